@@ -274,6 +274,11 @@ int ActivationDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
             in[i] = i % 2 ? RAN_GEN<Tgpu>(static_cast<Tgpu>(0.005), static_cast<Tgpu>(2.0))
                           : RAN_GEN<Tgpu>(static_cast<Tgpu>(-2.0), static_cast<Tgpu>(-0.005));
             break;
+        case MIOPEN_NEURON_GELU:
+        case MIOPEN_NEURON_SILU:
+        case MIOPEN_NEURON_MISH:
+            in[i] = RAN_GEN<Tgpu>(static_cast<Tgpu>(-4.0), static_cast<Tgpu>(4.0));
+            break;
         }
     }
 
@@ -30,6 +30,7 @@
 #include "InputFlags.hpp"
 #include "driver.hpp"
 #include "miopen_BatchNormHost.hpp"
+#include "roofline.hpp"
 #include "timer.hpp"
 #include <algorithm>
 #include <cmath>
@@ -895,6 +896,14 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunForwardGPU()
                dataSz,
                (rdCnt * dataSz + wrCnt * dataSz) / lowtime / 1e6,
                lowtime);
+        // Sum and sum of squares, then subtraction, scaling and shift per element when
+        // training, only the latter with the running statistics.
+        roofline::Report(GetHandle(),
+                         data_type,
+                         forw == 1 ? "fwd-train-bnorm" : "fwd-infer-bnorm",
+                         (forw == 1 ? 7.0 : 4.0) * M,
+                         (rdCnt + wrCnt) * dataSz,
+                         lowtime);
     }
     return miopenStatusSuccess;
 }
@@ -1147,6 +1156,15 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunBackwardGPU()
         if(iters > 1)
             printf("GPU Kernel Avg Time Backward Batch Normalization Elapsed: %f ms\n",
                    avgtime / (iters - 1));
+        // Sums of dy and of dy times the normalized x, then about six operations per element of
+        // dx. Reads x and dy, writes dx.
+        roofline::Report(GetHandle(),
+                         data_type,
+                         "bwd-bnorm",
+                         10 * roofline::GetElements(inputTensor),
+                         2 * roofline::GetBytes(inputTensor) + roofline::GetBytes(dxOutputTensor) +
+                             3 * roofline::GetBytes(biasScaleTensor),
+                         lowtime);
     }
 
     return miopenStatusSuccess;
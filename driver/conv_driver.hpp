@@ -38,6 +38,7 @@
 #include "conv_verify.hpp"
 #include "driver.hpp"
 #include "mloConvHost.hpp"
+#include "roofline.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
 #include "util_driver.hpp"
@@ -57,6 +58,7 @@
 #include <miopen/convolution.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/problem_description.hpp>
 #include "random.hpp"
 #include <numeric>
@@ -354,6 +356,8 @@ class ConvDriver : public Driver
     Timer2 warmup_wall_total; // Counts also auxiliary time.
 
     void PrintForwardTime(float kernel_total_time, float kernel_first_time) const;
+    /// Every direction reads two of the tensors and writes the third one.
+    void PrintRoofline(const std::string& name, float kernel_average_time) const;
     int RunForwardGpuImmed(bool is_transform);
     int RunForwardGpuFind(bool is_transform);
     void PrintBackwardDataTime(float kernel_total_time, float kernel_first_time);
@@ -642,6 +646,19 @@ int ConvDriver<Tgpu, Tref>::AddCmdLineArgs()
                          "",
                          "Use specified directory to cache verification data. Off by default.",
                          "string");
+    inflags.AddInputFlag("fast_init",
+                         '~',
+                         "0",
+                         "Fill the buffers in parallel with a counter-based generator (Default=0)."
+                         "\nThe data differs from the default initialization and is cached"
+                         " separately by --verification_cache",
+                         "int");
+    inflags.AddInputFlag("gpu_reference",
+                         '`',
+                         "0",
+                         "Verify against the naive GPU reference kernels instead of the CPU"
+                         " (Default=0), same as MIOPEN_DRIVER_USE_GPU_REFERENCE=1",
+                         "int");
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
     inflags.AddInputFlag("wall",
                          'w',
@@ -955,6 +972,28 @@ float16 RanGenWeights()
     return RAN_GEN<float16>(static_cast<float16>(-1.0 / 3.0), static_cast<float16>(0.5));
 }
 
+template <typename T>
+T RanGenWeightsAt(std::uint64_t seed, std::size_t i)
+{
+    return RAN_GEN_AT<T>(seed, i, static_cast<T>(-0.5), static_cast<T>(0.5));
+}
+
+template <>
+float16 RanGenWeightsAt(std::uint64_t seed, std::size_t i)
+{
+    return RAN_GEN_AT<float16>(
+        seed, i, static_cast<float16>(-1.0 / 3.0), static_cast<float16>(0.5));
+}
+
+/// Used by "--fast_init": element i only depends on i, so the fill is spread over all the cores.
+template <typename T, typename F>
+void FillParallel(std::vector<T>& data, F gen)
+{
+    miopen::par_for(data.size(), miopen::min_grain{1 << 16}, [&](std::size_t i) {
+        data[i] = gen(i);
+    });
+}
+
 } // namespace detail
 
 template <typename Tgpu, typename Tref>
@@ -1185,10 +1224,35 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
         if(!weiFileName.empty())
             weiRead = readBufferFromFile<Tgpu>(wei.data.data(), wei_sz, weiFileName.c_str());
 
+    /// The seeds only tell the buffers apart; the buffers not read from a file are filled here
+    /// and the serial loops below skip them.
+    enum : std::uint64_t
+    {
+        seed_in = 1,
+        seed_wei,
+        seed_dout,
+    };
+    const bool fast_init = inflags.GetValueInt("fast_init") != 0;
+
     if(is_int8)
     {
         float Data_scale = 127.0;
 
+        if(fast_init)
+        {
+            if(!dataRead && (is_fwd || is_wrw))
+                detail::FillParallel(in.data, [&](std::size_t i) {
+                    return static_cast<Tgpu>(Data_scale *
+                                             RAN_GEN_AT<float>(seed_in, i, 0.0f, 1.0f));
+                });
+            if(!weiRead && (is_fwd || is_bwd))
+                detail::FillParallel(wei.data, [&](std::size_t i) {
+                    return static_cast<Tgpu>(Data_scale * 2 *
+                                             detail::RanGenWeightsAt<float>(seed_wei, i));
+                });
+            dataRead = weiRead = true;
+        }
+
         if(!dataRead)
         {
             for(int i = 0; i < in_sz; i++)
@@ -1244,6 +1308,25 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
             if(!doutFileName.empty())
                 doutRead = readBufferFromFile<Tgpu>(dout.data.data(), out_sz, doutFileName.c_str());
 
+        if(fast_init)
+        {
+            const auto zero = static_cast<Tgpu>(0.0);
+            const auto one  = static_cast<Tgpu>(1.0);
+            if(!dataRead && (is_fwd || is_wrw))
+                detail::FillParallel(in.data, [&](std::size_t i) {
+                    return Data_scale * RAN_GEN_AT<Tgpu>(seed_in, i, zero, one);
+                });
+            if(!doutRead && (is_bwd || is_wrw))
+                detail::FillParallel(dout.data, [&](std::size_t i) {
+                    return Data_scale * RAN_GEN_AT<Tgpu>(seed_dout, i, zero, one);
+                });
+            if(!weiRead && (is_fwd || is_bwd))
+                detail::FillParallel(wei.data, [&](std::size_t i) {
+                    return Data_scale * detail::RanGenWeightsAt<Tgpu>(seed_wei, i);
+                });
+            dataRead = doutRead = weiRead = true;
+        }
+
         if(!dataRead)
         {
             for(int i = 0; i < in_sz; i++)
@@ -1362,7 +1445,8 @@ int ConvDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 bool ConvDriver<Tgpu, Tref>::UseGPUReference()
 {
-    if(miopen::IsEnabled(MIOPEN_DRIVER_USE_GPU_REFERENCE{}))
+    if(miopen::IsEnabled(MIOPEN_DRIVER_USE_GPU_REFERENCE{}) ||
+       inflags.GetValueInt("gpu_reference") != 0)
     {
         if(miopen_type<Tref>{} == miopenFloat &&
            (miopen_type<Tgpu>{} == miopenFloat || miopen_type<Tgpu>{} == miopenHalf ||
@@ -1403,6 +1487,27 @@ int ConvDriver<Tgpu, Tref>::FindForward(int& ret_algo_count,
     return rc;
 }
 
+template <typename Tgpu, typename Tref>
+void ConvDriver<Tgpu, Tref>::PrintRoofline(const std::string& name,
+                                           float kernel_average_time) const
+{
+    // The weights are k x c/g x filter, so each of the k output channels of a convolution
+    // (or input channels of a transposed one) takes a multiply-add per element of a filter.
+    const auto& weights = miopen::deref(weightTensor);
+    const auto& outputs = miopen::deref(
+        miopen::deref(convDesc).mode == miopenTranspose ? inputTensor : outputTensor);
+    const auto filter =
+        weights.GetElementSize() / std::max<std::size_t>(weights.GetLengths()[0], 1);
+    const auto bytes = roofline::GetBytes(inputTensor) + roofline::GetBytes(weightTensor) +
+                       roofline::GetBytes(outputTensor);
+    roofline::Report(handle,
+                     data_type,
+                     name,
+                     2.0 * outputs.GetElementSize() * filter,
+                     bytes,
+                     kernel_average_time);
+}
+
 template <typename Tgpu, typename Tref>
 void ConvDriver<Tgpu, Tref>::PrintForwardTime(const float kernel_total_time,
                                               const float kernel_first_time) const
@@ -1411,6 +1516,7 @@ void ConvDriver<Tgpu, Tref>::PrintForwardTime(const float kernel_total_time,
                                     ? (kernel_total_time - kernel_first_time) / (num_iterations - 1)
                                     : kernel_first_time;
     printf("GPU Kernel Time Forward Conv. Elapsed: %f ms (average)\n", kernel_average_time);
+    PrintRoofline("fwd-conv", kernel_average_time);
 
     const auto num_dim = miopen::deref(inputTensor).GetSize() - 2;
     if(num_dim != 2 && num_dim != 3)
@@ -2311,6 +2417,7 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardDataTime(float kernel_total_time, floa
                                     : kernel_first_time;
 
     printf("GPU Kernel Time Backward Data Conv. Elapsed: %f ms (average)\n", kernel_average_time);
+    PrintRoofline("bwdd-conv", kernel_average_time);
 
     const auto num_dim = miopen::deref(inputTensor).GetSize() - 2;
     if(num_dim != 2 && num_dim != 3)
@@ -2521,6 +2628,7 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardWrwTime(float kernel_total_time, float
 
     printf("GPU Kernel Time Backward Weights Conv. Elapsed: %f ms (average)\n",
            kernel_average_time);
+    PrintRoofline("bwdw-conv", kernel_average_time);
 
     const auto num_dim = miopen::deref(inputTensor).GetSize() - 2;
     if(num_dim != 2 && num_dim != 3)
@@ -3139,6 +3247,8 @@ std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheFileName(
        << "GPU" << get_datatype_string(Tgpu{});
     ss << "_"
        << "REF" << get_datatype_string(Tref{});
+    if(inflags.GetValueInt("fast_init") != 0)
+        ss << "_fast_init";
 
     return ss.str();
 }
@@ -130,7 +130,7 @@ void PadBufferSize(size_t& sz, int datatype_sz)
     printf(
         "Supported Base Arguments: conv[fp16|int8|bfp16], CBAInfer[fp16], pool[fp16], lrn[fp16], "
         "activ[fp16], softmax[fp16], bnorm[fp16], rnn[fp16], gemm, ctc, dropout[fp16], "
-        "tensorop[fp16], reduce[fp16,fp64]\n");
+        "tensorop[fp16], reduce[fp16,fp64], replay\n");
     exit(0); // NOLINT (concurrency-mt-unsafe)
 }
 
@@ -150,7 +150,8 @@ std::string ParseBaseArg(int argc, char* argv[])
        arg != "softmax" && arg != "softmaxfp16" && arg != "bnorm" && arg != "bnormfp16" &&
        arg != "rnn" && arg != "rnnfp16" && arg != "gemm" /*&& arg != "gemmfp16"*/ && arg != "ctc" &&
        arg != "dropout" && arg != "dropoutfp16" && arg != "tensorop" && arg != "tensoropfp16" &&
-       arg != "reduce" && arg != "reducefp16" && arg != "reducefp64" && arg != "--version")
+       arg != "reduce" && arg != "reducefp16" && arg != "reducefp64" && arg != "replay" &&
+       arg != "--version")
     {
         printf("Invalid Base Input Argument\n");
         Usage();
@@ -166,16 +167,32 @@ class Driver
     public:
     Driver()
     {
-        data_type = miopenFloat;
+        data_type   = miopenFloat;
+        owns_handle = SharedHandle() == nullptr;
+        handle      = owns_handle ? CreateHandle() : SharedHandle();
+
+        miopenGetStream(handle, &q);
+    }
+
+    static miopenHandle_t CreateHandle()
+    {
+        miopenHandle_t result;
 #if MIOPEN_BACKEND_OPENCL
-        miopenCreate(&handle);
+        miopenCreate(&result);
 #elif MIOPEN_BACKEND_HIP
         hipStream_t s;
         hipStreamCreate(&s);
-        miopenCreateWithStream(&handle, s);
+        miopenCreateWithStream(&result, s);
 #endif
+        return result;
+    }
 
-        miopenGetStream(handle, &q);
+    /// While set, the drivers created by the thread use this handle instead of their own, so
+    /// that they share its kernels and find results, e.g. the layers of a network in replay.
+    static miopenHandle_t& SharedHandle()
+    {
+        static thread_local miopenHandle_t shared = nullptr;
+        return shared;
     }
 
     miopenHandle_t GetHandle() { return handle; }
@@ -186,7 +203,11 @@ class Driver
 #elif MIOPEN_BACKEND_HIP
     hipStream_t& GetStream() { return q; }
 #endif
-    virtual ~Driver() { miopenDestroy(handle); }
+    virtual ~Driver()
+    {
+        if(owns_handle)
+            miopenDestroy(handle);
+    }
 
     // TODO: add timing APIs
     virtual int AddCmdLineArgs()                         = 0;
@@ -203,6 +224,7 @@ class Driver
     template <typename Tgpu>
     void InitDataType();
     miopenHandle_t handle;
+    bool owns_handle;
     miopenDataType_t data_type;
 
 #if MIOPEN_BACKEND_OPENCL
@@ -23,8 +23,10 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <chrono>
 #include <iostream>
 #include <cstdio>
+#include <memory>
 
 #include "activ_driver.hpp"
 #include "bn_driver.hpp"
@@ -40,159 +42,141 @@
 #include "dropout_driver.hpp"
 #include "tensorop_driver.hpp"
 #include "reduce_driver.hpp"
+#include "replay.hpp"
 #include "miopen/config.h"
 
-int main(int argc, char* argv[])
+Driver* MakeDriver(const std::string& base_arg)
 {
-
-    std::string base_arg = ParseBaseArg(argc, argv);
-
-    if(base_arg == "--version")
-    {
-        size_t major, minor, patch;
-        miopenGetVersion(&major, &minor, &patch);
-        std::cout << "MIOpen (version: " << major << "." << minor << "." << patch << ")"
-                  << std::endl;
-        exit(0); // NOLINT (concurrency-mt-unsafe)
-    }
-
-    // show command
-    std::cout << "MIOpenDriver";
-    for(int i = 1; i < argc; i++)
-        std::cout << " " << argv[i];
-    std::cout << std::endl;
-
-    Driver* drv;
     if(base_arg == "conv")
     {
-        drv = new ConvDriver<float, float>();
+        return new ConvDriver<float, float>();
     }
-    else if(base_arg == "convfp16")
+    if(base_arg == "convfp16")
     {
-        drv = new ConvDriver<float16, float>();
+        return new ConvDriver<float16, float>();
     }
-    else if(base_arg == "convbfp16")
+    if(base_arg == "convbfp16")
     {
-        drv = new ConvDriver<bfloat16, float>();
+        return new ConvDriver<bfloat16, float>();
     }
-    else if(base_arg == "convint8")
+    if(base_arg == "convint8")
     {
-        drv = new ConvDriver<int8_t, float>();
+        return new ConvDriver<int8_t, float>();
     }
-    else if(base_arg == "CBAInfer")
+    if(base_arg == "CBAInfer")
     {
-        drv = new CBAInferFusionDriver<float, double>();
+        return new CBAInferFusionDriver<float, double>();
     }
-    else if(base_arg == "CBAInferfp16")
+    if(base_arg == "CBAInferfp16")
     {
-        drv = new CBAInferFusionDriver<float16, double>();
+        return new CBAInferFusionDriver<float16, double>();
     }
-    else if(base_arg == "pool")
+    if(base_arg == "pool")
     {
-        drv = new PoolDriver<float, double>();
+        return new PoolDriver<float, double>();
     }
-    else if(base_arg == "poolfp16")
+    if(base_arg == "poolfp16")
     {
-        drv = new PoolDriver<float16, double>();
+        return new PoolDriver<float16, double>();
     }
-    else if(base_arg == "lrn")
+    if(base_arg == "lrn")
     {
-        drv = new LRNDriver<float, double>();
+        return new LRNDriver<float, double>();
     }
-    else if(base_arg == "lrnfp16")
+    if(base_arg == "lrnfp16")
     {
-        drv = new LRNDriver<float16, double>();
+        return new LRNDriver<float16, double>();
     }
-    else if(base_arg == "activ")
+    if(base_arg == "activ")
     {
-        drv = new ActivationDriver<float, double>();
+        return new ActivationDriver<float, double>();
     }
-    else if(base_arg == "activfp16")
+    if(base_arg == "activfp16")
     {
-        drv = new ActivationDriver<float16, double>();
+        return new ActivationDriver<float16, double>();
     }
-    else if(base_arg == "softmax")
+    if(base_arg == "softmax")
     {
-        drv = new SoftmaxDriver<float, double>();
+        return new SoftmaxDriver<float, double>();
     }
-    else if(base_arg == "softmaxfp16")
+    if(base_arg == "softmaxfp16")
     {
-        drv = new SoftmaxDriver<float16, double>();
+        return new SoftmaxDriver<float16, double>();
     }
 #if MIOPEN_USE_GEMM
-    else if(base_arg == "gemm")
+    if(base_arg == "gemm")
     {
-        drv = new GemmDriver<float>();
+        return new GemmDriver<float>();
     }
 // TODO half is not supported in gemm
-//    else if(base_arg == "gemmfp16")
+//    if(base_arg == "gemmfp16")
 //    {
-//        drv = new GemmDriver<float16>();
+//        return new GemmDriver<float16>();
 //    }
 #endif
-    else if(base_arg == "bnorm")
+    if(base_arg == "bnorm")
     {
-        drv = new BatchNormDriver<float, double>();
+        return new BatchNormDriver<float, double>();
     }
-    else if(base_arg == "bnormfp16")
+    if(base_arg == "bnormfp16")
     {
-        drv = new BatchNormDriver<float16, double, float>();
+        return new BatchNormDriver<float16, double, float>();
     }
-    else if(base_arg == "rnn")
+    if(base_arg == "rnn")
     {
-        drv = new RNNDriver<float, double>();
+        return new RNNDriver<float, double>();
     }
-    else if(base_arg == "rnnfp16")
+    if(base_arg == "rnnfp16")
     {
-        drv = new RNNDriver<float16, double>();
+        return new RNNDriver<float16, double>();
     }
-    else if(base_arg == "ctc")
+    if(base_arg == "ctc")
     {
-        drv = new CTCDriver<float>();
+        return new CTCDriver<float>();
     }
-    else if(base_arg == "dropout")
+    if(base_arg == "dropout")
     {
-        drv = new DropoutDriver<float, float>();
+        return new DropoutDriver<float, float>();
     }
-    else if(base_arg == "dropoutfp16")
+    if(base_arg == "dropoutfp16")
     {
-        drv = new DropoutDriver<float16, float>();
+        return new DropoutDriver<float16, float>();
     }
-    else if(base_arg == "tensorop")
+    if(base_arg == "tensorop")
     {
-        drv = new TensorOpDriver<float, float>();
+        return new TensorOpDriver<float, float>();
     }
-    else if(base_arg == "tensoropfp16")
+    if(base_arg == "tensoropfp16")
     {
-        drv = new TensorOpDriver<float16, float>();
+        return new TensorOpDriver<float16, float>();
     }
-    else if(base_arg == "reduce")
+    if(base_arg == "reduce")
     {
-        drv = new ReduceDriver<float, float>();
+        return new ReduceDriver<float, float>();
     }
-    else if(base_arg == "reducefp16")
+    if(base_arg == "reducefp16")
     {
-        drv = new ReduceDriver<float16, float>();
+        return new ReduceDriver<float16, float>();
     }
-    else if(base_arg == "reducefp64")
+    if(base_arg == "reducefp64")
     {
-        drv = new ReduceDriver<double, double>();
-    }
-    else
-    {
-        printf("Incorrect BaseArg\n");
-        exit(0); // NOLINT (concurrency-mt-unsafe)
+        return new ReduceDriver<double, double>();
     }
 
-    drv->AddCmdLineArgs();
-    int rc = drv->ParseCmdLineArgs(argc, argv);
+    return nullptr;
+}
+
+int RunDriver(Driver& drv, const std::string& base_arg, int argc, char* argv[], double* run_ms)
+{
+    drv.AddCmdLineArgs();
+    int rc = drv.ParseCmdLineArgs(argc, argv);
     if(rc != 0)
     {
         std::cout << "ParseCmdLineArgs() failed, rc = " << rc << std::endl;
         return rc;
     }
-    drv->GetandSetData();
-    rc = drv->AllocateBuffersAndCopy();
+    drv.GetandSetData();
+    rc = drv.AllocateBuffersAndCopy();
     if(rc != 0)
     {
         std::cout << "AllocateBuffersAndCopy() failed, rc = " << rc << std::endl;
@@ -200,33 +184,71 @@ int main(int argc, char* argv[])
     }
 
     int fargval = ((base_arg != "CBAInfer") && (base_arg != "CBAInferfp16"))
-                      ? drv->GetInputFlags().GetValueInt("forw")
+                      ? drv.GetInputFlags().GetValueInt("forw")
                       : 1;
     bool bnFwdInVer   = (fargval == 2 && (base_arg == "bnorm"));
-    bool verifyarg    = (drv->GetInputFlags().GetValueInt("verify") == 1);
+    bool verifyarg    = (drv.GetInputFlags().GetValueInt("verify") == 1);
     int cumulative_rc = 0; // Do not stop running tests in case of errors.
+    const auto start  = std::chrono::steady_clock::now();
 
     if(fargval & 1 || fargval == 0 || bnFwdInVer)
     {
-        rc = drv->RunForwardGPU();
+        rc = drv.RunForwardGPU();
         cumulative_rc |= rc;
         if(rc != 0)
             std::cout << "RunForwardGPU() failed, rc = "
                       << "0x" << std::hex << rc << std::dec << std::endl;
         if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyForward();
+            cumulative_rc |= drv.VerifyForward();
     }
 
     if(fargval != 1)
     {
-        rc = drv->RunBackwardGPU();
+        rc = drv.RunBackwardGPU();
         cumulative_rc |= rc;
         if(rc != 0)
             std::cout << "RunBackwardGPU() failed, rc = "
                       << "0x" << std::hex << rc << std::dec << std::endl;
         if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyBackward();
+            cumulative_rc |= drv.VerifyBackward();
     }
 
+    if(run_ms != nullptr)
+        *run_ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                .count();
     return cumulative_rc;
 }
+
+int main(int argc, char* argv[])
+{
+
+    std::string base_arg = ParseBaseArg(argc, argv);
+
+    if(base_arg == "--version")
+    {
+        size_t major, minor, patch;
+        miopenGetVersion(&major, &minor, &patch);
+        std::cout << "MIOpen (version: " << major << "." << minor << "." << patch << ")"
+                  << std::endl;
+        exit(0); // NOLINT (concurrency-mt-unsafe)
+    }
+
+    if(base_arg == "replay")
+        return RunReplay(argc, argv);
+
+    // show command
+    std::cout << "MIOpenDriver";
+    for(int i = 1; i < argc; i++)
+        std::cout << " " << argv[i];
+    std::cout << std::endl;
+
+    std::unique_ptr<Driver> drv{MakeDriver(base_arg)};
+    if(drv == nullptr)
+    {
+        printf("Incorrect BaseArg\n");
+        exit(0); // NOLINT (concurrency-mt-unsafe)
+    }
+
+    return RunDriver(*drv, base_arg, argc, argv);
+}
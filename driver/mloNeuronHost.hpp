@@ -53,7 +53,10 @@
 #define MIOPEN_NEURON_CLIPPED_RELU 7 // min(alpha, max(0, x))
 #define MIOPEN_NEURON_LEAKY_RELU 8   // alpha * x | x <= 0; x | x > 0
 #define MIOPEN_NEURON_ELU 9          // alpha * (e^x - 1) | x <= 0; x | x > 0
-#define MIOPEN_NEURON_TOTAL 10
+#define MIOPEN_NEURON_GELU 10        // 0.5 * x * (1 + erf(x / sqrt(2)))
+#define MIOPEN_NEURON_SILU 11        // x / (1 + e^-x)
+#define MIOPEN_NEURON_MISH 12        // x * tanh(log(1 + e^x))
+#define MIOPEN_NEURON_TOTAL 13
 #endif
 
 const float kBNLL_THRESHOLD = 50.;
@@ -121,6 +124,17 @@ int mloNeuronForwardRunHostAndVerify(int neuron_type,
     case MIOPEN_NEURON_ELU: // alpah * (exp(x)-1) | x<=0; x | x>0
         f = [=](_Tcheck x) { return (x > 0) ? x : alpha * std::expm1(x); };
         break;
+    case MIOPEN_NEURON_GELU: // 0.5 * x * (1 + erf(x / sqrt(2)))
+        f = [=](_Tcheck x) {
+            return _Tcheck(0.5) * x * (1 + std::erf(x / std::sqrt(_Tcheck(2))));
+        };
+        break;
+    case MIOPEN_NEURON_SILU: // x / (1 + e^-x)
+        f = [=](_Tcheck x) { return x / (1 + std::exp(-x)); };
+        break;
+    case MIOPEN_NEURON_MISH: // x * tanh(log(1 + e^x))
+        f = [=](_Tcheck x) { return x * std::tanh(std::log1p(std::exp(x))); };
+        break;
     default: printf("ERROR: unknown neuron type: %d\n", neuron_type); break;
     }
 
@@ -225,6 +239,26 @@ int mloNeuronBackwardRunHostAndVerify(int neuron_type,
     case MIOPEN_NEURON_ELU: // alpah * (exp(x)-1) | x<=0; x | x>0
         f = [=](_Tcheck dy, _Tcheck x, _Tcheck y) { return dy * ((x > 0) ? 1 : y + alpha); };
         break;
+    case MIOPEN_NEURON_GELU: // 0.5 * x * (1 + erf(x / sqrt(2)))
+        f = [=](_Tcheck dy, _Tcheck x, _Tcheck) {
+            _Tcheck cdf = _Tcheck(0.5) * (1 + std::erf(x / std::sqrt(_Tcheck(2))));
+            _Tcheck pdf = std::exp(_Tcheck(-0.5) * x * x) / std::sqrt(_Tcheck(2 * 3.14159265));
+            return dy * (cdf + x * pdf);
+        };
+        break;
+    case MIOPEN_NEURON_SILU: // x / (1 + e^-x)
+        f = [=](_Tcheck dy, _Tcheck x, _Tcheck) {
+            _Tcheck s = 1 / (1 + std::exp(-x));
+            return dy * s * (1 + x * (1 - s));
+        };
+        break;
+    case MIOPEN_NEURON_MISH: // x * tanh(log(1 + e^x))
+        f = [=](_Tcheck dy, _Tcheck x, _Tcheck) {
+            _Tcheck t = std::tanh(std::log1p(std::exp(x)));
+            _Tcheck s = 1 / (1 + std::exp(-x));
+            return dy * (t + x * s * (1 - t * t));
+        };
+        break;
     default: printf("ERROR: unknown neuron type: %d\n", neuron_type); break;
     }
 
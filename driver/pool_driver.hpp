@@ -29,6 +29,7 @@
 #include "InputFlags.hpp"
 #include "driver.hpp"
 #include "mloPoolingHost.hpp"
+#include "roofline.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
 #include <algorithm>
@@ -38,6 +39,7 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <miopen/pooling.hpp>
+#include <functional>
 #include <numeric>
 #include <vector>
 #include "random.hpp"
@@ -118,6 +120,14 @@ class PoolDriver_impl : public Driver
     std::vector<Tref> dinhost;
 
     int spatial_dim;
+
+    /// A comparison or an addition per element of the window of each output.
+    double GetFlops() const
+    {
+        const auto& window = miopen::deref(poolDesc).GetLengths();
+        return roofline::GetElements(outputTensor) *
+               std::accumulate(window.begin(), window.end(), 1.0, std::multiplies<double>());
+    }
 };
 
 template <typename Tgpu, typename Tref, typename Index>
@@ -424,6 +434,12 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunForwardGPU()
                    t.gettime_ms() / inflags.GetValueInt("iter"));
 
         printf("GPU Kernel Time Forward Pooling Elapsed: %f ms\n", time);
+        roofline::Report(GetHandle(),
+                         data_type,
+                         "fwd-pool",
+                         GetFlops(),
+                         roofline::GetBytes(inputTensor) + roofline::GetBytes(outputTensor),
+                         time);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -486,6 +502,12 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunBackwardGPU()
             printf("Wall-clock Time Backward Pooling Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
         printf("GPU Kernel Time Backward Pooling Elapsed: %f ms\n", time);
+        roofline::Report(GetHandle(),
+                         data_type,
+                         "bwd-pool",
+                         GetFlops(),
+                         roofline::GetBytes(dOutputTensor) + roofline::GetBytes(dInputTensor),
+                         time);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -1,6 +1,7 @@
 #ifndef GUARD_RANDOM_GEN_
 #define GUARD_RANDOM_GEN_
 
+#include <cstdint>
 #include <cstdlib>
 
 template <typename T>
@@ -19,4 +20,19 @@ static T RAN_GEN(T A, T B)
     return r;
 }
 
+/// Counter-based counterpart of RAN_GEN: the value only depends on the seed and on the element
+/// index, so buffers can be filled in parallel with the same result for any number of threads.
+template <typename T>
+static T RAN_GEN_AT(std::uint64_t seed, std::uint64_t index, T A, T B)
+{
+    // splitmix64 finalizer
+    std::uint64_t z = seed * 0x9e3779b97f4a7c15ULL + index;
+    z               = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z               = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z               = z ^ (z >> 31);
+    const double d  = static_cast<double>(z >> 11) / static_cast<double>(1ULL << 53);
+    return static_cast<T>((d * (static_cast<double>(B) - static_cast<double>(A))) +
+                          static_cast<double>(A));
+}
+
 #endif // GUARD_RANDOM_GEN_
@@ -29,6 +29,7 @@
 #include "../test/verify.hpp"
 #include "InputFlags.hpp"
 #include "driver.hpp"
+#include "roofline.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
 #include <algorithm>
@@ -445,6 +446,13 @@ int ReduceDriver<Tgpu, Tref>::RunForwardGPU()
             printf("Wall-clock Time Reduction Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
         printf("GPU Kernel Time Reduction Elapsed: %f ms\n", time);
+        // An operation per input element, the indices are left out.
+        roofline::Report(GetHandle(),
+                         data_type,
+                         "reduce",
+                         roofline::GetElements(inputTensor),
+                         roofline::GetBytes(inputTensor) + roofline::GetBytes(outputTensor),
+                         time);
     }
 
     return miopenStatusSuccess;
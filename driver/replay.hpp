@@ -0,0 +1,228 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_REPLAY_HPP
+#define GUARD_MIOPEN_REPLAY_HPP
+
+#include "driver.hpp"
+#include "InputFlags.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+Driver* MakeDriver(const std::string& base_arg);
+/// \p run_ms receives the time of the forward and backward runs, including their verification.
+int RunDriver(
+    Driver& drv, const std::string& base_arg, int argc, char* argv[], double* run_ms = nullptr);
+
+namespace replay {
+
+struct Layer
+{
+    std::vector<std::string> args; // Starting from the base argument, e.g. conv.
+    int count = 0;                 // Occurrences in the commands replayed.
+    int rc    = 0;
+    double ms = 0;
+
+    std::string Command() const
+    {
+        std::string result;
+        for(const auto& arg : args)
+            result += (result.empty() ? "" : " ") + arg;
+        return result;
+    }
+};
+
+/// Reads the MIOpenDriver commands of a log written with MIOPEN_ENABLE_LOGGING_CMD, or of a
+/// file with a command per line, in the order of their first occurrence.
+std::vector<Layer> ReadLayers(std::istream& in)
+{
+    const std::string prefix = "MIOpenDriver ";
+    std::vector<Layer> layers;
+    std::map<std::string, std::size_t> indices;
+    std::string line;
+
+    while(std::getline(in, line))
+    {
+        const auto pos = line.find(prefix);
+        std::istringstream command{pos == std::string::npos ? line
+                                                            : line.substr(pos + prefix.size())};
+        auto layer = Layer{};
+        std::string arg;
+        while(command >> arg)
+            layer.args.push_back(arg);
+        if(layer.args.empty() || layer.args.front().front() == '#')
+            continue;
+
+        const auto index = indices.emplace(layer.Command(), layers.size());
+        if(index.second)
+            layers.push_back(std::move(layer));
+        ++layers[index.first->second].count;
+    }
+    return layers;
+}
+
+int RunLayer(Layer& layer)
+{
+    const auto& base_arg = layer.args.front();
+    std::unique_ptr<Driver> drv{MakeDriver(base_arg)};
+    if(drv == nullptr)
+    {
+        std::cout << "Unsupported command: " << layer.Command() << std::endl;
+        return -1;
+    }
+
+    std::cout << "MIOpenDriver " << layer.Command() << std::endl;
+    // The layers are timed, not verified.
+    auto args = std::vector<std::string>{"MIOpenDriver"};
+    args.insert(args.end(), layer.args.begin(), layer.args.end());
+    args.insert(args.end(), {"-V", "0"});
+    auto argv = std::vector<char*>{};
+    for(auto& arg : args)
+        argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+
+    return RunDriver(*drv, base_arg, static_cast<int>(args.size()), argv.data(), &layer.ms);
+}
+
+void WriteString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for(const auto c : str)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\';
+        os << c;
+    }
+    os << '"';
+}
+
+void WriteJson(std::ostream& os, const std::vector<Layer*>& layers)
+{
+    auto total_ms = 0.0;
+    auto failed   = 0;
+    os << "{\"layers\": [";
+    for(std::size_t i = 0; i < layers.size(); ++i)
+    {
+        const auto& layer = *layers[i];
+        os << (i == 0 ? "\n" : ",\n") << "  {\"command\": ";
+        WriteString(os, layer.Command());
+        os << ", \"count\": " << layer.count << ", \"rc\": " << layer.rc
+           << ", \"ms\": " << layer.ms << '}';
+        total_ms += layer.ms * layer.count;
+        failed += layer.rc != 0 ? 1 : 0;
+    }
+    os << "\n], \"total_ms\": " << total_ms << ", \"failed\": " << failed << '}' << std::endl;
+}
+
+} // namespace replay
+
+/// Runs the layers of a network from a file of logged commands with a handle shared by all of
+/// them, after building their kernels and filling the find-db in parallel, and reports the time
+/// of each layer and the total time of the network, weighted by the occurrences of the layers,
+/// as JSON. Each of the --shards processes running on the GPUs of a node replays every
+/// --shards-th layer, starting from the --shard-th.
+int RunReplay(int argc, char* argv[])
+{
+    InputFlags inflags;
+    inflags.AddInputFlag("file", 'f', "", "File of MIOpenDriver commands to replay", "string");
+    inflags.AddInputFlag("output", 'o', "", "JSON report, written to stdout if empty", "string");
+    inflags.AddInputFlag(
+        "jobs", 'j', "0", "Threads building the kernels, 0 for all, -1 for none", "int");
+    inflags.AddInputFlag("shard", 's', "0", "Shard of the layers to replay", "int");
+    inflags.AddInputFlag("shards", 'S', "1", "Number of shards", "int");
+    inflags.Parse(argc, argv);
+
+    std::ifstream file{inflags.GetValueStr("file")};
+    if(!file)
+    {
+        std::cout << "Unable to read " << inflags.GetValueStr("file") << std::endl;
+        return -1;
+    }
+    auto layers       = replay::ReadLayers(file);
+    const auto shard  = inflags.GetValueInt("shard");
+    const auto shards = std::max(inflags.GetValueInt("shards"), 1);
+    auto selected     = std::vector<replay::Layer*>{};
+    for(std::size_t i = shard; i < layers.size(); i += shards)
+        selected.push_back(&layers[i]);
+
+    // Each thread builds with a handle of its own, and the layers reuse the kernels from the
+    // cache on disk and the results from the user find-db.
+    auto jobs = inflags.GetValueInt("jobs");
+    if(jobs == 0)
+        jobs = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+    jobs = std::min(jobs, static_cast<int>(selected.size()));
+    if(jobs > 0)
+    {
+        std::atomic<std::size_t> next{0};
+        auto threads = std::vector<std::thread>{};
+        for(auto i = 0; i < jobs; ++i)
+        {
+            threads.emplace_back([&] {
+                Driver::SharedHandle() = Driver::CreateHandle();
+                for(auto j = next++; j < selected.size(); j = next++)
+                {
+                    auto warmup = *selected[j];
+                    RunLayer(warmup);
+                }
+                miopenDestroy(Driver::SharedHandle());
+                Driver::SharedHandle() = nullptr;
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    Driver::SharedHandle() = Driver::CreateHandle();
+    auto failed            = 0;
+    for(auto layer : selected)
+    {
+        layer->rc = RunLayer(*layer);
+        failed += layer->rc != 0 ? 1 : 0;
+    }
+    miopenDestroy(Driver::SharedHandle());
+    Driver::SharedHandle() = nullptr;
+
+    if(inflags.GetValueStr("output").empty())
+    {
+        replay::WriteJson(std::cout, selected);
+    }
+    else
+    {
+        std::ofstream output{inflags.GetValueStr("output")};
+        replay::WriteJson(output, selected);
+    }
+    return failed == 0 ? 0 : -1;
+}
+
+#endif // GUARD_MIOPEN_REPLAY_HPP
@@ -265,13 +265,16 @@ int RNNDriver<Tgpu, Tref>::AddCmdLineArgs()
     inflags.AddInputFlag(
         "mode", 'm', "tanh", "RNN Mode (relu, tanh, lstm, gru) (Default=tanh)", "str");
     inflags.AddInputFlag("inputmode", 'p', "0", "linear == 0 or skip == 1, (Default=0)", "int");
-    inflags.AddInputFlag("rnnalgo", 'a', "0", "default, fundamental (Default=0)", "int");
+    inflags.AddInputFlag(
+        "rnnalgo", 'a', "0", "default, fundamental, persistent, recompute (Default=0)", "int");
     inflags.AddInputFlag("fwdtype",
                          'c',
                          "0",
                          "RNN forward being training or inference, Default training (Default=0)",
                          "int");
     inflags.AddInputFlag("datatype", 'f', "1", "16-bit or 32-bit fp (Default=1)", "int");
+    inflags.AddInputFlag(
+        "int8_weights", 'q', "0", "Int8 recurrent weights for inference (Default=0)", "int");
 
     inflags.AddInputFlag(
         "use_dropout", 'U', "0", "Use dropout: 1; Not use dropout: 0 (Default=0)", "int");
@@ -460,6 +463,14 @@ int RNNDriver<Tgpu, Tref>::SetRNNDescriptorFromCmdLineArgs()
     {
         algo = miopenRNNfundamental;
     }
+    else if((inflags.GetValueInt("rnnalgo")) == 2)
+    {
+        algo = miopenRNNpersistent;
+    }
+    else if((inflags.GetValueInt("rnnalgo")) == 3)
+    {
+        algo = miopenRNNrecompute;
+    }
     else
     {
         printf("Incorrect RNN algorithm\n");
@@ -789,6 +800,12 @@ int RNNDriver<Tgpu, Tref>::RunForwardGPU()
     if(inflags.GetValueInt("forw") != 0 && !(inflags.GetValueInt("forw") & 1))
         return miopenStatusSuccess;
 
+    if(inflags.GetValueInt("fwdtype") == 1 && inflags.GetValueInt("int8_weights") != 0)
+    {
+        miopenRNNPrepareQuantizedWeights(
+            GetHandle(), rnnDesc, inputTensors[0], weightTensor, wei_dev->GetMem());
+    }
+
     Timer t;
     float wl_time_forward = 0.0;
     float kl_time_forward = 0.0;
@@ -1575,6 +1592,9 @@ int RNNDriver<Tgpu, Tref>::VerifyForward()
     auto error = miopen::rms_range(outhost, out);
 
     Tref tolerance = (sizeof(Tgpu) == 4 ? static_cast<Tref>(1e-6) : static_cast<Tref>(5e-2));
+    // The int8 recurrent weights are only as accurate as their quantization
+    if(inflags.GetValueInt("int8_weights") != 0)
+        tolerance = static_cast<Tref>(5e-2);
 
     if(!(error < tolerance))
     {
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_ROOFLINE_HPP
+#define GUARD_MIOPEN_ROOFLINE_HPP
+
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+#include <miopen/stringutils.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#if MIOPEN_BACKEND_OPENCL
+#if defined(__APPLE__) || defined(__MACOSX)
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+#elif MIOPEN_BACKEND_HIP
+#include <hip/hip_runtime_api.h>
+#endif
+
+/// Appends the roofline figures of each timed operation to the file, as CSV if its name ends
+/// with .csv, as a JSON object per line otherwise.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DRIVER_ROOFLINE_FILE)
+
+namespace roofline {
+
+/// Peak compute throughput and DRAM bandwidth of a device, zero when unknown.
+struct Peak
+{
+    double gflops = 0;
+    double gbps   = 0;
+};
+
+/// Estimates the peak from the CU count and the clocks of the device: 64 lanes per CU doing
+/// a fused multiply-add per clock for fp32, twice that with the packed fp16 math, four times for
+/// the int8 dot products, and the double data rate memory clock times the bus width. Matrix
+/// cores are not accounted for, so convolutions using them may exceed 100%.
+inline Peak GetPeak(miopenHandle_t handle, miopenDataType_t type)
+{
+    const auto cus = static_cast<double>(miopen::deref(handle).GetMaxComputeUnits());
+    auto clock_mhz = 0.0;
+    auto peak      = Peak{};
+#if MIOPEN_BACKEND_HIP
+    int device, clock_khz = 0, memory_clock_khz = 0, bus_width = 0;
+    if(hipGetDevice(&device) == hipSuccess)
+    {
+        hipDeviceGetAttribute(&clock_khz, hipDeviceAttributeClockRate, device);
+        hipDeviceGetAttribute(&memory_clock_khz, hipDeviceAttributeMemoryClockRate, device);
+        hipDeviceGetAttribute(&bus_width, hipDeviceAttributeMemoryBusWidth, device);
+    }
+    clock_mhz = clock_khz * 1e-3;
+    peak.gbps = 2.0 * memory_clock_khz * 1e3 * (bus_width / 8.0) * 1e-9;
+#elif MIOPEN_BACKEND_OPENCL
+    cl_device_id device;
+    cl_uint clock = 0;
+    if(clGetCommandQueueInfo(miopen::deref(handle).GetStream(),
+                             CL_QUEUE_DEVICE,
+                             sizeof(device),
+                             &device,
+                             nullptr) == CL_SUCCESS)
+        clGetDeviceInfo(device, CL_DEVICE_MAX_CLOCK_FREQUENCY, sizeof(clock), &clock, nullptr);
+    clock_mhz = clock;
+#endif
+
+    const auto rate = type == miopenHalf ? 2.0 : type == miopenInt8 ? 4.0 : 1.0;
+    peak.gflops     = cus * 64 * 2 * rate * clock_mhz * 1e-3;
+    return peak;
+}
+
+inline double GetElements(miopenTensorDescriptor_t desc)
+{
+    return static_cast<double>(miopen::deref(desc).GetElementSize());
+}
+
+inline std::size_t GetBytes(miopenTensorDescriptor_t desc)
+{
+    const auto& tensor = miopen::deref(desc);
+    return tensor.GetElementSize() * miopen::GetTypeSize(tensor.GetType());
+}
+
+/// Prints the achieved throughput and bandwidth of an operation of \p flops and \p bytes moved
+/// to or from DRAM, which took \p ms, against the peak of the device of the handle, and which
+/// of them bounds it, i.e. whether the arithmetic intensity is below the ridge point.
+inline void Report(miopenHandle_t handle,
+                   miopenDataType_t type,
+                   const std::string& name,
+                   double flops,
+                   double bytes,
+                   double ms)
+{
+    if(ms <= 0)
+        return;
+    const auto peak      = GetPeak(handle, type);
+    const auto gflops    = flops / ms * 1e-6;
+    const auto gbps      = bytes / ms * 1e-6;
+    const auto intensity = bytes > 0 ? flops / bytes : 0;
+    const auto flops_pct = peak.gflops > 0 ? 100 * gflops / peak.gflops : 0;
+    const auto bytes_pct = peak.gbps > 0 ? 100 * gbps / peak.gbps : 0;
+    const auto bound     = peak.gflops <= 0 || peak.gbps <= 0
+                               ? "unknown"
+                               : intensity < peak.gflops / peak.gbps ? "memory" : "compute";
+
+    printf("roofline: %s, %.3f ms, %.1f GFLOPs (%.1f%% of %.0f), %.1f GB/s (%.1f%% of %.0f), "
+           "%.2f flop/byte, %s-bound\n",
+           name.c_str(),
+           ms,
+           gflops,
+           flops_pct,
+           peak.gflops,
+           gbps,
+           bytes_pct,
+           peak.gbps,
+           intensity,
+           bound);
+
+    const char* const path = miopen::GetStringEnv(MIOPEN_DRIVER_ROOFLINE_FILE{});
+    if(path == nullptr || *path == '\0')
+        return;
+    const auto csv   = miopen::EndsWith(path, ".csv");
+    const auto empty = std::ifstream{path}.peek() == std::ifstream::traits_type::eof();
+    std::ofstream file{path, std::ios::app};
+    if(csv && empty)
+        file << "name,ms,flops,bytes,gflops,gflops_pct,gbps,gbps_pct,intensity,bound\n";
+    if(csv)
+    {
+        file << name << ',' << ms << ',' << flops << ',' << bytes << ',' << gflops << ','
+             << flops_pct << ',' << gbps << ',' << bytes_pct << ',' << intensity << ',' << bound
+             << '\n';
+    }
+    else
+    {
+        file << "{\"name\": \"" << name << "\", \"ms\": " << ms << ", \"flops\": " << flops
+             << ", \"bytes\": " << bytes << ", \"gflops\": " << gflops
+             << ", \"gflops_pct\": " << flops_pct << ", \"gbps\": " << gbps
+             << ", \"gbps_pct\": " << bytes_pct << ", \"intensity\": " << intensity
+             << ", \"bound\": \"" << bound << "\"}\n";
+    }
+}
+
+} // namespace roofline
+
+#endif // GUARD_MIOPEN_ROOFLINE_HPP
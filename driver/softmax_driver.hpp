@@ -29,6 +29,7 @@
 #include "InputFlags.hpp"
 #include "driver.hpp"
 #include "mloSoftmaxHost.hpp"
+#include "roofline.hpp"
 #include "tensor_driver.hpp"
 #include "timer.hpp"
 #include <../test/verify.hpp>
@@ -156,7 +157,8 @@ int SoftmaxDriver<Tgpu, Tref>::AddCmdLineArgs()
     inflags.AddInputFlag("algorithm",
                          'a',
                          "1",
-                         "softmax algorithms: fast (0), accurate (1), logsoftmax (2) (Default=1)",
+                         "softmax algorithms: fast (0), accurate (1), logsoftmax (2), online (3) "
+                         "(Default=1)",
                          "int");
     inflags.AddInputFlag(
         "mode", 'm', "1", "instance mode (0), channel mode (1) (Default=1)", "int");
@@ -273,6 +275,13 @@ int SoftmaxDriver<Tgpu, Tref>::RunForwardGPU()
         float kernel_average_time =
             iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
         printf("GPU Kernel Time Forward Softmax Elapsed: %f ms\n", kernel_average_time);
+        // Max, subtraction, exponent, sum and division per element.
+        roofline::Report(GetHandle(),
+                         data_type,
+                         "fwd-softmax",
+                         5 * roofline::GetElements(inputTensor),
+                         roofline::GetBytes(inputTensor) + roofline::GetBytes(outputTensor),
+                         kernel_average_time);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -326,6 +335,14 @@ int SoftmaxDriver<Tgpu, Tref>::RunBackwardGPU()
         float kernel_average_time =
             iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
         printf("GPU Kernel Time Backward Softmax Elapsed: %f ms\n", kernel_average_time);
+        // Dot product of y and dy, subtraction and multiplication per element.
+        roofline::Report(GetHandle(),
+                         data_type,
+                         "bwd-softmax",
+                         4 * roofline::GetElements(outputTensor),
+                         roofline::GetBytes(outputTensor) + roofline::GetBytes(dOutputTensor) +
+                             roofline::GetBytes(dInputTensor),
+                         kernel_average_time);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_FIN_SCHEDULER_HPP
+#define GUARD_FIN_SCHEDULER_HPP
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+#include <vector>
+
+namespace fin {
+
+using json = nlohmann::json;
+
+/// Runs a job list on all the host cores and GPUs of the machine. The jobs are split into
+/// chunks, each run by a child fin process: the compile-only jobs on up to cpu_workers
+/// processes at once, the others on one process per GPU, selected with HIP_VISIBLE_DEVICES.
+/// Every worker slot has its own user db and kernel cache directories, since the compile step
+/// clears the cache. When all the chunks are done, the outputs are merged into one in the order
+/// of the input and the user find-dbs and perf-dbs of the slots into db_dir.
+///
+/// A chunk whose process fails is rerun job by job, so that a crashing job only loses itself
+/// and is reported with a "reason" in the output.
+struct SchedulerOptions
+{
+    std::string input;
+    std::string output;
+    /// Directory of the merged user dbs, the user db path of MIOpen if empty.
+    std::string db_dir;
+    /// Chunks, outputs, logs and per-slot dbs, <output>.work if empty.
+    std::string work_dir;
+    /// Runs the GPU jobs, this executable if empty.
+    std::string fin;
+    /// Runs the compile-only jobs, e.g. fin built with the HIPNOGPU backend of MIOpen.
+    std::string compile_fin;
+    /// 0 for the number of the hardware threads.
+    int cpu_workers = 0;
+    /// 0 for the number of the visible devices.
+    int gpus  = 0;
+    int chunk = 8;
+};
+
+/// Parses "--parallel [-j <cpu workers>] [-g <gpus>] [--chunk <jobs>] [--db-dir <dir>]
+/// [--work-dir <dir>] [--compile-fin <exe>] -i <input> -o <output>".
+SchedulerOptions ParseSchedulerArgs(const std::vector<std::string>& args);
+
+/// True for the jobs which do not need a GPU.
+bool IsCompileOnly(const json& job);
+
+int RunScheduler(SchedulerOptions options, char* envp[]);
+
+} // namespace fin
+#endif // GUARD_FIN_SCHEDULER_HPP
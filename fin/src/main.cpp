@@ -29,6 +29,7 @@
 #include "conv_fin.hpp"
 #include "error.hpp"
 #include "fin.hpp"
+#include "scheduler.hpp"
 
 #include <half.hpp>
 #include <miopen/bfloat16.hpp>
@@ -54,6 +55,16 @@ using json = nlohmann::json;
     printf("-i *input_json\n");
     printf("-o *output_json\n");
     printf("\n");
+    printf("Usage: ./fin --parallel [options] -i *input_json -o *output_json\n\n");
+    printf("Runs the jobs on child fin processes, the compile-only ones on the host cores\n");
+    printf("and the others on all the GPUs, then merges their outputs and user dbs.\n");
+    printf("-j *cpu_workers       compile processes at once (hardware threads)\n");
+    printf("-g *gpus              GPUs to benchmark on (all visible)\n");
+    printf("--chunk *jobs         jobs per process (8)\n");
+    printf("--db-dir *dir         output of the merged user dbs (MIOpen user db path)\n");
+    printf("--work-dir *dir       chunks and logs of the processes (*output_json.work)\n");
+    printf("--compile-fin *exe    fin built with the HIPNOGPU backend for the compile jobs\n");
+    printf("\n");
     exit(0);
 }
 
@@ -72,6 +83,19 @@ int main(int argc, char* argv[], char* envp[])
         }
     }
 
+    if(std::find(args.begin(), args.end(), "--parallel") != args.end())
+    {
+        try
+        {
+            return fin::RunScheduler(fin::ParseSchedulerArgs(args), envp);
+        }
+        catch(const std::exception& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            Usage();
+        }
+    }
+
     if(argc != 5)
     {
         std::cerr << "Invalid arguments" << std::endl;
@@ -0,0 +1,389 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "scheduler.hpp"
+#include "config.h"
+#include "error.hpp"
+
+#include <miopen/db_merge.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/stringutils.hpp>
+
+#if FIN_BACKEND_HIP
+#include <hip/hip_runtime_api.h>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <thread>
+
+namespace fin {
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+struct Chunk
+{
+    std::vector<std::size_t> jobs;
+    bool compile_only;
+    bool retry; ///< Rerun of a job of a failed chunk.
+};
+
+struct Slot
+{
+    bool gpu;
+    int device;
+    fs::path dir;
+    pid_t pid = 0;
+    Chunk chunk;
+    fs::path output;
+};
+
+int GetDeviceCount()
+{
+#if FIN_BACKEND_HIP
+    auto count = 0;
+    if(hipGetDeviceCount(&count) == hipSuccess)
+        return count;
+#endif
+    return 1;
+}
+
+std::string GetSelfPath()
+{
+    return fs::read_symlink("/proc/self/exe").string();
+}
+
+/// The environment of the scheduler with the overrides of the slot.
+std::vector<std::string> MakeEnv(char* envp[], const std::map<std::string, std::string>& overrides)
+{
+    auto result = std::vector<std::string>{};
+    for(auto env = envp; *env != nullptr; ++env)
+    {
+        const auto entry = std::string{*env};
+        if(overrides.count(entry.substr(0, entry.find('='))) == 0)
+            result.push_back(entry);
+    }
+    for(const auto& item : overrides)
+        result.push_back(item.first + "=" + item.second);
+    return result;
+}
+
+pid_t Spawn(const std::string& exe,
+            const std::vector<std::string>& args,
+            const std::vector<std::string>& env,
+            const fs::path& log)
+{
+    auto to_argv = [](const std::vector<std::string>& strings) {
+        auto result = std::vector<char*>{};
+        for(const auto& s : strings)
+            result.push_back(const_cast<char*>(s.c_str())); // NOLINT
+        result.push_back(nullptr);
+        return result;
+    };
+    auto argv  = to_argv(args);
+    auto envv  = to_argv(env);
+    auto files = posix_spawn_file_actions_t{};
+    posix_spawn_file_actions_init(&files);
+    posix_spawn_file_actions_addopen(
+        &files, STDOUT_FILENO, log.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    posix_spawn_file_actions_adddup2(&files, STDOUT_FILENO, STDERR_FILENO);
+
+    auto pid          = pid_t{0};
+    const auto status = posix_spawn(&pid, exe.c_str(), &files, nullptr, argv.data(), envv.data());
+    posix_spawn_file_actions_destroy(&files);
+    if(status != 0)
+        FIN_THROW("Unable to run " + exe + ": " + std::to_string(status));
+    return pid;
+}
+
+json FailedResult(const json& job, const std::string& reason)
+{
+    auto result              = json{};
+    result["config_tuna_id"] = job.value("config_tuna_id", json{});
+    result["arch"]           = job.value("arch", json{});
+    result["direction"]      = job.value("direction", json{});
+    result["input"]          = job;
+    result["reason"]         = reason;
+    return result;
+}
+
+/// Merges the user dbs of the slots into db_dir, including the dbs already there.
+void MergeDbs(const std::vector<Slot>& slots, const fs::path& db_dir)
+{
+    auto inputs = std::map<std::string, std::vector<std::string>>{};
+    for(const auto& slot : slots)
+    {
+        const auto dir = slot.dir / "db";
+        if(!fs::exists(dir))
+            continue;
+        for(const auto& entry : fs::directory_iterator(dir))
+            inputs[entry.path().filename().string()].push_back(entry.path().string());
+    }
+
+    fs::create_directories(db_dir);
+    for(auto& item : inputs)
+    {
+        const auto output = (db_dir / item.first).string();
+        auto& paths       = item.second;
+        if(fs::exists(output))
+            paths.insert(paths.begin(), output);
+
+        if(miopen::EndsWith(output, ".udb"))
+        {
+#if MIOPEN_ENABLE_SQLITE
+            paths.erase(std::remove(paths.begin(), paths.end(), output), paths.end());
+            miopen::DbMerger::MergeSQLite(paths, output, {});
+#endif
+            continue;
+        }
+        if(!miopen::EndsWith(output, ".txt"))
+            continue;
+
+        auto options    = miopen::DbMerger::Options{};
+        options.find_db = miopen::EndsWith(output, ".ufdb.txt");
+        auto merger     = miopen::DbMerger{options};
+        merger.AddText(paths);
+        merger.WriteText(output);
+        std::cerr << "Merged " << paths.size() << " dbs into " << output << ": "
+                  << merger.GetCount() << " records" << std::endl;
+    }
+}
+
+} // namespace
+
+bool IsCompileOnly(const json& job)
+{
+    static const auto gpu_free = std::set<std::string>{
+        "applicability", "get_solvers", "miopen_find_compile"};
+    if(!job.contains("steps"))
+        return false;
+    return std::all_of(job["steps"].begin(), job["steps"].end(), [](const json& step) {
+        return gpu_free.count(step.get<std::string>()) != 0;
+    });
+}
+
+SchedulerOptions ParseSchedulerArgs(const std::vector<std::string>& args)
+{
+    auto result = SchedulerOptions{};
+    for(std::size_t i = 1; i < args.size(); ++i)
+    {
+        const auto& arg  = args[i];
+        const auto value = [&]() {
+            if(i + 1 >= args.size())
+                FIN_THROW("Missing the value of " + arg);
+            return args[++i];
+        };
+        if(arg == "--parallel")
+            continue;
+        else if(arg == "-i")
+            result.input = value();
+        else if(arg == "-o")
+            result.output = value();
+        else if(arg == "-j")
+            result.cpu_workers = std::stoi(value());
+        else if(arg == "-g")
+            result.gpus = std::stoi(value());
+        else if(arg == "--chunk")
+            result.chunk = std::max(1, std::stoi(value()));
+        else if(arg == "--db-dir")
+            result.db_dir = value();
+        else if(arg == "--work-dir")
+            result.work_dir = value();
+        else if(arg == "--compile-fin")
+            result.compile_fin = value();
+        else
+            FIN_THROW("Invalid argument: " + arg);
+    }
+    if(result.input.empty() || result.output.empty())
+        FIN_THROW("The input and the output are required");
+    return result;
+}
+
+int RunScheduler(SchedulerOptions options, char* envp[])
+{
+    if(options.cpu_workers <= 0)
+        options.cpu_workers = std::max(1U, std::thread::hardware_concurrency());
+    if(options.gpus <= 0)
+        options.gpus = GetDeviceCount();
+    if(options.work_dir.empty())
+        options.work_dir = options.output + ".work";
+    if(options.db_dir.empty())
+        options.db_dir = miopen::GetUserDbPath();
+    if(options.fin.empty())
+        options.fin = GetSelfPath();
+    if(options.compile_fin.empty())
+        options.compile_fin = options.fin;
+
+    auto jobs = json{};
+    {
+        std::ifstream file{options.input};
+        if(!file)
+            FIN_THROW("Error loading json file: " + options.input);
+        file >> jobs;
+    }
+
+    // Contiguous chunks of each kind, the compile ones first since they are usually the most.
+    auto compile_queue = std::deque<Chunk>{};
+    auto gpu_queue     = std::deque<Chunk>{};
+    for(std::size_t i = 0; i < jobs.size(); ++i)
+    {
+        const auto compile_only = IsCompileOnly(jobs[i]);
+        auto& queue             = compile_only ? compile_queue : gpu_queue;
+        if(queue.empty() || queue.back().jobs.size() >= static_cast<std::size_t>(options.chunk))
+            queue.push_back({{}, compile_only, false});
+        queue.back().jobs.push_back(i);
+    }
+    std::cerr << "Scheduling " << jobs.size() << " jobs in " << compile_queue.size()
+              << " compile chunks on " << options.cpu_workers << " processes and "
+              << gpu_queue.size() << " chunks on " << options.gpus << " GPUs" << std::endl;
+
+    const auto work_dir = fs::path{options.work_dir};
+    auto slots          = std::vector<Slot>{};
+    for(auto i = 0; i < options.gpus; ++i)
+        slots.push_back({true, i, work_dir / ("gpu" + std::to_string(i))});
+    for(auto i = 0; i < options.cpu_workers; ++i)
+        slots.push_back({false, -1, work_dir / ("cpu" + std::to_string(i))});
+    for(const auto& slot : slots)
+        fs::create_directories(slot.dir / "db");
+
+    auto results = std::vector<json>(jobs.size());
+    auto next_id = 0;
+
+    const auto start = [&](Slot& slot) {
+        auto& queue = slot.gpu ? gpu_queue : compile_queue;
+        if(queue.empty())
+            return;
+        slot.chunk = std::move(queue.front());
+        queue.pop_front();
+
+        const auto name  = "chunk" + std::to_string(next_id++);
+        const auto input = slot.dir / (name + ".json");
+        slot.output      = slot.dir / (name + ".out.json");
+        auto chunk_jobs  = json::array();
+        for(const auto job : slot.chunk.jobs)
+            chunk_jobs.push_back(jobs[job]);
+        std::ofstream(input.string()) << chunk_jobs;
+
+        auto overrides = std::map<std::string, std::string>{
+            {"MIOPEN_USER_DB_PATH", (slot.dir / "db").string()},
+            {"MIOPEN_CUSTOM_CACHE_DIR", (slot.dir / "cache").string()}};
+        if(slot.gpu)
+            overrides["HIP_VISIBLE_DEVICES"] = std::to_string(slot.device);
+        const auto& exe = slot.gpu ? options.fin : options.compile_fin;
+        const auto args =
+            std::vector<std::string>{exe, "-i", input.string(), "-o", slot.output.string()};
+        slot.pid = Spawn(exe, args, MakeEnv(envp, overrides), slot.dir / (name + ".log"));
+    };
+
+    const auto finish = [&](Slot& slot, int status) {
+        slot.pid     = 0;
+        auto outputs = json{};
+        if(WIFEXITED(status) && WEXITSTATUS(status) == 0)
+        {
+            std::ifstream file{slot.output.string()};
+            outputs = json::parse(file, nullptr, false);
+        }
+        // The first item of an output is the environment of the process.
+        if(outputs.is_array() && outputs.size() == slot.chunk.jobs.size() + 1)
+        {
+            for(std::size_t i = 0; i < slot.chunk.jobs.size(); ++i)
+                results[slot.chunk.jobs[i]] = outputs[i + 1];
+            return;
+        }
+
+        const auto reason = "fin worker failed with status " + std::to_string(status);
+        std::cerr << reason << ", see the logs in " << slot.dir << std::endl;
+        auto& queue = slot.gpu ? gpu_queue : compile_queue;
+        for(const auto job : slot.chunk.jobs)
+        {
+            if(slot.chunk.jobs.size() > 1 && !slot.chunk.retry)
+                queue.push_back({{job}, slot.chunk.compile_only, true});
+            else
+                results[job] = FailedResult(jobs[job], reason);
+        }
+    };
+
+    auto running = 0;
+    for(;;)
+    {
+        for(auto& slot : slots)
+        {
+            if(slot.pid == 0)
+            {
+                start(slot);
+                running += slot.pid != 0 ? 1 : 0;
+            }
+        }
+        if(running == 0)
+            break;
+
+        auto status    = 0;
+        const auto pid = waitpid(-1, &status, 0);
+        if(pid < 0)
+            FIN_THROW("waitpid failed");
+        auto slot = std::find_if(
+            slots.begin(), slots.end(), [&](const Slot& s) { return s.pid == pid; });
+        if(slot == slots.end())
+            continue;
+        --running;
+        finish(*slot, status);
+    }
+
+    auto final_output = json::array();
+    {
+        auto jenv = std::vector<std::string>{};
+        for(auto env = envp; *env != nullptr; env++)
+            jenv.push_back(*env);
+        auto res_item           = json{};
+        res_item["process_env"] = jenv;
+        final_output.push_back(res_item);
+    }
+    for(auto& result : results)
+        final_output.push_back(std::move(result));
+
+    std::ofstream output_file{options.output};
+    if(!output_file)
+        FIN_THROW("Error opening json file: " + options.output);
+    output_file << std::setw(4) << final_output << std::endl;
+
+    MergeDbs(slots, options.db_dir);
+    return 0;
+}
+
+} // namespace fin
@@ -54,13 +54,17 @@
  * @defgroup handle
  * @defgroup LRN
  * @defgroup batchnorm
+ * @defgroup normalization
  * @defgroup activation
  * @defgroup tensor
  * @defgroup softmax
+ * @defgroup attention
  * @defgroup RNN
  * @defgroup fusion
  * @defgroup LossFunction
  * @defgroup TensorReduce
+ * @defgroup gemm
+ * @defgroup find2
  *
  */
 
@@ -152,6 +156,15 @@ typedef void (*miopenDeallocatorFunction)(void* context, void* memory);
  */
 MIOPEN_EXPORT miopenStatus_t miopenGetVersion(size_t* major, size_t* minor, size_t* patch);
 
+/*! @brief Re-reads the MIOPEN_* environment variables
+ *
+ * MIOpen reads the environment once, at its first use of an environment variable. Variables set or
+ * changed by the application afterwards only take effect after this call.
+ *
+ * @return          miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRefreshEnvironment(void);
+
 /*! @brief Method to create the MIOpen handle object.
  *
  * This function creates a MIOpen handle. This is called at the very start to initialize the MIOpen
@@ -246,6 +259,115 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Enable the deterministic mode of the handle
+ *
+ * In the deterministic mode, only the solutions which produce bitwise reproducible results are
+ * selected, e.g. the ones which do not reduce with atomics. This may select slower solutions.
+ * The find-db records of the mode are kept apart from the ones of the default mode.
+ * @param handle         MIOpen handle (input)
+ * @param deterministic  Boolean to toggle the deterministic mode (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetDeterministic(miopenHandle_t handle, bool deterministic);
+
+/*! @brief Get whether the handle is in the deterministic mode
+ *
+ * @param handle         MIOpen handle (input)
+ * @param deterministic  Pointer to a boolean to contain the mode (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetDeterministic(miopenHandle_t handle, bool* deterministic);
+
+/*! @brief Get the kernel compilation statistics of the process as JSON
+ *
+ * Reports the number and the time of the kernel builds per program file, per solver and per
+ * comgr action, as well as the hits and misses of the kernel caches. If json is NULL, only the
+ * size of the buffer needed, including the terminating NUL, is returned in size.
+ * @param handle     MIOpen handle (input)
+ * @param json       Buffer to contain the NUL-terminated statistics, or NULL (output)
+ * @param size       Size of the json buffer in bytes (input), the size needed (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetCompileStatistics(miopenHandle_t handle,
+                                                        char* json,
+                                                        size_t* size);
+
+/*! @brief Get the runtime counters of the handle and of the process as JSON
+ *
+ * Reports the hits and misses of the invoker, kernel, binary and find-db caches, the number and
+ * the time in microseconds of the kernel builds and of the searches run on find-db misses, and
+ * the buffers allocated by the library, as {"handle": {...}, "process": {...}}. If json is NULL,
+ * only the size of the buffer needed, including the terminating NUL, is returned in size.
+ * @param handle     MIOpen handle (input)
+ * @param json       Buffer to contain the NUL-terminated counters, or NULL (output)
+ * @param size       Size of the json buffer in bytes (input), the size needed (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetMetrics(miopenHandle_t handle, char* json, size_t* size);
+
+/*! @brief Get the device memory held by the library for the handle as JSON
+ *
+ * Reports the current and the peak bytes of the scratch buffers, of the buffers allocated by the
+ * searches, of the buffers kept by the invokers such as transformed weights, of the loaded code
+ * objects and of the rocBLAS handles, as well as their total, as {"buffers": {"current": ...,
+ * "peak": ...}, ...}. "selected_workspace_peak" is the largest workspace required by the
+ * solutions returned first by the find and the immediate mode queries of the handle, which is
+ * enough to run them. If json is NULL, only the size of the buffer needed, including the
+ * terminating NUL, is returned in size.
+ * @param handle     MIOpen handle (input)
+ * @param json       Buffer to contain the NUL-terminated usage, or NULL (output)
+ * @param size       Size of the json buffer in bytes (input), the size needed (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetMemoryUsage(miopenHandle_t handle,
+                                                  char* json,
+                                                  size_t* size);
+
+/*! @brief Lowers the peaks reported by miopenGetMemoryUsage to the current usage
+ *
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenResetMemoryUsagePeaks(miopenHandle_t handle);
+
+/*! @brief Get the result of the asynchronous numerics checks of the handle
+ *
+ * With the 0x20 bit of MIOPEN_CHECK_NUMERICS set, the tensors of the calls are checked for NaN and
+ * infinite values on the stream of the handle without waiting for the results. This waits for the
+ * checks enqueued since the last query, reports them as configured by MIOPEN_CHECK_NUMERICS and
+ * clears the results. Setting MIOPEN_CHECK_NUMERICS_INTERVAL=<n> only checks every n-th call and
+ * MIOPEN_CHECK_NUMERICS_SAMPLE=<n> only every n-th element of the tensors.
+ * @param handle     MIOpen handle (input)
+ * @param hasNan     1 if a NaN was found since the last query, 0 otherwise (output)
+ * @param hasInf     1 if an infinite value was found since the last query, 0 otherwise (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetCheckNumericsStatus(miopenHandle_t handle,
+                                                          int* hasNan,
+                                                          int* hasInf);
+
+/*! @brief Writes the code objects loaded by the handle to a snapshot file
+ *
+ * A process restarting with the same workload restores the snapshot with
+ * miopenLoadHandleSnapshot, so that its first calls neither look up nor load the programs of
+ * the kernel cache one by one. HIP backend only.
+ * @param handle     MIOpen handle (input)
+ * @param path       Path of the snapshot file, replaced if it exists (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSaveHandleSnapshot(miopenHandle_t handle, const char* path);
+
+/*! @brief Restores the code objects of a snapshot file into the handle
+ *
+ * The file is memory-mapped and the modules are loaded in parallel. It must have been written by
+ * the same version of the library for the same target, otherwise miopenStatusBadParm is
+ * returned. HIP backend only.
+ * @param handle     MIOpen handle (input)
+ * @param path       Path of the snapshot file written by miopenSaveHandleSnapshot (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenLoadHandleSnapshot(miopenHandle_t handle, const char* path);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -322,6 +444,35 @@ MIOPEN_DECLARE_OBJECT(miopenDropoutDescriptor);
  */
 MIOPEN_DECLARE_OBJECT(miopenReduceTensorDescriptor);
 
+/*! @ingroup find2
+ * @brief Creates the miopenProblem_t type
+ *
+ * Problem is an object that describes a convolution to be solved: its descriptors and
+ * direction, without any buffers.
+ */
+MIOPEN_DECLARE_OBJECT(miopenProblem);
+
+/*! @ingroup find2
+ * @brief Creates the miopenFindOptions_t type
+ */
+MIOPEN_DECLARE_OBJECT(miopenFindOptions);
+
+/*! @ingroup find2
+ * @brief Creates the miopenSolution_t type
+ *
+ * Solution is an object that identifies the solver chosen for a problem, together with its
+ * measured time and workspace size. It can be saved to a blob and loaded back.
+ */
+MIOPEN_DECLARE_OBJECT(miopenSolution);
+
+/*! @ingroup find2
+ * @brief Creates the miopenFrozenSolution_t type
+ *
+ * Frozen solution is a solution bound to its problem, with the descriptors validated and the
+ * kernels built once, so that its runs only pass the buffers to the kernels.
+ */
+MIOPEN_DECLARE_OBJECT(miopenFrozenSolution);
+
 /*! @ingroup tensor
  * @enum miopenDataType_t
  * MIOpen floating point datatypes. Both 32-bit and 16-bit floats are supported in MIOpen.
@@ -363,6 +514,21 @@ typedef enum
     miopenTensorOpMax = 3, /*!< Maximum of tensor element pairs */
 } miopenTensorOp_t;
 
+/*! @ingroup tensor
+ * @enum miopenPrimitive_t
+ * Primitives whose native tensor layouts can be queried with miopenIsTensorLayoutNative
+ */
+typedef enum
+{
+    miopenPrimitiveConvolution = 0, /*!< Convolution forward and backward */
+    miopenPrimitiveBatchNorm   = 1, /*!< Batch normalization */
+    miopenPrimitivePooling     = 2, /*!< Pooling */
+    miopenPrimitiveLRN         = 3, /*!< Local response normalization */
+    miopenPrimitiveSoftmax     = 4, /*!< Softmax */
+    miopenPrimitiveActivation  = 5, /*!< Activation */
+    miopenPrimitiveTensorOp    = 6, /*!< Element-wise tensor operations */
+} miopenPrimitive_t;
+
 /*! @ingroup convolutions
  *  @enum miopenConvolutionMode_t
  * Convolution mode selection for convolution layer preference.
@@ -402,11 +568,15 @@ typedef enum
  * Pooling layer workspace index mode. miopenPoolingWorkspaceIndexMask mode records indices
  * indicating the max values' positions in the filter/mask. miopenPoolingWorkspaceIndexImage mode
  * records indices indicating the max values' positions in the image.
+ * miopenPoolingWorkspaceIndexMaskPacked mode records the mask indices in 4 bits when the window
+ * has at most 16 elements and the channel count is even, and in 8 bits otherwise; the index type
+ * is ignored. It is limited to 2D pooling of NHWC tensors with windows of up to 256 elements.
  */
 typedef enum
 {
-    miopenPoolingWorkspaceIndexMask  = 0, /*!< Use mask indices, 2D pooling only */
-    miopenPoolingWorkspaceIndexImage = 1, /*!< Use image indices */
+    miopenPoolingWorkspaceIndexMask       = 0, /*!< Use mask indices, 2D pooling only */
+    miopenPoolingWorkspaceIndexImage      = 1, /*!< Use image indices */
+    miopenPoolingWorkspaceIndexMaskPacked = 2, /*!< Use bit-packed mask indices, 2D NHWC only */
 } miopenPoolingWorkspaceIndexMode_t;
 
 /*! @ingroup LRN
@@ -449,6 +619,10 @@ typedef enum
     miopenActivationELU =
         9, /*!< Exponential Rectified Linear Unit \f$ \alpha * (e^{x} - 1) | x <= 0; x | x > 0 \f$
             */
+    miopenActivationGELU =
+        10, /*!< Gaussian Error Linear Unit \f$ 0.5 * x * (1 + erf(x / \sqrt{2})) \f$ */
+    miopenActivationSILU = 11, /*!< Sigmoid Linear Unit (swish) \f$ x / (1 + e^{-x}) \f$ */
+    miopenActivationMISH = 12, /*!< Mish \f$ x * tanh(log(1 + e^{x})) \f$ */
 } miopenActivationMode_t;
 
 /*! @ingroup softmax
@@ -460,6 +634,9 @@ typedef enum
     MIOPEN_SOFTMAX_FAST     = 0, /*!< straightforward softmax */
     MIOPEN_SOFTMAX_ACCURATE = 1, /*!< scaled softmax by maximum value in input domain */
     MIOPEN_SOFTMAX_LOG      = 2, /*!< log softmax */
+    MIOPEN_SOFTMAX_ONLINE   = 3, /*!< accurate softmax with the maximum and the sum of contiguous
+                                    rows found in one pass, forward only; other layouts and
+                                    the backward pass use MIOPEN_SOFTMAX_ACCURATE */
 } miopenSoftmaxAlgorithm_t;
 
 /*! @ingroup softmax
@@ -673,6 +850,40 @@ MIOPEN_EXPORT miopenStatus_t miopenOpTensor(miopenHandle_t handle,
                                             const miopenTensorDescriptor_t cDesc,
                                             void* C);
 
+/*! @brief Execute element-wise tensor operations followed by an activation in one pass
+ *
+ * This function implements: \f$ C = act ( op ( alpha1[0] * A, alpha2[0] * B ) + beta[0] * C ) \f$
+ *
+ * B may be broadcast along any of its dimensions of length 1. The tensors may be strided and
+ * have to share the fp32, fp16 or bfp16 datatype.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param tensorOp   Operation from miopenTensorOp_t (input)
+ * @param alpha1     Tensor A's floating point scaling factor, allocated on the host (input)
+ * @param aDesc      Tensor descriptor for tensor A (input)
+ * @param A          Tensor A (input)
+ * @param alpha2     Tensor B's floating point scaling factor, allocated on the host (input)
+ * @param bDesc      Tensor descriptor for tensor B (input)
+ * @param B          Tensor B (input)
+ * @param beta       Tensor C's floating point scaling factor, allocated on the host (input)
+ * @param cDesc      Tensor descriptor for tensor C (input)
+ * @param C          Tensor C (input and output)
+ * @param activDesc  Activation applied to the result, may be nullptr for none (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenOpTensorActivation(miopenHandle_t handle,
+                                                      miopenTensorOp_t tensorOp,
+                                                      const void* alpha1,
+                                                      const miopenTensorDescriptor_t aDesc,
+                                                      const void* A,
+                                                      const void* alpha2,
+                                                      const miopenTensorDescriptor_t bDesc,
+                                                      const void* B,
+                                                      const void* beta,
+                                                      const miopenTensorDescriptor_t cDesc,
+                                                      void* C,
+                                                      const miopenActivationDescriptor_t activDesc);
+
 /*! @brief Fills a tensor with a single value.
  *
  * Supported datatypes are fp32, fp16, and bfp16
@@ -717,6 +928,9 @@ MIOPEN_EXPORT miopenStatus_t miopenGetTensorNumBytes(miopenTensorDescriptor_t te
  * This function implements:
  * 1. \f$ Y = alpha * X + beta * Y \f$ for fp32 and fp16 datatype
  * 2. Vectorize/de-vectorize along channel dimension C for int8 datatype
+ * 3. \f$ Y = alpha * X + beta * Y \f$ with a conversion between the datatypes when X and Y
+ *    differ in datatype; int8, int32, fp16, fp32 and bfp16 are supported, the scaling factors
+ *    are fp32 and the conversions to integer types saturate
  *
  * Currently this is used for transforming from int8 to int8x4 vector datatypes
  *
@@ -737,6 +951,45 @@ MIOPEN_EXPORT miopenStatus_t miopenTransformTensor(miopenHandle_t handle,
                                                    const miopenTensorDescriptor_t yDesc,
                                                    void* y);
 
+/*! @brief Copies one tensor to another tensor with the dimensions permuted.
+ *
+ * The dimension i of y is the dimension perm[i] of x, so the lengths of y are the lengths of x
+ * in the permuted order. Both tensors may be strided. The data types of the tensors may differ
+ * between float, half and bfloat16, in which case the elements are converted on the way.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param xDesc      Source Tensor descriptor for tensor x (input)
+ * @param x          Source Tensor x (input)
+ * @param perm       Permutation with one entry per dimension of x (input)
+ * @param yDesc      Destination Tensor descriptor for tensor y (input)
+ * @param y          Destination Tensor y (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenTransposeTensor(miopenHandle_t handle,
+                                                   const miopenTensorDescriptor_t xDesc,
+                                                   const void* x,
+                                                   const int* perm,
+                                                   const miopenTensorDescriptor_t yDesc,
+                                                   void* y);
+
+/*! @brief Queries whether a primitive runs on a tensor in its layout without a conversion.
+ *
+ * The primitives accept only some of the layouts and strides a tensor descriptor can express,
+ * the others have to be transformed by the caller, e.g. with miopenTransposeTensor. The query
+ * lets a framework that keeps its tensors channel-last plan these conversions once for a whole
+ * network instead of finding them out layer by layer. Batch normalization runs channel-last
+ * tensors in the spatial mode only, and local response normalization in the cross-channel mode
+ * only.
+ *
+ * @param primitive  Primitive that is going to use the tensor (input)
+ * @param tensorDesc Tensor descriptor (input)
+ * @param isNative   True when the primitive runs on the tensor as it is (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenIsTensorLayoutNative(miopenPrimitive_t primitive,
+                                                        const miopenTensorDescriptor_t tensorDesc,
+                                                        bool* isNative);
+
 /** @} */
 // CLOSEOUT TENSOR DOXYGEN GROUP
 
@@ -885,6 +1138,53 @@ miopenSetTransposeConvOutputPadding(miopenConvolutionDescriptor_t convDesc, int
 MIOPEN_EXPORT miopenStatus_t miopenSetTransposeConvNdOutputPadding(
     miopenConvolutionDescriptor_t convDesc, int spatialDim, int* adjA);
 
+/*! @brief Limits the workspace of the solutions used with the convolution descriptor
+ *
+ * The Find APIs return, and the Immediate mode APIs list, only the solutions which require no
+ * more workspace than the limit, and the GetWorkSpaceSize APIs never return more than the limit.
+ * The find-db keeps the solutions which are the fastest for their workspace, so that a tight
+ * limit still gets the best of them. By default there is no limit.
+ *
+ * @param convDesc        Convolution layer descriptor (output)
+ * @param workspaceLimit  Workspace limit in bytes (input)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetConvolutionWorkspaceLimit(
+    miopenConvolutionDescriptor_t convDesc, size_t workspaceLimit);
+
+/*! @brief Returns the workspace limit set by miopenSetConvolutionWorkspaceLimit()
+ *
+ * @param convDesc        Convolution layer descriptor (input)
+ * @param workspaceLimit  Pointer to the workspace limit in bytes (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetConvolutionWorkspaceLimit(
+    miopenConvolutionDescriptor_t convDesc, size_t* workspaceLimit);
+
+/*! @brief Declares the weights used with the convolution descriptor constant
+ *
+ * Intended for inference. Solvers which transform the filter, such as the multi-pass Winograd
+ * ones, transform every weight tensor once on its first use and keep the result in device memory
+ * owned by the library, so that the following calls neither transform the filter nor need the
+ * workspace for it. While enabled, the contents of a weight buffer must not change and its
+ * address must not be reused for other weights. Disabled by default.
+ *
+ * @param convDesc        Convolution layer descriptor (output)
+ * @param constant        1 if the weights are constant, 0 otherwise (input)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenSetConvolutionConstantWeights(miopenConvolutionDescriptor_t convDesc, int constant);
+
+/*! @brief Returns the value set by miopenSetConvolutionConstantWeights()
+ *
+ * @param convDesc        Convolution layer descriptor (input)
+ * @param constant        Pointer to 1 if the weights are constant, 0 otherwise (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenGetConvolutionConstantWeights(miopenConvolutionDescriptor_t convDesc, int* constant);
+
 /*! @brief Get the shape of a resulting 4-D tensor from a 2-D convolution
  *
  * This function returns the dimensions of the resulting 4D tensor of a 2D
@@ -1087,6 +1387,76 @@ miopenConvolutionForwardGetSolution(miopenHandle_t handle,
                                     size_t* solutionCount,
                                     miopenConvSolution_t* solutions);
 
+/*! @brief Query the applicable solutions with their run times predicted by a cost model
+ *
+ * Like miopenConvolutionForwardGetSolution, but neither find-db is consulted nor anything is
+ * run or compiled: every applicable solution is returned with the time predicted for the device
+ * of the handle from its peak rates and the efficiency estimated for the solution, and with its
+ * workspace size. The solutions are sorted by the predicted time, which is only meant to compare
+ * them and other problems against each other. The maximum length of the solutions array may be
+ * queried using miopenConvolutionForwardGetSolutionCount.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param maxSolutionCount The size of the solutions array passed in below (input)
+ * @param solutionCount The size of the solutions array returned (output)
+ * @param solutions      A pointer to an array of type miopenConvSolution_t allocated by the user,
+ *                      filled in by MIOpen with applicable solutions. (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardGetPredictedSolution(miopenHandle_t handle,
+                                             const miopenTensorDescriptor_t wDesc,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const miopenConvolutionDescriptor_t convDesc,
+                                             const miopenTensorDescriptor_t yDesc,
+                                             const size_t maxSolutionCount,
+                                             size_t* solutionCount,
+                                             miopenConvSolution_t* solutions);
+
+/*! @brief Model predicting the fastest solvers of a problem, see
+ * miopenSetConvolutionFallbackModel
+ *
+ * The features of the problem are, in this order: the direction (0 forward, 1 backward data,
+ * 2 backward weights), the data type (miopenDataType_t), 1 for non-default layouts, the number
+ * of spatial dimensions, the batch size, the channels, depth, height and width of the input,
+ * the channels, depth, height and width of the output, the depth, height and width of the
+ * filter, the vertical and horizontal padding, strides and dilations, and the group count. For
+ * the backward directions the input is dy. Depths are 1 for 2D convolutions.
+ *
+ * @param features       Features of the problem (input)
+ * @param featureCount   Number of the features (input)
+ * @param solverIds      The solvers predicted to be the fastest, the best first (output)
+ * @param maxSolverCount The size of the solverIds array (input)
+ * @param userData       The pointer passed along with the model (input)
+ * @return               Number of the solvers written to solverIds
+ */
+typedef size_t (*miopenConvFallbackModel_t)(const float* features,
+                                            size_t featureCount,
+                                            uint64_t* solverIds,
+                                            size_t maxSolverCount,
+                                            void* userData);
+
+/*! @brief Sets the model ranking the solutions of the immediate mode fallback
+ *
+ * When the find-db has no record of a problem, the Get*Solution calls return the solutions
+ * ranked by a heuristic. The solvers predicted by the model come first, in the predicted
+ * order. By default the model is a decision tree shipped for the device in the system db
+ * directory, which a model in the user db directory overrides, see the library documentation.
+ * The model is called from the threads the Get*Solution calls are made from.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param model          The model, NULL restores the default one (input)
+ * @param userData       Passed to the model (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetConvolutionFallbackModel(miopenHandle_t handle,
+                                                               miopenConvFallbackModel_t model,
+                                                               void* userData);
+
 /*! @brief Returns the workspace size required for a particular solution id.
  *
  * This is an optional call for users who may have serialized the solution id and just need the
@@ -1138,6 +1508,70 @@ miopenConvolutionForwardCompileSolution(miopenHandle_t handle,
                                         const miopenTensorDescriptor_t yDesc,
                                         const uint64_t solution_id);
 
+/*! @brief Completion callback of the asynchronous compilations of solutions
+ *
+ * Called from a background thread of the library when all the kernels of a solution are built.
+ * It must not call back into the library with the same handle.
+ * @param status     miopenStatusSuccess or the status of the first build that failed (input)
+ * @param user_data  The pointer passed along with the callback (input)
+ */
+typedef void (*miopenCompileCallback_t)(miopenStatus_t status, void* user_data);
+
+/*! @brief Schedules the compilation of the solution provided by the user, and returns
+ * without waiting for it.
+ *
+ * The kernels of the solution are built by the background compiler threads of the handle,
+ * which run up to MIOPEN_COMPILE_PARALLEL_LEVEL builds at a time, e.g. for all the layers of a
+ * model while the weights are loaded. The completion is reported by the callback, and can be
+ * polled with miopenQueryCompileSolution or waited for with miopenWaitCompileSolution. Running
+ * the solution before the completion waits for the builds.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param solution_id    ID of the solution to be compiled, as chosen by the user (input)
+ * @param callback       Called when the kernels are built, may be NULL (input)
+ * @param user_data      Passed to the callback (input)
+ * @param ticket         The ticket of the compilation (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardCompileSolutionAsync(miopenHandle_t handle,
+                                             const miopenTensorDescriptor_t wDesc,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const miopenConvolutionDescriptor_t convDesc,
+                                             const miopenTensorDescriptor_t yDesc,
+                                             const uint64_t solution_id,
+                                             miopenCompileCallback_t callback,
+                                             void* user_data,
+                                             uint64_t* ticket);
+
+/*! @brief Whether the asynchronous compilation of a solution is done
+ *
+ * @param handle         MIOpen handle the compilation was scheduled with (input)
+ * @param ticket         The ticket of the compilation (input)
+ * @param done           1 if the kernels are built, 0 otherwise (output)
+ * @param status         The status of the compilation when it is done (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenQueryCompileSolution(miopenHandle_t handle,
+                                                        uint64_t ticket,
+                                                        int* done,
+                                                        miopenStatus_t* status);
+
+/*! @brief Waits for the asynchronous compilation of a solution
+ *
+ * @param handle         MIOpen handle the compilation was scheduled with (input)
+ * @param ticket         The ticket of the compilation (input)
+ * @param status         The status of the compilation (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenWaitCompileSolution(miopenHandle_t handle,
+                                                       uint64_t ticket,
+                                                       miopenStatus_t* status);
+
 /*! @brief Executes the Forward convolution operation based on the provided solution ID.
  *
  * Supported datatypes are fp32, fp16, bfp16, and int8
@@ -1168,6 +1602,43 @@ miopenConvolutionForwardImmediate(miopenHandle_t handle,
                                   size_t workSpaceSize,
                                   const uint64_t solution_id);
 
+/*! @brief One forward convolution of miopenConvolutionForwardImmediateBatch
+ *
+ * The fields are the arguments of miopenConvolutionForwardImmediate.
+ */
+typedef struct
+{
+    miopenTensorDescriptor_t wDesc;         /*!< Tensor descriptor for weight tensor w */
+    const void* w;                          /*!< Weights tensor w */
+    miopenTensorDescriptor_t xDesc;         /*!< Tensor descriptor for input data tensor x */
+    const void* x;                          /*!< Data tensor x */
+    miopenConvolutionDescriptor_t convDesc; /*!< Convolution layer descriptor */
+    miopenTensorDescriptor_t yDesc;         /*!< Tensor descriptor for output data tensor y */
+    void* y;                                /*!< Data tensor y */
+    void* workSpace;                        /*!< Workspace tensor */
+    size_t workSpaceSize;                   /*!< Size of the memory in bytes of workSpace */
+    uint64_t solution_id;                   /*!< ID of the solution to run */
+} miopenConvolutionForwardImmediateCall_t;
+
+/*! @brief Executes several Forward convolutions based on the provided solution IDs.
+ *
+ * Equivalent to calling miopenConvolutionForwardImmediate for every element of calls in order,
+ * with less host overhead: all the calls are validated before the first launch, and the
+ * solution is only looked up once for the calls sharing their descriptors and solution ID.
+ * The kernels are launched back to back on the stream of the handle, so the batch can be
+ * recorded into a HIP graph by capturing the stream. With profiling enabled,
+ * miopenGetKernelTime returns the total time of the batch.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param calls          Array of the convolutions to run (input)
+ * @param count          Number of elements in calls (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardImmediateBatch(miopenHandle_t handle,
+                                       const miopenConvolutionForwardImmediateCall_t* calls,
+                                       size_t count);
+
 /*! @brief Query the maximum number of solutions applicable for the given input/output and weights
  *  tensor descriptor for backward Convolution w-r-t Data.
  *
@@ -1227,6 +1698,30 @@ miopenConvolutionBackwardDataGetSolution(miopenHandle_t handle,
                                          size_t* solutionCount,
                                          miopenConvSolution_t* solutions);
 
+/*! @brief Query the applicable backward data solutions with their run times predicted by a cost
+ * model, see miopenConvolutionForwardGetPredictedSolution.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param dyDesc         Tensor descriptor for data input tensor dy (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param dxDesc         Tensor descriptor for output data tensor dx (input)
+ * @param maxSolutionCount The size of the solutions array passed in below (input)
+ * @param solutionCount The size of the solutions array returned (output)
+ * @param solutions      A pointer to an array of type miopenConvSolution_t allocated by the user,
+ *                      filled in by MIOpen with applicable solutions. (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionBackwardDataGetPredictedSolution(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const miopenTensorDescriptor_t wDesc,
+                                                  const miopenConvolutionDescriptor_t convDesc,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  const size_t maxSolutionCount,
+                                                  size_t* solutionCount,
+                                                  miopenConvSolution_t* solutions);
+
 /*! @brief Returns the workspace size required for a particular solution id.
  *
  * This is an optional call for users who may have serialized the solution id and just need the
@@ -1279,6 +1774,31 @@ miopenConvolutionBackwardDataCompileSolution(miopenHandle_t handle,
                                              const miopenTensorDescriptor_t dxDesc,
                                              const uint64_t solution_id);
 
+/*! @brief Schedules the compilation of the solution provided by the user, and returns
+ * without waiting for it, see miopenConvolutionForwardCompileSolutionAsync.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param dyDesc         Tensor descriptor for data input tensor dy (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param dxDesc         Tensor descriptor for output data tensor dx (input)
+ * @param solution_id    ID of the solution to be compiled, as chosen by the user (input)
+ * @param callback       Called when the kernels are built, may be NULL (input)
+ * @param user_data      Passed to the callback (input)
+ * @param ticket         The ticket of the compilation (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionBackwardDataCompileSolutionAsync(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const miopenTensorDescriptor_t wDesc,
+                                                  const miopenConvolutionDescriptor_t convDesc,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  const uint64_t solution_id,
+                                                  miopenCompileCallback_t callback,
+                                                  void* user_data,
+                                                  uint64_t* ticket);
+
 /*! @brief Executes the Backward convolution w-r-t data  operation based on the provided solution
  * ID.
  *
@@ -1367,6 +1887,30 @@ miopenConvolutionBackwardWeightsGetSolution(miopenHandle_t handle,
                                             size_t* solutionCount,
                                             miopenConvSolution_t* solutions);
 
+/*! @brief Query the applicable backward weights solutions with their run times predicted by a
+ * cost model, see miopenConvolutionForwardGetPredictedSolution.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param dyDesc         Tensor descriptor for data tensor dy (input)
+ * @param xDesc          Tensor descriptor for data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param dwDesc         Tensor descriptor for weight tensor dw (input)
+ * @param maxSolutionCount The size of the solutions array passed in below (input)
+ * @param solutionCount The size of the solutions array returned (output)
+ * @param solutions      A pointer to an array of type miopenConvSolution_t allocated by the user,
+ *                      filled in by MIOpen with applicable solutions. (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionBackwardWeightsGetPredictedSolution(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     const miopenTensorDescriptor_t dwDesc,
+                                                     const size_t maxSolutionCount,
+                                                     size_t* solutionCount,
+                                                     miopenConvSolution_t* solutions);
+
 /*! @brief Returns the workspace size required for a particular solution id.
  *
  * This is an optional call for users who may have serialized the solution id and just need the
@@ -1418,6 +1962,31 @@ miopenConvolutionBackwardWeightsCompileSolution(miopenHandle_t handle,
                                                 const miopenTensorDescriptor_t dwDesc,
                                                 const uint64_t solution_id);
 
+/*! @brief Schedules the compilation of the solution provided by the user, and returns
+ * without waiting for it, see miopenConvolutionForwardCompileSolutionAsync.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param dyDesc         Tensor descriptor for data tensor dy (input)
+ * @param xDesc          Tensor descriptor for data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param dwDesc         Tensor descriptor for weight tensor dw (input)
+ * @param solution_id    ID of the solution to be compiled, as chosen by the user (input)
+ * @param callback       Called when the kernels are built, may be NULL (input)
+ * @param user_data      Passed to the callback (input)
+ * @param ticket         The ticket of the compilation (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionBackwardWeightsCompileSolutionAsync(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     const miopenTensorDescriptor_t dwDesc,
+                                                     const uint64_t solution_id,
+                                                     miopenCompileCallback_t callback,
+                                                     void* user_data,
+                                                     uint64_t* ticket);
+
 /*! @brief Executes the Backward convolution w-r-t weights  operation based on the provided solution
  * ID.
  *
@@ -1540,6 +2109,9 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
  * If using Group/Depthwise convolution mode, call miopenSetConvolutionGroupCount() before running
  * this.
  *
+ * The result is blended into the output as y = alpha * conv(x, w) + beta * y.
+ * With beta = 0 the output is not read.
+ *
  * @param handle         MIOpen handle (input)
  * @param alpha          Floating point scaling factor, allocated on the host (input)
  * @param xDesc          Tensor descriptor for data input tensor x (input)
@@ -1682,6 +2254,9 @@ miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
  * If using Group/Depthwise convolution mode, call miopenSetConvolutionGroupCount() before running
  * this.
  *
+ * The result is blended into the output as dx = alpha * conv_bwd(dy, w) + beta * dx.
+ * With beta = 0 the output is not read.
+ *
  * @param handle         MIOpen handle (input)
  * @param alpha          Floating point scaling factor, allocated on the host (input)
  * @param dyDesc         Tensor descriptor for data input tensor dy (input)
@@ -1806,6 +2381,9 @@ miopenFindConvolutionBackwardWeightsAlgorithm(miopenHandle_t handle,
  * If using Group/Depthwise convolution mode, call miopenSetConvolutionGroupCount() before running
  * this.
  *
+ * The result is blended into the output as dw = alpha * conv_wrw(dy, x) + beta * dw.
+ * With beta = 0 the output is not read.
+ *
  * @param handle         MIOpen handle (input)
  * @param alpha          Floating point scaling factor, allocated on the host (input)
  * @param dyDesc         Tensor descriptor for data tensor dy (input)
@@ -1913,6 +2491,40 @@ MIOPEN_EXPORT miopenStatus_t miopenSetPoolingWorkSpaceIndexMode(
 MIOPEN_EXPORT miopenStatus_t miopenGetPoolingWorkSpaceIndexMode(
     miopenPoolingDescriptor_t poolDesc, miopenPoolingWorkspaceIndexMode_t* workspace_index);
 
+/*! @brief Set the output size of an adaptive pooling layer.
+ *
+ * Output (oh, ow) of an adaptive pooling layer reduces the input region
+ * [floor(oh * H / outH), ceil((oh + 1) * H / outH)) x [floor(ow * W / outW),
+ * ceil((ow + 1) * W / outW)), so the window, padding and stride of the descriptor are ignored.
+ * An output size of 1x1 gives global pooling. Max pooling records the offset in the region with
+ * miopenPoolingWorkspaceIndexMask and the offset in the image with
+ * miopenPoolingWorkspaceIndexImage; miopenPoolingWorkspaceIndexMaskPacked is not supported.
+ * Setting the window with miopenSet2dPoolingDescriptor() clears the adaptive output size, so it
+ * must be called first.
+ *
+ * @param poolDesc     Pointer to a pooling layer descriptor (input/output)
+ * @param nbDims       Number of spatial dimensions, 2, or 0 to clear the adaptive size (input)
+ * @param outputLens   Output height and width (input)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetPoolingAdaptiveOutputSize(miopenPoolingDescriptor_t poolDesc,
+                                                                int nbDims,
+                                                                const int* outputLens);
+
+/*! @brief Get the output size of an adaptive pooling layer.
+ *
+ * @param poolDesc         Pointer to a pooling layer descriptor (input)
+ * @param nbDimsRequested  Length of outputLens (input)
+ * @param nbDims           Number of spatial dimensions, 0 for a non-adaptive layer (output)
+ * @param outputLens       Output lengths (output)
+ * @return                 miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenGetPoolingAdaptiveOutputSize(const miopenPoolingDescriptor_t poolDesc,
+                                   int nbDimsRequested,
+                                   int* nbDims,
+                                   int* outputLens);
+
 /*! @brief Sets a 2-D pooling layer descriptor details.
  *
  * Sets the window shape, padding, and stride for a previously created 2-D pooling descriptor.
@@ -2466,19 +3078,441 @@ miopenBatchNormalizationBackward(miopenHandle_t handle,
                                  const void* savedMean,
                                  const void* savedInvVariance);
 
-/** @} */
-// CLOSEOUT BATCHNORM DOXYGEN GROUP
 
-// Activation APIs
-/** @addtogroup activation
+/*! @brief Computes the local statistics of a synchronized batch normalization forward pass
  *
- *  @{
- */
-/*! @brief Creates the Activation descriptor object
+ * The forward training pass can be split into stages to normalize a mini-batch which is spread
+ * over several devices. Every device reduces its part of the mini-batch into per-channel partial
+ * sums, the caller adds them up across the devices (e.g. with an all-reduce) and passes the
+ * global sums to miopenBatchNormalizationForwardTrainingApply.
  *
- * @param activDesc Pointer to an activation tensor descriptor type
- * @return          miopenStatus_t
- */
+ * Only miopenBNSpatial is supported. The partial sums are float tensors laid out as
+ * bnScaleBiasMeanVarDesc; the local element count of a channel is N*H*W (N*D*H*W) of xDesc.
+ *
+ * @param handle                    MIOpen handle (input)
+ * @param bn_mode                   Batch normalization mode (input)
+ * @param xDesc                     Tensor descriptor for data input tensor x (input)
+ * @param x                         Data tensor x (input)
+ * @param bnScaleBiasMeanVarDesc    Tensor descriptor for BN scaling, shifting, saved variance and
+ * mean (input)
+ * @param localSum                  Per-channel sum of x (output)
+ * @param localSqSum                Per-channel sum of the squares of x (output)
+ * @return                          miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenBatchNormalizationForwardTrainingStats(miopenHandle_t handle,
+                                             miopenBatchNormMode_t bn_mode,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const void* x,
+                                             const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+                                             void* localSum,
+                                             void* localSqSum);
+
+/*! @brief Normalizes the local data with the global statistics of a synchronized forward pass
+ *
+ * Takes the per-channel sums of miopenBatchNormalizationForwardTrainingStats added up across
+ * the devices and the number of elements of a channel they cover. The running and saved results
+ * are updated as by miopenBatchNormalizationForwardTraining; the saved ones are required by
+ * miopenBatchNormalizationBackwardStats.
+ *
+ * @param handle                    MIOpen handle (input)
+ * @param bn_mode                   Batch normalization mode (input)
+ * @param alpha                     Floating point scaling factor, allocated on the host (input)
+ * @param beta                      Floating point shift factor, allocated on the host (input)
+ * @param xDesc                     Tensor descriptor for data input tensor x (input)
+ * @param x                         Data tensor x (input)
+ * @param yDesc                     Tensor descriptor for output data tensor y (input)
+ * @param y                         Data tensor y (output)
+ * @param bnScaleBiasMeanVarDesc    Tensor descriptor for BN scaling, shifting, saved variance and
+ * mean (input)
+ * @param bnScale                   Batch norm scaling, gamma, tensor (input)
+ * @param bnBias                    Batch norm bias, beta, tensor (input)
+ * @param globalSum                 Per-channel sum of x over all devices (input)
+ * @param globalSqSum               Per-channel sum of the squares of x over all devices (input)
+ * @param globalCount               Number of elements of a channel over all devices (input)
+ * @param expAvgFactor              Exponential averaging factor (input)
+ * @param resultRunningMean         Running average saved for inference (output)
+ * @param resultRunningVariance     Running variance saved for inference (output)
+ * @param epsilon                   Value to stablize inverse variance calculation (input)
+ * @param resultSaveMean            Saved mini-batch mean for backwards pass (output)
+ * @param resultSaveInvVariance     Saved mini-batch inverse variance for backwards pass (output)
+ * @return                          miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenBatchNormalizationForwardTrainingApply(miopenHandle_t handle,
+                                             miopenBatchNormMode_t bn_mode,
+                                             void* alpha,
+                                             void* beta,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const void* x,
+                                             const miopenTensorDescriptor_t yDesc,
+                                             void* y,
+                                             const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+                                             void* bnScale,
+                                             void* bnBias,
+                                             const void* globalSum,
+                                             const void* globalSqSum,
+                                             size_t globalCount,
+                                             double expAvgFactor,
+                                             void* resultRunningMean,
+                                             void* resultRunningVariance,
+                                             double epsilon,
+                                             void* resultSaveMean,
+                                             void* resultSaveInvVariance);
+
+/*! @brief Computes the local parameter gradients of a synchronized backward pass
+ *
+ * Reduces the local part of the mini-batch into per-channel partial dbias and dscale. Their sums
+ * across the devices are the gradients of bnBias and bnScale, and are passed to
+ * miopenBatchNormalizationBackwardApply.
+ *
+ * @param handle                    MIOpen handle (input)
+ * @param bn_mode                   Batch normalization mode (input)
+ * @param xDesc                     Tensor descriptor for data input tensor x (input)
+ * @param x                         Data tensor x (input)
+ * @param dyDesc                    Tensor descriptor for output data tensor y (input)
+ * @param dy                        Data tensor y (input)
+ * @param bnScaleBiasDiffDesc       Tensor descriptor for BN scaling, shifting, saved variance and
+ * mean (input)
+ * @param savedMean                 Global mean saved by the forward pass (input)
+ * @param savedInvVariance          Global inverse variance saved by the forward pass (input)
+ * @param localBiasDiff             Per-channel partial dbias (output)
+ * @param localScaleDiff            Per-channel partial dscale (output)
+ * @return                          miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenBatchNormalizationBackwardStats(miopenHandle_t handle,
+                                      miopenBatchNormMode_t bn_mode,
+                                      const miopenTensorDescriptor_t xDesc,
+                                      const void* x,
+                                      const miopenTensorDescriptor_t dyDesc,
+                                      const void* dy,
+                                      const miopenTensorDescriptor_t bnScaleBiasDiffDesc,
+                                      const void* savedMean,
+                                      const void* savedInvVariance,
+                                      void* localBiasDiff,
+                                      void* localScaleDiff);
+
+/*! @brief Computes the local data gradient of a synchronized backward pass
+ *
+ * @param handle                    MIOpen handle (input)
+ * @param bn_mode                   Batch normalization mode (input)
+ * @param alphaDataDiff             Floating point scaling factor, allocated on the host (input)
+ * @param betaDataDiff              Floating point shift factor, allocated on the host (input)
+ * @param xDesc                     Tensor descriptor for data input tensor x (input)
+ * @param x                         Data tensor x (input)
+ * @param dyDesc                    Tensor descriptor for output data tensor y (input)
+ * @param dy                        Data tensor y (input)
+ * @param dxDesc                    Tensor descriptor for output data tensor dx (input)
+ * @param dx                        Data delta tensor dx (output)
+ * @param bnScaleBiasDiffDesc       Tensor descriptor for BN scaling, shifting, saved variance and
+ * mean (input)
+ * @param bnScale                   Batch norm scaling, gamma, tensor (input)
+ * @param globalBiasDiff            Per-channel dbias over all devices (input)
+ * @param globalScaleDiff           Per-channel dscale over all devices (input)
+ * @param globalCount               Number of elements of a channel over all devices (input)
+ * @param savedMean                 Global mean saved by the forward pass (input)
+ * @param savedInvVariance          Global inverse variance saved by the forward pass (input)
+ * @return                          miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenBatchNormalizationBackwardApply(miopenHandle_t handle,
+                                      miopenBatchNormMode_t bn_mode,
+                                      const void* alphaDataDiff,
+                                      const void* betaDataDiff,
+                                      const miopenTensorDescriptor_t xDesc,
+                                      const void* x,
+                                      const miopenTensorDescriptor_t dyDesc,
+                                      const void* dy,
+                                      const miopenTensorDescriptor_t dxDesc,
+                                      void* dx,
+                                      const miopenTensorDescriptor_t bnScaleBiasDiffDesc,
+                                      const void* bnScale,
+                                      const void* globalBiasDiff,
+                                      const void* globalScaleDiff,
+                                      size_t globalCount,
+                                      const void* savedMean,
+                                      const void* savedInvVariance);
+
+/** @} */
+// CLOSEOUT BATCHNORM DOXYGEN GROUP
+
+// Layer and Group Normalization APIs
+/** @addtogroup normalization
+ *
+ *  @{
+ */
+
+/*! @brief Execute a forward layer normalization
+ *
+ * Normalizes x over the dimensions from normalizedDim on, separately for every index of the
+ * dimensions before it. The weight and the bias hold an element per normalized element. An
+ * optional residual is added to x before the normalization and an optional activation is applied
+ * after the affine transform, all in a single kernel:
+ * \f$ y = activ((x + residual - mean) * rstd * weight + bias) \f$
+ *
+ * Only fully packed float and half tensors are supported, the weight and the bias have the type
+ * of x. mean and rstd are float buffers with a value per normalized row. They may be NULL, but
+ * are needed by miopenLayerNormBackward.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param xDesc           Tensor descriptor for data input tensor x (input)
+ * @param x               Data tensor x (input)
+ * @param residual        Tensor added to x before the normalization, laid out as x, or NULL
+ *                        (input)
+ * @param weightDesc      Tensor descriptor for the weight and the bias (input)
+ * @param weight          Affine scaling tensor, or NULL together with bias (input)
+ * @param bias            Affine shift tensor, or NULL together with weight (input)
+ * @param normalizedDim   First normalized dimension of x (input)
+ * @param epsilon         Value to stabilize the inverse standard deviation calculation (input)
+ * @param activDesc       Activation applied to the output, or NULL for none (input)
+ * @param yDesc           Tensor descriptor for output data tensor y (input)
+ * @param y               Data tensor y (output)
+ * @param mean            Mean of the normalized rows, or NULL (output)
+ * @param rstd            Inverse standard deviation of the normalized rows, or NULL (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenLayerNormForward(miopenHandle_t handle,
+                                                    const miopenTensorDescriptor_t xDesc,
+                                                    const void* x,
+                                                    const void* residual,
+                                                    const miopenTensorDescriptor_t weightDesc,
+                                                    const void* weight,
+                                                    const void* bias,
+                                                    int normalizedDim,
+                                                    double epsilon,
+                                                    const miopenActivationDescriptor_t activDesc,
+                                                    const miopenTensorDescriptor_t yDesc,
+                                                    void* y,
+                                                    void* mean,
+                                                    void* rstd);
+
+/*! @brief Execute a backward layer normalization
+ *
+ * The residual sum and the activation input are recomputed from x, the residual, the weight, the
+ * bias and the saved statistics, so the forward pass keeps nothing but mean and rstd. dx is the
+ * gradient of the residual as well.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param xDesc           Tensor descriptor for data input tensor x (input)
+ * @param x               Data tensor x (input)
+ * @param residual        Residual of the forward pass, or NULL (input)
+ * @param dyDesc          Tensor descriptor for data tensor dy (input)
+ * @param dy              Gradient of the output (input)
+ * @param weightDesc      Tensor descriptor for the weight and the bias (input)
+ * @param weight          Affine scaling tensor, or NULL without the affine transform (input)
+ * @param bias            Affine shift tensor, needed with weight (input)
+ * @param normalizedDim   First normalized dimension of x (input)
+ * @param activDesc       Activation of the forward pass, or NULL for none (input)
+ * @param mean            Mean saved by the forward pass (input)
+ * @param rstd            Inverse standard deviation saved by the forward pass (input)
+ * @param dxDesc          Tensor descriptor for data tensor dx (input)
+ * @param dx              Gradient of x and of the residual (output)
+ * @param dweight         Gradient of the weight, needed with weight (output)
+ * @param dbias           Gradient of the bias, needed with weight (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenLayerNormBackward(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const void* x,
+                                                     const void* residual,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const void* dy,
+                                                     const miopenTensorDescriptor_t weightDesc,
+                                                     const void* weight,
+                                                     const void* bias,
+                                                     int normalizedDim,
+                                                     const miopenActivationDescriptor_t activDesc,
+                                                     const void* mean,
+                                                     const void* rstd,
+                                                     const miopenTensorDescriptor_t dxDesc,
+                                                     void* dx,
+                                                     void* dweight,
+                                                     void* dbias);
+
+/*! @brief Execute a forward dropout, residual add and layer normalization in one pass
+ *
+ * Computes \f$ y = activ(norm(dropout(x) + residual) * weight + bias) \f$ in the layer
+ * normalization kernel, so neither the dropout output nor the sum is written to memory. The
+ * dropout descriptor has to use MIOPEN_RNG_PHILOX without a saved mask: the mask is a function
+ * of the seed, the offset and the element index, the one of miopenDropoutForward on packed x,
+ * and miopenDropoutAddLayerNormBackward regenerates it. The other arguments are the ones of
+ * miopenLayerNormForward.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param dropoutDesc     Dropout layer descriptor (input)
+ * @param xDesc           Tensor descriptor for data input tensor x (input)
+ * @param x               Data tensor x, the dropout input (input)
+ * @param residual        Tensor added to the dropout output, laid out as x, or NULL (input)
+ * @param weightDesc      Tensor descriptor for the weight and the bias (input)
+ * @param weight          Affine scaling tensor, or NULL together with bias (input)
+ * @param bias            Affine shift tensor, or NULL together with weight (input)
+ * @param normalizedDim   First normalized dimension of x (input)
+ * @param epsilon         Value to stabilize the inverse standard deviation calculation (input)
+ * @param activDesc       Activation applied to the output, or NULL for none (input)
+ * @param yDesc           Tensor descriptor for output data tensor y (input)
+ * @param y               Data tensor y (output)
+ * @param mean            Mean of the normalized rows, or NULL (output)
+ * @param rstd            Inverse standard deviation of the normalized rows, or NULL (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenDropoutAddLayerNormForward(miopenHandle_t handle,
+                                 const miopenDropoutDescriptor_t dropoutDesc,
+                                 const miopenTensorDescriptor_t xDesc,
+                                 const void* x,
+                                 const void* residual,
+                                 const miopenTensorDescriptor_t weightDesc,
+                                 const void* weight,
+                                 const void* bias,
+                                 int normalizedDim,
+                                 double epsilon,
+                                 const miopenActivationDescriptor_t activDesc,
+                                 const miopenTensorDescriptor_t yDesc,
+                                 void* y,
+                                 void* mean,
+                                 void* rstd);
+
+/*! @brief Execute the backward pass of miopenDropoutAddLayerNormForward in one pass
+ *
+ * The dropout mask and the residual sum are recomputed, dx is the gradient of x through the
+ * dropout and dresidual the gradient of the residual.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param dropoutDesc     Dropout layer descriptor of the forward pass (input)
+ * @param xDesc           Tensor descriptor for data input tensor x (input)
+ * @param x               Data tensor x (input)
+ * @param residual        Residual of the forward pass, or NULL (input)
+ * @param dyDesc          Tensor descriptor for data tensor dy (input)
+ * @param dy              Gradient of the output (input)
+ * @param weightDesc      Tensor descriptor for the weight and the bias (input)
+ * @param weight          Affine scaling tensor, or NULL without the affine transform (input)
+ * @param bias            Affine shift tensor, needed with weight (input)
+ * @param normalizedDim   First normalized dimension of x (input)
+ * @param activDesc       Activation of the forward pass, or NULL for none (input)
+ * @param mean            Mean saved by the forward pass (input)
+ * @param rstd            Inverse standard deviation saved by the forward pass (input)
+ * @param dxDesc          Tensor descriptor for data tensor dx and dresidual (input)
+ * @param dx              Gradient of x (output)
+ * @param dresidual       Gradient of the residual, needed with residual (output)
+ * @param dweight         Gradient of the weight, needed with weight (output)
+ * @param dbias           Gradient of the bias, needed with weight (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenDropoutAddLayerNormBackward(miopenHandle_t handle,
+                                  const miopenDropoutDescriptor_t dropoutDesc,
+                                  const miopenTensorDescriptor_t xDesc,
+                                  const void* x,
+                                  const void* residual,
+                                  const miopenTensorDescriptor_t dyDesc,
+                                  const void* dy,
+                                  const miopenTensorDescriptor_t weightDesc,
+                                  const void* weight,
+                                  const void* bias,
+                                  int normalizedDim,
+                                  const miopenActivationDescriptor_t activDesc,
+                                  const void* mean,
+                                  const void* rstd,
+                                  const miopenTensorDescriptor_t dxDesc,
+                                  void* dx,
+                                  void* dresidual,
+                                  void* dweight,
+                                  void* dbias);
+
+/*! @brief Execute a forward group normalization
+ *
+ * Splits the channels of every sample into numGroups groups and normalizes each of them over its
+ * channels and spatial dimensions. The weight and the bias hold an element per channel. The
+ * residual, the activation and the statistics are handled as by miopenLayerNormForward, mean and
+ * rstd hold N * numGroups values.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param xDesc           Tensor descriptor for data input tensor x (input)
+ * @param x               Data tensor x (input)
+ * @param residual        Tensor added to x before the normalization, laid out as x, or NULL
+ *                        (input)
+ * @param weightDesc      Tensor descriptor for the weight and the bias (input)
+ * @param weight          Affine scaling tensor, or NULL together with bias (input)
+ * @param bias            Affine shift tensor, or NULL together with weight (input)
+ * @param numGroups       Number of groups the channels are split into (input)
+ * @param epsilon         Value to stabilize the inverse standard deviation calculation (input)
+ * @param activDesc       Activation applied to the output, or NULL for none (input)
+ * @param yDesc           Tensor descriptor for output data tensor y (input)
+ * @param y               Data tensor y (output)
+ * @param mean            Mean of the groups, or NULL (output)
+ * @param rstd            Inverse standard deviation of the groups, or NULL (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGroupNormForward(miopenHandle_t handle,
+                                                    const miopenTensorDescriptor_t xDesc,
+                                                    const void* x,
+                                                    const void* residual,
+                                                    const miopenTensorDescriptor_t weightDesc,
+                                                    const void* weight,
+                                                    const void* bias,
+                                                    int numGroups,
+                                                    double epsilon,
+                                                    const miopenActivationDescriptor_t activDesc,
+                                                    const miopenTensorDescriptor_t yDesc,
+                                                    void* y,
+                                                    void* mean,
+                                                    void* rstd);
+
+/*! @brief Execute a backward group normalization
+ *
+ * The counterpart of miopenGroupNormForward, see miopenLayerNormBackward.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param xDesc           Tensor descriptor for data input tensor x (input)
+ * @param x               Data tensor x (input)
+ * @param residual        Residual of the forward pass, or NULL (input)
+ * @param dyDesc          Tensor descriptor for data tensor dy (input)
+ * @param dy              Gradient of the output (input)
+ * @param weightDesc      Tensor descriptor for the weight and the bias (input)
+ * @param weight          Affine scaling tensor, or NULL without the affine transform (input)
+ * @param bias            Affine shift tensor, needed with weight (input)
+ * @param numGroups       Number of groups the channels are split into (input)
+ * @param activDesc       Activation of the forward pass, or NULL for none (input)
+ * @param mean            Mean saved by the forward pass (input)
+ * @param rstd            Inverse standard deviation saved by the forward pass (input)
+ * @param dxDesc          Tensor descriptor for data tensor dx (input)
+ * @param dx              Gradient of x and of the residual (output)
+ * @param dweight         Gradient of the weight, needed with weight (output)
+ * @param dbias           Gradient of the bias, needed with weight (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGroupNormBackward(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const void* x,
+                                                     const void* residual,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const void* dy,
+                                                     const miopenTensorDescriptor_t weightDesc,
+                                                     const void* weight,
+                                                     const void* bias,
+                                                     int numGroups,
+                                                     const miopenActivationDescriptor_t activDesc,
+                                                     const void* mean,
+                                                     const void* rstd,
+                                                     const miopenTensorDescriptor_t dxDesc,
+                                                     void* dx,
+                                                     void* dweight,
+                                                     void* dbias);
+
+/** @} */
+// CLOSEOUT NORMALIZATION DOXYGEN GROUP
+
+// Activation APIs
+/** @addtogroup activation
+ *
+ *  @{
+ */
+/*! @brief Creates the Activation descriptor object
+ *
+ * @param activDesc Pointer to an activation tensor descriptor type
+ * @return          miopenStatus_t
+ */
 MIOPEN_EXPORT miopenStatus_t
 miopenCreateActivationDescriptor(miopenActivationDescriptor_t* activDesc);
 
@@ -2680,9 +3714,178 @@ MIOPEN_EXPORT miopenStatus_t miopenSoftmaxBackward_V2(miopenHandle_t handle,
                                                       miopenSoftmaxAlgorithm_t algorithm,
                                                       miopenSoftmaxMode_t mode);
 
+/*! @brief Execute a fused softmax cross-entropy forward layer
+ *
+ * For every row of the logits x, whose classes are the innermost dimension, computes
+ * loss = log(sum(exp(x))) - x[label] from the int32 label of the row. When dx is not NULL it also
+ * writes the gradient of the loss, softmax(x) - onehot(label), which saves a separate backward
+ * call when the gradient of every loss is one. dx may point to x to overwrite the logits. Rows
+ * whose label is outside [0, classes) get a zero loss and gradient.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param xDesc          Tensor descriptor of the logits (input)
+ * @param x              Logits, the innermost dimension are the classes (input)
+ * @param labels         int32 label of every row (input)
+ * @param losses         float loss of every row (output)
+ * @param dxDesc         Tensor descriptor of the gradient, ignored when dx is NULL (input)
+ * @param dx             Gradient of the logits, or NULL (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenSoftmaxCrossEntropyForward(miopenHandle_t handle,
+                                 const miopenTensorDescriptor_t xDesc,
+                                 const void* x,
+                                 const void* labels,
+                                 void* losses,
+                                 const miopenTensorDescriptor_t dxDesc,
+                                 void* dx);
+
+/*! @brief Execute a fused softmax cross-entropy backward layer
+ *
+ * Writes dx = dlosses[row] * (softmax(x) - onehot(label)) for every row of the logits. dx may
+ * point to x.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param xDesc          Tensor descriptor of the logits (input)
+ * @param x              Logits, the innermost dimension are the classes (input)
+ * @param labels         int32 label of every row (input)
+ * @param dlosses        float gradient of the loss of every row (input)
+ * @param dxDesc         Tensor descriptor of the gradient (input)
+ * @param dx             Gradient of the logits (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenSoftmaxCrossEntropyBackward(miopenHandle_t handle,
+                                  const miopenTensorDescriptor_t xDesc,
+                                  const void* x,
+                                  const void* labels,
+                                  const void* dlosses,
+                                  const miopenTensorDescriptor_t dxDesc,
+                                  void* dx);
+
 /** @} */
 // CLOSEOUT SOFTMAX DOXYGEN GROUP
 
+// Multi-Head Attention APIs
+/** @addtogroup attention
+ *
+ *  @{
+ */
+
+/*! @brief Execute a fused scaled dot product attention forward layer
+ *
+ * Computes \f$ o = dropout(softmax(scale * q k^T + mask)) v \f$ for every batch and head of
+ * packed [B, H, S, D] tensors, q and o with Sq queries, k and v with Sk keys, without writing the
+ * Sq x Sk probabilities to memory. The causal mask hides the keys after the query, key j is
+ * visible to query i when j <= i. lse receives the float log-sum-exp of the scores of every one
+ * of the B * H * Sq query rows, which miopenMultiHeadAttentionBackward needs. The head dimension
+ * is up to 128.
+ *
+ * The dropout descriptor, if not NULL, has to use MIOPEN_RNG_PHILOX without a saved mask: the
+ * mask of every probability is a function of the seed, the offset, the query row and the key,
+ * and the backward pass regenerates it.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param qDesc           Tensor descriptor of the queries (input)
+ * @param q               Queries (input)
+ * @param kDesc           Tensor descriptor of the keys (input)
+ * @param k               Keys (input)
+ * @param vDesc           Tensor descriptor of the values, lengths of the keys (input)
+ * @param v               Values (input)
+ * @param scale           Scale of the scores, usually 1 / sqrt(D) (input)
+ * @param causal          Whether to apply the causal mask (input)
+ * @param dropoutDesc     Dropout of the probabilities, or NULL (input)
+ * @param oDesc           Tensor descriptor of the output, lengths of the queries (input)
+ * @param o               Output (output)
+ * @param lse             float log-sum-exp of every query row (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenMultiHeadAttentionForward(miopenHandle_t handle,
+                                const miopenTensorDescriptor_t qDesc,
+                                const void* q,
+                                const miopenTensorDescriptor_t kDesc,
+                                const void* k,
+                                const miopenTensorDescriptor_t vDesc,
+                                const void* v,
+                                float scale,
+                                bool causal,
+                                const miopenDropoutDescriptor_t dropoutDesc,
+                                const miopenTensorDescriptor_t oDesc,
+                                void* o,
+                                void* lse);
+
+/*! @brief Query the workspace size of miopenMultiHeadAttentionBackward
+ *
+ * @param handle          MIOpen handle (input)
+ * @param qDesc           Tensor descriptor of the queries (input)
+ * @param workSpaceSize   Size in bytes of the workspace (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenGetMultiHeadAttentionBackwardWorkspaceSize(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t qDesc,
+                                                 size_t* workSpaceSize);
+
+/*! @brief Execute a fused scaled dot product attention backward layer
+ *
+ * Recomputes the probabilities from lse and writes the gradients of q, k and v without atomics,
+ * so the result is deterministic. The arguments shared with the forward pass have to be the ones
+ * it was called with.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param qDesc           Tensor descriptor of the queries (input)
+ * @param q               Queries (input)
+ * @param kDesc           Tensor descriptor of the keys (input)
+ * @param k               Keys (input)
+ * @param vDesc           Tensor descriptor of the values (input)
+ * @param v               Values (input)
+ * @param oDesc           Tensor descriptor of the forward output (input)
+ * @param o               Forward output (input)
+ * @param doDesc          Tensor descriptor of the output gradient (input)
+ * @param dout            Gradient of the output (input)
+ * @param lse             Log-sum-exp saved by the forward pass (input)
+ * @param scale           Scale of the scores of the forward pass (input)
+ * @param causal          Whether the forward pass applied the causal mask (input)
+ * @param dropoutDesc     Dropout descriptor of the forward pass, or NULL (input)
+ * @param dqDesc          Tensor descriptor of the query gradient (input)
+ * @param dq              Gradient of the queries (output)
+ * @param dkDesc          Tensor descriptor of the key gradient (input)
+ * @param dk              Gradient of the keys (output)
+ * @param dvDesc          Tensor descriptor of the value gradient (input)
+ * @param dv              Gradient of the values (output)
+ * @param workSpace       Pointer to the workspace (input)
+ * @param workSpaceSize   Size in bytes of the workspace (input)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenMultiHeadAttentionBackward(miopenHandle_t handle,
+                                 const miopenTensorDescriptor_t qDesc,
+                                 const void* q,
+                                 const miopenTensorDescriptor_t kDesc,
+                                 const void* k,
+                                 const miopenTensorDescriptor_t vDesc,
+                                 const void* v,
+                                 const miopenTensorDescriptor_t oDesc,
+                                 const void* o,
+                                 const miopenTensorDescriptor_t doDesc,
+                                 const void* dout,
+                                 const void* lse,
+                                 float scale,
+                                 bool causal,
+                                 const miopenDropoutDescriptor_t dropoutDesc,
+                                 const miopenTensorDescriptor_t dqDesc,
+                                 void* dq,
+                                 const miopenTensorDescriptor_t dkDesc,
+                                 void* dk,
+                                 const miopenTensorDescriptor_t dvDesc,
+                                 void* dv,
+                                 void* workSpace,
+                                 size_t workSpaceSize);
+
+/** @} */
+// CLOSEOUT ATTENTION DOXYGEN GROUP
+
 /*! @ingroup FUSION
  * @brief MIOpen fusion interface
  */
@@ -2792,6 +3995,22 @@ miopenFusionPlanConvolutionGetAlgo(miopenFusionPlanDescriptor_t fusePlanDesc,
 MIOPEN_EXPORT miopenStatus_t miopenFusionPlanConvolutionSetAlgo(
     miopenFusionPlanDescriptor_t fusePlanDesc, miopenConvFwdAlgorithm_t algo);
 
+/*! @brief Lets the fusion plan treat the parameters of its operators as constants
+ *
+ * @details With constant folding, a spatial batch normalization inference operator which follows
+ * the convolution, and optionally its bias, is folded into the weights and the bias of the
+ * convolution. The plan then runs the convolution with the fastest solution for it and the
+ * remaining operators. The parameters are folded on the first execution and again on each
+ * execution after the arguments have been set, the memory which the arguments point to must
+ * not change in between. Disabled by default, call before compiling the plan.
+ *
+ * @param fusePlanDesc A fusion plan descriptor (input)
+ * @param enable       Whether the parameters may be folded (input)
+ * @return miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFusionPlanSetConstantFolding(
+    miopenFusionPlanDescriptor_t fusePlanDesc, bool enable);
+
 /*! @brief Creates forward convolution operator.
  *
  * @param fusePlanDesc   A fusion plan descriptor (input)
@@ -2845,6 +4064,59 @@ MIOPEN_EXPORT miopenStatus_t miopenCreateOpBiasForward(miopenFusionPlanDescripto
                                                        miopenFusionOpDescriptor_t* biasOp,
                                                        const miopenTensorDescriptor_t bDesc);
 
+/*! @brief Creates a backward bias operator, which computes the gradient of the bias added to the
+ * input of the preceding backward operators, e.g. the bias of the convolution before a batch
+ * normalization and an activation. Has to be the last operator of the plan, and does not change
+ * the data.
+ *
+ * @param fusePlanDesc   A fusion plan descriptor (input)
+ * @param biasBwdOp      Pointer to an operator type (output)
+ * @param dbDesc         Bias gradient tensor descriptor (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCreateOpBiasBackward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                        miopenFusionOpDescriptor_t* biasBwdOp,
+                                                        const miopenTensorDescriptor_t dbDesc);
+
+// Elementwise create ops ---
+/*! @brief Creates a forward tensor operator, which combines its input x with a tensor B:
+ * y = op(alpha1 * x, alpha2 * B). B has the type and the number of dimensions of x, each of
+ * its lengths is either the one of x or 1 to broadcast along that dimension.
+ *
+ * @param fusePlanDesc   A fusion plan descriptor (input)
+ * @param tensorOp       Pointer to an operator type (output)
+ * @param tensorOpType   Operation of the operator (input)
+ * @param bDesc          Descriptor of the B tensor (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCreateOpTensorForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                         miopenFusionOpDescriptor_t* tensorOp,
+                                                         miopenTensorOp_t tensorOpType,
+                                                         const miopenTensorDescriptor_t bDesc);
+
+/*! @brief Creates a forward scale operator: y = alpha * x.
+ *
+ * @param fusePlanDesc   A fusion plan descriptor (input)
+ * @param scaleOp        Pointer to an operator type (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCreateOpScaleForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                        miopenFusionOpDescriptor_t* scaleOp);
+
+// Pooling create op ---
+/*! @brief Creates a forward pooling operator, which pools the output of the previous operator
+ * without writing it to memory first. Has to be the last operator of the plan.
+ *
+ * @param fusePlanDesc   A fusion plan descriptor (input)
+ * @param poolOp         Pointer to an operator type (output)
+ * @param poolDesc       Pooling layer descriptor (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateOpPoolingForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                             miopenFusionOpDescriptor_t* poolOp,
+                             const miopenPoolingDescriptor_t poolDesc);
+
 // Batch normalization create ops ---
 /*! @brief Creates a forward inference batch normalization operator.
  *
@@ -2945,7 +4217,9 @@ miopenSetOpArgsActivForward(miopenOperatorArgs_t args,
  * @param alpha   Floating point scaling factor, allocated on the host (input)
  * @param beta    Floating point shift factor, allocated on the host (input)
  * @param y        Data tensor y, output of activations in the forward direction (input)
- * @param reserved    Data tensor reserved memory space; currently should be nullptr (input)
+ * @param reserved    Data tensor x, input of activations in the forward direction. Only used
+ *                    when no batch normalization precedes the activation, e.g. before a backward
+ *                    bias operator, otherwise should be nullptr (input)
  * @param activAlpha  Double precision activation parameter which depends on activation mode (input)
  * @param activBeta   Double precision activation parameter which depends on activation mode (input)
  * @param activGamma  Double precision activation parameter which depends on activation mode (input)
@@ -3058,6 +4332,69 @@ MIOPEN_EXPORT miopenStatus_t miopenSetOpArgsBiasForward(miopenOperatorArgs_t arg
                                                         const void* alpha,
                                                         const void* beta,
                                                         const void* bias);
+
+// Bias backward set arguments ---
+/*! @brief Sets the arguments for backward bias op
+ *
+ * @param args           An arguments object type (output)
+ * @param biasBwdOp      Backward bias operator (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param beta           Floating point shift factor, allocated on the host (input)
+ * @param dbias          Pointer to the bias gradient tensor memory (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetOpArgsBiasBackward(miopenOperatorArgs_t args,
+                                                         const miopenFusionOpDescriptor_t biasBwdOp,
+                                                         const void* alpha,
+                                                         const void* beta,
+                                                         void* dbias);
+
+// Elementwise set arguments ---
+/*! @brief Sets the arguments for a forward tensor op
+ *
+ * @param args           An arguments object type (output)
+ * @param tensorOp       Forward tensor operator (input)
+ * @param alpha1         Floating point scaling factor of the input, allocated on the host (input)
+ * @param alpha2         Floating point scaling factor of B, allocated on the host (input)
+ * @param B              Pointer to the B tensor memory (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetOpArgsTensorForward(miopenOperatorArgs_t args,
+                                                          const miopenFusionOpDescriptor_t tensorOp,
+                                                          const void* alpha1,
+                                                          const void* alpha2,
+                                                          const void* B);
+
+/*! @brief Sets the arguments for a forward scale op
+ *
+ * @param args           An arguments object type (output)
+ * @param scaleOp        Forward scale operator (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetOpArgsScaleForward(miopenOperatorArgs_t args,
+                                                         const miopenFusionOpDescriptor_t scaleOp,
+                                                         const void* alpha);
+
+// Pooling set arguments ---
+/*! @brief Sets the arguments for a forward pooling op
+ *
+ * @details The workspace is optional. When it is set for max pooling, the indices of the
+ * maxima are saved in it as miopenPoolingForward does, see miopenPoolingGetWorkSpaceSizeV2 for
+ * its size, so that miopenPoolingBackward can use it.
+ *
+ * @param args           An arguments object type (output)
+ * @param poolOp         Forward pooling operator (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param beta           Floating point shift factor, allocated on the host (input)
+ * @param workSpace      Pointer to the workspace for the indices, or NULL (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetOpArgsPoolingForward(miopenOperatorArgs_t args,
+                                                           const miopenFusionOpDescriptor_t poolOp,
+                                                           const void* alpha,
+                                                           const void* beta,
+                                                           void* workSpace);
 /*! @brief Executes the fusion plan
  *
  *
@@ -3111,10 +4448,17 @@ typedef enum
  */
 typedef enum
 {
-    miopenRNNdefault = 0, /*!< Use dedicated gate-operation kernel for LSTM and fundamental
-                             algorithm for vanilla RNN & GRU */
+    miopenRNNdefault = 0, /*!< Use dedicated gate-operation kernels for LSTM & GRU and
+                             fundamental algorithm for vanilla RNN */
     miopenRNNfundamental =
         1, /*!< Function by basic tesnsor operations, supported for vanilla RNN, LSTM, GRU */
+    miopenRNNpersistent = 2, /*!< Same as miopenRNNdefault, except that unidirectional
+                                inference with a small hidden size runs all the time steps of a
+                                layer in one kernel that keeps the recurrent weights on chip */
+    miopenRNNrecompute = 3, /*!< Same as miopenRNNdefault, except that the training reserve space
+                               only keeps the input. miopenRNNBackwardData recomputes the forward
+                               pass and hands it to the following miopenRNNBackwardWeights.
+                               Dropout is not supported. */
 } miopenRNNAlgo_t;
 
 /*! @enum miopenRNNDirectionMode_t
@@ -3218,7 +4562,7 @@ MIOPEN_EXPORT miopenStatus_t miopenDestroyRNNDescriptor(miopenRNNDescriptor_t rn
  * @param rnnMode      RNN model type (input)
  * @param biasMode     RNN bias included (input)
  * @param algo         RNN algorithm selected (input)
- * @param dataType     Only fp32 currently supported for RNNs (input)
+ * @param dataType     fp32 or fp16, bfloat16 for the forward passes only (input)
  * @return             miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenSetRNNDescriptor(miopenRNNDescriptor_t rnnDesc,
@@ -3246,7 +4590,7 @@ MIOPEN_EXPORT miopenStatus_t miopenSetRNNDescriptor(miopenRNNDescriptor_t rnnDes
  * @param rnnMode      RNN model type (input)
  * @param biasMode     RNN bias included (input)
  * @param algo         RNN algorithm selected (input)
- * @param dataType     Only fp32 currently supported for RNNs (input)
+ * @param dataType     fp32 or fp16, bfloat16 for the forward passes only (input)
  * @return             miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenSetRNNDescriptor_V2(miopenRNNDescriptor_t rnnDesc,
@@ -3260,6 +4604,31 @@ MIOPEN_EXPORT miopenStatus_t miopenSetRNNDescriptor_V2(miopenRNNDescriptor_t rnn
                                                        miopenRNNAlgo_t algo,
                                                        miopenDataType_t dataType);
 
+/*! @brief Set the recurrent projection size of a LSTM descriptor
+ *
+ * With a projection, the hidden state of every step is multiplied by a [projection size,
+ * hidden size] matrix per layer and direction before it feeds the next step and layer. The hidden
+ * state tensors and the output then have the projection size, while the cell state tensors keep
+ * the hidden size. miopenGetRNNLayerParam and miopenSetRNNLayerParam address the projection
+ * matrix with paramID 8, and it follows the biases in the weights tensor. Only forward inference
+ * supports a projection so far. Setting the descriptor again removes the projection.
+ *
+ * @param rnnDesc      RNN layer descriptor of LSTM type (input/output)
+ * @param projSize     Projection size, smaller than the hidden size, or 0 to disable (input)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetRNNProjectionSize(miopenRNNDescriptor_t rnnDesc,
+                                                        const int projSize);
+
+/*! @brief Get the recurrent projection size of a RNN descriptor
+ *
+ * @param rnnDesc      RNN layer descriptor type (input)
+ * @param projSize     Projection size, 0 without projection (output)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetRNNProjectionSize(miopenRNNDescriptor_t rnnDesc,
+                                                        int* projSize);
+
 /*! @brief Query the amount of memory required to execute the RNN layer
  *
  * This function calculates the amount of memory required to run the RNN layer given an RNN
@@ -4152,6 +5521,127 @@ MIOPEN_EXPORT miopenStatus_t miopenRNNForwardInference(miopenHandle_t handle,
                                                        void* workSpace,
                                                        size_t workSpaceNumBytes);
 
+/*! @brief Query the workspace of forward inference on padded sequences
+ *
+ * @param handle          MIOpen handle (input)
+ * @param rnnDesc         RNN layer descriptor type (input)
+ * @param xDesc           A packed tensor descriptor of dimensions [sequence length, batch size,
+ * input vector length] (input)
+ * @param numBytes        Number of bytes required by miopenRNNForwardInferencePadded (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetRNNPaddedWorkspaceSize(miopenHandle_t handle,
+                                                             const miopenRNNDescriptor_t rnnDesc,
+                                                             const miopenTensorDescriptor_t xDesc,
+                                                             size_t* numBytes);
+
+/*! @brief Execute forward inference for RNN layer on padded sequences
+ *
+ * Same as miopenRNNForwardInference, except that the input and output are single tensors in
+ * which every sequence of the batch takes the whole sequence length, as frameworks hold them.
+ * The valid steps of each sequence are given by seqLengths, so no per-step descriptors and no
+ * repacking are needed.
+ *
+ * @param handle                MIOpen handle (input)
+ * @param rnnDesc               RNN layer descriptor type (input)
+ * @param seqLengths            Host array with the length of every sequence of the batch. The
+ * lengths may decrease from element n to element n+1 and not increase, and must not exceed the
+ * first dimension of xDesc. (input)
+ * @param xDesc                 A packed tensor descriptor of dimensions [sequence length, batch
+ * size, input vector length] (input)
+ * @param x                     Pointer to input tensor (input)
+ * @param hxDesc                As for miopenRNNForwardInference, the second dimension must be
+ * at least the batch size of xDesc (input)
+ * @param hx                    Pointer to the hidden layer input tensor (input)
+ * @param cxDesc                As for miopenRNNForwardInference (input)
+ * @param cx                    Pointer to the cell layer input tensor (input)
+ * @param wDesc                 A weights tensor descriptor (input)
+ * @param w                     Pointer to input weights tensor (input)
+ * @param yDesc                 A packed tensor descriptor of dimensions [sequence length, batch
+ * size, output vector length] (input)
+ * @param y                     Pointer to output tensor, zero past the end of every sequence
+ * (output)
+ * @param hyDesc                As for miopenRNNForwardInference (input)
+ * @param hy                    Pointer to the hidden layer output tensor, holding the last
+ * valid step of every sequence (output)
+ * @param cyDesc                As for miopenRNNForwardInference (input)
+ * @param cy                    Pointer to the cell layer output tensor (output)
+ * @param workSpace             Pointer to memory allocated for forward inference (input)
+ * @param workSpaceNumBytes     Number of allocated bytes in memory for the workspace, see
+ * miopenGetRNNPaddedWorkspaceSize (input)
+ * @return                      miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRNNForwardInferencePadded(miopenHandle_t handle,
+                                                             miopenRNNDescriptor_t rnnDesc,
+                                                             const int* seqLengths,
+                                                             const miopenTensorDescriptor_t xDesc,
+                                                             const void* x,
+                                                             const miopenTensorDescriptor_t hxDesc,
+                                                             const void* hx,
+                                                             const miopenTensorDescriptor_t cxDesc,
+                                                             const void* cx,
+                                                             const miopenTensorDescriptor_t wDesc,
+                                                             const void* w,
+                                                             const miopenTensorDescriptor_t yDesc,
+                                                             void* y,
+                                                             const miopenTensorDescriptor_t hyDesc,
+                                                             void* hy,
+                                                             const miopenTensorDescriptor_t cyDesc,
+                                                             void* cy,
+                                                             void* workSpace,
+                                                             size_t workSpaceNumBytes);
+
+/*! @brief Prepare the weights of a RNN layer for forward inference
+ *
+ * Copies the weights once into a buffer allocated from the handle and owned by rnnDesc, with
+ * every weight matrix transposed and its rows aligned to the GEMM tile size. The following calls
+ * to miopenRNNForwardInference and miopenRNNForwardInferencePadded on the same handle, with
+ * the same w and input vector length, read the prepared buffer instead of w. The preparation
+ * must be repeated whenever the weights change, and the buffer is released with rnnDesc or
+ * when miopenSetRNNDescriptor is called on it.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param rnnDesc         RNN layer descriptor type (input)
+ * @param xDesc           A fully packed tensor descriptor of the input, as for
+ * miopenGetRNNParamsSize (input)
+ * @param wDesc           A weights tensor descriptor (input)
+ * @param w               Pointer to the weights tensor (input)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRNNPrepareWeights(miopenHandle_t handle,
+                                                     miopenRNNDescriptor_t rnnDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenTensorDescriptor_t wDesc,
+                                                     const void* w);
+
+/*! @brief Quantize the recurrent weights of a RNN layer to int8 for forward inference
+ *
+ * Quantizes the hidden state weight matrix of every layer once into a buffer allocated from the
+ * handle and owned by rnnDesc, symmetrically with one float scale per matrix row. The following
+ * calls to miopenRNNForwardInference and miopenRNNForwardInferencePadded on the same handle,
+ * with the same w and input vector length, run the persistent kernel on the int8 weights and
+ * dequantize its dot products, while the input weights, the biases and the activations keep the
+ * data type of the network. This halves the recurrent weights of a half precision network, and
+ * lets larger hidden sizes fit the persistent kernel. When the persistent kernel is still not
+ * applicable, the weights of w are used. Supported only for the unidirectional
+ * miopenRNNpersistent algorithm without projection. The quantization must be repeated whenever
+ * the weights change, and the buffer is released with rnnDesc or when miopenSetRNNDescriptor is
+ * called on it.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param rnnDesc         RNN layer descriptor type (input)
+ * @param xDesc           A fully packed tensor descriptor of the input, as for
+ * miopenGetRNNParamsSize (input)
+ * @param wDesc           A weights tensor descriptor (input)
+ * @param w               Pointer to the weights tensor (input)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRNNPrepareQuantizedWeights(miopenHandle_t handle,
+                                                              miopenRNNDescriptor_t rnnDesc,
+                                                              const miopenTensorDescriptor_t xDesc,
+                                                              const miopenTensorDescriptor_t wDesc,
+                                                              const void* w);
+
 /** @} */
 // CLOSEOUT RNN DOXYGEN GROUP
 
@@ -4179,8 +5669,8 @@ MIOPEN_EXPORT miopenStatus_t miopenCreateCTCLossDescriptor(miopenCTCLossDescript
 /*! @brief Retrieves a CTC loss function descriptor's details
  *
  * @param ctcLossDesc          CTC loss function descriptor (input)
- * @param dataType             Data type used in this CTC loss operation, only fp32 currently
- * supported (output)
+ * @param dataType             Data type used in this CTC loss operation, fp32, fp16 or bfp16
+ * (output)
  * @param blank_label_id       User defined index for blank label (output)
  * @param apply_softmax_layer  Boolean to toggle input layer property (output)
  * @return                     miopenStatus_t
@@ -4200,8 +5690,8 @@ MIOPEN_EXPORT miopenStatus_t miopenDestroyCTCLossDescriptor(miopenCTCLossDescrip
 /*! @brief Set the details of a CTC loss function descriptor
  *
  * @param ctcLossDesc          CTC loss function descriptor type (input)
- * @param dataType             Data type used in this CTC loss operation, only fp32 currently
- * supported (input)
+ * @param dataType             Data type used in this CTC loss operation, fp32, fp16 or bfp16
+ * (input)
  * @param blank_label_id       User defined index for blank label, default 0 (input)
  * @param apply_softmax_layer  Boolean to toggle input layer property (input)
  * @return             miopenStatus_t
@@ -4241,6 +5731,9 @@ miopenGetCTCLossWorkspaceSize(miopenHandle_t handle,
 /*! @brief Execute forward inference for CTCLoss layer
  *
  * Interface for executing the forward inference pass on a CTCLoss.
+ * The probabilities may be fp32, fp16 or bfp16, the losses and gradients share their type. The
+ * alphas, betas and log-space gradients of 16-bit inputs are accumulated in fp32, and with
+ * apply_softmax_layer their log-softmax is computed from the 16-bit logits by the loss kernel.
  * @param handle         MIOpen handle (input)
  * @param probsDesc      Tensor descriptor for probabilities (input)
  * @param probs          Pointer to the probabilities tensor (input)
@@ -4271,6 +5764,135 @@ MIOPEN_EXPORT miopenStatus_t miopenCTCLoss(miopenHandle_t handle,
                                            void* workSpace,
                                            size_t workSpaceSize);
 
+/*! @brief Query the amount of memory required to execute miopenCTCLoss_V2
+ *
+ * Unlike miopenGetCTCLossWorkspaceSize the labels and their lengths are not needed, the workspace
+ * only depends on an upper bound of the label lengths.
+ * @param handle          MIOpen handle (input)
+ * @param probsDesc       Tensor descriptor for probabilities (input)
+ * @param gradientsDesc   Tensor descriptor for gradients (input)
+ * @param maxLabelLength  Upper bound of the entries of labelLengths passed to miopenCTCLoss_V2
+ * (input)
+ * @param algo            CTC loss algorithm selected (input)
+ * @param ctcLossDesc     CTC loss function descriptor type (input)
+ * @param workSpaceSize   Number of bytes of workspace required for CTC loss operation with
+ * selected algorithm (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenGetCTCLossWorkspaceSize_V2(miopenHandle_t handle,
+                                 const miopenTensorDescriptor_t probsDesc,
+                                 const miopenTensorDescriptor_t gradientsDesc,
+                                 int maxLabelLength,
+                                 miopenCTCLossAlgo_t algo,
+                                 const miopenCTCLossDescriptor_t ctcLossDesc,
+                                 size_t* workSpaceSize);
+
+/*! @brief Execute forward inference for CTCLoss layer with device-resident labels
+ *
+ * Same as miopenCTCLoss, except that labels, labelLengths and inputLengths are in device memory,
+ * so the call does not synchronize with the device to read them. The label offsets and repeats
+ * are computed on the device. The lengths are not validated: input lengths are clamped to
+ * [1, max time step], label lengths to [0, maxLabelLength] and label ids to the class range.
+ * @param handle          MIOpen handle (input)
+ * @param probsDesc       Tensor descriptor for probabilities (input)
+ * @param probs           Pointer to the probabilities tensor (input)
+ * @param labels          Device pointer to the flattened labels list (input)
+ * @param labelLengths    Device pointer to the lengths list for "labels" (input)
+ * @param inputLengths    Device pointer to the list of the time steps in each batch (input)
+ * @param maxLabelLength  Upper bound of the entries of labelLengths (input)
+ * @param losses          Pointer to the computed losses of CTC (Output)
+ * @param gradientsDesc   Tensor descriptor for gradients (input)
+ * @param gradients       Pointer to the computed gradients of CTC (Output)
+ * @param algo            CTC loss algorithm selected (input)
+ * @param ctcLossDesc     CTC loss function descriptor type (input)
+ * @param workSpace       Pointer to memory allocated for execute CTC loss operation (input)
+ * @param workSpaceSize   Number of bytes returned by miopenGetCTCLossWorkspaceSize_V2 (input)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCTCLoss_V2(miopenHandle_t handle,
+                                              const miopenTensorDescriptor_t probsDesc,
+                                              const void* probs,
+                                              const int* labels,
+                                              const int* labelLengths,
+                                              const int* inputLengths,
+                                              int maxLabelLength,
+                                              void* losses,
+                                              const miopenTensorDescriptor_t gradientsDesc,
+                                              void* gradients,
+                                              miopenCTCLossAlgo_t algo,
+                                              const miopenCTCLossDescriptor_t ctcLossDesc,
+                                              void* workSpace,
+                                              size_t workSpaceSize);
+
+/*! @enum miopenCTCDecodeMode_t
+ * Algorithms available to decode the output of a CTC trained network
+ */
+typedef enum
+{
+    MIOPEN_CTC_DECODE_GREEDY = 0, /*!< Best path: the most likely class of every time step, with
+                                     repeats merged and blanks removed */
+    MIOPEN_CTC_DECODE_BEAM_SEARCH = 1, /*!< Prefix beam search */
+} miopenCTCDecodeMode_t;
+
+/*! @brief Query the amount of memory required to execute miopenCTCDecode
+ *
+ * @param handle         MIOpen handle (input)
+ * @param ctcLossDesc    CTC loss function descriptor type (input)
+ * @param mode           Decoding algorithm (input)
+ * @param beamWidth      Number of beams, 1 for greedy decoding and at most 64 (input)
+ * @param probsDesc      Tensor descriptor for probabilities (input)
+ * @param workSpaceSize  Number of bytes of workspace required for decoding (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenGetCTCDecodeWorkspaceSize(miopenHandle_t handle,
+                                const miopenCTCLossDescriptor_t ctcLossDesc,
+                                miopenCTCDecodeMode_t mode,
+                                int beamWidth,
+                                const miopenTensorDescriptor_t probsDesc,
+                                size_t* workSpaceSize);
+
+/*! @brief Decode the output of a CTC trained network on the device
+ *
+ * The probabilities have the layout of miopenCTCLoss, [max time step, batch, class] with unit
+ * class stride. Whether they are activations or log-probabilities, and the blank id, are taken
+ * from the CTC loss descriptor. For every sample the beamWidth best sequences are written as
+ * rows of max time step ids, ordered by decreasing score, which is the natural log-probability
+ * of the sequence (of its best path for greedy decoding). Beams that could not be filled get a
+ * length of 0 and a score of -1e30.
+ *
+ * The beam search only extends the prefixes by the beamWidth most likely non-blank classes of a
+ * time step.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param ctcLossDesc     CTC loss function descriptor type (input)
+ * @param mode            Decoding algorithm (input)
+ * @param beamWidth       Number of beams, 1 for greedy decoding and at most 64 (input)
+ * @param probsDesc       Tensor descriptor for probabilities (input)
+ * @param probs           Pointer to the probabilities tensor (input)
+ * @param inputLengths    Device pointer to the time steps of each sample, clamped to
+ * [0, max time step] (input)
+ * @param decoded         Device pointer to batch x beamWidth x max time step decoded ids (output)
+ * @param decodedLengths  Device pointer to batch x beamWidth sequence lengths (output)
+ * @param scores          Device pointer to batch x beamWidth float scores (output)
+ * @param workSpace       Pointer to memory allocated for decoding (input)
+ * @param workSpaceSize   Number of bytes returned by miopenGetCTCDecodeWorkspaceSize (input)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCTCDecode(miopenHandle_t handle,
+                                             const miopenCTCLossDescriptor_t ctcLossDesc,
+                                             miopenCTCDecodeMode_t mode,
+                                             int beamWidth,
+                                             const miopenTensorDescriptor_t probsDesc,
+                                             const void* probs,
+                                             const int* inputLengths,
+                                             int* decoded,
+                                             int* decodedLengths,
+                                             float* scores,
+                                             void* workSpace,
+                                             size_t workSpaceSize);
+
 /** @} */
 // CLOSEOUT LossFunction DOXYGEN GROUP
 
@@ -4286,6 +5908,9 @@ MIOPEN_EXPORT miopenStatus_t miopenCTCLoss(miopenHandle_t handle,
 typedef enum
 {
     MIOPEN_RNG_PSEUDO_XORWOW = 0, /*!< XORWOW pseudorandom generator */
+    MIOPEN_RNG_PHILOX        = 1, /*!< counter-based Philox4x32-10 generator keyed by the seed
+                                     and the offset; it needs no states, and backward dropout
+                                     regenerates the mask when no reserveSpace is passed */
 } miopenRNGType_t;
 
 /*! @brief Creates the dropout descriptor object
@@ -4313,10 +5938,25 @@ MIOPEN_EXPORT miopenStatus_t miopenDestroyDropoutDescriptor(miopenDropoutDescrip
 MIOPEN_EXPORT miopenStatus_t miopenDropoutGetReserveSpaceSize(const miopenTensorDescriptor_t xDesc,
                                                               size_t* reserveSpaceSizeInBytes);
 
+/*! @brief Query the amount of memory required to run dropout with a given dropout descriptor
+ *
+ * Same as miopenDropoutGetReserveSpaceSize, but takes the mask format of the descriptor into
+ * account: a bit-packed mask needs one bit instead of one byte per element.
+ * @param dropoutDesc              Dropout layer descriptor (input)
+ * @param xDesc                    Tensor descriptor for data tensor x (input)
+ * @param reserveSpaceSizeInBytes  Number of bytes of reservespace required for executing dropout
+ * (Output)
+ * @return                         miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenDropoutGetReserveSpaceSize_V2(const miopenDropoutDescriptor_t dropoutDesc,
+                                    const miopenTensorDescriptor_t xDesc,
+                                    size_t* reserveSpaceSizeInBytes);
+
 /*! @brief Query the amount of memory required to store the states of the random number generators
  *
  * This function calculates the amount of memory required to store the states of the random number
- * generators used by miopenDropoutForward.
+ * generators used by miopenDropoutForward. MIOPEN_RNG_PHILOX needs no states.
  * @param handle            MIOpen handle (input)
  * @param stateSizeInBytes  Number of bytes required to store random generator states (Output)
  * @return                  miopenStatus_t
@@ -4410,6 +6050,32 @@ MIOPEN_EXPORT miopenStatus_t miopenSetDropoutDescriptor(miopenDropoutDescriptor_
                                                         bool state_evo,
                                                         miopenRNGType_t rng_mode);
 
+/*! @brief Set the counter offset of the counter-based random number generator
+ *
+ * With MIOPEN_RNG_PHILOX the mask of each element is a function of the seed, the offset and the
+ * position of the element only. Advancing the offset between training iterations draws a new
+ * mask without any state buffer, and the backward pass with the same offset gets the same mask.
+ * The offset is ignored by the other random number generators.
+ * @param dropoutDesc  Dropout layer descriptor (input/Output)
+ * @param offset       Counter offset of the random number sequence (input)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetDropoutOffset(miopenDropoutDescriptor_t dropoutDesc,
+                                                    unsigned long long offset);
+
+/*! @brief Select the bit-packed mask format of the reserve space
+ *
+ * With a packed mask, bit i of reserveSpace byte b keeps or drops element 8 * b + i of the
+ * squashed tensor, which cuts the mask traffic of forward and backward dropout by 8x. A mask
+ * passed with use_mask must then be packed the same way. Query the reserve space size with
+ * miopenDropoutGetReserveSpaceSize_V2.
+ * @param dropoutDesc  Dropout layer descriptor (input/Output)
+ * @param mask_packed  Boolean flag indicating whether the mask holds one bit per element (input)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetDropoutMaskPacked(miopenDropoutDescriptor_t dropoutDesc,
+                                                        bool mask_packed);
+
 /*! @brief Execute forward dropout operation
  *
  * Interface for executing the forward pass on a Dropout.
@@ -4601,9 +6267,503 @@ miopenReduceTensor(miopenHandle_t handle,
                    const miopenTensorDescriptor_t cDesc,
                    void* C);
 
+/*! @brief Helper function to query the minimum workspace size required by the
+ * miopenReduceTensorSegmented call
+ *
+ * @param handle                   MIOpen Handle (input)
+ * @param reduceTensorDesc         Pointer to the ReduceTensor descriptor object (input)
+ * @param aDesc                    Pointer to the input tensor descriptor (input)
+ * @param cDesc                    Pointer to the output tensor descriptor (input)
+ * @param sizeInBytes              Pointer to data to return the minimum workspace size
+ * @return                         miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenGetReductionSegmentedWorkspaceSize(miopenHandle_t handle,
+                                         const miopenReduceTensorDescriptor_t reduceTensorDesc,
+                                         const miopenTensorDescriptor_t aDesc,
+                                         const miopenTensorDescriptor_t cDesc,
+                                         size_t* sizeInBytes);
+
+/*! @brief Segmented TensorReduce of variable-length row ranges of tensor A in a single launch
+ *
+ * Segment s reduces the rows [segmentOffsets[s], segmentOffsets[s + 1]) of the leading dimension
+ * of A, so that C[s, ...] = alpha * reduceOp(A[rows of s, ...]) + beta * C[s, ...]. All the other
+ * dimensions of A and C must match, the length of the leading dimension of C is the number of
+ * segments. An empty segment gives the identity of the operation, zero for an average. With
+ * MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES the indices hold the offset in its segment of the row of
+ * each selected element. A and C are packed float, half or bfloat16 tensors of the same type.
+ *
+ * @param handle                   MIOpen Handle (input)
+ * @param reduceTensorDesc         Pointer to the ReduceTensor descriptor object (input)
+ * @param indices                  Address of the allocated indices data space (output)
+ * @param indicesSizeInBytes       Size in bytes of the allocated indices data space (input)
+ * @param workspace                Address of the allocated workspace data (input)
+ * @param workspaceSizeInBytes     Size in bytes of the allocated workspace data (input)
+ * @param segmentOffsets           Device array of ascending int32 row offsets, one more than the
+ *                                 number of segments (input)
+ * @param alpha                    Pointer to scale factor for data in input tensor A (input)
+ * @param aDesc                    Pointer to the tensor descriptor for input tensor A (input)
+ * @param A                        Pointer to the data of input tensor A (input)
+ * @param beta                     Pointer to scale factor for data in output tensor C (input)
+ * @param cDesc                    Pointer to the tensor descriptor for output tensor C (input)
+ * @param C                        Pointer to the data of output tensor C (output)
+ * @return                         miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenReduceTensorSegmented(miopenHandle_t handle,
+                            const miopenReduceTensorDescriptor_t reduceTensorDesc,
+                            void* indices,
+                            size_t indicesSizeInBytes,
+                            void* workspace,
+                            size_t workspaceSizeInBytes,
+                            const void* segmentOffsets,
+                            const void* alpha,
+                            const miopenTensorDescriptor_t aDesc,
+                            const void* A,
+                            const void* beta,
+                            const miopenTensorDescriptor_t cDesc,
+                            void* C);
+
 /** @} */
 // CLOSEOUT TensorReduce DOXYGEN GROUP
 
+/** @addtogroup gemm
+ *
+ *  @{
+ */
+
+/*! @enum miopenGemmBackend_t
+ * The library running a GEMM
+ */
+typedef enum
+{
+    miopenGemmBackendDefault = 0, /*!< The backend selected by miopenFindGemmBackend for the
+                                     GEMM, otherwise the one of the MIOpen operations */
+    miopenGemmBackendRocBlas       = 1, /*!< rocBLAS */
+    miopenGemmBackendMIOpenGEMM    = 2, /*!< MIOpenGEMM, float only */
+    miopenGemmBackendMIOpenTensile = 3, /*!< MIOpenTensile */
+    miopenGemmBackendHipBlasLt     = 4, /*!< hipBLASLt */
+} miopenGemmBackend_t;
+
+/*! @struct miopenGemmProblem_t
+ * A GEMM C = alpha * op(A) * op(B) + beta * C, where op(A), op(B) and C are m x k, k x n and
+ * m x n matrices, and op() transposes its matrix or not. A, B and C are all stored column-major
+ * or all row-major, lda, ldb and ldc being the strides across their columns, respectively rows.
+ * With batchCount > 1 the GEMM is strided batched, the matrices of the batches being strideA,
+ * strideB and strideC elements apart.
+ */
+typedef struct
+{
+    bool isColMajor;           /*!< Whether the matrices are column-major */
+    bool transA;               /*!< Whether op() transposes A */
+    bool transB;               /*!< Whether op() transposes B */
+    int m;                     /*!< Rows of op(A) and C */
+    int n;                     /*!< Columns of op(B) and C */
+    int k;                     /*!< Columns of op(A) and rows of op(B) */
+    int lda;                   /*!< Leading dimension stride of A */
+    int ldb;                   /*!< Leading dimension stride of B */
+    int ldc;                   /*!< Leading dimension stride of C */
+    int batchCount;            /*!< Number of GEMMs of the strided batch, at least 1 */
+    long long strideA;         /*!< Stride between the matrices of A of the batch */
+    long long strideB;         /*!< Stride between the matrices of B of the batch */
+    long long strideC;         /*!< Stride between the matrices of C of the batch */
+    float alpha;               /*!< Scale of op(A) * op(B) */
+    float beta;                /*!< Scale of C */
+    miopenDataType_t dataType; /*!< miopenFloat, miopenHalf or miopenBFloat16 */
+} miopenGemmProblem_t;
+
+/*! @brief Query the workspace size required by miopenGemm
+ *
+ * None of the backends take a workspace from the caller at the moment, so the size is 0. It
+ * is reported for the callers to keep working when a backend needs one.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problem        The GEMM (input)
+ * @param workSpaceSize  Number of bytes of the workspace (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGemmGetWorkSpaceSize(miopenHandle_t handle,
+                                                        const miopenGemmProblem_t* problem,
+                                                        size_t* workSpaceSize);
+
+/*! @brief Select the fastest backend of a GEMM
+ *
+ * Times the GEMM on every backend of the build, into a temporary buffer rather than C, and
+ * stores the fastest backend in the user perf-db, where miopenGemm with
+ * miopenGemmBackendDefault finds it in this and the following processes. The backends that can
+ * select among several solutions, e.g. rocBLAS, also tune the GEMM and store their solution.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problem        The GEMM (input)
+ * @param A              Matrix A of the GEMM (input)
+ * @param B              Matrix B of the GEMM (input)
+ * @param backend        The fastest backend (output)
+ * @param time           The time of the GEMM on it in ms, may be NULL (output)
+ * @return               miopenStatus_t, miopenStatusNotImplemented when no backend runs it
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFindGemmBackend(miopenHandle_t handle,
+                                                   const miopenGemmProblem_t* problem,
+                                                   const void* A,
+                                                   const void* B,
+                                                   miopenGemmBackend_t* backend,
+                                                   float* time);
+
+/*! @brief Execute a GEMM, strided batched if the batch count is larger than 1
+ *
+ * Runs through the same dispatch as the GEMMs of the MIOpen operations, including the rocBLAS
+ * solutions tuned into the perf-db.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problem        The GEMM (input)
+ * @param backend        The backend to run it on (input)
+ * @param A              Matrix A (input)
+ * @param B              Matrix B (input)
+ * @param C              Matrix C (input/output)
+ * @param workSpace      Workspace of miopenGemmGetWorkSpaceSize bytes, may be NULL if 0 (input)
+ * @param workSpaceSize  Size of the workspace in bytes (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGemm(miopenHandle_t handle,
+                                        const miopenGemmProblem_t* problem,
+                                        miopenGemmBackend_t backend,
+                                        const void* A,
+                                        const void* B,
+                                        void* C,
+                                        void* workSpace,
+                                        size_t workSpaceSize);
+
+/*! @brief Execute a group of independent GEMMs
+ *
+ * No C of a GEMM may overlap the matrices of another one. The GEMMs of the same shape, whose
+ * matrices advance by the same strides in the same buffers, run as a single strided batched
+ * GEMM, e.g. the heads of a multi-head attention. The others run one by one. Each GEMM of the
+ * group has a batch count of 1.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problemCount   Number of GEMMs (input)
+ * @param problems       Array of problemCount GEMMs (input)
+ * @param backend        The backend to run them on (input)
+ * @param A              Array of problemCount matrices A (input)
+ * @param B              Array of problemCount matrices B (input)
+ * @param C              Array of problemCount matrices C (input/output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGemmGrouped(miopenHandle_t handle,
+                                               int problemCount,
+                                               const miopenGemmProblem_t* problems,
+                                               miopenGemmBackend_t backend,
+                                               const void* const* A,
+                                               const void* const* B,
+                                               void* const* C);
+
+/** @} */
+// CLOSEOUT gemm DOXYGEN GROUP
+
+// Find 2.0 APIs
+/** @addtogroup find2
+ *
+ *  @{
+ */
+
+/*! @enum miopenProblemDirection_t
+ * Direction of the convolution described by a problem.
+ */
+typedef enum
+{
+    miopenProblemDirectionForward         = 0, /*!< Computes y from x and w */
+    miopenProblemDirectionBackward        = 1, /*!< Computes x from y and w */
+    miopenProblemDirectionBackwardWeights = 2, /*!< Computes w from x and y */
+} miopenProblemDirection_t;
+
+/*! @brief Creates a convolution problem object
+ *
+ * The descriptors are copied, so they may be destroyed right after the call. For all the
+ * directions x is the data input of the convolution, w are the weights and y is the output,
+ * the transposed convolutions follow the rules of miopenConvolutionForward.
+ *
+ * @param problem    Pointer to the problem object (output)
+ * @param convDesc   Convolution layer descriptor (input)
+ * @param direction  Direction of the convolution (input)
+ * @param xDesc      Tensor descriptor for data tensor x (input)
+ * @param wDesc      Tensor descriptor for weight tensor w (input)
+ * @param yDesc      Tensor descriptor for data tensor y (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCreateConvProblem(miopenProblem_t* problem,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     miopenProblemDirection_t direction,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenTensorDescriptor_t wDesc,
+                                                     const miopenTensorDescriptor_t yDesc);
+
+/*! @brief Destroys the problem object
+ *
+ * @param problem    Problem object (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyProblem(miopenProblem_t problem);
+
+/*! @brief Creates the options of the search for solutions, with the defaults set
+ *
+ * By default there is no tuning, no limit of workspace and no time budget.
+ *
+ * @param options    Pointer to the find options object (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCreateFindOptions(miopenFindOptions_t* options);
+
+/*! @brief Destroys the find options object
+ *
+ * @param options    Find options object (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyFindOptions(miopenFindOptions_t options);
+
+/*! @brief Enables the exhaustive search of the performance configs of the solvers
+ *
+ * @param options    Find options object (input)
+ * @param value      Non-zero to tune, zero for the fast search (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetFindOptionTuning(miopenFindOptions_t options, int value);
+
+/*! @brief Limits the workspace of the solutions to be found
+ *
+ * Solutions which need more workspace are not returned.
+ *
+ * @param options    Find options object (input)
+ * @param value      Size of the workspace in bytes (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetFindOptionWorkspaceLimit(miopenFindOptions_t options,
+                                                               size_t value);
+
+/*! @brief Limits the time spent to tune the solvers
+ *
+ * Once the budget is spent, the solvers use the best performance config found so far, or
+ * the default one.
+ *
+ * @param options    Find options object (input)
+ * @param value      Budget in milliseconds, zero for no limit (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSetFindOptionTimeBudget(miopenFindOptions_t options,
+                                                          float value);
+
+/*! @brief Finds the solutions of a problem
+ *
+ * No buffers are needed: MIOpen allocates them when kernels have to be run. When the find-db
+ * already holds the results for the problem and tuning is not requested, nothing is run nor
+ * compiled. Otherwise the applicable solvers are measured, as miopenFindConvolution*Algorithm
+ * does. Solutions are returned sorted by time, each solution shall be destroyed by the user.
+ *
+ * @param handle        MIOpen handle (input)
+ * @param problem       Problem object (input)
+ * @param options       Find options object, NULL for defaults (input)
+ * @param solutions     Array of the solution objects to be filled (output)
+ * @param numSolutions  Number of the solutions returned (output)
+ * @param maxSolutions  Size of the solutions array (input)
+ * @return              miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
+                                                 miopenProblem_t problem,
+                                                 miopenFindOptions_t options,
+                                                 miopenSolution_t* solutions,
+                                                 size_t* numSolutions,
+                                                 size_t maxSolutions);
+
+/*! @brief Finds the solutions of several problems, e.g. of all the convolutions of a network
+ *
+ * Gives the same results as miopenFindSolutions called for each problem, but the kernels of all
+ * the problems which have to be measured are compiled upfront in one parallel pass, each distinct
+ * program once, and equal problems are solved once.
+ *
+ * @param handle                  MIOpen handle (input)
+ * @param problems                Array of the problem objects (input)
+ * @param numProblems             Number of the problems (input)
+ * @param options                 Find options object, NULL for defaults (input)
+ * @param solutions               Array of numProblems * maxSolutionsPerProblem solution objects,
+ *                                the solutions of problem i start at i * maxSolutionsPerProblem
+ *                                (output)
+ * @param numSolutions            Array of the numbers of the solutions returned per problem
+ *                                (output)
+ * @param maxSolutionsPerProblem  Maximum number of the solutions per problem (input)
+ * @return                        miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                                      const miopenProblem_t* problems,
+                                                      size_t numProblems,
+                                                      miopenFindOptions_t options,
+                                                      miopenSolution_t* solutions,
+                                                      size_t* numSolutions,
+                                                      size_t maxSolutionsPerProblem);
+
+/*! @brief Destroys the solution object
+ *
+ * @param solution   Solution object (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroySolution(miopenSolution_t solution);
+
+/*! @brief Returns the time of the solution, measured or estimated, in milliseconds
+ *
+ * @param solution   Solution object (input)
+ * @param time       Pointer to the time (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetSolutionTime(miopenSolution_t solution, float* time);
+
+/*! @brief Returns the size of the workspace the solution needs
+ *
+ * @param solution       Solution object (input)
+ * @param workspaceSize  Pointer to the size in bytes (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetSolutionWorkspaceSize(miopenSolution_t solution,
+                                                            size_t* workspaceSize);
+
+/*! @brief Returns the id of the solver of the solution
+ *
+ * The id may be used with the immediate mode APIs, e.g. miopenConvolutionForwardImmediate.
+ *
+ * @param solution   Solution object (input)
+ * @param solverId   Pointer to the id (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetSolutionSolverId(miopenSolution_t solution,
+                                                       uint64_t* solverId);
+
+/*! @brief Returns the size of the blob the solution is saved to
+ *
+ * @param solution   Solution object (input)
+ * @param size       Pointer to the size in bytes (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetSolutionSize(miopenSolution_t solution, size_t* size);
+
+/*! @brief Saves the solution to a blob
+ *
+ * The blob refers to the solver by name, so it stays valid across MIOpen versions as long
+ * as the solver exists.
+ *
+ * @param solution   Solution object (input)
+ * @param data       Buffer of miopenGetSolutionSize bytes (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSaveSolution(miopenSolution_t solution, char* data);
+
+/*! @brief Loads a solution saved by miopenSaveSolution
+ *
+ * @param solution   Pointer to the solution object (output)
+ * @param data       Blob of the solution (input)
+ * @param size       Size of the blob in bytes (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenLoadSolution(miopenSolution_t* solution,
+                                                const char* data,
+                                                size_t size);
+
+/*! @brief Runs the solution of the problem
+ *
+ * Kernels of the solution are compiled on the first run unless they are cached already.
+ * The problem shall be the one the solution was found for, miopenStatusBadParm is returned
+ * otherwise. Which of x, w and y are written depends on the direction of the problem.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param solution       Solution object (input)
+ * @param problem        Problem object (input)
+ * @param x              Data tensor x (input or output)
+ * @param w              Weights tensor w (input or output)
+ * @param y              Data tensor y (input or output)
+ * @param workspace      Workspace buffer (input)
+ * @param workspaceSize  Size of the workspace buffer in bytes (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRunSolution(miopenHandle_t handle,
+                                               miopenSolution_t solution,
+                                               miopenProblem_t problem,
+                                               void* x,
+                                               void* w,
+                                               void* y,
+                                               void* workspace,
+                                               size_t workspaceSize);
+
+/*! @brief Binds the solution to the problem for repeated runs
+ *
+ * All the checks of miopenRunSolution are done here and the kernels of the solution are
+ * compiled unless they are cached already. The descriptors are copied, so the problem and the
+ * solution may be destroyed right after the call. Meant for inference, where the same layers
+ * are run many times with only the buffers changing.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problem        Problem object (input)
+ * @param solution       Solution object found for the problem (input)
+ * @param frozen         Pointer to the frozen solution (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFreezeSolution(miopenHandle_t handle,
+                                                  miopenProblem_t problem,
+                                                  miopenSolution_t solution,
+                                                  miopenFrozenSolution_t* frozen);
+
+/*! @brief Runs the frozen solution
+ *
+ * Only the buffers and the workspace size are checked. The buffers are the ones of
+ * miopenRunSolution for the problem the solution was frozen for. A frozen solution shall not be
+ * run from several threads at once.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param frozen         Frozen solution (input)
+ * @param x              Data tensor x (input or output)
+ * @param w              Weights tensor w (input or output)
+ * @param y              Data tensor y (input or output)
+ * @param workspace      Workspace buffer (input)
+ * @param workspaceSize  Size of the workspace buffer in bytes (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenRunFrozenSolution(miopenHandle_t handle,
+                                                     miopenFrozenSolution_t frozen,
+                                                     void* x,
+                                                     void* w,
+                                                     void* y,
+                                                     void* workspace,
+                                                     size_t workspaceSize);
+
+/*! @brief Transforms the weights of the frozen solution once for its following runs
+ *
+ * Solvers such as the FFT and the multi-pass Winograd ones transform the filter on every run.
+ * Given constant weights, e.g. the ones of an inference model loaded once, the transformed
+ * filter is made here into device memory owned by the frozen solution, and the following
+ * miopenRunFrozenSolution calls read it instead of their weights, which may then be null.
+ * Preparing again replaces the transformed filter. It is a no-op for the solvers which run on
+ * the weights as they are, as reported by prepared. Not supported for the backward weights
+ * problems.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param frozen         Frozen solution (input)
+ * @param w              Weights tensor w (input)
+ * @param workspace      Workspace buffer of the solution (input)
+ * @param workspaceSize  Size of the workspace buffer in bytes (input)
+ * @param prepared       True if the weights were transformed, may be NULL (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenPrepareFrozenSolutionWeights(miopenHandle_t handle,
+                                                                miopenFrozenSolution_t frozen,
+                                                                const void* w,
+                                                                void* workspace,
+                                                                size_t workspaceSize,
+                                                                bool* prepared);
+
+/*! @brief Destroys the frozen solution
+ *
+ * @param frozen         Frozen solution (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyFrozenSolution(miopenFrozenSolution_t frozen);
+
+/** @} */
+// CLOSEOUT find2 DOXYGEN GROUP
+
 #ifdef __cplusplus
 }
 #endif
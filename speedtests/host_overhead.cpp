@@ -0,0 +1,430 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Host-side overhead of the frequently called API functions, i.e. of everything MIOpen does
+// around the kernel launches. Meant for the HIPNOGPU backend, where kernels are not launched
+// and buffers are not backed by device memory, but runs with the other backends as well.
+
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/manage_ptr.hpp>
+#include <miopen/miopen.h>
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace host_overhead {
+
+using HandlePtr     = MIOPEN_MANAGE_PTR(miopenHandle_t, miopenDestroy);
+using TensorDescPtr = MIOPEN_MANAGE_PTR(miopenTensorDescriptor_t, miopenDestroyTensorDescriptor);
+using ConvDescPtr =
+    MIOPEN_MANAGE_PTR(miopenConvolutionDescriptor_t, miopenDestroyConvolutionDescriptor);
+using FusionPlanPtr = MIOPEN_MANAGE_PTR(miopenFusionPlanDescriptor_t, miopenDestroyFusionPlan);
+using OpArgsPtr     = MIOPEN_MANAGE_PTR(miopenOperatorArgs_t, miopenDestroyOperatorArgs);
+
+void Check(miopenStatus_t status, const char* what)
+{
+    if(status != miopenStatusSuccess)
+    {
+        std::cerr << what << " failed: " << miopenGetErrorString(status) << std::endl;
+        std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+    }
+}
+
+TensorDescPtr MakeTensor(int n, int c, int h, int w)
+{
+    miopenTensorDescriptor_t desc;
+    Check(miopenCreateTensorDescriptor(&desc), "miopenCreateTensorDescriptor");
+    auto ptr = TensorDescPtr{desc};
+    Check(miopenSet4dTensorDescriptor(desc, miopenFloat, n, c, h, w),
+          "miopenSet4dTensorDescriptor");
+    return ptr;
+}
+
+/// 3x3 same-padded convolution of a ResNet-like layer, followed by a bias, a ReLU or a batch
+/// normalization, with the buffers they all need.
+struct Problem
+{
+    static constexpr int n = 1;
+    static constexpr int c = 64;
+    static constexpr int h = 28;
+    static constexpr int w = 28;
+    static constexpr int k = 64;
+
+    HandlePtr handle_ptr = [] {
+        miopenHandle_t result;
+        Check(miopenCreate(&result), "miopenCreate");
+        return HandlePtr{result};
+    }();
+    miopenHandle_t handle = handle_ptr.get();
+
+    TensorDescPtr x_desc  = MakeTensor(n, c, h, w);
+    TensorDescPtr w_desc  = MakeTensor(k, c, 3, 3);
+    TensorDescPtr y_desc  = MakeTensor(n, k, h, w);
+    TensorDescPtr b_desc  = MakeTensor(1, k, 1, 1);
+    TensorDescPtr bn_desc = [this] {
+        miopenTensorDescriptor_t desc;
+        Check(miopenCreateTensorDescriptor(&desc), "miopenCreateTensorDescriptor");
+        auto ptr = TensorDescPtr{desc};
+        Check(miopenDeriveBNTensorDescriptor(desc, y_desc.get(), miopenBNSpatial),
+              "miopenDeriveBNTensorDescriptor");
+        return ptr;
+    }();
+    ConvDescPtr conv_desc = [] {
+        miopenConvolutionDescriptor_t desc;
+        Check(miopenCreateConvolutionDescriptor(&desc), "miopenCreateConvolutionDescriptor");
+        auto ptr = ConvDescPtr{desc};
+        Check(miopenInitConvolutionDescriptor(desc, miopenConvolution, 1, 1, 1, 1, 1, 1),
+              "miopenInitConvolutionDescriptor");
+        return ptr;
+    }();
+
+    Allocator::ManageDataPtr x    = Create(n * c * h * w);
+    Allocator::ManageDataPtr wei  = Create(k * c * 3 * 3);
+    Allocator::ManageDataPtr y    = Create(n * k * h * w);
+    Allocator::ManageDataPtr bias = Create(k);
+    // Scale, bias, mean and variance of the batch normalization.
+    std::vector<Allocator::ManageDataPtr> bn = [this] {
+        auto result = std::vector<Allocator::ManageDataPtr>{};
+        for(auto i = 0; i < 4; ++i)
+            result.push_back(Create(k));
+        return result;
+    }();
+
+    Allocator::ManageDataPtr Create(std::size_t floats) const
+    {
+        return deref(handle).Create(std::max<std::size_t>(floats, 1) * sizeof(float));
+    }
+
+    void Finish() const { deref(handle).Finish(); }
+};
+
+struct HostOverheadDriver : public test_driver
+{
+    HostOverheadDriver()
+    {
+        add(iterations, "iterations");
+        add(bench, "bench");
+    }
+
+    void run()
+    {
+        auto found = false;
+        for(const auto& bm : GetBenchmarks())
+        {
+            if(bench != "all" && bm.first != bench)
+                continue;
+            (this->*bm.second)();
+            found = true;
+        }
+
+        if(!found)
+        {
+            std::cerr << "Unknown benchmark." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Permitted benchmarks: all";
+        for(const auto& bm : GetBenchmarks())
+            std::cout << ", " << bm.first;
+        std::cout << std::endl;
+    }
+
+    private:
+    using Benchmark = void (HostOverheadDriver::*)();
+
+    int iterations    = 10000;
+    std::string bench = "all";
+    Problem problem;
+
+    static std::vector<std::pair<std::string, Benchmark>> GetBenchmarks()
+    {
+        return {
+            {"tensor_desc", &HostOverheadDriver::TensorDesc},
+            {"conv_desc", &HostOverheadDriver::ConvDesc},
+            {"solutions", &HostOverheadDriver::Solutions},
+            {"immediate", &HostOverheadDriver::Immediate},
+            {"find", &HostOverheadDriver::Find},
+            {"fusion", &HostOverheadDriver::Fusion},
+            {"batchnorm", &HostOverheadDriver::BatchNorm},
+            {"op_tensor", &HostOverheadDriver::OpTensor},
+        };
+    }
+
+    /// Prints the mean time of a call after a first one, which builds the kernels and fills the
+    /// caches. The queue is drained between batches of calls, out of the measured time.
+    template <class F>
+    void Measure(const std::string& name, const F& call) const
+    {
+        constexpr auto batch = 1024;
+
+        call();
+        problem.Finish();
+
+        auto time = std::chrono::steady_clock::duration{};
+        for(auto done = 0; done < iterations; done += batch)
+        {
+            const auto count = std::min(batch, iterations - done);
+            const auto start = std::chrono::steady_clock::now();
+            for(auto i = 0; i < count; ++i)
+                call();
+            time += std::chrono::steady_clock::now() - start;
+            problem.Finish();
+        }
+
+        const auto us =
+            std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(time).count();
+        std::cout << name << ": " << us / std::max(iterations, 1) << " us per call" << std::endl;
+    }
+
+    void TensorDesc()
+    {
+        Measure("tensor_desc", [] {
+            miopenTensorDescriptor_t desc;
+            Check(miopenCreateTensorDescriptor(&desc), "miopenCreateTensorDescriptor");
+            Check(miopenSet4dTensorDescriptor(
+                      desc, miopenFloat, Problem::n, Problem::c, Problem::h, Problem::w),
+                  "miopenSet4dTensorDescriptor");
+            Check(miopenDestroyTensorDescriptor(desc), "miopenDestroyTensorDescriptor");
+        });
+    }
+
+    void ConvDesc()
+    {
+        Measure("conv_desc", [&] {
+            miopenConvolutionDescriptor_t desc;
+            Check(miopenCreateConvolutionDescriptor(&desc), "miopenCreateConvolutionDescriptor");
+            Check(miopenInitConvolutionDescriptor(desc, miopenConvolution, 1, 1, 1, 1, 1, 1),
+                  "miopenInitConvolutionDescriptor");
+            int n, c, h, w;
+            Check(miopenGetConvolutionForwardOutputDim(
+                      desc, problem.x_desc.get(), problem.w_desc.get(), &n, &c, &h, &w),
+                  "miopenGetConvolutionForwardOutputDim");
+            Check(miopenDestroyConvolutionDescriptor(desc), "miopenDestroyConvolutionDescriptor");
+        });
+    }
+
+    std::vector<miopenConvSolution_t> GetSolutions() const
+    {
+        std::size_t count;
+        Check(miopenConvolutionForwardGetSolutionCount(problem.handle,
+                                                       problem.w_desc.get(),
+                                                       problem.x_desc.get(),
+                                                       problem.conv_desc.get(),
+                                                       problem.y_desc.get(),
+                                                       &count),
+              "miopenConvolutionForwardGetSolutionCount");
+        auto solutions = std::vector<miopenConvSolution_t>(count);
+        Check(miopenConvolutionForwardGetSolution(problem.handle,
+                                                  problem.w_desc.get(),
+                                                  problem.x_desc.get(),
+                                                  problem.conv_desc.get(),
+                                                  problem.y_desc.get(),
+                                                  count,
+                                                  &count,
+                                                  solutions.data()),
+              "miopenConvolutionForwardGetSolution");
+        solutions.resize(count);
+        return solutions;
+    }
+
+    void Solutions()
+    {
+        Measure("solutions", [&] { GetSolutions(); });
+    }
+
+    void Immediate()
+    {
+        const auto solutions = GetSolutions();
+        if(solutions.empty())
+        {
+            std::cout << "immediate: no solutions" << std::endl;
+            return;
+        }
+        const auto& solution = solutions.front();
+        Check(miopenConvolutionForwardCompileSolution(problem.handle,
+                                                      problem.w_desc.get(),
+                                                      problem.x_desc.get(),
+                                                      problem.conv_desc.get(),
+                                                      problem.y_desc.get(),
+                                                      solution.solution_id),
+              "miopenConvolutionForwardCompileSolution");
+        const auto workspace = problem.Create(solution.workspace_size / sizeof(float) + 1);
+
+        Measure("immediate", [&] {
+            Check(miopenConvolutionForwardImmediate(problem.handle,
+                                                    problem.w_desc.get(),
+                                                    problem.wei.get(),
+                                                    problem.x_desc.get(),
+                                                    problem.x.get(),
+                                                    problem.conv_desc.get(),
+                                                    problem.y_desc.get(),
+                                                    problem.y.get(),
+                                                    workspace.get(),
+                                                    solution.workspace_size,
+                                                    solution.solution_id),
+                  "miopenConvolutionForwardImmediate");
+        });
+    }
+
+    void Find()
+    {
+        std::size_t workspace_size;
+        Check(miopenConvolutionForwardGetWorkSpaceSize(problem.handle,
+                                                       problem.w_desc.get(),
+                                                       problem.x_desc.get(),
+                                                       problem.conv_desc.get(),
+                                                       problem.y_desc.get(),
+                                                       &workspace_size),
+              "miopenConvolutionForwardGetWorkSpaceSize");
+        const auto workspace = problem.Create(workspace_size / sizeof(float) + 1);
+
+        // The first call searches unless the find-db already has the problem.
+        Measure("find", [&] {
+            miopenConvAlgoPerf_t perf[4];
+            int count;
+            Check(miopenFindConvolutionForwardAlgorithm(problem.handle,
+                                                        problem.x_desc.get(),
+                                                        problem.x.get(),
+                                                        problem.w_desc.get(),
+                                                        problem.wei.get(),
+                                                        problem.conv_desc.get(),
+                                                        problem.y_desc.get(),
+                                                        problem.y.get(),
+                                                        4,
+                                                        &count,
+                                                        perf,
+                                                        workspace.get(),
+                                                        workspace_size,
+                                                        false),
+                  "miopenFindConvolutionForwardAlgorithm");
+        });
+    }
+
+    void Fusion()
+    {
+        miopenFusionPlanDescriptor_t plan_desc;
+        Check(miopenCreateFusionPlan(&plan_desc, miopenVerticalFusion, problem.x_desc.get()),
+              "miopenCreateFusionPlan");
+        const auto plan = FusionPlanPtr{plan_desc};
+        miopenFusionOpDescriptor_t conv_op, bias_op, activ_op;
+        Check(miopenCreateOpConvForward(
+                  plan_desc, &conv_op, problem.conv_desc.get(), problem.w_desc.get()),
+              "miopenCreateOpConvForward");
+        Check(miopenCreateOpBiasForward(plan_desc, &bias_op, problem.b_desc.get()),
+              "miopenCreateOpBiasForward");
+        Check(miopenCreateOpActivationForward(plan_desc, &activ_op, miopenActivationRELU),
+              "miopenCreateOpActivationForward");
+        if(miopenCompileFusionPlan(problem.handle, plan_desc) != miopenStatusSuccess)
+        {
+            std::cout << "fusion: the plan is not supported" << std::endl;
+            return;
+        }
+
+        miopenOperatorArgs_t args_desc;
+        Check(miopenCreateOperatorArgs(&args_desc), "miopenCreateOperatorArgs");
+        const auto args = OpArgsPtr{args_desc};
+        const float alpha = 1, beta = 0;
+        Check(miopenSetOpArgsConvForward(args_desc, conv_op, &alpha, &beta, problem.wei.get()),
+              "miopenSetOpArgsConvForward");
+        Check(miopenSetOpArgsBiasForward(args_desc, bias_op, &alpha, &beta, problem.bias.get()),
+              "miopenSetOpArgsBiasForward");
+        Check(miopenSetOpArgsActivForward(args_desc, activ_op, &alpha, &beta, 0, 0, 0),
+              "miopenSetOpArgsActivForward");
+
+        Measure("fusion", [&] {
+            Check(miopenExecuteFusionPlan(problem.handle,
+                                          plan_desc,
+                                          problem.x_desc.get(),
+                                          problem.x.get(),
+                                          problem.y_desc.get(),
+                                          problem.y.get(),
+                                          args_desc),
+                  "miopenExecuteFusionPlan");
+        });
+    }
+
+    void BatchNorm()
+    {
+        float alpha = 1, beta = 0;
+        Measure("batchnorm", [&] {
+            Check(miopenBatchNormalizationForwardInference(problem.handle,
+                                                           miopenBNSpatial,
+                                                           &alpha,
+                                                           &beta,
+                                                           problem.y_desc.get(),
+                                                           problem.y.get(),
+                                                           problem.y_desc.get(),
+                                                           problem.x.get(),
+                                                           problem.bn_desc.get(),
+                                                           problem.bn[0].get(),
+                                                           problem.bn[1].get(),
+                                                           problem.bn[2].get(),
+                                                           problem.bn[3].get(),
+                                                           1e-5),
+                  "miopenBatchNormalizationForwardInference");
+        });
+    }
+
+    void OpTensor()
+    {
+        const float alpha = 1, beta = 0;
+        Measure("op_tensor", [&] {
+            Check(miopenOpTensor(problem.handle,
+                                 miopenTensorOpAdd,
+                                 &alpha,
+                                 problem.y_desc.get(),
+                                 problem.y.get(),
+                                 &alpha,
+                                 problem.b_desc.get(),
+                                 problem.bias.get(),
+                                 &beta,
+                                 problem.y_desc.get(),
+                                 problem.x.get()),
+                  "miopenOpTensor");
+        });
+    }
+};
+
+} // namespace host_overhead
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::host_overhead::HostOverheadDriver>(argc, argv);
+    return 0;
+}
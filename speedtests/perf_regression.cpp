@@ -0,0 +1,464 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Performance regression check of the convolutions MIOpen picks by default for a curated set of
+// layers, e.g. to catch slowdowns from changes of the solver priorities or of the heuristics.
+//
+// The kernel time of the first solution of the immediate mode is sampled for each direction of
+// each layer and compared with the baseline of the device stored in
+// <baselines>/<arch>_<CUs>.txt, written by a run with --update. A layer regresses when its mean
+// time is more than --threshold slower than the baseline and Welch's test rejects the equality
+// of the means with about 99% confidence, so that noise does not fail the check.
+
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/manage_ptr.hpp>
+#include <miopen/miopen.h>
+#include <miopen/solver_id.hpp>
+#include <driver.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace perf_regression {
+
+using TensorDescPtr = MIOPEN_MANAGE_PTR(miopenTensorDescriptor_t, miopenDestroyTensorDescriptor);
+using ConvDescPtr =
+    MIOPEN_MANAGE_PTR(miopenConvolutionDescriptor_t, miopenDestroyConvolutionDescriptor);
+
+constexpr const char* baselines_header = "miopen-perf-baselines 1";
+
+void Check(miopenStatus_t status, const char* what)
+{
+    if(status != miopenStatusSuccess)
+        MIOPEN_THROW(status, std::string{what} + " failed");
+}
+
+struct ConvConfig
+{
+    int n, c, h, w, k, y, x;
+    int pad_h = 0, pad_w = 0, stride_h = 1, stride_w = 1, dilation_h = 1, dilation_w = 1;
+    int groups = 1;
+
+    std::string ToString() const
+    {
+        std::ostringstream ss;
+        ss << "n" << n << "c" << c << "h" << h << "w" << w << "-k" << k << "y" << y << "x" << x
+           << "-p" << pad_h << "q" << pad_w << "-u" << stride_h << "v" << stride_w << "-l"
+           << dilation_h << "j" << dilation_w << "-g" << groups;
+        return ss.str();
+    }
+
+    /// Parses the fp32 convolutions of MIOpenDriver commands, e.g. logged with
+    /// MIOPEN_ENABLE_LOGGING_CMD. The flags missing take the defaults of the driver.
+    static bool Parse(const std::string& line, ConvConfig& config)
+    {
+        std::istringstream ss{line.substr(std::min(line.find("MIOpenDriver "), line.size()))};
+        std::string token;
+        if(!(ss >> token) || (token == "MIOpenDriver" && !(ss >> token)) || token != "conv")
+            return false;
+
+        config = ConvConfig{100, 3, 32, 32, 32, 3, 3};
+        auto field = [&](char flag) -> int* {
+            switch(flag)
+            {
+            case 'n': return &config.n;
+            case 'c': return &config.c;
+            case 'H': return &config.h;
+            case 'W': return &config.w;
+            case 'k': return &config.k;
+            case 'y': return &config.y;
+            case 'x': return &config.x;
+            case 'p': return &config.pad_h;
+            case 'q': return &config.pad_w;
+            case 'u': return &config.stride_h;
+            case 'v': return &config.stride_w;
+            case 'l': return &config.dilation_h;
+            case 'j': return &config.dilation_w;
+            case 'g': return &config.groups;
+            default: return nullptr;
+            }
+        };
+
+        std::string value;
+        while(ss >> token >> value)
+        {
+            if(token.size() == 2 && token[0] == '-')
+            {
+                auto* const target = field(token[1]);
+                if(target != nullptr)
+                    *target = std::stoi(value);
+            }
+        }
+        return true;
+    }
+};
+
+/// ResNet-50, Inception, VGG and MobileNet layers from network_data.hpp.
+std::vector<ConvConfig> GetCuratedConfigs()
+{
+    auto with = [](ConvConfig config, int pad, int stride, int groups = 1) {
+        config.pad_h = config.pad_w = pad;
+        config.stride_h = config.stride_w = stride;
+        config.groups                     = groups;
+        return config;
+    };
+
+    return {
+        with({32, 3, 224, 224, 64, 7, 7}, 3, 2),
+        with({32, 64, 56, 56, 64, 1, 1}, 0, 1),
+        with({32, 64, 56, 56, 64, 3, 3}, 1, 1),
+        with({32, 64, 56, 56, 256, 1, 1}, 0, 1),
+        with({32, 256, 56, 56, 128, 1, 1}, 0, 2),
+        with({32, 128, 28, 28, 128, 3, 3}, 1, 1),
+        with({32, 256, 14, 14, 256, 3, 3}, 1, 1),
+        with({32, 1024, 14, 14, 256, 1, 1}, 0, 1),
+        with({32, 512, 7, 7, 512, 3, 3}, 1, 1),
+        with({32, 512, 7, 7, 2048, 1, 1}, 0, 1),
+        with({32, 192, 28, 28, 32, 5, 5}, 2, 1),
+        with({32, 832, 7, 7, 384, 1, 1}, 0, 1),
+        with({64, 128, 56, 56, 128, 3, 3}, 1, 1),
+        with({32, 32, 112, 112, 32, 3, 3}, 1, 1, 32),
+    };
+}
+
+struct Sample
+{
+    std::string solver;
+    std::size_t count = 0;
+    double mean       = 0;
+    double stddev     = 0;
+
+    static Sample FromTimes(std::string solver, const std::vector<double>& times)
+    {
+        auto result   = Sample{std::move(solver), times.size()};
+        result.mean   = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+        auto variance = 0.0;
+        for(const auto time : times)
+            variance += (time - result.mean) * (time - result.mean);
+        result.stddev = times.size() > 1 ? std::sqrt(variance / (times.size() - 1)) : 0;
+        return result;
+    }
+};
+
+using Baselines = std::map<std::string, Sample>;
+
+Baselines ReadBaselines(const std::string& path)
+{
+    auto result = Baselines{};
+    std::ifstream file{path};
+    std::string line;
+    if(!std::getline(file, line))
+        return result;
+    if(line != baselines_header)
+        MIOPEN_THROW("Unsupported baselines file: " + path);
+
+    while(std::getline(file, line))
+    {
+        std::istringstream ss{line};
+        std::string key;
+        auto sample = Sample{};
+        if(ss >> key >> sample.solver >> sample.count >> sample.mean >> sample.stddev)
+            result.emplace(key, sample);
+    }
+    return result;
+}
+
+void WriteBaselines(const std::string& path, const Baselines& baselines)
+{
+    std::ofstream file{path, std::ios::trunc};
+    file << baselines_header << '\n';
+    for(const auto& baseline : baselines)
+    {
+        const auto& sample = baseline.second;
+        file << baseline.first << ' ' << sample.solver << ' ' << sample.count << ' '
+             << sample.mean << ' ' << sample.stddev << '\n';
+    }
+    if(!file)
+        MIOPEN_THROW("Unable to write " + path);
+}
+
+/// Buffers and descriptors of a layer, and the immediate mode calls of its directions.
+class Layer
+{
+    public:
+    struct Direction
+    {
+        std::string name;
+        std::function<miopenStatus_t(std::size_t, std::size_t*, miopenConvSolution_t*)>
+            get_solutions;
+        std::function<miopenStatus_t(uint64_t)> compile;
+        std::function<miopenStatus_t(void*, std::size_t, uint64_t)> run;
+    };
+
+    Layer(miopenHandle_t handle_, const ConvConfig& config) : handle(handle_)
+    {
+        miopenConvolutionDescriptor_t conv;
+        Check(miopenCreateConvolutionDescriptor(&conv), "miopenCreateConvolutionDescriptor");
+        conv_desc = ConvDescPtr{conv};
+        Check(miopenInitConvolutionDescriptor(conv,
+                                              miopenConvolution,
+                                              config.pad_h,
+                                              config.pad_w,
+                                              config.stride_h,
+                                              config.stride_w,
+                                              config.dilation_h,
+                                              config.dilation_w),
+              "miopenInitConvolutionDescriptor");
+        Check(miopenSetConvolutionGroupCount(conv, config.groups),
+              "miopenSetConvolutionGroupCount");
+
+        x_desc = MakeTensor({config.n, config.c, config.h, config.w});
+        w_desc = MakeTensor({config.k, config.c / config.groups, config.y, config.x});
+        int out_n, out_c, out_h, out_w;
+        Check(miopenGetConvolutionForwardOutputDim(
+                  conv, x_desc.get(), w_desc.get(), &out_n, &out_c, &out_h, &out_w),
+              "miopenGetConvolutionForwardOutputDim");
+        y_desc = MakeTensor({out_n, out_c, out_h, out_w});
+
+        x = Create(x_desc.get());
+        w = Create(w_desc.get());
+        y = Create(y_desc.get());
+    }
+
+    std::vector<Direction> GetDirections() const
+    {
+        const auto xd = x_desc.get(), wd = w_desc.get(), yd = y_desc.get();
+        const auto cd = conv_desc.get();
+        const auto h  = handle;
+
+        return {
+            {"fwd",
+             [=](std::size_t max, std::size_t* count, miopenConvSolution_t* solutions) {
+                 return miopenConvolutionForwardGetSolution(
+                     h, wd, xd, cd, yd, max, count, solutions);
+             },
+             [=](uint64_t id) {
+                 return miopenConvolutionForwardCompileSolution(h, wd, xd, cd, yd, id);
+             },
+             [=](void* ws, std::size_t ws_size, uint64_t id) {
+                 return miopenConvolutionForwardImmediate(
+                     h, wd, w.get(), xd, x.get(), cd, yd, y.get(), ws, ws_size, id);
+             }},
+            {"bwd",
+             [=](std::size_t max, std::size_t* count, miopenConvSolution_t* solutions) {
+                 return miopenConvolutionBackwardDataGetSolution(
+                     h, yd, wd, cd, xd, max, count, solutions);
+             },
+             [=](uint64_t id) {
+                 return miopenConvolutionBackwardDataCompileSolution(h, yd, wd, cd, xd, id);
+             },
+             [=](void* ws, std::size_t ws_size, uint64_t id) {
+                 return miopenConvolutionBackwardDataImmediate(
+                     h, yd, y.get(), wd, w.get(), cd, xd, x.get(), ws, ws_size, id);
+             }},
+            {"wrw",
+             [=](std::size_t max, std::size_t* count, miopenConvSolution_t* solutions) {
+                 return miopenConvolutionBackwardWeightsGetSolution(
+                     h, yd, xd, cd, wd, max, count, solutions);
+             },
+             [=](uint64_t id) {
+                 return miopenConvolutionBackwardWeightsCompileSolution(h, yd, xd, cd, wd, id);
+             },
+             [=](void* ws, std::size_t ws_size, uint64_t id) {
+                 return miopenConvolutionBackwardWeightsImmediate(
+                     h, yd, y.get(), xd, x.get(), cd, wd, w.get(), ws, ws_size, id);
+             }},
+        };
+    }
+
+    /// Times the first solution of the direction, which is what the users get by default.
+    Sample Measure(const Direction& direction, int samples) const
+    {
+        miopenConvSolution_t solution;
+        std::size_t count = 0;
+        Check(direction.get_solutions(1, &count, &solution), "GetSolution");
+        if(count == 0)
+            MIOPEN_THROW("No solutions");
+        Check(direction.compile(solution.solution_id), "CompileSolution");
+
+        const auto workspace =
+            deref(handle).Create(std::max<std::size_t>(solution.workspace_size, 1));
+        auto times = std::vector<double>{};
+        for(auto i = -2; i < samples; ++i)
+        {
+            Check(direction.run(workspace.get(), solution.workspace_size, solution.solution_id),
+                  "Immediate");
+            float time = 0;
+            Check(miopenGetKernelTime(handle, &time), "miopenGetKernelTime");
+            if(i >= 0) // The first runs warm up the caches and the clocks.
+                times.push_back(time);
+        }
+        return Sample::FromTimes(solver::Id{solution.solution_id}.ToString(), times);
+    }
+
+    private:
+    miopenHandle_t handle;
+    TensorDescPtr x_desc, w_desc, y_desc;
+    ConvDescPtr conv_desc;
+    std::shared_ptr<void> x, w, y;
+
+    static TensorDescPtr MakeTensor(std::vector<int> lengths)
+    {
+        miopenTensorDescriptor_t desc;
+        Check(miopenCreateTensorDescriptor(&desc), "miopenCreateTensorDescriptor");
+        auto result = TensorDescPtr{desc};
+        Check(miopenSetTensorDescriptor(
+                  desc, miopenFloat, static_cast<int>(lengths.size()), lengths.data(), nullptr),
+              "miopenSetTensorDescriptor");
+        return result;
+    }
+
+    std::shared_ptr<void> Create(miopenTensorDescriptor_t desc) const
+    {
+        std::size_t size;
+        Check(miopenGetTensorNumBytes(desc, &size), "miopenGetTensorNumBytes");
+        return deref(handle).Create(size);
+    }
+};
+
+struct PerfRegressionDriver : public test_driver
+{
+    PerfRegressionDriver()
+    {
+        add(baselines_dir, "baselines");
+        add(configs_file, "configs");
+        add(threshold, "threshold");
+        add(samples, "samples");
+        add(update, "update", flag());
+    }
+
+    void run()
+    {
+        miopenHandle_t handle;
+        Check(miopenCreate(&handle), "miopenCreate");
+        const auto handle_ptr = MIOPEN_MANAGE_PTR(miopenHandle_t, miopenDestroy){handle};
+        Check(miopenEnableProfiling(handle, true), "miopenEnableProfiling");
+
+        const auto path = baselines_dir + "/" + deref(handle).GetDbBasename() + ".txt";
+        auto baselines  = ReadBaselines(path);
+        auto regressed  = 0;
+
+        for(const auto& config : GetConfigs())
+        {
+            const auto layer = Layer{handle, config};
+            for(const auto& direction : layer.GetDirections())
+            {
+                const auto key = direction.name + "-" + config.ToString();
+                Sample current;
+                try
+                {
+                    current = layer.Measure(direction, samples);
+                }
+                catch(const Exception& ex)
+                {
+                    std::cout << key << ": skipped, " << ex.what() << std::endl;
+                    continue;
+                }
+
+                std::cout << key << ": " << current.mean << " ms +- " << current.stddev << " ("
+                          << current.solver << ")";
+                const auto baseline = baselines.find(key);
+                if(update)
+                    baselines[key] = current;
+                else if(baseline == baselines.end())
+                    std::cout << ", no baseline";
+                else if(IsRegression(baseline->second, current))
+                {
+                    std::cout << ", REGRESSED from " << baseline->second.mean << " ms ("
+                              << baseline->second.solver << ")";
+                    ++regressed;
+                }
+                std::cout << std::endl;
+            }
+        }
+
+        if(update)
+        {
+            WriteBaselines(path, baselines);
+            std::cout << "Baselines written to " << path << std::endl;
+        }
+        else if(regressed > 0)
+        {
+            std::cerr << regressed << " layers regressed against " << path << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+    }
+
+    private:
+    std::string baselines_dir = ".";
+    std::string configs_file;
+    double threshold = 0.05;
+    int samples      = 20;
+    bool update      = false;
+
+    std::vector<ConvConfig> GetConfigs() const
+    {
+        auto configs = GetCuratedConfigs();
+        if(configs_file.empty())
+            return configs;
+
+        std::ifstream file{configs_file};
+        if(!file)
+            MIOPEN_THROW("Unable to read " + configs_file);
+        std::string line;
+        auto config = ConvConfig{};
+        while(std::getline(file, line))
+            if(ConvConfig::Parse(line, config))
+                configs.push_back(config);
+        return configs;
+    }
+
+    bool IsRegression(const Sample& baseline, const Sample& current) const
+    {
+        if(current.mean <= baseline.mean * (1 + threshold))
+            return false;
+        // One-sided Welch's t-test, the critical value is that of the normal distribution
+        // rounded up for the degrees of freedom of a couple of tens of samples.
+        const auto error = std::sqrt(baseline.stddev * baseline.stddev / baseline.count +
+                                     current.stddev * current.stddev / current.count);
+        return error == 0 || (current.mean - baseline.mean) / error > 2.5;
+    }
+};
+
+} // namespace perf_regression
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perf_regression::PerfRegressionDriver>(argc, argv);
+    return 0;
+}
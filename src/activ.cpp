@@ -64,7 +64,10 @@ std::ostream& operator<<(std::ostream& stream, const ActivationDescriptor& x)
                     miopenActivationPOWER,
                     miopenActivationCLIPPEDRELU,
                     miopenActivationLEAKYRELU,
-                    miopenActivationELU)
+                    miopenActivationELU,
+                    miopenActivationGELU,
+                    miopenActivationSILU,
+                    miopenActivationMISH)
         << ", ";
     LogRange(stream, x.parms, ", ") << ", ";
     return stream;
@@ -76,6 +76,17 @@ NetworkConfig ProblemDescription::MakeNetworkConfig() const
     return NetworkConfig{ss.str()};
 }
 
+void ProblemDescription::Serialize(std::ostream& stream) const
+{
+    const auto sep = '-';
+
+    stream << GetHeight() << sep << GetWidth();
+    stream << sep << (IsPacked() ? "packed" : "2d");
+    stream << sep << GetDataTypeName(xDesc.GetType());
+    stream << sep << GetDirectionName();
+    stream << sep << 'm' << activDesc.GetMode();
+}
+
 } // namespace activ
 
 } // namespace miopen
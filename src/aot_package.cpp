@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/aot_package.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/binary_cache.hpp>
+#include <miopen/conv/context.hpp>
+#include <miopen/db.hpp>
+#include <miopen/db_merge.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/version.h>
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+#include <miopen/kern_db.hpp>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+namespace miopen {
+
+void AotPackager::AddDbs(const std::vector<std::string>& paths)
+{
+    auto merger = DbMerger{DbMerger::Options{}};
+    merger.AddText(paths);
+
+    for(const auto& key : merger.GetKeys())
+    {
+        auto problem = conv::ProblemDescription{};
+        if(problem.Deserialize(key))
+            AddProblem(problem);
+        else
+            MIOPEN_LOG_I2("Not a convolution problem: " << key);
+    }
+}
+
+void AotPackager::AddProblem(const conv::ProblemDescription& problem)
+{
+    std::ostringstream key;
+    problem.Serialize(key);
+    if(keys.insert(key.str()).second)
+        problems.push_back(problem);
+}
+
+std::vector<solver::KernelInfo> AotPackager::GetKernels(Handle& handle) const
+{
+    auto kernels = std::vector<solver::KernelInfo>{};
+    auto queued  = std::set<std::pair<std::string, std::string>>{};
+
+    for(const auto& problem : problems)
+    {
+        auto ctx = ConvolutionContext{ProblemDescription{problem}};
+        ctx.general_compile_options = "";
+        ctx.SetStream(&handle);
+        ctx.DetectRocm();
+        ctx.SetupFloats();
+
+        auto db = GetDb(ctx);
+
+        for(const auto& id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+        {
+            // Only the fusion plans use it, with the kernels of their own options.
+            if(id.ToString() == "ConvBiasActivAsm1x1U")
+                continue;
+
+            const auto& s = id.GetSolver();
+            if(s.IsEmpty() || !s.IsApplicable(ctx))
+                continue;
+
+            auto solution = solver::ConvSolution{};
+            try
+            {
+                solution = s.FindSolution(ctx, db, {});
+            }
+            catch(const Exception& ex)
+            {
+                MIOPEN_LOG_W(id.ToString() << ": " << ex.what());
+                continue;
+            }
+            if(!solution.Succeeded())
+                continue;
+
+            for(const auto& kernel : solution.construction_params)
+                if(queued.emplace(kernel.kernel_file, kernel.comp_options).second)
+                    kernels.push_back(kernel);
+        }
+    }
+    return kernels;
+}
+
+AotPackager::Summary AotPackager::Build(Handle& handle, const std::string& output_dir) const
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    const auto kernels = GetKernels(handle);
+    MIOPEN_LOG_I(problems.size() << " problems, " << kernels.size() << " programs");
+    std::ignore = solver::PrecompileKernels(handle, kernels);
+
+    const auto& target = handle.GetTargetProperties();
+    const auto num_cu  = handle.GetMaxComputeUnits();
+    const auto dir     = boost::filesystem::path{output_dir} / GetVersion();
+    const auto name    = Handle::GetDbBasename(target, num_cu);
+    const auto path    = dir / (name + ".kdb");
+
+    boost::filesystem::create_directories(dir);
+    boost::filesystem::remove(path);
+
+    auto package = KernDb{path.string(), false};
+    for(const auto& kernel : kernels)
+    {
+        auto args = kernel.comp_options;
+#if MIOPEN_BACKEND_HIP
+        // Handle::LoadProgram() keys the binaries by the options with the target appended.
+        if(!EndsWith(kernel.kernel_file, ".mlir") && !EndsWith(kernel.kernel_file, ".mlir-cpp"))
+            args += " -mcpu=" + target.Name();
+#endif
+        // The compiled programs do not keep the code objects loaded from the cache, so all of
+        // them are read back from it.
+        const auto blob = LoadBinary(target, num_cu, kernel.kernel_file, args, false);
+        if(blob.empty())
+            MIOPEN_THROW("No binary of " + kernel.kernel_file + " '" + kernel.comp_options +
+                         "' in the kernel cache, which shall be enabled to build packages");
+        package.StoreRecordUnsafe({kernel.kernel_file + ".o", args, blob});
+    }
+
+    std::ofstream manifest{(dir / (name + ".kdb.manifest")).string(),
+                           std::ios::out | std::ios::trunc};
+    manifest << "version=" << GetVersion() << '\n'
+             << "target=" << target.Name() << '\n'
+             << "num_cu=" << num_cu << '\n'
+             << "kernels=" << kernels.size() << '\n'
+             << "problems=" << problems.size() << '\n';
+    for(const auto& key : keys)
+        manifest << "problem=" << key << '\n';
+    if(!manifest)
+        MIOPEN_THROW("Unable to write the package manifest in " + dir.string());
+
+    return {path.string(), kernels.size()};
+#else
+    std::ignore = handle;
+    std::ignore = output_dir;
+    MIOPEN_THROW(miopenStatusNotImplemented,
+                 "Kernel packages need MIOPEN_ENABLE_SQLITE_KERN_CACHE");
+#endif
+}
+
+std::string AotPackager::GetVersion()
+{
+    return std::to_string(MIOPEN_VERSION_MAJOR) + "." + std::to_string(MIOPEN_VERSION_MINOR) +
+           "." + std::to_string(MIOPEN_VERSION_PATCH) + "." +
+           MIOPEN_STRINGIZE(MIOPEN_VERSION_TWEAK);
+}
+
+} // namespace miopen
@@ -0,0 +1,244 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/async_compiler.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/simple_hash.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
+
+namespace miopen {
+
+struct AsyncCompiler::State
+{
+    struct Job
+    {
+        Key key;
+        std::packaged_task<Program()> task;
+    };
+
+    std::mutex mutex;
+    std::condition_variable job_added;
+    std::condition_variable job_done;
+    std::deque<Job> queue;
+    std::unordered_map<Key, std::shared_future<Program>, SimpleHash> scheduled;
+    std::vector<std::thread> workers;
+    std::size_t idle_workers = 0;
+    bool stopping            = false;
+
+    struct Tracked
+    {
+        std::uint64_t ticket;
+        std::vector<std::shared_future<Program>> builds;
+        Callback callback;
+    };
+
+    std::deque<Tracked> tracked;
+    std::condition_variable tracked_added;
+    std::condition_variable ticket_done;
+    std::map<std::uint64_t, miopenStatus_t> tickets;
+    std::uint64_t next_ticket = 1;
+    std::thread tracker;
+
+    void Work()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            ++idle_workers;
+            job_added.wait(lock, [&]() { return stopping || !queue.empty(); });
+            --idle_workers;
+            if(stopping)
+                return;
+
+            auto job = std::move(queue.front());
+            queue.pop_front();
+
+            lock.unlock();
+            MIOPEN_LOG_I2("Compiling in background: " << job.key.first);
+            job.task();
+            lock.lock();
+
+            scheduled.erase(job.key);
+            job_done.notify_all();
+        }
+    }
+
+    void Track()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            tracked_added.wait(lock, [&]() { return stopping || !tracked.empty(); });
+            if(tracked.empty())
+                return;
+
+            auto item = std::move(tracked.front());
+            tracked.pop_front();
+
+            lock.unlock();
+            auto status = miopenStatusSuccess;
+            for(const auto& build : item.builds)
+            {
+                try
+                {
+                    build.get();
+                }
+                catch(const Exception& ex)
+                {
+                    if(status == miopenStatusSuccess)
+                        status = ex.status;
+                }
+                catch(...)
+                {
+                    if(status == miopenStatusSuccess)
+                        status = miopenStatusUnknownError;
+                }
+            }
+            if(item.callback)
+            {
+                try
+                {
+                    item.callback(status);
+                }
+                catch(...)
+                {
+                    MIOPEN_LOG_W("The callback of the compile ticket " << item.ticket << " threw");
+                }
+            }
+            lock.lock();
+
+            tickets[item.ticket] = status;
+            ticket_done.notify_all();
+        }
+    }
+};
+
+AsyncCompiler::AsyncCompiler() : state(std::make_unique<State>()) {}
+AsyncCompiler::AsyncCompiler(AsyncCompiler&&) noexcept = default;
+AsyncCompiler& AsyncCompiler::operator=(AsyncCompiler&&) noexcept = default;
+
+AsyncCompiler::~AsyncCompiler()
+{
+    if(state == nullptr)
+        return;
+    {
+        const std::lock_guard<std::mutex> lock(state->mutex);
+        state->stopping = true;
+    }
+    state->job_added.notify_all();
+    for(auto& worker : state->workers)
+        worker.join();
+    // The dropped jobs break their futures, so that the tracked builds complete.
+    state->queue.clear();
+    state->tracked_added.notify_all();
+    if(state->tracker.joinable())
+        state->tracker.join();
+}
+
+std::shared_future<Program> AsyncCompiler::Submit(const Key& key,
+                                                  std::function<Program()> job) const
+{
+    const std::lock_guard<std::mutex> lock(state->mutex);
+    const auto it = state->scheduled.find(key);
+    if(it != state->scheduled.end())
+        return it->second;
+
+    auto task   = std::packaged_task<Program()>{std::move(job)};
+    auto future = task.get_future().share();
+    state->scheduled.emplace(key, future);
+    state->queue.push_back({key, std::move(task)});
+
+    static const auto max_workers = std::max<std::size_t>(
+        Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, std::thread::hardware_concurrency()), 1);
+    if(state->idle_workers < state->queue.size() && state->workers.size() < max_workers)
+    {
+        auto* const s = state.get();
+        state->workers.emplace_back([s]() { s->Work(); });
+    }
+    else
+        state->job_added.notify_one();
+    return future;
+}
+
+void AsyncCompiler::Wait() const
+{
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->job_done.wait(lock, [&]() { return state->scheduled.empty(); });
+}
+
+std::uint64_t AsyncCompiler::Track(std::vector<std::shared_future<Program>> builds,
+                                   Callback callback) const
+{
+    const std::lock_guard<std::mutex> lock(state->mutex);
+    const auto ticket = state->next_ticket++;
+    state->tickets.emplace(ticket, miopenStatusNotInitialized);
+    state->tracked.push_back({ticket, std::move(builds), std::move(callback)});
+    if(!state->tracker.joinable())
+    {
+        auto* const s  = state.get();
+        state->tracker = std::thread([s]() { s->Track(); });
+    }
+    else
+        state->tracked_added.notify_one();
+    return ticket;
+}
+
+bool AsyncCompiler::Query(std::uint64_t ticket, miopenStatus_t& status) const
+{
+    const std::lock_guard<std::mutex> lock(state->mutex);
+    const auto it = state->tickets.find(ticket);
+    if(it == state->tickets.end())
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown compile ticket " + std::to_string(ticket));
+    if(it->second == miopenStatusNotInitialized)
+        return false;
+    status = it->second;
+    return true;
+}
+
+miopenStatus_t AsyncCompiler::WaitFor(std::uint64_t ticket) const
+{
+    std::unique_lock<std::mutex> lock(state->mutex);
+    const auto it = state->tickets.find(ticket);
+    if(it == state->tickets.end())
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown compile ticket " + std::to_string(ticket));
+    state->ticket_done.wait(lock, [&]() { return it->second != miopenStatusNotInitialized; });
+    return it->second;
+}
+
+} // namespace miopen
@@ -69,13 +69,16 @@ TensorDescriptor BuildReshaped4DTensorDescriptor(const miopen::TensorDescriptor&
 {
     auto dataType = tDesc.GetType();
     std::vector<size_t> dims(tDesc.GetLengths());
+    const auto& strides = tDesc.GetStrides();
 
     // NxCxDxHxW -> NxCx(D*H)xW
     dims[2] *= dims[3];
     dims[3] = dims[4];
     dims.pop_back();
 
-    return {dataType, dims};
+    // D and H are adjacent in both NCDHW and NDHWC, so the merged dimension keeps the stride
+    // of H and channel-last tensors stay channel-last.
+    return {dataType, dims, {strides[0], strides[1], strides[3], strides[4]}};
 }
 
 void profileSequence(const Handle& handle, unsigned char select, float* ctime)
@@ -106,6 +106,21 @@ static void LogCmdBNorm(const miopenTensorDescriptor_t xDesc,
     }
 }
 
+static bool IsUnsupportedBFloat16(const miopenTensorDescriptor_t xDesc,
+                                  const miopenTensorDescriptor_t yDesc,
+                                  const miopenTensorDescriptor_t paramDesc)
+{
+    const auto xType = miopen::deref(xDesc).GetType();
+    const auto yType = miopen::deref(yDesc).GetType();
+    const auto pType = miopen::deref(paramDesc).GetType();
+
+    if(pType == miopenBFloat16)
+        return true;
+    if(xType != miopenBFloat16 && yType != miopenBFloat16)
+        return false;
+    return xType != yType || pType != miopenFloat;
+}
+
 extern "C" miopenStatus_t
 miopenBatchNormalizationForwardInference(miopenHandle_t handle,
                                          miopenBatchNormMode_t bn_mode,
@@ -135,9 +150,8 @@ miopenBatchNormalizationForwardInference(miopenHandle_t handle,
                         estimatedVariance,
                         epsilon);
 
-    // bfloat16 not supported for batchnorm operation
-    if(miopen::deref(yDesc).GetType() == miopenBFloat16 ||
-       miopen::deref(xDesc).GetType() == miopenBFloat16)
+    // bfloat16 data is supported with float scale, bias and statistics only
+    if(IsUnsupportedBFloat16(xDesc, yDesc, bnScaleBiasMeanVarDesc))
     {
         return miopenStatusNotImplemented;
     }
@@ -206,10 +220,8 @@ miopenBatchNormalizationForwardTraining(miopenHandle_t handle,
                         resultSaveMean,
                         resultSaveInvVariance);
 
-    // bfloat16 not supported for batchnorm operation
-    if(miopen::deref(xDesc).GetType() == miopenBFloat16 ||
-       miopen::deref(yDesc).GetType() == miopenBFloat16 ||
-       miopen::deref(bnScaleBiasMeanVarDesc).GetType() == miopenBFloat16)
+    // bfloat16 data is supported with float scale, bias and statistics only
+    if(IsUnsupportedBFloat16(xDesc, yDesc, bnScaleBiasMeanVarDesc))
     {
         return miopenStatusNotImplemented;
     }
@@ -271,10 +283,9 @@ miopenBatchNormalizationBackward(miopenHandle_t handle,
                                  const void* savedMean,
                                  const void* savedInvVariance)
 {
-    // bfloat16 not supported for batchnorm operation
-    if(miopen::deref(xDesc).GetType() == miopenBFloat16 ||
-       miopen::deref(dyDesc).GetType() == miopenBFloat16 ||
-       miopen::deref(dxDesc).GetType() == miopenBFloat16)
+    // bfloat16 data is supported with float scale, bias and statistics only
+    if(IsUnsupportedBFloat16(xDesc, dyDesc, bnScaleBiasDiffDesc) ||
+       IsUnsupportedBFloat16(xDesc, dxDesc, bnScaleBiasDiffDesc))
     {
         return miopenStatusNotImplemented;
     }
@@ -326,3 +337,248 @@ miopenBatchNormalizationBackward(miopenHandle_t handle,
             DataCast(savedInvVariance));
     });
 }
+
+extern "C" miopenStatus_t
+miopenBatchNormalizationForwardTrainingStats(miopenHandle_t handle,
+                                             miopenBatchNormMode_t bn_mode,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const void* x,
+                                             const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+                                             void* localSum,
+                                             void* localSqSum)
+{
+    MIOPEN_LOG_FUNCTION(handle, bn_mode, xDesc, x, bnScaleBiasMeanVarDesc, localSum, localSqSum);
+
+    // bfloat16 not supported for batchnorm operation
+    if(miopen::deref(xDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(bnScaleBiasMeanVarDesc).GetType() == miopenBFloat16)
+    {
+        return miopenStatusNotImplemented;
+    }
+
+    // In case of NxCxDxHxW
+    int size{0};
+    miopenGetTensorDescriptorSize(xDesc, &size);
+    return miopen::try_([&] {
+        miopen::BatchNormForwardTrainingStats(
+            miopen::deref(handle),
+            bn_mode,
+            (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(xDesc))
+                        : miopen::deref(xDesc),
+            DataCast(x),
+            (size == 5)
+                ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(bnScaleBiasMeanVarDesc))
+                : miopen::deref(bnScaleBiasMeanVarDesc),
+            DataCast(localSum),
+            DataCast(localSqSum));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenBatchNormalizationForwardTrainingApply(miopenHandle_t handle,
+                                             miopenBatchNormMode_t bn_mode,
+                                             void* alpha,
+                                             void* beta,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const void* x,
+                                             const miopenTensorDescriptor_t yDesc,
+                                             void* y,
+                                             const miopenTensorDescriptor_t bnScaleBiasMeanVarDesc,
+                                             void* bnScale,
+                                             void* bnBias,
+                                             const void* globalSum,
+                                             const void* globalSqSum,
+                                             size_t globalCount,
+                                             double expAvgFactor,
+                                             void* resultRunningMean,
+                                             void* resultRunningVariance,
+                                             double epsilon,
+                                             void* resultSaveMean,
+                                             void* resultSaveInvVariance)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        bn_mode,
+                        xDesc,
+                        x,
+                        yDesc,
+                        y,
+                        bnScaleBiasMeanVarDesc,
+                        bnScale,
+                        bnBias,
+                        globalSum,
+                        globalSqSum,
+                        globalCount,
+                        expAvgFactor,
+                        resultRunningMean,
+                        resultRunningVariance,
+                        epsilon,
+                        resultSaveMean,
+                        resultSaveInvVariance);
+
+    // bfloat16 not supported for batchnorm operation
+    if(miopen::deref(xDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(yDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(bnScaleBiasMeanVarDesc).GetType() == miopenBFloat16)
+    {
+        return miopenStatusNotImplemented;
+    }
+
+    // In case of NxCxDxHxW
+    int size{0};
+    miopenGetTensorDescriptorSize(xDesc, &size);
+    return miopen::try_([&] {
+        miopen::BatchNormForwardTrainingApply(
+            miopen::deref(handle),
+            bn_mode,
+            alpha,
+            beta,
+            (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(xDesc))
+                        : miopen::deref(xDesc),
+            DataCast(x),
+            (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(yDesc))
+                        : miopen::deref(yDesc),
+            DataCast(y),
+            (size == 5)
+                ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(bnScaleBiasMeanVarDesc))
+                : miopen::deref(bnScaleBiasMeanVarDesc),
+            DataCast(bnScale),
+            DataCast(bnBias),
+            DataCast(globalSum),
+            DataCast(globalSqSum),
+            globalCount,
+            expAvgFactor,
+            DataCast(resultRunningMean),
+            DataCast(resultRunningVariance),
+            epsilon,
+            DataCast(resultSaveMean),
+            DataCast(resultSaveInvVariance));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenBatchNormalizationBackwardStats(miopenHandle_t handle,
+                                      miopenBatchNormMode_t bn_mode,
+                                      const miopenTensorDescriptor_t xDesc,
+                                      const void* x,
+                                      const miopenTensorDescriptor_t dyDesc,
+                                      const void* dy,
+                                      const miopenTensorDescriptor_t bnScaleBiasDiffDesc,
+                                      const void* savedMean,
+                                      const void* savedInvVariance,
+                                      void* localBiasDiff,
+                                      void* localScaleDiff)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        bn_mode,
+                        xDesc,
+                        x,
+                        dyDesc,
+                        dy,
+                        bnScaleBiasDiffDesc,
+                        savedMean,
+                        savedInvVariance,
+                        localBiasDiff,
+                        localScaleDiff);
+
+    // bfloat16 not supported for batchnorm operation
+    if(miopen::deref(xDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(dyDesc).GetType() == miopenBFloat16)
+    {
+        return miopenStatusNotImplemented;
+    }
+
+    // In case of NxCxDxHxW
+    int size{0};
+    miopenGetTensorDescriptorSize(xDesc, &size);
+    return miopen::try_([&] {
+        miopen::BatchNormBackwardStats(
+            miopen::deref(handle),
+            bn_mode,
+            (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(xDesc))
+                        : miopen::deref(xDesc),
+            DataCast(x),
+            (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(dyDesc))
+                        : miopen::deref(dyDesc),
+            DataCast(dy),
+            (size == 5)
+                ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(bnScaleBiasDiffDesc))
+                : miopen::deref(bnScaleBiasDiffDesc),
+            DataCast(savedMean),
+            DataCast(savedInvVariance),
+            DataCast(localBiasDiff),
+            DataCast(localScaleDiff));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenBatchNormalizationBackwardApply(miopenHandle_t handle,
+                                      miopenBatchNormMode_t bn_mode,
+                                      const void* alphaDataDiff,
+                                      const void* betaDataDiff,
+                                      const miopenTensorDescriptor_t xDesc,
+                                      const void* x,
+                                      const miopenTensorDescriptor_t dyDesc,
+                                      const void* dy,
+                                      const miopenTensorDescriptor_t dxDesc,
+                                      void* dx,
+                                      const miopenTensorDescriptor_t bnScaleBiasDiffDesc,
+                                      const void* bnScale,
+                                      const void* globalBiasDiff,
+                                      const void* globalScaleDiff,
+                                      size_t globalCount,
+                                      const void* savedMean,
+                                      const void* savedInvVariance)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        bn_mode,
+                        xDesc,
+                        x,
+                        dyDesc,
+                        dy,
+                        dxDesc,
+                        dx,
+                        bnScaleBiasDiffDesc,
+                        bnScale,
+                        globalBiasDiff,
+                        globalScaleDiff,
+                        globalCount,
+                        savedMean,
+                        savedInvVariance);
+
+    // bfloat16 not supported for batchnorm operation
+    if(miopen::deref(xDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(dyDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(dxDesc).GetType() == miopenBFloat16)
+    {
+        return miopenStatusNotImplemented;
+    }
+
+    // In case of NxCxDxHxW
+    int size{0};
+    miopenGetTensorDescriptorSize(xDesc, &size);
+    return miopen::try_([&] {
+        miopen::BatchNormBackwardApply(
+            miopen::deref(handle),
+            bn_mode,
+            alphaDataDiff,
+            betaDataDiff,
+            (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(xDesc))
+                        : miopen::deref(xDesc),
+            DataCast(x),
+            (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(dyDesc))
+                        : miopen::deref(dyDesc),
+            DataCast(dy),
+            (size == 5) ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(dxDesc))
+                        : miopen::deref(dxDesc),
+            DataCast(dx),
+            (size == 5)
+                ? miopen::BuildReshaped4DTensorDescriptor(miopen::deref(bnScaleBiasDiffDesc))
+                : miopen::deref(bnScaleBiasDiffDesc),
+            DataCast(bnScale),
+            DataCast(globalBiasDiff),
+            DataCast(globalScaleDiff),
+            globalCount,
+            DataCast(savedMean),
+            DataCast(savedInvVariance));
+    });
+}
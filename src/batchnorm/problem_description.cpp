@@ -38,6 +38,9 @@ namespace batchnorm {
 
 NetworkConfig ProblemDescription::MakeNetworkConfig() const
 {
+    if(bn_mode == miopenBNSpatial && direction != Direction::ForwardInference && IsLayoutNHWC())
+        return MakeNHWCNetworkConfig();
+
     switch(direction)
     {
     case Direction::ForwardTraining: return MakeForwardTrainingNetworkConfig();
@@ -47,6 +50,42 @@ NetworkConfig ProblemDescription::MakeNetworkConfig() const
     }
 }
 
+std::string ProblemDescription::GetDataTypesName() const
+{
+    const auto& outDesc = direction == Direction::Backward ? dxDesc : yOrDyDesc;
+    return EncodeDataTypesForKey(xDesc.GetType(), scaleBiasDesc.GetType(), outDesc.GetType());
+}
+
+std::string ProblemDescription::GetDirectionName() const
+{
+    switch(direction)
+    {
+    case Direction::ForwardTraining: return "FT";
+    case Direction::ForwardInference: return "FI";
+    case Direction::Backward: return "B";
+    default: MIOPEN_THROW(miopenStatusInternalError);
+    }
+}
+
+void ProblemDescription::Serialize(std::ostream& stream) const
+{
+    const auto sep = '-';
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+
+    stream << n << sep << c << sep << h << sep << w;
+    stream << sep << GetLayoutName();
+    stream << sep << GetDataTypesName();
+    stream << sep << GetDirectionName();
+    stream << sep << GetModeName();
+    stream << sep;
+    if(direction == Direction::Backward)
+        stream << 'u' << static_cast<int>(useSaved);
+    else
+        stream << 's' << static_cast<int>(resultsave) << 'r' << static_cast<int>(resultrunning);
+}
+
 NetworkConfig ProblemDescription::MakeForwardTrainingNetworkConfig() const
 {
     std::ostringstream ss;
@@ -325,6 +364,34 @@ NetworkConfig ProblemDescription::MakeBackwardNetworkConfig() const
     return NetworkConfig{ss.str()};
 }
 
+NetworkConfig ProblemDescription::MakeNHWCNetworkConfig() const
+{
+    std::ostringstream ss;
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+
+    ss << "nhwc";
+    ss << "dir" << static_cast<int>(direction);
+    ss << "n" << n;
+    ss << "c" << c;
+    ss << "hw" << h * w;
+    ss << "xt" << xDesc.GetType();
+    ss << "pt" << scaleBiasDesc.GetType();
+
+    if(direction == Direction::Backward)
+    {
+        ss << "us" << static_cast<int>(useSaved);
+    }
+    else
+    {
+        ss << "rs" << static_cast<int>(resultsave);
+        ss << "rr" << static_cast<int>(resultrunning);
+    }
+
+    return NetworkConfig{ss.str()};
+}
+
 } // namespace batchnorm
 
 } // namespace miopen
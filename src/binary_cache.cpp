@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/compile_stats.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/md5.hpp>
 #include <miopen/errors.hpp>
@@ -35,12 +36,20 @@
 #include <miopen/version.h>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/kern_db.hpp>
+#include <miopen/kernel_info.hpp>
+#include <miopen/logger.hpp>
 #include <miopen/db.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/shared_binary_cache.hpp>
+#include <miopen/write_file.hpp>
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 
 namespace miopen {
 
@@ -111,8 +120,9 @@ static bool IsCacheDisabled()
 }
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
-KDb GetDb(const TargetProperties& target, size_t num_cu)
+/// Returns paths to the system and user kernel databases, empty ones are absent.
+static std::pair<std::string, std::string> GetDbPaths(const TargetProperties& target,
+                                                      size_t num_cu)
 {
     static const auto user_dir = ComputeUserCachePath();
     static const auto sys_dir  = ComputeSysCachePath();
@@ -127,6 +137,56 @@ KDb GetDb(const TargetProperties& target, size_t num_cu)
 #endif
     return {sys_path.string(), user_path.string()};
 }
+
+/// Decompressed code objects shared by all the handles of the process, so that a process with a
+/// handle per device or per thread reads and decompresses a binary once per target. Only the
+/// module load is left per device context. The code objects do not depend on the number of CUs
+/// in the name of the database, hence the key is the target, the file and the build options.
+class ProcessBinaryCache
+{
+    public:
+    static ProcessBinaryCache& Get()
+    {
+        static ProcessBinaryCache cache;
+        return cache;
+    }
+
+    std::string Load(const std::string& target, const std::string& name, const std::string& args)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = binaries.find(MakeKey(target, name, args));
+        return it != binaries.end() ? it->second : std::string{};
+    }
+
+    void Store(const std::string& target,
+               const std::string& name,
+               const std::string& args,
+               const std::string& binary)
+    {
+        if(binary.empty())
+            return;
+        std::lock_guard<std::mutex> lock(mutex);
+        binaries[MakeKey(target, name, args)] = binary;
+    }
+
+    private:
+    static std::string MakeKey(const std::string& target,
+                               const std::string& name,
+                               const std::string& args)
+    {
+        return target + '\n' + name + '\n' + args;
+    }
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::string> binaries;
+};
+
+using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
+KDb GetDb(const TargetProperties& target, size_t num_cu)
+{
+    const auto paths = GetDbPaths(target, num_cu);
+    return {paths.first, paths.second};
+}
 #endif
 
 boost::filesystem::path GetCacheFile(const std::string& device,
@@ -159,24 +219,51 @@ std::string LoadBinary(const TargetProperties& target,
     if(miopen::IsCacheDisabled())
         return {};
 
+    const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
+    const auto verbose_name    = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
+    auto& process              = ProcessBinaryCache::Get();
+
+    {
+        auto binary = process.Load(target.DbId(), filename, args);
+        CompileStats::Get().AddLookup(CompileCache::Process, !binary.empty());
+        if(!binary.empty())
+        {
+            MIOPEN_LOG_I2("Loaded binary of the process for: " << verbose_name
+                                                               << "; args: " << args);
+            return binary;
+        }
+    }
+
     auto db = GetDb(target, num_cu);
 
-    const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
     KernelConfig cfg{filename, args, ""};
 
-    const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
     MIOPEN_LOG_I2("Loading binary for: " << verbose_name << "; args: " << args);
     auto record = db.FindRecord(cfg);
+    CompileStats::Get().AddLookup(CompileCache::Binaries, static_cast<bool>(record));
     if(record)
     {
         MIOPEN_LOG_I2("Sucessfully loaded binary for: " << verbose_name << "; args: " << args);
+        process.Store(target.DbId(), filename, args, record.get());
         return record.get();
     }
-    else
+
+    if(auto* const shared = SharedBinaryCache::Get())
     {
-        MIOPEN_LOG_I2("Unable to load binary for: " << verbose_name << "; args: " << args);
-        return {};
+        auto binary = shared->Load(target.DbId(), filename, args);
+        CompileStats::Get().AddLookup(CompileCache::Shared, !binary.empty());
+        if(!binary.empty())
+        {
+            MIOPEN_LOG_I2("Loaded shared binary for: " << verbose_name << "; args: " << args);
+            auto local = KernelConfig{filename, args, binary};
+            db.StoreRecord(local);
+            process.Store(target.DbId(), filename, args, binary);
+            return binary;
+        }
     }
+
+    MIOPEN_LOG_I2("Unable to load binary for: " << verbose_name << "; args: " << args);
+    return {};
 }
 
 void SaveBinary(const std::string& hsaco,
@@ -197,6 +284,10 @@ void SaveBinary(const std::string& hsaco,
     const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
     MIOPEN_LOG_I2("Saving binary for: " << verbose_name << "; args: " << args);
     db.StoreRecord(cfg);
+    ProcessBinaryCache::Get().Store(target.DbId(), filename, args, hsaco);
+
+    if(auto* const shared = SharedBinaryCache::Get())
+        shared->Store(target.DbId(), filename, args, hsaco);
 }
 #else
 boost::filesystem::path LoadBinary(const TargetProperties& target,
@@ -209,15 +300,24 @@ boost::filesystem::path LoadBinary(const TargetProperties& target,
         return {};
 
     (void)num_cu;
-    auto f = GetCacheFile(target.DbId(), name, args, is_kernel_str);
-    if(boost::filesystem::exists(f))
-    {
+    auto f         = GetCacheFile(target.DbId(), name, args, is_kernel_str);
+    const auto hit = boost::filesystem::exists(f);
+    CompileStats::Get().AddLookup(CompileCache::Binaries, hit);
+    if(hit)
         return f.string();
-    }
-    else
+
+    if(auto* const shared = SharedBinaryCache::Get())
     {
-        return {};
+        const auto binary = shared->Load(target.DbId(), f.filename().string(), args);
+        CompileStats::Get().AddLookup(CompileCache::Shared, !binary.empty());
+        if(!binary.empty())
+        {
+            boost::filesystem::create_directories(f.parent_path());
+            WriteFile(binary, f);
+            return f.string();
+        }
     }
+    return {};
 }
 
 void SaveBinary(const boost::filesystem::path& binary_path,
@@ -235,7 +335,71 @@ void SaveBinary(const boost::filesystem::path& binary_path,
         auto p = GetCacheFile(target.DbId(), name, args, is_kernel_str);
         boost::filesystem::create_directories(p.parent_path());
         boost::filesystem::rename(binary_path, p);
+
+        if(auto* const shared = SharedBinaryCache::Get())
+            shared->Store(target.DbId(), p.filename().string(), args, LoadFile(p));
     }
 }
 #endif
+
+void WarmupKernelCache(const Handle& handle, const std::vector<std::string>& programs)
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    if(miopen::IsCacheDisabled())
+        return;
+
+    const auto& target     = handle.GetTargetProperties();
+    const auto num_cu      = handle.GetMaxComputeUnits();
+    const auto paths       = GetDbPaths(target, num_cu);
+    const auto mcpu_suffix = " -mcpu=" + target.Name();
+
+    std::vector<KernelConfig> keys;
+    for(const auto& path : {paths.first, paths.second})
+    {
+        if(path.empty() || !boost::filesystem::exists(path))
+            continue;
+        auto db         = KernDb{path, path == paths.first};
+        const auto more = db.GetAllKeysUnsafe();
+        keys.insert(keys.end(), more.begin(), more.end());
+    }
+
+    // Database keys are built by Handle::LoadProgram, which appends ".o" to the program
+    // name and the target to the build parameters, except for MLIR programs.
+    std::vector<solver::KernelInfo> kernels;
+    for(const auto& key : keys)
+    {
+        if(!EndsWith(key.kernel_name, ".o"))
+            continue;
+        auto program = key.kernel_name.substr(0, key.kernel_name.size() - 2);
+        // Kernels from source strings are stored under a hash of the source.
+        if(program.find('.') == std::string::npos)
+            continue;
+        if(!programs.empty() &&
+           std::find(programs.begin(), programs.end(), program) == programs.end())
+            continue;
+
+        auto params = key.kernel_args;
+        if(!EndsWith(program, ".mlir") && !EndsWith(program, ".mlir-cpp"))
+        {
+            if(!EndsWith(params, mcpu_suffix))
+                continue;
+            params.resize(params.size() - mcpu_suffix.size());
+        }
+
+        solver::KernelInfo kernel;
+        kernel.kernel_file  = std::move(program);
+        kernel.comp_options = std::move(params);
+        kernels.push_back(std::move(kernel));
+    }
+
+    const auto pending = solver::PrecompileKernelsAsync(handle, kernels);
+    MIOPEN_LOG_I("Warming up kernel cache: " << pending.size() << " of " << keys.size()
+                                             << " code objects");
+#else
+    (void)handle;
+    (void)programs;
+    MIOPEN_LOG_W("Kernel cache warmup requires the SQLite kernel cache");
+#endif
+}
+
 } // namespace miopen
@@ -0,0 +1,553 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_log.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_BINARY)
+
+namespace miopen {
+namespace binlog {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr const char file_magic[] = "MIOBLOG1";
+// Per thread, enough for some ten thousands of records between the drains.
+constexpr std::size_t ring_size = 1024 * 1024;
+constexpr auto drain_period     = std::chrono::milliseconds{10};
+
+/// Blocks of the file, the records are written as they are in the rings.
+enum Tag : char
+{
+    SiteTag    = 'S',
+    RecordTag  = 'E',
+    DroppedTag = 'D',
+};
+
+// A record: RecordTag, the size of the rest, the site, the thread, the nanoseconds since the
+// start of the log, then the arguments up to the end.
+constexpr std::size_t record_header_size = 1 + 4 + 4 + 4 + 8;
+
+struct Site
+{
+    Kind kind;
+    std::string name;
+    std::string params;
+};
+
+int GetThreadId()
+{
+#ifdef __linux__
+    return syscall(SYS_gettid); // NOLINT
+#else
+    return 0;
+#endif
+}
+
+template <class T>
+T Read(const char*& p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+/// Single producer, single consumer queue of bytes.
+class Ring
+{
+    public:
+    Ring() : data(ring_size) {}
+
+    bool Push(const char* bytes, std::size_t size)
+    {
+        const auto h = head.load(std::memory_order_relaxed);
+        const auto t = tail.load(std::memory_order_acquire);
+        if(size > data.size() - (h - t))
+            return false;
+        const auto at    = h % data.size();
+        const auto first = std::min(size, data.size() - at);
+        std::memcpy(&data[at], bytes, first);
+        std::memcpy(data.data(), bytes + first, size - first);
+        head.store(h + size, std::memory_order_release);
+        return true;
+    }
+
+    void Drain(std::vector<char>& out)
+    {
+        const auto t     = tail.load(std::memory_order_relaxed);
+        const auto h     = head.load(std::memory_order_acquire);
+        const auto at    = t % data.size();
+        const auto size  = h - t;
+        const auto first = std::min(size, data.size() - at);
+        out.insert(out.end(), data.begin() + at, data.begin() + at + first);
+        out.insert(out.end(), data.begin(), data.begin() + (size - first));
+        tail.store(h, std::memory_order_release);
+    }
+
+    private:
+    std::vector<char> data;
+    std::atomic<std::size_t> head{0};
+    std::atomic<std::size_t> tail{0};
+};
+
+/// Turns the blocks into the lines of the text log.
+class Decoder
+{
+    public:
+    void AddSite(std::uint32_t id, Site site)
+    {
+        if(sites.size() <= id)
+            sites.resize(id + 1);
+        sites[id] = std::move(site);
+    }
+
+    /// \param p The record past its tag and size.
+    void Record(const char* p, const char* end, std::ostream& out) const
+    {
+        const auto site_id = Read<std::uint32_t>(p);
+        const auto tid     = Read<std::uint32_t>(p);
+        const auto ns      = Read<std::uint64_t>(p);
+        if(site_id >= sites.size())
+            return;
+        const auto& site = sites[site_id];
+
+        std::ostringstream prefix;
+        prefix << tid << " MIOpen " << std::fixed << std::setprecision(3) << ns * 1e-6 << ": ";
+
+        if(site.kind == Kind::Call)
+        {
+            out << prefix.str() << site.name << "{\n";
+            auto names = std::istringstream{site.params};
+            std::string name;
+            while(p < end)
+            {
+                std::getline(names >> std::ws, name, ',');
+                out << prefix.str() << '\t' << name << " = ";
+                p = Arg(p, end, out);
+                out << '\n';
+            }
+            out << prefix.str() << "}\n";
+            return;
+        }
+
+        // The level as an Int argument, then the text.
+        if(end - p < 1 + static_cast<std::ptrdiff_t>(sizeof(std::int64_t)))
+            return;
+        p += 1;
+        const auto level = Read<std::int64_t>(p);
+        out << prefix.str();
+        if(site.kind == Kind::Command)
+            out << "Command [" << site.name << "] ./bin/MIOpenDriver ";
+        else
+            out << LoggingLevelToCString(static_cast<LoggingLevel>(level)) << ' ';
+        if(site.kind == Kind::Message && !site.name.empty())
+            out << '[' << site.name << "] ";
+        while(p < end)
+            p = Arg(p, end, out);
+        out << '\n';
+    }
+
+    private:
+    static const char* Arg(const char* p, const char* end, std::ostream& out)
+    {
+        switch(static_cast<ArgType>(Read<std::uint8_t>(p)))
+        {
+        case ArgType::Int: out << Read<std::int64_t>(p); break;
+        case ArgType::UInt: out << Read<std::uint64_t>(p); break;
+        case ArgType::Double: out << Read<double>(p); break;
+        case ArgType::Pointer: {
+            const auto value = Read<std::uint64_t>(p);
+            if(value == 0)
+                out << "nullptr";
+            else
+                out << "0x" << std::hex << value << std::dec;
+            break;
+        }
+        case ArgType::String: {
+            const auto size = Read<std::uint32_t>(p);
+            out.write(p, size);
+            p += size;
+            break;
+        }
+        case ArgType::Array: {
+            const auto count = Read<std::uint32_t>(p);
+            out << "{ ";
+            for(std::uint32_t i = 0; i < count && p < end; ++i)
+            {
+                p = Arg(p, end, out);
+                out << ' ';
+            }
+            out << '}';
+            break;
+        }
+        default: return end;
+        }
+        return p;
+    }
+
+    std::vector<Site> sites;
+};
+
+class Writer
+{
+    public:
+    explicit Writer(const std::string& path)
+        : text(path.size() > 4 && path.compare(path.size() - 4, 4, ".txt") == 0),
+          file(path, std::ios::out | std::ios::trunc | std::ios::binary)
+    {
+        if(!text)
+            file.write(file_magic, sizeof(file_magic) - 1);
+        thread = std::thread{[this]() { Run(); }};
+    }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    ~Writer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex);
+            stop = true;
+        }
+        stop_cv.notify_one();
+        thread.join();
+        Flush();
+    }
+
+    std::shared_ptr<Ring> AddRing()
+    {
+        auto ring = std::make_shared<Ring>();
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        rings.push_back(ring);
+        return ring;
+    }
+
+    std::uint32_t AddSite(Site site)
+    {
+        std::lock_guard<std::mutex> lock(sites_mutex);
+        sites.push_back(std::move(site));
+        return static_cast<std::uint32_t>(sites.size() - 1);
+    }
+
+    void Drop() { dropped.fetch_add(1, std::memory_order_relaxed); }
+
+    std::uint64_t Now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin)
+            .count();
+    }
+
+    void Flush()
+    {
+        std::lock_guard<std::mutex> lock(io_mutex);
+        chunk.clear();
+        {
+            std::lock_guard<std::mutex> rings_lock(rings_mutex);
+            for(const auto& ring : rings)
+                ring->Drain(chunk);
+        }
+        // The sites are taken after the records, so these include the sites of all the records.
+        {
+            std::lock_guard<std::mutex> sites_lock(sites_mutex);
+            for(; sites_written < sites.size(); ++sites_written)
+                WriteSite(static_cast<std::uint32_t>(sites_written), sites[sites_written]);
+        }
+
+        if(text)
+        {
+            for(const char* p = chunk.data(); p < chunk.data() + chunk.size();)
+            {
+                const char* record = p + 1;
+                const auto size    = Read<std::uint32_t>(record);
+                decoder.Record(record, record + size, file);
+                p = record + size;
+            }
+        }
+        else
+        {
+            file.write(chunk.data(), chunk.size());
+        }
+
+        const auto total = dropped.load(std::memory_order_relaxed);
+        if(total != dropped_written)
+        {
+            dropped_written = total;
+            if(text)
+            {
+                file << "MIOpen: " << total << " log records dropped\n";
+            }
+            else
+            {
+                file.put(DroppedTag);
+                file.write(reinterpret_cast<const char*>(&total), sizeof(total));
+            }
+        }
+        file.flush();
+    }
+
+    private:
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(stop_mutex);
+        while(!stop_cv.wait_for(lock, drain_period, [this]() { return stop; }))
+        {
+            lock.unlock();
+            Flush();
+            lock.lock();
+        }
+    }
+
+    void WriteSite(std::uint32_t id, const Site& site)
+    {
+        if(text)
+        {
+            decoder.AddSite(id, site);
+            return;
+        }
+        const auto write_string = [&](const std::string& str) {
+            const auto size = static_cast<std::uint32_t>(str.size());
+            file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            file.write(str.data(), size);
+        };
+        file.put(SiteTag);
+        file.write(reinterpret_cast<const char*>(&id), sizeof(id));
+        file.put(static_cast<char>(site.kind));
+        write_string(site.name);
+        write_string(site.params);
+    }
+
+    const Clock::time_point origin = Clock::now();
+    const bool text;
+
+    std::mutex rings_mutex;
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::mutex sites_mutex;
+    std::vector<Site> sites;
+    std::atomic<std::uint64_t> dropped{0};
+
+    std::mutex io_mutex;
+    std::ofstream file;
+    std::vector<char> chunk;
+    std::size_t sites_written     = 0;
+    std::uint64_t dropped_written = 0;
+    Decoder decoder;
+
+    std::mutex stop_mutex;
+    std::condition_variable stop_cv;
+    bool stop = false;
+    std::thread thread;
+};
+
+Writer* GetWriter()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static const auto writer = []() -> std::unique_ptr<Writer> {
+        const auto path = GetStringEnv(MIOPEN_LOG_BINARY{});
+        if(path == nullptr || *path == '\0')
+            return nullptr;
+        return std::make_unique<Writer>(path);
+    }();
+    return writer.get();
+}
+
+struct ThreadState
+{
+    std::shared_ptr<Ring> ring = GetWriter()->AddRing();
+    const std::uint32_t tid    = GetThreadId();
+    std::vector<char> buffer;
+    std::ostringstream stream;
+};
+
+ThreadState& GetThreadState()
+{
+    static thread_local ThreadState state;
+    return state;
+}
+
+} // namespace
+
+bool IsEnabled()
+{
+    static const bool enabled = GetWriter() != nullptr;
+    return enabled;
+}
+
+std::uint32_t RegisterSite(Kind kind, const std::string& name, const std::string& params)
+{
+    if(!IsEnabled())
+        return 0;
+    return GetWriter()->AddSite({kind, name, params});
+}
+
+RecordWriter::RecordWriter(std::uint32_t site) : buffer(GetThreadState().buffer)
+{
+    buffer.resize(record_header_size);
+    auto* p = buffer.data();
+    *p      = RecordTag;
+    std::memcpy(p + 5, &site, sizeof(site));
+    std::memcpy(p + 9, &GetThreadState().tid, sizeof(std::uint32_t));
+    const auto now = GetWriter()->Now();
+    std::memcpy(p + 13, &now, sizeof(now));
+}
+
+RecordWriter::~RecordWriter()
+{
+    const auto size = static_cast<std::uint32_t>(buffer.size() - 5);
+    std::memcpy(buffer.data() + 1, &size, sizeof(size));
+    if(!GetThreadState().ring->Push(buffer.data(), buffer.size()))
+        GetWriter()->Drop();
+}
+
+template <class T>
+void RecordWriter::Put(ArgType type, const T& value)
+{
+    buffer.push_back(static_cast<char>(type));
+    Put(&value, sizeof(value));
+}
+
+void RecordWriter::Put(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+void RecordWriter::Int(std::int64_t value) { Put(ArgType::Int, value); }
+
+void RecordWriter::UInt(std::uint64_t value) { Put(ArgType::UInt, value); }
+
+void RecordWriter::Double(double value) { Put(ArgType::Double, value); }
+
+void RecordWriter::Pointer(const void* value)
+{
+    Put(ArgType::Pointer, static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+}
+
+void RecordWriter::String(const char* value, std::size_t size)
+{
+    Put(ArgType::String, static_cast<std::uint32_t>(size));
+    Put(value, size);
+}
+
+void RecordWriter::Array(std::size_t count)
+{
+    Put(ArgType::Array, static_cast<std::uint32_t>(count));
+}
+
+std::ostringstream& ThreadStream() { return GetThreadState().stream; }
+
+void Message(std::uint32_t site, int level)
+{
+    auto& stream = GetThreadState().stream;
+    {
+        RecordWriter record{site};
+        record.Int(level);
+        record.String(stream.str());
+    }
+    stream.str({});
+    stream.clear();
+}
+
+void Flush()
+{
+    if(IsEnabled())
+        GetWriter()->Flush();
+}
+
+void Decode(std::istream& in, std::ostream& out)
+{
+    char magic[sizeof(file_magic) - 1];
+    if(!in.read(magic, sizeof(magic)) || std::memcmp(magic, file_magic, sizeof(magic)) != 0)
+        MIOPEN_THROW("Not a binary log of MIOpen");
+
+    const auto read = [&](auto& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+    };
+    const auto read_string = [&]() {
+        auto size = std::uint32_t{0};
+        read(size);
+        auto str = std::string(size, '\0');
+        in.read(&str[0], size);
+        return str;
+    };
+
+    auto decoder = Decoder{};
+    auto record  = std::vector<char>{};
+    for(auto tag = char{}; in.get(tag);)
+    {
+        if(tag == SiteTag)
+        {
+            auto id   = std::uint32_t{0};
+            auto site = Site{};
+            read(id);
+            site.kind = static_cast<Kind>(in.get());
+            site.name   = read_string();
+            site.params = read_string();
+            decoder.AddSite(id, std::move(site));
+        }
+        else if(tag == RecordTag)
+        {
+            auto size = std::uint32_t{0};
+            read(size);
+            record.resize(size);
+            if(!in.read(record.data(), size))
+                break;
+            decoder.Record(record.data(), record.data() + size, out);
+        }
+        else if(tag == DroppedTag)
+        {
+            auto dropped = std::uint64_t{0};
+            read(dropped);
+            out << "MIOpen: " << dropped << " log records dropped\n";
+        }
+        else
+        {
+            MIOPEN_THROW("Corrupted binary log");
+        }
+    }
+}
+
+} // namespace binlog
+} // namespace miopen
@@ -31,9 +31,13 @@
 #include <miopen/tensor.hpp>
 #include <miopen/datatype.hpp>
 
+#include <algorithm>
+
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS_INTERVAL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS_SAMPLE)
 
 bool CheckNumericsEnabled(const int bitMask)
 {
@@ -53,6 +57,36 @@ struct CheckNumericsResult
     int hasInf  = 0;
 };
 
+namespace {
+
+std::size_t CheckNumericsInterval()
+{
+    return std::max<std::size_t>(1, miopen::Value(MIOPEN_CHECK_NUMERICS_INTERVAL{}));
+}
+
+// Every n-th element is checked, starting at an offset that moves with the calls, so that a
+// repeated call eventually covers all the elements.
+int CheckNumericsSampleStride()
+{
+    const auto stride = miopen::Value(MIOPEN_CHECK_NUMERICS_SAMPLE{});
+    return static_cast<int>(std::max<std::size_t>(1, stride));
+}
+
+/// Decides whether the checks of the current call are done, called before each of them.
+bool IsSampledCall(CheckNumericsState& state, bool isInput)
+{
+    // An input check after the output checks starts the next call.
+    if(isInput && state.in_outputs)
+    {
+        state.sampled = (state.calls % CheckNumericsInterval()) == 0;
+        ++state.calls;
+    }
+    state.in_outputs = !isInput;
+    return state.sampled;
+}
+
+} // namespace
+
 bool checkNumericsImpl(
     const Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput)
 {
@@ -63,23 +97,47 @@ bool checkNumericsImpl(
     const auto numBlocks            = handle.GetMaxComputeUnits() * 6;
     const size_t numGlobalWorkItems = blockSize * numBlocks;
 
-    const int computeStats = (mode & CheckNumerics::ComputeStats);
+    const bool async       = (mode & CheckNumerics::Async) != 0;
+    const int computeStats = async ? 0 : (mode & CheckNumerics::ComputeStats);
+    const int stride       = CheckNumericsSampleStride();
 
-    CheckNumericsResult abnormal_h;
+    auto& state = handle.GetCheckNumericsState();
+    std::unique_lock<std::mutex> lock{state.mutex};
+    if(!IsSampledCall(state, isInput))
+        return false;
+    const int first = static_cast<int>(state.calls % stride);
 
-    auto abnormal_d =
-        handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
-    handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+    CheckNumericsResult abnormal_h;
 
     std::string params            = GetDataTypeKernelParams(dDesc.GetType());
     std::string program_name      = "MIOpenCheckNumerics.cl";
     std::string kernel_name       = "MIOpenCheckNumerics";
     const std::vector<size_t> vld = {size_t{blockSize}, size_t{1}, size_t{1}};
     const std::vector<size_t> vgd = {numGlobalWorkItems, size_t{1}, size_t{1}};
+
+    if(async)
+    {
+        // The flags are only cleared by the poll, so nothing is copied per check.
+        if(!state.flags)
+        {
+            state.flags = handle.Create(sizeof(CheckNumericsResult));
+            handle.WriteToAsync(&abnormal_h, state.flags.get(), sizeof(CheckNumericsResult));
+        }
+        handle.AddKernel("MIOpenCheckNumerics", "", program_name, kernel_name, vld, vgd, params)(
+            data, numElements, state.flags.get(), computeStats, first, stride);
+        ++state.pending;
+        return false;
+    }
+    lock.unlock();
+
+    auto abnormal_d =
+        handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
+    handle.WriteToAsync(&abnormal_h, abnormal_d.get(), sizeof(CheckNumericsResult));
+
     handle.AddKernel("MIOpenCheckNumerics", "", program_name, kernel_name, vld, vgd, params)(
-        data, numElements, abnormal_d.get(), computeStats);
+        data, numElements, abnormal_d.get(), computeStats, first, stride);
 
-    handle.ReadTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+    handle.ReadToOrdered(&abnormal_h, abnormal_d.get(), sizeof(CheckNumericsResult));
 
     bool isAbnormal = (abnormal_h.hasNan != 0) || (abnormal_h.hasInf != 0);
 
@@ -93,9 +151,10 @@ bool checkNumericsImpl(
         if(computeStats != 0)
         {
             assert(numElements != 0);
+            const auto checked = (numElements - first + stride - 1) / stride;
             MIOPEN_LOG((isAbnormal ? miopen::LoggingLevel::Warning : miopen::LoggingLevel::Info),
-                       "Stats: mean=" << (abnormal_h.sum / numElements)
-                                      << " absmean=" << (abnormal_h.absSum / numElements)
+                       "Stats: mean=" << (abnormal_h.sum / checked)
+                                      << " absmean=" << (abnormal_h.absSum / checked)
                                       << " min=" << abnormal_h.min << " max=" << abnormal_h.max);
         }
     }
@@ -125,6 +184,48 @@ bool checkNumericsImpl(
     return isAbnormal;
 };
 
+bool CheckNumericsPoll(const Handle& handle, bool* hasNan, bool* hasInf)
+{
+    auto& state = handle.GetCheckNumericsState();
+    std::lock_guard<std::mutex> lock{state.mutex};
+
+    auto abnormal_h = CheckNumericsResult{};
+    if(state.flags && state.pending != 0)
+    {
+        // Reading back on the stream of the handle waits for the enqueued checks.
+        handle.ReadToOrdered(&abnormal_h, state.flags.get(), sizeof(CheckNumericsResult));
+        const auto zeros = CheckNumericsResult{};
+        handle.WriteToAsync(&zeros, state.flags.get(), sizeof(CheckNumericsResult));
+    }
+
+    const bool isAbnormal = (abnormal_h.hasNan != 0) || (abnormal_h.hasInf != 0);
+    if(hasNan != nullptr)
+        *hasNan = abnormal_h.hasNan != 0;
+    if(hasInf != nullptr)
+        *hasInf = abnormal_h.hasInf != 0;
+
+    const auto checks = state.pending;
+    state.pending     = 0;
+
+    const auto mode = static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{}));
+    if(((mode & CheckNumerics::Info) != 0) || (((mode & CheckNumerics::Warn) != 0) && isAbnormal))
+    {
+        MIOPEN_LOG((isAbnormal ? miopen::LoggingLevel::Warning : miopen::LoggingLevel::Info),
+                   "checks=" << checks << " nans=" << abnormal_h.hasNan
+                             << " infs=" << abnormal_h.hasInf);
+    }
+
+    if(isAbnormal)
+    {
+        if((mode & CheckNumerics::Throw) != 0)
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "abnormal checkNumerics result detected by the asynchronous checks");
+        if((mode & CheckNumerics::Abort) != 0)
+            abort();
+    }
+    return isAbnormal;
+}
+
 // Checks data for input
 // Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise
 bool checkNumericsInput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data)
@@ -133,14 +234,16 @@ bool checkNumericsInput(const Handle& handle, const TensorDescriptor& dDesc, Con
         handle, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})), dDesc, data, true);
 }
 
-// Synchronizes to wait for kernel to finish, then checks data for output:
+// Synchronizes to wait for kernel to finish unless asynchronous, then checks data for output:
 // Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise
 bool checkNumericsOutput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data)
 {
-    handle.Finish();
+    const auto mode = static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{}));
+    // The asynchronous checks are enqueued after the call on the same stream.
+    if((mode & CheckNumerics::Async) == 0)
+        handle.Finish();
 
-    return checkNumericsImpl(
-        handle, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})), dDesc, data, false);
+    return checkNumericsImpl(handle, mode, dDesc, data, false);
 }
 
 } // namespace miopen
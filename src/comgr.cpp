@@ -28,6 +28,7 @@
 
 #include <miopen/comgr.hpp>
 #include <miopen/algorithm.hpp>
+#include <miopen/compile_stats.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/hip_build_utils.hpp>
@@ -37,6 +38,7 @@
 #include <miopen/rocm_features.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
 #include <miopen/stringutils.hpp>
+#include <miopen/timer.hpp>
 
 #include <amd_comgr.h>
 #include <hip/hip_runtime_api.h>
@@ -640,9 +642,12 @@ class ActionInfo : ComgrOwner
     }
     void Do(const amd_comgr_action_kind_t kind, const Dataset& in, const Dataset& out) const
     {
+        Timer timer;
+        timer.start();
         ECI_THROW_MSG(amd_comgr_do_action(kind, handle, in.GetHandle(), out.GetHandle()),
                       kind,
                       GetLog(out, true));
+        CompileStats::Get().AddComgrAction(to_string(kind), timer.elapsed_ms());
         const auto log = GetLog(out);
         if(!log.empty())
             MIOPEN_LOG_I(to_string(kind) << ": " << log);
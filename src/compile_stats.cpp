@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_stats.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_STATS_FILE)
+
+namespace miopen {
+
+namespace {
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+thread_local std::string current_solver;
+
+void WriteString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for(const auto c : str)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+               << std::dec << std::setfill(' ');
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+const char* GetCacheName(std::size_t cache)
+{
+    switch(static_cast<CompileCache>(cache))
+    {
+    case CompileCache::Kernels: return "kernels";
+    case CompileCache::Binaries: return "binaries";
+    case CompileCache::Shared: return "shared";
+    case CompileCache::Process: return "process";
+    case CompileCache::Count: break;
+    }
+    return "unknown";
+}
+
+} // namespace
+
+CompileStats& CompileStats::Get()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static CompileStats stats;
+    return stats;
+}
+
+CompileStats::SolverScope::SolverScope(const std::string& solver) : previous(current_solver)
+{
+    current_solver = solver;
+}
+
+CompileStats::SolverScope::~SolverScope() { current_solver = previous; }
+
+void CompileStats::Total::Add(double time)
+{
+    ++count;
+    ms += time;
+    max_ms = std::max(max_ms, time);
+}
+
+void CompileStats::AddBuild(const std::string& program, double ms)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    programs[program].Add(ms);
+    if(!current_solver.empty())
+        solvers[current_solver].Add(ms);
+}
+
+void CompileStats::AddLookup(CompileCache cache, bool hit)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ++(hit ? hits : misses)[static_cast<std::size_t>(cache)];
+}
+
+void CompileStats::AddDecompression(std::size_t bytes, double ms)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    decompression.Add(ms);
+    decompressed_bytes += bytes;
+}
+
+void CompileStats::AddComgrAction(const std::string& action, double ms)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    comgr_actions[action].Add(ms);
+}
+
+std::string CompileStats::ToJson() const
+{
+    std::ostringstream os;
+    const auto write_total = [&](const Total& total) {
+        os << "\"count\": " << total.count << ", \"ms\": " << total.ms
+           << ", \"max_ms\": " << total.max_ms;
+    };
+    const auto write_totals = [&](const char* name, const std::map<std::string, Total>& totals) {
+        os << '"' << name << "\": {";
+        auto first = true;
+        for(const auto& total : totals)
+        {
+            os << (first ? "" : ", ");
+            WriteString(os, total.first);
+            os << ": {";
+            write_total(total.second);
+            os << '}';
+            first = false;
+        }
+        os << '}';
+    };
+
+    std::lock_guard<std::mutex> lock(mutex);
+    os << '{';
+    write_totals("programs", programs);
+    os << ", ";
+    write_totals("solvers", solvers);
+    os << ", ";
+    write_totals("comgr_actions", comgr_actions);
+    os << ", \"caches\": {";
+    for(std::size_t i = 0; i < hits.size(); ++i)
+    {
+        os << (i == 0 ? "" : ", ") << '"' << GetCacheName(i) << "\": {\"hits\": " << hits[i]
+           << ", \"misses\": " << misses[i] << '}';
+    }
+    os << "}, \"decompression\": {";
+    write_total(decompression);
+    os << ", \"bytes\": " << decompressed_bytes << "}}";
+    return os.str();
+}
+
+void CompileStats::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    programs.clear();
+    solvers.clear();
+    comgr_actions.clear();
+    hits.fill(0);
+    misses.fill(0);
+    decompression      = {};
+    decompressed_bytes = 0;
+}
+
+void CompileStats::Dump() const
+{
+    const char* const path = GetStringEnv(MIOPEN_COMPILE_STATS_FILE{});
+    if(path == nullptr || *path == '\0')
+        return;
+    std::ofstream file{path, std::ios::trunc};
+    file << ToJson() << std::endl;
+    if(!file)
+        MIOPEN_LOG_W("Unable to write compile statistics to " << path);
+}
+
+} // namespace miopen
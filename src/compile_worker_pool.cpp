@@ -0,0 +1,275 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_worker_pool.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/target_properties.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif // __linux__
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_WORKERS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_WORKER_PATH)
+
+namespace miopen {
+
+namespace compile_worker {
+
+std::string GetTargetName(const TargetProperties& target)
+{
+    auto name = target.Name();
+    if(target.SrameccReported())
+        name += *target.SrameccReported() ? ":sramecc+" : ":sramecc-";
+    if(target.Xnack())
+        name += *target.Xnack() ? ":xnack+" : ":xnack-";
+    return name;
+}
+
+#ifdef __linux__
+static bool SendAll(int fd, const char* data, std::size_t size)
+{
+    while(size > 0)
+    {
+        const auto sent = send(fd, data, size, MSG_NOSIGNAL);
+        if(sent <= 0)
+            return false;
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+static bool RecvAll(int fd, char* data, std::size_t size)
+{
+    while(size > 0)
+    {
+        const auto received = recv(fd, data, size, 0);
+        if(received <= 0)
+            return false;
+        data += received;
+        size -= received;
+    }
+    return true;
+}
+
+bool WriteMessage(int fd, const std::string& data)
+{
+    const auto header = std::to_string(data.size()) + '\n';
+    return SendAll(fd, header.data(), header.size()) && SendAll(fd, data.data(), data.size());
+}
+
+bool ReadMessage(int fd, std::string& data)
+{
+    std::size_t size = 0;
+    char c           = 0;
+    while(true)
+    {
+        if(!RecvAll(fd, &c, 1))
+            return false;
+        if(c == '\n')
+            break;
+        if(c < '0' || c > '9')
+            return false;
+        size = size * 10 + (c - '0');
+    }
+    data.resize(size);
+    return size == 0 || RecvAll(fd, &data[0], size);
+}
+#else
+bool WriteMessage(int, const std::string&) { return false; }
+bool ReadMessage(int, std::string&) { return false; }
+#endif // __linux__
+
+} // namespace compile_worker
+
+struct CompileWorkerPool::State
+{
+    struct Worker
+    {
+        int fd    = -1;
+        int pid   = -1;
+        bool busy = false;
+    };
+
+    std::mutex mutex;
+    std::condition_variable released;
+    std::vector<Worker> workers;
+    std::string target;
+    bool broken = false;
+
+    State() : workers(Value(MIOPEN_COMPILE_WORKERS{}, 0)) {}
+
+    ~State()
+    {
+        for(auto& worker : workers)
+            Stop(worker);
+    }
+
+#ifdef __linux__
+    bool Start(Worker& worker) const
+    {
+        const char* const custom = GetStringEnv(MIOPEN_COMPILE_WORKER_PATH{});
+        const std::string exe    = custom != nullptr ? custom : "miopen_compile_worker";
+
+        int fds[2];
+        if(socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+            return false;
+
+        const auto pid = fork();
+        if(pid == 0)
+        {
+            // Only async-signal-safe calls are allowed in the child of a threaded process.
+            dup2(fds[1], 0);
+            dup2(fds[1], 1);
+            execlp(exe.c_str(), exe.c_str(), "--arch", target.c_str(), nullptr);
+            _exit(127);
+        }
+        close(fds[1]);
+        if(pid < 0)
+        {
+            close(fds[0]);
+            return false;
+        }
+
+        worker.fd  = fds[0];
+        worker.pid = pid;
+        MIOPEN_LOG_I2("Started " << exe << " --arch " << target << ", pid " << pid);
+        return true;
+    }
+
+    static void Stop(Worker& worker)
+    {
+        if(worker.fd < 0)
+            return;
+        // The worker exits on end of input.
+        close(worker.fd);
+        waitpid(worker.pid, nullptr, 0);
+        worker.fd  = -1;
+        worker.pid = -1;
+    }
+#else
+    bool Start(Worker&) const { return false; }
+    static void Stop(Worker&) {}
+#endif // __linux__
+
+    Worker* Acquire(const std::string& job_target)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if(target.empty())
+            target = job_target;
+        if(broken || target != job_target)
+            return nullptr;
+
+        Worker* worker = nullptr;
+        released.wait(lock, [&]() {
+            const auto free = std::find_if(
+                workers.begin(), workers.end(), [](const auto& w) { return !w.busy; });
+            worker = free != workers.end() ? &*free : nullptr;
+            return worker != nullptr;
+        });
+        worker->busy = true;
+
+        if(worker->fd < 0 && !Start(*worker))
+        {
+            MIOPEN_LOG_W("Unable to start a compile worker, building in-process from now on");
+            broken       = true;
+            worker->busy = false;
+            released.notify_all();
+            return nullptr;
+        }
+        return worker;
+    }
+
+    void Release(Worker& worker, bool healthy)
+    {
+        if(!healthy)
+            Stop(worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            worker.busy = false;
+        }
+        released.notify_one();
+    }
+};
+
+CompileWorkerPool& CompileWorkerPool::Get()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static CompileWorkerPool pool;
+    return pool;
+}
+
+CompileWorkerPool::CompileWorkerPool() : state(std::make_unique<State>()) {}
+CompileWorkerPool::~CompileWorkerPool() = default;
+
+bool CompileWorkerPool::IsEnabled() const { return !state->workers.empty(); }
+std::size_t CompileWorkerPool::GetSize() const { return state->workers.size(); }
+
+std::string CompileWorkerPool::Build(const std::string& program_name,
+                                     const std::string& params,
+                                     const TargetProperties& target)
+{
+    if(!IsEnabled())
+        return {};
+
+    auto* const worker = state->Acquire(compile_worker::GetTargetName(target));
+    if(worker == nullptr)
+        return {};
+
+    std::string status;
+    std::string binary;
+    const auto healthy = compile_worker::WriteMessage(worker->fd, program_name) &&
+                         compile_worker::WriteMessage(worker->fd, params) &&
+                         compile_worker::ReadMessage(worker->fd, status) &&
+                         compile_worker::ReadMessage(worker->fd, binary);
+    state->Release(*worker, healthy);
+
+    if(!healthy)
+    {
+        MIOPEN_LOG_W("Compile worker failed on " << program_name << ", restarting it");
+        return {};
+    }
+    if(!status.empty())
+    {
+        MIOPEN_LOG_I(program_name << ": " << status);
+        return {};
+    }
+    return binary;
+}
+
+} // namespace miopen
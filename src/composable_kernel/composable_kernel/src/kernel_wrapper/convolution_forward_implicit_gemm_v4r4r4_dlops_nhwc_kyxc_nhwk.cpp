@@ -0,0 +1,299 @@
+#include "common_header.hpp"
+#include "tensor_descriptor.hpp"
+#include "tensor_descriptor_helper.hpp"
+#include "gridwise_gemm_dlops_v1r3.hpp"
+#include "transform_forward_convolution_into_gemm_v4r4r4_nhwc_kyxc_nhwk.hpp"
+
+using namespace ck;
+
+constexpr DataTypeEnum_t ABDataTypeEnum  = static_cast<DataTypeEnum_t>(CK_PARAM_ABDataTypeEnum);
+constexpr DataTypeEnum_t AccDataTypeEnum = static_cast<DataTypeEnum_t>(CK_PARAM_AccDataTypeEnum);
+constexpr DataTypeEnum_t CDataTypeEnum   = static_cast<DataTypeEnum_t>(CK_PARAM_CDataTypeEnum);
+
+using FloatAB  = typename get_datatype_from_enum<ABDataTypeEnum>::type;
+using FloatAcc = typename get_datatype_from_enum<AccDataTypeEnum>::type;
+using FloatC   = typename get_datatype_from_enum<CDataTypeEnum>::type;
+
+constexpr index_t BlockSize = CK_PARAM_BlockSize;
+
+constexpr auto GK1 = Number<CK_PARAM_GK1>{};
+
+constexpr index_t GM1PerBlockGM11 = CK_PARAM_GM1PerBlockGM11;
+constexpr index_t GN1PerBlockGN11 = CK_PARAM_GN1PerBlockGN11;
+constexpr index_t GK0PerBlock     = CK_PARAM_GK0PerBlock;
+
+constexpr index_t BM1PerThreadBM11 = CK_PARAM_BM1PerThreadBM11;
+constexpr index_t BN1PerThreadBN11 = CK_PARAM_BN1PerThreadBN11;
+constexpr index_t BK0PerThread     = CK_PARAM_BK0PerThread;
+
+using BM10BN10ThreadClusterBM10Xs = Sequence<CK_PARAM_BM10BN10ThreadClusterBM10Xs>;
+using BM10BN10ThreadClusterBN10Xs = Sequence<CK_PARAM_BM10BN10ThreadClusterBN10Xs>;
+
+using ABlockTransferThreadSliceLengths_GK0_GM0_GM1_GK1 =
+    Sequence<CK_PARAM_ABlockTransferThreadSliceLengths_GK0_GM0_GM1_GK1>;
+using ABlockTransferThreadClusterLengths_GK0_GM0_GM1_GK1 =
+    Sequence<CK_PARAM_ABlockTransferThreadClusterLengths_GK0_GM0_GM1_GK1>;
+using ABlockTransferThreadClusterArrangeOrder = Sequence<1, 2, 0, 3>;
+using ABlockTransferSrcAccessOrder            = Sequence<1, 2, 0, 3>;
+using ABlockTransferSrcVectorTensorLengths_GK0_GM0_GM1_GK1 =
+    Sequence<CK_PARAM_ABlockTransferSrcVectorTensorLengths_GK0_GM0_GM1_GK1>;
+using ABlockTransferSrcVectorTensorContiguousDimOrder = Sequence<1, 2, 0, 3>;
+using ABlockTransferDstVectorTensorLengths_GK0_GM0_GM1_GK1 =
+    Sequence<CK_PARAM_ABlockTransferDstVectorTensorLengths_GK0_GM0_GM1_GK1>;
+
+using BBlockTransferThreadSliceLengths_GK0_GN0_GN1_GK1 =
+    Sequence<CK_PARAM_BBlockTransferThreadSliceLengths_GK0_GN0_GN1_GK1>;
+using BBlockTransferThreadClusterLengths_GK0_GN0_GN1_GK1 =
+    Sequence<CK_PARAM_BBlockTransferThreadClusterLengths_GK0_GN0_GN1_GK1>;
+using BBlockTransferThreadClusterArrangeOrder = Sequence<1, 2, 0, 3>;
+using BBlockTransferSrcAccessOrder            = Sequence<1, 2, 0, 3>;
+using BBlockTransferSrcVectorTensorLengths_GK0_GN0_GN1_GK1 =
+    Sequence<CK_PARAM_BBlockTransferSrcVectorTensorLengths_GK0_GN0_GN1_GK1>;
+using BBlockTransferSrcVectorTensorContiguousDimOrder = Sequence<1, 2, 0, 3>;
+using BBlockTransferDstVectorTensorLengths_GK0_GN0_GN1_GK1 =
+    Sequence<CK_PARAM_BBlockTransferDstVectorTensorLengths_GK0_GN0_GN1_GK1>;
+
+using CThreadTransferSrcDstAccessOrder              = Sequence<0, 1, 2, 3, 4, 5>;
+constexpr index_t CThreadTransferSrcDstVectorDim    = 5;
+constexpr index_t CThreadTransferDstScalarPerVector = CK_PARAM_CThreadTransferDstScalarPerVector;
+
+constexpr bool HasMainKBlockLoop       = static_cast<bool>(CK_PARAM_HasMainKBlockLoop);
+constexpr bool HasDoubleTailKBlockLoop = static_cast<bool>(CK_PARAM_HasDoubleTailKBlockLoop);
+
+using AGridStepHacks = decltype(make_tuple(
+    make_tuple(Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0>{},    // 0+: GK0
+               Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0>{},    // 1+: GM0
+               Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0>{},    // 2+: GM1
+               Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0>{}),   // 3+: GK1
+    make_tuple(Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0>{},    // 0-: GK0
+               Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0>{},    // 1-: GM0
+               Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0>{},    // 2-: GM1
+               Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0>{}))); // 3-: GK1
+
+using BGridStepHacks =
+    decltype(make_tuple(make_tuple(Sequence<0, 0, 0, 0, 0, 0, 0, 0>{},    // 0+: GK0
+                                   Sequence<0, 0, 0, 0, 0, 0, 0, 0>{},    // 1+: GN0
+                                   Sequence<0, 0, 0, 0, 0, 0, 0, 0>{},    // 2+: GN1
+                                   Sequence<0, 0, 0, 0, 0, 0, 0, 0>{}),   // 3+: GK1
+                        make_tuple(Sequence<0, 0, 0, 0, 0, 0, 0, 0>{},    // 0-: GK0
+                                   Sequence<0, 0, 0, 0, 0, 0, 0, 0>{},    // 1-: GN0
+                                   Sequence<0, 0, 0, 0, 0, 0, 0, 0>{},    // 2-: GN1
+                                   Sequence<0, 0, 0, 0, 0, 0, 0, 0>{}))); // 3-: GK1
+
+using CGridStepHacks = decltype(make_tuple(make_tuple(Sequence<0, 0, 0, 0, 0>{},    // 0+: GM0
+                                                      Sequence<0, 0, 0, 0, 0>{},    // 1+: GM10
+                                                      Sequence<0, 0, 0, 0, 0>{},    // 2+: GM11
+                                                      Sequence<0, 0, 0, 0, 0>{},    // 3+: GN0
+                                                      Sequence<0, 0, 0, 0, 0>{},    // 4+: GN10
+                                                      Sequence<0, 0, 0, 0, 0>{}),   // 5+: GN11
+                                           make_tuple(Sequence<0, 0, 0, 0, 0>{},    // 0-: GM0
+                                                      Sequence<0, 0, 0, 0, 0>{},    // 1-: GM10
+                                                      Sequence<0, 0, 0, 0, 0>{},    // 2-: GM11
+                                                      Sequence<0, 0, 0, 0, 0>{},    // 3-: GN0
+                                                      Sequence<0, 0, 0, 0, 0>{},    // 4-: GN10
+                                                      Sequence<0, 0, 0, 0, 0>{}))); // 5-: GN11
+
+using AGridMoveSliceWindowStepHacks = Sequence<0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0, 0, 0, 0, 0>;
+using BGridMoveSliceWindowStepHacks = Sequence<0, 0, 0, 0, 0, 0, 0, 0>;
+
+template <typename AGridDesc_GK0_GM_GK1, typename BGridDesc_GK0_GN_GK1, typename CGridDesc_GM_GN>
+using GridwiseGemmFor =
+    GridwiseGemmDlops_km_kn_mn_v1r3<BlockSize,
+                                    FloatAB,
+                                    FloatAcc,
+                                    FloatC,
+                                    InMemoryDataOperationEnum_t::Set,
+                                    AGridDesc_GK0_GM_GK1,
+                                    BGridDesc_GK0_GN_GK1,
+                                    CGridDesc_GM_GN,
+                                    GM1PerBlockGM11,
+                                    GN1PerBlockGN11,
+                                    GK0PerBlock,
+                                    BM1PerThreadBM11,
+                                    BN1PerThreadBN11,
+                                    BK0PerThread,
+                                    BM10BN10ThreadClusterBM10Xs,
+                                    BM10BN10ThreadClusterBN10Xs,
+                                    ABlockTransferThreadSliceLengths_GK0_GM0_GM1_GK1,
+                                    ABlockTransferThreadClusterLengths_GK0_GM0_GM1_GK1,
+                                    ABlockTransferThreadClusterArrangeOrder,
+                                    ABlockTransferSrcAccessOrder,
+                                    ABlockTransferSrcVectorTensorLengths_GK0_GM0_GM1_GK1,
+                                    ABlockTransferSrcVectorTensorContiguousDimOrder,
+                                    ABlockTransferDstVectorTensorLengths_GK0_GM0_GM1_GK1,
+                                    BBlockTransferThreadSliceLengths_GK0_GN0_GN1_GK1,
+                                    BBlockTransferThreadClusterLengths_GK0_GN0_GN1_GK1,
+                                    BBlockTransferThreadClusterArrangeOrder,
+                                    BBlockTransferSrcAccessOrder,
+                                    BBlockTransferSrcVectorTensorLengths_GK0_GN0_GN1_GK1,
+                                    BBlockTransferSrcVectorTensorContiguousDimOrder,
+                                    BBlockTransferDstVectorTensorLengths_GK0_GN0_GN1_GK1,
+                                    CThreadTransferSrcDstAccessOrder,
+                                    CThreadTransferSrcDstVectorDim,
+                                    CThreadTransferDstScalarPerVector,
+                                    AGridStepHacks,
+                                    BGridStepHacks,
+                                    CGridStepHacks,
+                                    AGridMoveSliceWindowStepHacks,
+                                    BGridMoveSliceWindowStepHacks>;
+
+extern "C" __global__ void
+convolution_forward_implicit_gemm_v4r4r4_dlops_nhwc_kyxc_nhwk_prepare(int N_,
+                                                                      int C_,
+                                                                      int Hi_,
+                                                                      int Wi_,
+                                                                      int K_,
+                                                                      int Y_,
+                                                                      int X_,
+                                                                      int ConvStrideH_,
+                                                                      int ConvStrideW_,
+                                                                      int ConvDilationH_,
+                                                                      int ConvDilationW_,
+                                                                      int InLeftPadH_,
+                                                                      int InLeftPadW_,
+                                                                      int InRightPadH_,
+                                                                      int InRightPadW_,
+                                                                      void* p_desc_tuple)
+{
+    index_t N             = static_cast<index_t>(N_);
+    index_t C             = static_cast<index_t>(C_);
+    index_t Hi            = static_cast<index_t>(Hi_);
+    index_t Wi            = static_cast<index_t>(Wi_);
+    index_t K             = static_cast<index_t>(K_);
+    index_t Y             = static_cast<index_t>(Y_);
+    index_t X             = static_cast<index_t>(X_);
+    index_t ConvStrideH   = static_cast<index_t>(ConvStrideH_);
+    index_t ConvStrideW   = static_cast<index_t>(ConvStrideW_);
+    index_t ConvDilationH = static_cast<index_t>(ConvDilationH_);
+    index_t ConvDilationW = static_cast<index_t>(ConvDilationW_);
+    index_t InLeftPadH    = static_cast<index_t>(InLeftPadH_);
+    index_t InLeftPadW    = static_cast<index_t>(InLeftPadW_);
+    index_t InRightPadH   = static_cast<index_t>(InRightPadH_);
+    index_t InRightPadW   = static_cast<index_t>(InRightPadW_);
+
+    constexpr auto I0 = Number<0>{};
+    constexpr auto I1 = Number<1>{};
+    constexpr auto I2 = Number<2>{};
+
+    const index_t Ho =
+        (Hi + InLeftPadH + InRightPadH - ConvDilationH * (Y - 1) - 1) / ConvStrideH + 1;
+    const index_t Wo =
+        (Wi + InLeftPadW + InRightPadW - ConvDilationW * (X - 1) - 1) / ConvStrideW + 1;
+
+    const auto in_n_hi_wi_c_desc  = make_naive_tensor_descriptor_packed(make_tuple(N, Hi, Wi, C));
+    const auto wei_k_y_x_c_desc   = make_naive_tensor_descriptor_packed(make_tuple(K, Y, X, C));
+    const auto out_n_ho_wo_k_desc = make_naive_tensor_descriptor_packed(make_tuple(N, Ho, Wo, K));
+
+    const auto descs = transform_forward_convolution_into_gemm_v4r4r4_nhwc_kyxc_nhwk_pad(
+        in_n_hi_wi_c_desc,
+        wei_k_y_x_c_desc,
+        out_n_ho_wo_k_desc,
+        make_tuple(ConvStrideH, ConvStrideW),
+        make_tuple(ConvDilationH, ConvDilationW),
+        make_tuple(InLeftPadH, InLeftPadW),
+        make_tuple(InRightPadH, InRightPadW),
+        GK1);
+
+    const auto a_grid_desc_gk0_gm_gk1 = descs[I0];
+    const auto b_grid_desc_gk0_gn_gk1 = descs[I1];
+    const auto c_grid_desc_gm_gn      = descs[I2];
+
+    using GridwiseGemm = GridwiseGemmFor<decltype(a_grid_desc_gk0_gm_gk1),
+                                         decltype(b_grid_desc_gk0_gn_gk1),
+                                         decltype(c_grid_desc_gm_gn)>;
+
+    if(get_block_1d_id() == 0 && get_thread_local_1d_id() == 0)
+    {
+        auto desc_tuple = make_tuple(
+            GridwiseGemm::MakeAK0M0M1K1GridDescriptor(a_grid_desc_gk0_gm_gk1),
+            GridwiseGemm::MakeBK0N0N1K1GridDescriptor(b_grid_desc_gk0_gn_gk1),
+            GridwiseGemm::MakeCM0M10M11N0N10N11GridDescriptor(c_grid_desc_gm_gn),
+            GridwiseGemm::MakeCBlockIdToM0N0BlockClusterAdaptor(c_grid_desc_gm_gn));
+
+        *static_cast<decltype(desc_tuple)*>(p_desc_tuple) = desc_tuple;
+    }
+};
+
+extern "C" __global__ void
+#if CK_USE_LAUNCH_BOUNDS
+    __launch_bounds__(CK_MAX_THREAD_PER_BLOCK, CK_MIN_BLOCK_PER_CU)
+#endif
+        convolution_forward_implicit_gemm_v4r4r4_dlops_nhwc_kyxc_nhwk(
+            const FloatAB* __restrict__ p_a_grid,
+            const FloatAB* __restrict__ p_b_grid,
+            FloatC* __restrict__ p_c_grid,
+            const void CONSTANT* p_desc_tuple)
+{
+    constexpr auto I0 = Number<0>{};
+    constexpr auto I1 = Number<1>{};
+    constexpr auto I2 = Number<2>{};
+    constexpr auto I3 = Number<3>{};
+
+    constexpr auto in_n_hi_wi_c_desc =
+        make_naive_tensor_descriptor_packed(make_tuple(256, 28, 28, 256));
+    constexpr auto wei_k_y_x_c_desc =
+        make_naive_tensor_descriptor_packed(make_tuple(256, 3, 3, 256));
+    constexpr auto out_n_ho_wo_k_desc =
+        make_naive_tensor_descriptor_packed(make_tuple(256, 28, 28, 256));
+
+    constexpr auto descs =
+        transform_forward_convolution_into_gemm_v4r4r4_nhwc_kyxc_nhwk_pad(in_n_hi_wi_c_desc,
+                                                                          wei_k_y_x_c_desc,
+                                                                          out_n_ho_wo_k_desc,
+                                                                          make_tuple(1, 1),
+                                                                          make_tuple(1, 1),
+                                                                          make_tuple(1, 1),
+                                                                          make_tuple(1, 1),
+                                                                          GK1);
+
+    constexpr auto a_grid_desc_gk0_gm_gk1 = descs[I0];
+    constexpr auto b_grid_desc_gk0_gn_gk1 = descs[I1];
+    constexpr auto c_grid_desc_gm_gn      = descs[I2];
+
+    using GridwiseGemm = GridwiseGemmFor<decltype(a_grid_desc_gk0_gm_gk1),
+                                         decltype(b_grid_desc_gk0_gn_gk1),
+                                         decltype(c_grid_desc_gm_gn)>;
+
+    using AGridDesc_GK0_GM0_GM1_GK1 =
+        decltype(GridwiseGemm::MakeAK0M0M1K1GridDescriptor(a_grid_desc_gk0_gm_gk1));
+    using BGridDesc_GK0_GN0_GN1_GK1 =
+        decltype(GridwiseGemm::MakeBK0N0N1K1GridDescriptor(b_grid_desc_gk0_gn_gk1));
+    using CGridDesc_GM0_GM10_GM11_GN0_GN10_GN11 =
+        decltype(GridwiseGemm::MakeCM0M10M11N0N10N11GridDescriptor(c_grid_desc_gm_gn));
+    using CGridBlockCluster_BlockId_To_GM0_GN0 =
+        decltype(GridwiseGemm::MakeCBlockIdToM0N0BlockClusterAdaptor(c_grid_desc_gm_gn));
+
+    using DescTuple = decltype(make_tuple(AGridDesc_GK0_GM0_GM1_GK1{},
+                                          BGridDesc_GK0_GN0_GN1_GK1{},
+                                          CGridDesc_GM0_GM10_GM11_GN0_GN10_GN11{},
+                                          CGridBlockCluster_BlockId_To_GM0_GN0{}));
+
+    const auto desc_tuple = *reinterpret_cast<const DescTuple*>(
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wold-style-cast"
+        // TODO: how to cast?
+        (const void*)p_desc_tuple
+#pragma clang diagnostic pop
+    );
+
+    const auto a_grid_desc_gk0_gm0_gm1_gk1             = desc_tuple[I0];
+    const auto b_grid_desc_gk0_gn0_gn1_gk1             = desc_tuple[I1];
+    const auto c_grid_desc_gm0_gm10_gm11_gn0_gn10_gn11 = desc_tuple[I2];
+    const auto c_grid_block_cluster_blockid_to_gm0_gn0 = desc_tuple[I3];
+
+    constexpr index_t shared_block_size =
+        GridwiseGemm::GetSharedMemoryNumberOfByte() / sizeof(FloatAB);
+
+    __shared__ FloatAB p_shared_block[shared_block_size];
+
+    GridwiseGemm::Run(p_a_grid,
+                      p_b_grid,
+                      p_c_grid,
+                      p_shared_block,
+                      a_grid_desc_gk0_gm0_gm1_gk1,
+                      b_grid_desc_gk0_gn0_gn1_gk1,
+                      c_grid_desc_gm0_gm10_gm11_gn0_gn10_gn11,
+                      c_grid_block_cluster_blockid_to_gm0_gn0,
+                      integral_constant<bool, HasMainKBlockLoop>{},
+                      integral_constant<bool, HasDoubleTailKBlockLoop>{});
+};
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/batch_split.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <limits>
+#include <tuple>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_BATCH_SPLIT)
+/// Elements of a chunk, for testing, 0 sets the limit of the 32-bit indices.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_BATCH_SPLIT_MAX_ELEMENTS)
+
+namespace conv {
+
+namespace {
+
+TensorDescriptor WithBatchSize(const TensorDescriptor& desc, std::size_t batch_size)
+{
+    // The batch is the outermost dimension for all the layouts, so the strides stay the same.
+    auto lengths = desc.GetLengths();
+    lengths[0]   = batch_size;
+    return {desc.GetType(), lengths, desc.GetStrides()};
+}
+
+/// Elements spanned by the first \p images of the batch.
+std::size_t GetChunkSpace(const TensorDescriptor& desc, std::size_t images)
+{
+    const auto batch = desc.GetLengths()[0];
+    return desc.GetElementSpace() - (batch - images) * desc.GetStrides()[0];
+}
+
+} // namespace
+
+BatchSplit::BatchSplit(const TensorDescriptor& in, const TensorDescriptor& out)
+{
+#if MIOPEN_BACKEND_HIP
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_BATCH_SPLIT{}))
+        return;
+
+    auto limit = static_cast<std::size_t>(
+        miopen::Value(MIOPEN_DEBUG_CONV_BATCH_SPLIT_MAX_ELEMENTS{}));
+    if(limit == 0)
+        limit = std::numeric_limits<int>::max();
+
+    const auto fits = [&](std::size_t images) {
+        return GetChunkSpace(in, images) <= limit && GetChunkSpace(out, images) <= limit;
+    };
+
+    const auto batch = in.GetLengths()[0];
+    if(batch < 2 || fits(batch) || !fits(1))
+        return;
+
+    // The chunks have the same size, so that they share the problem of a single chunk.
+    auto images = batch / 2;
+    while(batch % images != 0 || !fits(images))
+        --images;
+
+    chunks          = batch / images;
+    in_chunk        = WithBatchSize(in, images);
+    out_chunk       = WithBatchSize(out, images);
+    in_chunk_bytes  = images * in.GetStrides()[0] * GetTypeSize(in.GetType());
+    out_chunk_bytes = images * out.GetStrides()[0] * GetTypeSize(out.GetType());
+    MIOPEN_LOG_I2("Splitting the batch of " << batch << " into " << chunks << " chunks");
+#else
+    std::ignore = in;
+    std::ignore = out;
+#endif
+}
+
+ConstData_t BatchSplit::In(ConstData_t in, std::size_t chunk) const
+{
+#if MIOPEN_BACKEND_HIP
+    return static_cast<const char*>(in) + chunk * in_chunk_bytes;
+#else
+    if(chunk != 0)
+        MIOPEN_THROW(miopenStatusInternalError);
+    return in;
+#endif
+}
+
+Data_t BatchSplit::Out(Data_t out, std::size_t chunk) const
+{
+#if MIOPEN_BACKEND_HIP
+    return static_cast<char*>(out) + chunk * out_chunk_bytes;
+#else
+    if(chunk != 0)
+        MIOPEN_THROW(miopenStatusInternalError);
+    return out;
+#endif
+}
+
+} // namespace conv
+} // namespace miopen
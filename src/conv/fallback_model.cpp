@@ -0,0 +1,224 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/fallback_model.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+constexpr const char* model_magic = "MIOpenFallbackModel";
+constexpr int model_version       = 1;
+
+std::shared_ptr<const FallbackModel> LoadFallbackModel(const boost::filesystem::path& path)
+{
+    if(!boost::filesystem::exists(path))
+        return nullptr;
+
+    std::ifstream file{path.string()};
+    try
+    {
+        auto model = std::shared_ptr<const FallbackModel>{DecisionTreeModel::Load(file)};
+        MIOPEN_LOG_I("Loaded fallback model " << path.string());
+        return model;
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_W("Invalid fallback model " << path.string() << ": " << ex.what());
+        return nullptr;
+    }
+}
+
+} // namespace
+
+FallbackFeatures GetFallbackFeatures(const ProblemDescription& problem)
+{
+    const auto f         = [](auto value) { return static_cast<float>(value); };
+    const auto direction = problem.GetDirection();
+    const auto direction_index =
+        direction == Direction::Forward ? 0 : direction == Direction::BackwardData ? 1 : 2;
+
+    // clang-format off
+    return {{
+        f(direction_index),
+        f(problem.GetInDataType()),
+        problem.IsLayoutDefault() ? 0.0f : 1.0f,
+        f(problem.GetSpatialDims()),
+        f(problem.GetInBatchSize()),
+        f(problem.GetInChannels()),
+        f(problem.GetInDepth()),
+        f(problem.GetInHeight()),
+        f(problem.GetInWidth()),
+        f(problem.GetOutChannels()),
+        f(problem.GetOutDepth()),
+        f(problem.GetOutHeight()),
+        f(problem.GetOutWidth()),
+        f(problem.GetWeightsDepth()),
+        f(problem.GetWeightsHeight()),
+        f(problem.GetWeightsWidth()),
+        f(problem.GetPadH()),
+        f(problem.GetPadW()),
+        f(problem.GetKernelStrideH()),
+        f(problem.GetKernelStrideW()),
+        f(problem.GetDilationH()),
+        f(problem.GetDilationW()),
+        f(problem.GetGroupCount()),
+    }};
+    // clang-format on
+}
+
+std::unique_ptr<DecisionTreeModel> DecisionTreeModel::Load(std::istream& stream)
+{
+    auto model  = std::make_unique<DecisionTreeModel>();
+    auto header = false;
+    auto line   = std::string{};
+    while(std::getline(stream, line))
+    {
+        std::istringstream fields{line.substr(0, line.find('#'))};
+        auto kind = std::string{};
+        if(!(fields >> kind))
+            continue;
+
+        if(!header)
+        {
+            auto version  = 0;
+            auto features = std::size_t{0};
+            if(kind != model_magic || !(fields >> version >> features) ||
+               version != model_version || features != FallbackFeatures{}.size())
+                MIOPEN_THROW("Unsupported version or features of the fallback model");
+            header = true;
+            continue;
+        }
+
+        auto node = Node{};
+        if(kind == "node")
+        {
+            if(!(fields >> node.feature >> node.threshold >> node.left >> node.right))
+                MIOPEN_THROW("Malformed node of the fallback model: " + line);
+        }
+        else if(kind == "leaf")
+        {
+            node.leaf = true;
+            auto name = std::string{};
+            while(fields >> name)
+            {
+                const auto solver = solver::Id{name};
+                if(solver.IsValid())
+                    node.solvers.push_back(solver);
+                else
+                    MIOPEN_LOG_I2("Unknown solver in the fallback model: " << name);
+            }
+        }
+        else
+        {
+            MIOPEN_THROW("Malformed entry of the fallback model: " + line);
+        }
+        model->nodes.push_back(std::move(node));
+    }
+
+    if(model->nodes.empty())
+        MIOPEN_THROW("Empty fallback model");
+
+    // Children following their parents make the walk from the root terminate.
+    for(auto i = std::size_t{0}; i < model->nodes.size(); ++i)
+    {
+        const auto& node = model->nodes[i];
+        if(node.leaf)
+            continue;
+        if(node.feature >= FallbackFeatures{}.size() || node.left <= i || node.right <= i ||
+           node.left >= model->nodes.size() || node.right >= model->nodes.size())
+            MIOPEN_THROW("Invalid node " + std::to_string(i) + " of the fallback model");
+    }
+    return model;
+}
+
+std::vector<solver::Id> DecisionTreeModel::Predict(const FallbackFeatures& features) const
+{
+    auto i = std::size_t{0};
+    while(!nodes[i].leaf)
+        i = features[nodes[i].feature] <= nodes[i].threshold ? nodes[i].left : nodes[i].right;
+    return nodes[i].solvers;
+}
+
+std::vector<solver::Id> CallbackFallbackModel::Predict(const FallbackFeatures& features) const
+{
+    auto ids = std::vector<uint64_t>(
+        solver::GetSolversByPrimitive(solver::Primitive::Convolution).size());
+    const auto count =
+        std::min(callback(features.data(), features.size(), ids.data(), ids.size(), user_data),
+                 ids.size());
+
+    auto solvers = std::vector<solver::Id>{};
+    for(auto i = std::size_t{0}; i < count; ++i)
+    {
+        const auto solver = solver::Id{ids[i]};
+        if(solver.IsValid())
+            solvers.push_back(solver);
+        else
+            MIOPEN_LOG_I2("Unknown solver predicted by the user fallback model: " << ids[i]);
+    }
+    return solvers;
+}
+
+std::shared_ptr<const FallbackModel> GetFallbackModel(const Handle& handle)
+{
+    if(const auto& model = handle.GetUserFallbackModel())
+        return model;
+
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const FallbackModel>> models;
+
+    const auto device = handle.GetDeviceName();
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto it = models.find(device);
+    if(it != models.end())
+        return it->second;
+
+    namespace fs = boost::filesystem;
+    auto model   = std::shared_ptr<const FallbackModel>{};
+    if(!GetUserDbPath().empty())
+        model = LoadFallbackModel(fs::path{GetUserDbPath()} / (device + ".ufbm.txt"));
+    if(!model)
+        model = LoadFallbackModel(fs::path{GetSystemDbPath()} / (device + ".fbm.txt"));
+    return models.emplace(device, std::move(model)).first->second;
+}
+
+} // namespace conv
+} // namespace miopen
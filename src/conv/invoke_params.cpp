@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/handle.hpp>
+
+#include <vector>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+Data_t Allocate(const Handle& handle,
+                const void* original,
+                std::size_t size,
+                std::vector<Allocator::ManageDataPtr>& buffers)
+{
+    if(original == nullptr || size == 0)
+        return nullptr;
+    // Zeros rather than garbage, which may hit the slow paths of the denormals or NaNs.
+    const MemoryCategoryScope memory_scope{MemoryCategory::Search};
+    auto buffer = handle.Create(size);
+    handle.ZeroAsync(buffer.get(), size);
+    buffers.push_back(std::move(buffer));
+    return buffers.back().get();
+}
+
+Data_t Allocate(const Handle& handle,
+                const void* original,
+                const TensorDescriptor& desc,
+                std::vector<Allocator::ManageDataPtr>& buffers)
+{
+    return Allocate(
+        handle, original, desc.GetElementSpace() * GetTypeSize(desc.GetType()), buffers);
+}
+
+} // namespace
+
+DataInvokeParams DataInvokeParams::Relocate(const Handle& handle,
+                                            std::vector<Allocator::ManageDataPtr>& buffers) const
+{
+    auto result        = *this;
+    result.tensors.in  = Allocate(handle, tensors.in, tensors.inDesc, buffers);
+    result.tensors.w   = Allocate(handle, tensors.w, tensors.wDesc, buffers);
+    result.tensors.out = Allocate(handle, tensors.out, tensors.outDesc, buffers);
+    result.workSpace   = Allocate(handle, workSpace, workSpaceSize, buffers);
+    return result;
+}
+
+WrWInvokeParams WrWInvokeParams::Relocate(const Handle& handle,
+                                          std::vector<Allocator::ManageDataPtr>& buffers) const
+{
+    auto result       = *this;
+    result.tensors.dy = Allocate(handle, tensors.dy, tensors.dyDesc, buffers);
+    result.tensors.x  = Allocate(handle, tensors.x, tensors.xDesc, buffers);
+    result.tensors.dw = Allocate(handle, tensors.dw, tensors.dwDesc, buffers);
+    result.workSpace  = Allocate(handle, workSpace, workSpaceSize, buffers);
+    return result;
+}
+
+} // namespace conv
+} // namespace miopen
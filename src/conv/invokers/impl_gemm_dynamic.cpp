@@ -474,9 +474,9 @@ InvokerFactory MakeImplGemmDynamicForwardXdlopsNHWCInvokerFactory(
     bool need_set_zero = config.gemm_k_global_split > 0;
 
     std::vector<OpKernelArg> opArgs;
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
     opArgs.emplace_back(hi);
     opArgs.emplace_back(wi);
     opArgs.emplace_back(n);
@@ -504,16 +504,17 @@ InvokerFactory MakeImplGemmDynamicForwardXdlopsNHWCInvokerFactory(
     opArgs.emplace_back(config.gemm_k_global_split);
     opArgs.emplace_back(pack0);
 
-    return [opArgs, need_set_zero](const std::vector<Kernel>& kernels) mutable {
+    return [opArgs, need_set_zero](const std::vector<Kernel>& kernels) {
+        auto args = PackedKernelArgs{opArgs};
         return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) mutable {
             decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
             const auto& tensors     = data_ctx.tensors;
             const auto ker          = handle.Run(kernels[0]);
             float elapsed           = 0;
 
-            opArgs[0] = OpKernelArg(tensors.in);
-            opArgs[1] = OpKernelArg(tensors.w);
-            opArgs[2] = OpKernelArg(tensors.out);
+            args.Set(0, tensors.in);
+            args.Set(1, tensors.w);
+            args.Set(2, tensors.out);
 
             if(need_set_zero)
             {
@@ -523,7 +524,7 @@ InvokerFactory MakeImplGemmDynamicForwardXdlopsNHWCInvokerFactory(
                     elapsed += handle.GetKernelTime();
             }
 
-            ker(opArgs);
+            ker(args);
 
             if(handle.IsProfilingEnabled())
             {
@@ -608,9 +609,9 @@ InvokerFactory MakeImplGemmDynamicBackwardDataXdlopsNHWCInvokerFactory(
     need_set_zero |= config.gemm_k_global_split > 0;
 
     std::vector<OpKernelArg> opArgs;
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
     opArgs.emplace_back(hi);
     opArgs.emplace_back(wi);
     opArgs.emplace_back(n);
@@ -651,16 +652,17 @@ InvokerFactory MakeImplGemmDynamicBackwardDataXdlopsNHWCInvokerFactory(
     opArgs.emplace_back(shift_pack_0);
     opArgs.emplace_back(config.gemm_k_global_split);
 
-    return [opArgs, need_set_zero](const std::vector<Kernel>& kernels) mutable {
+    return [opArgs, need_set_zero](const std::vector<Kernel>& kernels) {
+        auto args = PackedKernelArgs{opArgs};
         return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) mutable {
             decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
             const auto& tensors     = data_ctx.tensors;
             const auto ker          = handle.Run(kernels[0]);
             float elapsed           = 0;
 
-            opArgs[0] = OpKernelArg(tensors.out);
-            opArgs[1] = OpKernelArg(tensors.w);
-            opArgs[2] = OpKernelArg(tensors.in);
+            args.Set(0, tensors.out);
+            args.Set(1, tensors.w);
+            args.Set(2, tensors.in);
 
             if(need_set_zero)
             {
@@ -670,7 +672,7 @@ InvokerFactory MakeImplGemmDynamicBackwardDataXdlopsNHWCInvokerFactory(
                     elapsed += handle.GetKernelTime();
             }
 
-            ker(opArgs);
+            ker(args);
 
             if(handle.IsProfilingEnabled())
             {
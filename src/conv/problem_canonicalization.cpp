@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/problem_canonicalization.hpp>
+
+#include <miopen/convolution.hpp>
+#include <miopen/tensor.hpp>
+
+#include <boost/optional.hpp>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+TensorDescriptor WithBatchSize(const TensorDescriptor& desc, std::size_t batch_size)
+{
+    // The batch is the outermost dimension for all the layouts, so the strides stay the same.
+    auto lengths = desc.GetLengths();
+    lengths[0]   = batch_size;
+    return {desc.GetType(), lengths, desc.GetStrides()};
+}
+
+ProblemDescription WithBatchSize(const ProblemDescription& problem, std::size_t batch_size)
+{
+    return {WithBatchSize(problem.GetIn(), batch_size),
+            problem.GetWeights(),
+            WithBatchSize(problem.GetOut(), batch_size),
+            problem.GetConv(),
+            problem.GetDirection(),
+            problem.GetBias()};
+}
+
+/// None if the dilations are canonical already.
+boost::optional<ProblemDescription> WithCanonicalDilations(const ProblemDescription& problem)
+{
+    auto conv = problem.GetConv();
+    // The lengths are in the KC(Z)YX order whatever the layout, which is set by the strides.
+    const auto& lengths = problem.GetWeights().GetLengths();
+    auto changed        = false;
+    for(auto i = std::size_t{0}; i < conv.GetSpatialDimension(); ++i)
+    {
+        if(lengths[i + 2] == 1 && conv.dilations[i] != 1)
+        {
+            conv.dilations[i] = 1;
+            changed           = true;
+        }
+    }
+    if(!changed)
+        return boost::none;
+    return ProblemDescription{problem.GetIn(),
+                              problem.GetWeights(),
+                              problem.GetOut(),
+                              conv,
+                              problem.GetDirection(),
+                              problem.GetBias()};
+}
+
+} // namespace
+
+std::vector<std::size_t> GetBatchSizeBuckets(std::size_t batch_size)
+{
+    if(batch_size == 0 || (batch_size & (batch_size - 1)) == 0)
+        return {};
+
+    auto lower = std::size_t{1};
+    while(lower * 2 < batch_size)
+        lower *= 2;
+    const auto upper = lower * 2;
+
+    // Ties go to the larger batch, whose kernels cover the smaller one.
+    if(upper - batch_size <= batch_size - lower)
+        return {upper, lower};
+    return {lower, upper};
+}
+
+std::vector<ProblemDescription> GetCanonicalNeighbors(const ProblemDescription& problem)
+{
+    auto neighbors       = std::vector<ProblemDescription>{};
+    const auto dilations = WithCanonicalDilations(problem);
+    if(dilations)
+        neighbors.push_back(*dilations);
+
+    const auto& canonical = dilations ? *dilations : problem;
+    for(const auto batch_size : GetBatchSizeBuckets(problem.GetInBatchSize()))
+        neighbors.push_back(WithBatchSize(canonical, batch_size));
+    return neighbors;
+}
+
+} // namespace conv
+} // namespace miopen
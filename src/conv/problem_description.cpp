@@ -28,8 +28,11 @@
 
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/stringutils.hpp>
 #include <miopen/tensor_layout.hpp>
 
+#include <algorithm>
+#include <cctype>
 #include <sstream>
 
 namespace miopen {
@@ -112,6 +115,9 @@ void ProblemDescription::BuildConfKey(std::string& conf_key) const
               'x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
     ss << 'x' << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
     ss << 'x' << GetGroupCount();
+    // The solvers may keep constant weights transformed, which changes their workspace.
+    if(GetConv().constant_weights)
+        ss << 'x' << "CW";
 
     switch(GetDirection())
     {
@@ -174,6 +180,174 @@ void ProblemDescription::Serialize(std::ostream& stream) const
     }
 }
 
+namespace {
+
+bool ParseDbKeyValue(const std::string& str, int& value)
+{
+    if(str.empty() || str.size() > 9 ||
+       !std::all_of(str.begin(), str.end(), [](char c) { return std::isdigit(c) != 0; }))
+        return false;
+    value = std::stoi(str);
+    return true;
+}
+
+/// Parses "[d<sep>]h<sep>w" of the given number of spatial dimensions.
+bool ParseDbKeyDHW(const std::string& str,
+                   char sep,
+                   std::size_t spatial_dims,
+                   std::vector<int>& dhw)
+{
+    const auto parts = SplitDelim(str, sep);
+    if(parts.size() != spatial_dims)
+        return false;
+    dhw.resize(spatial_dims);
+    for(auto i = std::size_t{0}; i < spatial_dims; ++i)
+        if(!ParseDbKeyValue(parts[i], dhw[i]))
+            return false;
+    return true;
+}
+
+bool DecodeDataTypesForKey(const std::string& str,
+                           miopenDataType_t& in,
+                           miopenDataType_t& weights,
+                           miopenDataType_t& out)
+{
+    static const auto types = {miopenHalf,
+                               miopenFloat,
+                               miopenInt32,
+                               miopenInt8,
+                               miopenInt8x4,
+                               miopenBFloat16,
+                               miopenDouble};
+
+    for(const auto a : types)
+    {
+        for(const auto b : types)
+        {
+            for(const auto c : types)
+            {
+                if(EncodeDataTypesForKey(a, b, c) != str)
+                    continue;
+                in      = a;
+                weights = b;
+                out     = c;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/// Packed tensor of NC[D]HW lengths stored in the given layout.
+bool MakeDbKeyTensor(miopenDataType_t type,
+                     const std::string& layout,
+                     const std::vector<std::size_t>& lens,
+                     TensorDescriptor& tensor)
+{
+    const auto default_layout = tensor_layout_get_default(lens.size());
+    if(layout.size() != default_layout.size() ||
+       !std::is_permutation(layout.begin(), layout.end(), default_layout.begin()))
+        return false;
+
+    auto strides = std::vector<std::size_t>{};
+    tensor_layout_to_strides(lens, default_layout, layout, strides);
+    tensor = {type, lens, strides};
+    return true;
+}
+
+} // namespace
+
+bool ProblemDescription::Deserialize(const std::string& key)
+{
+    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F[_g2], see Serialize().
+    auto group_count  = 1;
+    const auto suffix = key.find('_');
+    if(suffix != std::string::npos &&
+       (key.size() < suffix + 3 || key[suffix + 1] != 'g' ||
+        !ParseDbKeyValue(key.substr(suffix + 2), group_count) || group_count < 1))
+        return false;
+
+    const auto tokens = SplitDelim(key.substr(0, suffix), '-');
+    if(tokens.size() < 4)
+        return false;
+
+    const std::size_t spatial_dims = tokens[3].find('x') != std::string::npos ? 2 : 3;
+    const auto layouts             = tokens.size() - (2 * spatial_dims + 10);
+    if(tokens.size() < 2 * spatial_dims + 11 || (layouts != 1 && layouts != 3))
+        return false;
+
+    auto token = tokens.begin();
+    int in_c, out_c, batch, bias;
+    std::vector<int> in_dhw(spatial_dims), wei_dhw, out_dhw(spatial_dims), pads, strides,
+        dilations;
+
+    auto ok = ParseDbKeyValue(*token++, in_c);
+    for(auto& v : in_dhw)
+        ok = ok && ParseDbKeyValue(*token++, v);
+    ok = ok && ParseDbKeyDHW(*token++, 'x', spatial_dims, wei_dhw);
+    ok = ok && ParseDbKeyValue(*token++, out_c);
+    for(auto& v : out_dhw)
+        ok = ok && ParseDbKeyValue(*token++, v);
+    ok = ok && ParseDbKeyValue(*token++, batch);
+    ok = ok && ParseDbKeyDHW(*token++, 'x', spatial_dims, pads);
+    ok = ok && ParseDbKeyDHW(*token++, 'x', spatial_dims, strides);
+    ok = ok && ParseDbKeyDHW(*token++, 'x', spatial_dims, dilations);
+    ok = ok && ParseDbKeyValue(*token++, bias);
+    if(!ok)
+        return false;
+
+    const auto in_layout_      = *token;
+    const auto weights_layout_ = layouts == 3 ? *(token + 1) : *token;
+    const auto out_layout_     = layouts == 3 ? *(token + 2) : *token;
+    token += layouts;
+
+    miopenDataType_t in_type, weights_type, out_type;
+    if(!DecodeDataTypesForKey(*token++, in_type, weights_type, out_type))
+        return false;
+
+    Direction direction_;
+    if(*token == "F")
+        direction_ = Direction::Forward;
+    else if(*token == "B")
+        direction_ = Direction::BackwardData;
+    else if(*token == "W")
+        direction_ = Direction::BackwardWeights;
+    else
+        return false;
+
+    // The input of the backward directions is dy, so the weights have its channels first.
+    const auto wei_k = direction_ == Direction::Forward ? out_c : in_c;
+    const auto wei_c = direction_ == Direction::Forward ? in_c : out_c;
+    if(wei_c % group_count != 0 || wei_k % group_count != 0)
+        return false;
+
+    const auto lengths = [&](int n, int c, const std::vector<int>& dhw) {
+        auto lens = std::vector<std::size_t>{static_cast<std::size_t>(n),
+                                             static_cast<std::size_t>(c)};
+        lens.insert(lens.end(), dhw.begin(), dhw.end());
+        return lens;
+    };
+
+    TensorDescriptor in_, weights_, out_;
+    if(!MakeDbKeyTensor(in_type, in_layout_, lengths(batch, in_c, in_dhw), in_) ||
+       !MakeDbKeyTensor(
+           weights_type, weights_layout_, lengths(wei_k, wei_c / group_count, wei_dhw), weights_) ||
+       !MakeDbKeyTensor(out_type, out_layout_, lengths(batch, out_c, out_dhw), out_))
+        return false;
+
+    const auto conv_ = ConvolutionDescriptor{spatial_dims,
+                                             miopenConvolution,
+                                             miopenPaddingDefault,
+                                             pads,
+                                             strides,
+                                             dilations,
+                                             std::vector<int>(spatial_dims, 0),
+                                             group_count};
+
+    *this = ProblemDescription{in_, weights_, out_, conv_, direction_, bias};
+    return true;
+}
+
 bool ProblemDescription::IsLayoutDefault() const
 {
     if(GetSpatialDims() == 2)
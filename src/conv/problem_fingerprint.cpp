@@ -0,0 +1,225 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_fingerprint.hpp>
+
+#include <miopen/conv/context.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/tensor.hpp>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace miopen {
+namespace conv {
+
+namespace {
+
+template <class TSrc, class TDst>
+void CopyDims(const TSrc& src, TDst& dst)
+{
+    if(src.size() > dst.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Too many dimensions for a convolution problem");
+    std::copy(src.begin(), src.end(), dst.begin());
+}
+
+} // namespace
+
+ProblemFingerprint::ProblemFingerprint(const TensorDescriptor& in,
+                                       const TensorDescriptor& weights,
+                                       const TensorDescriptor& out,
+                                       const ConvolutionDescriptor& conv,
+                                       Direction direction_,
+                                       int bias_)
+    : group_count(conv.GetGroupCount()),
+      bias(bias_),
+      spatial_dims(static_cast<uint32_t>(conv.GetSpatialDimension())),
+      mode(conv.mode),
+      padding_mode(conv.paddingMode),
+      direction(direction_)
+{
+    const TensorDescriptor* const descs[] = {&in, &weights, &out};
+    for(auto i = 0; i < 3; ++i)
+    {
+        auto& tensor     = tensors[i];
+        tensor.dims      = static_cast<uint32_t>(descs[i]->GetLengths().size());
+        tensor.data_type = descs[i]->GetType();
+        CopyDims(descs[i]->GetLengths(), tensor.lengths);
+        CopyDims(descs[i]->GetStrides(), tensor.strides);
+    }
+
+    CopyDims(conv.GetConvPads(), pads);
+    CopyDims(conv.GetConvStrides(), strides);
+    CopyDims(conv.GetConvDilations(), dilations);
+    CopyDims(conv.GetTransposeConvPads(), trans_output_pads);
+
+    hash = ComputeHash();
+}
+
+bool ProblemFingerprint::operator==(const ProblemFingerprint& other) const
+{
+    const auto tensors_equal = [](const Tensor& l, const Tensor& r) {
+        return l.dims == r.dims && l.data_type == r.data_type && l.lengths == r.lengths &&
+               l.strides == r.strides;
+    };
+
+    // clang-format off
+    return hash == other.hash
+        && std::equal(tensors.begin(), tensors.end(), other.tensors.begin(), tensors_equal)
+        && pads == other.pads
+        && strides == other.strides
+        && dilations == other.dilations
+        && trans_output_pads == other.trans_output_pads
+        && group_count == other.group_count
+        && bias == other.bias
+        && spatial_dims == other.spatial_dims
+        && mode == other.mode
+        && padding_mode == other.padding_mode
+        && direction == other.direction;
+    // clang-format on
+}
+
+std::size_t ProblemFingerprint::ComputeHash() const
+{
+    std::size_t seed = 0;
+    for(const auto& tensor : tensors)
+    {
+        boost::hash_combine(seed, tensor.dims);
+        boost::hash_combine(seed, static_cast<int>(tensor.data_type));
+        boost::hash_range(seed, tensor.lengths.begin(), tensor.lengths.end());
+        boost::hash_range(seed, tensor.strides.begin(), tensor.strides.end());
+    }
+    boost::hash_range(seed, pads.begin(), pads.end());
+    boost::hash_range(seed, strides.begin(), strides.end());
+    boost::hash_range(seed, dilations.begin(), dilations.end());
+    boost::hash_range(seed, trans_output_pads.begin(), trans_output_pads.end());
+    boost::hash_combine(seed, group_count);
+    boost::hash_combine(seed, bias);
+    boost::hash_combine(seed, spatial_dims);
+    boost::hash_combine(seed, static_cast<int>(mode));
+    boost::hash_combine(seed, static_cast<int>(padding_mode));
+    boost::hash_combine(seed, static_cast<int>(direction));
+    return seed;
+}
+
+boost::optional<const ProblemKeys&>
+ProblemKeysCache::Find(const ProblemFingerprint& fingerprint) const
+{
+    const std::shared_lock<std::shared_timed_mutex> lock(*mutex);
+    const auto it = items.find(fingerprint);
+    if(it == items.end())
+        return boost::none;
+    return it->second;
+}
+
+const ProblemKeys& ProblemKeysCache::Register(const ProblemFingerprint& fingerprint,
+                                              ProblemKeys keys)
+{
+    const std::unique_lock<std::shared_timed_mutex> lock(*mutex);
+    // Elements of unordered_map are not relocated on insertion, so returned
+    // references remain valid while other threads register new problems.
+    return items.emplace(fingerprint, std::move(keys)).first->second;
+}
+
+boost::optional<bool> ApplicabilityCache::Find(const ProblemFingerprint& fingerprint,
+                                               uint64_t solver) const
+{
+    const std::shared_lock<std::shared_timed_mutex> lock(*mutex);
+    const auto item = items.find(fingerprint);
+    if(item == items.end())
+        return boost::none;
+    const auto it = item->second.solvers.find(solver);
+    if(it == item->second.solvers.end())
+        return boost::none;
+    return it->second;
+}
+
+void ApplicabilityCache::Register(const ProblemFingerprint& fingerprint,
+                                  uint64_t solver,
+                                  bool applicable)
+{
+    const std::unique_lock<std::shared_timed_mutex> lock(*mutex);
+    items[fingerprint].solvers[solver] = applicable;
+}
+
+boost::optional<const std::vector<uint64_t>&>
+ApplicabilityCache::FindAll(const ProblemFingerprint& fingerprint) const
+{
+    const std::shared_lock<std::shared_timed_mutex> lock(*mutex);
+    const auto item = items.find(fingerprint);
+    if(item == items.end() || !item->second.applicable)
+        return boost::none;
+    return *item->second.applicable;
+}
+
+const std::vector<uint64_t>&
+ApplicabilityCache::RegisterAll(const ProblemFingerprint& fingerprint,
+                                const std::vector<std::pair<uint64_t, bool>>& checked)
+{
+    const std::unique_lock<std::shared_timed_mutex> lock(*mutex);
+    auto& item = items[fingerprint];
+    // Another thread may have checked the same problem meanwhile, and the list it has returned
+    // may still be in use.
+    if(item.applicable)
+        return *item.applicable;
+
+    auto applicable = std::vector<uint64_t>{};
+    for(const auto& solver : checked)
+    {
+        item.solvers[solver.first] = solver.second;
+        if(solver.second)
+            applicable.push_back(solver.first);
+    }
+    item.applicable = std::move(applicable);
+    return *item.applicable;
+}
+
+std::shared_ptr<const ConvolutionContext>
+ContextCache::Find(const ProblemFingerprint& fingerprint, bool disable_search_enforce) const
+{
+    const std::shared_lock<std::shared_timed_mutex> lock(*mutex);
+    const auto item = items.find(fingerprint);
+    if(item == items.end())
+        return nullptr;
+    return item->second[disable_search_enforce ? 1 : 0];
+}
+
+std::shared_ptr<const ConvolutionContext>
+ContextCache::Register(const ProblemFingerprint& fingerprint,
+                       std::shared_ptr<const ConvolutionContext> context)
+{
+    const std::unique_lock<std::shared_timed_mutex> lock(*mutex);
+    auto& slot = items[fingerprint][context->disable_search_enforce ? 1 : 0];
+    if(slot == nullptr)
+        slot = std::move(context);
+    return slot;
+}
+
+} // namespace conv
+} // namespace miopen
@@ -26,6 +26,7 @@
 #include <miopen/convolution.hpp>
 
 #include <miopen/config.h>
+#include <miopen/conv/batch_split.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/find_controls.hpp>
@@ -332,6 +333,9 @@ std::size_t ConvolutionDescriptor::ForwardGetWorkSpaceSize(Handle& handle,
 {
     MIOPEN_LOG_I("");
 
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+        return ForwardGetWorkSpaceSize(handle, wDesc, split.GetInChunk(), split.GetOutChunk());
+
     auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
     ctx.SetStream(&handle);
     ctx.DetectRocm();
@@ -370,7 +374,8 @@ std::size_t ConvolutionDescriptor::ForwardGetWorkSpaceSize(Handle& handle,
     if(IsWinograd3x3SupportedAndFast(ctx))
     {
         AutoUseFastDynamicSolutions tmp{ctx};
-        const auto ws = ForwardBackwardDataGetWorkSpaceSizeWinograd(ctx);
+        const auto ws =
+            std::min(ForwardBackwardDataGetWorkSpaceSizeWinograd(ctx), workspace_limit);
         MIOPEN_LOG_I2(ws);
         return ws;
     }
@@ -394,10 +399,11 @@ std::size_t ConvolutionDescriptor::ForwardGetWorkSpaceSize(Handle& handle,
 
         if(miopen::any_of(GetConvDilations(), [](auto v) { return v > 1; }))
         {
-            return std::max({workspace_size_gemm,
-                             direct_workspace,
-                             implicit_gemm_workspace,
-                             workspace_size_winograd});
+            return std::min(std::max({workspace_size_gemm,
+                                      direct_workspace,
+                                      implicit_gemm_workspace,
+                                      workspace_size_winograd}),
+                            workspace_limit);
         }
     }
 #endif
@@ -410,8 +416,10 @@ std::size_t ConvolutionDescriptor::ForwardGetWorkSpaceSize(Handle& handle,
                                             implicit_gemm_workspace,
                                             workspace_size_winograd});
 
-    MIOPEN_LOG_I2(workspace_size);
-    return workspace_size;
+    // Solutions which need more than the limit are never used.
+    const auto limited_size = std::min(workspace_size, workspace_limit);
+    MIOPEN_LOG_I2(limited_size);
+    return limited_size;
 }
 
 std::size_t
@@ -422,6 +430,10 @@ ConvolutionDescriptor::BackwardDataGetWorkSpaceSize(Handle& handle,
 {
     MIOPEN_LOG_I("");
 
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+        return BackwardDataGetWorkSpaceSize(
+            handle, wDesc, split.GetInChunk(), split.GetOutChunk());
+
     auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
     ctx.SetStream(&handle);
     ctx.DetectRocm();
@@ -450,7 +462,8 @@ ConvolutionDescriptor::BackwardDataGetWorkSpaceSize(Handle& handle,
     if(IsWinograd3x3SupportedAndFast(ctx))
     {
         AutoUseFastDynamicSolutions tmp{ctx};
-        const auto ws = ForwardBackwardDataGetWorkSpaceSizeWinograd(ctx);
+        const auto ws =
+            std::min(ForwardBackwardDataGetWorkSpaceSizeWinograd(ctx), workspace_limit);
         MIOPEN_LOG_I2(ws);
         return ws;
     }
@@ -478,7 +491,7 @@ ConvolutionDescriptor::BackwardDataGetWorkSpaceSize(Handle& handle,
 
         if(miopen::any_of(GetConvDilations(), [](auto v) { return v > 1; }))
         {
-            return std::max({workspace_size_gemm, tmp_max_workspace});
+            return std::min(std::max({workspace_size_gemm, tmp_max_workspace}), workspace_limit);
         }
     }
 #endif
@@ -490,8 +503,10 @@ ConvolutionDescriptor::BackwardDataGetWorkSpaceSize(Handle& handle,
                                             direct_workspace,
                                             implicit_gemm_workspace,
                                             workspace_size_winograd});
-    MIOPEN_LOG_I2(workspace_size);
-    return workspace_size;
+    // Solutions which need more than the limit are never used.
+    const auto limited_size = std::min(workspace_size, workspace_limit);
+    MIOPEN_LOG_I2(limited_size);
+    return limited_size;
 }
 
 std::size_t ConvolutionDescriptor::BackwardWeightsGetWorkSpaceSizeGEMM(
@@ -749,8 +764,10 @@ ConvolutionDescriptor::BackwardWeightsGetWorkSpaceSize(Handle& handle,
                                             BackwardWeightsGetWorkSpaceSizeWinograd(ctx),
                                             BackwardWeightsGetWorkSpaceSizeDirect(ctx),
                                             BackwardWeightsGetWorkSpaceSizeGEMM(ctx)});
-    MIOPEN_LOG_I2(workspace_size);
-    return workspace_size;
+    // Solutions which need more than the limit are never used.
+    const auto limited_size = std::min(workspace_size, workspace_limit);
+    MIOPEN_LOG_I2(limited_size);
+    return limited_size;
 }
 
 std::ostream& operator<<(std::ostream& stream, const ConvolutionDescriptor& c)
@@ -26,6 +26,8 @@
 #include <miopen/miopen.h>
 #include <miopen/miopen_internal.h>
 
+#include <miopen/async_compiler.hpp>
+#include <miopen/conv/fallback_model.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/find_controls.hpp>
@@ -34,8 +36,12 @@
 #include <miopen/tensor_ops.hpp>
 #include <algorithm>
 
-// TODO: Make miopenConvAlgoPerf_t loggable
+// TODO: Make miopenConvAlgoPerf_t and miopenConvolutionForwardImmediateCall_t loggable
 inline std::ostream& operator<<(std::ostream& os, miopenConvAlgoPerf_t) { return os; }
+inline std::ostream& operator<<(std::ostream& os, const miopenConvolutionForwardImmediateCall_t&)
+{
+    return os;
+}
 
 extern "C" miopenStatus_t miopenCreateConvolutionDescriptor(miopenConvolutionDescriptor_t* convDesc)
 {
@@ -94,6 +100,36 @@ extern "C" miopenStatus_t miopenSetConvolutionGroupCount(miopenConvolutionDescri
     return miopen::try_([&] { miopen::deref(convDesc).group_count = groupCount; });
 }
 
+extern "C" miopenStatus_t miopenSetConvolutionWorkspaceLimit(miopenConvolutionDescriptor_t convDesc,
+                                                             size_t workspaceLimit)
+{
+    MIOPEN_LOG_FUNCTION(convDesc, workspaceLimit);
+    return miopen::try_([&] { miopen::deref(convDesc).workspace_limit = workspaceLimit; });
+}
+
+extern "C" miopenStatus_t miopenGetConvolutionWorkspaceLimit(miopenConvolutionDescriptor_t convDesc,
+                                                             size_t* workspaceLimit)
+{
+    MIOPEN_LOG_FUNCTION(convDesc, workspaceLimit);
+    return miopen::try_(
+        [&] { miopen::deref(workspaceLimit) = miopen::deref(convDesc).workspace_limit; });
+}
+
+extern "C" miopenStatus_t
+miopenSetConvolutionConstantWeights(miopenConvolutionDescriptor_t convDesc, int constant)
+{
+    MIOPEN_LOG_FUNCTION(convDesc, constant);
+    return miopen::try_([&] { miopen::deref(convDesc).constant_weights = constant != 0; });
+}
+
+extern "C" miopenStatus_t
+miopenGetConvolutionConstantWeights(miopenConvolutionDescriptor_t convDesc, int* constant)
+{
+    MIOPEN_LOG_FUNCTION(convDesc, constant);
+    return miopen::try_(
+        [&] { miopen::deref(constant) = miopen::deref(convDesc).constant_weights ? 1 : 0; });
+}
+
 extern "C" miopenStatus_t miopenSetConvolutionFindMode(miopenConvolutionDescriptor_t convDesc,
                                                        miopenConvolutionFindMode_t findMode)
 {
@@ -625,6 +661,52 @@ miopenConvolutionForwardGetSolution(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionForwardGetPredictedSolution(miopenHandle_t handle,
+                                             const miopenTensorDescriptor_t wDesc,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const miopenConvolutionDescriptor_t convDesc,
+                                             const miopenTensorDescriptor_t yDesc,
+                                             const size_t maxSolutionCount,
+                                             size_t* solutionCount,
+                                             miopenConvSolution_t* solutions)
+{
+    MIOPEN_LOG_FUNCTION(handle, wDesc, xDesc, convDesc, yDesc, maxSolutionCount);
+    return miopen::try_([&] {
+        if(miopen::deref(convDesc).mode == miopenTranspose)
+            miopen::deref(convDesc).GetBackwardSolutionsPredicted(miopen::deref(handle),
+                                                                  miopen::deref(xDesc),
+                                                                  miopen::deref(wDesc),
+                                                                  miopen::deref(yDesc),
+                                                                  maxSolutionCount,
+                                                                  solutionCount,
+                                                                  solutions);
+        else
+            miopen::deref(convDesc).GetForwardSolutionsPredicted(miopen::deref(handle),
+                                                                 miopen::deref(wDesc),
+                                                                 miopen::deref(xDesc),
+                                                                 miopen::deref(yDesc),
+                                                                 maxSolutionCount,
+                                                                 solutionCount,
+                                                                 solutions);
+    });
+}
+
+extern "C" miopenStatus_t miopenSetConvolutionFallbackModel(miopenHandle_t handle,
+                                                            miopenConvFallbackModel_t model,
+                                                            void* userData)
+{
+    MIOPEN_LOG_FUNCTION(handle, userData);
+    return miopen::try_([&] {
+        auto& miopen_handle = miopen::deref(handle);
+        if(model == nullptr)
+            miopen_handle.SetUserFallbackModel(nullptr);
+        else
+            miopen_handle.SetUserFallbackModel(
+                std::make_shared<miopen::conv::CallbackFallbackModel>(model, userData));
+    });
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionForwardGetSolutionWorkspaceSize(miopenHandle_t handle,
                                                  const miopenTensorDescriptor_t wDesc,
@@ -721,6 +803,36 @@ miopenConvolutionForwardImmediate(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionForwardImmediateBatch(miopenHandle_t handle,
+                                       const miopenConvolutionForwardImmediateCall_t* calls,
+                                       size_t count)
+{
+    MIOPEN_LOG_FUNCTION(handle, calls, count);
+
+    return miopen::try_([&] {
+        if(count > 0 && calls == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "calls is null");
+
+        auto batch = std::vector<miopen::ConvFwdImmediateCall>{};
+        batch.reserve(count);
+        std::for_each(calls, calls + count, [&](const miopenConvolutionForwardImmediateCall_t& c) {
+            LogCmdConvolution(c.xDesc, c.wDesc, c.convDesc, c.yDesc, ConvDirection::Fwd, true);
+            batch.push_back({&miopen::deref(c.convDesc),
+                             &miopen::deref(c.wDesc),
+                             DataCast(c.w),
+                             &miopen::deref(c.xDesc),
+                             DataCast(c.x),
+                             &miopen::deref(c.yDesc),
+                             DataCast(c.y),
+                             DataCast(c.workSpace),
+                             c.workSpaceSize,
+                             c.solution_id});
+        });
+        miopen::ConvolutionForwardImmediateBatch(miopen::deref(handle), batch);
+    });
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionBackwardDataGetSolutionCount(miopenHandle_t handle,
                                               const miopenTensorDescriptor_t dyDesc,
@@ -779,6 +891,37 @@ miopenConvolutionBackwardDataGetSolution(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionBackwardDataGetPredictedSolution(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const miopenTensorDescriptor_t wDesc,
+                                                  const miopenConvolutionDescriptor_t convDesc,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  const size_t maxSolutionCount,
+                                                  size_t* solutionCount,
+                                                  miopenConvSolution_t* solutions)
+{
+    MIOPEN_LOG_FUNCTION(handle, dyDesc, wDesc, convDesc, dxDesc, maxSolutionCount);
+    return miopen::try_([&] {
+        if(miopen::deref(convDesc).mode == miopenTranspose)
+            miopen::deref(convDesc).GetForwardSolutionsPredicted(miopen::deref(handle),
+                                                                 miopen::deref(wDesc),
+                                                                 miopen::deref(dyDesc),
+                                                                 miopen::deref(dxDesc),
+                                                                 maxSolutionCount,
+                                                                 solutionCount,
+                                                                 solutions);
+        else
+            miopen::deref(convDesc).GetBackwardSolutionsPredicted(miopen::deref(handle),
+                                                                  miopen::deref(dyDesc),
+                                                                  miopen::deref(wDesc),
+                                                                  miopen::deref(dxDesc),
+                                                                  maxSolutionCount,
+                                                                  solutionCount,
+                                                                  solutions);
+    });
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionBackwardDataGetSolutionWorkspaceSize(miopenHandle_t handle,
                                                       const miopenTensorDescriptor_t dyDesc,
@@ -929,6 +1072,29 @@ miopenConvolutionBackwardWeightsGetSolution(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionBackwardWeightsGetPredictedSolution(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     const miopenTensorDescriptor_t dwDesc,
+                                                     const size_t maxSolutionCount,
+                                                     size_t* solutionCount,
+                                                     miopenConvSolution_t* solutions)
+{
+    MIOPEN_LOG_FUNCTION(handle, dyDesc, xDesc, convDesc, dwDesc, maxSolutionCount);
+    return miopen::try_([&] {
+        const auto transpose = miopen::deref(convDesc).mode == miopenTranspose;
+        miopen::deref(convDesc).GetWrwSolutionsPredicted(miopen::deref(handle),
+                                                         miopen::deref(transpose ? xDesc : dyDesc),
+                                                         miopen::deref(transpose ? dyDesc : xDesc),
+                                                         miopen::deref(dwDesc),
+                                                         maxSolutionCount,
+                                                         solutionCount,
+                                                         solutions);
+    });
+}
+
 extern "C" miopenStatus_t miopenConvolutionBackwardWeightsGetSolutionWorkspaceSize(
     miopenHandle_t handle,
     const miopenTensorDescriptor_t dyDesc,
@@ -982,6 +1148,126 @@ miopenConvolutionBackwardWeightsCompileSolution(miopenHandle_t handle,
     });
 }
 
+static std::uint64_t TrackCompile(miopen::Handle& handle,
+                                  std::vector<std::shared_future<miopen::Program>> builds,
+                                  miopenCompileCallback_t callback,
+                                  void* user_data)
+{
+    auto on_done = miopen::AsyncCompiler::Callback{};
+    if(callback != nullptr)
+        on_done = [=](miopenStatus_t status) { callback(status, user_data); };
+    return handle.GetAsyncCompiler().Track(std::move(builds), std::move(on_done));
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionForwardCompileSolutionAsync(miopenHandle_t handle,
+                                             const miopenTensorDescriptor_t wDesc,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const miopenConvolutionDescriptor_t convDesc,
+                                             const miopenTensorDescriptor_t yDesc,
+                                             const uint64_t solution_id,
+                                             miopenCompileCallback_t callback,
+                                             void* user_data,
+                                             uint64_t* ticket)
+{
+    MIOPEN_LOG_FUNCTION(handle, wDesc, xDesc, convDesc, yDesc, solution_id, user_data);
+    return miopen::try_([&] {
+        auto builds = miopen::deref(convDesc).mode == miopenTranspose
+                          ? miopen::deref(convDesc).CompileBackwardSolution(miopen::deref(handle),
+                                                                            miopen::deref(xDesc),
+                                                                            miopen::deref(wDesc),
+                                                                            miopen::deref(yDesc),
+                                                                            solution_id,
+                                                                            true)
+                          : miopen::deref(convDesc).CompileForwardSolution(miopen::deref(handle),
+                                                                           miopen::deref(wDesc),
+                                                                           miopen::deref(xDesc),
+                                                                           miopen::deref(yDesc),
+                                                                           solution_id,
+                                                                           true);
+        miopen::deref(ticket) =
+            TrackCompile(miopen::deref(handle), std::move(builds), callback, user_data);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionBackwardDataCompileSolutionAsync(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const miopenTensorDescriptor_t wDesc,
+                                                  const miopenConvolutionDescriptor_t convDesc,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  const uint64_t solution_id,
+                                                  miopenCompileCallback_t callback,
+                                                  void* user_data,
+                                                  uint64_t* ticket)
+{
+    MIOPEN_LOG_FUNCTION(handle, dyDesc, wDesc, convDesc, dxDesc, solution_id, user_data);
+    return miopen::try_([&] {
+        auto builds = miopen::deref(convDesc).mode == miopenTranspose
+                          ? miopen::deref(convDesc).CompileForwardSolution(miopen::deref(handle),
+                                                                           miopen::deref(wDesc),
+                                                                           miopen::deref(dyDesc),
+                                                                           miopen::deref(dxDesc),
+                                                                           solution_id,
+                                                                           true)
+                          : miopen::deref(convDesc).CompileBackwardSolution(miopen::deref(handle),
+                                                                            miopen::deref(dyDesc),
+                                                                            miopen::deref(wDesc),
+                                                                            miopen::deref(dxDesc),
+                                                                            solution_id,
+                                                                            true);
+        miopen::deref(ticket) =
+            TrackCompile(miopen::deref(handle), std::move(builds), callback, user_data);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionBackwardWeightsCompileSolutionAsync(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     const miopenTensorDescriptor_t dwDesc,
+                                                     const uint64_t solution_id,
+                                                     miopenCompileCallback_t callback,
+                                                     void* user_data,
+                                                     uint64_t* ticket)
+{
+    MIOPEN_LOG_FUNCTION(handle, dyDesc, xDesc, convDesc, dwDesc, solution_id, user_data);
+    return miopen::try_([&] {
+        const auto transpose = miopen::deref(convDesc).mode == miopenTranspose;
+        const auto& dy       = miopen::deref(transpose ? xDesc : dyDesc);
+        const auto& x        = miopen::deref(transpose ? dyDesc : xDesc);
+        auto builds          = miopen::deref(convDesc).CompileWrwSolution(
+            miopen::deref(handle), dy, x, miopen::deref(dwDesc), solution_id, true);
+        miopen::deref(ticket) =
+            TrackCompile(miopen::deref(handle), std::move(builds), callback, user_data);
+    });
+}
+
+extern "C" miopenStatus_t miopenQueryCompileSolution(miopenHandle_t handle,
+                                                     uint64_t ticket,
+                                                     int* done,
+                                                     miopenStatus_t* status)
+{
+    MIOPEN_LOG_FUNCTION(handle, ticket);
+    return miopen::try_([&] {
+        auto compile_status = miopenStatusSuccess;
+        const auto finished =
+            miopen::deref(handle).GetAsyncCompiler().Query(ticket, compile_status);
+        miopen::deref(done) = finished ? 1 : 0;
+        if(finished)
+            miopen::deref(status) = compile_status;
+    });
+}
+
+extern "C" miopenStatus_t
+miopenWaitCompileSolution(miopenHandle_t handle, uint64_t ticket, miopenStatus_t* status)
+{
+    MIOPEN_LOG_FUNCTION(handle, ticket);
+    return miopen::try_(
+        [&] { miopen::deref(status) = miopen::deref(handle).GetAsyncCompiler().WaitFor(ticket); });
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
                                           const miopenTensorDescriptor_t dyDesc,
@@ -28,8 +28,49 @@
 #include <miopen/errors.hpp>
 #include <miopen/env.hpp>
 
+#include <string>
+
 namespace miopen {
 
+namespace {
+
+/// wksp_sz_lb is the number of ints before the labels with blanks: the input and label lengths,
+/// the label offsets and repeats and the labels themselves when those are copied by the host.
+size_t CTCLossWorkspaceSize(Handle& handle,
+                            const TensorDescriptor& probsDesc,
+                            size_t wksp_sz_lb,
+                            int max_label_len)
+{
+    size_t class_sz      = probsDesc.GetLengths()[2];
+    size_t batch_size    = probsDesc.GetLengths()[1];
+    size_t max_time_step = probsDesc.GetLengths()[0];
+    size_t wksp_sz_dat   = 0;
+
+    // labels with blanks
+    wksp_sz_lb += batch_size * (2 * max_label_len + 1);
+
+    // logsoftmax of probs
+    wksp_sz_dat += max_time_step * batch_size * class_sz;
+
+    // alphas
+    wksp_sz_dat += max_time_step * batch_size * (2 * max_label_len + 1);
+
+    // beta buffer
+    wksp_sz_dat += 2 * batch_size * (2 * max_label_len + 1);
+
+    // fp32 log-space gradients of a frame for the 16-bit types
+    if(probsDesc.GetType() != miopenFloat)
+        wksp_sz_dat += batch_size * class_sz;
+
+    size_t total_size = wksp_sz_dat * sizeof(float) + wksp_sz_lb * sizeof(int);
+    if(total_size > handle.GetMaxMemoryAllocSize())
+        MIOPEN_THROW(miopenStatusBadParm, "Error: Workspace size exceeds GPU memory capacity");
+
+    return total_size;
+}
+
+} // namespace
+
 CTCLossDescriptor::CTCLossDescriptor()
 {
     dataType            = miopenFloat;
@@ -63,8 +104,6 @@ size_t CTCLossDescriptor::GetCTCLossWorkspaceSize(Handle& handle,
     int total_label_len = 0;
     std::vector<int> repeat(batch_size, 0);
     std::vector<int> labels_offset(batch_size, 0);
-    size_t wksp_sz_lb  = 0;
-    size_t wksp_sz_dat = 0;
 
     for(int i = 0; i < batch_size; i++)
     {
@@ -93,38 +132,57 @@ size_t CTCLossDescriptor::GetCTCLossWorkspaceSize(Handle& handle,
         }
     }
 
-    // input length
-    wksp_sz_lb += batch_size;
-
-    // label length
-    wksp_sz_lb += batch_size;
+    return CTCLossWorkspaceSize(handle, probsDesc, 4 * batch_size + total_label_len, max_label_len);
+}
 
-    // label offset
-    wksp_sz_lb += batch_size;
+size_t CTCLossDescriptor::GetCTCLossWorkspaceSize(Handle& handle,
+                                                  const TensorDescriptor& probsDesc,
+                                                  const TensorDescriptor& gradientsDesc,
+                                                  int maxLabelLength,
+                                                  miopenCTCLossAlgo_t algo) const
+{
+    (void)algo;
 
-    // label repeat
-    wksp_sz_lb += batch_size;
+    if(probsDesc.GetLengths()[0] != gradientsDesc.GetLengths()[0] ||
+       probsDesc.GetLengths()[1] != gradientsDesc.GetLengths()[1] ||
+       probsDesc.GetLengths()[2] != gradientsDesc.GetLengths()[2])
+    {
+        MIOPEN_THROW(
+            miopenStatusBadParm,
+            "The probability tensor's dimensions do not match the gradient tensor's dimensions");
+    }
 
-    // labels
-    wksp_sz_lb += total_label_len;
+    if(maxLabelLength <= 0)
+        MIOPEN_THROW(miopenStatusBadParm, "The maximum label length must be positive");
 
-    // labels with blanks
-    wksp_sz_lb += batch_size * (2 * max_label_len + 1);
+    // The device-resident labels and lengths are read in place, only the labels with blanks
+    // are stored in the workspace.
+    return CTCLossWorkspaceSize(handle, probsDesc, 0, maxLabelLength);
+}
 
-    // logsoftmax of probs
-    wksp_sz_dat += max_time_step * batch_size * class_sz;
+size_t CTCLossDescriptor::GetCTCDecodeWorkspaceSize(const TensorDescriptor& probsDesc,
+                                                    miopenCTCDecodeMode_t mode,
+                                                    int beamWidth) const
+{
+    if(probsDesc.GetSize() != 3)
+        MIOPEN_THROW(miopenStatusBadParm, "The probability tensor must have three dimensions");
 
-    // alphas
-    wksp_sz_dat += max_time_step * batch_size * (2 * max_label_len + 1);
+    if(mode == MIOPEN_CTC_DECODE_GREEDY)
+    {
+        if(beamWidth != 1)
+            MIOPEN_THROW(miopenStatusBadParm, "Greedy decoding requires a beam width of 1");
+        return 0;
+    }
 
-    // beta buffer
-    wksp_sz_dat += 2 * batch_size * (2 * max_label_len + 1);
+    if(mode != MIOPEN_CTC_DECODE_BEAM_SEARCH)
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown CTC decoding mode");
 
-    size_t total_size = wksp_sz_dat * sizeof(float) + wksp_sz_lb * sizeof(int);
-    if(total_size > handle.GetMaxMemoryAllocSize())
-        MIOPEN_THROW(miopenStatusBadParm, "Error: Workspace size exceeds GPU memory capacity");
+    if(beamWidth < 1 || beamWidth > MaxDecodeBeamWidth)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The beam width must be in [1, " + std::to_string(MaxDecodeBeamWidth) + "]");
 
-    return total_size;
+    // The parent beam and the appended id of every beam and frame
+    return probsDesc.GetLengths()[0] * probsDesc.GetLengths()[1] * beamWidth * 2 * sizeof(int);
 }
 
 std::ostream& operator<<(std::ostream& stream, const CTCLossDescriptor& r)
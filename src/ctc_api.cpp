@@ -178,3 +178,137 @@ extern "C" miopenStatus_t miopenCTCLoss(miopenHandle_t handle,
                      workSpaceSize);
     });
 }
+
+extern "C" miopenStatus_t
+miopenGetCTCLossWorkspaceSize_V2(miopenHandle_t handle,
+                                 const miopenTensorDescriptor_t probsDesc,
+                                 const miopenTensorDescriptor_t gradientsDesc,
+                                 int maxLabelLength,
+                                 miopenCTCLossAlgo_t algo,
+                                 const miopenCTCLossDescriptor_t ctcLossDesc,
+                                 size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(probsDesc, gradientsDesc, maxLabelLength, algo, ctcLossDesc, workSpaceSize);
+
+    return miopen::try_([&] {
+        miopen::deref(workSpaceSize) = miopen::deref(ctcLossDesc)
+                                           .GetCTCLossWorkspaceSize(miopen::deref(handle),
+                                                                    miopen::deref(probsDesc),
+                                                                    miopen::deref(gradientsDesc),
+                                                                    maxLabelLength,
+                                                                    algo);
+    });
+}
+
+extern "C" miopenStatus_t miopenCTCLoss_V2(miopenHandle_t handle,
+                                           const miopenTensorDescriptor_t probsDesc,
+                                           const void* probs,
+                                           const int* labels,
+                                           const int* labelLengths,
+                                           const int* inputLengths,
+                                           int maxLabelLength,
+                                           void* losses,
+                                           const miopenTensorDescriptor_t gradientsDesc,
+                                           void* gradients,
+                                           miopenCTCLossAlgo_t algo,
+                                           const miopenCTCLossDescriptor_t ctcLossDesc,
+                                           void* workSpace,
+                                           size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(probsDesc,
+                        probs,
+                        labels,
+                        labelLengths,
+                        inputLengths,
+                        maxLabelLength,
+                        losses,
+                        gradientsDesc,
+                        gradients,
+                        algo,
+                        ctcLossDesc,
+                        workSpace,
+                        workSpaceSize);
+
+    // bfloat16 not supported for ctc operation
+    if(miopen::deref(probsDesc).GetType() == miopenBFloat16 ||
+       miopen::deref(gradientsDesc).GetType() == miopenBFloat16)
+    {
+        return miopenStatusNotImplemented;
+    }
+
+    return miopen::try_([&] {
+        miopen::deref(ctcLossDesc)
+            .CTCLoss(miopen::deref(handle),
+                     miopen::deref(probsDesc),
+                     DataCast(probs),
+                     DataCast(labels),
+                     DataCast(labelLengths),
+                     DataCast(inputLengths),
+                     maxLabelLength,
+                     DataCast(losses),
+                     miopen::deref(gradientsDesc),
+                     DataCast(gradients),
+                     algo,
+                     DataCast(workSpace),
+                     workSpaceSize);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenGetCTCDecodeWorkspaceSize(miopenHandle_t handle,
+                                const miopenCTCLossDescriptor_t ctcLossDesc,
+                                miopenCTCDecodeMode_t mode,
+                                int beamWidth,
+                                const miopenTensorDescriptor_t probsDesc,
+                                size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, ctcLossDesc, mode, beamWidth, probsDesc, workSpaceSize);
+
+    return miopen::try_([&] {
+        miopen::deref(workSpaceSize) = miopen::deref(ctcLossDesc)
+                                           .GetCTCDecodeWorkspaceSize(
+                                               miopen::deref(probsDesc), mode, beamWidth);
+    });
+}
+
+extern "C" miopenStatus_t miopenCTCDecode(miopenHandle_t handle,
+                                          const miopenCTCLossDescriptor_t ctcLossDesc,
+                                          miopenCTCDecodeMode_t mode,
+                                          int beamWidth,
+                                          const miopenTensorDescriptor_t probsDesc,
+                                          const void* probs,
+                                          const int* inputLengths,
+                                          int* decoded,
+                                          int* decodedLengths,
+                                          float* scores,
+                                          void* workSpace,
+                                          size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        ctcLossDesc,
+                        mode,
+                        beamWidth,
+                        probsDesc,
+                        probs,
+                        inputLengths,
+                        decoded,
+                        decodedLengths,
+                        scores,
+                        workSpace,
+                        workSpaceSize);
+
+    return miopen::try_([&] {
+        miopen::deref(ctcLossDesc)
+            .CTCDecode(miopen::deref(handle),
+                       mode,
+                       beamWidth,
+                       miopen::deref(probsDesc),
+                       DataCast(probs),
+                       DataCast(inputLengths),
+                       DataCast(decoded),
+                       DataCast(decodedLengths),
+                       DataCast(scores),
+                       DataCast(workSpace),
+                       workSpaceSize);
+    });
+}
@@ -25,6 +25,8 @@
  *******************************************************************************/
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_write_batch.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -36,27 +38,286 @@
 #include <boost/none.hpp>
 #include <boost/optional.hpp>
 
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <fstream>
 #include <ios>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <sys/stat.h>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DB_WRITE_BATCH_SIZE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DB_WRITE_BATCH_TIMEOUT_MS)
+
 namespace miopen {
 
-struct RecordPositions
+struct DbFileState
+{
+    bool exists         = false;
+    dev_t device        = 0;
+    ino_t inode         = 0;
+    std::int64_t mtime  = 0;
+    std::streamoff size = 0;
+
+    static DbFileState Get(const std::string& filename)
+    {
+        struct stat info
+        {
+        };
+        if(stat(filename.c_str(), &info) != 0)
+            return {};
+        const auto mtime = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 +
+                           static_cast<std::int64_t>(info.st_mtim.tv_nsec);
+        return {true, info.st_dev, info.st_ino, mtime, static_cast<std::streamoff>(info.st_size)};
+    }
+
+    bool IsSameFile(const DbFileState& other) const
+    {
+        return exists && other.exists && device == other.device && inode == other.inode;
+    }
+
+    bool operator==(const DbFileState& other) const
+    {
+        return IsSameFile(other) && mtime == other.mtime && size == other.size;
+    }
+};
+
+struct DbIndexEntry
+{
+    std::streamoff offset;
+    std::streamoff size;
+};
+
+/// Key to line index of an append-only text db file. Records are only ever appended to the
+/// file. The last line with a key wins and a line with no contents removes the record.
+/// Lines that are already indexed never change until the file is compacted, which replaces
+/// it with a new one by rename. So the index is refreshed by parsing only the lines appended
+/// since the last refresh, and records are read from the file by the offsets without the
+/// inter-process lock.
+/// Lookups share the mutex and only hold it to find the offsets while the file is unchanged.
+/// It is taken exclusively to refresh the index, never for file writes or record reads.
+struct DbFileIndex
+{
+    std::shared_timed_mutex mutex;
+    DbFileState state;
+    /// Changes on every reset, so that a reader who finds the file replaced resets the index
+    /// only if nobody has done that since the lookup.
+    std::uint64_t version = 0;
+    /// Size of the indexed part of the file, an incomplete last line is not a part of it.
+    std::streamoff size = 0;
+    /// Size of the lines of the records that are not overwritten or removed.
+    std::streamoff live_size = 0;
+    /// Allows to detect the file rewritten in place.
+    std::string last_line;
+    std::unordered_map<std::string, DbIndexEntry> records;
+
+    static DbFileIndex& Get(const std::string& filename)
+    {
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static std::mutex mutex;
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static std::map<std::string, std::unique_ptr<DbFileIndex>> indices;
+
+        std::lock_guard<std::mutex> lock{mutex};
+        auto& index = indices[filename];
+        if(index == nullptr)
+            index = std::make_unique<DbFileIndex>();
+        return *index;
+    }
+
+    void Reset()
+    {
+        ++version;
+        state     = {};
+        size      = 0;
+        live_size = 0;
+        last_line.clear();
+        records.clear();
+    }
+
+    /// Returns false if the file is unreadable.
+    bool Refresh(const std::string& filename)
+    {
+        const auto current = DbFileState::Get(filename);
+        if(!current.exists)
+        {
+            Reset();
+            return false;
+        }
+        if(current == state)
+            return true;
+
+        std::ifstream file(filename, std::ios::binary);
+        if(!file)
+        {
+            Reset();
+            return false;
+        }
+
+        if(!current.IsSameFile(state) || current.size < size || !IsLastLineIntact(file))
+        {
+            MIOPEN_LOG_I2("Indexing " << filename);
+            Reset();
+        }
+
+        Parse(file, filename);
+        state = current;
+        return true;
+    }
+
+    bool Find(const std::string& key, DbIndexEntry& entry) const
+    {
+        const auto found = records.find(key);
+        if(found == records.end())
+            return false;
+        entry = found->second;
+        return true;
+    }
+
+    private:
+    bool IsLastLineIntact(std::istream& file) const
+    {
+        if(size == 0)
+            return true;
+
+        auto line = std::string(last_line.size() + 1, '\0');
+        file.seekg(size - static_cast<std::streamoff>(line.size()));
+        file.read(&line[0], line.size());
+        file.clear();
+        return file.gcount() == static_cast<std::streamsize>(line.size()) &&
+               line.compare(0, last_line.size(), last_line) == 0 && line.back() == '\n';
+    }
+
+    void Parse(std::istream& file, const std::string& filename)
+    {
+        file.seekg(size);
+
+        std::string line;
+        while(std::getline(file, line))
+        {
+            // The line is being appended by someone else.
+            if(file.eof())
+                break;
+
+            const auto offset   = size;
+            const auto key_size = line.find('=');
+            size += static_cast<std::streamoff>(line.size()) + 1;
+
+            if(key_size == std::string::npos || key_size == 0)
+            {
+                if(!line.empty()) // Do not blame empty lines.
+                    MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "@"
+                                                                      << offset);
+                continue;
+            }
+
+            last_line = line;
+            auto key  = line.substr(0, key_size);
+            const auto old = records.find(key);
+            if(old != records.end())
+            {
+                live_size -= old->second.size + 1;
+                records.erase(old);
+            }
+
+            if(key_size + 1 == line.size())
+                continue;
+
+            const auto entry = DbIndexEntry{offset, static_cast<std::streamoff>(line.size())};
+            live_size += entry.size + 1;
+            records.emplace(std::move(key), entry);
+        }
+    }
+};
+
+// Compaction leaves only the latest lines of the records in the file.
+static constexpr std::streamoff db_compaction_min_size = 64 * 1024;
+static constexpr std::streamoff db_compaction_ratio    = 2;
+
+struct PendingDbRecord
+{
+    DbRecord record;
+    // Whether values of the record in the file not overwritten by this one shall be kept.
+    bool merge;
+};
+
+struct PendingDbRecords
 {
-    std::streamoff begin = -1;
-    std::streamoff end   = -1;
+    std::map<std::string, PendingDbRecord> records;
+    std::chrono::steady_clock::time_point first_write;
 };
+
+namespace {
+struct PendingDbWrites
+{
+    std::mutex mutex;
+    std::map<std::string, PendingDbRecords> files;
+
+    ~PendingDbWrites()
+    {
+        for(const auto& file : files)
+        {
+            try
+            {
+                PlainTextDb{file.first}.Flush();
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Unable to write pending updates to " << file.first << ": "
+                                                                   << ex.what());
+            }
+        }
+    }
+};
+
+PendingDbWrites& GetPendingDbWrites()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static PendingDbWrites instance;
+    return instance;
+}
+} // namespace
+
+const DbWriteBatchLimits& DbWriteBatchLimits::Get()
+{
+    static const auto limits = DbWriteBatchLimits{
+        static_cast<std::size_t>(Value(MIOPEN_DB_WRITE_BATCH_SIZE{}, 0)),
+        std::chrono::milliseconds{Value(MIOPEN_DB_WRITE_BATCH_TIMEOUT_MS{}, 1000)}};
+    return limits;
+}
+
+void FlushDbWrites() noexcept
+{
+    try
+    {
+        PlainTextDb::FlushAll();
+#if MIOPEN_ENABLE_SQLITE
+        SQLitePerfDb::FlushAll();
+#endif
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to write pending database updates: " << ex.what());
+    }
+}
 PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
     : filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
+      index(DbFileIndex::Get(filename_)),
       warn_if_unreadable(is_system)
 {
     if(!is_system)
@@ -88,13 +349,45 @@ using shared_lock    = std::shared_lock<LockFile>;
 
 boost::optional<DbRecord> PlainTextDb::FindRecord(const std::string& key)
 {
-    const auto lock = shared_lock(lock_file, GetLockTimeout());
-    MIOPEN_VALIDATE_LOCK(lock);
-    return FindRecordUnsafe(key, nullptr);
+    auto pending = boost::optional<PendingDbRecord>{};
+    if(DbWriteBatchLimits::Get().IsEnabled())
+    {
+        auto& writes = GetPendingDbWrites();
+        std::lock_guard<std::mutex> pending_lock{writes.mutex};
+        const auto file = writes.files.find(filename);
+        if(file != writes.files.end())
+        {
+            const auto it = file->second.records.find(key);
+            if(it != file->second.records.end())
+            {
+                if(!it->second.merge)
+                    return it->second.record;
+                pending = it->second;
+            }
+        }
+    }
+
+    // Reads do not need the lock unless the file has been compacted in the middle of one.
+    auto stale  = false;
+    auto record = FindRecordUnsafe(key, stale);
+    if(stale)
+    {
+        const auto lock = shared_lock(lock_file, GetLockTimeout());
+        MIOPEN_VALIDATE_LOCK(lock);
+        record = FindRecordUnsafe(key, stale);
+    }
+    if(!pending)
+        return record;
+    if(record)
+        pending->record.Merge(*record);
+    return pending->record;
 }
 
 bool PlainTextDb::StoreRecord(const DbRecord& record)
 {
+    if(DbWriteBatchLimits::Get().IsEnabled())
+        return AddPendingRecord(record, false);
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return StoreRecordUnsafe(record);
@@ -102,6 +395,18 @@ bool PlainTextDb::StoreRecord(const DbRecord& record)
 
 bool PlainTextDb::UpdateRecord(DbRecord& record)
 {
+    if(DbWriteBatchLimits::Get().IsEnabled())
+    {
+        auto new_record = record;
+        const auto old_record = FindRecord(record.key);
+        if(old_record)
+            new_record.Merge(*old_record);
+        if(!AddPendingRecord(new_record, true))
+            return false;
+        record = std::move(new_record);
+        return true;
+    }
+
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return UpdateRecordUnsafe(record);
@@ -109,6 +414,7 @@ bool PlainTextDb::UpdateRecord(DbRecord& record)
 
 bool PlainTextDb::RemoveRecord(const std::string& key)
 {
+    Flush();
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return RemoveRecordUnsafe(key);
@@ -116,9 +422,10 @@ bool PlainTextDb::RemoveRecord(const std::string& key)
 
 bool PlainTextDb::Remove(const std::string& key, const std::string& id)
 {
+    Flush();
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    auto record = FindRecordUnsafe(key, nullptr);
+    auto record = FindRecordUnsafe(key);
     if(!record)
         return false;
     bool erased = record->EraseValues(id);
@@ -127,175 +434,192 @@ bool PlainTextDb::Remove(const std::string& key, const std::string& id)
     return StoreRecordUnsafe(*record);
 }
 
-boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
-                                                        RecordPositions* pos)
+boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key)
 {
-    if(pos != nullptr)
-    {
-        pos->begin = -1;
-        pos->end   = -1;
-    }
+    auto stale  = false;
+    auto record = FindRecordUnsafe(key, stale);
+    if(stale)
+        record = FindRecordUnsafe(key, stale);
+    return record;
+}
 
+boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key, bool& stale)
+{
     MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
 
-    std::ifstream file(filename);
+    stale = false;
 
-    if(!file)
+    auto entry   = DbIndexEntry{};
+    auto found   = false;
+    auto indexed = false;
+    auto version = std::uint64_t{0};
     {
-        if(warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
-            MIOPEN_LOG_W("File is unreadable: " << filename);
-        else
-            MIOPEN_LOG_I2("File is unreadable: " << filename);
-
-        return boost::none;
+        const auto current = DbFileState::Get(filename);
+        std::shared_lock<std::shared_timed_mutex> index_lock{index.mutex};
+        if(current.exists && current == index.state)
+        {
+            found   = index.Find(key, entry);
+            indexed = true;
+            version = index.version;
+        }
     }
 
-    int n_line = 0;
-    while(true)
+    if(!indexed)
     {
-        std::string line;
-        const auto line_begin = file.tellg();
-        if(!std::getline(file, line))
-            break;
-        ++n_line;
-        const auto next_line_begin = file.tellg();
-
-        const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
-        if(!is_key)
+        std::lock_guard<std::shared_timed_mutex> index_lock{index.mutex};
+        if(!index.Refresh(filename))
         {
-            if(!line.empty()) // Do not blame empty lines.
-            {
-                MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
-            }
-            continue;
-        }
-        const auto current_key = line.substr(0, key_size);
+            if(warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                MIOPEN_LOG_W("File is unreadable: " << filename);
+            else
+                MIOPEN_LOG_I2("File is unreadable: " << filename);
 
-        if(current_key != key)
-        {
-            continue;
+            return boost::none;
         }
-        MIOPEN_LOG_I2("Key match: " << current_key);
-        const auto contents = line.substr(key_size + 1);
+        found   = index.Find(key, entry);
+        version = index.version;
+    }
 
-        if(contents.empty())
-        {
-            MIOPEN_LOG_E("None contents under the key: " << current_key << " form file " << filename
-                                                         << "#" << n_line);
-            continue;
-        }
-        MIOPEN_LOG_I2("Contents found: " << contents);
+    if(!found)
+        return boost::none;
 
-        DbRecord record(key);
-        const bool is_parse_ok = record.ParseContents(contents);
+    std::ifstream file(filename, std::ios::binary);
+    auto line = std::string(entry.size, '\0');
+    file.seekg(entry.offset);
+    file.read(&line[0], line.size());
 
-        if(!is_parse_ok)
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: " << current_key << " form file "
-                                                                 << filename << "#" << n_line);
-            MIOPEN_LOG_E("Contents: " << contents);
-        }
-        // A record with matching key have been found.
-        if(pos != nullptr)
-        {
-            pos->begin = line_begin;
-            pos->end   = next_line_begin;
-        }
-        return record;
+    if(!file || line.compare(0, key.size(), key) != 0 || line[key.size()] != '=')
+    {
+        MIOPEN_LOG_I2("File has been replaced while being read: " << filename);
+        std::lock_guard<std::shared_timed_mutex> index_lock{index.mutex};
+        if(index.version == version)
+            index.Reset();
+        stale = true;
+        return boost::none;
     }
-    // Record was not found
-    return boost::none;
-}
 
-static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
-{
-    constexpr auto buffer_size_limit = 4 * 1024 * 1024;
-    const auto buffer_size           = std::min<std::streamoff>(buffer_size_limit, count);
-    auto buffer                      = std::vector<char>(buffer_size, 0);
-    auto left                        = count;
+    MIOPEN_LOG_I2("Key match: " << key);
+    const auto contents = line.substr(key.size() + 1);
+    MIOPEN_LOG_I2("Contents found: " << contents);
+
+    DbRecord record(key);
+    const bool is_parse_ok = record.ParseContents(contents);
 
-    while(left > 0 && !from.eof())
+    if(!is_parse_ok)
     {
-        const auto to_read = std::min<std::streamoff>(left, buffer_size);
-        from.read(buffer.data(), to_read);
-        const auto read = from.gcount();
-        to.write(buffer.data(), read);
-        left -= read;
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename
+                                                             << "@" << entry.offset);
+        MIOPEN_LOG_E("Contents: " << contents);
     }
+    return record;
 }
 
-bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
+bool PlainTextDb::AppendUnsafe(const std::vector<DbRecord>& records)
 {
-    assert(pos);
-
-    if(pos->begin < 0 || pos->end < 0)
+    std::ostringstream lines;
     {
-        {
-            std::ofstream file(filename, std::ios::app);
-
-            if(!file)
-            {
-                MIOPEN_LOG_E("File is unwritable: " << filename);
-                return false;
-            }
+        std::lock_guard<std::shared_timed_mutex> index_lock{index.mutex};
+        index.Refresh(filename);
 
-            (void)file.tellp();
-            record.WriteContents(file);
+        for(const auto& record : records)
+        {
+            if(record.GetSize() != 0)
+                record.WriteContents(lines);
+            else if(index.records.find(record.key) != index.records.end())
+                lines << record.key << '=' << std::endl;
         }
-
-        boost::filesystem::permissions(filename, boost::filesystem::all_all);
     }
-    else
+
+    const auto text = lines.str();
+    if(text.empty())
+        return true;
+
     {
-        std::ifstream from(filename, std::ios::ate);
+        // The lines are written at once, so that a reader would never see a part of them as
+        // complete lines. Lookups go on meanwhile, the lines are not indexed until written.
+        std::ofstream file(filename, std::ios::app | std::ios::binary);
 
-        if(!from)
+        if(!file)
         {
-            MIOPEN_LOG_E("File is unreadable: " << filename);
+            MIOPEN_LOG_E("File is unwritable: " << filename);
             return false;
         }
 
-        const auto temp_name = filename + ".temp";
-        std::ofstream to(temp_name);
+        file.write(text.data(), text.size());
+        file.flush();
 
-        if(!to)
+        if(!file)
         {
-            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            MIOPEN_LOG_E("File is unwritable: " << filename);
             return false;
         }
+    }
 
-        const auto from_size = from.tellg();
-        from.seekg(std::ios::beg);
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
 
-        Copy(from, to, pos->begin);
-        record.WriteContents(to);
-        from.seekg(pos->end);
-        Copy(from, to, from_size - pos->end);
+    std::lock_guard<std::shared_timed_mutex> index_lock{index.mutex};
+    index.Refresh(filename);
 
-        from.close();
-        to.close();
+    if(index.size >= db_compaction_min_size && index.size >= db_compaction_ratio * index.live_size)
+        CompactUnsafe();
+    return true;
+}
+
+void PlainTextDb::CompactUnsafe()
+{
+    MIOPEN_LOG_I2("Compacting " << filename << ": " << index.live_size << " of " << index.size
+                                << " bytes are in use");
+
+    auto entries = std::vector<DbIndexEntry>{};
+    entries.reserve(index.records.size());
+    for(const auto& record : index.records)
+        entries.push_back(record.second);
+    std::sort(entries.begin(), entries.end(), [](const auto& left, const auto& right) {
+        return left.offset < right.offset;
+    });
+
+    const auto temp_name = filename + ".temp";
+    {
+        std::ifstream from(filename, std::ios::binary);
+        std::ofstream to(temp_name, std::ios::binary);
+
+        if(!from || !to)
+        {
+            MIOPEN_LOG_E("Unable to compact " << filename);
+            return;
+        }
+
+        auto line = std::string{};
+        for(const auto& entry : entries)
+        {
+            line.resize(entry.size);
+            from.seekg(entry.offset);
+            from.read(&line[0], line.size());
+            to << line << '\n';
+        }
 
-        std::remove(filename.c_str());
-        std::rename(temp_name.c_str(), filename.c_str());
-        /// \todo What if rename fails? Thou shalt not loose the original file.
-        boost::filesystem::permissions(filename, boost::filesystem::all_all);
+        if(!from || !to)
+        {
+            MIOPEN_LOG_E("Unable to compact " << filename);
+            return;
+        }
     }
-    return true;
+
+    std::rename(temp_name.c_str(), filename.c_str());
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    index.Reset();
+    index.Refresh(filename);
 }
 
 bool PlainTextDb::StoreRecordUnsafe(const DbRecord& record)
 {
     MIOPEN_LOG_I2("Storing record: " << record.key);
-    RecordPositions pos;
-    FindRecordUnsafe(record.key, &pos);
-    return FlushUnsafe(record, &pos);
+    return AppendUnsafe({record});
 }
 
 bool PlainTextDb::UpdateRecordUnsafe(DbRecord& record)
 {
-    RecordPositions pos;
-    const auto old_record = FindRecordUnsafe(record.key, &pos);
+    const auto old_record = FindRecordUnsafe(record.key);
     DbRecord new_record(record);
     if(old_record)
     {
@@ -306,21 +630,99 @@ bool PlainTextDb::UpdateRecordUnsafe(DbRecord& record)
     {
         MIOPEN_LOG_I2("Storing record: " << record.key);
     }
-    bool result = FlushUnsafe(new_record, &pos);
+    bool result = AppendUnsafe({new_record});
     if(result)
         record = std::move(new_record);
     return result;
 }
 
+bool PlainTextDb::AddPendingRecord(const DbRecord& record, bool merge)
+{
+    const auto& limits = DbWriteBatchLimits::Get();
+    auto& writes       = GetPendingDbWrites();
+    std::lock_guard<std::mutex> pending_lock{writes.mutex};
+    auto& pending = writes.files[filename];
+
+    if(pending.records.empty())
+        pending.first_write = std::chrono::steady_clock::now();
+
+    auto it = pending.records.find(record.key);
+    if(it == pending.records.end())
+        pending.records.emplace(record.key, PendingDbRecord{record, merge});
+    else
+        // A stored record replaces the one in the file, and so does any later update of it.
+        it->second = PendingDbRecord{record, it->second.merge && merge};
+
+    if(pending.records.size() < limits.size &&
+       std::chrono::steady_clock::now() - pending.first_write < limits.timeout)
+        return true;
+
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return FlushPendingUnsafe(pending);
+}
+
+void PlainTextDb::Flush()
+{
+    auto& writes = GetPendingDbWrites();
+    std::lock_guard<std::mutex> pending_lock{writes.mutex};
+    const auto file = writes.files.find(filename);
+    if(file == writes.files.end() || file->second.records.empty())
+        return;
+
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    FlushPendingUnsafe(file->second);
+}
+
+void PlainTextDb::FlushAll()
+{
+    auto files = std::vector<std::string>{};
+    {
+        auto& writes = GetPendingDbWrites();
+        std::lock_guard<std::mutex> pending_lock{writes.mutex};
+        for(const auto& file : writes.files)
+            files.push_back(file.first);
+    }
+
+    for(const auto& file : files)
+        PlainTextDb{file}.Flush();
+}
+
+bool PlainTextDb::FlushPendingUnsafe(PendingDbRecords& pending)
+{
+    if(pending.records.empty())
+        return true;
+
+    MIOPEN_LOG_I2("Writing " << pending.records.size() << " records to " << filename);
+    auto pending_records = std::move(pending.records);
+    pending.records.clear();
+
+    // All of the records are appended to the file at once.
+    auto records = std::vector<DbRecord>{};
+    records.reserve(pending_records.size());
+    for(auto& pending_record : pending_records)
+    {
+        auto& record = pending_record.second.record;
+        if(pending_record.second.merge)
+        {
+            const auto old_record = FindRecordUnsafe(pending_record.first);
+            if(old_record)
+                record.Merge(*old_record);
+        }
+        records.push_back(std::move(record));
+    }
+
+    return AppendUnsafe(records);
+}
+
 bool PlainTextDb::RemoveRecordUnsafe(const std::string& key)
 {
-    // Create empty record with same key and replace original with that
+    // Empty record with same key replaces the original one.
     // This will remove record
     MIOPEN_LOG_I("Removing record: " << key);
-    RecordPositions pos;
-    FindRecordUnsafe(key, &pos);
     const DbRecord empty_record(key);
-    return FlushUnsafe(empty_record, &pos);
+    return AppendUnsafe({empty_record});
 }
 
 } // namespace miopen
@@ -0,0 +1,294 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_merge.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/perf_field.hpp>
+
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/problem_description.hpp>
+#include <miopen/sqlite_db.hpp>
+#include <miopen/stringutils.hpp>
+#endif
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <thread>
+#include <utility>
+
+namespace miopen {
+
+DbMerger::DbMerger(Options options_) : options(std::move(options_))
+{
+    if(options.jobs == 0)
+        options.jobs = std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void DbMerger::AddText(const std::vector<std::string>& paths)
+{
+    if(paths.empty())
+        return;
+
+    // Each thread merges a contiguous range of the inputs, so merging the results in the
+    // thread order gives the same database as merging the inputs one by one.
+    const auto jobs    = std::min(options.jobs, paths.size());
+    const auto per_job = (paths.size() + jobs - 1) / jobs;
+    auto results       = std::vector<Records>(jobs);
+    auto errors        = std::vector<std::exception_ptr>(jobs);
+    auto threads       = std::vector<std::thread>{};
+    threads.reserve(jobs);
+
+    for(auto job = std::size_t{0}; job < jobs; ++job)
+    {
+        threads.emplace_back([&, job]() {
+            try
+            {
+                const auto end = std::min(paths.size(), (job + 1) * per_job);
+                for(auto i = job * per_job; i < end; ++i)
+                    Merge(results[job], Parse(paths[i]));
+            }
+            catch(...)
+            {
+                errors[job] = std::current_exception();
+            }
+        });
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+
+    for(const auto& error : errors)
+        if(error)
+            std::rethrow_exception(error);
+
+    for(auto& result : results)
+        Merge(records, std::move(result));
+}
+
+std::vector<std::string> DbMerger::GetKeys() const
+{
+    auto keys = std::vector<std::string>{};
+    keys.reserve(records.size());
+    for(const auto& record : records)
+        keys.push_back(record.first);
+    return keys;
+}
+
+void DbMerger::WriteText(const std::string& path) const
+{
+    std::ofstream file{path, std::ios::out | std::ios::trunc};
+    if(!file)
+        MIOPEN_THROW("Unable to open the output database: " + path);
+
+    for(const auto& record : records)
+    {
+        // Sorted IDs make the output reproducible.
+        auto ids = std::vector<const std::pair<const std::string, std::string>*>{};
+        ids.reserve(record.second.map.size());
+        for(const auto& pair : record.second.map)
+            ids.push_back(&pair);
+        std::sort(ids.begin(), ids.end(), [](auto l, auto r) { return l->first < r->first; });
+
+        file << record.first << '=';
+        for(auto i = std::size_t{0}; i < ids.size(); ++i)
+            file << (i == 0 ? "" : ";") << ids[i]->first << ':' << ids[i]->second;
+        file << '\n';
+    }
+
+    file.close();
+    if(!file)
+        MIOPEN_THROW("Unable to write the output database: " + path);
+}
+
+DbMerger::Records DbMerger::Parse(const std::string& path) const
+{
+    std::ifstream file{path};
+    if(!file)
+        MIOPEN_THROW("Unable to open the database: " + path);
+
+    auto parsed = Records{};
+    auto line   = std::string{};
+    auto n_line = 0;
+
+    while(std::getline(file, line))
+    {
+        ++n_line;
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << n_line);
+            continue;
+        }
+
+        auto record    = DbRecord{line.substr(0, key_size)};
+        const auto key = record.GetKey();
+
+        if(!record.ParseContents(line.substr(key_size + 1)))
+        {
+            // An empty line is a removal in an append-only database.
+            parsed.erase(key);
+            continue;
+        }
+
+        parsed[key] = std::move(record);
+    }
+
+    if(options.filter)
+    {
+        for(auto it = parsed.begin(); it != parsed.end();)
+        {
+            auto& map = it->second.map;
+            for(auto value = map.begin(); value != map.end();)
+            {
+                if(options.filter(value->first, value->second))
+                    ++value;
+                else
+                    value = map.erase(value);
+            }
+
+            if(map.empty())
+                it = parsed.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    MIOPEN_LOG_I2("Parsed " << parsed.size() << " records from " << path);
+    return parsed;
+}
+
+void DbMerger::Merge(Records& to, Records&& from) const
+{
+    for(auto& record : from)
+    {
+        auto it = to.find(record.first);
+        if(it == to.end())
+        {
+            to.emplace(record.first, std::move(record.second));
+            continue;
+        }
+
+        auto& map = it->second.map;
+        for(auto& pair : record.second.map)
+        {
+            auto existing = map.find(pair.first);
+            if(existing == map.end())
+                map.emplace(pair.first, std::move(pair.second));
+            else if(!options.find_db || IsBetter(pair.second, existing->second))
+                existing->second = std::move(pair.second);
+        }
+    }
+}
+
+bool DbMerger::IsBetter(const std::string& values, const std::string& than) const
+{
+    auto data = FindDbData{};
+    if(!data.Deserialize(values))
+        return false;
+    auto other = FindDbData{};
+    if(!other.Deserialize(than))
+        return true;
+    // Entries of the budgeted find mode are kept only until a complete search replaces them.
+    if(data.provisional != other.provisional)
+        return other.provisional != 0;
+    // Clock-normalized times are comparable between the nodes the entries come from.
+    if(data.norm_time > 0 && other.norm_time > 0)
+        return data.norm_time < other.norm_time;
+    return data.time >= 0 && (other.time < 0 || data.time < other.time);
+}
+
+#if MIOPEN_ENABLE_SQLITE
+static std::string QuoteSQLite(const std::string& str)
+{
+    auto quoted = std::string{"'"};
+    for(const auto c : str)
+        quoted += (c == '\'') ? std::string{"''"} : std::string{c};
+    return quoted + "'";
+}
+
+void DbMerger::MergeSQLite(const std::vector<std::string>& inputs,
+                           const std::string& output,
+                           const Filter& filter)
+{
+    auto db = SQLitePerfDb{output, false};
+    if(db.dbInvalid)
+        MIOPEN_THROW("Invalid output perf database: " + output);
+
+    const auto fields = ProblemDescription{conv::Direction::Forward}.FieldNames();
+    auto matches      = std::vector<std::string>{};
+    for(const auto& field : fields)
+        matches.push_back("local.`" + field + "` = src.`" + field + "`");
+    const auto columns = "`" + JoinStrings(fields, "`,`") + "`";
+
+    for(const auto& input : inputs)
+    {
+        MIOPEN_LOG_I2("Merging " << input);
+        db.sql.Exec("ATTACH DATABASE " + QuoteSQLite(input) + " AS merged;");
+        // clang-format off
+        db.sql.Exec(
+            "BEGIN;"
+            "INSERT OR IGNORE INTO config(" + columns + ") "
+            "SELECT " + columns + " FROM merged.config;"
+            "INSERT OR REPLACE INTO perf_db(config, solver, params) "
+            "SELECT local.id, perf.solver, perf.params FROM merged.perf_db AS perf "
+            "INNER JOIN merged.config AS src ON perf.config = src.id "
+            "INNER JOIN config AS local ON " + JoinStrings(matches, " AND ") + ";"
+            "COMMIT;");
+        // clang-format on
+        db.sql.Exec("DETACH DATABASE merged;");
+    }
+
+    if(filter)
+    {
+        auto dropped = std::vector<std::string>{};
+        for(const auto& row : db.sql.Exec("SELECT id, solver, params FROM perf_db;"))
+            if(!filter(row.at("solver"), row.at("params")))
+                dropped.push_back(row.at("id"));
+
+        MIOPEN_LOG_I2("Dropping " << dropped.size() << " perf-db entries");
+        // Chunks keep the statements below the SQLite length limit.
+        constexpr auto chunk = std::size_t{1000};
+        for(auto begin = std::size_t{0}; begin < dropped.size(); begin += chunk)
+        {
+            const auto end = std::min(dropped.size(), begin + chunk);
+            const auto ids =
+                std::vector<std::string>(dropped.begin() + begin, dropped.begin() + end);
+            db.sql.Exec("DELETE FROM perf_db WHERE id IN (" + JoinStrings(ids, ",") + ");");
+        }
+    }
+
+    db.sql.Exec("DELETE FROM config WHERE id NOT IN (SELECT config FROM perf_db);");
+    db.sql.Exec("VACUUM;");
+}
+#endif
+
+} // namespace miopen
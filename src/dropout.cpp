@@ -37,11 +37,19 @@ DropoutDescriptor::DropoutDescriptor()
       seed(0ULL),
       use_mask(false),
       state_evo(false),
-      rng_mode(MIOPEN_RNG_PSEUDO_XORWOW)
+      rng_mode(MIOPEN_RNG_PSEUDO_XORWOW),
+      offset(0ULL),
+      mask_packed(false)
 {
     dataType_ = miopenFloat;
 }
 
+size_t DropoutDescriptor::GetReserveSpaceSize(const TensorDescriptor& xDesc) const
+{
+    const auto elem_num = xDesc.GetElementSize();
+    return mask_packed ? (elem_num + 7) / 8 : elem_num * sizeof(bool);
+}
+
 std::ostream& operator<<(std::ostream& stream, const DropoutDescriptor& x)
 {
     stream << x.dataType_ << ", ";
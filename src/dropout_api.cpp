@@ -55,6 +55,19 @@ extern "C" miopenStatus_t miopenDropoutGetReserveSpaceSize(const miopenTensorDes
     });
 }
 
+extern "C" miopenStatus_t
+miopenDropoutGetReserveSpaceSize_V2(const miopenDropoutDescriptor_t dropoutDesc,
+                                    const miopenTensorDescriptor_t xDesc,
+                                    size_t* reserveSpaceSizeInBytes)
+{
+
+    MIOPEN_LOG_FUNCTION(dropoutDesc, xDesc, reserveSpaceSizeInBytes);
+    return miopen::try_([&] {
+        miopen::deref(reserveSpaceSizeInBytes) =
+            miopen::deref(dropoutDesc).GetReserveSpaceSize(miopen::deref(xDesc));
+    });
+}
+
 extern "C" miopenStatus_t miopenDropoutGetStatesSize(miopenHandle_t handle,
                                                      size_t* stateSizeInBytes)
 {
@@ -135,6 +148,22 @@ extern "C" miopenStatus_t miopenSetDropoutDescriptor(miopenDropoutDescriptor_t d
     });
 }
 
+extern "C" miopenStatus_t miopenSetDropoutOffset(miopenDropoutDescriptor_t dropoutDesc,
+                                                 unsigned long long offset)
+{
+
+    MIOPEN_LOG_FUNCTION(dropoutDesc, offset);
+    return miopen::try_([&] { miopen::deref(dropoutDesc).offset = offset; });
+}
+
+extern "C" miopenStatus_t miopenSetDropoutMaskPacked(miopenDropoutDescriptor_t dropoutDesc,
+                                                     bool mask_packed)
+{
+
+    MIOPEN_LOG_FUNCTION(dropoutDesc, mask_packed);
+    return miopen::try_([&] { miopen::deref(dropoutDesc).mask_packed = mask_packed; });
+}
+
 static void LogCmdDropout(const miopenDropoutDescriptor_t dropoutDesc,
                           const miopenTensorDescriptor_t xDesc,
                           bool is_fwd)
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/embedded_db.hpp>
+
+#if MIOPEN_EMBED_DB
+
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen_data.hpp>
+
+#include <bzlib.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace miopen {
+namespace embedded {
+
+namespace {
+
+// Objects of add_embed_library() are named after the embedded files.
+const std::string object_suffix     = ".o";
+const std::string compressed_suffix = ".bz2";
+
+std::string Decompress(const char* data, std::size_t size, const std::string& name)
+{
+    bz_stream stream{};
+    if(BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK)
+        MIOPEN_THROW(miopenStatusInternalError, "BZ2_bzDecompressInit failed for " + name);
+
+    // NOLINTNEXTLINE (cppcoreguidelines-pro-type-const-cast)
+    stream.next_in  = const_cast<char*>(data);
+    stream.avail_in = static_cast<unsigned int>(size);
+
+    // Text databases compress about 10 times, so most of them fit the first guess.
+    std::string result(size * 10 + 4096, '\0');
+    auto rc = BZ_OK;
+    while(rc == BZ_OK)
+    {
+        const auto done = static_cast<std::size_t>(stream.total_out_lo32) |
+                          (static_cast<std::size_t>(stream.total_out_hi32) << 32);
+        if(done == result.size())
+            result.resize(result.size() * 2);
+        stream.next_out  = &result[done];
+        stream.avail_out = static_cast<unsigned int>(result.size() - done);
+        rc               = BZ2_bzDecompress(&stream);
+    }
+    const auto total = static_cast<std::size_t>(stream.total_out_lo32) |
+                       (static_cast<std::size_t>(stream.total_out_hi32) << 32);
+    BZ2_bzDecompressEnd(&stream);
+    if(rc != BZ_STREAM_END)
+        MIOPEN_THROW(miopenStatusInternalError,
+                     "Corrupted embedded database " + name + ", bz2 error " + std::to_string(rc));
+    result.resize(total);
+    return result;
+}
+
+} // namespace
+
+const std::vector<std::string>& GetFileNames()
+{
+    static const auto names = [] {
+        auto result = std::vector<std::string>{};
+        for(const auto& entry : miopen_data())
+        {
+            auto name = entry.first;
+            if(EndsWith(name, object_suffix))
+                name.resize(name.size() - object_suffix.size());
+            if(EndsWith(name, compressed_suffix))
+                name.resize(name.size() - compressed_suffix.size());
+            result.push_back(name);
+        }
+        return result;
+    }();
+    return names;
+}
+
+bool HasFile(const std::string& name)
+{
+    return miopen_data().find(name + object_suffix) != miopen_data().end() ||
+           miopen_data().find(name + compressed_suffix + object_suffix) != miopen_data().end();
+}
+
+std::pair<const char*, std::size_t> GetFile(const std::string& name)
+{
+    const auto raw = miopen_data().find(name + object_suffix);
+    if(raw != miopen_data().end())
+        return {raw->second.first, raw->second.second - raw->second.first};
+
+    const auto packed = miopen_data().find(name + compressed_suffix + object_suffix);
+    if(packed == miopen_data().end())
+        return {nullptr, 0};
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::map<std::string, std::unique_ptr<const std::string>> contents;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& file = contents[name];
+    if(file == nullptr)
+    {
+        const auto size = packed->second.second - packed->second.first;
+        file = std::make_unique<const std::string>(Decompress(packed->second.first, size, name));
+        MIOPEN_LOG_I2("Decompressed embedded database " << name << ": " << size << " -> "
+                                                        << file->size() << " bytes");
+    }
+    return {file->data(), file->size()};
+}
+
+} // namespace embedded
+} // namespace miopen
+
+#endif // MIOPEN_EMBED_DB
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/env.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern char** environ; // NOLINT (readability-redundant-declaration)
+
+namespace miopen {
+namespace env {
+
+namespace {
+
+using Snapshot = std::unordered_map<std::string, std::string>;
+
+class SnapshotStore
+{
+    public:
+    SnapshotStore() { Refresh(); }
+
+    const Snapshot& Current() const { return *current.load(std::memory_order_acquire); }
+    std::size_t Generation() const { return generation.load(std::memory_order_acquire); }
+
+    void Refresh()
+    {
+        auto snapshot = std::make_unique<Snapshot>();
+        // NOLINTNEXTLINE (concurrency-mt-unsafe)
+        for(auto entry = environ; entry != nullptr && *entry != nullptr; ++entry)
+        {
+            const auto var = std::string{*entry};
+            const auto eq  = var.find('=');
+            if(eq != std::string::npos)
+                snapshot->emplace(var.substr(0, eq), var.substr(eq + 1));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        current.store(snapshot.get(), std::memory_order_release);
+        // The values handed out stay valid until the end of the process.
+        snapshots.push_back(std::move(snapshot));
+        generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Snapshot>> snapshots;
+    std::atomic<const Snapshot*> current{nullptr};
+    std::atomic<std::size_t> generation{0};
+};
+
+SnapshotStore& GetStore()
+{
+    static SnapshotStore store;
+    return store;
+}
+
+} // namespace
+
+const char* GetSnapshotValue(const char* name)
+{
+    const auto& snapshot = GetStore().Current();
+    const auto it        = snapshot.find(name);
+    return it == snapshot.end() ? nullptr : it->second.c_str();
+}
+
+std::size_t GetSnapshotGeneration() { return GetStore().Generation(); }
+
+void Refresh() { GetStore().Refresh(); }
+
+} // namespace env
+} // namespace miopen
@@ -35,13 +35,17 @@
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <cstdlib>
 #include <cstring>
+#include <thread>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_ENFORCE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_ONLY_SOLVER)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_MODE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_BUDGET_MS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_SOLVERS_PARALLEL_LEVEL)
 
 namespace miopen {
 
@@ -167,6 +171,7 @@ const char* ToCString(const FindMode::Values mode)
     case FindMode::Values::Hybrid: return "HYBRID";
     case FindMode::Values::FastHybrid: return "FAST_HYBRID";
     case FindMode::Values::DynamicHybrid: return "DYNAMIC_HYBRID";
+    case FindMode::Values::Budgeted: return "BUDGETED";
     case FindMode::Values::End_: break;
     }
     return "<Unknown>";
@@ -195,6 +200,8 @@ FindMode::Values GetFindModeValueImpl2()
         return FindMode::Values::FastHybrid;
     else if(str == "DYNAMIC_HYBRID")
         return FindMode::Values::DynamicHybrid;
+    else if(str == "BUDGETED")
+        return FindMode::Values::Budgeted;
     else
     { // Nop. Fall down & try numerics.
     }
@@ -221,6 +228,29 @@ FindMode::Values GetFindModeValue()
 } // namespace
 
 FindMode::FindMode() { value = GetFindModeValue(); }
+
+float GetFindBudgetMs()
+{
+    static const auto budget = [] {
+        const auto ms = miopen::Value(MIOPEN_FIND_BUDGET_MS{}, 1000);
+        MIOPEN_LOG_NQI("MIOPEN_FIND_BUDGET_MS = " << ms);
+        return static_cast<float>(ms);
+    }();
+    return budget;
+}
+
+std::size_t GetFindSolversParallelLevel()
+{
+    static const auto level = [] {
+        const auto hardware = std::thread::hardware_concurrency();
+        const auto threads =
+            std::max<std::size_t>(miopen::Value(MIOPEN_FIND_SOLVERS_PARALLEL_LEVEL{}, hardware), 1);
+        MIOPEN_LOG_NQI("MIOPEN_FIND_SOLVERS_PARALLEL_LEVEL = " << threads);
+        return threads;
+    }();
+    return level;
+}
+
 std::ostream& operator<<(std::ostream& os, const FindMode& obj) { return os << obj.value; }
 
 static_assert(miopenConvolutionFindModeNormal ==
@@ -238,6 +268,9 @@ static_assert(miopenConvolutionFindModeFastHybrid ==
 static_assert(miopenConvolutionFindModeDynamicHybrid ==
                   static_cast<miopenConvolutionFindMode_t>(FindMode::Values::DynamicHybrid),
               "API is not in sync with the implementation.");
+static_assert(miopenConvolutionFindModeBudgeted ==
+                  static_cast<miopenConvolutionFindMode_t>(FindMode::Values::Budgeted),
+              "API is not in sync with the implementation.");
 static_assert(miopenConvolutionFindModeDefault ==
                   static_cast<miopenConvolutionFindMode_t>(FindMode::Values::Default_),
               "API is not in sync with the implementation.");
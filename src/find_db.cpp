@@ -30,9 +30,7 @@
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/perf_field.hpp>
-#if MIOPEN_EMBED_DB
-#include <miopen_data.hpp>
-#endif
+#include <miopen/embedded_db.hpp>
 #include <boost/filesystem.hpp>
 #include <string>
 #include <vector>
@@ -60,7 +58,7 @@ std::string FindDbRecord_t<TDb>::GetInstalledPathEmbed(Handle& handle)
         const auto suffix     = GetSystemFindDbSuffix();
         const auto filename   = base_name + "." + suffix + ext;
         const auto file_path  = root_path / filename;
-        if(miopen_data().find(filename + ".o") != miopen_data().end())
+        if(embedded::HasFile(filename))
         {
             MIOPEN_LOG_I2("Found exact embedded find database file:" << filename);
             return file_path.string();
@@ -69,9 +67,8 @@ std::string FindDbRecord_t<TDb>::GetInstalledPathEmbed(Handle& handle)
         {
             MIOPEN_LOG_I2("inexact find database search");
             std::vector<fs::path> all_files;
-            for(const auto& kinder : miopen_data())
+            for(const auto& fname : embedded::GetFileNames())
             {
-                const auto& fname    = kinder.first.substr(0, kinder.first.size() - 2);
                 const auto& filepath = root_path / fname;
                 if(EndsWith(fname, ".fdb.txt"))
                     all_files.push_back(filepath);
@@ -192,6 +189,9 @@ std::string FindDbRecord_t<TDb>::GetInstalledPathFile(Handle& handle)
 template <class TDb>
 std::string FindDbRecord_t<TDb>::GetInstalledPath(Handle& handle)
 {
+    // The shipped records are not known to be deterministic, so the mode only has user ones.
+    if(handle.IsDeterministic())
+        return "";
 #if !MIOPEN_DISABLE_SYSDB
 #if MIOPEN_EMBED_DB
     return GetInstalledPathEmbed(handle);
@@ -208,7 +208,9 @@ template <class TDb>
 std::string FindDbRecord_t<TDb>::GetUserPath(Handle& handle)
 {
 #if !MIOPEN_DISABLE_USERDB
-    return GetUserDbPath() + "/" + handle.GetDbBasename() + "." + GetUserDbSuffix() + ".ufdb.txt";
+    const auto mode = handle.IsDeterministic() ? ".det" : "";
+    return GetUserDbPath() + "/" + handle.GetDbBasename() + "." + GetUserDbSuffix() + mode +
+           ".ufdb.txt";
 #else
     (void)(handle);
     return "";
@@ -231,6 +233,54 @@ bool CheckInvokerSupport(const std::string& algo)
            algo == "miopenConvolutionBwdWeightsAlgoGEMM";
 }
 
+static constexpr char pareto_separator = '/';
+
+std::string MakeFindDbParetoId(const std::string& algorithm, const std::string& solver_id)
+{
+    return algorithm + pareto_separator + solver_id;
+}
+
+std::string GetFindDbAlgorithm(const std::string& id)
+{
+    return id.substr(0, id.find(pareto_separator));
+}
+
+template <class TDb>
+void FindDbRecord_t<TDb>::DropStale()
+{
+    if(!content)
+        return;
+
+    auto stale = std::vector<std::string>{};
+
+    for(const auto& pair : content->As<FindDbData>())
+    {
+        if(!pair.second.IsStale())
+            continue;
+        MIOPEN_LOG_I2("Find-db entry is stale: " << pair.first << ", solver version "
+                                                  << pair.second.solver_version);
+        stale.push_back(pair.first);
+    }
+
+    for(const auto& id : stale)
+        content->EraseValues(id);
+
+    has_stale = !stale.empty();
+    if(has_stale && content->GetSize() == 0)
+        content = boost::none;
+}
+
+template <class TDb>
+bool FindDbRecord_t<TDb>::IsProvisional() const
+{
+    if(!content)
+        return false;
+    for(const auto& pair : content->As<FindDbData>())
+        if(pair.second.provisional != 0)
+            return true;
+    return false;
+}
+
 template <class TDb>
 bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config) const
 {
@@ -241,7 +291,7 @@ bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config)
     {
         if(in_sync)
         {
-            if(CheckInvokerSupport(pair.first))
+            if(CheckInvokerSupport(GetFindDbAlgorithm(pair.first)))
             {
                 if(!handle.GetInvoker(config, {{pair.second.solver_id}}))
                 {
@@ -281,8 +331,10 @@ void FindDbRecord_t<TDb>::CopyTo(std::vector<PerfField>& to) const
 {
     const auto range = content->As<FindDbData>();
     std::transform(range.begin(), range.end(), std::back_inserter(to), [](const auto& pair) {
-        return PerfField{
-            pair.first, pair.second.solver_id, pair.second.time, pair.second.workspace};
+        return PerfField{GetFindDbAlgorithm(pair.first),
+                         pair.second.solver_id,
+                         pair.second.time,
+                         pair.second.workspace};
     });
 }
 
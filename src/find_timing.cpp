@@ -0,0 +1,179 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_timing.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_WARMUPS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_TRIALS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_TIME_STAT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_TIE_MARGIN)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_STABILIZE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_SETTLE_MS)
+
+namespace miopen {
+
+namespace {
+
+FindTimingConfig GetFindTimingConfigImpl()
+{
+    auto config    = FindTimingConfig{};
+    config.warmups = static_cast<int>(Value(MIOPEN_FIND_WARMUPS{}, config.warmups));
+    config.trials  = std::max(static_cast<int>(Value(MIOPEN_FIND_TRIALS{}, config.trials)), 1);
+
+    const char* const stat = GetStringEnv(MIOPEN_FIND_TIME_STAT{});
+    if(stat != nullptr)
+    {
+        std::string str = stat;
+        for(auto& c : str)
+            c = toupper(static_cast<unsigned char>(c));
+        if(str == "MEDIAN")
+            config.stat = FindTimingStat::Median;
+        else if(str == "TRIMMED_MEAN")
+            config.stat = FindTimingStat::TrimmedMean;
+        else
+            MIOPEN_LOG_NQE("Wrong MIOPEN_FIND_TIME_STAT, using MEDIAN.");
+    }
+
+    // In percents.
+    const char* const margin = GetStringEnv(MIOPEN_FIND_TIE_MARGIN{});
+    if(margin != nullptr)
+        config.margin = std::max(std::strtof(margin, nullptr), 0.0f) / 100.0f;
+
+    config.stabilize = IsEnabled(MIOPEN_FIND_STABILIZE{});
+    config.settle_ms = static_cast<int>(Value(MIOPEN_FIND_SETTLE_MS{}, config.settle_ms));
+
+    MIOPEN_LOG_NQI("Find timing: warmups = " << config.warmups << ", trials = " << config.trials
+                                             << ", trimmed mean = "
+                                             << (config.stat == FindTimingStat::TrimmedMean)
+                                             << ", tie margin = " << config.margin
+                                             << ", stabilize = " << config.stabilize
+                                             << ", settle ms = " << config.settle_ms);
+    return config;
+}
+
+float Quantile(const std::vector<float>& sorted, float p)
+{
+    const auto pos   = p * static_cast<float>(sorted.size() - 1);
+    const auto lower = static_cast<std::size_t>(pos);
+    const auto upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (pos - static_cast<float>(lower));
+}
+
+} // namespace
+
+const FindTimingConfig& GetFindTimingConfig()
+{
+    static const auto config = GetFindTimingConfigImpl();
+    return config;
+}
+
+FindTiming SummarizeFindTiming(std::vector<float> samples, FindTimingStat stat)
+{
+    auto timing = FindTiming{};
+    if(samples.empty())
+        return timing;
+
+    std::sort(samples.begin(), samples.end());
+    timing.trials = static_cast<int>(samples.size());
+
+    if(stat == FindTimingStat::TrimmedMean)
+    {
+        const auto trim = samples.size() / 4;
+        const auto kept = samples.size() - 2 * trim;
+        timing.time = std::accumulate(samples.begin() + trim, samples.end() - trim, 0.0f) /
+                      static_cast<float>(kept);
+    }
+    else
+    {
+        timing.time = Quantile(samples, 0.5f);
+    }
+
+    if(timing.time > 0.0f)
+        timing.spread = (Quantile(samples, 0.75f) - Quantile(samples, 0.25f)) / timing.time;
+    return timing;
+}
+
+int WarmUpUntilSettled(const std::function<float()>& run, const FindTimingConfig& config)
+{
+    if(!config.stabilize || config.settle_ms <= 0)
+        return 0;
+
+    // Medians of the windows, so that a single outlier neither settles nor unsettles it.
+    constexpr auto window = 4;
+    auto runs             = 0;
+    auto total            = 0.0f;
+    auto previous         = -1.0f;
+    auto samples          = std::vector<float>(window);
+
+    while(total < static_cast<float>(config.settle_ms))
+    {
+        for(auto& sample : samples)
+        {
+            sample = run();
+            total += sample;
+            ++runs;
+        }
+        const auto median = SummarizeFindTiming(samples, FindTimingStat::Median).time;
+        if(previous >= 0.0f && std::abs(median - previous) <= config.settle_tolerance * previous)
+        {
+            MIOPEN_LOG_I2("Clocks are settled after " << runs << " runs, " << median << " ms");
+            return runs;
+        }
+        previous = median;
+    }
+
+    MIOPEN_LOG_I2("Clocks are not settled after " << runs << " runs in " << total << " ms");
+    return runs;
+}
+
+float NormalizeFindTime(float time, std::size_t clock, std::size_t max_clock)
+{
+    if(clock == 0 || max_clock == 0)
+        return 0.0f;
+    return time * static_cast<float>(clock) / static_cast<float>(max_clock);
+}
+
+int CompareFindTiming(const FindTiming& lhs, const FindTiming& rhs, float margin)
+{
+    const auto tie = std::max({margin, lhs.spread, rhs.spread});
+    if(lhs.time < rhs.time * (1.0f - tie))
+        return -1;
+    if(rhs.time < lhs.time * (1.0f - tie))
+        return 1;
+    return 0;
+}
+
+} // namespace miopen
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/frozen_solution.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <ostream>
+#include <utility>
+
+namespace miopen {
+
+FrozenSolution::FrozenSolution(Invoker invoker_,
+                               AnyInvokeParams params_,
+                               miopenProblemDirection_t direction_,
+                               bool transposed_,
+                               std::size_t workspace_size_,
+                               bool prepares_weights_)
+    : invoker(std::move(invoker_)),
+      params(std::move(params_)),
+      direction(direction_),
+      transposed(transposed_),
+      workspace_size(workspace_size_),
+      prepares_weights(prepares_weights_)
+{
+}
+
+bool FrozenSolution::PrepareWeights(const Handle& handle,
+                                    ConstData_t w,
+                                    Data_t workspace,
+                                    std::size_t workspace_size_)
+{
+    if(w == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+    if(direction == miopenProblemDirectionBackwardWeights)
+        MIOPEN_THROW(miopenStatusBadParm, "The weights are the output of the solution");
+    if(!prepares_weights)
+        return false;
+    if(workspace_size_ < workspace_size)
+        MIOPEN_THROW(miopenStatusBadParm, "Workspace is too small for the solution");
+
+    // A new buffer, as the invokers only fill the empty ones.
+    auto prepared                    = std::make_shared<conv::PreparedWeights>();
+    auto& data_params                = params.CastTo<conv::DataInvokeParams>();
+    data_params.tensors.in           = nullptr;
+    data_params.tensors.w            = w;
+    data_params.tensors.out          = nullptr;
+    data_params.workSpace            = workspace;
+    data_params.workSpaceSize        = workspace_size_;
+    data_params.prepared_weights     = prepared.get();
+    data_params.prepare_weights_only = true;
+    invoker(handle, params);
+    data_params.prepare_weights_only = false;
+
+    prepared_weights = std::move(prepared);
+    MIOPEN_LOG_I2("Prepared the weights of " << *this);
+    return true;
+}
+
+void FrozenSolution::Run(const Handle& handle,
+                         Data_t x,
+                         Data_t w,
+                         Data_t y,
+                         Data_t workspace,
+                         std::size_t workspace_size_)
+{
+    if(x == nullptr || (w == nullptr && prepared_weights == nullptr) || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+    if(workspace_size_ < workspace_size)
+        MIOPEN_THROW(miopenStatusBadParm, "Workspace is too small for the solution");
+    if(transposed)
+        std::swap(x, y);
+
+    switch(direction)
+    {
+    case miopenProblemDirectionForward:
+    case miopenProblemDirectionBackward: {
+        auto& data_params            = params.CastTo<conv::DataInvokeParams>();
+        const auto forward           = direction == miopenProblemDirectionForward;
+        data_params.tensors.in       = forward ? x : y;
+        data_params.tensors.w        = w;
+        data_params.tensors.out      = forward ? y : x;
+        data_params.workSpace        = workspace;
+        data_params.workSpaceSize    = workspace_size_;
+        data_params.prepared_weights = prepared_weights.get();
+        break;
+    }
+    case miopenProblemDirectionBackwardWeights: {
+        auto& wrw_params         = params.CastTo<conv::WrWInvokeParams>();
+        wrw_params.tensors.dy    = y;
+        wrw_params.tensors.x     = x;
+        wrw_params.tensors.dw    = w;
+        wrw_params.workSpace     = workspace;
+        wrw_params.workSpaceSize = workspace_size_;
+        break;
+    }
+    }
+
+    invoker(handle, params);
+}
+
+std::ostream& operator<<(std::ostream& stream, const FrozenSolution& frozen)
+{
+    stream << frozen.direction << ", " << frozen.workspace_size << " bytes";
+    if(frozen.prepared_weights != nullptr)
+        stream << ", prepared weights";
+    return stream;
+}
+
+} // namespace miopen
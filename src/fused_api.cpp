@@ -123,6 +123,15 @@ miopenFusionPlanConvolutionSetAlgo(miopenFusionPlanDescriptor_t fusePlanDesc,
     return res;
 }
 
+extern "C" miopenStatus_t
+miopenFusionPlanSetConstantFolding(miopenFusionPlanDescriptor_t fusePlanDesc, bool enable)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, enable);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] { res = miopen::deref(fusePlanDesc).SetConstantFolding(enable); });
+    return res;
+}
+
 // Create convolution ops with unknown algorithms
 extern "C" miopenStatus_t miopenCreateOpConvForward(miopenFusionPlanDescriptor_t fusePlanDesc,
                                                     miopenFusionOpDescriptor_t* convOp,
@@ -184,6 +193,64 @@ extern "C" miopenStatus_t miopenCreateOpBiasForward(miopenFusionPlanDescriptor_t
     return res;
 }
 
+extern "C" miopenStatus_t miopenCreateOpTensorForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                      miopenFusionOpDescriptor_t* tensorOp,
+                                                      miopenTensorOp_t tensorOpType,
+                                                      const miopenTensorDescriptor_t bDesc)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, tensorOp, tensorOpType, bDesc);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] {
+        auto tod = std::make_shared<miopen::TensorFwdFusionOpDescriptor>(tensorOpType,
+                                                                         miopen::deref(bDesc));
+        miopen::deref(tensorOp) = tod.get();
+        res                     = miopen::deref(fusePlanDesc).AddOp(tod);
+    });
+    return res;
+}
+
+extern "C" miopenStatus_t miopenCreateOpScaleForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                     miopenFusionOpDescriptor_t* scaleOp)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, scaleOp);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] {
+        auto sod               = std::make_shared<miopen::ScaleFwdFusionOpDescriptor>();
+        miopen::deref(scaleOp) = sod.get();
+        res                    = miopen::deref(fusePlanDesc).AddOp(sod);
+    });
+    return res;
+}
+
+extern "C" miopenStatus_t miopenCreateOpPoolingForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                       miopenFusionOpDescriptor_t* poolOp,
+                                                       const miopenPoolingDescriptor_t poolDesc)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, poolOp, poolDesc);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] {
+        auto pod =
+            std::make_shared<miopen::PoolingFwdFusionOpDescriptor>(miopen::deref(poolDesc));
+        miopen::deref(poolOp) = pod.get();
+        res                   = miopen::deref(fusePlanDesc).AddOp(pod);
+    });
+    return res;
+}
+
+extern "C" miopenStatus_t miopenCreateOpBiasBackward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                                                     miopenFusionOpDescriptor_t* biasBwdOp,
+                                                     const miopenTensorDescriptor_t dbDesc)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, biasBwdOp, dbDesc);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] {
+        auto bod = std::make_shared<miopen::BiasBwdFusionOpDescriptor>(miopen::deref(dbDesc));
+        miopen::deref(biasBwdOp) = bod.get();
+        res                      = miopen::deref(fusePlanDesc).AddOp(bod);
+    });
+    return res;
+}
+
 // Batch normalization create op
 extern "C" miopenStatus_t
 miopenCreateOpBatchNormInference(miopenFusionPlanDescriptor_t fusePlanDesc,
@@ -272,6 +339,56 @@ extern "C" miopenStatus_t miopenSetOpArgsBiasForward(miopenOperatorArgs_t args,
     });
 }
 
+extern "C" miopenStatus_t miopenSetOpArgsTensorForward(miopenOperatorArgs_t args,
+                                                       const miopenFusionOpDescriptor_t tensorOp,
+                                                       const void* alpha1,
+                                                       const void* alpha2,
+                                                       const void* B)
+{
+    MIOPEN_LOG_FUNCTION(args, tensorOp, alpha1, alpha2, B);
+    return miopen::try_([&] {
+        auto&& op = dynamic_cast<miopen::TensorFwdFusionOpDescriptor&>(miopen::deref(tensorOp));
+        op.SetArgs(miopen::deref(args), alpha1, alpha2, DataCast(B));
+    });
+}
+
+extern "C" miopenStatus_t miopenSetOpArgsScaleForward(miopenOperatorArgs_t args,
+                                                      const miopenFusionOpDescriptor_t scaleOp,
+                                                      const void* alpha)
+{
+    MIOPEN_LOG_FUNCTION(args, scaleOp, alpha);
+    return miopen::try_([&] {
+        auto&& op = dynamic_cast<miopen::ScaleFwdFusionOpDescriptor&>(miopen::deref(scaleOp));
+        op.SetArgs(miopen::deref(args), alpha);
+    });
+}
+
+extern "C" miopenStatus_t miopenSetOpArgsPoolingForward(miopenOperatorArgs_t args,
+                                                        const miopenFusionOpDescriptor_t poolOp,
+                                                        const void* alpha,
+                                                        const void* beta,
+                                                        void* workSpace)
+{
+    MIOPEN_LOG_FUNCTION(args, poolOp, alpha, beta, workSpace);
+    return miopen::try_([&] {
+        auto&& op = dynamic_cast<miopen::PoolingFwdFusionOpDescriptor&>(miopen::deref(poolOp));
+        op.SetArgs(miopen::deref(args), alpha, beta, DataCast(workSpace));
+    });
+}
+
+extern "C" miopenStatus_t miopenSetOpArgsBiasBackward(miopenOperatorArgs_t args,
+                                                      const miopenFusionOpDescriptor_t biasBwdOp,
+                                                      const void* alpha,
+                                                      const void* beta,
+                                                      void* dbias)
+{
+    MIOPEN_LOG_FUNCTION(args, biasBwdOp, alpha, beta, dbias);
+    return miopen::try_([&] {
+        auto&& op = dynamic_cast<miopen::BiasBwdFusionOpDescriptor&>(miopen::deref(biasBwdOp));
+        op.SetArgs(miopen::deref(args), alpha, beta, DataCast(dbias));
+    });
+}
+
 extern "C" miopenStatus_t miopenSetOpArgsActivForward(miopenOperatorArgs_t args,
                                                       const miopenFusionOpDescriptor_t activFwdOp,
                                                       const void* alpha,
@@ -293,19 +410,19 @@ extern "C" miopenStatus_t miopenSetOpArgsActivBackward(miopenOperatorArgs_t args
                                                        const void* alpha,
                                                        const void* beta,
                                                        const void* y,
-                                                       const void* /*reserved*/,
+                                                       const void* x,
                                                        double activAlpha,
                                                        double activBeta,
                                                        double activGamma)
 {
-    MIOPEN_LOG_FUNCTION(args, activBwdOp, alpha, beta, y, activAlpha, activBeta, activGamma);
+    MIOPEN_LOG_FUNCTION(args, activBwdOp, alpha, beta, y, x, activAlpha, activBeta, activGamma);
     return miopen::try_([&] {
         auto&& op = dynamic_cast<miopen::ActivBwdFusionOpDescriptor&>(miopen::deref(activBwdOp));
         op.SetArgs(miopen::deref(args),
                    alpha,
                    beta,
                    DataCast(y),
-                   nullptr,
+                   DataCast(x),
                    activAlpha,
                    activBeta,
                    activGamma);
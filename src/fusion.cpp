@@ -31,14 +31,105 @@
 #include <miopen/handle.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/stringutils.hpp>
+#include <miopen/env.hpp>
+#include <miopen/db.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/find_timing.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/serializable.hpp>
 #include <ostream>
 #include <ios>
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <half.hpp>
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_FUSION_PLAN_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_FUSION_PLANS)
+
+namespace {
+
+/// Find-db key of a plan, see FusionPlanDescriptor::FindPlan.
+struct FusionPlanFindKey
+{
+    std::string key;
+    void Serialize(std::ostream& stream) const { stream << key; }
+};
+
+/// The faster way to run a plan: "graph" for the fused kernels of the metadata graph or the
+/// name of the pattern.
+struct FusionPlanFindData : solver::Serializable<FusionPlanFindData>
+{
+    std::string path;
+    float time = 0.0f;
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.path, "path");
+        f(self.time, "time");
+    }
+};
+
+const char* const fusion_find_id = "fusion_plan";
+
+bool IsFusionFindDbEnabled(const std::string& path)
+{
+    return !path.empty() && testing_find_db_enabled && !IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{});
+}
+
+/// What the compilation of a plan of the metadata graph found, for the identical plans which
+/// are compiled later, maybe with another handle or in another thread.
+struct FusionPlanRecipe
+{
+    std::size_t vertex_idx;
+    std::string algorithm_name;
+    std::string program_name;
+    std::string kernel_name;
+    std::string compile_config;
+    FusionKernelSourceType kernel_source_type;
+    std::vector<size_t> vld;
+    std::vector<size_t> vgd;
+    std::vector<Exec_arg_t> arg_list;
+};
+
+class FusionPlanCache
+{
+    public:
+    static boost::optional<FusionPlanRecipe> Find(const std::string& signature)
+    {
+        auto& cache = Get();
+        const std::lock_guard<std::mutex> lock(cache.mutex);
+        const auto it = cache.recipes.find(signature);
+        if(it == cache.recipes.end())
+            return boost::none;
+        return it->second;
+    }
+
+    static void Insert(const std::string& signature, FusionPlanRecipe recipe)
+    {
+        auto& cache = Get();
+        const std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.recipes.emplace(signature, std::move(recipe));
+    }
+
+    private:
+    std::mutex mutex;
+    std::unordered_map<std::string, FusionPlanRecipe> recipes;
+
+    static FusionPlanCache& Get()
+    {
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static FusionPlanCache cache;
+        return cache;
+    }
+};
+
+} // namespace
+
 FusionPlanDescriptor::FusionPlanDescriptor(const miopenFusionDirection_t dir,
                                            const TensorDescriptor& inDesc)
     : fusion_dir(dir),
@@ -56,12 +147,27 @@ FusionPlanDescriptor::FusionPlanDescriptor(const miopenFusionDirection_t dir,
 
 FusionPlanDescriptor::~FusionPlanDescriptor() { op_map.clear(); }
 
+static bool IsDefaultLayout(const TensorDescriptor& desc)
+{
+    return desc.GetSize() != 4 || desc.GetLayout("NCHW") == "NCHW";
+}
+
+static bool IsGraphFirstOp(miopenFusionOp_t op)
+{
+    return op == miopenFusionOpConvForward || op == miopenFusionOpBatchNormInference ||
+           op == miopenFusionOpBatchNormFwdTrain || op == miopenFusionOpBatchNormBwdTrain;
+}
+
 miopenStatus_t FusionPlanDescriptor::AddOp(std::shared_ptr<FusionOpDescriptor> desc)
 {
     // load the md graph for the first op
     if(op_count == 0)
     {
-        FusionMDGraph::Init(lu, desc->kind());
+        // The kernels of the graph expect NCHW tensors. The plans which the graph cannot start
+        // may still match a pattern.
+        graph_valid = IsDefaultLayout(input_desc) && IsGraphFirstOp(desc->kind());
+        if(graph_valid)
+            FusionMDGraph::Init(lu, desc->kind());
     }
     desc->SetIdx(op_count);
     if(op_map.empty())
@@ -71,24 +177,29 @@ miopenStatus_t FusionPlanDescriptor::AddOp(std::shared_ptr<FusionOpDescriptor> d
     desc->GetOutputDesc(output_desc);
     op_map.emplace_back(desc);
     op_count++;
-    is_valid = false;
-    miopen::try_([&] {
-        is_valid = lu.Advance(desc, [&](const std::string& sym, int& val) -> bool {
-            // check tensor attr
-            if(GetTensorAttr(sym, val))
-                return true;
-            // check op attr
-            if(desc->GetOpAttr(sym, val))
-                return true;
-            // check the values of enum types
-            if(GetEnumVal(sym, val))
-                return true;
-            // check dev attr
-            // if(GetDevAttribute(sym, val, handle))
-            //     return true;
-            return false;
+    pattern = FindFusionPattern(GetPatternProblem());
+    if(graph_valid)
+    {
+        graph_valid = false;
+        miopen::try_([&] {
+            graph_valid = lu.Advance(desc, [&](const std::string& sym, int& val) -> bool {
+                // check tensor attr
+                if(GetTensorAttr(sym, val))
+                    return true;
+                // check op attr
+                if(desc->GetOpAttr(sym, val))
+                    return true;
+                // check the values of enum types
+                if(GetEnumVal(sym, val))
+                    return true;
+                // check dev attr
+                // if(GetDevAttribute(sym, val, handle))
+                //     return true;
+                return false;
+            });
         });
-    });
+    }
+    is_valid = graph_valid || pattern != nullptr;
     if(is_valid)
         return miopenStatusSuccess;
     else
@@ -156,7 +267,14 @@ miopenStatus_t FusionPlanDescriptor::GetConvAlgos(int reqAlgoCount,
                                                   int& retAlgoCount,
                                                   miopenConvFwdAlgorithm_t* ptrAlgos)
 {
-    auto algos   = lu.GetConvAlgos();
+    // The patterns run any convolution solution.
+    auto algos = graph_valid ? lu.GetConvAlgos()
+                             : std::vector<miopenConvFwdAlgorithm_t>{
+                                   miopenConvolutionFwdAlgoImplicitGEMM,
+                                   miopenConvolutionFwdAlgoDirect,
+                                   miopenConvolutionFwdAlgoWinograd,
+                                   miopenConvolutionFwdAlgoGEMM,
+                               };
     retAlgoCount = std::min(reqAlgoCount, static_cast<int>(algos.size()));
 
     for(auto idx = 0; idx < retAlgoCount; idx++)
@@ -169,14 +287,38 @@ miopenStatus_t FusionPlanDescriptor::GetConvAlgos(int reqAlgoCount,
 
 miopenStatus_t FusionPlanDescriptor::SetConvAlgo(miopenConvFwdAlgorithm_t algo)
 {
+    conv_algo = algo;
+    if(!graph_valid)
+        return pattern != nullptr ? miopenStatusSuccess : miopenStatusUnknownError;
+
     bool res = lu.SetConvAlgo(algo);
 
     if(res)
         return miopenStatusSuccess;
+    // The graph has no kernel for the algorithm, fall back to the pattern.
+    graph_valid = false;
+    is_valid    = pattern != nullptr;
+    if(is_valid)
+        return miopenStatusSuccess;
     else
         return miopenStatusUnknownError;
 }
 
+miopenStatus_t FusionPlanDescriptor::SetConstantFolding(bool enable)
+{
+    constant_folding = enable;
+    if(op_count == 0)
+        return miopenStatusSuccess;
+    pattern  = FindFusionPattern(GetPatternProblem());
+    is_valid = graph_valid || pattern != nullptr;
+    return is_valid ? miopenStatusSuccess : miopenStatusUnsupportedOp;
+}
+
+FusionPatternProblem FusionPlanDescriptor::GetPatternProblem() const
+{
+    return FusionPatternProblem{input_desc, output_desc, op_map, conv_algo, constant_folding};
+}
+
 std::ostream& operator<<(std::ostream& stream, const FusionPlanDescriptor& fpd)
 {
     stream << "kernel_name: " << fpd.kernel_name;
@@ -315,7 +457,8 @@ miopenStatus_t ActivFwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
                                                    double activGamma)
 {
     auto id = std::to_string(GetIdx());
-    if(input_desc.GetType() == miopenFloat)
+    // The bfloat16 kernels take the activation arguments as float.
+    if(input_desc.GetType() == miopenFloat || input_desc.GetType() == miopenBFloat16)
     {
         args.ins_arg("activAlpha" + id, OpKernelArg(static_cast<float>(activAlpha)));
         args.ins_arg("activBeta" + id, OpKernelArg(static_cast<float>(activBeta)));
@@ -345,7 +488,7 @@ std::vector<std::pair<std::string, OpKernelArg>> ActivFwdFusionOpDescriptor::Get
 {
     std::vector<std::pair<std::string, OpKernelArg>> keys;
     auto id = std::to_string(GetIdx());
-    if(input_desc.GetType() == miopenFloat)
+    if(input_desc.GetType() == miopenFloat || input_desc.GetType() == miopenBFloat16)
     {
         float a = 0.0;
         keys.emplace_back("activAlpha" + id, OpKernelArg(a));
@@ -768,6 +911,154 @@ std::vector<std::pair<std::string, OpKernelArg>> BiasFusionOpDescriptor::GetArgs
     return keys;
 }
 
+// Tensor op forward
+miopenStatus_t TensorFwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
+{
+    const auto& lens   = input_desc.GetLengths();
+    const auto& b_lens = base_desc.GetLengths();
+    if(b_lens.size() != lens.size() || base_desc.GetType() != input_desc.GetType())
+        MIOPEN_THROW(miopenStatusBadParm, "The tensor of the op does not match its input");
+    for(std::size_t i = 0; i < lens.size(); ++i)
+    {
+        if(b_lens[i] != 1 && b_lens[i] != lens[i])
+            MIOPEN_THROW(miopenStatusBadParm, "The tensor of the op does not broadcast");
+    }
+    output_desc = input_desc;
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t TensorFwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
+                                                    const void* alpha1,
+                                                    const void* alpha2,
+                                                    ConstData_t b)
+{
+    auto id = std::to_string(GetIdx());
+    args.ins_arg("tensorAlpha1" + id, OpKernelArg(*static_cast<const float*>(alpha1)));
+    args.ins_arg("tensorAlpha2" + id, OpKernelArg(*static_cast<const float*>(alpha2)));
+    args.ins_arg("tensorB" + id, OpKernelArg(b));
+    return miopenStatusSuccess;
+}
+
+std::string TensorFwdFusionOpDescriptor::GetArgKey(const std::string& k) const
+{
+    return k + std::to_string(GetIdx());
+}
+
+OpKernelArg TensorFwdFusionOpDescriptor::GetOpAttr(const std::string& /* k */) const
+{
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown Tensor Op Attribute");
+}
+
+std::vector<std::pair<std::string, OpKernelArg>> TensorFwdFusionOpDescriptor::GetArgs() const
+{
+    auto id        = std::to_string(GetIdx());
+    ConstData_t cd = nullptr;
+    std::vector<std::pair<std::string, OpKernelArg>> keys;
+    keys.emplace_back("tensorAlpha1" + id, OpKernelArg(static_cast<float>(0.0f)));
+    keys.emplace_back("tensorAlpha2" + id, OpKernelArg(static_cast<float>(0.0f)));
+    keys.emplace_back("tensorB" + id, OpKernelArg(cd));
+    return keys;
+}
+
+// Scale forward
+miopenStatus_t ScaleFwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
+{
+    output_desc = input_desc;
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t ScaleFwdFusionOpDescriptor::SetArgs(OperatorArgs& args, const void* alpha)
+{
+    args.ins_arg("scaleAlpha" + std::to_string(GetIdx()),
+                 OpKernelArg(*static_cast<const float*>(alpha)));
+    return miopenStatusSuccess;
+}
+
+std::string ScaleFwdFusionOpDescriptor::GetArgKey(const std::string& k) const
+{
+    return k + std::to_string(GetIdx());
+}
+
+OpKernelArg ScaleFwdFusionOpDescriptor::GetOpAttr(const std::string& /* k */) const
+{
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown Scale Op Attribute");
+}
+
+std::vector<std::pair<std::string, OpKernelArg>> ScaleFwdFusionOpDescriptor::GetArgs() const
+{
+    std::vector<std::pair<std::string, OpKernelArg>> keys;
+    keys.emplace_back("scaleAlpha" + std::to_string(GetIdx()),
+                      OpKernelArg(static_cast<float>(0.0f)));
+    return keys;
+}
+
+// Pooling forward
+miopenStatus_t PoolingFwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
+{
+    return miopen::try_([&]() { output_desc = base_desc.GetForwardOutputTensor(input_desc); });
+}
+
+miopenStatus_t PoolingFwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
+                                                     const void* /*alpha*/,
+                                                     const void* /*beta*/,
+                                                     Data_t workSpace)
+{
+    args.ins_arg("poolWorkspace" + std::to_string(GetIdx()), OpKernelArg(workSpace));
+    return miopenStatusSuccess;
+}
+
+std::string PoolingFwdFusionOpDescriptor::GetArgKey(const std::string& k) const
+{
+    return k + std::to_string(GetIdx());
+}
+
+OpKernelArg PoolingFwdFusionOpDescriptor::GetOpAttr(const std::string& /* k */) const
+{
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown Pooling Op Attribute");
+}
+
+std::vector<std::pair<std::string, OpKernelArg>> PoolingFwdFusionOpDescriptor::GetArgs() const
+{
+    Data_t workspace = nullptr;
+    std::vector<std::pair<std::string, OpKernelArg>> keys;
+    keys.emplace_back("poolWorkspace" + std::to_string(GetIdx()), OpKernelArg(workspace));
+    return keys;
+}
+
+// Bias backward
+miopenStatus_t BiasBwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
+{
+    output_desc = input_desc;
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t BiasBwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
+                                                  const void* /*alpha*/,
+                                                  const void* /*beta*/,
+                                                  Data_t dbias)
+{
+    args.ins_arg("dbias" + std::to_string(GetIdx()), OpKernelArg(dbias));
+    return miopenStatusSuccess;
+}
+
+std::string BiasBwdFusionOpDescriptor::GetArgKey(const std::string& k) const
+{
+    return k + std::to_string(GetIdx());
+}
+
+OpKernelArg BiasBwdFusionOpDescriptor::GetOpAttr(const std::string& /* k */) const
+{
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown Bias Backward Op Attribute");
+}
+
+std::vector<std::pair<std::string, OpKernelArg>> BiasBwdFusionOpDescriptor::GetArgs() const
+{
+    Data_t dbias = nullptr;
+    std::vector<std::pair<std::string, OpKernelArg>> keys;
+    keys.emplace_back("dbias" + std::to_string(GetIdx()), OpKernelArg(dbias));
+    return keys;
+}
+
 static inline void
 find_replace_first(std::string& s_where, const std::string& s_find, const std::string& s_replace)
 {
@@ -978,14 +1269,95 @@ OpKernelArg FusionPlanDescriptor::GetDevAttribute(const std::string& k, const Ha
 
 miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
 {
-    miopenStatus_t status = miopenStatusUnknownError;
-    if(!isValid() || (lu.GetCurVertex(handle) == nullptr))
+    if(!isValid())
     {
-        MIOPEN_LOG_I2(
-            "A previous attempt to add an operator unsuccessful or the GPU architecture is not "
-            "supported for the fusion plan");
+        MIOPEN_LOG_I2("A previous attempt to add an operator unsuccessful for the fusion plan");
         MIOPEN_THROW(miopenStatusBadParm);
     }
+
+    // The fused kernels of the graph come first, unless the pattern is faster, e.g. as it folds
+    // ops away. The patterns cover the plans which the graph does not, or not on this GPU
+    // architecture.
+    pattern_invoker            = {};
+    find_pattern_invoker       = boost::none;
+    const auto graph_available = graph_valid && lu.GetCurVertex(handle) != nullptr;
+    const auto compile_pattern = [&]() {
+        MIOPEN_LOG_I2("Compiling the fusion plan with " << pattern->Name());
+        auto invoker = pattern->Compile(handle, GetPatternProblem());
+        if(invoker)
+            pattern_invoker = *invoker;
+        return invoker.is_initialized();
+    };
+    if(graph_available && pattern != nullptr)
+    {
+        // The find of the plan measures which of the two is faster, see FindPlan().
+        find_key     = "fusion-" + md5(GetSignature(handle) + pattern->Name() +
+                                       (constant_folding ? "fold" : ""));
+        find_db_path = UserFindDbRecord::GetUserPath(handle);
+
+        auto prefer_pattern = pattern->IsPreferredOverGraph();
+        auto found          = FusionPlanFindData{};
+        if(IsFusionFindDbEnabled(find_db_path) &&
+           PlainTextDb{find_db_path}.Load(FusionPlanFindKey{find_key}, fusion_find_id, found))
+        {
+            MIOPEN_LOG_I2("Fusion plan found in the find-db: " << found.path);
+            prefer_pattern = found.path == pattern->Name();
+        }
+        else if(IsEnabled(MIOPEN_FIND_FUSION_PLANS{}) &&
+                // Each run of a training batch normalization updates the running averages.
+                std::none_of(op_map.begin(), op_map.end(), [](const auto& op) {
+                    return op->kind() == miopenFusionOpBatchNormFwdTrain;
+                }))
+        {
+            // The solvers of the fused kernels search their performance configs.
+            const auto set_tuning = [&](bool enable) {
+                for(auto&& op : op_map)
+                    if(op->kind() == miopenFusionOpConvForward)
+                        dynamic_cast<ConvForwardOpDescriptor&>(*op).tune = enable;
+            };
+            set_tuning(true);
+            const auto status = CompileMDGraph(handle);
+            set_tuning(false);
+            const auto pattern_compiled = compile_pattern();
+            if(status == miopenStatusSuccess && pattern_compiled)
+            {
+                find_pattern_invoker = pattern_invoker;
+                pattern_invoker      = {};
+            }
+            if(status == miopenStatusSuccess || pattern_compiled)
+                return miopenStatusSuccess;
+            MIOPEN_LOG_I("No viable kernel found to execute the fusion plan");
+            return miopenStatusInternalError;
+        }
+        if(prefer_pattern)
+        {
+            if(compile_pattern())
+                return miopenStatusSuccess;
+            return CompileMDGraph(handle);
+        }
+    }
+    if(graph_available)
+    {
+        const auto status = CompileMDGraph(handle);
+        if(status == miopenStatusSuccess || pattern == nullptr)
+            return status;
+    }
+    if(pattern == nullptr)
+    {
+        MIOPEN_LOG_I2("The GPU architecture is not supported for the fusion plan");
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    if(!compile_pattern())
+    {
+        MIOPEN_LOG_I("No viable kernel found to execute the fusion plan");
+        return miopenStatusInternalError;
+    }
+    return miopenStatusSuccess;
+}
+
+std::string FusionPlanDescriptor::GetSignature(Handle& handle)
+{
     network_config =
         input_desc.ToString() + ((input_desc.GetType() == miopenHalf) ? "FP16" : "FP32");
     network_config +=
@@ -995,6 +1367,47 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
     {
         op->GetNetworkConfig(network_config, handle);
     }
+
+    // The network config covers the tensors and the attributes of the ops. The graph
+    // traversal also depends on the device and on the requested convolution algorithm.
+    auto signature = network_config + handle.GetDeviceName() + "cu" +
+                     std::to_string(handle.GetMaxComputeUnits()) + "algo" +
+                     (conv_algo ? std::to_string(*conv_algo) : "");
+    for(auto&& op : op_map)
+        signature += "op" + std::to_string(op->kind());
+    return signature;
+}
+
+miopenStatus_t FusionPlanDescriptor::CompileMDGraph(Handle& handle)
+{
+    miopenStatus_t status = miopenStatusUnknownError;
+    const auto signature  = GetSignature(handle);
+    const auto use_cache  = !miopen::IsEnabled(MIOPEN_DEBUG_DISABLE_FUSION_PLAN_CACHE{});
+    if(use_cache)
+    {
+        const auto recipe = FusionPlanCache::Find(signature);
+        if(recipe && recipe->vertex_idx < lu.cur_vertex.size())
+        {
+            MIOPEN_LOG_I2("Fusion plan found in the cache: " << recipe->kernel_name);
+            lu.cur_vertex      = {lu.cur_vertex[recipe->vertex_idx]};
+            algorithm_name     = recipe->algorithm_name;
+            program_name       = recipe->program_name;
+            kernel_name        = recipe->kernel_name;
+            kernel_source_type = recipe->kernel_source_type;
+            if(handle.GetKernels(algorithm_name, network_config).empty())
+                handle.AddKernel(algorithm_name,
+                                 network_config,
+                                 program_name,
+                                 kernel_name,
+                                 recipe->vld,
+                                 recipe->vgd,
+                                 recipe->compile_config);
+            arg_list    = recipe->arg_list;
+            packed_args = {};
+            return miopenStatusSuccess;
+        }
+    }
+
     // Check if the kernel is assembly or OpenCL
     auto ops_head  = op_map[0];
     algorithm_name = lu.GetAlgoName(handle);
@@ -1027,8 +1440,10 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
         auto success = true;
         // lu.cur_vertex is sorted according to the weights from MDGraph::Advance method
         std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> new_list;
-        for(auto& kinder : lu.cur_vertex)
+        auto vertex_idx = std::size_t{0};
+        for(; vertex_idx < lu.cur_vertex.size(); ++vertex_idx)
         {
+            auto& kinder = lu.cur_vertex[vertex_idx];
             if(kinder.first == nullptr)
             {
                 MIOPEN_LOG_I2("Invalid FusionPlan");
@@ -1119,6 +1534,20 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
                                  compile_config);
 
                 status = miopenStatusSuccess;
+                if(use_cache)
+                {
+                    arg_list = CalcArgOrder(handle);
+                    FusionPlanCache::Insert(signature,
+                                            {vertex_idx,
+                                             algorithm_name,
+                                             program_name,
+                                             kernel_name,
+                                             compile_config,
+                                             kernel_source_type,
+                                             vld,
+                                             vgd,
+                                             arg_list});
+                }
             }
         }
         else
@@ -1129,6 +1558,7 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
         }
     }
     arg_list = CalcArgOrder(handle);
+    packed_args = {};
     return status;
 }
 
@@ -1305,7 +1735,7 @@ miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
                                              Data_t output,
                                              const OperatorArgs& op_args)
 {
-    if(!isValid() || (lu.GetCurVertex(handle) == nullptr))
+    if(!isValid() || (!pattern_invoker && lu.GetCurVertex(handle) == nullptr))
     {
         MIOPEN_THROW(miopenStatusBadParm, "Attempting to execute an invalid fusion plan.");
     }
@@ -1319,6 +1749,63 @@ miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "The input descriptors dont match.");
     }
 
+    if(find_pattern_invoker)
+        FindPlan(handle, input, output, op_args);
+
+    if(pattern_invoker)
+    {
+        pattern_invoker(handle, input, output, op_args);
+        return miopenStatusSuccess;
+    }
+    return ExecuteMDGraph(handle, input, output, op_args);
+}
+
+void FusionPlanDescriptor::FindPlan(const Handle& handle,
+                                    ConstData_t input,
+                                    Data_t output,
+                                    const OperatorArgs& op_args)
+{
+    const auto pattern_run = *find_pattern_invoker;
+    find_pattern_invoker   = boost::none;
+
+    const auto& config = GetFindTimingConfig();
+    const AutoEnableProfiling enable_profiling{handle};
+    const auto measure = [&](const std::function<void()>& run) {
+        for(auto i = 0; i < config.warmups; ++i)
+            run();
+        auto samples = std::vector<float>{};
+        for(auto i = 0; i < config.trials; ++i)
+        {
+            handle.ResetKernelTime();
+            run();
+            samples.push_back(handle.GetKernelTime());
+        }
+        return SummarizeFindTiming(std::move(samples), config.stat);
+    };
+
+    const auto graph_timing   = measure([&]() { ExecuteMDGraph(handle, input, output, op_args); });
+    const auto pattern_timing = measure([&]() { pattern_run(handle, input, output, op_args); });
+    // A tie goes to the fused kernel, which keeps the intermediate results out of memory.
+    const auto use_pattern = CompareFindTiming(pattern_timing, graph_timing, config.margin) < 0;
+    MIOPEN_LOG_I("Fusion plan find: graph " << graph_timing.time << " ms, " << pattern->Name()
+                                            << " " << pattern_timing.time << " ms");
+    if(use_pattern)
+        pattern_invoker = pattern_run;
+
+    if(!IsFusionFindDbEnabled(find_db_path))
+        return;
+    auto data = FusionPlanFindData{};
+    data.path = use_pattern ? pattern->Name() : "graph";
+    data.time = use_pattern ? pattern_timing.time : graph_timing.time;
+    if(!PlainTextDb{find_db_path}.Update(FusionPlanFindKey{find_key}, fusion_find_id, data))
+        MIOPEN_LOG_E("Failed to store record to find-db at <" << find_db_path << ">");
+}
+
+miopenStatus_t FusionPlanDescriptor::ExecuteMDGraph(const Handle& handle,
+                                                    ConstData_t input,
+                                                    Data_t output,
+                                                    const OperatorArgs& op_args)
+{
     auto ops_head = op_map[0];
 
     auto&& kernels = handle.GetKernels(algorithm_name, network_config);
@@ -1329,40 +1816,60 @@ miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
     }
     KernelInvoke kernel = kernels.front();
 
-    std::vector<OpKernelArg> args;
     if(arg_list.empty())
     {
         MIOPEN_THROW("Kernel arguments not setup properly");
     }
-    for(auto& arg : arg_list)
+
+    const auto get_op_arg = [&](const Exec_arg_t& arg) -> const OpKernelArg& {
+        auto it = op_args.args_map.find(arg.key);
+        if(it == op_args.args_map.end())
+            MIOPEN_THROW(miopenStatusInternalError, "Argument Not Set: " + arg.key);
+        return it->second;
+    };
+
+    if(packed_args.GetCount() != arg_list.size())
     {
-        MIOPEN_LOG_I2("Key: " + arg.key);
-        switch(arg.type)
+        std::vector<OpKernelArg> args;
+        for(auto& arg : arg_list)
         {
-        case Input_Ptr: args.emplace_back(OpKernelArg(input)); break;
-        case Output_Ptr: args.emplace_back(OpKernelArg(output)); break;
-        case Padding: args.emplace_back(OpKernelArg(0, arg.size)); break;
-        case Scalar:
-        case Pointer: {
-            auto it = op_args.args_map.find(arg.key);
-            if(it != op_args.args_map.end())
-            {
-                args.push_back(it->second);
-            }
-            else
+            MIOPEN_LOG_I2("Key: " + arg.key);
+            switch(arg.type)
             {
-                MIOPEN_THROW(miopenStatusInternalError, "Argument Not Set: " + arg.key);
+            case Input_Ptr: args.emplace_back(OpKernelArg(input)); break;
+            case Output_Ptr: args.emplace_back(OpKernelArg(output)); break;
+            case Padding: args.emplace_back(OpKernelArg(0, arg.size)); break;
+            case Scalar:
+            case Pointer: args.push_back(get_op_arg(arg)); break;
+            case Default: args.push_back(arg.val); break;
             }
-            break;
-        }
-        case Default: args.push_back(arg.val); break;
         }
+        packed_args = PackedKernelArgs{args};
     }
-    if(args.empty())
+    else
     {
-        MIOPEN_THROW("Operator args not populated properly");
+        // Padding and defaults do not change between the calls, the op arguments are looked
+        // up only when they were set again since the last call.
+        const auto args_changed = op_args.generation != packed_generation;
+        for(std::size_t i = 0; i < arg_list.size(); ++i)
+        {
+            const auto& arg = arg_list[i];
+            switch(arg.type)
+            {
+            case Input_Ptr: packed_args.Set(i, input); break;
+            case Output_Ptr: packed_args.Set(i, output); break;
+            case Scalar:
+            case Pointer:
+                if(args_changed)
+                    packed_args.Set(i, get_op_arg(arg));
+                break;
+            case Padding:
+            case Default: break;
+            }
+        }
     }
-    kernel(args);
+    packed_generation = op_args.generation;
+    kernel(packed_args);
     return miopenStatusSuccess;
 }
 
@@ -0,0 +1,1310 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fusion_patterns.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/db.hpp>
+#include <miopen/fusion_plan.hpp>
+#include <miopen/gemm_v2.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver/conv_direct_tiled.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <numeric>
+
+namespace miopen {
+
+namespace {
+
+// Must match MIOpenFusionEpilogue.cl.
+constexpr std::size_t max_epilogue_ops = 4;
+enum class EpilogueOp
+{
+    None,
+    Bias,
+    Activ,
+    BnSpatial,
+    BnPerActivation,
+    BnTrainSpatial,
+    Tensor,
+    Scale,
+};
+constexpr std::size_t max_epilogue_dims = 5;
+
+std::string GetIndexTypeName(miopenIndexType_t index_type)
+{
+    switch(index_type)
+    {
+    case miopenIndexUint8: return "uchar";
+    case miopenIndexUint16: return "ushort";
+    case miopenIndexUint32: return "uint";
+    case miopenIndexUint64: return "ulong";
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown index type");
+}
+
+using OpIterator = std::vector<std::shared_ptr<FusionOpDescriptor>>::const_iterator;
+
+EpilogueOp GetEpilogueOp(const FusionOpDescriptor& op)
+{
+    switch(op.kind())
+    {
+    case miopenFusionOpBiasForward: return EpilogueOp::Bias;
+    case miopenFusionOpActivForward: return EpilogueOp::Activ;
+    case miopenFusionOpBatchNormInference:
+        return dynamic_cast<const BatchNormInferenceFusionOpDescriptor&>(op).mode ==
+                       miopenBNSpatial
+                   ? EpilogueOp::BnSpatial
+                   : EpilogueOp::BnPerActivation;
+    case miopenFusionOpBatchNormFwdTrain:
+        // Only after the convolution which computes the statistics, see ConvBnTrainPattern.
+        return dynamic_cast<const BatchNormFwdTrainFusionOpDescriptor&>(op).mode ==
+                       miopenBNSpatial
+                   ? EpilogueOp::BnTrainSpatial
+                   : EpilogueOp::None;
+    case miopenFusionOpTensorForward: return EpilogueOp::Tensor;
+    case miopenFusionOpScaleForward: return EpilogueOp::Scale;
+    case miopenFusionOpConvForward:
+    case miopenFusionOpPoolingForward:
+    case miopenFusionOpBiasBackward:
+    case miopenFusionOpActivBackward:
+    case miopenFusionOpBatchNormBwdTrain: break;
+    }
+    return EpilogueOp::None;
+}
+
+bool IsChannelsLast(const TensorDescriptor& desc) { return desc.GetStrides()[1] == 1; }
+
+/// The kernel applies a single activation mode, and only the fp32, fp16 and bfloat16 plans have
+/// the activation arguments.
+bool IsEpilogueApplicable(const TensorDescriptor& desc, OpIterator first, OpIterator last)
+{
+    if(desc.GetType() != miopenFloat && desc.GetType() != miopenHalf &&
+       desc.GetType() != miopenBFloat16)
+        return false;
+    if(desc.GetSize() < 3 || desc.GetSize() > max_epilogue_dims || !desc.IsPacked())
+        return false;
+    if(desc.GetElementSize() > std::numeric_limits<uint32_t>::max())
+        return false;
+    if(static_cast<std::size_t>(std::distance(first, last)) > max_epilogue_ops)
+        return false;
+    if(!std::all_of(first, last, [](const auto& op) { return op->IsEpilogue(); }))
+        return false;
+    return std::count_if(first, last, [](const auto& op) {
+               return op->kind() == miopenFusionOpActivForward;
+           }) <= 1;
+}
+
+const OpKernelArg& GetOpArg(const OperatorArgs& op_args, const std::string& key)
+{
+    auto it = op_args.args_map.find(key);
+    if(it == op_args.args_map.end())
+        MIOPEN_THROW(miopenStatusInternalError, "Argument Not Set: " + key);
+    return it->second;
+}
+
+template <class T>
+T GetOpPointer(const OperatorArgs& op_args, const std::string& key)
+{
+    T ptr = nullptr;
+    std::memcpy(&ptr, GetOpArg(op_args, key).buffer.data(), sizeof(ptr));
+    return ptr;
+}
+
+ConvolutionContext GetConvContext(Handle& handle,
+                                  const ConvForwardOpDescriptor& conv_op,
+                                  const TensorDescriptor& x_desc,
+                                  const TensorDescriptor& y_desc)
+{
+    auto ctx = ConvolutionContext{
+        x_desc, conv_op.filter_desc, y_desc, conv_op.base_desc, conv::Direction::Forward};
+    ctx.SetStream(&handle);
+    ctx.DetectRocm();
+    ctx.SetupFloats();
+    return ctx;
+}
+
+/// The solver of the fastest solution of the convolution which needs no workspace, as the plans
+/// are executed without one.
+boost::optional<solver::Id>
+FindConvolutionSolver(Handle& handle,
+                      const ConvForwardOpDescriptor& conv_op,
+                      const TensorDescriptor& x_desc,
+                      const TensorDescriptor& y_desc,
+                      boost::optional<miopenConvFwdAlgorithm_t> algo)
+{
+    const auto& conv   = conv_op.base_desc;
+    const auto& w_desc = conv_op.filter_desc;
+
+    const auto count = conv.GetForwardSolutionCount(handle, w_desc, x_desc, y_desc);
+    auto solutions   = std::vector<miopenConvSolution_t>(count);
+    auto returned    = std::size_t{0};
+    auto fallback    = false;
+    conv.GetForwardSolutions(
+        handle, w_desc, x_desc, y_desc, count, &returned, solutions.data(), &fallback);
+    solutions.resize(returned);
+
+    // The solutions come fastest first. The plans are executed without a workspace.
+    const auto solution =
+        std::find_if(solutions.begin(), solutions.end(), [&](const miopenConvSolution_t& s) {
+            return s.workspace_size == 0 &&
+                   (!algo || static_cast<int>(s.algorithm) == static_cast<int>(*algo));
+        });
+    if(solution == solutions.end())
+    {
+        MIOPEN_LOG_I("No convolution solution without workspace found for the fusion plan");
+        return boost::none;
+    }
+
+    const auto solver_id = solver::Id{solution->solution_id};
+    MIOPEN_LOG_I2("Convolution of the fusion plan: " << solver_id.ToString());
+    return solver_id;
+}
+
+boost::optional<Invoker> CompileConvolution(Handle& handle,
+                                            const ConvForwardOpDescriptor& conv_op,
+                                            const TensorDescriptor& x_desc,
+                                            const TensorDescriptor& y_desc,
+                                            const solver::Id& solver_id)
+{
+    const auto ctx           = GetConvContext(handle, conv_op, x_desc, y_desc);
+    auto db                  = GetDb(ctx);
+    const auto conv_solution = solver_id.GetSolver().FindSolution(ctx, db, {});
+    if(!conv_solution.Succeeded() || !conv_solution.invoker_factory)
+    {
+        MIOPEN_LOG_I(solver_id.ToString() << " has no invoker to execute the fusion plan");
+        return boost::none;
+    }
+    return handle.PrepareInvoker(*conv_solution.invoker_factory,
+                                 conv_solution.construction_params);
+}
+
+/// A pass which applies the ops from first to last to desc-shaped data.
+FusionPatternInvoker CompileEpilogue(Handle& handle,
+                                     const TensorDescriptor& desc,
+                                     OpIterator first,
+                                     OpIterator last)
+{
+    const auto& lengths = desc.GetLengths();
+    const auto total    = desc.GetElementSize();
+    const auto channels = lengths[1];
+    const auto pixels   = std::accumulate(
+        lengths.begin() + 2, lengths.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+    const auto read_unit = total % 4 == 0 ? 4 : 1;
+    const auto type      = desc.GetType();
+
+    auto build_params = KernelBuildParameters{
+        {"MIOPEN_USE_FP16", type == miopenHalf ? 1 : 0},
+        {"MIOPEN_USE_FP32", type == miopenFloat ? 1 : 0},
+        {"MIOPEN_USE_BFP16", type == miopenBFloat16 ? 1 : 0},
+        {"MIOPEN_EPI_TOTAL", total},
+        {"MIOPEN_EPI_C", channels},
+        {"MIOPEN_EPI_HW", pixels},
+        {"MIOPEN_EPI_CHANNELS_LAST", IsChannelsLast(desc) ? 1 : 0},
+        {"MIOPEN_EPI_READ_UNIT", read_unit},
+    };
+    auto activ = static_cast<int>(miopenActivationPASTHRU);
+    auto slot  = std::size_t{0};
+    auto has_tensor_op = false;
+    for(auto it = first; it != last; ++it, ++slot)
+    {
+        const auto k = std::to_string(slot);
+        if((*it)->kind() == miopenFusionOpActivForward)
+            activ = dynamic_cast<const ActivFwdFusionOpDescriptor&>(**it).activMode;
+        if((*it)->kind() == miopenFusionOpTensorForward)
+        {
+            // The strides of b are zero along the dimensions which it broadcasts.
+            const auto& op     = dynamic_cast<const TensorFwdFusionOpDescriptor&>(**it);
+            const auto& b_lens = op.base_desc.GetLengths();
+            for(std::size_t d = 0; d < max_epilogue_dims; ++d)
+            {
+                const auto stride =
+                    d < b_lens.size() && b_lens[d] != 1 ? op.base_desc.GetStrides()[d] : 0;
+                build_params.Define("MIOPEN_EPI_B" + k + "_STRIDE" + std::to_string(d), stride);
+            }
+            build_params.Define("MIOPEN_EPI_TENSOR_OP" + k, static_cast<int>(op.tensor_op));
+            has_tensor_op = true;
+        }
+        build_params.Define("MIOPEN_EPI_OP" + k, static_cast<int>(GetEpilogueOp(**it)));
+    }
+    if(has_tensor_op)
+    {
+        for(std::size_t d = 0; d < max_epilogue_dims; ++d)
+        {
+            const auto in_desc = d < lengths.size();
+            build_params.Define("MIOPEN_EPI_LEN" + std::to_string(d), in_desc ? lengths[d] : 1);
+            build_params.Define("MIOPEN_EPI_STRIDE" + std::to_string(d),
+                                in_desc ? desc.GetStrides()[d] : 1);
+        }
+    }
+    for(; slot < max_epilogue_ops; ++slot)
+        build_params.Define("MIOPEN_EPI_OP" + std::to_string(slot),
+                            static_cast<int>(EpilogueOp::None));
+    build_params.Define("MIOPEN_NRN_OP_ID", activ);
+
+    const auto algorithm      = std::string{"miopenFusionEpilogue"};
+    const auto options        = build_params.GenerateFor(kbp::OpenCL{});
+    const auto network_config = options;
+
+    if(handle.GetKernels(algorithm, network_config).empty())
+    {
+        const auto local      = std::size_t{256};
+        const auto work_items = total / read_unit;
+        const auto vld        = std::vector<size_t>{local, 1, 1};
+        const auto vgd = std::vector<size_t>{(work_items + local - 1) / local * local, 1, 1};
+        handle.AddKernel(algorithm,
+                         network_config,
+                         "MIOpenFusionEpilogue.cl",
+                         "MIOpenFusionEpilogue",
+                         vld,
+                         vgd,
+                         options);
+    }
+
+    const auto ops = std::vector<std::shared_ptr<FusionOpDescriptor>>(first, last);
+    return [=](const Handle& h, ConstData_t x, Data_t y, const OperatorArgs& op_args) {
+        auto args = std::vector<OpKernelArg>{OpKernelArg(x), OpKernelArg(y)};
+        for(const auto& op : ops)
+        {
+            const auto push = [&](const char* name) {
+                args.push_back(GetOpArg(op_args, op->GetArgKey(name)));
+            };
+            switch(GetEpilogueOp(*op))
+            {
+            case EpilogueOp::Bias: push("bias"); break;
+            case EpilogueOp::Activ:
+                push("activAlpha");
+                push("activBeta");
+                push("activGamma");
+                break;
+            case EpilogueOp::BnSpatial:
+            case EpilogueOp::BnPerActivation:
+                push("bnScale");
+                push("bnBias");
+                push("estimatedMean");
+                push("estimatedVariance");
+                push("epsilon");
+                break;
+            case EpilogueOp::BnTrainSpatial:
+                push("bnScale");
+                push("bnBias");
+                push("savedMean");
+                push("savedInvVariance");
+                break;
+            case EpilogueOp::Tensor:
+                push("tensorB");
+                push("tensorAlpha1");
+                push("tensorAlpha2");
+                break;
+            case EpilogueOp::Scale: push("scaleAlpha"); break;
+            case EpilogueOp::None: break;
+            }
+        }
+
+        auto&& kernels = h.GetKernels(algorithm, network_config);
+        if(kernels.empty())
+            MIOPEN_THROW(miopenStatusBadParm, "The FusionPlan was not compiled for execution");
+        kernels.front()(args);
+    };
+}
+
+/// Elementwise ops only, e.g. a batch normalization followed by an activation on NHWC data.
+struct EpiloguePattern : FusionPattern
+{
+    std::string Name() const override { return "EpiloguePattern"; }
+
+    bool IsApplicable(const FusionPatternProblem& problem) const override
+    {
+        return !problem.ops.empty() &&
+               IsEpilogueApplicable(problem.input_desc, problem.ops.begin(), problem.ops.end());
+    }
+
+    boost::optional<FusionPatternInvoker>
+    Compile(Handle& handle, const FusionPatternProblem& problem) const override
+    {
+        return CompileEpilogue(handle, problem.input_desc, problem.ops.begin(), problem.ops.end());
+    }
+};
+
+/// A convolution of any layout which the solvers support, followed by elementwise ops. Runs
+/// the best convolution solution which needs no workspace, then the ops in a single pass over
+/// its output.
+struct ConvEpiloguePattern : FusionPattern
+{
+    std::string Name() const override { return "ConvEpiloguePattern"; }
+
+    bool IsApplicable(const FusionPatternProblem& problem) const override
+    {
+        if(problem.ops.empty() || problem.ops[0]->kind() != miopenFusionOpConvForward)
+            return false;
+        return IsEpilogueApplicable(
+            problem.output_desc, std::next(problem.ops.begin()), problem.ops.end());
+    }
+
+    boost::optional<FusionPatternInvoker>
+    Compile(Handle& handle, const FusionPatternProblem& problem) const override
+    {
+        const auto conv_op =
+            std::dynamic_pointer_cast<ConvForwardOpDescriptor>(problem.ops.front());
+        const auto& w_desc = conv_op->filter_desc;
+        const auto& x_desc = problem.input_desc;
+        const auto& y_desc = problem.output_desc;
+
+        const auto gemm = CompileGemmEpilogue(handle, problem);
+        if(gemm)
+            return gemm;
+
+        const auto solver_id =
+            FindConvolutionSolver(handle, *conv_op, x_desc, y_desc, problem.conv_algo);
+        if(!solver_id)
+            return boost::none;
+        if(*solver_id == solver::Id{SolverDbId(solver::ConvDirectTiledFwd{})})
+        {
+            const auto fused = CompileTiledEpilogue(handle, problem);
+            if(fused)
+                return fused;
+        }
+        const auto conv_invoker = CompileConvolution(handle, *conv_op, x_desc, y_desc, *solver_id);
+        if(!conv_invoker)
+            return boost::none;
+
+        const auto has_epilogue = problem.ops.size() > 1;
+        const auto epilogue =
+            has_epilogue
+                ? CompileEpilogue(handle, y_desc, std::next(problem.ops.begin()), problem.ops.end())
+                : FusionPatternInvoker{};
+
+        return FusionPatternInvoker{[=](const Handle& h,
+                                        ConstData_t input,
+                                        Data_t output,
+                                        const OperatorArgs& op_args) {
+            const auto w = GetOpPointer<ConstData_t>(op_args, conv_op->GetArgKey("weights"));
+            const auto tensors    = ConvFwdTensors{x_desc, input, w_desc, w, y_desc, output};
+            const auto invoke_ctx = conv::DataInvokeParams{tensors, nullptr, 0};
+            (*conv_invoker)(h, invoke_ctx);
+            if(!has_epilogue)
+                return;
+
+            float elapsed = 0;
+            if(h.IsProfilingEnabled())
+                elapsed += h.GetKernelTime();
+            epilogue(h, output, output, op_args);
+            if(h.IsProfilingEnabled())
+            {
+                elapsed += h.GetKernelTime();
+                h.ResetKernelTime();
+                h.AccumKernelTime(elapsed);
+            }
+        }};
+    }
+
+    private:
+    /// A 1x1 convolution with unit strides and no padding is a single GEMM, over the pixels of
+    /// all the images for NHWC, or strided batched over the images for NCHW. hipBLASLt applies
+    /// a bias and a ReLU before it stores the output. Its bias is per column of the row-major
+    /// output, i.e. per channel only on NHWC, so the bias needs NHWC and NCHW takes the ReLU only.
+    static boost::optional<FusionPatternInvoker>
+    CompileGemmEpilogue(Handle& handle, const FusionPatternProblem& problem)
+    {
+        const auto& ops    = problem.ops;
+        const auto& x_desc = problem.input_desc;
+        const auto& y_desc = problem.output_desc;
+        const auto conv_op = std::dynamic_pointer_cast<ConvForwardOpDescriptor>(ops.front());
+        const auto& conv   = conv_op->base_desc;
+        const auto& w_desc = conv_op->filter_desc;
+
+        const auto all_equal = [](const std::vector<int>& values, int value) {
+            return std::all_of(values.begin(), values.end(), [&](int v) { return v == value; });
+        };
+        const auto w_lengths = w_desc.GetLengths();
+        if(conv.mode != miopenConvolution || conv.GetGroupCount() != 1 ||
+           !all_equal(conv.GetConvPads(), 0) || !all_equal(conv.GetConvStrides(), 1) ||
+           !all_equal(conv.GetConvDilations(), 1) ||
+           !std::all_of(w_lengths.begin() + 2, w_lengths.end(), [](auto l) { return l == 1; }))
+            return boost::none;
+        if(!x_desc.IsPacked() || !w_desc.IsPacked() || !y_desc.IsPacked() ||
+           x_desc.GetType() != w_desc.GetType() || x_desc.GetType() != y_desc.GetType())
+            return boost::none;
+
+        const auto nhwc    = IsChannelsLast(x_desc) && IsChannelsLast(y_desc);
+        const auto nchw    = !IsChannelsLast(x_desc) && !IsChannelsLast(y_desc);
+        auto epilogue      = GemmEpilogue{};
+        auto it            = std::next(ops.begin());
+        const auto bias_op = it != ops.end() && (*it)->kind() == miopenFusionOpBiasForward
+                                 ? std::dynamic_pointer_cast<BiasFusionOpDescriptor>(*it)
+                                 : nullptr;
+        if(bias_op != nullptr)
+        {
+            epilogue.bias = true;
+            ++it;
+        }
+        if(it != ops.end() && (*it)->kind() == miopenFusionOpActivForward &&
+           std::dynamic_pointer_cast<ActivFwdFusionOpDescriptor>(*it)->activMode ==
+               miopenActivationRELU)
+        {
+            epilogue.activation = GemmActivation::Relu;
+            ++it;
+        }
+        if(it != ops.end() || ops.size() == 1 || !(nhwc || (nchw && !epilogue.bias)))
+            return boost::none;
+
+        const auto batch    = static_cast<int>(x_desc.GetLengths()[0]);
+        const auto channels = static_cast<int>(x_desc.GetLengths()[1]);
+        const auto outputs  = static_cast<int>(y_desc.GetLengths()[1]);
+        const auto pixels   = static_cast<int>(y_desc.GetElementSize() / (batch * outputs));
+        // y = x * w^T for NHWC, y[n] = w * x[n] for NCHW, all row-major.
+        auto gemm_desc        = GemmDescriptor{};
+        gemm_desc.isColMajor  = false;
+        gemm_desc.transA      = false;
+        gemm_desc.transB      = nhwc;
+        gemm_desc.m           = nhwc ? batch * pixels : outputs;
+        gemm_desc.n           = nhwc ? outputs : pixels;
+        gemm_desc.k           = channels;
+        gemm_desc.lda         = channels;
+        gemm_desc.ldb         = nhwc ? channels : pixels;
+        gemm_desc.ldc         = nhwc ? outputs : pixels;
+        gemm_desc.batch_count = nhwc ? 1 : batch;
+        gemm_desc.strideA     = 0;
+        gemm_desc.strideB     = nhwc ? 0 : static_cast<long long>(channels) * pixels;
+        gemm_desc.strideC     = nhwc ? 0 : static_cast<long long>(outputs) * pixels;
+        gemm_desc.alpha       = 1;
+        gemm_desc.beta        = 0;
+        gemm_desc.dataType    = x_desc.GetType();
+        if(!IsGemmEpilogueSupported(handle, gemm_desc, epilogue))
+            return boost::none;
+        MIOPEN_LOG_I2("The fusion plan runs the convolution as a GEMM with an epilogue");
+
+        return FusionPatternInvoker{[=](const Handle& h,
+                                        ConstData_t input,
+                                        Data_t output,
+                                        const OperatorArgs& op_args) {
+            const auto w    = GetOpPointer<ConstData_t>(op_args, conv_op->GetArgKey("weights"));
+            const auto bias = bias_op != nullptr
+                                  ? GetOpPointer<ConstData_t>(op_args, bias_op->GetArgKey("bias"))
+                                  : nullptr;
+            const auto status = nhwc ? CallGemmEpilogue(
+                                           h, gemm_desc, input, 0, w, 0, output, 0, epilogue, bias)
+                                     : CallGemmEpilogue(
+                                           h, gemm_desc, w, 0, input, 0, output, 0, epilogue);
+            if(status != miopenStatusSuccess)
+                MIOPEN_THROW(status, "The GEMM of the fusion plan failed");
+        }};
+    }
+
+    /// When the tiled direct convolution is the fastest, it applies a bias, a residual add and
+    /// an activation, in that order, before it stores its output, e.g. for the residual blocks of
+    /// ResNets. That saves the pass of the epilogue, which reads and writes the output again.
+    static boost::optional<FusionPatternInvoker>
+    CompileTiledEpilogue(Handle& handle, const FusionPatternProblem& problem)
+    {
+        const auto& ops    = problem.ops;
+        const auto& y_desc = problem.output_desc;
+        auto epilogue      = solver::DirectTiledEpilogue{};
+        auto it            = std::next(ops.begin());
+        if(it != ops.end() && (*it)->kind() == miopenFusionOpBiasForward)
+        {
+            epilogue.bias = true;
+            ++it;
+        }
+        const auto residual_op = it != ops.end() && (*it)->kind() == miopenFusionOpTensorForward
+                                     ? std::dynamic_pointer_cast<TensorFwdFusionOpDescriptor>(*it)
+                                     : nullptr;
+        if(residual_op != nullptr)
+        {
+            // The residual is read at the indices of the output.
+            const auto& r_desc = residual_op->base_desc;
+            if(residual_op->tensor_op != miopenTensorOpAdd ||
+               r_desc.GetLengths() != y_desc.GetLengths() ||
+               r_desc.GetStrides() != y_desc.GetStrides())
+                return boost::none;
+            epilogue.residual = true;
+            ++it;
+        }
+        const auto activ_op = it != ops.end() && (*it)->kind() == miopenFusionOpActivForward
+                                  ? std::dynamic_pointer_cast<ActivFwdFusionOpDescriptor>(*it)
+                                  : nullptr;
+        if(activ_op != nullptr)
+        {
+            epilogue.activ = activ_op->activMode;
+            ++it;
+        }
+        if(it != ops.end() || ops.size() == 1)
+            return boost::none;
+
+        const auto conv_op = std::dynamic_pointer_cast<ConvForwardOpDescriptor>(ops.front());
+        const auto ctx     = GetConvContext(handle, *conv_op, problem.input_desc, y_desc);
+        const auto solver  = solver::ConvDirectTiledFwd{};
+        const auto conv_solution = solver::GetDirectTiledSolution(
+            ctx, solver.GetPerformanceConfig(ctx), false, false, epilogue);
+        const auto& kernel = conv_solution.construction_params.front();
+
+        const auto algorithm      = std::string{"miopenFusionConvTiledEpilogue"};
+        const auto network_config = kernel.comp_options;
+        if(handle.GetKernels(algorithm, network_config).empty())
+            handle.AddKernel(algorithm,
+                             network_config,
+                             kernel.kernel_file,
+                             kernel.kernel_name,
+                             kernel.l_wk,
+                             kernel.g_wk,
+                             kernel.comp_options);
+        MIOPEN_LOG_I2("The convolution of the fusion plan applies the epilogue");
+
+        const auto bias_op = epilogue.bias ? ops[1] : nullptr;
+        return FusionPatternInvoker{[=](const Handle& h,
+                                        ConstData_t input,
+                                        Data_t output,
+                                        const OperatorArgs& op_args) {
+            auto args = std::vector<OpKernelArg>{OpKernelArg(input),
+                                                 GetOpArg(op_args, conv_op->GetArgKey("weights")),
+                                                 OpKernelArg(output)};
+            const auto push = [&](const FusionOpDescriptor& op, const char* name) {
+                args.push_back(GetOpArg(op_args, op.GetArgKey(name)));
+            };
+            if(bias_op != nullptr)
+                push(*bias_op, "bias");
+            if(residual_op != nullptr)
+            {
+                push(*residual_op, "tensorB");
+                push(*residual_op, "tensorAlpha1");
+                push(*residual_op, "tensorAlpha2");
+            }
+            if(activ_op != nullptr)
+            {
+                push(*activ_op, "activAlpha");
+                push(*activ_op, "activBeta");
+                push(*activ_op, "activGamma");
+            }
+
+            auto&& kernels = h.GetKernels(algorithm, network_config);
+            if(kernels.empty())
+                MIOPEN_THROW(miopenStatusBadParm, "The FusionPlan was not compiled for execution");
+            kernels.front()(args);
+        }};
+    }
+};
+
+/// A forward convolution followed by a spatial training batch normalization and optionally
+/// an activation. The tiled direct convolution also adds up the statistics of its output
+/// channels, so that the output is written once, then normalized and activated by a single
+/// epilogue pass, instead of a separate pass for the statistics.
+struct ConvBnTrainPattern : FusionPattern
+{
+    std::string Name() const override { return "ConvBnTrainPattern"; }
+
+    bool IsApplicable(const FusionPatternProblem& problem) const override
+    {
+        const auto& ops = problem.ops;
+        if(ops.size() < 2 || ops.size() > 3 || ops[0]->kind() != miopenFusionOpConvForward)
+            return false;
+        if(GetEpilogueOp(*ops[1]) != EpilogueOp::BnTrainSpatial)
+            return false;
+        if(ops.size() == 3 && ops[2]->kind() != miopenFusionOpActivForward)
+            return false;
+        const auto& desc = problem.output_desc;
+        return (desc.GetType() == miopenFloat || desc.GetType() == miopenHalf) &&
+               desc.GetSize() == 4 && desc.IsPacked() &&
+               desc.GetElementSize() <= std::numeric_limits<uint32_t>::max();
+    }
+
+    boost::optional<FusionPatternInvoker>
+    Compile(Handle& handle, const FusionPatternProblem& problem) const override
+    {
+        const auto conv_op =
+            std::dynamic_pointer_cast<ConvForwardOpDescriptor>(problem.ops.front());
+        const auto bn_op =
+            std::dynamic_pointer_cast<BatchNormFwdTrainFusionOpDescriptor>(problem.ops[1]);
+        const auto& x_desc = problem.input_desc;
+        const auto& y_desc = problem.output_desc;
+
+        if(problem.conv_algo && *problem.conv_algo != miopenConvolutionFwdAlgoDirect)
+            return boost::none;
+        const auto ctx    = GetConvContext(handle, *conv_op, x_desc, y_desc);
+        const auto solver = solver::ConvDirectTiledFwd{};
+        if(!solver.IsApplicable(ctx))
+        {
+            MIOPEN_LOG_I("The convolution of the fusion plan does not support the statistics");
+            return boost::none;
+        }
+        const auto conv_solution =
+            solver::GetDirectTiledSolution(ctx, solver.GetPerformanceConfig(ctx), false, true);
+        const auto& conv_kernel = conv_solution.construction_params.front();
+
+        const auto channels = y_desc.GetLengths()[1];
+        const auto nhw      = y_desc.GetElementSize() / channels;
+        const auto stats_params = KernelBuildParameters{
+            {"MIOPEN_BN_C", channels},
+            {"MIOPEN_BN_NHW", nhw},
+            {"MIOPEN_BN_RUNNING", bn_op->runningMeanVar ? 1 : 0},
+        }.GenerateFor(kbp::OpenCL{});
+
+        const auto algorithm       = std::string{"miopenFusionConvBnTrain"};
+        const auto conv_config     = conv_kernel.comp_options;
+        const auto stats_config    = "stats" + stats_params;
+        const auto finalize_config = "finalize" + stats_params;
+        if(handle.GetKernels(algorithm, conv_config).empty())
+            handle.AddKernel(algorithm,
+                             conv_config,
+                             conv_kernel.kernel_file,
+                             conv_kernel.kernel_name,
+                             conv_kernel.l_wk,
+                             conv_kernel.g_wk,
+                             conv_kernel.comp_options);
+        const auto local = std::size_t{256};
+        const auto vld   = std::vector<size_t>{local, 1, 1};
+        const auto vgd   = std::vector<size_t>{(channels + local - 1) / local * local, 1, 1};
+        if(handle.GetKernels(algorithm, stats_config).empty())
+            handle.AddKernel(algorithm,
+                             stats_config,
+                             "MIOpenFusionBnTrainStats.cl",
+                             "MIOpenBnTrainStatsInit",
+                             vld,
+                             vgd,
+                             stats_params);
+        if(handle.GetKernels(algorithm, finalize_config).empty())
+            handle.AddKernel(algorithm,
+                             finalize_config,
+                             "MIOpenFusionBnTrainStats.cl",
+                             "MIOpenBnTrainStatsFinalize",
+                             vld,
+                             vgd,
+                             stats_params);
+
+        const auto epilogue =
+            CompileEpilogue(handle, y_desc, std::next(problem.ops.begin()), problem.ops.end());
+
+        return FusionPatternInvoker{[=](const Handle& h,
+                                        ConstData_t input,
+                                        Data_t output,
+                                        const OperatorArgs& op_args) {
+            const auto w     = GetOpPointer<ConstData_t>(op_args, conv_op->GetArgKey("weights"));
+            const auto sum   = GetOpPointer<Data_t>(op_args, bn_op->GetArgKey("savedMean"));
+            const auto sqsum = GetOpPointer<Data_t>(op_args, bn_op->GetArgKey("savedInvVariance"));
+            if(sum == nullptr || sqsum == nullptr)
+                MIOPEN_THROW(miopenStatusBadParm,
+                             "The fused convolution and batch normalization needs savedMean "
+                             "and savedInvVariance");
+
+            const auto get_kernel = [&](const std::string& config) {
+                auto&& kernels = h.GetKernels(algorithm, config);
+                if(kernels.empty())
+                    MIOPEN_THROW(miopenStatusBadParm,
+                                 "The FusionPlan was not compiled for execution");
+                return kernels.front();
+            };
+
+            float elapsed       = 0;
+            const auto add_time = [&]() {
+                if(h.IsProfilingEnabled())
+                    elapsed += h.GetKernelTime();
+            };
+
+            get_kernel(stats_config)(sum, sqsum);
+            add_time();
+            get_kernel(conv_config)(input, w, output, sum, sqsum);
+            add_time();
+            get_kernel(finalize_config)(
+                std::vector<OpKernelArg>{OpKernelArg(sum),
+                                         OpKernelArg(sqsum),
+                                         GetOpArg(op_args, bn_op->GetArgKey("runningMean")),
+                                         GetOpArg(op_args, bn_op->GetArgKey("runningVariance")),
+                                         GetOpArg(op_args, bn_op->GetArgKey("expAvgFactor")),
+                                         GetOpArg(op_args, bn_op->GetArgKey("epsilon"))});
+            add_time();
+            epilogue(h, output, output, op_args);
+            add_time();
+            if(h.IsProfilingEnabled())
+            {
+                h.ResetKernelTime();
+                h.AccumKernelTime(elapsed);
+            }
+        }};
+    }
+};
+
+/// With constant folding, a convolution and optionally its bias, followed by a spatial
+/// inference batch normalization and elementwise ops. The normalization is folded into the
+/// weights and the bias of the convolution, in buffers of the plan, so that the convolution
+/// runs with its fastest solution, also one which cannot fuse the normalization, and the bias
+/// and the remaining ops in a single epilogue pass. The parameters are folded on the first
+/// execution and again after the arguments are set again.
+struct ConvBnFoldPattern : FusionPattern
+{
+    std::string Name() const override { return "ConvBnFoldPattern"; }
+    bool IsPreferredOverGraph() const override { return true; }
+
+    bool IsApplicable(const FusionPatternProblem& problem) const override
+    {
+        const auto& ops = problem.ops;
+        if(!problem.constant_folding || ops.size() < 2 ||
+           ops[0]->kind() != miopenFusionOpConvForward)
+            return false;
+        const auto bn_idx = GetBnIndex(problem);
+        if(ops.size() <= bn_idx || GetEpilogueOp(*ops[bn_idx]) != EpilogueOp::BnSpatial)
+            return false;
+        // The folded bias takes a slot of the epilogue.
+        const auto tail = std::next(ops.begin(), bn_idx + 1);
+        if(static_cast<std::size_t>(std::distance(tail, ops.end())) >= max_epilogue_ops)
+            return false;
+
+        // The output channels of the weights are outermost.
+        const auto& w_desc = dynamic_cast<const ConvForwardOpDescriptor&>(*ops[0]).filter_desc;
+        const auto& w_lens = w_desc.GetLengths();
+        // The folding kernel has no bfloat16 variant.
+        return w_desc.IsPacked() && w_desc.GetType() == problem.output_desc.GetType() &&
+               w_desc.GetType() != miopenBFloat16 &&
+               w_desc.GetStrides()[0] * w_lens[0] == w_desc.GetElementSize() &&
+               w_lens[0] == problem.output_desc.GetLengths()[1] &&
+               IsEpilogueApplicable(problem.output_desc, tail, ops.end());
+    }
+
+    boost::optional<FusionPatternInvoker>
+    Compile(Handle& handle, const FusionPatternProblem& problem) const override
+    {
+        const auto conv_op =
+            std::dynamic_pointer_cast<ConvForwardOpDescriptor>(problem.ops.front());
+        const auto bn_idx   = GetBnIndex(problem);
+        const auto bias_op  = bn_idx == 2 ? problem.ops[1] : nullptr;
+        const auto bn_op    = problem.ops[bn_idx];
+        const auto& w_desc  = conv_op->filter_desc;
+        const auto& x_desc  = problem.input_desc;
+        const auto& y_desc  = problem.output_desc;
+        const auto channels = y_desc.GetLengths()[1];
+
+        const auto solver_id =
+            FindConvolutionSolver(handle, *conv_op, x_desc, y_desc, problem.conv_algo);
+        if(!solver_id)
+            return boost::none;
+        const auto conv_invoker = CompileConvolution(handle, *conv_op, x_desc, y_desc, *solver_id);
+        if(!conv_invoker)
+            return boost::none;
+
+        // The epilogue adds the folded bias, its key follows those of the ops of the plan.
+        auto bias_lens = std::vector<std::size_t>(y_desc.GetSize(), 1);
+        bias_lens[1]   = channels;
+        const auto folded_bias_op =
+            std::make_shared<BiasFusionOpDescriptor>(TensorDescriptor{y_desc.GetType(), bias_lens});
+        folded_bias_op->SetIdx(static_cast<int>(problem.ops.size()));
+        auto epilogue_ops = std::vector<std::shared_ptr<FusionOpDescriptor>>{folded_bias_op};
+        epilogue_ops.insert(
+            epilogue_ops.end(), std::next(problem.ops.begin(), bn_idx + 1), problem.ops.end());
+        const auto epilogue =
+            CompileEpilogue(handle, y_desc, epilogue_ops.begin(), epilogue_ops.end());
+
+        const auto is_fp16     = y_desc.GetType() == miopenHalf;
+        const auto w_per_k     = w_desc.GetElementSize() / channels;
+        const auto fold_params = KernelBuildParameters{
+            {"MIOPEN_USE_FP16", is_fp16 ? 1 : 0},
+            {"MIOPEN_USE_FP32", is_fp16 ? 0 : 1},
+            {"MIOPEN_FOLD_K", channels},
+            {"MIOPEN_FOLD_W_PER_K", w_per_k},
+            {"MIOPEN_FOLD_HAS_BIAS", bias_op != nullptr ? 1 : 0},
+        }.GenerateFor(kbp::OpenCL{});
+        const auto algorithm      = std::string{"miopenFusionFoldBn"};
+        const auto weights_config = "weights" + fold_params;
+        const auto bias_config    = "bias" + fold_params;
+        const auto local          = std::size_t{256};
+        const auto vld            = std::vector<size_t>{local, 1, 1};
+        const auto grid           = [&](std::size_t n) {
+            return std::vector<size_t>{(n + local - 1) / local * local, 1, 1};
+        };
+        if(handle.GetKernels(algorithm, weights_config).empty())
+            handle.AddKernel(algorithm,
+                             weights_config,
+                             "MIOpenFusionFoldBn.cl",
+                             "MIOpenFoldBnWeights",
+                             vld,
+                             grid(w_desc.GetElementSize()),
+                             fold_params);
+        if(handle.GetKernels(algorithm, bias_config).empty())
+            handle.AddKernel(algorithm,
+                             bias_config,
+                             "MIOpenFusionFoldBn.cl",
+                             "MIOpenFoldBnBias",
+                             vld,
+                             grid(channels),
+                             fold_params);
+
+        const auto w_bytes    = w_desc.GetElementSize() * GetTypeSize(w_desc.GetType());
+        const auto bias_bytes = channels * GetTypeSize(y_desc.GetType());
+        const auto folded     = std::make_shared<FoldedConstants>();
+
+        return FusionPatternInvoker{[=](const Handle& h,
+                                        ConstData_t input,
+                                        Data_t output,
+                                        const OperatorArgs& op_args) {
+            const auto get_kernel = [&](const std::string& config) {
+                auto&& kernels = h.GetKernels(algorithm, config);
+                if(kernels.empty())
+                    MIOPEN_THROW(miopenStatusBadParm,
+                                 "The FusionPlan was not compiled for execution");
+                return kernels.front();
+            };
+
+            float elapsed       = 0;
+            const auto add_time = [&]() {
+                if(h.IsProfilingEnabled())
+                    elapsed += h.GetKernelTime();
+            };
+
+            std::lock_guard<std::mutex> lock(folded->mutex);
+            if(folded->generation != op_args.generation)
+            {
+                if(!folded->weights)
+                {
+                    const MemoryCategoryScope memory_scope{MemoryCategory::Constants};
+                    folded->weights = h.Create(w_bytes);
+                    folded->bias    = h.Create(bias_bytes);
+                }
+                const auto push = [&](std::vector<OpKernelArg>& args, const char* name) {
+                    args.push_back(GetOpArg(op_args, bn_op->GetArgKey(name)));
+                };
+
+                auto w_args = std::vector<OpKernelArg>{
+                    GetOpArg(op_args, conv_op->GetArgKey("weights"))};
+                push(w_args, "bnScale");
+                push(w_args, "estimatedVariance");
+                push(w_args, "epsilon");
+                w_args.emplace_back(folded->weights.get());
+                get_kernel(weights_config)(w_args);
+                add_time();
+
+                // Without a bias of the convolution, the argument is unused.
+                auto b_args = std::vector<OpKernelArg>{
+                    bias_op != nullptr ? GetOpArg(op_args, bias_op->GetArgKey("bias"))
+                                       : OpKernelArg(folded->bias.get())};
+                push(b_args, "bnScale");
+                push(b_args, "bnBias");
+                push(b_args, "estimatedMean");
+                push(b_args, "estimatedVariance");
+                push(b_args, "epsilon");
+                b_args.emplace_back(folded->bias.get());
+                get_kernel(bias_config)(b_args);
+                add_time();
+
+                folded->args = op_args;
+                folded_bias_op->SetArgs(folded->args, nullptr, nullptr, folded->bias.get());
+                folded->generation = op_args.generation;
+            }
+
+            const auto tensors =
+                ConvFwdTensors{x_desc, input, w_desc, folded->weights.get(), y_desc, output};
+            const auto invoke_ctx = conv::DataInvokeParams{tensors, nullptr, 0};
+            (*conv_invoker)(h, invoke_ctx);
+            add_time();
+            epilogue(h, output, output, folded->args);
+            add_time();
+            if(h.IsProfilingEnabled())
+            {
+                h.ResetKernelTime();
+                h.AccumKernelTime(elapsed);
+            }
+        }};
+    }
+
+    private:
+    /// The buffers of the folded weights and bias and the arguments of the epilogue, which
+    /// are those of the plan and the folded bias.
+    struct FoldedConstants
+    {
+        std::mutex mutex;
+        std::size_t generation = 0;
+        Allocator::ManageDataPtr weights;
+        Allocator::ManageDataPtr bias;
+        OperatorArgs args;
+    };
+
+    static std::size_t GetBnIndex(const FusionPatternProblem& problem)
+    {
+        return problem.ops[1]->kind() == miopenFusionOpBiasForward ? 2 : 1;
+    }
+};
+
+/// Optionally a convolution, then optionally a bias and an activation, then a 2D pooling of
+/// NCHW data. The pooling kernel applies the bias and the activation to the output of the
+/// convolution as it reads it, so that only the pooled data is written after the convolution.
+/// The convolution writes into a buffer of the plan.
+struct PoolingPattern : FusionPattern
+{
+    std::string Name() const override { return "PoolingPattern"; }
+
+    bool IsApplicable(const FusionPatternProblem& problem) const override
+    {
+        const auto& ops = problem.ops;
+        if(ops.empty() || ops.back()->kind() != miopenFusionOpPoolingForward)
+            return false;
+        auto it = ops.begin();
+        if((*it)->kind() == miopenFusionOpConvForward)
+            ++it;
+        if((*it)->kind() == miopenFusionOpBiasForward)
+            ++it;
+        if((*it)->kind() == miopenFusionOpActivForward)
+            ++it;
+        if(std::next(it) != ops.end())
+            return false;
+
+        const auto& pool   = dynamic_cast<const PoolingFwdFusionOpDescriptor&>(**it).base_desc;
+        const auto& x_desc = (*it)->input_desc;
+        return pool.GetSize() == 2 && pool.GetPaddingMode() == miopenPaddingDefault &&
+               (x_desc.GetType() == miopenFloat || x_desc.GetType() == miopenHalf) &&
+               x_desc.GetSize() == 4 && x_desc.IsPacked() &&
+               x_desc.GetLayout("NCHW") == "NCHW" &&
+               x_desc.GetElementSize() <= std::numeric_limits<uint32_t>::max();
+    }
+
+    boost::optional<FusionPatternInvoker>
+    Compile(Handle& handle, const FusionPatternProblem& problem) const override
+    {
+        const auto& ops    = problem.ops;
+        const auto conv_op = ops.front()->kind() == miopenFusionOpConvForward
+                                 ? std::dynamic_pointer_cast<ConvForwardOpDescriptor>(ops.front())
+                                 : nullptr;
+        const auto find_op = [&](miopenFusionOp_t kind) {
+            const auto op = std::find_if(
+                ops.begin(), ops.end(), [&](const auto& o) { return o->kind() == kind; });
+            return op != ops.end() ? *op : nullptr;
+        };
+        const auto bias_op  = find_op(miopenFusionOpBiasForward);
+        const auto activ_op = std::dynamic_pointer_cast<ActivFwdFusionOpDescriptor>(
+            find_op(miopenFusionOpActivForward));
+        const auto pool_op = std::dynamic_pointer_cast<PoolingFwdFusionOpDescriptor>(ops.back());
+        const auto& pool   = pool_op->base_desc;
+        const auto& in_desc = problem.input_desc;
+        const auto& x_desc  = pool_op->input_desc;
+        const auto& y_desc  = problem.output_desc;
+
+        auto conv_invoker = boost::optional<Invoker>{};
+        auto conv_output  = std::shared_ptr<Allocator::ManageDataPtr>{};
+        if(conv_op != nullptr)
+        {
+            const auto solver_id =
+                FindConvolutionSolver(handle, *conv_op, in_desc, x_desc, problem.conv_algo);
+            if(!solver_id)
+                return boost::none;
+            conv_invoker = CompileConvolution(handle, *conv_op, in_desc, x_desc, *solver_id);
+            if(!conv_invoker)
+                return boost::none;
+            conv_output = std::make_shared<Allocator::ManageDataPtr>(
+                handle.Create(x_desc.GetElementSize() * GetTypeSize(x_desc.GetType())));
+        }
+
+        std::size_t n, c, hi, wi, ho, wo;
+        std::tie(n, c, hi, wi) = tien<4>(x_desc.GetLengths());
+        std::tie(std::ignore, std::ignore, ho, wo) = tien<4>(y_desc.GetLengths());
+        const auto is_max      = pool.GetMode() == miopenPoolingMax;
+        const auto image_index = pool.GetWorkspaceIndexMode() == miopenPoolingWorkspaceIndexImage;
+        const auto is_fp16     = x_desc.GetType() == miopenHalf;
+        // As in PoolingDescriptor::Forward, the indices of the maxima have to fit their type.
+        const auto window =
+            static_cast<std::size_t>(pool.GetLengths()[0]) * pool.GetLengths()[1];
+        const auto index_range    = image_index ? hi * wi : window;
+        // The fused kernel writes index_t masks and knows nothing of the packed layout.
+        const auto can_save_index =
+            pool.GetWorkspaceIndexMode() != miopenPoolingWorkspaceIndexMaskPacked &&
+            get_index_max(pool.GetIndexType()) >= index_range;
+
+        auto build_params = KernelBuildParameters{
+            {"MIOPEN_USE_FP16", is_fp16 ? 1 : 0},
+            {"MIOPEN_USE_FP32", is_fp16 ? 0 : 1},
+            {"MIOPEN_POOL_N", n},
+            {"MIOPEN_POOL_C", c},
+            {"MIOPEN_POOL_HI", hi},
+            {"MIOPEN_POOL_WI", wi},
+            {"MIOPEN_POOL_HO", ho},
+            {"MIOPEN_POOL_WO", wo},
+            {"MIOPEN_POOL_KH", pool.GetLengths()[0]},
+            {"MIOPEN_POOL_KW", pool.GetLengths()[1]},
+            {"MIOPEN_POOL_SH", pool.GetStrides()[0]},
+            {"MIOPEN_POOL_SW", pool.GetStrides()[1]},
+            {"MIOPEN_POOL_PH", pool.GetPads()[0]},
+            {"MIOPEN_POOL_PW", pool.GetPads()[1]},
+            {"MIOPEN_POOL_OP", static_cast<int>(pool.GetMode())},
+            {"MIOPEN_POOL_INDEX_TYPE", GetIndexTypeName(pool.GetIndexType())},
+            {"MIOPEN_POOL_IMG_INDEX", image_index ? 1 : 0},
+            {"MIOPEN_POOL_BIAS", bias_op != nullptr ? 1 : 0},
+            {"MIOPEN_POOL_ACTIV", activ_op != nullptr ? 1 : 0},
+        };
+        if(activ_op != nullptr)
+            build_params.Define("MIOPEN_NRN_OP_ID", static_cast<int>(activ_op->activMode));
+
+        const auto algorithm      = std::string{"miopenFusionPool"};
+        const auto network_config = build_params.GenerateFor(kbp::OpenCL{});
+        if(handle.GetKernels(algorithm, network_config).empty())
+        {
+            const auto local = std::size_t{256};
+            const auto total = y_desc.GetElementSize();
+            handle.AddKernel(algorithm,
+                             network_config,
+                             "MIOpenFusionPool.cl",
+                             "MIOpenFusionPool",
+                             {local, 1, 1},
+                             {(total + local - 1) / local * local, 1, 1},
+                             network_config);
+        }
+
+        const auto& w_desc = conv_op != nullptr ? conv_op->filter_desc : x_desc;
+        return FusionPatternInvoker{[=](const Handle& h,
+                                        ConstData_t input,
+                                        Data_t output,
+                                        const OperatorArgs& op_args) {
+            float elapsed = 0;
+            auto x        = input;
+            if(conv_invoker)
+            {
+                const auto w = GetOpPointer<ConstData_t>(op_args, conv_op->GetArgKey("weights"));
+                const auto tensors =
+                    ConvFwdTensors{in_desc, input, w_desc, w, x_desc, conv_output->get()};
+                const auto invoke_ctx = conv::DataInvokeParams{tensors, nullptr, 0};
+                (*conv_invoker)(h, invoke_ctx);
+                if(h.IsProfilingEnabled())
+                    elapsed += h.GetKernelTime();
+                x = conv_output->get();
+            }
+
+            auto args = std::vector<OpKernelArg>{OpKernelArg(x), OpKernelArg(output)};
+            const auto push = [&](const FusionOpDescriptor& op, const char* name) {
+                args.push_back(GetOpArg(op_args, op.GetArgKey(name)));
+            };
+            if(bias_op != nullptr)
+                push(*bias_op, "bias");
+            if(activ_op != nullptr)
+            {
+                push(*activ_op, "activAlpha");
+                push(*activ_op, "activBeta");
+                push(*activ_op, "activGamma");
+            }
+            if(is_max)
+            {
+                const auto workspace =
+                    GetOpPointer<Data_t>(op_args, pool_op->GetArgKey("poolWorkspace"));
+                if(workspace != nullptr && !can_save_index)
+                    MIOPEN_THROW(miopenStatusBadParm,
+                                 "Index range not enough for max pooling bwd");
+                args.emplace_back(workspace);
+            }
+
+            auto&& kernels = h.GetKernels(algorithm, network_config);
+            if(kernels.empty())
+                MIOPEN_THROW(miopenStatusBadParm, "The FusionPlan was not compiled for execution");
+            kernels.front()(args);
+            if(h.IsProfilingEnabled())
+            {
+                elapsed += h.GetKernelTime();
+                h.ResetKernelTime();
+                h.AccumKernelTime(elapsed);
+            }
+        }};
+    }
+};
+
+/// The backward plans which end with the gradient of the bias: [batch normalization backward]
+/// [activation backward] bias backward, the reverse of a convolution with a bias followed by the
+/// same forward ops. Without the batch normalization, a kernel applies the activation backward,
+/// writes dx and reduces it into the bias gradient in one pass over dy. With it, the kernel of
+/// the graph computes dx, dscale and dbias of the normalization, and the bias gradient is zero:
+/// the gradient of the input of a batch normalization with the statistics of the batch sums to
+/// zero over the normalized dimensions, so no pass over dx is needed.
+struct BiasBwdPattern : FusionPattern
+{
+    std::string Name() const override { return "BiasBwdPattern"; }
+
+    bool IsApplicable(const FusionPatternProblem& problem) const override
+    {
+        const auto& ops = problem.ops;
+        if(ops.empty() || ops.back()->kind() != miopenFusionOpBiasBackward)
+            return false;
+        auto it = ops.begin();
+        if((*it)->kind() == miopenFusionOpBatchNormBwdTrain)
+            ++it;
+        if((*it)->kind() == miopenFusionOpActivBackward)
+            ++it;
+        if(std::next(it) != ops.end())
+            return false;
+
+        const auto& desc    = problem.input_desc;
+        const auto& db_desc = dynamic_cast<const BiasBwdFusionOpDescriptor&>(**it).base_desc;
+        return (desc.GetType() == miopenFloat || desc.GetType() == miopenHalf) &&
+               desc.GetSize() >= 3 && desc.GetSize() <= max_epilogue_dims && desc.IsPacked() &&
+               desc.GetElementSize() <= std::numeric_limits<uint32_t>::max() &&
+               db_desc.GetType() == desc.GetType() &&
+               db_desc.GetElementSize() == desc.GetLengths()[1];
+    }
+
+    boost::optional<FusionPatternInvoker>
+    Compile(Handle& handle, const FusionPatternProblem& problem) const override
+    {
+        if(problem.ops.front()->kind() == miopenFusionOpBatchNormBwdTrain)
+            return CompileAfterBatchNorm(handle, problem);
+
+        const auto& ops     = problem.ops;
+        const auto& desc    = problem.input_desc;
+        const auto activ_op = std::dynamic_pointer_cast<ActivBwdFusionOpDescriptor>(ops.front());
+        const auto bias_op  = ops.back();
+        const auto& lengths = desc.GetLengths();
+        const auto channels = lengths[1];
+        const auto pixels   = std::accumulate(
+            lengths.begin() + 2, lengths.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+        const auto is_fp16 = desc.GetType() == miopenHalf;
+        const auto local   = std::size_t{256};
+
+        auto build_params = KernelBuildParameters{
+            {"MIOPEN_USE_FP16", is_fp16 ? 1 : 0},
+            {"MIOPEN_USE_FP32", is_fp16 ? 0 : 1},
+            {"MIOPEN_BWD_N", lengths[0]},
+            {"MIOPEN_BWD_C", channels},
+            {"MIOPEN_BWD_HW", pixels},
+            {"MIOPEN_BWD_CHANNELS_LAST", IsChannelsLast(desc) ? 1 : 0},
+            {"MIOPEN_BWD_LOCAL_SIZE", local},
+            {"MIOPEN_BWD_ACTIV", activ_op != nullptr ? 1 : 0},
+        };
+        if(activ_op != nullptr)
+            build_params.Define("MIOPEN_NRN_OP_ID", static_cast<int>(activ_op->activMode));
+
+        const auto algorithm      = std::string{"miopenFusionBiasBwd"};
+        const auto network_config = build_params.GenerateFor(kbp::OpenCL{});
+        if(handle.GetKernels(algorithm, network_config).empty())
+            handle.AddKernel(algorithm,
+                             network_config,
+                             "MIOpenFusionBiasBwd.cl",
+                             "MIOpenFusionBiasBwd",
+                             {local, 1, 1},
+                             {channels * local, 1, 1},
+                             network_config);
+
+        return FusionPatternInvoker{[=](const Handle& h,
+                                        ConstData_t input,
+                                        Data_t output,
+                                        const OperatorArgs& op_args) {
+            const auto dbias = GetOpArg(op_args, bias_op->GetArgKey("dbias"));
+            std::vector<OpKernelArg> args{OpKernelArg(input), OpKernelArg(output), dbias};
+            const auto push = [&](const char* name) {
+                args.push_back(GetOpArg(op_args, activ_op->GetArgKey(name)));
+            };
+            if(activ_op != nullptr)
+            {
+                if(GetOpPointer<ConstData_t>(op_args, activ_op->GetArgKey("x")) == nullptr)
+                    MIOPEN_THROW(miopenStatusBadParm,
+                                 "The activation backward op needs the input of the activation");
+                push("x");
+                push("y");
+                push("activDiffScale");
+                push("activGamma");
+                push("activBeta");
+                push("activAlpha");
+            }
+
+            auto&& kernels = h.GetKernels(algorithm, network_config);
+            if(kernels.empty())
+                MIOPEN_THROW(miopenStatusBadParm, "The FusionPlan was not compiled for execution");
+            kernels.front()(args);
+        }};
+    }
+
+    private:
+    static boost::optional<FusionPatternInvoker>
+    CompileAfterBatchNorm(Handle& handle, const FusionPatternProblem& problem)
+    {
+        const auto& ops = problem.ops;
+        auto head =
+            std::make_shared<FusionPlanDescriptor>(miopenVerticalFusion, problem.input_desc);
+        for(auto it = ops.begin(); it != std::prev(ops.end()); ++it)
+        {
+            if(head->AddOp(*it) != miopenStatusSuccess)
+                return boost::none;
+        }
+        try
+        {
+            if(head->Compile(handle) != miopenStatusSuccess)
+                return boost::none;
+        }
+        catch(const miopen::Exception& ex)
+        {
+            MIOPEN_LOG_I2(ex.what());
+            return boost::none;
+        }
+
+        const auto bias_op = std::dynamic_pointer_cast<BiasBwdFusionOpDescriptor>(ops.back());
+        const auto& desc   = problem.input_desc;
+        return FusionPatternInvoker{[=](const Handle& h,
+                                        ConstData_t input,
+                                        Data_t output,
+                                        const OperatorArgs& op_args) {
+            head->Execute(h, desc, input, desc, output, op_args);
+            float elapsed = 0;
+            if(h.IsProfilingEnabled())
+                elapsed += h.GetKernelTime();
+            const auto zero = 0.0f;
+            SetTensor(h,
+                      bias_op->base_desc,
+                      GetOpPointer<Data_t>(op_args, bias_op->GetArgKey("dbias")),
+                      &zero);
+            if(h.IsProfilingEnabled())
+            {
+                elapsed += h.GetKernelTime();
+                h.ResetKernelTime();
+                h.AccumKernelTime(elapsed);
+            }
+        }};
+    }
+};
+
+const std::vector<std::unique_ptr<FusionPattern>>& GetFusionPatterns()
+{
+    static const auto patterns = [] {
+        auto list = std::vector<std::unique_ptr<FusionPattern>>{};
+        list.emplace_back(std::make_unique<ConvBnFoldPattern>());
+        list.emplace_back(std::make_unique<ConvEpiloguePattern>());
+        list.emplace_back(std::make_unique<ConvBnTrainPattern>());
+        list.emplace_back(std::make_unique<PoolingPattern>());
+        list.emplace_back(std::make_unique<BiasBwdPattern>());
+        list.emplace_back(std::make_unique<EpiloguePattern>());
+        return list;
+    }();
+    return patterns;
+}
+
+} // namespace
+
+const FusionPattern* FindFusionPattern(const FusionPatternProblem& problem)
+{
+    for(const auto& pattern : GetFusionPatterns())
+    {
+        if(pattern->IsApplicable(problem))
+            return pattern.get();
+    }
+    return nullptr;
+}
+
+} // namespace miopen
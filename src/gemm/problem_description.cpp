@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/gemm/problem_description.hpp>
+#include <miopen/float_equal.hpp>
+
+#include <sstream>
+
+namespace miopen {
+
+namespace gemm {
+
+ProblemDescription::ProblemDescription(const GemmDescriptor& desc_, bool strided_batched_)
+    : desc(desc_), strided_batched(strided_batched_)
+{
+    if(!strided_batched)
+    {
+        desc.batch_count = 1;
+        desc.strideA     = 0;
+        desc.strideB     = 0;
+        desc.strideC     = 0;
+    }
+}
+
+bool ProblemDescription::IsBetaZero() const { return float_equal(desc.beta, 0); }
+
+std::string ProblemDescription::GetStridesName() const
+{
+    std::ostringstream ss;
+    ss << desc.strideA << 'x' << desc.strideB << 'x' << desc.strideC;
+    return ss.str();
+}
+
+void ProblemDescription::Serialize(std::ostream& stream) const
+{
+    const auto sep = '-';
+
+    stream << (desc.transA ? 't' : 'n') << (desc.transB ? 't' : 'n');
+    stream << sep << desc.m << 'x' << desc.n << 'x' << desc.k;
+    stream << sep << desc.lda << 'x' << desc.ldb << 'x' << desc.ldc;
+    stream << sep << 'b' << desc.batch_count << sep << GetStridesName();
+    stream << sep << GetDataTypeName(desc.dataType);
+    stream << sep << "beta" << static_cast<int>(!IsBetaZero());
+}
+
+} // namespace gemm
+
+} // namespace miopen
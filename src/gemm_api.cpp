@@ -0,0 +1,258 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/errors.hpp>
+#include <miopen/gemm_v2.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+static std::ostream& operator<<(std::ostream& stream, const miopenGemmProblem_t& problem)
+{
+    return stream << "{"
+                  << "isColMajor " << problem.isColMajor << ", "
+                  << "transA " << problem.transA << ", "
+                  << "transB " << problem.transB << ", "
+                  << "m " << problem.m << ", "
+                  << "n " << problem.n << ", "
+                  << "k " << problem.k << ", "
+                  << "lda " << problem.lda << ", "
+                  << "ldb " << problem.ldb << ", "
+                  << "ldc " << problem.ldc << ", "
+                  << "batchCount " << problem.batchCount << ", "
+                  << "strideA " << problem.strideA << ", "
+                  << "strideB " << problem.strideB << ", "
+                  << "strideC " << problem.strideC << ", "
+                  << "alpha " << problem.alpha << ", "
+                  << "beta " << problem.beta << ", "
+                  << "dataType " << problem.dataType << "} ";
+}
+
+namespace {
+
+#if MIOPEN_USE_GEMM
+miopen::GemmDescriptor MakeGemmDescriptor(const miopenGemmProblem_t* problem)
+{
+    const auto& p = miopen::deref(problem);
+    if(p.dataType != miopenFloat && p.dataType != miopenHalf && p.dataType != miopenBFloat16)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "GEMMs are only supported for float types");
+    }
+    if(p.m <= 0 || p.n <= 0 || p.k <= 0 || p.batchCount <= 0)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "The sizes of the GEMM must be positive");
+    }
+
+    auto desc        = miopen::GemmDescriptor{};
+    desc.isColMajor  = p.isColMajor;
+    desc.transA      = p.transA;
+    desc.transB      = p.transB;
+    desc.m           = p.m;
+    desc.n           = p.n;
+    desc.k           = p.k;
+    desc.lda         = p.lda;
+    desc.ldb         = p.ldb;
+    desc.ldc         = p.ldc;
+    desc.batch_count = p.batchCount;
+    desc.strideA     = p.strideA;
+    desc.strideB     = p.strideB;
+    desc.strideC     = p.strideC;
+    desc.alpha       = p.alpha;
+    desc.beta        = p.beta;
+    desc.dataType    = p.dataType;
+    return desc;
+}
+
+// The values of the public backends are the ones of GemmBackend_t
+miopen::GemmBackend_t GetGemmBackend(const miopen::Handle& handle,
+                                     const miopen::GemmDescriptor& desc,
+                                     miopenGemmBackend_t backend)
+{
+    if(backend == miopenGemmBackendDefault)
+        return miopen::GetGemmBackend(handle, desc);
+    if(backend < miopenGemmBackendRocBlas || backend > miopenGemmBackendHipBlasLt)
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown GEMM backend");
+    return static_cast<miopen::GemmBackend_t>(backend);
+}
+
+void CheckGemmStatus(miopenStatus_t status)
+{
+    if(status != miopenStatusSuccess)
+        MIOPEN_THROW(status, "The GEMM backend failed");
+}
+#else
+void ThrowNoGemm() { MIOPEN_THROW(miopenStatusNotImplemented, "MIOpen is built without GEMMs"); }
+#endif
+
+} // namespace
+
+extern "C" miopenStatus_t miopenGemmGetWorkSpaceSize(miopenHandle_t handle,
+                                                     const miopenGemmProblem_t* problem,
+                                                     size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, problem, workSpaceSize);
+    return miopen::try_([&] {
+#if MIOPEN_USE_GEMM
+        MakeGemmDescriptor(problem);
+        miopen::deref(workSpaceSize) = 0;
+#else
+        std::ignore = problem;
+        std::ignore = workSpaceSize;
+        ThrowNoGemm();
+#endif
+    });
+}
+
+extern "C" miopenStatus_t miopenFindGemmBackend(miopenHandle_t handle,
+                                                const miopenGemmProblem_t* problem,
+                                                const void* A,
+                                                const void* B,
+                                                miopenGemmBackend_t* backend,
+                                                float* time)
+{
+    MIOPEN_LOG_FUNCTION(handle, problem, A, B, backend, time);
+    return miopen::try_([&] {
+#if MIOPEN_USE_GEMM
+        auto& h         = miopen::deref(handle);
+        float best_time = 0;
+        const auto best = miopen::FindGemmBackend(
+            h, MakeGemmDescriptor(problem), DataCast(A), DataCast(B), best_time);
+        if(best == miopen::GemmBackend_t::nogemmbackend)
+            MIOPEN_THROW(miopenStatusNotImplemented, "No GEMM backend runs the GEMM");
+        miopen::deref(backend) = static_cast<miopenGemmBackend_t>(best);
+        if(time != nullptr)
+            *time = best_time;
+#else
+        std::ignore = std::tie(problem, A, B, backend, time);
+        ThrowNoGemm();
+#endif
+    });
+}
+
+extern "C" miopenStatus_t miopenGemm(miopenHandle_t handle,
+                                     const miopenGemmProblem_t* problem,
+                                     miopenGemmBackend_t backend,
+                                     const void* A,
+                                     const void* B,
+                                     void* C,
+                                     void* workSpace,
+                                     size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, problem, backend, A, B, C, workSpace, workSpaceSize);
+    return miopen::try_([&] {
+#if MIOPEN_USE_GEMM
+        auto& h           = miopen::deref(handle);
+        const auto desc   = MakeGemmDescriptor(problem);
+        const auto chosen = GetGemmBackend(h, desc, backend);
+        CheckGemmStatus(
+            desc.batch_count > 1
+                ? miopen::CallGemmStridedBatched(
+                      h, desc, DataCast(A), 0, DataCast(B), 0, DataCast(C), 0, nullptr, chosen)
+                : miopen::CallGemm(
+                      h, desc, DataCast(A), 0, DataCast(B), 0, DataCast(C), 0, nullptr, chosen));
+#else
+        std::ignore = std::tie(problem, backend, A, B, C);
+        ThrowNoGemm();
+#endif
+        std::ignore = std::tie(workSpace, workSpaceSize);
+    });
+}
+
+extern "C" miopenStatus_t miopenGemmGrouped(miopenHandle_t handle,
+                                            int problemCount,
+                                            const miopenGemmProblem_t* problems,
+                                            miopenGemmBackend_t backend,
+                                            const void* const* A,
+                                            const void* const* B,
+                                            void* const* C)
+{
+    MIOPEN_LOG_FUNCTION(handle, problemCount, problems, backend, A, B, C);
+    return miopen::try_([&] {
+#if MIOPEN_USE_GEMM
+        auto& h = miopen::deref(handle);
+        if(problemCount <= 0)
+        {
+            MIOPEN_THROW(miopenStatusBadParm, "The group has no GEMM");
+        }
+        if(problems == nullptr || A == nullptr || B == nullptr || C == nullptr)
+        {
+            MIOPEN_THROW(miopenStatusBadParm, "The GEMMs and their matrices cannot be null");
+        }
+
+        auto group = std::vector<miopen::GemmProblem>{};
+        for(auto i = 0; i < problemCount; ++i)
+        {
+            const auto desc = MakeGemmDescriptor(problems + i);
+            if(desc.batch_count != 1)
+            {
+                MIOPEN_THROW(miopenStatusBadParm, "The GEMMs of a group are not batched");
+            }
+            group.push_back({desc, DataCast(A[i]), 0, DataCast(B[i]), 0, DataCast(C[i]), 0});
+        }
+
+#if MIOPEN_BACKEND_HIP
+        // The matrices of the GEMMs of a data type are rebased on the lowest ones, so that the
+        // ones in a single buffer can run as a strided batched GEMM
+        const auto rebase = [&](auto matrix, auto offset) {
+            for(auto& p : group)
+            {
+                auto base = p.*matrix;
+                for(const auto& q : group)
+                {
+                    if(q.desc.dataType == p.desc.dataType && q.*matrix < base)
+                        base = q.*matrix;
+                }
+                const auto size =
+                    static_cast<std::ptrdiff_t>(miopen::GetTypeSize(p.desc.dataType));
+                const auto bytes =
+                    static_cast<const char*>(p.*matrix) - static_cast<const char*>(base);
+                if(bytes % size == 0 && bytes / size <= std::numeric_limits<int>::max())
+                {
+                    p.*offset = static_cast<int>(bytes / size);
+                    p.*matrix = base;
+                }
+            }
+        };
+        rebase(&miopen::GemmProblem::A, &miopen::GemmProblem::a_offset);
+        rebase(&miopen::GemmProblem::B, &miopen::GemmProblem::b_offset);
+        rebase(&miopen::GemmProblem::C, &miopen::GemmProblem::c_offset);
+#endif
+
+        CheckGemmStatus(
+            miopen::CallGemmGrouped(h, group, GetGemmBackend(h, group.front().desc, backend)));
+#else
+        std::ignore = std::tie(problemCount, problems, backend, A, B, C);
+        ThrowNoGemm();
+#endif
+    });
+}
@@ -29,6 +29,11 @@
 #include <miopen/tensor.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/finddb_kernel_cache_key.hpp>
+#include <miopen/db.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/gemm/problem_description.hpp>
+#include <miopen/memory_usage.hpp>
+#include <miopen/mlo_internal.hpp>
 
 #if MIOPEN_BACKEND_HIP
 #include <miopen/hipoc_kernel.hpp>
@@ -41,15 +46,44 @@
 #if MIOPEN_USE_ROCBLAS
 #include <half.hpp>
 #include <rocblas.h>
+#include <miopen/find_controls.hpp>
 #include <miopen/perf_field.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
 #endif
 
 #if MIOPEN_USE_MIOPENGEMM
 #include <miopen/miopengemm.hpp>
 #endif
 
+#if MIOPEN_USE_HIPBLASLT
+#include <hipblaslt/hipblaslt.h>
+#include <miopen/manage_ptr.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <sstream>
+#endif
+
 #include <boost/range/adaptors.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
 #if MIOPEN_USE_ROCBLAS
 
 #define MIOPEN_ROCBLAS_VERSION_DECIMAL (ROCBLAS_VERSION_MAJOR * 100 + ROCBLAS_VERSION_MINOR)
@@ -61,6 +95,9 @@
 /// Maintain API compatibility with various rocBLAS version
 #define USE_GEMM_FLAGS_PACK_INT8X4 (MIOPEN_ROCBLAS_VERSION_DECIMAL >= 238)
 
+/// The solutions of a GEMM can be listed and selected by index, see GetRocblasSolution().
+#define USE_GEMM_SOLUTION_INDEX (MIOPEN_ROCBLAS_VERSION_DECIMAL >= 300)
+
 template <class... Ts>
 auto miopen_rocblas_gemm_ex(Ts... xs)
 {
@@ -86,6 +123,8 @@ auto miopen_rocblas_gemm_strided_batched_ex(Ts... xs)
 #endif // MIOPEN_USE_ROCBLAS
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_GEMM_ENFORCE_BACKEND)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ROCBLAS_SOLUTION_SEARCH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GEMM_TIMING_TARGET_US)
 
 namespace miopen {
 
@@ -111,14 +150,18 @@ std::ostream& operator<<(std::ostream& stream, const GemmDescriptor& gemm_desc)
 }
 
 #if MIOPEN_BACKEND_HIP
-inline void ProfilingRecordStart(const Handle& handle, HipEventPtr& start, HipEventPtr& stop)
+inline void ProfilingRecordStart(const Handle& handle,
+                                 HipEventPool::EventPtr& start,
+                                 HipEventPool::EventPtr& stop)
 {
-    start = make_hip_event();
-    stop  = make_hip_event();
+    start = handle.GetEventPool().Get();
+    stop  = handle.GetEventPool().Get();
     hipEventRecord(start.get(), handle.GetStream());
 }
 
-inline void ProfilingRecordStop(const Handle& handle, HipEventPtr& start, HipEventPtr& stop)
+inline void ProfilingRecordStop(const Handle& handle,
+                                HipEventPool::EventPtr& start,
+                                HipEventPool::EventPtr& stop)
 {
     hipEventRecord(stop.get(), handle.GetStream());
     hipEventSynchronize(stop.get());
@@ -129,6 +172,738 @@ inline void ProfilingRecordStop(const Handle& handle, HipEventPtr& start, HipEve
 }
 #endif
 
+#if MIOPEN_USE_ROCBLAS
+namespace {
+
+// Set while CallGemmTimeMeasure() runs, i.e. while the GEMM is timed by a search.
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+thread_local bool searching_gemm = false;
+
+struct SearchingGemmScope
+{
+    explicit SearchingGemmScope(bool searching) : previous(searching_gemm)
+    {
+        searching_gemm = previous || searching;
+    }
+    ~SearchingGemmScope() { searching_gemm = previous; }
+    SearchingGemmScope(const SearchingGemmScope&) = delete;
+    SearchingGemmScope& operator=(const SearchingGemmScope&) = delete;
+
+    private:
+    bool previous;
+};
+
+struct RocblasSolution
+{
+    rocblas_gemm_algo algo = rocblas_gemm_algo::rocblas_gemm_algo_standard;
+    rocblas_int index      = 0;
+};
+
+#if USE_GEMM_SOLUTION_INDEX
+static const char* const perf_db_id = "rocBlasGemm";
+
+/// The rocBLAS types of a GEMM of MIOpen, the same as the ones used by CallGemm().
+struct RocblasTypes
+{
+    rocblas_datatype ab;
+    rocblas_datatype c;
+    rocblas_datatype compute;
+    std::size_t ab_size;
+    std::size_t c_size;
+    std::uint32_t flags;
+};
+
+bool GetRocblasTypes(miopenDataType_t type, RocblasTypes& types)
+{
+    switch(type)
+    {
+    case miopenInt8x4:
+    case miopenInt8:
+        types = {rocblas_datatype::rocblas_datatype_i8_r,
+                 rocblas_datatype::rocblas_datatype_i32_r,
+                 rocblas_datatype::rocblas_datatype_i32_r,
+                 1,
+                 4,
+                 rocblas_gemm_flags_pack_int8x4};
+        return true;
+    case miopenHalf:
+        types = {rocblas_datatype::rocblas_datatype_f16_r,
+                 rocblas_datatype::rocblas_datatype_f16_r,
+                 rocblas_datatype::rocblas_datatype_f32_r,
+                 2,
+                 2,
+                 0};
+        return true;
+    case miopenBFloat16:
+        types = {rocblas_datatype::rocblas_datatype_bf16_r,
+                 rocblas_datatype::rocblas_datatype_bf16_r,
+                 rocblas_datatype::rocblas_datatype_f32_r,
+                 2,
+                 2,
+                 0};
+        return true;
+    case miopenFloat:
+        types = {rocblas_datatype::rocblas_datatype_f32_r,
+                 rocblas_datatype::rocblas_datatype_f32_r,
+                 rocblas_datatype::rocblas_datatype_f32_r,
+                 4,
+                 4,
+                 0};
+        return true;
+    case miopenInt32:
+    case miopenDouble: break;
+    }
+    return false;
+}
+
+/// The arguments of rocblas_gemm_ex() and rocblas_gemm_strided_batched_ex(), apart from the
+/// solution. C is also the output.
+struct RocblasGemmArgs
+{
+    const GemmDescriptor& desc;
+    bool strided_batched;
+    RocblasTypes types;
+    const void* a;
+    const void* b;
+    void* c;
+    int alpha_i;
+    int beta_i;
+
+    const void* Alpha() const
+    {
+        return types.compute == rocblas_datatype::rocblas_datatype_i32_r
+                   ? static_cast<const void*>(&alpha_i)
+                   : static_cast<const void*>(&desc.alpha);
+    }
+    const void* Beta() const
+    {
+        return types.compute == rocblas_datatype::rocblas_datatype_i32_r
+                   ? static_cast<const void*>(&beta_i)
+                   : static_cast<const void*>(&desc.beta);
+    }
+
+    /// Runs the GEMM with the solution, or only checks the solution with
+    /// rocblas_gemm_flags_check_solution_index.
+    rocblas_status Run(const Handle& handle, const RocblasSolution& solution, std::uint32_t flags)
+    {
+        const auto op_a = desc.transA ? rocblas_operation_transpose : rocblas_operation_none;
+        const auto op_b = desc.transB ? rocblas_operation_transpose : rocblas_operation_none;
+        if(strided_batched)
+        {
+            return miopen_rocblas_gemm_strided_batched_ex(handle.rhandle().get(),
+                                                          op_a,
+                                                          op_b,
+                                                          desc.m,
+                                                          desc.n,
+                                                          desc.k,
+                                                          Alpha(),
+                                                          a,
+                                                          types.ab,
+                                                          desc.lda,
+                                                          desc.strideA,
+                                                          b,
+                                                          types.ab,
+                                                          desc.ldb,
+                                                          desc.strideB,
+                                                          Beta(),
+                                                          c,
+                                                          types.c,
+                                                          desc.ldc,
+                                                          desc.strideC,
+                                                          c,
+                                                          types.c,
+                                                          desc.ldc,
+                                                          desc.strideC,
+                                                          desc.batch_count,
+                                                          types.compute,
+                                                          solution.algo,
+                                                          solution.index,
+                                                          types.flags | flags);
+        }
+        return miopen_rocblas_gemm_ex(handle.rhandle().get(),
+                                      op_a,
+                                      op_b,
+                                      desc.m,
+                                      desc.n,
+                                      desc.k,
+                                      Alpha(),
+                                      a,
+                                      types.ab,
+                                      desc.lda,
+                                      b,
+                                      types.ab,
+                                      desc.ldb,
+                                      Beta(),
+                                      c,
+                                      types.c,
+                                      desc.ldc,
+                                      c,
+                                      types.c,
+                                      desc.ldc,
+                                      types.compute,
+                                      solution.algo,
+                                      solution.index,
+                                      types.flags | flags);
+    }
+
+    /// The indices of the solutions that rocBLAS has for the GEMM.
+    std::vector<rocblas_int> GetSolutions(const Handle& handle) const
+    {
+        const auto op_a = desc.transA ? rocblas_operation_transpose : rocblas_operation_none;
+        const auto op_b = desc.transB ? rocblas_operation_transpose : rocblas_operation_none;
+        const auto algo = rocblas_gemm_algo::rocblas_gemm_algo_solution_index;
+
+        const auto query = [&](rocblas_int* list, rocblas_int* size) {
+            if(strided_batched)
+            {
+                return rocblas_gemm_strided_batched_ex_get_solutions(handle.rhandle().get(),
+                                                                     op_a,
+                                                                     op_b,
+                                                                     desc.m,
+                                                                     desc.n,
+                                                                     desc.k,
+                                                                     Alpha(),
+                                                                     a,
+                                                                     types.ab,
+                                                                     desc.lda,
+                                                                     desc.strideA,
+                                                                     b,
+                                                                     types.ab,
+                                                                     desc.ldb,
+                                                                     desc.strideB,
+                                                                     Beta(),
+                                                                     c,
+                                                                     types.c,
+                                                                     desc.ldc,
+                                                                     desc.strideC,
+                                                                     c,
+                                                                     types.c,
+                                                                     desc.ldc,
+                                                                     desc.strideC,
+                                                                     desc.batch_count,
+                                                                     types.compute,
+                                                                     algo,
+                                                                     types.flags,
+                                                                     list,
+                                                                     size);
+            }
+            return rocblas_gemm_ex_get_solutions(handle.rhandle().get(),
+                                                 op_a,
+                                                 op_b,
+                                                 desc.m,
+                                                 desc.n,
+                                                 desc.k,
+                                                 Alpha(),
+                                                 a,
+                                                 types.ab,
+                                                 desc.lda,
+                                                 b,
+                                                 types.ab,
+                                                 desc.ldb,
+                                                 Beta(),
+                                                 c,
+                                                 types.c,
+                                                 desc.ldc,
+                                                 c,
+                                                 types.c,
+                                                 desc.ldc,
+                                                 types.compute,
+                                                 algo,
+                                                 types.flags,
+                                                 list,
+                                                 size);
+        };
+
+        rocblas_int size = 0;
+        if(query(nullptr, &size) != rocblas_status::rocblas_status_success || size <= 0)
+            return {};
+        auto solutions = std::vector<rocblas_int>(size);
+        if(query(solutions.data(), &size) != rocblas_status::rocblas_status_success)
+            return {};
+        solutions.resize(size);
+        return solutions;
+    }
+};
+
+/// Times the runs of the GEMM with the solution, in ms, or returns infinity if it fails.
+float TimeRocblasSolution(const Handle& handle, RocblasGemmArgs& args, const RocblasSolution& sln)
+{
+    constexpr int runs = 3;
+
+    // The first run may load the code object.
+    if(args.Run(handle, sln, 0) != rocblas_status::rocblas_status_success)
+        return std::numeric_limits<float>::infinity();
+
+    auto start = handle.GetEventPool().Get();
+    auto stop  = handle.GetEventPool().Get();
+    hipEventRecord(start.get(), handle.GetStream());
+    for(auto i = 0; i < runs; ++i)
+        args.Run(handle, sln, 0);
+    hipEventRecord(stop.get(), handle.GetStream());
+    hipEventSynchronize(stop.get());
+    float ms = 0;
+    hipEventElapsedTime(&ms, start.get(), stop.get());
+    return ms / runs;
+}
+#endif
+
+/// The rocBLAS solution of a column-major GEMM. The solutions tuned by the searches are stored
+/// in the perf-db and looked up once per process and device. The searches that time the GEMM
+/// (CallGemmTimeMeasure) also benchmark all the solutions listed by rocBLAS when the perf-db has
+/// no record for it, into a temporary output, and keep the default solution unless one is faster.
+RocblasSolution GetRocblasSolution(const Handle& handle,
+                                   const GemmDescriptor& gemm_desc,
+                                   bool strided_batched,
+                                   ConstData_t A,
+                                   int a_offset,
+                                   ConstData_t B,
+                                   int b_offset,
+                                   Data_t C,
+                                   int c_offset)
+{
+#if USE_GEMM_SOLUTION_INDEX
+    if(miopen::IsDisabled(MIOPEN_DEBUG_ROCBLAS_SOLUTION_SEARCH{}))
+        return {};
+
+    auto args = RocblasGemmArgs{gemm_desc,
+                                strided_batched,
+                                {},
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                static_cast<int>(gemm_desc.alpha),
+                                static_cast<int>(gemm_desc.beta)};
+    if(!GetRocblasTypes(gemm_desc.dataType, args.types))
+        return {};
+
+    // Whether the record was settled by a search goes along with it, so that a search only
+    // runs once, e.g. not again for the timed run after the warm-up.
+    static std::mutex mutex;
+    static std::map<std::string, std::pair<gemm::PerformanceConfigGemm, bool>> loaded;
+
+    const auto problem = gemm::ProblemDescription{gemm_desc, strided_batched};
+    // The context only locates the perf-db and reads the find controls.
+    const auto ctx     = ExecutionContext{const_cast<Handle*>(&handle)}; // NOLINT
+    const auto enforce = FindEnforce{};
+    const auto search  = searching_gemm;
+
+    std::ostringstream key;
+    key << handle.GetDbBasename() << ':' << problem;
+
+    const auto to_solution = [](const gemm::PerformanceConfigGemm& config) {
+        auto solution = RocblasSolution{};
+        if(config.solution_index != 0)
+        {
+            solution.algo  = rocblas_gemm_algo::rocblas_gemm_algo_solution_index;
+            solution.index = config.solution_index;
+        }
+        return solution;
+    };
+
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto it = loaded.find(key.str());
+        if(it != loaded.end() && (!search || it->second.second))
+            return to_solution(it->second.first);
+    }
+
+    // Nothing is written to C but by the timed runs, which use a temporary buffer.
+    args.a = static_cast<const char*>(A) + a_offset * args.types.ab_size;
+    args.b = static_cast<const char*>(B) + b_offset * args.types.ab_size;
+    args.c = static_cast<char*>(C) + c_offset * args.types.c_size;
+
+    auto db     = GetDb(ctx);
+    auto config = gemm::PerformanceConfigGemm{};
+
+    if(!(search && enforce.IsDbUpdate(ctx)))
+    {
+        // The indices of another version of rocBLAS, or of another build of its kernels, are
+        // not reused.
+        if(db.Load(problem, perf_db_id, config) &&
+           config.rocblas_version == MIOPEN_ROCBLAS_VERSION_DECIMAL &&
+           (config.solution_index == 0 ||
+            args.Run(handle, to_solution(config), rocblas_gemm_flags_check_solution_index) ==
+                rocblas_status::rocblas_status_success))
+        {
+            MIOPEN_LOG_I2("Perf Db: record loaded: " << config);
+            const std::lock_guard<std::mutex> lock(mutex);
+            loaded[key.str()] = {config, search};
+            return to_solution(config);
+        }
+        config = gemm::PerformanceConfigGemm{};
+    }
+
+    if(search)
+    {
+        const auto c_elements = (strided_batched ? gemm_desc.strideC * (gemm_desc.batch_count - 1)
+                                                 : 0) +
+                                static_cast<long long>(gemm_desc.ldc) * gemm_desc.n;
+        const MemoryCategoryScope category{MemoryCategory::Search};
+        const auto c   = handle.Create(c_elements * args.types.c_size);
+        const auto all = args.GetSolutions(handle);
+        args.c         = c.get();
+
+        auto best_time = TimeRocblasSolution(handle, args, {});
+        MIOPEN_LOG_I2("default: " << best_time << " ms");
+        for(const auto index : all)
+        {
+            const auto solution = RocblasSolution{
+                rocblas_gemm_algo::rocblas_gemm_algo_solution_index, index};
+            const auto time = TimeRocblasSolution(handle, args, solution);
+            MIOPEN_LOG_I2(index << ": " << time << " ms");
+            if(time < best_time)
+            {
+                best_time             = time;
+                config.solution_index = index;
+            }
+        }
+
+        config.rocblas_version = MIOPEN_ROCBLAS_VERSION_DECIMAL;
+        MIOPEN_LOG_I("rocBLAS GEMM " << problem << ": " << config << ", " << best_time << " ms");
+        db.Update(problem, perf_db_id, config);
+    }
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    loaded[key.str()] = {config, search};
+    return to_solution(config);
+#else
+    std::ignore = handle;
+    std::ignore = gemm_desc;
+    std::ignore = strided_batched;
+    std::ignore = A;
+    std::ignore = a_offset;
+    std::ignore = B;
+    std::ignore = b_offset;
+    std::ignore = C;
+    std::ignore = c_offset;
+    return {};
+#endif
+}
+
+} // namespace
+#endif // MIOPEN_USE_ROCBLAS
+
+#if MIOPEN_USE_HIPBLASLT
+namespace {
+
+using matmul_desc_ptr   = MIOPEN_MANAGE_PTR(hipblasLtMatmulDesc_t, hipblasLtMatmulDescDestroy);
+using matrix_layout_ptr = MIOPEN_MANAGE_PTR(hipblasLtMatrixLayout_t, hipblasLtMatrixLayoutDestroy);
+using matmul_pref_ptr =
+    MIOPEN_MANAGE_PTR(hipblasLtMatmulPreference_t, hipblasLtMatmulPreferenceDestroy);
+
+void CheckHipblasLt(hipblasStatus_t status, const char* what)
+{
+    if(status != HIPBLAS_STATUS_SUCCESS)
+        MIOPEN_THROW(miopenStatusInternalError,
+                     std::string{what} + " failed: " + std::to_string(static_cast<int>(status)));
+}
+
+bool GetHipblasLtType(miopenDataType_t type, hipDataType& result)
+{
+    switch(type)
+    {
+    case miopenHalf: result = HIP_R_16F; return true;
+    case miopenFloat: result = HIP_R_32F; return true;
+    case miopenBFloat16: result = HIP_R_16BF; return true;
+    case miopenInt8x4:
+    case miopenInt8:
+    case miopenInt32:
+    case miopenDouble: break;
+    }
+    return false;
+}
+
+hipblasLtEpilogue_t GetHipblasLtEpilogue(const GemmEpilogue& epilogue)
+{
+    switch(epilogue.activation)
+    {
+    case GemmActivation::None:
+        return epilogue.bias ? HIPBLASLT_EPILOGUE_BIAS : HIPBLASLT_EPILOGUE_DEFAULT;
+    case GemmActivation::Relu:
+        return epilogue.bias ? HIPBLASLT_EPILOGUE_RELU_BIAS : HIPBLASLT_EPILOGUE_RELU;
+    case GemmActivation::Gelu:
+        if(epilogue.aux)
+            return epilogue.bias ? HIPBLASLT_EPILOGUE_GELU_AUX_BIAS : HIPBLASLT_EPILOGUE_GELU_AUX;
+        return epilogue.bias ? HIPBLASLT_EPILOGUE_GELU_BIAS : HIPBLASLT_EPILOGUE_GELU;
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown GEMM activation");
+}
+
+/// The hipBLASLt descriptors of a column-major GEMM, which is strided batched if batch_count > 1.
+/// The accumulation is in fp32 for all the data types.
+class HipblasLtGemm
+{
+    public:
+    HipblasLtGemm(const Handle& handle_,
+                  const GemmDescriptor& desc_,
+                  const GemmEpilogue& epilogue_,
+                  hipDataType type_)
+        : handle(handle_), desc(desc_), epilogue(epilogue_), type(type_)
+    {
+        assert(desc.isColMajor);
+
+        hipblasLtMatmulDesc_t raw = nullptr;
+        CheckHipblasLt(hipblasLtMatmulDescCreate(&raw, HIPBLAS_COMPUTE_32F, HIP_R_32F),
+                       "hipblasLtMatmulDescCreate");
+        matmul = matmul_desc_ptr{raw};
+
+        SetAttribute(HIPBLASLT_MATMUL_DESC_TRANSA, desc.transA ? HIPBLAS_OP_T : HIPBLAS_OP_N);
+        SetAttribute(HIPBLASLT_MATMUL_DESC_TRANSB, desc.transB ? HIPBLAS_OP_T : HIPBLAS_OP_N);
+        SetAttribute(HIPBLASLT_MATMUL_DESC_EPILOGUE, GetHipblasLtEpilogue(epilogue));
+        if(epilogue.bias)
+            SetAttribute(HIPBLASLT_MATMUL_DESC_BIAS_DATA_TYPE, type);
+        if(epilogue.aux)
+        {
+            SetAttribute(HIPBLASLT_MATMUL_DESC_EPILOGUE_AUX_LD, static_cast<int64_t>(desc.ldc));
+            if(IsBatched())
+                SetAttribute(HIPBLASLT_MATMUL_DESC_EPILOGUE_AUX_BATCH_STRIDE,
+                             static_cast<int64_t>(desc.strideC));
+        }
+
+        a = MakeLayout(desc.transA ? desc.k : desc.m,
+                       desc.transA ? desc.m : desc.k,
+                       desc.lda,
+                       desc.strideA);
+        b = MakeLayout(desc.transB ? desc.n : desc.k,
+                       desc.transB ? desc.k : desc.n,
+                       desc.ldb,
+                       desc.strideB);
+        c = MakeLayout(desc.m, desc.n, desc.ldc, desc.strideC);
+    }
+
+    /// The best algorithm by the heuristics of hipBLASLt which needs no workspace, none if the
+    /// GEMM is not supported. Looked up once per device and GEMM.
+    boost::optional<hipblasLtMatmulAlgo_t> GetAlgo() const
+    {
+        std::ostringstream ss;
+        ss << handle.GetDbBasename() << ':' << desc << static_cast<int>(epilogue.activation)
+           << epilogue.bias << epilogue.aux;
+        const auto key = ss.str();
+
+        static std::mutex mutex;
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static auto algos = std::map<std::string, boost::optional<hipblasLtMatmulAlgo_t>>{};
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto found = algos.find(key);
+        if(found != algos.end())
+            return found->second;
+
+        hipblasLtMatmulPreference_t raw = nullptr;
+        CheckHipblasLt(hipblasLtMatmulPreferenceCreate(&raw), "hipblasLtMatmulPreferenceCreate");
+        const auto pref      = matmul_pref_ptr{raw};
+        const auto workspace = uint64_t{0};
+        CheckHipblasLt(
+            hipblasLtMatmulPreferenceSetAttribute(pref.get(),
+                                                  HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                                  &workspace,
+                                                  sizeof(workspace)),
+            "hipblasLtMatmulPreferenceSetAttribute");
+
+        hipblasLtMatmulHeuristicResult_t result{};
+        int returned      = 0;
+        const auto status = hipblasLtMatmulAlgoGetHeuristic(handle.GetHipblasLtHandle(),
+                                                            matmul.get(),
+                                                            a.get(),
+                                                            b.get(),
+                                                            c.get(),
+                                                            c.get(),
+                                                            pref.get(),
+                                                            1,
+                                                            &result,
+                                                            &returned);
+        auto algo = boost::optional<hipblasLtMatmulAlgo_t>{};
+        if(status == HIPBLAS_STATUS_SUCCESS && returned > 0)
+            algo = result.algo;
+        else
+            MIOPEN_LOG_I2("hipBLASLt has no algorithm for " << desc);
+        algos.emplace(key, algo);
+        return algo;
+    }
+
+    void Run(const hipblasLtMatmulAlgo_t& algo,
+             const void* A,
+             const void* B,
+             void* C,
+             const void* bias,
+             void* aux) const
+    {
+        if(epilogue.bias)
+            SetAttribute(HIPBLASLT_MATMUL_DESC_BIAS_POINTER, bias);
+        if(epilogue.aux)
+            SetAttribute(HIPBLASLT_MATMUL_DESC_EPILOGUE_AUX_POINTER, aux);
+
+        const auto alpha = desc.alpha;
+        const auto beta  = desc.beta;
+        CheckHipblasLt(hipblasLtMatmul(handle.GetHipblasLtHandle(),
+                                       matmul.get(),
+                                       &alpha,
+                                       A,
+                                       a.get(),
+                                       B,
+                                       b.get(),
+                                       &beta,
+                                       C,
+                                       c.get(),
+                                       C,
+                                       c.get(),
+                                       &algo,
+                                       nullptr,
+                                       0,
+                                       handle.GetStream()),
+                       "hipblasLtMatmul");
+    }
+
+    private:
+    bool IsBatched() const { return desc.batch_count > 1; }
+
+    template <class T>
+    void SetAttribute(hipblasLtMatmulDescAttributes_t attribute, const T& value) const
+    {
+        CheckHipblasLt(
+            hipblasLtMatmulDescSetAttribute(matmul.get(), attribute, &value, sizeof(value)),
+            "hipblasLtMatmulDescSetAttribute");
+    }
+
+    matrix_layout_ptr MakeLayout(int rows, int cols, int ld, long long stride) const
+    {
+        hipblasLtMatrixLayout_t raw = nullptr;
+        CheckHipblasLt(hipblasLtMatrixLayoutCreate(&raw, type, rows, cols, ld),
+                       "hipblasLtMatrixLayoutCreate");
+        auto layout = matrix_layout_ptr{raw};
+        if(IsBatched())
+        {
+            const auto count  = static_cast<int32_t>(desc.batch_count);
+            const auto offset = static_cast<int64_t>(stride);
+            CheckHipblasLt(hipblasLtMatrixLayoutSetAttribute(layout.get(),
+                                                             HIPBLASLT_MATRIX_LAYOUT_BATCH_COUNT,
+                                                             &count,
+                                                             sizeof(count)),
+                           "hipblasLtMatrixLayoutSetAttribute");
+            CheckHipblasLt(
+                hipblasLtMatrixLayoutSetAttribute(layout.get(),
+                                                  HIPBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
+                                                  &offset,
+                                                  sizeof(offset)),
+                "hipblasLtMatrixLayoutSetAttribute");
+        }
+        return layout;
+    }
+
+    const Handle& handle;
+    GemmDescriptor desc;
+    GemmEpilogue epilogue;
+    hipDataType type;
+    matmul_desc_ptr matmul;
+    matrix_layout_ptr a;
+    matrix_layout_ptr b;
+    matrix_layout_ptr c;
+};
+
+/// hipBLASLt is column-major, as rocBLAS.
+void ToColumnMajor(GemmDescriptor& gemm_desc,
+                   ConstData_t& A,
+                   int& a_offset,
+                   ConstData_t& B,
+                   int& b_offset)
+{
+    if(gemm_desc.isColMajor)
+        return;
+    gemm_desc.isColMajor = true;
+    std::swap(A, B);
+    std::swap(a_offset, b_offset);
+    std::swap(gemm_desc.transA, gemm_desc.transB);
+    std::swap(gemm_desc.m, gemm_desc.n);
+    std::swap(gemm_desc.lda, gemm_desc.ldb);
+    std::swap(gemm_desc.strideA, gemm_desc.strideB);
+}
+
+} // namespace
+#endif // MIOPEN_USE_HIPBLASLT
+
+bool IsGemmEpilogueSupported(const Handle& handle,
+                             const GemmDescriptor& gemm_desc,
+                             const GemmEpilogue& epilogue)
+{
+#if MIOPEN_USE_HIPBLASLT
+    hipDataType type;
+    if(!GetHipblasLtType(gemm_desc.dataType, type))
+        return false;
+    auto desc = gemm_desc;
+    auto A    = ConstData_t{nullptr};
+    auto B    = ConstData_t{nullptr};
+    auto a_offset = 0;
+    auto b_offset = 0;
+    ToColumnMajor(desc, A, a_offset, B, b_offset);
+    return HipblasLtGemm{handle, desc, epilogue, type}.GetAlgo() != boost::none;
+#else
+    (void)handle;
+    (void)gemm_desc;
+    (void)epilogue;
+    return false;
+#endif
+}
+
+miopenStatus_t CallGemmEpilogue(const Handle& handle,
+                                GemmDescriptor gemm_desc,
+                                ConstData_t A,
+                                int a_offset,
+                                ConstData_t B,
+                                int b_offset,
+                                Data_t C,
+                                int c_offset,
+                                const GemmEpilogue& epilogue,
+                                ConstData_t bias,
+                                Data_t aux)
+{
+#if MIOPEN_USE_HIPBLASLT
+    MIOPEN_LOG_I2("gemm_desc: " << gemm_desc);
+    MIOPEN_LOG_FUNCTION("hipBLASLt");
+
+    hipDataType type;
+    if(!GetHipblasLtType(gemm_desc.dataType, type))
+        return miopenStatusNotImplemented;
+    if((epilogue.bias && bias == nullptr) || (epilogue.aux && aux == nullptr))
+        MIOPEN_THROW(miopenStatusBadParm, "The GEMM epilogue has no bias or aux buffer");
+
+    ToColumnMajor(gemm_desc, A, a_offset, B, b_offset);
+    const auto gemm = HipblasLtGemm{handle, gemm_desc, epilogue, type};
+    const auto algo = gemm.GetAlgo();
+    if(!algo)
+        return miopenStatusNotImplemented;
+
+    const auto size = GetTypeSize(gemm_desc.dataType);
+
+    HipEventPool::EventPtr start;
+    HipEventPool::EventPtr stop;
+    if(handle.IsProfilingEnabled())
+        ProfilingRecordStart(handle, start, stop);
+
+    gemm.Run(*algo,
+             static_cast<const char*>(A) + a_offset * size,
+             static_cast<const char*>(B) + b_offset * size,
+             static_cast<char*>(C) + c_offset * size,
+             bias,
+             aux);
+
+    if(handle.IsProfilingEnabled())
+        ProfilingRecordStop(handle, start, stop);
+    return miopenStatusSuccess;
+#else
+    (void)handle;
+    (void)gemm_desc;
+    (void)A;
+    (void)a_offset;
+    (void)B;
+    (void)b_offset;
+    (void)C;
+    (void)c_offset;
+    (void)epilogue;
+    (void)bias;
+    (void)aux;
+    return miopenStatusNotImplemented;
+#endif
+}
+
 // hacks: control GEMM backend by enviroment variable and build option
 // very nasty
 static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
@@ -144,6 +919,7 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     case 2: gemm_backend_env = GemmBackend_t::miopengemm; break;
     case 3: gemm_backend_env = GemmBackend_t::nogemmbackend; break;
     case 4: gemm_backend_env = GemmBackend_t::miopentensile; break;
+    case 5: gemm_backend_env = GemmBackend_t::hipblaslt; break;
     default: gemm_backend_env = gemm_backend_preferred;
     }
 
@@ -155,6 +931,7 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     case GemmBackend_t::nogemmbackend: gemm_backend_enforced = GemmBackend_t::nogemmbackend; break;
     case GemmBackend_t::rocblas:
     case GemmBackend_t::miopengemm:
+    case GemmBackend_t::hipblaslt:
     case GemmBackend_t::miopentensile: gemm_backend_enforced = GemmBackend_t::miopentensile; break;
     }
 #elif MIOPEN_USE_ROCBLAS and MIOPEN_USE_MIOPENGEMM
@@ -162,6 +939,7 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     {
     case GemmBackend_t::nogemmbackend: gemm_backend_enforced = GemmBackend_t::nogemmbackend; break;
     case GemmBackend_t::miopentensile:
+    case GemmBackend_t::hipblaslt:
     case GemmBackend_t::rocblas: gemm_backend_enforced = GemmBackend_t::rocblas; break;
     case GemmBackend_t::miopengemm:
         gemm_backend_enforced =
@@ -175,6 +953,7 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     case GemmBackend_t::nogemmbackend: gemm_backend_enforced = GemmBackend_t::nogemmbackend; break;
     case GemmBackend_t::miopentensile:
     case GemmBackend_t::rocblas:
+    case GemmBackend_t::hipblaslt:
     case GemmBackend_t::miopengemm: gemm_backend_enforced = GemmBackend_t::rocblas; break;
     }
 #elif MIOPEN_USE_MIOPENGEMM
@@ -183,6 +962,7 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     case GemmBackend_t::nogemmbackend: gemm_backend_enforced = GemmBackend_t::nogemmbackend; break;
     case GemmBackend_t::miopentensile:
     case GemmBackend_t::rocblas:
+    case GemmBackend_t::hipblaslt:
     case GemmBackend_t::miopengemm:
         gemm_backend_enforced =
             (data_type == miopenFloat) ? GemmBackend_t::miopengemm : GemmBackend_t::nogemmbackend;
@@ -192,9 +972,90 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     gemm_backend_enforced = GemmBackend_t::nogemmbackend;
 #endif
 
+#if MIOPEN_USE_HIPBLASLT
+    // hipBLASLt has no int8 GEMMs, those keep the backend selected above.
+    if(gemm_backend_env == GemmBackend_t::hipblaslt &&
+       (data_type == miopenFloat || data_type == miopenHalf || data_type == miopenBFloat16))
+        gemm_backend_enforced = GemmBackend_t::hipblaslt;
+#endif
+
     return gemm_backend_enforced;
 }
 
+#if MIOPEN_BACKEND_HIP
+namespace {
+
+/// The GEMMs record events around each call when the profiling is enabled.
+struct ProfilingPauseScope
+{
+    explicit ProfilingPauseScope(const Handle& handle_)
+        : handle(handle_), previous(handle_.IsProfilingEnabled())
+    {
+        handle.EnableProfiling(false);
+    }
+    ~ProfilingPauseScope() { handle.EnableProfiling(previous); }
+
+    ProfilingPauseScope(const ProfilingPauseScope&) = delete;
+    ProfilingPauseScope& operator=(const ProfilingPauseScope&) = delete;
+
+    private:
+    const Handle& handle;
+    bool previous;
+};
+
+/// Times the GEMM by back-to-back runs between a single pair of pooled events, as many as fit
+/// into MIOPEN_DEBUG_GEMM_TIMING_TARGET_US (1000 by default, at most 100 runs), as calibrated by
+/// a single timed run after a warm-up. The kernel time of the handle is the mean of the runs.
+template <class F>
+miopenStatus_t TimeGemmRuns(const Handle& handle, F call, FindDbKCacheKey* kcache_key)
+{
+    constexpr auto max_runs = 100;
+
+    auto start      = handle.GetEventPool().Get();
+    auto stop       = handle.GetEventPool().Get();
+    const auto time = [&](int runs, FindDbKCacheKey* key) {
+        const ProfilingPauseScope pause{handle};
+        hipEventRecord(start.get(), handle.GetStream());
+        auto status = miopenStatusSuccess;
+        for(auto i = 0; i < runs && status == miopenStatusSuccess; ++i)
+            status = call(key);
+        hipEventRecord(stop.get(), handle.GetStream());
+        hipEventSynchronize(stop.get());
+        float ms = 0;
+        hipEventElapsedTime(&ms, start.get(), stop.get());
+        return std::make_pair(status, ms / runs);
+    };
+
+    {
+        // rocBLAS needs a warm-up call for accurate timing.
+        const ProfilingPauseScope pause{handle};
+        const auto status = call(nullptr);
+        if(status != miopenStatusSuccess)
+            return status;
+    }
+
+    auto timed = time(1, kcache_key);
+    if(timed.first != miopenStatusSuccess)
+        return timed.first;
+    const auto target = Value(MIOPEN_DEBUG_GEMM_TIMING_TARGET_US{}, 1000) / 1000.0f;
+    const auto runs   = timed.second > 0
+                            ? static_cast<int>(std::min<float>(target / timed.second, max_runs))
+                            : max_runs;
+    if(runs > 1)
+    {
+        timed = time(runs, nullptr);
+        if(timed.first != miopenStatusSuccess)
+            return timed.first;
+    }
+
+    handle.ResetKernelTime();
+    handle.AccumKernelTime(timed.second);
+    return miopenStatusSuccess;
+}
+
+} // namespace
+#endif
+
 miopenStatus_t CallGemmTimeMeasure(const Handle& handle,
                                    GemmDescriptor gemm_desc,
                                    ConstData_t A,
@@ -208,43 +1069,38 @@ miopenStatus_t CallGemmTimeMeasure(const Handle& handle,
                                    CallGemmType_t call_gemm_type,
                                    GemmBackend_t gemm_backend)
 {
-    switch(call_gemm_type)
-    {
-    case callGemm: {
-        if(time_precision)
-        {
-            // rocBLAS need a warm-up call for accurate timing
-            CallGemm(
-                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, nullptr, gemm_backend);
-        }
+#if MIOPEN_USE_ROCBLAS
+    // The searches time the GEMMs with the profiling enabled, and also select the solution.
+    const SearchingGemmScope searching{handle.IsProfilingEnabled()};
+#endif
 
-        return CallGemm(
-            handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, kcache_key, gemm_backend);
-    }
-    case callGemmStridedBatched: {
-        if(time_precision)
+    const auto call = [&](FindDbKCacheKey* key) {
+        switch(call_gemm_type)
         {
-            // rocBLAS need extra warm-up call for accurate timing
-            CallGemmStridedBatched(
-                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, nullptr, gemm_backend);
+        case callGemm:
+            return CallGemm(
+                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, key, gemm_backend);
+        case callGemmStridedBatched:
+            return CallGemmStridedBatched(
+                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, key, gemm_backend);
+        case callGemmStridedBatchedSequential:
+            return CallGemmStridedBatchedSequential(
+                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, key, gemm_backend);
         }
+        return miopenStatusNotImplemented;
+    };
 
-        return CallGemmStridedBatched(
-            handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, kcache_key, gemm_backend);
-    }
-    case callGemmStridedBatchedSequential: {
-        if(time_precision)
-        {
-            // rocBLAS need a warm-up call for accurate timing
-            CallGemmStridedBatchedSequential(
-                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, nullptr, gemm_backend);
-        }
+#if MIOPEN_BACKEND_HIP
+    if(time_precision && handle.IsProfilingEnabled())
+        return TimeGemmRuns(handle, call, kcache_key);
+#endif
 
-        return CallGemmStridedBatchedSequential(
-            handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, kcache_key, gemm_backend);
-    }
+    if(time_precision)
+    {
+        // rocBLAS needs a warm-up call for accurate timing
+        call(nullptr);
     }
-    return miopenStatusNotImplemented;
+    return call(kcache_key);
 }
 
 #if MIOPEN_USE_MIOPENTENSILE
@@ -308,8 +1164,8 @@ miopenStatus_t CallGemmMIOpenTensile(const Handle& handle,
     }
 
 #if MIOPEN_BACKEND_HIP
-    HipEventPtr start = nullptr;
-    HipEventPtr stop  = nullptr;
+    HipEventPool::EventPtr start;
+    HipEventPool::EventPtr stop;
     if(handle.IsProfilingEnabled())
         ProfilingRecordStart(handle, start, stop);
 #endif
@@ -405,8 +1261,11 @@ miopenStatus_t CallGemm(const Handle& handle,
 #if MIOPEN_USE_ROCBLAS
         MIOPEN_LOG_FUNCTION("rocBLAS");
 
-        HipEventPtr start = nullptr;
-        HipEventPtr stop  = nullptr;
+        const auto solution = GetRocblasSolution(
+            handle, gemm_desc, false, A, a_offset, B, b_offset, C, c_offset);
+
+        HipEventPool::EventPtr start;
+        HipEventPool::EventPtr stop;
         if(handle.IsProfilingEnabled())
         {
             ProfilingRecordStart(handle, start, stop);
@@ -445,8 +1304,8 @@ miopenStatus_t CallGemm(const Handle& handle,
                 rocblas_datatype::rocblas_datatype_i32_r,
                 gemm_desc.ldc,
                 rocblas_datatype::rocblas_datatype_i32_r,
-                rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                0,
+                solution.algo,
+                solution.index,
 #if USE_GEMM_FLAGS_PACK_INT8X4
                 rocblas_gemm_flags_pack_int8x4
 #else
@@ -482,8 +1341,8 @@ miopenStatus_t CallGemm(const Handle& handle,
                 rocblas_datatype::rocblas_datatype_f16_r,
                 gemm_desc.ldc,
                 rocblas_datatype::rocblas_datatype_f32_r,
-                rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                0,
+                solution.algo,
+                solution.index,
                 0);
         }
         break;
@@ -515,8 +1374,8 @@ miopenStatus_t CallGemm(const Handle& handle,
                 rocblas_datatype::rocblas_datatype_bf16_r,
                 gemm_desc.ldc,
                 rocblas_datatype::rocblas_datatype_f32_r,
-                rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                0,
+                solution.algo,
+                solution.index,
                 0);
         }
         break;
@@ -547,8 +1406,8 @@ miopenStatus_t CallGemm(const Handle& handle,
                 rocblas_datatype::rocblas_datatype_f32_r,
                 gemm_desc.ldc,
                 rocblas_datatype::rocblas_datatype_f32_r,
-                rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                0,
+                solution.algo,
+                solution.index,
                 0);
         }
         break;
@@ -575,6 +1434,12 @@ miopenStatus_t CallGemm(const Handle& handle,
 #endif
     }
 
+    case GemmBackend_t::hipblaslt: {
+        gemm_desc.batch_count = 1;
+        return CallGemmEpilogue(
+            handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, GemmEpilogue{});
+    }
+
     case GemmBackend_t::miopengemm: {
 #if MIOPEN_USE_MIOPENGEMM
         if(gemm_desc.dataType != miopenFloat)
@@ -704,8 +1569,11 @@ miopenStatus_t CallGemmStridedBatched(const Handle& handle,
 #if MIOPEN_USE_ROCBLAS
         MIOPEN_LOG_FUNCTION("rocBLAS");
 
-        HipEventPtr start = nullptr;
-        HipEventPtr stop  = nullptr;
+        const auto solution = GetRocblasSolution(
+            handle, gemm_desc, true, A, a_offset, B, b_offset, C, c_offset);
+
+        HipEventPool::EventPtr start;
+        HipEventPool::EventPtr stop;
         if(handle.IsProfilingEnabled())
         {
 
@@ -750,8 +1618,8 @@ miopenStatus_t CallGemmStridedBatched(const Handle& handle,
                 gemm_desc.strideC,
                 gemm_desc.batch_count,
                 rocblas_datatype::rocblas_datatype_i32_r,
-                rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                0,
+                solution.algo,
+                solution.index,
 #if USE_GEMM_FLAGS_PACK_INT8X4
                 rocblas_gemm_flags_pack_int8x4
 #else
@@ -792,8 +1660,8 @@ miopenStatus_t CallGemmStridedBatched(const Handle& handle,
                 gemm_desc.strideC,
                 gemm_desc.batch_count,
                 rocblas_datatype::rocblas_datatype_f32_r,
-                rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                0,
+                solution.algo,
+                solution.index,
                 0);
         }
         break;
@@ -829,8 +1697,8 @@ miopenStatus_t CallGemmStridedBatched(const Handle& handle,
                 gemm_desc.strideC,
                 gemm_desc.batch_count,
                 rocblas_datatype::rocblas_datatype_f32_r,
-                rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                0,
+                solution.algo,
+                solution.index,
                 0);
         }
         break;
@@ -866,8 +1734,8 @@ miopenStatus_t CallGemmStridedBatched(const Handle& handle,
                 gemm_desc.strideC,
                 gemm_desc.batch_count,
                 rocblas_datatype::rocblas_datatype_f32_r,
-                rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                0,
+                solution.algo,
+                solution.index,
                 0);
         }
         break;
@@ -894,6 +1762,10 @@ miopenStatus_t CallGemmStridedBatched(const Handle& handle,
 #endif
     }
 
+    case GemmBackend_t::hipblaslt:
+        return CallGemmEpilogue(
+            handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, GemmEpilogue{});
+
     case GemmBackend_t::miopengemm: {
 #if MIOPEN_USE_MIOPENGEMM
         return CallGemmStridedBatchedSequential(
@@ -951,8 +1823,11 @@ miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
 #if MIOPEN_USE_ROCBLAS
         MIOPEN_LOG_FUNCTION("rocBLAS");
 
-        HipEventPtr start = nullptr;
-        HipEventPtr stop  = nullptr;
+        const auto solution = GetRocblasSolution(
+            handle, gemm_desc, false, A, a_offset, B, b_offset, C, c_offset);
+
+        HipEventPool::EventPtr start;
+        HipEventPool::EventPtr stop;
         if(handle.IsProfilingEnabled())
         {
             ProfilingRecordStart(handle, start, stop);
@@ -993,8 +1868,8 @@ miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
                     rocblas_datatype::rocblas_datatype_i32_r,
                     gemm_desc.ldc,
                     rocblas_datatype::rocblas_datatype_i32_r,
-                    rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                    0,
+                    solution.algo,
+                    solution.index,
 #if USE_GEMM_FLAGS_PACK_INT8X4
                     rocblas_gemm_flags_pack_int8x4
 #else
@@ -1033,8 +1908,8 @@ miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
                     rocblas_datatype::rocblas_datatype_f16_r,
                     gemm_desc.ldc,
                     rocblas_datatype::rocblas_datatype_f32_r,
-                    rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                    0,
+                    solution.algo,
+                    solution.index,
                     0);
             }
         }
@@ -1068,8 +1943,8 @@ miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
                     rocblas_datatype::rocblas_datatype_bf16_r,
                     gemm_desc.ldc,
                     rocblas_datatype::rocblas_datatype_f32_r,
-                    rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                    0,
+                    solution.algo,
+                    solution.index,
                     0);
             }
         }
@@ -1103,8 +1978,8 @@ miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
                     rocblas_datatype::rocblas_datatype_f32_r,
                     gemm_desc.ldc,
                     rocblas_datatype::rocblas_datatype_f32_r,
-                    rocblas_gemm_algo::rocblas_gemm_algo_standard,
-                    0,
+                    solution.algo,
+                    solution.index,
                     0);
             }
         }
@@ -1132,6 +2007,10 @@ miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
 #endif
     }
 
+    case GemmBackend_t::hipblaslt:
+        return CallGemmEpilogue(
+            handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, GemmEpilogue{});
+
     case GemmBackend_t::miopengemm: {
 #if MIOPEN_USE_MIOPENGEMM
         if(gemm_desc.dataType != miopenFloat)
@@ -1243,6 +2122,259 @@ miopenStatus_t CallGemmStridedBatchedSequential(const Handle& handle,
     return miopenStatusUnknownError;
 }
 
+namespace {
+
+bool IsSameGemmShape(const GemmDescriptor& a, const GemmDescriptor& b)
+{
+    return std::tie(a.isColMajor, a.transA, a.transB, a.m, a.n, a.k, a.lda, a.ldb, a.ldc) ==
+               std::tie(b.isColMajor, b.transA, b.transB, b.m, b.n, b.k, b.lda, b.ldb, b.ldc) &&
+           a.alpha == b.alpha && a.beta == b.beta && a.dataType == b.dataType;
+}
+
+bool IsSameGemmBuffers(const GemmProblem& a, const GemmProblem& b)
+{
+    return a.A == b.A && a.B == b.B && a.C == b.C;
+}
+
+} // namespace
+
+miopenStatus_t CallGemmGrouped(const Handle& handle,
+                               const std::vector<GemmProblem>& problems,
+                               GemmBackend_t gemm_backend)
+{
+    auto done     = std::vector<bool>(problems.size(), false);
+    auto launches = 0;
+    float elapsed = 0;
+
+    for(auto i = std::size_t{0}; i < problems.size(); ++i)
+    {
+        if(done[i])
+            continue;
+        const auto& first = problems[i];
+        assert(first.desc.batch_count == 1);
+        done[i] = true;
+
+        // The second GEMM of the batch sets its strides, the next ones must follow them. The
+        // strides of C are positive, since the GEMMs are independent.
+        auto gemm_desc = first.desc;
+        for(auto j = i + 1; j < problems.size(); ++j)
+        {
+            const auto& next = problems[j];
+            if(done[j] || !IsSameGemmShape(first.desc, next.desc) ||
+               !IsSameGemmBuffers(first, next))
+                continue;
+            const auto count    = gemm_desc.batch_count;
+            const auto stride_a = static_cast<long long>(next.a_offset) - first.a_offset;
+            const auto stride_b = static_cast<long long>(next.b_offset) - first.b_offset;
+            const auto stride_c = static_cast<long long>(next.c_offset) - first.c_offset;
+            if(count == 1)
+            {
+                if(stride_a < 0 || stride_b < 0 || stride_c <= 0)
+                    continue;
+                gemm_desc.strideA = stride_a;
+                gemm_desc.strideB = stride_b;
+                gemm_desc.strideC = stride_c;
+            }
+            else if(stride_a != gemm_desc.strideA * count ||
+                    stride_b != gemm_desc.strideB * count || stride_c != gemm_desc.strideC * count)
+            {
+                continue;
+            }
+            ++gemm_desc.batch_count;
+            done[j] = true;
+        }
+
+        const auto status = gemm_desc.batch_count == 1 ? CallGemm(handle,
+                                                                  gemm_desc,
+                                                                  first.A,
+                                                                  first.a_offset,
+                                                                  first.B,
+                                                                  first.b_offset,
+                                                                  first.C,
+                                                                  first.c_offset,
+                                                                  nullptr,
+                                                                  gemm_backend)
+                                                       : CallGemmStridedBatched(handle,
+                                                                                gemm_desc,
+                                                                                first.A,
+                                                                                first.a_offset,
+                                                                                first.B,
+                                                                                first.b_offset,
+                                                                                first.C,
+                                                                                first.c_offset,
+                                                                                nullptr,
+                                                                                gemm_backend);
+        if(status != miopenStatusSuccess)
+            return status;
+        ++launches;
+        if(handle.IsProfilingEnabled())
+            elapsed += handle.GetKernelTime();
+    }
+
+    MIOPEN_LOG_I2(problems.size() << " GEMMs in " << launches << " launches");
+    if(handle.IsProfilingEnabled())
+    {
+        handle.ResetKernelTime();
+        handle.AccumKernelTime(elapsed);
+    }
+    return miopenStatusSuccess;
+}
+
+std::vector<GemmBackend_t> GetGemmBackends(miopenDataType_t data_type)
+{
+    auto backends = std::vector<GemmBackend_t>{};
+    for(const auto preferred : {GemmBackend_t::miopentensile,
+                                GemmBackend_t::rocblas,
+                                GemmBackend_t::hipblaslt,
+                                GemmBackend_t::miopengemm})
+    {
+        const auto backend = enforce_gemm_backend(data_type, preferred);
+        if(backend != GemmBackend_t::nogemmbackend &&
+           std::find(backends.begin(), backends.end(), backend) == backends.end())
+            backends.push_back(backend);
+    }
+    return backends;
+}
+
+namespace {
+
+const char* const gemm_backend_db_id = "GemmBackend";
+
+/// The perf-db key of the GEMM, as it is passed to rocBLAS.
+gemm::ProblemDescription MakeGemmBackendProblem(GemmDescriptor gemm_desc)
+{
+    if(!gemm_desc.isColMajor)
+    {
+        gemm_desc.isColMajor = true;
+        std::swap(gemm_desc.transA, gemm_desc.transB);
+        std::swap(gemm_desc.m, gemm_desc.n);
+        std::swap(gemm_desc.lda, gemm_desc.ldb);
+        std::swap(gemm_desc.strideA, gemm_desc.strideB);
+    }
+    return {gemm_desc, gemm_desc.batch_count > 1};
+}
+
+/// The backends of the perf-db records, looked up once per process and device.
+struct GemmBackendCache
+{
+    std::mutex mutex;
+    std::map<std::string, GemmBackend_t> backends;
+};
+
+GemmBackendCache& GetGemmBackendCache()
+{
+    static GemmBackendCache cache;
+    return cache;
+}
+
+std::string GetGemmBackendKey(const Handle& handle, const gemm::ProblemDescription& problem)
+{
+    std::ostringstream key;
+    key << handle.GetDbBasename() << ':' << problem;
+    return key.str();
+}
+
+} // namespace
+
+GemmBackend_t GetGemmBackend(const Handle& handle, const GemmDescriptor& gemm_desc)
+{
+    const auto backends = GetGemmBackends(gemm_desc.dataType);
+    if(backends.empty())
+        return GemmBackend_t::nogemmbackend;
+
+    const auto problem = MakeGemmBackendProblem(gemm_desc);
+    const auto key     = GetGemmBackendKey(handle, problem);
+    auto& cache        = GetGemmBackendCache();
+
+    {
+        const std::lock_guard<std::mutex> lock(cache.mutex);
+        const auto it = cache.backends.find(key);
+        if(it != cache.backends.end())
+            return it->second;
+    }
+
+    // The context only locates the perf-db.
+    const auto ctx = ExecutionContext{const_cast<Handle*>(&handle)}; // NOLINT
+    auto config    = gemm::GemmBackendConfig{};
+    auto backend   = backends.front();
+    // A backend of another build is not used.
+    if(GetDb(ctx).Load(problem, gemm_backend_db_id, config) &&
+       std::find(backends.begin(), backends.end(), static_cast<GemmBackend_t>(config.backend)) !=
+           backends.end())
+    {
+        MIOPEN_LOG_I2("Perf Db: record loaded: " << config);
+        backend = static_cast<GemmBackend_t>(config.backend);
+    }
+
+    const std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.backends[key] = backend;
+    return backend;
+}
+
+GemmBackend_t FindGemmBackend(const Handle& handle,
+                              const GemmDescriptor& gemm_desc,
+                              ConstData_t A,
+                              ConstData_t B,
+                              float& time)
+{
+    const auto strided_batched = gemm_desc.batch_count > 1;
+    const auto rows            = gemm_desc.isColMajor ? gemm_desc.n : gemm_desc.m;
+    const auto c_elements =
+        (strided_batched ? gemm_desc.strideC * (gemm_desc.batch_count - 1) : 0) +
+        static_cast<long long>(gemm_desc.ldc) * rows;
+
+    const MemoryCategoryScope category{MemoryCategory::Search};
+    const auto c = handle.Create(c_elements * GetTypeSize(gemm_desc.dataType));
+
+    auto best = GemmBackend_t::nogemmbackend;
+    time      = std::numeric_limits<float>::max();
+    {
+        // The timed runs also search the solutions of the backends that have them.
+        const AutoEnableProfiling profiling{handle};
+        for(const auto backend : GetGemmBackends(gemm_desc.dataType))
+        {
+            handle.ResetKernelTime();
+            const auto status =
+                CallGemmTimeMeasure(handle,
+                                    gemm_desc,
+                                    A,
+                                    0,
+                                    B,
+                                    0,
+                                    c.get(),
+                                    0,
+                                    nullptr,
+                                    true,
+                                    strided_batched ? callGemmStridedBatched : callGemm,
+                                    backend);
+            if(status != miopenStatusSuccess)
+                continue;
+            const auto backend_time = handle.GetKernelTime();
+            MIOPEN_LOG_I2("backend " << static_cast<int>(backend) << ": " << backend_time
+                                     << " ms");
+            if(backend_time < time)
+            {
+                best = backend;
+                time = backend_time;
+            }
+        }
+    }
+    if(best == GemmBackend_t::nogemmbackend)
+        return best;
+
+    const auto problem = MakeGemmBackendProblem(gemm_desc);
+    const auto ctx     = ExecutionContext{const_cast<Handle*>(&handle)}; // NOLINT
+    auto config        = gemm::GemmBackendConfig{};
+    config.backend     = static_cast<int>(best);
+    MIOPEN_LOG_I("GEMM " << problem << ": backend " << config.backend << ", " << time << " ms");
+    GetDb(ctx).Update(problem, gemm_backend_db_id, config);
+
+    auto& cache = GetGemmBackendCache();
+    const std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.backends[GetGemmBackendKey(handle, problem)] = best;
+    return best;
+}
+
 // y = w * Im2Col(x)
 GemmDescriptor CreateGemmDescriptorConvFwd(const TensorDescriptor& wDesc,
                                            const TensorDescriptor& xDesc,
@@ -23,10 +23,18 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <cstdio>
 #include <miopen/version.h>
+#include <miopen/check_numerics.hpp>
+#include <miopen/compile_stats.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/metrics.hpp>
+#if MIOPEN_BACKEND_HIP
+#include <miopen/handle_snapshot.hpp>
+#endif
 
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
@@ -67,6 +75,11 @@ extern "C" miopenStatus_t miopenGetVersion(size_t* major, size_t* minor, size_t*
     });
 }
 
+extern "C" miopenStatus_t miopenRefreshEnvironment()
+{
+    return miopen::try_([&] { miopen::env::Refresh(); });
+}
+
 extern "C" miopenStatus_t miopenCreate(miopenHandle_t* handle)
 {
 
@@ -112,3 +125,115 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenSetDeterministic(miopenHandle_t handle, bool deterministic)
+{
+    return miopen::try_([&] { miopen::deref(handle).SetDeterministic(deterministic); });
+}
+
+extern "C" miopenStatus_t miopenGetDeterministic(miopenHandle_t handle, bool* deterministic)
+{
+    return miopen::try_(
+        [&] { miopen::deref(deterministic) = miopen::deref(handle).IsDeterministic(); });
+}
+
+extern "C" miopenStatus_t
+miopenGetCompileStatistics(miopenHandle_t handle, char* json, size_t* size)
+{
+    return miopen::try_([&] {
+        miopen::deref(handle);
+        const auto stats = miopen::CompileStats::Get().ToJson();
+        if(json == nullptr)
+        {
+            miopen::deref(size) = stats.size() + 1;
+            return;
+        }
+        if(miopen::deref(size) < stats.size() + 1)
+            MIOPEN_THROW(miopenStatusBadParm, "The buffer is too small for the statistics");
+        std::copy(stats.begin(), stats.end(), json);
+        json[stats.size()] = '\0';
+    });
+}
+
+extern "C" miopenStatus_t miopenGetMetrics(miopenHandle_t handle, char* json, size_t* size)
+{
+    return miopen::try_([&] {
+        const auto metrics = "{\"handle\": " + miopen::deref(handle).GetMetrics().ToJson() +
+                             ", \"process\": " + miopen::Metrics::Process().ToJson() + "}";
+        if(json == nullptr)
+        {
+            miopen::deref(size) = metrics.size() + 1;
+            return;
+        }
+        if(miopen::deref(size) < metrics.size() + 1)
+            MIOPEN_THROW(miopenStatusBadParm, "The buffer is too small for the metrics");
+        std::copy(metrics.begin(), metrics.end(), json);
+        json[metrics.size()] = '\0';
+    });
+}
+
+extern "C" miopenStatus_t miopenGetMemoryUsage(miopenHandle_t handle, char* json, size_t* size)
+{
+    return miopen::try_([&] {
+        auto& usage = miopen::deref(handle).GetMemoryUsage();
+#if MIOPEN_USE_ROCBLAS
+        usage.Set(miopen::MemoryCategory::Rocblas, miopen::deref(handle).GetRocblasMemorySize());
+#endif
+        const auto report = usage.ToJson();
+        if(json == nullptr)
+        {
+            miopen::deref(size) = report.size() + 1;
+            return;
+        }
+        if(miopen::deref(size) < report.size() + 1)
+            MIOPEN_THROW(miopenStatusBadParm, "The buffer is too small for the memory usage");
+        std::copy(report.begin(), report.end(), json);
+        json[report.size()] = '\0';
+    });
+}
+
+extern "C" miopenStatus_t miopenResetMemoryUsagePeaks(miopenHandle_t handle)
+{
+    return miopen::try_([&] { miopen::deref(handle).GetMemoryUsage().ResetPeaks(); });
+}
+
+extern "C" miopenStatus_t miopenGetCheckNumericsStatus(miopenHandle_t handle,
+                                                      int* hasNan,
+                                                      int* hasInf)
+{
+    return miopen::try_([&] {
+        bool nan = false;
+        bool inf = false;
+        miopen::CheckNumericsPoll(miopen::deref(handle), &nan, &inf);
+        miopen::deref(hasNan) = nan ? 1 : 0;
+        miopen::deref(hasInf) = inf ? 1 : 0;
+    });
+}
+
+extern "C" miopenStatus_t miopenSaveHandleSnapshot(miopenHandle_t handle, const char* path)
+{
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "path is null");
+#if MIOPEN_BACKEND_HIP
+        std::ignore = miopen::HandleSnapshot::Save(miopen::deref(handle), path);
+#else
+        std::ignore = handle;
+        MIOPEN_THROW(miopenStatusNotImplemented, "Handle snapshots need the HIP backend");
+#endif
+    });
+}
+
+extern "C" miopenStatus_t miopenLoadHandleSnapshot(miopenHandle_t handle, const char* path)
+{
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "path is null");
+#if MIOPEN_BACKEND_HIP
+        std::ignore = miopen::HandleSnapshot::Load(miopen::deref(handle), path);
+#else
+        std::ignore = handle;
+        MIOPEN_THROW(miopenStatusNotImplemented, "Handle snapshots need the HIP backend");
+#endif
+    });
+}
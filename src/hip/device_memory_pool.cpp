@@ -0,0 +1,209 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/device_memory_pool.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <hip/hip_runtime_api.h>
+
+#include <algorithm>
+#include <memory>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DEVICE_MEMORY_POOL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_MEMORY_POOL_LIMIT_MB)
+
+namespace miopen {
+
+std::size_t GetAvailableMemory();
+
+namespace {
+
+constexpr std::size_t min_block_size   = 512;
+constexpr std::size_t small_block_size = 1024 * 1024;
+constexpr std::size_t large_block_step = 2 * 1024 * 1024;
+
+constexpr std::size_t default_limit_mb = 1024;
+
+} // namespace
+
+DeviceMemoryPool& DeviceMemoryPool::Get(int device)
+{
+    static std::mutex mutex;
+    // Intentionally leaked: buffers may be freed by static objects destroyed
+    // after the pools would have been.
+    static auto& pools = *new std::map<int, std::unique_ptr<DeviceMemoryPool>>{}; // NOLINT
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto& pool = pools[device];
+    if(!pool)
+        pool.reset(new DeviceMemoryPool(device));
+    return *pool;
+}
+
+bool DeviceMemoryPool::IsEnabled()
+{
+    return !miopen::IsDisabled(MIOPEN_DEBUG_DEVICE_MEMORY_POOL{});
+}
+
+DeviceMemoryPool::DeviceMemoryPool(int device_)
+    : device(device_),
+      limit(miopen::Value(MIOPEN_DEVICE_MEMORY_POOL_LIMIT_MB{}, default_limit_mb) * 1024 * 1024)
+{
+    MIOPEN_LOG_I2("Device memory pool for device " << device << ", limit: " << limit);
+}
+
+std::size_t DeviceMemoryPool::GetSizeClass(std::size_t size)
+{
+    if(size <= min_block_size)
+        return min_block_size;
+    if(size <= small_block_size)
+    {
+        auto size_class = min_block_size;
+        while(size_class < size)
+            size_class *= 2;
+        return size_class;
+    }
+    return (size + large_block_step - 1) / large_block_step * large_block_step;
+}
+
+Allocator::ManageDataPtr DeviceMemoryPool::Allocate(std::size_t size,
+                                                    miopenAcceleratorQueue_t stream)
+{
+    const auto deleter = AllocatorDeleter{&DeviceMemoryPool::Deallocate, this};
+    if(size == 0)
+        return Allocator::ManageDataPtr{nullptr, deleter};
+
+    const auto size_class = GetSizeClass(size);
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    auto block    = Block{nullptr, size_class, stream};
+    const auto it = free_blocks.find(size_class);
+    if(it != free_blocks.end())
+    {
+        auto& blocks      = it->second;
+        const auto reused = std::find_if(blocks.rbegin(), blocks.rend(), [&](const Block& b) {
+            return b.stream == stream;
+        });
+        if(reused != blocks.rend())
+        {
+            block.ptr = reused->ptr;
+            blocks.erase(std::next(reused).base());
+            cached_size -= size_class;
+        }
+    }
+
+    if(block.ptr == nullptr)
+        block.ptr = AllocateFromDevice(size_class);
+
+    used_blocks.emplace(block.ptr, block);
+    used_size += size_class;
+    return Allocator::ManageDataPtr{DataCast(block.ptr), deleter};
+}
+
+void* DeviceMemoryPool::AllocateFromDevice(std::size_t size)
+{
+    if(size > GetAvailableMemory())
+    {
+        MIOPEN_LOG_I2("Memory pressure, releasing " << cached_size << " cached bytes");
+        TrimUnsafe();
+        if(size > GetAvailableMemory())
+            MIOPEN_THROW("Memory not available to allocate buffer: " + std::to_string(size));
+    }
+
+    void* result = nullptr;
+    auto status  = hipMalloc(&result, size);
+    if(status != hipSuccess && cached_size > 0)
+    {
+        MIOPEN_LOG_I2("hipMalloc failed, releasing " << cached_size << " cached bytes");
+        TrimUnsafe();
+        status = hipMalloc(&result, size);
+    }
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error creating buffer " + std::to_string(size) + ": ");
+    return result;
+}
+
+void DeviceMemoryPool::Deallocate(void* context, void* ptr)
+{
+    static_cast<DeviceMemoryPool*>(context)->Release(ptr);
+}
+
+void DeviceMemoryPool::Release(void* ptr)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    const auto it = used_blocks.find(ptr);
+    if(it == used_blocks.end())
+    {
+        MIOPEN_LOG_E("Trying to release a buffer which is not owned by the memory pool");
+        return;
+    }
+
+    const auto block = it->second;
+    used_blocks.erase(it);
+    used_size -= block.size;
+
+    if(cached_size + block.size > limit)
+    {
+        hipFree(block.ptr);
+        return;
+    }
+
+    free_blocks[block.size].push_back(block);
+    cached_size += block.size;
+}
+
+void DeviceMemoryPool::Trim()
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    TrimUnsafe();
+}
+
+void DeviceMemoryPool::TrimUnsafe()
+{
+    // hipFree waits for the device, so pending work which still uses the blocks is finished.
+    for(const auto& size_class : free_blocks)
+        for(const auto& block : size_class.second)
+            hipFree(block.ptr);
+    free_blocks.clear();
+    cached_size = 0;
+}
+
+std::size_t DeviceMemoryPool::GetCachedSize() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    return cached_size;
+}
+
+std::size_t DeviceMemoryPool::GetUsedSize() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    return used_size;
+}
+
+} // namespace miopen
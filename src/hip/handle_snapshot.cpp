@@ -0,0 +1,249 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/handle_snapshot.hpp>
+
+#include <miopen/aot_package.hpp>
+#include <miopen/binary_cache.hpp>
+#include <miopen/config.h>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_PARALLEL_LEVEL)
+
+namespace miopen {
+
+namespace {
+constexpr std::uint32_t handle_snapshot_version = 1;
+constexpr char handle_snapshot_magic[8]         = {'M', 'I', 'O', 'P', 'E', 'N', 'H', 'S'};
+} // namespace
+
+struct HandleSnapshot::Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t identity_size;
+    std::uint64_t count;
+    std::uint64_t index_offset;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+};
+
+struct HandleSnapshot::IndexItem
+{
+    std::uint64_t name_offset;
+    std::uint64_t params_offset;
+    std::uint64_t code_object_offset;
+    std::uint64_t code_object_size;
+    std::uint32_t name_size;
+    std::uint32_t params_size;
+};
+
+std::string HandleSnapshot::GetIdentity(const Handle& handle)
+{
+    return AotPackager::GetVersion() + ':' + handle.GetDbBasename();
+}
+
+/// The code objects are only kept in memory by the programs built in this process, the others
+/// are read back from the binary cache.
+static std::string
+GetCodeObject(const Handle& handle, const std::string& name, std::string params, const Program& p)
+{
+    if(p.IsCodeObjectInMemory())
+        return p.GetCodeObjectBlob();
+
+    const auto& target = handle.GetTargetProperties();
+    if(!EndsWith(name, ".mlir-cpp") && !EndsWith(name, ".mlir"))
+        params += " -mcpu=" + target.Name();
+
+    for(const auto is_kernel_str : {false, true})
+    {
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        auto code_object =
+            LoadBinary(target, handle.GetMaxComputeUnits(), name, params, is_kernel_str);
+        if(!code_object.empty())
+            return code_object;
+#else
+        const auto path =
+            LoadBinary(target, handle.GetMaxComputeUnits(), name, params, is_kernel_str);
+        if(!path.empty())
+            return LoadFile(path);
+#endif
+    }
+    return {};
+}
+
+std::size_t HandleSnapshot::Save(const Handle& handle, const std::string& path)
+{
+    const auto identity = GetIdentity(handle);
+    auto index          = std::vector<IndexItem>{};
+    auto data           = identity;
+
+    for(const auto& program : handle.GetPrograms())
+    {
+        const auto& name       = program.first.first;
+        const auto& params     = program.first.second;
+        const auto code_object = GetCodeObject(handle, name, params, program.second);
+        if(code_object.empty())
+        {
+            MIOPEN_LOG_W("No code object of " << name << " " << params << ", skipped");
+            continue;
+        }
+
+        auto item               = IndexItem{};
+        item.name_offset        = data.size();
+        item.name_size          = name.size();
+        item.params_offset      = item.name_offset + item.name_size;
+        item.params_size        = params.size();
+        item.code_object_offset = item.params_offset + item.params_size;
+        item.code_object_size   = code_object.size();
+        index.push_back(item);
+        data += name;
+        data += params;
+        data += code_object;
+    }
+
+    auto header = Header{};
+    std::copy(std::begin(handle_snapshot_magic),
+              std::end(handle_snapshot_magic),
+              std::begin(header.magic));
+    header.version       = handle_snapshot_version;
+    header.identity_size = identity.size();
+    header.count         = index.size();
+    header.index_offset  = sizeof(Header);
+    header.data_offset   = header.index_offset + index.size() * sizeof(IndexItem);
+    header.data_size     = data.size();
+
+    // Processes which map the file at the moment never see it partially written.
+    const auto tmp_path = path + ".tmp";
+    {
+        auto output = std::ofstream{tmp_path, std::ios::binary | std::ios::trunc};
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(IndexItem));
+        output.write(data.data(), data.size());
+        if(!output)
+            MIOPEN_THROW("Unable to write " + tmp_path);
+    }
+    boost::filesystem::rename(tmp_path, path);
+    MIOPEN_LOG_I("Saved " << index.size() << " programs to " << path);
+    return index.size();
+}
+
+std::size_t HandleSnapshot::Load(const Handle& handle, const std::string& path)
+{
+    namespace ipc = boost::interprocess;
+
+    auto region = ipc::mapped_region{};
+    try
+    {
+        const auto file = ipc::file_mapping{path.c_str(), ipc::read_only};
+        region          = ipc::mapped_region{file, ipc::read_only};
+    }
+    catch(const ipc::interprocess_exception& ex)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Unable to map " + path + ": " + ex.what());
+    }
+
+    const auto size  = region.get_size();
+    const auto image = static_cast<const char*>(region.get_address());
+    auto header      = Header{};
+    if(size >= sizeof(Header))
+        std::memcpy(&header, image, sizeof(Header));
+
+    const auto index_fits = size >= sizeof(Header) &&
+                            header.index_offset % alignof(IndexItem) == 0 &&
+                            header.index_offset <= size &&
+                            header.count <= (size - header.index_offset) / sizeof(IndexItem);
+    const auto data_fits = index_fits && header.data_offset <= size &&
+                           header.data_size <= size - header.data_offset &&
+                           header.identity_size <= header.data_size;
+    if(!data_fits ||
+       std::memcmp(header.magic, handle_snapshot_magic, sizeof(handle_snapshot_magic)) != 0 ||
+       header.version != handle_snapshot_version)
+        MIOPEN_THROW(miopenStatusBadParm, "Ill-formed snapshot: " + path);
+
+    const auto data     = image + header.data_offset;
+    const auto identity = std::string{data, header.identity_size};
+    if(identity != GetIdentity(handle))
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Snapshot " + path + " is of " + identity + ", not of " +
+                         GetIdentity(handle));
+
+    const auto index = reinterpret_cast<const IndexItem*>(image + header.index_offset);
+    const auto fits  = [&](std::uint64_t offset, std::uint64_t length) {
+        return offset <= header.data_size && length <= header.data_size - offset;
+    };
+
+    auto programs = std::vector<Program>{};
+    programs.reserve(header.count);
+    for(auto i = std::uint64_t{0}; i < header.count; ++i)
+    {
+        const auto& item = index[i];
+        if(!fits(item.name_offset, item.name_size) || !fits(item.params_offset, item.params_size) ||
+           !fits(item.code_object_offset, item.code_object_size))
+            MIOPEN_THROW(miopenStatusBadParm, "Ill-formed snapshot: " + path);
+
+        const auto name   = std::string{data + item.name_offset, item.name_size};
+        const auto params = std::string{data + item.params_offset, item.params_size};
+        if(handle.HasProgram(name, params))
+            continue;
+
+        auto program = Program{
+            name, std::string{data + item.code_object_offset, item.code_object_size}};
+        handle.AddProgram(program, name, params);
+        programs.push_back(program);
+    }
+
+#if !MIOPEN_MODE_NOGPU
+    // Modules are loaded on the first use otherwise, one at a time.
+    const auto num_threads = std::max<std::size_t>(
+        Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, std::thread::hardware_concurrency()), 1);
+    par_for_strided(
+        programs.size(), max_threads{num_threads}, [&](auto i) { programs[i].GetModule(); });
+#endif
+
+    MIOPEN_LOG_I("Restored " << programs.size() << " of " << header.count << " programs from "
+                             << path);
+    return programs.size();
+}
+
+} // namespace miopen
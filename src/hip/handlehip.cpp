@@ -26,8 +26,12 @@
 
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
+#include <miopen/db_write_batch.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/compile_stats.hpp>
+#include <miopen/compile_worker_pool.hpp>
+#include <miopen/device_memory_pool.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -35,10 +39,13 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/metrics.hpp>
+#include <miopen/md5.hpp>
 #include <miopen/rocm_features.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 #include <miopen/write_file.hpp>
@@ -54,13 +61,25 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 
 #define MIOPEN_WORKAROUND_ROCM_COMPILER_SUPPORT_ISSUE_30 (MIOPEN_USE_COMGR && BUILD_SHARED_LIBS)
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_CU)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_WARMUP_KERNEL_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEFER_KERNEL_TIMES)
 
 namespace miopen {
 
@@ -146,11 +165,114 @@ int set_default_device()
     return (pid % n);
 }
 
+namespace {
+
+std::uint64_t NextHandleId()
+{
+    static std::atomic<std::uint64_t> next_id{1};
+    return next_id++;
+}
+
+// Stream pool index selected by the calling thread, per handle id.
+std::unordered_map<std::uint64_t, int>& ThreadStreamIndices()
+{
+    static thread_local std::unordered_map<std::uint64_t, int> indices;
+    return indices;
+}
+
+// Kernel time measured by the calling thread, per handle id, so the threads which share a
+// profiling handle time their own kernels.
+std::unordered_map<std::uint64_t, float>& ThreadKernelTimes()
+{
+    static thread_local std::unordered_map<std::uint64_t, float> times;
+    return times;
+}
+
+struct PendingKernelTime
+{
+    std::string name;
+    HipEventPool::EventPtr start;
+    HipEventPool::EventPtr stop;
+};
+
+// Kernels launched by the calling thread with deferred timing, per handle id. The events may
+// outlive their pool.
+std::unordered_map<std::uint64_t, std::vector<PendingKernelTime>>& ThreadPendingKernelTimes()
+{
+    static thread_local std::unordered_map<std::uint64_t, std::vector<PendingKernelTime>> times;
+    return times;
+}
+
+/// Attributes of a device, queried once per process, since handles are often short-lived.
+struct DeviceAttributes
+{
+    std::string name;
+    std::size_t num_cu     = 0;
+    std::size_t local_mem  = 0;
+    std::size_t global_mem = 0;
+    std::size_t max_grid_x = 0;
+    std::size_t warp_size  = 0;
+    std::size_t max_clock  = 0; ///< MHz.
+    /// Clock levels of the shader engine with the current one marked, empty if unknown.
+    std::string sclk_path;
+};
+
+const DeviceAttributes& GetDeviceAttributes(int device)
+{
+    static std::mutex mutex;
+    static std::map<int, DeviceAttributes> devices;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = devices.find(device);
+    if(it != devices.end())
+        return it->second;
+
+    hipDeviceProp_t props{};
+    const auto status = hipGetDeviceProperties(&props, device);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to get the device properties");
+
+    auto& attributes = devices[device];
+#if ROCM_FEATURE_HIP_GCNARCHNAME_RETURNS_CODENAME
+    attributes.name = "gfx" + std::to_string(props.gcnArch);
+#else
+    attributes.name = props.gcnArchName;
+#endif
+    attributes.num_cu     = props.multiProcessorCount;
+    attributes.local_mem  = props.sharedMemPerBlock;
+    attributes.global_mem = props.totalGlobalMem;
+    attributes.max_grid_x = props.maxGridSize[0];
+    attributes.warp_size  = props.warpSize;
+    attributes.max_clock  = props.clockRate / 1000;
+#ifndef _WIN32
+    char sclk_path[64];
+    std::snprintf(sclk_path,
+                  sizeof(sclk_path),
+                  "/sys/bus/pci/devices/%04x:%02x:%02x.0/pp_dpm_sclk",
+                  static_cast<unsigned>(props.pciDomainID),
+                  static_cast<unsigned>(props.pciBusID),
+                  static_cast<unsigned>(props.pciDeviceID));
+    attributes.sclk_path = sclk_path;
+#endif
+    MIOPEN_LOG_NQI("Raw device name: " << attributes.name);
+    return attributes;
+}
+
+} // namespace
+
 struct HandleImpl
 {
     // typedef MIOPEN_MANAGE_PTR(hipStream_t, hipStreamDestroy) StreamPtr;
     using StreamPtr = std::shared_ptr<typename std::remove_pointer<hipStream_t>::type>;
 
+    struct PoolStream
+    {
+        StreamPtr stream;
+#if MIOPEN_USE_ROCBLAS
+        rocblas_handle_ptr rhandle;
+#endif
+    };
+
     HandleImpl() : ctx(get_ctx()) {}
 
     StreamPtr create_stream()
@@ -164,10 +286,26 @@ struct HandleImpl
 
     static StreamPtr reference_stream(hipStream_t s) { return StreamPtr{s, null_deleter{}}; }
 
+    hipStream_t get_stream(int index) const
+    {
+        return index == 0 ? stream.get() : extra_streams[index - 1].stream.get();
+    }
+
+    int get_stream_index() const
+    {
+        if(extra_streams.empty())
+            return 0;
+        const auto& indices = ThreadStreamIndices();
+        const auto it       = indices.find(id);
+        return it == indices.end() ? 0 : it->second;
+    }
+
+    float& kernel_time() const { return ThreadKernelTimes()[id]; }
+
     void elapsed_time(hipEvent_t start, hipEvent_t stop)
     {
         if(enable_profiling)
-            hipEventElapsedTime(&this->profiling_result, start, stop);
+            hipEventElapsedTime(&kernel_time(), start, stop);
     }
 
     std::function<void(hipEvent_t, hipEvent_t)> elapsed_time_handler()
@@ -176,6 +314,39 @@ struct HandleImpl
             &HandleImpl::elapsed_time, this, std::placeholders::_1, std::placeholders::_2);
     }
 
+    std::vector<PendingKernelTime>& pending_times() const { return ThreadPendingKernelTimes()[id]; }
+
+    DeferredTimeCallback deferred_time_handler() const
+    {
+        return [this](const std::string& name,
+                      HipEventPool::EventPtr&& start,
+                      HipEventPool::EventPtr&& stop) {
+            pending_times().push_back({name, std::move(start), std::move(stop)});
+        };
+    }
+
+    // Waits for the kernels with deferred timing, their summed times replace the kernel time.
+    void resolve_pending_times() const
+    {
+        auto& pending = pending_times();
+        if(pending.empty())
+            return;
+        auto total = 0.0f;
+        for(const auto& p : pending)
+        {
+            const auto status = hipEventSynchronize(p.stop.get());
+            if(status != hipSuccess)
+                MIOPEN_THROW_HIP_STATUS(status, "Failed to wait for a timed kernel");
+            auto elapsed_ms = 0.0f;
+            hipEventElapsedTime(&elapsed_ms, p.start.get(), p.stop.get());
+            if(trace::IsEnabled())
+                trace::Gpu(p.name, trace::Clock::now(), elapsed_ms);
+            total += elapsed_ms;
+        }
+        pending.clear();
+        kernel_time() = total;
+    }
+
     void set_ctx() const
     {
         miopen::set_ctx(this->ctx);
@@ -185,27 +356,121 @@ struct HandleImpl
             MIOPEN_THROW("Running handle on wrong device");
     }
 
-    std::string get_device_name() const
-    {
-        hipDeviceProp_t props{};
-        hipGetDeviceProperties(&props, device);
-#if ROCM_FEATURE_HIP_GCNARCHNAME_RETURNS_CODENAME
-        const std::string name("gfx" + std::to_string(props.gcnArch));
-#else
-        const std::string name(props.gcnArchName);
-#endif
-        MIOPEN_LOG_NQI("Raw device name: " << name);
-        return name; // NOLINT (performance-no-automatic-move)
-    }
+    const DeviceAttributes& get_attributes() const { return GetDeviceAttributes(device); }
 
-    bool enable_profiling  = false;
-    StreamPtr stream       = nullptr;
-    float profiling_result = 0.0;
-    int device             = -1;
+    std::atomic<bool> enable_profiling{false};
+    std::atomic<bool> defer_kernel_times{false};
+    StreamPtr stream     = nullptr;
+    int device           = -1;
+    bool use_memory_pool = false;
     Allocator allocator{};
     KernelCache cache;
+    HipEventPool event_pool;
     hipCtx_t ctx;
+    // Depends on the device only, initialized on the first use.
+    std::once_flag target_properties_once;
     TargetProperties target_properties;
+    std::mutex captured_buffers_mutex;
+    bool capture_buffers = false;
+    std::vector<Allocator::ManageDataPtr> captured_buffers;
+    const std::uint64_t id = NextHandleId();
+    // Streams 1..N of the pool, stream 0 is the one above.
+    std::vector<PoolStream> extra_streams;
+    std::once_flag peers_once;
+    std::vector<std::unique_ptr<Handle>> peers;
+#if MIOPEN_USE_ROCBLAS
+    // Guards the rocBLAS handles of the streams, created on the first use.
+    std::mutex rocblas_mutex;
+#endif
+#if MIOPEN_USE_HIPBLASLT
+    std::once_flag hipblaslt_once;
+    hipblaslt_handle_ptr hipblaslt;
+#endif
+    /// Pinned host memory of the copies ordered on the streams of the handle. A block is
+    /// reused once the event recorded after its last copy has completed, so the pool grows to
+    /// the number of copies in flight.
+    struct StagingBlock
+    {
+        std::shared_ptr<void> memory;
+        std::size_t size = 0;
+        HipEventPool::EventPtr done;
+    };
+
+    std::mutex staging_mutex;
+    std::vector<StagingBlock> staging;
+
+    StagingBlock take_staging(std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(staging_mutex);
+            const auto it = std::find_if(staging.begin(), staging.end(), [&](const auto& block) {
+                return block.size >= size &&
+                       (block.done == nullptr || hipEventQuery(block.done.get()) == hipSuccess);
+            });
+            if(it != staging.end())
+            {
+                auto block = std::move(*it);
+                staging.erase(it);
+                return block;
+            }
+        }
+
+        auto block = StagingBlock{};
+        block.size = std::size_t{4096};
+        while(block.size < size)
+            block.size *= 2;
+        void* memory      = nullptr;
+        const auto status = hipHostMalloc(&memory, block.size);
+        if(status != hipSuccess)
+            MIOPEN_THROW_HIP_STATUS(status, "Failed to allocate a pinned staging buffer");
+        block.memory = std::shared_ptr<void>{memory, [](void* ptr) { hipHostFree(ptr); }};
+        return block;
+    }
+
+    void return_staging(StagingBlock block)
+    {
+        std::lock_guard<std::mutex> lock(staging_mutex);
+        staging.push_back(std::move(block));
+    }
+
+    // Modules by the md5 of their code objects. Options which the kernels ignore produce
+    // identical code objects, the programs of those share one module.
+    std::mutex modules_mutex;
+    std::unordered_map<std::string, std::weak_ptr<HIPOCProgramImpl>> modules;
+
+    /// Returns the program of the loaded module with the code object, if there is one, or
+    /// the one made by \p load otherwise.
+    HIPOCProgram ShareProgram(const std::string& hsaco,
+                              const std::function<HIPOCProgram()>& load,
+                              MemoryUsage& usage)
+    {
+        const auto hash = md5(hsaco);
+        auto program    = HIPOCProgram{};
+        {
+            std::lock_guard<std::mutex> lock(modules_mutex);
+            const auto it = modules.find(hash);
+            if(it != modules.end())
+                program.impl = it->second.lock();
+        }
+        if(program.impl != nullptr)
+            return program;
+
+        // Loading does not hold the lock, a racing thread may win.
+        program = load();
+        std::lock_guard<std::mutex> lock(modules_mutex);
+        auto& module = modules[hash];
+        if(auto loaded = module.lock())
+        {
+            program.impl = std::move(loaded);
+        }
+        else
+        {
+            module = program.impl;
+            // Unloaded with the handle at the latest, so the modules are not tracked further.
+            usage.Add(MemoryCategory::CodeObjects, hsaco.size());
+        }
+        return program;
+    }
 };
 
 Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
@@ -220,11 +485,9 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
 
     this->SetAllocator(nullptr, nullptr, nullptr);
 
-#if MIOPEN_USE_ROCBLAS
-    rhandle_ = CreateRocblasHandle();
-#endif
-    this->impl->target_properties.Init(this);
     MIOPEN_LOG_NQI(*this);
+    if(miopen::IsEnabled(MIOPEN_WARMUP_KERNEL_CACHE{}))
+        WarmupKernelCache(*this);
 }
 
 Handle::Handle() : impl(new HandleImpl())
@@ -240,27 +503,121 @@ Handle::Handle() : impl(new HandleImpl())
 #endif
     this->SetAllocator(nullptr, nullptr, nullptr);
 
-#if MIOPEN_USE_ROCBLAS
-    rhandle_ = CreateRocblasHandle();
-#endif
-    this->impl->target_properties.Init(this);
     MIOPEN_LOG_NQI(*this);
+    if(miopen::IsEnabled(MIOPEN_WARMUP_KERNEL_CACHE{}))
+        WarmupKernelCache(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    FlushDbWrites();
+    CompileStats::Get().Dump();
+    Metrics::Dump();
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
     this->impl->stream = HandleImpl::reference_stream(streamID);
 
 #if MIOPEN_USE_ROCBLAS
-    rocblas_set_stream(this->rhandle_.get(), this->GetStream());
+    {
+        std::lock_guard<std::mutex> lock(this->impl->rocblas_mutex);
+        if(this->rhandle_ != nullptr)
+            rocblas_set_stream(this->rhandle_.get(), this->impl->stream.get());
+    }
 #endif
-    this->impl->target_properties.Init(this);
     MIOPEN_LOG_NQI(*this);
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const { return impl->stream.get(); }
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    return impl->get_stream(impl->get_stream_index());
+}
+
+void Handle::ReserveExtraStreamsInPool(int count) const
+{
+    this->impl->set_ctx();
+    for(auto i = 0; i < count; ++i)
+    {
+        auto stream = impl->create_stream();
+#if MIOPEN_USE_ROCBLAS
+        std::lock_guard<std::mutex> lock(impl->rocblas_mutex);
+        impl->extra_streams.push_back({std::move(stream), nullptr});
+#else
+        impl->extra_streams.push_back({std::move(stream)});
+#endif
+    }
+    MIOPEN_LOG_I2("Streams in pool: " << GetStreamPoolSize());
+}
+
+void Handle::SetStreamFromPool(int index) const
+{
+    if(index < 0 || index >= GetStreamPoolSize())
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Stream index " + std::to_string(index) + " is out of the pool");
+    if(index == 0)
+        ThreadStreamIndices().erase(impl->id);
+    else
+        ThreadStreamIndices()[impl->id] = index;
+}
+
+int Handle::GetStreamIndexFromPool() const { return impl->get_stream_index(); }
+
+int Handle::GetStreamPoolSize() const { return 1 + static_cast<int>(impl->extra_streams.size()); }
+
+void Handle::WaitStreamInPool(int waiting, int signaling) const
+{
+    for(const auto index : {waiting, signaling})
+    {
+        if(index < 0 || index >= GetStreamPoolSize())
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Stream index " + std::to_string(index) + " is out of the pool");
+    }
+    if(waiting == signaling)
+        return;
+
+    this->impl->set_ctx();
+    const auto event = impl->event_pool.Get();
+    auto status      = hipEventRecord(event.get(), impl->get_stream(signaling));
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to record an event on the stream pool");
+    status = hipStreamWaitEvent(impl->get_stream(waiting), event.get(), 0);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to wait for an event on the stream pool");
+}
+
+std::vector<Handle*> Handle::GetPeers() const
+{
+    std::call_once(impl->peers_once, [&]() {
+        int n;
+        if(hipGetDeviceCount(&n) != hipSuccess)
+            return;
+
+        const auto name   = this->GetDeviceName();
+        const auto num_cu = this->GetMaxComputeUnits();
+
+        for(auto device = 0; device < n; ++device)
+        {
+            if(device == impl->device)
+                continue;
+            set_device(device);
+            auto peer = std::make_unique<Handle>(nullptr);
+            if(peer->GetDeviceName() == name && peer->GetMaxComputeUnits() == num_cu)
+                impl->peers.push_back(std::move(peer));
+            else
+                MIOPEN_LOG_I2("Device " << device << " is not a peer: "
+                                        << peer->GetDeviceName() << ", "
+                                        << peer->GetMaxComputeUnits() << " CUs");
+        }
+        impl->set_ctx();
+        MIOPEN_LOG_I("Peer devices: " << impl->peers.size());
+    });
+
+    auto peers = std::vector<Handle*>{};
+    for(const auto& peer : impl->peers)
+        peers.push_back(peer.get());
+    return peers;
+}
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
@@ -270,17 +627,68 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
     this->impl->allocator.context = allocatorContext;
+    this->impl->use_memory_pool   = allocator == nullptr && DeviceMemoryPool::IsEnabled();
 }
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
 
-float Handle::GetKernelTime() const { return this->impl->profiling_result; }
+void Handle::DeferKernelTimes(bool enable) const
+{
+    if(!enable)
+        this->impl->resolve_pending_times();
+    this->impl->defer_kernel_times = enable && !miopen::IsDisabled(MIOPEN_DEFER_KERNEL_TIMES{});
+}
+
+bool Handle::IsKernelTimeDeferred() const { return this->impl->defer_kernel_times; }
+
+void Handle::FlushKernelTimes() const { this->impl->resolve_pending_times(); }
+
+float Handle::GetKernelTime() const
+{
+    this->impl->resolve_pending_times();
+    return this->impl->kernel_time();
+}
 
 Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
+    AddMetric(*this, Metric::Allocations);
+    AddMetric(*this, Metric::AllocatedBytes, sz);
+    {
+        const std::lock_guard<std::mutex> lock(this->impl->captured_buffers_mutex);
+        if(this->impl->capture_buffers)
+        {
+            // The stream is being captured, so it can not be synchronized.
+            auto buffer = this->impl->use_memory_pool
+                              ? DeviceMemoryPool::Get(this->impl->device).Allocate(sz, GetStream())
+                              : this->impl->allocator(sz);
+            buffer         = Allocator::Track(std::move(buffer), sz, memory_usage);
+            const auto ptr = buffer.get();
+            this->impl->captured_buffers.push_back(std::move(buffer));
+            return Allocator::ManageDataPtr{ptr, AllocatorDeleter{[](void*, void*) {}, nullptr}};
+        }
+    }
+    // Blocks of the pool are reused only on the stream they were released on,
+    // so there is no need to wait for the pending work.
+    if(this->impl->use_memory_pool)
+        return Allocator::Track(
+            DeviceMemoryPool::Get(this->impl->device).Allocate(sz, this->GetStream()),
+            sz,
+            memory_usage);
     this->Finish();
-    return this->impl->allocator(sz);
+    return Allocator::Track(this->impl->allocator(sz), sz, memory_usage);
+}
+
+void Handle::CaptureBuffers(bool enable) const
+{
+    const std::lock_guard<std::mutex> lock(this->impl->captured_buffers_mutex);
+    this->impl->capture_buffers = enable;
+}
+
+std::vector<Allocator::ManageDataPtr> Handle::TakeCapturedBuffers() const
+{
+    const std::lock_guard<std::mutex> lock(this->impl->captured_buffers_mutex);
+    return std::move(this->impl->captured_buffers);
 }
 
 Allocator::ManageDataPtr&
@@ -303,6 +711,117 @@ void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size
         MIOPEN_THROW_HIP_STATUS(status, "Hip error reading from buffer: ");
 }
 
+void Handle::WriteToAsync(const void* data, Data_t ddata, std::size_t sz, std::size_t offset) const
+{
+    if(sz == 0)
+        return;
+    this->impl->set_ctx();
+    auto block = this->impl->take_staging(sz);
+    std::memcpy(block.memory.get(), data, sz);
+    const auto stream = this->GetStream();
+    auto status       = hipMemcpyAsync(
+        static_cast<char*>(ddata) + offset, block.memory.get(), sz, hipMemcpyHostToDevice, stream);
+    if(status == hipSuccess)
+    {
+        block.done = this->impl->event_pool.Get();
+        status     = hipEventRecord(block.done.get(), stream);
+    }
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error writing to buffer: ");
+    this->impl->return_staging(std::move(block));
+}
+
+void Handle::ReadToOrdered(void* data, ConstData_t ddata, std::size_t sz) const
+{
+    if(sz == 0)
+        return;
+    this->impl->set_ctx();
+    auto block        = this->impl->take_staging(sz);
+    const auto stream = this->GetStream();
+    block.done        = this->impl->event_pool.Get();
+    auto status = hipMemcpyAsync(block.memory.get(), ddata, sz, hipMemcpyDeviceToHost, stream);
+    if(status == hipSuccess)
+        status = hipEventRecord(block.done.get(), stream);
+    if(status == hipSuccess)
+        status = hipEventSynchronize(block.done.get());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error reading from buffer: ");
+    std::memcpy(data, block.memory.get(), sz);
+    this->impl->return_staging(std::move(block));
+}
+
+void Handle::CopyAsync(ConstData_t src, Data_t dest, std::size_t size) const
+{
+    this->impl->set_ctx();
+    auto status = hipMemcpyAsync(dest, src, size, hipMemcpyDeviceToDevice, this->GetStream());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error copying buffer: ");
+}
+
+void Handle::ZeroAsync(Data_t ddata, std::size_t sz) const
+{
+    this->impl->set_ctx();
+    auto status = hipMemsetAsync(ddata, 0, sz, this->GetStream());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error clearing buffer: ");
+}
+
+void Handle::Copy2DAsync(ConstData_t src,
+                         std::size_t src_offset,
+                         std::size_t src_pitch,
+                         Data_t dest,
+                         std::size_t dest_offset,
+                         std::size_t dest_pitch,
+                         std::size_t width,
+                         std::size_t height) const
+{
+    this->impl->set_ctx();
+    auto status = hipMemcpy2DAsync(static_cast<char*>(dest) + dest_offset,
+                                   dest_pitch,
+                                   static_cast<const char*>(src) + src_offset,
+                                   src_pitch,
+                                   width,
+                                   height,
+                                   hipMemcpyDeviceToDevice,
+                                   this->GetStream());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error copying buffer: ");
+}
+
+void Handle::FillAsync(Data_t ddata,
+                       std::size_t offset,
+                       std::size_t sz,
+                       const void* pattern,
+                       std::size_t pattern_size) const
+{
+    this->impl->set_ctx();
+    auto* const ptr = static_cast<char*>(ddata) + offset;
+    auto status     = hipSuccess;
+    switch(pattern_size)
+    {
+    case 1: {
+        status = hipMemsetD8Async(
+            ptr, *static_cast<const unsigned char*>(pattern), sz, this->GetStream());
+        break;
+    }
+    case 2: {
+        status = hipMemsetD16Async(
+            ptr, *static_cast<const unsigned short*>(pattern), sz / 2, this->GetStream());
+        break;
+    }
+    case 4: {
+        status = hipMemsetD32Async(
+            ptr, *static_cast<const int*>(pattern), sz / 4, this->GetStream());
+        break;
+    }
+    default:
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Unsupported fill pattern size: " + std::to_string(pattern_size));
+    }
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Hip error filling buffer: ");
+}
+
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
 {
     MIOPEN_HANDLE_LOCK
@@ -364,8 +883,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -378,8 +897,15 @@ bool Handle::HasKernel(const std::string& algorithm, const std::string& network_
 KernelInvoke Handle::Run(Kernel k) const
 {
     this->impl->set_ctx();
-    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
-        return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler());
+    // The MIOPEN_GPU_SYNC builds rely on the launches waiting for the kernels.
+    if(this->impl->enable_profiling && this->impl->defer_kernel_times && !MIOPEN_GPU_SYNC)
+        return k.Invoke(this->GetStream(),
+                        nullptr,
+                        &this->impl->event_pool,
+                        this->impl->deferred_time_handler());
+    else if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
+        return k.Invoke(
+            this->GetStream(), this->impl->elapsed_time_handler(), &this->impl->event_pool);
     else
         return k.Invoke(this->GetStream());
 }
@@ -401,18 +927,51 @@ Program Handle::LoadProgram(const std::string& program_name,
                                     program_name,
                                     params,
                                     is_kernel_str);
+    AddMetric(*this, hsaco.empty() ? Metric::BinaryCacheMisses : Metric::BinaryCacheHits);
+    // The workers build the files of the library only. These include the MLIR programs, which
+    // are generated in parallel without sharing the MIIR state of this process.
+    if(hsaco.empty() && CompileWorkerPool::Get().IsEnabled() && !is_kernel_str &&
+       kernel_src.empty())
+    {
+        CompileTimer ct;
+        hsaco = CompileWorkerPool::Get().Build(program_name, params, this->GetTargetProperties());
+        if(!hsaco.empty())
+        {
+            ct.Log("Kernel (worker)", program_name);
+            CompileStats::Get().AddBuild(program_name, ct.ElapsedMs());
+            AddMetricTime(*this, Metric::Compiles, Metric::CompileUs, ct.ElapsedMs());
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+            miopen::SaveBinary(hsaco,
+                               this->GetTargetProperties(),
+                               this->GetMaxComputeUnits(),
+                               program_name,
+                               params,
+                               is_kernel_str);
+#else
+            auto path = miopen::GetCachePath(false) / boost::filesystem::unique_path();
+            miopen::WriteFile(hsaco, path);
+            miopen::SaveBinary(
+                path, this->GetTargetProperties(), program_name, params, is_kernel_str);
+#endif
+            return this->impl->ShareProgram(
+                hsaco, [&]() { return HIPOCProgram{program_name, hsaco}; }, *memory_usage);
+        }
+    }
     if(hsaco.empty())
     {
         CompileTimer ct;
         auto p = HIPOCProgram{
             program_name, params, is_kernel_str, this->GetTargetProperties(), kernel_src};
         ct.Log("Kernel", is_kernel_str ? std::string() : program_name);
+        CompileStats::Get().AddBuild(is_kernel_str ? "tinygemm.cl" : program_name, ct.ElapsedMs());
+        AddMetricTime(*this, Metric::Compiles, Metric::CompileUs, ct.ElapsedMs());
+
+        hsaco = p.IsCodeObjectInMemory() ? p.GetCodeObjectBlob()
+                                         : miopen::LoadFile(p.GetCodeObjectPathname().string());
 
 // Save to cache
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-        miopen::SaveBinary(p.IsCodeObjectInMemory()
-                               ? p.GetCodeObjectBlob()
-                               : miopen::LoadFile(p.GetCodeObjectPathname().string()),
+        miopen::SaveBinary(hsaco,
                            this->GetTargetProperties(),
                            this->GetMaxComputeUnits(),
                            program_name,
@@ -420,18 +979,16 @@ Program Handle::LoadProgram(const std::string& program_name,
                            is_kernel_str);
 #else
         auto path = miopen::GetCachePath(false) / boost::filesystem::unique_path();
-        if(p.IsCodeObjectInMemory())
-            miopen::WriteFile(p.GetCodeObjectBlob(), path);
-        else
-            boost::filesystem::copy_file(p.GetCodeObjectPathname(), path);
+        miopen::WriteFile(hsaco, path);
         miopen::SaveBinary(path, this->GetTargetProperties(), program_name, params, is_kernel_str);
 #endif
         p.FreeCodeObjectFileStorage();
-        return p;
+        return this->impl->ShareProgram(hsaco, [&]() { return p; }, *memory_usage);
     }
     else
     {
-        return HIPOCProgram{program_name, hsaco};
+        return this->impl->ShareProgram(
+            hsaco, [&]() { return HIPOCProgram{program_name, hsaco}; }, *memory_usage);
     }
 }
 
@@ -447,12 +1004,26 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+void Handle::RemoveProgram(const std::string& program_name, const std::string& params) const
+{
+    this->impl->cache.RemoveProgram(program_name, params);
+}
+
+std::size_t Handle::GetCodeObjectsSize() const { return this->impl->cache.GetCodeObjectsSize(); }
+
+std::vector<std::pair<std::pair<std::string, std::string>, Program>> Handle::GetPrograms() const
+{
+    return this->impl->cache.GetPrograms();
+}
+
+const HipEventPool& Handle::GetEventPool() const { return this->impl->event_pool; }
+
 void Handle::Finish() const
 {
     this->impl->set_ctx();
 #if 0
     auto start = std::chrono::system_clock::now();
-    auto ev    = make_hip_event();
+    auto ev    = this->impl->event_pool.Get();
     hipEventRecord(ev.get(), this->GetStream());
     while(hipEventQuery(ev.get()) == hipErrorNotReady)
     {
@@ -465,7 +1036,7 @@ void Handle::Finish() const
     }
 #else
     // hipStreamSynchronize is broken, so we use hipEventSynchronize instead
-    auto ev = make_hip_event();
+    auto ev = this->impl->event_pool.Get();
     hipEventRecord(ev.get(), this->GetStream());
     auto status = hipEventSynchronize(ev.get());
     if(status != hipSuccess)
@@ -476,29 +1047,23 @@ void Handle::Flush() const {}
 
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
-void Handle::ResetKernelTime() const { this->impl->profiling_result = 0.0; }
-void Handle::AccumKernelTime(float curr_time) const { this->impl->profiling_result += curr_time; }
-
-std::size_t Handle::GetLocalMemorySize() const
+void Handle::ResetKernelTime() const
 {
-    int result;
-    auto status = hipDeviceGetAttribute(
-        &result, hipDeviceAttributeMaxSharedMemoryPerBlock, this->impl->device);
-    if(status != hipSuccess)
-        MIOPEN_THROW_HIP_STATUS(status);
-
-    return result;
+    this->impl->pending_times().clear();
+    this->impl->kernel_time() = 0.0;
 }
 
-std::size_t Handle::GetGlobalMemorySize() const
+void Handle::AccumKernelTime(float curr_time) const
 {
-    size_t result;
-    auto status = hipDeviceTotalMem(&result, this->impl->device);
+    this->impl->resolve_pending_times();
+    this->impl->kernel_time() += curr_time;
+}
 
-    if(status != hipSuccess)
-        MIOPEN_THROW_HIP_STATUS(status);
+std::size_t Handle::GetLocalMemorySize() const { return this->impl->get_attributes().local_mem; }
 
-    return result;
+std::size_t Handle::GetGlobalMemorySize() const
+{
+    return this->impl->get_attributes().global_mem;
 }
 
 std::size_t Handle::GetMaxComputeUnits() const
@@ -507,55 +1072,51 @@ std::size_t Handle::GetMaxComputeUnits() const
     if(num_cu > 0)
         return num_cu;
 
-    int result;
-    auto status =
-        hipDeviceGetAttribute(&result, hipDeviceAttributeMultiprocessorCount, this->impl->device);
-    if(status != hipSuccess)
-        MIOPEN_THROW_HIP_STATUS(status);
-
-    return result;
+    return this->impl->get_attributes().num_cu;
 }
 
-std::size_t Handle::GetImage3dMaxWidth() const
+std::size_t Handle::GetMaxClockFrequency() const
 {
-    int result;
-    auto status = hipDeviceGetAttribute(&result, hipDeviceAttributeMaxGridDimX, this->impl->device);
-    if(status != hipSuccess)
-        MIOPEN_THROW_HIP_STATUS(status);
-
-    return result;
+    return this->impl->get_attributes().max_clock;
 }
 
-std::size_t Handle::GetWavefrontWidth() const
+std::size_t Handle::GetCurrentClockFrequency() const
 {
-    hipDeviceProp_t props{};
-    hipGetDeviceProperties(&props, this->impl->device);
-    auto result = static_cast<size_t>(props.warpSize);
-    return result;
+    const auto& path = this->impl->get_attributes().sclk_path;
+    if(path.empty())
+        return 0;
+
+    // Levels are listed as "1: 1000Mhz *", with the current one marked.
+    std::ifstream file{path};
+    std::string line;
+    while(std::getline(file, line))
+    {
+        const auto colon = line.find(':');
+        if(colon != std::string::npos && line.find('*') != std::string::npos)
+            return std::strtoul(line.c_str() + colon + 1, nullptr, 10);
+    }
+    return 0;
 }
 
+std::size_t Handle::GetImage3dMaxWidth() const { return this->impl->get_attributes().max_grid_x; }
+
+std::size_t Handle::GetWavefrontWidth() const { return this->impl->get_attributes().warp_size; }
+
 // No HIP API that could return maximum memory allocation size
 // for a single object.
 std::size_t Handle::GetMaxMemoryAllocSize()
 {
-    if(m_MaxMemoryAllocSizeCached == 0)
-    {
-        size_t free, total;
-        auto status = hipMemGetInfo(&free, &total);
-        if(status != hipSuccess)
-            MIOPEN_THROW_HIP_STATUS(status, "Failed getting available memory");
-        m_MaxMemoryAllocSizeCached = floor(total * 0.85);
-    }
-
-    return m_MaxMemoryAllocSizeCached;
+    return floor(this->impl->get_attributes().global_mem * 0.85);
 }
 
-std::string Handle::GetDeviceNameImpl() const { return this->impl->get_device_name(); }
+std::string Handle::GetDeviceNameImpl() const { return this->impl->get_attributes().name; }
 
-std::string Handle::GetDeviceName() const { return this->impl->target_properties.Name(); }
+std::string Handle::GetDeviceName() const { return this->GetTargetProperties().Name(); }
 
 const TargetProperties& Handle::GetTargetProperties() const
 {
+    std::call_once(this->impl->target_properties_once,
+                   [&]() { this->impl->target_properties.Init(this); });
     return this->impl->target_properties;
 }
 
@@ -578,13 +1139,53 @@ shared<ConstData_t> Handle::CreateSubBuffer(ConstData_t data, std::size_t offset
 }
 
 #if MIOPEN_USE_ROCBLAS
-rocblas_handle_ptr Handle::CreateRocblasHandle() const
+const rocblas_handle_ptr& Handle::rhandle() const
+{
+    const auto index = impl->get_stream_index();
+    std::lock_guard<std::mutex> lock(impl->rocblas_mutex);
+    auto& result = index == 0 ? rhandle_ : impl->extra_streams[index - 1].rhandle;
+    // The initialization of rocBLAS is expensive, so the handles without GEMMs skip it.
+    if(result == nullptr)
+        result = CreateRocblasHandle(impl->get_stream(index));
+    return result;
+}
+
+std::size_t Handle::GetRocblasMemorySize() const
 {
+    const auto get_size = [](const rocblas_handle_ptr& rhandle) {
+        auto size = std::size_t{0};
+        if(rhandle != nullptr)
+            rocblas_get_device_memory_size(rhandle.get(), &size);
+        return size;
+    };
+    std::lock_guard<std::mutex> lock(impl->rocblas_mutex);
+    auto result = get_size(rhandle_);
+    for(const auto& stream : impl->extra_streams)
+        result += get_size(stream.rhandle);
+    return result;
+}
+
+rocblas_handle_ptr Handle::CreateRocblasHandle(miopenAcceleratorQueue_t stream) const
+{
+    this->impl->set_ctx();
     rocblas_handle x = nullptr;
     rocblas_create_handle(&x);
     auto result = rocblas_handle_ptr{x};
-    rocblas_set_stream(result.get(), GetStream());
+    rocblas_set_stream(result.get(), stream);
     return result;
 }
 #endif
+
+#if MIOPEN_USE_HIPBLASLT
+hipblasLtHandle_t Handle::GetHipblasLtHandle() const
+{
+    std::call_once(impl->hipblaslt_once, [&] {
+        hipblasLtHandle_t x = nullptr;
+        if(hipblasLtCreate(&x) != HIPBLAS_STATUS_SUCCESS)
+            MIOPEN_THROW(miopenStatusInternalError, "Failed to create the hipBLASLt handle");
+        impl->hipblaslt = hipblaslt_handle_ptr{x};
+    });
+    return impl->hipblaslt.get();
+}
+#endif
 } // namespace miopen
@@ -25,7 +25,9 @@
  *******************************************************************************/
 
 #include <miopen/config.h>
+#include <miopen/binary_cache.hpp>
 #include <miopen/hip_build_utils.hpp>
+#include <miopen/md5.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/exec_utils.hpp>
 #include <miopen/logger.hpp>
@@ -33,6 +35,8 @@
 #include <miopen/rocm_features.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
 #include <miopen/target_properties.hpp>
+#include <miopen/write_file.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/optional.hpp>
 #include <sstream>
 #include <string>
@@ -40,6 +44,8 @@
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_ENFORCE_COV3)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_VERBOSE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_DUMP)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_INCLUDE_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_CK_PCH)
 
 namespace miopen {
 
@@ -84,6 +90,127 @@ inline const std::string& GetCoV3Option(const bool enable)
     else
         return no_option;
 }
+
+/// Moves a freshly written temporary into its final place in the cache. Another process may
+/// have won the race meanwhile, then its result is used and ours is thrown away.
+void CommitCacheEntry(const boost::filesystem::path& tmp, const boost::filesystem::path& path)
+{
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmp, path, ec);
+    if(ec)
+        boost::filesystem::remove_all(tmp, ec);
+}
+
+std::string GetHipIncludeSetKey()
+{
+    std::string key = std::string{MIOPEN_HIP_COMPILER} + ':' +
+                      std::to_string(HipCompilerVersion().major) + '.' +
+                      std::to_string(HipCompilerVersion().minor) + '.' +
+                      std::to_string(HipCompilerVersion().patch);
+    for(const auto& inc_file : GetHipKernelIncList())
+        key += ':' + inc_file + ':' + md5(GetKernelInc(inc_file));
+    return md5(key);
+}
+
+boost::filesystem::path GetHipIncludeCacheImpl()
+{
+    if(IsDisabled(MIOPEN_DEBUG_HIP_INCLUDE_CACHE{}))
+        return {};
+    const auto cache_path = GetCachePath(false);
+    if(cache_path.empty())
+        return {};
+
+    const auto path = cache_path / "hip_include" / GetHipIncludeSetKey();
+    try
+    {
+        if(!boost::filesystem::exists(path))
+        {
+            const auto tmp = path.parent_path() / boost::filesystem::unique_path("%%%%-%%%%.tmp");
+            boost::filesystem::create_directories(tmp);
+            for(const auto& inc_file : GetHipKernelIncList())
+                WriteFile(GetKernelInc(inc_file), tmp / inc_file);
+            CommitCacheEntry(tmp, path);
+        }
+        if(boost::filesystem::exists(path))
+        {
+            MIOPEN_LOG_I2(path.string());
+            return path;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to create HIP include cache " << path.string() << ": " << ex.what());
+    }
+    return {};
+}
+
+/// The directory holding all the HIP kernel includes, shared by all the builds of the current
+/// library and compiler versions. The include files are written out once instead of into the
+/// temporary directory of every build. Empty when the user cache is not available.
+const boost::filesystem::path& GetHipIncludeCache()
+{
+    static const auto once = GetHipIncludeCacheImpl();
+    return once;
+}
+
+/// The static CK sources start with this header which pulls in most of the CK include tree.
+const std::string& GetCkCommonHeader()
+{
+    static const std::string header{"static_kernel_common_header.hpp"};
+    return header;
+}
+
+bool IsCkPchApplicable(const std::string& filename, const std::string& src)
+{
+    if(!IsHipClangCompiler() || IsDisabled(MIOPEN_DEBUG_HIP_CK_PCH{}))
+        return false;
+    if(!StartsWith(filename, "static_kernel_") || GetHipIncludeCache().empty())
+        return false;
+    const auto include = "#include \"" + GetCkCommonHeader() + '"';
+    const auto pos     = src.find("#include");
+    return pos != std::string::npos && src.compare(pos, include.size(), include) == 0;
+}
+
+/// Returns the precompiled CK common header matching the build options, building it first if
+/// needed, or an empty path on failure. The per-kernel CK_PARAM_* macros are defined after the
+/// header at the point they are used only, so they are left out of the key and of the PCH build.
+/// Clang still verifies that the remaining macros of the PCH match the command line.
+boost::filesystem::path GetCkPch(TmpDir& tmp_dir, const std::string& params)
+{
+    std::string pch_params;
+    for(const auto& option : SplitSpaceSeparated(params))
+    {
+        if(StartsWith(option, "-DCK_PARAM_"))
+            continue;
+        pch_params += ' ' + option;
+    }
+    const auto key  = GetHipIncludeSetKey() + ':' + pch_params;
+    const auto path = GetHipIncludeCache().parent_path().parent_path() / "ck_pch" /
+                      (md5(key) + ".pch");
+    try
+    {
+        if(!boost::filesystem::exists(path))
+        {
+            const auto tmp = path.parent_path() / boost::filesystem::unique_path("%%%%-%%%%.tmp");
+            boost::filesystem::create_directories(path.parent_path());
+            MIOPEN_LOG_I("Building " << path.string());
+            tmp_dir.Execute(MIOPEN_HIP_COMPILER,
+                            pch_params + " -x hip -Xclang -emit-pch " +
+                                (GetHipIncludeCache() / GetCkCommonHeader()).string() + " -o " +
+                                tmp.string());
+            if(!boost::filesystem::exists(tmp))
+                MIOPEN_THROW("PCH build failed");
+            CommitCacheEntry(tmp, path);
+        }
+        if(boost::filesystem::exists(path))
+            return path;
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to use the CK PCH " << path.string() << ": " << ex.what());
+    }
+    return {};
+}
 } // namespace
 
 static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
@@ -97,7 +224,9 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
 #ifdef __linux__
     // Write out the include files
     // Let's assume includes are overkill for feature tests & optimize'em out.
-    if(!testing_mode)
+    const auto& inc_cache = testing_mode ? boost::filesystem::path{} : GetHipIncludeCache();
+    const bool use_ck_pch = !testing_mode && IsCkPchApplicable(filename, src);
+    if(!testing_mode && inc_cache.empty())
     {
         auto inc_list = GetHipKernelIncList();
         auto inc_path = tmp_dir->path;
@@ -141,6 +270,8 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
     }
 
     params += " -Wno-unused-command-line-argument -I. ";
+    if(!inc_cache.empty())
+        params += "-I" + inc_cache.string() + " ";
     params += MIOPEN_STRINGIZE(HIP_COMPILER_FLAGS);
     if(IsHccCompiler())
     {
@@ -181,6 +312,12 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
         std::string(" -DHIP_PACKAGE_VERSION_FLAT=") + std::to_string(HIP_PACKAGE_VERSION_FLAT);
 
     params += " ";
+    if(use_ck_pch)
+    {
+        const auto pch = GetCkPch(*tmp_dir, params);
+        if(!pch.empty())
+            params += "-Xclang -include-pch -Xclang " + pch.string() + " ";
+    }
     auto bin_file = tmp_dir->path / (filename + ".o");
 
     // compile
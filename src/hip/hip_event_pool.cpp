@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/hip_event_pool.hpp>
+
+#include <miopen/errors.hpp>
+
+#include <mutex>
+#include <vector>
+
+namespace miopen {
+
+struct HipEventPool::State
+{
+    // Idle events above the limit are destroyed, a burst of concurrent launches
+    // shall not keep driver resources forever.
+    static constexpr std::size_t max_idle = 64;
+
+    ~State()
+    {
+        for(auto event : idle)
+            hipEventDestroy(event);
+    }
+
+    std::mutex mutex;
+    std::vector<hipEvent_t> idle;
+};
+
+void HipEventPool::Releaser::operator()(hipEvent_t event) const
+{
+    if(state != nullptr)
+    {
+        const std::lock_guard<std::mutex> lock(state->mutex);
+        if(state->idle.size() < State::max_idle)
+        {
+            state->idle.push_back(event);
+            return;
+        }
+    }
+    hipEventDestroy(event);
+}
+
+HipEventPool::HipEventPool() : state(std::make_shared<State>()) {}
+
+HipEventPool::EventPtr HipEventPool::Get() const
+{
+    {
+        const std::lock_guard<std::mutex> lock(state->mutex);
+        if(!state->idle.empty())
+        {
+            const auto event = state->idle.back();
+            state->idle.pop_back();
+            return EventPtr{event, Releaser{state}};
+        }
+    }
+
+    hipEvent_t event  = nullptr;
+    const auto status = hipEventCreate(&event);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to create event");
+    return EventPtr{event, Releaser{state}};
+}
+
+std::size_t HipEventPool::GetIdleCount() const
+{
+    const std::lock_guard<std::mutex> lock(state->mutex);
+    return state->idle.size();
+}
+
+} // namespace miopen
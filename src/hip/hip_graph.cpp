@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/hip_graph.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+namespace miopen {
+
+void HipGraph::BeginCapture(const Handle& handle)
+{
+    if(handle.GetStream() == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Graph capture is not supported on the null stream");
+    if(handle.IsProfilingEnabled())
+        MIOPEN_THROW(miopenStatusBadParm, "Graph capture is not supported with profiling");
+
+    handle.CaptureBuffers(true);
+    const auto status = hipStreamBeginCapture(handle.GetStream(), hipStreamCaptureModeRelaxed);
+    if(status != hipSuccess)
+    {
+        handle.CaptureBuffers(false);
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to begin graph capture");
+    }
+}
+
+void HipGraph::EndCapture(const Handle& handle)
+{
+    hipGraph_t captured = nullptr;
+    const auto status   = hipStreamEndCapture(handle.GetStream(), &captured);
+    handle.CaptureBuffers(false);
+    auto captured_buffers = handle.TakeCapturedBuffers();
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to end graph capture");
+
+    auto new_graph = HipGraphPtr{captured};
+
+    if(exec != nullptr)
+    {
+        hipGraphNode_t error_node = nullptr;
+        auto result               = hipGraphExecUpdateError;
+        if(hipGraphExecUpdate(exec.get(), new_graph.get(), &error_node, &result) == hipSuccess &&
+           result == hipGraphExecUpdateSuccess)
+        {
+            graph   = std::move(new_graph);
+            buffers = std::move(captured_buffers);
+            return;
+        }
+        MIOPEN_LOG_I2("Graph can not be updated in place, instantiating it again");
+    }
+
+    hipGraphExec_t instance = nullptr;
+    const auto inst_status  = hipGraphInstantiate(&instance, new_graph.get(), nullptr, nullptr, 0);
+    if(inst_status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(inst_status, "Failed to instantiate graph");
+
+    exec    = HipGraphExecPtr{instance};
+    graph   = std::move(new_graph);
+    buffers = std::move(captured_buffers);
+}
+
+void HipGraph::Launch(const Handle& handle) const
+{
+    if(exec == nullptr)
+        MIOPEN_THROW("Graph has not been captured");
+    const auto status = hipGraphLaunch(exec.get(), handle.GetStream());
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed to launch graph");
+}
+
+} // namespace miopen
@@ -28,22 +28,32 @@
 #include <miopen/errors.hpp>
 #include <miopen/hipoc_kernel.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/trace.hpp>
 
 #include <hip/hip_ext.h>
 #include <hip/hip_runtime.h>
 
 #include <chrono>
 #include <thread>
+#include <utility>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
 
 namespace miopen {
 
+static bool IsUniformGrid(const std::array<size_t, 3>& gdims, const std::array<size_t, 3>& ldims)
+{
+    for(auto i = 0; i < 3; ++i)
+        if(ldims[i] == 0 || gdims[i] % ldims[i] != 0)
+            return false;
+    return true;
+}
+
 void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 {
-    HipEventPtr start = nullptr;
-    HipEventPtr stop  = nullptr;
-    void* config[]    = {// HIP_LAUNCH_PARAM_* are macros that do horrible things
+    HipEventPool::EventPtr start;
+    HipEventPool::EventPtr stop;
+    void* config[] = {// HIP_LAUNCH_PARAM_* are macros that do horrible things
                       // NOLINTNEXTLINE cppcoreguidelines-pro-type-cstyle-cast
                       HIP_LAUNCH_PARAM_BUFFER_POINTER,
                       args,
@@ -52,10 +62,19 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
                       &size,
                       // NOLINTNEXTLINE cppcoreguidelines-pro-type-cstyle-cast
                       HIP_LAUNCH_PARAM_END};
-    if(callback)
+    const bool timed = callback || deferred_callback;
+    if(timed)
     {
-        start = make_hip_event();
-        stop  = make_hip_event();
+        if(event_pool != nullptr)
+        {
+            start = event_pool->Get();
+            stop  = event_pool->Get();
+        }
+        else
+        {
+            start = HipEventPool::EventPtr{make_hip_event().release(), {}};
+            stop  = HipEventPool::EventPtr{make_hip_event().release(), {}};
+        }
     }
 
     const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
@@ -66,6 +85,31 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 
     MIOPEN_HANDLE_LOCK
 
+    // The GPU time is only known with the events of the profiling.
+    if(!timed)
+        trace::Instant("kernel", name);
+
+    // Unlike hipHccModuleLaunchKernel, hipModuleLaunchKernel can be recorded by stream
+    // capture. It takes the grid in work-groups, so is used only when no events are
+    // needed and the global size is a multiple of the work-group size.
+    if(!timed && IsUniformGrid(gdims, ldims))
+    {
+        const auto status = hipModuleLaunchKernel(fun,
+                                                  gdims[0] / ldims[0],
+                                                  gdims[1] / ldims[1],
+                                                  gdims[2] / ldims[2],
+                                                  ldims[0],
+                                                  ldims[1],
+                                                  ldims[2],
+                                                  0,
+                                                  stream,
+                                                  nullptr,
+                                                  reinterpret_cast<void**>(&config));
+        if(status != hipSuccess)
+            MIOPEN_THROW_HIP_STATUS(status, "Failed to launch kernel");
+        return;
+    }
+
     auto status = hipHccModuleLaunchKernel(fun,
                                            gdims[0],
                                            gdims[1],
@@ -82,6 +126,12 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
     if(status != hipSuccess)
         MIOPEN_THROW_HIP_STATUS(status, "Failed to launch kernel");
 
+    if(deferred_callback)
+    {
+        deferred_callback(name, std::move(start), std::move(stop));
+        return;
+    }
+
     if(callback)
     {
 #if 0
@@ -98,13 +148,22 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 #else
         hipEventSynchronize(stop.get());
 #endif
+        if(trace::IsEnabled())
+        {
+            auto elapsed_ms = 0.0f;
+            hipEventElapsedTime(&elapsed_ms, start.get(), stop.get());
+            trace::Gpu(name, trace::Clock::now(), elapsed_ms);
+        }
         callback(start.get(), stop.get());
     }
 }
 
 HIPOCKernelInvoke HIPOCKernel::Invoke(hipStream_t stream,
-                                      std::function<void(hipEvent_t, hipEvent_t)> callback) const
+                                      std::function<void(hipEvent_t, hipEvent_t)> callback,
+                                      const HipEventPool* event_pool,
+                                      DeferredTimeCallback deferred_callback) const
 {
-    return HIPOCKernelInvoke{stream, fun, ldims, gdims, name, callback};
+    return HIPOCKernelInvoke{
+        stream, fun, ldims, gdims, name, callback, event_pool, deferred_callback};
 }
 } // namespace miopen
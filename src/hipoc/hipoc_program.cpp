@@ -31,6 +31,7 @@
 #include <miopen/hipoc_program.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/kernel_warnings.hpp>
+#include <miopen/load_file.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/mlir_build.hpp>
 #include <miopen/stringutils.hpp>
@@ -40,6 +41,7 @@
 #include <miopen/env.hpp>
 #include <miopen/comgr.hpp>
 #include <miopen/logger.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/optional.hpp>
 
 #include <cstring>
@@ -174,16 +176,14 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
                                    const boost::filesystem::path& filespec)
     : program(program_name), hsaco_file(filespec)
 {
-    module = CreateModule(hsaco_file);
+    code_object_size = boost::filesystem::file_size(hsaco_file);
+    hipGetDevice(&device);
 }
 
 HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name, const std::string& blob)
-    : program(program_name) ///, module(CreateModuleInMem(blob))
+    : program(program_name), code_object_size(blob.size()), lazy_blob(blob)
 {
-    if(nullptr !=
-       miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{})) /// \todo Finish off this spaghetti eventually.
-        return;
-    module = CreateModuleInMem(blob);
+    hipGetDevice(&device);
 }
 
 HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
@@ -195,17 +195,47 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
 {
     BuildCodeObject(params, is_kernel_str, kernel_src);
     if(!binary.empty())
-    {
-        module = CreateModuleInMem(binary);
-    }
+        code_object_size = binary.size();
     else
+        code_object_size = boost::filesystem::file_size(hsaco_file);
+    hipGetDevice(&device);
+}
+
+hipModule_t HIPOCProgramImpl::GetModule()
+{
+    std::lock_guard<std::mutex> lock(module_mutex);
+    if(module != nullptr)
+        return module.get();
+    if(nullptr !=
+       miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{})) /// \todo Finish off this spaghetti eventually.
+        return nullptr;
+
+    // Kernels may be created by a thread which uses another device.
+    int current = -1;
+    hipGetDevice(&current);
+    if(device >= 0 && current != device)
+        hipSetDevice(device);
+    try
     {
-        const char* const arch = miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{});
-        if(arch == nullptr)
-        {
+        if(!lazy_blob.empty())
+            module = CreateModuleInMem(lazy_blob);
+        else if(!binary.empty())
+            module = CreateModuleInMem(binary);
+        else
             module = CreateModule(hsaco_file);
-        }
     }
+    catch(...)
+    {
+        if(device >= 0 && current != device)
+            hipSetDevice(current);
+        throw;
+    }
+    if(device >= 0 && current != device)
+        hipSetDevice(current);
+
+    MIOPEN_LOG_I2("Loaded module of " << program);
+    lazy_blob = std::string{};
+    return module.get();
 }
 
 #if !MIOPEN_USE_COMGR
@@ -263,6 +293,13 @@ void HIPOCProgramImpl::BuildCodeObjectInMemory(const std::string& params,
         binary.resize(sz);
         std::memcpy(&binary[0], src.c_str(), sz);
     }
+#if MIOPEN_USE_MLIR
+    else if(miopen::EndsWith(filename, ".mlir"))
+    {
+        // MIIR produces the code object itself, so it does not wait for the COMgr lock.
+        MiirGenBin(params, binary);
+    }
+#endif
     else
     {
 #if MIOPEN_WORKAROUND_ROCM_COMPILER_SUPPORT_ISSUE_27
@@ -347,7 +384,7 @@ HIPOCProgram::HIPOCProgram(const std::string& program_name, const std::string& h
 {
 }
 
-hipModule_t HIPOCProgram::GetModule() const { return impl->module.get(); }
+hipModule_t HIPOCProgram::GetModule() const { return impl->GetModule(); }
 
 boost::filesystem::path HIPOCProgram::GetCodeObjectPathname() const
 {
@@ -368,10 +405,22 @@ std::string HIPOCProgram::GetCodeObjectBlob() const
 
 void HIPOCProgram::FreeCodeObjectFileStorage()
 {
+    {
+        // The module may still need the code object.
+        std::lock_guard<std::mutex> lock(impl->module_mutex);
+        if(impl->module == nullptr && impl->binary.empty() && !impl->hsaco_file.empty() &&
+           impl->lazy_blob.empty())
+            impl->lazy_blob = LoadFile(impl->hsaco_file.string());
+    }
     impl->dir = boost::none;
     impl->hsaco_file.clear();
 }
 
 bool HIPOCProgram::IsCodeObjectInMemory() const { return !impl->binary.empty(); };
 
+std::size_t HIPOCProgram::GetCodeObjectSize() const
+{
+    return impl != nullptr ? impl->code_object_size : 0;
+}
+
 } // namespace miopen
@@ -27,8 +27,13 @@
 #pragma once
 
 #include <miopen/activ.hpp>
+#include <miopen/conv/problem_description.hpp>
 #include <miopen/tensor.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
 
+#include <functional>
 #include <string>
 
 namespace miopen {
@@ -44,6 +49,9 @@ enum class Direction
 };
 
 struct ProblemDescription
+#if MIOPEN_ENABLE_SQLITE
+    : SQLiteSerializable<ProblemDescription>
+#endif
 {
     // Forward constructor
     ProblemDescription(const ActivationDescriptor& activ,
@@ -87,10 +95,37 @@ struct ProblemDescription
         return yDesc;
     }
 
+    bool IsPacked() const
+    {
+        const auto packed = xDesc.IsPacked() && yDesc.IsPacked();
+        if(direction == Direction::Forward)
+            return packed;
+        return packed && dxDesc.IsPacked() && dyDesc.IsPacked();
+    }
+
     NetworkConfig MakeNetworkConfig() const;
 
+    /// The perf-db key, e.g. 3136-64-packed-FP32-F-m3
     void Serialize(std::ostream& stream) const;
 
+    static std::string table_name() { return "activ_config"; }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(int, std::string)> f)
+    {
+        f(static_cast<int>(self.GetHeight()), "height");
+        f(static_cast<int>(self.GetWidth()), "width");
+        f(static_cast<int>(self.IsPacked()), "packed");
+        f(static_cast<int>(self.activDesc.GetMode()), "mode");
+    }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(std::string, std::string)> f)
+    {
+        f(GetDataTypeName(self.xDesc.GetType()), "data_type");
+        f(self.GetDirectionName(), "direction");
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
     {
         obj.Serialize(os);
@@ -98,6 +133,10 @@ struct ProblemDescription
     }
 
     private:
+    std::size_t GetWidth() const { return xDesc.GetLengths().back(); }
+    std::size_t GetHeight() const { return xDesc.GetElementSize() / GetWidth(); }
+    std::string GetDirectionName() const { return direction == Direction::Forward ? "F" : "B"; }
+
     Direction direction;
     ActivationDescriptor activDesc;
     TensorDescriptor xDesc;
@@ -43,6 +43,37 @@ namespace activ {
 using OldStyleProblemDescription =
     std::tuple<const ExecutionContext*, const miopen::activ::ProblemDescription*>;
 
+struct PerformanceConfigActiv : Serializable<PerformanceConfigActiv>
+{
+    int read_unit;       // 2^n[1..8], elements of a vector load, 8 only for 16-bit types
+    int vecs_per_thread; // 2^n[1..8], vectors loaded by a work-item before any is computed
+    int grid_size;       // 0 or 2^n[64..4096], work-groups striding over the tensor,
+                         // 0 launches enough of them to cover it in one pass
+
+    PerformanceConfigActiv(int read_unit_, int vecs_per_thread_, int grid_size_)
+        : read_unit(read_unit_), vecs_per_thread(vecs_per_thread_), grid_size(grid_size_)
+    {
+    }
+    PerformanceConfigActiv() : PerformanceConfigActiv(-1, -1, -1) {}
+    PerformanceConfigActiv(bool) : PerformanceConfigActiv(1, 1, 0) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.read_unit, "read_unit");
+        f(self.vecs_per_thread, "vecs_per_thread");
+        f(self.grid_size, "grid_size");
+    }
+
+    void HeuristicInit(const miopen::activ::ProblemDescription& problem);
+    bool IsValidValue() const;
+    bool SetNextValue(const miopen::activ::ProblemDescription& problem);
+    bool IsValid(const miopen::activ::ProblemDescription& problem) const;
+    bool operator==(const PerformanceConfigActiv& other) const;
+};
+
+/// Packed tensors and 2D tensors with padded rows. The packed ones are processed with wide
+/// vector loads in a grid-strided loop, the geometry of which is tuned.
 struct ActivFwdSolver0 : public SolverBase<OldStyleProblemDescription>
 {
     inline bool IsApplicable(const OldStyleProblemDescription& problem) const
@@ -52,13 +83,25 @@ struct ActivFwdSolver0 : public SolverBase<OldStyleProblemDescription>
 
     inline ConvSolution GetSolution(const OldStyleProblemDescription& problem) const
     {
-        return GetSolution(*std::get<0>(problem), *std::get<1>(problem));
+        const auto& context    = *std::get<0>(problem);
+        const auto& activ_prob = *std::get<1>(problem);
+        return GetSolution(context, activ_prob, GetPerformanceConfig(context, activ_prob));
     }
 
     bool IsApplicable(const ExecutionContext& context,
                       const miopen::activ::ProblemDescription& problem) const;
+    PerformanceConfigActiv
+    GetPerformanceConfig(const ExecutionContext& context,
+                         const miopen::activ::ProblemDescription& problem) const;
+    bool IsValidPerformanceConfig(const ExecutionContext& context,
+                                  const miopen::activ::ProblemDescription& problem,
+                                  const PerformanceConfigActiv& config) const;
+    PerformanceConfigActiv Search(const ExecutionContext& context,
+                                  const miopen::activ::ProblemDescription& problem,
+                                  const AnyInvokeParams& invoke_ctx) const;
     ConvSolution GetSolution(const ExecutionContext& context,
-                             const miopen::activ::ProblemDescription& problem) const;
+                             const miopen::activ::ProblemDescription& problem,
+                             const PerformanceConfigActiv& config) const;
 };
 
 struct ActivFwdSolver1 : public SolverBase<OldStyleProblemDescription>
@@ -88,13 +131,25 @@ struct ActivBwdSolver0 : public SolverBase<OldStyleProblemDescription>
 
     inline ConvSolution GetSolution(const OldStyleProblemDescription& problem) const
     {
-        return GetSolution(*std::get<0>(problem), *std::get<1>(problem));
+        const auto& context    = *std::get<0>(problem);
+        const auto& activ_prob = *std::get<1>(problem);
+        return GetSolution(context, activ_prob, GetPerformanceConfig(context, activ_prob));
     }
 
     bool IsApplicable(const ExecutionContext& context,
                       const miopen::activ::ProblemDescription& problem) const;
+    PerformanceConfigActiv
+    GetPerformanceConfig(const ExecutionContext& context,
+                         const miopen::activ::ProblemDescription& problem) const;
+    bool IsValidPerformanceConfig(const ExecutionContext& context,
+                                  const miopen::activ::ProblemDescription& problem,
+                                  const PerformanceConfigActiv& config) const;
+    PerformanceConfigActiv Search(const ExecutionContext& context,
+                                  const miopen::activ::ProblemDescription& problem,
+                                  const AnyInvokeParams& invoke_ctx) const;
     ConvSolution GetSolution(const ExecutionContext& context,
-                             const miopen::activ::ProblemDescription& problem) const;
+                             const miopen::activ::ProblemDescription& problem,
+                             const PerformanceConfigActiv& config) const;
 };
 
 struct ActivBwdSolver1 : public SolverBase<OldStyleProblemDescription>
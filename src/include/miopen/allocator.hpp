@@ -2,18 +2,30 @@
 #define GUARD_MLOPEN_ALLOCATOR_HPP
 
 #include <cassert>
+#include <memory>
 
 #include <miopen/common.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/manage_ptr.hpp>
+#include <miopen/memory_usage.hpp>
 #include <miopen/miopen.h>
 
 namespace miopen {
 
 struct AllocatorDeleter
 {
-    miopenDeallocatorFunction deallocator;
-    void* context;
+    AllocatorDeleter() = default;
+    AllocatorDeleter(miopenDeallocatorFunction deallocator_, void* context_)
+        : deallocator(deallocator_), context(context_)
+    {
+    }
+
+    miopenDeallocatorFunction deallocator = nullptr;
+    void* context                         = nullptr;
+    /// Where the buffer is accounted, see Allocator::Track().
+    std::shared_ptr<MemoryUsage> usage = nullptr;
+    std::size_t size                   = 0;
+    MemoryCategory category            = MemoryCategory::Buffers;
 
     template <class T>
     void operator()(T* x) const
@@ -22,6 +34,8 @@ struct AllocatorDeleter
         if(x != nullptr)
         {
             deallocator(context, x);
+            if(usage != nullptr)
+                usage->Remove(category, size);
         }
     }
 };
@@ -46,6 +60,20 @@ struct Allocator
         }
         return ManageDataPtr{DataCast(result), AllocatorDeleter{deallocator, context}};
     }
+
+    /// Accounts the buffer in \p usage, in the category of MemoryCategoryScope, until it is freed.
+    static ManageDataPtr
+    Track(ManageDataPtr buffer, std::size_t size, const std::shared_ptr<MemoryUsage>& usage)
+    {
+        if(buffer == nullptr)
+            return buffer;
+        auto deleter     = buffer.get_deleter();
+        deleter.usage    = usage;
+        deleter.size     = size;
+        deleter.category = MemoryCategoryScope::Current();
+        usage->Add(deleter.category, size);
+        return ManageDataPtr{buffer.release(), std::move(deleter)};
+    }
 };
 
 } // namespace miopen
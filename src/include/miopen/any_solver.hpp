@@ -65,6 +65,21 @@ struct AnySolver
         assert(ptr_value != nullptr);
         return ptr_value->GetWti(ctx);
     };
+    bool IsDeterministic(const ConvolutionContext& ctx) const
+    {
+        assert(ptr_value != nullptr);
+        return ptr_value->IsDeterministic(ctx);
+    };
+    bool SupportsAlphaBeta(const ConvolutionContext& ctx) const
+    {
+        assert(ptr_value != nullptr);
+        return ptr_value->SupportsAlphaBeta(ctx);
+    };
+    bool PreparesWeights() const
+    {
+        assert(ptr_value != nullptr);
+        return ptr_value->PreparesWeights();
+    };
     const std::type_info& Type() const
     {
         assert(ptr_value != nullptr);
@@ -100,6 +115,9 @@ struct AnySolver
         virtual bool IsTunable() const                                                     = 0;
         virtual bool IsDynamic() const                                                     = 0;
         virtual float GetWti(const ConvolutionContext& ctx) const                          = 0;
+        virtual bool IsDeterministic(const ConvolutionContext& ctx) const                  = 0;
+        virtual bool SupportsAlphaBeta(const ConvolutionContext& ctx) const                = 0;
+        virtual bool PreparesWeights() const                                               = 0;
         virtual const std::type_info& Type() const                                         = 0;
         virtual std::string GetSolverDbId() const                                          = 0;
         virtual ConvSolution FindSolution(const ConvolutionContext& ctx,
@@ -141,6 +159,15 @@ struct AnySolver
         }
         bool IsDynamic() const override { return value.IsDynamic(); }
         float GetWti(const ConvolutionContext& ctx) const override { return value.GetWti(ctx); }
+        bool IsDeterministic(const ConvolutionContext& ctx) const override
+        {
+            return value.IsDeterministic(ctx);
+        }
+        bool SupportsAlphaBeta(const ConvolutionContext& ctx) const override
+        {
+            return value.SupportsAlphaBeta(ctx);
+        }
+        bool PreparesWeights() const override { return value.PreparesWeights(); }
         ConvSolution FindSolution(const ConvolutionContext& ctx,
                                   Db& db,
                                   const miopen::AnyInvokeParams& invoke_ctx) const override
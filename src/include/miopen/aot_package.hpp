@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_AOT_PACKAGE_HPP_
+#define GUARD_MIOPEN_AOT_PACKAGE_HPP_
+
+#include <miopen/config.h>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/kernel_info.hpp>
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Ahead-of-time compilation of the kernels of all the convolution solvers applicable to the
+/// problems of find-db and perf-db files, for the target of a handle.
+///
+/// The package is a kernel database of the format of the installed system ones and is named
+/// like them after the target, in a directory named after the MIOpen version. Installed into
+/// the system db directory, or embedded with MIOPEN_EMBED_DB and MIOPEN_BINCACHE_PATH, it
+/// leaves nothing to compile at run time for these problems.
+class AotPackager
+{
+    public:
+    /// Adds the convolution problems of text find-db or perf-db files, the keys of the other
+    /// primitives are skipped. The files are read with the semantics of DbMerger.
+    void AddDbs(const std::vector<std::string>& paths);
+    void AddProblem(const conv::ProblemDescription& problem);
+    std::size_t GetProblemCount() const { return problems.size(); }
+
+    /// Kernels of the solutions of all the applicable solvers, each program once. Tunable
+    /// solvers use the perf-db entries of the target, or their default configurations.
+    std::vector<solver::KernelInfo> GetKernels(Handle& handle) const;
+
+    struct Summary
+    {
+        std::string path;
+        std::size_t kernels = 0;
+    };
+
+    /// Compiles the kernels in parallel, MIOPEN_COMPILE_PARALLEL_LEVEL threads at most, and writes
+    /// them to the package under the output directory, next to a manifest of its contents.
+    Summary Build(Handle& handle, const std::string& output_dir) const;
+
+    /// "<major>.<minor>.<patch>.<tweak>" of the library, the directory of its packages.
+    static std::string GetVersion();
+
+    private:
+    std::vector<conv::ProblemDescription> problems;
+    std::set<std::string> keys;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_AOT_PACKAGE_HPP_
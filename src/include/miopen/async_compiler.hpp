@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_ASYNC_COMPILER_HPP_
+#define GUARD_MIOPEN_ASYNC_COMPILER_HPP_
+
+#include <miopen/kernel.hpp>
+#include <miopen/miopen.h>
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Builds programs on background threads, so a cache miss does not block the caller.
+///
+/// Jobs are keyed by program name and build parameters: a program which is already
+/// scheduled is not scheduled again and the same future is returned. Worker threads
+/// are started on demand, up to MIOPEN_COMPILE_PARALLEL_LEVEL. Jobs that have not
+/// started yet are dropped on destruction, running ones are waited for.
+///
+/// Groups of builds can be tracked by a ticket, e.g. the kernels of a solution, which the
+/// caller polls or waits for, or gets a callback when they are done.
+class AsyncCompiler
+{
+    public:
+    using Key      = std::pair<std::string, std::string>;
+    using Callback = std::function<void(miopenStatus_t)>;
+
+    AsyncCompiler();
+    AsyncCompiler(AsyncCompiler&&) noexcept;
+    AsyncCompiler& operator=(AsyncCompiler&&) noexcept;
+    ~AsyncCompiler();
+
+    std::shared_future<Program> Submit(const Key& key, std::function<Program()> job) const;
+    /// Blocks until all the jobs submitted so far are done.
+    void Wait() const;
+
+    /// Returns the ticket of the builds. When they are all done, the status is the one of the
+    /// first build that failed, or success, and the callback is called with it from a background
+    /// thread, in the order of the tickets.
+    std::uint64_t Track(std::vector<std::shared_future<Program>> builds, Callback callback) const;
+    /// Whether the builds of the ticket are done, then also sets their status.
+    bool Query(std::uint64_t ticket, miopenStatus_t& status) const;
+    /// Blocks until the builds of the ticket are done and returns their status.
+    miopenStatus_t WaitFor(std::uint64_t ticket) const;
+
+    private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_ASYNC_COMPILER_HPP_
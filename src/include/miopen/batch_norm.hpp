@@ -214,6 +214,68 @@ void BatchNormBackward(Handle& handle,
                        ConstData_t savedMean,
                        ConstData_t savedInvVariance);
 
+/// Stages of spatial forward and backward training with the per-channel partial sums reduced
+/// by the caller, e.g. across the devices of a data-parallel job. The sums are float tensors
+/// shaped like the scale and bias ones.
+void BatchNormForwardTrainingStats(Handle& handle,
+                                   miopenBatchNormMode_t bn_mode,
+                                   const TensorDescriptor& xDesc,
+                                   ConstData_t x,
+                                   const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                   Data_t localSum,
+                                   Data_t localSqSum);
+
+void BatchNormForwardTrainingApply(Handle& handle,
+                                   miopenBatchNormMode_t bn_mode,
+                                   const void* alpha,
+                                   const void* beta,
+                                   const TensorDescriptor& xDesc,
+                                   ConstData_t x,
+                                   const TensorDescriptor& yDesc,
+                                   Data_t y,
+                                   const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                   ConstData_t bnScale,
+                                   ConstData_t bnBias,
+                                   ConstData_t globalSum,
+                                   ConstData_t globalSqSum,
+                                   std::size_t globalCount,
+                                   double expAvgFactor,
+                                   Data_t resultRunningMean,
+                                   Data_t resultRunningVariance,
+                                   double epsilon,
+                                   Data_t resultSaveMean,
+                                   Data_t resultSaveInvVariance);
+
+void BatchNormBackwardStats(Handle& handle,
+                            miopenBatchNormMode_t bn_mode,
+                            const TensorDescriptor& xDesc,
+                            ConstData_t x,
+                            const TensorDescriptor& dyDesc,
+                            ConstData_t dy,
+                            const TensorDescriptor& bnScaleBiasDiffDesc,
+                            ConstData_t savedMean,
+                            ConstData_t savedInvVariance,
+                            Data_t localBiasDiff,
+                            Data_t localScaleDiff);
+
+void BatchNormBackwardApply(Handle& handle,
+                            miopenBatchNormMode_t bn_mode,
+                            const void* alphaDataDiff,
+                            const void* betaDataDiff,
+                            const TensorDescriptor& xDesc,
+                            ConstData_t x,
+                            const TensorDescriptor& dyDesc,
+                            ConstData_t dy,
+                            const TensorDescriptor& dxDesc,
+                            Data_t dx,
+                            const TensorDescriptor& bnScaleBiasDiffDesc,
+                            ConstData_t bnScale,
+                            ConstData_t globalBiasDiff,
+                            ConstData_t globalScaleDiff,
+                            std::size_t globalCount,
+                            ConstData_t savedMean,
+                            ConstData_t savedInvVariance);
+
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_BATCHNORMALIZATION_HPP_
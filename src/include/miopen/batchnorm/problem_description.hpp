@@ -27,9 +27,14 @@
 #pragma once
 
 #include <miopen/activ.hpp>
+#include <miopen/conv/problem_description.hpp>
 #include <miopen/tensor.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
 
 #include <cassert>
+#include <functional>
 #include <string>
 
 namespace miopen {
@@ -45,7 +50,17 @@ enum class Direction
     Backward,
 };
 
+/// Channel-last tensors have the unit stride on the channel dimension. The NDHWC ones come in
+/// reshaped to four dimensions by BuildReshaped4DTensorDescriptor.
+inline bool IsLayoutNHWC(const TensorDescriptor& desc)
+{
+    return desc.GetLengths().size() == 4 && desc.GetLengths()[1] > 1 && desc.GetStrides()[1] == 1;
+}
+
 struct ProblemDescription
+#if MIOPEN_ENABLE_SQLITE
+    : SQLiteSerializable<ProblemDescription>
+#endif
 {
     // Forward
     ProblemDescription(Direction direction_,
@@ -140,10 +155,46 @@ struct ProblemDescription
         return useSaved;
     }
 
+    double GetExpAvgFactor() const
+    {
+        assert(direction == Direction::ForwardTraining);
+        return expAvgFactor;
+    }
+
+    double GetEpsilon() const { return epsilon; }
+
+    bool IsLayoutNHWC() const { return batchnorm::IsLayoutNHWC(xDesc); }
+
     NetworkConfig MakeNetworkConfig() const;
 
+    /// The perf-db key, e.g. 64-256-14-14-NCHW-FP32-FT-spatial-s1r1
     void Serialize(std::ostream& stream) const;
 
+    static std::string table_name() { return "bn_config"; }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(int, std::string)> f)
+    {
+        int n, c, h, w;
+        std::tie(n, c, h, w) = tien<4>(self.xDesc.GetLengths());
+        f(n, "batchsize");
+        f(c, "in_channels");
+        f(h, "in_h");
+        f(w, "in_w");
+        f(static_cast<int>(self.resultsave), "result_save");
+        f(static_cast<int>(self.resultrunning), "result_running");
+        f(static_cast<int>(self.useSaved), "use_saved");
+    }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(std::string, std::string)> f)
+    {
+        f(self.GetLayoutName(), "layout");
+        f(self.GetDataTypesName(), "data_type");
+        f(self.GetDirectionName(), "direction");
+        f(self.GetModeName(), "mode");
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
     {
         obj.Serialize(os);
@@ -163,9 +214,15 @@ struct ProblemDescription
     bool resultrunning = false;
     bool useSaved      = false;
 
+    std::string GetLayoutName() const { return IsLayoutNHWC() ? "NHWC" : "NCHW"; }
+    std::string GetDataTypesName() const;
+    std::string GetDirectionName() const;
+    std::string GetModeName() const { return bn_mode == miopenBNSpatial ? "spatial" : "per_act"; }
+
     NetworkConfig MakeForwardTrainingNetworkConfig() const;
     NetworkConfig MakeForwardInferenceNetworkConfig() const;
     NetworkConfig MakeBackwardNetworkConfig() const;
+    NetworkConfig MakeNHWCNetworkConfig() const;
 };
 
 } // namespace batchnorm
@@ -28,6 +28,7 @@
 
 #include <miopen/solver.hpp>
 
+#include <cstddef>
 #include <utility>
 
 namespace miopen {
@@ -133,6 +134,124 @@ struct BnBwdTrainingSpatialMultiple : public SolverBase<OldStyleProblemDescripti
                              const miopen::batchnorm::ProblemDescription& problem) const;
 };
 
+/// Launch geometry of the channel-last spatial kernels of MIOpenBatchNormSpatialNHWC.cl for
+/// nhw rows of c channels. The grid is (cgroups * grp0, nseg * grp1).
+struct BnNHWCGeometry
+{
+    BnNHWCGeometry(std::size_t c, std::size_t nhw);
+
+    int vec;             // channels per work-item, loaded as one vector
+    std::size_t grp0;    // work-items along the channels
+    std::size_t grp1;    // work-items along the rows
+    std::size_t cgroups; // work-groups along the channels
+    std::size_t nseg;    // row segments, reduced by separate work-groups
+    std::size_t segrows; // rows per segment, the last one also takes the remainder
+};
+
+struct BnFwdTrainingSpatialNHWC : public SolverBase<OldStyleProblemDescription>
+{
+    inline bool IsApplicable(const OldStyleProblemDescription& problem) const
+    {
+        return IsApplicable(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    inline ConvSolution GetSolution(const OldStyleProblemDescription& problem) const
+    {
+        return GetSolution(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::batchnorm::ProblemDescription& problem) const;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::batchnorm::ProblemDescription& problem) const;
+};
+
+struct BnBwdTrainingSpatialNHWC : public SolverBase<OldStyleProblemDescription>
+{
+    inline bool IsApplicable(const OldStyleProblemDescription& problem) const
+    {
+        return IsApplicable(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    inline ConvSolution GetSolution(const OldStyleProblemDescription& problem) const
+    {
+        return GetSolution(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::batchnorm::ProblemDescription& problem) const;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::batchnorm::ProblemDescription& problem) const;
+};
+
+struct PerformanceConfigBnFwdTrainingWelford
+    : Serializable<PerformanceConfigBnFwdTrainingWelford>
+{
+    int grp_size;           // 2^n[64..1024], work-items per work-group
+    int elems_per_thread;   // {1,2,4}, elements loaded by a work-item at once
+    int blocks_per_channel; // 2^n[1..64], 1 normalizes in the same kernel, more ones merge
+                            // the statistics in the last work-group done with the channel
+
+    PerformanceConfigBnFwdTrainingWelford(int grp_size_, int elems_per_thread_, int blocks_)
+        : grp_size(grp_size_), elems_per_thread(elems_per_thread_), blocks_per_channel(blocks_)
+    {
+    }
+    PerformanceConfigBnFwdTrainingWelford() : PerformanceConfigBnFwdTrainingWelford(-1, -1, -1)
+    {
+    }
+    PerformanceConfigBnFwdTrainingWelford(bool) : PerformanceConfigBnFwdTrainingWelford(64, 1, 1)
+    {
+    }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.grp_size, "grp_size");
+        f(self.elems_per_thread, "elems_per_thread");
+        f(self.blocks_per_channel, "blocks_per_channel");
+    }
+
+    void HeuristicInit(const miopen::batchnorm::ProblemDescription& problem);
+    bool IsValidValue() const;
+    bool SetNextValue(const miopen::batchnorm::ProblemDescription& problem);
+    bool IsValid(const miopen::batchnorm::ProblemDescription& problem) const;
+    bool operator==(const PerformanceConfigBnFwdTrainingWelford& other) const;
+};
+
+/// Single-pass spatial forward training of NCHW tensors. The statistics are accumulated with
+/// Welford's algorithm and the partial results of the work-groups sharing a channel are merged
+/// by the last of them to finish, so no kernel is spent on the reduction alone.
+struct BnFwdTrainingSpatialWelford : public SolverBase<OldStyleProblemDescription>
+{
+    inline bool IsApplicable(const OldStyleProblemDescription& problem) const
+    {
+        return IsApplicable(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    inline ConvSolution GetSolution(const OldStyleProblemDescription& problem) const
+    {
+        const auto& context = *std::get<0>(problem);
+        const auto& bn_prob = *std::get<1>(problem);
+        return GetSolution(context, bn_prob, GetPerformanceConfig(context, bn_prob));
+    }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::batchnorm::ProblemDescription& problem) const;
+    PerformanceConfigBnFwdTrainingWelford
+    GetPerformanceConfig(const ExecutionContext& context,
+                         const miopen::batchnorm::ProblemDescription& problem) const;
+    bool IsValidPerformanceConfig(const ExecutionContext& context,
+                                  const miopen::batchnorm::ProblemDescription& problem,
+                                  const PerformanceConfigBnFwdTrainingWelford& config) const;
+    PerformanceConfigBnFwdTrainingWelford
+    Search(const ExecutionContext& context,
+           const miopen::batchnorm::ProblemDescription& problem,
+           const AnyInvokeParams& invoke_ctx) const;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::batchnorm::ProblemDescription& problem,
+                             const PerformanceConfigBnFwdTrainingWelford& config) const;
+};
+
 } // namespace batchnorm
 
 } // namespace solver
@@ -31,9 +31,12 @@
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem/path.hpp>
 #include <string>
+#include <vector>
 
 namespace miopen {
 
+struct Handle;
+
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
@@ -67,6 +70,12 @@ void SaveBinary(const std::string& hsaco,
                 bool is_kernel_str = false);
 #endif
 
+/// Loads code objects from the kernel cache databases of the device into the kernel
+/// cache of the handle, so the first use of each kernel does not have to. Only the
+/// \p programs listed are loaded, or every cached one if the list is empty.
+/// Loading runs in background, see AsyncCompiler.
+void WarmupKernelCache(const Handle& handle, const std::vector<std::string>& programs = {});
+
 } // namespace miopen
 
 #endif
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BINARY_LOG_HPP_
+#define GUARD_MIOPEN_BINARY_LOG_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace binlog {
+
+/// Low-overhead replacement of the text log, enabled by MIOPEN_LOG_BINARY=<file>.
+///
+/// The enabled MIOPEN_LOG_* messages, the API calls logged with MIOPEN_ENABLE_LOGGING and the
+/// driver commands of MIOPEN_ENABLE_LOGGING_CMD are not printed to stderr but appended as
+/// binary records to a lock-free ring buffer of the calling thread. Each call site is
+/// registered once, so a record only holds the id of its site, the thread, the time and the
+/// arguments: the values of the API parameters, with the handles and descriptors as pointers,
+/// or the text of the messages. A background thread drains the buffers to the file every few
+/// milliseconds. Records which do not fit into a full buffer are dropped and counted.
+///
+/// miopen_decode_log converts the file to the text log. If the file name ends with .txt, the
+/// background thread writes the text log itself.
+enum class Kind : std::uint8_t
+{
+    Message,
+    Call,
+    Command,
+};
+
+enum class ArgType : std::uint8_t
+{
+    Int,
+    UInt,
+    Double,
+    Pointer,
+    String,
+    /// The count followed by as many arguments.
+    Array,
+};
+
+bool IsEnabled();
+
+/// \param params Comma separated names of the arguments of the records.
+std::uint32_t RegisterSite(Kind kind, const std::string& name, const std::string& params = {});
+
+/// Builds a record of the calling thread, which is committed to its buffer by the destructor.
+class RecordWriter
+{
+    public:
+    explicit RecordWriter(std::uint32_t site);
+    RecordWriter(const RecordWriter&) = delete;
+    RecordWriter& operator=(const RecordWriter&) = delete;
+    ~RecordWriter();
+
+    void Int(std::int64_t value);
+    void UInt(std::uint64_t value);
+    void Double(double value);
+    void Pointer(const void* value);
+    void String(const char* value, std::size_t size);
+    void String(const std::string& value) { String(value.data(), value.size()); }
+    void Array(std::size_t count);
+
+    private:
+    template <class T>
+    void Put(ArgType type, const T& value);
+    void Put(const void* data, std::size_t size);
+
+    std::vector<char>& buffer;
+};
+
+/// The stream the messages are formatted into on the calling thread, reused to save the
+/// construction of a stream per message.
+std::ostringstream& ThreadStream();
+/// Logs the text of ThreadStream() and clears it.
+/// \param level One of LoggingLevel, 0 for the driver commands.
+void Message(std::uint32_t site, int level);
+
+/// Writes the records done so far, which is otherwise done periodically and at exit.
+void Flush();
+
+/// Converts a binary log to the text log.
+void Decode(std::istream& in, std::ostream& out);
+
+} // namespace binlog
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BINARY_LOG_HPP_
@@ -1,8 +1,12 @@
 #ifndef GUARD_MIOPEN_CHECK_NUMERICS_HPP
 #define GUARD_MIOPEN_CHECK_NUMERICS_HPP
 
+#include <miopen/allocator.hpp>
 #include <miopen/common.hpp>
 
+#include <cstddef>
+#include <mutex>
+
 namespace miopen {
 
 struct Handle;
@@ -15,9 +19,29 @@ struct CheckNumerics
     static const int Throw        = 0x04; // MIOPEN_THROW on abnormal result
     static const int Abort        = 0x08; // abort on abnormal result (to drop into debugger)
     static const int ComputeStats = 0x10; // Print mean/absmean/min/max (slow)
+    static const int Async        = 0x20; // no host sync, report via CheckNumericsPoll
 };
 bool CheckNumericsEnabled(int bitMask = -1);
 
+/// The state of the asynchronous checks of a handle. The kernels accumulate the abnormal flags
+/// into a device buffer that is only read back by CheckNumericsPoll(). The checks of an API call,
+/// i.e. a run of input checks followed by output checks, are all sampled or all skipped according
+/// to MIOPEN_CHECK_NUMERICS_INTERVAL.
+struct CheckNumericsState
+{
+    std::mutex mutex;
+    Allocator::ManageDataPtr flags = nullptr;
+    std::size_t calls   = 0;
+    std::size_t pending = 0; // kernels enqueued since the last poll
+    bool sampled        = true;
+    bool in_outputs     = true;
+};
+
+/// Waits for the pending asynchronous checks of the handle, reports their abnormal values with
+/// the MIOPEN_CHECK_NUMERICS mode and clears the flags.
+/// Returns: true if an abnormal value (inf or nan) was detected since the last poll
+bool CheckNumericsPoll(const Handle& handle, bool* hasNan = nullptr, bool* hasInf = nullptr);
+
 bool checkNumericsInput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data);
 bool checkNumericsOutput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data);
 bool checkNumericsImpl(
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_STATS_HPP_
+#define GUARD_MIOPEN_COMPILE_STATS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace miopen {
+
+enum class CompileCache
+{
+    Kernels,  ///< Programs of the handles, see KernelCache.
+    Binaries, ///< Code objects on disk, KernDb or the file cache without SQLite.
+    Shared,   ///< See SharedBinaryCache.
+    Process,  ///< Decompressed code objects shared by the handles of the process.
+    Count,
+};
+
+/// Statistics of the kernel builds of the process and of the caches in front of them, which
+/// show the problems worth compiling ahead of time and compile regressions across releases.
+/// Builds are attributed to the solver of the innermost SolverScope of the building thread.
+///
+/// miopenGetCompileStatistics() returns them as JSON, which is also written to the file set
+/// by MIOPEN_COMPILE_STATS_FILE whenever a handle is destroyed.
+class CompileStats
+{
+    public:
+    static CompileStats& Get();
+
+    class SolverScope
+    {
+        public:
+        explicit SolverScope(const std::string& solver);
+        SolverScope(const SolverScope&) = delete;
+        SolverScope& operator=(const SolverScope&) = delete;
+        ~SolverScope();
+
+        private:
+        std::string previous;
+    };
+
+    void AddBuild(const std::string& program, double ms);
+    void AddLookup(CompileCache cache, bool hit);
+    void AddDecompression(std::size_t bytes, double ms);
+    void AddComgrAction(const std::string& action, double ms);
+
+    /// {"programs": {<name>: {"count", "ms", "max_ms"}, ...}, "solvers": {...},
+    ///  "comgr_actions": {...}, "caches": {<cache>: {"hits", "misses"}, ...},
+    ///  "decompression": {"count", "ms", "max_ms", "bytes"}}
+    std::string ToJson() const;
+    void Reset();
+    /// Writes ToJson() to MIOPEN_COMPILE_STATS_FILE, if set.
+    void Dump() const;
+
+    private:
+    struct Total
+    {
+        std::size_t count = 0;
+        double ms         = 0;
+        double max_ms     = 0;
+
+        void Add(double time);
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::string, Total> programs;
+    std::map<std::string, Total> solvers;
+    std::map<std::string, Total> comgr_actions;
+    std::array<std::size_t, static_cast<std::size_t>(CompileCache::Count)> hits{};
+    std::array<std::size_t, static_cast<std::size_t>(CompileCache::Count)> misses{};
+    Total decompression;
+    std::size_t decompressed_bytes = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_STATS_HPP_
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_WORKER_POOL_HPP_
+#define GUARD_MIOPEN_COMPILE_WORKER_POOL_HPP_
+
+#include <memory>
+#include <string>
+
+namespace miopen {
+
+struct TargetProperties;
+
+/// Builds code objects in miopen_compile_worker helper processes, so the compilations of
+/// PrecompileKernels threads do not contend on the global state of the in-process compilers.
+///
+/// MIOPEN_COMPILE_WORKERS sets the number of the processes, the pool is off by default.
+/// MIOPEN_COMPILE_WORKER_PATH overrides the worker executable, which is otherwise looked up in
+/// PATH. The processes are started on first use for the target of the first job and exchange
+/// length-prefixed messages with the library over a socket pair. A worker that breaks is
+/// dropped and restarted by the next job.
+class CompileWorkerPool
+{
+    public:
+    static CompileWorkerPool& Get();
+
+    CompileWorkerPool();
+    CompileWorkerPool(const CompileWorkerPool&) = delete;
+    CompileWorkerPool& operator=(const CompileWorkerPool&) = delete;
+    ~CompileWorkerPool();
+
+    bool IsEnabled() const;
+    std::size_t GetSize() const;
+
+    /// Returns the code object of the program, or an empty string if it can not be built by a
+    /// worker. The caller builds the program in-process then, which also reports the errors.
+    std::string Build(const std::string& program_name,
+                      const std::string& params,
+                      const TargetProperties& target);
+
+    private:
+    struct State;
+    std::unique_ptr<State> state;
+};
+
+namespace compile_worker {
+
+/// The device name a worker is started with, e.g. gfx90a:sramecc+:xnack-.
+std::string GetTargetName(const TargetProperties& target);
+
+/// Messages are a decimal length, a newline and the data.
+bool WriteMessage(int fd, const std::string& data);
+bool ReadMessage(int fd, std::string& data);
+
+} // namespace compile_worker
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_WORKER_POOL_HPP_
@@ -30,6 +30,7 @@
 #include <tuple>
 #include <vector>
 #include <limits>
+#include <miopen/solver/gemm_cost_model.hpp>
 
 namespace miopen {
 
@@ -222,6 +223,39 @@ HeuristicInitMacroTileNoPadGemmK(size_t gemm_m,
         return std::make_tuple(0, 0, 0);
 }
 
+// Channels per group under which the gemm of a single group is narrower than most of the macro
+// tiles, so that a tile chosen by the padding inside one group leaves the xdlops mostly idle.
+static constexpr size_t igemm_grouped_narrow_channels = 32;
+
+static inline bool IsNarrowGroupedGemm(size_t group, size_t c_per_group, size_t k_per_group)
+{
+    return group > 1 && (c_per_group < igemm_grouped_narrow_channels ||
+                         k_per_group < igemm_grouped_narrow_channels);
+}
+
+// select the macro tile of a grouped convolution with few channels per group over the grid of
+// all the groups instead of a single one: the tiles of many groups share the compute units, so
+// a larger tile which keeps the xdlops busy can pay for the padding of a narrow group.
+// cost_of() returns the max float for the configs which can't run the problem.
+// returns the index of the cheapest config, or the size of the list if none can run.
+template <typename ConfigList, typename CostOf>
+static inline size_t HeuristicSelectGroupedTile(const ConfigList& config_list,
+                                                const CostOf& cost_of)
+{
+    size_t selected_index = config_list.size();
+    float min_cost        = std::numeric_limits<float>::max();
+    for(size_t i = 0; i < config_list.size(); i++)
+    {
+        const float cost = cost_of(config_list[i]);
+        if(cost < min_cost)
+        {
+            min_cost       = cost;
+            selected_index = i;
+        }
+    }
+    return selected_index;
+}
+
 template <int L, int H>
 inline static bool IsLinear(const int v)
 {
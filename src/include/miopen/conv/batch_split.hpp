@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CONV_BATCH_SPLIT_HPP_
+#define GUARD_MIOPEN_CONV_BATCH_SPLIT_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+
+namespace miopen {
+namespace conv {
+
+/// Most of the convolution kernels index their tensors with 32 bits and their solvers reject the
+/// data tensors of more elements. Such forward and backward data problems are run as a sequence
+/// of equal chunks of the batch which fit the limit, so that the fast solvers stay applicable:
+/// the find, the immediate mode queries and the runs are all made for the problem of one chunk.
+/// HIP only, as the chunks are addressed by offsets into the buffers. Batches of one image are
+/// not split. Disabled by MIOPEN_DEBUG_CONV_BATCH_SPLIT=0.
+struct BatchSplit
+{
+    /// \p in and \p out are the data tensors the convolution reads and writes.
+    BatchSplit(const TensorDescriptor& in, const TensorDescriptor& out);
+
+    /// False when the problem is run whole.
+    explicit operator bool() const { return chunks > 1; }
+
+    std::size_t GetChunks() const { return chunks; }
+    const TensorDescriptor& GetInChunk() const { return in_chunk; }
+    const TensorDescriptor& GetOutChunk() const { return out_chunk; }
+
+    ConstData_t In(ConstData_t in, std::size_t chunk) const;
+    Data_t Out(Data_t out, std::size_t chunk) const;
+
+    private:
+    std::size_t chunks = 1;
+    TensorDescriptor in_chunk;
+    TensorDescriptor out_chunk;
+    std::size_t in_chunk_bytes  = 0;
+    std::size_t out_chunk_bytes = 0;
+};
+
+} // namespace conv
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CONV_BATCH_SPLIT_HPP_
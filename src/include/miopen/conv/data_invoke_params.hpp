@@ -32,12 +32,31 @@
 namespace miopen {
 namespace conv {
 
+/// Filter transformed ahead of the runs, see FrozenSolution::PrepareWeights().
+struct PreparedWeights
+{
+    Allocator::ManageDataPtr buffer;
+};
+
 struct DataInvokeParams : InvokeParams
 {
     ConvDataTensors tensors;
     Data_t workSpace          = nullptr;
     std::size_t workSpaceSize = 0;
 
+    /// The result is blended into the output as alpha * conv + beta * output. Only the
+    /// invokers of the solvers for which SupportsAlphaBeta() holds read these, the others
+    /// are run with the defaults and blended by the caller.
+    float alpha = 1.0f;
+    float beta  = 0.0f;
+
+    /// The invokers of the solvers for which PreparesWeights() holds read the transformed
+    /// filter from here instead of transforming tensors.w, after filling it if it is empty. With
+    /// prepare_weights_only they only fill it and read neither the data tensors nor the
+    /// workspace beyond what the transform of the filter needs. The other invokers ignore both.
+    PreparedWeights* prepared_weights = nullptr;
+    bool prepare_weights_only         = false;
+
     DataInvokeParams(ConvDataTensors tensors_, Data_t workSpace_, std::size_t workSpaceSize_)
         : tensors(tensors_), workSpace(workSpace_), workSpaceSize(workSpaceSize_)
     {
@@ -53,6 +72,10 @@ struct DataInvokeParams : InvokeParams
           workSpaceSize(workSpaceSize_)
     {
     }
+
+    /// Same params with the buffers of the same sizes allocated on \p handle.
+    DataInvokeParams Relocate(const Handle& handle,
+                              std::vector<Allocator::ManageDataPtr>& buffers) const;
 };
 
 } // namespace conv
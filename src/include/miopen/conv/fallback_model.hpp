@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CONV_FALLBACK_MODEL_HPP_
+#define GUARD_MIOPEN_CONV_FALLBACK_MODEL_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/solver_id.hpp>
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace conv {
+
+struct ProblemDescription;
+
+/// Problem features the fallback models are evaluated on, in the order documented for
+/// miopenSetConvolutionFallbackModel. The tensors are taken in the terms of ProblemDescription,
+/// where "in" of the backward directions is dy.
+using FallbackFeatures = std::array<float, 23>;
+
+FallbackFeatures GetFallbackFeatures(const ProblemDescription& problem);
+
+/// Predicts the solvers which are the fastest for the problems the find-db has no record of.
+/// Immediate mode fallback puts the predicted solvers first, in the predicted order, and ranks
+/// the others by their WTI as before.
+class FallbackModel
+{
+    public:
+    virtual ~FallbackModel() = default;
+    /// The best solver first. The solvers the model knows nothing about need not be listed.
+    virtual std::vector<solver::Id> Predict(const FallbackFeatures& features) const = 0;
+};
+
+/// Binary decision tree, trained offline on the find-db timings of a device.
+///
+/// Text format, '#' starts a comment:
+///   MIOpenFallbackModel <version> <feature count>
+///   node <feature> <threshold> <left> <right>
+///   leaf <solver name>...
+/// The entries are numbered from 0 in the order of the file, and 0 is the root. Features not
+/// greater than the threshold go to the left child. The children shall follow their parent.
+class DecisionTreeModel : public FallbackModel
+{
+    public:
+    /// Throws on malformed models. Unknown solvers are skipped, so that the models survive the
+    /// removal of solvers.
+    static std::unique_ptr<DecisionTreeModel> Load(std::istream& stream);
+
+    std::vector<solver::Id> Predict(const FallbackFeatures& features) const override;
+
+    private:
+    struct Node
+    {
+        bool leaf           = false;
+        std::size_t feature = 0;
+        float threshold     = 0.0f;
+        std::size_t left    = 0;
+        std::size_t right   = 0;
+        std::vector<solver::Id> solvers;
+    };
+
+    std::vector<Node> nodes;
+};
+
+/// Model of the user, see miopenSetConvolutionFallbackModel.
+class CallbackFallbackModel : public FallbackModel
+{
+    public:
+    CallbackFallbackModel(miopenConvFallbackModel_t callback_, void* user_data_)
+        : callback(callback_), user_data(user_data_)
+    {
+    }
+
+    std::vector<solver::Id> Predict(const FallbackFeatures& features) const override;
+
+    private:
+    miopenConvFallbackModel_t callback;
+    void* user_data;
+};
+
+/// The model set on the handle by the user if any, otherwise the one shipped for the device:
+/// "<device>.ufbm.txt" in the user db directory, which overrides "<device>.fbm.txt" in the
+/// system db directory. May be null. The files are read once per process.
+std::shared_ptr<const FallbackModel> GetFallbackModel(const Handle& handle);
+
+} // namespace conv
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CONV_FALLBACK_MODEL_HPP_
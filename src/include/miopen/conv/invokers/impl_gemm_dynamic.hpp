@@ -125,9 +125,9 @@ ComputeDynamicIGemmForwardKernelArgs<int>(const ProblemDescription& conv_problem
     int pack0       = cfg;
     // clang-format on
 
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
     opArgs.emplace_back(hi);
     opArgs.emplace_back(wi);
     opArgs.emplace_back(n);
@@ -207,9 +207,9 @@ ComputeDynamicIGemmForwardKernelArgs<solver::TunableImplicitGemmGTCDynamic_t>(
         magic_div_u32_pack_shift(mdiv_0.shift, mdiv_1.shift, mdiv_2.shift, mdiv_3.shift);
     uint32_t shift_pack_1 = magic_div_u32_pack_shift(mdiv_4.shift, mdiv_5.shift, mdiv_6.shift, 0);
 
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
+    opArgs.emplace_back(nullptr); // placeholder
     opArgs.emplace_back(hi);
     opArgs.emplace_back(wi);
     opArgs.emplace_back(n);
@@ -247,17 +247,18 @@ static inline InvokerFactory MakeImplGemmDynamicForwardInvokerFactory(const Conv
 {
     const auto& conv_problem = ctx.conv_problem;
     auto opArgs              = ComputeDynamicIGemmForwardKernelArgs<T>(conv_problem, cfg);
-    return [opArgs](const std::vector<Kernel>& kernels) mutable {
+    return [opArgs](const std::vector<Kernel>& kernels) {
+        auto args = PackedKernelArgs{opArgs};
         return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) mutable {
             decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
             const auto& tensors     = data_ctx.tensors;
             const auto k            = handle.Run(kernels[0]);
 
-            opArgs[0] = OpKernelArg(tensors.in);
-            opArgs[1] = OpKernelArg(tensors.w);
-            opArgs[2] = OpKernelArg(tensors.out);
+            args.Set(0, tensors.in);
+            args.Set(1, tensors.w);
+            args.Set(2, tensors.out);
 
-            k(opArgs);
+            k(args);
         };
     };
 }
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CONV_PROBLEM_CANONICALIZATION_HPP_
+#define GUARD_MIOPEN_CONV_PROBLEM_CANONICALIZATION_HPP_
+
+#include <miopen/conv/problem_description.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+namespace conv {
+
+/// Problems whose tuning results are reused for \p problem when the find-db has no record of
+/// it, the most similar first. The problem itself is not included. These are the problem with
+/// - the dilation of the 1-wide filter dimensions set to 1, since it has no effect on them,
+///   which is the same convolution;
+/// - the batch size rounded up and down to powers of two, the buckets dynamic batch inference
+///   is typically tuned for, which mostly share the kernels.
+std::vector<ProblemDescription> GetCanonicalNeighbors(const ProblemDescription& problem);
+
+/// Batch sizes of bucket of \p batch_size, the nearest first. Empty for powers of two.
+std::vector<std::size_t> GetBatchSizeBuckets(std::size_t batch_size);
+
+} // namespace conv
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CONV_PROBLEM_CANONICALIZATION_HPP_
@@ -319,6 +319,12 @@ struct ProblemDescription
 
     void Serialize(std::ostream& stream) const;
 
+    /// Restores the problem from a find-db or perf-db key written by Serialize(). The tensors
+    /// are packed in the layouts of the key and the convolution is a regular one, as the key
+    /// describes both the regular and the transposed ones in the same way.
+    /// \return False if the key is not one of a convolution problem.
+    bool Deserialize(const std::string& key);
+
     friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
     {
         obj.Serialize(os);
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/miopen.h>
+#include <miopen/names.hpp>
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct TensorDescriptor;
+struct ConvolutionDescriptor;
+struct ConvolutionContext;
+
+namespace conv {
+
+/// Fixed-size identity of a convolution problem.
+///
+/// Unlike NetworkConfig and the db key it is built directly from the descriptors
+/// without any string formatting or allocations, which makes it cheap enough to be
+/// computed on each immediate mode call. Tensor strides are included, so problems
+/// differing only in layout get different fingerprints.
+struct ProblemFingerprint
+{
+    static constexpr std::size_t max_tensor_dims  = 5;
+    static constexpr std::size_t max_spatial_dims = 3;
+
+    ProblemFingerprint(const TensorDescriptor& in,
+                       const TensorDescriptor& weights,
+                       const TensorDescriptor& out,
+                       const ConvolutionDescriptor& conv,
+                       Direction direction,
+                       int bias = 0);
+
+    std::size_t GetHash() const { return hash; }
+
+    bool operator==(const ProblemFingerprint& other) const;
+    bool operator!=(const ProblemFingerprint& other) const { return !(*this == other); }
+
+    struct Hasher
+    {
+        std::size_t operator()(const ProblemFingerprint& fp) const { return fp.GetHash(); }
+    };
+
+    private:
+    struct Tensor
+    {
+        std::array<std::size_t, max_tensor_dims> lengths{};
+        std::array<std::size_t, max_tensor_dims> strides{};
+        uint32_t dims              = 0;
+        miopenDataType_t data_type = miopenFloat;
+    };
+
+    std::array<Tensor, 3> tensors{};
+    std::array<int, max_spatial_dims> pads{};
+    std::array<int, max_spatial_dims> strides{};
+    std::array<int, max_spatial_dims> dilations{};
+    std::array<int, max_spatial_dims> trans_output_pads{};
+    int group_count                  = 1;
+    int bias                         = 0;
+    uint32_t spatial_dims            = 0;
+    miopenConvolutionMode_t mode     = miopenConvolution;
+    miopenPaddingMode_t padding_mode = miopenPaddingDefault;
+    Direction direction              = Direction::Forward;
+    std::size_t hash                 = 0;
+
+    std::size_t ComputeHash() const;
+};
+
+/// String forms of a problem which are needed to access the caches and find-db.
+struct ProblemKeys
+{
+    NetworkConfig network_config;
+    std::string db_key;
+};
+
+/// Remembers string keys built for fingerprints, so they are only formatted when
+/// a problem is seen for the first time (and for logging and persistence).
+class ProblemKeysCache
+{
+    public:
+    boost::optional<const ProblemKeys&> Find(const ProblemFingerprint& fingerprint) const;
+    const ProblemKeys& Register(const ProblemFingerprint& fingerprint, ProblemKeys keys);
+
+    private:
+    // Mutexes are not movable, and the Handle owning the cache is.
+    std::unique_ptr<std::shared_timed_mutex> mutex = std::make_unique<std::shared_timed_mutex>();
+    std::unordered_map<ProblemFingerprint, ProblemKeys, ProblemFingerprint::Hasher> items;
+};
+
+/// Remembers which solvers are applicable to the problems, so that IsApplicable(), which may
+/// query the assembler or MLIR, is only run once for a problem and a solver. Solvers are
+/// identified by the values of their solver::Id.
+class ApplicabilityCache
+{
+    public:
+    boost::optional<bool> Find(const ProblemFingerprint& fingerprint, uint64_t solver) const;
+    void Register(const ProblemFingerprint& fingerprint, uint64_t solver, bool applicable);
+
+    /// The applicable solvers in the order of the registry, once all of them have been checked.
+    boost::optional<const std::vector<uint64_t>&>
+    FindAll(const ProblemFingerprint& fingerprint) const;
+    /// \p checked are all the solvers of the registry paired with their applicability.
+    const std::vector<uint64_t>& RegisterAll(const ProblemFingerprint& fingerprint,
+                                             const std::vector<std::pair<uint64_t, bool>>& checked);
+
+    private:
+    struct Item
+    {
+        std::unordered_map<uint64_t, bool> solvers;
+        boost::optional<std::vector<uint64_t>> applicable;
+    };
+
+    std::unique_ptr<std::shared_timed_mutex> mutex = std::make_unique<std::shared_timed_mutex>();
+    std::unordered_map<ProblemFingerprint, Item, ProblemFingerprint::Hasher> items;
+};
+
+/// Remembers the contexts prepared for the problems of the immediate mode, so that the problem
+/// description is only built, and the environment only detected, once per problem and not by
+/// each of GetSolutions(), CompileSolution() and the runs. The contexts of the compilation,
+/// which disables the enforced search, are kept apart from the others.
+class ContextCache
+{
+    public:
+    std::shared_ptr<const ConvolutionContext> Find(const ProblemFingerprint& fingerprint,
+                                                   bool disable_search_enforce) const;
+    /// Returns the context registered first, when another thread has raced to prepare it.
+    std::shared_ptr<const ConvolutionContext>
+    Register(const ProblemFingerprint& fingerprint,
+             std::shared_ptr<const ConvolutionContext> context);
+
+    private:
+    using Item = std::array<std::shared_ptr<const ConvolutionContext>, 2>;
+
+    std::unique_ptr<std::shared_timed_mutex> mutex = std::make_unique<std::shared_timed_mutex>();
+    std::unordered_map<ProblemFingerprint, Item, ProblemFingerprint::Hasher> items;
+};
+
+} // namespace conv
+} // namespace miopen
@@ -38,6 +38,12 @@ struct WrWInvokeParams : InvokeParams
     Data_t workSpace          = nullptr;
     std::size_t workSpaceSize = 0;
 
+    /// The result is blended into the output as alpha * conv + beta * output. Only the
+    /// invokers of the solvers for which SupportsAlphaBeta() holds read these, the others
+    /// are run with the defaults and blended by the caller.
+    float alpha = 1.0f;
+    float beta  = 0.0f;
+
     WrWInvokeParams(ConvWrwTensors tensors_, Data_t workSpace_, std::size_t workSpaceSize_)
         : tensors(tensors_), workSpace(workSpace_), workSpaceSize(workSpaceSize_)
     {
@@ -53,6 +59,10 @@ struct WrWInvokeParams : InvokeParams
           workSpaceSize(workSpaceSize_)
     {
     }
+
+    /// Same params with the buffers of the same sizes allocated on \p handle.
+    WrWInvokeParams Relocate(const Handle& handle,
+                             std::vector<Allocator::ManageDataPtr>& buffers) const;
 };
 
 } // namespace conv
@@ -34,9 +34,12 @@
 #include <miopen/solver_id.hpp>
 #include <miopen/names.hpp>
 #include <miopen/invoke_params.hpp>
+#include <miopen/invoker.hpp>
 
 #include <boost/any.hpp>
 
+#include <future>
+#include <limits>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -173,6 +176,11 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
     std::vector<miopen::solver::ConvSolution>
     FindFftSolutions(const ConvolutionContext& ctx, const AnyInvokeParams& invoke_ctx) const;
 
+    /// Solutions of the applicable solvers with the configs the find would use without
+    /// searching, so that their kernels can be compiled ahead of the find of several problems.
+    std::vector<miopen::solver::ConvSolution>
+    GetFindCandidates(Handle& handle, const ProblemDescription& problem) const;
+
     void ConvolutionForward(Handle& handle,
                             const void* alpha,
                             const TensorDescriptor& xDesc,
@@ -200,11 +208,22 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                              miopenConvSolution_t* solutions,
                              bool* fallbackPathTaken) const;
 
-    void CompileForwardSolution(Handle& handle,
-                                const TensorDescriptor& wDesc,
-                                const TensorDescriptor& xDesc,
-                                const TensorDescriptor& yDesc,
-                                solver::Id solver_id) const;
+    /// The applicable solutions sorted by the run time predicted by a cost model, without
+    /// using find-db and without running anything.
+    void GetForwardSolutionsPredicted(Handle& handle,
+                                      const TensorDescriptor& wDesc,
+                                      const TensorDescriptor& xDesc,
+                                      const TensorDescriptor& yDesc,
+                                      size_t maxSolutionCount,
+                                      size_t* solutionCount,
+                                      miopenConvSolution_t* solutions) const;
+
+    std::vector<std::shared_future<Program>> CompileForwardSolution(Handle& handle,
+                                                                    const TensorDescriptor& wDesc,
+                                                                    const TensorDescriptor& xDesc,
+                                                                    const TensorDescriptor& yDesc,
+                                                                    solver::Id solver_id,
+                                                                    bool async = false) const;
 
     std::size_t GetForwardSolutionWorkspaceSize(Handle& handle,
                                                 const TensorDescriptor& wDesc,
@@ -269,11 +288,20 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                               miopenConvSolution_t* solutions,
                               bool* fallbackPathTaken) const;
 
-    void CompileBackwardSolution(Handle& handle,
-                                 const TensorDescriptor& dyDesc,
-                                 const TensorDescriptor& wDesc,
-                                 const TensorDescriptor& dxDesc,
-                                 solver::Id solver_id) const;
+    void GetBackwardSolutionsPredicted(Handle& handle,
+                                       const TensorDescriptor& dyDesc,
+                                       const TensorDescriptor& wDesc,
+                                       const TensorDescriptor& dxDesc,
+                                       size_t maxSolutionCount,
+                                       size_t* solutionCount,
+                                       miopenConvSolution_t* solutions) const;
+
+    std::vector<std::shared_future<Program>> CompileBackwardSolution(Handle& handle,
+                                                                     const TensorDescriptor& dyDesc,
+                                                                     const TensorDescriptor& wDesc,
+                                                                     const TensorDescriptor& dxDesc,
+                                                                     solver::Id solver_id,
+                                                                     bool async = false) const;
 
     std::size_t GetBackwardSolutionWorkspaceSize(Handle& handle,
                                                  const TensorDescriptor& dyDesc,
@@ -306,11 +334,20 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                          miopenConvSolution_t* solutions,
                          bool* fallbackPathTaken) const;
 
-    void CompileWrwSolution(Handle& handle,
-                            const TensorDescriptor& dyDesc,
-                            const TensorDescriptor& xDesc,
-                            const TensorDescriptor& dwDesc,
-                            solver::Id solver_id) const;
+    void GetWrwSolutionsPredicted(Handle& handle,
+                                  const TensorDescriptor& dyDesc,
+                                  const TensorDescriptor& xDesc,
+                                  const TensorDescriptor& dwDesc,
+                                  size_t maxSolutionCount,
+                                  size_t* solutionCount,
+                                  miopenConvSolution_t* solutions) const;
+
+    std::vector<std::shared_future<Program>> CompileWrwSolution(Handle& handle,
+                                                                const TensorDescriptor& dyDesc,
+                                                                const TensorDescriptor& xDesc,
+                                                                const TensorDescriptor& dwDesc,
+                                                                solver::Id solver_id,
+                                                                bool async = false) const;
 
     std::size_t GetWrwSolutionWorkspaceSize(Handle& handle,
                                             const TensorDescriptor& dyDesc,
@@ -329,6 +366,16 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                                  std::size_t workSpaceSize,
                                  solver::Id solver_id) const;
 
+    /// Runs the checks of the immediate mode call of \p dir which do not need the buffers and
+    /// returns the invoker of \p solver_id, built if needed. Whatever the direction, \p xDesc is
+    /// the input of the forward convolution and \p yDesc is its output.
+    Invoker GetImmediateInvoker(Handle& handle,
+                                const TensorDescriptor& xDesc,
+                                const TensorDescriptor& wDesc,
+                                const TensorDescriptor& yDesc,
+                                conv::Direction dir,
+                                solver::Id solver_id) const;
+
     std::size_t BackwardWeightsGetWorkSpaceSize(Handle& handle,
                                                 const TensorDescriptor& dyDesc,
                                                 const TensorDescriptor& xDesc,
@@ -379,6 +426,10 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
     int group_count;
     float lowp_quant; // quantization factor for low precision
     FindMode findMode;
+    /// Solutions which need more workspace are neither found nor listed.
+    std::size_t workspace_limit = std::numeric_limits<std::size_t>::max();
+    /// The weights are not modified between the calls, so solvers may keep them transformed.
+    bool constant_weights = false;
 
     void ConvBwdGemm(Handle& handle,
                      const struct ConvBwdTensors& tensors,
@@ -402,6 +453,12 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                               size_t* solutionCount,
                               miopenConvSolution_t* solutions) const;
 
+    void GetSolutionsPredicted(Handle& handle,
+                               const ProblemDescription& problem,
+                               size_t maxSolutionCount,
+                               size_t* solutionCount,
+                               miopenConvSolution_t* solutions) const;
+
     std::size_t GetSolutionCountFallback(Handle& handle, const ProblemDescription& problem) const;
 };
 
@@ -413,6 +470,28 @@ void ConvolutionBackwardBias(const Handle& handle,
                              const TensorDescriptor& dbDesc,
                              Data_t db);
 
+/// One convolution of ConvolutionForwardImmediateBatch. The descriptors are not owned.
+struct ConvFwdImmediateCall
+{
+    const ConvolutionDescriptor* conv;
+    const TensorDescriptor* wDesc;
+    ConstData_t w;
+    const TensorDescriptor* xDesc;
+    ConstData_t x;
+    const TensorDescriptor* yDesc;
+    Data_t y;
+    Data_t workSpace;
+    std::size_t workSpaceSize;
+    solver::Id solver_id;
+};
+
+/// Runs the forward convolutions as ConvolutionForwardImmediate would, one after another on the
+/// stream of the handle. All the calls are validated before the first launch, and the invoker is
+/// only looked up once for the calls sharing their descriptors and solver. With profiling
+/// enabled the kernel time is the total of the batch.
+void ConvolutionForwardImmediateBatch(Handle& handle,
+                                      const std::vector<ConvFwdImmediateCall>& calls);
+
 std::ostream& operator<<(std::ostream& stream, const ConvolutionDescriptor& c);
 
 } // namespace miopen
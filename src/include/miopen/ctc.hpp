@@ -56,6 +56,13 @@ struct CTCLossDescriptor : miopenCTCLossDescriptor
                                    const int* inputLengths,
                                    miopenCTCLossAlgo_t algo) const;
 
+    /// Workspace of the device-resident variant of CTCLoss, for labels up to maxLabelLength.
+    size_t GetCTCLossWorkspaceSize(Handle& handle,
+                                   const TensorDescriptor& probsDesc,
+                                   const TensorDescriptor& gradientsDesc,
+                                   int maxLabelLength,
+                                   miopenCTCLossAlgo_t algo) const;
+
     void CTCLoss(const Handle& handle,
                  const TensorDescriptor& probsDesc,
                  ConstData_t probs,
@@ -68,6 +75,44 @@ struct CTCLossDescriptor : miopenCTCLossDescriptor
                  miopenCTCLossAlgo_t algo,
                  Data_t workSpace,
                  size_t workSpaceSize) const;
+
+    /// The labels and both length lists are device buffers, so nothing is read back to the
+    /// host. The label offsets and repeats are computed by the kernel and the lengths are not
+    /// validated, only clamped to the time steps of probsDesc and to maxLabelLength.
+    void CTCLoss(const Handle& handle,
+                 const TensorDescriptor& probsDesc,
+                 ConstData_t probs,
+                 ConstData_t labels,
+                 ConstData_t labelLengths,
+                 ConstData_t inputLengths,
+                 int maxLabelLength,
+                 Data_t losses,
+                 const TensorDescriptor& gradientsDesc,
+                 Data_t gradients,
+                 miopenCTCLossAlgo_t algo,
+                 Data_t workSpace,
+                 size_t workSpaceSize) const;
+
+    /// The beams and candidates of a beam search are kept in LDS, which bounds the beam width.
+    static constexpr int MaxDecodeBeamWidth = 64;
+
+    /// Decoding uses blank_label_id and reads activations when apply_softmax_layer is set,
+    /// log-probabilities otherwise, like the loss.
+    size_t GetCTCDecodeWorkspaceSize(const TensorDescriptor& probsDesc,
+                                     miopenCTCDecodeMode_t mode,
+                                     int beamWidth) const;
+
+    void CTCDecode(const Handle& handle,
+                   miopenCTCDecodeMode_t mode,
+                   int beamWidth,
+                   const TensorDescriptor& probsDesc,
+                   ConstData_t probs,
+                   ConstData_t inputLengths,
+                   Data_t decoded,
+                   Data_t decodedLengths,
+                   Data_t scores,
+                   Data_t workSpace,
+                   size_t workSpaceSize) const;
 };
 
 std::ostream& operator<<(std::ostream& stream, const CTCLossDescriptor& r);
@@ -66,6 +66,12 @@ inline std::string GetDataType(miopenDataType_t type)
     return type_str;
 }
 
+// OpenCL has no bfloat16 type, so the kernels which support it keep the elements in ushort
+inline std::string GetDataTypeStorage(miopenDataType_t type)
+{
+    return type == miopenBFloat16 ? "ushort" : GetDataType(type);
+}
+
 inline std::size_t get_data_size(miopenDataType_t) { MIOPEN_THROW("not implemented"); }
 
 inline std::size_t get_data_size(miopenIndexType_t index_type)
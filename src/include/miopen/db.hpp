@@ -28,6 +28,7 @@
 
 #include <miopen/db_record.hpp>
 #include <miopen/rank.hpp>
+#include <miopen/remote_db.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
@@ -35,6 +36,8 @@
 
 #include <chrono>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -44,9 +47,12 @@ class path;
 
 namespace miopen {
 
-struct RecordPositions;
+struct DbFileIndex;
+struct PendingDbRecords;
 class LockFile;
 
+/// Records are appended to the file and looked up by an in-memory index of it, see
+/// DbFileIndex. The file is compacted once most of it is taken by outdated records.
 /// No instance of this class should be used from several threads at the same time.
 class PlainTextDb
 {
@@ -95,6 +101,11 @@ class PlainTextDb
 
     bool Remove(const std::string& key, const std::string& id);
 
+    /// Writes the updates of the file delayed by write-behind batching,
+    /// see DbWriteBatchLimits.
+    void Flush();
+    static void FlushAll();
+
     template <class T>
     inline bool RemoveRecord(const T& problem_config)
     {
@@ -139,19 +150,25 @@ class PlainTextDb
     private:
     std::string filename;
     LockFile& lock_file;
+    DbFileIndex& index;
     const bool warn_if_unreadable;
 
-    boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
-    bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
+    boost::optional<DbRecord> FindRecordUnsafe(const std::string& key);
+    /// Sets stale if the file has been replaced after being indexed.
+    boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, bool& stale);
+    bool AppendUnsafe(const std::vector<DbRecord>& records);
+    void CompactUnsafe();
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
+    bool FlushPendingUnsafe(PendingDbRecords& pending);
+    bool AddPendingRecord(const DbRecord& record, bool merge);
 
     template <class T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
     {
         const auto key = DbRecord::Serialize(problem_config);
-        return FindRecordUnsafe(key, nullptr);
+        return FindRecordUnsafe(key);
     }
 };
 
@@ -175,6 +192,8 @@ class MultiFileDb
           ,
           _user(GetDbInstance<TUser>(user_path, false))
 #endif
+          ,
+          remote_name(RemoteDb::GetName(installed_path))
     {
 #if MIOPEN_DISABLE_USERDB
         (void)(user_path);
@@ -200,7 +219,7 @@ class MultiFileDb
             return users;
 #endif
 
-        return installed;
+        return FetchRemote(installed, args...);
     }
 
     template <bool merge = merge_records, std::enable_if_t<!merge>* = nullptr, typename... U>
@@ -208,10 +227,10 @@ class MultiFileDb
     {
 #if !MIOPEN_DISABLE_USERDB
         auto users = _user.FindRecord(args...);
-        return users ? users : _installed.FindRecord(args...);
-#else
-        return _installed.FindRecord(args...);
+        if(users)
+            return users;
 #endif
+        return FetchRemote(_installed.FindRecord(args...), args...);
     }
 
     template <typename... U>
@@ -221,7 +240,10 @@ class MultiFileDb
         sink{args...};
         return true;
 #else
-        return _user.StoreRecord(args...);
+        const auto ok = _user.StoreRecord(args...);
+        if(ok)
+            PublishRemote(args...);
+        return ok;
 #endif
     }
 
@@ -232,7 +254,10 @@ class MultiFileDb
         sink{args...};
         return true;
 #else
-        return _user.UpdateRecord(args...);
+        const auto ok = _user.UpdateRecord(args...);
+        if(ok)
+            PublishRemote(args...);
+        return ok;
 #endif
     }
 
@@ -254,7 +279,10 @@ class MultiFileDb
         sink{args...};
         return true;
 #else
-        return _user.Update(args...);
+        auto record = _user.Update(args...);
+        if(record)
+            PublishUpdated(*record, args...);
+        return record;
 #endif
     }
 
@@ -265,7 +293,9 @@ class MultiFileDb
         if(_user.Load(args...))
             return true;
 #endif
-        return _installed.Load(args...);
+        if(_installed.Load(args...))
+            return true;
+        return LoadRemote(args...);
     }
 
     template <typename... U>
@@ -298,10 +328,67 @@ class MultiFileDb
         return GetDbInstance<TDb>(rank<1>{}, path, warn_if_unreadable);
     }
 
+    // Only the databases of records are shared through RemoteDb.
+    template <class TRecord, typename... U>
+    TRecord FetchRemote(TRecord found, const U&...)
+    {
+        return found;
+    }
+
+    template <typename U>
+    boost::optional<DbRecord> FetchRemote(boost::optional<DbRecord> found, const U& key)
+    {
+        if(found || remote_name.empty())
+            return found;
+
+        auto record = RemoteDb::Get()->Fetch(remote_name, RemoteDb::GetKey(key));
+#if !MIOPEN_DISABLE_USERDB
+        if(record)
+            CacheRemote(std::is_same<TUser, PlainTextDb>{}, *record);
+#endif
+        return record;
+    }
+
+    template <typename... U>
+    bool LoadRemote(U&...)
+    {
+        return false;
+    }
+
+    template <class T, class V>
+    bool LoadRemote(T& problem_config, const std::string& id, V& values)
+    {
+        const auto record = FetchRemote(boost::optional<DbRecord>{}, problem_config);
+        return record && record->GetValues(id, values);
+    }
+
+    /// Records are cached by the user db unless it keeps them in a different form.
+    void CacheRemote(std::true_type, const DbRecord& record) { _user.StoreRecord(record); }
+    void CacheRemote(std::false_type, const DbRecord&) {}
+
+    template <typename... U>
+    void PublishRemote(const U&...)
+    {
+    }
+
+    void PublishRemote(const DbRecord& record)
+    {
+        if(!remote_name.empty())
+            RemoteDb::Get()->Publish(remote_name, record);
+    }
+
+    template <class T, typename... U>
+    void PublishUpdated(const DbRecord& record, const T& problem_config, const U&...)
+    {
+        if(!remote_name.empty())
+            RemoteDb::Get()->Publish(remote_name, RemoteDb::GetKey(problem_config), record);
+    }
+
     decltype(MultiFileDb::GetDbInstance<TInstalled>("", true)) _installed;
 #if !MIOPEN_DISABLE_USERDB
     decltype(MultiFileDb::GetDbInstance<TUser>("", false)) _user;
 #endif
+    std::string remote_name;
 };
 
 template <class TInnerDb>
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_MERGE_HPP_
+#define GUARD_MIOPEN_DB_MERGE_HPP_
+
+#include <miopen/config.h>
+#include <miopen/db_record.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Offline merge of databases collected from many machines into one compact database.
+///
+/// Text databases (find-db and perf-db) are parsed in parallel, each with the append-only
+/// semantics of PlainTextDb: the latest line of a key wins and an empty line removes it.
+/// Then they are merged in the order given. For the same key and ID, find-db keeps the
+/// fastest entry and perf-db keeps the one from the latest input. The output has one line
+/// per key, sorted by key, which also suits MappedDb::Convert.
+class DbMerger
+{
+    public:
+    /// \return False for the entries which shall be dropped, e.g. these of the removed solvers.
+    using Filter = std::function<bool(const std::string& id, const std::string& values)>;
+
+    struct Options
+    {
+        /// Values are FindDbData and the fastest one is kept for each ID.
+        bool find_db = false;
+        Filter filter;
+        /// Number of the parsing threads, 0 for the number of the hardware threads.
+        std::size_t jobs = 0;
+    };
+
+    DbMerger(Options options_);
+
+    void AddText(const std::vector<std::string>& paths);
+    void WriteText(const std::string& path) const;
+    std::size_t GetCount() const { return records.size(); }
+    /// Keys of the merged records in the sorted order.
+    std::vector<std::string> GetKeys() const;
+
+#if MIOPEN_ENABLE_SQLITE
+    /// Merges SQLite perf databases into the output one, which is created if missing.
+    /// Rows of the later inputs replace these of the earlier ones for the same problem
+    /// and solver. Problems without solvers left are removed and the file is vacuumed.
+    static void MergeSQLite(const std::vector<std::string>& inputs,
+                            const std::string& output,
+                            const Filter& filter);
+#endif
+
+    private:
+    using Records = std::map<std::string, DbRecord>;
+
+    Records Parse(const std::string& path) const;
+    void Merge(Records& to, Records&& from) const;
+    bool IsBetter(const std::string& values, const std::string& than) const;
+
+    Options options;
+    Records records;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_MERGE_HPP_
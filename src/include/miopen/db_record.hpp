@@ -242,6 +242,8 @@ class DbRecord
     friend class PlainTextDb;
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
+    friend class RemoteDb;
+    friend class DbMerger;
 };
 
 } // namespace miopen
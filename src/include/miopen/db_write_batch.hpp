@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_WRITE_BATCH_HPP_
+#define GUARD_MIOPEN_DB_WRITE_BATCH_HPP_
+
+#include <chrono>
+#include <cstddef>
+
+namespace miopen {
+
+/// Write-behind batching of the user perf-db and find-db updates.
+///
+/// When enabled with MIOPEN_DB_WRITE_BATCH_SIZE above one, updates are kept in memory
+/// and written in one transaction (SQLite) or one rewrite of the file (text db) when
+/// the number of pending updates reaches the limit, when the oldest of them is older
+/// than MIOPEN_DB_WRITE_BATCH_TIMEOUT_MS, when a handle is destroyed and on exit.
+/// Lookups in the process see the pending updates.
+struct DbWriteBatchLimits
+{
+    std::size_t size;
+    std::chrono::milliseconds timeout;
+
+    static const DbWriteBatchLimits& Get();
+    bool IsEnabled() const { return size > 1; }
+};
+
+/// Writes all pending updates of the user databases of the process.
+void FlushDbWrites() noexcept;
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_WRITE_BATCH_HPP_
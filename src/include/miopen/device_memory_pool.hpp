@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DEVICE_MEMORY_POOL_HPP_
+#define GUARD_MIOPEN_DEVICE_MEMORY_POOL_HPP_
+
+#include <miopen/allocator.hpp>
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// Caching allocator of device memory used by Handle::Create when no custom
+/// allocator is set.
+///
+/// Freed buffers are kept in free lists indexed by size class instead of being
+/// returned with hipFree (which synchronizes the whole device). A cached block is
+/// only handed out again for the stream it has been used on last time, so work
+/// still pending on that stream is ordered before any use of the new owner and no
+/// synchronization is required. Cached blocks are released when the amount of cached
+/// memory exceeds the limit (MIOPEN_DEVICE_MEMORY_POOL_LIMIT_MB) and on memory
+/// pressure, i.e. when hipMalloc fails or there is not enough free device memory.
+///
+/// There is one pool per device. Pools are never destroyed, so buffers are allowed
+/// to outlive the handles that have created them.
+class DeviceMemoryPool
+{
+    public:
+    static DeviceMemoryPool& Get(int device);
+    static bool IsEnabled();
+
+    Allocator::ManageDataPtr Allocate(std::size_t size, miopenAcceleratorQueue_t stream);
+    /// Returns all cached blocks to the device.
+    void Trim();
+
+    std::size_t GetCachedSize() const;
+    std::size_t GetUsedSize() const;
+
+    private:
+    struct Block
+    {
+        void* ptr;
+        std::size_t size;
+        miopenAcceleratorQueue_t stream;
+    };
+
+    explicit DeviceMemoryPool(int device_);
+
+    static std::size_t GetSizeClass(std::size_t size);
+    static void Deallocate(void* context, void* ptr);
+
+    void Release(void* ptr);
+    void* AllocateFromDevice(std::size_t size);
+    void TrimUnsafe();
+
+    const int device;
+    const std::size_t limit;
+    mutable std::mutex mutex;
+    // size class -> cached blocks
+    std::map<std::size_t, std::vector<Block>> free_blocks;
+    std::unordered_map<void*, Block> used_blocks;
+    std::size_t cached_size = 0;
+    std::size_t used_size   = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DEVICE_MEMORY_POOL_HPP_
@@ -65,9 +65,15 @@ struct DropoutDescriptor : miopenDropoutDescriptor
     bool use_mask;
     bool state_evo;
     miopenRNGType_t rng_mode;
+    // Counter offset of MIOPEN_RNG_PHILOX, which keeps no states
+    unsigned long long offset;
+    // The mask in reserveSpace holds one bit instead of one byte per element
+    bool mask_packed;
 
     miopenDataType_t dataType_;
 
+    size_t GetReserveSpaceSize(const TensorDescriptor& xDesc) const;
+
     void InitPRNGState(Handle& handle,
                        Data_t prng_states,
                        size_t prng_stateSizeInBytes,
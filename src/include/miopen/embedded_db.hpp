@@ -0,0 +1,60 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_EMBEDDED_DB_HPP_
+#define GUARD_MIOPEN_EMBEDDED_DB_HPP_
+
+#include <miopen/config.h>
+
+#if MIOPEN_EMBED_DB
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace embedded {
+
+/// The databases embedded into the library by MIOPEN_EMBED_DB, e.g. "gfx906_60.db". These are
+/// either stored as is or compressed with bzip2 when built with MIOPEN_EMBED_DB_COMPRESS,
+/// which is transparent to the callers.
+
+/// Names of the embedded files, without the compression suffix.
+const std::vector<std::string>& GetFileNames();
+
+bool HasFile(const std::string& name);
+
+/// Contents of an embedded file, or {nullptr, 0} if there is none. A compressed file is
+/// decompressed on the first request and kept for the lifetime of the process, so only the
+/// databases of the devices in use are paged in and expanded.
+std::pair<const char*, std::size_t> GetFile(const std::string& name);
+
+} // namespace embedded
+} // namespace miopen
+
+#endif // MIOPEN_EMBED_DB
+
+#endif // GUARD_MIOPEN_EMBEDDED_DB_HPP_
@@ -26,6 +26,7 @@
 #ifndef GUARD_MIOPEN_ENV_HPP
 #define GUARD_MIOPEN_ENV_HPP
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <string>
@@ -33,7 +34,7 @@
 
 namespace miopen {
 
-/// \todo Rework: Case-insensitive string compare, ODR, (?) move to .cpp
+/// \todo Rework: Case-insensitive string compare, ODR
 
 // Declare a cached environment variable
 #define MIOPEN_DECLARE_ENV_VAR(x)                 \
@@ -42,36 +43,82 @@ namespace miopen {
         static const char* value() { return #x; } \
     };
 
+namespace env {
+
+/// The environment is read once per process into a snapshot, which all the lookups below use
+/// instead of scanning environ on each call. Changes made with setenv() after the first lookup
+/// are only seen after Refresh().
+
+/// The value of \p name in the current snapshot, nullptr if it is not set. The string stays
+/// valid until the end of the process, also after Refresh().
+const char* GetSnapshotValue(const char* name);
+
+/// Incremented by each Refresh().
+std::size_t GetSnapshotGeneration();
+
+/// Re-reads the environment. The values cached by IsEnabled(), IsDisabled(), Value() and
+/// GetStringEnv() are updated on their next call.
+void Refresh();
+
+/// A value derived from an environment variable, re-derived when the snapshot changes.
+template <class V>
+class CachedValue
+{
+    public:
+    template <class F>
+    V Get(const char* name, F derive)
+    {
+        const auto snapshot = GetSnapshotGeneration();
+        if(generation.load(std::memory_order_acquire) != snapshot)
+        {
+            value.store(derive(GetSnapshotValue(name)), std::memory_order_relaxed);
+            generation.store(snapshot, std::memory_order_release);
+        }
+        return value.load(std::memory_order_relaxed);
+    }
+
+    private:
+    std::atomic<std::size_t> generation{0};
+    std::atomic<V> value{};
+};
+
+inline bool IsValueDisabled(const char* value)
+{
+    return value != nullptr &&
+           (std::strcmp(value, "disable") == 0 || std::strcmp(value, "disabled") == 0 ||
+            std::strcmp(value, "0") == 0 || std::strcmp(value, "no") == 0 ||
+            std::strcmp(value, "false") == 0);
+}
+
+inline bool IsValueEnabled(const char* value)
+{
+    return value != nullptr &&
+           (std::strcmp(value, "enable") == 0 || std::strcmp(value, "enabled") == 0 ||
+            std::strcmp(value, "1") == 0 || std::strcmp(value, "yes") == 0 ||
+            std::strcmp(value, "true") == 0);
+}
+
+} // namespace env
+
 /*
  * Returns false if a feature-controlling environment variable is defined
  * and set to something which disables a feature.
  */
 inline bool IsEnvvarValueDisabled(const char* name)
 {
-    // NOLINTNEXTLINE (concurrency-mt-unsafe)
-    const auto value_env_p = std::getenv(name);
-    return value_env_p != nullptr &&
-           (std::strcmp(value_env_p, "disable") == 0 || std::strcmp(value_env_p, "disabled") == 0 ||
-            std::strcmp(value_env_p, "0") == 0 || std::strcmp(value_env_p, "no") == 0 ||
-            std::strcmp(value_env_p, "false") == 0);
+    return env::IsValueDisabled(env::GetSnapshotValue(name));
 }
 
 inline bool IsEnvvarValueEnabled(const char* name)
 {
-    // NOLINTNEXTLINE (concurrency-mt-unsafe)
-    const auto value_env_p = std::getenv(name);
-    return value_env_p != nullptr &&
-           (std::strcmp(value_env_p, "enable") == 0 || std::strcmp(value_env_p, "enabled") == 0 ||
-            std::strcmp(value_env_p, "1") == 0 || std::strcmp(value_env_p, "yes") == 0 ||
-            std::strcmp(value_env_p, "true") == 0);
+    return env::IsValueEnabled(env::GetSnapshotValue(name));
 }
 
 // Return 0 if env is enabled else convert environment var to an int.
 // Supports hexadecimal with leading 0x or decimal
 inline unsigned long int EnvvarValue(const char* name, unsigned long int fallback = 0)
 {
-    // NOLINTNEXTLINE (concurrency-mt-unsafe)
-    const auto value_env_p = std::getenv(name);
+    const auto value_env_p = env::GetSnapshotValue(name);
     if(value_env_p == nullptr)
     {
         return fallback;
@@ -84,8 +131,7 @@ inline unsigned long int EnvvarValue(const char* name, unsigned long int fallbac
 
 inline std::vector<std::string> GetEnv(const char* name)
 {
-    // NOLINTNEXTLINE (concurrency-mt-unsafe)
-    const auto p = std::getenv(name);
+    const auto p = env::GetSnapshotValue(name);
     if(p == nullptr)
         return {};
     else
@@ -95,32 +141,31 @@ inline std::vector<std::string> GetEnv(const char* name)
 template <class T>
 inline const char* GetStringEnv(T)
 {
-    static const std::vector<std::string> result = GetEnv(T::value());
-    if(result.empty())
-        return nullptr;
-    else
-        return result.front().c_str();
+    static env::CachedValue<const char*> result;
+    return result.Get(T::value(), [](const char* value) { return value; });
 }
 
 template <class T>
 inline bool IsEnabled(T)
 {
-    static const bool result = miopen::IsEnvvarValueEnabled(T::value());
-    return result;
+    static env::CachedValue<bool> result;
+    return result.Get(T::value(), env::IsValueEnabled);
 }
 
 template <class T>
 inline bool IsDisabled(T)
 {
-    static const bool result = miopen::IsEnvvarValueDisabled(T::value());
-    return result;
+    static env::CachedValue<bool> result;
+    return result.Get(T::value(), env::IsValueDisabled);
 }
 
 template <class T>
 inline unsigned long int Value(T, unsigned long int fallback = 0)
 {
-    static const auto result = miopen::EnvvarValue(T::value(), fallback);
-    return result;
+    // The fallback is not cached, callers may pass different ones.
+    static env::CachedValue<const char*> result;
+    const auto value = result.Get(T::value(), [](const char* v) { return v; });
+    return value == nullptr ? fallback : strtoul(value, nullptr, 0);
 }
 } // namespace miopen
 
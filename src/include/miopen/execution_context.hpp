@@ -29,9 +29,7 @@
 #include <miopen/db_path.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/sqlite_db.hpp>
-#if MIOPEN_EMBED_DB
-#include <miopen_data.hpp>
-#endif
+#include <miopen/embedded_db.hpp>
 #include <boost/filesystem.hpp>
 
 #include <string>
@@ -104,7 +102,7 @@ struct ExecutionContext
 #endif
             filename << ext;
             // clang-format on
-            if(miopen_data().find(filename.str() + ".o") != miopen_data().end())
+            if(embedded::HasFile(filename.str()))
             {
                 MIOPEN_LOG_I("Found exact embedded perf database file");
                 return (pdb_path / filename.str()).string();
@@ -117,10 +115,8 @@ struct ExecutionContext
                 namespace fs            = boost::filesystem;
                 int closest_cu          = std::numeric_limits<int>::max();
                 fs::path best_path;
-                for(auto const& entry : miopen_data())
+                for(auto const& fname : embedded::GetFileNames())
                 {
-                    // string the .o from the filename
-                    const auto fname = entry.first.substr(0, entry.first.size() - 2);
                     MIOPEN_LOG_I2("Testing embedded file:" << fname);
                     const auto& filepath = pdb_path / fname;
                     if(filepath.extension() == ext &&
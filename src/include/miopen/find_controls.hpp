@@ -32,6 +32,7 @@
 
 #include <boost/optional.hpp>
 
+#include <cstddef>
 #include <ostream>
 
 namespace miopen {
@@ -105,6 +106,13 @@ class FindEnforce
 
 boost::optional<std::vector<solver::Id>> GetEnvFindOnlySolver();
 
+/// Milliseconds a find call may take in the budgeted find mode, see MIOPEN_FIND_BUDGET_MS.
+float GetFindBudgetMs();
+
+/// Threads enumerating the solvers of a find which does not search, see
+/// MIOPEN_FIND_SOLVERS_PARALLEL_LEVEL. 1 makes the enumeration serial.
+std::size_t GetFindSolversParallelLevel();
+
 class FindMode
 {
     public:
@@ -116,6 +124,7 @@ class FindMode
         Hybrid,
         FastHybrid,
         DynamicHybrid,
+        Budgeted,
         End_,
         Default_ = DynamicHybrid,
     };
@@ -165,6 +174,12 @@ class FindMode
         return value == Values::DynamicHybrid && IsEnabled(context);
     }
 
+    template <class Context>
+    bool IsBudgeted(const Context& context) const
+    {
+        return value == Values::Budgeted && IsEnabled(context);
+    }
+
     friend std::ostream& operator<<(std::ostream&, const FindMode&);
 };
 
@@ -31,8 +31,11 @@
 #include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/timer.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/optional.hpp>
 
@@ -68,6 +71,13 @@ testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
 
 bool CheckInvokerSupport(const std::string& algo);
 
+/// Records hold the fastest solution of each algorithm under the name of the algorithm. The
+/// solutions which need less workspace than all the faster ones are kept under the ids made here,
+/// so that a record holds the Pareto-optimal solutions by time and workspace.
+std::string MakeFindDbParetoId(const std::string& algorithm, const std::string& solver_id);
+/// Returns the algorithm of a record entry, see MakeFindDbParetoId().
+std::string GetFindDbAlgorithm(const std::string& id);
+
 template <class TDb>
 class FindDbRecord_t
 {
@@ -96,6 +106,27 @@ class FindDbRecord_t
             return;
 
         content = db->FindRecord(problem);
+        DropStale();
+        in_sync = content.is_initialized();
+    }
+
+    /// Same as above but takes an already serialized problem, which allows to
+    /// avoid formatting the key on each call of the immediate mode.
+    template <class TTestDb = TDb>
+    FindDbRecord_t(Handle& handle, const std::string& key, is_immediate_t<TTestDb> = 0)
+        : path(testing_find_db_path_override() ? *testing_find_db_path_override()
+                                               : GetUserPath(handle)),
+          installed_path(testing_find_db_path_override() ? *testing_find_db_path_override()
+                                                         : GetInstalledPath(handle)),
+          db(boost::make_optional<DbTimer<TDb>>(testing_find_db_enabled &&
+                                                    !IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}),
+                                                DbTimer<TDb>{installed_path, path}))
+    {
+        if(!db.is_initialized())
+            return;
+
+        content = db->FindRecord(key);
+        DropStale();
         in_sync = content.is_initialized();
     }
 
@@ -115,6 +146,7 @@ class FindDbRecord_t
             return;
 
         content = db->FindRecord(problem);
+        DropStale();
         in_sync = content.is_initialized();
     }
 
@@ -132,46 +164,85 @@ class FindDbRecord_t
     auto end() { return content->As<FindDbData>().end(); }
     bool empty() const { return !content.is_initialized(); }
 
+    /// Provisional records, see FindDbData::provisional, are regenerated unless
+    /// \p accept_provisional is set.
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
                                           const TProblemDescription& problem,
-                                          const std::function<void(DbRecord&)>& regenerator)
+                                          const std::function<void(DbRecord&)>& regenerator,
+                                          bool accept_provisional = false)
     {
         auto ret = std::vector<PerfField>{};
         FindDbRecord_t<TDb> record{handle, problem};
 
         const auto network_config = problem.BuildConfKey();
 
-        if(record.in_sync && !record.Validate(handle, network_config))
+        if(record.in_sync && !record.has_stale &&
+           (accept_provisional || !record.IsProvisional()) &&
+           !record.Validate(handle, network_config))
         {
+            trace::Instant("find_db", "Find-db hit", network_config.ToString());
+            AddMetric(handle, Metric::FindDbHits);
             record.CopyTo(ret);
             return ret;
         }
 
         MIOPEN_LOG_I("Find-db regenerating.");
+        trace::Instant("find_db", "Find-db miss", network_config.ToString());
+        AddMetric(handle, Metric::FindDbMisses);
         ret.clear();
         record.in_sync = false;
         record.content.emplace(problem);
-        regenerator(*record.content);
+        {
+            MIOPEN_TRACE_SCOPE("find", "Find " + network_config.ToString());
+            Timer timer;
+            timer.start();
+            regenerator(*record.content);
+            AddMetricTime(handle, Metric::Finds, Metric::FindUs, timer.elapsed_ms());
+        }
         record.CopyTo(ret);
 
         return ret;
     }
 
+    /// Lets \p modifier change the record of the problem, which is created if missing, and
+    /// stores it, e.g. when a solution has been measured to be faster after the find.
+    template <class TProblemDescription>
+    static void Update(Handle& handle,
+                       const TProblemDescription& problem,
+                       const std::function<void(DbRecord&)>& modifier)
+    {
+        FindDbRecord_t<TDb> record{handle, problem};
+        if(!record.db.is_initialized())
+            return;
+        if(!record.content.is_initialized())
+            record.content.emplace(problem);
+        modifier(*record.content);
+        record.in_sync = false;
+    }
+
+    /// The user find-db of the handle, empty when the user dbs are disabled. Also holds the
+    /// records of other finds, e.g. of the fusion plans.
+    static std::string GetUserPath(Handle& handle);
+
     private:
     std::string path;
     std::string installed_path;
     boost::optional<DbTimer<TDb>> db;
     boost::optional<DbRecord> content{boost::none};
-    bool in_sync = false;
+    bool in_sync   = false;
+    bool has_stale = false;
 
     static bool HasKernel(Handle& handle, const FindDbKCacheKey& key);
 
     static std::string GetInstalledPath(Handle& handle);
     static std::string GetInstalledPathEmbed(Handle& handle);
     static std::string GetInstalledPathFile(Handle& handle);
-    static std::string GetUserPath(Handle& handle);
 
+    // Removes entries of the solvers which db version has changed since they were found, so
+    // that the rest of the record stays usable and only find mode regenerates it.
+    void DropStale();
+    bool IsProvisional() const;
     // Returns true if rebuild is required
     bool Validate(Handle& handle, const NetworkConfig& config) const;
     void CopyTo(std::vector<PerfField>& to) const;
@@ -29,9 +29,15 @@
 
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
+#include <miopen/execution_context.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/par_for.hpp>
 #include <miopen/solver_id.hpp>
 
+#include <boost/optional.hpp>
+
+#include <exception>
+#include <functional>
 #include <limits>
 #include <vector>
 
@@ -53,9 +59,10 @@ auto FindSolutionImpl(
         return s.GetSolution(context, s.GetPerformanceConfig(context));
     }
     MIOPEN_LOG_I(SolverDbId(s));
+    const auto& db_id = SolverPerfDbId(s);
     if(enforce.IsDbClean(context))
     {
-        if(db.Remove(context, SolverDbId(s)))
+        if(db.Remove(context, db_id))
             MIOPEN_LOG_W("Perf Db: record removed: " << SolverDbId(s) << ", enforce: " << enforce);
     }
     else
@@ -68,7 +75,7 @@ auto FindSolutionImpl(
         {
             using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
             PerformanceConfig config{};
-            if(db.Load(context, SolverDbId(s), config))
+            if(db.Load(context, db_id, config))
             {
                 MIOPEN_LOG_I2("Perf Db: record loaded: " << SolverDbId(s));
                 if(s.IsValidPerformanceConfig(context, config))
@@ -90,7 +97,7 @@ auto FindSolutionImpl(
             try
             {
                 auto c = s.Search(context, invoke_ctx);
-                db.Update(context, SolverDbId(s), c);
+                db.Update(context, db_id, c);
                 return s.GetSolution(context, c);
             }
             catch(const miopen::Exception& ex)
@@ -129,6 +136,137 @@ FindSolution(Solver s, const Context& context, Db& db, const AnyInvokeParams& in
     return solution;
 }
 
+template <class Solver, class Problem, class Db>
+auto FindSolutionImpl(rank<1>,
+                      Solver s,
+                      const ExecutionContext& context,
+                      const Problem& problem,
+                      Db& db,
+                      const AnyInvokeParams& invoke_ctx)
+    -> decltype(s.GetSolution(context, problem, s.Search(context, problem, invoke_ctx)))
+{
+    const FindEnforce enforce;
+    if(context.disable_perfdb_access)
+    {
+        MIOPEN_LOG_I(SolverDbId(s) << " (db access disabled)");
+        return s.GetSolution(context, problem, s.GetPerformanceConfig(context, problem));
+    }
+    MIOPEN_LOG_I(SolverDbId(s));
+    const auto& db_id = SolverPerfDbId(s);
+    if(enforce.IsDbClean(context))
+    {
+        if(db.Remove(problem, db_id))
+            MIOPEN_LOG_W("Perf Db: record removed: " << SolverDbId(s) << ", enforce: " << enforce);
+    }
+    else
+    {
+        if((context.do_search || enforce.IsSearch(context)) && enforce.IsDbUpdate(context))
+        {
+            MIOPEN_LOG_W("Perf Db: load skipped: " << SolverDbId(s) << ", enforce: " << enforce);
+        }
+        else
+        {
+            using PerformanceConfig = decltype(s.GetPerformanceConfig(context, problem));
+            PerformanceConfig config{};
+            auto loaded = false;
+            try
+            {
+                loaded = db.Load(problem, db_id, config);
+            }
+            catch(const miopen::Exception& ex)
+            {
+                // E.g. the system database predates the table of this kind of problems.
+                MIOPEN_LOG_W("Perf Db: load failed for: " << SolverDbId(s) << ": " << ex.what());
+            }
+            if(loaded)
+            {
+                MIOPEN_LOG_I2("Perf Db: record loaded: " << SolverDbId(s));
+                if(s.IsValidPerformanceConfig(context, problem, config))
+                {
+                    return s.GetSolution(context, problem, config);
+                }
+                MIOPEN_LOG_WE("Invalid config loaded from Perf Db: "
+                              << SolverDbId(s) << ": " << config << ". Performance may degrade.");
+            }
+            else
+            {
+                MIOPEN_LOG_I("Perf Db: record not found for: " << SolverDbId(s));
+            }
+        }
+
+        if(context.do_search || enforce.IsSearch(context))
+        {
+            MIOPEN_LOG_I("Starting search: " << SolverDbId(s) << ", enforce: " << enforce);
+            try
+            {
+                auto c = s.Search(context, problem, invoke_ctx);
+                db.Update(problem, db_id, c);
+                return s.GetSolution(context, problem, c);
+            }
+            catch(const miopen::Exception& ex)
+            {
+                MIOPEN_LOG_E("Search failed for: " << SolverDbId(s) << ": " << ex.what());
+            }
+        }
+    }
+
+    return s.GetSolution(context, problem, s.GetPerformanceConfig(context, problem));
+}
+
+template <class Solver, class Problem, class Db>
+auto FindSolutionImpl(rank<0>,
+                      Solver s,
+                      const ExecutionContext& context,
+                      const Problem& problem,
+                      Db&,
+                      const AnyInvokeParams&) -> decltype(s.GetSolution(context, problem))
+{
+    MIOPEN_LOG_I(SolverDbId(s) << " (not searchable)");
+    return s.GetSolution(context, problem);
+}
+
+/// Finds optimized Solution for the solvers which take the problem apart from the context.
+/// May read/write perfDb, the same way as the generic method above.
+template <class Solver, class Problem, class Db>
+ConvSolution FindSolution(Solver s,
+                          const ExecutionContext& context,
+                          const Problem& problem,
+                          Db& db,
+                          const AnyInvokeParams& invoke_ctx)
+{
+    static_assert(std::is_empty<Solver>{} && std::is_trivially_constructible<Solver>{},
+                  "Solver must be stateless");
+    auto solution      = FindSolutionImpl(rank<1>{}, s, context, problem, db, invoke_ctx);
+    solution.solver_id = SolverDbId(s);
+    return solution;
+}
+
+/// Calls \p f for each index below \p n on up to GetFindSolversParallelLevel() threads. The
+/// exception thrown for the lowest index, if any, is rethrown once all the calls are done, as
+/// the serial loop over the solvers would have thrown it.
+template <class F>
+void ParForSolvers(std::size_t n, const F& f)
+{
+    auto errors = std::vector<std::exception_ptr>(n);
+    // Strided, since the expensive solvers tend to be next to each other.
+    par_for_strided(n, max_threads{GetFindSolversParallelLevel()}, [&](auto i) {
+        try
+        {
+            f(i);
+        }
+        catch(...)
+        {
+            errors[i] = std::current_exception();
+        }
+    });
+
+    for(const auto& error : errors)
+    {
+        if(error)
+            std::rethrow_exception(error);
+    }
+}
+
 template <class... Solvers>
 struct SolverContainer
 {
@@ -139,6 +277,75 @@ struct SolverContainer
                           Db&& db,
                           const AnyInvokeParams& invoke_ctx,
                           std::size_t limit = std::numeric_limits<std::size_t>::max()) const
+    {
+        const auto find_only = GetEnvFindOnlySolver();
+        const auto solve     = [&](auto solver) -> boost::optional<Solution> {
+            if(find_only &&
+               (std::find(find_only->begin(), find_only->end(), Id{SolverDbId(solver)}) ==
+                find_only->end()))
+            { // Do nothing (and keep silence for the sake of Tuna), just skip.
+                return boost::none;
+            }
+            // For better performance, check IsDynamic() first, because
+            // it is much faster than IsApplicable().
+            if(search_params.use_dynamic_solutions_only && !solver.IsDynamic())
+            {
+                MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-dynamic)");
+                return boost::none;
+            }
+            if(!solver.IsApplicable(search_params))
+            {
+                MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
+                return boost::none;
+            }
+            if(search_params.GetStream().IsDeterministic() &&
+               !solver.IsDeterministic(search_params))
+            {
+                MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-deterministic)");
+                return boost::none;
+            }
+
+            const Solution s = FindSolution(solver, search_params, db, invoke_ctx);
+            if(!s.Succeeded())
+            {
+                /// \todo If Solver is applicable it must provide an appropriate Solution.
+                /// This is not the case for some 20x5 convolutions (and possibly others).
+                /// Normally we should not get here and message level should be Error.
+                /// For now, let's use Info (not Warning) level to avoid
+                /// flooding the console.
+                MIOPEN_LOG_I(SolverDbId(solver) << ": [Warning] Applicable Solver not succeeded.");
+                return boost::none;
+            }
+            MIOPEN_LOG_I2(SolverDbId(solver) << ": Success.");
+            return s;
+        };
+
+        // The searches measure the kernels on the GPU, so they are run one at a time. The limit
+        // needs the solutions of the preceding solvers.
+        const FindEnforce enforce;
+        if(limit == std::numeric_limits<std::size_t>::max() && !search_params.do_search &&
+           !enforce.IsSomethingEnforced(search_params))
+            return SolveInParallel<Solution>(solve);
+
+        std::vector<Solution> ss;
+        miopen::each_args(
+            [&](auto solver) {
+                if(ss.size() >= limit)
+                    return;
+                auto s = solve(solver);
+                if(s)
+                    ss.push_back(std::move(*s));
+            },
+            Solvers{}...);
+        return ss;
+    }
+
+    // Search for all applicable solutions among many solvers
+    template <class Problem, class Solution = miopen::solver::ConvSolution>
+    std::vector<Solution>
+    SearchForSolutions(const ExecutionContext& ctx,
+                       const Problem& problem,
+                       std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
         std::vector<Solution> ss;
         std::size_t count    = 0;
@@ -154,13 +361,14 @@ struct SolverContainer
                 }
                 // For better performance, check IsDynamic() first, because
                 // it is much faster than IsApplicable().
-                else if(search_params.use_dynamic_solutions_only && !solver.IsDynamic())
-                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-dynamic)");
-                else if(!solver.IsApplicable(search_params))
+                // else if(problem.use_dynamic_solutions_only && !solver.IsDynamic())
+                //    MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-dynamic)");
+                else if(!solver.IsApplicable(ctx, problem))
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
                 else
                 {
-                    const Solution s = FindSolution(solver, search_params, db, invoke_ctx);
+                    auto s      = solver.GetSolution(ctx, problem);
+                    s.solver_id = SolverDbId(solver);
                     if(s.Succeeded())
                     {
                         ++count;
@@ -169,13 +377,7 @@ struct SolverContainer
                     }
                     else
                     {
-                        /// \todo If Solver is applicable it must provide an appropriate Solution.
-                        /// This is not the case for some 20x5 convolutions (and possibly others).
-                        /// Normally we should not get here and message level should be Error.
-                        /// For now, let's use Info (not Warning) level to avoid
-                        /// flooding the console.
-                        MIOPEN_LOG_I(SolverDbId(solver)
-                                     << ": [Warning] Applicable Solver not succeeded.");
+                        MIOPEN_LOG_E(SolverDbId(solver) << ": Applicable Solver not succeeded.");
                     }
                 }
             },
@@ -183,11 +385,14 @@ struct SolverContainer
         return ss;
     }
 
-    // Search for all applicable solutions among many solvers
-    template <class Problem, class Solution = miopen::solver::ConvSolution>
+    // Search for all applicable solutions among many solvers, the searchable ones are tuned or
+    // loaded from the perf-db
+    template <class Problem, class Db, class Solution = miopen::solver::ConvSolution>
     std::vector<Solution>
     SearchForSolutions(const ExecutionContext& ctx,
                        const Problem& problem,
+                       Db&& db,
+                       const AnyInvokeParams& invoke_ctx,
                        std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
         std::vector<Solution> ss;
@@ -202,16 +407,11 @@ struct SolverContainer
                     find_only->end()))
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                // For better performance, check IsDynamic() first, because
-                // it is much faster than IsApplicable().
-                // else if(problem.use_dynamic_solutions_only && !solver.IsDynamic())
-                //    MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped (non-dynamic)");
                 else if(!solver.IsApplicable(ctx, problem))
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
                 else
                 {
-                    auto s      = solver.GetSolution(ctx, problem);
-                    s.solver_id = SolverDbId(solver);
+                    const Solution s = FindSolution(solver, ctx, problem, db, invoke_ctx);
                     if(s.Succeeded())
                     {
                         ++count;
@@ -296,6 +496,26 @@ struct SolverContainer
 
         return found;
     }
+
+    private:
+    /// Runs \p solve for each of the solvers in parallel, the solutions are returned in the order
+    /// of the solvers.
+    template <class Solution, class F>
+    static std::vector<Solution> SolveInParallel(const F& solve)
+    {
+        const auto jobs = std::vector<std::function<boost::optional<Solution>()>>{
+            [&solve]() { return solve(Solvers{}); }...};
+        auto results = std::vector<boost::optional<Solution>>(jobs.size());
+        ParForSolvers(jobs.size(), [&](auto i) { results[i] = jobs[i](); });
+
+        std::vector<Solution> ss;
+        for(auto& result : results)
+        {
+            if(result)
+                ss.push_back(std::move(*result));
+        }
+        return ss;
+    }
 };
 
 } // namespace solver
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FIND_TIMING_HPP_
+#define GUARD_MIOPEN_FIND_TIMING_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace miopen {
+
+enum class FindTimingStat
+{
+    Median,
+    TrimmedMean, ///< Mean of the samples without the lowest and the highest quarters.
+};
+
+/// Summary of the repeated measurements of a solution during find.
+struct FindTiming
+{
+    float time   = 0.0f; ///< Median or trimmed mean of the samples, ms.
+    float spread = 0.0f; ///< Interquartile range of the samples relative to the time.
+    int trials   = 0;
+    /// Time of the samples scaled to the max clock of the device, see NormalizeFindTime.
+    /// Zero if the clock is unknown, ms.
+    float norm_time = 0.0f;
+};
+
+/// How the solutions are measured, see MIOPEN_FIND_WARMUPS, MIOPEN_FIND_TRIALS,
+/// MIOPEN_FIND_TIME_STAT, MIOPEN_FIND_TIE_MARGIN, MIOPEN_FIND_STABILIZE and
+/// MIOPEN_FIND_SETTLE_MS.
+struct FindTimingConfig
+{
+    int warmups         = 1;
+    int trials          = 3;
+    FindTimingStat stat = FindTimingStat::Median;
+    float margin        = 0.02f; ///< Relative difference of the times treated as a tie.
+    /// Waits for the clocks to settle before the measurements and interleaves the runs of
+    /// the candidates, so that the boost, power capping and thermal state of the device
+    /// affect all of them alike.
+    bool stabilize         = false;
+    int settle_ms          = 500;   ///< Limit of the total kernel time of the warm-up.
+    float settle_tolerance = 0.02f; ///< Relative difference of the windows of the warm-up.
+};
+
+const FindTimingConfig& GetFindTimingConfig();
+
+FindTiming SummarizeFindTiming(std::vector<float> samples, FindTimingStat stat);
+
+/// Runs \p run, which returns the time of a single run in ms, until the times of two
+/// consecutive windows of runs agree within the settle tolerance, or until the runs took
+/// settle_ms in total. Nothing is run unless stabilization is enabled in \p config.
+/// \return Number of the runs done.
+int WarmUpUntilSettled(const std::function<float()>& run, const FindTimingConfig& config);
+
+/// The \p time measured at the shader \p clock scaled to \p max_clock, as if the kernel
+/// was bound by the clock. Zero if either of the clocks is unknown.
+float NormalizeFindTime(float time, std::size_t clock, std::size_t max_clock);
+
+/// Negative if \p lhs is faster than \p rhs, positive if slower and zero if the difference is
+/// within the tie margin. The margin grows to the spread of the samples of the noisier one.
+int CompareFindTiming(const FindTiming& lhs, const FindTiming& rhs, float margin);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_TIMING_HPP_
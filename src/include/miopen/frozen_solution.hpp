@@ -0,0 +1,91 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FROZEN_SOLUTION_HPP_
+#define GUARD_MIOPEN_FROZEN_SOLUTION_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/common.hpp>
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/invoke_params.hpp>
+#include <miopen/invoker.hpp>
+#include <miopen/object.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+
+namespace miopen {
+
+struct Handle;
+
+/// Solution of a problem bound to it for repeated runs, see Problem::Freeze(). The descriptors
+/// have been validated and the invoker built once, so a run only sets the buffers into the
+/// stored invoke params and launches the kernels. Not to be run from several threads at once.
+struct FrozenSolution : miopenFrozenSolution
+{
+    FrozenSolution(Invoker invoker_,
+                   AnyInvokeParams params_,
+                   miopenProblemDirection_t direction_,
+                   bool transposed_,
+                   std::size_t workspace_size_,
+                   bool prepares_weights_);
+
+    /// The buffers are in the terms of the problem the solution was frozen for.
+    void Run(const Handle& handle,
+             Data_t x,
+             Data_t w,
+             Data_t y,
+             Data_t workspace,
+             std::size_t workspace_size);
+
+    /// Transforms the filter \p w once for the following runs, which then do not read their
+    /// weights. Returns false, doing nothing, if the solver does not transform the filter.
+    bool PrepareWeights(const Handle& handle,
+                        ConstData_t w,
+                        Data_t workspace,
+                        std::size_t workspace_size);
+
+    std::size_t GetWorkspaceSize() const { return workspace_size; }
+
+    friend std::ostream& operator<<(std::ostream& stream, const FrozenSolution& frozen);
+
+    private:
+    Invoker invoker;
+    AnyInvokeParams params;
+    /// Direction of the problem after the conversion of the transposed convolutions.
+    miopenProblemDirection_t direction;
+    bool transposed;
+    std::size_t workspace_size;
+    bool prepares_weights;
+    /// Shared by the copies, which are bound to the same weights.
+    std::shared_ptr<conv::PreparedWeights> prepared_weights;
+};
+
+} // namespace miopen
+
+MIOPEN_DEFINE_OBJECT(miopenFrozenSolution, miopen::FrozenSolution);
+
+#endif // GUARD_MIOPEN_FROZEN_SOLUTION_HPP_
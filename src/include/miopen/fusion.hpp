@@ -32,6 +32,7 @@
 #include <miopen/convolution.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/op_kernel_args.hpp>
+#include <miopen/pooling.hpp>
 #include <miopen/fusion_ops.hpp>
 
 #include <set>
@@ -56,6 +57,9 @@ struct OperatorArgs : miopenOperatorArgs
     friend std::ostream& operator<<(std::ostream& stream, const OperatorArgs& x);
     std::vector<OpKernelArg> args_vec;
     std::unordered_map<std::string, OpKernelArg> args_map;
+    /// Unique across the process and renewed by every ins_arg(), so the plans which keep the
+    /// packed arguments of their last execution know whether these arguments changed since.
+    std::size_t generation;
 };
 
 struct FusionOpDescriptor : miopenFusionOpDescriptor
@@ -80,6 +84,9 @@ struct FusionOpDescriptor : miopenFusionOpDescriptor
     virtual bool GetOpAttr(const std::string& /*sym*/, int& /*val*/) const { return false; };
     virtual std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name);
     virtual std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name);
+    /// Whether the op is elementwise on the output of the previous one, so that the fusion
+    /// patterns may apply it in a generated epilogue pass.
+    virtual bool IsEpilogue() const { return false; }
     void SetInputDesc(TensorDescriptor i_desc) { input_desc = i_desc; };
     TensorDescriptor input_desc;
 
@@ -103,11 +110,70 @@ struct BiasFusionOpDescriptor : FusionOpDescriptor
     std::string GetArgKey(const std::string& k) const override;
     OpKernelArg GetOpAttr(const std::string& k) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpBiasForward; };
+    bool IsEpilogue() const override { return true; }
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
     TensorDescriptor base_desc;
 };
 
+/// The gradient of a bias which was added to the input of the previous backward ops, i.e. the
+/// sum of their output over all dimensions but the channels. The output is the input.
+struct BiasBwdFusionOpDescriptor : FusionOpDescriptor
+{
+    BiasBwdFusionOpDescriptor(const TensorDescriptor& desc) : base_desc(desc){};
+    miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
+    miopenStatus_t SetArgs(OperatorArgs& args, const void* alpha, const void* beta, Data_t dbias);
+    std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const override;
+    std::string GetArgKey(const std::string& k) const override;
+    OpKernelArg GetOpAttr(const std::string& k) const override;
+    miopenFusionOp_t kind() const override { return miopenFusionOpBiasBackward; };
+    TensorDescriptor base_desc;
+};
+
+/// y = op(alpha1 * x, alpha2 * b), where b broadcasts along its dimensions of length 1.
+struct TensorFwdFusionOpDescriptor : FusionOpDescriptor
+{
+    TensorFwdFusionOpDescriptor(miopenTensorOp_t op, const TensorDescriptor& desc)
+        : tensor_op(op), base_desc(desc){};
+    miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
+    miopenStatus_t
+    SetArgs(OperatorArgs& args, const void* alpha1, const void* alpha2, ConstData_t b);
+    std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const override;
+    std::string GetArgKey(const std::string& k) const override;
+    OpKernelArg GetOpAttr(const std::string& k) const override;
+    miopenFusionOp_t kind() const override { return miopenFusionOpTensorForward; };
+    bool IsEpilogue() const override { return true; }
+    miopenTensorOp_t tensor_op;
+    TensorDescriptor base_desc;
+};
+
+/// y = alpha * x.
+struct ScaleFwdFusionOpDescriptor : FusionOpDescriptor
+{
+    miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
+    miopenStatus_t SetArgs(OperatorArgs& args, const void* alpha);
+    std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const override;
+    std::string GetArgKey(const std::string& k) const override;
+    OpKernelArg GetOpAttr(const std::string& k) const override;
+    miopenFusionOp_t kind() const override { return miopenFusionOpScaleForward; };
+    bool IsEpilogue() const override { return true; }
+};
+
+/// Forward pooling of the output of the previous op. With a workspace, max pooling also saves
+/// the indices for the backward pass.
+struct PoolingFwdFusionOpDescriptor : FusionOpDescriptor
+{
+    PoolingFwdFusionOpDescriptor(const PoolingDescriptor& desc) : base_desc(desc){};
+    miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
+    miopenStatus_t
+    SetArgs(OperatorArgs& args, const void* alpha, const void* beta, Data_t workSpace);
+    std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const override;
+    std::string GetArgKey(const std::string& k) const override;
+    OpKernelArg GetOpAttr(const std::string& k) const override;
+    miopenFusionOp_t kind() const override { return miopenFusionOpPoolingForward; };
+    PoolingDescriptor base_desc;
+};
+
 struct ActivFwdFusionOpDescriptor : FusionOpDescriptor
 {
     ActivFwdFusionOpDescriptor(miopenActivationMode_t mode) : activMode(mode){};
@@ -128,6 +194,7 @@ struct ActivFwdFusionOpDescriptor : FusionOpDescriptor
     bool GetOpAttr(const std::string& sym, int& val) const override;
     OpKernelArg GetOpAttr(const std::string& k) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpActivForward; };
+    bool IsEpilogue() const override { return true; }
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
     miopenActivationMode_t activMode;
@@ -183,6 +250,7 @@ struct BatchNormInferenceFusionOpDescriptor : FusionOpDescriptor
     OpKernelArg GetOpAttr(const std::string& k) const override;
     bool GetOpAttr(const std::string& sym, int& val) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpBatchNormInference; };
+    bool IsEpilogue() const override { return true; }
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
 
@@ -300,6 +368,8 @@ struct ConvForwardOpDescriptor : FusionOpDescriptor
     solver::KernelInfo kernel_info;
     bool kernel_info_valid;
     std::string conv_compiler_options;
+    /// The solvers search their performance configs, set by the find of the plan.
+    bool tune = false;
 
     private:
     mlo_construct_direct2D_fusion ConstructParams(Handle& handle);
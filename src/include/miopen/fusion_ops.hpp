@@ -44,6 +44,10 @@ enum miopenFusionOp_t
     miopenFusionOpBatchNormFwdTrain  = 4,
     miopenFusionOpBatchNormBwdTrain  = 5,
     miopenFusionOpActivBackward      = 6,
+    miopenFusionOpTensorForward      = 7,
+    miopenFusionOpScaleForward       = 8,
+    miopenFusionOpPoolingForward     = 9,
+    miopenFusionOpBiasBackward       = 10,
 };
 
 enum MDGraph_op_t
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_MLOPEN_FUSION_PATTERNS_HPP
+#define MIOPEN_GUARD_MLOPEN_FUSION_PATTERNS_HPP
+
+#include <miopen/fusion.hpp>
+#include <miopen/tensor.hpp>
+
+#include <boost/optional.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// The ops of a fusion plan, as the patterns see them.
+struct FusionPatternProblem
+{
+    const TensorDescriptor& input_desc;
+    const TensorDescriptor& output_desc;
+    const std::vector<std::shared_ptr<FusionOpDescriptor>>& ops;
+    boost::optional<miopenConvFwdAlgorithm_t> conv_algo;
+    /// The parameters of the ops may be folded into the weights, see
+    /// FusionPlanDescriptor::SetConstantFolding.
+    bool constant_folding;
+};
+
+/// Runs a compiled plan on its input, output and the op arguments.
+using FusionPatternInvoker =
+    std::function<void(const Handle&, ConstData_t, Data_t, const OperatorArgs&)>;
+
+/// Compiles the fusion plans whose ops match a pattern, instead of a path of the metadata
+/// graph. The patterns combine the kernels of the ops, e.g. the best convolution solution
+/// followed by a generated epilogue pass, so new op chains need no new graph vertices.
+struct FusionPattern
+{
+    virtual ~FusionPattern() = default;
+
+    virtual std::string Name() const = 0;
+    virtual bool IsApplicable(const FusionPatternProblem& problem) const = 0;
+    /// Whether the pattern is faster than the kernels of the graph for the plans which both
+    /// support, e.g. as it removes ops, so that the plans compile with it first.
+    virtual bool IsPreferredOverGraph() const { return false; }
+    /// Nothing when the plan cannot be compiled on this handle, e.g. when no kernel fits.
+    virtual boost::optional<FusionPatternInvoker>
+    Compile(Handle& handle, const FusionPatternProblem& problem) const = 0;
+};
+
+/// The first pattern applicable to the problem, or nullptr.
+const FusionPattern* FindFusionPattern(const FusionPatternProblem& problem);
+
+} // namespace miopen
+
+#endif
@@ -5,7 +5,11 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <miopen/fusion.hpp>
+#include <miopen/fusion_patterns.hpp>
 #include <miopen/md_graph.hpp>
+#include <miopen/op_kernel_args.hpp>
+
+#include <boost/optional.hpp>
 
 namespace miopen {
 
@@ -57,6 +61,9 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     miopenStatus_t
     GetConvAlgos(int reqAlgoCount, int& retAlgoCount, miopenConvFwdAlgorithm_t* ptrAlgos);
     miopenStatus_t SetConvAlgo(miopenConvFwdAlgorithm_t algo);
+    /// Lets the plan treat the parameters of its ops as constants, e.g. to fold an inference
+    /// batch normalization into the weights of the convolution.
+    miopenStatus_t SetConstantFolding(bool enable);
 
     miopenStatus_t GetOp(int op_idx, std::shared_ptr<FusionOpDescriptor>& desc);
 
@@ -73,6 +80,23 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     OpKernelArg GetTensorAttr(const std::string& sym) const;
     bool GetTensorAttr(const std::string& sym, int& val) const;
 
+    miopenStatus_t CompileMDGraph(Handle& handle);
+    miopenStatus_t ExecuteMDGraph(const Handle& handle,
+                                  ConstData_t input,
+                                  Data_t output,
+                                  const OperatorArgs& op_args);
+    FusionPatternProblem GetPatternProblem() const;
+    /// Sets network_config and returns it with the device and the ops appended, which
+    /// identifies the compiled plan.
+    std::string GetSignature(Handle& handle);
+    /// Measures the fused kernels of the graph against the pattern on the arguments of the
+    /// first Execute() after a Compile() in find mode, keeps the faster and stores it in the
+    /// find-db for the later compilations of the plan.
+    void FindPlan(const Handle& handle,
+                  ConstData_t input,
+                  Data_t output,
+                  const OperatorArgs& op_args);
+
     private:
     miopenFusionDirection_t fusion_dir;
     TensorDescriptor input_desc;
@@ -90,6 +114,21 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     std::string network_config;
     miopenDataType_t data_type;
     std::vector<Exec_arg_t> arg_list;
+    // Kernel arguments of the last Execute(), only the values of arg_list entries
+    // which come from the call are updated on the next one.
+    PackedKernelArgs packed_args;
+    // OperatorArgs::generation of the arguments packed_args were set from.
+    std::size_t packed_generation = 0;
+    // The plan is a path of the metadata graph, or it matches a pattern, or both.
+    bool graph_valid              = false;
+    const FusionPattern* pattern = nullptr;
+    FusionPatternInvoker pattern_invoker;
+    boost::optional<miopenConvFwdAlgorithm_t> conv_algo;
+    bool constant_folding = false;
+    // The pattern compiled along with the graph for FindPlan(), and where its result goes.
+    boost::optional<FusionPatternInvoker> find_pattern_invoker;
+    std::string find_key;
+    std::string find_db_path;
 };
 
 } // namespace miopen
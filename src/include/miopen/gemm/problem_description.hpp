@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/gemm_v2.hpp>
+#include <miopen/serializable.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <functional>
+#include <string>
+
+namespace miopen {
+
+namespace gemm {
+
+/// A GEMM as it is passed to rocBLAS, i.e. column-major. The single GEMMs do not depend on the
+/// batch fields of the descriptor, which are cleared.
+struct ProblemDescription
+#if MIOPEN_ENABLE_SQLITE
+    : SQLiteSerializable<ProblemDescription>
+#endif
+{
+    ProblemDescription(const GemmDescriptor& desc_, bool strided_batched_);
+
+    const GemmDescriptor& GetGemmDesc() const { return desc; }
+    bool IsStridedBatched() const { return strided_batched; }
+    bool IsBetaZero() const;
+
+    /// The perf-db key, e.g. nt-256x3136x1152-256x3136x256-b1-0x0x0-FP32-beta0
+    void Serialize(std::ostream& stream) const;
+
+    static std::string table_name() { return "gemm_config"; }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(int, std::string)> f)
+    {
+        f(static_cast<int>(self.desc.transA), "trans_a");
+        f(static_cast<int>(self.desc.transB), "trans_b");
+        f(self.desc.m, "m");
+        f(self.desc.n, "n");
+        f(self.desc.k, "k");
+        f(self.desc.lda, "lda");
+        f(self.desc.ldb, "ldb");
+        f(self.desc.ldc, "ldc");
+        f(self.desc.batch_count, "batch_count");
+        f(static_cast<int>(self.IsBetaZero()), "beta_zero");
+    }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(std::string, std::string)> f)
+    {
+        f(self.GetStridesName(), "strides");
+        f(GetDataTypeName(self.desc.dataType), "data_type");
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
+    {
+        obj.Serialize(os);
+        return os;
+    }
+
+    private:
+    std::string GetStridesName() const;
+
+    GemmDescriptor desc;
+    bool strided_batched;
+};
+
+/// The rocBLAS solution selected for a GEMM, 0 being the default one of rocBLAS. The indices
+/// are only valid for the version of rocBLAS that returned them.
+struct PerformanceConfigGemm : solver::Serializable<PerformanceConfigGemm>
+{
+    int solution_index  = 0;
+    int rocblas_version = 0;
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.solution_index, "solution_index");
+        f(self.rocblas_version, "rocblas_version");
+    }
+};
+
+/// The backend selected for a GEMM by FindGemmBackend(), as a GemmBackend_t.
+struct GemmBackendConfig : solver::Serializable<GemmBackendConfig>
+{
+    int backend = 0;
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.backend, "backend");
+    }
+};
+
+} // namespace gemm
+
+} // namespace miopen
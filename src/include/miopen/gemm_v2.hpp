@@ -29,6 +29,8 @@
 #include <miopen/common.hpp>
 #include <miopen/miopen.h>
 
+#include <vector>
+
 namespace miopen {
 
 struct Handle;
@@ -41,6 +43,7 @@ enum GemmBackend_t
     rocblas       = 1,
     miopengemm    = 2,
     miopentensile = 3,
+    hipblaslt     = 4,
 };
 
 enum CallGemmType_t
@@ -78,6 +81,24 @@ struct GemmDescriptor
     friend std::ostream& operator<<(std::ostream& stream, const GemmDescriptor& gemm_desc);
 };
 
+/// The activation applied by the GEMMs with an epilogue, see CallGemmEpilogue().
+enum class GemmActivation
+{
+    None,
+    Relu,
+    Gelu,
+};
+
+/// The elementwise ops fused into a GEMM: C = activation(op(A) * op(B) + beta * C + bias).
+/// The bias has one value per column of a row-major C, i.e. per row of a column-major one. With
+/// aux the GELU also stores its input into a C-shaped buffer, for the backward pass.
+struct GemmEpilogue
+{
+    GemmActivation activation = GemmActivation::None;
+    bool bias                 = false;
+    bool aux                  = false;
+};
+
 miopenStatus_t CallGemmTimeMeasure(const Handle& handle,
                                    GemmDescriptor gemm_desc,
                                    ConstData_t A,
@@ -125,6 +146,60 @@ CallGemmStridedBatchedSequential(const Handle& handle,
                                  FindDbKCacheKey* kcache_key, // for find-db
                                  GemmBackend_t gemm_backend = GemmBackend_t::miopentensile);
 
+/// One of the GEMMs of CallGemmGrouped(), its batch_count is 1.
+struct GemmProblem
+{
+    GemmDescriptor desc;
+    ConstData_t A;
+    int a_offset;
+    ConstData_t B;
+    int b_offset;
+    Data_t C;
+    int c_offset;
+};
+
+/// Runs independent GEMMs, i.e. no C overlaps the operands of another GEMM, in as few launches
+/// as possible. The GEMMs of the same shape on the same buffers, whose offsets advance by the same
+/// strides, run as a single strided batched GEMM, e.g. the per-direction GEMMs of an RNN or the
+/// heads of a multi-head attention. The others run one by one.
+miopenStatus_t CallGemmGrouped(const Handle& handle,
+                               const std::vector<GemmProblem>& problems,
+                               GemmBackend_t gemm_backend = GemmBackend_t::miopentensile);
+
+/// The backends this build runs GEMMs of the data type on, the default one first.
+std::vector<GemmBackend_t> GetGemmBackends(miopenDataType_t data_type);
+
+/// The backend stored in the perf-db for the GEMM by FindGemmBackend(), or the default one of
+/// GetGemmBackends(). The GEMM is strided batched if batch_count > 1.
+GemmBackend_t GetGemmBackend(const Handle& handle, const GemmDescriptor& gemm_desc);
+
+/// Times the GEMM on every backend of GetGemmBackends(), into a temporary C, and stores the
+/// fastest one in the perf-db. Returns nogemmbackend if none runs it, otherwise its time in ms.
+GemmBackend_t FindGemmBackend(const Handle& handle,
+                              const GemmDescriptor& gemm_desc,
+                              ConstData_t A,
+                              ConstData_t B,
+                              float& time);
+
+/// Whether CallGemmEpilogue() supports the GEMM, which needs hipBLASLt.
+bool IsGemmEpilogueSupported(const Handle& handle,
+                             const GemmDescriptor& gemm_desc,
+                             const GemmEpilogue& epilogue);
+
+/// A GEMM, strided batched if batch_count > 1, with the elementwise ops applied before C is
+/// stored, instead of in separate passes over C.
+miopenStatus_t CallGemmEpilogue(const Handle& handle,
+                                GemmDescriptor gemm_desc,
+                                ConstData_t A,
+                                int a_offset,
+                                ConstData_t B,
+                                int b_offset,
+                                Data_t C,
+                                int c_offset,
+                                const GemmEpilogue& epilogue,
+                                ConstData_t bias = nullptr,
+                                Data_t aux       = nullptr);
+
 // GEMM parameters for Convolution (using Im2Col) Fwd
 // y = w * Im2Col(x)
 GemmDescriptor CreateGemmDescriptorConvFwd(const TensorDescriptor& wDesc,
@@ -33,23 +33,74 @@
 #include <miopen/invoke_params.hpp>
 #include <miopen/env.hpp>
 
+#include <algorithm>
 #include <vector>
 #include <cstdlib>
 #include <limits>
 #include <iterator>
 #include <chrono>
 #include <cassert>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 #include <miopen/conv/context.hpp>
 #include <miopen/conv_solution.hpp>
+#include <miopen/find_timing.hpp>
+#include <miopen/kernel_info.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/rank.hpp>
+
+#include <boost/optional.hpp>
 
 namespace miopen {
 namespace solver {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_MULTI_GPU)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SEARCH_HALVING)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_TIME_BUDGET_MS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_COMPILE_AHEAD)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_TOP_K)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COST_MODEL_DEFAULTS)
+
+/// Deadline of the searches started by the calling thread, for the duration of a Find 2.0
+/// call with a time budget. Searches stop taking new candidates once it passes.
+class SearchDeadline
+{
+    public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Sets the deadline unless \p budget_ms is zero. The previous one is restored on exit.
+    SearchDeadline(const float budget_ms) : previous(Current())
+    {
+        if(budget_ms > 0.0f)
+            Current() = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                           std::chrono::duration<float, std::milli>{budget_ms});
+    }
+    SearchDeadline(const SearchDeadline&) = delete;
+    SearchDeadline& operator=(const SearchDeadline&) = delete;
+    ~SearchDeadline() { Current() = previous; }
+
+    static boost::optional<Clock::time_point> Get() { return Current(); }
+
+    private:
+    static boost::optional<Clock::time_point>& Current()
+    {
+        static thread_local boost::optional<Clock::time_point> deadline;
+        return deadline;
+    }
+
+    boost::optional<Clock::time_point> previous;
+};
 
 /// This STL-like container together with corresponding iterator provide access
 /// to a set of all available performance configs for the given problem config.
@@ -78,9 +129,11 @@ template <typename PerformanceConfig, typename Context>
 class ComputedIterator : public std::iterator<std::input_iterator_tag, PerformanceConfig>
 {
     PerformanceConfig v;
-    const Context* p; // For Next().
+    const Context* p;                   // For Next().
+    const std::vector<bool>* selection; // Valid values to visit, all if null.
+    std::size_t n_valid;                // Index of v among the valid values.
 
-    ComputedIterator& Next()
+    void NextValid()
     {
         if(p != nullptr)
         {
@@ -93,19 +146,49 @@ class ComputedIterator : public std::iterator<std::input_iterator_tag, Performan
                 }
             } while(!v.IsValid(*p));
         }
+    }
+
+    void SkipUnselected()
+    {
+        if(selection == nullptr)
+            return;
+        while(p != nullptr && !(*selection)[n_valid])
+        {
+            if(++n_valid >= selection->size())
+            {
+                p = nullptr;
+                break;
+            }
+            NextValid();
+        }
+    }
+
+    ComputedIterator& Next()
+    {
+        NextValid();
+        ++n_valid;
+        if(selection != nullptr && n_valid >= selection->size())
+            p = nullptr;
+        SkipUnselected();
         return *this;
     }
 
     // Implements container's begin()
-    ComputedIterator(const Context& problem, const bool spare) : v(spare), p(&problem)
+    ComputedIterator(const Context& problem,
+                     const bool spare,
+                     const std::vector<bool>* selection_)
+        : v(spare), p(&problem), selection(selection_), n_valid(0)
     {
         if(!v.IsValid(*p))
-            Next();
+            NextValid();
+        if(selection != nullptr && selection->empty())
+            p = nullptr;
+        SkipUnselected();
     }
 
     public:
     // STL-like iterator shall be default contructible. Also implements container's end()
-    ComputedIterator() : v(), p(nullptr) {}
+    ComputedIterator() : v(), p(nullptr), selection(nullptr), n_valid(0) {}
     // STL-like iterator shall be copy contructible. The default copy ctor is ok.
 
     ComputedIterator& operator++() { return Next(); }
@@ -137,6 +220,7 @@ class ComputedContainer
                      //
                      // Nevertheless, a Solver is free to either use or not use this capability
                      // (i.e. it is ok for PerformanceConfig(bool) to ignore its parameter).
+    std::shared_ptr<const std::vector<bool>> selection; // See Select().
 
     /// \note We do not add 'const' to keep the object assignable
     /// for the sake of flexibility. Nevertheless, all element accesses of
@@ -149,8 +233,18 @@ class ComputedContainer
         : problem(problem_), spare(spare_)
     {
     }
-    const_iterator begin() const { return {problem, spare}; }
+    const_iterator begin() const { return {problem, spare, selection.get()}; }
     const_iterator end() const { return {}; }
+
+    /// Returns the container of the values for which selection_[i] is set, where i is
+    /// the position of the value in this container, which shall not be selected already.
+    ComputedContainer Select(std::vector<bool> selection_) const
+    {
+        assert(selection == nullptr);
+        auto selected      = *this;
+        selected.selection = std::make_shared<const std::vector<bool>>(std::move(selection_));
+        return selected;
+    }
 };
 
 template <typename PerformanceConfig>
@@ -298,6 +392,499 @@ using RunAndMeasure_t =
                                                           std::declval<ConvSolution>(),
                                                           std::declval<float&>()));
 
+/// Solvers may rank their performance configs with an analytic or learned cost model, by
+/// `float EstimateCost(const Context&, const PerformanceConfig&) const`, lower is better.
+/// With MIOPEN_SEARCH_TOP_K set, only that many of the cheapest configs are searched.
+template <class Solver, class Context, class PerformanceConfig>
+auto SelectByCostModel(const Solver& s,
+                       const Context& context,
+                       const ComputedContainer<PerformanceConfig, Context>& configs,
+                       rank<1>)
+    -> decltype(s.EstimateCost(context, std::declval<const PerformanceConfig&>()), configs)
+{
+    const auto top_k = Value(MIOPEN_SEARCH_TOP_K{}, 0);
+    if(top_k == 0)
+        return configs;
+
+    // Ties go to the lower index, so the order of the configs is kept.
+    auto costs = std::vector<std::pair<float, std::size_t>>{};
+    for(const auto& config : configs)
+        costs.emplace_back(s.EstimateCost(context, config), costs.size());
+    if(costs.size() <= top_k)
+        return configs;
+
+    std::nth_element(costs.begin(), costs.begin() + top_k, costs.end());
+    auto selection = std::vector<bool>(costs.size(), false);
+    for(auto i = std::size_t{0}; i < top_k; ++i)
+        selection[costs[i].second] = true;
+    MIOPEN_LOG_I2("Cost model keeps " << top_k << " of " << costs.size() << " configs");
+    return configs.Select(std::move(selection));
+}
+
+template <class Solver, class Context, class PerformanceConfig>
+ComputedContainer<PerformanceConfig, Context>
+SelectByCostModel(const Solver&,
+                  const Context&,
+                  const ComputedContainer<PerformanceConfig, Context>& configs,
+                  rank<0>)
+{
+    return configs;
+}
+
+/// Returns the cheapest config by the cost model of the solver, if enabled by
+/// MIOPEN_DEBUG_COST_MODEL_DEFAULTS. Meant for GetPerformanceConfig() of the solvers,
+/// which is used when there is no record in the perf-db.
+template <class Solver, class Context>
+auto GetCostModelConfig(const Solver& s, const Context& context)
+    -> boost::optional<decltype(s.GetPerformanceConfig(context))>
+{
+    using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
+    if(!IsEnabled(MIOPEN_DEBUG_COST_MODEL_DEFAULTS{}))
+        return boost::none;
+
+    auto best      = boost::optional<PerformanceConfig>{};
+    auto best_cost = std::numeric_limits<float>::max();
+    // Configs of the spare set are only considered if there are no others.
+    for(const auto spare : {false, true})
+    {
+        for(const auto& config : ComputedContainer<PerformanceConfig, Context>(context, spare))
+        {
+            const auto cost = s.EstimateCost(context, config);
+            if(!best || cost < best_cost)
+            {
+                best      = config;
+                best_cost = cost;
+            }
+        }
+        if(best)
+            break;
+    }
+    if(best)
+        MIOPEN_LOG_I2("Cost model default: " << *best << ", cost " << best_cost);
+    return best;
+}
+
+struct SearchMeasurement
+{
+    int ret       = 0;
+    bool averaged = false;
+    float time    = 0.0f;
+    Invoker invoker;
+};
+
+/// Builds the invoker of a candidate on the handle of the context.
+/// \return 0 on success, the failure code otherwise.
+template <class Solver, class Context, class PerformanceConfig>
+int PrepareSearchCandidate(const Solver& s,
+                           const Context& context,
+                           const ConvSolution& default_solution,
+                           const PerformanceConfig& current_config,
+                           const size_t n_current,
+                           const int n_runs_total,
+                           Invoker& invoker)
+{
+    try
+    {
+        const auto current_solution = s.GetSolution(context, current_config, true);
+        if(default_solution.workspce_sz != current_solution.workspce_sz)
+        {
+            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                             << "Workspace size should not depend on PerformanceConfig: "
+                             << default_solution.workspce_sz
+                             << " != " << current_solution.workspce_sz);
+            return -2;
+        }
+
+        invoker = context.GetStream().PrepareInvoker(*current_solution.invoker_factory,
+                                                     current_solution.construction_params);
+        return 0;
+    }
+    catch(...)
+    {
+        return 1;
+    }
+}
+
+/// Runs the invoker up to \p runs times and sets the total time into \p time. Stops early
+/// once a single run exceeds \p abort_time, the number of the runs done is returned then.
+/// \return Number of the runs done, 0 on failure.
+inline int RunSearchCandidate(const Handle& profile_h,
+                              const Invoker& invoker,
+                              const AnyInvokeParams& invoke_ctx,
+                              const int runs,
+                              const float abort_time,
+                              float& time)
+{
+    time = 0.0f;
+    try
+    {
+        for(int i = 0; i < runs; ++i)
+        {
+            invoker(profile_h, invoke_ctx);
+            const auto elapsed = profile_h.GetKernelTime();
+            time += elapsed;
+            if(elapsed > abort_time)
+                return i + 1;
+        }
+        return runs;
+    }
+    catch(...)
+    {
+        return 0;
+    }
+}
+
+/// Measures a candidate on the handle of the context. Smooths the jitter of measurements:
+/// if the 1st probe is NOT too bad (measured time <= 1.05 * best known time), then re-runs
+/// it 4 times more and returns the average of all 5 attempts. With MIOPEN_FIND_STABILIZE,
+/// the 4 runs are interleaved with the runs of the \p best invoker instead, and the average
+/// of them is scaled by the ratio of \p best_time to the average of the best ones, so that
+/// the two are compared under the same clocks.
+template <class Solver, class Context, class PerformanceConfig>
+SearchMeasurement MeasureSearchCandidate(const Solver& s,
+                                         const Context& context,
+                                         const AnyInvokeParams& invoke_ctx,
+                                         const ConvSolution& default_solution,
+                                         const PerformanceConfig& current_config,
+                                         const size_t n_current,
+                                         const int n_runs_total,
+                                         const float best_time,
+                                         const Invoker* best = nullptr)
+{
+    auto& profile_h = context.GetStream();
+    auto m          = SearchMeasurement{};
+    MIOPEN_LOG_I2('#' << n_current << '/' << n_runs_total << ' ' << current_config);
+
+    Invoker invoker;
+    m.ret = PrepareSearchCandidate(
+        s, context, default_solution, current_config, n_current, n_runs_total, invoker);
+    if(m.ret == 0 && RunSearchCandidate(profile_h,
+                                        invoker,
+                                        invoke_ctx,
+                                        1,
+                                        std::numeric_limits<float>::max(),
+                                        m.time) != 1)
+        m.ret = 1;
+
+    MIOPEN_LOG_T("##"
+                 << "(n_current, n_runs_total):  " << n_current << '/' << n_runs_total
+                 << " elapsed_time: " << m.time << ", best_time: " << best_time << ", "
+                 << current_config);
+
+    if(m.ret == 0 && m.time / best_time < 1.05f)
+    {
+        MIOPEN_LOG_I2("Finding average for: " << m.time << " / " << best_time << " = "
+                                              << (m.time / best_time));
+
+        constexpr auto no_abort = std::numeric_limits<float>::max();
+        auto more               = 0.0f;
+        if(best != nullptr && GetFindTimingConfig().stabilize)
+        {
+            auto reference = 0.0f;
+            auto done      = 0;
+            for(; done < 4; ++done)
+            {
+                auto time = 0.0f;
+                if(RunSearchCandidate(profile_h, invoker, invoke_ctx, 1, no_abort, time) != 1)
+                    break;
+                more += time;
+                if(RunSearchCandidate(profile_h, *best, invoke_ctx, 1, no_abort, time) != 1)
+                    break;
+                reference += time;
+            }
+
+            if(done == 4 && reference > 0.0f)
+            {
+                m.averaged = true;
+                m.time     = more * best_time / reference;
+            }
+            else
+            {
+                m.ret = 1;
+            }
+        }
+        else if(RunSearchCandidate(profile_h, invoker, invoke_ctx, 4, no_abort, more) == 4)
+        {
+            m.averaged = true;
+            m.time     = (m.time + more) / 5;
+        }
+        else
+        {
+            m.ret = 1;
+        }
+    }
+    m.invoker = std::move(invoker);
+    return m;
+}
+
+/// Successive halving, enabled by MIOPEN_DEBUG_SEARCH_HALVING: every candidate is probed
+/// once, then the fastest quarter of them is re-measured in rounds, with twice the runs
+/// per round and the faster half kept, until one is left. A run which is more than twice
+/// slower than the best average of the round aborts the candidate. The total number of
+/// runs is about the same as probing each candidate once, instead of averaging each one
+/// which is close to the best.
+template <class Solver, class Context, class PerformanceConfig>
+void SuccessiveHalvingSearch(const Solver& s,
+                             const Context& context,
+                             const AnyInvokeParams& invoke_ctx,
+                             const ConvSolution& default_solution,
+                             const ComputedContainer<PerformanceConfig, Context>& all_configs,
+                             const int n_runs_total,
+                             const std::function<bool()>& is_over_budget,
+                             HeartBeat<PerformanceConfig>& heartbeat,
+                             PerformanceConfig& best_config,
+                             float& best_time,
+                             size_t& n_best,
+                             size_t& n_failed,
+                             bool& is_passed)
+{
+    struct Candidate
+    {
+        size_t index;
+        PerformanceConfig config;
+        float time;
+    };
+
+    const auto& profile_h = context.GetStream();
+    const auto by_time    = [](const Candidate& l, const Candidate& r) {
+        return l.time < r.time || (l.time == r.time && l.index < r.index);
+    };
+
+    // Only the fastest probes are kept, as the configs themselves take too much memory.
+    const auto n_kept = std::max<size_t>(1, static_cast<size_t>(n_runs_total) / 4);
+    auto candidates   = std::vector<Candidate>{};
+    auto probe_best   = best_time;
+    size_t n_current  = 0;
+
+    for(const auto& current_config : all_configs)
+    {
+        if(is_over_budget())
+            break;
+
+        Invoker invoker;
+        auto time = 0.0f;
+        auto ret  = PrepareSearchCandidate(
+            s, context, default_solution, current_config, n_current, n_runs_total, invoker);
+        if(ret == 0 && RunSearchCandidate(profile_h,
+                                          invoker,
+                                          invoke_ctx,
+                                          1,
+                                          std::numeric_limits<float>::max(),
+                                          time) != 1)
+            ret = 1;
+
+        if(ret == 0)
+        {
+            probe_best = std::min(probe_best, time);
+            candidates.push_back({n_current, current_config, time});
+            std::push_heap(candidates.begin(), candidates.end(), by_time);
+            if(candidates.size() > n_kept)
+            {
+                std::pop_heap(candidates.begin(), candidates.end(), by_time);
+                candidates.pop_back();
+            }
+        }
+        else
+        {
+            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                             << " Failed rc=" << ret);
+            ++n_failed;
+        }
+
+        heartbeat.Monitor(ret != 0,
+                          time,
+                          n_current,
+                          probe_best,
+                          n_failed,
+                          n_runs_total,
+                          current_config);
+        ++n_current;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), by_time);
+
+    for(auto runs = 2; candidates.size() > 1; runs *= 2)
+    {
+        if(is_over_budget())
+        {
+            candidates.resize(1);
+            break;
+        }
+
+        auto round_best = std::numeric_limits<float>::max();
+        for(auto& candidate : candidates)
+        {
+            Invoker invoker;
+            auto ret = PrepareSearchCandidate(s,
+                                              context,
+                                              default_solution,
+                                              candidate.config,
+                                              candidate.index,
+                                              n_runs_total,
+                                              invoker);
+            auto total = 0.0f;
+            const auto done =
+                ret == 0 ? RunSearchCandidate(
+                               profile_h, invoker, invoke_ctx, runs, 2 * round_best, total)
+                         : 0;
+
+            if(done == runs)
+            {
+                candidate.time = total / runs;
+                round_best     = std::min(round_best, candidate.time);
+            }
+            else
+            {
+                // Aborted or failed ones go to the end.
+                candidate.time = std::numeric_limits<float>::max();
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), by_time);
+        candidates.resize((candidates.size() + 1) / 2);
+        MIOPEN_LOG_W("Halving by " << runs << " runs: " << candidates.size() << " left, best #"
+                                   << candidates.front().index << ' ' << candidates.front().time);
+    }
+
+    if(candidates.empty() || candidates.front().time == std::numeric_limits<float>::max())
+        return;
+
+    is_passed   = true;
+    best_config = candidates.front().config;
+    best_time   = candidates.front().time;
+    n_best      = candidates.front().index;
+}
+
+/// Builds the kernels of the candidates in the background, ahead of their measurement,
+/// so the compilation overlaps with the benchmarking. Up to \p ahead candidates are built
+/// or measured at a time. Programs built here are unloaded as soon as their candidate is
+/// released, and so are the ones of the candidates which are left unmeasured.
+template <class Solver, class Context, class PerformanceConfig>
+class SearchCompilePipeline
+{
+    public:
+    SearchCompilePipeline(const Solver& s_,
+                          const Context& context_,
+                          const ComputedContainer<PerformanceConfig, Context>& configs,
+                          const std::size_t ahead_)
+        : s(s_),
+          context(context_),
+          next(configs.begin()),
+          end(configs.end()),
+          ahead(std::max<std::size_t>(ahead_, 1))
+    {
+    }
+
+    SearchCompilePipeline(const SearchCompilePipeline&) = delete;
+    SearchCompilePipeline& operator=(const SearchCompilePipeline&) = delete;
+
+    ~SearchCompilePipeline()
+    {
+        for(auto it = candidates.begin(); it != candidates.end();)
+        {
+            const auto current = it++;
+            if(current->second.measured)
+                continue;
+            for(const auto& pending : current->second.pending)
+                pending.wait();
+            Release(current->first);
+        }
+    }
+
+    /// Waits until the kernels of the candidate \p n are built. Candidates go in order.
+    void Wait(const std::size_t n)
+    {
+        while(n_submitted < n + ahead && next != end)
+            Submit();
+
+        const auto it = candidates.find(n);
+        if(it == candidates.end())
+            return;
+        // Failures to build are not reported here but by the measurement.
+        for(const auto& pending : it->second.pending)
+            pending.wait();
+        it->second.pending.clear();
+        it->second.measured = true;
+    }
+
+    /// Unloads the programs of the candidate \p n, unless other candidates use them.
+    void Release(const std::size_t n)
+    {
+        const auto it = candidates.find(n);
+        if(it == candidates.end())
+            return;
+        for(const auto& key : it->second.programs)
+        {
+            const auto use = uses.find(key);
+            if(--use->second > 0)
+                continue;
+            context.GetStream().RemoveProgram(key.first, key.second);
+            uses.erase(use);
+        }
+        candidates.erase(it);
+    }
+
+    private:
+    using Key = std::pair<std::string, std::string>;
+
+    struct Candidate
+    {
+        std::vector<Key> programs;
+        std::vector<std::shared_future<Program>> pending;
+        bool measured = false;
+    };
+
+    void Submit()
+    {
+        const auto& h   = context.GetStream();
+        auto& candidate = candidates[n_submitted++];
+        try
+        {
+            const auto solution = s.GetSolution(context, *next, true);
+            for(const auto& kernel : solution.construction_params)
+            {
+                const auto key = Key{kernel.kernel_file, kernel.comp_options};
+                const auto use = uses.find(key);
+                if(use != uses.end())
+                {
+                    ++use->second;
+                }
+                else
+                {
+                    // Programs which were loaded before the search are not ours to unload.
+                    if(h.HasProgram(kernel.kernel_file, kernel.comp_options))
+                        continue;
+                    uses.emplace(key, 1);
+                    const auto pending = PrecompileKernelsAsync(h, {kernel});
+                    candidate.pending.insert(
+                        candidate.pending.end(), pending.begin(), pending.end());
+                }
+                candidate.programs.push_back(key);
+            }
+        }
+        catch(...)
+        {
+            // The measurement reports the failure.
+        }
+        ++next;
+    }
+
+    const Solver& s;
+    const Context& context;
+    typename ComputedContainer<PerformanceConfig, Context>::const_iterator next;
+    typename ComputedContainer<PerformanceConfig, Context>::const_iterator end;
+    const std::size_t ahead;
+    std::size_t n_submitted = 0;
+    std::map<std::size_t, Candidate> candidates;
+    std::map<Key, int> uses;
+};
+
+/// MIOPEN_SEARCH_TIME_BUDGET_MS limits the wall-clock time of a search, after which the
+/// best of the candidates measured so far is used. So does the SearchDeadline, if any.
+///
+/// With MIOPEN_SEARCH_MULTI_GPU enabled, the candidates are spread across the peer devices
+/// of the handle (see Handle::GetPeers()), provided that the invoke params can be relocated
+/// to them. Otherwise they are measured one by one on the handle of the context.
 template <class Solver, class Context>
 auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParams& invoke_ctx_)
     -> decltype(s.GetPerformanceConfig(context_))
@@ -325,11 +912,11 @@ auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParam
     const ComputedContainer<PerformanceConfig, Context> main(context);
     const int main_size = std::distance(main.begin(), main.end());
     const ComputedContainer<PerformanceConfig, Context> spare(context, true);
-    const int spare_size = std::distance(spare.begin(), spare.end());
-    const bool useSpare  = (main_size == 0);
+    const bool useSpare = (main_size == 0);
 
-    const ComputedContainer<PerformanceConfig, Context> all_configs = useSpare ? spare : main;
-    const int n_runs_total = useSpare ? spare_size : main_size;
+    const ComputedContainer<PerformanceConfig, Context> all_configs =
+        SelectByCostModel(s, context, useSpare ? spare : main, rank<1>{});
+    const int n_runs_total = std::distance(all_configs.begin(), all_configs.end());
     MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
                                << (useSpare ? " (spare)" : "") << "...");
 
@@ -340,126 +927,260 @@ auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParam
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
+    Timer budget_timer;
+    budget_timer.start();
+    const auto budget_ms   = static_cast<float>(Value(MIOPEN_SEARCH_TIME_BUDGET_MS{}, 0));
+    // Taken here, as the deadline is not visible to the threads of the multi-GPU search.
+    const auto deadline    = SearchDeadline::Get();
+    auto budget_warned     = false;
+    const auto over_budget = [&]() {
+        if(!(deadline && SearchDeadline::Clock::now() >= *deadline) &&
+           (budget_ms <= 0.0f || budget_timer.elapsed_ms() < budget_ms))
+            return false;
+        if(!budget_warned)
+            MIOPEN_LOG_W(SolverDbId(s) << ": Search time budget is exceeded, stopping");
+        budget_warned = true;
+        return true;
+    };
+
+    // Builds all the candidates up front, where these are not pipelined with the measurement.
+    const auto precompile_all = [&]() {
 // PrecompileKernels call saves to binary_cache, this needs to be escaped if KERN_CACHE is not on.
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-    std::vector<KernelInfo> kernels;
-    for(const auto& current_config : all_configs)
-    {
-        ConvSolution current_solution = s.GetSolution(context, current_config, true);
-        for(auto&& kernel : current_solution.construction_params)
+        std::vector<KernelInfo> kernels;
+        for(const auto& current_config : all_configs)
         {
-            if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
-                continue;
-            kernels.push_back(kernel);
+            ConvSolution current_solution = s.GetSolution(context, current_config, true);
+            for(auto&& kernel : current_solution.construction_params)
+            {
+                if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
+                    continue;
+                kernels.push_back(kernel);
+            }
         }
-    }
-    std::ignore = PrecompileKernels(profile_h, kernels);
+        std::ignore = PrecompileKernels(profile_h, kernels);
 #endif
+    };
 
     if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
     {
-        size_t n_current = 0;
-        for(const auto& current_config : all_configs)
+        // Buffers of the problem on the peer devices, which are lost from the context.
+        auto peer_buffers = std::vector<Allocator::ManageDataPtr>{};
+        auto workers      = std::vector<std::pair<Context, AnyInvokeParams>>{};
+        if(IsEnabled(MIOPEN_SEARCH_MULTI_GPU{}))
         {
-            float elapsed_time = 0.0f;
-            int ret            = 0;
-            MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
-                              << current_config);
+            for(const auto peer : profile_h.GetPeers())
+            {
+                auto params = invoke_ctx.Relocate(*peer, peer_buffers);
+                if(!params)
+                {
+                    MIOPEN_LOG_W(SolverDbId(s) << ": Multi-GPU search is not supported");
+                    workers.clear();
+                    break;
+                }
+                auto worker_context = context;
+                worker_context.SetStream(peer);
+                workers.emplace_back(std::move(worker_context), std::move(params));
+            }
+        }
 
-            ConvSolution current_solution;
-            Invoker invoker;
+        // The clocks of the peers are left to the measurements as is.
+        if(workers.empty() && GetFindTimingConfig().stabilize)
+        {
+            const auto invoker = profile_h.PrepareInvoker(*default_solution.invoker_factory,
+                                                          default_solution.construction_params);
+            WarmUpUntilSettled(
+                [&]() {
+                    invoker(profile_h, invoke_ctx);
+                    return profile_h.GetKernelTime();
+                },
+                GetFindTimingConfig());
+        }
 
-            try
+        if(workers.empty() && IsEnabled(MIOPEN_DEBUG_SEARCH_HALVING{}))
+        {
+            precompile_all();
+            SuccessiveHalvingSearch(s,
+                                    context,
+                                    invoke_ctx,
+                                    default_solution,
+                                    all_configs,
+                                    n_runs_total,
+                                    over_budget,
+                                    heartbeat,
+                                    best_config,
+                                    best_time,
+                                    n_best,
+                                    n_failed,
+                                    is_passed);
+        }
+        else if(workers.empty())
+        {
+            SearchCompilePipeline<Solver, Context, PerformanceConfig> pipeline{
+                s, context, all_configs, Value(MIOPEN_SEARCH_COMPILE_AHEAD{}, 20)};
+            size_t n_current = 0;
+            Invoker best_invoker;
+            for(const auto& current_config : all_configs)
             {
-                current_solution = s.GetSolution(context, current_config, true);
-                if(default_solution.workspce_sz != current_solution.workspce_sz)
+                if(over_budget())
+                    break;
+
+                pipeline.Wait(n_current);
+                auto is_best        = false;
+                const auto has_best = best_time != std::numeric_limits<float>::max();
+
+                const auto m = MeasureSearchCandidate(s,
+                                                      context,
+                                                      invoke_ctx,
+                                                      default_solution,
+                                                      current_config,
+                                                      n_current,
+                                                      n_runs_total,
+                                                      best_time,
+                                                      has_best ? &best_invoker : nullptr);
+
+                if(m.ret == 0 && m.averaged)
                 {
-                    ret = -2;
-                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                     << "Workspace size should not depend on PerformanceConfig: "
-                                     << default_solution.workspce_sz
-                                     << " != " << current_solution.workspce_sz);
+                    is_passed = true;
+                    if(m.time < best_time)
+                    {
+                        MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
+                                         << ' ' << m.time << " < " << best_time << ' '
+                                         << current_config);
+                        if(has_best)
+                            pipeline.Release(n_best);
+                        is_best      = true;
+                        best_config  = current_config;
+                        best_time    = m.time;
+                        n_best       = n_current;
+                        best_invoker = m.invoker;
+                    }
+                    else
+                    {
+                        MIOPEN_LOG_I2("Average is not better: " << m.time << " >= " << best_time);
+                    }
                 }
+                if(!is_best)
+                    pipeline.Release(n_current);
 
-                invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
-                                                   current_solution.construction_params);
-                invoker(profile_h, invoke_ctx);
-                elapsed_time = profile_h.GetKernelTime();
-            }
-            catch(...)
-            {
-                ret = 1;
+                if(m.ret != 0)
+                {
+                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                                     << " Failed rc=" << m.ret);
+                    ++n_failed;
+                }
+                heartbeat.Monitor(m.ret != 0,
+                                  m.time,
+                                  n_current,
+                                  best_time,
+                                  n_failed,
+                                  n_runs_total,
+                                  current_config);
+                ++n_current;
             }
+        }
+        else
+        {
+            // The workers, one per device, take the candidates in order, so the faster ones
+            // take more of them. The best so far is shared, ties go to the lower index,
+            // which keeps the result independent of the timing of the workers.
+            precompile_all();
+            workers.emplace_back(context, invoke_ctx);
+            MIOPEN_LOG_W(SolverDbId(s) << ": Searching on " << workers.size() << " devices");
 
-            MIOPEN_LOG_T("##"
-                         << "(n_current, n_failed, n_runs_total):  " << n_current << '/' << n_failed
-                         << '/' << n_runs_total << " elapsed_time: " << elapsed_time
-                         << ", best_time: " << best_time << ", " << current_config);
+            std::mutex mutex;
+            std::atomic<std::size_t> next{0};
+            std::size_t n_done = 0;
+            auto errors        = std::vector<std::exception_ptr>(workers.size());
 
-            if(ret == 0)
-            {
-                // Smooth the jitter of measurements:
-                // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-                // then re-run it 4 times more and compute average time,
-                // and decide using average of all 5 attempts vs. the best.
-                if(elapsed_time / best_time < 1.05f)
+            const auto run = [&](std::size_t worker) {
+                try
                 {
-                    MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time
-                                                          << " = " << (elapsed_time / best_time));
+                    const auto& worker_context = workers[worker].first;
+                    const auto& worker_params  = workers[worker].second;
+                    AutoEnableProfiling enableWorkerProfiling{worker_context.GetStream()};
 
-                    try
+                    auto it  = all_configs.begin();
+                    auto pos = std::size_t{0};
+
+                    while(true)
                     {
-                        for(int i = 0; i < 4; ++i)
+                        const auto n_current = next++;
+                        if(n_current >= static_cast<std::size_t>(n_runs_total))
+                            break;
+                        for(; pos < n_current; ++pos)
+                            ++it;
+                        const auto& current_config = *it;
+
+                        auto known_best = 0.0f;
                         {
-                            invoker(profile_h, invoke_ctx);
-                            elapsed_time += profile_h.GetKernelTime();
+                            std::lock_guard<std::mutex> lock{mutex};
+                            if(over_budget())
+                                break;
+                            known_best = best_time;
                         }
-                    }
-                    catch(...)
-                    {
-                        ret = 1;
-                    }
 
-                    if(ret == 0)
-                    {
-                        is_passed = true;
-                        elapsed_time /= 5;
-                        if(elapsed_time < best_time)
+                        const auto m = MeasureSearchCandidate(s,
+                                                              worker_context,
+                                                              worker_params,
+                                                              default_solution,
+                                                              current_config,
+                                                              n_current,
+                                                              n_runs_total,
+                                                              known_best);
+
+                        std::lock_guard<std::mutex> lock{mutex};
+                        if(m.ret == 0 && m.averaged)
                         {
-                            MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                             << ' ' << elapsed_time << " < " << best_time << ' '
-                                             << current_config);
-                            best_config = current_config;
-                            best_time   = elapsed_time;
-                            n_best      = n_current;
+                            is_passed = true;
+                            if(m.time < best_time || (m.time == best_time && n_current < n_best))
+                            {
+                                MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/'
+                                                 << n_runs_total << ' ' << m.time << " < "
+                                                 << best_time << ' ' << current_config
+                                                 << ", device " << worker);
+                                best_config = current_config;
+                                best_time   = m.time;
+                                n_best      = n_current;
+                            }
                         }
-                        else
+
+                        if(m.ret != 0)
                         {
-                            MIOPEN_LOG_I2("Average is not better: " << elapsed_time
-                                                                    << " >= " << best_time);
+                            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                                             << " Failed rc=" << m.ret);
+                            ++n_failed;
                         }
+                        heartbeat.Monitor(m.ret != 0,
+                                          m.time,
+                                          n_done++,
+                                          best_time,
+                                          n_failed,
+                                          n_runs_total,
+                                          current_config);
                     }
                 }
-            }
+                catch(...)
+                {
+                    errors[worker] = std::current_exception();
+                }
+            };
 
-            if(ret != 0)
-            {
-                MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                 << " Failed rc=" << ret);
-                ++n_failed;
-            }
-            heartbeat.Monitor(ret != 0,
-                              elapsed_time,
-                              n_current,
-                              best_time,
-                              n_failed,
-                              n_runs_total,
-                              current_config);
-            ++n_current;
+            auto threads = std::vector<std::thread>{};
+            for(auto worker = std::size_t{1}; worker < workers.size(); ++worker)
+                threads.emplace_back(run, worker - 1);
+            run(workers.size() - 1);
+            for(auto& thread : threads)
+                thread.join();
+
+            for(const auto& error : errors)
+                if(error)
+                    std::rethrow_exception(error);
         }
     }
     else
     {
+        precompile_all();
         MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
                      "Running kernels on GPU is disabled. Search skipped");
     }
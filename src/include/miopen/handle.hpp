@@ -27,10 +27,15 @@
 #define GUARD_MIOPEN_CONTEXT_HPP_
 
 #include <miopen/config.h>
+#include <miopen/async_compiler.hpp>
+#include <miopen/check_numerics.hpp>
 #include <miopen/kernel_info.hpp>
 #include <miopen/common.hpp>
+#include <miopen/conv/problem_fingerprint.hpp>
 #include <miopen/invoker_cache.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/memory_usage.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
 #include <miopen/object.hpp>
@@ -42,6 +47,7 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <array>
 #include <cstdio>
 #include <cstring>
 #include <ios>
@@ -55,9 +61,17 @@
 #include <rocblas.h>
 #endif
 
+#if MIOPEN_USE_HIPBLASLT
+#include <miopen/manage_ptr.hpp>
+#include <hipblaslt/hipblaslt.h>
+#endif
+
 namespace miopen {
 
 struct HandleImpl;
+namespace conv {
+class FallbackModel;
+} // namespace conv
 #if MIOPEN_USE_MIOPENGEMM
 struct GemmGeometry;
 using GemmKey = std::pair<std::string, std::string>;
@@ -67,6 +81,16 @@ using GemmKey = std::pair<std::string, std::string>;
 using rocblas_handle_ptr = MIOPEN_MANAGE_PTR(rocblas_handle, rocblas_destroy_handle);
 #endif
 
+#if MIOPEN_USE_HIPBLASLT
+using hipblaslt_handle_ptr = MIOPEN_MANAGE_PTR(hipblasLtHandle_t, hipblasLtDestroy);
+#endif
+
+/// Many threads may issue work through one handle. The caches of kernels, invokers, problem keys,
+/// applicability and contexts are synchronized, the ones looked up by every call with
+/// reader-writer locks.
+/// Each thread selects its stream with SetStreamFromPool() and measures its own kernel time.
+/// SetStream(), SetAllocator(), EnableProfiling() and ReserveExtraStreamsInPool() configure the
+/// handle and shall not race with its other uses.
 struct Handle : miopenHandle
 {
     friend struct TargetProperties;
@@ -79,11 +103,39 @@ struct Handle : miopenHandle
     miopenAcceleratorQueue_t GetStream() const;
     void SetStream(miopenAcceleratorQueue_t streamID) const;
 
+    /// Creates \p count streams owned by the handle in addition to the one set with
+    /// SetStream(). Threads select their stream with SetStreamFromPool(); kernels,
+    /// invokers and other caches of the handle are shared by all streams.
+    /// Shall not be called concurrently with any other use of the handle.
+    void ReserveExtraStreamsInPool(int count) const;
+    /// Makes GetStream() return stream \p index of the pool for the calling thread.
+    /// Index 0 stands for the stream set with SetStream().
+    void SetStreamFromPool(int index) const;
+    /// Index of the stream of the pool GetStream() returns for the calling thread.
+    int GetStreamIndexFromPool() const;
+    int GetStreamPoolSize() const;
+    /// Makes the work enqueued later on stream \p waiting of the pool wait for the work enqueued
+    /// so far on stream \p signaling, without blocking the host.
+    void WaitStreamInPool(int waiting, int signaling) const;
+
+    /// Handles on the other visible devices with the same target and number of compute units,
+    /// e.g. for spreading a search across the GPUs of a node. They are created on the first
+    /// call and owned by this handle. Empty for the backends which do not support it.
+    std::vector<Handle*> GetPeers() const;
+
     void SetAllocator(miopenAllocatorFunction allocator,
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
 
     void EnableProfiling(bool enable = true) const;
+    /// While profiling, the launches of the calling thread then do not wait for their kernels.
+    /// The events of the kernels are kept and resolved at once by FlushKernelTimes() or the
+    /// kernel time accessors, after which the kernel time is the sum of the times of the kernels
+    /// launched since the previous resolution. HIP backend only, MIOPEN_DEFER_KERNEL_TIMES=0
+    /// keeps the launches waiting.
+    void DeferKernelTimes(bool enable = true) const;
+    bool IsKernelTimeDeferred() const;
+    void FlushKernelTimes() const;
 
     void ResetKernelTime() const;
     void AccumKernelTime(float curr_time) const;
@@ -106,10 +158,15 @@ struct Handle : miopenHandle
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config) const;
 
-    auto GetKernels(const std::string& algorithm, const std::string& network_config) const
+    std::vector<KernelInvoke> GetKernels(const std::string& algorithm,
+                                         const std::string& network_config) const
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        const auto kernels = this->GetKernelsImpl(algorithm, network_config);
+        std::vector<KernelInvoke> result;
+        result.reserve(kernels.size());
+        for(const auto& k : kernels)
+            result.push_back(this->Run(k));
+        return result;
     }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
     {
@@ -123,8 +180,8 @@ struct Handle : miopenHandle
     }
 
     KernelInvoke Run(Kernel k) const;
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config) const;
+    std::vector<Kernel> GetKernelsImpl(const std::string& algorithm,
+                                       const std::string& network_config) const;
 
     Program LoadProgram(const std::string& program_name,
                         std::string params,
@@ -135,6 +192,20 @@ struct Handle : miopenHandle
 
     void AddProgram(Program prog, const std::string& program_name, const std::string& params) const;
 
+    /// Unloads the program unless something else still holds it, e.g. an invoker.
+    void RemoveProgram(const std::string& program_name, const std::string& params) const;
+
+    /// Total size of the code objects held by the kernel cache of the handle, in bytes.
+    std::size_t GetCodeObjectsSize() const;
+    /// The programs held by the kernel cache of the handle, most recently used first,
+    /// with their names and build parameters.
+    std::vector<std::pair<std::pair<std::string, std::string>, Program>> GetPrograms() const;
+
+#if MIOPEN_BACKEND_HIP
+    /// Events for synchronization and timing on the streams of the handle.
+    const HipEventPool& GetEventPool() const;
+#endif
+
     void Finish() const;
     void Flush() const;
 
@@ -143,6 +214,10 @@ struct Handle : miopenHandle
     std::size_t GetImage3dMaxWidth() const;
     std::size_t GetWavefrontWidth() const;
     std::size_t GetMaxComputeUnits() const;
+    /// Shader clocks in MHz, zero if unknown. The current one is the level reported by the power
+    /// management of the driver at the moment, which is only known with HIP on Linux.
+    std::size_t GetMaxClockFrequency() const;
+    std::size_t GetCurrentClockFrequency() const;
     std::size_t GetMaxHardwareComputeUnits() const
     {
         std::size_t num_cu = this->GetMaxComputeUnits();
@@ -164,9 +239,45 @@ struct Handle : miopenHandle
     void Copy(ConstData_t src, Data_t dest, std::size_t size) const;
 
     Allocator::ManageDataPtr Create(std::size_t sz) const;
+    /// While enabled, buffers returned by Create() are not freed by their owners but kept
+    /// until TakeCapturedBuffers(), because a graph being captured may refer to them.
+    /// HIP backend only, see HipGraph.
+    void CaptureBuffers(bool enable) const;
+    std::vector<Allocator::ManageDataPtr> TakeCapturedBuffers() const;
     Allocator::ManageDataPtr&
     WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz) const;
     void ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz) const;
+    /// Enqueues a copy of \p sz bytes from the host to \p ddata at \p offset bytes on
+    /// GetStream() and returns without waiting. The data are staged in pinned memory of the
+    /// handle, so \p data may be reused right away.
+    void
+    WriteToAsync(const void* data, Data_t ddata, std::size_t sz, std::size_t offset = 0) const;
+    /// Copies \p sz bytes to the host after the work enqueued so far on GetStream(), for which
+    /// it waits, but not for the other streams of the device.
+    void ReadToOrdered(void* data, ConstData_t ddata, std::size_t sz) const;
+    /// Enqueues a copy between device buffers on GetStream().
+    void CopyAsync(ConstData_t src, Data_t dest, std::size_t size) const;
+    /// Enqueues clearing \p sz bytes of \p ddata on GetStream().
+    void ZeroAsync(Data_t ddata, std::size_t sz) const;
+    /// Enqueues a copy of \p height rows of \p width bytes between device buffers on GetStream().
+    /// The rows start \p src_pitch and \p dest_pitch bytes apart, the first ones at \p src_offset
+    /// and \p dest_offset bytes.
+    void Copy2DAsync(ConstData_t src,
+                     std::size_t src_offset,
+                     std::size_t src_pitch,
+                     Data_t dest,
+                     std::size_t dest_offset,
+                     std::size_t dest_pitch,
+                     std::size_t width,
+                     std::size_t height) const;
+    /// Enqueues filling \p sz bytes of \p ddata from \p offset bytes on GetStream() with the
+    /// \p pattern_size bytes at \p pattern, which may be 1, 2 or 4 bytes long. Both \p offset and
+    /// \p sz have to be multiples of \p pattern_size.
+    void FillAsync(Data_t ddata,
+                   std::size_t offset,
+                   std::size_t sz,
+                   const void* pattern,
+                   std::size_t pattern_size) const;
     shared<Data_t> CreateSubBuffer(Data_t data, std::size_t offset, std::size_t size);
 #if MIOPEN_BACKEND_HIP
     shared<ConstData_t> CreateSubBuffer(ConstData_t data, std::size_t offset, std::size_t size);
@@ -214,10 +325,6 @@ struct Handle : miopenHandle
     }
 
     std::unique_ptr<HandleImpl> impl;
-    std::unordered_map<std::string, std::vector<miopenConvSolution_t>> find_map;
-#if MIOPEN_USE_MIOPENGEMM
-    std::unordered_map<GemmKey, std::unique_ptr<GemmGeometry>, SimpleHash> geo_map;
-#endif
 
     Invoker PrepareInvoker(const InvokerFactory& factory,
                            const std::vector<solver::KernelInfo>& kernels) const;
@@ -227,8 +334,10 @@ struct Handle : miopenHandle
                          const std::string& solver,
                          const AlgorithmName& algo)
     {
-        invokers.Register({config, solver}, invoker);
-        invokers.SetAsFound1_0(config, algo, solver);
+        const auto solver_id = solver::Id{solver};
+        auto& cache          = GetInvokerCache();
+        cache.Register(config, solver_id, invoker);
+        cache.SetAsFound1_0(config, algo, solver_id);
     }
 
     boost::optional<const Invoker&>
@@ -238,27 +347,105 @@ struct Handle : miopenHandle
     {
         assert(solver || algo);
         assert(!(solver && algo));
+        boost::optional<const Invoker&> invoker;
         if(solver)
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            invoker = GetInvokerCache()(config, *solver);
         }
-        MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
-                                                          << algo->ToString());
-        return invokers.GetFound1_0(config, *algo);
+        else
+        {
+            MIOPEN_LOG_I2("Returning an invoker for problem "
+                          << config.ToString() << " and algorithm " << algo->ToString());
+            invoker = GetInvokerCache().GetFound1_0(config, *algo);
+        }
+        AddMetric(*this, invoker ? Metric::InvokerCacheHits : Metric::InvokerCacheMisses);
+        return invoker;
+    }
+
+    /// The solver whose invoker GetInvoker() returns for \p algo, if any.
+    boost::optional<solver::Id> GetFoundSolverId(const NetworkConfig& config,
+                                                 const AlgorithmName& algo) const
+    {
+        return GetInvokerCache().GetFound1_0Id(config, algo);
     }
 
+    boost::optional<const conv::ProblemKeys&>
+    GetProblemKeys(const conv::ProblemFingerprint& fingerprint) const
+    {
+        return problem_keys.Find(fingerprint);
+    }
+
+    const AsyncCompiler& GetAsyncCompiler() const { return async_compiler; }
+
+    /// The counters of this handle, see also Metrics::Process().
+    Metrics& GetMetrics() const { return *metrics; }
+    /// The device memory held by the library for this handle.
+    MemoryUsage& GetMemoryUsage() const { return *memory_usage; }
+    /// The flags of the asynchronous numerics checks, see CheckNumerics::Async.
+    CheckNumericsState& GetCheckNumericsState() const { return *check_numerics; }
+
+    const conv::ProblemKeys& RegisterProblemKeys(const conv::ProblemFingerprint& fingerprint,
+                                                 conv::ProblemKeys keys)
+    {
+        return problem_keys.Register(fingerprint, std::move(keys));
+    }
+
+    conv::ApplicabilityCache& GetApplicabilityCache() { return applicability; }
+
+    conv::ContextCache& GetContextCache() { return contexts; }
+
+    /// In the deterministic mode find and the immediate mode only select the solutions whose
+    /// results are bitwise reproducible, see solver::SolverBase::IsDeterministic(). The find-db
+    /// records and the invokers of the two modes are kept apart, so that switching the mode
+    /// does not pick the winners of the other one.
+    void SetDeterministic(bool enable) { deterministic = enable; }
+    bool IsDeterministic() const { return deterministic; }
+
+    /// Set by the user to replace the shipped model of the fallback, see conv::GetFallbackModel().
+    const std::shared_ptr<const conv::FallbackModel>& GetUserFallbackModel() const
+    {
+        return user_fallback_model;
+    }
+    void SetUserFallbackModel(std::shared_ptr<const conv::FallbackModel> model)
+    {
+        user_fallback_model = std::move(model);
+    }
+
+#if MIOPEN_USE_HIPBLASLT
+    /// hipBLASLt handle, created on the first use. The stream is passed to each call.
+    hipblasLtHandle_t GetHipblasLtHandle() const;
+#endif
+
 #if MIOPEN_USE_ROCBLAS
-    const rocblas_handle_ptr& rhandle() const { return rhandle_; }
+    /// rocBLAS handle bound to the stream returned by GetStream(), created on the first use.
+    const rocblas_handle_ptr& rhandle() const;
+    /// Device memory of the rocBLAS handles of all the streams of the pool.
+    std::size_t GetRocblasMemorySize() const;
 
     private:
-    rocblas_handle_ptr CreateRocblasHandle() const;
-    rocblas_handle_ptr rhandle_;
+    rocblas_handle_ptr CreateRocblasHandle(miopenAcceleratorQueue_t stream) const;
+    mutable rocblas_handle_ptr rhandle_;
 #else
     private:
 #endif
-    InvokerCache invokers;
+    InvokerCache& GetInvokerCache() { return invokers[deterministic ? 1 : 0]; }
+    const InvokerCache& GetInvokerCache() const { return invokers[deterministic ? 1 : 0]; }
+
+    bool deterministic = false;
+    // Of the default and the deterministic modes.
+    std::array<InvokerCache, 2> invokers;
+    conv::ProblemKeysCache problem_keys;
+    conv::ApplicabilityCache applicability;
+    conv::ContextCache contexts;
+    std::shared_ptr<const conv::FallbackModel> user_fallback_model;
+    std::unique_ptr<Metrics> metrics = std::make_unique<Metrics>();
+    // Shared with the buffers, which may outlive the handle.
+    std::shared_ptr<MemoryUsage> memory_usage = std::make_shared<MemoryUsage>();
+    std::unique_ptr<CheckNumericsState> check_numerics = std::make_unique<CheckNumericsState>();
+    // Declared last: the background jobs use the handle, so they are finished first.
+    AsyncCompiler async_compiler;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Handle& handle) { return handle.Print(os); }
@@ -267,19 +454,23 @@ struct AutoEnableProfiling
 {
     AutoEnableProfiling(const Handle& x) : h(x)
     {
-        prev_state = h.IsProfilingEnabled();
+        prev_state    = h.IsProfilingEnabled();
+        prev_deferred = h.IsKernelTimeDeferred();
         h.EnableProfiling();
+        h.DeferKernelTimes();
     }
 
     ~AutoEnableProfiling()
     {
         h.EnableProfiling(prev_state);
+        h.DeferKernelTimes(prev_deferred);
         h.ResetKernelTime();
     }
 
     private:
     const Handle& h;
     bool prev_state;
+    bool prev_deferred;
 };
 
 } // namespace miopen
@@ -0,0 +1,64 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_HANDLE_SNAPSHOT_HPP_
+#define GUARD_MIOPEN_HANDLE_SNAPSHOT_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+
+struct Handle;
+
+/// Snapshot of the code objects held by the kernel cache of a handle, so that another process
+/// can restore them at start instead of looking up and loading every program on the first call
+/// of each solution.
+///
+/// The file consists of a header, an index of the programs and the name/parameters/code object
+/// blobs, like MappedDb. It is memory-mapped on load and only accepted by the same version of the
+/// library for the same target. The find-db and the invokers are not part of it: the former is
+/// persistent already, the latter are cheap to prepare once the programs are in the cache.
+class HandleSnapshot
+{
+    public:
+    /// Writes the programs of the handle, most recently used first.
+    /// \return Number of the programs written.
+    static std::size_t Save(const Handle& handle, const std::string& path);
+    /// Adds the programs of the snapshot the handle lacks to its kernel cache and loads their
+    /// modules in parallel, MIOPEN_COMPILE_PARALLEL_LEVEL threads at most.
+    /// \return Number of the programs restored.
+    static std::size_t Load(const Handle& handle, const std::string& path);
+
+    private:
+    struct Header;
+    struct IndexItem;
+
+    static std::string GetIdentity(const Handle& handle);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_HANDLE_SNAPSHOT_HPP_
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_HIP_EVENT_POOL_HPP_
+#define GUARD_MIOPEN_HIP_EVENT_POOL_HPP_
+
+#include <hip/hip_runtime_api.h>
+
+#include <memory>
+#include <type_traits>
+
+namespace miopen {
+
+/// Recycles hip events used for synchronization and kernel timing instead of
+/// creating and destroying a pair of them per launch.
+///
+/// Events are handed out as EventPtr and are returned to the pool when destroyed.
+/// The pool state is shared with the handed out events, so these may outlive the
+/// pool. All events of a pool belong to the device which is current on Get().
+class HipEventPool
+{
+    public:
+    struct State;
+
+    struct Releaser
+    {
+        /// Events without a pool are destroyed.
+        std::shared_ptr<State> state;
+        void operator()(hipEvent_t event) const;
+    };
+
+    using EventPtr = std::unique_ptr<std::remove_pointer<hipEvent_t>::type, Releaser>;
+
+    HipEventPool();
+
+    EventPtr Get() const;
+    std::size_t GetIdleCount() const;
+
+    private:
+    std::shared_ptr<State> state;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_HIP_EVENT_POOL_HPP_
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_HIP_GRAPH_HPP_
+#define GUARD_MIOPEN_HIP_GRAPH_HPP_
+
+#include <miopen/allocator.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/manage_ptr.hpp>
+
+#include <hip/hip_runtime_api.h>
+
+#include <vector>
+
+namespace miopen {
+
+using HipGraphPtr     = MIOPEN_MANAGE_PTR(hipGraph_t, hipGraphDestroy);
+using HipGraphExecPtr = MIOPEN_MANAGE_PTR(hipGraphExec_t, hipGraphExecDestroy);
+
+/// Sequence of MIOpen calls on a handle recorded into a HIP graph, so it can be
+/// replayed with a single launch instead of launching every kernel from the host.
+///
+/// Everything submitted to the stream of the handle between BeginCapture() and
+/// EndCapture() is recorded. Buffers the library creates during the capture are kept
+/// alive by the graph. The stream must not be the null stream, and profiling must be
+/// disabled while capturing because it synchronizes after every kernel.
+///
+/// To replay with other buffers, capture the same sequence again: EndCapture() then
+/// updates the instantiated graph in place (hipGraphExecUpdate), which is much cheaper
+/// than a new instantiation, and falls back to instantiating if the topology differs.
+class HipGraph
+{
+    public:
+    void BeginCapture(const Handle& handle);
+    void EndCapture(const Handle& handle);
+    void Launch(const Handle& handle) const;
+
+    bool IsInstantiated() const { return exec != nullptr; }
+
+    private:
+    HipGraphPtr graph;
+    HipGraphExecPtr exec;
+    std::vector<Allocator::ManageDataPtr> buffers;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_HIP_GRAPH_HPP_
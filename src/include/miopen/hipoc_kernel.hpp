@@ -29,6 +29,7 @@
 #include <array>
 #include <cassert>
 #include <miopen/errors.hpp>
+#include <miopen/hip_event_pool.hpp>
 #include <miopen/hipoc_program.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/op_kernel_args.hpp>
@@ -117,6 +118,11 @@ struct KernelArgs
     uint64_t hidden[6] = {};
 };
 
+/// Takes the events around a launch without waiting for these, the elapsed time is then
+/// resolved by the receiver when it is needed.
+using DeferredTimeCallback =
+    std::function<void(const std::string&, HipEventPool::EventPtr&&, HipEventPool::EventPtr&&)>;
+
 struct HIPOCKernelInvoke
 {
     hipStream_t stream          = nullptr;
@@ -125,6 +131,10 @@ struct HIPOCKernelInvoke
     std::array<size_t, 3> gdims = {};
     std::string name;
     std::function<void(hipEvent_t, hipEvent_t)> callback;
+    /// Source of the events for the callback, new ones are created if not set.
+    const HipEventPool* event_pool = nullptr;
+    /// Replaces callback if set, so the launch does not wait for the kernel.
+    DeferredTimeCallback deferred_callback;
 
     // Workaround for aggregate types in c++11
     HIPOCKernelInvoke() {}
@@ -133,10 +143,25 @@ struct HIPOCKernelInvoke
                       std::array<size_t, 3> pldims,
                       std::array<size_t, 3> pgdims,
                       std::string pname,
-                      std::function<void(hipEvent_t, hipEvent_t)> pcallback)
-        : stream(pstream), fun(pfun), ldims(pldims), gdims(pgdims), name(pname), callback(pcallback)
+                      std::function<void(hipEvent_t, hipEvent_t)> pcallback,
+                      const HipEventPool* pevent_pool         = nullptr,
+                      DeferredTimeCallback pdeferred_callback = nullptr)
+        : stream(pstream),
+          fun(pfun),
+          ldims(pldims),
+          gdims(pgdims),
+          name(pname),
+          callback(pcallback),
+          event_pool(pevent_pool),
+          deferred_callback(pdeferred_callback)
+    {
+    }
+    void operator()(const PackedKernelArgs& args) const
     {
+        // The buffer is only read: HIP copies it to the kernarg segment.
+        run(const_cast<char*>(args.data()), args.size()); // NOLINT
     }
+
     void operator()(std::vector<OpKernelArg>& any_args) const
     {
         char hip_args[256] = {0};
@@ -203,7 +228,9 @@ struct HIPOCKernel
     }
 
     HIPOCKernelInvoke Invoke(hipStream_t stream,
-                             std::function<void(hipEvent_t, hipEvent_t)> callback = nullptr) const;
+                             std::function<void(hipEvent_t, hipEvent_t)> callback = nullptr,
+                             const HipEventPool* event_pool                      = nullptr,
+                             DeferredTimeCallback deferred_callback              = nullptr) const;
 };
 
 } // namespace miopen
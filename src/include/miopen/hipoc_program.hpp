@@ -39,12 +39,12 @@ struct HIPOCProgramImpl;
 struct HIPOCProgram
 {
     HIPOCProgram();
-    /// This ctor builds the program from source, initializes module.
+    /// This ctor builds the program from source.
     /// Also either CO pathname (typically if offline tools were used)
     /// or binary blob (if comgr was used to build the program)
     /// is initialized. GetModule(), GetCodeObjectPathname(),
     /// GetCodeObjectBlob() return appropriate data after this ctor.
-    /// Other ctors only guarantee to initialize module.
+    /// Other ctors only guarantee GetModule().
     HIPOCProgram(const std::string& program_name,
                  std::string params,
                  bool is_kernel_str,
@@ -53,6 +53,7 @@ struct HIPOCProgram
     HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco);
     HIPOCProgram(const std::string& program_name, const std::string& hsaco);
     std::shared_ptr<HIPOCProgramImpl> impl;
+    /// Loads the module on the first call.
     hipModule_t GetModule() const;
     /// \return Pathname of CO file, if it resides on the filesystem.
     /// This function should not be called after FreeCodeObjectFileStorage().
@@ -62,6 +63,8 @@ struct HIPOCProgram
     /// \return True if CO blob resides in-memory.
     /// False if CO resides on filesystem.
     bool IsCodeObjectInMemory() const;
+    /// \return Size of the loaded code object in bytes, zero if unknown.
+    std::size_t GetCodeObjectSize() const;
     void FreeCodeObjectFileStorage();
 };
 } // namespace miopen
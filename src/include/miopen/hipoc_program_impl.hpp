@@ -33,6 +33,10 @@
 #include <boost/optional.hpp>
 #include <hip/hip_runtime_api.h>
 
+#include <mutex>
+#include <string>
+#include <vector>
+
 namespace miopen {
 
 using hipModulePtr = MIOPEN_MANAGE_PTR(hipModule_t, hipModuleUnload);
@@ -55,6 +59,15 @@ struct HIPOCProgramImpl
     hipModulePtr module;
     boost::optional<TmpDir> dir;
     std::vector<char> binary;
+    std::size_t code_object_size = 0;
+    /// The module is instantiated by the first kernel, many programs are built or loaded
+    /// from the cache only to be discarded. Until then the code object stays in \ref binary,
+    /// \ref lazy_blob or \ref hsaco_file, lazy_blob is freed after loading.
+    std::string lazy_blob;
+    int device = -1;
+    std::mutex module_mutex;
+
+    hipModule_t GetModule();
 
 #if !MIOPEN_USE_COMGR
     void
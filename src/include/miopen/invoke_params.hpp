@@ -26,15 +26,20 @@
 
 #pragma once
 
+#include <miopen/allocator.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/rank.hpp>
 
 #include <memory>
 #include <typeinfo>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace miopen {
 
+struct Handle;
+
 enum class InvokeType
 {
     Run,
@@ -110,6 +115,19 @@ struct AnyInvokeParams
         return *reinterpret_cast<Actual*>(impl->GetRawPtr());
     }
 
+    /// Copy of the params with the buffers replaced by new ones of the same sizes, which are
+    /// allocated on \p handle and owned by \p buffers, e.g. to measure the same problem on
+    /// another device. Empty unless the actual params implement
+    /// "Actual Relocate(const Handle&, std::vector<Allocator::ManageDataPtr>&) const".
+    AnyInvokeParams Relocate(const Handle& handle,
+                             std::vector<Allocator::ManageDataPtr>& buffers) const
+    {
+        auto result = AnyInvokeParams{};
+        if(impl)
+            result.impl = impl->Relocate(handle, buffers);
+        return result;
+    }
+
     operator bool() const { return impl != nullptr; }
 
     private:
@@ -128,6 +146,8 @@ struct AnyInvokeParams
         virtual bool CanCastTo(const std::type_info&) const = 0;
         virtual void* GetRawPtr()                           = 0;
         virtual std::unique_ptr<Interface> Copy() const     = 0;
+        virtual std::unique_ptr<Interface>
+        Relocate(const Handle& handle, std::vector<Allocator::ManageDataPtr>& buffers) const = 0;
 
         protected:
         Interface() = default;
@@ -150,8 +170,32 @@ struct AnyInvokeParams
             return std::make_unique<Implementation<Actual>>(value);
         }
 
+        std::unique_ptr<Interface> Relocate(const Handle& handle,
+                                            std::vector<Allocator::ManageDataPtr>& buffers) const
+            override
+        {
+            return RelocateImpl(rank<1>{}, value, handle, buffers);
+        }
+
         private:
         Actual value;
+
+        template <class T>
+        static auto RelocateImpl(rank<1>,
+                                 const T& params,
+                                 const Handle& handle,
+                                 std::vector<Allocator::ManageDataPtr>& buffers)
+            -> decltype(params.Relocate(handle, buffers), std::unique_ptr<Interface>{})
+        {
+            return std::make_unique<Implementation<Actual>>(params.Relocate(handle, buffers));
+        }
+
+        template <class T>
+        static std::unique_ptr<Interface>
+        RelocateImpl(rank<0>, const T&, const Handle&, std::vector<Allocator::ManageDataPtr>&)
+        {
+            return nullptr;
+        }
     };
 
     std::unique_ptr<Interface> impl;
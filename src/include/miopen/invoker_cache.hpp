@@ -28,44 +28,86 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/names.hpp>
+#include <miopen/solver_id.hpp>
 
 #include <boost/optional.hpp>
 
-#include <map>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 namespace miopen {
 
+/// Thread-safe cache of invokers.
+///
+/// Items are stored in a fixed number of shards selected by the precomputed
+/// network config hash, each guarded by its own reader-writer lock, so concurrent
+/// lookups from threads that share a handle neither serialize on a single mutex
+/// nor allocate. Entries are never removed, hence references returned by the
+/// lookups stay valid for the lifetime of the cache.
 class InvokerCache
 {
     public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
-
-    boost::optional<const Invoker&> operator[](const Key& key) const;
+    boost::optional<const Invoker&> operator()(const NetworkConfig& config,
+                                               solver::Id solver_id) const;
+    // For find 1.0
+    boost::optional<const Invoker&> GetFound1_0(const NetworkConfig& config,
+                                                const AlgorithmName& algorithm) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
-                                                const std::string& algorithm) const;
-    void Register(const Key& key, const Invoker& invoker);
+    boost::optional<solver::Id> GetFound1_0Id(const NetworkConfig& config,
+                                              const AlgorithmName& algorithm) const;
+    void Register(const NetworkConfig& config, solver::Id solver_id, const Invoker& invoker);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
-                       const std::string& algorithm,
-                       const std::string& solver_id);
+    void SetAsFound1_0(const NetworkConfig& config,
+                       const AlgorithmName& algorithm,
+                       solver::Id solver_id);
 
     private:
+    static constexpr std::size_t shard_count = 16;
+
     struct Item
     {
+        explicit Item(const std::string& network_config_) : network_config(network_config_) {}
+
+        // Hashes of different configs may collide, so the full value is kept to tell them apart.
+        std::string network_config;
         // algorithm -> solver_id
         // for find 1.0
-        std::map<std::string, std::string> found_1_0;
+        std::unordered_map<std::string, uint64_t> found_1_0;
         // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
+        std::unordered_map<uint64_t, Invoker> invokers;
+    };
+
+    struct Shard
+    {
+        mutable std::shared_timed_mutex mutex;
+        // network_config hash -> Item
+        std::unordered_multimap<uint64_t, Item> items;
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    static std::size_t ShardIndex(const NetworkConfig& config)
+    {
+        // unordered_multimap picks buckets with low bits of the hash, so use the high ones here.
+        return (config.GetHash() >> 32) % shard_count;
+    }
+
+    const Shard& GetShard(const NetworkConfig& config) const
+    {
+        return (*shards)[ShardIndex(config)];
+    }
+    Shard& GetShard(const NetworkConfig& config) { return (*shards)[ShardIndex(config)]; }
+
+    static const Item* FindItem(const Shard& shard, const NetworkConfig& config);
+    static Item* FindItem(Shard& shard, const NetworkConfig& config);
+
+    // Mutexes are not movable, and the Handle owning the cache is.
+    std::unique_ptr<std::array<Shard, shard_count>> shards =
+        std::make_unique<std::array<Shard, shard_count>>();
 };
 
 } // namespace miopen
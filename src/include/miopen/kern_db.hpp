@@ -32,15 +32,20 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
+#include <miopen/kern_db_codec.hpp>
 #include <miopen/md5.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <chrono>
 #include <thread>
+#include <unordered_map>
 
 namespace boost {
 namespace filesystem {
@@ -69,25 +74,62 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` INT"
+           << ",`kernel_key` INT"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
            << "ON " << KernelConfig::table_name() << "(kernel_name, kernel_args);";
         return ss.str();
     }
-    std::string Where() const
+    static std::string CreateKeyIndexQuery()
     {
-        std::ostringstream ss;
-        ss << "(kernel_name = '" << kernel_name << "')"
-           << " AND (kernel_args = '" << kernel_args << "')";
-        return ss.str();
+        return "CREATE INDEX IF NOT EXISTS `idx_" + table_name() + "_key` ON " + table_name() +
+               "(kernel_key);";
+    }
+    static std::string CreateHashIndexQuery()
+    {
+        return "CREATE INDEX IF NOT EXISTS `idx_" + table_name() + "_hash` ON " + table_name() +
+               "(kernel_hash);";
     }
+    /// Fixed-width hash of kernel_name and kernel_args, so that the lookups probe an integer
+    /// index instead of comparing the long option strings. Collisions are resolved by
+    /// comparing the strings of the few matching rows.
+    std::int64_t Key() const;
 };
 
 class KernDb : public SQLiteBase<KernDb>
 {
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    /// Codec of the new records.
+    KernDbCodec codec;
+    /// Databases created before the codec column have bz2 or uncompressed blobs.
+    bool has_codec_column = false;
+    /// Read-only databases created before the key column are searched by the strings.
+    bool has_key_column = false;
+    /// Records with the same code object as an existing one store an empty blob and share the
+    /// blob of the other record by kernel_hash. Only the writable databases deduplicate, since
+    /// the lookups by the hash need its index.
+    bool deduplicate = false;
+
+    /// Instances are shared by the threads, which compile kernels in parallel, so the
+    /// statements prepared once per connection are used one at a time.
+    struct Statements
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, SQLite::Statement> cache;
+    };
+    std::unique_ptr<Statements> statements = std::make_unique<Statements>();
+
+    std::string GetCodecColumn() const;
+    std::string GetKeyClause() const;
+    void BindKey(SQLite::Statement& stmt, const KernelConfig& config, int first) const;
+    SQLite::Statement& GetStatement(const std::string& query);
+    void AddKeyColumn();
+    bool HasBlob(const std::string& hash);
+    KernDbCodec EncodeBlob(const std::string& blob, std::string& encoded) const;
+    std::string DecodeBlob(KernDbCodec blob_codec, const std::string& blob, std::size_t size) const;
 
     public:
     KernDb(const std::string& filename_, bool is_system);
@@ -96,90 +138,12 @@ class KernDb : public SQLiteBase<KernDb>
            bool _is_system,
            std::function<std::string(std::string, bool*)> _compress_fn,
            std::function<std::string(std::string, unsigned int)> _decompress_fn);
-    template <typename T>
-    bool RemoveRecordUnsafe(const T& problem_config)
-    {
-        if(filename.empty())
-            return true;
-        auto del_query =
-            "DELETE FROM " + T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, del_query};
-        auto rc   = stmt.Step(sql);
-        if(rc == SQLITE_DONE)
-            return true;
-        else
-        {
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-            return false;
-        }
-    }
-
-    template <typename T>
-    boost::optional<std::string> FindRecordUnsafe(const T& problem_config)
-    {
-        if(filename.empty())
-            return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
-        // only one result field
-        // assert one row
-        auto rc = stmt.Step(sql);
-        if(rc == SQLITE_ROW)
-        {
-            auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
-            auto uncompressed_size         = stmt.ColumnInt64(2);
-            std::string& decompressed_blob = compressed_blob;
-            if(uncompressed_size != 0)
-            {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
-            }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
-                MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
-            return decompressed_blob;
-        }
-        else if(rc == SQLITE_DONE)
-            return boost::none;
-        else
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-        return boost::none;
-    }
+    /// Returns kernel_name and kernel_args of all the records, blobs are not loaded.
+    std::vector<KernelConfig> GetAllKeysUnsafe();
 
-    template <typename T>
-    boost::optional<std::string> StoreRecordUnsafe(const T& problem_config)
-    {
-        if(filename.empty())
-            return boost::none;
-        auto insert_query = "INSERT OR IGNORE INTO " + T::table_name() +
-                            "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
-        auto uncompressed_size = problem_config.kernel_blob.size();
-        bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
-        stmt.BindText(1, problem_config.kernel_name);
-        stmt.BindText(2, problem_config.kernel_args);
-        if(!success)
-        {
-            stmt.BindBlob(3, problem_config.kernel_blob);
-            stmt.BindInt64(5, 0);
-        }
-        else
-        {
-            stmt.BindBlob(3, compressed_blob);
-            stmt.BindInt64(5, uncompressed_size);
-        }
-        stmt.BindText(4, md5_sum);
-
-        auto rc = stmt.Step(sql);
-        if(rc != SQLITE_DONE)
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
-        return problem_config.kernel_blob;
-    }
+    bool RemoveRecordUnsafe(const KernelConfig& problem_config);
+    boost::optional<std::string> FindRecordUnsafe(const KernelConfig& problem_config);
+    boost::optional<std::string> StoreRecordUnsafe(const KernelConfig& problem_config);
 };
 } // namespace miopen
 #endif
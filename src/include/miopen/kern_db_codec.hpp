@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERN_DB_CODEC_HPP_
+#define GUARD_MIOPEN_KERN_DB_CODEC_HPP_
+
+#include <miopen/config.h>
+
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+
+/// Compression of the kernel blobs in KernDb, stored per record. The values are stored
+/// in the database and shall never change.
+enum class KernDbCodec : int
+{
+    None = 0,
+    Bz2  = 1,
+    Zstd = 2,
+    Lz4  = 3,
+};
+
+/// Blobs smaller than this are stored uncompressed.
+constexpr std::size_t kern_db_min_compressed_size = 4 * 1024;
+
+bool IsAvailable(KernDbCodec codec);
+const char* ToString(KernDbCodec codec);
+
+/// Codec for the new records. MIOPEN_KERN_DB_CODEC (none, bz2, zstd or lz4) selects it
+/// if available, the default is the fastest to decompress one available.
+KernDbCodec GetKernDbCodec();
+
+/// Returns false if the blob does not become smaller.
+bool CompressBlob(KernDbCodec codec, const std::string& blob, std::string& compressed);
+std::string DecompressBlob(KernDbCodec codec, const std::string& blob, std::size_t size);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERN_DB_CODEC_HPP_
@@ -46,6 +46,8 @@
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <list>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -55,14 +57,20 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * The cache is thread-safe, so it can be shared by all streams of a handle.
+ * Programs are built without holding the lock.
+ *
+ * The cache may be bounded by the total size of the code objects and by the
+ * number of entries (MIOPEN_KERNEL_CACHE_LIMIT_MB, MIOPEN_KERNEL_CACHE_LIMIT_ENTRIES).
+ * The least recently used programs and kernels are evicted then; a program
+ * is unloaded when nothing else holds it, and reloaded from the binary cache
+ * on the next use.
  */
 class KernelCache
 {
 
     public:
-    using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using Key = std::pair<std::string, std::string>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -76,12 +84,9 @@ class KernelCache
                      bool is_kernel_miopengemm_str = false,
                      const std::string& kernel_src = "");
 
-    void AddKernel(Key key, Kernel k, std::size_t cache_index);
-
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    std::vector<Kernel> GetKernels(const std::string& algorithm, const std::string& network_config);
 
     bool HasKernels(const std::string& algorithm, const std::string& network_config) const;
 
@@ -89,11 +94,57 @@ class KernelCache
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
 
+    /// Drops the program and the kernels built from it, if there are any.
+    void RemoveProgram(const std::string& program_name, const std::string& params);
+
+    /// The cached programs with their keys, most recently used first.
+    std::vector<std::pair<Key, Program>> GetPrograms() const;
+
+    /// Total size of the code objects of the cached programs, in bytes.
+    std::size_t GetCodeObjectsSize() const;
+    std::size_t GetProgramsCount() const;
+    std::size_t GetKernelsCount() const;
+
+    /// Limits are taken from the environment, unbounded by default.
     KernelCache();
+    /// Zero stands for no limit.
+    KernelCache(std::size_t max_code_objects_size_, std::size_t max_entries_);
 
     private:
+    struct ProgramEntry
+    {
+        Program program;
+        std::size_t size;
+        std::list<Key>::iterator lru;
+    };
+
+    struct KernelEntry
+    {
+        std::vector<Kernel> kernels;
+        std::vector<Key> programs;
+        std::list<Key>::iterator lru;
+    };
+
+    using KernelMap  = std::unordered_map<Key, KernelEntry, SimpleHash>;
+    using ProgramMap = std::unordered_map<Key, ProgramEntry, SimpleHash>;
+
+    void AddKernel(const Key& key, Kernel k, std::size_t cache_index, const Key& program);
+    /// Return the cached program if there is one, so all users share it.
+    Program InsertProgram(const Key& key, const Program& program);
+    void EraseProgram(ProgramMap::iterator it);
+    void EraseKernels(KernelMap::iterator it);
+    void Evict();
+
+    std::size_t max_code_objects_size;
+    std::size_t max_entries;
+    std::size_t code_objects_size = 0;
+
+    mutable std::mutex mutex;
     KernelMap kernel_map;
     ProgramMap program_map;
+    // Most recently used keys go first.
+    std::list<Key> kernel_lru;
+    std::list<Key> program_lru;
 };
 
 } // namespace miopen
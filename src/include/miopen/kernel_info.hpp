@@ -27,6 +27,7 @@
 #ifndef GUARD_MLOPEN_KERNEL_INFO_HPP
 #define GUARD_MLOPEN_KERNEL_INFO_HPP
 
+#include <future>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -50,7 +51,18 @@ struct KernelInfo
     friend std::ostream& operator<<(std::ostream& os, const KernelInfo& k);
 };
 
-std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels);
+/// solvers optionally name the solver of each kernel, which its build time is reported for.
+std::vector<Program> PrecompileKernels(const Handle& h,
+                                       const std::vector<KernelInfo>& kernels,
+                                       const std::vector<std::string>& solvers = {});
+
+/// Schedules building of the kernels which are not in the cache of the handle yet.
+/// Programs are added to the cache as soon as they are built. Returns the pending
+/// builds, so an empty result means that all the kernels are ready.
+std::vector<std::shared_future<Program>>
+PrecompileKernelsAsync(const Handle& h,
+                       const std::vector<KernelInfo>& kernels,
+                       const std::string& solver = "");
 
 } // namespace solver
 } // namespace miopen
@@ -32,10 +32,19 @@
 #include <iostream>
 
 namespace miopen {
+
+struct ConvolutionContext;
+
 namespace solver {
 
+/// The search space is not a product of independent ranges: it is walked in the order of the
+/// original nested loops of the legacy search, which skip the combinations depending on the
+/// problem, the value before the first one being the all-zero one.
 struct LegacyPerformanceConfig : Serializable<LegacyPerformanceConfig>
 {
+    LegacyPerformanceConfig() = default;
+    explicit LegacyPerformanceConfig(bool) {}
+
     int grp_tile1       = 0;
     int grp_tile0       = 0;
     int in_tile1        = 0;
@@ -60,6 +69,10 @@ struct LegacyPerformanceConfig : Serializable<LegacyPerformanceConfig>
         iud.n_stacks        = n_stacks;
     }
 
+    bool SetNextValue(const ConvolutionContext& params);
+    bool IsValid(const ConvolutionContext& params) const;
+    bool operator==(const LegacyPerformanceConfig& other) const;
+
     template <class Self, class F>
     static void Visit(Self&& self, F f)
     {
@@ -34,9 +34,11 @@
 #include <type_traits>
 #include <chrono>
 
+#include <miopen/binary_log.hpp>
 #include <miopen/each_args.hpp>
 #include <miopen/object.hpp>
 #include <miopen/config.h>
+#include <miopen/trace.hpp>
 
 // See https://github.com/pfultz2/Cloak/wiki/C-Preprocessor-tricks,-tips,-and-idioms
 #define MIOPEN_PP_CAT(x, y) MIOPEN_PP_PRIMITIVE_CAT(x, y)
@@ -266,6 +268,78 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
     return os;
 }
 
+namespace binlog {
+
+template <class T,
+          typename std::enable_if<(std::is_integral<T>{} && std::is_signed<T>{}), int>::type = 0>
+void LogArg(RecordWriter& record, const T& x)
+{
+    record.Int(x);
+}
+
+template <class T,
+          typename std::enable_if<(std::is_integral<T>{} && !std::is_signed<T>{}), int>::type = 0>
+void LogArg(RecordWriter& record, const T& x)
+{
+    record.UInt(x);
+}
+
+template <class T, typename std::enable_if<(std::is_enum<T>{}), int>::type = 0>
+void LogArg(RecordWriter& record, const T& x)
+{
+    record.Int(static_cast<std::int64_t>(x));
+}
+
+template <class T, typename std::enable_if<(std::is_floating_point<T>{}), int>::type = 0>
+void LogArg(RecordWriter& record, const T& x)
+{
+    record.Double(x);
+}
+
+/// The handles and the descriptors are logged as pointers, which is what makes the binary log
+/// cheap. Their contents can be told from the calls which have set them.
+template <class T, typename std::enable_if<(std::is_pointer<T>{}), int>::type = 0>
+void LogArg(RecordWriter& record, const T& x)
+{
+    record.Pointer(x);
+}
+
+inline void LogArg(RecordWriter& record, const char* x)
+{
+    if(x == nullptr)
+        record.Pointer(x);
+    else
+        record.String(x, std::char_traits<char>::length(x));
+}
+
+inline void LogArg(RecordWriter& record, const std::string& x) { record.String(x); }
+
+template <class T, typename std::enable_if<(std::is_class<T>{}), int>::type = 0>
+void LogArg(RecordWriter& record, const T& x)
+{
+    std::ostringstream ss;
+    ss << get_object(x);
+    record.String(ss.str());
+}
+
+template <class T>
+void LogArg(RecordWriter& record, const std::vector<T>& x)
+{
+    record.Array(x.size());
+    for(const auto& item : x)
+        LogArg(record, item);
+}
+
+template <class T, typename S>
+void LogArg(RecordWriter& record, const logger::CArray<T, S>& x)
+{
+    LogArg(record, x.values);
+}
+
+} // namespace binlog
+
+#define MIOPEN_LOG_BINARY_EACH(param) miopen::binlog::LogArg(miopen_log_record, param);
+
 #define MIOPEN_LOG_FUNCTION_EACH(param)                                         \
     do                                                                          \
     {                                                                           \
@@ -278,10 +352,20 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
         std::cerr << miopen_log_func_ss.str();                                  \
     } while(false);
 
+// Also traces the call, see miopen::trace.
 #define MIOPEN_LOG_FUNCTION(...)                                                        \
+    MIOPEN_TRACE_SCOPE("api", __func__);                                                \
     do                                                                                  \
         if(miopen::IsLoggingFunctionCalls())                                            \
         {                                                                               \
+            if(miopen::binlog::IsEnabled())                                             \
+            {                                                                           \
+                static const auto miopen_log_site = miopen::binlog::RegisterSite(       \
+                    miopen::binlog::Kind::Call, __PRETTY_FUNCTION__, #__VA_ARGS__);     \
+                miopen::binlog::RecordWriter miopen_log_record{miopen_log_site};        \
+                MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_BINARY_EACH, __VA_ARGS__)                \
+                break;                                                                  \
+            }                                                                           \
             std::ostringstream miopen_log_func_ss;                                      \
             miopen_log_func_ss << miopen::LoggingPrefix() << __PRETTY_FUNCTION__ << "{" \
                                << std::endl;                                            \
@@ -293,7 +377,7 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
         }                                                                               \
     while(false)
 #else
-#define MIOPEN_LOG_FUNCTION(...)
+#define MIOPEN_LOG_FUNCTION(...) MIOPEN_TRACE_SCOPE("api", __func__)
 #endif
 
 std::string LoggingParseFunction(const char* func, const char* pretty_func);
@@ -301,24 +385,59 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 #define MIOPEN_GET_FN_NAME() \
     (miopen::LoggingParseFunction(__func__, __PRETTY_FUNCTION__)) /* NOLINT */
 
-#define MIOPEN_LOG_XQ_(level, disableQuieting, fn_name, ...)                                 \
-    do                                                                                       \
-    {                                                                                        \
-        if(miopen::IsLogging(level, disableQuieting))                                        \
-        {                                                                                    \
-            std::ostringstream miopen_log_ss;                                                \
-            miopen_log_ss << miopen::LoggingPrefix() << LoggingLevelToCString(level) << " [" \
-                          << fn_name << "] " << __VA_ARGS__ << std::endl;                    \
-            std::cerr << miopen_log_ss.str();                                                \
-        }                                                                                    \
+#define MIOPEN_LOG_TEXT_(level, fn_name, ...)                                            \
+    do                                                                                   \
+    {                                                                                    \
+        std::ostringstream miopen_log_ss;                                                \
+        miopen_log_ss << miopen::LoggingPrefix() << LoggingLevelToCString(level) << " [" \
+                      << fn_name << "] " << __VA_ARGS__ << std::endl;                    \
+        std::cerr << miopen_log_ss.str();                                                \
+    } while(false)
+
+// The site of the binary log is registered on the first use, with the name of the function.
+#define MIOPEN_LOG_XQ_(level, disableQuieting, fn_name, ...)                              \
+    do                                                                                    \
+    {                                                                                     \
+        if(miopen::IsLogging(level, disableQuieting))                                     \
+        {                                                                                 \
+            if(miopen::binlog::IsEnabled())                                               \
+            {                                                                             \
+                static const auto miopen_log_site =                                       \
+                    miopen::binlog::RegisterSite(miopen::binlog::Kind::Message, fn_name); \
+                miopen::binlog::ThreadStream() << __VA_ARGS__;                            \
+                miopen::binlog::Message(miopen_log_site, static_cast<int>(level));        \
+            }                                                                             \
+            else                                                                          \
+            {                                                                             \
+                MIOPEN_LOG_TEXT_(level, fn_name, __VA_ARGS__);                            \
+            }                                                                             \
+        }                                                                                 \
     } while(false)
 
 #define MIOPEN_LOG(level, ...) MIOPEN_LOG_XQ_(level, false, MIOPEN_GET_FN_NAME(), __VA_ARGS__)
 #define MIOPEN_LOG_NQ_(level, ...) MIOPEN_LOG_XQ_(level, true, MIOPEN_GET_FN_NAME(), __VA_ARGS__)
 
 #define MIOPEN_LOG_E(...) MIOPEN_LOG(miopen::LoggingLevel::Error, __VA_ARGS__)
-#define MIOPEN_LOG_E_FROM(from, ...) \
-    MIOPEN_LOG_XQ_(miopen::LoggingLevel::Error, false, from, __VA_ARGS__)
+// The name varies between the calls, so the error is formatted into the binary log as well.
+#define MIOPEN_LOG_E_FROM(from, ...)                                                    \
+    do                                                                                  \
+    {                                                                                   \
+        if(miopen::IsLogging(miopen::LoggingLevel::Error))                              \
+        {                                                                               \
+            if(miopen::binlog::IsEnabled())                                             \
+            {                                                                           \
+                static const auto miopen_log_site =                                     \
+                    miopen::binlog::RegisterSite(miopen::binlog::Kind::Message, "");    \
+                miopen::binlog::ThreadStream() << "[" << from << "] " << __VA_ARGS__;   \
+                miopen::binlog::Message(miopen_log_site,                                \
+                                        static_cast<int>(miopen::LoggingLevel::Error)); \
+            }                                                                           \
+            else                                                                        \
+            {                                                                           \
+                MIOPEN_LOG_TEXT_(miopen::LoggingLevel::Error, from, __VA_ARGS__);       \
+            }                                                                           \
+        }                                                                               \
+    } while(false)
 #define MIOPEN_LOG_W(...) MIOPEN_LOG(miopen::LoggingLevel::Warning, __VA_ARGS__)
 #define MIOPEN_LOG_I(...) MIOPEN_LOG(miopen::LoggingLevel::Info, __VA_ARGS__)
 #define MIOPEN_LOG_I2(...) MIOPEN_LOG(miopen::LoggingLevel::Info2, __VA_ARGS__)
@@ -335,6 +454,14 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 #define MIOPEN_LOG_DRIVER_CMD(...)                                                             \
     do                                                                                         \
     {                                                                                          \
+        if(miopen::binlog::IsEnabled())                                                        \
+        {                                                                                      \
+            static const auto miopen_log_site = miopen::binlog::RegisterSite(                  \
+                miopen::binlog::Kind::Command, MIOPEN_GET_FN_NAME());                          \
+            miopen::binlog::ThreadStream() << __VA_ARGS__;                                     \
+            miopen::binlog::Message(miopen_log_site, 0);                                       \
+            break;                                                                             \
+        }                                                                                      \
         std::ostringstream miopen_driver_cmd_ss;                                               \
         miopen_driver_cmd_ss << miopen::LoggingPrefix() << "Command"                           \
                              << " ["                                                           \
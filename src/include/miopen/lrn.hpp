@@ -79,6 +79,9 @@ struct LRNDescriptor : miopenLRNDescriptor
     miopenLRNMode_t mode = miopenLRNWithinChannel;
 };
 
+/// Packed channel-last tensors run the NHWC kernels, the others need packed NCHW.
+bool IsLRNNHWC(const TensorDescriptor& desc);
+
 } // namespace miopen
 MIOPEN_DEFINE_OBJECT(miopenLRNDescriptor, miopen::LRNDescriptor);
 #endif // _MIOPEN_LRN_HPP_
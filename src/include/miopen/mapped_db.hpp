@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MAPPED_DB_HPP_
+#define GUARD_MIOPEN_MAPPED_DB_HPP_
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace miopen {
+
+/// Read-only database precompiled from a text one (find-db or perf-db), which is
+/// memory-mapped instead of being parsed on load. The pages are shared through the
+/// page cache between processes which use the same file, and a record is only
+/// copied out when found.
+///
+/// The file consists of a header, an index of records sorted by key and the
+/// key/contents blobs. The text database is usually installed alongside,
+/// as "<text path>.bin"; the file is rejected if the text one has changed since.
+///
+/// Without the precompiled file, the same image can be built into a node-wide shared
+/// memory segment named after the path and the version of the text database. The first
+/// process builds it, the later ones map it read-only. Segments persist until reboot
+/// or removal from /dev/shm, a changed text database gets a new one.
+class MappedDb
+{
+    public:
+    struct Record
+    {
+        int line;
+        std::string content;
+    };
+
+    /// \return Path to the precompiled version of the text database.
+    static std::string GetPath(const std::string& text_path);
+    /// \return Database if the file exists and is valid.
+    static std::unique_ptr<MappedDb> Open(const std::string& path, const std::string& text_path);
+    /// Builds the precompiled file from a text database. Duplicate keys are ignored,
+    /// like on load of the text one.
+    static void Convert(const std::string& text_path, const std::string& path);
+    /// \return Database from the shared memory segment of the text database, which is
+    /// created on the first use. None if the segment is being created by another process.
+    static std::unique_ptr<MappedDb> OpenShared(const std::string& text_path);
+    /// Removes the shared memory segment of the current version of the text database.
+    static void RemoveShared(const std::string& text_path);
+
+    boost::optional<Record> Find(const std::string& key) const;
+    std::size_t GetCount() const;
+
+    private:
+    struct Header;
+    struct IndexItem;
+
+    MappedDb(const std::string& path, boost::interprocess::mapped_region&& region);
+
+    static std::string Build(const std::string& text_path, std::size_t& count);
+    static std::string GetSharedName(const std::string& text_path);
+
+    const Header& GetHeader() const;
+    const IndexItem* GetIndex() const;
+    const char* GetData() const;
+    bool IsComplete() const;
+    bool Validate(const std::string& text_path) const;
+
+    std::string path;
+    boost::interprocess::mapped_region region;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MAPPED_DB_HPP_
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MEMORY_USAGE_HPP_
+#define GUARD_MIOPEN_MEMORY_USAGE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+
+enum class MemoryCategory
+{
+    Buffers,     ///< Scratch buffers of the kernels, the default.
+    Search,      ///< Buffers and workspaces allocated to run the searches.
+    Constants,   ///< Buffers kept by the invokers, e.g. transformed or folded weights.
+    CodeObjects, ///< Binaries of the loaded programs.
+    Rocblas,     ///< Device memory of the rocBLAS handles.
+    Count,
+};
+
+/// Device memory held by the library per category, with the high-water marks since the handle
+/// has been created or the marks have been reset. The buffers returned by Handle::Create() are
+/// accounted until they are freed, which may happen after the handle is destroyed.
+///
+/// It also keeps the largest workspace required by the solutions the searches and the queries
+/// of the immediate mode have selected, which is the workspace a deployment running the same
+/// problems needs, unlike the maximum over all the solutions returned by
+/// miopenConvolutionForwardGetWorkSpaceSize() and the like.
+class MemoryUsage
+{
+    public:
+    void Add(MemoryCategory category, std::size_t bytes);
+    void Remove(MemoryCategory category, std::size_t bytes);
+    /// For the categories which are queried rather than tracked.
+    void Set(MemoryCategory category, std::size_t bytes);
+    void AddSelectedWorkspace(std::size_t bytes);
+
+    std::size_t Get(MemoryCategory category) const { return At(category).current.load(); }
+    std::size_t GetPeak(MemoryCategory category) const { return At(category).peak.load(); }
+    std::size_t GetTotal() const { return total.current.load(); }
+    std::size_t GetTotalPeak() const { return total.peak.load(); }
+    std::size_t GetSelectedWorkspacePeak() const { return selected_workspace.load(); }
+
+    /// Lowers the high-water marks to the current usage.
+    void ResetPeaks();
+    /// {"buffers": {"current": <bytes>, "peak": <bytes>}, ..., "total": {...},
+    ///  "selected_workspace_peak": <bytes>}
+    std::string ToJson() const;
+
+    private:
+    struct Counter
+    {
+        std::atomic<std::size_t> current{0};
+        std::atomic<std::size_t> peak{0};
+
+        void Add(std::size_t bytes);
+    };
+
+    const Counter& At(MemoryCategory category) const
+    {
+        return counters[static_cast<std::size_t>(category)];
+    }
+    Counter& At(MemoryCategory category) { return counters[static_cast<std::size_t>(category)]; }
+
+    std::array<Counter, static_cast<std::size_t>(MemoryCategory::Count)> counters{};
+    Counter total;
+    std::atomic<std::size_t> selected_workspace{0};
+};
+
+/// Sets the category of the buffers returned by Handle::Create() on this thread while alive.
+class MemoryCategoryScope
+{
+    public:
+    explicit MemoryCategoryScope(MemoryCategory category);
+    ~MemoryCategoryScope();
+    MemoryCategoryScope(const MemoryCategoryScope&) = delete;
+    MemoryCategoryScope& operator=(const MemoryCategoryScope&) = delete;
+
+    static MemoryCategory Current();
+
+    private:
+    MemoryCategory previous;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MEMORY_USAGE_HPP_
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_METRICS_HPP_
+#define GUARD_MIOPEN_METRICS_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+struct Handle;
+
+enum class Metric
+{
+    InvokerCacheHits,
+    InvokerCacheMisses,
+    KernelCacheHits,
+    KernelCacheMisses,
+    BinaryCacheHits,
+    BinaryCacheMisses,
+    FindDbHits,
+    FindDbMisses,
+    Compiles,
+    CompileUs, ///< Wall time of the kernel builds, microseconds.
+    Finds,
+    FindUs, ///< Wall time of the searches run on find-db misses, microseconds.
+    Allocations,
+    AllocatedBytes, ///< Through Handle::Create().
+    Count,
+};
+
+/// Lock-free counters of the cache lookups, builds, searches and allocations, kept per handle
+/// and for the whole process. Unlike CompileStats, these are cheap enough to be always on and
+/// meant for monitoring in production.
+///
+/// miopenGetMetrics() returns them as JSON. The process counters are also written to the file
+/// set by MIOPEN_METRICS_FILE whenever a handle is destroyed and, if MIOPEN_METRICS_INTERVAL_S
+/// is set, at most that often while they change.
+class Metrics
+{
+    public:
+    static Metrics& Process();
+
+    void Add(Metric metric, std::uint64_t value = 1)
+    {
+        counters[static_cast<std::size_t>(metric)].fetch_add(value, std::memory_order_relaxed);
+    }
+    std::uint64_t Get(Metric metric) const
+    {
+        return counters[static_cast<std::size_t>(metric)].load(std::memory_order_relaxed);
+    }
+
+    /// {"invoker_cache_hits": <count>, ..., "compile_us": <us>, ...}
+    std::string ToJson() const;
+    void Reset();
+    /// Writes ToJson() of the process counters to MIOPEN_METRICS_FILE, if set.
+    static void Dump();
+    /// Dump() unless it has been done less than MIOPEN_METRICS_INTERVAL_S seconds ago.
+    static void DumpIfDue();
+
+    private:
+    std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Metric::Count)> counters{};
+};
+
+/// Adds to the counters of the handle and of the process.
+void AddMetric(const Handle& handle, Metric metric, std::uint64_t value = 1);
+/// Counts an event of \p ms milliseconds in \p count and its time in \p us.
+void AddMetricTime(const Handle& handle, Metric count, Metric us, double ms);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_METRICS_HPP_
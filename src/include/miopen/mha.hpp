@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MHA_HPP_
+#define GUARD_MIOPEN_MHA_HPP_
+
+#include <miopen/common.hpp>
+
+#include <cstddef>
+
+namespace miopen {
+
+struct DropoutDescriptor;
+struct Handle;
+struct TensorDescriptor;
+
+/// Fused scaled dot product attention o = dropout(softmax(scale * q * k^T + mask)) * v of packed
+/// [B, H, S, D] tensors, q and o with Sq queries, k and v with Sk keys. The causal mask hides the
+/// keys after the query. lse is a float buffer with the log-sum-exp of every one of the B * H * Sq
+/// query rows, from which backward recomputes the probabilities. The dropout descriptor, if
+/// any, has to use MIOPEN_RNG_PHILOX without a saved mask; backward replays the mask.
+void MhaForward(Handle& handle,
+                const TensorDescriptor& qDesc,
+                ConstData_t q,
+                const TensorDescriptor& kDesc,
+                ConstData_t k,
+                const TensorDescriptor& vDesc,
+                ConstData_t v,
+                float scale,
+                bool causal,
+                const DropoutDescriptor* dropoutDesc,
+                const TensorDescriptor& oDesc,
+                Data_t o,
+                Data_t lse);
+
+std::size_t GetMhaBackwardWorkspaceSize(const TensorDescriptor& qDesc);
+
+/// o and lse are the ones of MhaForward with the same arguments.
+void MhaBackward(Handle& handle,
+                 const TensorDescriptor& qDesc,
+                 ConstData_t q,
+                 const TensorDescriptor& kDesc,
+                 ConstData_t k,
+                 const TensorDescriptor& vDesc,
+                 ConstData_t v,
+                 const TensorDescriptor& oDesc,
+                 ConstData_t o,
+                 const TensorDescriptor& doDesc,
+                 ConstData_t dout,
+                 ConstData_t lse,
+                 float scale,
+                 bool causal,
+                 const DropoutDescriptor* dropoutDesc,
+                 const TensorDescriptor& dqDesc,
+                 Data_t dq,
+                 const TensorDescriptor& dkDesc,
+                 Data_t dk,
+                 const TensorDescriptor& dvDesc,
+                 Data_t dv,
+                 Data_t workSpace,
+                 std::size_t workSpaceSize);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MHA_HPP_
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/invoke_params.hpp>
+#include <miopen/tensor.hpp>
+
+namespace miopen {
+namespace mha {
+
+struct InvokeParams : public miopen::InvokeParams
+{
+    InvokeParams() = default;
+
+    ConstData_t q = nullptr;
+    ConstData_t k = nullptr;
+    ConstData_t v = nullptr;
+    Data_t o      = nullptr;
+    Data_t lse    = nullptr;
+    float scale   = 1;
+
+    // Dropout of the probabilities
+    double dropout            = 0;
+    double dropout_scale      = 1;
+    unsigned long long seed   = 0;
+    unsigned long long offset = 0;
+};
+
+struct BwdInvokeParams : public miopen::InvokeParams
+{
+    BwdInvokeParams() = default;
+
+    ConstData_t q             = nullptr;
+    ConstData_t k             = nullptr;
+    ConstData_t v             = nullptr;
+    ConstData_t o             = nullptr;
+    ConstData_t dout          = nullptr;
+    ConstData_t lse           = nullptr;
+    Data_t dq                 = nullptr;
+    Data_t dk                 = nullptr;
+    Data_t dv                 = nullptr;
+    Data_t workSpace          = nullptr;
+    std::size_t workSpaceSize = 0;
+    float scale               = 1;
+
+    // Dropout of the probabilities
+    double dropout            = 0;
+    double dropout_scale      = 1;
+    unsigned long long seed   = 0;
+    unsigned long long offset = 0;
+};
+
+} // namespace mha
+
+} // namespace miopen
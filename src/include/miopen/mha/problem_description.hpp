@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+
+namespace miopen {
+
+struct NetworkConfig;
+
+namespace mha {
+
+enum class Direction
+{
+    Forward,
+    Backward,
+};
+
+/// q is [B, H, Sq, D], k and v are [B, H, Sk, D].
+struct ProblemDescription
+{
+    ProblemDescription(Direction direction_,
+                       const TensorDescriptor& qDesc_,
+                       const TensorDescriptor& kDesc_,
+                       bool causal_,
+                       bool dropout_)
+        : direction(direction_), qDesc(qDesc_), kDesc(kDesc_), causal(causal_), dropout(dropout_)
+    {
+    }
+
+    Direction GetDirection() const { return direction; }
+    const TensorDescriptor& GetQDesc() const { return qDesc; }
+    const TensorDescriptor& GetKDesc() const { return kDesc; }
+    bool IsCausal() const { return causal; }
+    /// Philox dropout of the probabilities
+    bool HasDropout() const { return dropout; }
+
+    std::size_t GetBatchHeads() const { return qDesc.GetLengths()[0] * qDesc.GetLengths()[1]; }
+    std::size_t GetQueries() const { return qDesc.GetLengths()[2]; }
+    std::size_t GetKeys() const { return kDesc.GetLengths()[2]; }
+    std::size_t GetHeadDim() const { return qDesc.GetLengths()[3]; }
+
+    /// The float dot products of the output and its gradient, a value per query row.
+    std::size_t GetBackwardWorkspaceSize() const
+    {
+        return GetBatchHeads() * GetQueries() * sizeof(float);
+    }
+
+    NetworkConfig MakeNetworkConfig() const;
+
+    private:
+    Direction direction;
+    TensorDescriptor qDesc;
+    TensorDescriptor kDesc;
+    bool causal  = false;
+    bool dropout = false;
+};
+
+} // namespace mha
+
+} // namespace miopen
@@ -67,6 +67,11 @@ extern "C" {
  * * Dynamic Hybrid: This mode is similar to Fast Hybrid, but in case of Find-db miss skips all
  * non-dynamic kernels, thus saving compilation time. Versus Fast Hybrid, we expect similar start-up
  * times but better GPU performance.
+ *
+ * * Budgeted: Checks the Find-db for an entry. If there is a hit, use that entry. If there is a
+ * miss, measures the dynamic solutions in the order of the Immediate mode heuristic until the
+ * budget set by MIOPEN_FIND_BUDGET_MS (1000 ms by default) is spent, and returns the best ones
+ * found so far. Results are stored as provisional, so that the next Find in other modes refines them.
  */
 typedef enum
 {
@@ -75,6 +80,7 @@ typedef enum
     miopenConvolutionFindModeHybrid        = 3, /*!< Hybrid mode */
     miopenConvolutionFindModeFastHybrid    = 4, /*!< Fast Hybrid mode */
     miopenConvolutionFindModeDynamicHybrid = 5, /*!< Dynamic Hybrid mode */
+    miopenConvolutionFindModeBudgeted      = 6, /*!< Budgeted mode */
     miopenConvolutionFindModeDefault =
         miopenConvolutionFindModeDynamicHybrid, /*!< Default setting */
 } miopenConvolutionFindMode_t;
@@ -713,14 +713,20 @@ struct mlo_construct_norm : mlo_construct_activ_lrn_pooling_common
 
     void mloConstruct();
 
+    /// The forward kernel expects the shape of the tensors in its trailing arguments: batch
+    /// size, the batch, channel and row strides of the input and of the output, and the output
+    /// width and height. Only its tiling is compiled in, see MIOPEN_DEBUG_LRN_DYNAMIC_SHAPE.
+    bool isDynamicShape() const { return _dynamic_shape; }
+
     protected:
     int mloConstructFwd();
     int mloConstructBwd();
-    int _norm_region  = 0;
-    int _norm_area    = 0;
-    double _normAlpha = 0.0;
-    double _normBeta  = 0.0;
-    double _normK     = 0.0;
+    int _norm_region    = 0;
+    int _norm_area      = 0;
+    double _normAlpha   = 0.0;
+    double _normBeta    = 0.0;
+    double _normK       = 0.0;
+    bool _dynamic_shape = false;
 };
 
 struct mlo_construct_neuron : mlo_construct_activ_lrn_pooling_common
@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
 
 namespace miopen {
@@ -33,12 +35,25 @@ namespace miopen {
 struct NetworkConfig
 {
     NetworkConfig() = default;
-    explicit NetworkConfig(const std::string& value_) : value(value_) {}
+    explicit NetworkConfig(const std::string& value_)
+        : value(value_), hash(std::hash<std::string>{}(value_))
+    {
+    }
     operator std::string() const { return value; }
-    std::string ToString() const { return value; }
+    const std::string& ToString() const { return value; }
+    /// Computed once on construction, so hot paths (e.g. the invoker cache lookup)
+    /// do not need to rehash or copy the string.
+    uint64_t GetHash() const { return hash; }
+
+    bool operator==(const NetworkConfig& other) const
+    {
+        return hash == other.hash && value == other.value;
+    }
+    bool operator!=(const NetworkConfig& other) const { return !(*this == other); }
 
     private:
     std::string value;
+    uint64_t hash = 0;
 };
 
 struct AlgorithmName
@@ -46,7 +61,7 @@ struct AlgorithmName
     AlgorithmName() = default;
     explicit AlgorithmName(const std::string& value_) : value(value_) {}
     operator std::string() const { return value; }
-    std::string ToString() const { return value; }
+    const std::string& ToString() const { return value; }
 
     private:
     std::string value;
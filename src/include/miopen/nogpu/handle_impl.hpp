@@ -58,6 +58,7 @@ struct HandleImpl
     std::size_t max_mem_alloc_size = 0;
     Allocator allocator{};
     KernelCache cache;
+    HipEventPool event_pool;
     std::int64_t ctx;
     TargetProperties target_properties;
 };
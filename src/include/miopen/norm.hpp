@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_NORM_HPP_
+#define GUARD_MIOPEN_NORM_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/miopen.h>
+
+namespace miopen {
+
+struct ActivationDescriptor;
+struct DropoutDescriptor;
+struct Handle;
+struct TensorDescriptor;
+
+namespace norm {
+
+enum class Mode
+{
+    Layer,
+    Group,
+};
+
+} // namespace norm
+
+/// Layer and group normalization with an optional residual added to x before and an optional
+/// activation applied after the affine transform. mode_arg is the first normalized dimension of
+/// the layer norm and the number of groups of the group norm. weight and bias are either both
+/// set or both null, mean and rstd are float buffers with a value per normalized row.
+/// A dropout descriptor applies dropout to x before the residual is added. Its mask is drawn
+/// by the counter-based MIOPEN_RNG_PHILOX generator, which backward replays, so it is stored
+/// nowhere.
+void NormForward(Handle& handle,
+                 norm::Mode mode,
+                 int mode_arg,
+                 const TensorDescriptor& xDesc,
+                 ConstData_t x,
+                 ConstData_t residual,
+                 const TensorDescriptor& weightDesc,
+                 ConstData_t weight,
+                 ConstData_t bias,
+                 double epsilon,
+                 const ActivationDescriptor& activDesc,
+                 const TensorDescriptor& yDesc,
+                 Data_t y,
+                 Data_t mean,
+                 Data_t rstd,
+                 const DropoutDescriptor* dropoutDesc = nullptr);
+
+/// dx is the gradient of the residual too, unless there is dropout: the gradient of the residual
+/// then goes to dresidual. mean and rstd are the ones saved by NormForward.
+void NormBackward(Handle& handle,
+                  norm::Mode mode,
+                  int mode_arg,
+                  const TensorDescriptor& xDesc,
+                  ConstData_t x,
+                  ConstData_t residual,
+                  const TensorDescriptor& dyDesc,
+                  ConstData_t dy,
+                  const TensorDescriptor& weightDesc,
+                  ConstData_t weight,
+                  ConstData_t bias,
+                  const ActivationDescriptor& activDesc,
+                  ConstData_t mean,
+                  ConstData_t rstd,
+                  const TensorDescriptor& dxDesc,
+                  Data_t dx,
+                  Data_t dweight,
+                  Data_t dbias,
+                  const DropoutDescriptor* dropoutDesc = nullptr,
+                  Data_t dresidual                     = nullptr);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_NORM_HPP_
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/activ.hpp>
+#include <miopen/norm.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cassert>
+#include <string>
+
+namespace miopen {
+
+struct NetworkConfig;
+
+namespace norm {
+
+enum class Direction
+{
+    Forward,
+    Backward,
+};
+
+/// The tensor is normalized as GetRows() rows of GetRowLength() contiguous elements. The affine
+/// parameter of element k of row r is (r % GetParamGroups()) * (K / D) + k / D, with D being
+/// GetParamDiv() and K the row length.
+struct ProblemDescription
+{
+    // Forward
+    ProblemDescription(Mode mode_,
+                       int mode_arg_,
+                       const TensorDescriptor& xDesc_,
+                       const TensorDescriptor& yDesc_,
+                       const TensorDescriptor& weightDesc_,
+                       const ActivationDescriptor& activDesc_,
+                       bool affine_,
+                       bool residual_,
+                       bool saveStats_,
+                       bool dropout_ = false)
+        : direction(Direction::Forward),
+          mode(mode_),
+          mode_arg(mode_arg_),
+          xDesc(xDesc_),
+          yOrDyDesc(yDesc_),
+          weightDesc(weightDesc_),
+          activDesc(activDesc_),
+          affine(affine_),
+          residual(residual_),
+          saveStats(saveStats_),
+          dropout(dropout_)
+    {
+    }
+
+    // Backward
+    ProblemDescription(Mode mode_,
+                       int mode_arg_,
+                       const TensorDescriptor& xDesc_,
+                       const TensorDescriptor& dyDesc_,
+                       const TensorDescriptor& dxDesc_,
+                       const TensorDescriptor& weightDesc_,
+                       const ActivationDescriptor& activDesc_,
+                       bool affine_,
+                       bool residual_,
+                       bool dropout_ = false)
+        : direction(Direction::Backward),
+          mode(mode_),
+          mode_arg(mode_arg_),
+          xDesc(xDesc_),
+          yOrDyDesc(dyDesc_),
+          dxDesc(dxDesc_),
+          weightDesc(weightDesc_),
+          activDesc(activDesc_),
+          affine(affine_),
+          residual(residual_),
+          dropout(dropout_)
+    {
+    }
+
+    Direction GetDirection() const { return direction; }
+    Mode GetMode() const { return mode; }
+    const TensorDescriptor& GetXDesc() const { return xDesc; }
+    const TensorDescriptor& GetWeightDesc() const { return weightDesc; }
+    const ActivationDescriptor& GetActivDesc() const { return activDesc; }
+
+    const TensorDescriptor& GetYDesc() const
+    {
+        assert(direction == Direction::Forward);
+        return yOrDyDesc;
+    }
+
+    const TensorDescriptor& GetDYDesc() const
+    {
+        assert(direction == Direction::Backward);
+        return yOrDyDesc;
+    }
+
+    const TensorDescriptor& GetDXDesc() const
+    {
+        assert(direction == Direction::Backward);
+        return dxDesc;
+    }
+
+    bool IsAffine() const { return affine; }
+    bool HasResidual() const { return residual; }
+    /// Philox dropout applied to x before the residual is added
+    bool HasDropout() const { return dropout; }
+
+    bool GetSaveStats() const
+    {
+        assert(direction == Direction::Forward);
+        return saveStats;
+    }
+
+    std::size_t GetRows() const;
+    std::size_t GetRowLength() const;
+    std::size_t GetParamGroups() const;
+    std::size_t GetParamDiv() const;
+    std::size_t GetParamCount() const { return GetParamGroups() * GetRowLength() / GetParamDiv(); }
+
+    NetworkConfig MakeNetworkConfig() const;
+
+    private:
+    Direction direction;
+    Mode mode;
+    int mode_arg;
+    TensorDescriptor xDesc;
+    TensorDescriptor yOrDyDesc;
+    TensorDescriptor dxDesc;
+    TensorDescriptor weightDesc;
+    ActivationDescriptor activDesc;
+    bool affine    = false;
+    bool residual  = false;
+    bool saveStats = false;
+    bool dropout   = false;
+};
+
+} // namespace norm
+
+} // namespace miopen
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/solver.hpp>
+
+#include <cstddef>
+#include <utility>
+
+namespace miopen {
+
+class KernelBuildParameters;
+struct TensorDescriptor;
+
+namespace norm {
+struct ProblemDescription;
+} // namespace norm
+
+namespace solver {
+
+namespace norm {
+
+using OldStyleProblemDescription =
+    std::tuple<const ExecutionContext*, const miopen::norm::ProblemDescription*>;
+
+/// Work-group size and register caching of the kernels which normalize a row in a work-group.
+struct NormRowGeometry
+{
+    NormRowGeometry(std::size_t row_length);
+
+    std::size_t grp0;
+    std::size_t ept;
+    bool cached;
+};
+
+/// Checks shared by both directions, out is y or dx.
+bool IsNormApplicable(const miopen::norm::ProblemDescription& problem,
+                      const TensorDescriptor& out);
+
+/// Kernel defines shared by all the kernels of MIOpenNorm.cl.
+KernelBuildParameters GetNormBuildParams(const miopen::norm::ProblemDescription& problem);
+
+struct NormFwd : public SolverBase<OldStyleProblemDescription>
+{
+    inline bool IsApplicable(const OldStyleProblemDescription& problem) const
+    {
+        return IsApplicable(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    inline ConvSolution GetSolution(const OldStyleProblemDescription& problem) const
+    {
+        return GetSolution(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::norm::ProblemDescription& problem) const;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::norm::ProblemDescription& problem) const;
+};
+
+struct NormBwd : public SolverBase<OldStyleProblemDescription>
+{
+    inline bool IsApplicable(const OldStyleProblemDescription& problem) const
+    {
+        return IsApplicable(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    inline ConvSolution GetSolution(const OldStyleProblemDescription& problem) const
+    {
+        return GetSolution(*std::get<0>(problem), *std::get<1>(problem));
+    }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::norm::ProblemDescription& problem) const;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::norm::ProblemDescription& problem) const;
+};
+
+} // namespace norm
+
+} // namespace solver
+
+} // namespace miopen
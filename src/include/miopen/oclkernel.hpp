@@ -95,6 +95,22 @@ struct OCLKernelInvoke
     std::array<size_t, 3> ldims = {};
     std::function<void(cl_event&)> callback;
 
+    void operator()(const PackedKernelArgs& args) const
+    {
+        for(size_t idx = 0; idx < args.GetCount(); idx++)
+        {
+            cl_int status = clSetKernelArg(
+                kernel.get(), idx, args.GetSize(idx), args.data() + args.GetOffset(idx));
+            if(status != CL_SUCCESS)
+            {
+                MIOPEN_THROW("Error setting argument #" + std::to_string(idx) +
+                             " to kernel (size = " + std::to_string(args.GetSize(idx)) +
+                             "): " + OpenCLErrorMessage(status));
+            }
+        }
+        run();
+    }
+
     void operator()(std::vector<OpKernelArg> args) const
     {
         for(size_t idx = 0; idx < args.size(); idx++)
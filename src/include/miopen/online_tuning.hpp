@@ -0,0 +1,116 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_ONLINE_TUNING_HPP_
+#define GUARD_MIOPEN_ONLINE_TUNING_HPP_
+
+#include <miopen/find_timing.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Online tuning samples the times of the immediate mode calls, which are known when profiling
+/// is enabled, and now and then runs another applicable solution of the problem instead of the
+/// requested one. A solution which is consistently faster is written to the user find-db, so
+/// that the following miopenConvolution*GetSolution calls return it first. See
+/// MIOPEN_ONLINE_TUNING and MIOPEN_ONLINE_TUNING_INTERVAL.
+struct OnlineTuningConfig
+{
+    std::size_t interval    = 64;    ///< Calls of a problem per exploring one.
+    std::size_t samples     = 16;    ///< Recent times kept per solution.
+    std::size_t min_samples = 8;     ///< Times of both solutions needed to compare them.
+    float margin            = 0.05f; ///< Relative difference of the times treated as a tie.
+};
+
+bool IsOnlineTuningEnabled();
+const OnlineTuningConfig& GetOnlineTuningConfig();
+
+class OnlineTuner
+{
+    public:
+    struct Candidate
+    {
+        std::string solver;
+        std::size_t workspace;
+    };
+
+    struct Promotion
+    {
+        std::string solver;
+        FindTiming time;
+        FindTiming incumbent_time;
+    };
+
+    explicit OnlineTuner(const OnlineTuningConfig& config_ = {}) : config(config_) {}
+
+    bool HasCandidates(const std::string& problem) const;
+    void SetCandidates(const std::string& problem, std::vector<Candidate> candidates);
+
+    /// Counts a call of the problem. Returns the solution to explore on it, which is the least
+    /// sampled candidate fitting into \p workspace_limit, or none to run \p requested.
+    boost::optional<std::string>
+    Next(const std::string& problem, const std::string& requested, std::size_t workspace_limit);
+
+    void Record(const std::string& problem, const std::string& solver, float time);
+
+    /// Returns the solution which is faster than \p incumbent beyond the noise of both, once
+    /// per such a change.
+    boost::optional<Promotion> TakeWinner(const std::string& problem,
+                                          const std::string& incumbent);
+
+    private:
+    struct Samples
+    {
+        std::vector<float> recent;
+        std::size_t next  = 0;
+        std::size_t total = 0;
+    };
+
+    struct State
+    {
+        std::size_t calls   = 0;
+        bool has_candidates = false;
+        std::vector<Candidate> candidates;
+        std::map<std::string, Samples> samples;
+        std::string promoted;
+    };
+
+    OnlineTuningConfig config;
+    mutable std::mutex mutex;
+    std::map<std::string, State> states;
+
+    FindTiming Summarize(const Samples& samples) const;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_ONLINE_TUNING_HPP_
@@ -1,8 +1,13 @@
 #ifndef MIOPEN_GUARD_MLOPEN_OP_KERNEL_ARGS_HPP
 #define MIOPEN_GUARD_MLOPEN_OP_KERNEL_ARGS_HPP
 
+#include <miopen/errors.hpp>
+
 #include <type_traits>
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
 #include <half.hpp>
 
 #include <boost/container/small_vector.hpp>
@@ -32,4 +37,62 @@ struct OpKernelArg
     bool is_ptr = false;
 };
 
+namespace miopen {
+
+/// Kernel arguments packed once into a buffer laid out like the kernarg segment:
+/// every argument is aligned to its size. Invokers which launch a kernel with the
+/// same argument list many times keep it and patch only the values that change,
+/// usually the buffer pointers, instead of packing all of the arguments per launch.
+class PackedKernelArgs
+{
+    public:
+    PackedKernelArgs() = default;
+
+    explicit PackedKernelArgs(const std::vector<OpKernelArg>& args)
+    {
+        std::size_t size = 0;
+        for(const auto& arg : args)
+        {
+            const auto alignment = arg.size();
+            size += (alignment - (size % alignment)) % alignment;
+            offsets.push_back(size);
+            sizes.push_back(arg.size());
+            size += arg.size();
+        }
+        buffer.resize(size);
+        for(std::size_t i = 0; i < args.size(); ++i)
+            std::memcpy(&buffer[offsets[i]], args[i].buffer.data(), args[i].size());
+    }
+
+    void Set(std::size_t index, const OpKernelArg& arg)
+    {
+        if(index >= sizes.size() || arg.size() != sizes[index])
+            MIOPEN_THROW("Kernel argument #" + std::to_string(index) + " does not match");
+        std::memcpy(&buffer[offsets[index]], arg.buffer.data(), arg.size());
+    }
+
+    template <class T>
+    void Set(std::size_t index, T value)
+    {
+        static_assert(std::is_trivial<T>{}, "Only for trivial types");
+        if(index >= sizes.size() || sizeof(T) != sizes[index])
+            MIOPEN_THROW("Kernel argument #" + std::to_string(index) + " does not match");
+        std::memcpy(&buffer[offsets[index]], &value, sizeof(T));
+    }
+
+    std::size_t GetCount() const { return sizes.size(); }
+    std::size_t GetOffset(std::size_t index) const { return offsets[index]; }
+    std::size_t GetSize(std::size_t index) const { return sizes[index]; }
+
+    const char* data() const { return buffer.data(); }
+    std::size_t size() const { return buffer.size(); }
+
+    private:
+    std::vector<char> buffer;
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> sizes;
+};
+
+} // namespace miopen
+
 #endif
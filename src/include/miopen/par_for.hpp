@@ -28,10 +28,17 @@
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 #ifdef __MINGW32__
@@ -59,24 +66,134 @@ struct joinable_thread : std::thread
     }
 };
 
-struct thread_factory
+namespace detail {
+
+/// One par_for call. The threads taking part claim chunks of the indices from a shared counter,
+/// so that the fast ones take over the work of the slow ones instead of idling.
+struct par_for_job
 {
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
+    par_for_job(std::size_t n_, std::size_t grainsize_, std::function<void(std::size_t)> body_)
+        : n(n_), grainsize(grainsize_), body(std::move(body_))
+    {
+    }
+
+    /// Runs the chunks until none is left.
+    void work()
+    {
+        for(;;)
+        {
+            const std::size_t start = next.fetch_add(grainsize);
+            if(start >= n)
+                return;
+            const std::size_t last = std::min(n, start + grainsize);
+            try
+            {
+                for(std::size_t i = start; i < last; i++)
+                    body(i);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!error)
+                    error = std::current_exception();
+            }
+            if(done.fetch_add(last - start) + (last - start) == n)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+
+    /// Waits for the chunks claimed by the other threads, rethrowing the first exception.
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return done == n; });
+        if(error)
+            std::rethrow_exception(error);
+    }
+
+    private:
+    const std::size_t n;
+    const std::size_t grainsize;
+    const std::function<void(std::size_t)> body;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+};
+
+/// Threads of the process shared by all the par_for calls, started on demand and kept until the
+/// exit. The calling thread works on its own job too and only waits for the chunks which are
+/// being run by the others, so nested and concurrent calls cannot deadlock even when all the
+/// workers are busy: the job is then finished by its caller alone.
+struct par_for_pool
+{
+    static par_for_pool& get()
+    {
+        static par_for_pool pool;
+        return pool;
+    }
+
+    void run(const std::shared_ptr<par_for_job>& job, std::size_t helpers)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(std::size_t i = 0; i < helpers; i++)
+                jobs.push_back(job);
+            while(workers.size() < helpers)
+                workers.emplace_back([this] { worker(); });
+        }
+        wakeup.notify_all();
+        job->work();
+        job->wait();
+    }
+
+    ~par_for_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wakeup.notify_all();
+        workers.clear();
+    }
+
+    private:
+    par_for_pool() = default;
+
+    void worker()
     {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
+        for(;;)
+        {
+            std::shared_ptr<par_for_job> job;
             {
-                f(i);
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeup.wait(lock, [&] { return stop || !jobs.empty(); });
+                if(stop)
+                    return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
             }
-        });
-        work += grainsize;
-        return result;
+            // Finished jobs are still queued for the helpers that came too late, which return
+            // right away.
+            job->work();
+        }
     }
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<std::shared_ptr<par_for_job>> jobs;
+    std::vector<joinable_thread> workers;
+    bool stop = false;
 };
 
+} // namespace detail
+
+/// Runs \p f on the indices [0, n) with \p threadsize threads at most, the calling one included.
+/// The indices are handed out in chunks of about an eighth of the share of a thread.
 template <class F>
 void par_for_impl(std::size_t n, std::size_t threadsize, F f)
 {
@@ -87,14 +204,9 @@ void par_for_impl(std::size_t n, std::size_t threadsize, F f)
     }
     else
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        const std::size_t grainsize = std::max<std::size_t>(1, n / (threadsize * 8));
+        auto job = std::make_shared<detail::par_for_job>(n, grainsize, f);
+        detail::par_for_pool::get().run(job, threadsize - 1);
     }
 }
 
@@ -136,16 +248,21 @@ void par_for(std::size_t n, max_threads mt, F f)
     par_for_impl(n, std::min(threadsize, n), f);
 }
 
+/// Meant for few uneven items such as the kernels to compile, which are handed out one at a time
+/// to at most \p mt threads, e.g. MIOPEN_COMPILE_PARALLEL_LEVEL.
 template <class F>
 void par_for_strided(std::size_t n, max_threads mt, F f)
 {
-    auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), mt.n);
-    par_for_impl(threadsize, threadsize, [&](auto start) {
-        for(std::size_t i = start; i < n; i += threadsize)
-        {
+    const auto threadsize =
+        std::min({static_cast<std::size_t>(std::thread::hardware_concurrency()), mt.n, n});
+    if(threadsize <= 1)
+    {
+        for(std::size_t i = 0; i < n; i++)
             f(i);
-        }
-    });
+        return;
+    }
+    auto job = std::make_shared<detail::par_for_job>(n, 1, f);
+    detail::par_for_pool::get().run(job, threadsize - 1);
 }
 
 } // namespace miopen
@@ -29,7 +29,9 @@
 #include <miopen/errors.hpp>
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/serializable.hpp>
+#include <miopen/solver_id.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <string>
 
@@ -54,20 +56,71 @@ struct FindDbData : solver::Serializable<FindDbData>
     /// solver doesn't use kernel cache and doesn't require a validation of built kernel existence.
     // Todo: remove when all finds will support invokers
     FindDbKCacheKey kcache_key;
+    /// Db version of the solver at the time the entry was found. Entries which are written
+    /// before the field has been introduced have no such value and are read as version 1.
+    int solver_version;
+    /// Non-zero if the entry was found by the budgeted find mode and the search has been cut
+    /// short, so that a later non-budgeted find refines it.
+    int provisional;
+    /// Number of the measurements the time is summarized from, see FindTiming.
+    int trials;
+    /// Interquartile range of the measurements relative to the time.
+    float spread;
+    /// Time scaled to the max clock of the device, zero if the clock was unknown. Unlike the
+    /// time, it is comparable between the nodes which ran at different clocks.
+    float norm_time;
 
-    FindDbData() : solver_id("<invalid>"), time(-1), workspace(-1) {}
+    FindDbData()
+        : solver_id("<invalid>"),
+          time(-1),
+          workspace(-1),
+          solver_version(1),
+          provisional(0),
+          trials(1),
+          spread(0),
+          norm_time(0)
+    {
+    }
 
     FindDbData(const std::string& solver_id_,
                float time_,
                std::size_t workspace_,
-               const FindDbKCacheKey& kcache_key_)
-        : solver_id(solver_id_), time(time_), workspace(workspace_), kcache_key(kcache_key_)
+               const FindDbKCacheKey& kcache_key_,
+               bool provisional_ = false)
+        : solver_id(solver_id_),
+          time(time_),
+          workspace(workspace_),
+          kcache_key(kcache_key_),
+          solver_version(solver::Id{solver_id_}.GetDbVersion()),
+          provisional(provisional_ ? 1 : 0),
+          trials(1),
+          spread(0),
+          norm_time(0)
     {
         if(!kcache_key.IsValid())
             MIOPEN_THROW("Invalid kernel cache key: " + kcache_key.algorithm_name + ", " +
                          kcache_key.network_config);
     }
 
+    /// True if the solver has changed its db version since the entry was found.
+    bool IsStale() const { return solver_version != solver::Id{solver_id}.GetDbVersion(); }
+
+    bool Deserialize(const std::string& s)
+    {
+        // Older entries lack some of the trailing fields, which then take their defaults:
+        // solver_version, provisional, trials, spread and norm_time in this order.
+        static const char* const defaults[] = {",1", ",0", ",1", ",0", ",0"};
+        constexpr auto first_optional       = 5;
+        constexpr auto total                = first_optional + 5;
+
+        auto padded = s;
+        for(auto field = std::count(s.begin(), s.end(), ',') + 1;
+            first_optional <= field && field < total;
+            ++field)
+            padded += defaults[field - first_optional];
+        return solver::Serializable<FindDbData>::Deserialize(padded);
+    }
+
     template <class Self, class F>
     static void Visit(Self&& self, F f)
     {
@@ -76,6 +129,11 @@ struct FindDbData : solver::Serializable<FindDbData>
         f(self.workspace, "workspace");
         f(self.kcache_key.algorithm_name, "kcache_key::algorithm_name");
         f(self.kcache_key.network_config, "kcache_key::network_confing");
+        f(self.solver_version, "solver_version");
+        f(self.provisional, "provisional");
+        f(self.trials, "trials");
+        f(self.spread, "spread");
+        f(self.norm_time, "norm_time");
     }
 };
 
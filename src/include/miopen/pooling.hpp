@@ -66,6 +66,14 @@ struct PoolingDescriptor : miopenPoolingDescriptor
 
     miopenPoolingWorkspaceIndexMode_t GetWorkspaceIndexMode() const;
 
+    /// Fixes the spatial output size, each output then reduces the input region
+    /// [floor(o * in / out), ceil((o + 1) * in / out)) instead of a window. Empty clears it.
+    void SetAdaptiveOutputLengths(const std::vector<int>& out_lens);
+
+    const std::vector<int>& GetAdaptiveOutputLengths() const;
+
+    bool IsAdaptive() const;
+
     const std::vector<int>& GetLengths() const;
 
     const std::vector<int>& GetStrides() const;
@@ -83,6 +91,10 @@ struct PoolingDescriptor : miopenPoolingDescriptor
 
     std::size_t GetWorkSpaceSize(const TensorDescriptor& yDesc) const;
 
+    /// Bits per index of miopenPoolingWorkspaceIndexMaskPacked: 4 when the window fits a nibble
+    /// and the channels pair up, 8 otherwise.
+    int GetPackedIndexBits(int channels) const;
+
     miopenStatus_t Forward(Handle& handle,
                            const void* alpha,
                            const TensorDescriptor& xDesc,
@@ -112,6 +124,7 @@ struct PoolingDescriptor : miopenPoolingDescriptor
     std::vector<int> lens;
     std::vector<int> strides;
     std::vector<int> pads;
+    std::vector<int> adaptive_lens;
 
     miopenPoolingMode_t mode  = miopenPoolingMax;
     miopenPaddingMode_t pmode = miopenPaddingDefault;
@@ -119,6 +132,9 @@ struct PoolingDescriptor : miopenPoolingDescriptor
     miopenIndexType_t indexType                          = miopenIndexUint8;
     miopenPoolingWorkspaceIndexMode_t workspaceIndexMode = miopenPoolingWorkspaceIndexMask;
 };
+
+/// 4D channel-last tensors run the NHWC kernels, the others need the unit stride on W.
+bool IsPoolingNHWC(const TensorDescriptor& desc);
 } // namespace miopen
 MIOPEN_DEFINE_OBJECT(miopenPoolingDescriptor, miopen::PoolingDescriptor);
 #endif // _MIOPEN_POOLING_HPP_
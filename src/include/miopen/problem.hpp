@@ -0,0 +1,121 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PROBLEM_HPP_
+#define GUARD_MIOPEN_PROBLEM_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/common.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/frozen_solution.hpp>
+#include <miopen/object.hpp>
+#include <miopen/solution.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+struct FindOptions : miopenFindOptions
+{
+    bool tuning                 = false;
+    std::size_t workspace_limit = std::numeric_limits<std::size_t>::max();
+    /// Milliseconds, zero stands for no limit.
+    float time_budget = 0.0f;
+
+    friend std::ostream& operator<<(std::ostream& stream, const FindOptions& options);
+};
+
+/// Convolution problem of the Find 2.0 API. Unlike the Find API, it needs no buffers from
+/// the user, and returns solutions which are keyed by solver rather than by algorithm.
+struct Problem : miopenProblem
+{
+    Problem(const ConvolutionDescriptor& conv_,
+            miopenProblemDirection_t direction_,
+            const TensorDescriptor& x_,
+            const TensorDescriptor& w_,
+            const TensorDescriptor& y_);
+
+    /// Returns the solutions sorted by time. The find-db results are used if there are any
+    /// and tuning is not requested, otherwise the applicable solvers are run on buffers
+    /// allocated here.
+    std::vector<Solution> FindSolutions(Handle& handle,
+                                        const FindOptions& options,
+                                        std::size_t max_solutions) const;
+
+    /// Same as above for several problems at once. The kernels of the problems which are to be
+    /// measured are compiled in one parallel pass, each distinct program once, and equal problems
+    /// are solved once. The results are in the order of \p problems.
+    static std::vector<std::vector<Solution>>
+    FindSolutionsBatch(Handle& handle,
+                       const std::vector<const Problem*>& problems,
+                       const FindOptions& options,
+                       std::size_t max_solutions);
+
+    void Run(Handle& handle,
+             const Solution& solution,
+             Data_t x,
+             Data_t w,
+             Data_t y,
+             Data_t workspace,
+             std::size_t workspace_size) const;
+
+    /// Checks the solution against the problem and builds its invoker, so that the runs of the
+    /// returned object skip all the per-call work of Run().
+    FrozenSolution Freeze(Handle& handle, const Solution& solution) const;
+
+    /// Network config of the problem, which the solutions are checked against.
+    std::string GetKey() const;
+
+    friend std::ostream& operator<<(std::ostream& stream, const Problem& problem);
+
+    private:
+    /// Transposed convolutions are solved as the opposite direction of the ordinary ones,
+    /// with x and y swapped. The members hold the problem after this conversion.
+    ConvolutionDescriptor conv;
+    miopenProblemDirection_t direction;
+    miopenProblemDirection_t user_direction;
+    TensorDescriptor x;
+    TensorDescriptor w;
+    TensorDescriptor y;
+
+    std::vector<miopenConvSolution_t> GetSolutions(Handle& handle, bool& fallback) const;
+    bool NeedsFind(Handle& handle, const FindOptions& options) const;
+    std::size_t GetMaxWorkspaceSize(Handle& handle) const;
+    void RunFind(Handle& handle, const FindOptions& options) const;
+};
+
+} // namespace miopen
+
+MIOPEN_DEFINE_OBJECT(miopenFindOptions, miopen::FindOptions);
+MIOPEN_DEFINE_OBJECT(miopenProblem, miopen::Problem);
+
+#endif // GUARD_MIOPEN_PROBLEM_HPP_
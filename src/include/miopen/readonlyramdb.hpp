@@ -30,12 +30,16 @@
 
 #include <boost/optional.hpp>
 
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <sstream>
 
 namespace miopen {
 
+class MappedDb;
+
 class ReadonlyRamDb
 {
     public:
@@ -43,29 +47,8 @@ class ReadonlyRamDb
 
     static ReadonlyRamDb& GetCached(const std::string& path, bool warn_if_unreadable);
 
-    boost::optional<DbRecord> FindRecord(const std::string& problem) const
-    {
-        MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        const auto it = cache.find(problem);
-
-        if(it == cache.end())
-            return boost::none;
-
-        auto record = DbRecord{problem};
-
-        MIOPEN_LOG_I2("Key match: " << problem);
-        MIOPEN_LOG_I2("Contents found: " << it->second.content);
-
-        if(!record.ParseContents(it->second.content))
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: "
-                         << problem << " form file " << db_path << "#" << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
-            return boost::none;
-        }
-
-        return record;
-    }
+    /// The contents of a record are parsed on the first lookup and memoized.
+    boost::optional<DbRecord> FindRecord(const std::string& problem) const;
 
     template <class TProblem>
     boost::optional<DbRecord> FindRecord(const TProblem& problem) const
@@ -90,17 +73,35 @@ class ReadonlyRamDb
         std::string content;
     };
 
-    std::string db_path;
-    std::unordered_map<std::string, CacheItem> cache;
-
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
+    // Position of a record in the contents of the file.
+    struct IndexItem
+    {
+        std::size_t offset;
+        std::size_t key_size;
+        std::size_t content_size;
+        int line;
+    };
 
+    std::string db_path;
+    // The whole text database, only indexed on load.
+    std::string contents;
+    // Records by the hash of their keys.
+    std::unordered_multimap<std::size_t, IndexItem> index;
+    // Precompiled version of the database, the text one is not loaded if it is used.
+    std::shared_ptr<const MappedDb> mapped;
+
+    mutable std::mutex parsed_mutex;
+    mutable std::unordered_map<std::string, boost::optional<DbRecord>> parsed;
+
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb(ReadonlyRamDb&&)      = delete;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = delete;
+
+    static std::size_t GetKeyHash(const char* key, std::size_t size);
+    boost::optional<CacheItem> FindItem(const std::string& problem) const;
     void Prefetch(const std::string& path, bool warn_if_unreadable);
-    void
-    ParseAndLoadDb(std::istream& input_stream, const std::string& path, bool warn_if_unreadable);
+    void IndexDb(std::string&& db_contents, const std::string& path);
 };
 
 } // namespace miopen
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/reduce_tunables.hpp>
+#include <miopen/reducetensor.hpp>
+#include <miopen/serializable.hpp>
+#include <miopen/tensor.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <functional>
+#include <string>
+
+namespace miopen {
+
+namespace reduce {
+
+struct ProblemDescription
+#if MIOPEN_ENABLE_SQLITE
+    : SQLiteSerializable<ProblemDescription>
+#endif
+{
+    ProblemDescription(const ReduceTensorDescriptor& reduce_,
+                       const TensorDescriptor& aDesc_,
+                       const TensorDescriptor& cDesc_)
+        : reduce(reduce_), aDesc(aDesc_), cDesc(cDesc_)
+    {
+    }
+
+    const ReduceTensorDescriptor& GetReduceDesc() const { return reduce; }
+    const TensorDescriptor& GetADesc() const { return aDesc; }
+    const TensorDescriptor& GetCDesc() const { return cDesc; }
+
+    std::size_t GetInvariantLength() const { return cDesc.GetElementSize(); }
+    std::size_t GetToReduceLength() const
+    {
+        return aDesc.GetElementSize() / cDesc.GetElementSize();
+    }
+
+    bool NeedIndices() const;
+
+    /// The perf-db key, e.g. 64x56x56x32-1110-packed-FP32-FP32-FP32-op0-n0-i0
+    void Serialize(std::ostream& stream) const;
+
+    static std::string table_name() { return "reduce_config"; }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(int, std::string)> f)
+    {
+        f(static_cast<int>(self.aDesc.IsPacked() && self.cDesc.IsPacked()), "packed");
+        f(static_cast<int>(self.reduce.reduceTensorOp_), "op");
+        f(static_cast<int>(self.reduce.reduceTensorNanOpt_), "nan_opt");
+        f(static_cast<int>(self.NeedIndices()), "indices");
+    }
+
+    template <class Self>
+    static void Visit(Self&& self, std::function<void(std::string, std::string)> f)
+    {
+        f(self.GetLengthsName(), "lengths");
+        f(self.GetReduceDimsName(), "reduce_dims");
+        f(GetDataTypeName(self.aDesc.GetType()), "src_type");
+        f(GetDataTypeName(self.reduce.reduceTensorCompType_), "comp_type");
+        f(GetDataTypeName(self.cDesc.GetType()), "dst_type");
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
+    {
+        obj.Serialize(os);
+        return os;
+    }
+
+    private:
+    std::string GetLengthsName() const;
+    std::string GetReduceDimsName() const;
+
+    ReduceTensorDescriptor reduce;
+    TensorDescriptor aDesc;
+    TensorDescriptor cDesc;
+};
+
+/// The tunable parameters of the generic (composable kernel) reduction as they are stored in the
+/// perf-db. Only the fields used by the reduction methods the problem maps to are searched, the
+/// others keep their default values.
+struct PerformanceConfigReduce : solver::Serializable<PerformanceConfigReduce>
+{
+    int block_size;                   // 2^n[128..512]
+    int thread_buffer_length;         // 2^n[4..16], direct thread-wise reduction
+    int accesses_per_thread_in_block; // 2^n[1..4], block-wise and multi-block reductions
+    int accesses_per_thread_in_warp;  // 2^n[1..4], direct warp-wise reduction
+
+    PerformanceConfigReduce(const tunable_generic_reduction& tunable)
+        : block_size(tunable.BlockSize),
+          thread_buffer_length(tunable.GredThreadBufferLength),
+          accesses_per_thread_in_block(tunable.GredAccessesPerThreadInBlock),
+          accesses_per_thread_in_warp(tunable.GredAccessesPerThreadInWarp)
+    {
+    }
+    PerformanceConfigReduce() : PerformanceConfigReduce(default_tunable_generic_reduction) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.block_size, "block_size");
+        f(self.thread_buffer_length, "thread_buffer_length");
+        f(self.accesses_per_thread_in_block, "accesses_per_thread_in_block");
+        f(self.accesses_per_thread_in_warp, "accesses_per_thread_in_warp");
+    }
+
+    tunable_generic_reduction GetTunable() const
+    {
+        return {block_size,
+                thread_buffer_length,
+                accesses_per_thread_in_block,
+                accesses_per_thread_in_warp};
+    }
+
+    /// The smallest block size of the search space, which needs the largest workspace.
+    static int MinBlockSize() { return 128; }
+
+    bool IsValidValue() const;
+    bool SetNextValue();
+    bool IsValid(const ProblemDescription& problem, int warp_size) const;
+    bool operator==(const PerformanceConfigReduce& other) const;
+};
+
+} // namespace reduce
+
+} // namespace miopen
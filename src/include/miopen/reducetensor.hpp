@@ -61,7 +61,7 @@ struct ReduceTensorDescriptor : miopenReduceTensorDescriptor
                                  const TensorDescriptor& outDesc) const;
     std::size_t GetIndicesSize(const TensorDescriptor& inDesc,
                                const TensorDescriptor& outDesc) const;
-    void ReduceTensor(const Handle& handle,
+    void ReduceTensor(Handle& handle,
                       Data_t indices,
                       size_t indicesSizeInBytes,
                       Data_t workspace,
@@ -72,6 +72,25 @@ struct ReduceTensorDescriptor : miopenReduceTensorDescriptor
                       const void* beta,
                       const TensorDescriptor& cDesc,
                       Data_t C) const;
+
+    std::size_t GetSegmentedWorkspaceSize(const Handle& handle,
+                                          const TensorDescriptor& inDesc,
+                                          const TensorDescriptor& outDesc) const;
+    /// Reduces the rows [offsets[s], offsets[s + 1]) of the leading dimension of A to row s of C.
+    /// offsets holds cDesc.GetLengths()[0] + 1 ascending int32 values in device memory; the
+    /// indices are the offsets of the selected rows in their segment.
+    void ReduceTensorSegmented(Handle& handle,
+                               Data_t indices,
+                               size_t indicesSizeInBytes,
+                               Data_t workspace,
+                               size_t workspaceSizeInBytes,
+                               ConstData_t offsets,
+                               const void* alpha,
+                               const TensorDescriptor& aDesc,
+                               ConstData_t A,
+                               const void* beta,
+                               const TensorDescriptor& cDesc,
+                               Data_t C) const;
 };
 
 std::ostream& operator<<(std::ostream& stream, const ReduceTensorDescriptor& c);
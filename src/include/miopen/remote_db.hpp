@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_REMOTE_DB_HPP_
+#define GUARD_MIOPEN_REMOTE_DB_HPP_
+
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace miopen {
+
+/// Client of a remote tuning database shared by many machines. Records missing from both
+/// local databases are fetched from it, and records written to the user database are
+/// published to it in the background.
+///
+/// The transport is an external command set by MIOPEN_REMOTE_DB_COMMAND, e.g. a script
+/// around curl or a gRPC client, which is invoked as:
+///   <command> get <db> <key>  prints the contents of the record ("id:values;...") and
+///                             exits with 0, or exits with non-zero if there is none;
+///   <command> put <db> <key>  reads the contents from stdin and merges them into
+///                             the remote record.
+/// <db> is the file name of the installed database, which identifies the target.
+class RemoteDb
+{
+    public:
+    RemoteDb(const std::string& command_);
+    RemoteDb(const RemoteDb&) = delete;
+    RemoteDb& operator=(const RemoteDb&) = delete;
+    /// Waits for the pending publications.
+    ~RemoteDb();
+
+    /// \return Null unless enabled.
+    static RemoteDb* Get();
+    /// \return Name of the remote database for the installed one, empty unless enabled.
+    static std::string GetName(const std::string& installed_path);
+
+    static const std::string& GetKey(const std::string& key) { return key; }
+    static const std::string& GetKey(const DbRecord& record) { return record.GetKey(); }
+    template <class T>
+    static std::string GetKey(const T& problem_config)
+    {
+        return DbRecord::Serialize(problem_config);
+    }
+
+    /// Results, including misses, are memoized for the process lifetime.
+    boost::optional<DbRecord> Fetch(const std::string& db, const std::string& key);
+    void Publish(const std::string& db, const DbRecord& record);
+    void Publish(const std::string& db, const std::string& key, const DbRecord& record);
+    /// Waits until the publications queued so far are done.
+    void Flush();
+
+    private:
+    struct Publication
+    {
+        std::string db;
+        std::string key;
+        std::string contents;
+    };
+
+    std::string command;
+    std::mutex fetched_mutex;
+    std::map<std::pair<std::string, std::string>, boost::optional<DbRecord>> fetched;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::deque<Publication> queue;
+    bool publishing = false;
+    bool stopping   = false;
+    std::thread publisher;
+
+    std::string GetCommand(const char* action, const std::string& db, const std::string& key) const;
+    void PublishLoop();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_REMOTE_DB_HPP_
@@ -27,6 +27,7 @@
 #ifndef GUARD_MIOPEN_RNN_HPP_
 #define GUARD_MIOPEN_RNN_HPP_
 
+#include <miopen/allocator.hpp>
 #include <miopen/common.hpp>
 #include <miopen/dropout.hpp>
 #include <miopen/errors.hpp>
@@ -38,6 +39,7 @@
 
 #include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -93,6 +95,7 @@ struct RNNDescriptor : miopenRNNDescriptor
 
     size_t nHiddenTensorsPerLayer; // TODO dlowell: set via constructor, or "set" functions
     size_t workspaceScale;
+    size_t projSize = 0; // LSTM recurrent projection, 0 without projection
 
     miopenRNNMode_t rnnMode;
     miopenRNNDirectionMode_t dirMode;
@@ -103,6 +106,22 @@ struct RNNDescriptor : miopenRNNDescriptor
     std::size_t typeSize;
     miopenDropoutDescriptor_t dropoutDesc{};
 
+    // Weights re-laid out by PrepareWeights, with the weights and input length they came from
+    std::shared_ptr<Allocator::ManageDataPtr> preparedWeights;
+    ConstData_t preparedWeightsSource{};
+    int preparedInputLen = 0;
+
+    // Recurrent weights quantized by PrepareQuantizedWeights, with the weights and input length
+    // they came from
+    std::shared_ptr<Allocator::ManageDataPtr> quantizedWeights;
+    ConstData_t quantizedWeightsSource{};
+    int quantizedInputLen = 0;
+
+    // With miopenRNNrecompute, the reserve space rebuilt by RNNBackwardData for the following
+    // RNNBackwardWeights
+    mutable std::shared_ptr<Allocator::ManageDataPtr> recomputedReserve;
+    mutable std::size_t recomputedReserveSize = 0;
+
     size_t biasOffsetCalculation(const TensorDescriptor& xDesc, int layer, int biasID) const;
 
     size_t paramsOffsetCalculation(const TensorDescriptor& xDesc, int layer, int paramID) const;
@@ -114,10 +133,18 @@ struct RNNDescriptor : miopenRNNDescriptor
                             int seqLength,
                             c_array_view<const miopenTensorDescriptor_t> xDesc) const;
 
+    size_t GetWorkspaceSizeForRows(std::size_t rows) const;
+
+    /// Workspace of forward inference with a padded [sequence, batch, vector] input
+    size_t GetPaddedWorkspaceSize(Handle& handle, const TensorDescriptor& xDesc) const;
+
     size_t GetReserveSize(Handle& handle,
                           int seqLength,
                           c_array_view<const miopenTensorDescriptor_t> xDesc) const;
 
+    /// Reserve space of the training passes without recomputation
+    size_t GetFullReserveSizeForRows(std::size_t rows) const;
+
     size_t
     GetParamsSize(Handle& handle, const TensorDescriptor& xDesc, miopenDataType_t dtype) const;
 
@@ -179,6 +206,33 @@ struct RNNDescriptor : miopenRNNDescriptor
                             TensorDescriptor& biasDesc,
                             size_t* biasOffset) const;
 
+    /// Row stride of the matrices of the prepared weights, aligned to the GEMM tile
+    std::size_t GetPackedWeightsStride() const;
+
+    /// Copies w once into a buffer allocated from the handle, with every weight matrix
+    /// transposed for the GEMMs of forward inference; the biases follow unchanged
+    void PrepareWeights(Handle& handle,
+                        const TensorDescriptor& xDesc,
+                        const TensorDescriptor& wDesc,
+                        ConstData_t w);
+
+    /// The prepared weights if they come from w for matrices of in_h inputs, null otherwise
+    ConstData_t GetPreparedWeights(ConstData_t w, int in_h) const;
+
+    /// Quantizes the hidden matrix of every layer of w to int8, with a float scale per row, into
+    /// a buffer allocated from the handle for the persistent kernel of forward inference. The
+    /// scales of all the layers come first, then the int8 matrices.
+    void PrepareQuantizedWeights(Handle& handle,
+                                 const TensorDescriptor& xDesc,
+                                 const TensorDescriptor& wDesc,
+                                 ConstData_t w);
+
+    /// The quantized weights if they come from w for matrices of in_h inputs, null otherwise
+    ConstData_t GetQuantizedWeights(ConstData_t w, int in_h) const;
+
+    /// Byte offset of the int8 matrices in the quantized weights
+    std::size_t GetQuantizedMatricesOffset() const;
+
     size_t GetRNNInputSuperTensorSize(Handle& handle,
                                       int seqLength,
                                       c_array_view<miopenTensorDescriptor_t> xDesc) const;
@@ -207,6 +261,28 @@ struct RNNDescriptor : miopenRNNDescriptor
                             Data_t reserveSpace,
                             size_t reserveSpaceSize) const;
 
+    /// The forward training pass that fills the full reserve space
+    void RNNForwardTrainingFull(Handle& handle,
+                                int seqLen,
+                                c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                ConstData_t x,
+                                const TensorDescriptor& hxDesc,
+                                ConstData_t hx,
+                                const TensorDescriptor& cxDesc,
+                                ConstData_t cx,
+                                const TensorDescriptor& wDesc,
+                                ConstData_t w,
+                                c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                Data_t y,
+                                const TensorDescriptor& hyDesc,
+                                Data_t hy,
+                                const TensorDescriptor& cyDesc,
+                                Data_t cy,
+                                Data_t workSpace,
+                                size_t workSpaceSize,
+                                Data_t reserveSpace,
+                                size_t reserveSpaceSize) const;
+
     void RNNForwardInference(Handle& handle,
                              int seqLen,
                              c_array_view<const miopenTensorDescriptor_t> xDesc,
@@ -226,6 +302,49 @@ struct RNNDescriptor : miopenRNNDescriptor
                              Data_t workSpace,
                              size_t workSpaceSize) const;
 
+    /// Forward inference on padded [sequence, batch, vector] input and output. The batch is
+    /// sorted by decreasing sequence length, and the padding of the output is zeroed.
+    void RNNForwardInferencePadded(Handle& handle,
+                                   const int* seqLengths,
+                                   const TensorDescriptor& xDesc,
+                                   ConstData_t x,
+                                   const TensorDescriptor& hxDesc,
+                                   ConstData_t hx,
+                                   const TensorDescriptor& cxDesc,
+                                   ConstData_t cx,
+                                   const TensorDescriptor& wDesc,
+                                   ConstData_t w,
+                                   const TensorDescriptor& yDesc,
+                                   Data_t y,
+                                   const TensorDescriptor& hyDesc,
+                                   Data_t hy,
+                                   const TensorDescriptor& cyDesc,
+                                   Data_t cy,
+                                   Data_t workSpace,
+                                   size_t workSpaceSize) const;
+
+    /// Shared by both layouts: in_n holds the valid vectors of every step, which are the first
+    /// rows starting at time_rows of that step
+    void RNNForwardInferenceRows(Handle& handle,
+                                 const std::vector<int>& in_n,
+                                 const std::vector<int>& time_rows,
+                                 int in_h,
+                                 int out_h,
+                                 ConstData_t x,
+                                 const TensorDescriptor& hxDesc,
+                                 ConstData_t hx,
+                                 const TensorDescriptor& cxDesc,
+                                 ConstData_t cx,
+                                 const TensorDescriptor& wDesc,
+                                 ConstData_t w,
+                                 Data_t y,
+                                 const TensorDescriptor& hyDesc,
+                                 Data_t hy,
+                                 const TensorDescriptor& cyDesc,
+                                 Data_t cy,
+                                 Data_t workSpace,
+                                 size_t workSpaceSize) const;
+
     void RNNBackwardData(Handle& handle,
                          int seqLen,
                          c_array_view<const miopenTensorDescriptor_t> yDesc,
@@ -253,6 +372,34 @@ struct RNNDescriptor : miopenRNNDescriptor
                          Data_t reserveSpace,
                          size_t reserveSpaceSize) const;
 
+    /// The backward data pass reading the full reserve space
+    void RNNBackwardDataFull(Handle& handle,
+                             int seqLen,
+                             c_array_view<const miopenTensorDescriptor_t> yDesc,
+                             ConstData_t y,
+                             c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                             ConstData_t dy,
+                             const TensorDescriptor& dhyDesc,
+                             ConstData_t dhy,
+                             const TensorDescriptor& dcyDesc,
+                             ConstData_t dcy,
+                             const TensorDescriptor& wDesc,
+                             ConstData_t w,
+                             const TensorDescriptor& hxDesc,
+                             ConstData_t hx,
+                             const TensorDescriptor& cxDesc,
+                             ConstData_t cx,
+                             c_array_view<const miopenTensorDescriptor_t> dxDesc,
+                             Data_t dx,
+                             const TensorDescriptor& dhxDesc,
+                             Data_t dhx,
+                             const TensorDescriptor& dcxDesc,
+                             Data_t dcx,
+                             Data_t workSpace,
+                             size_t workSpaceSize,
+                             Data_t reserveSpace,
+                             size_t reserveSpaceSize) const;
+
     void RNNBackwardWeights(Handle& handle,
                             int seqLen,
                             c_array_view<const miopenTensorDescriptor_t> xDesc,
@@ -268,6 +415,27 @@ struct RNNDescriptor : miopenRNNDescriptor
                             ConstData_t reserveSpace,
                             size_t reserveSpaceSize) const;
 
+    /// The backward weights pass reading the full reserve space
+    void RNNBackwardWeightsFull(Handle& handle,
+                                int seqLen,
+                                c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                ConstData_t x,
+                                const TensorDescriptor& hxDesc,
+                                ConstData_t hx,
+                                c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                                ConstData_t dy,
+                                const TensorDescriptor& dwDesc,
+                                Data_t dw,
+                                Data_t workSpace,
+                                size_t workSpaceSize,
+                                ConstData_t reserveSpace,
+                                size_t reserveSpaceSize) const;
+
+    void SetProjectionSize(int projSz);
+
+    /// Size of the state fed back to the next step and layer, the projection size if any
+    inline size_t recSize() const { return projSize != 0 ? projSize : hsize; }
+
     inline bool isNotRNNskip() const { return inputMode != miopenRNNskip; }
     inline bool isRNNskip() const { return inputMode == miopenRNNskip; }
 };
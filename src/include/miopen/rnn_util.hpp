@@ -31,6 +31,8 @@
 #include <miopen/common.hpp>
 #include <miopen/handle.hpp>
 
+#include <vector>
+
 namespace miopen {
 
 void LSTMForwardHiddenStateUpdate(const Handle& handle,
@@ -57,6 +59,90 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
                                   std::size_t activ_cell_offset,
                                   std::size_t hidden_offset);
 
+void GRUForwardHiddenStateUpdate(const Handle& handle,
+                                 miopenDataType_t rnn_data_type,
+                                 bool is_inference,
+                                 bool is_seq_begin,
+                                 int direction,
+                                 int max_batch,
+                                 int cur_batch,
+                                 int use_batch,
+                                 int hy_h,
+                                 int hy_stride,
+                                 ConstData_t hx,
+                                 std::size_t hx_offset,
+                                 Data_t reserve_space,
+                                 std::size_t z_offset,
+                                 std::size_t r_offset,
+                                 std::size_t c_offset,
+                                 std::size_t hidden_offset,
+                                 std::size_t hidden_offset_pre,
+                                 std::size_t activ_offset);
+
+/// Directions of a bidirectional layer run on their own streams of the handle's pool when
+/// MIOPEN_RNN_DIRECTION_STREAMS is set. Returns the pool stream of the reverse direction, which
+/// is reserved on first use, or the current stream of the calling thread otherwise.
+int GetRNNReverseDirectionStream(const Handle& handle, bool is_bidirection);
+
+/// Selects a stream of the pool for the calling thread until the end of the scope.
+struct RNNStreamScope
+{
+    RNNStreamScope(const Handle& handle_, int index)
+        : handle(handle_), previous(handle_.GetStreamIndexFromPool())
+    {
+        handle.SetStreamFromPool(index);
+    }
+    ~RNNStreamScope() { handle.SetStreamFromPool(previous); }
+
+    RNNStreamScope(const RNNStreamScope&) = delete;
+    RNNStreamScope& operator=(const RNNStreamScope&) = delete;
+
+    private:
+    const Handle& handle;
+    int previous;
+};
+
+bool IsRNNPersistentApplicable(const Handle& handle,
+                               miopenDataType_t rnn_data_type,
+                               miopenRNNMode_t rnn_mode,
+                               bool is_bidirection,
+                               const std::vector<int>& in_n,
+                               int hy_h,
+                               bool int8_weights);
+
+void RNNForwardPersistent(const Handle& handle,
+                          miopenDataType_t rnn_data_type,
+                          miopenRNNMode_t rnn_mode,
+                          int seq_len,
+                          int batch,
+                          int hy_h,
+                          int hy_stride,
+                          ConstData_t w,
+                          std::size_t w_offset,
+                          ConstData_t w_scale,
+                          std::size_t scale_offset,
+                          ConstData_t hx,
+                          std::size_t hx_offset,
+                          ConstData_t cx,
+                          std::size_t cx_offset,
+                          Data_t work_space,
+                          std::size_t gate_offset,
+                          std::size_t hidden_offset,
+                          std::size_t cell_offset,
+                          std::size_t sync_offset);
+
+/// Quantizes rows of row_len weights from w_offset to int8 at byte wq_offset of wq, with the
+/// float scale of every row at float scale_offset of wq
+void RNNQuantizeWeightsInt8(const Handle& handle,
+                            miopenDataType_t rnn_data_type,
+                            int rows,
+                            int row_len,
+                            ConstData_t w,
+                            std::size_t w_offset,
+                            Data_t wq,
+                            std::size_t wq_offset,
+                            std::size_t scale_offset);
+
 void LSTMBackwardHiddenStateUpdate(const Handle& handle,
                                    miopenDataType_t rnn_data_type,
                                    bool is_seq_begin,
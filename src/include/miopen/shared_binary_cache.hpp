@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SHARED_BINARY_CACHE_HPP_
+#define GUARD_MIOPEN_SHARED_BINARY_CACHE_HPP_
+
+#include <boost/filesystem/path.hpp>
+
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+/// Code object cache shared by many hosts through a network file system, set by
+/// MIOPEN_SHARED_CACHE_DIR. It is consulted after the local kernel cache misses, and hits are
+/// copied into the local one. It avoids SQLite, whose locking is unreliable over NFS:
+///   objects/<xx>/<md5 of the code object>     content-addressed code objects;
+///   index/<target>/<md5 of the name and args> the md5 of the code object of the kernel;
+///   index/<target>/<...>.lock                 claims the build of a kernel.
+/// Every file is written under a temporary name and published by rename, so a reader never
+/// sees a partial file. A process which misses claims the build, the others wait for it to
+/// publish the result up to MIOPEN_SHARED_CACHE_WAIT_MS (30 s by default) and then build on
+/// their own. Claims older than 10 minutes are considered abandoned.
+class SharedBinaryCache
+{
+    public:
+    SharedBinaryCache(const boost::filesystem::path& root_);
+    SharedBinaryCache(const SharedBinaryCache&) = delete;
+    SharedBinaryCache& operator=(const SharedBinaryCache&) = delete;
+    /// Drops the claims of the builds which did not finish.
+    ~SharedBinaryCache();
+
+    /// \return Null unless enabled.
+    static SharedBinaryCache* Get();
+
+    /// Returns the code object, or an empty string on a miss.
+    std::string Load(const std::string& target, const std::string& name, const std::string& args);
+    void Store(const std::string& target,
+               const std::string& name,
+               const std::string& args,
+               const std::string& binary);
+
+    private:
+    boost::filesystem::path GetIndexPath(const std::string& target,
+                                         const std::string& name,
+                                         const std::string& args) const;
+    boost::filesystem::path GetObjectPath(const std::string& hash) const;
+    std::string Read(const boost::filesystem::path& index_path);
+    bool Claim(const boost::filesystem::path& index_path);
+
+    boost::filesystem::path root;
+    std::mutex mutex;
+    /// Read-through index of the published kernels, index path to code object hash. Misses are
+    /// not remembered, since other hosts publish all the time.
+    std::unordered_map<std::string, std::string> index;
+    std::set<std::string> claims;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SHARED_BINARY_CACHE_HPP_
@@ -61,5 +61,21 @@ miopenStatus_t SoftmaxBackward(const Handle& handle,
                                int dy_offset = 0,
                                int dx_offset = 0);
 
+miopenStatus_t SoftmaxCrossEntropyForward(const Handle& handle,
+                                          const TensorDescriptor& xDesc,
+                                          ConstData_t x,
+                                          ConstData_t labels,
+                                          Data_t losses,
+                                          const TensorDescriptor& dxDesc,
+                                          Data_t dx);
+
+miopenStatus_t SoftmaxCrossEntropyBackward(const Handle& handle,
+                                           const TensorDescriptor& xDesc,
+                                           ConstData_t x,
+                                           ConstData_t labels,
+                                           ConstData_t dlosses,
+                                           const TensorDescriptor& dxDesc,
+                                           Data_t dx);
+
 } // namespace miopen
 #endif // _MIOPEN_SOFTMAX_HPP_
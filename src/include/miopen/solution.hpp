@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SOLUTION_HPP_
+#define GUARD_MIOPEN_SOLUTION_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/object.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+
+/// Solver chosen for a problem by the Find 2.0 API, see Problem::FindSolutions().
+/// Holds no kernels, these are built by the first run of the solution.
+struct Solution : miopenSolution
+{
+    Solution() = default;
+    Solution(solver::Id solver_,
+             miopenProblemDirection_t direction_,
+             std::string problem_key_,
+             float time_,
+             std::size_t workspace_size_);
+
+    solver::Id GetSolver() const { return solver; }
+    miopenProblemDirection_t GetDirection() const { return direction; }
+    /// Network config of the problem the solution was found for.
+    const std::string& GetProblemKey() const { return problem_key; }
+    float GetTime() const { return time; }
+    std::size_t GetWorkspaceSize() const { return workspace_size; }
+
+    /// The solver is saved by name, so the blob is portable across the versions of MIOpen.
+    std::string Save() const;
+    static Solution Load(const char* data, std::size_t size);
+
+    friend std::ostream& operator<<(std::ostream& stream, const Solution& solution);
+
+    private:
+    solver::Id solver;
+    miopenProblemDirection_t direction = miopenProblemDirectionForward;
+    std::string problem_key;
+    float time                 = 0.0f;
+    std::size_t workspace_size = 0;
+};
+
+} // namespace miopen
+
+MIOPEN_DEFINE_OBJECT(miopenSolution, miopen::Solution);
+
+#endif // GUARD_MIOPEN_SOLUTION_HPP_
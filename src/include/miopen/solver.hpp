@@ -35,6 +35,7 @@
 #include <miopen/legacy_exhaustive_search.hpp>
 #include <miopen/rocm_features.hpp>
 #include <miopen/type_name.hpp>
+#include <miopen/rank.hpp>
 #include <miopen/miopen.h>
 #include <miopen/buffer_info.hpp>
 
@@ -84,6 +85,40 @@ const std::string& SolverDbId(Solver solver)
     return result;
 }
 
+template <class Solver>
+constexpr auto GetSolverDbVersion(rank<1>) -> decltype(Solver::db_version)
+{
+    return Solver::db_version;
+}
+
+template <class Solver>
+constexpr int GetSolverDbVersion(rank<0>)
+{
+    return 1;
+}
+
+/// Version of the records a solver keeps in the find-db and perf-db. A solver declares
+/// "static constexpr int db_version = N;" and bumps it when its kernels or the meaning
+/// of its performance config change, so that only its own records become stale.
+template <class Solver>
+constexpr int GetSolverDbVersion()
+{
+    return GetSolverDbVersion<Solver>(rank<1>{});
+}
+
+/// Id of the solver values in the perf-db. Version 1 keeps the plain solver id for
+/// compatibility with the existing databases, later versions get a suffix, so that values
+/// tuned for a previous version are not found and the solver gets re-tuned.
+template <class Solver>
+const std::string& SolverPerfDbId(Solver solver)
+{
+    const auto version       = GetSolverDbVersion<Solver>();
+    static const auto result = version == 1
+                                   ? SolverDbId(solver)
+                                   : SolverDbId(solver) + "_v" + std::to_string(version);
+    return result;
+}
+
 /// Base class for problem solvers.
 ///
 /// Solvers are to be instantiated as const objects and shall not have any variable
@@ -134,6 +169,20 @@ struct SolverBase
     /// * @see https://github.com/ROCmSoftwarePlatform/MIOpen/issues/410
     float GetWti(const Context&) const { return -2.0; }
 
+    /// Returns false if the results of the solution may differ bitwise between runs, for
+    /// example when its kernels reduce with atomics. Only the deterministic solvers are used
+    /// when the handle is in the deterministic mode, see Handle::SetDeterministic().
+    bool IsDeterministic(const Context&) const { return true; }
+
+    /// Returns true if the invokers of the solution blend their result into the output
+    /// according to the alpha and beta of the invoke params. For the other solvers the
+    /// convolution calls blend it with an extra pass over the output.
+    bool SupportsAlphaBeta(const Context&) const { return false; }
+
+    /// Returns true if the invokers of the solution transform the filter on every run unless
+    /// they are given the transformed one, see conv::DataInvokeParams::prepared_weights.
+    bool PreparesWeights() const { return false; }
+
     // Returns the workspace size required by the solver for a given ConvolutionContext
     size_t GetWorkspaceSize(const Context&) const { return 0; };
 
@@ -1286,6 +1335,9 @@ struct ConvHipImplicitGemmForwardV4R4Xdlops : SolverBase<ConvolutionContext>
 
     PerformanceImplicitGemmForwardV4R4Xdlops Search(const ConvolutionContext&,
                                                     const AnyInvokeParams& invoke_ctx) const;
+    /// Relative run time of the config by the analytic cost model, see GenericSearch().
+    float EstimateCost(const ConvolutionContext& ctx,
+                       const PerformanceImplicitGemmForwardV4R4Xdlops& config) const;
 };
 
 struct ConvHipImplicitGemmForwardV4R4Xdlops_Padded_Gemm : SolverBase<ConvolutionContext>
@@ -1385,6 +1437,8 @@ struct ConvHipImplicitGemmBwdDataV1R1 : SolverBase<ConvolutionContext>
 {
     static std::tuple<int, int, int> CalculateGemmSize(const ConvolutionContext& ctx);
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The overlapping windows are accumulated with atomics.
+    bool IsDeterministic(const ConvolutionContext&) const { return false; }
     PerformanceImplicitGemmBwdDataV1R1 GetPerformanceConfig(const ConvolutionContext& ctx) const;
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmBwdDataV1R1& config) const;
@@ -1468,6 +1522,8 @@ struct ConvHipImplicitGemmBwdDataV1R1Xdlops : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmBwdV1R1Xdlops& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The overlapping windows are accumulated with atomics.
+    bool IsDeterministic(const ConvolutionContext&) const { return false; }
     size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmBwdV1R1Xdlops& config,
@@ -1501,6 +1557,8 @@ struct ConvAsmImplicitGemmV4R1DynamicWrw : SolverBase<ConvolutionContext>
 struct ConvAsmImplicitGemmGTCDynamicWrwXdlops : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The GEMM K may be split and reduced with atomics.
+    bool IsDeterministic(const ConvolutionContext&) const { return false; }
     bool IsDynamic() const { return true; }
     size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext& ctx) const;
@@ -1534,10 +1592,6 @@ struct ConvOclDirectFwdLegacyExhaustiveSearch : SolverBase<ConvolutionContext>
     LegacyPerformanceConfig GetPerformanceConfig(const ConvolutionContext&) const;
     LegacyPerformanceConfig Search(const ConvolutionContext&,
                                    const AnyInvokeParams& invoke_ctx) const;
-
-    private:
-    template <typename Tgpu>
-    LegacyPerformanceConfig SearchImpl(const ConvolutionContext&) const;
 };
 
 struct ConvOclDirectFwd : ConvOclDirectFwdLegacyExhaustiveSearch
@@ -1545,7 +1599,8 @@ struct ConvOclDirectFwd : ConvOclDirectFwdLegacyExhaustiveSearch
     bool IsApplicable(const ConvolutionContext& params) const;
 
     ConvSolution GetSolution(const ConvolutionContext& params,
-                             const LegacyPerformanceConfig& searched_params) const;
+                             const LegacyPerformanceConfig& searched_params,
+                             bool disableConfigOverrideFromEnv = false) const;
     bool IsValidPerformanceConfig(const ConvolutionContext&, const LegacyPerformanceConfig&) const;
 
     protected:
@@ -1555,14 +1610,16 @@ struct ConvOclDirectFwd : ConvOclDirectFwdLegacyExhaustiveSearch
 struct ConvOclDirectFwdFused : ConvOclDirectFwd
 {
     ConvSolution GetSolution(const ConvolutionContext& params,
-                             const LegacyPerformanceConfig& searched_params) const;
+                             const LegacyPerformanceConfig& searched_params,
+                             bool disableConfigOverrideFromEnv = false) const;
 };
 
 struct ConvOclDirectFwd1x1 : ConvOclDirectFwdLegacyExhaustiveSearch
 {
     bool IsApplicable(const ConvolutionContext& params) const;
     ConvSolution GetSolution(const ConvolutionContext& params,
-                             const LegacyPerformanceConfig& searched_params) const;
+                             const LegacyPerformanceConfig& searched_params,
+                             bool disableConfigOverrideFromEnv = false) const;
     bool IsValidPerformanceConfig(const ConvolutionContext&, const LegacyPerformanceConfig&) const
     {
         return true;
@@ -1695,6 +1752,7 @@ struct ConvMPBidirectWinograd : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
     bool IsDynamic() const { return true; }
+    bool PreparesWeights() const { return true; }
     size_t GetWorkspaceSize(const ConvolutionContext& params) const;
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 
@@ -1731,6 +1789,7 @@ template <int WinoDataH, int WinoFilterH, int WinoDataW = WinoDataH, int WinoFil
 struct ConvMPBidirectWinograd_xdlops : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    bool PreparesWeights() const { return true; }
 
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmForwardV4R4Xdlops& c) const
@@ -1739,13 +1798,7 @@ struct ConvMPBidirectWinograd_xdlops : SolverBase<ConvolutionContext>
             GetTransformedConvContext(ctx), c);
     }
 
-    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const
-    {
-        return ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>()
-                   .GetWorkspaceSize(ctx) +
-               ConvHipImplicitGemmForwardV4R4Xdlops{}.GetWorkspaceSize(
-                   GetTransformedConvContext(ctx));
-    }
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
 
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmForwardV4R4Xdlops& config,
@@ -2133,6 +2186,8 @@ struct ConvOclBwdWrW1x1 : SolverBase<ConvolutionContext>
 struct fft : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The transformed weights are copied out of the workspace by offset.
+    bool PreparesWeights() const { return MIOPEN_BACKEND_HIP != 0; }
     size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
     ConvSolution GetSolution(const ConvolutionContext& ctx) const;
 };
@@ -2198,6 +2253,8 @@ struct ConvHipImplicitGemmWrwV4R4Xdlops : SolverBase<ConvolutionContext>
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmWrwV4R4Xdlops& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The GEMM K blocks are reduced with atomics.
+    bool IsDeterministic(const ConvolutionContext&) const { return false; }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmWrwV4R4Xdlops& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -2275,6 +2332,8 @@ struct ConvHipImplicitGemmWrwV4R4Xdlops_Padded_Gemm : SolverBase<ConvolutionCont
     bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
                                   const PerformanceImplicitGemmWrwV4R4Xdlops_Padded_Gemm& c) const;
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The GEMM K blocks are reduced with atomics.
+    bool IsDeterministic(const ConvolutionContext&) const { return false; }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmWrwV4R4Xdlops_Padded_Gemm& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -2322,6 +2381,46 @@ struct ConvCkIgemmFwdV6r1DlopsNchw : SolverBase<ConvolutionContext>
                              bool disableConfigOverrideFromEnv = false) const;
 };
 
+struct PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc
+    : Serializable<PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc>
+{
+    int ck_tunable_list_id;
+
+    PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc(int a) : ck_tunable_list_id(a) {}
+
+    PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc() : PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc(-1) {}
+
+    PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc(bool) : PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc(0) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.ck_tunable_list_id, "ck_tunable_list_id");
+    }
+
+    bool SetNextValue(const ConvolutionContext&);
+    bool IsValid(const ConvolutionContext&) const;
+    bool operator==(const PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc& config) const
+    {
+        return ck_tunable_list_id == config.ck_tunable_list_id;
+    }
+};
+
+struct ConvCkIgemmFwdV4r4r4DlopsNhwc : SolverBase<ConvolutionContext>
+{
+    bool IsApplicable(const ConvolutionContext&) const;
+    std::size_t GetWorkspaceSize(const ConvolutionContext&) const;
+    bool IsDynamic() const { return true; }
+    PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc GetPerformanceConfig(const ConvolutionContext&) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext&,
+                                  const PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc&) const;
+    PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc Search(const ConvolutionContext&,
+                                                    const AnyInvokeParams&) const;
+    ConvSolution GetSolution(const ConvolutionContext&,
+                             const PerformanceConvCkIgemmFwdV4r4r4DlopsNhwc&,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
 struct ConvDirectNaiveConvFwd : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& ctx) const;
@@ -2352,6 +2451,450 @@ struct ConvDirectNaiveConvWrw : SolverBase<ConvolutionContext>
     ConvSolution GetSolution(const ConvolutionContext& ctx) const;
 };
 
+struct PerformanceConfigConvDepthwise : Serializable<PerformanceConfigConvDepthwise>
+{
+    int tile;  // Neighbouring outputs along W computed by a work-item.
+    int block; // Work-group size.
+
+    PerformanceConfigConvDepthwise(int tile_, int block_) : tile(tile_), block(block_) {}
+    PerformanceConfigConvDepthwise() : PerformanceConfigConvDepthwise(-1, -1) {}
+    PerformanceConfigConvDepthwise(bool) : PerformanceConfigConvDepthwise(1, 64) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.tile, "tile");
+        f(self.block, "block");
+    }
+
+    void HeuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue(const ConvolutionContext& ctx);
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceConfigConvDepthwise& other) const;
+    std::string ToString() const;
+};
+
+/// Depthwise convolutions, i.e. the group ones with a single input channel per group, in
+/// NCHW and NHWC. The output channels of a group are the channel multiplier.
+struct ConvDepthwiseFwd : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvDepthwise GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvDepthwise& config) const;
+    PerformanceConfigConvDepthwise Search(const ConvolutionContext& ctx,
+                                          const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    float GetWti(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvDepthwise& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct ConvDepthwiseBwd : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvDepthwise GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvDepthwise& config) const;
+    PerformanceConfigConvDepthwise Search(const ConvolutionContext& ctx,
+                                          const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    float GetWti(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvDepthwise& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct ConvDepthwiseWrw : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvDepthwise GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvDepthwise& config) const;
+    PerformanceConfigConvDepthwise Search(const ConvolutionContext& ctx,
+                                          const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    float GetWti(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvDepthwise& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct PerformanceConfigConvOclImplicitGemmWrwSplitK
+    : Serializable<PerformanceConfigConvOclImplicitGemmWrwSplitK>
+{
+    int tile;   // Side of the GEMM tile computed by a work-group.
+    int splits; // Parts the GEMM K dimension (output pixels of the batch) is split into.
+    int atomic; // Whether the parts are added atomically instead of reduced in order.
+
+    PerformanceConfigConvOclImplicitGemmWrwSplitK(int tile_, int splits_, int atomic_)
+        : tile(tile_), splits(splits_), atomic(atomic_)
+    {
+    }
+    PerformanceConfigConvOclImplicitGemmWrwSplitK()
+        : PerformanceConfigConvOclImplicitGemmWrwSplitK(-1, -1, -1)
+    {
+    }
+    PerformanceConfigConvOclImplicitGemmWrwSplitK(bool)
+        : PerformanceConfigConvOclImplicitGemmWrwSplitK(32, 1, 0)
+    {
+    }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.tile, "tile");
+        f(self.splits, "splits");
+        f(self.atomic, "atomic");
+    }
+
+    void HeuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue(const ConvolutionContext& ctx);
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceConfigConvOclImplicitGemmWrwSplitK& other) const;
+    std::string ToString() const;
+};
+
+/// Backward weights as an implicit GEMM whose reduction over the output pixels of the batch
+/// is split among the work-groups, which keeps the GPU busy when the batch is small and the
+/// filter is large. The parts are reduced either in order in the workspace or atomically.
+struct ConvOclImplicitGemmWrwSplitK : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvOclImplicitGemmWrwSplitK
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool
+    IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvOclImplicitGemmWrwSplitK& config) const;
+    PerformanceConfigConvOclImplicitGemmWrwSplitK Search(const ConvolutionContext& ctx,
+                                                         const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    /// Enough for the deterministic reduction of the most parts the problem may be split into.
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvOclImplicitGemmWrwSplitK& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc
+    : Serializable<PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc>
+{
+    int block_m; // Output pixels of the GEMM tile computed by a work-group.
+    int block_n; // Output channels of the GEMM tile computed by a work-group.
+
+    PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc(int block_m_, int block_n_)
+        : block_m(block_m_), block_n(block_n_)
+    {
+    }
+    PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc()
+        : PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc(-1, -1)
+    {
+    }
+    PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc(bool)
+        : PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc(32, 32)
+    {
+    }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.block_m, "block_m");
+        f(self.block_n, "block_n");
+    }
+
+    void HeuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue(const ConvolutionContext& ctx);
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc& other) const;
+    std::string ToString() const;
+};
+
+/// Int8 forward convolution of NHWC tensors on the xdlops instructions, accumulating in int32.
+/// The output is int32 or fp32, like for the other int8 solvers.
+struct ConvHipImplicitGemmFwdXdlopsInt8Nhwc : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool
+    IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                             const PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc& config) const;
+    PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc
+    Search(const ConvolutionContext& ctx, const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct PerformanceConfigHipWinogradFusedXdlops
+    : Serializable<PerformanceConfigHipWinogradFusedXdlops>
+{
+    int tile;    // Output tile side of F(tile x tile, 3x3).
+    int block_t; // Output tiles computed by a work-group.
+    int block_k; // Output channels computed by a work-group.
+
+    PerformanceConfigHipWinogradFusedXdlops(int tile_, int block_t_, int block_k_)
+        : tile(tile_), block_t(block_t_), block_k(block_k_)
+    {
+    }
+    PerformanceConfigHipWinogradFusedXdlops() : PerformanceConfigHipWinogradFusedXdlops(-1, -1, -1)
+    {
+    }
+    PerformanceConfigHipWinogradFusedXdlops(bool)
+        : PerformanceConfigHipWinogradFusedXdlops(4, 16, 16)
+    {
+    }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.tile, "tile");
+        f(self.block_t, "block_t");
+        f(self.block_k, "block_k");
+    }
+
+    void HeuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue(const ConvolutionContext& ctx);
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceConfigHipWinogradFusedXdlops& other) const;
+    std::string ToString() const;
+};
+
+/// Fp16 forward 3x3 convolution of NCHW tensors as a single-pass F(4x4,3x3) or F(6x6,3x3)
+/// Winograd. The transforms stay in registers and LDS, and the elementwise GEMMs run on the
+/// xdlops instructions, so that no workspace is needed.
+struct ConvHipWinogradFusedXdlops : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigHipWinogradFusedXdlops
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigHipWinogradFusedXdlops& config) const;
+    PerformanceConfigHipWinogradFusedXdlops Search(const ConvolutionContext& ctx,
+                                                   const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigHipWinogradFusedXdlops& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct PerformanceConfigConvOclImplicitGemmNdhwc
+    : Serializable<PerformanceConfigConvOclImplicitGemmNdhwc>
+{
+    int tile_m; // Rows of the GEMM tile computed by a work-group.
+    int tile_n; // Columns of the GEMM tile computed by a work-group.
+
+    PerformanceConfigConvOclImplicitGemmNdhwc(int tile_m_, int tile_n_)
+        : tile_m(tile_m_), tile_n(tile_n_)
+    {
+    }
+    PerformanceConfigConvOclImplicitGemmNdhwc()
+        : PerformanceConfigConvOclImplicitGemmNdhwc(-1, -1)
+    {
+    }
+    PerformanceConfigConvOclImplicitGemmNdhwc(bool)
+        : PerformanceConfigConvOclImplicitGemmNdhwc(32, 32)
+    {
+    }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.tile_m, "tile_m");
+        f(self.tile_n, "tile_n");
+    }
+
+    void HeuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue(const ConvolutionContext& ctx);
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceConfigConvOclImplicitGemmNdhwc& other) const;
+    std::string ToString() const;
+};
+
+/// 3D convolutions on NDHWC tensors as implicit GEMMs, which need neither im3d2col nor its
+/// workspace.
+struct ConvOclImplicitGemmNdhwcFwd : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvOclImplicitGemmNdhwc
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvOclImplicitGemmNdhwc& config) const;
+    PerformanceConfigConvOclImplicitGemmNdhwc Search(const ConvolutionContext& ctx,
+                                                     const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvOclImplicitGemmNdhwc& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct ConvOclImplicitGemmNdhwcBwd : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvOclImplicitGemmNdhwc
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvOclImplicitGemmNdhwc& config) const;
+    PerformanceConfigConvOclImplicitGemmNdhwc Search(const ConvolutionContext& ctx,
+                                                     const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvOclImplicitGemmNdhwc& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct ConvOclImplicitGemmNdhwcWrw : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvOclImplicitGemmNdhwc
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvOclImplicitGemmNdhwc& config) const;
+    PerformanceConfigConvOclImplicitGemmNdhwc Search(const ConvolutionContext& ctx,
+                                                     const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvOclImplicitGemmNdhwc& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+/// Strided backward data, and so transposed forward convolutions, on NHWC and NDHWC tensors by
+/// sub-pixel decomposition: each phase of dx is a dense implicit GEMM with the taps that hit dy,
+/// instead of reading the zeros the strides leave between the dy pixels.
+struct ConvOclImplicitGemmSubPixelBwd : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvOclImplicitGemmNdhwc
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvOclImplicitGemmNdhwc& config) const;
+    PerformanceConfigConvOclImplicitGemmNdhwc Search(const ConvolutionContext& ctx,
+                                                     const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvOclImplicitGemmNdhwc& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct PerformanceConfigConvOclImplicitGemmFwdStreamK
+    : Serializable<PerformanceConfigConvOclImplicitGemmFwdStreamK>
+{
+    int tile;       // Side of the GEMM tile computed by a work-group at a time.
+    int wgs_per_cu; // Persistent work-groups per compute unit.
+
+    PerformanceConfigConvOclImplicitGemmFwdStreamK(int tile_, int wgs_per_cu_)
+        : tile(tile_), wgs_per_cu(wgs_per_cu_)
+    {
+    }
+    PerformanceConfigConvOclImplicitGemmFwdStreamK()
+        : PerformanceConfigConvOclImplicitGemmFwdStreamK(-1, -1)
+    {
+    }
+    PerformanceConfigConvOclImplicitGemmFwdStreamK(bool)
+        : PerformanceConfigConvOclImplicitGemmFwdStreamK(32, 1)
+    {
+    }
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.tile, "tile");
+        f(self.wgs_per_cu, "wgs_per_cu");
+    }
+
+    void HeuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue(const ConvolutionContext& ctx);
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceConfigConvOclImplicitGemmFwdStreamK& other) const;
+    std::string ToString() const;
+};
+
+/// Forward as a stream-K implicit GEMM: a persistent work-group per CU slot takes an equal share
+/// of the K iterations of all the tiles, instead of whole tiles whose count may leave the last
+/// wave mostly idle. A second kernel adds up the tiles which were split between work-groups.
+struct ConvOclImplicitGemmFwdStreamK : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvOclImplicitGemmFwdStreamK
+    GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool
+    IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvOclImplicitGemmFwdStreamK& config) const;
+    PerformanceConfigConvOclImplicitGemmFwdStreamK Search(const ConvolutionContext& ctx,
+                                                          const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    /// Enough for the partial tiles of the most work-groups a config may launch.
+    size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvOclImplicitGemmFwdStreamK& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct PerformanceConfigConvDirectTiled : Serializable<PerformanceConfigConvDirectTiled>
+{
+    int tile_m; // GEMM M side of the tile computed by a work-group.
+    int tile_n; // GEMM N side of the tile computed by a work-group.
+
+    PerformanceConfigConvDirectTiled(int tile_m_, int tile_n_) : tile_m(tile_m_), tile_n(tile_n_)
+    {
+    }
+    PerformanceConfigConvDirectTiled() : PerformanceConfigConvDirectTiled(-1, -1) {}
+    PerformanceConfigConvDirectTiled(bool) : PerformanceConfigConvDirectTiled(32, 32) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.tile_m, "tile_m");
+        f(self.tile_n, "tile_n");
+    }
+
+    void HeuristicInit(const ConvolutionContext& ctx);
+    bool IsValidValue() const;
+    bool SetNextValue(const ConvolutionContext& ctx);
+    bool IsValid(const ConvolutionContext& ctx) const;
+    bool operator==(const PerformanceConfigConvDirectTiled& other) const;
+    std::string ToString() const;
+};
+
+/// Generic tiled direct convolutions for every layout, type and group count of the naive ones,
+/// with the sizes compiled in, LDS tiling and vector loads. A fallback for the problems which no
+/// specialized solver covers.
+struct ConvDirectTiledFwd : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvDirectTiled GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvDirectTiled& config) const;
+    PerformanceConfigConvDirectTiled Search(const ConvolutionContext& ctx,
+                                            const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvDirectTiled& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct ConvDirectTiledBwd : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvDirectTiled GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvDirectTiled& config) const;
+    PerformanceConfigConvDirectTiled Search(const ConvolutionContext& ctx,
+                                            const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvDirectTiled& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
+struct ConvDirectTiledWrw : SolverBase<ConvolutionContext>
+{
+    PerformanceConfigConvDirectTiled GetPerformanceConfig(const ConvolutionContext& ctx) const;
+    bool IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                  const PerformanceConfigConvDirectTiled& config) const;
+    PerformanceConfigConvDirectTiled Search(const ConvolutionContext& ctx,
+                                            const AnyInvokeParams& invoke_ctx) const;
+    bool IsApplicable(const ConvolutionContext& ctx) const;
+    ConvSolution GetSolution(const ConvolutionContext& ctx,
+                             const PerformanceConfigConvDirectTiled& config,
+                             bool disableConfigOverrideFromEnv = false) const;
+};
+
 struct GemmFwdBase : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ExecutionContext&, const conv::ProblemDescription&) const;
@@ -2416,6 +2959,11 @@ struct GemmFwd1x1_0_1 : GemmFwdBase
         return IsApplicable(ctx, ctx.conv_problem);
     }
 
+    bool SupportsAlphaBeta(const ConvolutionContext& ctx) const
+    {
+        return SupportsAlphaBeta(ctx, ctx.conv_problem);
+    }
+
     ConvSolution GetSolution(const ConvolutionContext& ctx) const
     {
         return GetSolution(ctx, ctx.conv_problem);
@@ -2423,6 +2971,7 @@ struct GemmFwd1x1_0_1 : GemmFwdBase
 
     size_t GetWorkspaceSize(const ExecutionContext&, const conv::ProblemDescription&) const;
     bool IsApplicable(const ExecutionContext&, const conv::ProblemDescription&) const;
+    bool SupportsAlphaBeta(const ExecutionContext&, const conv::ProblemDescription&) const;
     ConvSolution GetSolution(const ExecutionContext&, const conv::ProblemDescription&) const;
 };
 
@@ -2542,6 +3091,11 @@ struct GemmWrw1x1_stride1 : GemmWrwBase
         return IsApplicable(ctx, ctx.conv_problem);
     }
 
+    bool SupportsAlphaBeta(const ConvolutionContext& ctx) const
+    {
+        return SupportsAlphaBeta(ctx, ctx.conv_problem);
+    }
+
     ConvSolution GetSolution(const ConvolutionContext& ctx) const
     {
         return GetSolution(ctx, ctx.conv_problem);
@@ -2549,6 +3103,7 @@ struct GemmWrw1x1_stride1 : GemmWrwBase
 
     size_t GetWorkspaceSize(const ExecutionContext&, const conv::ProblemDescription&) const;
     bool IsApplicable(const ExecutionContext&, const conv::ProblemDescription&) const;
+    bool SupportsAlphaBeta(const ExecutionContext&, const conv::ProblemDescription&) const;
     ConvSolution GetSolution(const ExecutionContext&, const conv::ProblemDescription&) const;
 };
 
@@ -2878,8 +3433,13 @@ struct ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC : SolverBase<ConvolutionContex
                                   const PerformanceConfigAsmImplicitGemmGTCFwdXdlopsNHWC&) const;
     PerformanceConfigAsmImplicitGemmGTCFwdXdlopsNHWC
     Search(const ConvolutionContext&, const AnyInvokeParams& invoke_ctx) const;
+    /// Relative run time of the config by the analytic cost model, see GenericSearch().
+    float EstimateCost(const ConvolutionContext& ctx,
+                       const PerformanceConfigAsmImplicitGemmGTCFwdXdlopsNHWC& config) const;
 
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The GEMM K may be split and reduced with atomics.
+    bool IsDeterministic(const ConvolutionContext&) const { return false; }
     bool IsDynamic() const { return true; }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceConfigAsmImplicitGemmGTCFwdXdlopsNHWC& config,
@@ -3012,6 +3572,8 @@ struct ConvAsmImplicitGemmGTCDynamicBwdXdlopsNHWC : SolverBase<ConvolutionContex
     Search(const ConvolutionContext&, const AnyInvokeParams& invoke_ctx) const;
 
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The GEMM K may be split and reduced with atomics.
+    bool IsDeterministic(const ConvolutionContext&) const { return false; }
     bool IsDynamic() const { return true; }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceConfigAsmImplicitGemmGTCBwdXdlopsNHWC& config,
@@ -3148,6 +3710,8 @@ struct ConvAsmImplicitGemmGTCDynamicWrwXdlopsNHWC : SolverBase<ConvolutionContex
     size_t GetWorkspaceSize(const ConvolutionContext& ctx) const;
 
     bool IsApplicable(const ConvolutionContext& ctx) const;
+    // The GEMM K may be split and reduced with atomics.
+    bool IsDeterministic(const ConvolutionContext&) const { return false; }
     bool IsDynamic() const { return true; }
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceConfigAsmImplicitGemmGTCWrwXdlopsNHWC& config,
@@ -3176,6 +3740,7 @@ struct mlo_construct_direct2D_fusion : mlo_construct_base
     }
 
     bool IsAutoTuneEnabled() const { return _search_params.do_search; }
+    void EnableAutoTune(bool enable) { _search_params.do_search = enable; }
 
     inline void mloCopyTo(miopen::ConvolutionContext& params) const /// TODO: get rid of this
     {
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SOLVER_CONV_COST_MODEL_HPP_
+#define GUARD_MIOPEN_SOLVER_CONV_COST_MODEL_HPP_
+
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+
+namespace conv {
+struct ProblemDescription;
+} // namespace conv
+
+namespace solver {
+
+/// Amount of work of a convolution, as seen by the cost model.
+struct ConvWork
+{
+    double flops = 0.0; ///< Multiply-adds count as two.
+    double bytes = 0.0; ///< Tensors read and written once, plus the workspace twice.
+};
+
+/// Peak rates of a device for a data type.
+struct DeviceThroughput
+{
+    double flops_per_ms = 0.0;
+    double bytes_per_ms = 0.0;
+};
+
+ConvWork GetConvWork(const conv::ProblemDescription& problem, std::size_t workspace);
+
+/// Looked up by the prefix of the device name in a table of the clock, the memory bandwidth and
+/// the flops per compute unit and clock of the known architectures. Matrix cores are assumed
+/// where the architecture has them.
+DeviceThroughput
+GetDeviceThroughput(const std::string& device_name, std::size_t num_cu, miopenDataType_t type);
+
+/// Fraction of the peak flops reached by a typical solver of the algorithm. The cost model scales
+/// it by the WTI of the solver when it has one.
+float GetDefaultEfficiency(miopenConvAlgorithm_t algorithm);
+
+/// Roofline estimate of the run time of a convolution, in milliseconds: the larger of the compute
+/// and the memory times plus a launch overhead. The efficiency is the fraction of the peak flops
+/// reached, e.g. the WTI of the solver.
+float EstimateConvTime(const ConvWork& work, const DeviceThroughput& device, float efficiency);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOLVER_CONV_COST_MODEL_HPP_
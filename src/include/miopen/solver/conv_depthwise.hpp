@@ -0,0 +1,50 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/solver.hpp>
+
+namespace miopen {
+
+namespace solver {
+
+/// Sizes of a depthwise convolution in the terms of the forward one: x has c channels and
+/// y has c * m ones, output channel k is computed from input channel k / m.
+struct DepthwiseConvSizes
+{
+    int n, c, m;
+    int hi, wi, ho, wo;
+    int fy, fx, sy, sx, dy, dx, py, px;
+};
+
+DepthwiseConvSizes GetDepthwiseConvSizes(const ConvolutionContext& ctx);
+bool IsDepthwiseConvApplicable(const ConvolutionContext& ctx);
+ConvSolution GetDepthwiseConvSolution(const ConvolutionContext& ctx,
+                                      const PerformanceConfigConvDepthwise& config,
+                                      bool disableConfigOverrideFromEnv);
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/solver.hpp>
+
+#include <boost/optional.hpp>
+
+namespace miopen {
+
+namespace solver {
+
+/// Sizes of a 2D or 3D convolution in the terms of the forward one: x has g * cg channels and
+/// y has g * kg ones. 2D problems have a depth of 1.
+struct DirectTiledSizes
+{
+    int n, g, cg, kg;
+    int di, hi, wi, do_, ho, wo;
+    int fz, fy, fx, sz, sy, sx, dz, dy, dx, pz, py, px;
+};
+
+DirectTiledSizes GetDirectTiledSizes(const ConvolutionContext& ctx);
+bool IsDirectTiledApplicable(const ConvolutionContext& ctx);
+/// Elementwise ops which the forward kernel applies to its output before it stores it, for the
+/// fusion plans: y = activ(alpha1 * (conv(x, w) + bias) + alpha2 * residual).
+struct DirectTiledEpilogue
+{
+    bool bias     = false;
+    bool residual = false;
+    boost::optional<miopenActivationMode_t> activ;
+};
+
+/// With bn_stats, the forward kernel also adds up the sums and the sums of squares of the
+/// output channels into two more fp32 arguments, for the training batch normalization of the
+/// fusion plans. The arguments of the epilogue follow, see MIOpenConvDirectTiled.cl. The invoker
+/// of the solution passes neither.
+ConvSolution GetDirectTiledSolution(const ConvolutionContext& ctx,
+                                    const PerformanceConfigConvDirectTiled& config,
+                                    bool disableConfigOverrideFromEnv,
+                                    bool bn_stats = false,
+                                    const DirectTiledEpilogue& epilogue = DirectTiledEpilogue{});
+
+} // namespace solver
+} // namespace miopen
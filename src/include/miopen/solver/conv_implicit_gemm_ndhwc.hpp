@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#pragma once
+
+#include <miopen/solver.hpp>
+
+namespace miopen {
+
+namespace solver {
+
+/// Sizes of a 3D convolution in the terms of the forward one: x has g * cg channels and y has
+/// g * kg ones.
+struct NdhwcConvSizes
+{
+    int n, g, cg, kg;
+    int di, hi, wi, do_, ho, wo;
+    int fz, fy, fx, sz, sy, sx, dz, dy, dx, pz, py, px;
+};
+
+/// 2D problems have a depth, filter depth and depth stride of 1.
+NdhwcConvSizes GetNdhwcConvSizes(const ConvolutionContext& ctx);
+/// With sub_pixel, backward data is computed a sub-pixel phase of dx at a time, which only reads
+/// the taps that hit dy. This also takes 2D problems.
+bool IsNdhwcImplicitGemmApplicable(const ConvolutionContext& ctx, bool sub_pixel = false);
+ConvSolution GetNdhwcImplicitGemmSolution(const ConvolutionContext& ctx,
+                                          const PerformanceConfigConvOclImplicitGemmNdhwc& config,
+                                          bool disableConfigOverrideFromEnv,
+                                          bool sub_pixel = false);
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SOLVER_GEMM_COST_MODEL_HPP_
+#define GUARD_MIOPEN_SOLVER_GEMM_COST_MODEL_HPP_
+
+#include <cstddef>
+
+namespace miopen {
+namespace solver {
+
+/// Shape of a tiled GEMM kernel launch, as seen by the cost model.
+struct GemmTileShape
+{
+    std::size_t gemm_g      = 1;
+    std::size_t gemm_m      = 0;
+    std::size_t gemm_n      = 0;
+    std::size_t gemm_k      = 0;
+    std::size_t m_per_block = 0;
+    std::size_t n_per_block = 0;
+    std::size_t k_per_block = 0;
+    std::size_t block_size  = 0;
+    std::size_t lds_size    = 0; ///< Bytes of LDS per workgroup.
+    std::size_t k_splits    = 1; ///< Number of the slices of GEMM K reduced with atomics.
+};
+
+/// Analytic estimate of the run time of a tiled GEMM kernel, in arbitrary units.
+/// Only meant to rank the performance configs of a solver against each other. Accounts for
+/// the padding of partial tiles, for the quantization of the tiles over the compute units,
+/// for the occupancy limited by LDS and workgroup size and for the arithmetic intensity of
+/// the tile. Returns the max float for a shape which cannot run.
+float EstimateGemmTileCost(const GemmTileShape& shape, std::size_t num_cu);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOLVER_GEMM_COST_MODEL_HPP_
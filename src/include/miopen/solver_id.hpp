@@ -48,6 +48,8 @@ enum class Primitive
     Convolution,
     Activation,
     Batchnorm,
+    Normalization,
+    Attention,
 };
 
 struct Id
@@ -65,6 +67,8 @@ struct Id
     std::string GetAlgo(conv::Direction dir) const;
     miopenConvAlgorithm_t GetAlgo() const;
     Primitive GetPrimitive() const;
+    /// Version of the solver records in the databases, 1 for ids without a solver.
+    int GetDbVersion() const;
 
     bool IsValid() const { return is_valid; }
     uint64_t Value() const { return value; }
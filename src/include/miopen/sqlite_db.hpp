@@ -30,6 +30,7 @@
 #if MIOPEN_ENABLE_SQLITE
 
 #include <miopen/db_record.hpp>
+#include <miopen/db_write_batch.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/stringutils.hpp>
@@ -47,7 +48,10 @@
 
 #include <string>
 #include <chrono>
+#include <map>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -189,6 +193,8 @@ class SQLite
         int BindText(int idx, const std::string& txt);
         int BindBlob(int idx, const std::string& blob);
         int BindInt64(int idx, int64_t);
+        /// Makes a prepared statement ready to be stepped again with new bindings.
+        void Reset();
     };
 
     using result_type = std::vector<std::unordered_map<std::string, std::string>>;
@@ -272,6 +278,9 @@ class SQLiteBase
     }
 
     static Derived& GetCached(const std::string& path, bool is_system);
+    /// Calls f for each instance returned by GetCached() so far.
+    template <class F>
+    static void ForEachCached(F f);
     // TODO: Fix this for the overhead of having fields per record
 
     inline auto CheckTableColumns(const std::string& tableName,
@@ -337,18 +346,33 @@ class SQLiteBase
     std::string filename;
     bool dbInvalid;
     SQLite sql;
+
+    private:
+    struct Cache
+    {
+        std::mutex mutex;
+        std::map<std::string, Derived> instances;
+    };
+
+    static Cache& GetCache();
 };
 
 template <typename Derived>
-Derived& SQLiteBase<Derived>::GetCached(const std::string& path, bool is_system)
+typename SQLiteBase<Derived>::Cache& SQLiteBase<Derived>::GetCache()
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    std::lock_guard<std::mutex> lock{mutex};
+    static Cache cache;
+    return cache;
+}
 
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto instances = std::map<std::string, Derived>{};
-    const auto it         = instances.find(path);
+template <typename Derived>
+Derived& SQLiteBase<Derived>::GetCached(const std::string& path, bool is_system)
+{
+    auto& cache = GetCache();
+    std::lock_guard<std::mutex> lock{cache.mutex};
+
+    auto& instances = cache.instances;
+    const auto it   = instances.find(path);
 
     if(it != instances.end())
         return it->second;
@@ -357,11 +381,29 @@ Derived& SQLiteBase<Derived>::GetCached(const std::string& path, bool is_system)
     return instances.at(path);
 }
 
+template <typename Derived>
+template <class F>
+void SQLiteBase<Derived>::ForEachCached(F f)
+{
+    auto& cache = GetCache();
+    std::lock_guard<std::mutex> lock{cache.mutex};
+    for(auto& instance : cache.instances)
+        f(instance.second);
+}
+
 class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
 {
     public:
     static constexpr char const* MIOPEN_PERFDB_SCHEMA_VER = "1.1.0";
     SQLitePerfDb(const std::string& filename_, bool is_system);
+    SQLitePerfDb(SQLitePerfDb&&) = default;
+    SQLitePerfDb& operator=(SQLitePerfDb&&) = default;
+    ~SQLitePerfDb();
+
+    /// Writes the updates delayed by write-behind batching in one transaction,
+    /// see DbWriteBatchLimits.
+    void Flush();
+    static void FlushAll();
 
     template <class T>
     inline void InsertConfig(const T& prob_desc)
@@ -425,6 +467,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
                 MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
         }
+        MergePendingWrites(GetConfigKey(problem_config.table_name(), clause, values), rec);
         if(rec.GetSize() == 0)
             return boost::none;
         else
@@ -440,6 +483,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
     {
         if(dbInvalid)
             return false;
+        Flush();
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
@@ -471,47 +515,35 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
     {
         if(dbInvalid)
             return boost::none;
-        // UPSERT the value
-        {
-            std::string clause;
-            std::vector<std::string> vals;
-            std::tie(clause, vals) = problem_config.InsertQuery();
-            auto stmt              = SQLite::Statement{sql, clause, vals};
-            auto rc                = stmt.Step(sql);
-            if(rc != SQLITE_DONE)
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "Failed to insert config: " + sql.ErrorMessage());
-            auto cnt = sql.Changes();
-            MIOPEN_LOG_I2(cnt << " rows updated");
-        }
 
-        // UPSERT perf values
+        auto write = PendingWrite{};
+        std::tie(write.config_query, write.config_values) = problem_config.InsertQuery();
         {
             std::ostringstream params;
             values.Serialize(params);
             std::string clause;
-            std::vector<std::string> vals(2);
+            std::vector<std::string> vals;
             std::tie(clause, vals) = problem_config.WhereClause();
 
             // clang-format off
-            std::string query =
+            write.perf_query =
                 "INSERT OR REPLACE INTO "
                 "perf_db(config, solver, params) "
                 "VALUES("
                 "(SELECT id FROM " + problem_config.table_name() +  " "
                 "WHERE ( " + clause + " ) ) , ? , ?);";
             // clang-format on
+            write.config_key = GetConfigKey(problem_config.table_name(), clause, vals);
             vals.push_back(id);
             vals.push_back(params.str());
-            auto stmt = SQLite::Statement{sql, query, vals};
-            auto rc   = stmt.Step(sql);
-            if(rc != SQLITE_DONE)
-            {
-                MIOPEN_LOG_E("Failed to insert performance record in the database: " +
-                             sql.ErrorMessage());
-                return boost::none;
-            }
+            write.perf_values = std::move(vals);
         }
+
+        if(DbWriteBatchLimits::Get().IsEnabled())
+            AddPendingWrite(std::move(write));
+        else if(!Write(write))
+            return boost::none;
+
         DbRecord record;
         record.SetValues(id, values);
         return record;
@@ -533,6 +565,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
     {
         if(dbInvalid)
             return true;
+        Flush();
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
@@ -571,6 +604,35 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             return false;
         return record->GetValues(id, values);
     }
+
+    private:
+    struct PendingWrite
+    {
+        std::string config_query;
+        std::vector<std::string> config_values;
+        std::string perf_query;
+        std::vector<std::string> perf_values;
+        std::string config_key;
+    };
+
+    struct PendingWrites
+    {
+        std::mutex mutex;
+        std::vector<PendingWrite> writes;
+        // Solver parameters by config, so lookups see the updates before they are written.
+        std::unordered_map<std::string, DbRecord> records;
+        std::chrono::steady_clock::time_point first_write;
+    };
+
+    static std::string GetConfigKey(const std::string& table,
+                                    const std::string& clause,
+                                    const std::vector<std::string>& values);
+    bool Write(const PendingWrite& write);
+    void AddPendingWrite(PendingWrite&& write);
+    void FlushUnsafe(PendingWrites& pending_writes);
+    void MergePendingWrites(const std::string& config_key, DbRecord& record);
+
+    std::unique_ptr<PendingWrites> pending = std::make_unique<PendingWrites>();
 };
 } // namespace miopen
 #endif
@@ -143,7 +143,7 @@ struct TensorDescriptor : miopenTensorDescriptor
     TensorDescriptor(miopenDataType_t t, const Range1& plens, const Range2& pstrides)
         : lens(plens.begin(), plens.end()), strides(pstrides.begin(), pstrides.end()), type(t)
     {
-        packed = (this->GetElementSize() == this->GetElementSpace());
+        this->CalculateDerived();
     }
 
     void CalculateStrides();
@@ -209,10 +209,16 @@ struct TensorDescriptor : miopenTensorDescriptor
     friend std::ostream& operator<<(std::ostream& stream, const TensorDescriptor& t);
 
     private:
+    /// Computes the properties derived from the lengths and the strides, which are queried
+    /// for every use of the descriptor.
+    void CalculateDerived();
+
     std::vector<std::size_t> lens;
     std::vector<std::size_t> strides;
 
     bool packed;
+    std::size_t element_size  = 1;
+    std::size_t element_space = 1;
 
     miopenDataType_t type = miopenFloat;
 };
@@ -176,6 +176,27 @@ void OpTensor(const Handle& handle,
               size_t Boffset = 0,
               size_t Coffset = 0);
 
+/// Stride-generic OpTensor with any broadcast of B and an optional activation of the result:
+/// C = act(op(alpha0 * A, alpha1 * B) + beta * C). The tensors share a floating point type.
+void OpTensorElementwise(const Handle& handle,
+                         miopenTensorOp_t tensorOp,
+                         const void* alpha0,
+                         const TensorDescriptor& aTensorDesc,
+                         ConstData_t ATensor,
+                         const void* alpha1,
+                         const TensorDescriptor& bTensorDesc,
+                         ConstData_t BTensor,
+                         const void* beta,
+                         const TensorDescriptor& cTensorDesc,
+                         Data_t CTensor,
+                         size_t Aoffset                    = 0,
+                         size_t Boffset                    = 0,
+                         size_t Coffset                    = 0,
+                         miopenActivationMode_t activMode = miopenActivationPASTHRU,
+                         double activAlpha                 = 0,
+                         double activBeta                  = 0,
+                         double activGamma                 = 0);
+
 void CopyTensor(const Handle& handle,
                 const TensorDescriptor& srcDesc,
                 ConstData_t src,
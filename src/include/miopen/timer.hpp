@@ -50,18 +50,16 @@ class Timer
 
 class CompileTimer
 {
-#if MIOPEN_BUILD_DEV
     Timer timer;
-#endif
+    const trace::Clock::time_point begin = trace::Clock::now();
+
     public:
-    CompileTimer()
-    {
-#if MIOPEN_BUILD_DEV
-        timer.start();
-#endif
-    }
+    CompileTimer() { timer.start(); }
+    float ElapsedMs() { return timer.elapsed_ms(); }
     void Log(const std::string& s1, const std::string& s2 = {})
     {
+        if(trace::IsEnabled())
+            trace::Complete("compile", s1, begin, trace::Clock::now(), s2);
 #if MIOPEN_BUILD_DEV
         MIOPEN_LOG_I2(s1 << (s2.empty() ? "" : " ") << s2
                          << " Compile Time, ms: " << timer.elapsed_ms());
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACE_HPP_
+#define GUARD_MIOPEN_TRACE_HPP_
+
+#include <miopen/config.h>
+
+#include <chrono>
+#include <string>
+
+namespace miopen {
+namespace trace {
+
+/// A timeline of the API calls, find db lookups, kernel builds and kernel launches of the
+/// process, written in the Chrome trace event format to the file set by MIOPEN_TRACE_FILE when
+/// the process exits. Both chrome://tracing and the Perfetto UI open these files. The GPU time
+/// of the kernels is recorded while the profiling of their handle is enabled.
+///
+/// With roctx, the scopes are also reported as ranges to the ROCm profilers, whether or not
+/// MIOPEN_TRACE_FILE is set.
+
+using Clock = std::chrono::steady_clock;
+
+bool IsEnabled();
+
+/// An event of the calling thread, e.g. a build, from begin to end.
+void Complete(const char* category,
+              const std::string& name,
+              Clock::time_point begin,
+              Clock::time_point end,
+              const std::string& detail = {});
+/// A point event of the calling thread, e.g. a find db hit.
+void Instant(const char* category, const std::string& name, const std::string& detail = {});
+/// A kernel run on the GPU timeline. Its begin is estimated from the completion seen by the host
+/// and the time between its events.
+void Gpu(const std::string& name, Clock::time_point end, float elapsed_ms);
+
+/// Writes the events recorded so far, which is otherwise done at exit.
+void Flush();
+
+class Scope
+{
+    public:
+    Scope(const char* category, const char* name);
+    Scope(const char* category, const std::string& name);
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope();
+
+    private:
+    void Begin(const char* name);
+
+    const char* category;
+    std::string name;
+    Clock::time_point begin;
+    bool active = false;
+};
+
+} // namespace trace
+} // namespace miopen
+
+#define MIOPEN_TRACE_SCOPE(category, name) \
+    const miopen::trace::Scope MIOPEN_TRACE_PP_CAT(miopen_trace_scope_, __LINE__) { category, name }
+#define MIOPEN_TRACE_PP_CAT(x, y) MIOPEN_TRACE_PP_CAT_(x, y)
+#define MIOPEN_TRACE_PP_CAT_(x, y) x##y
+
+#endif // GUARD_MIOPEN_TRACE_HPP_
@@ -34,6 +34,7 @@
 namespace miopen {
 
 struct Handle;
+struct TensorDescriptor;
 
 float Im2ColGPU(
     const Handle& handle,
@@ -113,6 +114,18 @@ float transpose_packed_MN2NM(const Handle& handle,
                              ConstData_t in,
                              Data_t out,
                              miopenDataType_t type);
+
+/// Copies x to y with the dimensions permuted, the output dimension i is the input dimension
+/// perm[i]. Both tensors may be strided; float, half and bfloat16 elements are converted when
+/// the types of the tensors differ.
+float PermuteTensorGPU(const Handle& handle,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       const TensorDescriptor& yDesc,
+                       Data_t y,
+                       const std::vector<int>& perm,
+                       std::size_t x_offset = 0,
+                       std::size_t y_offset = 0);
 } // namespace miopen
 
 #endif // _MIOPEN_UTIL_HPP_
@@ -27,81 +27,121 @@
 #include <miopen/invoker_cache.hpp>
 #include <miopen/logger.hpp>
 
+#include <mutex>
+
 namespace miopen {
 
-boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
+const InvokerCache::Item* InvokerCache::FindItem(const Shard& shard, const NetworkConfig& config)
+{
+    const auto range = shard.items.equal_range(config.GetHash());
+    for(auto it = range.first; it != range.second; ++it)
+        if(it->second.network_config == config.ToString())
+            return &it->second;
+    return nullptr;
+}
+
+InvokerCache::Item* InvokerCache::FindItem(Shard& shard, const NetworkConfig& config)
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
+    return const_cast<Item*>(FindItem(static_cast<const Shard&>(shard), config));
+}
+
+boost::optional<const Invoker&> InvokerCache::operator()(const NetworkConfig& config,
+                                                         solver::Id solver_id) const
+{
+    const auto& shard = GetShard(config);
+    const std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    const auto item = FindItem(shard, config);
+    if(item == nullptr)
         return boost::none;
-    const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
-    if(invoker == item_invokers.end())
+    const auto invoker = item->invokers.find(solver_id.Value());
+    if(invoker == item->invokers.end())
         return boost::none;
     return invoker->second;
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
-                                                          const std::string& algorithm) const
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const NetworkConfig& config,
+                                                          const AlgorithmName& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    const auto& shard = GetShard(config);
+    const std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    const auto item = FindItem(shard, config);
+    if(item == nullptr)
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
+        MIOPEN_LOG_I2("No invokers found for " << config.ToString());
         return boost::none;
     }
-    if(item->second.found_1_0.empty())
+    if(item->found_1_0.empty())
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
+        MIOPEN_LOG_I2("Invokers found for " << config.ToString()
                                             << " but there is no find 1.0 result.");
         return boost::none;
     }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+    const auto found_1_0_id = item->found_1_0.find(algorithm.ToString());
+    if(found_1_0_id == item->found_1_0.end())
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
+        MIOPEN_LOG_I2("Invokers found for " << config.ToString()
+                                            << " but there is no one with an algorithm "
+                                            << algorithm.ToString());
         return boost::none;
     }
-    const auto invoker = item_invokers.find(found_1_0_id->second);
-    if(invoker == item_invokers.end())
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
+    const auto invoker = item->invokers.find(found_1_0_id->second);
+    if(invoker == item->invokers.end())
+        MIOPEN_THROW("No invoker with solver_id of " +
+                     solver::Id{found_1_0_id->second}.ToString() + " was registered for " +
+                     config.ToString());
     return invoker->second;
 }
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+boost::optional<solver::Id> InvokerCache::GetFound1_0Id(const NetworkConfig& config,
+                                                        const AlgorithmName& algorithm) const
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    const auto& shard = GetShard(config);
+    const std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    const auto item = FindItem(shard, config);
+    if(item == nullptr)
+        return boost::none;
+    const auto found_1_0_id = item->found_1_0.find(algorithm.ToString());
+    if(found_1_0_id == item->found_1_0.end())
+        return boost::none;
+    return solver::Id{found_1_0_id->second};
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
-                                 const std::string& algorithm,
-                                 const std::string& solver_id)
+void InvokerCache::Register(const NetworkConfig& config,
+                            solver::Id solver_id,
+                            const Invoker& invoker)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
+    auto& shard = GetShard(config);
+    {
+        const std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+        auto item = FindItem(shard, config);
+        if(item == nullptr)
+            item = &shard.items.emplace(config.GetHash(), Item{config.ToString()})->second;
+        item->invokers.insert({solver_id.Value(), invoker});
+    }
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << config.ToString() << " and solver "
+                                                      << solver_id.ToString());
+}
 
+void InvokerCache::SetAsFound1_0(const NetworkConfig& config,
+                                 const AlgorithmName& algorithm,
+                                 solver::Id solver_id)
+{
+    auto& shard = GetShard(config);
     {
+        const std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+        const auto item = FindItem(shard, config);
+        if(item == nullptr)
+            MIOPEN_THROW("No invoker was registered for " + config.ToString());
+
         // Validating at find time
-        const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
-        if(invoker == item_invokers.end())
-            MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
-    }
+        if(item->invokers.find(solver_id.Value()) == item->invokers.end())
+            MIOPEN_THROW("No invoker with solver_id of " + solver_id.ToString() +
+                         " was registered for " + config.ToString());
 
-    item->second.found_1_0[algorithm] = solver_id;
-    MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
-                            << " in " << network_config);
+        item->found_1_0[algorithm.ToString()] = solver_id.Value();
+    }
+    MIOPEN_LOG_I2("Solver " << solver_id.ToString() << " registered as find 1.0 best for "
+                            << algorithm.ToString() << " in " << config.ToString());
 }
 
 } // namespace miopen
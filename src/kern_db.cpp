@@ -25,17 +25,24 @@
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
 
+#include <miopen/compile_stats.hpp>
+#include <miopen/timer.hpp>
+
 namespace miopen {
 KernDb::KernDb(const std::string& filename_, bool is_system)
     : KernDb(filename_, is_system, compress, decompress)
 {
+    codec = GetKernDbCodec();
 }
 
 KernDb::KernDb(const std::string& filename_,
                bool is_system,
                std::function<std::string(std::string, bool*)> _compress_fn,
                std::function<std::string(std::string, unsigned int)> _decompress_fn)
-    : SQLiteBase(filename_, is_system), compress_fn(_compress_fn), decompress_fn(_decompress_fn)
+    : SQLiteBase(filename_, is_system),
+      compress_fn(_compress_fn),
+      decompress_fn(_decompress_fn),
+      codec(KernDbCodec::Bz2)
 {
     if(dbInvalid)
     {
@@ -58,7 +65,384 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
+    }
+
+    has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    if(!has_codec_column && !is_system)
+    {
+        sql.Exec("ALTER TABLE `" + KernelConfig::table_name() + "` ADD COLUMN `codec` INT;");
+        has_codec_column = true;
+    }
+
+    has_key_column = CheckTableColumns(KernelConfig::table_name(), {"kernel_key"});
+    if(!is_system)
+    {
+        if(!has_key_column)
+            AddKeyColumn();
+        sql.Exec(KernelConfig::CreateKeyIndexQuery());
+        has_key_column = true;
+        sql.Exec(KernelConfig::CreateHashIndexQuery());
+        deduplicate = true;
+    }
+}
+
+namespace {
+struct StatementReset
+{
+    SQLite::Statement& stmt;
+    ~StatementReset() { stmt.Reset(); }
+};
+} // namespace
+
+std::int64_t KernelConfig::Key() const
+{
+    // 64-bit FNV-1a, which is stable across the platforms unlike std::hash.
+    auto hash        = std::uint64_t{14695981039346656037ULL};
+    const auto apply = [&](const std::string& str) {
+        for(const auto c : str)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+    };
+    apply(kernel_name);
+    apply(std::string(1, '\0'));
+    apply(kernel_args);
+    return static_cast<std::int64_t>(hash);
+}
+
+void KernDb::AddKeyColumn()
+{
+    const auto table = KernelConfig::table_name();
+    sql.Exec("ALTER TABLE `" + table + "` ADD COLUMN `kernel_key` INT;");
+
+    auto keys = std::vector<std::pair<std::int64_t, std::int64_t>>{};
+    {
+        auto select = SQLite::Statement{sql,
+                                        "SELECT id, kernel_name, kernel_args FROM " + table +
+                                            " WHERE kernel_key IS NULL;"};
+        while(true)
+        {
+            const auto rc = select.Step(sql);
+            if(rc == SQLITE_DONE)
+                break;
+            if(rc != SQLITE_ROW)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            const auto config = KernelConfig{select.ColumnText(1), select.ColumnText(2), ""};
+            keys.emplace_back(select.ColumnInt64(0), config.Key());
+        }
+    }
+
+    MIOPEN_LOG_I2("Adding keys to " << keys.size() << " records of " << filename);
+    sql.Exec("BEGIN;");
+    auto update = SQLite::Statement{sql, "UPDATE " + table + " SET kernel_key = ? WHERE id = ?;"};
+    for(const auto& key : keys)
+    {
+        update.BindInt64(1, key.second);
+        update.BindInt64(2, key.first);
+        if(update.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        update.Reset();
+    }
+    sql.Exec("COMMIT;");
+}
+
+std::string KernDb::GetKeyClause() const
+{
+    return has_key_column ? "(kernel_key = ?) AND (kernel_name = ?) AND (kernel_args = ?)"
+                          : "(kernel_name = ?) AND (kernel_args = ?)";
+}
+
+void KernDb::BindKey(SQLite::Statement& stmt, const KernelConfig& config, int first) const
+{
+    if(has_key_column)
+        stmt.BindInt64(first++, config.Key());
+    stmt.BindText(first++, config.kernel_name);
+    stmt.BindText(first, config.kernel_args);
+}
+
+SQLite::Statement& KernDb::GetStatement(const std::string& query)
+{
+    auto it = statements->cache.find(query);
+    if(it == statements->cache.end())
+        it = statements->cache.emplace(query, SQLite::Statement{sql, query}).first;
+    return it->second;
+}
+
+bool KernDb::RemoveRecordUnsafe(const KernelConfig& problem_config)
+{
+    if(filename.empty())
+        return true;
+
+    std::lock_guard<std::mutex> lock{statements->mutex};
+
+    // The blob of the record moves to one of the records which share it.
+    auto hash              = std::string{};
+    auto blob              = std::string{};
+    auto uncompressed_size = std::int64_t{};
+    auto blob_codec        = std::int64_t{};
+    if(deduplicate)
+    {
+        auto& stmt = GetStatement("SELECT kernel_hash, kernel_blob, uncompressed_size, " +
+                                  GetCodecColumn() + " FROM " + KernelConfig::table_name() +
+                                  " WHERE " + GetKeyClause() + ";");
+        const StatementReset reset{stmt};
+        BindKey(stmt, problem_config, 1);
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_ROW)
+        {
+            hash              = stmt.ColumnText(0);
+            blob              = stmt.ColumnBlob(1);
+            uncompressed_size = stmt.ColumnInt64(2);
+            blob_codec        = stmt.ColumnInt64(3);
+        }
+        else if(rc != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+
+    {
+        auto& stmt = GetStatement("DELETE FROM " + KernelConfig::table_name() + " WHERE " +
+                                  GetKeyClause() + ";");
+        const StatementReset reset{stmt};
+        BindKey(stmt, problem_config, 1);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+
+    if(!blob.empty())
+    {
+        const auto table = KernelConfig::table_name();
+        auto& stmt       = GetStatement(
+            "UPDATE " + table + " SET kernel_blob = ?, uncompressed_size = ?, codec = ? " +
+            "WHERE id = (SELECT id FROM " + table +
+            " WHERE (kernel_hash = ?) AND (length(kernel_blob) = 0) LIMIT 1);");
+        const StatementReset reset{stmt};
+        stmt.BindBlob(1, blob);
+        stmt.BindInt64(2, uncompressed_size);
+        stmt.BindInt64(3, blob_codec);
+        stmt.BindText(4, hash);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+    return true;
+}
+
+bool KernDb::HasBlob(const std::string& hash)
+{
+    auto& stmt = GetStatement("SELECT 1 FROM " + KernelConfig::table_name() +
+                              " WHERE (kernel_hash = ?) AND (length(kernel_blob) > 0) LIMIT 1;");
+    const StatementReset reset{stmt};
+    stmt.BindText(1, hash);
+    const auto rc = stmt.Step(sql);
+    if(rc != SQLITE_ROW && rc != SQLITE_DONE)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    return rc == SQLITE_ROW;
+}
+
+boost::optional<std::string> KernDb::FindRecordUnsafe(const KernelConfig& problem_config)
+{
+    if(filename.empty())
+        return boost::none;
+
+    auto compressed_blob   = std::string{};
+    auto md5_hash          = std::string{};
+    auto uncompressed_size = std::int64_t{};
+    auto blob_codec        = KernDbCodec::None;
+
+    {
+        std::lock_guard<std::mutex> lock{statements->mutex};
+        auto& stmt = GetStatement("SELECT kernel_blob, kernel_hash, uncompressed_size, " +
+                                  GetCodecColumn() + " FROM " + KernelConfig::table_name() +
+                                  " WHERE " + GetKeyClause() + ";");
+        const StatementReset reset{stmt};
+        BindKey(stmt, problem_config, 1);
+
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_DONE)
+            return boost::none;
+        if(rc != SQLITE_ROW)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+
+        compressed_blob   = stmt.ColumnBlob(0);
+        md5_hash          = stmt.ColumnText(1);
+        uncompressed_size = stmt.ColumnInt64(2);
+        blob_codec        = static_cast<KernDbCodec>(stmt.ColumnInt64(3));
+    }
+
+    // The record shares the code object of another one. Code objects are never empty.
+    if(compressed_blob.empty())
+    {
+        std::lock_guard<std::mutex> lock{statements->mutex};
+        auto& stmt = GetStatement(
+            "SELECT kernel_blob, uncompressed_size, " + GetCodecColumn() + " FROM " +
+            KernelConfig::table_name() +
+            " WHERE (kernel_hash = ?) AND (length(kernel_blob) > 0) LIMIT 1;");
+        const StatementReset reset{stmt};
+        stmt.BindText(1, md5_hash);
+
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_DONE)
+        {
+            MIOPEN_LOG_W("Shared code object is missing: " << problem_config.kernel_name);
+            return boost::none;
+        }
+        if(rc != SQLITE_ROW)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+
+        compressed_blob   = stmt.ColumnBlob(0);
+        uncompressed_size = stmt.ColumnInt64(1);
+        blob_codec        = static_cast<KernDbCodec>(stmt.ColumnInt64(2));
+    }
+
+    // Decompression and hashing do not hold the connection.
+    Timer timer;
+    timer.start();
+    auto decompressed_blob = DecodeBlob(blob_codec, compressed_blob, uncompressed_size);
+    if(blob_codec != KernDbCodec::None)
+        CompileStats::Get().AddDecompression(decompressed_blob.size(), timer.elapsed_ms());
+    if(md5(decompressed_blob) != md5_hash)
+        MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+    return decompressed_blob;
+}
+
+boost::optional<std::string> KernDb::StoreRecordUnsafe(const KernelConfig& problem_config)
+{
+    if(filename.empty())
+        return boost::none;
+
+    const auto md5_sum = md5(problem_config.kernel_blob);
+
+    // Options which the kernel ignores produce identical code objects.
+    auto shared = false;
+    if(deduplicate)
+    {
+        std::lock_guard<std::mutex> lock{statements->mutex};
+        shared = HasBlob(md5_sum);
+    }
+    auto compressed_blob  = std::string{};
+    const auto blob_codec =
+        shared ? KernDbCodec::None : EncodeBlob(problem_config.kernel_blob, compressed_blob);
+
+    auto insert_query = "INSERT OR IGNORE INTO " + KernelConfig::table_name() +
+                        "(kernel_name, kernel_args, kernel_blob, kernel_hash, uncompressed_size";
+    auto params = std::string{"?, ?, ?, ?, ?"};
+    if(has_codec_column)
+    {
+        insert_query += ", codec";
+        params += ", ?";
+    }
+    if(has_key_column)
+    {
+        insert_query += ", kernel_key";
+        params += ", ?";
+    }
+    insert_query += ") VALUES(" + params + ");";
+
+    std::lock_guard<std::mutex> lock{statements->mutex};
+    {
+        auto& stmt = GetStatement(insert_query);
+        const StatementReset reset{stmt};
+        stmt.BindText(1, problem_config.kernel_name);
+        stmt.BindText(2, problem_config.kernel_args);
+        if(shared)
+        {
+            stmt.BindBlob(3, std::string{});
+            stmt.BindInt64(5, 0);
+        }
+        else if(blob_codec == KernDbCodec::None)
+        {
+            stmt.BindBlob(3, problem_config.kernel_blob);
+            stmt.BindInt64(5, 0);
+        }
+        else
+        {
+            stmt.BindBlob(3, compressed_blob);
+            stmt.BindInt64(5, problem_config.kernel_blob.size());
+        }
+        stmt.BindText(4, md5_sum);
+        auto next = 6;
+        if(has_codec_column)
+            stmt.BindInt64(next++, static_cast<int>(blob_codec));
+        if(has_key_column)
+            stmt.BindInt64(next, problem_config.Key());
+
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+
+    if(has_key_column && sql.Changes() == 0)
+    {
+        // The record may have been stored without the key by a previous version.
+        auto& stmt = GetStatement("UPDATE " + KernelConfig::table_name() +
+                                  " SET kernel_key = ? WHERE (kernel_name = ?) AND "
+                                  "(kernel_args = ?) AND (kernel_key IS NULL);");
+        const StatementReset reset{stmt};
+        stmt.BindInt64(1, problem_config.Key());
+        stmt.BindText(2, problem_config.kernel_name);
+        stmt.BindText(3, problem_config.kernel_args);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+    return problem_config.kernel_blob;
+}
+
+std::string KernDb::GetCodecColumn() const
+{
+    // The records without the codec have been compressed with bz2 unless stored as is.
+    const auto legacy_codec = "(CASE WHEN uncompressed_size = 0 THEN " +
+                              std::to_string(static_cast<int>(KernDbCodec::None)) + " ELSE " +
+                              std::to_string(static_cast<int>(KernDbCodec::Bz2)) + " END)";
+    if(!has_codec_column)
+        return legacy_codec;
+    return "IFNULL(codec, " + legacy_codec + ")";
+}
+
+KernDbCodec KernDb::EncodeBlob(const std::string& blob, std::string& encoded) const
+{
+    if(blob.size() < kern_db_min_compressed_size)
+        return KernDbCodec::None;
+
+    // The database without the codec column can only store bz2 records.
+    const auto blob_codec = has_codec_column ? codec : KernDbCodec::Bz2;
+
+    if(blob_codec == KernDbCodec::Bz2)
+    {
+        auto success = false;
+        encoded      = compress_fn(blob, &success);
+        return success ? KernDbCodec::Bz2 : KernDbCodec::None;
+    }
+
+    return CompressBlob(blob_codec, blob, encoded) ? blob_codec : KernDbCodec::None;
+}
+
+std::string
+KernDb::DecodeBlob(KernDbCodec blob_codec, const std::string& blob, std::size_t size) const
+{
+    if(blob_codec == KernDbCodec::None)
+        return blob;
+    if(blob_codec == KernDbCodec::Bz2)
+        return decompress_fn(blob, size);
+    return DecompressBlob(blob_codec, blob, size);
+}
+
+std::vector<KernelConfig> KernDb::GetAllKeysUnsafe()
+{
+    std::vector<KernelConfig> keys;
+    if(filename.empty() || dbInvalid)
+        return keys;
+    auto stmt = SQLite::Statement{
+        sql, "SELECT kernel_name, kernel_args FROM " + KernelConfig::table_name() + ";"};
+    while(true)
+    {
+        const auto rc = stmt.Step(sql);
+        if(rc == SQLITE_DONE)
+            break;
+        if(rc != SQLITE_ROW)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        keys.push_back({stmt.ColumnText(0), stmt.ColumnText(1), ""});
     }
+    return keys;
 }
 
 } // namespace miopen
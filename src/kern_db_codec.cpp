@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kern_db_codec.hpp>
+
+#include <miopen/bz2.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#if MIOPEN_USE_ZSTD
+#include <zstd.h>
+#endif
+#if MIOPEN_USE_LZ4
+#include <lz4.h>
+#endif
+
+#include <limits>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERN_DB_CODEC)
+
+namespace miopen {
+
+bool IsAvailable(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::None:
+    case KernDbCodec::Bz2: return true;
+    case KernDbCodec::Zstd: return MIOPEN_USE_ZSTD != 0;
+    case KernDbCodec::Lz4: return MIOPEN_USE_LZ4 != 0;
+    }
+    return false;
+}
+
+const char* ToString(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::None: return "none";
+    case KernDbCodec::Bz2: return "bz2";
+    case KernDbCodec::Zstd: return "zstd";
+    case KernDbCodec::Lz4: return "lz4";
+    }
+    return "<unknown>";
+}
+
+static KernDbCodec GetDefaultCodec()
+{
+    // Decompression of lz4 is the fastest, zstd compresses better at a close speed.
+    if(IsAvailable(KernDbCodec::Zstd))
+        return KernDbCodec::Zstd;
+    if(IsAvailable(KernDbCodec::Lz4))
+        return KernDbCodec::Lz4;
+    return KernDbCodec::Bz2;
+}
+
+KernDbCodec GetKernDbCodec()
+{
+    static const auto codec = []() {
+        const auto name = GetStringEnv(MIOPEN_KERN_DB_CODEC{});
+        if(name == nullptr)
+            return GetDefaultCodec();
+
+        for(const auto codec :
+            {KernDbCodec::None, KernDbCodec::Bz2, KernDbCodec::Zstd, KernDbCodec::Lz4})
+        {
+            if(std::string{name} != ToString(codec))
+                continue;
+            if(IsAvailable(codec))
+                return codec;
+            MIOPEN_LOG_W("Kernel cache codec is not available: " << name);
+            return GetDefaultCodec();
+        }
+        MIOPEN_LOG_W("Unknown kernel cache codec: " << name);
+        return GetDefaultCodec();
+    }();
+    return codec;
+}
+
+bool CompressBlob(KernDbCodec codec, const std::string& blob, std::string& compressed)
+{
+    switch(codec)
+    {
+    case KernDbCodec::None: return false;
+    case KernDbCodec::Bz2: {
+        auto success = false;
+        compressed   = compress(blob, &success);
+        return success;
+    }
+    case KernDbCodec::Zstd: {
+#if MIOPEN_USE_ZSTD
+        compressed.resize(ZSTD_compressBound(blob.size()));
+        const auto size =
+            ZSTD_compress(&compressed[0], compressed.size(), blob.data(), blob.size(), 9);
+        if(ZSTD_isError(size) != 0)
+            MIOPEN_THROW(std::string{"ZSTD_compress failed: "} + ZSTD_getErrorName(size));
+        compressed.resize(size);
+        return size < blob.size();
+#else
+        break;
+#endif
+    }
+    case KernDbCodec::Lz4: {
+#if MIOPEN_USE_LZ4
+        if(blob.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE))
+            return false;
+        const auto src_size = static_cast<int>(blob.size());
+        compressed.resize(LZ4_compressBound(src_size));
+        const auto size = LZ4_compress_default(
+            blob.data(), &compressed[0], src_size, static_cast<int>(compressed.size()));
+        if(size <= 0)
+            MIOPEN_THROW("LZ4_compress_default failed");
+        compressed.resize(size);
+        return compressed.size() < blob.size();
+#else
+        break;
+#endif
+    }
+    }
+    MIOPEN_THROW("Kernel cache codec is not available: " + std::string{ToString(codec)});
+}
+
+std::string DecompressBlob(KernDbCodec codec, const std::string& blob, std::size_t size)
+{
+    switch(codec)
+    {
+    case KernDbCodec::None: return blob;
+    case KernDbCodec::Bz2: return decompress(blob, size);
+    case KernDbCodec::Zstd: {
+#if MIOPEN_USE_ZSTD
+        auto result = std::string(size, '\0');
+        const auto decompressed_size =
+            ZSTD_decompress(&result[0], result.size(), blob.data(), blob.size());
+        if(ZSTD_isError(decompressed_size) != 0 || decompressed_size != size)
+            MIOPEN_THROW("ZSTD_decompress failed: possible database corruption");
+        return result;
+#else
+        break;
+#endif
+    }
+    case KernDbCodec::Lz4: {
+#if MIOPEN_USE_LZ4
+        if(size > static_cast<std::size_t>(std::numeric_limits<int>::max()) ||
+           blob.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+            MIOPEN_THROW("LZ4_decompress_safe failed: possible database corruption");
+        auto result                  = std::string(size, '\0');
+        const auto decompressed_size = LZ4_decompress_safe(
+            blob.data(), &result[0], static_cast<int>(blob.size()), static_cast<int>(size));
+        if(decompressed_size < 0 || static_cast<std::size_t>(decompressed_size) != size)
+            MIOPEN_THROW("LZ4_decompress_safe failed: possible database corruption");
+        return result;
+#else
+        break;
+#endif
+    }
+    }
+    MIOPEN_THROW("Kernel cache codec is not available to read the record: " +
+                 std::string{ToString(codec)});
+}
+
+} // namespace miopen
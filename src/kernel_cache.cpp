@@ -39,36 +39,68 @@
  * limitations under the License.
  * ************************************************************************ */
 
+#include <miopen/compile_stats.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/stringutils.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERNEL_CACHE_LIMIT_MB)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERNEL_CACHE_LIMIT_ENTRIES)
 
 namespace miopen {
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+static std::size_t GetCodeObjectSize(const Program& program)
+{
+#if MIOPEN_BACKEND_OPENCL
+    std::size_t size = 0;
+    if(program == nullptr || clGetProgramInfo(program.get(),
+                                              CL_PROGRAM_BINARY_SIZES,
+                                              sizeof(size),
+                                              &size,
+                                              nullptr) != CL_SUCCESS)
+        return 0;
+    return size;
+#else
+    return program.GetCodeObjectSize();
+#endif
+}
+
+KernelCache::KernelCache()
+    : KernelCache(Value(MIOPEN_KERNEL_CACHE_LIMIT_MB{}, 0) * 1024 * 1024,
+                  Value(MIOPEN_KERNEL_CACHE_LIMIT_ENTRIES{}, 0))
+{
+}
+
+KernelCache::KernelCache(std::size_t max_code_objects_size_, std::size_t max_entries_)
+    : max_code_objects_size(max_code_objects_size_), max_entries(max_entries_)
+{
+}
+
+std::vector<Kernel> KernelCache::GetKernels(const std::string& algorithm,
+                                            const std::string& network_config)
 {
 
     std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
 
+    const std::lock_guard<std::mutex> lock(mutex);
     const auto it = kernel_map.find(key);
     if(it != kernel_map.end())
     {
-        MIOPEN_LOG_I2(it->second.size()
+        MIOPEN_LOG_I2(it->second.kernels.size()
                       << " kernels for key: " << key.first << " \"" << key.second << '\"');
-        return it->second;
+        kernel_lru.splice(kernel_lru.begin(), kernel_lru, it->second.lru);
+        return it->second.kernels;
     }
 
-    static const std::vector<Kernel> empty{};
     MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
-    return empty;
+    return {};
 }
 
 bool KernelCache::HasKernels(const std::string& algorithm, const std::string& network_config) const
@@ -77,11 +109,12 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
 #ifndef NDEBUG
     MIOPEN_LOG_I("Key: " << key.first << " \"" << key.second << '\"');
 #endif
+    const std::lock_guard<std::mutex> lock(mutex);
     const auto it = kernel_map.find(key);
     if(it == kernel_map.end())
         return false;
 
-    if(it->second.empty())
+    if(it->second.kernels.empty())
     {
         MIOPEN_THROW("There should be at least one kernel in kernel cache if an entry exists");
     }
@@ -92,12 +125,26 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
 bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
 {
     const auto key = std::make_pair(name, params);
+    const std::lock_guard<std::mutex> lock(mutex);
     return program_map.count(key) > 0;
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    const std::lock_guard<std::mutex> lock(mutex);
+    const auto key = std::make_pair(program_name, params);
+    const auto it  = program_map.find(key);
+    if(it != program_map.end())
+        EraseProgram(it);
+    InsertProgram(key, prog);
+}
+
+void KernelCache::RemoveProgram(const std::string& program_name, const std::string& params)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    const auto it = program_map.find(std::make_pair(program_name, params));
+    if(it != program_map.end())
+        EraseProgram(it);
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -116,20 +163,33 @@ Kernel KernelCache::AddKernel(const Handle& h,
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
         MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
 
+    const auto program_key = std::make_pair(program_name, params);
     Program program;
+    bool found = false;
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
     {
-        program = program_it->second;
+        const std::lock_guard<std::mutex> lock(mutex);
+        auto program_it = program_map.find(program_key);
+        if(program_it != program_map.end())
+        {
+            program = program_it->second.program;
+            found   = true;
+            program_lru.splice(program_lru.begin(), program_lru, program_it->second.lru);
+        }
     }
-    else
+
+    CompileStats::Get().AddLookup(CompileCache::Kernels, found);
+    AddMetric(h, found ? Metric::KernelCacheHits : Metric::KernelCacheMisses);
+    if(!found)
     {
         if(!is_kernel_miopengemm_str) // default value
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
         program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+
+        // Another thread may have built the same program meanwhile, keep the first one.
+        const std::lock_guard<std::mutex> lock(mutex);
+        program = InsertProgram(program_key, program);
     }
 
     Kernel kernel{};
@@ -145,19 +205,35 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
     if(!network_config.empty() && !algorithm.empty())
     {
-        this->AddKernel(key, kernel, cache_index);
+        this->AddKernel(key, kernel, cache_index, program_key);
     }
     return kernel;
 }
 
-void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
+void KernelCache::AddKernel(const Key& key, Kernel k, std::size_t cache_index, const Key& program)
 {
-    auto&& v = kernel_map[key];
-    if(cache_index >= v.size())
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto it = kernel_map.find(key);
+    if(it == kernel_map.end())
+    {
+        kernel_lru.push_front(key);
+        it             = kernel_map.emplace(key, KernelEntry{}).first;
+        it->second.lru = kernel_lru.begin();
+    }
+    else
+    {
+        kernel_lru.splice(kernel_lru.begin(), kernel_lru, it->second.lru);
+    }
+
+    auto&& entry = it->second;
+    if(cache_index >= entry.kernels.size())
     {
-        v.resize(cache_index + 1);
+        entry.kernels.resize(cache_index + 1);
     }
-    v[cache_index] = k;
+    entry.kernels[cache_index] = k;
+    if(std::find(entry.programs.begin(), entry.programs.end(), program) == entry.programs.end())
+        entry.programs.push_back(program);
+    Evict();
 }
 
 void KernelCache::ClearKernels(const std::string& algorithm, const std::string& network_config)
@@ -167,14 +243,106 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
         MIOPEN_THROW("Network config or algorithm empty.");
     }
     const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v                                      = this->kernel_map[key];
-    if(!v.empty())
+    const std::lock_guard<std::mutex> lock(mutex);
+    const auto it = kernel_map.find(key);
+    if(it != kernel_map.end())
+    {
+        MIOPEN_LOG_I2(it->second.kernels.size()
+                      << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        EraseKernels(it);
+    }
+}
+
+std::size_t KernelCache::GetCodeObjectsSize() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    return code_objects_size;
+}
+
+std::vector<std::pair<KernelCache::Key, Program>> KernelCache::GetPrograms() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto programs = std::vector<std::pair<Key, Program>>{};
+    programs.reserve(program_lru.size());
+    for(const auto& key : program_lru)
+        programs.emplace_back(key, program_map.at(key).program);
+    return programs;
+}
+
+std::size_t KernelCache::GetProgramsCount() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    return program_map.size();
+}
+
+std::size_t KernelCache::GetKernelsCount() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    return kernel_map.size();
+}
+
+Program KernelCache::InsertProgram(const Key& key, const Program& program)
+{
+    const auto found = program_map.find(key);
+    if(found != program_map.end())
+    {
+        program_lru.splice(program_lru.begin(), program_lru, found->second.lru);
+        return found->second.program;
+    }
+
+    program_lru.push_front(key);
+    const auto size = GetCodeObjectSize(program);
+    program_map.emplace(key, ProgramEntry{program, size, program_lru.begin()});
+    code_objects_size += size;
+    MIOPEN_LOG_I2("Programs: " << program_map.size() << ", code objects: " << code_objects_size
+                               << " bytes");
+    Evict();
+    return program;
+}
+
+void KernelCache::EraseProgram(ProgramMap::iterator it)
+{
+    // Kernels of the program keep it loaded, so these are dropped as well.
+    for(auto kernels = kernel_map.begin(); kernels != kernel_map.end();)
     {
-        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        const auto& programs = kernels->second.programs;
+        const auto next      = std::next(kernels);
+        if(std::find(programs.begin(), programs.end(), it->first) != programs.end())
+            EraseKernels(kernels);
+        kernels = next;
     }
-    v.clear();
+
+    code_objects_size -= it->second.size;
+    program_lru.erase(it->second.lru);
+    program_map.erase(it);
+}
+
+void KernelCache::EraseKernels(KernelMap::iterator it)
+{
+    kernel_lru.erase(it->second.lru);
+    kernel_map.erase(it);
 }
 
-KernelCache::KernelCache() {}
+void KernelCache::Evict()
+{
+    // The most recently used entries are never evicted, those are just being added.
+    while(max_entries != 0 && kernel_map.size() > max_entries && kernel_lru.size() > 1)
+    {
+        MIOPEN_LOG_I2("Evicting kernels for key: " << kernel_lru.back().first << " \""
+                                                   << kernel_lru.back().second << '\"');
+        EraseKernels(kernel_map.find(kernel_lru.back()));
+    }
+
+    while(program_lru.size() > 1 &&
+          ((max_entries != 0 && program_map.size() > max_entries) ||
+           (max_code_objects_size != 0 && code_objects_size > max_code_objects_size)))
+    {
+        MIOPEN_LOG_I2("Evicting program: " << program_lru.back().first << " \""
+                                           << program_lru.back().second << '\"');
+        EraseProgram(program_map.find(program_lru.back()));
+        MIOPEN_LOG_I2("Programs: " << program_map.size() << ", code objects: "
+                                   << code_objects_size << " bytes");
+    }
+}
 
 } // namespace miopen
@@ -102,8 +102,9 @@ MIOpenBatchNormActivInferSpatialEst(const _FLOAT alpha,
         ActivationFunction(MIOPEN_READ_UNIT, actRes, bnRes, gamma, beta, alpha);
         for(int i = 0; i < MIOPEN_READ_UNIT; i++)
         {
-            out[index + i] = (_FLOAT)actRes[i];
+            data[i] = (_FLOAT)actRes[i];
         }
+        *((__global MIOPEN_READ_TYPE*)(out + index)) = *((MIOPEN_READ_TYPE*)data);
     }
 } // end spatial norm
 
@@ -141,10 +142,6 @@ MIOpenBatchNormActivInferPerActEst(const _FLOAT alpha,
     _FLOAT_PREC pscale[MIOPEN_READ_UNIT];
     _FLOAT_PREC pbias[MIOPEN_READ_UNIT];
 
-    *((MIOPEN_READ_TYPE*)pmean)  = *((const __global MIOPEN_READ_TYPE*)(estimatedMean + chw_i));
-    *((MIOPEN_READ_TYPE*)pvar)   = *((const __global MIOPEN_READ_TYPE*)(estimatedVariance + chw_i));
-    *((MIOPEN_READ_TYPE*)pscale) = *((const __global MIOPEN_READ_TYPE*)(scale + chw_i));
-    *((MIOPEN_READ_TYPE*)pbias)  = *((const __global MIOPEN_READ_TYPE*)(bias + chw_i));
     for(int i = 0; i < MIOPEN_READ_UNIT; i++)
     {
         pmean[i]  = estimatedMean[chw_i + i];
@@ -168,8 +165,9 @@ MIOpenBatchNormActivInferPerActEst(const _FLOAT alpha,
         ActivationFunction(MIOPEN_READ_UNIT, actRes, bnRes, gamma, beta, alpha);
         for(int i = 0; i < MIOPEN_READ_UNIT; i++)
         {
-            out[index + i] = (_FLOAT)actRes[i];
+            data[i] = (_FLOAT)actRes[i];
         }
+        *((__global MIOPEN_READ_TYPE*)(out + index)) = *((MIOPEN_READ_TYPE*)data);
     }
 }
 
@@ -34,6 +34,40 @@
 
 #include "batchnorm_functions.h"
 
+#ifndef MIO_BN_VEC
+#define MIO_BN_VEC 1
+#endif
+
+// Each work-item transforms MIO_BN_VEC consecutive elements of an image, the host only picks a
+// vector size that divides the image.
+static inline void infer_load(const global _FLOAT* p, _FLOAT_PREC* v)
+{
+#if MIO_BN_VEC == 4
+    const _FLOAT4 t = vload4(0, p);
+    v[0]            = BN_LOAD(t.x);
+    v[1]            = BN_LOAD(t.y);
+    v[2]            = BN_LOAD(t.z);
+    v[3]            = BN_LOAD(t.w);
+#elif MIO_BN_VEC == 2
+    const _FLOAT2 t = vload2(0, p);
+    v[0]            = BN_LOAD(t.x);
+    v[1]            = BN_LOAD(t.y);
+#else
+    v[0] = BN_LOAD(*p);
+#endif
+}
+
+static inline void infer_store(global _FLOAT* p, const _FLOAT_PREC* v)
+{
+#if MIO_BN_VEC == 4
+    vstore4((_FLOAT4)(BN_STORE(v[0]), BN_STORE(v[1]), BN_STORE(v[2]), BN_STORE(v[3])), 0, p);
+#elif MIO_BN_VEC == 2
+    vstore2((_FLOAT2)(BN_STORE(v[0]), BN_STORE(v[1])), 0, p);
+#else
+    *p = BN_STORE(v[0]);
+#endif
+}
+
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
 MIOpenBatchNormFwdInferPerActivationEst(const __global _FLOAT* in,
                                         __global _FLOAT* __restrict out,
@@ -48,29 +82,33 @@ MIOpenBatchNormFwdInferPerActivationEst(const __global _FLOAT* in,
 {
 
     // PER ACTIVATION
-    _FLOAT_PREC mean, variance;
-    _FLOAT_PREC invVariance, elemStd, inhat;
-    _FLOAT_PREC pvt_scale, pvt_bias;
+    _FLOAT_PREC invVariance[MIO_BN_VEC];
+    _FLOAT_PREC mean[MIO_BN_VEC], pvt_scale[MIO_BN_VEC], pvt_bias[MIO_BN_VEC];
+    _FLOAT_PREC v[MIO_BN_VEC];
     unsigned int adjIndex, index;
     int ygid    = get_global_id(1);
     int yglb_sz = get_global_size(1);
     int grpid   = get_group_id(0);
 
-    for(int img_offset = ygid; img_offset < imageDims; img_offset += yglb_sz)
+    for(int img_offset = ygid * MIO_BN_VEC; img_offset < imageDims;
+        img_offset += yglb_sz * MIO_BN_VEC)
     {
-        adjIndex    = (grpid * imageDims) + img_offset;
-        mean        = estimatedMean[adjIndex];
-        variance    = estimatedVariance[adjIndex];
-        invVariance = rsqrt(fabs(variance + epsilon));
-        pvt_scale   = *(scale + adjIndex);
-        pvt_bias    = *(bias + adjIndex);
+        adjIndex = (grpid * imageDims) + img_offset;
+        for(int k = 0; k < MIO_BN_VEC; k++)
+        {
+            mean[k]        = estimatedMean[adjIndex + k];
+            invVariance[k] = rsqrt(fabs(estimatedVariance[adjIndex + k] + epsilon));
+            pvt_scale[k]   = *(scale + adjIndex + k);
+            pvt_bias[k]    = *(bias + adjIndex + k);
+        }
 
         for(int n = 0; n < batchSize; n++)
         {
-            index      = (batchStride * n) + adjIndex;
-            elemStd    = (_FLOAT_PREC)(*(in + index)) - mean;
-            inhat      = elemStd * invVariance;
-            out[index] = (_FLOAT)(mad(pvt_scale, inhat, pvt_bias));
+            index = (batchStride * n) + adjIndex;
+            infer_load(in + index, v);
+            for(int k = 0; k < MIO_BN_VEC; k++)
+                v[k] = mad(pvt_scale[k], (v[k] - mean[k]) * invVariance[k], pvt_bias[k]);
+            infer_store(out + index, v);
         }
     }
 }
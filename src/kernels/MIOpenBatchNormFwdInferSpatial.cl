@@ -34,6 +34,40 @@
 
 #include "batchnorm_functions.h"
 
+#ifndef MIO_BN_VEC
+#define MIO_BN_VEC 1
+#endif
+
+// Each work-item transforms MIO_BN_VEC consecutive elements of an image, the host only picks a
+// vector size that divides the image.
+static inline void infer_load(const global _FLOAT* p, _FLOAT_PREC* v)
+{
+#if MIO_BN_VEC == 4
+    const _FLOAT4 t = vload4(0, p);
+    v[0]            = BN_LOAD(t.x);
+    v[1]            = BN_LOAD(t.y);
+    v[2]            = BN_LOAD(t.z);
+    v[3]            = BN_LOAD(t.w);
+#elif MIO_BN_VEC == 2
+    const _FLOAT2 t = vload2(0, p);
+    v[0]            = BN_LOAD(t.x);
+    v[1]            = BN_LOAD(t.y);
+#else
+    v[0] = BN_LOAD(*p);
+#endif
+}
+
+static inline void infer_store(global _FLOAT* p, const _FLOAT_PREC* v)
+{
+#if MIO_BN_VEC == 4
+    vstore4((_FLOAT4)(BN_STORE(v[0]), BN_STORE(v[1]), BN_STORE(v[2]), BN_STORE(v[3])), 0, p);
+#elif MIO_BN_VEC == 2
+    vstore2((_FLOAT2)(BN_STORE(v[0]), BN_STORE(v[1])), 0, p);
+#else
+    *p = BN_STORE(v[0]);
+#endif
+}
+
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
 MIOpenBatchNormFwdInferSpatialEst(const __global _FLOAT* __restrict in, /* x input */
                                   __global _FLOAT* __restrict out,      /* y output */
@@ -53,8 +87,8 @@ MIOpenBatchNormFwdInferSpatialEst(const __global _FLOAT* __restrict in, /* x inp
     unsigned int index;
 
     _FLOAT_PREC mean, variance, invVariance;
-    _FLOAT_PREC inhat;
     _FLOAT_PREC pscale, pbias;
+    _FLOAT_PREC v[MIO_BN_VEC];
 
     mean        = *(estimatedMean + xgid);
     variance    = *(estimatedVariance + xgid);
@@ -62,13 +96,15 @@ MIOpenBatchNormFwdInferSpatialEst(const __global _FLOAT* __restrict in, /* x inp
     pbias       = *(bias + xgid);
     invVariance = rsqrt(fabs(variance + epsilon));
 
-    for(int idx = ygid; idx < imageDims; idx += get_global_size(1))
+    for(int idx = ygid * MIO_BN_VEC; idx < imageDims; idx += get_global_size(1) * MIO_BN_VEC)
     {
         for(int n = 0; n < batchSize; n++)
         {
-            index      = (n * batchStride) + (xgid * imageDims) + idx;
-            inhat      = ((_FLOAT_PREC)(*(in + index)) - mean) * invVariance;
-            out[index] = (_FLOAT)(mad(pscale, inhat, pbias));
+            index = (n * batchStride) + (xgid * imageDims) + idx;
+            infer_load(in + index, v);
+            for(int k = 0; k < MIO_BN_VEC; k++)
+                v[k] = mad(pscale, (v[k] - mean) * invVariance, pbias);
+            infer_store(out + index, v);
         }
     }
 } // end spatial norm
@@ -0,0 +1,347 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Single-pass spatial batch normalization of NCHW tensors. Every work-item keeps the Welford
+// state (count, mean, M2) of the elements it has seen, with M2 the sum of the squared deviations
+// from the mean, and the states are merged pairwise with the formula of Chan et al. Unlike the
+// sum and sum of squares of the other variants this does not lose the variance to cancellation
+// once the mean is large against the deviations.
+//
+// MIO_BN_NBLOCKS work-groups share a channel. With one of them the work-group normalizes the
+// channel in the same kernel. Otherwise each work-group writes its partial state to the
+// workspace and counts itself in with an atomic, and the last one to arrive merges the partial
+// states, commits the statistics and resets the counter for the next launch. The output is then
+// written by MIOpenBatchNormFwdTrainSpatialWelfordNorm.
+//
+// Layout of the workspace, in floats: MIO_BN_C * MIO_BN_NBLOCKS partial states of 3 values,
+// MIO_BN_C pairs of mean and inverse variance, MIO_BN_C counters.
+
+// Disable specific warnings
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconditional-uninitialized"
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsometimes-uninitialized"
+#endif
+
+#include "batchnorm_functions.h"
+
+#ifndef MIO_BN_EPT
+#define MIO_BN_EPT 1
+#endif
+
+#ifndef MIO_BN_NBLOCKS
+#define MIO_BN_NBLOCKS 1
+#endif
+
+#define MIO_BN_HWV (MIO_BN_HW / MIO_BN_EPT)
+#define MIO_BN_NHWV (MIO_BN_N * MIO_BN_HWV)
+#define MIO_BN_WELFORD_STRIDE (MIO_BN_GRP0 * MIO_BN_NBLOCKS)
+
+#define MIO_BN_WS_STATS (3 * MIO_BN_C * MIO_BN_NBLOCKS)
+#define MIO_BN_WS_COUNTERS (MIO_BN_WS_STATS + 2 * MIO_BN_C)
+
+static inline void welford_load(const global _FLOAT* p, _FLOAT_ACCUM* v)
+{
+#if MIO_BN_EPT == 4
+    const _FLOAT4 t = vload4(0, p);
+    v[0]            = BN_LOAD(t.x);
+    v[1]            = BN_LOAD(t.y);
+    v[2]            = BN_LOAD(t.z);
+    v[3]            = BN_LOAD(t.w);
+#elif MIO_BN_EPT == 2
+    const _FLOAT2 t = vload2(0, p);
+    v[0]            = BN_LOAD(t.x);
+    v[1]            = BN_LOAD(t.y);
+#else
+    v[0] = BN_LOAD(*p);
+#endif
+}
+
+static inline void welford_store(global _FLOAT* p, const _FLOAT_ACCUM* v)
+{
+#if MIO_BN_EPT == 4
+    vstore4((_FLOAT4)(BN_STORE(v[0]), BN_STORE(v[1]), BN_STORE(v[2]), BN_STORE(v[3])), 0, p);
+#elif MIO_BN_EPT == 2
+    vstore2((_FLOAT2)(BN_STORE(v[0]), BN_STORE(v[1])), 0, p);
+#else
+    *p = BN_STORE(v[0]);
+#endif
+}
+
+// Offset of the vector i of the channel, the vectors are numbered across the images.
+static inline uint welford_index(uint chan, uint i)
+{
+    const uint n   = i / MIO_BN_HWV;
+    const uint hwv = i - n * MIO_BN_HWV;
+    return n * MIO_BN_CHW + chan * MIO_BN_HW + hwv * MIO_BN_EPT;
+}
+
+static inline void welford_merge(_FLOAT_ACCUM* count,
+                                 _FLOAT_ACCUM* mean,
+                                 _FLOAT_ACCUM* m2,
+                                 _FLOAT_ACCUM count_b,
+                                 _FLOAT_ACCUM mean_b,
+                                 _FLOAT_ACCUM m2_b)
+{
+    const _FLOAT_ACCUM total = *count + count_b;
+    if(total == (_FLOAT_ACCUM)0.)
+        return;
+    const _FLOAT_ACCUM delta  = mean_b - *mean;
+    const _FLOAT_ACCUM weight = count_b / total;
+    *mean                     = mad(delta, weight, *mean);
+    *m2                       = mad(delta * delta, *count * weight, *m2 + m2_b);
+    *count                    = total;
+}
+
+static inline void welford_accum(const global _FLOAT* in,
+                                 uint chan,
+                                 uint first,
+                                 _FLOAT_ACCUM* count,
+                                 _FLOAT_ACCUM* mean,
+                                 _FLOAT_ACCUM* m2)
+{
+    _FLOAT_ACCUM v[MIO_BN_EPT];
+    for(uint i = first; i < MIO_BN_NHWV; i += MIO_BN_WELFORD_STRIDE)
+    {
+        welford_load(in + welford_index(chan, i), v);
+
+        _FLOAT_ACCUM vmean = (_FLOAT_ACCUM)0.;
+        for(uint k = 0; k < MIO_BN_EPT; k++)
+            vmean += v[k];
+        vmean *= (_FLOAT_ACCUM)(1.0 / MIO_BN_EPT);
+
+        _FLOAT_ACCUM vm2 = (_FLOAT_ACCUM)0.;
+        for(uint k = 0; k < MIO_BN_EPT; k++)
+            vm2 = mad(v[k] - vmean, v[k] - vmean, vm2);
+
+        welford_merge(count, mean, m2, (_FLOAT_ACCUM)MIO_BN_EPT, vmean, vm2);
+    }
+}
+
+// Merges the states of the work-group into the one of work-item 0 and hands it to all of them.
+static inline void welford_reduce(local _FLOAT_ACCUM* lcl_count,
+                                  local _FLOAT_ACCUM* lcl_mean,
+                                  local _FLOAT_ACCUM* lcl_m2,
+                                  uint lid,
+                                  _FLOAT_ACCUM* count,
+                                  _FLOAT_ACCUM* mean,
+                                  _FLOAT_ACCUM* m2)
+{
+    lcl_count[lid] = *count;
+    lcl_mean[lid]  = *mean;
+    lcl_m2[lid]    = *m2;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(uint red = MIO_BN_GRP0 >> 1; red > 0; red >>= 1)
+    {
+        if(lid < red)
+        {
+            welford_merge(
+                count, mean, m2, lcl_count[lid + red], lcl_mean[lid + red], lcl_m2[lid + red]);
+            lcl_count[lid] = *count;
+            lcl_mean[lid]  = *mean;
+            lcl_m2[lid]    = *m2;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    *count = lcl_count[0];
+    *mean  = lcl_mean[0];
+    *m2    = lcl_m2[0];
+    barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+static inline void welford_commit(global _FLOAT_PREC* resultRunningMean,
+                                  global _FLOAT_PREC* resultRunningVariance,
+                                  double expAvgFactor,
+                                  global _FLOAT_PREC* resultSaveMean,
+                                  global _FLOAT_PREC* resultSaveInvVariance,
+                                  _FLOAT_ACCUM mean,
+                                  _FLOAT_ACCUM variance,
+                                  _FLOAT_ACCUM invVariance,
+                                  uint chan)
+{
+#if(MIO_RUNNING_RESULT == 1)
+    running_stash(resultRunningMean, resultRunningVariance, expAvgFactor, mean, variance, chan);
+#endif
+#if(MIO_SAVE_MEAN_VARIANCE == 1)
+    saved_stash(resultSaveMean, resultSaveInvVariance, mean, invVariance, chan);
+#endif
+}
+
+static inline void welford_normalize(const global _FLOAT* in,
+                                     global _FLOAT* out,
+                                     _FLOAT_ACCUM pscale,
+                                     _FLOAT_ACCUM pbias,
+                                     uint chan,
+                                     uint first,
+                                     _FLOAT_ACCUM mean,
+                                     _FLOAT_ACCUM invVariance)
+{
+    _FLOAT_ACCUM v[MIO_BN_EPT];
+    for(uint i = first; i < MIO_BN_NHWV; i += MIO_BN_WELFORD_STRIDE)
+    {
+        const uint index = welford_index(chan, i);
+        welford_load(in + index, v);
+        for(uint k = 0; k < MIO_BN_EPT; k++)
+            v[k] = mad(pscale, (v[k] - mean) * invVariance, pbias);
+        welford_store(out + index, v);
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, 1, 1))) __kernel void
+MIOpenBatchNormFwdTrainSpatialWelford(const __global _FLOAT* __restrict in,
+                                      __global _FLOAT* __restrict out,
+                                      const __global _FLOAT_PREC* __restrict scale,
+                                      const __global _FLOAT_PREC* __restrict bias,
+                                      double expAvgFactor,
+                                      __global _FLOAT_PREC* __restrict resultRunningMean,
+                                      __global _FLOAT_PREC* __restrict resultRunningVariance,
+                                      double epsilon,
+                                      __global _FLOAT_PREC* __restrict resultSaveMean,
+                                      __global _FLOAT_PREC* __restrict resultSaveInvVariance,
+                                      __global _FLOAT_ACCUM* workspace)
+{
+    local _FLOAT_ACCUM lcl_count[MIO_BN_GRP0];
+    local _FLOAT_ACCUM lcl_mean[MIO_BN_GRP0];
+    local _FLOAT_ACCUM lcl_m2[MIO_BN_GRP0];
+
+    const uint lid  = get_local_id(0);
+    const uint blk  = get_group_id(0);
+    const uint chan = get_group_id(1);
+
+    _FLOAT_ACCUM count = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM mean  = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM m2    = (_FLOAT_ACCUM)0.;
+
+    welford_accum(in, chan, blk * MIO_BN_GRP0 + lid, &count, &mean, &m2);
+    welford_reduce(lcl_count, lcl_mean, lcl_m2, lid, &count, &mean, &m2);
+
+#if MIO_BN_NBLOCKS == 1
+    (void)workspace;
+
+    const _FLOAT_ACCUM variance    = m2 / (_FLOAT_ACCUM)MIO_BN_NHW;
+    const _FLOAT_ACCUM invVariance = rsqrt(variance + (_FLOAT_ACCUM)epsilon);
+
+    if(lid == 0)
+        welford_commit(resultRunningMean,
+                       resultRunningVariance,
+                       expAvgFactor,
+                       resultSaveMean,
+                       resultSaveInvVariance,
+                       mean,
+                       variance,
+                       invVariance,
+                       chan);
+
+    welford_normalize(in,
+                      out,
+                      (_FLOAT_ACCUM)scale[chan],
+                      (_FLOAT_ACCUM)bias[chan],
+                      chan,
+                      lid,
+                      mean,
+                      invVariance);
+#else
+    (void)out;
+    (void)scale;
+    (void)bias;
+
+    local uint lcl_last;
+    volatile global _FLOAT_ACCUM* partials = workspace;
+    volatile global uint* counters = (volatile global uint*)(workspace + MIO_BN_WS_COUNTERS);
+
+    if(lid == 0)
+    {
+        const uint slot         = 3 * (chan * MIO_BN_NBLOCKS + blk);
+        partials[slot]          = count;
+        partials[slot + 1]      = mean;
+        partials[slot + 2]      = m2;
+        mem_fence(CLK_GLOBAL_MEM_FENCE);
+        lcl_last = atomic_inc(counters + chan) == MIO_BN_NBLOCKS - 1;
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    if(!lcl_last)
+        return;
+
+    count = (_FLOAT_ACCUM)0.;
+    mean  = (_FLOAT_ACCUM)0.;
+    m2    = (_FLOAT_ACCUM)0.;
+    for(uint b = lid; b < MIO_BN_NBLOCKS; b += MIO_BN_GRP0)
+    {
+        const uint slot = 3 * (chan * MIO_BN_NBLOCKS + b);
+        welford_merge(&count, &mean, &m2, partials[slot], partials[slot + 1], partials[slot + 2]);
+    }
+    welford_reduce(lcl_count, lcl_mean, lcl_m2, lid, &count, &mean, &m2);
+
+    if(lid == 0)
+    {
+        const _FLOAT_ACCUM variance    = m2 / (_FLOAT_ACCUM)MIO_BN_NHW;
+        const _FLOAT_ACCUM invVariance = rsqrt(variance + (_FLOAT_ACCUM)epsilon);
+
+        workspace[MIO_BN_WS_STATS + 2 * chan]     = mean;
+        workspace[MIO_BN_WS_STATS + 2 * chan + 1] = invVariance;
+
+        welford_commit(resultRunningMean,
+                       resultRunningVariance,
+                       expAvgFactor,
+                       resultSaveMean,
+                       resultSaveInvVariance,
+                       mean,
+                       variance,
+                       invVariance,
+                       chan);
+
+        atomic_xchg(counters + chan, 0);
+    }
+#endif
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, 1, 1))) __kernel void
+MIOpenBatchNormFwdTrainSpatialWelfordNorm(const __global _FLOAT* __restrict in,
+                                          __global _FLOAT* __restrict out,
+                                          const __global _FLOAT_PREC* __restrict scale,
+                                          const __global _FLOAT_PREC* __restrict bias,
+                                          const __global _FLOAT_ACCUM* __restrict workspace)
+{
+    const uint chan = get_group_id(1);
+
+    welford_normalize(in,
+                      out,
+                      (_FLOAT_ACCUM)scale[chan],
+                      (_FLOAT_ACCUM)bias[chan],
+                      chan,
+                      get_group_id(0) * MIO_BN_GRP0 + get_local_id(0),
+                      workspace[MIO_BN_WS_STATS + 2 * chan],
+                      workspace[MIO_BN_WS_STATS + 2 * chan + 1]);
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,829 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Spatial batch normalization of channel-last (NHWC and, reshaped, NDHWC) tensors. The tensor
+// is viewed as MIO_BN_NHW rows of MIO_BN_C contiguous channels. Work-items along dimension 0
+// own MIO_BN_VEC consecutive channels each and load them with one vector access, work-items
+// along dimension 1 stride the rows, so a work-group reads whole stretches of a row at once.
+//
+// With MIO_BN_NSEG == 1 a single work-group reduces all the rows of its channels. Otherwise
+// the rows are split into MIO_BN_NSEG segments of MIO_BN_SEGROWS rows (the last one takes the
+// remainder) and the reduction runs as a chain of kernels over a grid of (channels, segments).
+// The partial results go to a float stash at the start of each segment of the output tensor,
+// which is overwritten by the last kernel of the chain only.
+
+// Disable specific warnings
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconditional-uninitialized"
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsometimes-uninitialized"
+#endif
+
+#include "batchnorm_functions.h"
+
+#ifndef MIO_BN_VEC
+#define MIO_BN_VEC 1
+#endif
+
+#ifndef MIO_BN_NSEG
+#define MIO_BN_NSEG 1
+#endif
+
+#ifndef MIO_BN_SEGROWS
+#define MIO_BN_SEGROWS MIO_BN_NHW
+#endif
+
+#ifndef MIO_BN_USESAVED
+#define MIO_BN_USESAVED 0
+#endif
+
+#define MIO_BN_NHWC_LCL_SIZE (MIO_BN_GRP0 * MIO_BN_GRP1 * MIO_BN_VEC)
+
+// Slots of the per segment stash, MIO_BN_C floats each.
+#define MIO_BN_STASH_SUM 0
+#define MIO_BN_STASH_SQSUM 1
+#define MIO_BN_STASH_MEAN 2
+#define MIO_BN_STASH_INVVAR 3
+#define MIO_BN_STASH_DBIAS_PART 4
+#define MIO_BN_STASH_DSCALE_PART 5
+#define MIO_BN_STASH_DBIAS 6
+#define MIO_BN_STASH_DSCALE 7
+
+static inline void nhwc_load(const global _FLOAT* p, _FLOAT_ACCUM* v)
+{
+#if MIO_BN_VEC == 4
+    const _FLOAT4 t = vload4(0, p);
+    v[0]            = BN_LOAD(t.x);
+    v[1]            = BN_LOAD(t.y);
+    v[2]            = BN_LOAD(t.z);
+    v[3]            = BN_LOAD(t.w);
+#elif MIO_BN_VEC == 2
+    const _FLOAT2 t = vload2(0, p);
+    v[0]            = BN_LOAD(t.x);
+    v[1]            = BN_LOAD(t.y);
+#else
+    v[0] = BN_LOAD(*p);
+#endif
+}
+
+static inline void nhwc_store(global _FLOAT* p, const _FLOAT_ACCUM* v)
+{
+#if MIO_BN_VEC == 4
+    vstore4((_FLOAT4)(BN_STORE(v[0]), BN_STORE(v[1]), BN_STORE(v[2]), BN_STORE(v[3])), 0, p);
+#elif MIO_BN_VEC == 2
+    vstore2((_FLOAT2)(BN_STORE(v[0]), BN_STORE(v[1])), 0, p);
+#else
+    *p = BN_STORE(v[0]);
+#endif
+}
+
+static inline void nhwc_load_param(const global _FLOAT_PREC* p, _FLOAT_ACCUM* v)
+{
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+        v[k] = (_FLOAT_ACCUM)p[k];
+}
+
+static inline global _FLOAT_ACCUM* nhwc_stash(global _FLOAT* out, uint seg)
+{
+    return (global _FLOAT_ACCUM*)(out + seg * MIO_BN_SEGROWS * MIO_BN_C);
+}
+
+static inline uint nhwc_row_begin(uint seg) { return seg * MIO_BN_SEGROWS; }
+
+static inline uint nhwc_row_end(uint seg)
+{
+    return (seg + 1 == MIO_BN_NSEG) ? MIO_BN_NHW : (seg + 1) * MIO_BN_SEGROWS;
+}
+
+// Sums both arrays over dimension 1 of the work-group and hands the totals to every work-item.
+static inline void nhwc_reduce2(_FLOAT_ACCUM* a,
+                                _FLOAT_ACCUM* b,
+                                local _FLOAT_ACCUM* lcl_a,
+                                local _FLOAT_ACCUM* lcl_b,
+                                uint lidx,
+                                uint lidy)
+{
+    const uint base = (lidy * MIO_BN_GRP0 + lidx) * MIO_BN_VEC;
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        lcl_a[base + k] = a[k];
+        lcl_b[base + k] = b[k];
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(uint s = MIO_BN_GRP1 >> 1; s > 0; s >>= 1)
+    {
+        if(lidy < s)
+        {
+            const uint other = base + s * MIO_BN_GRP0 * MIO_BN_VEC;
+            for(uint k = 0; k < MIO_BN_VEC; k++)
+            {
+                lcl_a[base + k] += lcl_a[other + k];
+                lcl_b[base + k] += lcl_b[other + k];
+            }
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    const uint root = lidx * MIO_BN_VEC;
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        a[k] = lcl_a[root + k];
+        b[k] = lcl_b[root + k];
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+static inline void nhwc_accum_stats(const global _FLOAT* in,
+                                    uint chan,
+                                    uint begin,
+                                    uint end,
+                                    uint lidy,
+                                    _FLOAT_ACCUM* sum,
+                                    _FLOAT_ACCUM* sqsum)
+{
+    _FLOAT_ACCUM value[MIO_BN_VEC];
+    for(uint row = begin + lidy; row < end; row += MIO_BN_GRP1)
+    {
+        nhwc_load(in + row * MIO_BN_C + chan, value);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            sum[k] += value[k];
+            sqsum[k] = mad(value[k], value[k], sqsum[k]);
+        }
+    }
+}
+
+// Turns the sums into the mean and the variance in place.
+static inline void nhwc_mean_invvar(_FLOAT_ACCUM* mean,
+                                    _FLOAT_ACCUM* variance,
+                                    _FLOAT_ACCUM* invVariance,
+                                    double epsilon)
+{
+    const _FLOAT_ACCUM inhw = (_FLOAT_ACCUM)1.0 / (_FLOAT_ACCUM)MIO_BN_NHW;
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        mean[k]        = mean[k] * inhw;
+        variance[k]    = mad(-mean[k], mean[k], variance[k] * inhw);
+        variance[k]    = (variance[k] < 0) ? (_FLOAT_ACCUM)0. : variance[k];
+        invVariance[k] = rsqrt(variance[k] + (_FLOAT_ACCUM)epsilon);
+    }
+}
+
+static inline void nhwc_commit_stats(global _FLOAT_PREC* resultRunningMean,
+                                     global _FLOAT_PREC* resultRunningVariance,
+                                     double expAvgFactor,
+                                     global _FLOAT_PREC* resultSaveMean,
+                                     global _FLOAT_PREC* resultSaveInvVariance,
+                                     const _FLOAT_ACCUM* mean,
+                                     const _FLOAT_ACCUM* variance,
+                                     const _FLOAT_ACCUM* invVariance,
+                                     uint chan)
+{
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+#if(MIO_RUNNING_RESULT == 1)
+        running_stash(resultRunningMean,
+                      resultRunningVariance,
+                      expAvgFactor,
+                      mean[k],
+                      variance[k],
+                      chan + k);
+#endif
+#if(MIO_SAVE_MEAN_VARIANCE == 1)
+        saved_stash(resultSaveMean, resultSaveInvVariance, mean[k], invVariance[k], chan + k);
+#endif
+    }
+}
+
+static inline void nhwc_normalize(const global _FLOAT* in,
+                                  global _FLOAT* out,
+                                  const global _FLOAT_PREC* scale,
+                                  const global _FLOAT_PREC* bias,
+                                  uint chan,
+                                  uint begin,
+                                  uint end,
+                                  uint lidy,
+                                  const _FLOAT_ACCUM* mean,
+                                  const _FLOAT_ACCUM* invVariance)
+{
+    _FLOAT_ACCUM pscale[MIO_BN_VEC], pbias[MIO_BN_VEC], value[MIO_BN_VEC];
+    nhwc_load_param(scale + chan, pscale);
+    nhwc_load_param(bias + chan, pbias);
+
+    for(uint row = begin + lidy; row < end; row += MIO_BN_GRP1)
+    {
+        const uint index = row * MIO_BN_C + chan;
+        nhwc_load(in + index, value);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+            value[k] = mad(pscale[k], (value[k] - mean[k]) * invVariance[k], pbias[k]);
+        nhwc_store(out + index, value);
+    }
+}
+
+// Writes the sums of the rows of segment get_group_id(1) to its stash.
+static inline void nhwc_segment_stats(const global _FLOAT* in,
+                                      global _FLOAT* out,
+                                      local _FLOAT_ACCUM* lcl_a,
+                                      local _FLOAT_ACCUM* lcl_b)
+{
+    const uint lidx   = get_local_id(0);
+    const uint lidy   = get_local_id(1);
+    const uint seg    = get_group_id(1);
+    const uint chan   = get_global_id(0) * MIO_BN_VEC;
+    const bool active = chan < MIO_BN_C;
+
+    _FLOAT_ACCUM sum[MIO_BN_VEC], sqsum[MIO_BN_VEC];
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        sum[k]   = (_FLOAT_ACCUM)0.;
+        sqsum[k] = (_FLOAT_ACCUM)0.;
+    }
+
+    if(active)
+        nhwc_accum_stats(in, chan, nhwc_row_begin(seg), nhwc_row_end(seg), lidy, sum, sqsum);
+    nhwc_reduce2(sum, sqsum, lcl_a, lcl_b, lidx, lidy);
+
+    if(active && lidy == 0)
+    {
+        global _FLOAT_ACCUM* stash = nhwc_stash(out, seg);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            stash[MIO_BN_STASH_SUM * MIO_BN_C + chan + k]   = sum[k];
+            stash[MIO_BN_STASH_SQSUM * MIO_BN_C + chan + k] = sqsum[k];
+        }
+    }
+}
+
+// Adds up the segment sums and stashes the mean and the inverse variance in the segment of the
+// work-group. Returns true for the work-items that should commit the statistics.
+static inline bool nhwc_final_stats(global _FLOAT* out,
+                                    double epsilon,
+                                    _FLOAT_ACCUM* mean,
+                                    _FLOAT_ACCUM* variance,
+                                    _FLOAT_ACCUM* invVariance,
+                                    local _FLOAT_ACCUM* lcl_a,
+                                    local _FLOAT_ACCUM* lcl_b)
+{
+    const uint lidx   = get_local_id(0);
+    const uint lidy   = get_local_id(1);
+    const uint seg    = get_group_id(1);
+    const uint chan   = get_global_id(0) * MIO_BN_VEC;
+    const bool active = chan < MIO_BN_C;
+
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        mean[k]     = (_FLOAT_ACCUM)0.;
+        variance[k] = (_FLOAT_ACCUM)0.;
+    }
+
+    if(active)
+    {
+        for(uint s = lidy; s < MIO_BN_NSEG; s += MIO_BN_GRP1)
+        {
+            const global _FLOAT_ACCUM* stash = nhwc_stash(out, s);
+            for(uint k = 0; k < MIO_BN_VEC; k++)
+            {
+                mean[k] += stash[MIO_BN_STASH_SUM * MIO_BN_C + chan + k];
+                variance[k] += stash[MIO_BN_STASH_SQSUM * MIO_BN_C + chan + k];
+            }
+        }
+    }
+    nhwc_reduce2(mean, variance, lcl_a, lcl_b, lidx, lidy);
+    nhwc_mean_invvar(mean, variance, invVariance, epsilon);
+
+    if(active && lidy == 0)
+    {
+        global _FLOAT_ACCUM* stash = nhwc_stash(out, seg);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            stash[MIO_BN_STASH_MEAN * MIO_BN_C + chan + k]   = mean[k];
+            stash[MIO_BN_STASH_INVVAR * MIO_BN_C + chan + k] = invVariance[k];
+        }
+    }
+
+    return active && lidy == 0 && seg == 0;
+}
+
+// Reads the stashed mean and inverse variance of the segment of the work-group. The barrier
+// keeps the work-group from overwriting the stash before all of it has been read.
+static inline void nhwc_load_stashed_stats(global _FLOAT* out,
+                                           uint chan,
+                                           bool active,
+                                           _FLOAT_ACCUM* mean,
+                                           _FLOAT_ACCUM* invVariance)
+{
+    if(active)
+    {
+        const global _FLOAT_ACCUM* stash = nhwc_stash(out, get_group_id(1));
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            mean[k]        = stash[MIO_BN_STASH_MEAN * MIO_BN_C + chan + k];
+            invVariance[k] = stash[MIO_BN_STASH_INVVAR * MIO_BN_C + chan + k];
+        }
+    }
+}
+
+//============================ FORWARD TRAINING ============================
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormFwdTrainSpatialNHWC(const __global _FLOAT* __restrict in,
+                                   __global _FLOAT* __restrict out,
+                                   const __global _FLOAT_PREC* __restrict scale,
+                                   const __global _FLOAT_PREC* __restrict bias,
+                                   double expAvgFactor,
+                                   __global _FLOAT_PREC* __restrict resultRunningMean,
+                                   __global _FLOAT_PREC* __restrict resultRunningVariance,
+                                   double epsilon,
+                                   __global _FLOAT_PREC* __restrict resultSaveMean,
+                                   __global _FLOAT_PREC* __restrict resultSaveInvVariance)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_BN_NHWC_LCL_SIZE];
+    local _FLOAT_ACCUM lcl_b[MIO_BN_NHWC_LCL_SIZE];
+
+    const uint lidx   = get_local_id(0);
+    const uint lidy   = get_local_id(1);
+    const uint chan   = get_global_id(0) * MIO_BN_VEC;
+    const bool active = chan < MIO_BN_C;
+
+    _FLOAT_ACCUM mean[MIO_BN_VEC], variance[MIO_BN_VEC], invVariance[MIO_BN_VEC];
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        mean[k]     = (_FLOAT_ACCUM)0.;
+        variance[k] = (_FLOAT_ACCUM)0.;
+    }
+
+    if(active)
+        nhwc_accum_stats(in, chan, 0, MIO_BN_NHW, lidy, mean, variance);
+    nhwc_reduce2(mean, variance, lcl_a, lcl_b, lidx, lidy);
+    nhwc_mean_invvar(mean, variance, invVariance, epsilon);
+
+    if(!active)
+        return;
+
+    if(lidy == 0)
+        nhwc_commit_stats(resultRunningMean,
+                          resultRunningVariance,
+                          expAvgFactor,
+                          resultSaveMean,
+                          resultSaveInvVariance,
+                          mean,
+                          variance,
+                          invVariance,
+                          chan);
+
+    nhwc_normalize(in, out, scale, bias, chan, 0, MIO_BN_NHW, lidy, mean, invVariance);
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormFwdTrainSpatialNHWCMeanVariance(const __global _FLOAT* __restrict in,
+                                               __global _FLOAT* __restrict out)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_BN_NHWC_LCL_SIZE];
+    local _FLOAT_ACCUM lcl_b[MIO_BN_NHWC_LCL_SIZE];
+
+    nhwc_segment_stats(in, out, lcl_a, lcl_b);
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormFwdTrainSpatialNHWCFinalMeanVariance(
+    __global _FLOAT* __restrict out,
+    double expAvgFactor,
+    __global _FLOAT_PREC* __restrict resultRunningMean,
+    __global _FLOAT_PREC* __restrict resultRunningVariance,
+    double epsilon,
+    __global _FLOAT_PREC* __restrict resultSaveMean,
+    __global _FLOAT_PREC* __restrict resultSaveInvVariance)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_BN_NHWC_LCL_SIZE];
+    local _FLOAT_ACCUM lcl_b[MIO_BN_NHWC_LCL_SIZE];
+
+    _FLOAT_ACCUM mean[MIO_BN_VEC], variance[MIO_BN_VEC], invVariance[MIO_BN_VEC];
+
+    if(nhwc_final_stats(out, epsilon, mean, variance, invVariance, lcl_a, lcl_b))
+        nhwc_commit_stats(resultRunningMean,
+                          resultRunningVariance,
+                          expAvgFactor,
+                          resultSaveMean,
+                          resultSaveInvVariance,
+                          mean,
+                          variance,
+                          invVariance,
+                          get_global_id(0) * MIO_BN_VEC);
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormFwdTrainSpatialNHWCNorm(const __global _FLOAT* __restrict in,
+                                       __global _FLOAT* __restrict out,
+                                       const __global _FLOAT_PREC* __restrict scale,
+                                       const __global _FLOAT_PREC* __restrict bias)
+{
+    const uint seg    = get_group_id(1);
+    const uint chan   = get_global_id(0) * MIO_BN_VEC;
+    const bool active = chan < MIO_BN_C;
+
+    _FLOAT_ACCUM mean[MIO_BN_VEC], invVariance[MIO_BN_VEC];
+    nhwc_load_stashed_stats(out, chan, active, mean, invVariance);
+    barrier(CLK_GLOBAL_MEM_FENCE);
+
+    if(active)
+        nhwc_normalize(in,
+                       out,
+                       scale,
+                       bias,
+                       chan,
+                       nhwc_row_begin(seg),
+                       nhwc_row_end(seg),
+                       get_local_id(1),
+                       mean,
+                       invVariance);
+}
+
+//=========================== FORWARD INFERENCE ============================
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormFwdInferSpatialNHWC(const __global _FLOAT* __restrict in,
+                                   __global _FLOAT* __restrict out,
+                                   const __global _FLOAT_PREC* __restrict estimatedMean,
+                                   const __global _FLOAT_PREC* __restrict estimatedVariance,
+                                   const __global _FLOAT_PREC* __restrict scale,
+                                   const __global _FLOAT_PREC* __restrict bias,
+                                   double epsilon)
+{
+    const uint chan = get_global_id(0) * MIO_BN_VEC;
+    if(chan >= MIO_BN_C)
+        return;
+
+    _FLOAT_ACCUM mean[MIO_BN_VEC], invVariance[MIO_BN_VEC];
+    nhwc_load_param(estimatedMean + chan, mean);
+    nhwc_load_param(estimatedVariance + chan, invVariance);
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+        invVariance[k] = rsqrt(fabs(invVariance[k] + (_FLOAT_ACCUM)epsilon));
+
+    _FLOAT_ACCUM pscale[MIO_BN_VEC], pbias[MIO_BN_VEC], value[MIO_BN_VEC];
+    nhwc_load_param(scale + chan, pscale);
+    nhwc_load_param(bias + chan, pbias);
+
+    for(uint row = get_global_id(1); row < MIO_BN_NHW; row += get_global_size(1))
+    {
+        const uint index = row * MIO_BN_C + chan;
+        nhwc_load(in + index, value);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+            value[k] = mad(pscale[k], (value[k] - mean[k]) * invVariance[k], pbias[k]);
+        nhwc_store(out + index, value);
+    }
+}
+
+//================================ BACKWARD ================================
+
+static inline void nhwc_accum_diffs(const global _FLOAT* x_in,
+                                    const global _FLOAT* dy_in,
+                                    uint chan,
+                                    uint begin,
+                                    uint end,
+                                    uint lidy,
+                                    const _FLOAT_ACCUM* mean,
+                                    const _FLOAT_ACCUM* invVariance,
+                                    _FLOAT_ACCUM* dbias,
+                                    _FLOAT_ACCUM* dscale)
+{
+    _FLOAT_ACCUM xin[MIO_BN_VEC], dyin[MIO_BN_VEC];
+    for(uint row = begin + lidy; row < end; row += MIO_BN_GRP1)
+    {
+        const uint index = row * MIO_BN_C + chan;
+        nhwc_load(x_in + index, xin);
+        nhwc_load(dy_in + index, dyin);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            dbias[k] += dyin[k];
+            dscale[k] = mad((xin[k] - mean[k]) * invVariance[k], dyin[k], dscale[k]);
+        }
+    }
+}
+
+static inline void nhwc_dx(const global _FLOAT* x_in,
+                           const global _FLOAT* dy_in,
+                           global _FLOAT* dx_out,
+                           const global _FLOAT_PREC* bnScale,
+                           uint chan,
+                           uint begin,
+                           uint end,
+                           uint lidy,
+                           const _FLOAT_ACCUM* mean,
+                           const _FLOAT_ACCUM* invVariance,
+                           const _FLOAT_ACCUM* dbias,
+                           const _FLOAT_ACCUM* dscale)
+{
+    const _FLOAT_ACCUM nhw  = (_FLOAT_ACCUM)MIO_BN_NHW;
+    const _FLOAT_ACCUM inhw = (_FLOAT_ACCUM)1.0 / nhw;
+
+    _FLOAT_ACCUM pscale[MIO_BN_VEC], xin[MIO_BN_VEC], dyin[MIO_BN_VEC];
+    nhwc_load_param(bnScale + chan, pscale);
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+        pscale[k] *= invVariance[k] * inhw;
+
+    for(uint row = begin + lidy; row < end; row += MIO_BN_GRP1)
+    {
+        const uint index = row * MIO_BN_C + chan;
+        nhwc_load(x_in + index, xin);
+        nhwc_load(dy_in + index, dyin);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            const _FLOAT_ACCUM xhat = (xin[k] - mean[k]) * invVariance[k];
+            dyin[k] = pscale[k] * (mad(nhw, dyin[k], -dbias[k]) - xhat * dscale[k]);
+        }
+        nhwc_store(dx_out + index, dyin);
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormBwdSpatialNHWC(const __global _FLOAT* __restrict x_in,
+                              const __global _FLOAT* __restrict dy_in,
+                              __global _FLOAT* __restrict dx_out,
+                              const __global _FLOAT_PREC* __restrict bnScale,
+                              __global _FLOAT_PREC* __restrict delta_scale,
+                              __global _FLOAT_PREC* __restrict delta_bias,
+                              double epsilon,
+                              const __global _FLOAT_PREC* __restrict savedMean,
+                              const __global _FLOAT_PREC* __restrict savedInvVariance)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_BN_NHWC_LCL_SIZE];
+    local _FLOAT_ACCUM lcl_b[MIO_BN_NHWC_LCL_SIZE];
+
+    const uint lidx   = get_local_id(0);
+    const uint lidy   = get_local_id(1);
+    const uint chan   = get_global_id(0) * MIO_BN_VEC;
+    const bool active = chan < MIO_BN_C;
+
+    _FLOAT_ACCUM mean[MIO_BN_VEC], invVariance[MIO_BN_VEC];
+    _FLOAT_ACCUM dbias[MIO_BN_VEC], dscale[MIO_BN_VEC];
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        mean[k]        = (_FLOAT_ACCUM)0.;
+        invVariance[k] = (_FLOAT_ACCUM)0.;
+        dbias[k]       = (_FLOAT_ACCUM)0.;
+        dscale[k]      = (_FLOAT_ACCUM)0.;
+    }
+
+#if(MIO_BN_USESAVED == 1)
+    (void)epsilon;
+    if(active)
+    {
+        nhwc_load_param(savedMean + chan, mean);
+        nhwc_load_param(savedInvVariance + chan, invVariance);
+    }
+#else
+    (void)savedMean;
+    (void)savedInvVariance;
+    _FLOAT_ACCUM variance[MIO_BN_VEC];
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+        variance[k] = (_FLOAT_ACCUM)0.;
+    if(active)
+        nhwc_accum_stats(x_in, chan, 0, MIO_BN_NHW, lidy, mean, variance);
+    nhwc_reduce2(mean, variance, lcl_a, lcl_b, lidx, lidy);
+    nhwc_mean_invvar(mean, variance, invVariance, epsilon);
+#endif
+
+    if(active)
+        nhwc_accum_diffs(
+            x_in, dy_in, chan, 0, MIO_BN_NHW, lidy, mean, invVariance, dbias, dscale);
+    nhwc_reduce2(dbias, dscale, lcl_a, lcl_b, lidx, lidy);
+
+    if(!active)
+        return;
+
+    if(lidy == 0)
+    {
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            delta_bias[chan + k]  = (_FLOAT_PREC)dbias[k];
+            delta_scale[chan + k] = (_FLOAT_PREC)dscale[k];
+        }
+    }
+
+    nhwc_dx(x_in,
+            dy_in,
+            dx_out,
+            bnScale,
+            chan,
+            0,
+            MIO_BN_NHW,
+            lidy,
+            mean,
+            invVariance,
+            dbias,
+            dscale);
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormBwdSpatialNHWCMeanVariance(const __global _FLOAT* __restrict x_in,
+                                          __global _FLOAT* __restrict dx_out)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_BN_NHWC_LCL_SIZE];
+    local _FLOAT_ACCUM lcl_b[MIO_BN_NHWC_LCL_SIZE];
+
+    nhwc_segment_stats(x_in, dx_out, lcl_a, lcl_b);
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormBwdSpatialNHWCFinalMeanVariance(__global _FLOAT* __restrict dx_out,
+                                               double epsilon)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_BN_NHWC_LCL_SIZE];
+    local _FLOAT_ACCUM lcl_b[MIO_BN_NHWC_LCL_SIZE];
+
+    _FLOAT_ACCUM mean[MIO_BN_VEC], variance[MIO_BN_VEC], invVariance[MIO_BN_VEC];
+    (void)nhwc_final_stats(dx_out, epsilon, mean, variance, invVariance, lcl_a, lcl_b);
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormBwdSpatialNHWCDScaleDBias(const __global _FLOAT* __restrict x_in,
+                                         const __global _FLOAT* __restrict dy_in,
+                                         __global _FLOAT* __restrict dx_out,
+                                         const __global _FLOAT_PREC* __restrict savedMean,
+                                         const __global _FLOAT_PREC* __restrict savedInvVariance)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_BN_NHWC_LCL_SIZE];
+    local _FLOAT_ACCUM lcl_b[MIO_BN_NHWC_LCL_SIZE];
+
+    const uint lidx   = get_local_id(0);
+    const uint lidy   = get_local_id(1);
+    const uint seg    = get_group_id(1);
+    const uint chan   = get_global_id(0) * MIO_BN_VEC;
+    const bool active = chan < MIO_BN_C;
+
+    _FLOAT_ACCUM mean[MIO_BN_VEC], invVariance[MIO_BN_VEC];
+    _FLOAT_ACCUM dbias[MIO_BN_VEC], dscale[MIO_BN_VEC];
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        dbias[k]  = (_FLOAT_ACCUM)0.;
+        dscale[k] = (_FLOAT_ACCUM)0.;
+    }
+
+#if(MIO_BN_USESAVED == 1)
+    if(active)
+    {
+        nhwc_load_param(savedMean + chan, mean);
+        nhwc_load_param(savedInvVariance + chan, invVariance);
+    }
+#else
+    (void)savedMean;
+    (void)savedInvVariance;
+    nhwc_load_stashed_stats(dx_out, chan, active, mean, invVariance);
+#endif
+
+    if(active)
+        nhwc_accum_diffs(x_in,
+                         dy_in,
+                         chan,
+                         nhwc_row_begin(seg),
+                         nhwc_row_end(seg),
+                         lidy,
+                         mean,
+                         invVariance,
+                         dbias,
+                         dscale);
+    nhwc_reduce2(dbias, dscale, lcl_a, lcl_b, lidx, lidy);
+
+    if(active && lidy == 0)
+    {
+        global _FLOAT_ACCUM* stash = nhwc_stash(dx_out, seg);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            stash[MIO_BN_STASH_DBIAS_PART * MIO_BN_C + chan + k]  = dbias[k];
+            stash[MIO_BN_STASH_DSCALE_PART * MIO_BN_C + chan + k] = dscale[k];
+        }
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormBwdSpatialNHWCFinalDScaleDBias(__global _FLOAT* __restrict dx_out,
+                                              __global _FLOAT_PREC* __restrict delta_scale,
+                                              __global _FLOAT_PREC* __restrict delta_bias)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_BN_NHWC_LCL_SIZE];
+    local _FLOAT_ACCUM lcl_b[MIO_BN_NHWC_LCL_SIZE];
+
+    const uint lidx   = get_local_id(0);
+    const uint lidy   = get_local_id(1);
+    const uint seg    = get_group_id(1);
+    const uint chan   = get_global_id(0) * MIO_BN_VEC;
+    const bool active = chan < MIO_BN_C;
+
+    _FLOAT_ACCUM dbias[MIO_BN_VEC], dscale[MIO_BN_VEC];
+    for(uint k = 0; k < MIO_BN_VEC; k++)
+    {
+        dbias[k]  = (_FLOAT_ACCUM)0.;
+        dscale[k] = (_FLOAT_ACCUM)0.;
+    }
+
+    if(active)
+    {
+        for(uint s = lidy; s < MIO_BN_NSEG; s += MIO_BN_GRP1)
+        {
+            const global _FLOAT_ACCUM* stash = nhwc_stash(dx_out, s);
+            for(uint k = 0; k < MIO_BN_VEC; k++)
+            {
+                dbias[k] += stash[MIO_BN_STASH_DBIAS_PART * MIO_BN_C + chan + k];
+                dscale[k] += stash[MIO_BN_STASH_DSCALE_PART * MIO_BN_C + chan + k];
+            }
+        }
+    }
+    nhwc_reduce2(dbias, dscale, lcl_a, lcl_b, lidx, lidy);
+
+    if(active && lidy == 0)
+    {
+        global _FLOAT_ACCUM* stash = nhwc_stash(dx_out, seg);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            stash[MIO_BN_STASH_DBIAS * MIO_BN_C + chan + k]  = dbias[k];
+            stash[MIO_BN_STASH_DSCALE * MIO_BN_C + chan + k] = dscale[k];
+            if(seg == 0)
+            {
+                delta_bias[chan + k]  = (_FLOAT_PREC)dbias[k];
+                delta_scale[chan + k] = (_FLOAT_PREC)dscale[k];
+            }
+        }
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
+MIOpenBatchNormBwdSpatialNHWCDX(const __global _FLOAT* __restrict x_in,
+                                const __global _FLOAT* __restrict dy_in,
+                                __global _FLOAT* __restrict dx_out,
+                                const __global _FLOAT_PREC* __restrict bnScale,
+                                const __global _FLOAT_PREC* __restrict savedMean,
+                                const __global _FLOAT_PREC* __restrict savedInvVariance)
+{
+    const uint seg    = get_group_id(1);
+    const uint chan   = get_global_id(0) * MIO_BN_VEC;
+    const bool active = chan < MIO_BN_C;
+
+    _FLOAT_ACCUM mean[MIO_BN_VEC], invVariance[MIO_BN_VEC];
+    _FLOAT_ACCUM dbias[MIO_BN_VEC], dscale[MIO_BN_VEC];
+
+#if(MIO_BN_USESAVED == 1)
+    if(active)
+    {
+        nhwc_load_param(savedMean + chan, mean);
+        nhwc_load_param(savedInvVariance + chan, invVariance);
+    }
+#else
+    (void)savedMean;
+    (void)savedInvVariance;
+    nhwc_load_stashed_stats(dx_out, chan, active, mean, invVariance);
+#endif
+    if(active)
+    {
+        const global _FLOAT_ACCUM* stash = nhwc_stash(dx_out, seg);
+        for(uint k = 0; k < MIO_BN_VEC; k++)
+        {
+            dbias[k]  = stash[MIO_BN_STASH_DBIAS * MIO_BN_C + chan + k];
+            dscale[k] = stash[MIO_BN_STASH_DSCALE * MIO_BN_C + chan + k];
+        }
+    }
+    barrier(CLK_GLOBAL_MEM_FENCE);
+
+    if(active)
+        nhwc_dx(x_in,
+                dy_in,
+                dx_out,
+                bnScale,
+                chan,
+                nhwc_row_begin(seg),
+                nhwc_row_end(seg),
+                get_local_id(1),
+                mean,
+                invVariance,
+                dbias,
+                dscale);
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,237 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Stages of spatial batch normalization training with the statistics reduced outside of MIOpen,
+// e.g. across the devices of a data-parallel job. The Stats kernels reduce the local partial
+// sums of a channel to float buffers, the Apply kernels take the sums reduced over all the
+// devices together with the global element count. A work-group reduces a channel, the Apply
+// kernels spread a channel over MIO_BN_NGRPS work-groups.
+//
+// The tensors are addressed through MIO_BN_NSTRIDE, MIO_BN_CSTRIDE and MIO_BN_HWSTRIDE, so both
+// NCHW and NHWC layouts are handled.
+
+// Disable specific warnings
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconditional-uninitialized"
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsometimes-uninitialized"
+#endif
+
+#define MIOPEN_USE_AMDGCN 0
+#if defined(__AMDGCN__) && MIO_BN_GFX1030 != 1
+#undef MIOPEN_USE_AMDGCN
+#define MIOPEN_USE_AMDGCN 1
+#endif
+
+// The global element count is known at run time only, which is what the running statistics
+// of variant 4 expect.
+#define MIO_BN_VARIANT 4
+
+#include "batchnorm_functions.h"
+#include "reduction_functions.h"
+
+#ifndef MIO_BN_NSTRIDE
+#define MIO_BN_NSTRIDE MIO_BN_CHW
+#endif
+
+#ifndef MIO_BN_CSTRIDE
+#define MIO_BN_CSTRIDE MIO_BN_HW
+#endif
+
+#ifndef MIO_BN_HWSTRIDE
+#define MIO_BN_HWSTRIDE 1
+#endif
+
+#define MIO_BN_SYNC_STRIDE (MIO_BN_GRP0 * MIO_BN_NGRPS)
+
+// Offset of the element i of the channel, the elements are numbered across the images.
+static inline uint sync_index(uint chan, uint i)
+{
+    const uint n  = i / MIO_BN_HW;
+    const uint hw = i - n * MIO_BN_HW;
+    return n * MIO_BN_NSTRIDE + chan * MIO_BN_CSTRIDE + hw * MIO_BN_HWSTRIDE;
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, 1, 1))) __kernel void
+MIOpenBatchNormSyncFwdStats(const __global _FLOAT* __restrict in,
+                            __global float* __restrict localSum,
+                            __global float* __restrict localSqSum)
+{
+    const uint lid  = get_local_id(0);
+    const uint chan = get_group_id(1);
+
+    _FLOAT_ACCUM sum   = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM sqsum = (_FLOAT_ACCUM)0.;
+
+    for(uint i = lid; i < MIO_BN_NHW; i += MIO_BN_GRP0)
+    {
+        const _FLOAT_ACCUM xin = (_FLOAT_ACCUM)in[sync_index(chan, i)];
+        sum += xin;
+        sqsum = mad(xin, xin, sqsum);
+    }
+
+#if !MIOPEN_USE_AMDGCN
+    local _FLOAT_ACCUM lcl_data_x[MIO_BN_LDS_SIZE];
+    local _FLOAT_ACCUM lcl_data_y[MIO_BN_LDS_SIZE];
+    lds_reduce2(&sum, &sqsum, (_FLOAT_ACCUM)1., lcl_data_x, lcl_data_y, lid);
+#else
+    local _FLOAT_ACCUM lcl_data_x[MIO_BN_LDSGCN_SIZE];
+    local _FLOAT_ACCUM lcl_data_y[MIO_BN_LDSGCN_SIZE];
+    gcn_reduce2(&sum, &sqsum, (_FLOAT_ACCUM)1., lcl_data_x, lcl_data_y, lid);
+#endif
+
+    if(lid == 0)
+    {
+        localSum[chan]   = (float)sum;
+        localSqSum[chan] = (float)sqsum;
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, 1, 1))) __kernel void
+MIOpenBatchNormSyncFwdApply(const __global _FLOAT* __restrict in,
+                            __global _FLOAT* __restrict out,
+                            const __global _FLOAT_PREC* __restrict scale,
+                            const __global _FLOAT_PREC* __restrict bias,
+                            const __global float* __restrict globalSum,
+                            const __global float* __restrict globalSqSum,
+                            float inhw,
+                            double expAvgFactor,
+                            __global _FLOAT_PREC* __restrict resultRunningMean,
+                            __global _FLOAT_PREC* __restrict resultRunningVariance,
+                            double epsilon,
+                            __global _FLOAT_PREC* __restrict resultSaveMean,
+                            __global _FLOAT_PREC* __restrict resultSaveInvVariance)
+{
+    const uint chan = get_group_id(1);
+
+    const _FLOAT_ACCUM mean = (_FLOAT_ACCUM)globalSum[chan] * (_FLOAT_ACCUM)inhw;
+    _FLOAT_ACCUM variance   = mad(-mean, mean, (_FLOAT_ACCUM)globalSqSum[chan] * inhw);
+    variance                = (variance < 0) ? (_FLOAT_ACCUM)0. : variance;
+    const _FLOAT_ACCUM invVariance = rsqrt(variance + (_FLOAT_ACCUM)epsilon);
+
+    if(get_global_id(0) == 0)
+    {
+#if(MIO_RUNNING_RESULT == 1)
+        running_stash_dyn(resultRunningMean,
+                          resultRunningVariance,
+                          expAvgFactor,
+                          mean,
+                          variance,
+                          chan,
+                          (_FLOAT_ACCUM)inhw);
+#endif
+#if(MIO_SAVE_MEAN_VARIANCE == 1)
+        saved_stash(resultSaveMean, resultSaveInvVariance, mean, invVariance, chan);
+#endif
+    }
+
+    const _FLOAT_ACCUM pvscale = (_FLOAT_ACCUM)scale[chan];
+    const _FLOAT_ACCUM pvbias  = (_FLOAT_ACCUM)bias[chan];
+
+    for(uint i = get_global_id(0); i < MIO_BN_NHW; i += MIO_BN_SYNC_STRIDE)
+    {
+        const uint index = sync_index(chan, i);
+        out[index] =
+            (_FLOAT)mad(pvscale, ((_FLOAT_ACCUM)in[index] - mean) * invVariance, pvbias);
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, 1, 1))) __kernel void
+MIOpenBatchNormSyncBwdStats(const __global _FLOAT* __restrict x_in,
+                            const __global _FLOAT* __restrict dy_in,
+                            const __global _FLOAT_PREC* __restrict savedMean,
+                            const __global _FLOAT_PREC* __restrict savedInvVariance,
+                            __global float* __restrict localBiasDiff,
+                            __global float* __restrict localScaleDiff)
+{
+    const uint lid  = get_local_id(0);
+    const uint chan = get_group_id(1);
+
+    const _FLOAT_ACCUM mean        = (_FLOAT_ACCUM)savedMean[chan];
+    const _FLOAT_ACCUM invVariance = (_FLOAT_ACCUM)savedInvVariance[chan];
+
+    _FLOAT_ACCUM db = (_FLOAT_ACCUM)0.;
+    _FLOAT_ACCUM ds = (_FLOAT_ACCUM)0.;
+
+    for(uint i = lid; i < MIO_BN_NHW; i += MIO_BN_GRP0)
+    {
+        const uint index        = sync_index(chan, i);
+        const _FLOAT_ACCUM xhat = ((_FLOAT_ACCUM)x_in[index] - mean) * invVariance;
+        const _FLOAT_ACCUM dyin = (_FLOAT_ACCUM)dy_in[index];
+        db += dyin;
+        ds = mad(xhat, dyin, ds);
+    }
+
+#if !MIOPEN_USE_AMDGCN
+    local _FLOAT_ACCUM lcl_data_x[MIO_BN_LDS_SIZE];
+    local _FLOAT_ACCUM lcl_data_y[MIO_BN_LDS_SIZE];
+    lds_reduce2(&db, &ds, (_FLOAT_ACCUM)1., lcl_data_x, lcl_data_y, lid);
+#else
+    local _FLOAT_ACCUM lcl_data_x[MIO_BN_LDSGCN_SIZE];
+    local _FLOAT_ACCUM lcl_data_y[MIO_BN_LDSGCN_SIZE];
+    gcn_reduce2(&db, &ds, (_FLOAT_ACCUM)1., lcl_data_x, lcl_data_y, lid);
+#endif
+
+    if(lid == 0)
+    {
+        localBiasDiff[chan]  = (float)db;
+        localScaleDiff[chan] = (float)ds;
+    }
+}
+
+__attribute__((reqd_work_group_size(MIO_BN_GRP0, 1, 1))) __kernel void
+MIOpenBatchNormSyncBwdApply(const __global _FLOAT* __restrict x_in,
+                            const __global _FLOAT* __restrict dy_in,
+                            __global _FLOAT* __restrict dx_out,
+                            const __global _FLOAT_PREC* __restrict scale,
+                            const __global _FLOAT_PREC* __restrict savedMean,
+                            const __global _FLOAT_PREC* __restrict savedInvVariance,
+                            const __global float* __restrict globalBiasDiff,
+                            const __global float* __restrict globalScaleDiff,
+                            float inhw)
+{
+    const uint chan = get_group_id(1);
+
+    const _FLOAT_ACCUM mean        = (_FLOAT_ACCUM)savedMean[chan];
+    const _FLOAT_ACCUM invVariance = (_FLOAT_ACCUM)savedInvVariance[chan];
+    const _FLOAT_ACCUM pvscale     = (_FLOAT_ACCUM)scale[chan] * invVariance;
+    const _FLOAT_ACCUM db          = (_FLOAT_ACCUM)globalBiasDiff[chan] * (_FLOAT_ACCUM)inhw;
+    const _FLOAT_ACCUM ds          = (_FLOAT_ACCUM)globalScaleDiff[chan] * (_FLOAT_ACCUM)inhw;
+
+    for(uint i = get_global_id(0); i < MIO_BN_NHW; i += MIO_BN_SYNC_STRIDE)
+    {
+        const uint index        = sync_index(chan, i);
+        const _FLOAT_ACCUM xhat = ((_FLOAT_ACCUM)x_in[index] - mean) * invVariance;
+        const _FLOAT_ACCUM tmp  = mad(-xhat, ds, (_FLOAT_ACCUM)dy_in[index] - db);
+        dx_out[index]           = (_FLOAT)(pvscale * tmp);
+    }
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,430 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// CTC decoding of a [MAX_TSTEP, BATCH_SZ, CLASS_SZ] tensor with the layout of the CTC loss. One
+// work-group decodes one sample at a time. With SOFTMAX_APPLIED the input holds activations and
+// the log-softmax of every frame is computed on the fly, otherwise it holds log-probabilities.
+//
+// The decoded sequences of a sample are BEAM_WIDTH rows of MAX_TSTEP ids, sorted by decreasing
+// score, the score being the log-probability of the sequence (of its best path for greedy).
+
+#include "float_types.h"
+
+#ifndef SOFTMAX_APPLIED
+#define SOFTMAX_APPLIED 1
+#endif
+
+#ifndef BEAM_WIDTH
+#define BEAM_WIDTH 1
+#endif
+
+#ifndef NUM_TOP
+#define NUM_TOP BEAM_WIDTH
+#endif
+
+#ifndef PROBS_STRIDE0
+#define PROBS_STRIDE0 (BATCH_SZ * CLASS_SZ)
+#endif
+#ifndef PROBS_STRIDE1
+#define PROBS_STRIDE1 CLASS_SZ
+#endif
+
+#ifndef BLANK_LB_ID
+#define BLANK_LB 0
+#elif BLANK_LB_ID < 0
+#define BLANK_LB 0
+#elif BLANK_LB_ID >= CLASS_SZ
+#define BLANK_LB (CLASS_SZ - 1)
+#else
+#define BLANK_LB BLANK_LB_ID
+#endif
+
+// The log of a zero probability, anything at or below it is an empty beam or candidate.
+#define CTC_LOG_ZERO (-1e30f)
+
+// "No candidate" in the reductions, below every log-probability including CTC_LOG_ZERO.
+#define CTC_NONE_VAL (-MAXFLOAT)
+#define CTC_NONE_IDX INT_MAX
+
+#define NUM_CAND (BEAM_WIDTH * (NUM_TOP + 1))
+
+static inline float ctc_logaddexp(float a, float b)
+{
+    const float m = max(a, b);
+    if(m <= CTC_LOG_ZERO)
+        return CTC_LOG_ZERO;
+    return m + log(exp(a - m) + exp(b - m));
+}
+
+/// Whether (v, i) comes before (pv, pi) in the order of decreasing value and increasing index,
+/// which makes the selections deterministic.
+static inline bool ctc_before(float v, int i, float pv, int pi)
+{
+    return v > pv || (v == pv && i < pi);
+}
+
+/// Keeps the first of (v, i) in ctc_before order over the work-group, the LDS may be reused as
+/// soon as it returns.
+static inline void
+ctc_first_reduce(float* v, int* i, local float* lcl_v, local int* lcl_i, uint lid)
+{
+    lcl_v[lid] = *v;
+    lcl_i[lid] = *i;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint s = WORK_PER_GRP >> 1; s > 0; s >>= 1)
+    {
+        if(lid < s && ctc_before(lcl_v[lid + s], lcl_i[lid + s], lcl_v[lid], lcl_i[lid]))
+        {
+            lcl_v[lid] = lcl_v[lid + s];
+            lcl_i[lid] = lcl_i[lid + s];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    *v = lcl_v[0];
+    *i = lcl_i[0];
+    barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+/// The log-sum-exp of a frame with maximum m which turns its activations into log-probabilities,
+/// 0 when the input already holds log-probabilities.
+static inline float ctc_frame_lse(const global _FLOAT* row, float m, local float* lcl_v, uint lid)
+{
+#if SOFTMAX_APPLIED
+    float s = 0.0f;
+    for(uint c = lid; c < CLASS_SZ; c += WORK_PER_GRP)
+        s += exp(CVT_FLOAT2ACCUM(row[c]) - m);
+
+    lcl_v[lid] = s;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint k = WORK_PER_GRP >> 1; k > 0; k >>= 1)
+    {
+        if(lid < k)
+            lcl_v[lid] += lcl_v[lid + k];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    s = lcl_v[0];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    return m + log(s);
+#else
+    (void)row;
+    (void)m;
+    (void)lcl_v;
+    (void)lid;
+    return 0.0f;
+#endif
+}
+
+/// The most likely class of the frame among those after (pv, pi) in ctc_before order, skipping
+/// the blank when no_blank is set.
+static inline void ctc_frame_next(const global _FLOAT* row,
+                                  float pv,
+                                  int pi,
+                                  bool no_blank,
+                                  float* v,
+                                  int* idx,
+                                  local float* lcl_v,
+                                  local int* lcl_i,
+                                  uint lid)
+{
+    *v   = CTC_NONE_VAL;
+    *idx = CTC_NONE_IDX;
+    for(uint c = lid; c < CLASS_SZ; c += WORK_PER_GRP)
+    {
+        const float x = CVT_FLOAT2ACCUM(row[c]);
+        if((no_blank && c == BLANK_LB) || !ctc_before(pv, pi, x, c))
+            continue;
+        if(ctc_before(x, c, *v, *idx))
+        {
+            *v   = x;
+            *idx = c;
+        }
+    }
+    ctc_first_reduce(v, idx, lcl_v, lcl_i, lid);
+}
+
+/// Best path decoding: the most likely class of every frame, with repeats merged and blanks
+/// removed. The score is the log-probability of that path.
+__attribute__((reqd_work_group_size(WORK_PER_GRP, 1, 1))) kernel void
+CTCGreedyDecode(const global _FLOAT* probs,
+                const global int* input_lengths,
+                global int* decoded,
+                global int* decoded_lengths,
+                global float* scores,
+                global int* workSpace)
+{
+    local float lcl_v[WORK_PER_GRP];
+    local int lcl_i[WORK_PER_GRP];
+
+    const uint lid = get_local_id(0);
+
+    for(uint bid = get_group_id(0); bid < BATCH_SZ; bid += GRP_NUM)
+    {
+        const uint input_len = clamp(input_lengths[bid], 0, MAX_TSTEP);
+        global int* out      = decoded + bid * BEAM_WIDTH * MAX_TSTEP;
+
+        int prev    = CTC_NONE_IDX;
+        uint len    = 0;
+        float score = 0.0f;
+
+        for(uint t = 0; t < input_len; t++)
+        {
+            const global _FLOAT* row = probs + t * PROBS_STRIDE0 + bid * PROBS_STRIDE1;
+
+            float m;
+            int c;
+            ctc_frame_next(row, MAXFLOAT, -1, false, &m, &c, lcl_v, lcl_i, lid);
+            score += m - ctc_frame_lse(row, m, lcl_v, lid);
+
+            if(c != BLANK_LB && c != prev)
+            {
+                if(lid == 0)
+                    out[len] = c;
+                len++;
+            }
+            prev = c;
+        }
+
+        if(lid == 0)
+        {
+            decoded_lengths[bid * BEAM_WIDTH] = len;
+            scores[bid * BEAM_WIDTH]          = score;
+        }
+    }
+
+    (void)workSpace;
+}
+
+/// Prefix beam search. Every beam is a distinct prefix with the log-probabilities pb and pnb of
+/// the paths ending in a blank and in its last id. At every frame a beam either stays (blank or
+/// repeat of its last id) or is extended by one of the NUM_TOP most likely non-blank ids of the
+/// frame, and the BEAM_WIDTH most likely of those candidates become the next beams. An extension
+/// that equals an existing beam is merged into that beam; prefixes are compared by their length
+/// and a 64-bit hash. The workspace keeps the parent and appended id of every beam and frame,
+/// two ints each, from which the sequences are read back at the end.
+__attribute__((reqd_work_group_size(WORK_PER_GRP, 1, 1))) kernel void
+CTCBeamSearchDecode(const global _FLOAT* probs,
+                    const global int* input_lengths,
+                    global int* decoded,
+                    global int* decoded_lengths,
+                    global float* scores,
+                    global int* workSpace)
+{
+    local float lcl_v[WORK_PER_GRP];
+    local int lcl_i[WORK_PER_GRP];
+
+    local float beam_pb[BEAM_WIDTH];
+    local float beam_pnb[BEAM_WIDTH];
+    local int beam_len[BEAM_WIDTH]; // -1 for an empty beam
+    local int beam_last[BEAM_WIDTH];
+    local ulong beam_hash[BEAM_WIDTH];
+    local ulong beam_phash[BEAM_WIDTH]; // hash of the prefix without its last id
+
+    local float top_lp[NUM_TOP];
+    local int top_cls[NUM_TOP];
+
+    local float cand_pb[BEAM_WIDTH]; // only the staying candidates end in a blank
+    local float cand_pnb[NUM_CAND];
+    local int cand_sel[BEAM_WIDTH];
+
+    const uint lid = get_local_id(0);
+
+    for(uint bid = get_group_id(0); bid < BATCH_SZ; bid += GRP_NUM)
+    {
+        const uint input_len = clamp(input_lengths[bid], 0, MAX_TSTEP);
+        global int* trace    = workSpace + bid * MAX_TSTEP * BEAM_WIDTH * 2;
+
+        if(lid < BEAM_WIDTH)
+        {
+            beam_pb[lid]    = lid == 0 ? 0.0f : CTC_LOG_ZERO;
+            beam_pnb[lid]   = CTC_LOG_ZERO;
+            beam_len[lid]   = lid == 0 ? 0 : -1;
+            beam_last[lid]  = -1;
+            beam_hash[lid]  = 0xcbf29ce484222325UL;
+            beam_phash[lid] = 0;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint t = 0; t < input_len; t++)
+        {
+            const global _FLOAT* row = probs + t * PROBS_STRIDE0 + bid * PROBS_STRIDE1;
+
+            float v;
+            int c;
+            ctc_frame_next(row, MAXFLOAT, -1, false, &v, &c, lcl_v, lcl_i, lid);
+            const float lse      = ctc_frame_lse(row, v, lcl_v, lid);
+            const float lp_blank = CVT_FLOAT2ACCUM(row[BLANK_LB]) - lse;
+
+            v = MAXFLOAT;
+            c = -1;
+            for(uint k = 0; k < NUM_TOP; k++)
+            {
+                ctc_frame_next(row, v, c, true, &v, &c, lcl_v, lcl_i, lid);
+                if(lid == 0)
+                {
+                    top_lp[k]  = v - lse;
+                    top_cls[k] = c;
+                }
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            for(uint q = lid; q < NUM_CAND; q += WORK_PER_GRP)
+            {
+                if(q < BEAM_WIDTH)
+                {
+                    const int last = beam_last[q];
+                    const float p  = ctc_logaddexp(beam_pb[q], beam_pnb[q]) + lp_blank;
+                    cand_pb[q]     = beam_len[q] < 0 ? CTC_LOG_ZERO : max(p, CTC_LOG_ZERO);
+                    cand_pnb[q]    = beam_len[q] < 0 || last < 0
+                                         ? CTC_LOG_ZERO
+                                         : max(beam_pnb[q] + CVT_FLOAT2ACCUM(row[last]) - lse,
+                                               CTC_LOG_ZERO);
+                }
+                else
+                {
+                    const uint i   = (q - BEAM_WIDTH) / NUM_TOP;
+                    const uint k   = (q - BEAM_WIDTH) % NUM_TOP;
+                    const float pa = top_cls[k] == beam_last[i]
+                                         ? beam_pb[i]
+                                         : ctc_logaddexp(beam_pb[i], beam_pnb[i]);
+                    cand_pnb[q] =
+                        beam_len[i] < 0 ? CTC_LOG_ZERO : max(pa + top_lp[k], CTC_LOG_ZERO);
+                }
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            // A staying beam takes over the extension of its parent that reproduces it. Beams
+            // are distinct prefixes, so every extension has at most one such beam.
+            if(lid < BEAM_WIDTH && beam_len[lid] > 0)
+            {
+                for(uint i = 0; i < BEAM_WIDTH; i++)
+                {
+                    if(beam_len[i] != beam_len[lid] - 1 || beam_hash[i] != beam_phash[lid])
+                        continue;
+                    for(uint k = 0; k < NUM_TOP; k++)
+                    {
+                        if(top_cls[k] != beam_last[lid])
+                            continue;
+                        const uint q  = BEAM_WIDTH + i * NUM_TOP + k;
+                        cand_pnb[lid] = ctc_logaddexp(cand_pnb[lid], cand_pnb[q]);
+                        cand_pnb[q]   = CTC_LOG_ZERO;
+                    }
+                    break;
+                }
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            v = MAXFLOAT;
+            c = -1;
+            for(uint r = 0; r < BEAM_WIDTH; r++)
+            {
+                float best = CTC_NONE_VAL;
+                int q_best = CTC_NONE_IDX;
+                for(int q = lid; q < NUM_CAND; q += WORK_PER_GRP)
+                {
+                    const float s =
+                        q < BEAM_WIDTH ? ctc_logaddexp(cand_pb[q], cand_pnb[q]) : cand_pnb[q];
+                    if(ctc_before(v, c, s, q) && ctc_before(s, q, best, q_best))
+                    {
+                        best   = s;
+                        q_best = q;
+                    }
+                }
+                ctc_first_reduce(&best, &q_best, lcl_v, lcl_i, lid);
+                v = best;
+                c = q_best;
+                if(lid == 0)
+                    cand_sel[r] = best > CTC_LOG_ZERO ? q_best : -1;
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            float pb = CTC_LOG_ZERO, pnb = CTC_LOG_ZERO;
+            int len = -1, last = -1, parent = -1, id = -1;
+            ulong hash = 0, phash = 0;
+            if(lid < BEAM_WIDTH && cand_sel[lid] >= 0)
+            {
+                const int q = cand_sel[lid];
+                if(q < BEAM_WIDTH)
+                {
+                    pb     = cand_pb[q];
+                    pnb    = cand_pnb[q];
+                    len    = beam_len[q];
+                    last   = beam_last[q];
+                    hash   = beam_hash[q];
+                    phash  = beam_phash[q];
+                    parent = q;
+                }
+                else
+                {
+                    const int i = (q - BEAM_WIDTH) / NUM_TOP;
+                    id          = top_cls[(q - BEAM_WIDTH) % NUM_TOP];
+                    pnb         = cand_pnb[q];
+                    len         = beam_len[i] + 1;
+                    last        = id;
+                    phash       = beam_hash[i];
+                    hash        = (phash ^ (ulong)(id + 1)) * 0x100000001b3UL;
+                    parent      = i;
+                }
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            if(lid < BEAM_WIDTH)
+            {
+                beam_pb[lid]    = pb;
+                beam_pnb[lid]   = pnb;
+                beam_len[lid]   = len;
+                beam_last[lid]  = last;
+                beam_hash[lid]  = hash;
+                beam_phash[lid] = phash;
+
+                trace[(t * BEAM_WIDTH + lid) * 2]     = parent;
+                trace[(t * BEAM_WIDTH + lid) * 2 + 1] = id;
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+        barrier(CLK_GLOBAL_MEM_FENCE);
+
+        if(lid < BEAM_WIDTH)
+        {
+            global int* out = decoded + (bid * BEAM_WIDTH + lid) * MAX_TSTEP;
+            const int len   = beam_len[lid];
+
+            int pos = len;
+            int cur = lid;
+            for(uint t = input_len; t > 0 && pos > 0; t--)
+            {
+                const int id = trace[((t - 1) * BEAM_WIDTH + cur) * 2 + 1];
+                if(id >= 0)
+                    out[--pos] = id;
+                cur = trace[((t - 1) * BEAM_WIDTH + cur) * 2];
+            }
+
+            decoded_lengths[bid * BEAM_WIDTH + lid] = max(len, 0);
+            scores[bid * BEAM_WIDTH + lid] =
+                len < 0 ? CTC_LOG_ZERO : ctc_logaddexp(beam_pb[lid], beam_pnb[lid]);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+}
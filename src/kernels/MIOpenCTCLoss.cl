@@ -60,26 +60,45 @@
 #define MIOPEN_USE_FP16 0
 #endif
 
+#ifndef MIOPEN_USE_BFP16
+#define MIOPEN_USE_BFP16 0
+#endif
+
 #if MIOPEN_USE_FP16 == 1
 #pragma OPENCL EXTENSION cl_khr_fp16 : enable
 #define _FLOAT half
-#ifndef HALF_MAX
-#define MAX_VAL 65504 /* max value */
-#else
-#define MAX_VAL HALF_MAX
-#endif
 #endif
 #if MIOPEN_USE_FP32 == 1
 #define _FLOAT float
+#endif
+#if MIOPEN_USE_BFP16 == 1
+#include "bfloat16_dev.hpp"
+#define _FLOAT ushort
+#endif
+
+// The probabilities, losses and gradients of the 16-bit types are only loaded and stored, the
+// log-space alphas, betas and gradients are kept in fp32 in the workspace and in LDS.
+#define _FLOAT_PREC float
 #ifndef FLT_MAX
 #define MAX_VAL 3.402823466e+38F /* max value */
 #else
 #define MAX_VAL FLT_MAX
 #endif
+
+#if MIOPEN_USE_BFP16 == 1
+#define CTC_LOAD(v) bfloat16_to_float(v)
+#define CTC_STORE(v) float_to_bfloat16(v)
+#else
+#define CTC_LOAD(v) ((_FLOAT_PREC)(v))
+#define CTC_STORE(v) ((_FLOAT)(v))
 #endif
 
 #ifndef NEGATIVE_CUTOFF_VAL
-#define NEGATIVE_CUTOFF_VAL (_FLOAT)(-1e20)
+#define NEGATIVE_CUTOFF_VAL (_FLOAT_PREC)(-1e20)
+#endif
+
+#ifndef DEVICE_LABELS
+#define DEVICE_LABELS 0
 #endif
 
 #ifndef SOFTMAX_LEN
@@ -97,12 +116,22 @@
 #define PROBS_STRIDE1 CLASS_SZ
 #endif
 
+#ifndef FUSED_SOFTMAX
+#define FUSED_SOFTMAX 0
+#endif
+
+// The log-softmax is written to the workspace in fp32, either by the softmax kernel or, with
+// FUSED_SOFTMAX, by this kernel from the 16-bit logits.
 #if SOFTMAX_APPLIED == 1
 #define USE_PROBS_STRIDE0 (BATCH_SZ * CLASS_SZ)
 #define USE_PROBS_STRIDE1 CLASS_SZ
+#define _FLOAT_PROB _FLOAT_PREC
+#define PROB_LOAD(v) (v)
 #else
 #define USE_PROBS_STRIDE0 PROBS_STRIDE0
 #define USE_PROBS_STRIDE1 PROBS_STRIDE1
+#define _FLOAT_PROB _FLOAT
+#define PROB_LOAD(v) CTC_LOAD(v)
 #endif
 
 #ifndef GRADS_STRIDE0
@@ -128,6 +157,14 @@
 #define ADDRSPACE_GRAD __global
 #endif
 
+// The log-space gradients of a frame are gathered in fp32 in LDS, or for the 16-bit types in
+// a per sample buffer of the workspace, rather than in the gradients themselves.
+#if defined(OPT_LCL_MEM_GRAD) || MIOPEN_USE_FP32 == 0
+#define USE_GRADTMP 1
+#else
+#define USE_GRADTMP 0
+#endif
+
 #ifdef OPT_LCL_MEM_LB
 #define ADDRSPACE_LB __local
 #else
@@ -140,11 +177,11 @@
 #define ADDRSPACE_BETA __global
 #endif
 
-static inline _FLOAT LogAddExp(const _FLOAT* x, const _FLOAT* y)
+static inline _FLOAT_PREC LogAddExp(const _FLOAT_PREC* x, const _FLOAT_PREC* y)
 {
-    _FLOAT a = max(*x, *y);
-    _FLOAT b = min(*x, *y);
-    _FLOAT c = b - a;
+    _FLOAT_PREC a = max(*x, *y);
+    _FLOAT_PREC b = min(*x, *y);
+    _FLOAT_PREC c = b - a;
 
     return c <= NEGATIVE_CUTOFF_VAL ? max(a, NEGATIVE_CUTOFF_VAL)
                                     : max(a + log(exp(b - a) + 1), NEGATIVE_CUTOFF_VAL);
@@ -181,13 +218,13 @@ inline void AtomicLogAddExp(volatile ADDRSPACE_GRAD float* addr, const float ope
     } while(curVal.uval != prevVal.uval);
 }
 
-static inline void CTCAlpha(const global _FLOAT* probs_logits,
+static inline void CTCAlpha(const global _FLOAT_PROB* probs_logits,
                             const ADDRSPACE_LB int* label_prime,
                             const unsigned int label_length,
                             const unsigned int input_length,
                             const unsigned int batch_id,
                             const unsigned int label_repeat,
-                            global _FLOAT* alpha,
+                            global _FLOAT_PREC* alpha,
                             global _FLOAT* loss)
 {
     uint label_prime_len = 2 * label_length + 1;
@@ -200,7 +237,8 @@ static inline void CTCAlpha(const global _FLOAT* probs_logits,
     {
         uint lb_cur = i % 2 == 0 ? BLANK_LB : *((const ADDRSPACE_LB int*)(label_prime + i));
         uint pidx   = batch_id * USE_PROBS_STRIDE1 + lb_cur;
-        *((global _FLOAT*)(alpha + i)) = *((const global _FLOAT*)(probs_logits + pidx));
+        *((global _FLOAT_PREC*)(alpha + i)) =
+            PROB_LOAD(*((const global _FLOAT_PROB*)(probs_logits + pidx)));
     }
     barrier(CLK_LOCAL_MEM_FENCE);
 
@@ -215,19 +253,19 @@ static inline void CTCAlpha(const global _FLOAT* probs_logits,
             size_t aidx_ts  = j * label_prime_len + i;
             size_t aidx_t1s = (j - 1) * label_prime_len + i;
 
-            _FLOAT alpha_t1s1 = *((global _FLOAT*)(alpha + aidx_t1s - 1));
-            _FLOAT alpha_t1s  = *((global _FLOAT*)(alpha + aidx_t1s));
+            _FLOAT_PREC alpha_t1s1 = *((global _FLOAT_PREC*)(alpha + aidx_t1s - 1));
+            _FLOAT_PREC alpha_t1s  = *((global _FLOAT_PREC*)(alpha + aidx_t1s));
 
-            _FLOAT alpha_ts = i == 0 ? alpha_t1s : LogAddExp(&alpha_t1s, &alpha_t1s1);
+            _FLOAT_PREC alpha_ts = i == 0 ? alpha_t1s : LogAddExp(&alpha_t1s, &alpha_t1s1);
             if(i >= 2)
                 if(lb_cur != BLANK_LB && lb_cur != lb_pre)
                 {
-                    _FLOAT alpha_t1s2 = *((global _FLOAT*)(alpha + aidx_t1s - 2));
-                    alpha_ts          = LogAddExp(&alpha_ts, &alpha_t1s2);
+                    _FLOAT_PREC alpha_t1s2 = *((global _FLOAT_PREC*)(alpha + aidx_t1s - 2));
+                    alpha_ts               = LogAddExp(&alpha_ts, &alpha_t1s2);
                 }
 
-            alpha_ts += *((global _FLOAT*)(probs_logits + pidx));
-            *((global _FLOAT*)(alpha + aidx_ts)) = max(alpha_ts, NEGATIVE_CUTOFF_VAL);
+            alpha_ts += PROB_LOAD(*((const global _FLOAT_PROB*)(probs_logits + pidx)));
+            *((global _FLOAT_PREC*)(alpha + aidx_ts)) = max(alpha_ts, NEGATIVE_CUTOFF_VAL);
         }
         barrier(CLK_LOCAL_MEM_FENCE);
     }
@@ -235,38 +273,42 @@ static inline void CTCAlpha(const global _FLOAT* probs_logits,
     if(lid == 0)
     {
         uint alpha_size         = input_length * label_prime_len;
-        _FLOAT alp0             = *((global _FLOAT*)(alpha + alpha_size - 1));
-        _FLOAT alp1             = *((global _FLOAT*)(alpha + alpha_size - 2));
-        *((global _FLOAT*)loss) = -LogAddExp(&alp0, &alp1);
+        _FLOAT_PREC alp0        = *((global _FLOAT_PREC*)(alpha + alpha_size - 1));
+        _FLOAT_PREC alp1        = *((global _FLOAT_PREC*)(alpha + alpha_size - 2));
+        *((global _FLOAT*)loss) = CTC_STORE(-LogAddExp(&alp0, &alp1));
     }
 }
 
-static inline void CTCGradient(const global _FLOAT* probs_logits,
+static inline void CTCGradient(const global _FLOAT_PROB* probs_logits,
                                const ADDRSPACE_LB int* label_prime,
                                const unsigned int label_length,
                                const unsigned int input_length,
                                const unsigned int batch_id,
                                const unsigned int label_repeat,
-                               global _FLOAT* alpha_log,
-                               ADDRSPACE_BETA _FLOAT* beta_buff0,
-                               ADDRSPACE_BETA _FLOAT* beta_buff1,
-                               const global _FLOAT* loss,
+                               global _FLOAT_PREC* alpha_log,
+                               ADDRSPACE_BETA _FLOAT_PREC* beta_buff0,
+                               ADDRSPACE_BETA _FLOAT_PREC* beta_buff1,
                                global _FLOAT* gradients
-#ifdef OPT_LCL_MEM_GRAD
+#if USE_GRADTMP
                                ,
-                               local _FLOAT* gradtmp
+                               ADDRSPACE_GRAD _FLOAT_PREC* gradtmp
 #endif
 )
 {
     uint label_prime_len = 2 * label_length + 1;
 
-    _FLOAT prob_lx_log = -*((const global _FLOAT*)loss);
+    // The log-likelihood is taken from the fp32 alphas rather than the rounded 16-bit loss.
+    uint alpha_size         = input_length * label_prime_len;
+    _FLOAT_PREC alp0        = *((global _FLOAT_PREC*)(alpha_log + alpha_size - 1));
+    _FLOAT_PREC alp1        = *((global _FLOAT_PREC*)(alpha_log + alpha_size - 2));
+    _FLOAT_PREC prob_lx_log = LogAddExp(&alp0, &alp1);
 
     uint lid = get_local_id(0);
 
     uint aidx0 = 1;
     uint aidx1 = label_length + label_repeat < input_length ? 0 : 1;
 
+#if !USE_GRADTMP
     for(uint j = 0; j < input_length; j++)
         for(uint i = lid; i < CLASS_SZ; i += WORK_PER_GRP)
         {
@@ -274,25 +316,27 @@ static inline void CTCGradient(const global _FLOAT* probs_logits,
                 NEGATIVE_CUTOFF_VAL;
         }
     barrier(CLK_LOCAL_MEM_FENCE);
+#endif
 
     for(uint k = aidx1 + lid; k <= aidx0; k += WORK_PER_GRP)
     {
         uint k1     = label_prime_len - 1 - k;
         uint lb_cur = k1 % 2 == 0 ? BLANK_LB : *((const ADDRSPACE_LB int*)(label_prime + k1));
         uint pidx = (input_length - 1) * USE_PROBS_STRIDE0 + batch_id * USE_PROBS_STRIDE1 + lb_cur;
-#ifndef OPT_LCL_MEM_GRAD
+#if !USE_GRADTMP
         uint gidx = (input_length - 1) * GRADS_STRIDE0 + batch_id * GRADS_STRIDE1 + lb_cur;
 #endif
         uint bidx_ts = (input_length - 1) * label_prime_len + k1;
 
-        _FLOAT probs_logits_pidx = *((const global _FLOAT*)(probs_logits + pidx));
-        *((ADDRSPACE_BETA _FLOAT*)(beta_buff0 + k1)) = probs_logits_pidx;
+        _FLOAT_PREC probs_logits_pidx =
+            PROB_LOAD(*((const global _FLOAT_PROB*)(probs_logits + pidx)));
+        *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff0 + k1)) = probs_logits_pidx;
 
-        _FLOAT alpha_temp = *((global _FLOAT*)(alpha_log + bidx_ts));
+        _FLOAT_PREC alpha_temp = *((global _FLOAT_PREC*)(alpha_log + bidx_ts));
         alpha_temp += probs_logits_pidx;
-        _FLOAT grad_temp = NEGATIVE_CUTOFF_VAL;
+        _FLOAT_PREC grad_temp = NEGATIVE_CUTOFF_VAL;
 
-#ifdef OPT_LCL_MEM_GRAD
+#if USE_GRADTMP
         gradtmp[lb_cur]
 #else
         gradients[gidx]
@@ -305,9 +349,10 @@ static inline void CTCGradient(const global _FLOAT* probs_logits,
     {
         uint pidx = (input_length - 1) * USE_PROBS_STRIDE0 + batch_id * USE_PROBS_STRIDE1 + i;
         uint gidx = (input_length - 1) * GRADS_STRIDE0 + batch_id * GRADS_STRIDE1 + i;
-        _FLOAT probs_logits_pidx = *((const global _FLOAT*)(probs_logits + pidx));
-        _FLOAT grad_temp =
-#ifdef OPT_LCL_MEM_GRAD
+        _FLOAT_PREC probs_logits_pidx =
+            PROB_LOAD(*((const global _FLOAT_PROB*)(probs_logits + pidx)));
+        _FLOAT_PREC grad_temp =
+#if USE_GRADTMP
             gradtmp[i]
 #else
             gradients[gidx]
@@ -321,13 +366,13 @@ static inline void CTCGradient(const global _FLOAT* probs_logits,
         grad_temp -= prob_lx_log;
         grad_temp = grad_temp <= NEGATIVE_CUTOFF_VAL ? 0 : exp(grad_temp);
 
-        *((global _FLOAT*)(gradients + gidx)) =
+        *((global _FLOAT*)(gradients + gidx)) = CTC_STORE(
 #if SOFTMAX_APPLIED == 1
             exp(probs_logits_pidx)
 #endif
-            - grad_temp;
+            - grad_temp);
 
-#ifdef OPT_LCL_MEM_GRAD
+#if USE_GRADTMP
         gradtmp[i] = NEGATIVE_CUTOFF_VAL;
 #endif
     }
@@ -346,43 +391,44 @@ static inline void CTCGradient(const global _FLOAT* probs_logits,
 
             size_t pidx = j1 * USE_PROBS_STRIDE0 + batch_id * USE_PROBS_STRIDE1 + lb_cur;
 
-            _FLOAT beta_temp = j % 2 == 0 ? *((ADDRSPACE_BETA _FLOAT*)(beta_buff1 + k1))
-                                          : *((ADDRSPACE_BETA _FLOAT*)(beta_buff0 + k1));
+            _FLOAT_PREC beta_temp = j % 2 == 0 ? *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff1 + k1))
+                                               : *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff0 + k1));
 
             if(k1 <= label_prime_len - 2)
             {
-                _FLOAT beta_temp1 = j % 2 == 0 ? *((ADDRSPACE_BETA _FLOAT*)(beta_buff1 + k1 + 1))
-                                               : *((ADDRSPACE_BETA _FLOAT*)(beta_buff0 + k1 + 1));
+                _FLOAT_PREC beta_temp1 =
+                    j % 2 == 0 ? *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff1 + k1 + 1))
+                               : *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff0 + k1 + 1));
                 beta_temp = LogAddExp(&beta_temp, &beta_temp1);
             }
             if(k1 <= label_prime_len - 3)
                 if(lb_cur != BLANK_LB && lb_cur != lb_pre)
                 {
-                    _FLOAT beta_temp2 = j % 2 == 0
-                                            ? *((ADDRSPACE_BETA _FLOAT*)(beta_buff1 + k1 + 2))
-                                            : *((ADDRSPACE_BETA _FLOAT*)(beta_buff0 + k1 + 2));
+                    _FLOAT_PREC beta_temp2 =
+                        j % 2 == 0 ? *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff1 + k1 + 2))
+                                   : *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff0 + k1 + 2));
                     beta_temp = LogAddExp(&beta_temp, &beta_temp2);
                 }
 
-            beta_temp += *((const global _FLOAT*)(probs_logits + pidx));
+            beta_temp += PROB_LOAD(*((const global _FLOAT_PROB*)(probs_logits + pidx)));
             beta_temp = max(beta_temp, NEGATIVE_CUTOFF_VAL);
             if(j % 2 == 0)
-                *((ADDRSPACE_BETA _FLOAT*)(beta_buff0 + k1)) = beta_temp;
+                *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff0 + k1)) = beta_temp;
             else
-                *((ADDRSPACE_BETA _FLOAT*)(beta_buff1 + k1)) = beta_temp;
+                *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff1 + k1)) = beta_temp;
 
 #ifdef OPT_ATOMIC_LOGADDEXP
-#ifndef OPT_LCL_MEM_GRAD
-            size_t gidx = j1 * USE_PROBS_STRIDE0 + batch_id * USE_PROBS_STRIDE1 + lb_cur;
+#if !USE_GRADTMP
+            size_t gidx = j1 * GRADS_STRIDE0 + batch_id * GRADS_STRIDE1 + lb_cur;
 #endif
             size_t bidx_ts = j1 * label_prime_len + k1;
-            beta_temp += *((global _FLOAT*)(alpha_log + bidx_ts));
+            beta_temp += *((global _FLOAT_PREC*)(alpha_log + bidx_ts));
 
             AtomicLogAddExp((
-#ifdef OPT_LCL_MEM_GRAD
-                                local _FLOAT*)(gradtmp + lb_cur
+#if USE_GRADTMP
+                                ADDRSPACE_GRAD _FLOAT_PREC*)(gradtmp + lb_cur
 #else
-                                global _FLOAT*)(gradients + gidx
+                                global _FLOAT_PREC*)(gradients + gidx
 #endif
                                                ),
                             beta_temp);
@@ -395,23 +441,24 @@ static inline void CTCGradient(const global _FLOAT* probs_logits,
             {
                 int klid   = 2 * k + lid;
                 int lb_cur = lid == 0 ? BLANK_LB : *((const ADDRSPACE_LB int*)(label_prime + klid));
-#ifndef OPT_LCL_MEM_GRAD
+#if !USE_GRADTMP
                 size_t gidx      = j1 * GRADS_STRIDE0 + batch_id * GRADS_STRIDE1 + lb_cur;
 #endif
-                _FLOAT beta_temp = j % 2 == 0 ? *((ADDRSPACE_BETA _FLOAT*)(beta_buff0 + klid))
-                                              : *((ADDRSPACE_BETA _FLOAT*)(beta_buff1 + klid));
+                _FLOAT_PREC beta_temp = j % 2 == 0
+                                            ? *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff0 + klid))
+                                            : *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff1 + klid));
                 size_t bidx_ts = j1 * label_prime_len + klid;
 
-                beta_temp += *((global _FLOAT*)(alpha_log + bidx_ts));
-                _FLOAT grad_temp =
-#ifdef OPT_LCL_MEM_GRAD
+                beta_temp += *((global _FLOAT_PREC*)(alpha_log + bidx_ts));
+                _FLOAT_PREC grad_temp =
+#if USE_GRADTMP
                     gradtmp[lb_cur]
 #else
                     gradients[gidx]
 #endif
                     ;
 
-#ifdef OPT_LCL_MEM_GRAD
+#if USE_GRADTMP
                 gradtmp[lb_cur]
 #else
                 gradients[gidx]
@@ -423,23 +470,23 @@ static inline void CTCGradient(const global _FLOAT* probs_logits,
         {
             int k            = 2 * label_length;
 
-#ifndef OPT_LCL_MEM_GRAD
+#if !USE_GRADTMP
             size_t gidx      = j1 * GRADS_STRIDE0 + batch_id * GRADS_STRIDE1 + BLANK_LB;
 #endif
-            _FLOAT beta_temp = j % 2 == 0 ? *((ADDRSPACE_BETA _FLOAT*)(beta_buff0 + k))
-                                          : *((ADDRSPACE_BETA _FLOAT*)(beta_buff1 + k));
+            _FLOAT_PREC beta_temp = j % 2 == 0 ? *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff0 + k))
+                                               : *((ADDRSPACE_BETA _FLOAT_PREC*)(beta_buff1 + k));
             size_t bidx_ts = j1 * label_prime_len + k;
 
-            beta_temp += *((global _FLOAT*)(alpha_log + bidx_ts));
-            _FLOAT grad_temp =
-#ifdef OPT_LCL_MEM_GRAD
+            beta_temp += *((global _FLOAT_PREC*)(alpha_log + bidx_ts));
+            _FLOAT_PREC grad_temp =
+#if USE_GRADTMP
                 gradtmp[BLANK_LB]
 #else
                 gradients[gidx]
 #endif
                 ;
 
-#ifdef OPT_LCL_MEM_GRAD
+#if USE_GRADTMP
             gradtmp[BLANK_LB]
 #else
             gradients[gidx]
@@ -454,10 +501,11 @@ static inline void CTCGradient(const global _FLOAT* probs_logits,
             size_t pidx = j1 * USE_PROBS_STRIDE0 + batch_id * USE_PROBS_STRIDE1 + i;
             size_t gidx = j1 * GRADS_STRIDE0 + batch_id * GRADS_STRIDE1 + i;
 
-            _FLOAT probs_logits_pidx = *((const global _FLOAT*)(probs_logits + pidx));
+            _FLOAT_PREC probs_logits_pidx =
+                PROB_LOAD(*((const global _FLOAT_PROB*)(probs_logits + pidx)));
 
-            _FLOAT grad_temp =
-#ifdef OPT_LCL_MEM_GRAD
+            _FLOAT_PREC grad_temp =
+#if USE_GRADTMP
                 gradtmp[i]
 #else
                 gradients[gidx]
@@ -472,25 +520,94 @@ static inline void CTCGradient(const global _FLOAT* probs_logits,
             grad_temp -= prob_lx_log;
             grad_temp = grad_temp <= NEGATIVE_CUTOFF_VAL ? 0 : exp(grad_temp);
 
-            *((global _FLOAT*)(gradients + gidx)) =
+            *((global _FLOAT*)(gradients + gidx)) = CTC_STORE(
 #if SOFTMAX_APPLIED == 1
                 exp(probs_logits_pidx)
 #endif
-                - grad_temp;
+                - grad_temp);
 
-#ifdef OPT_LCL_MEM_GRAD
-            *((local _FLOAT*)(gradtmp + i)) = NEGATIVE_CUTOFF_VAL;
+#if USE_GRADTMP
+            *((ADDRSPACE_GRAD _FLOAT_PREC*)(gradtmp + i)) = NEGATIVE_CUTOFF_VAL;
 #endif
         }
         barrier(CLK_LOCAL_MEM_FENCE);
     }
 }
 
+#if FUSED_SOFTMAX
+static inline _FLOAT_PREC CTCGroupMax(_FLOAT_PREC v, local _FLOAT_PREC* red)
+{
+    uint lid = get_local_id(0);
+    red[lid] = v;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint s = WORK_PER_GRP / 2; s > 0; s >>= 1)
+    {
+        if(lid < s)
+            red[lid] = max(red[lid], red[lid + s]);
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    v = red[0];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    return v;
+}
+
+static inline _FLOAT_PREC CTCGroupSum(_FLOAT_PREC v, local _FLOAT_PREC* red)
+{
+    uint lid = get_local_id(0);
+    red[lid] = v;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint s = WORK_PER_GRP / 2; s > 0; s >>= 1)
+    {
+        if(lid < s)
+            red[lid] += red[lid + s];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    v = red[0];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    return v;
+}
+
+// Log-softmax of the frames of one sample, read from the 16-bit logits and written in fp32
+// to the packed log-probabilities of the workspace. Only the frames within the input length
+// are read by the recursions, so the others are skipped.
+static inline void CTCLogSoftmax(const global _FLOAT* logits,
+                                 global _FLOAT_PREC* probs_log,
+                                 const unsigned int input_length,
+                                 const unsigned int batch_id,
+                                 local _FLOAT_PREC* red)
+{
+    uint lid = get_local_id(0);
+
+    for(uint j = 0; j < input_length; j++)
+    {
+        const global _FLOAT* frame = logits + j * PROBS_STRIDE0 + batch_id * PROBS_STRIDE1;
+        global _FLOAT_PREC* frame_log =
+            probs_log + j * USE_PROBS_STRIDE0 + batch_id * USE_PROBS_STRIDE1;
+
+        _FLOAT_PREC frame_max = -MAX_VAL;
+        for(uint i = lid; i < CLASS_SZ; i += WORK_PER_GRP)
+            frame_max = max(frame_max, CTC_LOAD(frame[i]));
+        frame_max = CTCGroupMax(frame_max, red);
+
+        _FLOAT_PREC frame_sum = 0;
+        for(uint i = lid; i < CLASS_SZ; i += WORK_PER_GRP)
+            frame_sum += exp(CTC_LOAD(frame[i]) - frame_max);
+        _FLOAT_PREC frame_lse = frame_max + log(CTCGroupSum(frame_sum, red));
+
+        for(uint i = lid; i < CLASS_SZ; i += WORK_PER_GRP)
+            frame_log[i] = CTC_LOAD(frame[i]) - frame_lse;
+    }
+}
+#endif
+
 kernel void CTCLossGPU(const global _FLOAT* probs,
-                       global _FLOAT* workSpace,
+                       global _FLOAT_PREC* workSpace,
                        global int* dim_data,
                        global _FLOAT* losses,
-                       global _FLOAT* gradients)
+                       global _FLOAT* gradients,
+                       const global int* labels,
+                       const global int* label_lengths,
+                       const global int* input_lengths)
 {
 
     uint gid = get_global_id(0);
@@ -499,43 +616,87 @@ kernel void CTCLossGPU(const global _FLOAT* probs,
     uint grp_id = gid / WORK_PER_GRP;
 
 #ifdef OPT_LCL_MEM_BETA
-    local _FLOAT beta0[MAX_S_LEN];
-    local _FLOAT beta1[MAX_S_LEN];
+    local _FLOAT_PREC beta0[MAX_S_LEN];
+    local _FLOAT_PREC beta1[MAX_S_LEN];
 #endif
 
 #ifdef OPT_LCL_MEM_GRAD
-    local _FLOAT gradtmp[CLASS_SZ];
+    local _FLOAT_PREC gradtmp[CLASS_SZ];
+#endif
+
+#if FUSED_SOFTMAX
+    local _FLOAT_PREC sfm_red[WORK_PER_GRP];
 #endif
 
 #ifdef OPT_LCL_MEM_LB
     local int lb_prime[MAX_S_LEN];
 #endif
 
+#if DEVICE_LABELS
+    local uint lcl_repeat;
+#endif
+
     for(uint bid = grp_id; bid < BATCH_SZ; bid += GRP_NUM)
     {
+#if DEVICE_LABELS
+        // The lengths were never seen by the host, so they are clamped to the sizes the
+        // workspace was allocated for and the offsets and repeats are computed here.
+        uint input_len = clamp(input_lengths[bid], 1, MAX_TSTEP);
+        uint label_len = clamp(label_lengths[bid], 0, MAX_LB_LEN);
+
+        uint label_offsets = 0;
+        for(uint i = 0; i < bid; i++)
+            label_offsets += max(label_lengths[i], 0);
+
+        if(lid == 0)
+            lcl_repeat = 0;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        uint repeat = 0;
+        for(uint i = lid + 1; i < label_len; i += WORK_PER_GRP)
+            if(labels[label_offsets + i] == labels[label_offsets + i - 1])
+                repeat++;
+        if(repeat > 0)
+            atomic_add(&lcl_repeat, repeat);
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        uint label_repeat = lcl_repeat;
+#else
         uint input_len     = *((global int*)(dim_data + bid));
         uint label_len     = *((global int*)(dim_data + BATCH_SZ + bid));
         uint label_offsets = *((global int*)(dim_data + 2 * BATCH_SZ + bid));
         uint label_repeat  = *((global int*)(dim_data + 3 * BATCH_SZ + bid));
+#endif
 
         for(uint i = lid; i < label_len; i += WORK_PER_GRP)
+        {
+#if DEVICE_LABELS
+            // Out of range ids are clamped so that they cannot index past probs or gradients.
+            int lb = clamp(labels[label_offsets + i], 0, CLASS_SZ - 1);
+#else
+            int lb = dim_data[4 * BATCH_SZ + label_offsets + i];
+#endif
 #ifdef OPT_LCL_MEM_LB
-            lb_prime[
+            lb_prime[2 * i + 1] = lb;
 #else
-            dim_data[LB_PRIME_OFFSET + bid * MAX_S_LEN +
+            dim_data[LB_PRIME_OFFSET + bid * MAX_S_LEN + 2 * i + 1] = lb;
 #endif
-                2 * i + 1] = dim_data[4 * BATCH_SZ + label_offsets + i];
+        }
 
         for(uint i = lid; i < MAX_TSTEP * MAX_S_LEN; i += WORK_PER_GRP)
-            *((global _FLOAT*)(workSpace + ALPHA_OFFSET + bid * MAX_TSTEP * MAX_S_LEN + i)) =
+            *((global _FLOAT_PREC*)(workSpace + ALPHA_OFFSET + bid * MAX_TSTEP * MAX_S_LEN + i)) =
                 NEGATIVE_CUTOFF_VAL;
 
 #ifndef OPT_LCL_MEM_BETA
         for(uint i = lid; i < 2 * MAX_S_LEN; i += WORK_PER_GRP)
-            *((global _FLOAT*)(workSpace + BETA_OFFSET + bid * 2 * MAX_S_LEN + i)) =
+            *((global _FLOAT_PREC*)(workSpace + BETA_OFFSET + bid * 2 * MAX_S_LEN + i)) =
                 NEGATIVE_CUTOFF_VAL;
 #endif
 
+#if FUSED_SOFTMAX
+        CTCLogSoftmax(probs, &workSpace[PROBLOG_OFFSET], input_len, bid, &sfm_red[0]);
+#endif
+
         barrier(CLK_LOCAL_MEM_FENCE);
 
         CTCAlpha(
@@ -559,15 +720,20 @@ kernel void CTCLossGPU(const global _FLOAT* probs,
             &losses[bid]);
 
 #ifdef OPT_LCL_MEM_GRAD
+        local _FLOAT_PREC* grad_buff = &gradtmp[0];
+#elif USE_GRADTMP
+        global _FLOAT_PREC* grad_buff = &workSpace[GRADTMP_OFFSET + bid * CLASS_SZ];
+#endif
+#if USE_GRADTMP
         for(uint i = lid; i < CLASS_SZ; i += WORK_PER_GRP)
-            *((local _FLOAT*)(gradtmp + i)) = NEGATIVE_CUTOFF_VAL;
+            *((ADDRSPACE_GRAD _FLOAT_PREC*)(grad_buff + i)) = NEGATIVE_CUTOFF_VAL;
 #endif
 
 #ifdef OPT_LCL_MEM_BETA
         for(uint i = lid; i < MAX_S_LEN; i += WORK_PER_GRP)
         {
-            *((local _FLOAT*)(beta0 + i)) = NEGATIVE_CUTOFF_VAL;
-            *((local _FLOAT*)(beta1 + i)) = NEGATIVE_CUTOFF_VAL;
+            *((local _FLOAT_PREC*)(beta0 + i)) = NEGATIVE_CUTOFF_VAL;
+            *((local _FLOAT_PREC*)(beta1 + i)) = NEGATIVE_CUTOFF_VAL;
         }
 #endif
 
@@ -599,14 +765,18 @@ kernel void CTCLossGPU(const global _FLOAT* probs,
             &workSpace[BETA_OFFSET + (bid * 2 + 1) * MAX_S_LEN]
 #endif
             ,
-            &losses[bid],
             gradients
-#ifdef OPT_LCL_MEM_GRAD
+#if USE_GRADTMP
             ,
-            &gradtmp[0]
+            grad_buff
 #endif
         );
     }
 
     (void)probs;
+#if !DEVICE_LABELS
+    (void)labels;
+    (void)label_lengths;
+    (void)input_lengths;
+#endif
 }
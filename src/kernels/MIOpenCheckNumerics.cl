@@ -80,10 +80,14 @@ void cl_atomic_max_float(volatile __global float* addr, float val)
     }
 
 // Checks a block of data for abnormal numeric values :
+// Only the elements first, first + stride, ... are checked. The flags are only ever set, so the
+// results of many launches can be accumulated into one buffer.
 __kernel void MIOpenCheckNumerics(const __global DTYPE* data,
                                   int size,
                                   __global struct CheckNumericsResult* abnormal,
-                                  int computeStats)
+                                  int computeStats,
+                                  int first,
+                                  int stride)
 {
     const int lid           = get_local_id(0);
     const int gid           = get_global_id(0);
@@ -91,7 +95,7 @@ __kernel void MIOpenCheckNumerics(const __global DTYPE* data,
 
     local float stats[4 * GROUP_SIZE];
 
-    int offset       = gid;
+    long offset      = first + (long)gid * stride;
     ACCUMTYPE sum    = 0.0f;
     ACCUMTYPE abssum = 0.0f;
     DTYPE minV       = FLT_MAX;
@@ -140,7 +144,7 @@ __kernel void MIOpenCheckNumerics(const __global DTYPE* data,
         {
             abnormal->hasInf = 1;
         }
-        offset += total_wi_size;
+        offset += (long)total_wi_size * stride;
     }
 
     if(computeStats)
@@ -0,0 +1,258 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+// Depthwise convolution: input channel c is convolved with the MIOPEN_DW_M filters of the output
+// channels c * MIOPEN_DW_M ... c * MIOPEN_DW_M + MIOPEN_DW_M - 1. All the sizes are compiled in,
+// so that the loops over the filter and the tile are unrolled and the filter and the input rows
+// stay in registers.
+
+#define MIOPEN_DW_K (MIOPEN_DW_C * MIOPEN_DW_M)
+#define MIOPEN_DW_FLT_SZ (MIOPEN_DW_FLT_H * MIOPEN_DW_FLT_W)
+// Input elements of a row read by the MIOPEN_DW_TILE neighbouring outputs.
+#define MIOPEN_DW_ROW_SPAN \
+    ((MIOPEN_DW_TILE - 1) * MIOPEN_DW_STRIDE_W + (MIOPEN_DW_FLT_W - 1) * MIOPEN_DW_DILATION_W + 1)
+
+#define MIOPEN_DW_TILES(w) (((w) + MIOPEN_DW_TILE - 1) / MIOPEN_DW_TILE)
+
+#if MIOPEN_DW_NHWC
+#define X_IDX(n, c, h, w) \
+    ((((n)*MIOPEN_DW_IN_H + (h)) * MIOPEN_DW_IN_W + (w)) * MIOPEN_DW_C + (c))
+#define Y_IDX(n, k, h, w) \
+    ((((n)*MIOPEN_DW_OUT_H + (h)) * MIOPEN_DW_OUT_W + (w)) * MIOPEN_DW_K + (k))
+#else
+#define X_IDX(n, c, h, w) \
+    ((((n)*MIOPEN_DW_C + (c)) * MIOPEN_DW_IN_H + (h)) * MIOPEN_DW_IN_W + (w))
+#define Y_IDX(n, k, h, w) \
+    ((((n)*MIOPEN_DW_K + (k)) * MIOPEN_DW_OUT_H + (h)) * MIOPEN_DW_OUT_W + (w))
+#endif
+// Filters are K x 1 x FLT_H x FLT_W in both layouts.
+#define W_IDX(k, y, x) (((k)*MIOPEN_DW_FLT_H + (y)) * MIOPEN_DW_FLT_W + (x))
+
+// Splits the work-item id into the image, the channel, the row and the tile of the row. In NHWC
+// the channel is the fastest, in NCHW the tile is, so that neighbouring work-items access
+// neighbouring elements.
+#if MIOPEN_DW_NHWC
+#define SPLIT_ID(id, channels, height, tiles, n, ch, h, tile) \
+    do                                                         \
+    {                                                          \
+        uint rest_ = (id);                                     \
+        ch         = rest_ % (channels);                       \
+        rest_ /= (channels);                                   \
+        tile = rest_ % (tiles);                                \
+        rest_ /= (tiles);                                      \
+        h = rest_ % (height);                                  \
+        n = rest_ / (height);                                  \
+    } while(0)
+#else
+#define SPLIT_ID(id, channels, height, tiles, n, ch, h, tile) \
+    do                                                         \
+    {                                                          \
+        uint rest_ = (id);                                     \
+        tile       = rest_ % (tiles);                          \
+        rest_ /= (tiles);                                      \
+        h = rest_ % (height);                                  \
+        rest_ /= (height);                                     \
+        ch = rest_ % (channels);                               \
+        n  = rest_ / (channels);                               \
+    } while(0)
+#endif
+
+__attribute__((reqd_work_group_size(MIOPEN_DW_BLOCK, 1, 1))) __kernel void
+MIOpenConvDepthwiseFwd(const __global _FLOAT* __restrict x,
+                       const __global _FLOAT* __restrict w,
+                       __global _FLOAT* __restrict y)
+{
+    uint n, k, ho, tile;
+    SPLIT_ID(get_global_id(0), MIOPEN_DW_K, MIOPEN_DW_OUT_H, MIOPEN_DW_TILES(MIOPEN_DW_OUT_W), n, k,
+             ho, tile);
+    if(n >= MIOPEN_DW_N)
+        return;
+
+    const uint c   = k / MIOPEN_DW_M;
+    const uint wo0 = tile * MIOPEN_DW_TILE;
+    const int wi0  = (int)(wo0 * MIOPEN_DW_STRIDE_W) - MIOPEN_DW_PAD_W;
+
+    _FLOAT_ACCUM flt[MIOPEN_DW_FLT_SZ];
+    for(uint i = 0; i < MIOPEN_DW_FLT_SZ; ++i)
+        flt[i] = CVT_FLOAT2ACCUM(w[k * MIOPEN_DW_FLT_SZ + i]);
+
+    _FLOAT_ACCUM acc[MIOPEN_DW_TILE];
+    for(uint t = 0; t < MIOPEN_DW_TILE; ++t)
+        acc[t] = (_FLOAT_ACCUM)0;
+
+    for(uint fy = 0; fy < MIOPEN_DW_FLT_H; ++fy)
+    {
+        const int hi = (int)(ho * MIOPEN_DW_STRIDE_H + fy * MIOPEN_DW_DILATION_H) - MIOPEN_DW_PAD_H;
+        if(hi < 0 || hi >= MIOPEN_DW_IN_H)
+            continue;
+
+        // The row is read once for all the outputs of the tile.
+        _FLOAT_ACCUM row[MIOPEN_DW_ROW_SPAN];
+        for(uint i = 0; i < MIOPEN_DW_ROW_SPAN; ++i)
+        {
+            const int wi = wi0 + (int)i;
+            row[i]       = (wi >= 0 && wi < MIOPEN_DW_IN_W)
+                               ? CVT_FLOAT2ACCUM(x[X_IDX(n, c, hi, wi)])
+                               : (_FLOAT_ACCUM)0;
+        }
+
+        for(uint fx = 0; fx < MIOPEN_DW_FLT_W; ++fx)
+            for(uint t = 0; t < MIOPEN_DW_TILE; ++t)
+                acc[t] += flt[fy * MIOPEN_DW_FLT_W + fx] *
+                          row[t * MIOPEN_DW_STRIDE_W + fx * MIOPEN_DW_DILATION_W];
+    }
+
+    for(uint t = 0; t < MIOPEN_DW_TILE; ++t)
+    {
+        const uint wo = wo0 + t;
+        if(wo < MIOPEN_DW_OUT_W)
+            y[Y_IDX(n, k, ho, wo)] = CVT_ACCUM2FLOAT(acc[t]);
+    }
+}
+
+__attribute__((reqd_work_group_size(MIOPEN_DW_BLOCK, 1, 1))) __kernel void
+MIOpenConvDepthwiseBwd(const __global _FLOAT* __restrict dy,
+                       const __global _FLOAT* __restrict w,
+                       __global _FLOAT* __restrict dx)
+{
+    uint n, c, hi, tile;
+    SPLIT_ID(get_global_id(0), MIOPEN_DW_C, MIOPEN_DW_IN_H, MIOPEN_DW_TILES(MIOPEN_DW_IN_W), n, c,
+             hi, tile);
+    if(n >= MIOPEN_DW_N)
+        return;
+
+    const uint wi0 = tile * MIOPEN_DW_TILE;
+
+    _FLOAT_ACCUM acc[MIOPEN_DW_TILE];
+    for(uint t = 0; t < MIOPEN_DW_TILE; ++t)
+        acc[t] = (_FLOAT_ACCUM)0;
+
+    for(uint m = 0; m < MIOPEN_DW_M; ++m)
+    {
+        const uint k = c * MIOPEN_DW_M + m;
+        for(uint fy = 0; fy < MIOPEN_DW_FLT_H; ++fy)
+        {
+            const int ho_num = (int)(hi + MIOPEN_DW_PAD_H) - (int)(fy * MIOPEN_DW_DILATION_H);
+            if(ho_num < 0 || ho_num % MIOPEN_DW_STRIDE_H != 0)
+                continue;
+            const int ho = ho_num / MIOPEN_DW_STRIDE_H;
+            if(ho >= MIOPEN_DW_OUT_H)
+                continue;
+
+            for(uint fx = 0; fx < MIOPEN_DW_FLT_W; ++fx)
+            {
+                const _FLOAT_ACCUM flt = CVT_FLOAT2ACCUM(w[W_IDX(k, fy, fx)]);
+                for(uint t = 0; t < MIOPEN_DW_TILE; ++t)
+                {
+                    const int wo_num =
+                        (int)(wi0 + t + MIOPEN_DW_PAD_W) - (int)(fx * MIOPEN_DW_DILATION_W);
+                    if(wo_num < 0 || wo_num % MIOPEN_DW_STRIDE_W != 0)
+                        continue;
+                    const int wo = wo_num / MIOPEN_DW_STRIDE_W;
+                    if(wo < MIOPEN_DW_OUT_W)
+                        acc[t] += flt * CVT_FLOAT2ACCUM(dy[Y_IDX(n, k, ho, wo)]);
+                }
+            }
+        }
+    }
+
+    for(uint t = 0; t < MIOPEN_DW_TILE; ++t)
+    {
+        const uint wi = wi0 + t;
+        if(wi < MIOPEN_DW_IN_W)
+            dx[X_IDX(n, c, hi, wi)] = CVT_ACCUM2FLOAT(acc[t]);
+    }
+}
+
+// A work-group per output channel. The work-items accumulate all the taps of the filter over
+// their share of the tiles of the images and the taps are then reduced in the local memory.
+__attribute__((reqd_work_group_size(MIOPEN_DW_BLOCK, 1, 1))) __kernel void
+MIOpenConvDepthwiseWrw(const __global _FLOAT* __restrict x,
+                       __global _FLOAT* __restrict dw,
+                       const __global _FLOAT* __restrict dy)
+{
+    const uint k   = get_group_id(0);
+    const uint c   = k / MIOPEN_DW_M;
+    const uint lid = get_local_id(0);
+
+    _FLOAT_ACCUM acc[MIOPEN_DW_FLT_SZ];
+    for(uint i = 0; i < MIOPEN_DW_FLT_SZ; ++i)
+        acc[i] = (_FLOAT_ACCUM)0;
+
+    const uint tiles = MIOPEN_DW_TILES(MIOPEN_DW_OUT_W);
+    for(uint id = lid; id < MIOPEN_DW_N * MIOPEN_DW_OUT_H * tiles; id += MIOPEN_DW_BLOCK)
+    {
+        const uint tile = id % tiles;
+        const uint ho   = (id / tiles) % MIOPEN_DW_OUT_H;
+        const uint n    = id / (tiles * MIOPEN_DW_OUT_H);
+        const uint wo0  = tile * MIOPEN_DW_TILE;
+        const int wi0   = (int)(wo0 * MIOPEN_DW_STRIDE_W) - MIOPEN_DW_PAD_W;
+
+        _FLOAT_ACCUM grad[MIOPEN_DW_TILE];
+        for(uint t = 0; t < MIOPEN_DW_TILE; ++t)
+            grad[t] = (wo0 + t < MIOPEN_DW_OUT_W) ? CVT_FLOAT2ACCUM(dy[Y_IDX(n, k, ho, wo0 + t)])
+                                                  : (_FLOAT_ACCUM)0;
+
+        for(uint fy = 0; fy < MIOPEN_DW_FLT_H; ++fy)
+        {
+            const int hi =
+                (int)(ho * MIOPEN_DW_STRIDE_H + fy * MIOPEN_DW_DILATION_H) - MIOPEN_DW_PAD_H;
+            if(hi < 0 || hi >= MIOPEN_DW_IN_H)
+                continue;
+
+            _FLOAT_ACCUM row[MIOPEN_DW_ROW_SPAN];
+            for(uint i = 0; i < MIOPEN_DW_ROW_SPAN; ++i)
+            {
+                const int wi = wi0 + (int)i;
+                row[i]       = (wi >= 0 && wi < MIOPEN_DW_IN_W)
+                                   ? CVT_FLOAT2ACCUM(x[X_IDX(n, c, hi, wi)])
+                                   : (_FLOAT_ACCUM)0;
+            }
+
+            for(uint fx = 0; fx < MIOPEN_DW_FLT_W; ++fx)
+                for(uint t = 0; t < MIOPEN_DW_TILE; ++t)
+                    acc[fy * MIOPEN_DW_FLT_W + fx] +=
+                        grad[t] * row[t * MIOPEN_DW_STRIDE_W + fx * MIOPEN_DW_DILATION_W];
+        }
+    }
+
+    __local _FLOAT_ACCUM lcl[MIOPEN_DW_BLOCK];
+    for(uint i = 0; i < MIOPEN_DW_FLT_SZ; ++i)
+    {
+        lcl[lid] = acc[i];
+        barrier(CLK_LOCAL_MEM_FENCE);
+        for(uint s = MIOPEN_DW_BLOCK / 2; s > 0; s >>= 1)
+        {
+            if(lid < s)
+                lcl[lid] += lcl[lid + s];
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+        if(lid == 0)
+            dw[k * MIOPEN_DW_FLT_SZ + i] = CVT_ACCUM2FLOAT(lcl[0]);
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+}
@@ -0,0 +1,451 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+// Generic tiled direct convolution, the fast fallback of the naive kernels. 2D problems come
+// as 3D ones of depth 1, every size is a compile-time constant so that the filter taps and
+// strides resolve to shifts and constants. The convolution of a group is computed as a GEMM
+// staged through LDS, a pass per MIOPEN_DT_DIR:
+// - Forward (0): M is the output pixels, N the output channels, K the filter taps of a channel.
+// - Backward data (1): M is the input pixels, N the input channels, K the filter taps of an
+//   output channel. The taps which do not hit an output pixel because of the strides read zeros.
+// - Backward weights (2): M is the output channels, N the filter taps of an input channel, K is
+//   the output pixels of the batch.
+// The filter taps of a channel are ordered as in the filters of MIOPEN_DT_NHWC, so the GEMM
+// indices along them are contiguous in memory. MIOPEN_DT_VEC_A and MIOPEN_DT_VEC_B are 4 when the
+// contiguous dimension of the matrix allows aligned vector loads, and 1 otherwise.
+
+#define DT_C (MIOPEN_DT_G * MIOPEN_DT_CG)
+#define DT_K (MIOPEN_DT_G * MIOPEN_DT_KG)
+#define DT_ZYX (MIOPEN_DT_FZ * MIOPEN_DT_FY * MIOPEN_DT_FX)
+#define DT_IN_DHW (MIOPEN_DT_DI * MIOPEN_DT_HI * MIOPEN_DT_WI)
+#define DT_OUT_DHW (MIOPEN_DT_DO * MIOPEN_DT_HO * MIOPEN_DT_WO)
+
+#if MIOPEN_DT_DIR == 0
+#define GEMM_M (MIOPEN_DT_N * DT_OUT_DHW)
+#define GEMM_N MIOPEN_DT_KG
+#define GEMM_K (DT_ZYX * MIOPEN_DT_CG)
+#elif MIOPEN_DT_DIR == 1
+#define GEMM_M (MIOPEN_DT_N * DT_IN_DHW)
+#define GEMM_N MIOPEN_DT_CG
+#define GEMM_K (DT_ZYX * MIOPEN_DT_KG)
+#else
+#define GEMM_M MIOPEN_DT_KG
+#define GEMM_N (DT_ZYX * MIOPEN_DT_CG)
+#define GEMM_K (MIOPEN_DT_N * DT_OUT_DHW)
+#endif
+
+// Whether the GEMM K index is the contiguous one of the A and B matrices.
+#if MIOPEN_DT_NHWC
+#define A_K_FAST (MIOPEN_DT_DIR != 2)
+#define B_K_FAST (MIOPEN_DT_DIR == 0)
+#else
+#define A_K_FAST (MIOPEN_DT_DIR == 2)
+#define B_K_FAST 1
+#endif
+
+#define BK 16
+#define BLOCK_SIDE 16
+#define BLOCK (BLOCK_SIDE * BLOCK_SIDE)
+#define TM (MIOPEN_DT_TILE_M / BLOCK_SIDE)
+#define TN (MIOPEN_DT_TILE_N / BLOCK_SIDE)
+#define TILES_M ((GEMM_M + MIOPEN_DT_TILE_M - 1) / MIOPEN_DT_TILE_M)
+#define TILES_N ((GEMM_N + MIOPEN_DT_TILE_N - 1) / MIOPEN_DT_TILE_N)
+
+#define _FLOAT4 PPCAT(_FLOAT, FOUR)
+
+static inline int XIndex(uint n, uint c, uint pix)
+{
+#if MIOPEN_DT_NHWC
+    return (n * DT_IN_DHW + pix) * DT_C + c;
+#else
+    return (n * DT_C + c) * DT_IN_DHW + pix;
+#endif
+}
+
+static inline int YIndex(uint n, uint k, uint pix)
+{
+#if MIOPEN_DT_NHWC
+    return (n * DT_OUT_DHW + pix) * DT_K + k;
+#else
+    return (n * DT_K + k) * DT_OUT_DHW + pix;
+#endif
+}
+
+static inline int WIndex(uint k, uint c, uint tap)
+{
+#if MIOPEN_DT_NHWC
+    return (k * DT_ZYX + tap) * MIOPEN_DT_CG + c;
+#else
+    return (k * MIOPEN_DT_CG + c) * DT_ZYX + tap;
+#endif
+}
+
+// Splits an index over the filter taps of channels_ channels.
+static inline void SplitTaps(uint i, uint channels_, uint* channel, uint* tap)
+{
+#if MIOPEN_DT_NHWC
+    *channel = i % channels_;
+    *tap     = i / channels_;
+#else
+    *channel = i / DT_ZYX;
+    *tap     = i % DT_ZYX;
+#endif
+}
+
+// Input pixel read by the tap of the output pixel, or -1 out of the padded borders.
+static inline int InPixelOfTap(uint pix, uint tap)
+{
+    const uint x  = tap % MIOPEN_DT_FX;
+    const uint y  = (tap / MIOPEN_DT_FX) % MIOPEN_DT_FY;
+    const uint z  = tap / (MIOPEN_DT_FX * MIOPEN_DT_FY);
+    const uint wo = pix % MIOPEN_DT_WO;
+    const uint ho = (pix / MIOPEN_DT_WO) % MIOPEN_DT_HO;
+    const uint d  = pix / (MIOPEN_DT_WO * MIOPEN_DT_HO);
+    const int di  = (int)(d * MIOPEN_DT_SZ + z * MIOPEN_DT_DZ) - MIOPEN_DT_PZ;
+    const int hi  = (int)(ho * MIOPEN_DT_SY + y * MIOPEN_DT_DY) - MIOPEN_DT_PY;
+    const int wi  = (int)(wo * MIOPEN_DT_SX + x * MIOPEN_DT_DX) - MIOPEN_DT_PX;
+    if(di < 0 || di >= MIOPEN_DT_DI || hi < 0 || hi >= MIOPEN_DT_HI || wi < 0 ||
+       wi >= MIOPEN_DT_WI)
+        return -1;
+    return (di * MIOPEN_DT_HI + hi) * MIOPEN_DT_WI + wi;
+}
+
+#if MIOPEN_DT_DIR == 1
+// Output coordinate reached from input coordinate i by the tap t, or -1.
+static inline int OutCoord(int i, uint t, int s, int d, int p, int size)
+{
+    const int o = i + p - (int)t * d;
+    if(o < 0 || o % s != 0 || o / s >= size)
+        return -1;
+    return o / s;
+}
+
+// Output pixel which the tap of the input pixel contributes to, or -1.
+static inline int OutPixelOfTap(uint pix, uint tap)
+{
+    const uint x = tap % MIOPEN_DT_FX;
+    const uint y = (tap / MIOPEN_DT_FX) % MIOPEN_DT_FY;
+    const uint z = tap / (MIOPEN_DT_FX * MIOPEN_DT_FY);
+    const int wi = pix % MIOPEN_DT_WI;
+    const int hi = (pix / MIOPEN_DT_WI) % MIOPEN_DT_HI;
+    const int di = pix / (MIOPEN_DT_WI * MIOPEN_DT_HI);
+    const int d  = OutCoord(di, z, MIOPEN_DT_SZ, MIOPEN_DT_DZ, MIOPEN_DT_PZ, MIOPEN_DT_DO);
+    const int ho = OutCoord(hi, y, MIOPEN_DT_SY, MIOPEN_DT_DY, MIOPEN_DT_PY, MIOPEN_DT_HO);
+    const int wo = OutCoord(wi, x, MIOPEN_DT_SX, MIOPEN_DT_DX, MIOPEN_DT_PX, MIOPEN_DT_WO);
+    if(d < 0 || ho < 0 || wo < 0)
+        return -1;
+    return (d * MIOPEN_DT_HO + ho) * MIOPEN_DT_WO + wo;
+}
+#endif
+
+// Index of element (m, k) of the A matrix of group g, or -1 for a zero.
+static inline int IndexA(uint g, uint m, uint k)
+{
+    if(m >= GEMM_M || k >= GEMM_K)
+        return -1;
+#if MIOPEN_DT_DIR == 0
+    uint c, tap;
+    SplitTaps(k, MIOPEN_DT_CG, &c, &tap);
+    const int pix = InPixelOfTap(m % DT_OUT_DHW, tap);
+    return pix < 0 ? -1 : XIndex(m / DT_OUT_DHW, g * MIOPEN_DT_CG + c, pix);
+#elif MIOPEN_DT_DIR == 1
+    uint kk, tap;
+    SplitTaps(k, MIOPEN_DT_KG, &kk, &tap);
+    const int pix = OutPixelOfTap(m % DT_IN_DHW, tap);
+    return pix < 0 ? -1 : YIndex(m / DT_IN_DHW, g * MIOPEN_DT_KG + kk, pix);
+#else
+    return YIndex(k / DT_OUT_DHW, g * MIOPEN_DT_KG + m, k % DT_OUT_DHW);
+#endif
+}
+
+// Index of element (k, n) of the B matrix of group g, or -1 for a zero.
+static inline int IndexB(uint g, uint k, uint n)
+{
+    if(k >= GEMM_K || n >= GEMM_N)
+        return -1;
+#if MIOPEN_DT_DIR == 0
+    uint c, tap;
+    SplitTaps(k, MIOPEN_DT_CG, &c, &tap);
+    return WIndex(g * MIOPEN_DT_KG + n, c, tap);
+#elif MIOPEN_DT_DIR == 1
+    uint kk, tap;
+    SplitTaps(k, MIOPEN_DT_KG, &kk, &tap);
+    return WIndex(g * MIOPEN_DT_KG + kk, n, tap);
+#else
+    uint c, tap;
+    SplitTaps(n, MIOPEN_DT_CG, &c, &tap);
+    const int pix = InPixelOfTap(k % DT_OUT_DHW, tap);
+    return pix < 0 ? -1 : XIndex(k / DT_OUT_DHW, g * MIOPEN_DT_CG + c, pix);
+#endif
+}
+
+// Index of element (m, n) of the C matrix of group g.
+static inline int IndexC(uint g, uint m, uint n)
+{
+#if MIOPEN_DT_DIR == 0
+    return YIndex(m / DT_OUT_DHW, g * MIOPEN_DT_KG + n, m % DT_OUT_DHW);
+#elif MIOPEN_DT_DIR == 1
+    return XIndex(m / DT_IN_DHW, g * MIOPEN_DT_CG + n, m % DT_IN_DHW);
+#else
+    uint c, tap;
+    SplitTaps(n, MIOPEN_DT_CG, &c, &tap);
+    return WIndex(g * MIOPEN_DT_KG + m, c, tap);
+#endif
+}
+
+// Loads vec_ elements which start at index i, the host makes sure that they are contiguous.
+static inline void
+Load(const __global _FLOAT* __restrict p, int i, uint vec_, _FLOAT_ACCUM* __restrict v)
+{
+    if(i < 0)
+    {
+        for(uint j = 0; j < vec_; ++j)
+            v[j] = (_FLOAT_ACCUM)0;
+    }
+    else if(vec_ == 4)
+    {
+        const _FLOAT4 r = vload4(0, p + i);
+        v[0]            = CVT_FLOAT2ACCUM(r.x);
+        v[1]            = CVT_FLOAT2ACCUM(r.y);
+        v[2]            = CVT_FLOAT2ACCUM(r.z);
+        v[3]            = CVT_FLOAT2ACCUM(r.w);
+    }
+    else
+    {
+        v[0] = CVT_FLOAT2ACCUM(p[i]);
+    }
+}
+
+#if MIOPEN_DT_BN_STATS
+static inline void AtomicAdd(volatile __global float* p, float value)
+{
+    union
+    {
+        uint u;
+        float f;
+    } current, expected, next;
+
+    current.f = *p;
+    do
+    {
+        expected.f = current.f;
+        next.f     = current.f + value;
+        current.u  = atomic_cmpxchg((volatile __global uint*)p, expected.u, next.u);
+    } while(current.u != expected.u);
+}
+
+// The forward convolution of a fusion plan with a training batch normalization also adds up
+// the sums and the sums of squares of the output channels, for the statistics of the batch.
+#define DT_BN_STATS_PARAMS \
+    , __global float* __restrict bn_sum, __global float* __restrict bn_sqsum
+#else
+#define DT_BN_STATS_PARAMS
+#endif
+
+// The forward convolution of a fusion plan may apply elementwise ops to its output before it
+// stores it: y = activ(alpha1 * (conv(x, w) + bias) + alpha2 * residual). The residual has the
+// shape and the strides of y. Each op adds its arguments, in that order.
+#if MIOPEN_DT_BIAS
+#define DT_BIAS_PARAMS , const __global _FLOAT* __restrict bias
+#else
+#define DT_BIAS_PARAMS
+#endif
+#if MIOPEN_DT_RESIDUAL
+#define DT_RESIDUAL_PARAMS \
+    , const __global _FLOAT* __restrict residual, const float alpha1, const float alpha2
+#else
+#define DT_RESIDUAL_PARAMS
+#endif
+#if MIOPEN_DT_ACTIV
+#define _FLOAT_PREC _FLOAT_ACCUM
+#define UNUSED __attribute__((__unused__))
+#if MIOPEN_USE_FP16 == 1
+#define EPSILON (_FLOAT_ACCUM)0.0001
+#else
+#define EPSILON (_FLOAT_ACCUM)0.000001
+#endif
+#include "activation_functions.h"
+// There is no bfloat16 scalar type for the arguments, so they are passed as float.
+#if MIOPEN_USE_BFP16 == 1
+#define DT_ACTIV_ARG float
+#else
+#define DT_ACTIV_ARG _FLOAT
+#endif
+#define DT_ACTIV_PARAMS \
+    , const DT_ACTIV_ARG activ_alpha, const DT_ACTIV_ARG activ_beta, const DT_ACTIV_ARG activ_gamma
+#else
+#define DT_ACTIV_PARAMS
+#endif
+
+// The arguments follow the GEMM: a is x, dy and dy, b is w, w and x and c is y, dx and dw.
+__attribute__((reqd_work_group_size(BLOCK, 1, 1))) __kernel void
+MIOpenConvDirectTiled(const __global _FLOAT* __restrict a,
+                      const __global _FLOAT* __restrict b,
+                      __global _FLOAT* __restrict c DT_BN_STATS_PARAMS DT_BIAS_PARAMS
+                          DT_RESIDUAL_PARAMS DT_ACTIV_PARAMS)
+{
+    const uint lid = get_local_id(0);
+    const uint tx  = lid % BLOCK_SIDE;
+    const uint ty  = lid / BLOCK_SIDE;
+
+    uint wg       = get_group_id(0);
+    const uint n0 = (wg % TILES_N) * MIOPEN_DT_TILE_N;
+    wg /= TILES_N;
+    const uint m0 = (wg % TILES_M) * MIOPEN_DT_TILE_M;
+    const uint g  = wg / TILES_M;
+
+    __local _FLOAT_ACCUM lcl_a[BK][MIOPEN_DT_TILE_M];
+    __local _FLOAT_ACCUM lcl_b[BK][MIOPEN_DT_TILE_N];
+
+    _FLOAT_ACCUM acc[TM][TN];
+    for(uint i = 0; i < TM; ++i)
+        for(uint j = 0; j < TN; ++j)
+            acc[i][j] = (_FLOAT_ACCUM)0;
+
+    for(uint k0 = 0; k0 < GEMM_K; k0 += BK)
+    {
+        // The work-items go along the contiguous dimension of each matrix, a vector at a time.
+        for(uint i = lid * MIOPEN_DT_VEC_A; i < BK * MIOPEN_DT_TILE_M;
+            i += BLOCK * MIOPEN_DT_VEC_A)
+        {
+            _FLOAT_ACCUM v[MIOPEN_DT_VEC_A];
+#if A_K_FAST
+            const uint kk = i % BK;
+            const uint mm = i / BK;
+            Load(a, IndexA(g, m0 + mm, k0 + kk), MIOPEN_DT_VEC_A, v);
+            for(uint j = 0; j < MIOPEN_DT_VEC_A; ++j)
+                lcl_a[kk + j][mm] = v[j];
+#else
+            const uint kk = i / MIOPEN_DT_TILE_M;
+            const uint mm = i % MIOPEN_DT_TILE_M;
+            Load(a, IndexA(g, m0 + mm, k0 + kk), MIOPEN_DT_VEC_A, v);
+            for(uint j = 0; j < MIOPEN_DT_VEC_A; ++j)
+                lcl_a[kk][mm + j] = v[j];
+#endif
+        }
+        for(uint i = lid * MIOPEN_DT_VEC_B; i < BK * MIOPEN_DT_TILE_N;
+            i += BLOCK * MIOPEN_DT_VEC_B)
+        {
+            _FLOAT_ACCUM v[MIOPEN_DT_VEC_B];
+#if B_K_FAST
+            const uint kk = i % BK;
+            const uint nn = i / BK;
+            Load(b, IndexB(g, k0 + kk, n0 + nn), MIOPEN_DT_VEC_B, v);
+            for(uint j = 0; j < MIOPEN_DT_VEC_B; ++j)
+                lcl_b[kk + j][nn] = v[j];
+#else
+            const uint kk = i / MIOPEN_DT_TILE_N;
+            const uint nn = i % MIOPEN_DT_TILE_N;
+            Load(b, IndexB(g, k0 + kk, n0 + nn), MIOPEN_DT_VEC_B, v);
+            for(uint j = 0; j < MIOPEN_DT_VEC_B; ++j)
+                lcl_b[kk][nn + j] = v[j];
+#endif
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint kk = 0; kk < BK; ++kk)
+        {
+            _FLOAT_ACCUM ra[TM], rb[TN];
+            for(uint i = 0; i < TM; ++i)
+                ra[i] = lcl_a[kk][ty + i * BLOCK_SIDE];
+            for(uint j = 0; j < TN; ++j)
+                rb[j] = lcl_b[kk][tx + j * BLOCK_SIDE];
+            for(uint i = 0; i < TM; ++i)
+                for(uint j = 0; j < TN; ++j)
+                    acc[i][j] += ra[i] * rb[j];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    for(uint i = 0; i < TM; ++i)
+    {
+        const uint m = m0 + ty + i * BLOCK_SIDE;
+        if(m >= GEMM_M)
+            continue;
+        for(uint j = 0; j < TN; ++j)
+        {
+            const uint n = n0 + tx + j * BLOCK_SIDE;
+            if(n >= GEMM_N)
+                continue;
+            const int idx  = IndexC(g, m, n);
+            _FLOAT_ACCUM v = acc[i][j];
+#if MIOPEN_DT_BIAS
+            v += CVT_FLOAT2ACCUM(bias[g * MIOPEN_DT_KG + n]);
+#endif
+#if MIOPEN_DT_RESIDUAL
+            v = alpha1 * v + alpha2 * CVT_FLOAT2ACCUM(residual[idx]);
+#endif
+#if MIOPEN_DT_ACTIV
+            const _FLOAT_ACCUM pre = v;
+            ActivationFunction(1,
+                               &v,
+                               &pre,
+                               (_FLOAT_ACCUM)activ_gamma,
+                               (_FLOAT_ACCUM)activ_beta,
+                               (_FLOAT_ACCUM)activ_alpha);
+#endif
+            c[idx] = CVT_ACCUM2FLOAT(v);
+        }
+    }
+
+#if MIOPEN_DT_BN_STATS && MIOPEN_DT_DIR == 0
+    // The work-items of a tile column add up their rows in LDS, then the first one adds the
+    // column to the sums of its output channel. The values are the stored ones.
+    __local float lcl_sum[BLOCK];
+    __local float lcl_sqsum[BLOCK];
+    for(uint j = 0; j < TN; ++j)
+    {
+        const uint n = n0 + tx + j * BLOCK_SIDE;
+        float sum    = 0;
+        float sqsum  = 0;
+        for(uint i = 0; i < TM; ++i)
+        {
+            const uint m = m0 + ty + i * BLOCK_SIDE;
+            if(m < GEMM_M && n < GEMM_N)
+            {
+                const float v = (float)CVT_ACCUM2FLOAT(acc[i][j]);
+                sum += v;
+                sqsum += v * v;
+            }
+        }
+        lcl_sum[lid]   = sum;
+        lcl_sqsum[lid] = sqsum;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        if(ty == 0 && n < GEMM_N)
+        {
+            for(uint r = 1; r < BLOCK_SIDE; ++r)
+            {
+                sum += lcl_sum[r * BLOCK_SIDE + tx];
+                sqsum += lcl_sqsum[r * BLOCK_SIDE + tx];
+            }
+            AtomicAdd(bn_sum + g * MIOPEN_DT_KG + n, sum);
+            AtomicAdd(bn_sqsum + g * MIOPEN_DT_KG + n, sqsum);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+#endif
+}
@@ -4032,6 +4032,7 @@ MIOpenConvFFT_inv_out(__global const float2* restrict gbIn, __global float* rest
 /* kernel */
 __attribute__((reqd_work_group_size(WG_0I, WG_1J, 1))) __kernel void
 MIOpenConvFFT_cgemm(__global float2* gb,
+                    __global const float2* gbA,
                     unsigned int const offsetC,
                     unsigned int const offsetA,
                     unsigned int const offsetB,
@@ -4049,7 +4050,7 @@ MIOpenConvFFT_cgemm(__global float2* gb,
 
     /* apply offsets */
     __global float2* C       = gb + offsetC;
-    __global float2 const* A = gb + offsetA;
+    __global float2 const* A = gbA + offsetA;
     __global float2 const* B = gb + offsetB;
 
     /* allocate registers */
@@ -4509,6 +4510,7 @@ MIOpenConvFFT_cgemm(__global float2* gb,
 /****************************************/
 __attribute__((reqd_work_group_size(NUM_THREADS, 1, 1))) __kernel void
 MIOpenConvFFT_cgemm(__global float2* gb,
+                    __global const float2* gbA,
                     unsigned int const offsetC,
                     unsigned int const offsetA,
                     unsigned int const offsetB,
@@ -4526,7 +4528,7 @@ MIOpenConvFFT_cgemm(__global float2* gb,
 
     /* apply offsets */
     __global float2* C       = gb + offsetC;
-    __global float2 const* A = gb + offsetA;
+    __global float2 const* A = gbA + offsetA;
     __global float2 const* B = gb + offsetB;
 
     /***************************************/
@@ -5073,6 +5075,7 @@ MIOpenConvFFT_cgemm(__global float2* gb,
 /******************************************/
 __attribute__((reqd_work_group_size(NUM_THREADS, 1, 1))) __kernel void
 MIOpenConvFFT_cgemm(__global float2* gb,
+                    __global const float2* gbA,
                     unsigned int const offsetC,
                     unsigned int const offsetA,
                     unsigned int const offsetB,
@@ -5090,7 +5093,7 @@ MIOpenConvFFT_cgemm(__global float2* gb,
 
     /* apply offsets */
     __global float2* C       = gb + offsetC;
-    __global float2 const* A = gb + offsetA;
+    __global float2 const* A = gbA + offsetA;
     __global float2 const* B = gb + offsetB;
 
     /******************************************/
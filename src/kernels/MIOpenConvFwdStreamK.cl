@@ -0,0 +1,253 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+// Forward 2D convolution as a stream-K implicit GEMM. M is the output pixels, N the output
+// channels of a group and K is Cg*Y*X. The BK-wide iterations of all the output tiles form a
+// single range, which MIOPEN_SKF_GRID persistent work-groups split evenly, so that no compute
+// unit idles on the last wave of tiles. A work-group writes the tiles it computes completely to
+// y, and the partial sums of the tiles it shares with its neighbours to its two workspace slots,
+// the first for the tile it starts in and the second one for the tile it ends in.
+// MIOpenConvFwdStreamKFixup then adds the partial sums of each shared tile in order.
+
+#define SKF_C (MIOPEN_SKF_G * MIOPEN_SKF_CG)
+#define SKF_K (MIOPEN_SKF_G * MIOPEN_SKF_KG)
+#define SKF_YX (MIOPEN_SKF_FY * MIOPEN_SKF_FX)
+
+#define GEMM_M (MIOPEN_SKF_N * MIOPEN_SKF_HO * MIOPEN_SKF_WO)
+#define GEMM_N MIOPEN_SKF_KG
+#define GEMM_K (MIOPEN_SKF_CG * SKF_YX)
+
+#define BK 16
+#define BLOCK_SIDE 16
+#define BLOCK (BLOCK_SIDE * BLOCK_SIDE)
+#define TILE MIOPEN_SKF_TILE
+#define TT (TILE / BLOCK_SIDE)
+#define TILES_M ((GEMM_M + TILE - 1) / TILE)
+#define TILES_N ((GEMM_N + TILE - 1) / TILE)
+#define TILES (TILES_M * TILES_N * MIOPEN_SKF_G)
+
+#define ITERS_PER_TILE ((GEMM_K + BK - 1) / BK)
+#define TOTAL_ITERS (TILES * ITERS_PER_TILE)
+#define ITERS_PER_WG (TOTAL_ITERS / MIOPEN_SKF_GRID)
+#define EXTRA_ITERS (TOTAL_ITERS % MIOPEN_SKF_GRID)
+
+// The first EXTRA_ITERS work-groups take an iteration more than the others.
+static inline uint IterBegin(uint wg)
+{
+    return wg * ITERS_PER_WG + (wg < EXTRA_ITERS ? wg : EXTRA_ITERS);
+}
+
+static inline uint WgOfIter(uint iter)
+{
+    const uint long_part = EXTRA_ITERS * (ITERS_PER_WG + 1);
+    if(iter < long_part)
+        return iter / (ITERS_PER_WG + 1);
+    return EXTRA_ITERS + (iter - long_part) / ITERS_PER_WG;
+}
+
+static inline uint Slot(uint wg, uint tile)
+{
+    return tile == IterBegin(wg) / ITERS_PER_TILE ? 0 : 1;
+}
+
+// Element (m, k) of the x matrix of group g.
+static inline _FLOAT_ACCUM LoadA(const __global _FLOAT* x, uint g, uint m, uint k)
+{
+    if(m >= GEMM_M || k >= GEMM_K)
+        return (_FLOAT_ACCUM)0;
+#if MIOPEN_SKF_NHWC
+    const uint c   = k % MIOPEN_SKF_CG;
+    const uint tap = k / MIOPEN_SKF_CG;
+#else
+    const uint c   = k / SKF_YX;
+    const uint tap = k % SKF_YX;
+#endif
+    const uint wo = m % MIOPEN_SKF_WO;
+    const uint ho = (m / MIOPEN_SKF_WO) % MIOPEN_SKF_HO;
+    const uint n  = m / (MIOPEN_SKF_WO * MIOPEN_SKF_HO);
+    const int hi =
+        (int)(ho * MIOPEN_SKF_SY + (tap / MIOPEN_SKF_FX) * MIOPEN_SKF_DY) - MIOPEN_SKF_PY;
+    const int wi =
+        (int)(wo * MIOPEN_SKF_SX + (tap % MIOPEN_SKF_FX) * MIOPEN_SKF_DX) - MIOPEN_SKF_PX;
+    if(hi < 0 || hi >= MIOPEN_SKF_HI || wi < 0 || wi >= MIOPEN_SKF_WI)
+        return (_FLOAT_ACCUM)0;
+#if MIOPEN_SKF_NHWC
+    return CVT_FLOAT2ACCUM(
+        x[((n * MIOPEN_SKF_HI + hi) * MIOPEN_SKF_WI + wi) * SKF_C + g * MIOPEN_SKF_CG + c]);
+#else
+    return CVT_FLOAT2ACCUM(
+        x[((n * SKF_C + g * MIOPEN_SKF_CG + c) * MIOPEN_SKF_HI + hi) * MIOPEN_SKF_WI + wi]);
+#endif
+}
+
+// Element (k, n) of the w matrix of group g, the filters are contiguous along K in both layouts.
+static inline _FLOAT_ACCUM LoadB(const __global _FLOAT* w, uint g, uint k, uint n)
+{
+    if(k >= GEMM_K || n >= GEMM_N)
+        return (_FLOAT_ACCUM)0;
+    return CVT_FLOAT2ACCUM(w[(g * MIOPEN_SKF_KG + n) * GEMM_K + k]);
+}
+
+// Index of element (m, n) of the y matrix of group g.
+static inline uint IndexC(uint g, uint m, uint n)
+{
+#if MIOPEN_SKF_NHWC
+    return m * SKF_K + g * MIOPEN_SKF_KG + n;
+#else
+    const uint pixels = MIOPEN_SKF_HO * MIOPEN_SKF_WO;
+    return ((m / pixels) * SKF_K + g * MIOPEN_SKF_KG + n) * pixels + m % pixels;
+#endif
+}
+
+static inline void DecomposeTile(uint tile, uint* g, uint* m0, uint* n0)
+{
+    *n0 = (tile % TILES_N) * TILE;
+    tile /= TILES_N;
+    *m0 = (tile % TILES_M) * TILE;
+    *g  = tile / TILES_M;
+}
+
+__attribute__((reqd_work_group_size(BLOCK, 1, 1))) __kernel void
+MIOpenConvFwdStreamK(const __global _FLOAT* __restrict x,
+                     const __global _FLOAT* __restrict w,
+                     __global _FLOAT* __restrict y,
+                     __global _FLOAT_ACCUM* __restrict partials)
+{
+    const uint lid = get_local_id(0);
+    const uint tx  = lid % BLOCK_SIDE;
+    const uint ty  = lid / BLOCK_SIDE;
+    const uint wg  = get_group_id(0);
+    const uint end = IterBegin(wg + 1);
+
+    __local _FLOAT_ACCUM lcl_a[BK][TILE];
+    __local _FLOAT_ACCUM lcl_b[BK][TILE];
+
+    for(uint iter = IterBegin(wg); iter < end;)
+    {
+        const uint tile       = iter / ITERS_PER_TILE;
+        const uint tile_begin = tile * ITERS_PER_TILE;
+        const uint tile_end   = tile_begin + ITERS_PER_TILE;
+        const uint seg_end    = end < tile_end ? end : tile_end;
+
+        uint g, m0, n0;
+        DecomposeTile(tile, &g, &m0, &n0);
+
+        _FLOAT_ACCUM acc[TT][TT];
+        for(uint i = 0; i < TT; ++i)
+            for(uint j = 0; j < TT; ++j)
+                acc[i][j] = (_FLOAT_ACCUM)0;
+
+        for(uint it = iter; it < seg_end; ++it)
+        {
+            const uint k0 = (it - tile_begin) * BK;
+            for(uint i = lid; i < BK * TILE; i += BLOCK)
+            {
+#if MIOPEN_SKF_NHWC
+                const uint kk = i % BK;
+                const uint mm = i / BK;
+#else
+                const uint kk = i / TILE;
+                const uint mm = i % TILE;
+#endif
+                lcl_a[kk][mm] = LoadA(x, g, m0 + mm, k0 + kk);
+            }
+            for(uint i = lid; i < BK * TILE; i += BLOCK)
+            {
+                const uint kk = i % BK;
+                const uint nn = i / BK;
+                lcl_b[kk][nn] = LoadB(w, g, k0 + kk, n0 + nn);
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            for(uint kk = 0; kk < BK; ++kk)
+            {
+                _FLOAT_ACCUM ra[TT], rb[TT];
+                for(uint i = 0; i < TT; ++i)
+                {
+                    ra[i] = lcl_a[kk][ty + i * BLOCK_SIDE];
+                    rb[i] = lcl_b[kk][tx + i * BLOCK_SIDE];
+                }
+                for(uint i = 0; i < TT; ++i)
+                    for(uint j = 0; j < TT; ++j)
+                        acc[i][j] += ra[i] * rb[j];
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if(iter == tile_begin && seg_end == tile_end)
+        {
+            for(uint i = 0; i < TT; ++i)
+            {
+                const uint m = m0 + ty + i * BLOCK_SIDE;
+                if(m >= GEMM_M)
+                    continue;
+                for(uint j = 0; j < TT; ++j)
+                {
+                    const uint n = n0 + tx + j * BLOCK_SIDE;
+                    if(n < GEMM_N)
+                        y[IndexC(g, m, n)] = CVT_ACCUM2FLOAT(acc[i][j]);
+                }
+            }
+        }
+        else
+        {
+            __global _FLOAT_ACCUM* slot = partials + (wg * 2 + Slot(wg, tile)) * (TILE * TILE);
+            for(uint i = 0; i < TT; ++i)
+                for(uint j = 0; j < TT; ++j)
+                    slot[(ty + i * BLOCK_SIDE) * TILE + tx + j * BLOCK_SIDE] = acc[i][j];
+        }
+
+        iter = seg_end;
+    }
+}
+
+// A work-group per tile, the tiles which a single work-group has computed are already done.
+__attribute__((reqd_work_group_size(BLOCK, 1, 1))) __kernel void
+MIOpenConvFwdStreamKFixup(const __global _FLOAT_ACCUM* __restrict partials,
+                          __global _FLOAT* __restrict y)
+{
+    const uint tile  = get_group_id(0);
+    const uint wg_lo = WgOfIter(tile * ITERS_PER_TILE);
+    const uint wg_hi = WgOfIter((tile + 1) * ITERS_PER_TILE - 1);
+    if(wg_lo == wg_hi)
+        return;
+
+    uint g, m0, n0;
+    DecomposeTile(tile, &g, &m0, &n0);
+
+    for(uint i = get_local_id(0); i < TILE * TILE; i += BLOCK)
+    {
+        const uint m = m0 + i / TILE;
+        const uint n = n0 + i % TILE;
+        if(m >= GEMM_M || n >= GEMM_N)
+            continue;
+        _FLOAT_ACCUM sum = (_FLOAT_ACCUM)0;
+        for(uint wg = wg_lo; wg <= wg_hi; ++wg)
+            sum += partials[(wg * 2 + Slot(wg, tile)) * (TILE * TILE) + i];
+        y[IndexC(g, m, n)] = CVT_ACCUM2FLOAT(sum);
+    }
+}
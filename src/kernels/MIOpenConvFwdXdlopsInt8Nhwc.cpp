@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <hip/hip_runtime.h>
+#include <stdint.h>
+
+// Forward int8 convolution of NHWC inputs and KYXC filters as an implicit GEMM on the xdlops
+// (matrix core) instructions, accumulating in int32. GEMM M is the output pixels of the batch,
+// GEMM N the output channels of a group and GEMM K the filter elements (y, x, c) with c the
+// fastest, which is contiguous in both the input and the filters. Four int8 of K are packed in
+// a dword, so that the channels of a group must be a multiple of 4.
+//
+// A work-group of 4 waves computes a MIOPEN_I8_BM x MIOPEN_I8_BN tile, each wave a quarter of
+// it with 16x16x16 MFMA blocks.
+
+#if MIOPEN_I8_OUT_FLOAT
+#define OUT_TYPE float
+#else
+#define OUT_TYPE int
+#endif
+
+typedef int int32x4_t __attribute__((ext_vector_type(4)));
+
+#define I8_C (MIOPEN_I8_G * MIOPEN_I8_CG)
+#define I8_K (MIOPEN_I8_G * MIOPEN_I8_KG)
+#define I8_M (MIOPEN_I8_N * MIOPEN_I8_HO * MIOPEN_I8_WO)
+// Dwords of the GEMM K dimension.
+#define I8_KD_TOTAL (MIOPEN_I8_FY * MIOPEN_I8_FX * MIOPEN_I8_CG / 4)
+
+#define WAVE 64
+#define BLOCK 256
+#define MFMA 16
+// Dwords of the GEMM K dimension staged in LDS per step.
+#define KD 16
+#define WM (MIOPEN_I8_BM / 2)
+#define WN (MIOPEN_I8_BN / 2)
+#define RM (WM / MFMA)
+#define RN (WN / MFMA)
+#define TILES_M ((I8_M + MIOPEN_I8_BM - 1) / MIOPEN_I8_BM)
+#define TILES_N ((MIOPEN_I8_KG + MIOPEN_I8_BN - 1) / MIOPEN_I8_BN)
+
+extern "C" __global__ void __launch_bounds__(BLOCK)
+    MIOpenConvFwdXdlopsInt8Nhwc(const int8_t* __restrict__ p_in,
+                                const int8_t* __restrict__ p_wei,
+                                OUT_TYPE* __restrict__ p_out)
+{
+    // The padding avoids the bank conflicts of the stores, which go along K.
+    __shared__ int lds_a[KD][MIOPEN_I8_BM + 1];
+    __shared__ int lds_b[KD][MIOPEN_I8_BN + 1];
+
+    const int* in  = reinterpret_cast<const int*>(p_in);
+    const int* wei = reinterpret_cast<const int*>(p_wei);
+
+    const unsigned tid    = threadIdx.x;
+    const unsigned lane   = tid % WAVE;
+    const unsigned wave   = tid / WAVE;
+    const unsigned wave_m = (wave % 2) * WM;
+    const unsigned wave_n = (wave / 2) * WN;
+
+    unsigned bid      = blockIdx.x;
+    const unsigned n0 = (bid % TILES_N) * MIOPEN_I8_BN;
+    bid /= TILES_N;
+    const unsigned m0 = (bid % TILES_M) * MIOPEN_I8_BM;
+    const unsigned g  = bid / TILES_M;
+
+    int32x4_t acc[RM][RN];
+    for(unsigned i = 0; i < RM; ++i)
+        for(unsigned j = 0; j < RN; ++j)
+            for(unsigned r = 0; r < 4; ++r)
+                acc[i][j][r] = 0;
+
+    for(unsigned kd0 = 0; kd0 < I8_KD_TOTAL; kd0 += KD)
+    {
+        for(unsigned i = tid; i < KD * MIOPEN_I8_BM; i += BLOCK)
+        {
+            const unsigned kd = i % KD;
+            const unsigned mm = i / KD;
+            const unsigned m  = m0 + mm;
+            const unsigned k  = kd0 + kd;
+            const unsigned wo = m % MIOPEN_I8_WO;
+            const unsigned ho = (m / MIOPEN_I8_WO) % MIOPEN_I8_HO;
+            const unsigned n  = m / (MIOPEN_I8_WO * MIOPEN_I8_HO);
+            const unsigned cd = k % (MIOPEN_I8_CG / 4);
+            const unsigned fx = (k / (MIOPEN_I8_CG / 4)) % MIOPEN_I8_FX;
+            const unsigned fy = k / (MIOPEN_I8_CG / 4 * MIOPEN_I8_FX);
+            const int hi      = (int)(ho * MIOPEN_I8_SY + fy * MIOPEN_I8_DY) - MIOPEN_I8_PY;
+            const int wi      = (int)(wo * MIOPEN_I8_SX + fx * MIOPEN_I8_DX) - MIOPEN_I8_PX;
+            const bool valid  = m < I8_M && k < I8_KD_TOTAL && hi >= 0 && hi < MIOPEN_I8_HI &&
+                               wi >= 0 && wi < MIOPEN_I8_WI;
+            lds_a[kd][mm] =
+                valid ? in[(((n * MIOPEN_I8_HI + hi) * MIOPEN_I8_WI + wi) * I8_C +
+                            g * MIOPEN_I8_CG) / 4 + cd]
+                      : 0;
+        }
+        for(unsigned i = tid; i < KD * MIOPEN_I8_BN; i += BLOCK)
+        {
+            const unsigned kd = i % KD;
+            const unsigned nn = i / KD;
+            const unsigned k  = kd0 + kd;
+            const unsigned kn = n0 + nn;
+            lds_b[kd][nn] = kn < MIOPEN_I8_KG && k < I8_KD_TOTAL
+                                ? wei[(g * MIOPEN_I8_KG + kn) * I8_KD_TOTAL + k]
+                                : 0;
+        }
+        __syncthreads();
+
+        // A lane provides the 4 int8 of K (lane / 16) of row or column (lane % 16) of a block.
+        for(unsigned kk = 0; kk < KD; kk += 4)
+        {
+            int a[RM], b[RN];
+            for(unsigned i = 0; i < RM; ++i)
+                a[i] = lds_a[kk + lane / MFMA][wave_m + i * MFMA + lane % MFMA];
+            for(unsigned j = 0; j < RN; ++j)
+                b[j] = lds_b[kk + lane / MFMA][wave_n + j * MFMA + lane % MFMA];
+            for(unsigned i = 0; i < RM; ++i)
+                for(unsigned j = 0; j < RN; ++j)
+                    acc[i][j] =
+                        __builtin_amdgcn_mfma_i32_16x16x16i8(a[i], b[j], acc[i][j], 0, 0, 0);
+        }
+        __syncthreads();
+    }
+
+    // Accumulator r of a lane is row 4 * (lane / 16) + r and column lane % 16 of its block,
+    // so that 16 neighbouring lanes store neighbouring output channels.
+    for(unsigned i = 0; i < RM; ++i)
+    {
+        for(unsigned j = 0; j < RN; ++j)
+        {
+            const unsigned kn = n0 + wave_n + j * MFMA + lane % MFMA;
+            if(kn >= MIOPEN_I8_KG)
+                continue;
+            for(unsigned r = 0; r < 4; ++r)
+            {
+                const unsigned m = m0 + wave_m + i * MFMA + 4 * (lane / MFMA) + r;
+                if(m < I8_M)
+                    p_out[m * I8_K + g * MIOPEN_I8_KG + kn] = (OUT_TYPE)acc[i][j][r];
+            }
+        }
+    }
+}
@@ -0,0 +1,359 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+// 3D convolutions on NDHWC tensors and KZYXC filters as implicit GEMMs, a pass per
+// MIOPEN_IG3D_DIR. The GEMM K dimension steps through the filter taps with the channels being
+// the fastest, so that a tap reads contiguous channels of a pixel.
+// - Forward (0): M is the output pixels, N the output channels of a group, K is Z*Y*X*Cg.
+// - Backward data (1): M is the input pixels, N the input channels of a group, K is Z*Y*X*Kg.
+//   The taps which do not hit an output pixel because of the strides read zeros.
+// - Backward weights (2): M is the output channels of a group, N is Z*Y*X*Cg, K is the output
+//   pixels of the batch.
+// - Backward data by sub-pixel phases (3): the input pixels i = i0 + s * q of a phase are only
+//   hit by the taps t = r + s * j, so each phase is a GEMM as (1) with these taps alone. M is the
+//   q of a phase, N the input channels of a group and K is the taps of a phase times Kg. The
+//   phases with fewer taps or pixels than the others read zeros and skip the writes. 2D problems
+//   have D = FZ = SZ = 1.
+
+#define IG3D_C (MIOPEN_IG3D_G * MIOPEN_IG3D_CG)
+#define IG3D_K (MIOPEN_IG3D_G * MIOPEN_IG3D_KG)
+#define IG3D_ZYX (MIOPEN_IG3D_FZ * MIOPEN_IG3D_FY * MIOPEN_IG3D_FX)
+#define IG3D_ZYXC (IG3D_ZYX * MIOPEN_IG3D_CG)
+#define IG3D_IN_PIXELS (MIOPEN_IG3D_N * MIOPEN_IG3D_DI * MIOPEN_IG3D_HI * MIOPEN_IG3D_WI)
+#define IG3D_OUT_PIXELS (MIOPEN_IG3D_N * MIOPEN_IG3D_DO * MIOPEN_IG3D_HO * MIOPEN_IG3D_WO)
+
+#if MIOPEN_IG3D_DIR == 0
+#define GEMM_M IG3D_OUT_PIXELS
+#define GEMM_N MIOPEN_IG3D_KG
+#define GEMM_K IG3D_ZYXC
+#elif MIOPEN_IG3D_DIR == 1
+#define GEMM_M IG3D_IN_PIXELS
+#define GEMM_N MIOPEN_IG3D_CG
+#define GEMM_K (IG3D_ZYX * MIOPEN_IG3D_KG)
+#elif MIOPEN_IG3D_DIR == 2
+#define GEMM_M MIOPEN_IG3D_KG
+#define GEMM_N IG3D_ZYXC
+#define GEMM_K IG3D_OUT_PIXELS
+#else
+#define IG3D_QD ((MIOPEN_IG3D_DI + MIOPEN_IG3D_SZ - 1) / MIOPEN_IG3D_SZ)
+#define IG3D_QH ((MIOPEN_IG3D_HI + MIOPEN_IG3D_SY - 1) / MIOPEN_IG3D_SY)
+#define IG3D_QW ((MIOPEN_IG3D_WI + MIOPEN_IG3D_SX - 1) / MIOPEN_IG3D_SX)
+#define IG3D_TZ ((MIOPEN_IG3D_FZ + MIOPEN_IG3D_SZ - 1) / MIOPEN_IG3D_SZ)
+#define IG3D_TY ((MIOPEN_IG3D_FY + MIOPEN_IG3D_SY - 1) / MIOPEN_IG3D_SY)
+#define IG3D_TX ((MIOPEN_IG3D_FX + MIOPEN_IG3D_SX - 1) / MIOPEN_IG3D_SX)
+#define GEMM_M (MIOPEN_IG3D_N * IG3D_QD * IG3D_QH * IG3D_QW)
+#define GEMM_N MIOPEN_IG3D_CG
+#define GEMM_K (IG3D_TZ * IG3D_TY * IG3D_TX * MIOPEN_IG3D_KG)
+#define PHASES (MIOPEN_IG3D_SZ * MIOPEN_IG3D_SY * MIOPEN_IG3D_SX)
+#endif
+
+#define BK 16
+#define BLOCK_SIDE 16
+#define BLOCK (BLOCK_SIDE * BLOCK_SIDE)
+#define TM (MIOPEN_IG3D_TILE_M / BLOCK_SIDE)
+#define TN (MIOPEN_IG3D_TILE_N / BLOCK_SIDE)
+#define TILES_M ((GEMM_M + MIOPEN_IG3D_TILE_M - 1) / MIOPEN_IG3D_TILE_M)
+#define TILES_N ((GEMM_N + MIOPEN_IG3D_TILE_N - 1) / MIOPEN_IG3D_TILE_N)
+
+// Pixel of the input tensor, or -1 out of the padded borders.
+static inline int InPixel(uint n, int di, int hi, int wi)
+{
+    if(di < 0 || di >= MIOPEN_IG3D_DI || hi < 0 || hi >= MIOPEN_IG3D_HI || wi < 0 ||
+       wi >= MIOPEN_IG3D_WI)
+        return -1;
+    return (((int)n * MIOPEN_IG3D_DI + di) * MIOPEN_IG3D_HI + hi) * MIOPEN_IG3D_WI + wi;
+}
+
+// Input pixel read by the tap (z, y, x) of output pixel p.
+static inline int InPixelOfTap(uint p, uint z, uint y, uint x)
+{
+    const uint wo = p % MIOPEN_IG3D_WO;
+    const uint ho = (p / MIOPEN_IG3D_WO) % MIOPEN_IG3D_HO;
+    const uint d  = (p / (MIOPEN_IG3D_WO * MIOPEN_IG3D_HO)) % MIOPEN_IG3D_DO;
+    const uint n  = p / (MIOPEN_IG3D_WO * MIOPEN_IG3D_HO * MIOPEN_IG3D_DO);
+    return InPixel(n,
+                   (int)(d * MIOPEN_IG3D_SZ + z * MIOPEN_IG3D_DZ) - MIOPEN_IG3D_PZ,
+                   (int)(ho * MIOPEN_IG3D_SY + y * MIOPEN_IG3D_DY) - MIOPEN_IG3D_PY,
+                   (int)(wo * MIOPEN_IG3D_SX + x * MIOPEN_IG3D_DX) - MIOPEN_IG3D_PX);
+}
+
+#if MIOPEN_IG3D_DIR == 1
+// Output coordinate reached from input coordinate i by the tap t, or -1.
+static inline int OutCoord(int i, uint t, int s, int d, int p, int size)
+{
+    const int o = i + p - (int)t * d;
+    if(o < 0 || o % s != 0 || o / s >= size)
+        return -1;
+    return o / s;
+}
+
+// Output pixel which the tap (z, y, x) of input pixel p contributes to, or -1.
+static inline int OutPixelOfTap(uint p, uint z, uint y, uint x)
+{
+    const int wi = p % MIOPEN_IG3D_WI;
+    const int hi = (p / MIOPEN_IG3D_WI) % MIOPEN_IG3D_HI;
+    const int di = (p / (MIOPEN_IG3D_WI * MIOPEN_IG3D_HI)) % MIOPEN_IG3D_DI;
+    const int n  = p / (MIOPEN_IG3D_WI * MIOPEN_IG3D_HI * MIOPEN_IG3D_DI);
+    const int d  = OutCoord(di, z, MIOPEN_IG3D_SZ, MIOPEN_IG3D_DZ, MIOPEN_IG3D_PZ, MIOPEN_IG3D_DO);
+    const int ho = OutCoord(hi, y, MIOPEN_IG3D_SY, MIOPEN_IG3D_DY, MIOPEN_IG3D_PY, MIOPEN_IG3D_HO);
+    const int wo = OutCoord(wi, x, MIOPEN_IG3D_SX, MIOPEN_IG3D_DX, MIOPEN_IG3D_PX, MIOPEN_IG3D_WO);
+    if(d < 0 || ho < 0 || wo < 0)
+        return -1;
+    return ((n * MIOPEN_IG3D_DO + d) * MIOPEN_IG3D_HO + ho) * MIOPEN_IG3D_WO + wo;
+}
+#endif
+
+#if MIOPEN_IG3D_DIR == 3
+// Phase r of a dimension: the first input coordinate i0 of the phase, and e = (i0 + p - r) / s
+// such that the tap r + s * j of the input coordinate i0 + s * q reads the output e + q - j * d.
+// The dilation is 1 wherever the stride is not.
+static inline int PhaseFirst(int r, int s, int p) { return ((r - p) % s + s) % s; }
+static inline int PhaseShift(int r, int s, int p) { return (PhaseFirst(r, s, p) + p - r) / s; }
+
+static inline uint PhaseZ(uint ph) { return ph / (MIOPEN_IG3D_SY * MIOPEN_IG3D_SX); }
+static inline uint PhaseY(uint ph) { return (ph / MIOPEN_IG3D_SX) % MIOPEN_IG3D_SY; }
+static inline uint PhaseX(uint ph) { return ph % MIOPEN_IG3D_SX; }
+
+// Input pixel q of phase ph, or -1 past the borders.
+static inline int InPixelOfPhase(uint ph, uint q)
+{
+    const uint qw = q % IG3D_QW;
+    const uint qh = (q / IG3D_QW) % IG3D_QH;
+    const uint qd = (q / (IG3D_QW * IG3D_QH)) % IG3D_QD;
+    const uint n  = q / (IG3D_QW * IG3D_QH * IG3D_QD);
+    return InPixel(n,
+                   PhaseFirst(PhaseZ(ph), MIOPEN_IG3D_SZ, MIOPEN_IG3D_PZ) + qd * MIOPEN_IG3D_SZ,
+                   PhaseFirst(PhaseY(ph), MIOPEN_IG3D_SY, MIOPEN_IG3D_PY) + qh * MIOPEN_IG3D_SY,
+                   PhaseFirst(PhaseX(ph), MIOPEN_IG3D_SX, MIOPEN_IG3D_PX) + qw * MIOPEN_IG3D_SX);
+}
+
+// Output coordinate read by the tap j of the phase coordinate q, or -1.
+static inline int PhaseOutCoord(int q, int j, int r, int s, int d, int p, int size)
+{
+    const int o = PhaseShift(r, s, p) + q - j * d;
+    return o < 0 || o >= size ? -1 : o;
+}
+
+// Output pixel read by the tap (jz, jy, jx) of the input pixel q of phase ph, or -1.
+static inline int OutPixelOfPhaseTap(uint ph, uint q, uint jz, uint jy, uint jx)
+{
+    const int qw = q % IG3D_QW;
+    const int qh = (q / IG3D_QW) % IG3D_QH;
+    const int qd = (q / (IG3D_QW * IG3D_QH)) % IG3D_QD;
+    const int n  = q / (IG3D_QW * IG3D_QH * IG3D_QD);
+    const int d  = PhaseOutCoord(
+        qd, jz, PhaseZ(ph), MIOPEN_IG3D_SZ, MIOPEN_IG3D_DZ, MIOPEN_IG3D_PZ, MIOPEN_IG3D_DO);
+    const int ho = PhaseOutCoord(
+        qh, jy, PhaseY(ph), MIOPEN_IG3D_SY, MIOPEN_IG3D_DY, MIOPEN_IG3D_PY, MIOPEN_IG3D_HO);
+    const int wo = PhaseOutCoord(
+        qw, jx, PhaseX(ph), MIOPEN_IG3D_SX, MIOPEN_IG3D_DX, MIOPEN_IG3D_PX, MIOPEN_IG3D_WO);
+    if(d < 0 || ho < 0 || wo < 0)
+        return -1;
+    return ((n * MIOPEN_IG3D_DO + d) * MIOPEN_IG3D_HO + ho) * MIOPEN_IG3D_WO + wo;
+}
+
+// Filter tap r + s * j of the phase ph, or -1 past the filter.
+static inline int TapOfPhase(uint ph, uint jz, uint jy, uint jx)
+{
+    const uint z = PhaseZ(ph) + jz * MIOPEN_IG3D_SZ;
+    const uint y = PhaseY(ph) + jy * MIOPEN_IG3D_SY;
+    const uint x = PhaseX(ph) + jx * MIOPEN_IG3D_SX;
+    if(z >= MIOPEN_IG3D_FZ || y >= MIOPEN_IG3D_FY || x >= MIOPEN_IG3D_FX)
+        return -1;
+    return (z * MIOPEN_IG3D_FY + y) * MIOPEN_IG3D_FX + x;
+}
+#endif
+
+// Element (m, k) of the A matrix of group g, and of phase ph with MIOPEN_IG3D_DIR 3.
+static inline _FLOAT_ACCUM LoadA(const __global _FLOAT* a, uint g, uint ph, uint m, uint k)
+{
+    if(m >= GEMM_M || k >= GEMM_K)
+        return (_FLOAT_ACCUM)0;
+#if MIOPEN_IG3D_DIR == 0
+    const uint c   = k % MIOPEN_IG3D_CG;
+    const uint tap = k / MIOPEN_IG3D_CG;
+    const int pix  = InPixelOfTap(m,
+                                 tap / (MIOPEN_IG3D_FY * MIOPEN_IG3D_FX),
+                                 (tap / MIOPEN_IG3D_FX) % MIOPEN_IG3D_FY,
+                                 tap % MIOPEN_IG3D_FX);
+    return pix < 0 ? (_FLOAT_ACCUM)0
+                   : CVT_FLOAT2ACCUM(a[(uint)pix * IG3D_C + g * MIOPEN_IG3D_CG + c]);
+#elif MIOPEN_IG3D_DIR == 1
+    const uint kk  = k % MIOPEN_IG3D_KG;
+    const uint tap = k / MIOPEN_IG3D_KG;
+    const int pix  = OutPixelOfTap(m,
+                                  tap / (MIOPEN_IG3D_FY * MIOPEN_IG3D_FX),
+                                  (tap / MIOPEN_IG3D_FX) % MIOPEN_IG3D_FY,
+                                  tap % MIOPEN_IG3D_FX);
+    return pix < 0 ? (_FLOAT_ACCUM)0
+                   : CVT_FLOAT2ACCUM(a[(uint)pix * IG3D_K + g * MIOPEN_IG3D_KG + kk]);
+#elif MIOPEN_IG3D_DIR == 2
+    return CVT_FLOAT2ACCUM(a[k * IG3D_K + g * MIOPEN_IG3D_KG + m]);
+#else
+    const uint kk  = k % MIOPEN_IG3D_KG;
+    const uint tap = k / MIOPEN_IG3D_KG;
+    const int pix  = OutPixelOfPhaseTap(
+        ph, m, tap / (IG3D_TY * IG3D_TX), (tap / IG3D_TX) % IG3D_TY, tap % IG3D_TX);
+    return pix < 0 ? (_FLOAT_ACCUM)0
+                   : CVT_FLOAT2ACCUM(a[(uint)pix * IG3D_K + g * MIOPEN_IG3D_KG + kk]);
+#endif
+}
+
+// Element (k, n) of the B matrix of group g, and of phase ph with MIOPEN_IG3D_DIR 3.
+static inline _FLOAT_ACCUM LoadB(const __global _FLOAT* b, uint g, uint ph, uint k, uint n)
+{
+    if(k >= GEMM_K || n >= GEMM_N)
+        return (_FLOAT_ACCUM)0;
+#if MIOPEN_IG3D_DIR == 0
+    return CVT_FLOAT2ACCUM(b[(g * MIOPEN_IG3D_KG + n) * IG3D_ZYXC + k]);
+#elif MIOPEN_IG3D_DIR == 1
+    const uint kk  = k % MIOPEN_IG3D_KG;
+    const uint tap = k / MIOPEN_IG3D_KG;
+    return CVT_FLOAT2ACCUM(b[(g * MIOPEN_IG3D_KG + kk) * IG3D_ZYXC + tap * MIOPEN_IG3D_CG + n]);
+#elif MIOPEN_IG3D_DIR == 3
+    const uint kk = k % MIOPEN_IG3D_KG;
+    const uint j  = k / MIOPEN_IG3D_KG;
+    const int tap = TapOfPhase(ph, j / (IG3D_TY * IG3D_TX), (j / IG3D_TX) % IG3D_TY, j % IG3D_TX);
+    return tap < 0 ? (_FLOAT_ACCUM)0
+                   : CVT_FLOAT2ACCUM(b[(g * MIOPEN_IG3D_KG + kk) * IG3D_ZYXC +
+                                       (uint)tap * MIOPEN_IG3D_CG + n]);
+#else
+    const uint c   = n % MIOPEN_IG3D_CG;
+    const uint tap = n / MIOPEN_IG3D_CG;
+    const int pix  = InPixelOfTap(k,
+                                 tap / (MIOPEN_IG3D_FY * MIOPEN_IG3D_FX),
+                                 (tap / MIOPEN_IG3D_FX) % MIOPEN_IG3D_FY,
+                                 tap % MIOPEN_IG3D_FX);
+    return pix < 0 ? (_FLOAT_ACCUM)0
+                   : CVT_FLOAT2ACCUM(b[(uint)pix * IG3D_C + g * MIOPEN_IG3D_CG + c]);
+#endif
+}
+
+// Index of element (m, n) of the C matrix of group g and phase ph, or -1 for the rows of a phase
+// past the borders.
+static inline int IndexC(uint g, uint ph, uint m, uint n)
+{
+#if MIOPEN_IG3D_DIR == 0
+    return m * IG3D_K + g * MIOPEN_IG3D_KG + n;
+#elif MIOPEN_IG3D_DIR == 1
+    return m * IG3D_C + g * MIOPEN_IG3D_CG + n;
+#elif MIOPEN_IG3D_DIR == 2
+    return (g * MIOPEN_IG3D_KG + m) * IG3D_ZYXC + n;
+#else
+    const int pix = InPixelOfPhase(ph, m);
+    return pix < 0 ? -1 : pix * IG3D_C + g * MIOPEN_IG3D_CG + n;
+#endif
+}
+
+// The arguments follow the GEMM: a is x, dy and dy, b is w, w and x and c is y, dx and dw.
+__attribute__((reqd_work_group_size(BLOCK, 1, 1))) __kernel void
+MIOpenConvImplicitGemmNdhwc(const __global _FLOAT* __restrict a,
+                            const __global _FLOAT* __restrict b,
+                            __global _FLOAT* __restrict c)
+{
+    const uint lid = get_local_id(0);
+    const uint tx  = lid % BLOCK_SIDE;
+    const uint ty  = lid / BLOCK_SIDE;
+
+    uint wg       = get_group_id(0);
+    const uint n0 = (wg % TILES_N) * MIOPEN_IG3D_TILE_N;
+    wg /= TILES_N;
+    const uint m0 = (wg % TILES_M) * MIOPEN_IG3D_TILE_M;
+    wg /= TILES_M;
+#if MIOPEN_IG3D_DIR == 3
+    const uint g  = wg % MIOPEN_IG3D_G;
+    const uint ph = wg / MIOPEN_IG3D_G;
+#else
+    const uint g  = wg;
+    const uint ph = 0;
+#endif
+
+    __local _FLOAT_ACCUM lcl_a[BK][MIOPEN_IG3D_TILE_M];
+    __local _FLOAT_ACCUM lcl_b[BK][MIOPEN_IG3D_TILE_N];
+
+    _FLOAT_ACCUM acc[TM][TN];
+    for(uint i = 0; i < TM; ++i)
+        for(uint j = 0; j < TN; ++j)
+            acc[i][j] = (_FLOAT_ACCUM)0;
+
+    for(uint k0 = 0; k0 < GEMM_K; k0 += BK)
+    {
+        // The contiguous dimension of each matrix is the fastest among the work-items.
+        for(uint i = lid; i < BK * MIOPEN_IG3D_TILE_M; i += BLOCK)
+        {
+#if MIOPEN_IG3D_DIR == 2
+            const uint kk = i / MIOPEN_IG3D_TILE_M;
+            const uint mm = i % MIOPEN_IG3D_TILE_M;
+#else
+            const uint kk = i % BK;
+            const uint mm = i / BK;
+#endif
+            lcl_a[kk][mm] = LoadA(a, g, ph, m0 + mm, k0 + kk);
+        }
+        for(uint i = lid; i < BK * MIOPEN_IG3D_TILE_N; i += BLOCK)
+        {
+#if MIOPEN_IG3D_DIR == 0
+            const uint kk = i % BK;
+            const uint nn = i / BK;
+#else
+            const uint kk = i / MIOPEN_IG3D_TILE_N;
+            const uint nn = i % MIOPEN_IG3D_TILE_N;
+#endif
+            lcl_b[kk][nn] = LoadB(b, g, ph, k0 + kk, n0 + nn);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint kk = 0; kk < BK; ++kk)
+        {
+            _FLOAT_ACCUM ra[TM], rb[TN];
+            for(uint i = 0; i < TM; ++i)
+                ra[i] = lcl_a[kk][ty + i * BLOCK_SIDE];
+            for(uint j = 0; j < TN; ++j)
+                rb[j] = lcl_b[kk][tx + j * BLOCK_SIDE];
+            for(uint i = 0; i < TM; ++i)
+                for(uint j = 0; j < TN; ++j)
+                    acc[i][j] += ra[i] * rb[j];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    for(uint i = 0; i < TM; ++i)
+    {
+        const uint m = m0 + ty + i * BLOCK_SIDE;
+        if(m >= GEMM_M)
+            continue;
+        for(uint j = 0; j < TN; ++j)
+        {
+            const uint n = n0 + tx + j * BLOCK_SIDE;
+            if(n >= GEMM_N)
+                continue;
+            const int index = IndexC(g, ph, m, n);
+            if(index >= 0)
+                c[index] = CVT_ACCUM2FLOAT(acc[i][j]);
+        }
+    }
+}
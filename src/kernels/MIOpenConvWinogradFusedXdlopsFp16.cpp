@@ -0,0 +1,364 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <hip/hip_runtime.h>
+
+// Forward fp16 3x3 convolution of NCHW tensors with stride 1 as a single-pass Winograd
+// F(MIOPEN_WF_TILE x MIOPEN_WF_TILE, 3x3). The input and filter transforms, the ALPHA * ALPHA
+// elementwise GEMMs and the output transform all run in one kernel, so that nothing goes
+// through the workspace.
+//
+// A work-group computes MIOPEN_WF_BT output tiles of MIOPEN_WF_BK output channels of a group.
+// For every chunk of CC input channels it transforms the input tiles to V and the filters to U
+// in fp32, stores both to LDS as fp16, and accumulates M[xi] += V[xi] * U[xi]^T in fp32 with
+// 16x16x16 MFMA blocks. The 16x16 blocks of all xi are spread over the 4 waves. At the end the
+// accumulators go through LDS again, so that every thread gets all ALPHA * ALPHA values of an
+// output tile of an output channel for the output transform.
+
+typedef _Float16 half4_t __attribute__((ext_vector_type(4)));
+typedef float float4_t __attribute__((ext_vector_type(4)));
+
+#define WF_C (MIOPEN_WF_G * MIOPEN_WF_CG)
+#define WF_K (MIOPEN_WF_G * MIOPEN_WF_KG)
+#define ALPHA (MIOPEN_WF_TILE + 2)
+#define XI (ALPHA * ALPHA)
+// Output tiles of the whole batch.
+#define TILES_H ((MIOPEN_WF_HO + MIOPEN_WF_TILE - 1) / MIOPEN_WF_TILE)
+#define TILES_W ((MIOPEN_WF_WO + MIOPEN_WF_TILE - 1) / MIOPEN_WF_TILE)
+#define TILES (MIOPEN_WF_N * TILES_H * TILES_W)
+
+#define WAVE 64
+#define BLOCK 256
+#define WAVES (BLOCK / WAVE)
+#define MFMA 16
+// Input channels transformed and multiplied per step.
+#define CC 16
+#define NBT (MIOPEN_WF_BT / MFMA)
+#define NBK (MIOPEN_WF_BK / MFMA)
+#define NB (NBT * NBK)
+// 16x16 blocks of the elementwise GEMMs computed by a wave.
+#define ITEMS (XI * NB / WAVES)
+#define BLOCKS_T ((TILES + MIOPEN_WF_BT - 1) / MIOPEN_WF_BT)
+#define BLOCKS_K ((MIOPEN_WF_KG + MIOPEN_WF_BK - 1) / MIOPEN_WF_BK)
+
+// LDS holds either V and U of a step, or M of one 16x16 block for all xi.
+#define LDS_VU_BYTES (XI * (MIOPEN_WF_BT + MIOPEN_WF_BK) * CC * 2)
+#define LDS_M_BYTES (XI * MFMA * MFMA * 4)
+#define LDS_BYTES (LDS_VU_BYTES > LDS_M_BYTES ? LDS_VU_BYTES : LDS_M_BYTES)
+
+#if MIOPEN_WF_TILE == 4
+// clang-format off
+#define WF_BT_MATRIX {                                          \
+    { 4.0f,  0.0f, -5.0f,  0.0f, 1.0f, 0.0f },                  \
+    { 0.0f, -4.0f, -4.0f,  1.0f, 1.0f, 0.0f },                  \
+    { 0.0f,  4.0f, -4.0f, -1.0f, 1.0f, 0.0f },                  \
+    { 0.0f, -2.0f, -1.0f,  2.0f, 1.0f, 0.0f },                  \
+    { 0.0f,  2.0f, -1.0f, -2.0f, 1.0f, 0.0f },                  \
+    { 0.0f,  4.0f,  0.0f, -5.0f, 0.0f, 1.0f } }
+#define WF_G_MATRIX {                                           \
+    {  1.0f / 4,   0.0f,       0.0f     },                      \
+    { -1.0f / 6,  -1.0f / 6,  -1.0f / 6 },                      \
+    { -1.0f / 6,   1.0f / 6,  -1.0f / 6 },                      \
+    {  1.0f / 24,  1.0f / 12,  1.0f / 6 },                      \
+    {  1.0f / 24, -1.0f / 12,  1.0f / 6 },                      \
+    {  0.0f,       0.0f,       1.0f     } }
+#define WF_AT_MATRIX {                                          \
+    { 1.0f, 1.0f,  1.0f, 1.0f,  1.0f, 0.0f },                   \
+    { 0.0f, 1.0f, -1.0f, 2.0f, -2.0f, 0.0f },                   \
+    { 0.0f, 1.0f,  1.0f, 4.0f,  4.0f, 0.0f },                   \
+    { 0.0f, 1.0f, -1.0f, 8.0f, -8.0f, 1.0f } }
+// clang-format on
+#elif MIOPEN_WF_TILE == 6
+// clang-format off
+#define WF_BT_MATRIX {                                                                  \
+    { 1.0f,  0.0f,      -21.0f / 4,  0.0f,       21.0f / 4,  0.0f,      -1.0f, 0.0f },  \
+    { 0.0f,  1.0f,        1.0f,     -17.0f / 4, -17.0f / 4,  1.0f,       1.0f, 0.0f },  \
+    { 0.0f, -1.0f,        1.0f,      17.0f / 4, -17.0f / 4, -1.0f,       1.0f, 0.0f },  \
+    { 0.0f,  1.0f / 2,    1.0f / 4,  -5.0f / 2,  -5.0f / 4,  2.0f,       1.0f, 0.0f },  \
+    { 0.0f, -1.0f / 2,    1.0f / 4,   5.0f / 2,  -5.0f / 4, -2.0f,       1.0f, 0.0f },  \
+    { 0.0f,  2.0f,        4.0f,      -5.0f / 2,  -5.0f,      1.0f / 2,   1.0f, 0.0f },  \
+    { 0.0f, -2.0f,        4.0f,       5.0f / 2,  -5.0f,     -1.0f / 2,   1.0f, 0.0f },  \
+    { 0.0f, -1.0f,        0.0f,      21.0f / 4,   0.0f,    -21.0f / 4,   0.0f, 1.0f } }
+#define WF_G_MATRIX {                                           \
+    {  1.0f,        0.0f,        0.0f       },                  \
+    { -2.0f / 9,   -2.0f / 9,   -2.0f / 9   },                  \
+    { -2.0f / 9,    2.0f / 9,   -2.0f / 9   },                  \
+    {  1.0f / 90,   1.0f / 45,   2.0f / 45  },                  \
+    {  1.0f / 90,  -1.0f / 45,   2.0f / 45  },                  \
+    { 32.0f / 45,  16.0f / 45,   8.0f / 45  },                  \
+    { 32.0f / 45, -16.0f / 45,   8.0f / 45  },                  \
+    {  0.0f,        0.0f,        1.0f       } }
+#define WF_AT_MATRIX {                                                                  \
+    { 1.0f, 1.0f,  1.0f,  1.0f,   1.0f,  1.0f,       1.0f,       0.0f },                \
+    { 0.0f, 1.0f, -1.0f,  2.0f,  -2.0f,  1.0f / 2,  -1.0f / 2,   0.0f },                \
+    { 0.0f, 1.0f,  1.0f,  4.0f,   4.0f,  1.0f / 4,   1.0f / 4,   0.0f },                \
+    { 0.0f, 1.0f, -1.0f,  8.0f,  -8.0f,  1.0f / 8,  -1.0f / 8,   0.0f },                \
+    { 0.0f, 1.0f,  1.0f, 16.0f,  16.0f,  1.0f / 16,  1.0f / 16,  0.0f },                \
+    { 0.0f, 1.0f, -1.0f, 32.0f, -32.0f,  1.0f / 32, -1.0f / 32,  1.0f } }
+// clang-format on
+#else
+#error "MIOPEN_WF_TILE must be 4 or 6"
+#endif
+
+/// v = BT * d * B
+__device__ void InputTransform(const float (&d)[ALPHA][ALPHA], float (&v)[ALPHA][ALPHA])
+{
+    const float bt[ALPHA][ALPHA] = WF_BT_MATRIX;
+    float tmp[ALPHA][ALPHA];
+#pragma unroll
+    for(int i = 0; i < ALPHA; ++i)
+#pragma unroll
+        for(int j = 0; j < ALPHA; ++j)
+        {
+            float s = 0.0f;
+#pragma unroll
+            for(int a = 0; a < ALPHA; ++a)
+                s += bt[i][a] * d[a][j];
+            tmp[i][j] = s;
+        }
+#pragma unroll
+    for(int i = 0; i < ALPHA; ++i)
+#pragma unroll
+        for(int j = 0; j < ALPHA; ++j)
+        {
+            float s = 0.0f;
+#pragma unroll
+            for(int b = 0; b < ALPHA; ++b)
+                s += tmp[i][b] * bt[j][b];
+            v[i][j] = s;
+        }
+}
+
+/// u = G * g * GT
+__device__ void FilterTransform(const float (&f)[3][3], float (&u)[ALPHA][ALPHA])
+{
+    const float gm[ALPHA][3] = WF_G_MATRIX;
+    float tmp[ALPHA][3];
+#pragma unroll
+    for(int i = 0; i < ALPHA; ++i)
+#pragma unroll
+        for(int j = 0; j < 3; ++j)
+            tmp[i][j] = gm[i][0] * f[0][j] + gm[i][1] * f[1][j] + gm[i][2] * f[2][j];
+#pragma unroll
+    for(int i = 0; i < ALPHA; ++i)
+#pragma unroll
+        for(int j = 0; j < ALPHA; ++j)
+            u[i][j] = tmp[i][0] * gm[j][0] + tmp[i][1] * gm[j][1] + tmp[i][2] * gm[j][2];
+}
+
+/// y = AT * m * A
+__device__ void OutputTransform(const float (&m)[ALPHA][ALPHA],
+                                float (&y)[MIOPEN_WF_TILE][MIOPEN_WF_TILE])
+{
+    const float at[MIOPEN_WF_TILE][ALPHA] = WF_AT_MATRIX;
+    float tmp[MIOPEN_WF_TILE][ALPHA];
+#pragma unroll
+    for(int i = 0; i < MIOPEN_WF_TILE; ++i)
+#pragma unroll
+        for(int j = 0; j < ALPHA; ++j)
+        {
+            float s = 0.0f;
+#pragma unroll
+            for(int a = 0; a < ALPHA; ++a)
+                s += at[i][a] * m[a][j];
+            tmp[i][j] = s;
+        }
+#pragma unroll
+    for(int i = 0; i < MIOPEN_WF_TILE; ++i)
+#pragma unroll
+        for(int j = 0; j < MIOPEN_WF_TILE; ++j)
+        {
+            float s = 0.0f;
+#pragma unroll
+            for(int b = 0; b < ALPHA; ++b)
+                s += tmp[i][b] * at[j][b];
+            y[i][j] = s;
+        }
+}
+
+extern "C" __global__ void __launch_bounds__(BLOCK)
+    MIOpenConvWinogradFusedXdlopsFp16(const _Float16* __restrict__ p_in,
+                                      const _Float16* __restrict__ p_wei,
+                                      _Float16* __restrict__ p_out)
+{
+    __shared__ float4_t lds[LDS_BYTES / 16];
+    // V[xi][t][c] and U[xi][k][c], with the channels of a step contiguous for the MFMA loads.
+    _Float16* const lds_v = reinterpret_cast<_Float16*>(lds);
+    _Float16* const lds_u = lds_v + XI * MIOPEN_WF_BT * CC;
+    // M[xi][k][t] of one 16x16 block.
+    float* const lds_m = reinterpret_cast<float*>(lds);
+
+    const unsigned tid  = threadIdx.x;
+    const unsigned lane = tid % WAVE;
+    const unsigned wave = tid / WAVE;
+
+    unsigned bid      = blockIdx.x;
+    const unsigned k0 = (bid % BLOCKS_K) * MIOPEN_WF_BK;
+    bid /= BLOCKS_K;
+    const unsigned t0 = (bid % BLOCKS_T) * MIOPEN_WF_BT;
+    const unsigned g  = bid / BLOCKS_T;
+
+    float4_t acc[ITEMS];
+#pragma unroll
+    for(unsigned q = 0; q < ITEMS; ++q)
+        for(unsigned r = 0; r < 4; ++r)
+            acc[q][r] = 0.0f;
+
+    for(unsigned c0 = 0; c0 < MIOPEN_WF_CG; c0 += CC)
+    {
+        // Neighbouring threads take neighbouring tiles, which share most of the input rows.
+        for(unsigned i = tid; i < MIOPEN_WF_BT * CC; i += BLOCK)
+        {
+            const unsigned tt = i % MIOPEN_WF_BT;
+            const unsigned cc = i / MIOPEN_WF_BT;
+            const unsigned t  = t0 + tt;
+            const unsigned c  = c0 + cc;
+            const unsigned tw = t % TILES_W;
+            const unsigned th = (t / TILES_W) % TILES_H;
+            const unsigned n  = t / (TILES_W * TILES_H);
+            const int hi0     = (int)(th * MIOPEN_WF_TILE) - MIOPEN_WF_PY;
+            const int wi0     = (int)(tw * MIOPEN_WF_TILE) - MIOPEN_WF_PX;
+            const bool valid  = t < TILES && c < MIOPEN_WF_CG;
+            const _Float16* in =
+                p_in + ((size_t)n * WF_C + g * MIOPEN_WF_CG + c) * MIOPEN_WF_HI * MIOPEN_WF_WI;
+
+            float d[ALPHA][ALPHA];
+#pragma unroll
+            for(int y = 0; y < ALPHA; ++y)
+#pragma unroll
+                for(int x = 0; x < ALPHA; ++x)
+                {
+                    const int hi = hi0 + y;
+                    const int wi = wi0 + x;
+                    d[y][x] = valid && hi >= 0 && hi < MIOPEN_WF_HI && wi >= 0 &&
+                                      wi < MIOPEN_WF_WI
+                                  ? (float)in[hi * MIOPEN_WF_WI + wi]
+                                  : 0.0f;
+                }
+            float v[ALPHA][ALPHA];
+            InputTransform(d, v);
+#pragma unroll
+            for(int y = 0; y < ALPHA; ++y)
+#pragma unroll
+                for(int x = 0; x < ALPHA; ++x)
+                    lds_v[((y * ALPHA + x) * MIOPEN_WF_BT + tt) * CC + cc] = (_Float16)v[y][x];
+        }
+        for(unsigned i = tid; i < MIOPEN_WF_BK * CC; i += BLOCK)
+        {
+            const unsigned cc = i % CC;
+            const unsigned kk = i / CC;
+            const unsigned k  = k0 + kk;
+            const unsigned c  = c0 + cc;
+            const bool valid  = k < MIOPEN_WF_KG && c < MIOPEN_WF_CG;
+            const _Float16* wei =
+                p_wei + ((size_t)(g * MIOPEN_WF_KG + k) * MIOPEN_WF_CG + c) * 9;
+
+            float f[3][3];
+#pragma unroll
+            for(int y = 0; y < 3; ++y)
+#pragma unroll
+                for(int x = 0; x < 3; ++x)
+                    f[y][x] = valid ? (float)wei[y * 3 + x] : 0.0f;
+            float u[ALPHA][ALPHA];
+            FilterTransform(f, u);
+#pragma unroll
+            for(int y = 0; y < ALPHA; ++y)
+#pragma unroll
+                for(int x = 0; x < ALPHA; ++x)
+                    lds_u[((y * ALPHA + x) * MIOPEN_WF_BK + kk) * CC + cc] = (_Float16)u[y][x];
+        }
+        __syncthreads();
+
+        // Block j of the work-group is position j / NB and block j % NB of the tile. A lane
+        // provides the 4 channels 4 * (lane / 16) of row or column (lane % 16) of a block.
+#pragma unroll
+        for(unsigned q = 0; q < ITEMS; ++q)
+        {
+            const unsigned j  = wave + q * WAVES;
+            const unsigned xi = j / NB;
+            const unsigned bt = (j % NB) / NBK;
+            const unsigned bk = (j % NB) % NBK;
+            const half4_t a   = *reinterpret_cast<const half4_t*>(
+                lds_v + (xi * MIOPEN_WF_BT + bt * MFMA + lane % MFMA) * CC + 4 * (lane / MFMA));
+            const half4_t b = *reinterpret_cast<const half4_t*>(
+                lds_u + (xi * MIOPEN_WF_BK + bk * MFMA + lane % MFMA) * CC + 4 * (lane / MFMA));
+            acc[q] = __builtin_amdgcn_mfma_f32_16x16x16f16(a, b, acc[q], 0, 0, 0);
+        }
+        __syncthreads();
+    }
+
+    // Accumulator r of a lane is tile 4 * (lane / 16) + r and channel lane % 16 of its block.
+    for(unsigned blk = 0; blk < NB; ++blk)
+    {
+#pragma unroll
+        for(unsigned q = 0; q < ITEMS; ++q)
+        {
+            const unsigned j = wave + q * WAVES;
+            if(j % NB != blk)
+                continue;
+            const unsigned xi = j / NB;
+#pragma unroll
+            for(unsigned r = 0; r < 4; ++r)
+                lds_m[(xi * MFMA + lane % MFMA) * MFMA + 4 * (lane / MFMA) + r] = acc[q][r];
+        }
+        __syncthreads();
+
+        // Neighbouring threads take neighbouring tiles of a channel, for the global stores.
+        const unsigned tt = tid % MFMA;
+        const unsigned kk = tid / MFMA;
+        const unsigned t  = t0 + (blk / NBK) * MFMA + tt;
+        const unsigned k  = k0 + (blk % NBK) * MFMA + kk;
+
+        float m[ALPHA][ALPHA];
+#pragma unroll
+        for(int y = 0; y < ALPHA; ++y)
+#pragma unroll
+            for(int x = 0; x < ALPHA; ++x)
+                m[y][x] = lds_m[((y * ALPHA + x) * MFMA + kk) * MFMA + tt];
+        __syncthreads();
+
+        if(t < TILES && k < MIOPEN_WF_KG)
+        {
+            float out[MIOPEN_WF_TILE][MIOPEN_WF_TILE];
+            OutputTransform(m, out);
+
+            const unsigned tw = t % TILES_W;
+            const unsigned th = (t / TILES_W) % TILES_H;
+            const unsigned n  = t / (TILES_W * TILES_H);
+            _Float16* const y_ptr =
+                p_out + ((size_t)n * WF_K + g * MIOPEN_WF_KG + k) * MIOPEN_WF_HO * MIOPEN_WF_WO;
+#pragma unroll
+            for(int y = 0; y < MIOPEN_WF_TILE; ++y)
+#pragma unroll
+                for(int x = 0; x < MIOPEN_WF_TILE; ++x)
+                {
+                    const unsigned ho = th * MIOPEN_WF_TILE + y;
+                    const unsigned wo = tw * MIOPEN_WF_TILE + x;
+                    if(ho < MIOPEN_WF_HO && wo < MIOPEN_WF_WO)
+                        y_ptr[ho * MIOPEN_WF_WO + wo] = (_Float16)out[y][x];
+                }
+        }
+    }
+}
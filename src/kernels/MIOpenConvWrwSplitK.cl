@@ -0,0 +1,207 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+// Backward weights as an implicit GEMM with the reduction dimension split among the
+// work-groups: dw[k][c, y, x] = sum over (n, ho, wo) of dy[n][k][ho, wo] * x[n][c][hi, wi].
+// GEMM M is the output channels of a group, GEMM N is the filter elements, GEMM K is the
+// output pixels of the batch, the latter is split into MIOPEN_SK_SPLITS parts. The parts are
+// written to the output directly (MIOPEN_SK_MODE 0, a single part), to own slices of the
+// workspace which are then summed in order (1, deterministic) or added atomically (2).
+
+#define MIOPEN_SK_C (MIOPEN_SK_G * MIOPEN_SK_CG)
+#define MIOPEN_SK_K (MIOPEN_SK_G * MIOPEN_SK_KG)
+#define MIOPEN_SK_CYX (MIOPEN_SK_CG * MIOPEN_SK_FY * MIOPEN_SK_FX)
+#define MIOPEN_SK_WEI (MIOPEN_SK_K * MIOPEN_SK_CYX)
+#define MIOPEN_SK_E (MIOPEN_SK_N * MIOPEN_SK_HO * MIOPEN_SK_WO)
+
+#define BK 16
+#define BLOCK_SIDE 16
+#define BLOCK (BLOCK_SIDE * BLOCK_SIDE)
+#define TM (MIOPEN_SK_TILE / BLOCK_SIDE)
+#define TN (MIOPEN_SK_TILE / BLOCK_SIDE)
+#define TILES_M ((MIOPEN_SK_KG + MIOPEN_SK_TILE - 1) / MIOPEN_SK_TILE)
+#define TILES_N ((MIOPEN_SK_CYX + MIOPEN_SK_TILE - 1) / MIOPEN_SK_TILE)
+#define E_PER_SPLIT \
+    ((MIOPEN_SK_E + MIOPEN_SK_SPLITS * BK - 1) / (MIOPEN_SK_SPLITS * BK) * BK)
+
+#if MIOPEN_SK_NHWC
+#define X_IDX(n, c, h, w) \
+    ((((n)*MIOPEN_SK_HI + (h)) * MIOPEN_SK_WI + (w)) * MIOPEN_SK_C + (c))
+#define DY_IDX(n, k, h, w) \
+    ((((n)*MIOPEN_SK_HO + (h)) * MIOPEN_SK_WO + (w)) * MIOPEN_SK_K + (k))
+#else
+#define X_IDX(n, c, h, w) \
+    ((((n)*MIOPEN_SK_C + (c)) * MIOPEN_SK_HI + (h)) * MIOPEN_SK_WI + (w))
+#define DY_IDX(n, k, h, w) \
+    ((((n)*MIOPEN_SK_K + (k)) * MIOPEN_SK_HO + (h)) * MIOPEN_SK_WO + (w))
+#endif
+
+#if MIOPEN_SK_MODE == 0
+#define OUT_TYPE _FLOAT
+#else
+#define OUT_TYPE float
+#endif
+
+#if MIOPEN_SK_MODE == 2
+static inline void AtomicAdd(volatile __global float* addr, float value)
+{
+    union
+    {
+        uint u;
+        float f;
+    } prev, next, cur;
+    cur.f = *addr;
+    do
+    {
+        prev.f = cur.f;
+        next.f = prev.f + value;
+        cur.u  = atomic_cmpxchg((volatile __global uint*)addr, prev.u, next.u);
+    } while(cur.u != prev.u);
+}
+#endif
+
+__attribute__((reqd_work_group_size(BLOCK, 1, 1))) __kernel void
+MIOpenConvWrwSplitK(const __global _FLOAT* __restrict x,
+                    __global OUT_TYPE* __restrict out,
+                    const __global _FLOAT* __restrict dy)
+{
+    const uint lid = get_local_id(0);
+    const uint tx  = lid % BLOCK_SIDE;
+    const uint ty  = lid / BLOCK_SIDE;
+
+    uint wg       = get_group_id(0);
+    const uint n0 = (wg % TILES_N) * MIOPEN_SK_TILE;
+    wg /= TILES_N;
+    const uint m0 = (wg % TILES_M) * MIOPEN_SK_TILE;
+    wg /= TILES_M;
+    const uint g = wg % MIOPEN_SK_G;
+    const uint s = wg / MIOPEN_SK_G;
+
+    const uint e_begin = s * E_PER_SPLIT;
+    const uint e_end   = min((uint)MIOPEN_SK_E, e_begin + E_PER_SPLIT);
+
+    __local _FLOAT_ACCUM lcl_dy[BK][MIOPEN_SK_TILE];
+    __local _FLOAT_ACCUM lcl_x[BK][MIOPEN_SK_TILE];
+
+    _FLOAT_ACCUM acc[TM][TN];
+    for(uint i = 0; i < TM; ++i)
+        for(uint j = 0; j < TN; ++j)
+            acc[i][j] = (_FLOAT_ACCUM)0;
+
+    for(uint e0 = e_begin; e0 < e_end; e0 += BK)
+    {
+        for(uint i = lid; i < BK * MIOPEN_SK_TILE; i += BLOCK)
+        {
+            // The contiguous dimension of the tensors is the fastest among the work-items.
+#if MIOPEN_SK_NHWC
+            const uint ek = i / MIOPEN_SK_TILE;
+            const uint j  = i % MIOPEN_SK_TILE;
+#else
+            const uint ek = i % BK;
+            const uint j  = i / BK;
+#endif
+            const uint e       = e0 + ek;
+            const uint wo      = e % MIOPEN_SK_WO;
+            const uint ho      = (e / MIOPEN_SK_WO) % MIOPEN_SK_HO;
+            const uint n       = e / (MIOPEN_SK_WO * MIOPEN_SK_HO);
+            const bool e_valid = e < e_end;
+
+            const uint m  = m0 + j;
+            lcl_dy[ek][j] = (e_valid && m < MIOPEN_SK_KG)
+                                ? CVT_FLOAT2ACCUM(dy[DY_IDX(n, g * MIOPEN_SK_KG + m, ho, wo)])
+                                : (_FLOAT_ACCUM)0;
+
+            const uint nn = n0 + j;
+#if MIOPEN_SK_NHWC
+            const uint cl = nn % MIOPEN_SK_CG;
+            const uint fx = (nn / MIOPEN_SK_CG) % MIOPEN_SK_FX;
+            const uint fy = nn / (MIOPEN_SK_CG * MIOPEN_SK_FX);
+#else
+            const uint cl = nn / (MIOPEN_SK_FY * MIOPEN_SK_FX);
+            const uint fy = (nn / MIOPEN_SK_FX) % MIOPEN_SK_FY;
+            const uint fx = nn % MIOPEN_SK_FX;
+#endif
+            const int hi       = (int)(ho * MIOPEN_SK_SY + fy * MIOPEN_SK_DY) - MIOPEN_SK_PY;
+            const int wi       = (int)(wo * MIOPEN_SK_SX + fx * MIOPEN_SK_DX) - MIOPEN_SK_PX;
+            const bool x_valid = e_valid && nn < MIOPEN_SK_CYX && hi >= 0 && hi < MIOPEN_SK_HI &&
+                                 wi >= 0 && wi < MIOPEN_SK_WI;
+            lcl_x[ek][j] = x_valid
+                               ? CVT_FLOAT2ACCUM(x[X_IDX(n, g * MIOPEN_SK_CG + cl, hi, wi)])
+                               : (_FLOAT_ACCUM)0;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint kk = 0; kk < BK; ++kk)
+        {
+            _FLOAT_ACCUM a[TM], b[TN];
+            for(uint i = 0; i < TM; ++i)
+                a[i] = lcl_dy[kk][ty + i * BLOCK_SIDE];
+            for(uint j = 0; j < TN; ++j)
+                b[j] = lcl_x[kk][tx + j * BLOCK_SIDE];
+            for(uint i = 0; i < TM; ++i)
+                for(uint j = 0; j < TN; ++j)
+                    acc[i][j] += a[i] * b[j];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    for(uint i = 0; i < TM; ++i)
+    {
+        const uint m = m0 + ty + i * BLOCK_SIDE;
+        if(m >= MIOPEN_SK_KG)
+            continue;
+        for(uint j = 0; j < TN; ++j)
+        {
+            const uint nn = n0 + tx + j * BLOCK_SIDE;
+            if(nn >= MIOPEN_SK_CYX)
+                continue;
+            // The layout of the filters is K x CYX in NCHW and NHWC, as nn follows it.
+            const uint idx = (g * MIOPEN_SK_KG + m) * MIOPEN_SK_CYX + nn;
+#if MIOPEN_SK_MODE == 0
+            out[idx] = CVT_ACCUM2FLOAT(acc[i][j]);
+#elif MIOPEN_SK_MODE == 1
+            out[s * MIOPEN_SK_WEI + idx] = acc[i][j];
+#else
+            AtomicAdd(out + idx, acc[i][j]);
+#endif
+        }
+    }
+}
+
+// Sums the parts, always in the same order, and converts the result to the type of the filters.
+__attribute__((reqd_work_group_size(BLOCK, 1, 1))) __kernel void
+MIOpenConvWrwSplitKReduce(const __global float* __restrict parts, __global _FLOAT* __restrict dw)
+{
+    const uint gid = get_global_id(0);
+    if(gid >= MIOPEN_SK_WEI)
+        return;
+
+    float sum = 0;
+    for(uint s = 0; s < MIOPEN_SK_REDUCED_PARTS; ++s)
+        sum += parts[s * MIOPEN_SK_WEI + gid];
+    dw[gid] = CVT_ACCUM2FLOAT(sum);
+}
@@ -301,17 +301,53 @@ __kernel void InitKernelState(__global prngStates* state)
 #define USE_PRNG 0
 #endif
 
+#ifndef USE_PHILOX
+#define USE_PHILOX 0
+#endif
+
+#ifndef PACK_MASK
+#define PACK_MASK 0
+#endif
+
+#ifndef MASK_VEC8
+#define MASK_VEC8 0
+#endif
+
+// The kernel draws the mask instead of reading it from reserveSpace
+#define GEN_MASK ((RUN_FORWARD && !USE_MASK) || (!RUN_FORWARD && USE_PRNG))
+
+#if USE_PHILOX
+#include "philox.h"
+#endif
+
+#if PACK_MASK
+uint dropout_offset(uint e,
+                    const int dim1,
+                    const int dim2,
+                    const int dim3,
+                    const int dim4,
+                    const int str0,
+                    const int str1,
+                    const int str2,
+                    const int str3)
+{
+    const uint i0 = e / dim1 / dim2 / dim3 / dim4;
+    const uint i1 = (e / dim2 / dim3 / dim4) % dim1;
+    const uint i2 = (e / dim3 / dim4) % dim2;
+    const uint i3 = (e / dim4) % dim3;
+    const uint i4 = e % dim4;
+    return i0 * str0 + i1 * str1 + i2 * str2 + i3 * str3 + i4;
+}
+#endif
+
 __kernel void
 #if RUN_FORWARD
 DropoutForward(
-#if USE_MASK
-    UNUSED
-#endif
 #else
 DropoutBackward(
-#if !USE_PRNG
-    UNUSED
 #endif
+#if !GEN_MASK || USE_PHILOX
+    UNUSED
 #endif
     const __global prngStates* state,
     const float dropout,
@@ -346,16 +382,93 @@ DropoutBackward(
 #if(RUN_FORWARD && !USE_RSVSP && !USE_MASK) || (!RUN_FORWARD && USE_PRNG)
     UNUSED
 #endif
-    const uint rsvsp_offset)
+    const uint rsvsp_offset,
+#if !GEN_MASK || !USE_PHILOX
+    UNUSED
+#endif
+    const ulong prng_seed,
+#if !GEN_MASK || !USE_PHILOX
+    UNUSED
+#endif
+    const ulong prng_offset)
 {
-    _FLOAT dat_blk[RD_BLCK];
-    uchar is_kept[RD_BLCK];
-#if(RUN_FORWARD && !USE_MASK) || (!RUN_FORWARD && USE_PRNG)
+#if GEN_MASK && !USE_PHILOX
     uint sid = get_global_id(0);
     prngStates cur_state;
     cur_state = *((__global prngStates*)(state + sid));
 #endif
 
+#if PACK_MASK
+    // Bit i of mask byte b belongs to element 8 * b + i and total_work counts elements, so every
+    // work-item owns whole bytes of the mask. With MASK_VEC8 the rows are a multiple of 8 long and
+    // the elements of a byte are contiguous, they are then moved with single vector accesses.
+    const uint total_bytes = (total_work + 7) / 8;
+    for(uint gid = get_global_id(0); gid < total_bytes; gid += get_global_size(0))
+    {
+#if GEN_MASK
+        uchar bits = 0;
+        for(uint i = 0; i < 8; ++i)
+        {
+#if USE_PHILOX
+            const uint rnd = philox_element(prng_seed, prng_offset, gid * 8 + i);
+#else
+            const uint rnd = xorwow_lite_next(&cur_state);
+#endif
+            bits |= (uchar)((uniform_distribution(rnd) > dropout ? 1U : 0U) << i);
+        }
+#if RUN_FORWARD && USE_RSVSP
+        reserveSpace[rsvsp_offset + gid] = bits;
+#endif
+#else
+        const uchar bits = reserveSpace[rsvsp_offset + gid];
+#endif
+
+#if MASK_VEC8
+        const uint x_idx = dropout_offset(
+            gid * 8, dim1, dim2, dim3, dim4, in_str0, in_str1, in_str2, in_str3);
+        const uint y_idx = dropout_offset(
+            gid * 8, dim1, dim2, dim3, dim4, out_str0, out_str1, out_str2, out_str3);
+
+        _FLOAT dat_blk[8];
+#if RUN_FORWARD
+        vstore8(vload8(0, x + in_offset + x_idx), 0, dat_blk);
+#else
+        vstore8(vload8(0, y + out_offset + y_idx), 0, dat_blk);
+#endif
+        for(uint i = 0; i < 8; ++i)
+        {
+            dat_blk[i] = ((bits >> i) & 1) != 0 ? dat_blk[i] * (_FLOAT)scale : (_FLOAT)0;
+        }
+#if RUN_FORWARD
+        vstore8(vload8(0, dat_blk), 0, y + out_offset + y_idx);
+#else
+        vstore8(vload8(0, dat_blk), 0, x + in_offset + x_idx);
+#endif
+#else
+        for(uint i = 0; i < 8 && gid * 8 + i < total_work; ++i)
+        {
+            const uint x_idx = dropout_offset(
+                gid * 8 + i, dim1, dim2, dim3, dim4, in_str0, in_str1, in_str2, in_str3);
+            const uint y_idx = dropout_offset(
+                gid * 8 + i, dim1, dim2, dim3, dim4, out_str0, out_str1, out_str2, out_str3);
+#if RUN_FORWARD
+            const _FLOAT dat = x[in_offset + x_idx];
+#else
+            const _FLOAT dat = y[out_offset + y_idx];
+#endif
+            const _FLOAT res = ((bits >> i) & 1) != 0 ? dat * (_FLOAT)scale : (_FLOAT)0;
+#if RUN_FORWARD
+            y[out_offset + y_idx] = res;
+#else
+            x[in_offset + x_idx] = res;
+#endif
+        }
+#endif
+    }
+#else
+    _FLOAT dat_blk[RD_BLCK];
+    uchar is_kept[RD_BLCK];
+
     for(uint gid = get_global_id(0); gid < total_work; gid += get_global_size(0))
     {
         uint i0    = gid / dim1 / dim2 / dim3 / dim4;
@@ -376,10 +489,16 @@ DropoutBackward(
             y + out_offset + y_idx
 #endif
             ));
-#if(RUN_FORWARD && !USE_MASK) || (!RUN_FORWARD && USE_PRNG)
+#if GEN_MASK
         for(int i = 0; i < RD_BLCK; ++i)
         {
-            is_kept[i] = (uchar)(uniform_distribution(xorwow_lite_next(&cur_state)) > dropout);
+#if USE_PHILOX
+            const uint rnd =
+                philox_element(prng_seed, prng_offset, gid - i4 + i4_rd * RD_BLCK + i);
+#else
+            const uint rnd = xorwow_lite_next(&cur_state);
+#endif
+            is_kept[i] = (uchar)(uniform_distribution(rnd) > dropout);
         }
 #if RUN_FORWARD && USE_RSVSP
         *((global READ_BOOL_TYPE*)(reserveSpace + rsvsp_offset + gid - i4 + i4_rd * RD_BLCK)) =
@@ -402,6 +521,7 @@ DropoutBackward(
 #endif
             )) = *((READ_DAT_TYPE*)dat_blk);
     }
+#endif
     (void)dropout;
 }
 #endif
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+// The last op of the backward fusion plans which end with a bias gradient: applies the activation
+// backward of the plan to dy, writes the result to dx and sums it up into the gradient of the
+// bias, so that dy is read once. A work-group reduces a channel of the MIOPEN_BWD_N images of
+// MIOPEN_BWD_HW pixels, which are NCHW packed, or NHWC with MIOPEN_BWD_CHANNELS_LAST. dx may be
+// dy.
+#if MIOPEN_BWD_ACTIV
+#define _FLOAT_PREC _FLOAT_ACCUM
+#define UNUSED __attribute__((__unused__))
+#if MIOPEN_USE_FP16 == 1
+#define EPSILON (_FLOAT_ACCUM)0.0001
+#else
+#define EPSILON (_FLOAT_ACCUM)0.000001
+#endif
+#include "activation_functions.h"
+// x and y are the input and the output of the activation in the forward direction.
+#define BWD_ACTIV_PARAMS                                                                  \
+    , const __global _FLOAT* __restrict x, const __global _FLOAT* __restrict y,           \
+        const _FLOAT activ_diff_scale, const _FLOAT activ_gamma, const _FLOAT activ_beta, \
+        const _FLOAT activ_alpha
+#else
+#define BWD_ACTIV_PARAMS
+#endif
+
+#define BWD_NHW (MIOPEN_BWD_N * MIOPEN_BWD_HW)
+
+static inline uint Index(uint c, uint i)
+{
+#if MIOPEN_BWD_CHANNELS_LAST
+    return i * MIOPEN_BWD_C + c;
+#else
+    return (i / MIOPEN_BWD_HW) * (MIOPEN_BWD_C * MIOPEN_BWD_HW) + c * MIOPEN_BWD_HW +
+           i % MIOPEN_BWD_HW;
+#endif
+}
+
+__attribute__((reqd_work_group_size(MIOPEN_BWD_LOCAL_SIZE, 1, 1))) __kernel void
+MIOpenFusionBiasBwd(const __global _FLOAT* dy,
+                    __global _FLOAT* dx,
+                    __global _FLOAT* __restrict dbias BWD_ACTIV_PARAMS)
+{
+    __local _FLOAT_ACCUM partial[MIOPEN_BWD_LOCAL_SIZE];
+    const uint c   = get_group_id(0);
+    const uint lid = get_local_id(0);
+
+    _FLOAT_ACCUM sum = (_FLOAT_ACCUM)0;
+    for(uint i = lid; i < BWD_NHW; i += MIOPEN_BWD_LOCAL_SIZE)
+    {
+        const uint p   = Index(c, i);
+        _FLOAT_ACCUM g = CVT_FLOAT2ACCUM(dy[p]);
+#if MIOPEN_BWD_ACTIV
+        const _FLOAT_ACCUM top_diff = g;
+        const _FLOAT_ACCUM bot_data = CVT_FLOAT2ACCUM(x[p]);
+        const _FLOAT_ACCUM top_data = CVT_FLOAT2ACCUM(y[p]);
+        ActivationFunction_Diff(1,
+                                &g,
+                                &top_diff,
+                                &bot_data,
+                                &top_data,
+                                CVT_FLOAT2ACCUM(activ_diff_scale),
+                                CVT_FLOAT2ACCUM(activ_gamma),
+                                CVT_FLOAT2ACCUM(activ_beta),
+                                CVT_FLOAT2ACCUM(activ_alpha));
+        dx[p] = CVT_ACCUM2FLOAT(g);
+#else
+        if(dx != dy)
+            dx[p] = dy[p];
+#endif
+        sum += g;
+    }
+
+    partial[lid] = sum;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint s = MIOPEN_BWD_LOCAL_SIZE / 2; s > 0; s >>= 1)
+    {
+        if(lid < s)
+            partial[lid] += partial[lid + s];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    if(lid == 0)
+        dbias[c] = CVT_ACCUM2FLOAT(partial[0]);
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// The statistics of a training batch normalization whose input comes from the convolution of
+// a fusion plan. The convolution adds the sums and the sums of squares of its MIOPEN_BN_C
+// output channels up into the buffers of the saved mean and inverse variance, then the
+// finalize kernel turns them into the saved statistics and updates the running ones.
+// MIOPEN_BN_NHW is the count of the elements of a channel.
+
+__kernel void MIOpenBnTrainStatsInit(__global float* __restrict sum,
+                                     __global float* __restrict sqsum)
+{
+    const uint c = get_global_id(0);
+    if(c >= MIOPEN_BN_C)
+        return;
+    sum[c]   = 0;
+    sqsum[c] = 0;
+}
+
+__kernel void MIOpenBnTrainStatsFinalize(__global float* __restrict sum_mean,
+                                         __global float* __restrict sqsum_inv_variance,
+                                         __global float* __restrict running_mean,
+                                         __global float* __restrict running_variance,
+                                         const double exp_avg_factor,
+                                         const double epsilon)
+{
+    const uint c = get_global_id(0);
+    if(c >= MIOPEN_BN_C)
+        return;
+
+    const float inhw     = 1.0f / MIOPEN_BN_NHW;
+    const float mean     = sum_mean[c] * inhw;
+    const float variance = fmax(sqsum_inv_variance[c] * inhw - mean * mean, 0.0f);
+
+    sum_mean[c]           = mean;
+    sqsum_inv_variance[c] = rsqrt(variance + (float)epsilon);
+
+#if MIOPEN_BN_RUNNING
+    // The running variance is the unbiased one.
+    const float adjust =
+        MIOPEN_BN_NHW == 1 ? variance : variance * (MIOPEN_BN_NHW / (MIOPEN_BN_NHW - 1.0f));
+    const float factor  = (float)exp_avg_factor;
+    running_mean[c]     = (1 - factor) * running_mean[c] + factor * mean;
+    running_variance[c] = (1 - factor) * running_variance[c] + factor * adjust;
+#else
+    (void)running_mean;
+    (void)running_variance;
+    (void)exp_avg_factor;
+#endif
+}
@@ -0,0 +1,293 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT half
+#define _FLOAT_PREC half
+#define EPSILON (_FLOAT)0.0001
+#endif
+#if MIOPEN_USE_FP32 == 1
+#define _FLOAT float
+#define _FLOAT_PREC float
+#define EPSILON (_FLOAT)0.000001
+#endif
+#if MIOPEN_USE_BFP16 == 1
+#include "bfloat16_dev.hpp"
+#define _FLOAT ushort
+#define _FLOAT_PREC float
+#define EPSILON 0.000001f
+#endif
+
+// bfloat16 data is stored as ushort, so it is converted explicitly and the activation arguments,
+// which have no bfloat16 scalar type, are passed as float.
+#if MIOPEN_USE_BFP16 == 1
+#define EPI_LOAD(v) bfloat16_to_float(v)
+#define EPI_STORE(v) float_to_bfloat16(v)
+#define _FLOAT_ARG float
+#else
+#define EPI_LOAD(v) ((_FLOAT_PREC)(v))
+#define EPI_STORE(v) ((_FLOAT)(v))
+#define _FLOAT_ARG _FLOAT
+#endif
+
+#define UNUSED __attribute__((__unused__))
+
+#include "activation_functions.h"
+
+// The epilogue of the fusion plans which are compiled from patterns: applies up to 4
+// elementwise ops, MIOPEN_EPI_OP0 to MIOPEN_EPI_OP3 in order, in a single pass from x to y.
+// x and y may be the same buffer, e.g. the output of the convolution of the plan. A work-item
+// handles MIOPEN_EPI_READ_UNIT neighbouring elements. The arguments of each op follow x and y.
+#define EPI_NONE 0
+#define EPI_BIAS 1
+#define EPI_ACTIV 2
+#define EPI_BN_SPATIAL 3
+#define EPI_BN_PER_ACTIVATION 4
+#define EPI_BN_TRAIN_SPATIAL 5
+#define EPI_TENSOR_OP 6
+#define EPI_SCALE 7
+
+// The batch normalization parameters are fp32 and NCHW-packed for every type and layout.
+#define EPI_BN_PARAMS(k)                                                                  \
+    const __global float *__restrict scale##k, const __global float *__restrict bias##k, \
+        const __global float *__restrict mean##k,                                        \
+        const __global float *__restrict variance##k, const double epsilon##k
+
+// Normalizes with the saved statistics of a training batch normalization, see
+// MIOpenFusionBnTrainStats.cl.
+#define EPI_BN_TRAIN_PARAMS(k)                                                            \
+    const __global float *__restrict scale##k, const __global float *__restrict bias##k, \
+        const __global float *__restrict mean##k,                                        \
+        const __global float *__restrict inv_variance##k
+
+// A tensor op combines the data with its tensor b, which broadcasts along the dimensions whose
+// MIOPEN_EPI_B<k>_STRIDE<d> is 0. The data has up to 5 dimensions of MIOPEN_EPI_LEN<d> elements
+// and MIOPEN_EPI_STRIDE<d> strides, the dimensions which it has not are of length 1.
+#define EPI_TENSOR_PARAMS(k)                                            \
+    const __global _FLOAT *__restrict tensor##k, const float alpha1##k, \
+        const float alpha2##k
+
+// The ops of miopenTensorOp_t.
+static inline float TensorOp(uint op, float a, float b)
+{
+    switch(op)
+    {
+    case 0: return a + b;
+    case 1: return a * b;
+    case 2: return fmin(a, b);
+    default: return fmax(a, b);
+    }
+}
+
+static inline uint Coord(uint i, uint stride, uint len) { return (i / stride) % len; }
+
+#define EPI_B_INDEX(k, i)                                                        \
+    (Coord(i, MIOPEN_EPI_STRIDE0, MIOPEN_EPI_LEN0) * MIOPEN_EPI_B##k##_STRIDE0 + \
+     Coord(i, MIOPEN_EPI_STRIDE1, MIOPEN_EPI_LEN1) * MIOPEN_EPI_B##k##_STRIDE1 + \
+     Coord(i, MIOPEN_EPI_STRIDE2, MIOPEN_EPI_LEN2) * MIOPEN_EPI_B##k##_STRIDE2 + \
+     Coord(i, MIOPEN_EPI_STRIDE3, MIOPEN_EPI_LEN3) * MIOPEN_EPI_B##k##_STRIDE3 + \
+     Coord(i, MIOPEN_EPI_STRIDE4, MIOPEN_EPI_LEN4) * MIOPEN_EPI_B##k##_STRIDE4)
+
+static inline uint Channel(uint i)
+{
+#if MIOPEN_EPI_CHANNELS_LAST
+    return i % MIOPEN_EPI_C;
+#else
+    return (i / MIOPEN_EPI_HW) % MIOPEN_EPI_C;
+#endif
+}
+
+// Index of the per-activation batch normalization parameters of an element.
+static inline uint Activation(uint i)
+{
+#if MIOPEN_EPI_CHANNELS_LAST
+    return (i % MIOPEN_EPI_C) * MIOPEN_EPI_HW + (i / MIOPEN_EPI_C) % MIOPEN_EPI_HW;
+#else
+    return i % (MIOPEN_EPI_C * MIOPEN_EPI_HW);
+#endif
+}
+
+// Applies the op of slot k to the elements of the work-item, which start at base.
+#define EPI_APPLY_BIAS(k)                          \
+    for(uint i = 0; i < MIOPEN_EPI_READ_UNIT; ++i) \
+        data[i] += EPI_LOAD(bias##k[Channel(base + i)]);
+#define EPI_APPLY_ACTIV(k)                                                                \
+    {                                                                                     \
+        _FLOAT_PREC res[MIOPEN_EPI_READ_UNIT];                                            \
+        ActivationFunction(MIOPEN_EPI_READ_UNIT, res, data, gamma##k, beta##k, alpha##k); \
+        for(uint i = 0; i < MIOPEN_EPI_READ_UNIT; ++i)                                    \
+            data[i] = res[i];                                                             \
+    }
+#define EPI_APPLY_BN(k, index)                                                              \
+    for(uint i = 0; i < MIOPEN_EPI_READ_UNIT; ++i)                                          \
+    {                                                                                       \
+        const uint p         = index(base + i);                                             \
+        const float inv_sqrt = rsqrt(variance##k[p] + (float)epsilon##k);                   \
+        data[i] =                                                                           \
+            (_FLOAT_PREC)(scale##k[p] * ((float)data[i] - mean##k[p]) * inv_sqrt + bias##k[p]); \
+    }
+#define EPI_APPLY_BN_TRAIN(k)                                                             \
+    for(uint i = 0; i < MIOPEN_EPI_READ_UNIT; ++i)                                        \
+    {                                                                                     \
+        const uint p  = Channel(base + i);                                                \
+        const float v = scale##k[p] * ((float)data[i] - mean##k[p]) * inv_variance##k[p]; \
+        data[i]       = (_FLOAT_PREC)(v + bias##k[p]);                                    \
+    }
+#define EPI_APPLY_TENSOR(k)                                                        \
+    for(uint i = 0; i < MIOPEN_EPI_READ_UNIT; ++i)                                 \
+    {                                                                              \
+        const float a = alpha1##k * (float)data[i];                                \
+        const float b = alpha2##k * EPI_LOAD(tensor##k[EPI_B_INDEX(k, base + i)]); \
+        data[i]       = (_FLOAT_PREC)TensorOp(MIOPEN_EPI_TENSOR_OP##k, a, b);      \
+    }
+#define EPI_APPLY_SCALE(k)                         \
+    for(uint i = 0; i < MIOPEN_EPI_READ_UNIT; ++i) \
+        data[i] = (_FLOAT_PREC)(scale##k * (float)data[i]);
+
+#if MIOPEN_EPI_OP0 == EPI_BIAS
+#define EPI_PARAMS0 , const __global _FLOAT* __restrict bias0
+#define EPI_APPLY0 EPI_APPLY_BIAS(0)
+#elif MIOPEN_EPI_OP0 == EPI_ACTIV
+#define EPI_PARAMS0 , const _FLOAT_ARG alpha0, const _FLOAT_ARG beta0, const _FLOAT_ARG gamma0
+#define EPI_APPLY0 EPI_APPLY_ACTIV(0)
+#elif MIOPEN_EPI_OP0 == EPI_BN_SPATIAL
+#define EPI_PARAMS0 , EPI_BN_PARAMS(0)
+#define EPI_APPLY0 EPI_APPLY_BN(0, Channel)
+#elif MIOPEN_EPI_OP0 == EPI_BN_PER_ACTIVATION
+#define EPI_PARAMS0 , EPI_BN_PARAMS(0)
+#define EPI_APPLY0 EPI_APPLY_BN(0, Activation)
+#elif MIOPEN_EPI_OP0 == EPI_BN_TRAIN_SPATIAL
+#define EPI_PARAMS0 , EPI_BN_TRAIN_PARAMS(0)
+#define EPI_APPLY0 EPI_APPLY_BN_TRAIN(0)
+#elif MIOPEN_EPI_OP0 == EPI_TENSOR_OP
+#define EPI_PARAMS0 , EPI_TENSOR_PARAMS(0)
+#define EPI_APPLY0 EPI_APPLY_TENSOR(0)
+#elif MIOPEN_EPI_OP0 == EPI_SCALE
+#define EPI_PARAMS0 , const float scale0
+#define EPI_APPLY0 EPI_APPLY_SCALE(0)
+#else
+#define EPI_PARAMS0
+#define EPI_APPLY0
+#endif
+
+#if MIOPEN_EPI_OP1 == EPI_BIAS
+#define EPI_PARAMS1 , const __global _FLOAT* __restrict bias1
+#define EPI_APPLY1 EPI_APPLY_BIAS(1)
+#elif MIOPEN_EPI_OP1 == EPI_ACTIV
+#define EPI_PARAMS1 , const _FLOAT_ARG alpha1, const _FLOAT_ARG beta1, const _FLOAT_ARG gamma1
+#define EPI_APPLY1 EPI_APPLY_ACTIV(1)
+#elif MIOPEN_EPI_OP1 == EPI_BN_SPATIAL
+#define EPI_PARAMS1 , EPI_BN_PARAMS(1)
+#define EPI_APPLY1 EPI_APPLY_BN(1, Channel)
+#elif MIOPEN_EPI_OP1 == EPI_BN_PER_ACTIVATION
+#define EPI_PARAMS1 , EPI_BN_PARAMS(1)
+#define EPI_APPLY1 EPI_APPLY_BN(1, Activation)
+#elif MIOPEN_EPI_OP1 == EPI_BN_TRAIN_SPATIAL
+#define EPI_PARAMS1 , EPI_BN_TRAIN_PARAMS(1)
+#define EPI_APPLY1 EPI_APPLY_BN_TRAIN(1)
+#elif MIOPEN_EPI_OP1 == EPI_TENSOR_OP
+#define EPI_PARAMS1 , EPI_TENSOR_PARAMS(1)
+#define EPI_APPLY1 EPI_APPLY_TENSOR(1)
+#elif MIOPEN_EPI_OP1 == EPI_SCALE
+#define EPI_PARAMS1 , const float scale1
+#define EPI_APPLY1 EPI_APPLY_SCALE(1)
+#else
+#define EPI_PARAMS1
+#define EPI_APPLY1
+#endif
+
+#if MIOPEN_EPI_OP2 == EPI_BIAS
+#define EPI_PARAMS2 , const __global _FLOAT* __restrict bias2
+#define EPI_APPLY2 EPI_APPLY_BIAS(2)
+#elif MIOPEN_EPI_OP2 == EPI_ACTIV
+#define EPI_PARAMS2 , const _FLOAT_ARG alpha2, const _FLOAT_ARG beta2, const _FLOAT_ARG gamma2
+#define EPI_APPLY2 EPI_APPLY_ACTIV(2)
+#elif MIOPEN_EPI_OP2 == EPI_BN_SPATIAL
+#define EPI_PARAMS2 , EPI_BN_PARAMS(2)
+#define EPI_APPLY2 EPI_APPLY_BN(2, Channel)
+#elif MIOPEN_EPI_OP2 == EPI_BN_PER_ACTIVATION
+#define EPI_PARAMS2 , EPI_BN_PARAMS(2)
+#define EPI_APPLY2 EPI_APPLY_BN(2, Activation)
+#elif MIOPEN_EPI_OP2 == EPI_BN_TRAIN_SPATIAL
+#define EPI_PARAMS2 , EPI_BN_TRAIN_PARAMS(2)
+#define EPI_APPLY2 EPI_APPLY_BN_TRAIN(2)
+#elif MIOPEN_EPI_OP2 == EPI_TENSOR_OP
+#define EPI_PARAMS2 , EPI_TENSOR_PARAMS(2)
+#define EPI_APPLY2 EPI_APPLY_TENSOR(2)
+#elif MIOPEN_EPI_OP2 == EPI_SCALE
+#define EPI_PARAMS2 , const float scale2
+#define EPI_APPLY2 EPI_APPLY_SCALE(2)
+#else
+#define EPI_PARAMS2
+#define EPI_APPLY2
+#endif
+
+#if MIOPEN_EPI_OP3 == EPI_BIAS
+#define EPI_PARAMS3 , const __global _FLOAT* __restrict bias3
+#define EPI_APPLY3 EPI_APPLY_BIAS(3)
+#elif MIOPEN_EPI_OP3 == EPI_ACTIV
+#define EPI_PARAMS3 , const _FLOAT_ARG alpha3, const _FLOAT_ARG beta3, const _FLOAT_ARG gamma3
+#define EPI_APPLY3 EPI_APPLY_ACTIV(3)
+#elif MIOPEN_EPI_OP3 == EPI_BN_SPATIAL
+#define EPI_PARAMS3 , EPI_BN_PARAMS(3)
+#define EPI_APPLY3 EPI_APPLY_BN(3, Channel)
+#elif MIOPEN_EPI_OP3 == EPI_BN_PER_ACTIVATION
+#define EPI_PARAMS3 , EPI_BN_PARAMS(3)
+#define EPI_APPLY3 EPI_APPLY_BN(3, Activation)
+#elif MIOPEN_EPI_OP3 == EPI_BN_TRAIN_SPATIAL
+#define EPI_PARAMS3 , EPI_BN_TRAIN_PARAMS(3)
+#define EPI_APPLY3 EPI_APPLY_BN_TRAIN(3)
+#elif MIOPEN_EPI_OP3 == EPI_TENSOR_OP
+#define EPI_PARAMS3 , EPI_TENSOR_PARAMS(3)
+#define EPI_APPLY3 EPI_APPLY_TENSOR(3)
+#elif MIOPEN_EPI_OP3 == EPI_SCALE
+#define EPI_PARAMS3 , const float scale3
+#define EPI_APPLY3 EPI_APPLY_SCALE(3)
+#else
+#define EPI_PARAMS3
+#define EPI_APPLY3
+#endif
+
+__kernel void MIOpenFusionEpilogue(const __global _FLOAT* x,
+                                   __global _FLOAT* y EPI_PARAMS0 EPI_PARAMS1 EPI_PARAMS2
+                                       EPI_PARAMS3)
+{
+    const uint base = get_global_id(0) * MIOPEN_EPI_READ_UNIT;
+    if(base >= MIOPEN_EPI_TOTAL)
+        return;
+
+    _FLOAT_PREC data[MIOPEN_EPI_READ_UNIT];
+    for(uint i = 0; i < MIOPEN_EPI_READ_UNIT; ++i)
+        data[i] = EPI_LOAD(x[base + i]);
+
+    EPI_APPLY0
+    EPI_APPLY1
+    EPI_APPLY2
+    EPI_APPLY3
+
+    for(uint i = 0; i < MIOPEN_EPI_READ_UNIT; ++i)
+        y[base + i] = EPI_STORE(data[i]);
+}
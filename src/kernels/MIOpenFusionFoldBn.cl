@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT half
+#endif
+#if MIOPEN_USE_FP32 == 1
+#define _FLOAT float
+#endif
+
+// Folds an inference batch normalization into the convolution in front of it:
+// y = scale * (conv(x, w) + bias - mean) / sqrt(variance + epsilon) + bn_bias
+//   = conv(x, w * s) + (bias - mean) * s + bn_bias, with s = scale / sqrt(variance + epsilon)
+// for each of the MIOPEN_FOLD_K output channels. The weights are packed with the output
+// channels outermost, MIOPEN_FOLD_W_PER_K elements each. The batch normalization parameters are
+// fp32 for every type.
+
+static inline float FoldScale(const __global float* __restrict scale,
+                              const __global float* __restrict variance,
+                              const double epsilon,
+                              uint k)
+{
+    return scale[k] * rsqrt(variance[k] + (float)epsilon);
+}
+
+__kernel void MIOpenFoldBnWeights(const __global _FLOAT* __restrict w,
+                                  const __global float* __restrict scale,
+                                  const __global float* __restrict variance,
+                                  const double epsilon,
+                                  __global _FLOAT* __restrict folded_w)
+{
+    const uint i = get_global_id(0);
+    if(i >= MIOPEN_FOLD_K * MIOPEN_FOLD_W_PER_K)
+        return;
+    const uint k = i / MIOPEN_FOLD_W_PER_K;
+    folded_w[i]  = (_FLOAT)((float)w[i] * FoldScale(scale, variance, epsilon, k));
+}
+
+// bias is the one of the convolution if MIOPEN_FOLD_HAS_BIAS, else unused.
+__kernel void MIOpenFoldBnBias(const __global _FLOAT* __restrict bias,
+                               const __global float* __restrict scale,
+                               const __global float* __restrict bn_bias,
+                               const __global float* __restrict mean,
+                               const __global float* __restrict variance,
+                               const double epsilon,
+                               __global _FLOAT* __restrict folded_bias)
+{
+    const uint k = get_global_id(0);
+    if(k >= MIOPEN_FOLD_K)
+        return;
+#if MIOPEN_FOLD_HAS_BIAS
+    const float b = (float)bias[k];
+#else
+    (void)bias;
+    const float b = 0;
+#endif
+    folded_bias[k] = (_FLOAT)((b - mean[k]) * FoldScale(scale, variance, epsilon, k) + bn_bias[k]);
+}
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "float_types.h"
+
+// The last op of the fusion plans which end with a pooling: applies the elementwise ops of the
+// plan after its convolution to the full-resolution data x on the fly and pools it into y, so
+// that the activated data is never written. A work-item computes an output element of the
+// MIOPEN_POOL_N * MIOPEN_POOL_C NCHW-packed images. MIOPEN_POOL_OP is a miopenPoolingMode_t.
+#define POOL_MAX 0
+#define POOL_AVERAGE 1
+#define POOL_AVERAGE_INCLUSIVE 2
+
+#if MIOPEN_POOL_BIAS
+#define POOL_BIAS_PARAMS , const __global _FLOAT* __restrict bias
+#else
+#define POOL_BIAS_PARAMS
+#endif
+#if MIOPEN_POOL_ACTIV
+#define _FLOAT_PREC _FLOAT_ACCUM
+#define UNUSED __attribute__((__unused__))
+#if MIOPEN_USE_FP16 == 1
+#define EPSILON (_FLOAT)0.0001
+#else
+#define EPSILON (_FLOAT)0.000001
+#endif
+#include "activation_functions.h"
+#define POOL_ACTIV_PARAMS \
+    , const _FLOAT activ_alpha, const _FLOAT activ_beta, const _FLOAT activ_gamma
+#else
+#define POOL_ACTIV_PARAMS
+#endif
+// Max pooling saves the indices of the maxima into mask unless it is null, as an index in the
+// image with MIOPEN_POOL_IMG_INDEX and in the window otherwise, like MIOpenPooling.cl.
+#if MIOPEN_POOL_OP == POOL_MAX
+typedef MIOPEN_POOL_INDEX_TYPE index_t;
+#define POOL_INDEX_PARAMS , __global index_t* __restrict mask
+#else
+#define POOL_INDEX_PARAMS
+#endif
+
+#define POOL_TOTAL (MIOPEN_POOL_N * MIOPEN_POOL_C * MIOPEN_POOL_HO * MIOPEN_POOL_WO)
+
+__kernel void MIOpenFusionPool(const __global _FLOAT* __restrict x,
+                               __global _FLOAT* __restrict y POOL_BIAS_PARAMS POOL_ACTIV_PARAMS
+                                   POOL_INDEX_PARAMS)
+{
+    const uint o = get_global_id(0);
+    if(o >= POOL_TOTAL)
+        return;
+    const uint wo = o % MIOPEN_POOL_WO;
+    const uint ho = (o / MIOPEN_POOL_WO) % MIOPEN_POOL_HO;
+    const uint nc = o / (MIOPEN_POOL_WO * MIOPEN_POOL_HO);
+#if MIOPEN_POOL_BIAS
+    const _FLOAT_ACCUM b = CVT_FLOAT2ACCUM(bias[nc % MIOPEN_POOL_C]);
+#endif
+    const int h0 = (int)(ho * MIOPEN_POOL_SH) - MIOPEN_POOL_PH;
+    const int w0 = (int)(wo * MIOPEN_POOL_SW) - MIOPEN_POOL_PW;
+    const __global _FLOAT* image = x + nc * MIOPEN_POOL_HI * MIOPEN_POOL_WI;
+
+#if MIOPEN_POOL_OP == POOL_MAX
+    _FLOAT_ACCUM res = (_FLOAT_ACCUM)(-MAX_VAL);
+    index_t index    = 0;
+#else
+    _FLOAT_ACCUM res = (_FLOAT_ACCUM)0;
+    uint count       = 0;
+#endif
+    for(uint j = 0; j < MIOPEN_POOL_KH; ++j)
+    {
+        const int h = h0 + (int)j;
+        if(h < 0 || h >= MIOPEN_POOL_HI)
+            continue;
+        for(uint i = 0; i < MIOPEN_POOL_KW; ++i)
+        {
+            const int w = w0 + (int)i;
+            if(w < 0 || w >= MIOPEN_POOL_WI)
+                continue;
+            _FLOAT_ACCUM v = CVT_FLOAT2ACCUM(image[h * MIOPEN_POOL_WI + w]);
+#if MIOPEN_POOL_BIAS
+            v += b;
+#endif
+#if MIOPEN_POOL_ACTIV
+            const _FLOAT_ACCUM pre = v;
+            ActivationFunction(1,
+                               &v,
+                               &pre,
+                               CVT_FLOAT2ACCUM(activ_gamma),
+                               CVT_FLOAT2ACCUM(activ_beta),
+                               CVT_FLOAT2ACCUM(activ_alpha));
+#endif
+#if MIOPEN_POOL_OP == POOL_MAX
+            if(v > res)
+            {
+                res = v;
+#if MIOPEN_POOL_IMG_INDEX
+                index = (index_t)(h * MIOPEN_POOL_WI + w);
+#else
+                index = (index_t)(i + MIOPEN_POOL_KW * j);
+#endif
+            }
+#else
+            res += v;
+            ++count;
+#endif
+        }
+    }
+
+#if MIOPEN_POOL_OP == POOL_AVERAGE_INCLUSIVE
+    res /= (_FLOAT_ACCUM)(MIOPEN_POOL_KH * MIOPEN_POOL_KW);
+#elif MIOPEN_POOL_OP == POOL_AVERAGE
+    res /= (_FLOAT_ACCUM)(count == 0 ? 1 : count);
+#endif
+    y[o] = CVT_ACCUM2FLOAT(res);
+#if MIOPEN_POOL_OP == POOL_MAX
+    if(mask != 0)
+        mask[o] = index;
+#endif
+}
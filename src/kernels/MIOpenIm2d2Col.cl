@@ -63,6 +63,12 @@ typedef short data_t;
 typedef float data_t;
 #endif
 
+// The whole image of a channel is only staged in LDS when it holds no more rows than the output
+// rows being converted read. A chunk of the output rows of a tall image takes the tiled path.
+#ifndef WHOLE_IM_IN_LDS
+#define WHOLE_IM_IN_LDS 1
+#endif
+
 /* Simple GPU implementation - number of threads launced == sizeof im2col buffer
  * Each thread writes one pixel of output. First (out_h*out_w) threads write to
  * the first line (row) of the im2col output.
@@ -133,7 +139,7 @@ kernel void Im2d2Col(const int data_size_off,
     int gid               = get_group_id(0);
 
 #ifndef EXTREME_LARGE
-#if NUM_IM_BLKS == 1 && STRIDE_GT_1 == 0
+#if NUM_IM_BLKS == 1 && STRIDE_GT_1 == 0 && WHOLE_IM_IN_LDS
 
     // Load image into LDS
     local data_t local_im[LOCAL_MEM_SIZE];
@@ -175,7 +181,7 @@ kernel void Im2d2Col(const int data_size_off,
         }
     }
 
-#else  // NUM_IM_BLKS > 1 || STRIDE_GT_1 1
+#else  // NUM_IM_BLKS > 1 || STRIDE_GT_1 1 || !WHOLE_IM_IN_LDS
 
     local data_t local_im[LOCAL_MEM_SIZE];
 
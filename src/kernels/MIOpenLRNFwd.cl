@@ -50,6 +50,36 @@
 #define MLO_LRN_GROUP_SZ2 1
 #define MLO_LRN_STRIDE 1
 
+#ifndef MLO_LRN_DYNAMIC_SHAPE
+#define MLO_LRN_DYNAMIC_SHAPE 0
+#endif
+
+// In the dynamic shape mode of MIOpenLRNWithinChannel_PS, only the tiling is compiled in and the
+// shape of the tensors is passed in the trailing kernel arguments, so that a program serves all
+// the shapes of the same tiling.
+#if MLO_LRN_DYNAMIC_SHAPE
+#define MLO_LRN_SHAPE_ARGS                                                                     \
+    , int mlo_batch_sz, int mlo_bot_batch_str, int mlo_bot_channel_str, int mlo_bot_str,     \
+        int mlo_top_batch_str, int mlo_top_channel_str, int mlo_top_str, int mlo_top_width, \
+        int mlo_top_height
+#define MLO_LRN_BATCH_SZ mlo_batch_sz
+#define MLO_LRN_BOT_BATCH_STRIDE mlo_bot_batch_str
+#define MLO_LRN_BOT_CHANNEL_STRIDE mlo_bot_channel_str
+#define MLO_LRN_BOT_STRIDE mlo_bot_str
+#define MLO_LRN_BOT_WIDTH mlo_top_width
+#define MLO_LRN_BOT_HEIGHT mlo_top_height
+#define MLO_LRN_TOP_BATCH_STRIDE mlo_top_batch_str
+#define MLO_LRN_TOP_CHANNEL_STRIDE mlo_top_channel_str
+#define MLO_LRN_TOP_STRIDE mlo_top_str
+#define MLO_LRN_TOP_WIDTH mlo_top_width
+#define MLO_LRN_TOP_HEIGHT mlo_top_height
+#define MLO_LRN_SCALE_BATCH_STRIDE mlo_top_batch_str
+#define MLO_LRN_SCALE_CHANNEL_STRIDE mlo_top_channel_str
+#define MLO_LRN_SCALE_STRIDE mlo_top_str
+#else
+#define MLO_LRN_SHAPE_ARGS
+#endif
+
 #define MLO_LRN_LEFT_PAD0 (((MLO_LRN_PRE_PAD0 + MLO_READ_UNIT - 1) / MLO_READ_UNIT) * MLO_READ_UNIT)
 #define MLO_LRN_RIGHT_SIDE                                                               \
     (((MLO_LRN_GROUP_SZ0 * MLO_LRN_N_HORIZ_OUT_PIX + MLO_LRN_PAD0 + MLO_READ_UNIT - 1) / \
@@ -80,7 +110,7 @@ MIOpenLRNWithinChannel_PS(const __global _FLOAT* bot,
                           _FLOAT alphaoverarea,
                           UNUSED _FLOAT alpha,
                           _FLOAT beta,
-                          _FLOAT K)
+                          _FLOAT K MLO_LRN_SHAPE_ARGS)
 {
     // IT's taken from POOLING AVE with stride = 1'
     __local _FLOAT bot_data[MLO_LRN_LCL_DATA_WIDTH * MLO_LRN_LCL_DATA_HEIGHT];
@@ -389,6 +419,7 @@ MIOpenLRNWithinChannel_PS(const __global _FLOAT* bot,
     }
 }
 
+#if !MLO_LRN_DYNAMIC_SHAPE
 #if(MLO_LRN_N_INPUTS < MLO_LRN_KERNEL_SZ)
 #define MLO_LOW_CHNL_COUNT 1
 #else
@@ -699,3 +730,4 @@ MIOpenLRNAcrossChannels4(const __global _FLOAT* bottom,
         }
     }
 }
+#endif // !MLO_LRN_DYNAMIC_SHAPE
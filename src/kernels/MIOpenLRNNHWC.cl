@@ -0,0 +1,242 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Cross-channel LRN of packed NHWC tensors. Work-items (x, y) of a work-group own the channel
+// vectors x, x + MLO_LRN_GROUP_SZ0, ... of pixel y and keep them in registers. The squares
+// (forward) or y * dy / scale (backward) of the whole pixel go to local memory with zero padding
+// on both sides, so a window sum is a run of local reads that slides over the channels of a vector
+// by one addition and one subtraction per channel.
+//
+// The forward window of channel c is [c - MLO_LRN_PRE_PAD, c + MLO_LRN_PAD], the backward one is
+// mirrored; the host passes the padding of the side in front of the channel as MLO_LRN_PRE_PAD.
+
+#if MIOPEN_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#define _FLOAT half
+#endif
+#if MIOPEN_USE_FP32 == 1
+#define _FLOAT float
+#endif
+
+#define PPCAT_NX(A, B) A##B
+#define PPCAT(A, B) PPCAT_NX(A, B)
+#define TWO 2
+#define FOUR 4
+#define _FLOAT2 PPCAT(_FLOAT, TWO)
+#define _FLOAT4 PPCAT(_FLOAT, FOUR)
+
+#define UNUSED __attribute__((__unused__))
+
+#ifndef MLO_LRN_VEC
+#define MLO_LRN_VEC 1
+#endif
+
+#ifndef MLO_LRN_DO_SCALE
+#define MLO_LRN_DO_SCALE 0
+#endif
+
+#define MLO_LRN_CVECS (MLO_LRN_C / MLO_LRN_VEC)
+#define MLO_LRN_NCACHE ((MLO_LRN_CVECS + MLO_LRN_GROUP_SZ0 - 1) / MLO_LRN_GROUP_SZ0)
+#define MLO_LRN_LCL_WIDTH (MLO_LRN_C + MLO_LRN_KERNEL_SZ - 1)
+
+static inline void lrn_load(const global _FLOAT* p, float* v)
+{
+#if MLO_LRN_VEC == 4
+    const _FLOAT4 t = vload4(0, p);
+    v[0]            = (float)t.x;
+    v[1]            = (float)t.y;
+    v[2]            = (float)t.z;
+    v[3]            = (float)t.w;
+#elif MLO_LRN_VEC == 2
+    const _FLOAT2 t = vload2(0, p);
+    v[0]            = (float)t.x;
+    v[1]            = (float)t.y;
+#else
+    v[0] = (float)(*p);
+#endif
+}
+
+static inline void lrn_store(global _FLOAT* p, const float* v)
+{
+#if MLO_LRN_VEC == 4
+    vstore4((_FLOAT4)((_FLOAT)v[0], (_FLOAT)v[1], (_FLOAT)v[2], (_FLOAT)v[3]), 0, p);
+#elif MLO_LRN_VEC == 2
+    vstore2((_FLOAT2)((_FLOAT)v[0], (_FLOAT)v[1]), 0, p);
+#else
+    *p = (_FLOAT)v[0];
+#endif
+}
+
+/// Zeroes the padding of the row of the pixel; the channels are written by the caller.
+static inline void lrn_clear_pads(local float* row)
+{
+    for(uint i = get_local_id(0); i < MLO_LRN_KERNEL_SZ - 1; i += MLO_LRN_GROUP_SZ0)
+        row[i < MLO_LRN_PRE_PAD ? i : MLO_LRN_C + i] = 0.0f;
+}
+
+/// Window sums of the channels of the vector starting at channel c.
+static inline void lrn_window(const local float* row, uint c, float* sum)
+{
+    float acc = 0.0f;
+    for(uint k = 0; k < MLO_LRN_KERNEL_SZ; k++)
+        acc += row[c + k];
+    sum[0] = acc;
+    for(uint k = 1; k < MLO_LRN_VEC; k++)
+    {
+        acc += row[c + k + MLO_LRN_KERNEL_SZ - 1] - row[c + k - 1];
+        sum[k] = acc;
+    }
+}
+
+__attribute__((reqd_work_group_size(MLO_LRN_GROUP_SZ0, MLO_LRN_GROUP_SZ1, 1))) __kernel void
+MIOpenLRNCrossChannelNHWCFwd(const __global _FLOAT* bottom,
+                             __global _FLOAT* top,
+#if !MLO_LRN_DO_SCALE
+                             UNUSED
+#endif
+                                 __global _FLOAT* scale,
+                             const float alphaoverarea,
+                             const float beta,
+                             const float K,
+                             const uint pixels)
+{
+    local float lcl_sq[MLO_LRN_GROUP_SZ1 * MLO_LRN_LCL_WIDTH];
+
+    const uint pix    = get_global_id(1);
+    const bool active = pix < pixels;
+    local float* row  = lcl_sq + get_local_id(1) * MLO_LRN_LCL_WIDTH;
+    const uint base   = pix * MLO_LRN_C;
+
+    float x[MLO_LRN_NCACHE][MLO_LRN_VEC];
+    lrn_clear_pads(row);
+    for(uint j = 0; j < MLO_LRN_NCACHE; j++)
+    {
+        const uint i = get_local_id(0) + j * MLO_LRN_GROUP_SZ0;
+        if(i < MLO_LRN_CVECS)
+        {
+            if(active)
+                lrn_load(bottom + base + i * MLO_LRN_VEC, x[j]);
+            for(uint k = 0; k < MLO_LRN_VEC; k++)
+            {
+                if(!active)
+                    x[j][k] = 0.0f;
+                row[MLO_LRN_PRE_PAD + i * MLO_LRN_VEC + k] = x[j][k] * x[j][k];
+            }
+        }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    if(!active)
+        return;
+
+    for(uint j = 0; j < MLO_LRN_NCACHE; j++)
+    {
+        const uint i = get_local_id(0) + j * MLO_LRN_GROUP_SZ0;
+        if(i >= MLO_LRN_CVECS)
+            break;
+
+        float sum[MLO_LRN_VEC];
+        float scl[MLO_LRN_VEC];
+        lrn_window(row, i * MLO_LRN_VEC, sum);
+        for(uint k = 0; k < MLO_LRN_VEC; k++)
+        {
+            scl[k]  = K + sum[k] * alphaoverarea;
+            x[j][k] = x[j][k] * exp(-beta * log(scl[k]));
+        }
+        lrn_store(top + base + i * MLO_LRN_VEC, x[j]);
+#if MLO_LRN_DO_SCALE
+        lrn_store(scale + base + i * MLO_LRN_VEC, scl);
+#endif
+    }
+}
+
+/// dx = scale^-beta * dy - ratio * x * sum(y * dy / scale) over the mirrored window.
+__attribute__((reqd_work_group_size(MLO_LRN_GROUP_SZ0, MLO_LRN_GROUP_SZ1, 1))) __kernel void
+MIOpenLRNCrossChannelNHWCBwd(const __global _FLOAT* top,
+                             const __global _FLOAT* bot,
+                             const __global _FLOAT* top_df,
+                             const __global _FLOAT* scale,
+                             __global _FLOAT* bot_df,
+                             const float ratio,
+                             const float beta,
+                             const uint pixels)
+{
+    local float lcl_r[MLO_LRN_GROUP_SZ1 * MLO_LRN_LCL_WIDTH];
+
+    const uint pix    = get_global_id(1);
+    const bool active = pix < pixels;
+    local float* row  = lcl_r + get_local_id(1) * MLO_LRN_LCL_WIDTH;
+    const uint base   = pix * MLO_LRN_C;
+
+    // Keeps scale^-beta * dy of every channel of the work-item.
+    float d[MLO_LRN_NCACHE][MLO_LRN_VEC];
+    lrn_clear_pads(row);
+    for(uint j = 0; j < MLO_LRN_NCACHE; j++)
+    {
+        const uint i = get_local_id(0) + j * MLO_LRN_GROUP_SZ0;
+        if(i < MLO_LRN_CVECS)
+        {
+            float y[MLO_LRN_VEC];
+            float s[MLO_LRN_VEC];
+            for(uint k = 0; k < MLO_LRN_VEC; k++)
+            {
+                y[k]    = 0.0f;
+                s[k]    = 1.0f;
+                d[j][k] = 0.0f;
+            }
+            if(active)
+            {
+                lrn_load(top + base + i * MLO_LRN_VEC, y);
+                lrn_load(top_df + base + i * MLO_LRN_VEC, d[j]);
+                lrn_load(scale + base + i * MLO_LRN_VEC, s);
+            }
+            for(uint k = 0; k < MLO_LRN_VEC; k++)
+            {
+                row[MLO_LRN_PRE_PAD + i * MLO_LRN_VEC + k] = y[k] * d[j][k] / s[k];
+                d[j][k] *= exp(-beta * log(s[k]));
+            }
+        }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    if(!active)
+        return;
+
+    for(uint j = 0; j < MLO_LRN_NCACHE; j++)
+    {
+        const uint i = get_local_id(0) + j * MLO_LRN_GROUP_SZ0;
+        if(i >= MLO_LRN_CVECS)
+            break;
+
+        float sum[MLO_LRN_VEC];
+        float x[MLO_LRN_VEC];
+        lrn_window(row, i * MLO_LRN_VEC, sum);
+        lrn_load(bot + base + i * MLO_LRN_VEC, x);
+        for(uint k = 0; k < MLO_LRN_VEC; k++)
+            d[j][k] -= ratio * x[k] * sum[k];
+        lrn_store(bot_df + base + i * MLO_LRN_VEC, d[j]);
+    }
+}
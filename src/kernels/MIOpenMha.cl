@@ -0,0 +1,508 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Fused scaled dot product attention O = dropout(softmax(scale * Q * K^T + mask)) * V of
+// packed [B, H, S, D] tensors, one (batch, head) pair per work-group row of the grid.
+//
+// Forward walks the keys in tiles and keeps the running maximum, the running sum and the
+// unnormalized output of its query tile in registers (the online softmax), so the Sq x Sk
+// probabilities never leave the work-group. It saves the log-sum-exp of every query row, from
+// which backward recomputes the probabilities tile by tile:
+//  - MIOpenMhaBwdDot: dsum = rowsum(dO * O),
+//  - MIOpenMhaBwdKV: a key tile per work-group accumulates dK and dV over the query tiles,
+//  - MIOpenMhaBwdQ: a query tile per work-group accumulates dQ over the key tiles.
+// Every gradient element is owned by one work-item, so backward needs no atomics.
+//
+// MIO_MHA_CAUSAL masks out the keys after the query (key > query). With MIO_MHA_DROPOUT the
+// probability of query i and key j is dropped when philox_uniform_2d(seed, offset, bh * Sq + i,
+// j) is not above the rate; the mask is regenerated wherever it is needed and stored nowhere.
+
+#include "float_types.h"
+
+#ifndef MIO_MHA_CAUSAL
+#define MIO_MHA_CAUSAL 0
+#endif
+
+#ifndef MIO_MHA_DROPOUT
+#define MIO_MHA_DROPOUT 0
+#endif
+
+#if MIO_MHA_DROPOUT
+#include "philox.h"
+#endif
+
+#define MIO_MHA_GRP 256
+
+// Forward tiles: a lane group of MIO_MHA_FWD_LANES work-items per query row.
+#define MIO_MHA_FWD_BR 32
+#define MIO_MHA_FWD_BC 32
+#define MIO_MHA_FWD_LANES (MIO_MHA_GRP / MIO_MHA_FWD_BR)
+#define MIO_MHA_FWD_CPL (MIO_MHA_FWD_BC / MIO_MHA_FWD_LANES)
+#define MIO_MHA_FWD_DPL ((MIO_MHA_D + MIO_MHA_FWD_LANES - 1) / MIO_MHA_FWD_LANES)
+
+// Backward tiles: a score per work-item, a lane group of MIO_MHA_BWD_B work-items per row.
+#define MIO_MHA_BWD_B 16
+#define MIO_MHA_BWD_DPL ((MIO_MHA_D + MIO_MHA_BWD_B - 1) / MIO_MHA_BWD_B)
+
+// The rows of the tiles in local memory are padded against bank conflicts.
+#define MIO_MHA_STRIDE (MIO_MHA_D + 1)
+
+/// Rows [first, first + rows) of a [n, D] matrix to local memory, zeros past n.
+static inline void mha_load_tile(local _FLOAT_ACCUM* tile,
+                                 const global _FLOAT* __restrict src,
+                                 uint first,
+                                 uint rows,
+                                 uint n,
+                                 uint lid)
+{
+    for(uint i = lid; i < rows * MIO_MHA_D; i += MIO_MHA_GRP)
+    {
+        const uint r = i / MIO_MHA_D;
+        const uint d = i % MIO_MHA_D;
+        tile[r * MIO_MHA_STRIDE + d] =
+            first + r < n ? CVT_FLOAT2ACCUM(src[(ulong)(first + r) * MIO_MHA_D + d]) : 0.0f;
+    }
+}
+
+static inline _FLOAT_ACCUM mha_dot(local const _FLOAT_ACCUM* a, local const _FLOAT_ACCUM* b)
+{
+    _FLOAT_ACCUM sum = 0.0f;
+    for(uint d = 0; d < MIO_MHA_D; d++)
+        sum = mad(a[d], b[d], sum);
+    return sum;
+}
+
+static inline bool mha_visible(uint query, uint key)
+{
+#if MIO_MHA_CAUSAL
+    return query < MIO_MHA_SQ && key < MIO_MHA_SK && key <= query;
+#else
+    return query < MIO_MHA_SQ && key < MIO_MHA_SK;
+#endif
+}
+
+/// Dropout factor of a probability: the amplification if it is kept, 0 otherwise.
+static inline _FLOAT_ACCUM mha_drop(
+    float dropout, float dropout_scale, ulong seed, ulong offset, uint row, uint key)
+{
+#if MIO_MHA_DROPOUT
+    return philox_uniform_2d(seed, offset, row, key) > dropout ? dropout_scale : 0.0f;
+#else
+    (void)dropout;
+    (void)dropout_scale;
+    (void)seed;
+    (void)offset;
+    (void)row;
+    (void)key;
+    return 1.0f;
+#endif
+}
+
+/// A work-group per MIO_MHA_FWD_BR queries of a (batch, head) pair.
+__attribute__((reqd_work_group_size(MIO_MHA_GRP, 1, 1))) __kernel void
+MIOpenMhaFwd(const global _FLOAT* __restrict q,
+             const global _FLOAT* __restrict k,
+             const global _FLOAT* __restrict v,
+             global _FLOAT* __restrict o,
+             global float* __restrict lse,
+             float scale,
+             float dropout,
+             float dropout_scale,
+             ulong seed,
+             ulong offset)
+{
+    local _FLOAT_ACCUM q_tile[MIO_MHA_FWD_BR * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM kv_tile[MIO_MHA_FWD_BC * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM p_tile[MIO_MHA_FWD_BR * MIO_MHA_FWD_BC];
+    local _FLOAT_ACCUM max_tile[MIO_MHA_FWD_BR * MIO_MHA_FWD_LANES];
+    local _FLOAT_ACCUM sum_tile[MIO_MHA_FWD_BR * MIO_MHA_FWD_LANES];
+
+    const uint lid   = get_local_id(0);
+    const uint row   = lid / MIO_MHA_FWD_LANES;
+    const uint lane  = lid % MIO_MHA_FWD_LANES;
+    const uint q0    = get_group_id(0) * MIO_MHA_FWD_BR;
+    const uint bh    = get_group_id(1);
+    const uint query = q0 + row;
+
+    const global _FLOAT* qh = q + (ulong)bh * MIO_MHA_SQ * MIO_MHA_D;
+    const global _FLOAT* kh = k + (ulong)bh * MIO_MHA_SK * MIO_MHA_D;
+    const global _FLOAT* vh = v + (ulong)bh * MIO_MHA_SK * MIO_MHA_D;
+
+    mha_load_tile(q_tile, qh, q0, MIO_MHA_FWD_BR, MIO_MHA_SQ, lid);
+
+    _FLOAT_ACCUM acc[MIO_MHA_FWD_DPL];
+    for(uint i = 0; i < MIO_MHA_FWD_DPL; i++)
+        acc[i] = 0.0f;
+    // The running maximum starts finite, so that the correction exp(m - m_new) is never NaN. The
+    // rows past Sq see no key and are not written.
+    _FLOAT_ACCUM m = -FLT_MAX;
+    _FLOAT_ACCUM l = 0.0f;
+
+    // With the causal mask the keys past the last query of the tile are all masked out.
+#if MIO_MHA_CAUSAL
+    const uint k_end = min((uint)MIO_MHA_SK, q0 + MIO_MHA_FWD_BR);
+#else
+    const uint k_end = MIO_MHA_SK;
+#endif
+    for(uint k0 = 0; k0 < k_end; k0 += MIO_MHA_FWD_BC)
+    {
+        barrier(CLK_LOCAL_MEM_FENCE);
+        mha_load_tile(kv_tile, kh, k0, MIO_MHA_FWD_BC, MIO_MHA_SK, lid);
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        // A lane covers MIO_MHA_FWD_CPL consecutive keys, which share a Philox call.
+        _FLOAT_ACCUM s[MIO_MHA_FWD_CPL];
+        _FLOAT_ACCUM s_max = -INFINITY;
+        for(uint j = 0; j < MIO_MHA_FWD_CPL; j++)
+        {
+            const uint c = lane * MIO_MHA_FWD_CPL + j;
+            s[j]         = -INFINITY;
+            if(mha_visible(query, k0 + c))
+                s[j] = scale * mha_dot(q_tile + row * MIO_MHA_STRIDE, kv_tile + c * MIO_MHA_STRIDE);
+            s_max = fmax(s_max, s[j]);
+        }
+        max_tile[row * MIO_MHA_FWD_LANES + lane] = s_max;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        _FLOAT_ACCUM m_new = m;
+        for(uint i = 0; i < MIO_MHA_FWD_LANES; i++)
+            m_new = fmax(m_new, max_tile[row * MIO_MHA_FWD_LANES + i]);
+
+        // The keys are not needed anymore.
+        mha_load_tile(kv_tile, vh, k0, MIO_MHA_FWD_BC, MIO_MHA_SK, lid);
+
+        // The sum is the one of the softmax, dropout applies to its normalized output only.
+        _FLOAT_ACCUM p_sum = 0.0f;
+        for(uint j = 0; j < MIO_MHA_FWD_CPL; j++)
+        {
+            const uint c       = lane * MIO_MHA_FWD_CPL + j;
+            const _FLOAT_ACCUM p = exp(s[j] - m_new);
+            p_sum += p;
+            p_tile[row * MIO_MHA_FWD_BC + c] =
+                p * mha_drop(
+                        dropout, dropout_scale, seed, offset, bh * MIO_MHA_SQ + query, k0 + c);
+        }
+        sum_tile[row * MIO_MHA_FWD_LANES + lane] = p_sum;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        const _FLOAT_ACCUM corr = exp(m - m_new);
+        l *= corr;
+        for(uint i = 0; i < MIO_MHA_FWD_LANES; i++)
+            l += sum_tile[row * MIO_MHA_FWD_LANES + i];
+        m = m_new;
+
+        for(uint i = 0; i < MIO_MHA_FWD_DPL; i++)
+        {
+            const uint d = lane + i * MIO_MHA_FWD_LANES;
+            if(d < MIO_MHA_D)
+            {
+                _FLOAT_ACCUM a = acc[i] * corr;
+                for(uint c = 0; c < MIO_MHA_FWD_BC; c++)
+                    a = mad(p_tile[row * MIO_MHA_FWD_BC + c], kv_tile[c * MIO_MHA_STRIDE + d], a);
+                acc[i] = a;
+            }
+        }
+    }
+
+    if(query >= MIO_MHA_SQ)
+        return;
+
+    const ulong base = ((ulong)bh * MIO_MHA_SQ + query) * MIO_MHA_D;
+    for(uint i = 0; i < MIO_MHA_FWD_DPL; i++)
+    {
+        const uint d = lane + i * MIO_MHA_FWD_LANES;
+        if(d < MIO_MHA_D)
+            o[base + d] = CVT_ACCUM2FLOAT(acc[i] / l);
+    }
+    if(lane == 0)
+        lse[(ulong)bh * MIO_MHA_SQ + query] = m + log(l);
+}
+
+/// dsum = rowsum(dO * O), the dot product of the output and its gradient per query row.
+__attribute__((reqd_work_group_size(MIO_MHA_GRP, 1, 1))) __kernel void
+MIOpenMhaBwdDot(const global _FLOAT* __restrict o,
+                const global _FLOAT* __restrict dout,
+                global float* __restrict dsum,
+                uint rows)
+{
+    local _FLOAT_ACCUM sum_tile[MIO_MHA_GRP];
+
+    const uint lid  = get_local_id(0);
+    const uint lane = lid % MIO_MHA_FWD_LANES;
+    const uint row  = get_group_id(0) * MIO_MHA_FWD_BR + lid / MIO_MHA_FWD_LANES;
+
+    _FLOAT_ACCUM sum = 0.0f;
+    if(row < rows)
+    {
+        const ulong base = (ulong)row * MIO_MHA_D;
+        for(uint d = lane; d < MIO_MHA_D; d += MIO_MHA_FWD_LANES)
+            sum = mad(CVT_FLOAT2ACCUM(o[base + d]), CVT_FLOAT2ACCUM(dout[base + d]), sum);
+    }
+    sum_tile[lid] = sum;
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    if(lane != 0 || row >= rows)
+        return;
+    for(uint i = 1; i < MIO_MHA_FWD_LANES; i++)
+        sum += sum_tile[lid + i];
+    dsum[row] = sum;
+}
+
+/// The gradient of the score of a query and a key, and its dropped probability in *p_drop.
+static inline _FLOAT_ACCUM mha_bwd_score_grad(local const _FLOAT_ACCUM* q_row,
+                                              local const _FLOAT_ACCUM* dout_row,
+                                              local const _FLOAT_ACCUM* k_row,
+                                              local const _FLOAT_ACCUM* v_row,
+                                              uint bh,
+                                              uint query,
+                                              uint key,
+                                              const global float* __restrict lse,
+                                              const global float* __restrict dsum,
+                                              float scale,
+                                              float dropout,
+                                              float dropout_scale,
+                                              ulong seed,
+                                              ulong offset,
+                                              _FLOAT_ACCUM* p_drop)
+{
+    if(!mha_visible(query, key))
+    {
+        *p_drop = 0.0f;
+        return 0.0f;
+    }
+
+    const uint row         = bh * MIO_MHA_SQ + query;
+    const _FLOAT_ACCUM p   = exp(scale * mha_dot(q_row, k_row) - lse[row]);
+    const _FLOAT_ACCUM dp  = mha_dot(dout_row, v_row);
+    const _FLOAT_ACCUM drp = mha_drop(dropout, dropout_scale, seed, offset, row, key);
+
+    *p_drop = p * drp;
+    return p * (dp * drp - dsum[row]);
+}
+
+/// A work-group per MIO_MHA_BWD_B keys of a (batch, head) pair. The work-item of key c and lane
+/// r computes the score of query r of the tile and key c, and owns the columns lane + i * B of
+/// dK and dV of key c.
+__attribute__((reqd_work_group_size(MIO_MHA_GRP, 1, 1))) __kernel void
+MIOpenMhaBwdKV(const global _FLOAT* __restrict q,
+               const global _FLOAT* __restrict k,
+               const global _FLOAT* __restrict v,
+               const global _FLOAT* __restrict dout,
+               const global float* __restrict lse,
+               const global float* __restrict dsum,
+               global _FLOAT* __restrict dk,
+               global _FLOAT* __restrict dv,
+               float scale,
+               float dropout,
+               float dropout_scale,
+               ulong seed,
+               ulong offset)
+{
+    local _FLOAT_ACCUM k_tile[MIO_MHA_BWD_B * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM v_tile[MIO_MHA_BWD_B * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM q_tile[MIO_MHA_BWD_B * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM dout_tile[MIO_MHA_BWD_B * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM p_tile[MIO_MHA_BWD_B * MIO_MHA_BWD_B];
+    local _FLOAT_ACCUM ds_tile[MIO_MHA_BWD_B * MIO_MHA_BWD_B];
+
+    const uint lid  = get_local_id(0);
+    const uint c    = lid / MIO_MHA_BWD_B;
+    const uint lane = lid % MIO_MHA_BWD_B;
+    const uint k0   = get_group_id(0) * MIO_MHA_BWD_B;
+    const uint bh   = get_group_id(1);
+
+    const ulong q_base = (ulong)bh * MIO_MHA_SQ * MIO_MHA_D;
+    const ulong k_base = (ulong)bh * MIO_MHA_SK * MIO_MHA_D;
+
+    mha_load_tile(k_tile, k + k_base, k0, MIO_MHA_BWD_B, MIO_MHA_SK, lid);
+    mha_load_tile(v_tile, v + k_base, k0, MIO_MHA_BWD_B, MIO_MHA_SK, lid);
+
+    _FLOAT_ACCUM dk_acc[MIO_MHA_BWD_DPL];
+    _FLOAT_ACCUM dv_acc[MIO_MHA_BWD_DPL];
+    for(uint i = 0; i < MIO_MHA_BWD_DPL; i++)
+    {
+        dk_acc[i] = 0.0f;
+        dv_acc[i] = 0.0f;
+    }
+
+    // With the causal mask the queries before the first key of the tile see none of its keys.
+#if MIO_MHA_CAUSAL
+    const uint q_begin = k0;
+#else
+    const uint q_begin = 0;
+#endif
+    for(uint q0 = q_begin; q0 < MIO_MHA_SQ; q0 += MIO_MHA_BWD_B)
+    {
+        barrier(CLK_LOCAL_MEM_FENCE);
+        mha_load_tile(q_tile, q + q_base, q0, MIO_MHA_BWD_B, MIO_MHA_SQ, lid);
+        mha_load_tile(dout_tile, dout + q_base, q0, MIO_MHA_BWD_B, MIO_MHA_SQ, lid);
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        _FLOAT_ACCUM p_drop;
+        const _FLOAT_ACCUM ds = mha_bwd_score_grad(q_tile + lane * MIO_MHA_STRIDE,
+                                                   dout_tile + lane * MIO_MHA_STRIDE,
+                                                   k_tile + c * MIO_MHA_STRIDE,
+                                                   v_tile + c * MIO_MHA_STRIDE,
+                                                   bh,
+                                                   q0 + lane,
+                                                   k0 + c,
+                                                   lse,
+                                                   dsum,
+                                                   scale,
+                                                   dropout,
+                                                   dropout_scale,
+                                                   seed,
+                                                   offset,
+                                                   &p_drop);
+        p_tile[lane * MIO_MHA_BWD_B + c]  = p_drop;
+        ds_tile[lane * MIO_MHA_BWD_B + c] = ds;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint i = 0; i < MIO_MHA_BWD_DPL; i++)
+        {
+            const uint d = lane + i * MIO_MHA_BWD_B;
+            if(d < MIO_MHA_D)
+            {
+                for(uint r = 0; r < MIO_MHA_BWD_B; r++)
+                {
+                    dv_acc[i] = mad(p_tile[r * MIO_MHA_BWD_B + c],
+                                    dout_tile[r * MIO_MHA_STRIDE + d],
+                                    dv_acc[i]);
+                    dk_acc[i] = mad(ds_tile[r * MIO_MHA_BWD_B + c],
+                                    q_tile[r * MIO_MHA_STRIDE + d],
+                                    dk_acc[i]);
+                }
+            }
+        }
+    }
+
+    if(k0 + c >= MIO_MHA_SK)
+        return;
+
+    const ulong base = k_base + (ulong)(k0 + c) * MIO_MHA_D;
+    for(uint i = 0; i < MIO_MHA_BWD_DPL; i++)
+    {
+        const uint d = lane + i * MIO_MHA_BWD_B;
+        if(d < MIO_MHA_D)
+        {
+            dk[base + d] = CVT_ACCUM2FLOAT(scale * dk_acc[i]);
+            dv[base + d] = CVT_ACCUM2FLOAT(dv_acc[i]);
+        }
+    }
+}
+
+/// A work-group per MIO_MHA_BWD_B queries of a (batch, head) pair. The work-item of query r and
+/// lane c computes the score of query r and key c of the tile, and owns the columns
+/// lane + i * B of dQ of query r.
+__attribute__((reqd_work_group_size(MIO_MHA_GRP, 1, 1))) __kernel void
+MIOpenMhaBwdQ(const global _FLOAT* __restrict q,
+              const global _FLOAT* __restrict k,
+              const global _FLOAT* __restrict v,
+              const global _FLOAT* __restrict dout,
+              const global float* __restrict lse,
+              const global float* __restrict dsum,
+              global _FLOAT* __restrict dq,
+              float scale,
+              float dropout,
+              float dropout_scale,
+              ulong seed,
+              ulong offset)
+{
+    local _FLOAT_ACCUM q_tile[MIO_MHA_BWD_B * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM dout_tile[MIO_MHA_BWD_B * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM k_tile[MIO_MHA_BWD_B * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM v_tile[MIO_MHA_BWD_B * MIO_MHA_STRIDE];
+    local _FLOAT_ACCUM ds_tile[MIO_MHA_BWD_B * MIO_MHA_BWD_B];
+
+    const uint lid  = get_local_id(0);
+    const uint r    = lid / MIO_MHA_BWD_B;
+    const uint lane = lid % MIO_MHA_BWD_B;
+    const uint q0   = get_group_id(0) * MIO_MHA_BWD_B;
+    const uint bh   = get_group_id(1);
+
+    const ulong q_base = (ulong)bh * MIO_MHA_SQ * MIO_MHA_D;
+    const ulong k_base = (ulong)bh * MIO_MHA_SK * MIO_MHA_D;
+
+    mha_load_tile(q_tile, q + q_base, q0, MIO_MHA_BWD_B, MIO_MHA_SQ, lid);
+    mha_load_tile(dout_tile, dout + q_base, q0, MIO_MHA_BWD_B, MIO_MHA_SQ, lid);
+
+    _FLOAT_ACCUM dq_acc[MIO_MHA_BWD_DPL];
+    for(uint i = 0; i < MIO_MHA_BWD_DPL; i++)
+        dq_acc[i] = 0.0f;
+
+#if MIO_MHA_CAUSAL
+    const uint k_end = min((uint)MIO_MHA_SK, q0 + MIO_MHA_BWD_B);
+#else
+    const uint k_end = MIO_MHA_SK;
+#endif
+    for(uint k0 = 0; k0 < k_end; k0 += MIO_MHA_BWD_B)
+    {
+        barrier(CLK_LOCAL_MEM_FENCE);
+        mha_load_tile(k_tile, k + k_base, k0, MIO_MHA_BWD_B, MIO_MHA_SK, lid);
+        mha_load_tile(v_tile, v + k_base, k0, MIO_MHA_BWD_B, MIO_MHA_SK, lid);
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        _FLOAT_ACCUM p_drop;
+        ds_tile[r * MIO_MHA_BWD_B + lane] = mha_bwd_score_grad(q_tile + r * MIO_MHA_STRIDE,
+                                                               dout_tile + r * MIO_MHA_STRIDE,
+                                                               k_tile + lane * MIO_MHA_STRIDE,
+                                                               v_tile + lane * MIO_MHA_STRIDE,
+                                                               bh,
+                                                               q0 + r,
+                                                               k0 + lane,
+                                                               lse,
+                                                               dsum,
+                                                               scale,
+                                                               dropout,
+                                                               dropout_scale,
+                                                               seed,
+                                                               offset,
+                                                               &p_drop);
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint i = 0; i < MIO_MHA_BWD_DPL; i++)
+        {
+            const uint d = lane + i * MIO_MHA_BWD_B;
+            if(d < MIO_MHA_D)
+            {
+                for(uint c = 0; c < MIO_MHA_BWD_B; c++)
+                    dq_acc[i] = mad(
+                        ds_tile[r * MIO_MHA_BWD_B + c], k_tile[c * MIO_MHA_STRIDE + d], dq_acc[i]);
+            }
+        }
+    }
+
+    if(q0 + r >= MIO_MHA_SQ)
+        return;
+
+    const ulong base = q_base + (ulong)(q0 + r) * MIO_MHA_D;
+    for(uint i = 0; i < MIO_MHA_BWD_DPL; i++)
+    {
+        const uint d = lane + i * MIO_MHA_BWD_B;
+        if(d < MIO_MHA_D)
+            dq[base + d] = CVT_ACCUM2FLOAT(scale * dq_acc[i]);
+    }
+}
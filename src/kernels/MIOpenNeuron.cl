@@ -29,6 +29,13 @@
 #define FOUR 4
 #define EIGHT 8
 
+#ifndef MIOPEN_USE_BFP16
+#define MIOPEN_USE_BFP16 0
+#endif
+#ifndef MIOPEN_USE_INT8
+#define MIOPEN_USE_INT8 0
+#endif
+
 #if MIOPEN_USE_FP16 == 1
 #pragma OPENCL EXTENSION cl_khr_fp16 : enable
 #define _FLOAT half
@@ -40,6 +47,38 @@
 #define _FLOAT_PREC float
 #define EPSILON (_FLOAT)0.000001
 #endif
+#if MIOPEN_USE_BFP16 == 1
+#include "bfloat16_dev.hpp"
+#define _FLOAT ushort
+#define _FLOAT_PREC float
+#define EPSILON 0.000001f
+#endif
+// int8 data of any layout, NCHW_VECT_C included, is only supported by the lite forward kernels,
+// which apply the activation element by element in float and round to the nearest int8.
+#if MIOPEN_USE_INT8 == 1
+#define _FLOAT char
+#define _FLOAT_PREC float
+#define EPSILON 0.000001f
+#endif
+
+// The activation parameters are passed as float with int8 data.
+#if MIOPEN_USE_INT8 == 1
+#define _FLOAT_ARG float
+#else
+#define _FLOAT_ARG _FLOAT
+#endif
+
+// bfloat16 data is stored as ushort, the lite kernels convert it to float for the activation
+#if MIOPEN_USE_BFP16 == 1
+#define NRN_LOAD(v) bfloat16_to_float(v)
+#define NRN_STORE(v) float_to_bfloat16(v)
+#elif MIOPEN_USE_INT8 == 1
+#define NRN_LOAD(v) ((_FLOAT_PREC)(v))
+#define NRN_STORE(v) convert_char_sat_rte(v)
+#else
+#define NRN_LOAD(v) ((_FLOAT_PREC)(v))
+#define NRN_STORE(v) ((_FLOAT)(v))
+#endif
 
 #define _FLOAT2 PPCAT(_FLOAT, TWO)
 #define _FLOAT4 PPCAT(_FLOAT, FOUR)
@@ -53,6 +92,22 @@
 
 #ifdef LITE
 
+static void LoadUnit(_FLOAT_PREC* dst, const _FLOAT* src)
+{
+    for(uint i = 0; i < MIOPEN_READ_UNIT; ++i)
+    {
+        dst[i] = NRN_LOAD(src[i]);
+    }
+}
+
+static void StoreUnit(_FLOAT* dst, const _FLOAT_PREC* src)
+{
+    for(uint i = 0; i < MIOPEN_READ_UNIT; ++i)
+    {
+        dst[i] = NRN_STORE(src[i]);
+    }
+}
+
 /**********************************************************************************************
 **********************************************************************************************/
 
@@ -69,9 +124,9 @@
 
 __kernel void MIOpenActiveFwdLite(const __global _FLOAT* bot,
                                   __global _FLOAT* top,
-                                  _FLOAT gamma,
-                                  _FLOAT beta,
-                                  _FLOAT alpha,
+                                  _FLOAT_ARG gamma,
+                                  _FLOAT_ARG beta,
+                                  _FLOAT_ARG alpha,
                                   const long bot_offset,
                                   const long top_offset)
 {
@@ -80,13 +135,21 @@ __kernel void MIOpenActiveFwdLite(const __global _FLOAT* bot,
     uint index = gid0 * MIOPEN_READ_UNIT;
 
     _FLOAT data[MIOPEN_READ_UNIT];
-    _FLOAT response[MIOPEN_READ_UNIT];
+    _FLOAT_PREC bot_dat[MIOPEN_READ_UNIT];
+    _FLOAT_PREC response[MIOPEN_READ_UNIT];
 
     *((MIOPEN_READ_TYPE*)data) = *((const __global MIOPEN_READ_TYPE*)(bot + bot_offset + index));
 
-    ActivationFunction(MIOPEN_READ_UNIT, response, (const _FLOAT*)data, gamma, beta, alpha);
+    LoadUnit(bot_dat, data);
+    ActivationFunction(MIOPEN_READ_UNIT,
+                       response,
+                       (const _FLOAT_PREC*)bot_dat,
+                       NRN_LOAD(gamma),
+                       NRN_LOAD(beta),
+                       NRN_LOAD(alpha));
+    StoreUnit(data, response);
 
-    *((__global MIOPEN_READ_TYPE*)(top + top_offset + index)) = *((MIOPEN_READ_TYPE*)response);
+    *((__global MIOPEN_READ_TYPE*)(top + top_offset + index)) = *((MIOPEN_READ_TYPE*)data);
 }
 
 /**********************************************************************************************
@@ -94,9 +157,9 @@ __kernel void MIOpenActiveFwdLite(const __global _FLOAT* bot,
 
 __kernel void MIOpenActiveFwd2DLite(const __global _FLOAT* bot,
                                     __global _FLOAT* top,
-                                    _FLOAT gamma,
-                                    _FLOAT beta,
-                                    _FLOAT alpha,
+                                    _FLOAT_ARG gamma,
+                                    _FLOAT_ARG beta,
+                                    _FLOAT_ARG alpha,
                                     const long bot_offset,
                                     const long top_offset,
                                     const uint bot_stride,
@@ -109,14 +172,22 @@ __kernel void MIOpenActiveFwd2DLite(const __global _FLOAT* bot,
     uint top_index = y * top_stride + x_id * MIOPEN_READ_UNIT;
 
     _FLOAT data[MIOPEN_READ_UNIT];
-    _FLOAT response[MIOPEN_READ_UNIT];
+    _FLOAT_PREC bot_dat[MIOPEN_READ_UNIT];
+    _FLOAT_PREC response[MIOPEN_READ_UNIT];
 
     *((MIOPEN_READ_TYPE*)data) =
         *((const __global MIOPEN_READ_TYPE*)(bot + bot_offset + bot_index));
 
-    ActivationFunction(MIOPEN_READ_UNIT, response, (const _FLOAT*)data, gamma, beta, alpha);
+    LoadUnit(bot_dat, data);
+    ActivationFunction(MIOPEN_READ_UNIT,
+                       response,
+                       (const _FLOAT_PREC*)bot_dat,
+                       NRN_LOAD(gamma),
+                       NRN_LOAD(beta),
+                       NRN_LOAD(alpha));
+    StoreUnit(data, response);
 
-    *((__global MIOPEN_READ_TYPE*)(top + top_offset + top_index)) = *((MIOPEN_READ_TYPE*)response);
+    *((__global MIOPEN_READ_TYPE*)(top + top_offset + top_index)) = *((MIOPEN_READ_TYPE*)data);
 }
 
 /**********************************************************************************************
@@ -144,20 +215,29 @@ __kernel void MIOpenActiveBwdLite(__global _FLOAT* bot_diff,
     _FLOAT bot_dat[MIOPEN_READ_UNIT];
     _FLOAT top_dat[MIOPEN_READ_UNIT];
 
+    _FLOAT_PREC bot_diff_prec[MIOPEN_READ_UNIT];
+    _FLOAT_PREC top_diff_prec[MIOPEN_READ_UNIT];
+    _FLOAT_PREC bot_prec[MIOPEN_READ_UNIT];
+    _FLOAT_PREC top_prec[MIOPEN_READ_UNIT];
+
     *((MIOPEN_READ_TYPE*)top_diff_dat) =
         *((const __global MIOPEN_READ_TYPE*)(top_diff + top_diff_offset + index));
     *((MIOPEN_READ_TYPE*)bot_dat) = *((const __global MIOPEN_READ_TYPE*)(bot + bot_offset + index));
     *((MIOPEN_READ_TYPE*)top_dat) = *((const __global MIOPEN_READ_TYPE*)(top + top_offset + index));
 
+    LoadUnit(top_diff_prec, top_diff_dat);
+    LoadUnit(bot_prec, bot_dat);
+    LoadUnit(top_prec, top_dat);
     ActivationFunction_Diff(MIOPEN_READ_UNIT,
-                            bot_diff_dat,
-                            top_diff_dat,
-                            bot_dat,
-                            top_dat,
-                            diff_scale,
-                            gamma,
-                            beta,
-                            alpha);
+                            bot_diff_prec,
+                            top_diff_prec,
+                            bot_prec,
+                            top_prec,
+                            NRN_LOAD(diff_scale),
+                            NRN_LOAD(gamma),
+                            NRN_LOAD(beta),
+                            NRN_LOAD(alpha));
+    StoreUnit(bot_diff_dat, bot_diff_prec);
 
     *((__global MIOPEN_READ_TYPE*)(bot_diff + bot_diff_offset + index)) =
         *((MIOPEN_READ_TYPE*)bot_diff_dat);
@@ -196,6 +276,11 @@ __kernel void MIOpenActiveBwd2DLite(__global _FLOAT* bot_diff,
     _FLOAT bot_dat[MIOPEN_READ_UNIT];
     _FLOAT top_dat[MIOPEN_READ_UNIT];
 
+    _FLOAT_PREC bot_diff_prec[MIOPEN_READ_UNIT];
+    _FLOAT_PREC top_diff_prec[MIOPEN_READ_UNIT];
+    _FLOAT_PREC bot_prec[MIOPEN_READ_UNIT];
+    _FLOAT_PREC top_prec[MIOPEN_READ_UNIT];
+
     *((MIOPEN_READ_TYPE*)top_diff_dat) =
         *((const __global MIOPEN_READ_TYPE*)(top_diff + top_diff_offset + top_diff_index));
     *((MIOPEN_READ_TYPE*)bot_dat) =
@@ -203,20 +288,205 @@ __kernel void MIOpenActiveBwd2DLite(__global _FLOAT* bot_diff,
     *((MIOPEN_READ_TYPE*)top_dat) =
         *((const __global MIOPEN_READ_TYPE*)(top + top_offset + top_index));
 
+    LoadUnit(top_diff_prec, top_diff_dat);
+    LoadUnit(bot_prec, bot_dat);
+    LoadUnit(top_prec, top_dat);
     ActivationFunction_Diff(MIOPEN_READ_UNIT,
-                            bot_diff_dat,
-                            top_diff_dat,
-                            bot_dat,
-                            top_dat,
-                            diff_scale,
-                            gamma,
-                            beta,
-                            alpha);
+                            bot_diff_prec,
+                            top_diff_prec,
+                            bot_prec,
+                            top_prec,
+                            NRN_LOAD(diff_scale),
+                            NRN_LOAD(gamma),
+                            NRN_LOAD(beta),
+                            NRN_LOAD(alpha));
+    StoreUnit(bot_diff_dat, bot_diff_prec);
 
     *((__global MIOPEN_READ_TYPE*)(bot_diff + bot_diff_offset + bot_diff_index)) =
         *((MIOPEN_READ_TYPE*)bot_diff_dat);
 }
 
+/**********************************************************************************************
+**********************************************************************************************/
+
+// Packed tensors of any length, TENS_LEN = total.
+// A work-item handles MIOPEN_NRN_VECS vectors of MIOPEN_READ_UNIT elements, which are one
+// work-group size apart so that the loads of a work-group stay contiguous, and the grid strides
+// over what is left of the tensor. The elements past the last full vector go to the first
+// work-items. A work-item writes only what it has read, so the output may alias the input.
+// local size = (256, 1, 1)
+// global size = (256 * groups, 1, 1)
+
+#ifndef MIOPEN_NRN_VECS
+#define MIOPEN_NRN_VECS 1
+#endif
+
+__kernel void MIOpenActiveFwdPacked(const __global _FLOAT* bot,
+                                    __global _FLOAT* top,
+                                    _FLOAT_ARG gamma,
+                                    _FLOAT_ARG beta,
+                                    _FLOAT_ARG alpha,
+                                    const long bot_offset,
+                                    const long top_offset,
+                                    const ulong total)
+{
+    const __global _FLOAT* src = bot + bot_offset;
+    __global _FLOAT* dst       = top + top_offset;
+
+    const ulong nvec = total / MIOPEN_READ_UNIT;
+    const ulong lsz  = get_local_size(0);
+    const ulong step = get_global_size(0) * MIOPEN_NRN_VECS;
+
+    for(ulong v0 = get_group_id(0) * lsz * MIOPEN_NRN_VECS + get_local_id(0); v0 < nvec;
+        v0 += step)
+    {
+        _FLOAT data[MIOPEN_NRN_VECS][MIOPEN_READ_UNIT];
+
+        // All the loads are issued before any of them is used.
+        for(uint k = 0; k < MIOPEN_NRN_VECS; ++k)
+        {
+            const ulong v = v0 + k * lsz;
+            if(v < nvec)
+                *((MIOPEN_READ_TYPE*)data[k]) =
+                    *((const __global MIOPEN_READ_TYPE*)(src + v * MIOPEN_READ_UNIT));
+        }
+
+        for(uint k = 0; k < MIOPEN_NRN_VECS; ++k)
+        {
+            const ulong v = v0 + k * lsz;
+            if(v < nvec)
+            {
+                _FLOAT_PREC bot_dat[MIOPEN_READ_UNIT];
+                _FLOAT_PREC response[MIOPEN_READ_UNIT];
+
+                LoadUnit(bot_dat, data[k]);
+                ActivationFunction(MIOPEN_READ_UNIT,
+                                   response,
+                                   (const _FLOAT_PREC*)bot_dat,
+                                   NRN_LOAD(gamma),
+                                   NRN_LOAD(beta),
+                                   NRN_LOAD(alpha));
+                StoreUnit(data[k], response);
+
+                *((__global MIOPEN_READ_TYPE*)(dst + v * MIOPEN_READ_UNIT)) =
+                    *((MIOPEN_READ_TYPE*)data[k]);
+            }
+        }
+    }
+
+    const ulong tail = nvec * MIOPEN_READ_UNIT + get_global_id(0);
+    if(tail < total)
+    {
+        _FLOAT_PREC bot_dat = NRN_LOAD(src[tail]);
+        _FLOAT_PREC response;
+
+        ActivationFunction(
+            1, &response, &bot_dat, NRN_LOAD(gamma), NRN_LOAD(beta), NRN_LOAD(alpha));
+        dst[tail] = NRN_STORE(response);
+    }
+}
+
+/**********************************************************************************************
+**********************************************************************************************/
+
+// The same layout as MIOpenActiveFwdPacked, bot_diff may alias top_diff.
+
+__kernel void MIOpenActiveBwdPacked(__global _FLOAT* bot_diff,
+                                    __global const _FLOAT* top_diff,
+                                    __global const _FLOAT* bot,
+                                    __global const _FLOAT* top,
+                                    _FLOAT diff_scale,
+                                    _FLOAT gamma,
+                                    _FLOAT beta,
+                                    _FLOAT alpha,
+                                    const long bot_diff_offset,
+                                    const long top_diff_offset,
+                                    const long bot_offset,
+                                    const long top_offset,
+                                    const ulong total)
+{
+    __global _FLOAT* dx       = bot_diff + bot_diff_offset;
+    const __global _FLOAT* dy = top_diff + top_diff_offset;
+    const __global _FLOAT* x  = bot + bot_offset;
+    const __global _FLOAT* y  = top + top_offset;
+
+    const ulong nvec = total / MIOPEN_READ_UNIT;
+    const ulong lsz  = get_local_size(0);
+    const ulong step = get_global_size(0) * MIOPEN_NRN_VECS;
+
+    for(ulong v0 = get_group_id(0) * lsz * MIOPEN_NRN_VECS + get_local_id(0); v0 < nvec;
+        v0 += step)
+    {
+        _FLOAT top_diff_dat[MIOPEN_NRN_VECS][MIOPEN_READ_UNIT];
+        _FLOAT bot_dat[MIOPEN_NRN_VECS][MIOPEN_READ_UNIT];
+        _FLOAT top_dat[MIOPEN_NRN_VECS][MIOPEN_READ_UNIT];
+
+        for(uint k = 0; k < MIOPEN_NRN_VECS; ++k)
+        {
+            const ulong v = v0 + k * lsz;
+            if(v < nvec)
+            {
+                const ulong index = v * MIOPEN_READ_UNIT;
+
+                *((MIOPEN_READ_TYPE*)top_diff_dat[k]) =
+                    *((const __global MIOPEN_READ_TYPE*)(dy + index));
+                *((MIOPEN_READ_TYPE*)bot_dat[k]) = *((const __global MIOPEN_READ_TYPE*)(x + index));
+                *((MIOPEN_READ_TYPE*)top_dat[k]) = *((const __global MIOPEN_READ_TYPE*)(y + index));
+            }
+        }
+
+        for(uint k = 0; k < MIOPEN_NRN_VECS; ++k)
+        {
+            const ulong v = v0 + k * lsz;
+            if(v < nvec)
+            {
+                _FLOAT bot_diff_dat[MIOPEN_READ_UNIT];
+                _FLOAT_PREC bot_diff_prec[MIOPEN_READ_UNIT];
+                _FLOAT_PREC top_diff_prec[MIOPEN_READ_UNIT];
+                _FLOAT_PREC bot_prec[MIOPEN_READ_UNIT];
+                _FLOAT_PREC top_prec[MIOPEN_READ_UNIT];
+
+                LoadUnit(top_diff_prec, top_diff_dat[k]);
+                LoadUnit(bot_prec, bot_dat[k]);
+                LoadUnit(top_prec, top_dat[k]);
+                ActivationFunction_Diff(MIOPEN_READ_UNIT,
+                                        bot_diff_prec,
+                                        top_diff_prec,
+                                        bot_prec,
+                                        top_prec,
+                                        NRN_LOAD(diff_scale),
+                                        NRN_LOAD(gamma),
+                                        NRN_LOAD(beta),
+                                        NRN_LOAD(alpha));
+                StoreUnit(bot_diff_dat, bot_diff_prec);
+
+                *((__global MIOPEN_READ_TYPE*)(dx + v * MIOPEN_READ_UNIT)) =
+                    *((MIOPEN_READ_TYPE*)bot_diff_dat);
+            }
+        }
+    }
+
+    const ulong tail = nvec * MIOPEN_READ_UNIT + get_global_id(0);
+    if(tail < total)
+    {
+        _FLOAT_PREC top_diff_prec = NRN_LOAD(dy[tail]);
+        _FLOAT_PREC bot_prec      = NRN_LOAD(x[tail]);
+        _FLOAT_PREC top_prec      = NRN_LOAD(y[tail]);
+        _FLOAT_PREC bot_diff_prec;
+
+        ActivationFunction_Diff(1,
+                                &bot_diff_prec,
+                                &top_diff_prec,
+                                &bot_prec,
+                                &top_prec,
+                                NRN_LOAD(diff_scale),
+                                NRN_LOAD(gamma),
+                                NRN_LOAD(beta),
+                                NRN_LOAD(alpha));
+        dx[tail] = NRN_STORE(bot_diff_prec);
+    }
+}
+
 /**************************************************************************************************************/
 
 #else
@@ -0,0 +1,582 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Layer and group normalization. The tensor is viewed as MIO_NORM_ROWS rows of MIO_NORM_K
+// contiguous elements, every row is normalized on its own:
+//  - layer norm: the rows are the leading dimensions, the row the normalized ones;
+//  - group norm: a row is the (C / G) * spatial elements of a group of a sample.
+// The affine parameter of element k of row r is (r % MIO_NORM_G) * (K / D) + k / D, where D is
+// MIO_NORM_D: D = 1 and G = 1 for layer norm, D = spatial and G = groups for group norm.
+//
+// The optional residual is added to x before the normalization and the optional activation
+// MIO_NORM_ACTIV (a miopenActivationMode_t) is applied after the affine transform. Backward
+// recomputes both from x, residual and the saved statistics, so nothing but the mean and the
+// inverse standard deviation of a row is kept from the forward pass.
+//
+// With MIO_NORM_DROPOUT, dropout is applied to x before the residual is added. Its mask comes
+// from the counter-based generator of philox.h and is regenerated wherever x is read, so the
+// dropout -> add -> norm chain neither stores the mask nor the sum. Backward writes the masked
+// gradient to dx and the unmasked one to the residual gradient.
+
+#include "float_types.h"
+
+#ifndef MIO_NORM_DROPOUT
+#define MIO_NORM_DROPOUT 0
+#endif
+
+#if MIO_NORM_DROPOUT
+#include "philox.h"
+#endif
+
+#ifndef MIO_NORM_AFFINE
+#define MIO_NORM_AFFINE 1
+#endif
+
+#ifndef MIO_NORM_RESIDUAL
+#define MIO_NORM_RESIDUAL 0
+#endif
+
+#ifndef MIO_NORM_SAVE_STATS
+#define MIO_NORM_SAVE_STATS 1
+#endif
+
+#ifndef MIO_NORM_ACTIV
+#define MIO_NORM_ACTIV 0
+#endif
+
+#ifndef MIO_NORM_G
+#define MIO_NORM_G 1
+#endif
+
+#ifndef MIO_NORM_D
+#define MIO_NORM_D 1
+#endif
+
+#ifndef MIO_NORM_PARAM_GRP1
+#define MIO_NORM_PARAM_GRP1 4
+#endif
+
+// Elements of a row per work-item. Rows that fit into MIO_NORM_CACHED registers are read once.
+#define MIO_NORM_EPT ((MIO_NORM_K + MIO_NORM_GRP0 - 1) / MIO_NORM_GRP0)
+
+#define MIO_NORM_PARAMS (MIO_NORM_G * (MIO_NORM_K / MIO_NORM_D))
+
+static inline uint norm_param(uint row, uint k)
+{
+    return (row % MIO_NORM_G) * (MIO_NORM_K / MIO_NORM_D) + k / MIO_NORM_D;
+}
+
+/// Rate, amplification and generator key of the fused dropout.
+typedef struct
+{
+    float rate;
+    float scale;
+    ulong seed;
+    ulong offset;
+} norm_dropout;
+
+static inline norm_dropout
+make_norm_dropout(float dropout, float dropout_scale, ulong seed, ulong offset)
+{
+    norm_dropout d;
+    d.rate   = dropout;
+    d.scale  = dropout_scale;
+    d.seed   = seed;
+    d.offset = offset;
+    return d;
+}
+
+/// Dropout factor of element i: the amplification if the element is kept, 0 otherwise.
+static inline _FLOAT_ACCUM norm_drop(norm_dropout drop, ulong i)
+{
+#if MIO_NORM_DROPOUT
+    return philox_uniform(drop.seed, drop.offset, (uint)i) > drop.rate ? drop.scale : 0.0f;
+#else
+    (void)drop;
+    (void)i;
+    return 1.0f;
+#endif
+}
+
+static inline _FLOAT_ACCUM norm_load(const global _FLOAT* __restrict x,
+                                     const global _FLOAT* __restrict residual,
+                                     norm_dropout drop,
+                                     ulong i)
+{
+#if MIO_NORM_DROPOUT
+    const _FLOAT_ACCUM v = CVT_FLOAT2ACCUM(x[i]) * norm_drop(drop, i);
+#else
+    (void)drop;
+    const _FLOAT_ACCUM v = CVT_FLOAT2ACCUM(x[i]);
+#endif
+#if MIO_NORM_RESIDUAL
+    return v + CVT_FLOAT2ACCUM(residual[i]);
+#else
+    (void)residual;
+    return v;
+#endif
+}
+
+static inline _FLOAT_ACCUM norm_activ(_FLOAT_ACCUM p, float alpha, float beta, float gamma)
+{
+    (void)alpha;
+    (void)beta;
+    (void)gamma;
+#if MIO_NORM_ACTIV == 0 // PASTHRU
+    return p;
+#elif MIO_NORM_ACTIV == 1 // LOGISTIC
+    return 1.0f / (1.0f + exp(-p));
+#elif MIO_NORM_ACTIV == 2 // TANH
+    return beta * tanh(alpha * p);
+#elif MIO_NORM_ACTIV == 3 // RELU
+    return fmax(p, 0.0f);
+#elif MIO_NORM_ACTIV == 4 // SOFTRELU
+    return log1p(exp(p));
+#elif MIO_NORM_ACTIV == 5 // ABS
+    return fabs(p);
+#elif MIO_NORM_ACTIV == 6 // POWER
+    const _FLOAT_ACCUM v = alpha + beta * p;
+    return v <= FLT_MIN ? 0.0f : pow(v, gamma);
+#elif MIO_NORM_ACTIV == 7 // CLIPPEDRELU
+    return fmin(alpha, fmax(p, 0.0f));
+#elif MIO_NORM_ACTIV == 8 // LEAKYRELU
+    return p > 0.0f ? p : alpha * p;
+#elif MIO_NORM_ACTIV == 9 // ELU
+    return p > 0.0f ? p : alpha * expm1(p);
+#endif
+}
+
+/// Derivative of the activation at the pre-activation value p.
+static inline _FLOAT_ACCUM norm_activ_diff(_FLOAT_ACCUM p, float alpha, float beta, float gamma)
+{
+    (void)alpha;
+    (void)beta;
+    (void)gamma;
+#if MIO_NORM_ACTIV == 0
+    (void)p;
+    return 1.0f;
+#elif MIO_NORM_ACTIV == 1
+    const _FLOAT_ACCUM s = 1.0f / (1.0f + exp(-p));
+    return s * (1.0f - s);
+#elif MIO_NORM_ACTIV == 2
+    const _FLOAT_ACCUM t = tanh(alpha * p);
+    return alpha * beta * (1.0f - t * t);
+#elif MIO_NORM_ACTIV == 3
+    return p > 0.0f ? 1.0f : 0.0f;
+#elif MIO_NORM_ACTIV == 4
+    return 1.0f / (1.0f + exp(-p));
+#elif MIO_NORM_ACTIV == 5
+    return p >= 0.0f ? 1.0f : -1.0f;
+#elif MIO_NORM_ACTIV == 6
+    const _FLOAT_ACCUM v = alpha + beta * p;
+    return v <= FLT_MIN ? 0.0f : gamma * beta * pow(v, gamma - 1.0f);
+#elif MIO_NORM_ACTIV == 7
+    return (p > 0.0f && p <= alpha) ? 1.0f : 0.0f;
+#elif MIO_NORM_ACTIV == 8
+    return p > 0.0f ? 1.0f : alpha;
+#elif MIO_NORM_ACTIV == 9
+    return p > 0.0f ? 1.0f : alpha * exp(p);
+#endif
+}
+
+/// Sums a and b over the work-group, the LDS may be reused as soon as it returns.
+static inline void norm_reduce2(_FLOAT_ACCUM* a,
+                                _FLOAT_ACCUM* b,
+                                local _FLOAT_ACCUM* lcl_a,
+                                local _FLOAT_ACCUM* lcl_b,
+                                uint lid,
+                                uint size)
+{
+    lcl_a[lid] = *a;
+    lcl_b[lid] = *b;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint s = size >> 1; s > 0; s >>= 1)
+    {
+        if(lid < s)
+        {
+            lcl_a[lid] += lcl_a[lid + s];
+            lcl_b[lid] += lcl_b[lid + s];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    *a = lcl_a[0];
+    *b = lcl_b[0];
+    barrier(CLK_LOCAL_MEM_FENCE);
+}
+
+/// One work-group per row.
+__attribute__((reqd_work_group_size(MIO_NORM_GRP0, 1, 1))) __kernel void
+MIOpenNormFwd(const global _FLOAT* __restrict x,
+              const global _FLOAT* __restrict residual,
+              const global _FLOAT* __restrict weight,
+              const global _FLOAT* __restrict bias,
+              global _FLOAT* __restrict y,
+              global float* __restrict mean,
+              global float* __restrict rstd,
+              float epsilon,
+              float alpha,
+              float beta,
+              float gamma,
+              float dropout,
+              float dropout_scale,
+              ulong seed,
+              ulong offset)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_NORM_GRP0];
+    local _FLOAT_ACCUM lcl_b[MIO_NORM_GRP0];
+
+    const uint lid          = get_local_id(0);
+    const uint row          = get_group_id(0);
+    const ulong base        = (ulong)row * MIO_NORM_K;
+    const norm_dropout drop = make_norm_dropout(dropout, dropout_scale, seed, offset);
+
+    // Shifting by the first element keeps the variance of rows with a large mean accurate.
+    const _FLOAT_ACCUM shift = norm_load(x, residual, drop, base);
+
+#if MIO_NORM_CACHED
+    _FLOAT_ACCUM cache[MIO_NORM_EPT];
+#endif
+    _FLOAT_ACCUM sum   = 0.0f;
+    _FLOAT_ACCUM sumsq = 0.0f;
+    for(uint i = 0; i < MIO_NORM_EPT; i++)
+    {
+        const uint k = lid + i * MIO_NORM_GRP0;
+        if(k < MIO_NORM_K)
+        {
+            const _FLOAT_ACCUM v = norm_load(x, residual, drop, base + k) - shift;
+#if MIO_NORM_CACHED
+            cache[i] = v;
+#endif
+            sum += v;
+            sumsq = mad(v, v, sumsq);
+        }
+    }
+    norm_reduce2(&sum, &sumsq, lcl_a, lcl_b, lid, MIO_NORM_GRP0);
+
+    const _FLOAT_ACCUM m   = sum / MIO_NORM_K;
+    const _FLOAT_ACCUM var = fmax(sumsq / MIO_NORM_K - m * m, 0.0f);
+    const _FLOAT_ACCUM r   = rsqrt(var + (_FLOAT_ACCUM)epsilon);
+
+#if MIO_NORM_SAVE_STATS
+    if(lid == 0)
+    {
+        mean[row] = shift + m;
+        rstd[row] = r;
+    }
+#else
+    (void)mean;
+    (void)rstd;
+#endif
+
+    for(uint i = 0; i < MIO_NORM_EPT; i++)
+    {
+        const uint k = lid + i * MIO_NORM_GRP0;
+        if(k < MIO_NORM_K)
+        {
+#if MIO_NORM_CACHED
+            const _FLOAT_ACCUM v = cache[i];
+#else
+            const _FLOAT_ACCUM v = norm_load(x, residual, drop, base + k) - shift;
+#endif
+            _FLOAT_ACCUM p = (v - m) * r;
+#if MIO_NORM_AFFINE
+            const uint c = norm_param(row, k);
+            p            = mad(p, CVT_FLOAT2ACCUM(weight[c]), CVT_FLOAT2ACCUM(bias[c]));
+#else
+            (void)weight;
+            (void)bias;
+#endif
+            y[base + k] = CVT_ACCUM2FLOAT(norm_activ(p, alpha, beta, gamma));
+        }
+    }
+}
+
+/// Gradient of the pre-activation of element k of a row, xhat is returned through the pointer.
+static inline _FLOAT_ACCUM norm_dpre(const global _FLOAT* __restrict x,
+                                     const global _FLOAT* __restrict residual,
+                                     norm_dropout drop,
+                                     const global _FLOAT* __restrict dy,
+                                     const global _FLOAT* __restrict weight,
+                                     const global _FLOAT* __restrict bias,
+                                     _FLOAT_ACCUM m,
+                                     _FLOAT_ACCUM r,
+                                     uint row,
+                                     uint k,
+                                     float alpha,
+                                     float beta,
+                                     float gamma,
+                                     _FLOAT_ACCUM* xhat)
+{
+    const ulong i = (ulong)row * MIO_NORM_K + k;
+    *xhat         = (norm_load(x, residual, drop, i) - m) * r;
+#if MIO_NORM_ACTIV == 0
+    (void)weight;
+    (void)bias;
+    (void)alpha;
+    (void)beta;
+    (void)gamma;
+    return CVT_FLOAT2ACCUM(dy[i]);
+#else
+#if MIO_NORM_AFFINE
+    const uint c         = norm_param(row, k);
+    const _FLOAT_ACCUM p = mad(*xhat, CVT_FLOAT2ACCUM(weight[c]), CVT_FLOAT2ACCUM(bias[c]));
+#else
+    (void)weight;
+    (void)bias;
+    const _FLOAT_ACCUM p = *xhat;
+#endif
+    return CVT_FLOAT2ACCUM(dy[i]) * norm_activ_diff(p, alpha, beta, gamma);
+#endif
+}
+
+/// Data gradient, one work-group per row. dx is the gradient of the residual as well, unless
+/// dropout makes them differ: the residual gradient then goes to dresidual.
+__attribute__((reqd_work_group_size(MIO_NORM_GRP0, 1, 1))) __kernel void
+MIOpenNormBwdData(const global _FLOAT* __restrict x,
+                  const global _FLOAT* __restrict residual,
+                  const global _FLOAT* __restrict dy,
+                  const global _FLOAT* __restrict weight,
+                  const global _FLOAT* __restrict bias,
+                  const global float* __restrict mean,
+                  const global float* __restrict rstd,
+                  global _FLOAT* __restrict dx,
+                  global _FLOAT* __restrict dresidual,
+                  float alpha,
+                  float beta,
+                  float gamma,
+                  float dropout,
+                  float dropout_scale,
+                  ulong seed,
+                  ulong offset)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_NORM_GRP0];
+    local _FLOAT_ACCUM lcl_b[MIO_NORM_GRP0];
+
+    const uint lid          = get_local_id(0);
+    const uint row          = get_group_id(0);
+    const ulong base        = (ulong)row * MIO_NORM_K;
+    const _FLOAT_ACCUM m    = mean[row];
+    const _FLOAT_ACCUM r    = rstd[row];
+    const norm_dropout drop = make_norm_dropout(dropout, dropout_scale, seed, offset);
+
+#if MIO_NORM_CACHED
+    _FLOAT_ACCUM cache_g[MIO_NORM_EPT];
+    _FLOAT_ACCUM cache_xhat[MIO_NORM_EPT];
+#endif
+    _FLOAT_ACCUM sum_g     = 0.0f;
+    _FLOAT_ACCUM sum_gxhat = 0.0f;
+    for(uint i = 0; i < MIO_NORM_EPT; i++)
+    {
+        const uint k = lid + i * MIO_NORM_GRP0;
+        if(k < MIO_NORM_K)
+        {
+            _FLOAT_ACCUM xhat;
+            _FLOAT_ACCUM g = norm_dpre(
+                x, residual, drop, dy, weight, bias, m, r, row, k, alpha, beta, gamma, &xhat);
+#if MIO_NORM_AFFINE
+            g *= CVT_FLOAT2ACCUM(weight[norm_param(row, k)]);
+#endif
+#if MIO_NORM_CACHED
+            cache_g[i]    = g;
+            cache_xhat[i] = xhat;
+#endif
+            sum_g += g;
+            sum_gxhat = mad(g, xhat, sum_gxhat);
+        }
+    }
+    norm_reduce2(&sum_g, &sum_gxhat, lcl_a, lcl_b, lid, MIO_NORM_GRP0);
+
+    const _FLOAT_ACCUM mean_g     = sum_g / MIO_NORM_K;
+    const _FLOAT_ACCUM mean_gxhat = sum_gxhat / MIO_NORM_K;
+
+    for(uint i = 0; i < MIO_NORM_EPT; i++)
+    {
+        const uint k = lid + i * MIO_NORM_GRP0;
+        if(k < MIO_NORM_K)
+        {
+#if MIO_NORM_CACHED
+            const _FLOAT_ACCUM g    = cache_g[i];
+            const _FLOAT_ACCUM xhat = cache_xhat[i];
+#else
+            _FLOAT_ACCUM xhat;
+            _FLOAT_ACCUM g = norm_dpre(
+                x, residual, drop, dy, weight, bias, m, r, row, k, alpha, beta, gamma, &xhat);
+#if MIO_NORM_AFFINE
+            g *= CVT_FLOAT2ACCUM(weight[norm_param(row, k)]);
+#endif
+#endif
+            const _FLOAT_ACCUM dsum = r * (g - mean_g - xhat * mean_gxhat);
+#if MIO_NORM_DROPOUT
+            dx[base + k] = CVT_ACCUM2FLOAT(dsum * norm_drop(drop, base + k));
+#if MIO_NORM_RESIDUAL
+            dresidual[base + k] = CVT_ACCUM2FLOAT(dsum);
+#endif
+#else
+            dx[base + k] = CVT_ACCUM2FLOAT(dsum);
+#endif
+        }
+    }
+#if !MIO_NORM_DROPOUT || !MIO_NORM_RESIDUAL
+    (void)dresidual;
+#endif
+}
+
+#if MIO_NORM_AFFINE
+
+/// Parameter gradients of D == 1. A work-item owns a parameter, the MIO_NORM_PARAM_GRP1 lanes
+/// of dimension 1 split the rows of its group, so consecutive work-items read consecutive
+/// elements of a row.
+__attribute__((reqd_work_group_size(MIO_NORM_GRP0, MIO_NORM_PARAM_GRP1, 1))) __kernel void
+MIOpenNormBwdParamsColumns(const global _FLOAT* __restrict x,
+                           const global _FLOAT* __restrict residual,
+                           const global _FLOAT* __restrict dy,
+                           const global _FLOAT* __restrict weight,
+                           const global _FLOAT* __restrict bias,
+                           const global float* __restrict mean,
+                           const global float* __restrict rstd,
+                           global _FLOAT* __restrict dweight,
+                           global _FLOAT* __restrict dbias,
+                           float alpha,
+                           float beta,
+                           float gamma,
+                           float dropout,
+                           float dropout_scale,
+                           ulong seed,
+                           ulong offset)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_NORM_GRP0 * MIO_NORM_PARAM_GRP1];
+    local _FLOAT_ACCUM lcl_b[MIO_NORM_GRP0 * MIO_NORM_PARAM_GRP1];
+
+    const uint p            = get_global_id(0);
+    const uint lane         = get_local_id(1);
+    const uint lid          = get_local_id(0) + lane * MIO_NORM_GRP0;
+    const norm_dropout drop = make_norm_dropout(dropout, dropout_scale, seed, offset);
+
+    _FLOAT_ACCUM dw = 0.0f;
+    _FLOAT_ACCUM db = 0.0f;
+    if(p < MIO_NORM_PARAMS)
+    {
+        const uint k = p % MIO_NORM_K;
+        for(uint row = p / MIO_NORM_K + lane * MIO_NORM_G; row < MIO_NORM_ROWS;
+            row += MIO_NORM_G * MIO_NORM_PARAM_GRP1)
+        {
+            _FLOAT_ACCUM xhat;
+            const _FLOAT_ACCUM g = norm_dpre(x,
+                                             residual,
+                                             drop,
+                                             dy,
+                                             weight,
+                                             bias,
+                                             mean[row],
+                                             rstd[row],
+                                             row,
+                                             k,
+                                             alpha,
+                                             beta,
+                                             gamma,
+                                             &xhat);
+            dw = mad(g, xhat, dw);
+            db += g;
+        }
+    }
+
+    lcl_a[lid] = dw;
+    lcl_b[lid] = db;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if(lane == 0 && p < MIO_NORM_PARAMS)
+    {
+        for(uint j = 1; j < MIO_NORM_PARAM_GRP1; j++)
+        {
+            dw += lcl_a[lid + j * MIO_NORM_GRP0];
+            db += lcl_b[lid + j * MIO_NORM_GRP0];
+        }
+        dweight[p] = CVT_ACCUM2FLOAT(dw);
+        dbias[p]   = CVT_ACCUM2FLOAT(db);
+    }
+}
+
+/// Parameter gradients of D > 1, one work-group per parameter. The elements of a parameter come
+/// in runs of D along the rows of its group.
+__attribute__((reqd_work_group_size(MIO_NORM_GRP0, 1, 1))) __kernel void
+MIOpenNormBwdParamsChannels(const global _FLOAT* __restrict x,
+                            const global _FLOAT* __restrict residual,
+                            const global _FLOAT* __restrict dy,
+                            const global _FLOAT* __restrict weight,
+                            const global _FLOAT* __restrict bias,
+                            const global float* __restrict mean,
+                            const global float* __restrict rstd,
+                            global _FLOAT* __restrict dweight,
+                            global _FLOAT* __restrict dbias,
+                            float alpha,
+                            float beta,
+                            float gamma,
+                            float dropout,
+                            float dropout_scale,
+                            ulong seed,
+                            ulong offset)
+{
+    local _FLOAT_ACCUM lcl_a[MIO_NORM_GRP0];
+    local _FLOAT_ACCUM lcl_b[MIO_NORM_GRP0];
+
+    const uint lid          = get_local_id(0);
+    const uint p            = get_group_id(0);
+    const uint group        = p / (MIO_NORM_K / MIO_NORM_D);
+    const uint k0           = (p % (MIO_NORM_K / MIO_NORM_D)) * MIO_NORM_D;
+    const norm_dropout drop = make_norm_dropout(dropout, dropout_scale, seed, offset);
+
+    _FLOAT_ACCUM dw = 0.0f;
+    _FLOAT_ACCUM db = 0.0f;
+    for(uint e = lid; e < (MIO_NORM_ROWS / MIO_NORM_G) * MIO_NORM_D; e += MIO_NORM_GRP0)
+    {
+        const uint row = group + (e / MIO_NORM_D) * MIO_NORM_G;
+        _FLOAT_ACCUM xhat;
+        const _FLOAT_ACCUM g = norm_dpre(x,
+                                         residual,
+                                         drop,
+                                         dy,
+                                         weight,
+                                         bias,
+                                         mean[row],
+                                         rstd[row],
+                                         row,
+                                         k0 + e % MIO_NORM_D,
+                                         alpha,
+                                         beta,
+                                         gamma,
+                                         &xhat);
+        dw = mad(g, xhat, dw);
+        db += g;
+    }
+    norm_reduce2(&dw, &db, lcl_a, lcl_b, lid, MIO_NORM_GRP0);
+
+    if(lid == 0)
+    {
+        dweight[p] = CVT_ACCUM2FLOAT(dw);
+        dbias[p]   = CVT_ACCUM2FLOAT(db);
+    }
+}
+
+#endif // MIO_NORM_AFFINE
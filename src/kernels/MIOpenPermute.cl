@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// N-d tensor permutation. The output dimension i is the input dimension perm[i]; the host folds
+// the dimensions that stay adjacent, drops the unit ones and passes the lengths and both sets of
+// strides in the output order as compile-time lists, so every permutation gets its own build.
+//
+// MIO_PERM_Q is the output dimension that is innermost in the input. When it is innermost in
+// the output too, MIOpenPermuteCopy moves MIO_PERM_VEC elements per work-item. Otherwise
+// MIOpenPermuteTile stages MIO_PERM_TILE x MIO_PERM_TILE tiles of the (MIO_PERM_Q, last)
+// plane in LDS, so both the reads and the writes run along the contiguous dimension.
+//
+// MIO_PERM_CONVERT converts the elements through float on the way, bfloat16 is stored as ushort.
+
+#if MIO_PERM_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#endif
+
+#if MIO_PERM_IN_BF16 == 1 || MIO_PERM_OUT_BF16 == 1
+#include "bfloat16_dev.hpp"
+#endif
+
+#define PERM_PPCAT_NX(A, B) A##B
+#define PERM_PPCAT(A, B) PERM_PPCAT_NX(A, B)
+
+#if MIO_PERM_CONVERT == 1
+#define PERM_ACC_T float
+#if MIO_PERM_IN_BF16 == 1
+#define PERM_LOAD(v) bfloat16_to_float(v)
+#else
+#define PERM_LOAD(v) ((float)(v))
+#endif
+#if MIO_PERM_OUT_BF16 == 1
+#define PERM_STORE(v) float_to_bfloat16(v)
+#else
+#define PERM_STORE(v) ((MIO_PERM_OUT_T)(v))
+#endif
+#else
+#define PERM_ACC_T MIO_PERM_IN_T
+#define PERM_LOAD(v) (v)
+#define PERM_STORE(v) (v)
+#endif
+
+#define PERM_LAST (MIO_PERM_RANK - 1)
+
+#ifndef MIO_PERM_VEC
+#define MIO_PERM_VEC 1
+#endif
+
+__constant uint perm_lens[]         = {MIO_PERM_LENS};
+__constant ulong perm_in_strides[]  = {MIO_PERM_IN_STRIDES};
+__constant ulong perm_out_strides[] = {MIO_PERM_OUT_STRIDES};
+
+// Adds the offsets of the coordinate folded into idx over all the dimensions but the skipped
+// ones, the innermost dimension varies fastest.
+static inline void perm_offsets(uint idx, int skip0, int skip1, ulong* in_off, ulong* out_off)
+{
+    for(int d = PERM_LAST; d >= 0; --d)
+    {
+        if(d == skip0 || d == skip1)
+            continue;
+        const uint i = idx % perm_lens[d];
+        idx /= perm_lens[d];
+        *in_off += i * perm_in_strides[d];
+        *out_off += i * perm_out_strides[d];
+    }
+}
+
+#if MIO_PERM_VEC > 1
+#define PERM_IN_VEC_T PERM_PPCAT(MIO_PERM_IN_T, MIO_PERM_VEC)
+#define PERM_OUT_VEC_T PERM_PPCAT(MIO_PERM_OUT_T, MIO_PERM_VEC)
+#define PERM_VLOAD PERM_PPCAT(vload, MIO_PERM_VEC)
+#define PERM_VSTORE PERM_PPCAT(vstore, MIO_PERM_VEC)
+#endif
+
+// global size: (ceil(len[last] / MIO_PERM_VEC), product of the other lengths)
+__kernel void MIOpenPermuteCopy(const global MIO_PERM_IN_T* __restrict in,
+                                global MIO_PERM_OUT_T* __restrict out,
+                                ulong in_offset,
+                                ulong out_offset)
+{
+    const uint l = get_global_id(0) * MIO_PERM_VEC;
+    if(l >= perm_lens[PERM_LAST])
+        return;
+
+    ulong in_off  = in_offset;
+    ulong out_off = out_offset;
+    perm_offsets(get_global_id(1), PERM_LAST, PERM_LAST, &in_off, &out_off);
+
+#if MIO_PERM_VEC > 1
+    // The host only vectorizes unit-stride innermost dimensions the vector divides.
+    const PERM_IN_VEC_T v = PERM_VLOAD(0, in + in_off + l);
+#if MIO_PERM_CONVERT == 1
+    MIO_PERM_OUT_T r[MIO_PERM_VEC];
+    const MIO_PERM_IN_T* s = (const MIO_PERM_IN_T*)&v;
+    for(int k = 0; k < MIO_PERM_VEC; ++k)
+        r[k] = PERM_STORE(PERM_LOAD(s[k]));
+    PERM_VSTORE(*((const PERM_OUT_VEC_T*)r), 0, out + out_off + l);
+#else
+    PERM_VSTORE(v, 0, out + out_off + l);
+#endif
+#else
+    out[out_off + l * perm_out_strides[PERM_LAST]] =
+        PERM_STORE(PERM_LOAD(in[in_off + l * perm_in_strides[PERM_LAST]]));
+#endif
+}
+
+// local size: (MIO_PERM_TILE, MIO_PERM_ROWS)
+// global size: (tiles along MIO_PERM_Q, tiles along the last dimension, product of the rest)
+__attribute__((reqd_work_group_size(MIO_PERM_TILE, MIO_PERM_ROWS, 1))) __kernel void
+MIOpenPermuteTile(const global MIO_PERM_IN_T* __restrict in,
+                  global MIO_PERM_OUT_T* __restrict out,
+                  ulong in_offset,
+                  ulong out_offset)
+{
+    // The padding column keeps the transposed reads of the tile off a single LDS bank.
+    local PERM_ACC_T tile[MIO_PERM_TILE][MIO_PERM_TILE + 1];
+
+    const uint tx = get_local_id(0);
+    const uint ty = get_local_id(1);
+    const uint q0 = get_group_id(0) * MIO_PERM_TILE;
+    const uint l0 = get_group_id(1) * MIO_PERM_TILE;
+
+    ulong in_off  = in_offset;
+    ulong out_off = out_offset;
+    perm_offsets(get_group_id(2), MIO_PERM_Q, PERM_LAST, &in_off, &out_off);
+
+    const uint len_q = perm_lens[MIO_PERM_Q];
+    const uint len_l = perm_lens[PERM_LAST];
+
+    // Consecutive work-items read consecutive input elements along MIO_PERM_Q.
+    for(uint r = ty; r < MIO_PERM_TILE; r += MIO_PERM_ROWS)
+    {
+        const uint q = q0 + tx;
+        const uint l = l0 + r;
+        if(q < len_q && l < len_l)
+            tile[r][tx] = PERM_LOAD(in[in_off + q * perm_in_strides[MIO_PERM_Q] +
+                                       l * perm_in_strides[PERM_LAST]]);
+    }
+
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    // And write consecutive output elements along the last dimension.
+    for(uint r = ty; r < MIO_PERM_TILE; r += MIO_PERM_ROWS)
+    {
+        const uint q = q0 + r;
+        const uint l = l0 + tx;
+        if(q < len_q && l < len_l)
+            out[out_off + q * perm_out_strides[MIO_PERM_Q] + l * perm_out_strides[PERM_LAST]] =
+                PERM_STORE(tile[tx][r]);
+    }
+}
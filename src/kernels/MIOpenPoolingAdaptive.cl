@@ -0,0 +1,365 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Adaptive and global 2D pooling. Output (oh, ow) reduces the input region
+// [floor(oh * H / OH), ceil((oh + 1) * H / OH)) x [floor(ow * W / OW), ceil((ow + 1) * W / OW)),
+// the whole image for global pooling.
+//
+// The forward pass is a work-group reduction over the region. With MLO_POOLING_NHWC 0 an output
+// is reduced by a row of MLO_POOLING_GROUP_SZ0 work-items and a group holds
+// MLO_POOLING_GROUP_SZ1 channels; MLO_POOLING_FLAT marks dense planes of a global pooling, which
+// are then read MLO_POOLING_VEC elements at a time. With MLO_POOLING_NHWC 1 a work-item owns
+// MLO_POOLING_VEC channels and the MLO_POOLING_GROUP_SZ1 rows of the group split the region.
+// The backward pass gathers every input from the outputs whose regions cover it.
+//
+// The max pooling indices are dense in the layout of the output. MLO_POOLING_INDEX_MODE 0 stores
+// the offset in the region, 1 the offset in the image.
+
+#include "pooling_functions.h"
+
+#ifndef MLO_POOLING_VEC
+#define MLO_POOLING_VEC 1
+#endif
+
+#ifndef MLO_POOLING_NHWC
+#define MLO_POOLING_NHWC 0
+#endif
+
+#ifndef MLO_POOLING_FLAT
+#define MLO_POOLING_FLAT 0
+#endif
+
+#ifndef MLO_POOLING_INDEX_MODE
+#define MLO_POOLING_INDEX_MODE 0
+#endif
+
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX && defined(MLO_POOLING_SAVE_INDEX)
+#define MLO_POOLING_USE_MASK 1
+#else
+#define MLO_POOLING_USE_MASK 0
+#endif
+
+#if MLO_POOLING_NHWC
+#define MLO_POOLING_RED_VEC MLO_POOLING_VEC
+#define MLO_POOLING_RED_SZ MLO_POOLING_GROUP_SZ1
+#else
+#define MLO_POOLING_RED_VEC 1
+#define MLO_POOLING_RED_SZ MLO_POOLING_GROUP_SZ0
+#endif
+
+static inline void adapt_load(const global _FLOAT* p, float* v)
+{
+#if MLO_POOLING_VEC == 4
+    const _FLOAT4 t = vload4(0, p);
+    v[0]            = (float)t.x;
+    v[1]            = (float)t.y;
+    v[2]            = (float)t.z;
+    v[3]            = (float)t.w;
+#elif MLO_POOLING_VEC == 2
+    const _FLOAT2 t = vload2(0, p);
+    v[0]            = (float)t.x;
+    v[1]            = (float)t.y;
+#else
+    v[0] = (float)(*p);
+#endif
+}
+
+static inline void adapt_store(global _FLOAT* p, const float* v)
+{
+#if MLO_POOLING_VEC == 4
+    vstore4((_FLOAT4)((_FLOAT)v[0], (_FLOAT)v[1], (_FLOAT)v[2], (_FLOAT)v[3]), 0, p);
+#elif MLO_POOLING_VEC == 2
+    vstore2((_FLOAT2)((_FLOAT)v[0], (_FLOAT)v[1]), 0, p);
+#else
+    *p = (_FLOAT)v[0];
+#endif
+}
+
+static inline int region_begin(int o, int in_len, int out_len) { return (o * in_len) / out_len; }
+
+static inline int region_end(int o, int in_len, int out_len)
+{
+    return ((o + 1) * in_len + out_len - 1) / out_len;
+}
+
+static inline void adapt_reduce(float* val, uint* idx, float v, uint i)
+{
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+    if(v > *val)
+    {
+        *val = v;
+        *idx = i;
+    }
+#else
+    (void)idx;
+    (void)i;
+    *val += v;
+#endif
+}
+
+/// Combining in the order of the offsets keeps the first maximum, as the window kernels do.
+static inline void adapt_combine(float* val, uint* idx, float v, uint i)
+{
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+    if(v > *val || (v == *val && i < *idx))
+    {
+        *val = v;
+        *idx = i;
+    }
+#else
+    (void)idx;
+    (void)i;
+    *val += v;
+#endif
+}
+
+__attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0, MLO_POOLING_GROUP_SZ1, 1))) __kernel void
+mloPoolingAdaptiveFwd(const __global _FLOAT* bot,
+                      __global _FLOAT* top,
+#if !MLO_POOLING_USE_MASK
+                      UNUSED
+#endif
+                          __global index_t* mask,
+                      int channels,
+                      int bot_height,
+                      int bot_width,
+                      int top_height,
+                      int top_width,
+                      int bot_batch_str,
+                      int bot_c_str,
+                      int bot_h_str,
+                      int bot_w_str,
+                      int top_batch_str,
+                      int top_c_str,
+                      int top_h_str,
+                      int top_w_str)
+{
+    __local float lcl_val[MLO_POOLING_GROUP_SZ0 * MLO_POOLING_GROUP_SZ1 * MLO_POOLING_RED_VEC];
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+    __local uint lcl_idx[MLO_POOLING_GROUP_SZ0 * MLO_POOLING_GROUP_SZ1 * MLO_POOLING_RED_VEC];
+#endif
+
+#if MLO_POOLING_NHWC
+    const uint c    = get_global_id(0) * MLO_POOLING_VEC;
+    const uint pix  = get_group_id(1);
+    const uint lane = get_local_id(1);
+    const uint row  = get_local_id(0);
+#else
+    const uint c    = get_global_id(1);
+    const uint pix  = get_group_id(0);
+    const uint lane = get_local_id(0);
+    const uint row  = get_local_id(1);
+#endif
+    const uint b       = get_global_id(2);
+    const bool enabled = c < channels;
+
+    const int oh = pix / top_width;
+    const int ow = pix % top_width;
+    const int hs = region_begin(oh, bot_height, top_height);
+    const int ws = region_begin(ow, bot_width, top_width);
+    const int rw = region_end(ow, bot_width, top_width) - ws;
+    const int n  = (region_end(oh, bot_height, top_height) - hs) * rw;
+
+    float val[MLO_POOLING_VEC];
+    uint idx[MLO_POOLING_VEC];
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+    {
+        val[k] = MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX ? -INFINITY : 0.0f;
+        idx[k] = MLO_POOLING_INDEX_MODE == 1 ? hs * bot_width + ws : 0;
+    }
+
+    const global _FLOAT* src = bot + b * bot_batch_str + c * bot_c_str;
+#if MLO_POOLING_FLAT
+    // The region is the dense plane, an element offset is both offsets of an index.
+    for(int e = lane * MLO_POOLING_VEC; enabled && e < n; e += MLO_POOLING_RED_SZ * MLO_POOLING_VEC)
+    {
+        float v[MLO_POOLING_VEC];
+        adapt_load(src + e, v);
+        for(uint k = 0; k < MLO_POOLING_VEC; k++)
+            adapt_reduce(&val[0], &idx[0], v[k], e + k);
+    }
+#else
+    for(int e = lane; enabled && e < n; e += MLO_POOLING_RED_SZ)
+    {
+        const int h  = hs + e / rw;
+        const int w  = ws + e % rw;
+        const uint i = MLO_POOLING_INDEX_MODE == 1 ? h * bot_width + w : e;
+
+        float v[MLO_POOLING_VEC];
+        adapt_load(src + h * bot_h_str + w * bot_w_str, v);
+        for(uint k = 0; k < MLO_POOLING_VEC; k++)
+            adapt_reduce(&val[k], &idx[k], v[k], i);
+    }
+#endif
+
+    const uint slot = (row * MLO_POOLING_RED_SZ + lane) * MLO_POOLING_RED_VEC;
+    for(uint k = 0; k < MLO_POOLING_RED_VEC; k++)
+    {
+        lcl_val[slot + k] = val[k];
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+        lcl_idx[slot + k] = idx[k];
+#endif
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(uint s = MLO_POOLING_RED_SZ / 2; s > 0; s >>= 1)
+    {
+        if(lane < s)
+        {
+            const uint other = slot + s * MLO_POOLING_RED_VEC;
+            for(uint k = 0; k < MLO_POOLING_RED_VEC; k++)
+            {
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+                adapt_combine(&val[k], &idx[k], lcl_val[other + k], lcl_idx[other + k]);
+                lcl_idx[slot + k] = idx[k];
+#else
+                adapt_combine(&val[k], &idx[k], lcl_val[other + k], 0);
+#endif
+                lcl_val[slot + k] = val[k];
+            }
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if(lane != 0 || !enabled)
+        return;
+
+#if MLO_POOLING_OP_ID != MLO_POOLING_OP_MAX
+    for(uint k = 0; k < MLO_POOLING_RED_VEC; k++)
+        val[k] /= n;
+#endif
+
+    adapt_store(top + b * top_batch_str + c * top_c_str + oh * top_h_str + ow * top_w_str, val);
+#if MLO_POOLING_USE_MASK
+#if MLO_POOLING_NHWC
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+        mask[(b * top_height * top_width + pix) * channels + c + k] = (index_t)idx[k];
+#else
+    mask[(b * channels + c) * top_height * top_width + pix] = (index_t)idx[0];
+#endif
+#endif
+}
+
+/// A work-item owns MLO_POOLING_VEC channels of an input pixel with MLO_POOLING_NHWC 1,
+/// MLO_POOLING_VEC elements of a plane with MLO_POOLING_FLAT and a single element otherwise.
+__attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0, MLO_POOLING_GROUP_SZ1, 1))) __kernel void
+mloPoolingAdaptiveBwd(const __global _FLOAT* top_diff,
+                      __global _FLOAT* bot_diff,
+#if MLO_POOLING_OP_ID != MLO_POOLING_OP_MAX
+                      UNUSED
+#endif
+                          const __global index_t* mask,
+                      int channels,
+                      int bot_height,
+                      int bot_width,
+                      int top_height,
+                      int top_width,
+                      int bot_batch_str,
+                      int bot_c_str,
+                      int bot_h_str,
+                      int bot_w_str,
+                      int top_batch_str,
+                      int top_c_str,
+                      int top_h_str,
+                      int top_w_str)
+{
+    const uint b     = get_global_id(2);
+    const uint plane = bot_height * bot_width;
+#if MLO_POOLING_NHWC
+    const uint c   = get_global_id(0) * MLO_POOLING_VEC;
+    const uint pix = get_global_id(1);
+    if(c >= channels || pix >= plane)
+        return;
+#else
+    const uint e   = get_global_id(0) * MLO_POOLING_VEC;
+    const uint c   = e / plane;
+    const uint pix = e % plane;
+    if(c >= channels)
+        return;
+#endif
+
+    float grad[MLO_POOLING_VEC];
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+        grad[k] = 0.0f;
+
+    const global _FLOAT* dy = top_diff + b * top_batch_str + c * top_c_str;
+#if MLO_POOLING_FLAT
+    // A global pooling: every element of the dense plane belongs to the single output.
+    const float g = (float)dy[0];
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+    {
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+        grad[k] = mask[b * channels + c] == pix + k ? g : 0.0f;
+#else
+        grad[k] = g / plane;
+#endif
+    }
+    adapt_store(bot_diff + b * bot_batch_str + c * bot_c_str + pix, grad);
+#else
+    const int h = pix / bot_width;
+    const int w = pix % bot_width;
+
+    // Outputs [begin, end) whose regions cover (h, w).
+    const int oh_beg = (h * top_height) / bot_height;
+    const int ow_beg = (w * top_width) / bot_width;
+    const int oh_end = ((h + 1) * top_height + bot_height - 1) / bot_height;
+    const int ow_end = ((w + 1) * top_width + bot_width - 1) / bot_width;
+
+    for(int oh = oh_beg; oh < oh_end; oh++)
+    {
+        const int hs = region_begin(oh, bot_height, top_height);
+#if MLO_POOLING_OP_ID != MLO_POOLING_OP_MAX
+        const int rh = region_end(oh, bot_height, top_height) - hs;
+#endif
+        for(int ow = ow_beg; ow < ow_end; ow++)
+        {
+            const int ws = region_begin(ow, bot_width, top_width);
+            const int rw = region_end(ow, bot_width, top_width) - ws;
+
+            float g[MLO_POOLING_VEC];
+            adapt_load(dy + oh * top_h_str + ow * top_w_str, g);
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+            const uint self = MLO_POOLING_INDEX_MODE == 1 ? pix : (h - hs) * rw + (w - ws);
+#if MLO_POOLING_NHWC
+            const uint m = (b * top_height * top_width + oh * top_width + ow) * channels + c;
+            for(uint k = 0; k < MLO_POOLING_VEC; k++)
+                grad[k] += mask[m + k] == self ? g[k] : 0.0f;
+#else
+            const uint m = (b * channels + c) * top_height * top_width + oh * top_width + ow;
+            grad[0] += mask[m] == self ? g[0] : 0.0f;
+#endif
+#else
+            const float scale = 1.0f / (rh * rw);
+            for(uint k = 0; k < MLO_POOLING_VEC; k++)
+                grad[k] += g[k] * scale;
+#endif
+        }
+    }
+
+    adapt_store(bot_diff + b * bot_batch_str + c * bot_c_str + h * bot_h_str + w * bot_w_str,
+                grad);
+#endif
+}
@@ -73,71 +73,54 @@ mloPoolingNDMaxBwd(const __global _FLOAT* top_df,
         int bot_h_id = ((gid / bot_blk_w) % bot_blk_h) * PIX_H_PER_WORK;
         int bot_w_id = (gid % bot_blk_w) * PIX_W_PER_WORK;
 
-        int top_d_start =
-            bot_d_id + pad_d < KERNEL_SZ_D ? 0 : (bot_d_id + pad_d - KERNEL_SZ_D) / STRIDE_D + 1;
-        int top_h_start =
-            bot_h_id + pad_h < KERNEL_SZ_H ? 0 : (bot_h_id + pad_h - KERNEL_SZ_H) / STRIDE_H + 1;
-        int top_w_start =
-            bot_w_id + pad_w < KERNEL_SZ_W ? 0 : (bot_w_id + pad_w - KERNEL_SZ_W) / STRIDE_W + 1;
-
-        int top_d_end = (bot_d_id + PIX_D_PER_WORK - 1 + pad_d) / STRIDE_D + 1;
-        int top_h_end = (bot_h_id + PIX_H_PER_WORK - 1 + pad_h) / STRIDE_H + 1;
-        int top_w_end = (bot_w_id + PIX_W_PER_WORK - 1 + pad_w) / STRIDE_W + 1;
-
-        top_d_end = min(top_d_end, (int)top_d);
-        top_h_end = min(top_h_end, (int)top_h);
-        top_w_end = min(top_w_end, (int)top_w);
-
-        _FLOAT bot_data[PIX_D_PER_WORK][PIX_H_PER_WORK][PIX_W_PER_WORK] = {0};
-
-        for(int h = top_d_start; h < top_d_end; ++h)
-        {
-            for(int j = top_h_start; j < top_h_end; ++j)
-            {
-                for(int i = top_w_start; i < top_w_end; ++i)
-                {
-                    uint top_gbl_off =
-                        b_id * top_str_b + c_id * top_str_c + h * top_str_d + j * top_str_h + i;
-
-                    _FLOAT top_val   = b_id < batch ? top_df[top_gbl_off] : 0;
-                    index_t mask_idx = b_id < batch ? mask[top_gbl_off] : MLO_POOLING_INDEX_MAX;
-
-                    uint mask_d_id = mask_idx / bot_h / bot_w;
-                    uint mask_h_id = (mask_idx / bot_w) % bot_h;
-                    uint mask_w_id = mask_idx % bot_w;
-
-                    if(mask_d_id >= bot_d_id && mask_h_id >= bot_h_id && mask_w_id >= bot_w_id &&
-                       mask_d_id < bot_d_id + PIX_D_PER_WORK &&
-                       mask_h_id < bot_h_id + PIX_H_PER_WORK &&
-                       mask_w_id < bot_w_id + PIX_W_PER_WORK)
-                    {
-                        mask_d_id -= bot_d_id;
-                        mask_h_id -= bot_h_id;
-                        mask_w_id -= bot_w_id;
-
-                        bot_data[mask_d_id][mask_h_id][mask_w_id] += top_val;
-                    }
-                }
-            }
-        }
-
         uint bot_off = b_id * bot_str_b + c_id * bot_str_c + bot_d_id * bot_str_d +
                        bot_h_id * bot_str_h + bot_w_id;
+        uint top_off = b_id * top_str_b + c_id * top_str_c;
 
+        // Each input pixel gathers its gradient from the outputs whose windows cover it: an
+        // output contributes when its stored index names this pixel, so dx is written exactly
+        // once and needs neither a zero-initialization pass nor atomics for overlapping windows.
         for(uint m = 0; m < PIX_D_PER_WORK; m++)
         {
+            int d      = bot_d_id + m;
+            int pd     = d + (int)pad_d;
+            int td_beg = pd < KERNEL_SZ_D ? 0 : (pd - KERNEL_SZ_D) / STRIDE_D + 1;
+            int td_end = min(pd / STRIDE_D + 1, (int)top_d);
+
             for(uint k = 0; k < PIX_H_PER_WORK; k++)
             {
+                int h      = bot_h_id + k;
+                int ph     = h + (int)pad_h;
+                int th_beg = ph < KERNEL_SZ_H ? 0 : (ph - KERNEL_SZ_H) / STRIDE_H + 1;
+                int th_end = min(ph / STRIDE_H + 1, (int)top_h);
+
                 for(uint l = 0; l < PIX_W_PER_WORK; l++)
                 {
+                    int w      = bot_w_id + l;
+                    int pw     = w + (int)pad_w;
+                    int tw_beg = pw < KERNEL_SZ_W ? 0 : (pw - KERNEL_SZ_W) / STRIDE_W + 1;
+                    int tw_end = min(pw / STRIDE_W + 1, (int)top_w);
 
-                    if(bot_d_id + m < bot_d && bot_h_id + k < bot_h && bot_w_id + l < bot_w &&
-                       b_id < batch)
-                    {
-                        uint bot_idx = bot_off + m * bot_str_d + k * bot_str_h + l;
+                    if(d >= (int)bot_d || h >= (int)bot_h || w >= (int)bot_w || b_id >= (int)batch)
+                        continue;
 
-                        bot_df[bot_idx] = bot_data[m][k][l];
+                    index_t self = (d * bot_h + h) * bot_w + w;
+                    _FLOAT grad  = 0;
+
+                    for(int td = td_beg; td < td_end; ++td)
+                    {
+                        for(int th = th_beg; th < th_end; ++th)
+                        {
+                            uint top_row = top_off + td * top_str_d + th * top_str_h;
+                            for(int tw = tw_beg; tw < tw_end; ++tw)
+                            {
+                                if(mask[top_row + tw] == self)
+                                    grad += top_df[top_row + tw];
+                            }
+                        }
                     }
+
+                    bot_df[bot_off + m * bot_str_d + k * bot_str_h + l] = grad;
                 }
             }
         }
@@ -0,0 +1,313 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// 2D pooling of NHWC tensors. A work-item owns MLO_POOLING_VEC consecutive channels of an output
+// (forward) or input (backward) pixel and loads them with one vector access; neighbouring
+// work-items of dimension 0 read neighbouring channels, so every access is coalesced.
+//
+// The max pooling indices are laid out as dense NHWC. MLO_POOLING_INDEX_MODE 0 stores the offset
+// in the window and 1 the offset in the image as index_t, 2 packs the offset in the window into
+// MLO_POOLING_INDEX_BITS (4 or 8) bits, two channels per byte with 4 bits.
+
+#include "pooling_functions.h"
+
+#ifndef MLO_POOLING_VEC
+#define MLO_POOLING_VEC 1
+#endif
+
+#ifndef MLO_POOLING_INDEX_MODE
+#define MLO_POOLING_INDEX_MODE 0
+#endif
+
+#ifndef MLO_POOLING_INDEX_BITS
+#define MLO_POOLING_INDEX_BITS 8
+#endif
+
+#define MLO_POOLING_WINDOW (MLO_POOLING_KERNEL_SZ0 * MLO_POOLING_KERNEL_SZ1)
+
+#if MLO_POOLING_INDEX_MODE == 2
+#if MLO_POOLING_INDEX_BITS == 4 && (MLO_POOLING_VEC % 2 != 0 || MLO_POOLING_WINDOW > 16)
+#error "4-bit indices need pairs of channels and windows of up to 16 elements"
+#endif
+#if MLO_POOLING_WINDOW > 256
+#error "Packed indices need windows of up to 256 elements"
+#endif
+typedef uchar mask_t;
+#else
+typedef index_t mask_t;
+#endif
+
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX && defined(MLO_POOLING_SAVE_INDEX)
+#define MLO_POOLING_USE_MASK 1
+#else
+#define MLO_POOLING_USE_MASK 0
+#endif
+
+static inline void pool_load(const global _FLOAT* p, float* v)
+{
+#if MLO_POOLING_VEC == 4
+    const _FLOAT4 t = vload4(0, p);
+    v[0]            = (float)t.x;
+    v[1]            = (float)t.y;
+    v[2]            = (float)t.z;
+    v[3]            = (float)t.w;
+#elif MLO_POOLING_VEC == 2
+    const _FLOAT2 t = vload2(0, p);
+    v[0]            = (float)t.x;
+    v[1]            = (float)t.y;
+#else
+    v[0] = (float)(*p);
+#endif
+}
+
+static inline void pool_store(global _FLOAT* p, const float* v)
+{
+#if MLO_POOLING_VEC == 4
+    vstore4((_FLOAT4)((_FLOAT)v[0], (_FLOAT)v[1], (_FLOAT)v[2], (_FLOAT)v[3]), 0, p);
+#elif MLO_POOLING_VEC == 2
+    vstore2((_FLOAT2)((_FLOAT)v[0], (_FLOAT)v[1]), 0, p);
+#else
+    *p = (_FLOAT)v[0];
+#endif
+}
+
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+/// e is the dense NHWC index of the first channel of the vector.
+static inline void pool_store_mask(global mask_t* mask, uint e, const uint* idx)
+{
+#if MLO_POOLING_INDEX_MODE == 2 && MLO_POOLING_INDEX_BITS == 4
+    for(uint k = 0; k < MLO_POOLING_VEC; k += 2)
+        mask[(e + k) / 2] = (uchar)((idx[k + 1] << 4) | idx[k]);
+#else
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+        mask[e + k] = (mask_t)idx[k];
+#endif
+}
+
+static inline void pool_load_mask(const global mask_t* mask, uint e, uint* idx)
+{
+#if MLO_POOLING_INDEX_MODE == 2 && MLO_POOLING_INDEX_BITS == 4
+    for(uint k = 0; k < MLO_POOLING_VEC; k += 2)
+    {
+        const uint packed = mask[(e + k) / 2];
+        idx[k]            = packed & 0xF;
+        idx[k + 1]        = packed >> 4;
+    }
+#else
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+        idx[k] = mask[e + k];
+#endif
+}
+#endif
+
+static inline uint
+pool_size(int hstart, int wstart, int bot_height, int bot_width)
+{
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_AVE
+    const int hend = min(hstart + MLO_POOLING_KERNEL_SZ1, bot_height);
+    const int wend = min(wstart + MLO_POOLING_KERNEL_SZ0, bot_width);
+    const uint n   = (hend - max(hstart, 0)) * (wend - max(wstart, 0));
+    return n == 0 ? 1 : n;
+#else
+    (void)hstart;
+    (void)wstart;
+    (void)bot_height;
+    (void)bot_width;
+    return MLO_POOLING_WINDOW;
+#endif
+}
+
+__attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0, MLO_POOLING_GROUP_SZ1, 1))) __kernel void
+mloPoolingNHWCFwd(const __global _FLOAT* bot,
+                  __global _FLOAT* top,
+#if !MLO_POOLING_USE_MASK
+                  UNUSED
+#endif
+                      __global mask_t* mask,
+                  int pad1,
+                  int pad0,
+                  int channels,
+                  int bot_height,
+                  int bot_width,
+                  int top_height,
+                  int top_width,
+                  int bot_batch_str,
+                  int bot_h_str,
+                  int bot_w_str,
+                  int top_batch_str,
+                  int top_h_str,
+                  int top_w_str)
+{
+    const uint c   = get_global_id(0) * MLO_POOLING_VEC;
+    const uint pix = get_global_id(1);
+    const uint b   = get_global_id(2);
+    if(c >= channels || pix >= top_height * top_width)
+        return;
+
+    const uint oh    = pix / top_width;
+    const uint ow    = pix % top_width;
+    const int hstart = (int)(oh * MLO_POOLING_STRIDE1) - pad1;
+    const int wstart = (int)(ow * MLO_POOLING_STRIDE0) - pad0;
+
+    float res[MLO_POOLING_VEC];
+#if MLO_POOLING_USE_MASK
+    uint idx[MLO_POOLING_VEC];
+#endif
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+    {
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+        res[k] = -MAX_VAL;
+#else
+        res[k] = 0.0f;
+#endif
+#if MLO_POOLING_USE_MASK
+        idx[k] = 0;
+#endif
+    }
+
+    const global _FLOAT* bot_b = bot + b * bot_batch_str + c;
+    for(uint j = 0; j < MLO_POOLING_KERNEL_SZ1; j++)
+    {
+        const int h = hstart + (int)j;
+        if(h < 0 || h >= bot_height)
+            continue;
+        for(uint i = 0; i < MLO_POOLING_KERNEL_SZ0; i++)
+        {
+            const int w = wstart + (int)i;
+            if(w < 0 || w >= bot_width)
+                continue;
+
+            float v[MLO_POOLING_VEC];
+            pool_load(bot_b + h * bot_h_str + w * bot_w_str, v);
+            for(uint k = 0; k < MLO_POOLING_VEC; k++)
+            {
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+                if(v[k] > res[k])
+                {
+                    res[k] = v[k];
+#if MLO_POOLING_USE_MASK
+#if MLO_POOLING_INDEX_MODE == 1
+                    idx[k] = h * bot_width + w;
+#else
+                    idx[k] = i + MLO_POOLING_KERNEL_SZ0 * j;
+#endif
+#endif
+                }
+#else
+                res[k] += v[k];
+#endif
+            }
+        }
+    }
+
+#if MLO_POOLING_OP_ID != MLO_POOLING_OP_MAX
+    const float scale = 1.0f / pool_size(hstart, wstart, bot_height, bot_width);
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+        res[k] *= scale;
+#endif
+
+    pool_store(top + b * top_batch_str + oh * top_h_str + ow * top_w_str + c, res);
+#if MLO_POOLING_USE_MASK
+    pool_store_mask(mask, (b * top_height * top_width + pix) * channels + c, idx);
+#endif
+}
+
+/// Gathers the gradient of an input pixel from the windows that cover it.
+__attribute__((reqd_work_group_size(MLO_POOLING_GROUP_SZ0, MLO_POOLING_GROUP_SZ1, 1))) __kernel void
+mloPoolingNHWCBwd(const __global _FLOAT* top_diff,
+                  __global _FLOAT* bot_diff,
+#if MLO_POOLING_OP_ID != MLO_POOLING_OP_MAX
+                  UNUSED
+#endif
+                      const __global mask_t* mask,
+                  int pad1,
+                  int pad0,
+                  int channels,
+                  int bot_height,
+                  int bot_width,
+                  int top_height,
+                  int top_width,
+                  int bot_batch_str,
+                  int bot_h_str,
+                  int bot_w_str,
+                  int top_batch_str,
+                  int top_h_str,
+                  int top_w_str)
+{
+    const uint c   = get_global_id(0) * MLO_POOLING_VEC;
+    const uint pix = get_global_id(1);
+    const uint b   = get_global_id(2);
+    if(c >= channels || pix >= bot_height * bot_width)
+        return;
+
+    const int h = pix / bot_width;
+    const int w = pix % bot_width;
+
+    // Windows [start, end) of the outputs covering (h, w).
+    const int ph = h + pad1;
+    const int pw = w + pad0;
+    const int oh_start =
+        ph < MLO_POOLING_KERNEL_SZ1 ? 0 : (ph - MLO_POOLING_KERNEL_SZ1) / MLO_POOLING_STRIDE1 + 1;
+    const int ow_start =
+        pw < MLO_POOLING_KERNEL_SZ0 ? 0 : (pw - MLO_POOLING_KERNEL_SZ0) / MLO_POOLING_STRIDE0 + 1;
+    const int oh_end = min(ph / MLO_POOLING_STRIDE1 + 1, top_height);
+    const int ow_end = min(pw / MLO_POOLING_STRIDE0 + 1, top_width);
+
+    float grad[MLO_POOLING_VEC];
+    for(uint k = 0; k < MLO_POOLING_VEC; k++)
+        grad[k] = 0.0f;
+
+    const global _FLOAT* top_b = top_diff + b * top_batch_str + c;
+    for(int oh = oh_start; oh < oh_end; oh++)
+    {
+        for(int ow = ow_start; ow < ow_end; ow++)
+        {
+            float dy[MLO_POOLING_VEC];
+            pool_load(top_b + oh * top_h_str + ow * top_w_str, dy);
+
+#if MLO_POOLING_OP_ID == MLO_POOLING_OP_MAX
+            uint idx[MLO_POOLING_VEC];
+            pool_load_mask(mask, ((b * top_height + oh) * top_width + ow) * channels + c, idx);
+#if MLO_POOLING_INDEX_MODE == 1
+            const uint self = h * bot_width + w;
+#else
+            const uint self = (pw - ow * MLO_POOLING_STRIDE0) +
+                              MLO_POOLING_KERNEL_SZ0 * (ph - oh * MLO_POOLING_STRIDE1);
+#endif
+            for(uint k = 0; k < MLO_POOLING_VEC; k++)
+                grad[k] += idx[k] == self ? dy[k] : 0.0f;
+#else
+            const int hstart  = oh * MLO_POOLING_STRIDE1 - pad1;
+            const int wstart  = ow * MLO_POOLING_STRIDE0 - pad0;
+            const float scale = 1.0f / pool_size(hstart, wstart, bot_height, bot_width);
+            for(uint k = 0; k < MLO_POOLING_VEC; k++)
+                grad[k] += dy[k] * scale;
+#endif
+        }
+    }
+
+    pool_store(bot_diff + b * bot_batch_str + h * bot_h_str + w * bot_w_str + c, grad);
+}
@@ -30,38 +30,54 @@
 #ifndef MIOPEN_USE_FP32
 #define MIOPEN_USE_FP32 0
 #endif
+#ifndef MIOPEN_USE_BFP16
+#define MIOPEN_USE_BFP16 0
+#endif
+
+#include "float_types.h"
 
 #if MIOPEN_USE_FP16 == 1
-#pragma OPENCL EXTENSION cl_khr_fp16 : enable
-#define _FLOAT half
-#define EPSILON (_FLOAT)0.0001
-#ifndef HALF_MAX
-#define MAX_VAL 65504 /* max value */
-#else
-#define MAX_VAL HALF_MAX
-#endif
-#endif
-#if MIOPEN_USE_FP32 == 1
-#define _FLOAT float
-#define EPSILON (_FLOAT)0.000001
-#ifndef FLT_MAX
-#define MAX_VAL 3.402823466e+38F /* max value */
+#define EPSILON (_FLOAT_ACCUM)0.0001
 #else
-#define MAX_VAL FLT_MAX
-#endif
+#define EPSILON (_FLOAT_ACCUM)0.000001
 #endif
 
-#define _FLOAT_PREC _FLOAT
+// The gates and the cell state are computed in float for the 16 bit types too, only the
+// workspace and the tensors keep the type of the data.
+#define _FLOAT_PREC _FLOAT_ACCUM
 #define UNUSED __attribute__((__unused__))
 
 #include "activation_functions.h"
 
+static void LoadDat(_FLOAT_PREC* dat, const global _FLOAT* src)
+{
+    _FLOAT tmp[RD_BLCK];
+    *((READ_TYPE*)tmp) = *((const global READ_TYPE*)src);
+    for(int i = 0; i < RD_BLCK; ++i)
+    {
+        dat[i] = CVT_FLOAT2ACCUM(tmp[i]);
+    }
+}
+
+static void StoreDat(global _FLOAT* dst, const _FLOAT_PREC* dat)
+{
+    _FLOAT tmp[RD_BLCK];
+    for(int i = 0; i < RD_BLCK; ++i)
+    {
+        tmp[i] = CVT_ACCUM2FLOAT(dat[i]);
+    }
+    *((global READ_TYPE*)dst) = *((READ_TYPE*)tmp);
+}
+
 #ifndef LSTM_FWD_HID
 #define LSTM_FWD_HID 0
 #endif
 #ifndef LSTM_BWD_HID
 #define LSTM_BWD_HID 0
 #endif
+#ifndef GRU_FWD_HID
+#define GRU_FWD_HID 0
+#endif
 
 #if LSTM_FWD_HID
 #ifndef INFERENCE_MODE
@@ -90,18 +106,18 @@ __kernel void LSTMFwdHidUpdate(const global _FLOAT* cx,
                                const int cur_batch,
                                const int use_batch)
 {
-    int total_item     = cur_batch * hy_h / RD_BLCK;
-    total_item         = max(total_item, 1);
-    _FLOAT activ_param = 1;
+    int total_item          = cur_batch * hy_h / RD_BLCK;
+    total_item              = max(total_item, 1);
+    _FLOAT_PREC activ_param = 1;
 
-    _FLOAT s_dat[RD_BLCK];
+    _FLOAT_PREC s_dat[RD_BLCK];
 
-    _FLOAT i_dat[RD_BLCK];
-    _FLOAT f_dat[RD_BLCK];
-    _FLOAT o_dat[RD_BLCK];
-    _FLOAT c_dat[RD_BLCK];
+    _FLOAT_PREC i_dat[RD_BLCK];
+    _FLOAT_PREC f_dat[RD_BLCK];
+    _FLOAT_PREC o_dat[RD_BLCK];
+    _FLOAT_PREC c_dat[RD_BLCK];
 
-    _FLOAT cx_dat[RD_BLCK];
+    _FLOAT_PREC cx_dat[RD_BLCK];
 
     for(int gid = get_global_id(0); gid < total_item; gid += get_global_size(0))
     {
@@ -109,34 +125,33 @@ __kernel void LSTMFwdHidUpdate(const global _FLOAT* cx,
         int h_idx   = gid * RD_BLCK - b_idx * hy_h;
         int rsv_idx = b_idx * hy_stride + h_idx;
 
-        *((READ_TYPE*)s_dat) = *((const global READ_TYPE*)(reservespace + i_offset + rsv_idx));
+        LoadDat(s_dat, reservespace + i_offset + rsv_idx);
         ActivationFunction_Sigmoid(
-            RD_BLCK, i_dat, (const _FLOAT*)s_dat, activ_param, activ_param, activ_param);
+            RD_BLCK, i_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
 
-        *((READ_TYPE*)s_dat) = *((const global READ_TYPE*)(reservespace + f_offset + rsv_idx));
+        LoadDat(s_dat, reservespace + f_offset + rsv_idx);
         ActivationFunction_Sigmoid(
-            RD_BLCK, f_dat, (const _FLOAT*)s_dat, activ_param, activ_param, activ_param);
+            RD_BLCK, f_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
 
-        *((READ_TYPE*)s_dat) = *((const global READ_TYPE*)(reservespace + o_offset + rsv_idx));
+        LoadDat(s_dat, reservespace + o_offset + rsv_idx);
         ActivationFunction_Sigmoid(
-            RD_BLCK, o_dat, (const _FLOAT*)s_dat, activ_param, activ_param, activ_param);
+            RD_BLCK, o_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
 
-        *((READ_TYPE*)s_dat) = *((const global READ_TYPE*)(reservespace + c_offset + rsv_idx));
+        LoadDat(s_dat, reservespace + c_offset + rsv_idx);
         ActivationFunction_TanH(
-            RD_BLCK, c_dat, (const _FLOAT*)s_dat, activ_param, activ_param, activ_param);
+            RD_BLCK, c_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
 
         if((bool)is_seq_begin)
         {
             if((bool)use_cx)
             {
-                *((READ_TYPE*)cx_dat) =
-                    *((const global READ_TYPE*)(cx + cx_offset + gid * RD_BLCK));
+                LoadDat(cx_dat, cx + cx_offset + gid * RD_BLCK);
             }
             else
             {
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
-                    cx_dat[i] = (_FLOAT)0;
+                    cx_dat[i] = (_FLOAT_PREC)0;
                 }
             }
         }
@@ -144,21 +159,19 @@ __kernel void LSTMFwdHidUpdate(const global _FLOAT* cx,
         {
             if(b_idx < use_batch)
             {
-                *((READ_TYPE*)cx_dat) =
-                    *((const global READ_TYPE*)(reservespace + cell_offset_pre + rsv_idx));
+                LoadDat(cx_dat, reservespace + cell_offset_pre + rsv_idx);
             }
             else
             {
                 if(direction == 1 && (bool)use_cx)
                 {
-                    *((READ_TYPE*)cx_dat) =
-                        *((const global READ_TYPE*)(cx + cx_offset + gid * RD_BLCK));
+                    LoadDat(cx_dat, cx + cx_offset + gid * RD_BLCK);
                 }
                 else
                 {
                     for(int i = 0; i < RD_BLCK; ++i)
                     {
-                        cx_dat[i] = (_FLOAT)0;
+                        cx_dat[i] = (_FLOAT_PREC)0;
                     }
                 }
             }
@@ -170,22 +183,21 @@ __kernel void LSTMFwdHidUpdate(const global _FLOAT* cx,
         }
         ActivationFunction_TanH(RD_BLCK, cx_dat, s_dat, activ_param, activ_param, activ_param);
 
-        *((global READ_TYPE*)(reservespace + i_offset + rsv_idx)) = *((READ_TYPE*)i_dat);
-        *((global READ_TYPE*)(reservespace + f_offset + rsv_idx)) = *((READ_TYPE*)f_dat);
-        *((global READ_TYPE*)(reservespace + o_offset + rsv_idx)) = *((READ_TYPE*)o_dat);
-        *((global READ_TYPE*)(reservespace + c_offset + rsv_idx)) = *((READ_TYPE*)c_dat);
+        StoreDat(reservespace + i_offset + rsv_idx, i_dat);
+        StoreDat(reservespace + f_offset + rsv_idx, f_dat);
+        StoreDat(reservespace + o_offset + rsv_idx, o_dat);
+        StoreDat(reservespace + c_offset + rsv_idx, c_dat);
 
-        *((global READ_TYPE*)(reservespace + cell_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreDat(reservespace + cell_offset + rsv_idx, s_dat);
 #if !INFERENCE_MODE
-        *((global READ_TYPE*)(reservespace + activ_cell_offset + b_idx * hy_stride / 6 + h_idx)) =
-            *((READ_TYPE*)cx_dat);
+        StoreDat(reservespace + activ_cell_offset + b_idx * hy_stride / 6 + h_idx, cx_dat);
 #endif
         for(int i = 0; i < RD_BLCK; ++i)
         {
             s_dat[i] = o_dat[i] * cx_dat[i];
         }
 
-        *((global READ_TYPE*)(reservespace + hidden_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreDat(reservespace + hidden_offset + rsv_idx, s_dat);
     }
 }
 #endif
@@ -222,26 +234,26 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                const int use_batch,
                                const int use_batch2)
 {
-    int total_item     = cur_batch * hy_h / RD_BLCK;
-    total_item         = max(total_item, 1);
-    _FLOAT activ_param = 1;
+    int total_item          = cur_batch * hy_h / RD_BLCK;
+    total_item              = max(total_item, 1);
+    _FLOAT_PREC activ_param = 1;
 
-    _FLOAT dh_dat[RD_BLCK];
+    _FLOAT_PREC dh_dat[RD_BLCK];
 
-    _FLOAT s_dat[RD_BLCK];
+    _FLOAT_PREC s_dat[RD_BLCK];
 
-    _FLOAT i_dat[RD_BLCK];
-    _FLOAT f_dat[RD_BLCK];
-    _FLOAT o_dat[RD_BLCK];
-    _FLOAT c_dat[RD_BLCK];
+    _FLOAT_PREC i_dat[RD_BLCK];
+    _FLOAT_PREC f_dat[RD_BLCK];
+    _FLOAT_PREC o_dat[RD_BLCK];
+    _FLOAT_PREC c_dat[RD_BLCK];
 
-    _FLOAT di_dat[RD_BLCK];
-    _FLOAT df_dat[RD_BLCK];
-    _FLOAT do_dat[RD_BLCK];
-    _FLOAT dc_dat[RD_BLCK];
+    _FLOAT_PREC di_dat[RD_BLCK];
+    _FLOAT_PREC df_dat[RD_BLCK];
+    _FLOAT_PREC do_dat[RD_BLCK];
+    _FLOAT_PREC dc_dat[RD_BLCK];
 
-    _FLOAT cx_dat[RD_BLCK];
-    _FLOAT dcx_dat[RD_BLCK];
+    _FLOAT_PREC cx_dat[RD_BLCK];
+    _FLOAT_PREC dcx_dat[RD_BLCK];
 
     for(int gid = get_global_id(0); gid < total_item; gid += get_global_size(0))
     {
@@ -249,20 +261,19 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         int h_idx   = gid * RD_BLCK - b_idx * hy_h;
         int rsv_idx = b_idx * hy_stride + h_idx;
 
-        *((READ_TYPE*)dh_dat) = *((const global READ_TYPE*)(workspace + dhidden_offset + rsv_idx));
-        *((READ_TYPE*)o_dat)  = *((const global READ_TYPE*)(reservespace + o_offset + rsv_idx));
+        LoadDat(dh_dat, workspace + dhidden_offset + rsv_idx);
+        LoadDat(o_dat, reservespace + o_offset + rsv_idx);
 
-        *((READ_TYPE*)i_dat) = *((const global READ_TYPE*)(reservespace + i_offset + rsv_idx));
+        LoadDat(i_dat, reservespace + i_offset + rsv_idx);
 
-        *((READ_TYPE*)c_dat) = *((const global READ_TYPE*)(reservespace + c_offset + rsv_idx));
+        LoadDat(c_dat, reservespace + c_offset + rsv_idx);
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
             s_dat[i] = dh_dat[i] * o_dat[i];
         }
 
-        *((READ_TYPE*)cx_dat) = *((const global READ_TYPE*)(reservespace + activ_cell_offset +
-                                                            b_idx * hy_stride / 6 + h_idx));
+        LoadDat(cx_dat, reservespace + activ_cell_offset + b_idx * hy_stride / 6 + h_idx);
 
         ActivationFunction_TanH_Diff(RD_BLCK,
                                      dcx_dat,
@@ -278,8 +289,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         {
             if((bool)use_dcy)
             {
-                *((READ_TYPE*)s_dat) =
-                    *((const global READ_TYPE*)(dcy + dcy_offset + gid * RD_BLCK));
+                LoadDat(s_dat, dcy + dcy_offset + gid * RD_BLCK);
 
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
@@ -291,10 +301,8 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         {
             if(b_idx < use_batch)
             {
-                *((READ_TYPE*)s_dat) =
-                    *((const global READ_TYPE*)(workspace + dcell_offset_pre + rsv_idx));
-                *((READ_TYPE*)f_dat) =
-                    *((const global READ_TYPE*)(reservespace + f_offset_pre + rsv_idx));
+                LoadDat(s_dat, workspace + dcell_offset_pre + rsv_idx);
+                LoadDat(f_dat, reservespace + f_offset_pre + rsv_idx);
 
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
@@ -305,8 +313,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
             {
                 if(direction == 0 && (bool)use_dcy)
                 {
-                    *((READ_TYPE*)s_dat) =
-                        *((const global READ_TYPE*)(dcy + dcy_offset + gid * RD_BLCK));
+                    LoadDat(s_dat, dcy + dcy_offset + gid * RD_BLCK);
 
                     for(int i = 0; i < RD_BLCK; ++i)
                     {
@@ -320,8 +327,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         {
             if((bool)use_cx)
             {
-                *((READ_TYPE*)df_dat) =
-                    *((const global READ_TYPE*)(cx + cx_offset + gid * RD_BLCK));
+                LoadDat(df_dat, cx + cx_offset + gid * RD_BLCK);
 
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
@@ -332,7 +338,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
             {
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
-                    df_dat[i] = (_FLOAT)0;
+                    df_dat[i] = (_FLOAT_PREC)0;
                 }
             }
         }
@@ -340,8 +346,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
         {
             if(b_idx < use_batch2)
             {
-                *((READ_TYPE*)df_dat) =
-                    *((const global READ_TYPE*)(reservespace + cell_offset_pre + rsv_idx));
+                LoadDat(df_dat, reservespace + cell_offset_pre + rsv_idx);
 
                 for(int i = 0; i < RD_BLCK; ++i)
                 {
@@ -352,8 +357,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
             {
                 if(direction == 1 && (bool)use_cx)
                 {
-                    *((READ_TYPE*)df_dat) =
-                        *((const global READ_TYPE*)(cx + cx_offset + gid * RD_BLCK));
+                    LoadDat(df_dat, cx + cx_offset + gid * RD_BLCK);
 
                     for(int i = 0; i < RD_BLCK; ++i)
                     {
@@ -364,13 +368,13 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                 {
                     for(int i = 0; i < RD_BLCK; ++i)
                     {
-                        df_dat[i] = (_FLOAT)0;
+                        df_dat[i] = (_FLOAT_PREC)0;
                     }
                 }
             }
         }
 
-        *((READ_TYPE*)f_dat) = *((const global READ_TYPE*)(reservespace + f_offset + rsv_idx));
+        LoadDat(f_dat, reservespace + f_offset + rsv_idx);
 
         ActivationFunction_Sigmoid_Diff(RD_BLCK,
                                         s_dat,
@@ -382,7 +386,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                         activ_param,
                                         activ_param);
 
-        *((global READ_TYPE*)(workspace + df_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreDat(workspace + df_offset + rsv_idx, s_dat);
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
@@ -399,7 +403,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                         activ_param,
                                         activ_param);
 
-        *((global READ_TYPE*)(workspace + di_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreDat(workspace + di_offset + rsv_idx, s_dat);
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
@@ -416,7 +420,7 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                         activ_param,
                                         activ_param);
 
-        *((global READ_TYPE*)(workspace + do_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreDat(workspace + do_offset + rsv_idx, s_dat);
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
@@ -433,10 +437,134 @@ __kernel void LSTMBwdHidUpdate(const global _FLOAT* cx,
                                      activ_param,
                                      activ_param);
 
-        *((global READ_TYPE*)(workspace + dc_offset + rsv_idx)) = *((READ_TYPE*)s_dat);
+        StoreDat(workspace + dc_offset + rsv_idx, s_dat);
+
+        StoreDat(workspace + dcell_offset + rsv_idx, dcx_dat);
+        StoreDat(workspace + dhidden_offset + rsv_idx, dh_dat);
+    }
+}
+#endif
+
+#if GRU_FWD_HID
+#ifndef INFERENCE_MODE
+#define INFERENCE_MODE 0
+#endif
+
+// One time step of a GRU after the GEMMs: the z, r and c gates hold their input and hidden
+// parts added up, except for c which holds its hidden part only, while the hidden state holds
+// the input part of c. Computes the gates and h = (1 - z) * c + z * h_prev in one pass. Without
+// INFERENCE_MODE the activated gates go to activ_offset past the pre-activations, and so does
+// the hidden part of c, as the backward pass expects them.
+__kernel void GRUFwdHidUpdate(const global _FLOAT* hx,
+                              global _FLOAT* reservespace,
+                              const int hy_h,
+                              const int hy_stride,
+                              const long hx_offset,
+                              const long z_offset,
+                              const long r_offset,
+                              const long c_offset,
+                              const long hidden_offset,
+                              const long hidden_offset_pre,
+#if INFERENCE_MODE
+                              UNUSED
+#endif
+                              const long activ_offset,
+                              const char use_hx,
+                              const char is_seq_begin,
+                              const int direction,
+                              const int cur_batch,
+                              const int use_batch)
+{
+    int total_item          = cur_batch * hy_h / RD_BLCK;
+    total_item              = max(total_item, 1);
+    _FLOAT_PREC activ_param = 1;
+
+    _FLOAT_PREC s_dat[RD_BLCK];
+
+    _FLOAT_PREC z_dat[RD_BLCK];
+    _FLOAT_PREC r_dat[RD_BLCK];
+    _FLOAT_PREC c_dat[RD_BLCK];
+    _FLOAT_PREC h_dat[RD_BLCK];
+
+    _FLOAT_PREC hx_dat[RD_BLCK];
+
+    for(int gid = get_global_id(0); gid < total_item; gid += get_global_size(0))
+    {
+        int b_idx   = gid * RD_BLCK / hy_h;
+        int h_idx   = gid * RD_BLCK - b_idx * hy_h;
+        int rsv_idx = b_idx * hy_stride + h_idx;
+
+        LoadDat(s_dat, reservespace + z_offset + rsv_idx);
+        ActivationFunction_Sigmoid(
+            RD_BLCK, z_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
+
+        LoadDat(s_dat, reservespace + r_offset + rsv_idx);
+        ActivationFunction_Sigmoid(
+            RD_BLCK, r_dat, (const _FLOAT_PREC*)s_dat, activ_param, activ_param, activ_param);
+
+        LoadDat(c_dat, reservespace + c_offset + rsv_idx);
+        LoadDat(h_dat, reservespace + hidden_offset + rsv_idx);
+
+        // The pre-activation of c, and c.
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            h_dat[i] = r_dat[i] * c_dat[i] + h_dat[i];
+        }
+        ActivationFunction_TanH(RD_BLCK, s_dat, h_dat, activ_param, activ_param, activ_param);
+
+        if((bool)is_seq_begin)
+        {
+            if((bool)use_hx)
+            {
+                LoadDat(hx_dat, hx + hx_offset + gid * RD_BLCK);
+            }
+            else
+            {
+                for(int i = 0; i < RD_BLCK; ++i)
+                {
+                    hx_dat[i] = (_FLOAT_PREC)0;
+                }
+            }
+        }
+        else
+        {
+            if(b_idx < use_batch)
+            {
+                LoadDat(hx_dat, reservespace + hidden_offset_pre + rsv_idx);
+            }
+            else
+            {
+                if(direction == 1 && (bool)use_hx)
+                {
+                    LoadDat(hx_dat, hx + hx_offset + gid * RD_BLCK);
+                }
+                else
+                {
+                    for(int i = 0; i < RD_BLCK; ++i)
+                    {
+                        hx_dat[i] = (_FLOAT_PREC)0;
+                    }
+                }
+            }
+        }
+
+#if INFERENCE_MODE
+        StoreDat(reservespace + z_offset + rsv_idx, z_dat);
+        StoreDat(reservespace + r_offset + rsv_idx, r_dat);
+        StoreDat(reservespace + c_offset + rsv_idx, s_dat);
+#else
+        StoreDat(reservespace + z_offset + activ_offset + rsv_idx, z_dat);
+        StoreDat(reservespace + r_offset + activ_offset + rsv_idx, r_dat);
+        StoreDat(reservespace + hidden_offset + activ_offset + rsv_idx, c_dat);
+        StoreDat(reservespace + c_offset + rsv_idx, h_dat);
+        StoreDat(reservespace + c_offset + activ_offset + rsv_idx, s_dat);
+#endif
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            h_dat[i] = s_dat[i] - z_dat[i] * s_dat[i] + z_dat[i] * hx_dat[i];
+        }
 
-        *((global READ_TYPE*)(workspace + dcell_offset + rsv_idx))   = *((READ_TYPE*)dcx_dat);
-        *((global READ_TYPE*)(workspace + dhidden_offset + rsv_idx)) = *((READ_TYPE*)dh_dat);
+        StoreDat(reservespace + hidden_offset + rsv_idx, h_dat);
     }
 }
 #endif
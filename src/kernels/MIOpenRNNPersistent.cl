@@ -0,0 +1,252 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_USE_FP16
+#define MIOPEN_USE_FP16 0
+#endif
+#ifndef MIOPEN_USE_FP32
+#define MIOPEN_USE_FP32 0
+#endif
+#ifndef MIOPEN_USE_BFP16
+#define MIOPEN_USE_BFP16 0
+#endif
+
+#include "float_types.h"
+
+// RNN_MODE follows miopenRNNMode_t: 0 - ReLU, 1 - tanh, 2 - LSTM, 3 - GRU
+#ifndef RNN_MODE
+#define RNN_MODE 1
+#endif
+
+#if RNN_MODE == 2
+#define GATES 4
+#elif RNN_MODE == 3
+#define GATES 3
+#else
+#define GATES 1
+#endif
+
+// Every work-group owns UNITS hidden units of all the gates, and SPLIT work-items share one dot
+// product over the hidden size
+#define TASKS (BATCH * GATES * UNITS)
+#define SLOTS (LOCAL_SIZE / SPLIT)
+// the cells each work-item updates, the same ones at every step
+#define CELLS ((BATCH * UNITS + LOCAL_SIZE - 1) / LOCAL_SIZE)
+
+// With RNN_INT8_WEIGHTS the recurrent weights are int8 with one float scale per row, as
+// quantized by RNNQuantizeWeightsInt8, and every dot product is scaled once it is reduced
+#ifndef RNN_INT8_WEIGHTS
+#define RNN_INT8_WEIGHTS 0
+#endif
+
+#if RNN_INT8_WEIGHTS
+#define _FLOAT_WEI char
+#define CVT_WEI2ACCUM(x) ((float)(x))
+#define ROW_SCALE(gu) scale_lds[gu]
+#else
+#define _FLOAT_WEI _FLOAT
+#define CVT_WEI2ACCUM(x) CVT_FLOAT2ACCUM(x)
+#define ROW_SCALE(gu) 1.0f
+#endif
+
+static inline float Sigmoid(float x) { return 1.0f / (1.0f + exp(-x)); }
+
+// OpenCL has no grid-wide barrier, so this relies on all the work-groups being resident at once,
+// which the host guarantees by launching at most one work-group per compute unit. The hidden
+// state is read back through volatile pointers, so it is not served from a stale cache.
+static void GridSync(volatile global uint* counter, uint target)
+{
+    barrier(CLK_LOCAL_MEM_FENCE | CLK_GLOBAL_MEM_FENCE);
+    if(get_local_id(0) == 0)
+    {
+        atomic_inc(counter);
+        while(atomic_add(counter, 0) < target)
+        {
+        }
+    }
+    barrier(CLK_LOCAL_MEM_FENCE | CLK_GLOBAL_MEM_FENCE);
+}
+
+// All the time steps of one unidirectional layer of inference, with the same batch at every
+// step. The workspace rows already hold the input GEMM and the biases, laid out as for the
+// default algorithm; the recurrent weights stay in LDS between the steps.
+__attribute__((reqd_work_group_size(LOCAL_SIZE, 1, 1))) __kernel void
+RNNFwdPersistent(const global _FLOAT_WEI* w,
+                 const global float* w_scale,
+                 const global _FLOAT* hx,
+                 const global _FLOAT* cx,
+                 global _FLOAT* workspace,
+                 volatile global uint* sync,
+                 const long w_offset,
+                 const long scale_offset,
+                 const long hx_offset,
+                 const long cx_offset,
+                 const long gate_offset,
+                 const long hidden_offset,
+                 const long cell_offset,
+                 const long sync_offset,
+                 const int hy_stride,
+                 const int seq_len,
+                 const char use_hx,
+                 const char use_cx)
+{
+    local _FLOAT_WEI w_lds[GATES * UNITS * HY_H];
+    local float acc_lds[TASKS];
+    local float red_lds[LOCAL_SIZE];
+#if RNN_INT8_WEIGHTS
+    local float scale_lds[GATES * UNITS];
+#else
+    (void)w_scale;
+    (void)scale_offset;
+#endif
+
+    const int lid   = get_local_id(0);
+    const int part  = lid % SPLIT;
+    const int unit0 = get_group_id(0) * UNITS;
+
+    volatile global _FLOAT* hidden = workspace;
+    volatile global uint* counter  = sync + sync_offset;
+
+    for(int i = lid; i < GATES * UNITS * HY_H; i += LOCAL_SIZE)
+    {
+        const int gu = i / HY_H;
+        const int n  = unit0 + gu % UNITS;
+        w_lds[i]     = n < HY_H ? w[w_offset + ((gu / UNITS) * HY_H + n) * HY_H + i % HY_H]
+                                : (_FLOAT_WEI)0;
+    }
+#if RNN_INT8_WEIGHTS
+    for(int gu = lid; gu < GATES * UNITS; gu += LOCAL_SIZE)
+    {
+        const int n   = unit0 + gu % UNITS;
+        scale_lds[gu] = n < HY_H ? w_scale[scale_offset + (gu / UNITS) * HY_H + n] : 0.0f;
+    }
+#endif
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+#if RNN_MODE == 2
+    float c_state[CELLS];
+#else
+    (void)cx;
+    (void)cx_offset;
+    (void)cell_offset;
+    (void)use_cx;
+#endif
+
+    for(int t = 0; t < seq_len; t++)
+    {
+        const long row     = gate_offset + (long)t * BATCH * hy_stride;
+        const long row_pre = row - BATCH * hy_stride;
+
+        // recurrent GEMM against the hidden state of the previous step, none at the first step
+        // without hx
+        const bool has_prev = t > 0 || (bool)use_hx;
+        for(int base = 0; base < TASKS; base += SLOTS)
+        {
+            const int task = base + lid / SPLIT;
+            float sum      = 0;
+            if(has_prev && task < TASKS)
+            {
+                const int b  = task / (GATES * UNITS);
+                const int gu = task % (GATES * UNITS);
+                for(int k = part; k < HY_H; k += SPLIT)
+                {
+                    const float h =
+                        t == 0 ? CVT_FLOAT2ACCUM(hx[hx_offset + b * HY_H + k])
+                               : CVT_FLOAT2ACCUM(hidden[row_pre + b * hy_stride + hidden_offset +
+                                                        k]);
+                    sum += CVT_WEI2ACCUM(w_lds[gu * HY_H + k]) * h;
+                }
+            }
+            red_lds[lid] = sum;
+            barrier(CLK_LOCAL_MEM_FENCE);
+            for(int s = SPLIT / 2; s > 0; s >>= 1)
+            {
+                if(part < s)
+                    red_lds[lid] += red_lds[lid + s];
+                barrier(CLK_LOCAL_MEM_FENCE);
+            }
+            if(part == 0 && task < TASKS)
+                acc_lds[task] = red_lds[lid] * ROW_SCALE(task % (GATES * UNITS));
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        // cell update of the units owned by this work-group
+        for(int e = lid, cell = 0; e < BATCH * UNITS; e += LOCAL_SIZE, cell++)
+        {
+            const int b = e / UNITS;
+            const int u = e % UNITS;
+            const int j = unit0 + u;
+            if(j >= HY_H)
+                continue;
+
+            const long idx          = row + b * hy_stride;
+            const global _FLOAT* in = workspace + idx;
+            const local float* acc  = acc_lds + b * GATES * UNITS + u;
+#if RNN_MODE == 2
+            const float i_dat = Sigmoid(CVT_FLOAT2ACCUM(in[j]) + acc[0]);
+            const float f_dat = Sigmoid(CVT_FLOAT2ACCUM(in[HY_H + j]) + acc[UNITS]);
+            const float o_dat = Sigmoid(CVT_FLOAT2ACCUM(in[2 * HY_H + j]) + acc[2 * UNITS]);
+            const float c_dat = tanh(CVT_FLOAT2ACCUM(in[3 * HY_H + j]) + acc[3 * UNITS]);
+
+            // the cell state carried between the steps stays in float
+            float c_pre = 0;
+            if(t > 0)
+                c_pre = c_state[cell];
+            else if((bool)use_cx)
+                c_pre = CVT_FLOAT2ACCUM(cx[cx_offset + b * HY_H + j]);
+
+            const float s_dat                  = i_dat * c_dat + f_dat * c_pre;
+            c_state[cell]                      = s_dat;
+            workspace[idx + cell_offset + j]   = CVT_ACCUM2FLOAT(s_dat);
+            workspace[idx + hidden_offset + j] = CVT_ACCUM2FLOAT(o_dat * tanh(s_dat));
+#elif RNN_MODE == 3
+            const float z_dat = Sigmoid(CVT_FLOAT2ACCUM(in[j]) + acc[0]);
+            const float r_dat = Sigmoid(CVT_FLOAT2ACCUM(in[HY_H + j]) + acc[UNITS]);
+            const float c_dat = tanh(CVT_FLOAT2ACCUM(in[hidden_offset + j]) +
+                                     r_dat * (CVT_FLOAT2ACCUM(in[2 * HY_H + j]) + acc[2 * UNITS]));
+
+            float h_pre = 0;
+            if(t > 0)
+                h_pre = CVT_FLOAT2ACCUM(workspace[row_pre + b * hy_stride + hidden_offset + j]);
+            else if((bool)use_hx)
+                h_pre = CVT_FLOAT2ACCUM(hx[hx_offset + b * HY_H + j]);
+
+            workspace[idx + hidden_offset + j] =
+                CVT_ACCUM2FLOAT((1 - z_dat) * c_dat + z_dat * h_pre);
+#else
+            const float v_dat = CVT_FLOAT2ACCUM(in[j]) + acc[0];
+#if RNN_MODE == 0
+            workspace[idx + j] = CVT_ACCUM2FLOAT(v_dat > 0 ? v_dat : 0);
+#else
+            workspace[idx + j] = CVT_ACCUM2FLOAT(tanh(v_dat));
+#endif
+#endif
+        }
+
+        if(t + 1 < seq_len)
+            GridSync(counter, (t + 1) * get_num_groups(0));
+    }
+}
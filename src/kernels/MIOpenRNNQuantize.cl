@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_USE_FP16
+#define MIOPEN_USE_FP16 0
+#endif
+#ifndef MIOPEN_USE_FP32
+#define MIOPEN_USE_FP32 0
+#endif
+#ifndef MIOPEN_USE_BFP16
+#define MIOPEN_USE_BFP16 0
+#endif
+
+#include "float_types.h"
+
+// Quantizes every row of ROW_LEN weights of a matrix to int8, symmetric around zero with one
+// float scale per row, so that a row dequantizes as scale * q. One work-group per row.
+__attribute__((reqd_work_group_size(LOCAL_SIZE, 1, 1))) __kernel void
+RNNQuantizeWeightsInt8(const global _FLOAT* w,
+                       global char* wq,
+                       global float* scale,
+                       const long w_offset,
+                       const long wq_offset,
+                       const long scale_offset)
+{
+    local float max_lds[LOCAL_SIZE];
+
+    const int lid  = get_local_id(0);
+    const long row = get_group_id(0);
+
+    const global _FLOAT* src = w + w_offset + row * ROW_LEN;
+
+    float amax = 0;
+    for(int k = lid; k < ROW_LEN; k += LOCAL_SIZE)
+        amax = fmax(amax, fabs(CVT_FLOAT2ACCUM(src[k])));
+    max_lds[lid] = amax;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(int s = LOCAL_SIZE / 2; s > 0; s >>= 1)
+    {
+        if(lid < s)
+            max_lds[lid] = fmax(max_lds[lid], max_lds[lid + s]);
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    // a row of zeros keeps a zero scale and quantizes to zeros
+    const float row_scale = max_lds[0] / 127.0f;
+    const float inv_scale = row_scale > 0 ? 1.0f / row_scale : 0.0f;
+    if(lid == 0)
+        scale[scale_offset + row] = row_scale;
+
+    global char* dst = wq + wq_offset + row * ROW_LEN;
+    for(int k = lid; k < ROW_LEN; k += LOCAL_SIZE)
+        dst[k] = (char)clamp(rint(CVT_FLOAT2ACCUM(src[k]) * inv_scale), -127.0f, 127.0f);
+}
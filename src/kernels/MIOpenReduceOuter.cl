@@ -0,0 +1,509 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Reduction over the outer dimensions of a packed tensor, e.g. the per-channel statistics of an
+// NHWC tensor. The host folds the tensor to `rows` rows of `cols` contiguous elements and
+// reduces the rows, so every row is read with coalesced vector loads by the MIO_RED_GRP0
+// work-items along dimension 0 while the MIO_RED_GRP1 work-items along dimension 1 stride over
+// the rows. The rows are split into segments of `segrows` rows (the last one takes the
+// remainder), one per work-group along dimension 1:
+//   MIO_RED_MODE 0: a single segment, the work-group writes the result
+//   MIO_RED_MODE 1: every segment writes its partial result to ws[seg][col] and
+//                   MIOpenReduceOuterFinal reduces them
+//   MIO_RED_MODE 2: every segment merges its partial result into ws[col] atomically, which
+//                   MIOpenReduceOuterInit has set to the identity of the operation, and
+//                   MIOpenReduceOuterFinal only applies the epilogue
+//
+// MIO_RED_OP is the miopenReduceTensorOp_t. The shape is only known at run time, so that a build
+// serves every reduction of the same type, operation and vector width (and can be shipped in the
+// kernel database). The reduction is done in float, bfloat16 is stored as ushort.
+
+#if MIO_RED_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#endif
+
+#if MIO_RED_BF16 == 1
+#include "bfloat16_dev.hpp"
+#define RED_LOAD(v) bfloat16_to_float(v)
+#define RED_STORE(v) float_to_bfloat16(v)
+#else
+#define RED_LOAD(v) ((float)(v))
+#define RED_STORE(v) ((MIO_RED_T)(v))
+#endif
+
+#ifndef MIO_RED_VEC
+#define MIO_RED_VEC 1
+#endif
+
+#ifndef MIO_RED_NAN
+#define MIO_RED_NAN 0
+#endif
+
+#define RED_PPCAT_NX(A, B) A##B
+#define RED_PPCAT(A, B) RED_PPCAT_NX(A, B)
+
+#define RED_ADD 0
+#define RED_MUL 1
+#define RED_MIN 2
+#define RED_MAX 3
+#define RED_AMAX 4
+#define RED_AVG 5
+#define RED_NORM1 6
+#define RED_NORM2 7
+
+static inline float red_identity()
+{
+#if MIO_RED_OP == RED_MUL
+    return 1.0f;
+#elif MIO_RED_OP == RED_MIN
+    return INFINITY;
+#elif MIO_RED_OP == RED_MAX
+    return -INFINITY;
+#else
+    return 0.0f;
+#endif
+}
+
+static inline float red_pre(float v)
+{
+#if MIO_RED_OP == RED_AMAX || MIO_RED_OP == RED_NORM1
+    return fabs(v);
+#elif MIO_RED_OP == RED_NORM2
+    return v * v;
+#else
+    return v;
+#endif
+}
+
+static inline float red_combine(float acc, float v)
+{
+#if MIO_RED_NAN == 1 && (MIO_RED_OP == RED_MIN || MIO_RED_OP == RED_MAX || MIO_RED_OP == RED_AMAX)
+    // fmin and fmax drop a NaN operand.
+    if(isnan(acc) || isnan(v))
+        return NAN;
+#endif
+#if MIO_RED_OP == RED_MUL
+    return acc * v;
+#elif MIO_RED_OP == RED_MIN
+    return fmin(acc, v);
+#elif MIO_RED_OP == RED_MAX || MIO_RED_OP == RED_AMAX
+    return fmax(acc, v);
+#else
+    return acc + v;
+#endif
+}
+
+static inline float red_post(float v, ulong rows)
+{
+    (void)rows;
+#if MIO_RED_OP == RED_AVG
+    return v / (float)rows;
+#elif MIO_RED_OP == RED_NORM2
+    return sqrt(v);
+#else
+    return v;
+#endif
+}
+
+static inline void red_load(const global MIO_RED_T* p, float* v)
+{
+#if MIO_RED_VEC > 1
+    const RED_PPCAT(MIO_RED_T, MIO_RED_VEC) t = RED_PPCAT(vload, MIO_RED_VEC)(0, p);
+    const MIO_RED_T* s                         = (const MIO_RED_T*)&t;
+    for(int k = 0; k < MIO_RED_VEC; ++k)
+        v[k] = RED_LOAD(s[k]);
+#else
+    v[0] = RED_LOAD(*p);
+#endif
+}
+
+// c = alpha * v + beta * c, c is not read when beta is zero
+static inline void
+red_store(global MIO_RED_T* p, const float* v, float alpha, float beta, int n, ulong rows)
+{
+    for(int k = 0; k < n; ++k)
+    {
+        const float old = (beta != 0.0f) ? beta * RED_LOAD(p[k]) : 0.0f;
+        p[k]            = RED_STORE(alpha * red_post(v[k], rows) + old);
+    }
+}
+
+static inline void red_atomic_combine(volatile global float* p, float v)
+{
+    union
+    {
+        uint u;
+        float f;
+    } current, expected, next;
+
+    current.f = *p;
+    do
+    {
+        expected.f = current.f;
+        next.f     = red_combine(current.f, v);
+        current.u  = atomic_cmpxchg((volatile global uint*)p, expected.u, next.u);
+    } while(current.u != expected.u);
+}
+
+// global size: (ceil(cols / MIO_RED_VEC / MIO_RED_GRP0) * MIO_RED_GRP0, segments * MIO_RED_GRP1),
+// cols is a multiple of MIO_RED_VEC
+__attribute__((reqd_work_group_size(MIO_RED_GRP0, MIO_RED_GRP1, 1))) __kernel void
+MIOpenReduceOuter(const global MIO_RED_T* a,
+                  global MIO_RED_T* c,
+                  global float* ws,
+                  float alpha,
+                  float beta,
+                  ulong rows,
+                  uint cols,
+                  ulong segrows)
+{
+    local float lcl[MIO_RED_GRP1][MIO_RED_GRP0 * MIO_RED_VEC];
+
+    const uint lid0   = get_local_id(0);
+    const uint lid1   = get_local_id(1);
+    const uint seg    = get_group_id(1);
+    const uint nseg   = get_num_groups(1);
+    const uint col    = get_global_id(0) * MIO_RED_VEC;
+    const bool active = col < cols;
+
+    float acc[MIO_RED_VEC];
+    for(int k = 0; k < MIO_RED_VEC; ++k)
+        acc[k] = red_identity();
+
+    if(active)
+    {
+        const ulong row_end = (seg == nseg - 1) ? rows : (seg + 1) * segrows;
+        for(ulong row = seg * segrows + lid1; row < row_end; row += MIO_RED_GRP1)
+        {
+            float v[MIO_RED_VEC];
+            red_load(a + row * cols + col, v);
+            for(int k = 0; k < MIO_RED_VEC; ++k)
+                acc[k] = red_combine(acc[k], red_pre(v[k]));
+        }
+    }
+
+    for(int k = 0; k < MIO_RED_VEC; ++k)
+        lcl[lid1][lid0 * MIO_RED_VEC + k] = acc[k];
+    barrier(CLK_LOCAL_MEM_FENCE);
+
+    for(uint s = MIO_RED_GRP1 / 2; s > 0; s >>= 1)
+    {
+        if(lid1 < s)
+        {
+            for(int k = 0; k < MIO_RED_VEC; ++k)
+                lcl[lid1][lid0 * MIO_RED_VEC + k] =
+                    red_combine(lcl[lid1][lid0 * MIO_RED_VEC + k],
+                                lcl[lid1 + s][lid0 * MIO_RED_VEC + k]);
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+    if(lid1 != 0 || !active)
+        return;
+
+    const local float* res = &lcl[0][lid0 * MIO_RED_VEC];
+#if MIO_RED_MODE == 0
+    (void)ws;
+    float v[MIO_RED_VEC];
+    for(int k = 0; k < MIO_RED_VEC; ++k)
+        v[k] = res[k];
+    red_store(c + col, v, alpha, beta, MIO_RED_VEC, rows);
+#elif MIO_RED_MODE == 1
+    (void)c;
+    (void)alpha;
+    (void)beta;
+    for(int k = 0; k < MIO_RED_VEC; ++k)
+        ws[(ulong)seg * cols + col + k] = res[k];
+#else
+    (void)c;
+    (void)alpha;
+    (void)beta;
+    for(int k = 0; k < MIO_RED_VEC; ++k)
+        red_atomic_combine(ws + col + k, res[k]);
+#endif
+}
+
+// global size: >= cols
+__kernel void MIOpenReduceOuterInit(global float* ws, uint cols)
+{
+    const uint col = get_global_id(0);
+    if(col < cols)
+        ws[col] = red_identity();
+}
+
+// global size: >= cols
+__kernel void MIOpenReduceOuterFinal(global MIO_RED_T* c,
+                                     const global float* ws,
+                                     float alpha,
+                                     float beta,
+                                     ulong rows,
+                                     uint cols,
+                                     uint nseg)
+{
+    const uint col = get_global_id(0);
+    if(col >= cols)
+        return;
+
+    float v = ws[col];
+#if MIO_RED_MODE == 1
+    for(uint seg = 1; seg < nseg; ++seg)
+        v = red_combine(v, ws[(ulong)seg * cols + col]);
+#else
+    (void)nseg;
+#endif
+    red_store(c + col, &v, alpha, beta, 1, rows);
+}
+
+#ifndef MIO_RED_INDICES
+#define MIO_RED_INDICES 0
+#endif
+
+#define RED_NO_INDEX 0x7fffffff
+
+// Whether (v, i) replaces (acc, idx) in the index-returning MIN, MAX and AMAX: the earliest row
+// wins a tie, and with MIO_RED_NAN the earliest NaN wins.
+static inline bool red_prefer(float v, int i, float acc, int idx)
+{
+#if MIO_RED_NAN == 1
+    if(isnan(acc) || isnan(v))
+        return isnan(v) && (!isnan(acc) || i < idx);
+#endif
+#if MIO_RED_OP == RED_MIN
+    return v < acc || (v == acc && i < idx);
+#else
+    return v > acc || (v == acc && i < idx);
+#endif
+}
+
+static inline void red_combine_index(float* acc, int* idx, float v, int i)
+{
+#if MIO_RED_INDICES == 1
+    if(red_prefer(v, i, *acc, *idx))
+    {
+        *acc = v;
+        *idx = i;
+    }
+#else
+    (void)idx;
+    (void)i;
+    *acc = red_combine(*acc, v);
+#endif
+}
+
+// Segmented reduction: segment s reduces the rows [offsets[s], offsets[s + 1]) to row s of c.
+// The rows are split evenly into chunks of `chunkrows` rows, one per work-group along
+// dimension 1, so long and short segments are balanced across the work-groups. A chunk reduces
+// every segment it intersects: a segment inside the chunk is written to c right away, the
+// partial result of a segment crossing the start of the chunk goes to ws[chunk][0] and the one
+// of a segment crossing its end to ws[chunk][1], and MIOpenReduceOuterSegmentedFinal combines
+// them. The indices of MIO_RED_INDICES are the offsets of the rows in their segment, their
+// partial results follow the values in the workspace as rows of the input.
+//
+// global size: (ceil(cols / MIO_RED_VEC / MIO_RED_GRP0) * MIO_RED_GRP0, chunks * MIO_RED_GRP1),
+// cols is a multiple of MIO_RED_VEC
+__attribute__((reqd_work_group_size(MIO_RED_GRP0, MIO_RED_GRP1, 1))) __kernel void
+MIOpenReduceOuterSegmented(const global MIO_RED_T* a,
+                           global MIO_RED_T* c,
+                           global int* indices,
+                           global float* ws,
+                           const global int* offsets,
+                           float alpha,
+                           float beta,
+                           ulong rows,
+                           uint cols,
+                           uint nsegs,
+                           ulong chunkrows)
+{
+    local float lcl[MIO_RED_GRP1][MIO_RED_GRP0 * MIO_RED_VEC];
+#if MIO_RED_INDICES == 1
+    local int lcl_idx[MIO_RED_GRP1][MIO_RED_GRP0 * MIO_RED_VEC];
+    global int* ws_idx = (global int*)(ws + (ulong)get_num_groups(1) * 2 * cols);
+#else
+    (void)indices;
+#endif
+
+    const uint lid0   = get_local_id(0);
+    const uint lid1   = get_local_id(1);
+    const uint chunk  = get_group_id(1);
+    const uint col    = get_global_id(0) * MIO_RED_VEC;
+    const bool active = col < cols;
+
+    const ulong r0 = chunk * chunkrows;
+    const ulong r1 = min(rows, r0 + chunkrows);
+
+    // The last segment that starts at or before r0.
+    uint lo = 0;
+    uint hi = nsegs;
+    while(hi - lo > 1)
+    {
+        const uint mid = (lo + hi) / 2;
+        if(offsets[mid] <= r0)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    for(uint s = lo; s < nsegs; ++s)
+    {
+        const ulong beg = offsets[s];
+        const ulong end = offsets[s + 1];
+        if(beg >= r1)
+            break;
+
+        const ulong row_beg = max(beg, r0);
+        const ulong row_end = min(end, r1);
+        if(row_beg >= row_end)
+            continue;
+
+        float acc[MIO_RED_VEC];
+        int idx[MIO_RED_VEC];
+        for(int k = 0; k < MIO_RED_VEC; ++k)
+        {
+            acc[k] = red_identity();
+            idx[k] = RED_NO_INDEX;
+        }
+
+        if(active)
+        {
+            for(ulong row = row_beg + lid1; row < row_end; row += MIO_RED_GRP1)
+            {
+                float v[MIO_RED_VEC];
+                red_load(a + row * cols + col, v);
+                for(int k = 0; k < MIO_RED_VEC; ++k)
+                    red_combine_index(&acc[k], &idx[k], red_pre(v[k]), (int)row);
+            }
+        }
+
+        for(int k = 0; k < MIO_RED_VEC; ++k)
+        {
+            lcl[lid1][lid0 * MIO_RED_VEC + k] = acc[k];
+#if MIO_RED_INDICES == 1
+            lcl_idx[lid1][lid0 * MIO_RED_VEC + k] = idx[k];
+#endif
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for(uint t = MIO_RED_GRP1 / 2; t > 0; t >>= 1)
+        {
+            if(lid1 < t)
+            {
+                for(int k = 0; k < MIO_RED_VEC; ++k)
+                {
+                    const int e = lid0 * MIO_RED_VEC + k;
+#if MIO_RED_INDICES == 1
+                    red_combine_index(&acc[k], &idx[k], lcl[lid1 + t][e], lcl_idx[lid1 + t][e]);
+                    lcl_idx[lid1][e] = idx[k];
+#else
+                    red_combine_index(&acc[k], &idx[k], lcl[lid1 + t][e], 0);
+#endif
+                    lcl[lid1][e] = acc[k];
+                }
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if(lid1 == 0 && active)
+        {
+            if(beg >= r0 && end <= r1)
+            {
+                red_store(c + (ulong)s * cols + col, acc, alpha, beta, MIO_RED_VEC, end - beg);
+#if MIO_RED_INDICES == 1
+                for(int k = 0; k < MIO_RED_VEC; ++k)
+                    indices[(ulong)s * cols + col + k] = idx[k] - (int)beg;
+#endif
+            }
+            else
+            {
+                const ulong slot = ((ulong)chunk * 2 + (beg < r0 ? 0 : 1)) * cols + col;
+                for(int k = 0; k < MIO_RED_VEC; ++k)
+                {
+                    ws[slot + k] = acc[k];
+#if MIO_RED_INDICES == 1
+                    ws_idx[slot + k] = idx[k];
+#endif
+                }
+            }
+        }
+        // lcl is reused by the next segment.
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+}
+
+// Completes the segments that cross a chunk boundary and the empty ones.
+// global size: (>= cols, nsegs)
+__kernel void MIOpenReduceOuterSegmentedFinal(global MIO_RED_T* c,
+                                              global int* indices,
+                                              const global float* ws,
+                                              const global int* offsets,
+                                              float alpha,
+                                              float beta,
+                                              uint cols,
+                                              uint nchunks,
+                                              ulong chunkrows)
+{
+    const uint col = get_global_id(0);
+    const uint s   = get_global_id(1);
+    if(col >= cols)
+        return;
+
+    const ulong beg = offsets[s];
+    const ulong end = offsets[s + 1];
+
+    float v = red_identity();
+    int i   = (int)beg;
+#if MIO_RED_INDICES == 1
+    const global int* ws_idx = (const global int*)(ws + (ulong)nchunks * 2 * cols);
+#else
+    (void)indices;
+    (void)nchunks;
+#endif
+    if(end > beg)
+    {
+        const ulong first = beg / chunkrows;
+        const ulong last  = (end - 1) / chunkrows;
+        if(first == last)
+            return;
+
+        v = ws[(first * 2 + 1) * cols + col];
+#if MIO_RED_INDICES == 1
+        i = ws_idx[(first * 2 + 1) * cols + col];
+#endif
+        for(ulong chunk = first + 1; chunk <= last; ++chunk)
+        {
+#if MIO_RED_INDICES == 1
+            red_combine_index(&v, &i, ws[chunk * 2 * cols + col], ws_idx[chunk * 2 * cols + col]);
+#else
+            red_combine_index(&v, &i, ws[chunk * 2 * cols + col], 0);
+#endif
+        }
+    }
+
+    // An empty segment stores the identity, or zero for an average.
+    red_store(c + (ulong)s * cols + col, &v, alpha, beta, 1, max(end - beg, (ulong)1));
+#if MIO_RED_INDICES == 1
+    indices[(ulong)s * cols + col] = i - (int)beg;
+#endif
+}
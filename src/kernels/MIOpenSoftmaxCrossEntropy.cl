@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Softmax cross-entropy over rows of MIO_SFM_LEN logits with one integer label per row, one
+// work-group per row. The forward kernel writes loss = log(sum(exp(x))) - x[label] and, with
+// MIO_SCE_GRAD, the gradient softmax(x) - onehot(label); the backward kernel writes the gradient
+// scaled by the incoming loss gradient of the row. Rows whose label is outside [0, MIO_SFM_LEN)
+// get a zero loss and gradient. The gradient may overwrite the logits.
+
+#include "softmax_online.h"
+
+#ifndef MIO_SCE_GRAD
+#define MIO_SCE_GRAD 0
+#endif
+
+#define MIO_SFM_ROW_VECS (MIO_SFM_LEN / MIO_SFM_VEC)
+
+/// Writes the gradient of vector i of the row from its logits v.
+static inline void
+sce_write(global _FLOAT* dxr, uint i, float* v, float m, float rs, int label, float scale)
+{
+    for(uint k = 0; k < MIO_SFM_VEC; k++)
+    {
+        const float hit = (i * MIO_SFM_VEC + k == (uint)label) ? 1.0f : 0.0f;
+        v[k]            = (exp(v[k] - m) * rs - hit) * scale;
+    }
+    sfm_store(dxr + i * MIO_SFM_VEC, v);
+}
+
+static inline void sce_grad(const global _FLOAT* xr,
+                            global _FLOAT* dxr,
+                            float m,
+                            float s,
+                            int label,
+                            float scale,
+                            UNUSED float (*cache)[MIO_SFM_VEC])
+{
+    const float rs = 1.0f / s;
+#if MIO_SFM_CACHE > 0
+    (void)xr;
+    for(uint j = 0; j < MIO_SFM_CACHE; j++)
+    {
+        const uint i = get_local_id(0) + j * MIO_SFM_GRP;
+        if(i < MIO_SFM_ROW_VECS)
+            sce_write(dxr, i, cache[j], m, rs, label, scale);
+    }
+#else
+    for(uint i = get_local_id(0); i < MIO_SFM_ROW_VECS; i += MIO_SFM_GRP)
+    {
+        float v[MIO_SFM_VEC];
+        sfm_load(xr + i * MIO_SFM_VEC, v);
+        sce_write(dxr, i, v, m, rs, label, scale);
+    }
+#endif
+}
+
+__attribute__((reqd_work_group_size(MIO_SFM_GRP, 1, 1))) __kernel void
+SoftmaxCrossEntropyForward(const global _FLOAT* x,
+                           const global int* labels,
+                           global float* losses,
+#if !MIO_SCE_GRAD
+                           UNUSED
+#endif
+                               global _FLOAT* dx,
+                           const uint x_rstr,
+#if !MIO_SCE_GRAD
+                           UNUSED
+#endif
+                               const uint dx_rstr)
+{
+    local float lm[MIO_SFM_GRP];
+    local float ls[MIO_SFM_GRP];
+
+    const uint row          = get_group_id(0);
+    const global _FLOAT* xr = x + row * x_rstr;
+    const int label         = labels[row];
+    const bool valid        = label >= 0 && label < MIO_SFM_LEN;
+
+    // Picked before the barriers of the reduction, the gradient may overwrite it afterwards.
+    const float picked = (valid && get_local_id(0) == 0) ? CVT_FLOAT2ACCUM(xr[label]) : 0.0f;
+
+    MIO_SFM_CACHE_DECL;
+    float m, s;
+    sfm_stats(xr, MIO_SFM_ROW_VECS, &m, &s, cache);
+    sfm_reduce(&m, &s, lm, ls);
+
+    if(get_local_id(0) == 0)
+        losses[row] = valid ? m + log(s) - picked : 0.0f;
+
+#if MIO_SCE_GRAD
+    sce_grad(xr, dx + row * dx_rstr, m, s, label, valid ? 1.0f : 0.0f, cache);
+#endif
+}
+
+__attribute__((reqd_work_group_size(MIO_SFM_GRP, 1, 1))) __kernel void
+SoftmaxCrossEntropyBackward(const global _FLOAT* x,
+                            const global int* labels,
+                            const global float* dlosses,
+                            global _FLOAT* dx,
+                            const uint x_rstr,
+                            const uint dx_rstr)
+{
+    local float lm[MIO_SFM_GRP];
+    local float ls[MIO_SFM_GRP];
+
+    const uint row          = get_group_id(0);
+    const global _FLOAT* xr = x + row * x_rstr;
+    const int label         = labels[row];
+    const bool valid        = label >= 0 && label < MIO_SFM_LEN;
+
+    MIO_SFM_CACHE_DECL;
+    float m, s;
+    sfm_stats(xr, MIO_SFM_ROW_VECS, &m, &s, cache);
+    sfm_reduce(&m, &s, lm, ls);
+
+    sce_grad(xr, dx + row * dx_rstr, m, s, label, valid ? dlosses[row] : 0.0f, cache);
+}
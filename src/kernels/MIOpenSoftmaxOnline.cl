@@ -0,0 +1,216 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Online softmax over contiguous rows of MIO_SFM_LEN elements, the statistics of a row take one
+// read (see softmax_online.h). When a work-item's share of the row fits MIO_SFM_CACHE vectors it
+// stays in registers and the row is read once and written once; otherwise it is read again.
+//
+// MIO_SFM_NBLK > 1 splits a row over several work-groups for problems with too few rows to fill
+// the device. SoftmaxOnlinePartial then writes the statistics of each chunk of MIO_SFM_CHUNK
+// elements to the workspace and SoftmaxOnlineNorm merges them before writing its chunk.
+
+#include "softmax_online.h"
+
+#ifndef MIO_SFM_NBLK
+#define MIO_SFM_NBLK 1
+#endif
+
+#ifndef MIO_SFM_CHUNK
+#define MIO_SFM_CHUNK MIO_SFM_LEN
+#endif
+
+#ifndef USE_ALPHA
+#define USE_ALPHA 0
+#endif
+
+#ifndef USE_BETA
+#define USE_BETA 0
+#endif
+
+#define MIO_SFM_CHUNK_VECS (MIO_SFM_CHUNK / MIO_SFM_VEC)
+
+static inline void
+sfm_output(float* v, const global _FLOAT* yr, float m, float rs, float alpha, float beta)
+{
+    for(uint k = 0; k < MIO_SFM_VEC; k++)
+        v[k] = exp(v[k] - m) * rs;
+#if USE_ALPHA
+    for(uint k = 0; k < MIO_SFM_VEC; k++)
+        v[k] *= alpha;
+#else
+    (void)alpha;
+#endif
+#if USE_BETA
+    float old[MIO_SFM_VEC];
+    sfm_load(yr, old);
+    for(uint k = 0; k < MIO_SFM_VEC; k++)
+        v[k] += old[k] * beta;
+#else
+    (void)yr;
+    (void)beta;
+#endif
+}
+
+static inline void sfm_normalize(const global _FLOAT* xr,
+                                 global _FLOAT* yr,
+                                 uint nvecs,
+                                 float m,
+                                 float s,
+                                 float alpha,
+                                 float beta,
+                                 UNUSED float (*cache)[MIO_SFM_VEC])
+{
+    const float rs = 1.0f / s;
+#if MIO_SFM_CACHE > 0
+    (void)xr;
+    for(uint j = 0; j < MIO_SFM_CACHE; j++)
+    {
+        const uint i = get_local_id(0) + j * MIO_SFM_GRP;
+        if(i < nvecs)
+        {
+            sfm_output(cache[j], yr + i * MIO_SFM_VEC, m, rs, alpha, beta);
+            sfm_store(yr + i * MIO_SFM_VEC, cache[j]);
+        }
+    }
+#else
+    for(uint i = get_local_id(0); i < nvecs; i += MIO_SFM_GRP)
+    {
+        float v[MIO_SFM_VEC];
+        sfm_load(xr + i * MIO_SFM_VEC, v);
+        sfm_output(v, yr + i * MIO_SFM_VEC, m, rs, alpha, beta);
+        sfm_store(yr + i * MIO_SFM_VEC, v);
+    }
+#endif
+}
+
+
+/// One work-group per row.
+__attribute__((reqd_work_group_size(MIO_SFM_GRP, 1, 1))) __kernel void
+SoftmaxOnlineForward(const global _FLOAT* x,
+                     global _FLOAT* y,
+                     const uint row_hw,
+                     const uint row_w,
+                     const uint in_nstr,
+                     const uint in_hstr,
+                     const uint in_wstr,
+                     const uint out_nstr,
+                     const uint out_hstr,
+                     const uint out_wstr,
+                     const int x_offset,
+                     const int y_offset,
+                     const float alpha,
+                     const float beta)
+{
+    local float lm[MIO_SFM_GRP];
+    local float ls[MIO_SFM_GRP];
+
+    const uint row = get_group_id(0);
+    const global _FLOAT* xr =
+        x + x_offset + sfm_row_offset(row, row_hw, row_w, in_nstr, in_hstr, in_wstr);
+    global _FLOAT* yr =
+        y + y_offset + sfm_row_offset(row, row_hw, row_w, out_nstr, out_hstr, out_wstr);
+
+    MIO_SFM_CACHE_DECL;
+    float m, s;
+    sfm_stats(xr, MIO_SFM_CHUNK_VECS, &m, &s, cache);
+    sfm_reduce(&m, &s, lm, ls);
+    sfm_normalize(xr, yr, MIO_SFM_CHUNK_VECS, m, s, alpha, beta, cache);
+}
+
+/// Work-group (chunk, row) writes the statistics of its chunk to ws[2 * (row * NBLK + chunk)].
+__attribute__((reqd_work_group_size(MIO_SFM_GRP, 1, 1))) __kernel void
+SoftmaxOnlinePartial(const global _FLOAT* x,
+                     global float* ws,
+                     const uint row_hw,
+                     const uint row_w,
+                     const uint in_nstr,
+                     const uint in_hstr,
+                     const uint in_wstr,
+                     const int x_offset)
+{
+    local float lm[MIO_SFM_GRP];
+    local float ls[MIO_SFM_GRP];
+
+    const uint chunk = get_group_id(0);
+    const uint row   = get_group_id(1);
+    const uint first = chunk * MIO_SFM_CHUNK;
+    const uint nvecs = (min((uint)MIO_SFM_LEN, first + MIO_SFM_CHUNK) - first) / MIO_SFM_VEC;
+    const global _FLOAT* xr =
+        x + x_offset + sfm_row_offset(row, row_hw, row_w, in_nstr, in_hstr, in_wstr) + first;
+
+    MIO_SFM_CACHE_DECL;
+    float m, s;
+    sfm_stats(xr, nvecs, &m, &s, cache);
+    sfm_reduce(&m, &s, lm, ls);
+    if(get_local_id(0) == 0)
+    {
+        ws[2 * (row * MIO_SFM_NBLK + chunk)]     = m;
+        ws[2 * (row * MIO_SFM_NBLK + chunk) + 1] = s;
+    }
+}
+
+/// Merges the statistics of the row and writes the chunk of work-group (chunk, row).
+__attribute__((reqd_work_group_size(MIO_SFM_GRP, 1, 1))) __kernel void
+SoftmaxOnlineNorm(const global _FLOAT* x,
+                  global _FLOAT* y,
+                  const global float* ws,
+                  const uint row_hw,
+                  const uint row_w,
+                  const uint in_nstr,
+                  const uint in_hstr,
+                  const uint in_wstr,
+                  const uint out_nstr,
+                  const uint out_hstr,
+                  const uint out_wstr,
+                  const int x_offset,
+                  const int y_offset,
+                  const float alpha,
+                  const float beta)
+{
+    const uint chunk = get_group_id(0);
+    const uint row   = get_group_id(1);
+    const uint first = chunk * MIO_SFM_CHUNK;
+    const uint nvecs = (min((uint)MIO_SFM_LEN, first + MIO_SFM_CHUNK) - first) / MIO_SFM_VEC;
+    const global _FLOAT* xr =
+        x + x_offset + sfm_row_offset(row, row_hw, row_w, in_nstr, in_hstr, in_wstr) + first;
+    global _FLOAT* yr =
+        y + y_offset + sfm_row_offset(row, row_hw, row_w, out_nstr, out_hstr, out_wstr) + first;
+
+    float m = -FLT_MAX;
+    float s = 0.0f;
+    for(uint b = 0; b < MIO_SFM_NBLK; b++)
+        sfm_merge(&m, &s, ws[2 * (row * MIO_SFM_NBLK + b)], ws[2 * (row * MIO_SFM_NBLK + b) + 1]);
+
+    // The registers of the partial pass are gone, so the chunk is read again.
+    const float rs = 1.0f / s;
+    for(uint i = get_local_id(0); i < nvecs; i += MIO_SFM_GRP)
+    {
+        float v[MIO_SFM_VEC];
+        sfm_load(xr + i * MIO_SFM_VEC, v);
+        sfm_output(v, yr + i * MIO_SFM_VEC, m, rs, alpha, beta);
+        sfm_store(yr + i * MIO_SFM_VEC, v);
+    }
+}
@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Stride-generic OpTensor: c = act(op(alpha0 * a, alpha1 * b) + beta * c). The host folds the
+// dimensions that are contiguous in all three tensors and passes the lengths and strides as
+// compile-time lists; a zero stride of b broadcasts it along that dimension, whatever the
+// dimension is. Every work-item takes MIO_EW_VEC consecutive elements of the innermost dimension,
+// which the host only vectorizes when both a and c have the unit stride there and b either has
+// it as well or is broadcast (MIO_EW_B_VEC == 0).
+//
+// The arithmetic is done in float, bfloat16 is stored as ushort.
+
+#if MIO_EW_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#endif
+
+#if MIO_EW_BF16 == 1
+#include "bfloat16_dev.hpp"
+#define EW_LOAD(v) bfloat16_to_float(v)
+#define EW_STORE(v) float_to_bfloat16(v)
+#else
+#define EW_LOAD(v) ((float)(v))
+#define EW_STORE(v) ((MIO_EW_T)(v))
+#endif
+
+#ifndef MIO_EW_VEC
+#define MIO_EW_VEC 1
+#endif
+
+#ifndef MIO_EW_B_VEC
+#define MIO_EW_B_VEC 1
+#endif
+
+#ifndef MIO_EW_ACTIV
+#define MIO_EW_ACTIV 0
+#endif
+
+#define EW_PPCAT_NX(A, B) A##B
+#define EW_PPCAT(A, B) EW_PPCAT_NX(A, B)
+
+#if MIO_EW_ACTIV == 1
+#define _FLOAT float
+#define _FLOAT_PREC float
+#ifndef EPSILON
+#define EPSILON 1e-6f
+#endif
+#define UNUSED __attribute__((__unused__))
+#include "activation_functions.h"
+#endif
+
+#define EW_LAST (MIO_EW_RANK - 1)
+
+__constant uint ew_lens[]       = {MIO_EW_LENS};
+__constant ulong ew_a_strides[] = {MIO_EW_A_STRIDES};
+__constant ulong ew_b_strides[] = {MIO_EW_B_STRIDES};
+__constant ulong ew_c_strides[] = {MIO_EW_C_STRIDES};
+
+static inline float ew_op(float a, float b)
+{
+#if MIO_EW_OP == 0
+    return a + b;
+#elif MIO_EW_OP == 1
+    return a * b;
+#elif MIO_EW_OP == 2
+    return fmin(a, b);
+#else
+    return fmax(a, b);
+#endif
+}
+
+static inline void ew_load(const global MIO_EW_T* p, float* v)
+{
+#if MIO_EW_VEC > 1
+    const EW_PPCAT(MIO_EW_T, MIO_EW_VEC) t = EW_PPCAT(vload, MIO_EW_VEC)(0, p);
+    const MIO_EW_T* s                       = (const MIO_EW_T*)&t;
+    for(int k = 0; k < MIO_EW_VEC; ++k)
+        v[k] = EW_LOAD(s[k]);
+#else
+    v[0] = EW_LOAD(*p);
+#endif
+}
+
+static inline void ew_store(global MIO_EW_T* p, const float* v)
+{
+#if MIO_EW_VEC > 1
+    MIO_EW_T s[MIO_EW_VEC];
+    for(int k = 0; k < MIO_EW_VEC; ++k)
+        s[k] = EW_STORE(v[k]);
+    EW_PPCAT(vstore, MIO_EW_VEC)(*((const EW_PPCAT(MIO_EW_T, MIO_EW_VEC)*)s), 0, p);
+#else
+    *p = EW_STORE(v[0]);
+#endif
+}
+
+// global size: any, the work-items stride over the vectors of the tensor
+__kernel void MIOpenTensorOpElementwise(const global MIO_EW_T* a,
+                                        const global MIO_EW_T* b,
+                                        global MIO_EW_T* c,
+                                        float alpha0,
+                                        float alpha1,
+                                        float beta,
+                                        float activ_gamma,
+                                        float activ_beta,
+                                        float activ_alpha,
+                                        ulong a_offset,
+                                        ulong b_offset,
+                                        ulong c_offset,
+                                        ulong total)
+{
+    for(ulong gid = get_global_id(0); gid < total; gid += get_global_size(0))
+    {
+        ulong a_off = a_offset;
+        ulong b_off = b_offset;
+        ulong c_off = c_offset;
+
+        ulong rest = gid;
+        for(int d = EW_LAST; d >= 0; --d)
+        {
+            const uint len = (d == EW_LAST) ? ew_lens[d] / MIO_EW_VEC : ew_lens[d];
+            const uint i   = (d == EW_LAST) ? (rest % len) * MIO_EW_VEC : rest % len;
+            rest /= len;
+            a_off += i * ew_a_strides[d];
+            b_off += i * ew_b_strides[d];
+            c_off += i * ew_c_strides[d];
+        }
+
+        float va[MIO_EW_VEC];
+        float vb[MIO_EW_VEC];
+        float vc[MIO_EW_VEC];
+
+        ew_load(a + a_off, va);
+#if MIO_EW_B_VEC == 1
+        ew_load(b + b_off, vb);
+#else
+        const float bs = EW_LOAD(b[b_off]);
+        for(int k = 0; k < MIO_EW_VEC; ++k)
+            vb[k] = bs;
+#endif
+        // A zero beta does not read c, so c may be uninitialized.
+        if(beta != 0.f)
+            ew_load(c + c_off, vc);
+
+        for(int k = 0; k < MIO_EW_VEC; ++k)
+        {
+            const float r = ew_op(alpha0 * va[k], alpha1 * vb[k]);
+            vc[k]         = (beta != 0.f) ? mad(beta, vc[k], r) : r;
+        }
+
+#if MIO_EW_ACTIV == 1
+        float vr[MIO_EW_VEC];
+        ActivationFunction(MIO_EW_VEC, vr, vc, activ_gamma, activ_beta, activ_alpha);
+        ew_store(c + c_off, vr);
+#else
+        (void)activ_gamma;
+        (void)activ_beta;
+        (void)activ_alpha;
+        ew_store(c + c_off, vc);
+#endif
+    }
+}
@@ -42,6 +42,22 @@
 #endif
 #endif
 
+#ifndef MIOPEN_USE_BFP16
+#define MIOPEN_USE_BFP16 0
+#endif
+
+// bfloat16 is kept in ushort and converted to float for the arithmetic
+#if MIOPEN_USE_BFP16 == 1
+#include "bfloat16_dev.hpp"
+#define MIOPEN_ACCUM_TYPE float
+#define CVT_FLOAT2ACCUM(x) bfloat16_to_float(x)
+#define CVT_ACCUM2FLOAT(x) float_to_bfloat16(x)
+#else
+#define MIOPEN_ACCUM_TYPE MIOPEN_TYPE
+#define CVT_FLOAT2ACCUM(x) ((MIOPEN_ACCUM_TYPE)(x))
+#define CVT_ACCUM2FLOAT(x) ((MIOPEN_TYPE)(x))
+#endif
+
 /* Only works for NCHW
  * bitmap tracks which dims are the same between 'a' and 'c'.
  * Example: 0, 1, 1, 0 means that C and H dims are the same and the rest are ones
@@ -58,13 +74,36 @@
 
 #define UNUSED __attribute__((__unused__))
 
-MIOPEN_TYPE miopenAdd(MIOPEN_TYPE a, MIOPEN_TYPE b) { return a + b; }
+MIOPEN_ACCUM_TYPE miopenAdd(MIOPEN_ACCUM_TYPE a, MIOPEN_ACCUM_TYPE b) { return a + b; }
 
-MIOPEN_TYPE miopenMul(MIOPEN_TYPE a, MIOPEN_TYPE b) { return a * b; }
+MIOPEN_ACCUM_TYPE miopenMul(MIOPEN_ACCUM_TYPE a, MIOPEN_ACCUM_TYPE b) { return a * b; }
+
+MIOPEN_ACCUM_TYPE miopenMax(MIOPEN_ACCUM_TYPE a, MIOPEN_ACCUM_TYPE b)
+{
+    return ((a > b) ? a : b);
+}
+
+MIOPEN_ACCUM_TYPE miopenMin(MIOPEN_ACCUM_TYPE a, MIOPEN_ACCUM_TYPE b)
+{
+    return ((a < b) ? a : b);
+}
 
-MIOPEN_TYPE miopenMax(MIOPEN_TYPE a, MIOPEN_TYPE b) { return ((a > b) ? a : b); }
+// alpha * x in the type of the arithmetic
+MIOPEN_ACCUM_TYPE miopenScale(MIOPEN_TYPE x, MIOPEN_TYPE alpha)
+{
+    return CVT_FLOAT2ACCUM(x) * CVT_FLOAT2ACCUM(alpha);
+}
 
-MIOPEN_TYPE miopenMin(MIOPEN_TYPE a, MIOPEN_TYPE b) { return ((a < b) ? a : b); }
+// c = op(alpha0 * a, operand) + beta * c, where the operand is alpha1 * b
+MIOPEN_TYPE miopenTensorOpElem(MIOPEN_TYPE a,
+                               MIOPEN_TYPE alpha0,
+                               MIOPEN_ACCUM_TYPE operand,
+                               MIOPEN_TYPE beta,
+                               MIOPEN_TYPE c)
+{
+    return CVT_ACCUM2FLOAT(MIOPEN_TENSOR_OP(miopenScale(a, alpha0), operand) +
+                           miopenScale(c, beta));
+}
 
 #ifdef USE_FWD_BIAS
 
@@ -98,8 +137,8 @@ __kernel void OpTensorFwdBias(global MIOPEN_TYPE* a,
 
         int lid = get_local_id(0);
 
-        int o_c             = incr_wg == 1 ? (gid % b_c) : gid;
-        MIOPEN_TYPE operand = b_off[o_c] * alpha1;
+        int o_c                   = incr_wg == 1 ? (gid % b_c) : gid;
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[o_c], alpha1);
 
         // each workgroup computes N*H*W for each C (bias-term)
         // number of workgroups = c_c (b_c)
@@ -108,7 +147,7 @@ __kernel void OpTensorFwdBias(global MIOPEN_TYPE* a,
             int o_hw     = incr_wg == 0 ? (lid % (work_per_wg / c_n)) : lid;
             int o_n      = incr_wg == 0 ? (lid / (work_per_wg / c_n)) : (gid / b_c);
             int index    = o_n * c_nstride + o_c * c_cstride + o_hw;
-            c_off[index] = MIOPEN_TENSOR_OP(a_off[index] * alpha0, operand) + beta * c_off[index];
+            c_off[index] = miopenTensorOpElem(a_off[index], alpha0, operand, beta, c_off[index]);
 
             lid += get_local_size(0);
         }
@@ -156,8 +195,8 @@ __kernel void OpTensorFwdBiasGeneric(global MIOPEN_TYPE* a,
 
         // each workgroup computes N*H*W for each C (bias-term)
         // number of workgroups = c_c (b_c)
-        int o_c             = (incr_wg == 1) ? (gid % b_c) : gid;
-        MIOPEN_TYPE operand = b_off[o_c * b_cstride] * alpha1;
+        int o_c                   = (incr_wg == 1) ? (gid % b_c) : gid;
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[o_c * b_cstride], alpha1);
 
         while(lid < work_per_wg)
         {
@@ -166,8 +205,7 @@ __kernel void OpTensorFwdBiasGeneric(global MIOPEN_TYPE* a,
             int o_w    = (incr_wg == 1) ? (lid % c_w) : ((lid / c_n) % c_w);
             int aindex = o_n * a_nstride + o_c * a_cstride + o_h * a_hstride + o_w;
             int cindex = o_n * c_nstride + o_c * c_cstride + o_h * c_hstride + o_w;
-            c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+            c_off[cindex] = miopenTensorOpElem(a_off[aindex], alpha0, operand, beta, c_off[cindex]);
 
             lid += get_local_size(0);
         }
@@ -212,9 +250,9 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
     for(; gid < num_wg; gid += MAX_NUM_WG)
     {
 
-        int lid             = (bitmap == 0xF) ? 0 : get_local_id(0);
-        int lcl_sz          = (bitmap == 0xF) ? work_per_wg : get_local_size(0);
-        MIOPEN_TYPE operand = b_off[gid] * alpha1;
+        int lid                   = (bitmap == 0xF) ? 0 : get_local_id(0);
+        int lcl_sz                = (bitmap == 0xF) ? work_per_wg : get_local_size(0);
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[gid], alpha1);
 
         int o_w = (bitmap & (1 << 0)) ? (gid % c_w) : 0;
         int o_h = (bitmap & (1 << 1)) ? ((gid / ((bitmap & (1 << 0)) ? c_w : 1)) % c_h) : 0;
@@ -229,7 +267,7 @@ __kernel void OpTensorLeadingOnes(global MIOPEN_TYPE* a,
         while(lid < work_per_wg)
         {
             int index    = o_n * c_nstride + o_c * c_cstride + o_h * c_w + o_w + lid;
-            c_off[index] = MIOPEN_TENSOR_OP(a_off[index] * alpha0, operand) + beta * c_off[index];
+            c_off[index] = miopenTensorOpElem(a_off[index], alpha0, operand, beta, c_off[index]);
             lid += lcl_sz;
         }
     }
@@ -292,8 +330,8 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
         int o_n = gid / (((bitmap & (1 << 0)) ? c_w : 1) * ((bitmap & (1 << 1)) ? c_h : 1) *
                          ((bitmap & (1 << 2)) ? c_c : 1));
 
-        int bindex          = o_n * b_nstride + o_c * b_cstride + o_h * b_hstride + o_w;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int bindex                = o_n * b_nstride + o_c * b_cstride + o_h * b_hstride + o_w;
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[bindex], alpha1);
 
         while(lid < work_per_wg)
         {
@@ -307,8 +345,7 @@ __kernel void OpTensorLeadingOnesGeneric(global MIOPEN_TYPE* a,
                              : ((bitmap & (1 << 2)) ? (lid % c_w) : ((lid / c_c) / c_h)));
             int aindex = o_n * a_nstride + o_c * a_cstride + o_h * a_hstride + o_w;
             int cindex = o_n * c_nstride + o_c * c_cstride + o_h * c_hstride + o_w;
-            c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+            c_off[cindex] = miopenTensorOpElem(a_off[aindex], alpha0, operand, beta, c_off[cindex]);
 
             lid += lcl_sz;
         }
@@ -371,7 +408,7 @@ __kernel void Op4dTensorGeneric(global MIOPEN_TYPE* a,
 
         int bindex = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_h_gid_off * b_hstride +
                      o_w_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[bindex], alpha1);
 
         while(lid < work_per_wg)
         {
@@ -382,8 +419,7 @@ __kernel void Op4dTensorGeneric(global MIOPEN_TYPE* a,
 
             int aindex = o_n * a_nstride + o_c * a_cstride + o_h * a_hstride + o_w;
             int cindex = o_n * c_nstride + o_c * c_cstride + o_h * c_hstride + o_w;
-            c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+            c_off[cindex] = miopenTensorOpElem(a_off[aindex], alpha0, operand, beta, c_off[cindex]);
 
             lid += get_local_size(0);
         }
@@ -455,7 +491,7 @@ __kernel void Op5dTensorGeneric(global MIOPEN_TYPE* a,
         int bindex = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_d_gid_off * b_dstride +
                      o_h_gid_off * b_hstride + o_w_gid_off;
 
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[bindex], alpha1);
 
         while(lid < work_per_wg)
         {
@@ -470,8 +506,7 @@ __kernel void Op5dTensorGeneric(global MIOPEN_TYPE* a,
             int cindex =
                 o_n * c_nstride + o_c * c_cstride + o_d * c_dstride + o_h * c_hstride + o_w;
 
-            c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+            c_off[cindex] = miopenTensorOpElem(a_off[aindex], alpha0, operand, beta, c_off[cindex]);
 
             lid += get_local_size(0);
         }
@@ -524,8 +559,8 @@ __kernel void Op3dTensorGeneric(global MIOPEN_TYPE* a,
         int o_c_gid_off = (gid / b_h) % b_c;
         int o_n_gid_off = (gid / b_h) / b_c;
 
-        int bindex          = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_h_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int bindex                = o_n_gid_off * b_nstride + o_c_gid_off * b_cstride + o_h_gid_off;
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[bindex], alpha1);
 
         while(lid < work_per_wg)
         {
@@ -536,8 +571,7 @@ __kernel void Op3dTensorGeneric(global MIOPEN_TYPE* a,
             int aindex = o_n * a_nstride + o_c * a_cstride + o_h;
             int cindex = o_n * c_nstride + o_c * c_cstride + o_h;
 
-            c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+            c_off[cindex] = miopenTensorOpElem(a_off[aindex], alpha0, operand, beta, c_off[cindex]);
 
             lid += get_local_size(0);
         }
@@ -603,11 +637,13 @@ __kernel void Op2dTensorLite(const global MIOPEN_TYPE* a,
 
             for(int i = 0; i < RD_BLCK; ++i)
             {
+                MIOPEN_ACCUM_TYPE c_acc = MIOPEN_TENSOR_OP(miopenScale(a_dat[i], alpha0),
+                                                           miopenScale(b_dat[i], alpha1));
                 if(use_beta == 1)
                 {
-                    c_dat[i] *= beta;
+                    c_acc += miopenScale(c_dat[i], beta);
                 }
-                c_dat[i] += MIOPEN_TENSOR_OP(a_dat[i] * alpha0, b_dat[i] * alpha1);
+                c_dat[i] = CVT_ACCUM2FLOAT(c_acc);
             }
 
             *((global READ_TYPE*)(c + Coffset + c_index)) = *((READ_TYPE*)c_dat);
@@ -638,6 +674,10 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
     MIOPEN_TYPE b_dat[RD_BLCK];
     MIOPEN_TYPE c_dat[RD_BLCK];
 
+    // the rows of b are summed up in the type of the arithmetic
+    MIOPEN_ACCUM_TYPE a_acc[RD_BLCK];
+    MIOPEN_ACCUM_TYPE c_acc[RD_BLCK];
+
     for(int i = 0; i < RD_BLCK; ++i)
     {
         b_dat[i] = (MIOPEN_TYPE)0;
@@ -647,8 +687,8 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
     {
         for(int i = 0; i < RD_BLCK; ++i)
         {
-            a_dat[i] = (MIOPEN_TYPE)0;
-            c_dat[i] = (MIOPEN_TYPE)0;
+            a_acc[i] = (MIOPEN_ACCUM_TYPE)0;
+            c_acc[i] = (MIOPEN_ACCUM_TYPE)0;
         }
 
         int io_index = gid * RD_BLCK;
@@ -657,7 +697,7 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
             *((READ_TYPE*)a_dat) = *((const global READ_TYPE*)(a + Aoffset + io_index));
             for(int i = 0; i < RD_BLCK; ++i)
             {
-                a_dat[i] *= alpha0;
+                a_acc[i] = miopenScale(a_dat[i], alpha0);
             }
         }
 
@@ -666,7 +706,7 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
             *((READ_TYPE*)c_dat) = *((const global READ_TYPE*)(c + Coffset + io_index));
             for(int i = 0; i < RD_BLCK; ++i)
             {
-                c_dat[i] *= beta;
+                c_acc[i] = miopenScale(c_dat[i], beta);
             }
         }
 
@@ -679,9 +719,13 @@ __kernel void Op2dTensorSquash(const global MIOPEN_TYPE* a,
             }
             for(int i = 0; i < RD_BLCK; ++i)
             {
-                c_dat[i] += MIOPEN_TENSOR_OP(a_dat[i], b_dat[i] * alpha1);
+                c_acc[i] += MIOPEN_TENSOR_OP(a_acc[i], miopenScale(b_dat[i], alpha1));
             }
         }
+        for(int i = 0; i < RD_BLCK; ++i)
+        {
+            c_dat[i] = CVT_ACCUM2FLOAT(c_acc[i]);
+        }
         *((global READ_TYPE*)(c + Coffset + io_index)) = *((READ_TYPE*)c_dat);
     }
 }
@@ -724,8 +768,8 @@ __kernel void Op2dTensorGeneric(global MIOPEN_TYPE* a,
         int o_c_gid_off = gid % b_c;
         int o_n_gid_off = gid / b_c;
 
-        int bindex          = o_n_gid_off * b_nstride + o_c_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int bindex                = o_n_gid_off * b_nstride + o_c_gid_off;
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[bindex], alpha1);
 
         while(lid < work_per_wg)
         {
@@ -733,8 +777,7 @@ __kernel void Op2dTensorGeneric(global MIOPEN_TYPE* a,
             int o_n    = (bitmap & (1 << 1)) ? o_n_gid_off : lid / o_n_div;
             int aindex = o_n * a_nstride + o_c;
             int cindex = o_n * c_nstride + o_c;
-            c_off[cindex] =
-                MIOPEN_TENSOR_OP(a_off[aindex] * alpha0, operand) + beta * c_off[cindex];
+            c_off[cindex] = miopenTensorOpElem(a_off[aindex], alpha0, operand, beta, c_off[cindex]);
             lid += get_local_size(0);
         }
     }
@@ -769,14 +812,14 @@ __kernel void Op1dTensorGeneric(global MIOPEN_TYPE* a,
     // MAX_NUM_WG: the maximum number of workgroups actually launched
     for(; gid < num_wg; gid += MAX_NUM_WG)
     {
-        int lid             = get_local_id(0);
-        int o_n_gid_off     = gid % b_n;
-        int bindex          = o_n_gid_off;
-        MIOPEN_TYPE operand = b_off[bindex] * alpha1;
+        int lid                   = get_local_id(0);
+        int o_n_gid_off           = gid % b_n;
+        int bindex                = o_n_gid_off;
+        MIOPEN_ACCUM_TYPE operand = miopenScale(b_off[bindex], alpha1);
         while(lid < work_per_wg)
         {
             int o_n    = (bitmap & (1 << 0)) ? o_n_gid_off : lid % c_n;
-            c_off[o_n] = MIOPEN_TENSOR_OP(a_off[o_n] * alpha0, operand) + beta * c_off[o_n];
+            c_off[o_n] = miopenTensorOpElem(a_off[o_n], alpha0, operand, beta, c_off[o_n]);
             lid += get_local_size(0);
         }
     }
@@ -831,11 +874,13 @@ __kernel void Op4dTensorLite(const global MIOPEN_TYPE* a,
 
         for(int i = 0; i < RD_BLCK; ++i)
         {
+            MIOPEN_ACCUM_TYPE c_acc =
+                MIOPEN_TENSOR_OP(miopenScale(a_dat[i], alpha0), miopenScale(b_dat[i], alpha1));
             if(use_beta == 1)
             {
-                c_dat[i] *= beta;
+                c_acc += miopenScale(c_dat[i], beta);
             }
-            c_dat[i] += MIOPEN_TENSOR_OP(a_dat[i] * alpha0, b_dat[i] * alpha1);
+            c_dat[i] = CVT_ACCUM2FLOAT(c_acc);
         }
 
         *((global READ_TYPE*)(c + index + Coffset)) = *((READ_TYPE*)c_dat);
@@ -0,0 +1,178 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Fused cast, stride-generic copy and scaling: y = alpha * x + beta * y, where x and y may have
+// different types and strides. The host folds the dimensions that are contiguous in both tensors
+// and passes the lengths and strides as compile-time lists. Every work-item takes MIO_TC_VEC
+// consecutive elements of the innermost dimension, which the host only vectorizes when it has
+// the unit stride in both tensors.
+//
+// The types are selected by MIOPEN_SRC_TYPE and MIOPEN_DST_TYPE with the codes of CastTensor:
+// 0 int8, 1 int32, 2 half, 3 float, 4 bfloat16 (stored as ushort). The arithmetic is done in
+// float, the conversion to the integer types saturates like the one to half does.
+
+#if MIOPEN_SRC_TYPE == 2 || MIOPEN_DST_TYPE == 2
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#endif
+
+#if MIOPEN_SRC_TYPE == 4 || MIOPEN_DST_TYPE == 4
+#include "bfloat16_dev.hpp"
+#endif
+
+#if MIOPEN_SRC_TYPE == 0
+#define TC_X_T char
+#elif MIOPEN_SRC_TYPE == 1
+#define TC_X_T int
+#elif MIOPEN_SRC_TYPE == 2
+#define TC_X_T half
+#elif MIOPEN_SRC_TYPE == 3
+#define TC_X_T float
+#else
+#define TC_X_T ushort
+#endif
+
+#if MIOPEN_DST_TYPE == 0
+#define TC_Y_T char
+#elif MIOPEN_DST_TYPE == 1
+#define TC_Y_T int
+#elif MIOPEN_DST_TYPE == 2
+#define TC_Y_T half
+#elif MIOPEN_DST_TYPE == 3
+#define TC_Y_T float
+#else
+#define TC_Y_T ushort
+#endif
+
+#if MIOPEN_SRC_TYPE == 4
+#define TC_LOAD_X(v) bfloat16_to_float(v)
+#else
+#define TC_LOAD_X(v) ((float)(v))
+#endif
+
+#if MIOPEN_DST_TYPE == 4
+#define TC_LOAD_Y(v) bfloat16_to_float(v)
+#define TC_STORE_Y(v) float_to_bfloat16(v)
+#elif MIOPEN_DST_TYPE == 3
+#define TC_LOAD_Y(v) (v)
+#define TC_STORE_Y(v) (v)
+#elif MIOPEN_DST_TYPE == 2
+#define TC_LOAD_Y(v) ((float)(v))
+#define TC_STORE_Y(v) ((half)clamp((v), -65504.0f, 65504.0f))
+#elif MIOPEN_DST_TYPE == 1
+#define TC_LOAD_Y(v) ((float)(v))
+#define TC_STORE_Y(v) convert_int_sat(v)
+#else
+#define TC_LOAD_Y(v) ((float)(v))
+#define TC_STORE_Y(v) convert_char_sat(v)
+#endif
+
+#ifndef MIO_TC_VEC
+#define MIO_TC_VEC 1
+#endif
+
+#define TC_PPCAT_NX(A, B) A##B
+#define TC_PPCAT(A, B) TC_PPCAT_NX(A, B)
+
+#define TC_LAST (MIO_TC_RANK - 1)
+
+__constant uint tc_lens[]       = {MIO_TC_LENS};
+__constant ulong tc_x_strides[] = {MIO_TC_X_STRIDES};
+__constant ulong tc_y_strides[] = {MIO_TC_Y_STRIDES};
+
+static inline void tc_load_x(const global TC_X_T* p, float* v)
+{
+#if MIO_TC_VEC > 1
+    const TC_PPCAT(TC_X_T, MIO_TC_VEC) t = TC_PPCAT(vload, MIO_TC_VEC)(0, p);
+    const TC_X_T* s                      = (const TC_X_T*)&t;
+    for(int k = 0; k < MIO_TC_VEC; ++k)
+        v[k] = TC_LOAD_X(s[k]);
+#else
+    v[0] = TC_LOAD_X(*p);
+#endif
+}
+
+static inline void tc_load_y(const global TC_Y_T* p, float* v)
+{
+#if MIO_TC_VEC > 1
+    const TC_PPCAT(TC_Y_T, MIO_TC_VEC) t = TC_PPCAT(vload, MIO_TC_VEC)(0, p);
+    const TC_Y_T* s                      = (const TC_Y_T*)&t;
+    for(int k = 0; k < MIO_TC_VEC; ++k)
+        v[k] = TC_LOAD_Y(s[k]);
+#else
+    v[0] = TC_LOAD_Y(*p);
+#endif
+}
+
+static inline void tc_store_y(global TC_Y_T* p, const float* v)
+{
+#if MIO_TC_VEC > 1
+    TC_Y_T s[MIO_TC_VEC];
+    for(int k = 0; k < MIO_TC_VEC; ++k)
+        s[k] = TC_STORE_Y(v[k]);
+    TC_PPCAT(vstore, MIO_TC_VEC)(*((const TC_PPCAT(TC_Y_T, MIO_TC_VEC)*)s), 0, p);
+#else
+    *p = TC_STORE_Y(v[0]);
+#endif
+}
+
+// global size: any, the work-items stride over the vectors of the tensor
+__kernel void MIOpenTransformCastTensor(const global TC_X_T* x,
+                                        global TC_Y_T* y,
+                                        float alpha,
+                                        float beta,
+                                        ulong x_offset,
+                                        ulong y_offset,
+                                        ulong total)
+{
+    for(ulong gid = get_global_id(0); gid < total; gid += get_global_size(0))
+    {
+        ulong x_off = x_offset;
+        ulong y_off = y_offset;
+
+        ulong rest = gid;
+        for(int d = TC_LAST; d >= 0; --d)
+        {
+            const uint len = (d == TC_LAST) ? tc_lens[d] / MIO_TC_VEC : tc_lens[d];
+            const uint i   = (d == TC_LAST) ? (rest % len) * MIO_TC_VEC : rest % len;
+            rest /= len;
+            x_off += i * tc_x_strides[d];
+            y_off += i * tc_y_strides[d];
+        }
+
+        float vx[MIO_TC_VEC];
+        float vy[MIO_TC_VEC];
+
+        tc_load_x(x + x_off, vx);
+        // A zero beta does not read y, so y may be uninitialized.
+        if(beta != 0.f)
+            tc_load_y(y + y_off, vy);
+
+        for(int k = 0; k < MIO_TC_VEC; ++k)
+            vy[k] = (beta != 0.f) ? mad(beta, vy[k], alpha * vx[k]) : alpha * vx[k];
+
+        tc_store_y(y + y_off, vy);
+    }
+}
@@ -13,7 +13,10 @@
 #define MIOPEN_NEURON_CLIPPED_RELU 7 // min(alpha, max(0, x))
 #define MIOPEN_NEURON_LEAKY_RELU 8   // alpha * x | x <= 0; x | x > 0
 #define MIOPEN_NEURON_ELU 9          // alpha * (e^x - 1) | x <= 0; x | x > 0
-#define MIOPEN_NEURON_TOTAL 10
+#define MIOPEN_NEURON_GELU 10        // 0.5 * x * (1 + erf(x / sqrt(2)))
+#define MIOPEN_NEURON_SILU 11        // x / (1 + e^-x)
+#define MIOPEN_NEURON_MISH 12        // x * tanh(log(1 + e^x))
+#define MIOPEN_NEURON_TOTAL 13
 
 static __constant _FLOAT kBNLL_THRESHOLD = (_FLOAT)50.;
 
@@ -194,6 +197,54 @@ void ActivationFunction_ELU(const uint n,
     }
 }
 
+void ActivationFunction_GELU(const uint n,
+                             _FLOAT_PREC* res,
+                             const _FLOAT_PREC* data,
+                             UNUSED const _FLOAT_PREC gamma,
+                             UNUSED const _FLOAT_PREC beta,
+                             UNUSED const _FLOAT_PREC alpha)
+{
+    for(uint i = 0; i < n; ++i)
+    {
+        // y = x * Phi(x), Phi is the standard normal CDF
+        res[i] = (_FLOAT_PREC)0.5f * data[i] *
+                 ((_FLOAT_PREC)1.f + erf(data[i] * (_FLOAT_PREC)0.70710678f));
+    }
+}
+
+void ActivationFunction_SiLU(const uint n,
+                             _FLOAT_PREC* res,
+                             const _FLOAT_PREC* data,
+                             UNUSED const _FLOAT_PREC gamma,
+                             UNUSED const _FLOAT_PREC beta,
+                             UNUSED const _FLOAT_PREC alpha)
+{
+    for(uint i = 0; i < n; ++i)
+    {
+        // y = x * sigmoid(x)
+        res[i] = data[i] / ((_FLOAT_PREC)1.f + exp(-data[i]));
+    }
+}
+
+_FLOAT_PREC SoftPlus(const _FLOAT_PREC x)
+{
+    return (x > 0) ? (x + log((_FLOAT_PREC)1.f + exp(-x))) : log((_FLOAT_PREC)1.f + exp(x));
+}
+
+void ActivationFunction_Mish(const uint n,
+                             _FLOAT_PREC* res,
+                             const _FLOAT_PREC* data,
+                             UNUSED const _FLOAT_PREC gamma,
+                             UNUSED const _FLOAT_PREC beta,
+                             UNUSED const _FLOAT_PREC alpha)
+{
+    for(uint i = 0; i < n; ++i)
+    {
+        // y = x * tanh(log(1 + exp(x)))
+        res[i] = data[i] * tanh(SoftPlus(data[i]));
+    }
+}
+
 void ActivationFunction(const uint n,
                         _FLOAT_PREC* res,
                         const _FLOAT_PREC* data,
@@ -245,6 +296,18 @@ void ActivationFunction(const uint n,
     {
         ActivationFunction_ELU(n, res, data, gamma, beta, alpha);
     }
+#elif MIOPEN_NRN_OP_ID == MIOPEN_NEURON_GELU
+    {
+        ActivationFunction_GELU(n, res, data, gamma, beta, alpha);
+    }
+#elif MIOPEN_NRN_OP_ID == MIOPEN_NEURON_SILU
+    {
+        ActivationFunction_SiLU(n, res, data, gamma, beta, alpha);
+    }
+#elif MIOPEN_NRN_OP_ID == MIOPEN_NEURON_MISH
+    {
+        ActivationFunction_Mish(n, res, data, gamma, beta, alpha);
+    }
 #endif
 }
 
@@ -422,6 +485,66 @@ void ActivationFunction_ELU_Diff(const uint n,
     }
 }
 
+void ActivationFunction_GELU_Diff(const uint n,
+                                  _FLOAT_PREC* bot_diff,
+                                  const _FLOAT_PREC* top_diff,
+                                  const _FLOAT_PREC* bot_data,
+                                  UNUSED const _FLOAT_PREC* top_data,
+                                  UNUSED const _FLOAT_PREC diff_scale,
+                                  UNUSED const _FLOAT_PREC gamma,
+                                  UNUSED const _FLOAT_PREC beta,
+                                  UNUSED const _FLOAT_PREC alpha)
+{
+    for(uint i = 0; i < n; ++i)
+    {
+        // dy/dx = Phi(x) + x * phi(x), phi is the standard normal PDF
+        _FLOAT_PREC x   = bot_data[i];
+        _FLOAT_PREC cdf =
+            (_FLOAT_PREC)0.5f * ((_FLOAT_PREC)1.f + erf(x * (_FLOAT_PREC)0.70710678f));
+        _FLOAT_PREC pdf = (_FLOAT_PREC)0.39894228f * exp((_FLOAT_PREC)-0.5f * x * x);
+        bot_diff[i]     = top_diff[i] * (cdf + x * pdf);
+    }
+}
+
+void ActivationFunction_SiLU_Diff(const uint n,
+                                  _FLOAT_PREC* bot_diff,
+                                  const _FLOAT_PREC* top_diff,
+                                  const _FLOAT_PREC* bot_data,
+                                  UNUSED const _FLOAT_PREC* top_data,
+                                  UNUSED const _FLOAT_PREC diff_scale,
+                                  UNUSED const _FLOAT_PREC gamma,
+                                  UNUSED const _FLOAT_PREC beta,
+                                  UNUSED const _FLOAT_PREC alpha)
+{
+    for(uint i = 0; i < n; ++i)
+    {
+        // dy/dx = s * (1 + x * (1 - s)), s = sigmoid(x)
+        _FLOAT_PREC x = bot_data[i];
+        _FLOAT_PREC s = (_FLOAT_PREC)1.f / ((_FLOAT_PREC)1.f + exp(-x));
+        bot_diff[i]   = top_diff[i] * s * ((_FLOAT_PREC)1.f + x * ((_FLOAT_PREC)1.f - s));
+    }
+}
+
+void ActivationFunction_Mish_Diff(const uint n,
+                                  _FLOAT_PREC* bot_diff,
+                                  const _FLOAT_PREC* top_diff,
+                                  const _FLOAT_PREC* bot_data,
+                                  UNUSED const _FLOAT_PREC* top_data,
+                                  UNUSED const _FLOAT_PREC diff_scale,
+                                  UNUSED const _FLOAT_PREC gamma,
+                                  UNUSED const _FLOAT_PREC beta,
+                                  UNUSED const _FLOAT_PREC alpha)
+{
+    for(uint i = 0; i < n; ++i)
+    {
+        // dy/dx = t + x * s * (1 - t^2), t = tanh(softplus(x)), s = sigmoid(x)
+        _FLOAT_PREC x = bot_data[i];
+        _FLOAT_PREC t = tanh(SoftPlus(x));
+        _FLOAT_PREC s = (_FLOAT_PREC)1.f / ((_FLOAT_PREC)1.f + exp(-x));
+        bot_diff[i]   = top_diff[i] * (t + x * s * ((_FLOAT_PREC)1.f - t * t));
+    }
+}
+
 void ActivationFunction_Diff(const uint n,
                              _FLOAT_PREC* bot_diff,
                              const _FLOAT_PREC* top_diff,
@@ -486,5 +609,20 @@ void ActivationFunction_Diff(const uint n,
         ActivationFunction_ELU_Diff(
             n, bot_diff, top_diff, bot_data, top_data, diff_scale, gamma, beta, alpha);
     }
+#elif MIOPEN_NRN_OP_ID == MIOPEN_NEURON_GELU
+    {
+        ActivationFunction_GELU_Diff(
+            n, bot_diff, top_diff, bot_data, top_data, diff_scale, gamma, beta, alpha);
+    }
+#elif MIOPEN_NRN_OP_ID == MIOPEN_NEURON_SILU
+    {
+        ActivationFunction_SiLU_Diff(
+            n, bot_diff, top_diff, bot_data, top_data, diff_scale, gamma, beta, alpha);
+    }
+#elif MIOPEN_NRN_OP_ID == MIOPEN_NEURON_MISH
+    {
+        ActivationFunction_Mish_Diff(
+            n, bot_diff, top_diff, bot_data, top_data, diff_scale, gamma, beta, alpha);
+    }
 #endif
 }
@@ -10,6 +10,10 @@
 #define MIOPEN_USE_FPMIX 0
 #endif
 
+#ifndef MIOPEN_USE_BFPMIX
+#define MIOPEN_USE_BFPMIX 0
+#endif
+
 #define _FLOAT_ACCUM float
 #if MIOPEN_USE_FP16 == 1
 #define MIO_BN_NODPP 1
@@ -52,6 +56,33 @@
 #endif
 #define EPSILON (_FLOAT)0.000001
 
+#endif
+#if MIOPEN_USE_BFPMIX == 1
+// bfloat16 data with float parameters; the data is stored as ushort and is converted with
+// BN_LOAD/BN_STORE, all the arithmetic is done in float.
+#include "bfloat16_dev.hpp"
+#define _FLOAT ushort
+
+#ifdef MIO_BN_NODPP
+#undef MIO_BN_NODPP
+#define MIO_BN_NODPP 0
+#endif
+
+#ifdef _FLOAT_PREC
+#undef _FLOAT_PREC
+#endif
+#define _FLOAT_PREC float
+
+#ifdef EPSILON
+#undef EPSILON
+#endif
+#define EPSILON 0.000001f
+
+#define BN_LOAD(v) bfloat16_to_float(v)
+#define BN_STORE(v) float_to_bfloat16(v)
+#else
+#define BN_LOAD(v) ((_FLOAT_ACCUM)(v))
+#define BN_STORE(v) ((_FLOAT)(v))
 #endif
 
 #define _FLOAT2 PPCAT(_FLOAT, TWO)
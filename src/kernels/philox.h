@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_PHILOX_H
+#define GUARD_PHILOX_H
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"). Every output is a
+// pure function of the key and the counter, so the random number of an element can be
+// regenerated from its position at any time without keeping generator states. The dropout
+// kernels and the fused dropout of MIOpenNorm.cl draw the same mask from (seed, offset, element),
+// the attention kernels of MIOpenMha.cl draw theirs from (seed, offset, query, key).
+
+#define PHILOX_M0 0xD2511F53U
+#define PHILOX_M1 0xCD9E8D57U
+#define PHILOX_W0 0x9E3779B9U
+#define PHILOX_W1 0xBB67AE85U
+
+static inline uint4 philox4x32_10(uint4 ctr, uint2 key)
+{
+    for(int r = 0; r < 10; ++r)
+    {
+        if(r > 0)
+        {
+            key.x += PHILOX_W0;
+            key.y += PHILOX_W1;
+        }
+        const uint lo0 = PHILOX_M0 * ctr.x;
+        const uint hi0 = mul_hi(PHILOX_M0, ctr.x);
+        const uint lo1 = PHILOX_M1 * ctr.z;
+        const uint hi1 = mul_hi(PHILOX_M1, ctr.z);
+        ctr            = (uint4)(hi1 ^ ctr.y ^ key.x, lo1, hi0 ^ ctr.w ^ key.y, lo0);
+    }
+    return ctr;
+}
+
+// One generator call covers four consecutive elements; the counter is (element / 4, row, offset).
+// Most masks are a single row. The attention probabilities of MIOpenMha.cl use a row per query,
+// since they would exceed 2^32 elements.
+static inline uint philox_element_2d(ulong seed, ulong offset, uint row, uint elem)
+{
+    const uint4 ctr = (uint4)(elem / 4, row, (uint)offset, (uint)(offset >> 32));
+    const uint4 res = philox4x32_10(ctr, (uint2)((uint)seed, (uint)(seed >> 32)));
+    const uint lane = elem % 4;
+    return lane == 0 ? res.x : lane == 1 ? res.y : lane == 2 ? res.z : res.w;
+}
+
+static inline uint philox_element(ulong seed, ulong offset, uint elem)
+{
+    return philox_element_2d(seed, offset, 0, elem);
+}
+
+// Uniform in (0, 1], the mapping of the xorwow dropout kernels.
+static inline float philox_uniform_2d(ulong seed, ulong offset, uint row, uint elem)
+{
+    return 2.3283064e-10f + philox_element_2d(seed, offset, row, elem) * 2.3283064e-10f;
+}
+
+static inline float philox_uniform(ulong seed, ulong offset, uint elem)
+{
+    return philox_uniform_2d(seed, offset, 0, elem);
+}
+
+#endif // GUARD_PHILOX_H
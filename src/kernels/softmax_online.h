@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_SOFTMAX_ONLINE_H
+#define GUARD_SOFTMAX_ONLINE_H
+
+// Row statistics shared by the online softmax kernels. A work-group of MIO_SFM_GRP work-items
+// walks a contiguous row in vectors of MIO_SFM_VEC elements and keeps the running maximum of the
+// row with the sum of exponentials relative to it, rescaling the sum whenever the maximum grows.
+
+#include "float_types.h"
+
+#ifndef _FLOAT4
+#define _FLOAT4 PPCAT(_FLOAT, FOUR)
+#endif
+
+#define UNUSED __attribute__((__unused__))
+
+#ifndef MIO_SFM_VEC
+#define MIO_SFM_VEC 1
+#endif
+
+#ifndef MIO_SFM_CACHE
+#define MIO_SFM_CACHE 0
+#endif
+
+static inline void sfm_load(const global _FLOAT* p, float* v)
+{
+#if MIO_SFM_VEC == 4
+    const _FLOAT4 t = vload4(0, p);
+    v[0]            = CVT_FLOAT2ACCUM(t.x);
+    v[1]            = CVT_FLOAT2ACCUM(t.y);
+    v[2]            = CVT_FLOAT2ACCUM(t.z);
+    v[3]            = CVT_FLOAT2ACCUM(t.w);
+#elif MIO_SFM_VEC == 2
+    const _FLOAT2 t = vload2(0, p);
+    v[0]            = CVT_FLOAT2ACCUM(t.x);
+    v[1]            = CVT_FLOAT2ACCUM(t.y);
+#else
+    v[0] = CVT_FLOAT2ACCUM(*p);
+#endif
+}
+
+static inline void sfm_store(global _FLOAT* p, const float* v)
+{
+#if MIO_SFM_VEC == 4
+    _FLOAT4 t;
+    t.x = CVT_ACCUM2FLOAT(v[0]);
+    t.y = CVT_ACCUM2FLOAT(v[1]);
+    t.z = CVT_ACCUM2FLOAT(v[2]);
+    t.w = CVT_ACCUM2FLOAT(v[3]);
+    vstore4(t, 0, p);
+#elif MIO_SFM_VEC == 2
+    _FLOAT2 t;
+    t.x = CVT_ACCUM2FLOAT(v[0]);
+    t.y = CVT_ACCUM2FLOAT(v[1]);
+    vstore2(t, 0, p);
+#else
+    *p = CVT_ACCUM2FLOAT(v[0]);
+#endif
+}
+
+/// Rows are the pixels of the channel mode or the images of the instance mode.
+static inline uint
+sfm_row_offset(uint row, uint row_hw, uint row_w, uint nstr, uint hstr, uint wstr)
+{
+    const uint n  = row / row_hw;
+    const uint hw = row % row_hw;
+    return n * nstr + (hw / row_w) * hstr + (hw % row_w) * wstr;
+}
+
+/// Folds a vector into the running maximum m and the running sum s.
+static inline void sfm_update(float* m, float* s, const float* v)
+{
+    float vm = v[0];
+    for(uint k = 1; k < MIO_SFM_VEC; k++)
+        vm = fmax(vm, v[k]);
+
+    const float nm = fmax(*m, vm);
+    float ns       = *s * exp(*m - nm);
+    for(uint k = 0; k < MIO_SFM_VEC; k++)
+        ns += exp(v[k] - nm);
+    *m = nm;
+    *s = ns;
+}
+
+static inline void sfm_merge(float* m, float* s, float om, float os)
+{
+    const float nm = fmax(*m, om);
+    *s             = *s * exp(*m - nm) + os * exp(om - nm);
+    *m             = nm;
+}
+
+static inline void sfm_reduce(float* m, float* s, local float* lm, local float* ls)
+{
+    const uint lid = get_local_id(0);
+    lm[lid]        = *m;
+    ls[lid]        = *s;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    for(uint red = MIO_SFM_GRP / 2; red > 0; red >>= 1)
+    {
+        if(lid < red)
+        {
+            float rm = lm[lid];
+            float rs = ls[lid];
+            sfm_merge(&rm, &rs, lm[lid + red], ls[lid + red]);
+            lm[lid] = rm;
+            ls[lid] = rs;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+    *m = lm[0];
+    *s = ls[0];
+}
+
+/// Statistics of the chunk of the row starting at xr, kept in cache when it fits.
+static inline void sfm_stats(const global _FLOAT* xr,
+                             uint nvecs,
+                             float* m,
+                             float* s,
+                             UNUSED float (*cache)[MIO_SFM_VEC])
+{
+    *m = -FLT_MAX;
+    *s = 0.0f;
+#if MIO_SFM_CACHE > 0
+    for(uint j = 0; j < MIO_SFM_CACHE; j++)
+    {
+        const uint i = get_local_id(0) + j * MIO_SFM_GRP;
+        if(i < nvecs)
+        {
+            sfm_load(xr + i * MIO_SFM_VEC, cache[j]);
+            sfm_update(m, s, cache[j]);
+        }
+    }
+#else
+    for(uint i = get_local_id(0); i < nvecs; i += MIO_SFM_GRP)
+    {
+        float v[MIO_SFM_VEC];
+        sfm_load(xr + i * MIO_SFM_VEC, v);
+        sfm_update(m, s, v);
+    }
+#endif
+}
+#if MIO_SFM_CACHE > 0
+#define MIO_SFM_CACHE_DECL float cache[MIO_SFM_CACHE][MIO_SFM_VEC]
+#else
+#define MIO_SFM_CACHE_DECL float(*cache)[MIO_SFM_VEC] = 0
+#endif
+
+#endif // GUARD_SOFTMAX_ONLINE_H
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/layout_support.hpp>
+#include <miopen/batchnorm/problem_description.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/lrn.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/tensor.hpp>
+
+namespace miopen {
+
+// The strides of a packed tensor whose dimensions are laid out in their order, e.g. NCHW.
+static bool IsChannelFirst(const TensorDescriptor& desc)
+{
+    const auto& lens     = desc.GetLengths();
+    const auto& strides  = desc.GetStrides();
+    std::size_t expected = 1;
+    for(auto i = lens.size(); i > 0; --i)
+    {
+        if(lens[i - 1] > 1 && strides[i - 1] != expected)
+            return false;
+        expected *= lens[i - 1];
+    }
+    return true;
+}
+
+static bool IsConvLayoutNative(const TensorDescriptor& desc)
+{
+    if(!desc.IsPacked())
+        return false;
+    if(desc.GetSize() == 4)
+    {
+        const auto layout = desc.GetLayout("NCHW");
+        return layout == "NCHW" || layout == "NHWC";
+    }
+    if(desc.GetSize() == 5)
+    {
+        const auto layout = desc.GetLayout("NCDHW");
+        return layout == "NCDHW" || layout == "NDHWC";
+    }
+    return false;
+}
+
+bool IsTensorLayoutNative(miopenPrimitive_t primitive, const TensorDescriptor& desc)
+{
+    const auto& strides = desc.GetStrides();
+    switch(primitive)
+    {
+    case miopenPrimitiveConvolution: return IsConvLayoutNative(desc);
+    case miopenPrimitiveBatchNorm:
+        // The 5D channel-last tensors are reshaped to 4D before the check of the primitive.
+        return desc.IsPacked() && (IsChannelFirst(desc) || batchnorm::IsLayoutNHWC(desc) ||
+                                   (desc.GetSize() == 5 && desc.GetLayout("NCDHW") == "NDHWC"));
+    case miopenPrimitivePooling:
+        if(desc.GetSize() == 4 && IsPoolingNHWC(desc))
+            return true;
+        return (desc.GetSize() == 4 || desc.GetSize() == 5) && strides.back() == 1;
+    case miopenPrimitiveLRN:
+        return desc.GetSize() == 4 && desc.IsPacked() && (IsChannelFirst(desc) || IsLRNNHWC(desc));
+    case miopenPrimitiveSoftmax:
+        // The online kernels take channel-last rows, the accurate ones any unit-stride W.
+        return desc.GetSize() == 4 && (strides[1] == 1 || strides[3] == 1);
+    case miopenPrimitiveActivation: return desc.IsPacked() || desc.GetSize() <= 4;
+    case miopenPrimitiveTensorOp: return desc.GetSize() <= 5;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Unknown primitive");
+}
+
+} // namespace miopen
@@ -0,0 +1,360 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/mapped_db.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+constexpr std::uint32_t mapped_db_version = 1;
+constexpr char mapped_db_magic[8]         = {'M', 'I', 'O', 'P', 'E', 'N', 'D', 'B'};
+} // namespace
+
+struct MappedDb::Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t count;
+    // Size of the text database the file has been built from.
+    std::uint64_t text_size;
+    std::uint64_t index_offset;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+};
+
+struct MappedDb::IndexItem
+{
+    std::uint64_t key_offset;
+    std::uint64_t content_offset;
+    std::uint32_t key_size;
+    std::uint32_t content_size;
+    std::int32_t line;
+    std::uint32_t reserved;
+};
+
+std::string MappedDb::GetPath(const std::string& text_path) { return text_path + ".bin"; }
+
+MappedDb::MappedDb(const std::string& path_, boost::interprocess::mapped_region&& region_)
+    : path(path_), region(std::move(region_))
+{
+}
+
+std::unique_ptr<MappedDb> MappedDb::Open(const std::string& path, const std::string& text_path)
+{
+    if(!boost::filesystem::exists(path))
+        return nullptr;
+
+    auto db = std::unique_ptr<MappedDb>{};
+    try
+    {
+        const auto file = boost::interprocess::file_mapping{path.c_str(),
+                                                            boost::interprocess::read_only};
+        db.reset(new MappedDb{path, {file, boost::interprocess::read_only}});
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map " << path << ": " << ex.what());
+        return nullptr;
+    }
+
+    if(!db->Validate(text_path))
+        return nullptr;
+    MIOPEN_LOG_I2("Mapped " << db->GetCount() << " records from " << path);
+    return db;
+}
+
+const MappedDb::Header& MappedDb::GetHeader() const
+{
+    return *static_cast<const Header*>(region.get_address());
+}
+
+const MappedDb::IndexItem* MappedDb::GetIndex() const
+{
+    return reinterpret_cast<const IndexItem*>(static_cast<const char*>(region.get_address()) +
+                                              GetHeader().index_offset);
+}
+
+const char* MappedDb::GetData() const
+{
+    return static_cast<const char*>(region.get_address()) + GetHeader().data_offset;
+}
+
+std::size_t MappedDb::GetCount() const { return GetHeader().count; }
+
+bool MappedDb::IsComplete() const
+{
+    // The header of a shared segment is written after the rest of it.
+    const auto complete =
+        region.get_size() >= sizeof(Header) &&
+        std::memcmp(GetHeader().magic, mapped_db_magic, sizeof(mapped_db_magic)) == 0;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return complete;
+}
+
+bool MappedDb::Validate(const std::string& text_path) const
+{
+    const auto size = region.get_size();
+    if(size < sizeof(Header))
+    {
+        MIOPEN_LOG_W("Ill-formed file: " << path);
+        return false;
+    }
+
+    const auto& header = GetHeader();
+    const auto index_fits = header.index_offset % alignof(IndexItem) == 0 &&
+                            header.index_offset <= size &&
+                            header.count <= (size - header.index_offset) / sizeof(IndexItem);
+    const auto data_fits =
+        header.data_offset <= size && header.data_size <= size - header.data_offset;
+
+    if(std::memcmp(header.magic, mapped_db_magic, sizeof(mapped_db_magic)) != 0 ||
+       header.version != mapped_db_version || !index_fits || !data_fits)
+    {
+        MIOPEN_LOG_W("Ill-formed file: " << path);
+        return false;
+    }
+
+    boost::system::error_code error;
+    const auto text_size = boost::filesystem::file_size(text_path, error);
+    if(!error && text_size != header.text_size)
+    {
+        MIOPEN_LOG_I("Outdated file: " << path << ", " << text_path << " is used instead");
+        return false;
+    }
+    return true;
+}
+
+boost::optional<MappedDb::Record> MappedDb::Find(const std::string& key) const
+{
+    const auto& header = GetHeader();
+    const auto data    = GetData();
+    const auto begin   = GetIndex();
+    const auto end     = begin + header.count;
+
+    const auto less = [&](const IndexItem& item, const std::string& k) {
+        return k.compare(0, std::string::npos, data + item.key_offset, item.key_size) > 0;
+    };
+    const auto it = std::lower_bound(begin, end, key, less);
+
+    if(it == end || key.compare(0, std::string::npos, data + it->key_offset, it->key_size) != 0)
+        return boost::none;
+
+    if(it->content_offset > header.data_size ||
+       it->content_size > header.data_size - it->content_offset)
+    {
+        MIOPEN_LOG_E("Ill-formed record: " << path << "#" << it->line);
+        return boost::none;
+    }
+
+    return Record{it->line, {data + it->content_offset, it->content_size}};
+}
+
+std::string MappedDb::Build(const std::string& text_path, std::size_t& count)
+{
+    auto input = std::ifstream{text_path};
+    if(!input)
+        MIOPEN_THROW("File is unreadable: " + text_path);
+
+    auto records = std::map<std::string, Record>{};
+    auto line    = std::string{};
+    auto n_line  = 0;
+
+    while(std::getline(input, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << text_path << "#" << n_line);
+            continue;
+        }
+
+        records.emplace(line.substr(0, key_size), Record{n_line, line.substr(key_size + 1)});
+    }
+
+    auto index = std::vector<IndexItem>{};
+    auto data  = std::string{};
+    index.reserve(records.size());
+
+    for(const auto& record : records)
+    {
+        auto item           = IndexItem{};
+        item.key_offset     = data.size();
+        item.key_size       = record.first.size();
+        item.content_offset = item.key_offset + item.key_size;
+        item.content_size   = record.second.content.size();
+        item.line           = record.second.line;
+        index.push_back(item);
+        data += record.first;
+        data += record.second.content;
+    }
+
+    auto header = Header{};
+    std::copy(std::begin(mapped_db_magic), std::end(mapped_db_magic), std::begin(header.magic));
+    header.version      = mapped_db_version;
+    header.count        = index.size();
+    header.text_size    = boost::filesystem::file_size(text_path);
+    header.index_offset = sizeof(Header);
+    header.data_offset  = header.index_offset + index.size() * sizeof(IndexItem);
+    header.data_size    = data.size();
+
+    auto image = std::string{};
+    image.reserve(header.data_offset + data.size());
+    image.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    image.append(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(IndexItem));
+    image.append(data);
+    count = index.size();
+    return image;
+}
+
+void MappedDb::Convert(const std::string& text_path, const std::string& path)
+{
+    auto count       = std::size_t{0};
+    const auto image = Build(text_path, count);
+
+    // Processes which map the file at the moment never see it partially written.
+    const auto tmp_path = path + ".tmp";
+    {
+        auto output = std::ofstream{tmp_path, std::ios::binary | std::ios::trunc};
+        output.write(image.data(), image.size());
+        if(!output)
+            MIOPEN_THROW("Unable to write " + tmp_path);
+    }
+    boost::filesystem::rename(tmp_path, path);
+    MIOPEN_LOG_I("Converted " << count << " records from " << text_path << " to " << path);
+}
+
+std::string MappedDb::GetSharedName(const std::string& text_path)
+{
+    const auto path = boost::filesystem::absolute(text_path);
+    std::ostringstream version;
+    version << path.string() << ':' << boost::filesystem::file_size(path) << ':'
+            << boost::filesystem::last_write_time(path) << ':' << mapped_db_version;
+    return "miopen_db_" + md5(version.str());
+}
+
+std::unique_ptr<MappedDb> MappedDb::OpenShared(const std::string& text_path)
+{
+    namespace ipc = boost::interprocess;
+
+    auto name = std::string{};
+    try
+    {
+        name = GetSharedName(text_path);
+    }
+    catch(const boost::filesystem::filesystem_error& ex)
+    {
+        MIOPEN_LOG_I2(ex.what());
+        return nullptr;
+    }
+
+    try
+    {
+        auto segment = ipc::shared_memory_object{ipc::create_only, name.c_str(), ipc::read_write};
+        try
+        {
+            auto count       = std::size_t{0};
+            const auto image = Build(text_path, count);
+            segment.truncate(image.size());
+            const auto writable = ipc::mapped_region{segment, ipc::read_write};
+            const auto address  = static_cast<char*>(writable.get_address());
+            std::copy(image.begin() + sizeof(Header), image.end(), address + sizeof(Header));
+            std::atomic_thread_fence(std::memory_order_release);
+            std::copy(image.begin(), image.begin() + sizeof(Header), address);
+            MIOPEN_LOG_I("Shared " << count << " records from " << text_path << " as " << name);
+        }
+        catch(...)
+        {
+            ipc::shared_memory_object::remove(name.c_str());
+            throw;
+        }
+    }
+    catch(const ipc::interprocess_exception& ex)
+    {
+        if(ex.get_error_code() != ipc::already_exists_error)
+        {
+            MIOPEN_LOG_W("Unable to share " << text_path << ": " << ex.what());
+            return nullptr;
+        }
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to share " << text_path << ": " << ex.what());
+        return nullptr;
+    }
+
+    auto db = std::unique_ptr<MappedDb>{};
+    try
+    {
+        const auto segment =
+            ipc::shared_memory_object{ipc::open_only, name.c_str(), ipc::read_only};
+        db.reset(new MappedDb{name, {segment, ipc::read_only}});
+    }
+    catch(const ipc::interprocess_exception& ex)
+    {
+        // An empty segment cannot be mapped.
+        MIOPEN_LOG_I2("Unable to map " << name << ": " << ex.what());
+        return nullptr;
+    }
+
+    if(!db->IsComplete())
+    {
+        MIOPEN_LOG_I2(name << " is being created by another process");
+        return nullptr;
+    }
+    if(!db->Validate(text_path))
+        return nullptr;
+    MIOPEN_LOG_I2("Mapped " << db->GetCount() << " records from " << name);
+    return db;
+}
+
+void MappedDb::RemoveShared(const std::string& text_path)
+{
+    boost::interprocess::shared_memory_object::remove(GetSharedName(text_path).c_str());
+}
+
+} // namespace miopen
@@ -227,9 +227,16 @@ void FusionMDGraph::Init(FusionMDGraph& g, miopenFusionOp_t op)
     case miopenFusionOpActivForward:
     case miopenFusionOpActivBackward:
     case miopenFusionOpBiasForward:
-        MIOPEN_THROW(
-            miopenStatusNotImplemented,
-            "Operators Activ and Bias are not supported as first ops in a Fusion Plan (yet)");
+    case miopenFusionOpTensorForward:
+    case miopenFusionOpScaleForward:
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Elementwise operators are not supported as first ops of the graph (yet)");
+    case miopenFusionOpPoolingForward:
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Pooling is not supported as the first op of the graph (yet)");
+    case miopenFusionOpBiasBackward:
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "The bias gradient is not supported as the first op of the graph (yet)");
     }
 }
 
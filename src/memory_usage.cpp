@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/memory_usage.hpp>
+
+#include <sstream>
+
+namespace miopen {
+
+namespace {
+
+const char* GetCategoryName(std::size_t category)
+{
+    switch(static_cast<MemoryCategory>(category))
+    {
+    case MemoryCategory::Buffers: return "buffers";
+    case MemoryCategory::Search: return "search";
+    case MemoryCategory::Constants: return "constants";
+    case MemoryCategory::CodeObjects: return "code_objects";
+    case MemoryCategory::Rocblas: return "rocblas";
+    case MemoryCategory::Count: break;
+    }
+    return "unknown";
+}
+
+void UpdatePeak(std::atomic<std::size_t>& peak, std::size_t value)
+{
+    auto current = peak.load(std::memory_order_relaxed);
+    while(current < value && !peak.compare_exchange_weak(current, value))
+    {
+    }
+}
+
+MemoryCategory& ThreadCategory()
+{
+    static thread_local MemoryCategory category = MemoryCategory::Buffers;
+    return category;
+}
+
+} // namespace
+
+void MemoryUsage::Counter::Add(std::size_t bytes) { UpdatePeak(peak, current += bytes); }
+
+void MemoryUsage::Add(MemoryCategory category, std::size_t bytes)
+{
+    At(category).Add(bytes);
+    total.Add(bytes);
+}
+
+void MemoryUsage::Remove(MemoryCategory category, std::size_t bytes)
+{
+    At(category).current -= bytes;
+    total.current -= bytes;
+}
+
+void MemoryUsage::Set(MemoryCategory category, std::size_t bytes)
+{
+    const auto previous = At(category).current.exchange(bytes);
+    UpdatePeak(At(category).peak, bytes);
+    UpdatePeak(total.peak, total.current += bytes - previous);
+}
+
+void MemoryUsage::AddSelectedWorkspace(std::size_t bytes) { UpdatePeak(selected_workspace, bytes); }
+
+void MemoryUsage::ResetPeaks()
+{
+    for(auto& counter : counters)
+        counter.peak = counter.current.load();
+    total.peak         = total.current.load();
+    selected_workspace = 0;
+}
+
+std::string MemoryUsage::ToJson() const
+{
+    std::ostringstream os;
+    os << '{';
+    const auto print = [&](const char* name, const Counter& counter) {
+        os << '"' << name << "\": {\"current\": " << counter.current
+           << ", \"peak\": " << counter.peak << "}, ";
+    };
+    for(std::size_t i = 0; i < counters.size(); ++i)
+        print(GetCategoryName(i), counters[i]);
+    print("total", total);
+    os << "\"selected_workspace_peak\": " << selected_workspace << '}';
+    return os.str();
+}
+
+MemoryCategoryScope::MemoryCategoryScope(MemoryCategory category) : previous(ThreadCategory())
+{
+    ThreadCategory() = category;
+}
+
+MemoryCategoryScope::~MemoryCategoryScope() { ThreadCategory() = previous; }
+
+MemoryCategory MemoryCategoryScope::Current() { return ThreadCategory(); }
+
+} // namespace miopen
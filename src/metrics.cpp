@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/metrics.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_METRICS_FILE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_METRICS_INTERVAL_S)
+
+namespace miopen {
+
+namespace {
+
+const char* GetMetricName(std::size_t metric)
+{
+    switch(static_cast<Metric>(metric))
+    {
+    case Metric::InvokerCacheHits: return "invoker_cache_hits";
+    case Metric::InvokerCacheMisses: return "invoker_cache_misses";
+    case Metric::KernelCacheHits: return "kernel_cache_hits";
+    case Metric::KernelCacheMisses: return "kernel_cache_misses";
+    case Metric::BinaryCacheHits: return "binary_cache_hits";
+    case Metric::BinaryCacheMisses: return "binary_cache_misses";
+    case Metric::FindDbHits: return "find_db_hits";
+    case Metric::FindDbMisses: return "find_db_misses";
+    case Metric::Compiles: return "compiles";
+    case Metric::CompileUs: return "compile_us";
+    case Metric::Finds: return "finds";
+    case Metric::FindUs: return "find_us";
+    case Metric::Allocations: return "allocations";
+    case Metric::AllocatedBytes: return "allocated_bytes";
+    case Metric::Count: break;
+    }
+    return "unknown";
+}
+
+const std::string& GetDumpPath()
+{
+    static const std::string path = [] {
+        const char* const value = GetStringEnv(MIOPEN_METRICS_FILE{});
+        return value == nullptr ? std::string{} : std::string{value};
+    }();
+    return path;
+}
+
+std::int64_t NowSeconds()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+Metrics& Metrics::Process()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static Metrics metrics;
+    return metrics;
+}
+
+std::string Metrics::ToJson() const
+{
+    std::ostringstream os;
+    os << '{';
+    for(std::size_t i = 0; i < counters.size(); ++i)
+    {
+        os << (i == 0 ? "" : ", ") << '"' << GetMetricName(i)
+           << "\": " << counters[i].load(std::memory_order_relaxed);
+    }
+    os << '}';
+    return os.str();
+}
+
+void Metrics::Reset()
+{
+    for(auto& counter : counters)
+        counter.store(0, std::memory_order_relaxed);
+}
+
+void Metrics::Dump()
+{
+    const auto& path = GetDumpPath();
+    if(path.empty())
+        return;
+    // Concurrent dumps would interleave in the file.
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock(mutex);
+    std::ofstream file{path, std::ios::trunc};
+    file << Process().ToJson() << std::endl;
+    if(!file)
+        MIOPEN_LOG_W("Unable to write metrics to " << path);
+}
+
+void Metrics::DumpIfDue()
+{
+    static const auto interval = static_cast<std::int64_t>(Value(MIOPEN_METRICS_INTERVAL_S{}));
+    if(interval == 0 || GetDumpPath().empty())
+        return;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::atomic<std::int64_t> next_dump{NowSeconds() + interval};
+    const auto now = NowSeconds();
+    auto due       = next_dump.load(std::memory_order_relaxed);
+    // Only the thread which moves the deadline dumps.
+    if(now >= due && next_dump.compare_exchange_strong(due, now + interval))
+        Dump();
+}
+
+void AddMetric(const Handle& handle, Metric metric, std::uint64_t value)
+{
+    handle.GetMetrics().Add(metric, value);
+    Metrics::Process().Add(metric, value);
+    Metrics::DumpIfDue();
+}
+
+void AddMetricTime(const Handle& handle, Metric count, Metric us, double ms)
+{
+    AddMetric(handle, count);
+    AddMetric(handle, us, static_cast<std::uint64_t>(ms * 1000));
+}
+
+} // namespace miopen
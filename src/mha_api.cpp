@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/dropout.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mha.hpp>
+#include <miopen/tensor.hpp>
+
+// The dropout is optional.
+static const miopen::DropoutDescriptor*
+MhaDropoutDesc(const miopenDropoutDescriptor_t dropoutDesc)
+{
+    return dropoutDesc != nullptr ? &miopen::deref(dropoutDesc) : nullptr;
+}
+
+extern "C" miopenStatus_t
+miopenMultiHeadAttentionForward(miopenHandle_t handle,
+                                const miopenTensorDescriptor_t qDesc,
+                                const void* q,
+                                const miopenTensorDescriptor_t kDesc,
+                                const void* k,
+                                const miopenTensorDescriptor_t vDesc,
+                                const void* v,
+                                float scale,
+                                bool causal,
+                                const miopenDropoutDescriptor_t dropoutDesc,
+                                const miopenTensorDescriptor_t oDesc,
+                                void* o,
+                                void* lse)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, qDesc, q, kDesc, k, vDesc, v, scale, causal, dropoutDesc, oDesc, o, lse);
+    return miopen::try_([&] {
+        miopen::MhaForward(miopen::deref(handle),
+                           miopen::deref(qDesc),
+                           DataCast(q),
+                           miopen::deref(kDesc),
+                           DataCast(k),
+                           miopen::deref(vDesc),
+                           DataCast(v),
+                           scale,
+                           causal,
+                           MhaDropoutDesc(dropoutDesc),
+                           miopen::deref(oDesc),
+                           DataCast(o),
+                           DataCast(lse));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenGetMultiHeadAttentionBackwardWorkspaceSize(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t qDesc,
+                                                 size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, qDesc, workSpaceSize);
+    return miopen::try_([&] {
+        miopen::deref(workSpaceSize) = miopen::GetMhaBackwardWorkspaceSize(miopen::deref(qDesc));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenMultiHeadAttentionBackward(miopenHandle_t handle,
+                                 const miopenTensorDescriptor_t qDesc,
+                                 const void* q,
+                                 const miopenTensorDescriptor_t kDesc,
+                                 const void* k,
+                                 const miopenTensorDescriptor_t vDesc,
+                                 const void* v,
+                                 const miopenTensorDescriptor_t oDesc,
+                                 const void* o,
+                                 const miopenTensorDescriptor_t doDesc,
+                                 const void* dout,
+                                 const void* lse,
+                                 float scale,
+                                 bool causal,
+                                 const miopenDropoutDescriptor_t dropoutDesc,
+                                 const miopenTensorDescriptor_t dqDesc,
+                                 void* dq,
+                                 const miopenTensorDescriptor_t dkDesc,
+                                 void* dk,
+                                 const miopenTensorDescriptor_t dvDesc,
+                                 void* dv,
+                                 void* workSpace,
+                                 size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        qDesc,
+                        q,
+                        kDesc,
+                        k,
+                        vDesc,
+                        v,
+                        oDesc,
+                        o,
+                        doDesc,
+                        dout,
+                        lse,
+                        scale,
+                        causal,
+                        dropoutDesc,
+                        dqDesc,
+                        dq,
+                        dkDesc,
+                        dk,
+                        dvDesc,
+                        dv,
+                        workSpace,
+                        workSpaceSize);
+    return miopen::try_([&] {
+        miopen::MhaBackward(miopen::deref(handle),
+                            miopen::deref(qDesc),
+                            DataCast(q),
+                            miopen::deref(kDesc),
+                            DataCast(k),
+                            miopen::deref(vDesc),
+                            DataCast(v),
+                            miopen::deref(oDesc),
+                            DataCast(o),
+                            miopen::deref(doDesc),
+                            DataCast(dout),
+                            DataCast(lse),
+                            scale,
+                            causal,
+                            MhaDropoutDesc(dropoutDesc),
+                            miopen::deref(dqDesc),
+                            DataCast(dq),
+                            miopen::deref(dkDesc),
+                            DataCast(dk),
+                            miopen::deref(dvDesc),
+                            DataCast(dv),
+                            DataCast(workSpace),
+                            workSpaceSize);
+    });
+}
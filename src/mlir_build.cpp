@@ -32,6 +32,10 @@
 #include <Miir.h>
 
 #include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace miopen {
@@ -62,6 +66,33 @@ void check_miir_error(MiirStatus status, const std::string& miir_fn_name)
     default: MIOPEN_THROW(miir_fn_name + " <UNKNOWN ERROR>");
     }
 }
+
+/// The tuning loops query the same MIIR options many times, from the search and from the
+/// threads building the candidates, and each query lowers a fresh MiirHandle. The results
+/// only depend on the options, so these are kept for the lifetime of the process.
+template <class T>
+class MiirQueryCache
+{
+    public:
+    template <class F>
+    T Get(const std::string& params, F&& query)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto found = values.find(params);
+            if(found != values.end())
+                return found->second;
+        }
+        // The handles are independent, so queries run in parallel outside the lock.
+        const auto value = query();
+        std::lock_guard<std::mutex> lock(mutex);
+        return values.emplace(params, value).first->second;
+    }
+
+    private:
+    std::mutex mutex;
+    std::unordered_map<std::string, T> values;
+};
 } // namespace
 /// Generates HIP source, header and options for HIP compiler.
 /// Writes HIP source and header into output directory.
@@ -141,17 +172,30 @@ boost::filesystem::path MiirBuildViaHip(boost::optional<TmpDir>& tmp_dir,
 
 void MiirGenLaunchParams(const std::string& params, size_t& local_size, size_t& global_size)
 {
-    AutoMiirHandle handle(params);
-    auto status = miirLowerTuningParams(handle());
-    check_miir_error(status, "miirLowerTuningParams");
-    miirGetExecutionDims(handle(), &global_size, &local_size);
-    check_miir_error(status, "miirGetExecutionDims");
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static MiirQueryCache<std::pair<size_t, size_t>> cache;
+    const auto dims = cache.Get(params, [&]() {
+        AutoMiirHandle handle(params);
+        auto status = miirLowerTuningParams(handle());
+        check_miir_error(status, "miirLowerTuningParams");
+        auto local  = size_t{0};
+        auto global = size_t{0};
+        miirGetExecutionDims(handle(), &global, &local);
+        check_miir_error(status, "miirGetExecutionDims");
+        return std::make_pair(local, global);
+    });
+    local_size  = dims.first;
+    global_size = dims.second;
 }
 
 bool MiirIsConfigApplicable(const std::string& params)
 {
-    AutoMiirHandle handle(params);
-    return MIIR_SUCCESS == miirLowerTuningParams(handle());
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static MiirQueryCache<bool> cache;
+    return cache.Get(params, [&]() {
+        AutoMiirHandle handle(params);
+        return MIIR_SUCCESS == miirLowerTuningParams(handle());
+    });
 }
 
 void MiirGenBin(const std::string& params, std::vector<char>& buffer)
@@ -169,11 +213,15 @@ void MiirGenBin(const std::string& params, std::vector<char>& buffer)
 
 int MiirGetKernelCount(const std::string& params)
 {
-    AutoMiirHandle handle(params);
-    const auto kernel_count = miirGetKernelCount(handle());
-    if(kernel_count < 1)
-        MIOPEN_THROW("miirGetKernelCount invalid count: " + std::to_string(kernel_count));
-    return kernel_count;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static MiirQueryCache<int> cache;
+    return cache.Get(params, [&]() {
+        AutoMiirHandle handle(params);
+        const auto kernel_count = miirGetKernelCount(handle());
+        if(kernel_count < 1)
+            MIOPEN_THROW("miirGetKernelCount invalid count: " + std::to_string(kernel_count));
+        return kernel_count;
+    });
 }
 
 } // namespace miopen
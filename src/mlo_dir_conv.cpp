@@ -156,7 +156,8 @@ static auto GetImplicitGemmSolvers()
         miopen::solver::ConvAsmImplicitGemmGTCDynamicBwdXdlops,
         miopen::solver::ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC,
         miopen::solver::ConvAsmImplicitGemmGTCDynamicBwdXdlopsNHWC,
-        miopen::solver::ConvCkIgemmFwdV6r1DlopsNchw>{};
+        miopen::solver::ConvCkIgemmFwdV6r1DlopsNchw,
+        miopen::solver::ConvCkIgemmFwdV4r4r4DlopsNhwc>{};
 }
 
 static auto GetWindogradSolvers()
@@ -174,7 +175,8 @@ static auto GetWindogradSolvers()
                                            miopen::solver::ConvMPBidirectWinograd_xdlops<3, 3>,
                                            miopen::solver::ConvMPBidirectWinograd_xdlops<4, 3>,
                                            miopen::solver::ConvMPBidirectWinograd_xdlops<5, 3>,
-                                           miopen::solver::ConvMPBidirectWinograd_xdlops<6, 3>>{};
+                                           miopen::solver::ConvMPBidirectWinograd_xdlops<6, 3>,
+                                           miopen::solver::ConvHipWinogradFusedXdlops>{};
 }
 
 static auto GetImplicitGemmWrWSolvers()
@@ -26,7 +26,9 @@
 
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
+#include <miopen/db_write_batch.hpp>
 #include <miopen/binary_cache.hpp>
+#include <miopen/compile_stats.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -34,6 +36,7 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/timer.hpp>
 #include <miopen/hipoc_program.hpp>
 
@@ -65,12 +68,29 @@ Handle::Handle() : impl(new HandleImpl())
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    FlushDbWrites();
+    CompileStats::Get().Dump();
+    Metrics::Dump();
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t /* streamID */) const {}
 
 miopenAcceleratorQueue_t Handle::GetStream() const { return {}; }
 
+void Handle::ReserveExtraStreamsInPool(int /* count */) const {}
+
+void Handle::SetStreamFromPool(int /* index */) const {}
+
+int Handle::GetStreamIndexFromPool() const { return 0; }
+
+int Handle::GetStreamPoolSize() const { return 1; }
+
+void Handle::WaitStreamInPool(int /* waiting */, int /* signaling */) const {}
+
+std::vector<Handle*> Handle::GetPeers() const { return {}; }
+
 void Handle::SetAllocator(miopenAllocatorFunction /* allocator */,
                           miopenDeallocatorFunction /* deallocator */,
                           void* /* allocatorContext */) const
@@ -79,9 +99,20 @@ void Handle::SetAllocator(miopenAllocatorFunction /* allocator */,
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
 
+void Handle::DeferKernelTimes(bool /* enable */) const {}
+
+bool Handle::IsKernelTimeDeferred() const { return false; }
+
+void Handle::FlushKernelTimes() const {}
+
 float Handle::GetKernelTime() const { return this->impl->profiling_result; }
 
-Allocator::ManageDataPtr Handle::Create(std::size_t sz) const { return this->impl->allocator(sz); }
+Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
+{
+    AddMetric(*this, Metric::Allocations);
+    AddMetric(*this, Metric::AllocatedBytes, sz);
+    return Allocator::Track(this->impl->allocator(sz), sz, memory_usage);
+}
 
 Allocator::ManageDataPtr&
 Handle::WriteTo(const void* /* data */, Allocator::ManageDataPtr& ddata, std::size_t /* sz */) const
@@ -97,6 +128,40 @@ void Handle::ReadTo(void* /* data */,
 
 void Handle::Copy(ConstData_t /* src */, Data_t /* dest */, std::size_t /* size */) const {}
 
+void Handle::WriteToAsync(const void* /* data */,
+                          Data_t /* ddata */,
+                          std::size_t /* sz */,
+                          std::size_t /* offset */) const
+{
+}
+
+void Handle::ReadToOrdered(void* /* data */, ConstData_t /* ddata */, std::size_t /* sz */) const
+{
+}
+
+void Handle::CopyAsync(ConstData_t /* src */, Data_t /* dest */, std::size_t /* size */) const {}
+
+void Handle::ZeroAsync(Data_t /* ddata */, std::size_t /* sz */) const {}
+
+void Handle::Copy2DAsync(ConstData_t /* src */,
+                         std::size_t /* src_offset */,
+                         std::size_t /* src_pitch */,
+                         Data_t /* dest */,
+                         std::size_t /* dest_offset */,
+                         std::size_t /* dest_pitch */,
+                         std::size_t /* width */,
+                         std::size_t /* height */) const
+{
+}
+
+void Handle::FillAsync(Data_t /* ddata */,
+                       std::size_t /* offset */,
+                       std::size_t /* sz */,
+                       const void* /* pattern */,
+                       std::size_t /* pattern_size */) const
+{
+}
+
 KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                const std::string& network_config,
                                const std::string& program_name,
@@ -148,8 +213,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -181,10 +246,14 @@ Program Handle::LoadProgram(const std::string& program_name,
     pgmImpl->target  = this->GetTargetProperties();
     auto p           = HIPOCProgram{};
     p.impl           = pgmImpl;
+    AddMetric(*this, hsaco.empty() ? Metric::BinaryCacheMisses : Metric::BinaryCacheHits);
     if(hsaco.empty())
     {
         // avoid the constructor since it implicitly calls the HIP API
+        CompileTimer ct;
         pgmImpl->BuildCodeObject(params, is_kernel_str, kernel_src);
+        CompileStats::Get().AddBuild(is_kernel_str ? "tinygemm.cl" : program_name, ct.ElapsedMs());
+        AddMetricTime(*this, Metric::Compiles, Metric::CompileUs, ct.ElapsedMs());
 // auto p = HIPOCProgram{
 //     program_name, params, is_kernel_str, this->GetTargetProperties(), kernel_src};
 
@@ -227,6 +296,20 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+void Handle::RemoveProgram(const std::string& program_name, const std::string& params) const
+{
+    this->impl->cache.RemoveProgram(program_name, params);
+}
+
+std::size_t Handle::GetCodeObjectsSize() const { return this->impl->cache.GetCodeObjectsSize(); }
+
+std::vector<std::pair<std::pair<std::string, std::string>, Program>> Handle::GetPrograms() const
+{
+    return this->impl->cache.GetPrograms();
+}
+
+const HipEventPool& Handle::GetEventPool() const { return this->impl->event_pool; }
+
 void Handle::Finish() const {}
 void Handle::Flush() const {}
 
@@ -241,6 +324,10 @@ std::size_t Handle::GetGlobalMemorySize() const { return this->impl->global_mem_
 
 std::size_t Handle::GetMaxComputeUnits() const { return this->impl->num_cu; }
 
+std::size_t Handle::GetMaxClockFrequency() const { return 0; }
+
+std::size_t Handle::GetCurrentClockFrequency() const { return 0; }
+
 std::size_t Handle::GetImage3dMaxWidth() const { return this->impl->img3d_max_width; }
 
 std::size_t Handle::GetWavefrontWidth() const { return this->impl->warp_size; }
@@ -282,7 +369,9 @@ shared<ConstData_t> Handle::CreateSubBuffer(ConstData_t data, std::size_t offset
 }
 
 #if MIOPEN_USE_ROCBLAS
-rocblas_handle_ptr Handle::CreateRocblasHandle() const
+const rocblas_handle_ptr& Handle::rhandle() const { return rhandle_; }
+
+rocblas_handle_ptr Handle::CreateRocblasHandle(miopenAcceleratorQueue_t /* stream */) const
 {
     rocblas_handle x = nullptr;
     rocblas_create_handle(&x);
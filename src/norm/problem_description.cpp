@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/norm/problem_description.hpp>
+#include <miopen/names.hpp>
+
+#include <functional>
+#include <numeric>
+#include <sstream>
+
+namespace miopen {
+
+namespace norm {
+
+static std::size_t LengthsProduct(const std::vector<std::size_t>& lens, std::size_t first)
+{
+    return std::accumulate(
+        lens.begin() + first, lens.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+}
+
+std::size_t ProblemDescription::GetRows() const
+{
+    const auto& lens = xDesc.GetLengths();
+    if(mode == Mode::Layer)
+        return LengthsProduct(lens, 0) / LengthsProduct(lens, mode_arg);
+    return lens[0] * mode_arg;
+}
+
+std::size_t ProblemDescription::GetRowLength() const
+{
+    const auto& lens = xDesc.GetLengths();
+    if(mode == Mode::Layer)
+        return LengthsProduct(lens, mode_arg);
+    return lens[1] / mode_arg * LengthsProduct(lens, 2);
+}
+
+std::size_t ProblemDescription::GetParamGroups() const
+{
+    return mode == Mode::Layer ? 1 : mode_arg;
+}
+
+std::size_t ProblemDescription::GetParamDiv() const
+{
+    return mode == Mode::Layer ? 1 : LengthsProduct(xDesc.GetLengths(), 2);
+}
+
+NetworkConfig ProblemDescription::MakeNetworkConfig() const
+{
+    std::ostringstream ss;
+
+    ss << (mode == Mode::Layer ? "layernorm-" : "groupnorm-");
+    ss << (direction == Direction::Forward ? "fwd-" : "bwd-");
+    ss << xDesc.GetType();
+    ss << "r" << GetRows();
+    ss << "k" << GetRowLength();
+    ss << "g" << GetParamGroups();
+    ss << "d" << GetParamDiv();
+    ss << "a" << static_cast<int>(affine);
+    ss << "res" << static_cast<int>(residual);
+    ss << "drop" << static_cast<int>(dropout);
+    if(direction == Direction::Forward)
+        ss << "s" << static_cast<int>(saveStats);
+    ss << "act" << activDesc.GetMode();
+
+    return NetworkConfig{ss.str()};
+}
+
+} // namespace norm
+
+} // namespace miopen
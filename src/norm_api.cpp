@@ -0,0 +1,371 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/activ.hpp>
+#include <miopen/dropout.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/norm.hpp>
+#include <miopen/tensor.hpp>
+
+// The weight descriptor and the activation are optional.
+static miopen::TensorDescriptor NormWeightDesc(const miopenTensorDescriptor_t weightDesc)
+{
+    return weightDesc != nullptr ? miopen::deref(weightDesc) : miopen::TensorDescriptor{};
+}
+
+static miopen::ActivationDescriptor NormActivDesc(const miopenActivationDescriptor_t activDesc)
+{
+    return activDesc != nullptr ? miopen::deref(activDesc)
+                                : miopen::ActivationDescriptor{miopenActivationPASTHRU, 1, 0, 1};
+}
+
+extern "C" miopenStatus_t miopenLayerNormForward(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const void* x,
+                                                 const void* residual,
+                                                 const miopenTensorDescriptor_t weightDesc,
+                                                 const void* weight,
+                                                 const void* bias,
+                                                 int normalizedDim,
+                                                 double epsilon,
+                                                 const miopenActivationDescriptor_t activDesc,
+                                                 const miopenTensorDescriptor_t yDesc,
+                                                 void* y,
+                                                 void* mean,
+                                                 void* rstd)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        xDesc,
+                        x,
+                        residual,
+                        weightDesc,
+                        weight,
+                        bias,
+                        normalizedDim,
+                        epsilon,
+                        activDesc,
+                        yDesc,
+                        y,
+                        mean,
+                        rstd);
+    return miopen::try_([&] {
+        miopen::NormForward(miopen::deref(handle),
+                            miopen::norm::Mode::Layer,
+                            normalizedDim,
+                            miopen::deref(xDesc),
+                            DataCast(x),
+                            DataCast(residual),
+                            NormWeightDesc(weightDesc),
+                            DataCast(weight),
+                            DataCast(bias),
+                            epsilon,
+                            NormActivDesc(activDesc),
+                            miopen::deref(yDesc),
+                            DataCast(y),
+                            DataCast(mean),
+                            DataCast(rstd));
+    });
+}
+
+extern "C" miopenStatus_t miopenLayerNormBackward(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t xDesc,
+                                                  const void* x,
+                                                  const void* residual,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const void* dy,
+                                                  const miopenTensorDescriptor_t weightDesc,
+                                                  const void* weight,
+                                                  const void* bias,
+                                                  int normalizedDim,
+                                                  const miopenActivationDescriptor_t activDesc,
+                                                  const void* mean,
+                                                  const void* rstd,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  void* dx,
+                                                  void* dweight,
+                                                  void* dbias)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        xDesc,
+                        x,
+                        residual,
+                        dyDesc,
+                        dy,
+                        weightDesc,
+                        weight,
+                        bias,
+                        normalizedDim,
+                        activDesc,
+                        mean,
+                        rstd,
+                        dxDesc,
+                        dx,
+                        dweight,
+                        dbias);
+    return miopen::try_([&] {
+        miopen::NormBackward(miopen::deref(handle),
+                             miopen::norm::Mode::Layer,
+                             normalizedDim,
+                             miopen::deref(xDesc),
+                             DataCast(x),
+                             DataCast(residual),
+                             miopen::deref(dyDesc),
+                             DataCast(dy),
+                             NormWeightDesc(weightDesc),
+                             DataCast(weight),
+                             DataCast(bias),
+                             NormActivDesc(activDesc),
+                             DataCast(mean),
+                             DataCast(rstd),
+                             miopen::deref(dxDesc),
+                             DataCast(dx),
+                             DataCast(dweight),
+                             DataCast(dbias));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenDropoutAddLayerNormForward(miopenHandle_t handle,
+                                 const miopenDropoutDescriptor_t dropoutDesc,
+                                 const miopenTensorDescriptor_t xDesc,
+                                 const void* x,
+                                 const void* residual,
+                                 const miopenTensorDescriptor_t weightDesc,
+                                 const void* weight,
+                                 const void* bias,
+                                 int normalizedDim,
+                                 double epsilon,
+                                 const miopenActivationDescriptor_t activDesc,
+                                 const miopenTensorDescriptor_t yDesc,
+                                 void* y,
+                                 void* mean,
+                                 void* rstd)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        dropoutDesc,
+                        xDesc,
+                        x,
+                        residual,
+                        weightDesc,
+                        weight,
+                        bias,
+                        normalizedDim,
+                        epsilon,
+                        activDesc,
+                        yDesc,
+                        y,
+                        mean,
+                        rstd);
+    return miopen::try_([&] {
+        miopen::NormForward(miopen::deref(handle),
+                            miopen::norm::Mode::Layer,
+                            normalizedDim,
+                            miopen::deref(xDesc),
+                            DataCast(x),
+                            DataCast(residual),
+                            NormWeightDesc(weightDesc),
+                            DataCast(weight),
+                            DataCast(bias),
+                            epsilon,
+                            NormActivDesc(activDesc),
+                            miopen::deref(yDesc),
+                            DataCast(y),
+                            DataCast(mean),
+                            DataCast(rstd),
+                            &miopen::deref(dropoutDesc));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenDropoutAddLayerNormBackward(miopenHandle_t handle,
+                                  const miopenDropoutDescriptor_t dropoutDesc,
+                                  const miopenTensorDescriptor_t xDesc,
+                                  const void* x,
+                                  const void* residual,
+                                  const miopenTensorDescriptor_t dyDesc,
+                                  const void* dy,
+                                  const miopenTensorDescriptor_t weightDesc,
+                                  const void* weight,
+                                  const void* bias,
+                                  int normalizedDim,
+                                  const miopenActivationDescriptor_t activDesc,
+                                  const void* mean,
+                                  const void* rstd,
+                                  const miopenTensorDescriptor_t dxDesc,
+                                  void* dx,
+                                  void* dresidual,
+                                  void* dweight,
+                                  void* dbias)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        dropoutDesc,
+                        xDesc,
+                        x,
+                        residual,
+                        dyDesc,
+                        dy,
+                        weightDesc,
+                        weight,
+                        bias,
+                        normalizedDim,
+                        activDesc,
+                        mean,
+                        rstd,
+                        dxDesc,
+                        dx,
+                        dresidual,
+                        dweight,
+                        dbias);
+    return miopen::try_([&] {
+        miopen::NormBackward(miopen::deref(handle),
+                             miopen::norm::Mode::Layer,
+                             normalizedDim,
+                             miopen::deref(xDesc),
+                             DataCast(x),
+                             DataCast(residual),
+                             miopen::deref(dyDesc),
+                             DataCast(dy),
+                             NormWeightDesc(weightDesc),
+                             DataCast(weight),
+                             DataCast(bias),
+                             NormActivDesc(activDesc),
+                             DataCast(mean),
+                             DataCast(rstd),
+                             miopen::deref(dxDesc),
+                             DataCast(dx),
+                             DataCast(dweight),
+                             DataCast(dbias),
+                             &miopen::deref(dropoutDesc),
+                             DataCast(dresidual));
+    });
+}
+
+extern "C" miopenStatus_t miopenGroupNormForward(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const void* x,
+                                                 const void* residual,
+                                                 const miopenTensorDescriptor_t weightDesc,
+                                                 const void* weight,
+                                                 const void* bias,
+                                                 int numGroups,
+                                                 double epsilon,
+                                                 const miopenActivationDescriptor_t activDesc,
+                                                 const miopenTensorDescriptor_t yDesc,
+                                                 void* y,
+                                                 void* mean,
+                                                 void* rstd)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        xDesc,
+                        x,
+                        residual,
+                        weightDesc,
+                        weight,
+                        bias,
+                        numGroups,
+                        epsilon,
+                        activDesc,
+                        yDesc,
+                        y,
+                        mean,
+                        rstd);
+    return miopen::try_([&] {
+        miopen::NormForward(miopen::deref(handle),
+                            miopen::norm::Mode::Group,
+                            numGroups,
+                            miopen::deref(xDesc),
+                            DataCast(x),
+                            DataCast(residual),
+                            NormWeightDesc(weightDesc),
+                            DataCast(weight),
+                            DataCast(bias),
+                            epsilon,
+                            NormActivDesc(activDesc),
+                            miopen::deref(yDesc),
+                            DataCast(y),
+                            DataCast(mean),
+                            DataCast(rstd));
+    });
+}
+
+extern "C" miopenStatus_t miopenGroupNormBackward(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t xDesc,
+                                                  const void* x,
+                                                  const void* residual,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const void* dy,
+                                                  const miopenTensorDescriptor_t weightDesc,
+                                                  const void* weight,
+                                                  const void* bias,
+                                                  int numGroups,
+                                                  const miopenActivationDescriptor_t activDesc,
+                                                  const void* mean,
+                                                  const void* rstd,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  void* dx,
+                                                  void* dweight,
+                                                  void* dbias)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        xDesc,
+                        x,
+                        residual,
+                        dyDesc,
+                        dy,
+                        weightDesc,
+                        weight,
+                        bias,
+                        numGroups,
+                        activDesc,
+                        mean,
+                        rstd,
+                        dxDesc,
+                        dx,
+                        dweight,
+                        dbias);
+    return miopen::try_([&] {
+        miopen::NormBackward(miopen::deref(handle),
+                             miopen::norm::Mode::Group,
+                             numGroups,
+                             miopen::deref(xDesc),
+                             DataCast(x),
+                             DataCast(residual),
+                             miopen::deref(dyDesc),
+                             DataCast(dy),
+                             NormWeightDesc(weightDesc),
+                             DataCast(weight),
+                             DataCast(bias),
+                             NormActivDesc(activDesc),
+                             DataCast(mean),
+                             DataCast(rstd),
+                             miopen::deref(dxDesc),
+                             DataCast(dx),
+                             DataCast(dweight),
+                             DataCast(dbias));
+    });
+}
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include <miopen/activ.hpp>
+#include <miopen/db.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/float_equal.hpp>
@@ -80,7 +81,8 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
     const auto ctx = ExecutionContext{&handle};
     const auto solvers =
         solver::SolverContainer<solver::activ::ActivFwdSolver0, solver::activ::ActivFwdSolver1>{};
-    const auto slns = solvers.SearchForSolutions(ctx, problem, 1);
+    auto db         = GetDb(ctx);
+    const auto slns = solvers.SearchForSolutions(ctx, problem, db, invoke_params, 1);
 
     if(slns.empty())
         MIOPEN_THROW(miopenStatusNotImplemented, "No solver found for activation forward.");
@@ -150,7 +152,8 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
 
     const auto ctx     = ExecutionContext{&handle};
     const auto solvers = solver::SolverContainer<solver::activ::ActivBwdSolver0>{};
-    const auto slns    = solvers.SearchForSolutions(ctx, problem, 1);
+    auto db            = GetDb(ctx);
+    const auto slns    = solvers.SearchForSolutions(ctx, problem, db, invoke_params, 1);
 
     if(slns.empty())
         MIOPEN_THROW(miopenStatusNotImplemented, "No solver found for activation forward.");
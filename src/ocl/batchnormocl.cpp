@@ -26,6 +26,7 @@
 #include <miopen/batch_norm.hpp>
 
 #include <miopen/check_numerics.hpp>
+#include <miopen/db.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/float_equal.hpp>
@@ -42,7 +43,10 @@
 #include <miopen/batchnorm/solvers.hpp>
 #include <miopen/find_solution.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <initializer_list>
+#include <limits>
 
 namespace miopen {
 
@@ -58,6 +62,68 @@ static auto GetContext(Handle& handle)
     return ctx;
 }
 
+static void BatchNormForwardInferenceNHWC(Handle& handle,
+                                          const TensorDescriptor& xDesc,
+                                          ConstData_t x,
+                                          Data_t y,
+                                          const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                          ConstData_t bnScale,
+                                          ConstData_t bnBias,
+                                          ConstData_t estimatedMean,
+                                          ConstData_t estimatedVariance,
+                                          double epsilon)
+{
+    const bool bfp16parm =
+        xDesc.GetType() == miopenHalf && bnScaleBiasMeanVarDesc.GetType() == miopenHalf;
+    const bool bfpmixparm =
+        xDesc.GetType() == miopenHalf && bnScaleBiasMeanVarDesc.GetType() == miopenFloat;
+    const bool bbfpmixparm = xDesc.GetType() == miopenBFloat16;
+    const bool bfp32parm   = !bfp16parm && !bfpmixparm && !bbfpmixparm;
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+
+    const std::size_t in_nhw = static_cast<std::size_t>(n) * h * w;
+
+    std::string algo_name      = "miopenBatchNormalizationForwardInference";
+    std::string network_config = "nhwcfp16" + std::to_string(static_cast<int>(bfp16parm)) +
+                                 "fp32" + std::to_string(static_cast<int>(bfp32parm)) + "bfmix" +
+                                 std::to_string(static_cast<int>(bbfpmixparm)) + "NHW" +
+                                 std::to_string(in_nhw) + "C" + std::to_string(c);
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(x, y, estimatedMean, estimatedVariance, bnScale, bnBias, epsilon);
+        return;
+    }
+
+    const auto geo = solver::batchnorm::BnNHWCGeometry{static_cast<std::size_t>(c), in_nhw};
+    // Every work-item normalizes a few rows, there are no reductions to split.
+    const auto ygroups = std::min<std::size_t>((in_nhw + geo.grp1 * 4 - 1) / (geo.grp1 * 4), 1024);
+
+    const std::vector<size_t> vld{geo.grp0, geo.grp1, 1};
+    const std::vector<size_t> vgd{geo.cgroups * geo.grp0, ygroups * geo.grp1, 1};
+
+    std::string parms = " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                        " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                        " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                        " -DMIOPEN_USE_BFPMIX=" + std::to_string(static_cast<int>(bbfpmixparm)) +
+                        " -DMIO_BN_C=" + std::to_string(c) +
+                        " -DMIO_BN_NHW=" + std::to_string(in_nhw) +
+                        " -DMIO_BN_VEC=" + std::to_string(geo.vec) +
+                        " -DMIO_BN_GRP0=" + std::to_string(geo.grp0) +
+                        " -DMIO_BN_GRP1=" + std::to_string(geo.grp1) + " -DMIO_BN_GRP2=1";
+
+    std::string program_name = "MIOpenBatchNormSpatialNHWC.cl";
+    std::string kernel_name  = "MIOpenBatchNormFwdInferSpatialNHWC";
+
+    MIOPEN_LOG_I2(kernel_name << ":: " << parms);
+
+    handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+        x, y, estimatedMean, estimatedVariance, bnScale, bnBias, epsilon);
+}
+
 void BatchNormForwardTraining(Handle& handle,
                               miopenBatchNormMode_t bn_mode,
                               const void* alpha,
@@ -103,6 +169,11 @@ void BatchNormForwardTraining(Handle& handle,
     {
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
+    if(xDesc.GetType() == miopenBFloat16 && !batchnorm::IsLayoutNHWC(xDesc))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "bfloat16 batch normalization training supports the NHWC layout only");
+    }
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsInput(handle, xDesc, x);
@@ -152,10 +223,13 @@ void BatchNormForwardTraining(Handle& handle,
     {
         const auto ctx = ExecutionContext{&handle};
         const auto solvers =
-            solver::SolverContainer<solver::batchnorm::BnFwdTrainingSpatialSingle,
+            solver::SolverContainer<solver::batchnorm::BnFwdTrainingSpatialNHWC,
+                                    solver::batchnorm::BnFwdTrainingSpatialSingle,
+                                    solver::batchnorm::BnFwdTrainingSpatialWelford,
                                     solver::batchnorm::BnFwdTrainingSpatialMultiple,
                                     solver::batchnorm::BnFwdTrainingPerActivation>{};
-        const auto slns = solvers.SearchForSolutions(ctx, problem, 1);
+        auto db         = GetDb(ctx);
+        const auto slns = solvers.SearchForSolutions(ctx, problem, db, invoke_params, 1);
 
         if(slns.empty())
             MIOPEN_THROW(miopenStatusNotImplemented, "No solver found for activation forward.");
@@ -230,6 +304,29 @@ void BatchNormForwardInference(Handle& handle,
             MIOPEN_LOG_E("Only alpha=1 and beta=0 is supported");
             MIOPEN_THROW(miopenStatusBadParm);
         }
+        if(batchnorm::IsLayoutNHWC(xDesc))
+        {
+            if(bn_mode != miopenBNSpatial || yDesc.GetStrides() != xDesc.GetStrides())
+            {
+                MIOPEN_THROW(miopenStatusNotImplemented,
+                             "Only spatial batch normalization supports the NHWC layout");
+            }
+            BatchNormForwardInferenceNHWC(handle,
+                                          xDesc,
+                                          x,
+                                          y,
+                                          bnScaleBiasMeanVarDesc,
+                                          bnScale,
+                                          bnBias,
+                                          estimatedMean,
+                                          estimatedVariance,
+                                          epsilon);
+            if(miopen::CheckNumericsEnabled())
+            {
+                miopen::checkNumericsOutput(handle, yDesc, y);
+            }
+            return;
+        }
 
         bool bfpmixparm = false;
         bool bfp16parm  = false;
@@ -244,16 +341,22 @@ void BatchNormForwardInference(Handle& handle,
             bfpmixparm = true;
             bfp32parm  = false;
         }
+        const bool bbfpmixparm = xDesc.GetType() == miopenBFloat16;
+        if(bbfpmixparm)
+            bfp32parm = false;
 
         int n, c, h, w;
         std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
 
         unsigned int in_nstride = c * h * w;
         unsigned int in_cstride = h * w;
+        // Both kernels walk the images of a channel, so the vector has to divide the image.
+        const unsigned int vec = (in_cstride % 4 == 0) ? 4 : (in_cstride % 2 == 0) ? 2 : 1;
 
         std::string algo_name      = "miopenBatchNormalizationForwardInference";
         std::string network_config = "fp16" + std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
-                                     std::to_string(static_cast<int>(bfp32parm)) + "mode" +
+                                     std::to_string(static_cast<int>(bfp32parm)) + "bfmix" +
+                                     std::to_string(static_cast<int>(bbfpmixparm)) + "mode" +
                                      std::to_string(bn_mode) + "HWdims" +
                                      std::to_string(in_cstride) + "C" + std::to_string(c);
 
@@ -277,7 +380,7 @@ void BatchNormForwardInference(Handle& handle,
             size_t xlocalsize = 1;
             auto xgridsize    = c;
             size_t ylocalsize = 256;
-            size_t ygridsize  = ylocalsize * ((in_cstride + ylocalsize - 1) / ylocalsize);
+            size_t ygridsize  = ylocalsize * ((in_cstride / vec + ylocalsize - 1) / ylocalsize);
             size_t zlocalsize = 1;
             size_t zgridsize  = 1;
 
@@ -298,6 +401,8 @@ void BatchNormForwardInference(Handle& handle,
                 " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
                 " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
                 " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                " -DMIOPEN_USE_BFPMIX=" + std::to_string(static_cast<int>(bbfpmixparm)) +
+                " -DMIO_BN_VEC=" + std::to_string(vec) +
                 " -DMIO_BN_GRP0=" + std::to_string(xlocalsize) +
                 " -DMIO_BN_GRP1=" + std::to_string(ylocalsize) +
                 " -DMIO_BN_GRP2=" + std::to_string(zlocalsize) +
@@ -418,6 +523,11 @@ void BatchNormBackward(Handle& handle,
         MIOPEN_LOG_E("Only alphaParamDiff=1 and betaParamDiff=0 is supported");
         MIOPEN_THROW(miopenStatusBadParm);
     }
+    if(xDesc.GetType() == miopenBFloat16 && !batchnorm::IsLayoutNHWC(xDesc))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "bfloat16 batch normalization backward supports the NHWC layout only");
+    }
 
     const auto useSaved = savedMean != nullptr && savedInvVariance != nullptr;
 
@@ -462,7 +572,8 @@ void BatchNormBackward(Handle& handle,
     {
         const auto ctx = ExecutionContext{&handle};
         const auto solvers =
-            solver::SolverContainer<solver::batchnorm::BnBwdTrainingSpatialSingle,
+            solver::SolverContainer<solver::batchnorm::BnBwdTrainingSpatialNHWC,
+                                    solver::batchnorm::BnBwdTrainingSpatialSingle,
                                     solver::batchnorm::BnBwdTrainingSpatialMultiple>{};
         const auto slns = solvers.SearchForSolutions(ctx, problem, 1);
 
@@ -491,6 +602,12 @@ void BatchNormBackward(Handle& handle,
         }
     }
 
+    if(batchnorm::IsLayoutNHWC(xDesc))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Only spatial batch normalization supports the NHWC layout");
+    }
+
     static const auto ctx = GetContext(handle);
 
     std::vector<size_t> vld;
@@ -638,4 +755,278 @@ void BatchNormBackward(Handle& handle,
         miopen::checkNumericsOutput(handle, bnScaleBiasDiffDesc, resultBnBiasDiff);
     }
 }
+
+//============ BEGIN SYNCHRONIZED STAGES =============
+static void CheckBatchNormSyncTensors(miopenBatchNormMode_t bn_mode,
+                                      const TensorDescriptor& xDesc,
+                                      std::initializer_list<const TensorDescriptor*> others)
+{
+    if(bn_mode != miopenBNSpatial)
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Only the spatial batch normalization can be split into stages.");
+    if(xDesc.GetSize() != 4)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    // H and W are addressed as one dimension.
+    const auto& lens    = xDesc.GetLengths();
+    const auto& strides = xDesc.GetStrides();
+    if(strides[2] != lens[3] * strides[3])
+        MIOPEN_THROW(miopenStatusBadParm, "The H and W dimensions have to be packed.");
+    if(xDesc.GetElementSpace() > std::numeric_limits<uint32_t>::max())
+        MIOPEN_THROW(miopenStatusNotImplemented);
+
+    for(const auto desc : others)
+    {
+        if(desc->GetLengths() != lens || desc->GetStrides() != strides ||
+           desc->GetType() != xDesc.GetType())
+            MIOPEN_THROW(miopenStatusBadParm, "The data tensors have to match x.");
+    }
+}
+
+/// Launches a kernel of MIOpenBatchNormSync.cl. The Stats kernels reduce a channel in a single
+/// work-group, the Apply ones spread it over several.
+template <class... Args>
+static void RunBatchNormSyncKernel(Handle& handle,
+                                   const std::string& kernel_name,
+                                   const TensorDescriptor& xDesc,
+                                   const TensorDescriptor& bnDesc,
+                                   bool apply,
+                                   const std::string& extra_parms,
+                                   Args&&... args)
+{
+    const bool bfp16parm  = xDesc.GetType() == miopenHalf && bnDesc.GetType() == miopenHalf;
+    const bool bfpmixparm = xDesc.GetType() == miopenHalf && bnDesc.GetType() == miopenFloat;
+    const bool bfp32parm  = !bfp16parm && !bfpmixparm;
+
+    const auto& lens      = xDesc.GetLengths();
+    const auto& strides   = xDesc.GetStrides();
+    const std::size_t hw  = lens[2] * lens[3];
+    const std::size_t nhw = lens[0] * hw;
+
+    const std::size_t grp0  = 256;
+    const std::size_t ngrps = apply ? std::min<std::size_t>((nhw + grp0 * 4 - 1) / (grp0 * 4), 64)
+                                    : 1;
+
+    std::string algo_name      = "miopenBatchNormalizationSync";
+    std::string network_config = kernel_name + "fp16" + std::to_string(int(bfp16parm)) + "fp32" +
+                                 std::to_string(int(bfp32parm)) + "c" + std::to_string(lens[1]) +
+                                 "nhw" + std::to_string(nhw) + "hw" + std::to_string(hw) + "s" +
+                                 std::to_string(strides[0]) + "x" + std::to_string(strides[1]) +
+                                 "x" + std::to_string(strides[3]) + extra_parms;
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(std::forward<Args>(args)...);
+        return;
+    }
+
+    const std::vector<size_t> vld{grp0, 1, 1};
+    const std::vector<size_t> vgd{grp0 * ngrps, lens[1], 1};
+
+    std::string parms = " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                        " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                        " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                        " -DMIO_BN_C=" + std::to_string(lens[1]) +
+                        " -DMIO_BN_HW=" + std::to_string(hw) +
+                        " -DMIO_BN_NHW=" + std::to_string(nhw) +
+                        " -DMIO_BN_NSTRIDE=" + std::to_string(strides[0]) +
+                        " -DMIO_BN_CSTRIDE=" + std::to_string(strides[1]) +
+                        " -DMIO_BN_HWSTRIDE=" + std::to_string(strides[3]) +
+                        " -DMIO_BN_NGRPS=" + std::to_string(ngrps) +
+                        " -DMIO_BN_LDS_SIZE=" + std::to_string(grp0) +
+                        " -DMIO_BN_LDSGCN_SIZE=" + std::to_string(grp0 / 64) +
+                        " -DMIO_BN_GRP0=" + std::to_string(grp0) +
+                        " -DMIO_BN_GRP1=1 -DMIO_BN_GRP2=1" +
+                        " -DMIO_BN_GFX1030=" + ((handle.GetDeviceName() == "gfx1030") ? "1" : "0") +
+                        extra_parms;
+
+    MIOPEN_LOG_I2(kernel_name << ":: " << parms);
+
+    handle.AddKernel(algo_name,
+                     network_config,
+                     "MIOpenBatchNormSync.cl",
+                     kernel_name,
+                     vld,
+                     vgd,
+                     parms)(std::forward<Args>(args)...);
+}
+
+void BatchNormForwardTrainingStats(Handle& handle,
+                                   miopenBatchNormMode_t bn_mode,
+                                   const TensorDescriptor& xDesc,
+                                   ConstData_t x,
+                                   const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                   Data_t localSum,
+                                   Data_t localSqSum)
+{
+    if(x == nullptr || localSum == nullptr || localSqSum == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+    CheckBatchNormSyncTensors(bn_mode, xDesc, {});
+    if(miopen::CheckNumericsEnabled())
+        miopen::checkNumericsInput(handle, xDesc, x);
+
+    RunBatchNormSyncKernel(handle,
+                           "MIOpenBatchNormSyncFwdStats",
+                           xDesc,
+                           bnScaleBiasMeanVarDesc,
+                           false,
+                           "",
+                           x,
+                           localSum,
+                           localSqSum);
+}
+
+void BatchNormForwardTrainingApply(Handle& handle,
+                                   miopenBatchNormMode_t bn_mode,
+                                   const void* alpha,
+                                   const void* beta,
+                                   const TensorDescriptor& xDesc,
+                                   ConstData_t x,
+                                   const TensorDescriptor& yDesc,
+                                   Data_t y,
+                                   const TensorDescriptor& bnScaleBiasMeanVarDesc,
+                                   ConstData_t bnScale,
+                                   ConstData_t bnBias,
+                                   ConstData_t globalSum,
+                                   ConstData_t globalSqSum,
+                                   std::size_t globalCount,
+                                   double expAvgFactor,
+                                   Data_t resultRunningMean,
+                                   Data_t resultRunningVariance,
+                                   double epsilon,
+                                   Data_t resultSaveMean,
+                                   Data_t resultSaveInvVariance)
+{
+    if(x == nullptr || y == nullptr || bnScale == nullptr || bnBias == nullptr ||
+       globalSum == nullptr || globalSqSum == nullptr || globalCount == 0)
+        MIOPEN_THROW(miopenStatusBadParm);
+    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
+       !float_equal(*(static_cast<const float*>(beta)), 0.0))
+        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
+    CheckBatchNormSyncTensors(bn_mode, xDesc, {&yDesc});
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        miopen::checkNumericsInput(handle, bnScaleBiasMeanVarDesc, bnScale);
+        miopen::checkNumericsInput(handle, bnScaleBiasMeanVarDesc, bnBias);
+    }
+
+    const auto resultsave    = resultSaveMean != nullptr && resultSaveInvVariance != nullptr;
+    const auto resultrunning = resultRunningMean != nullptr && resultRunningVariance != nullptr;
+
+    RunBatchNormSyncKernel(handle,
+                           "MIOpenBatchNormSyncFwdApply",
+                           xDesc,
+                           bnScaleBiasMeanVarDesc,
+                           true,
+                           " -DMIO_SAVE_MEAN_VARIANCE=" + std::to_string(int(resultsave)) +
+                               " -DMIO_RUNNING_RESULT=" + std::to_string(int(resultrunning)),
+                           x,
+                           y,
+                           bnScale,
+                           bnBias,
+                           globalSum,
+                           globalSqSum,
+                           static_cast<float>(1.0 / globalCount),
+                           expAvgFactor,
+                           resultRunningMean,
+                           resultRunningVariance,
+                           epsilon,
+                           resultSaveMean,
+                           resultSaveInvVariance);
+
+    if(miopen::CheckNumericsEnabled())
+        miopen::checkNumericsOutput(handle, yDesc, y);
+}
+
+void BatchNormBackwardStats(Handle& handle,
+                            miopenBatchNormMode_t bn_mode,
+                            const TensorDescriptor& xDesc,
+                            ConstData_t x,
+                            const TensorDescriptor& dyDesc,
+                            ConstData_t dy,
+                            const TensorDescriptor& bnScaleBiasDiffDesc,
+                            ConstData_t savedMean,
+                            ConstData_t savedInvVariance,
+                            Data_t localBiasDiff,
+                            Data_t localScaleDiff)
+{
+    if(x == nullptr || dy == nullptr || savedMean == nullptr || savedInvVariance == nullptr ||
+       localBiasDiff == nullptr || localScaleDiff == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+    CheckBatchNormSyncTensors(bn_mode, xDesc, {&dyDesc});
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        miopen::checkNumericsInput(handle, dyDesc, dy);
+    }
+
+    RunBatchNormSyncKernel(handle,
+                           "MIOpenBatchNormSyncBwdStats",
+                           xDesc,
+                           bnScaleBiasDiffDesc,
+                           false,
+                           "",
+                           x,
+                           dy,
+                           savedMean,
+                           savedInvVariance,
+                           localBiasDiff,
+                           localScaleDiff);
+}
+
+void BatchNormBackwardApply(Handle& handle,
+                            miopenBatchNormMode_t bn_mode,
+                            const void* alphaDataDiff,
+                            const void* betaDataDiff,
+                            const TensorDescriptor& xDesc,
+                            ConstData_t x,
+                            const TensorDescriptor& dyDesc,
+                            ConstData_t dy,
+                            const TensorDescriptor& dxDesc,
+                            Data_t dx,
+                            const TensorDescriptor& bnScaleBiasDiffDesc,
+                            ConstData_t bnScale,
+                            ConstData_t globalBiasDiff,
+                            ConstData_t globalScaleDiff,
+                            std::size_t globalCount,
+                            ConstData_t savedMean,
+                            ConstData_t savedInvVariance)
+{
+    if(x == nullptr || dy == nullptr || dx == nullptr || bnScale == nullptr ||
+       globalBiasDiff == nullptr || globalScaleDiff == nullptr || savedMean == nullptr ||
+       savedInvVariance == nullptr || globalCount == 0)
+        MIOPEN_THROW(miopenStatusBadParm);
+    if(!float_equal(*(static_cast<const float*>(alphaDataDiff)), 1.0) ||
+       !float_equal(*(static_cast<const float*>(betaDataDiff)), 0.0))
+        MIOPEN_THROW("Only alphaDataDiff=1 and betaDataDiff=0 is supported");
+    CheckBatchNormSyncTensors(bn_mode, xDesc, {&dyDesc, &dxDesc});
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        miopen::checkNumericsInput(handle, dyDesc, dy);
+        miopen::checkNumericsInput(handle, bnScaleBiasDiffDesc, bnScale);
+    }
+
+    RunBatchNormSyncKernel(handle,
+                           "MIOpenBatchNormSyncBwdApply",
+                           xDesc,
+                           bnScaleBiasDiffDesc,
+                           true,
+                           "",
+                           x,
+                           dy,
+                           dx,
+                           bnScale,
+                           savedMean,
+                           savedInvVariance,
+                           globalBiasDiff,
+                           globalScaleDiff,
+                           static_cast<float>(1.0 / globalCount));
+
+    if(miopen::CheckNumericsEnabled())
+        miopen::checkNumericsOutput(handle, dxDesc, dx);
+}
+//============= END SYNCHRONIZED STAGES ==============
 } // namespace miopen
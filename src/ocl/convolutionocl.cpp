@@ -33,26 +33,41 @@
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/find_db.hpp>
+#include <miopen/find_solution.hpp>
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/find_timing.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/invoker.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/online_tuning.hpp>
+#include <miopen/reducetensor.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/solver/conv_cost_model.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
+#include <miopen/timer.hpp>
 #include <miopen/util.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/any_solver.hpp>
+#include <miopen/conv/batch_split.hpp>
 #include <miopen/conv/tensors.hpp>
 #include <miopen/conv/compiled_in_parameters.hpp>
+#include <miopen/conv/fallback_model.hpp>
+#include <miopen/conv/problem_canonicalization.hpp>
+#include <miopen/conv/problem_fingerprint.hpp>
 #include <miopen/conv/data_invoke_params.hpp>
 #include <miopen/conv/wrw_invoke_params.hpp>
 
 #include <cassert>
+#include <map>
+#include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
+#include <boost/optional.hpp>
 #include <boost/range/adaptors.hpp>
 
 namespace miopen {
@@ -64,13 +79,85 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_ARCH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_BWD_BIAS_REDUCE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_MODEL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMMED_CANONICAL_LOOKUP)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_COMPILE_ONLY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_IMMED_ASYNC_COMPILE)
 
 size_t GetKernelGlobalWorkDim(const KernelInvoke& kernel, int dim) { return kernel.gdims[dim]; }
 
 size_t GetKernelLocalWorkDim(const KernelInvoke& kernel, int dim) { return kernel.ldims[dim]; }
 
+/// Returns string forms of the problem, formatting them only when the
+/// fingerprint is seen for the first time on this handle.
+static const conv::ProblemKeys& GetProblemKeys(Handle& handle,
+                                               const conv::ProblemFingerprint& fingerprint,
+                                               const ProblemDescription& problem)
+{
+    if(const auto keys = handle.GetProblemKeys(fingerprint))
+        return *keys;
+
+    auto keys           = conv::ProblemKeys{};
+    keys.network_config = problem.BuildConfKey();
+    {
+        std::ostringstream ss;
+        problem.Serialize(ss);
+        keys.db_key = ss.str();
+    }
+    return handle.RegisterProblemKeys(fingerprint, std::move(keys));
+}
+
+/// Tensors are taken in the order of conv::ProblemDescription (in, weights, out),
+/// where "in" of the backward directions is dy.
+static conv::ProblemFingerprint MakeFingerprint(const ProblemDescription& problem)
+{
+    const auto& conv_problem = problem.conv_problem;
+    return {conv_problem.GetIn(),
+            conv_problem.GetWeights(),
+            conv_problem.GetOut(),
+            conv_problem.GetConv(),
+            conv_problem.GetDirection(),
+            conv_problem.GetBias()};
+}
+
+/// The context of the problem on this handle, prepared for the solvers. It is built on the first
+/// call for the fingerprint and shared by the later ones, see conv::ContextCache.
+template <class TContextFactory>
+static std::shared_ptr<const ConvolutionContext>
+GetImmediateContext(Handle& handle,
+                    const conv::ProblemFingerprint& fingerprint,
+                    const TContextFactory& make_ctx,
+                    bool disable_search_enforce = false)
+{
+    auto& cache = handle.GetContextCache();
+    auto cached = cache.Find(fingerprint, disable_search_enforce);
+    if(cached != nullptr && &cached->GetStream() == &handle)
+        return cached;
+
+    auto ctx = std::make_shared<ConvolutionContext>(make_ctx());
+    ctx->SetStream(&handle);
+    ctx->disable_search_enforce = disable_search_enforce;
+    ctx->DetectRocm();
+    ctx->SetupFloats();
+    if(cached != nullptr) // The handle has been moved.
+        return ctx;
+    return cache.Register(fingerprint, std::move(ctx));
+}
+
+static std::shared_ptr<const ConvolutionContext>
+GetImmediateContext(Handle& handle,
+                    const ProblemDescription& problem,
+                    bool disable_search_enforce = false)
+{
+    return GetImmediateContext(
+        handle,
+        MakeFingerprint(problem),
+        [&]() { return ConvolutionContext{problem}; },
+        disable_search_enforce);
+}
+
 static inline void AddKernels(const Handle& handle,
                               const std::string& algorithm_name,
                               const std::string& network_config,
@@ -275,9 +362,28 @@ static void EvaluateInvokers(Handle& handle,
     {
         return;
     }
+    struct Measured
+    {
+        const solver::ConvSolution* solution;
+        FindTiming timing;
+        Invoker invoker;
+    };
+
+    struct Candidate
+    {
+        const solver::ConvSolution* solution;
+        Invoker invoker;
+        std::vector<float> samples      = {};
+        std::vector<float> norm_samples = {};
+        bool failed                     = false;
+    };
+
     miopen::solver::ConvSolution selected{miopenStatusUnknownError};
-    float best = std::numeric_limits<float>::max();
+    FindTiming best;
     Invoker best_invoker;
+    const auto& timing = GetFindTimingConfig();
+    auto measured_all  = std::vector<Measured>{};
+    auto candidates    = std::vector<Candidate>{};
 
     for(const auto& sol : solutions)
     {
@@ -302,37 +408,136 @@ static void EvaluateInvokers(Handle& handle,
         if(!sol.invoker_factory)
             MIOPEN_THROW("Invoker is not provided by solver " + sol.solver_id);
 
-        const auto invoker = handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params);
+        candidates.push_back(
+            {&sol, handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params)});
+    }
+
+    const auto max_clock = timing.stabilize ? handle.GetMaxClockFrequency() : 0;
+
+    // Runs the candidate once and returns the time, a failed one is skipped from then on.
+    const auto run = [&](Candidate& candidate, bool is_sample) {
+        if(candidate.failed)
+            return 0.0f;
         try
         {
-            invoker(handle, invoke_ctx);
-            const auto elapsed = handle.GetKernelTime();
-
-            MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ") << best);
-            if(elapsed < best)
+            candidate.invoker(handle, invoke_ctx);
+            const auto time = handle.GetKernelTime();
+            if(is_sample)
             {
-                best         = elapsed;
-                selected     = sol;
-                best_invoker = invoker;
+                candidate.samples.push_back(time);
+                const auto clock = max_clock != 0 ? handle.GetCurrentClockFrequency() : 0;
+                if(clock != 0)
+                    candidate.norm_samples.push_back(NormalizeFindTime(time, clock, max_clock));
             }
+            return time;
         }
         catch(const miopen::Exception& ex)
         {
             MIOPEN_LOG_E(ex.what());
+            candidate.failed = true;
+            return 0.0f;
+        }
+    };
+
+    if(timing.stabilize && !candidates.empty())
+    {
+        WarmUpUntilSettled([&]() { return run(candidates.front(), false); }, timing);
+        for(auto& candidate : candidates)
+            for(auto i = 0; i < timing.warmups; ++i)
+                run(candidate, false);
+
+        // A/B/A/B rather than A/A/B/B, every other round backwards, so that a drift of the
+        // clocks during the measurement affects all the candidates alike.
+        for(auto i = 0; i < timing.trials; ++i)
+        {
+            if(i % 2 == 0)
+                for(auto& candidate : candidates)
+                    run(candidate, true);
+            else
+                for(auto it = candidates.rbegin(); it != candidates.rend(); ++it)
+                    run(*it, true);
         }
     }
+    else
+    {
+        for(auto& candidate : candidates)
+        {
+            for(auto i = 0; i < timing.warmups; ++i)
+                run(candidate, false);
+            for(auto i = 0; i < timing.trials; ++i)
+                run(candidate, true);
+        }
+    }
+
+    for(auto& candidate : candidates)
+    {
+        if(candidate.failed)
+            continue;
+
+        const auto& sol = *candidate.solution;
+        auto measured   = SummarizeFindTiming(candidate.samples, timing.stat);
+        if(candidate.norm_samples.size() == candidate.samples.size())
+            measured.norm_time = SummarizeFindTiming(candidate.norm_samples, timing.stat).time;
+
+        // Within the noise, the solution which needs less workspace is preferred.
+        const auto cmp =
+            selected.Succeeded() ? CompareFindTiming(measured, best, timing.margin) : -1;
+        const auto is_better = cmp < 0 || (cmp == 0 && sol.workspce_sz < selected.workspce_sz);
+
+        MIOPEN_LOG_I(sol << ": " << measured.time << " (spread " << measured.spread
+                         << ", normalized " << measured.norm_time << ")"
+                         << (is_better ? " < " : " >= ") << best.time);
+        measured_all.push_back({&sol, measured, candidate.invoker});
+        if(is_better)
+        {
+            best         = measured;
+            selected     = sol;
+            best_invoker = candidate.invoker;
+        }
+    }
+
+    if(!selected.Succeeded())
+        return;
 
-    if(selected.Succeeded())
+    // The rest of the Pareto front by time and workspace, for the queries with smaller
+    // workspace limits. The invokers are registered before the selected one, which shall be
+    // the last to be set as found for the algorithm.
+    std::sort(measured_all.begin(), measured_all.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.timing.time < rhs.timing.time;
+    });
+    auto front_workspace = std::numeric_limits<std::size_t>::max();
+    for(const auto& entry : measured_all)
     {
-        handle.RegisterInvoker(best_invoker, network_config, selected.solver_id, algorithm_name);
-        MIOPEN_LOG_I("Selected: " << selected << ": " << best
-                                  << ", workspce_sz = " << selected.workspce_sz);
-        record.SetValues(algorithm_name,
-                         FindDbData{selected.solver_id,
-                                    best,
-                                    selected.workspce_sz,
-                                    FindDbKCacheKey::MakeUnused(algorithm_name)});
+        const auto& sol = *entry.solution;
+        if(sol.workspce_sz >= front_workspace)
+            continue;
+        front_workspace = sol.workspce_sz;
+        if(sol.solver_id == selected.solver_id || sol.workspce_sz >= selected.workspce_sz)
+            continue;
+
+        handle.RegisterInvoker(entry.invoker, network_config, sol.solver_id, algorithm_name);
+        auto data   = FindDbData{sol.solver_id,
+                                 entry.timing.time,
+                                 sol.workspce_sz,
+                                 FindDbKCacheKey::MakeUnused(algorithm_name)};
+        data.trials    = entry.timing.trials;
+        data.spread    = entry.timing.spread;
+        data.norm_time = entry.timing.norm_time;
+        record.SetValues(MakeFindDbParetoId(algorithm_name, sol.solver_id), data);
+        MIOPEN_LOG_I2("Pareto-optimal: " << sol << ": " << entry.timing.time);
     }
+
+    handle.RegisterInvoker(best_invoker, network_config, selected.solver_id, algorithm_name);
+    MIOPEN_LOG_I("Selected: " << selected << ": " << best.time
+                              << ", workspce_sz = " << selected.workspce_sz);
+    auto data   = FindDbData{selected.solver_id,
+                           best.time,
+                           selected.workspce_sz,
+                           FindDbKCacheKey::MakeUnused(algorithm_name)};
+    data.trials    = best.trials;
+    data.spread    = best.spread;
+    data.norm_time = best.norm_time;
+    record.SetValues(algorithm_name, data);
 }
 
 static inline void AppendPointersToElements(const std::vector<miopen::solver::ConvSolution>& from,
@@ -433,6 +638,133 @@ static void DirConvFindCore(Handle& handle,
                      record);
 }
 
+/// Budgeted find mode: the dynamic solvers are measured in the order of the immediate mode
+/// heuristic until the budget of the call is spent. Returns false if nothing has been found,
+/// so that the caller may run the regular find instead.
+template <class InvokeParams>
+static bool BudgetedFindCore(Handle& handle,
+                             const ConvolutionDescriptor& conv,
+                             ConvolutionContext ctx,
+                             conv::Direction dir,
+                             const InvokeParams& invoke_ctx,
+                             DbRecord& record)
+{
+    struct Measured
+    {
+        solver::Id solver_id;
+        float time;
+        std::size_t workspace;
+        Invoker invoker;
+    };
+
+    AutoEnableProfiling enableProfiling{handle};
+    const auto budget = GetFindBudgetMs();
+    Timer timer;
+    timer.start();
+
+    const auto max_count = solver::GetSolversByPrimitive(solver::Primitive::Convolution).size();
+    auto candidates      = std::vector<miopenConvSolution_t>(max_count);
+    auto count           = std::size_t{0};
+    conv.GetSolutionsFallback(handle, ctx, max_count, &count, candidates.data());
+    candidates.resize(count);
+
+    // Tuning does not fit into the budget, the solvers use their default configs.
+    ctx.do_search = false;
+    ctx.SetStream(&handle);
+    ctx.DetectRocm();
+    ctx.SetupFloats();
+    auto db = GetDb(ctx);
+
+    // One entry per algorithm, as the regular find stores.
+    auto best     = std::map<std::string, Measured>{};
+    auto measured = std::size_t{0};
+
+    for(const auto& candidate : candidates)
+    {
+        if(!best.empty() && timer.elapsed_ms() >= budget)
+            break;
+        ++measured;
+
+        if(candidate.workspace_size > 0 &&
+           (invoke_ctx.workSpace == nullptr || invoke_ctx.workSpaceSize < candidate.workspace_size))
+            continue;
+
+        const auto solver_id = solver::Id{candidate.solution_id};
+        try
+        {
+            const auto solution = solver_id.GetSolver().FindSolution(ctx, db, {});
+            if(!solution.Succeeded() || !solution.invoker_factory)
+                continue;
+            const auto invoker =
+                handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
+            invoker(handle, invoke_ctx);
+            const auto elapsed = handle.GetKernelTime();
+            MIOPEN_LOG_I(solver_id.ToString() << ": " << elapsed);
+
+            const auto algorithm = solver_id.GetAlgo(dir);
+            const auto found     = best.find(algorithm);
+            if(found == best.end() || elapsed < found->second.time)
+                best[algorithm] = {solver_id, elapsed, solution.workspce_sz, invoker};
+        }
+        catch(const miopen::Exception& ex)
+        {
+            MIOPEN_LOG_E(ex.what());
+        }
+    }
+
+    const auto provisional = measured < candidates.size();
+    if(provisional)
+        MIOPEN_LOG_I("Find budget of " << budget << " ms is spent, "
+                                       << candidates.size() - measured
+                                       << " solutions are not measured");
+
+    const auto network_config = ctx.BuildConfKey();
+    for(const auto& pair : best)
+    {
+        const auto& entry = pair.second;
+        handle.RegisterInvoker(
+            entry.invoker, network_config, entry.solver_id.ToString(), AlgorithmName{pair.first});
+        record.SetValues(pair.first,
+                         FindDbData{entry.solver_id.ToString(),
+                                    entry.time,
+                                    entry.workspace,
+                                    FindDbKCacheKey::MakeUnused(pair.first),
+                                    provisional});
+    }
+    return !best.empty();
+}
+
+/// Leaves the fastest entry of each algorithm among the ones which fit into the workspace limit.
+/// The results of the problem of one chunk of a BatchSplit are reported for the whole problem.
+template <class Result>
+static void ScaleTimes(Result* results, std::size_t count, std::size_t chunks)
+{
+    for(std::size_t i = 0; i < count; ++i)
+        results[i].time *= static_cast<float>(chunks);
+}
+
+static void SelectWithinWorkspaceLimit(std::vector<PerfField>& perf_db, std::size_t limit)
+{
+    std::sort(begin(perf_db), end(perf_db));
+
+    auto selected = std::vector<PerfField>{};
+    for(auto& entry : perf_db)
+    {
+        if(entry.workspace > limit)
+            continue;
+        const auto same_algo = [&](const PerfField& other) { return other.name == entry.name; };
+        if(std::any_of(selected.begin(), selected.end(), same_algo))
+            continue;
+        selected.push_back(std::move(entry));
+    }
+
+    if(selected.empty() && !perf_db.empty())
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "No solution fits into the workspace limit of " + std::to_string(limit) +
+                         " bytes");
+    perf_db = std::move(selected);
+}
+
 void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                                  const TensorDescriptor& xDesc,
                                                  ConstData_t x,
@@ -457,7 +789,28 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
     if(requestAlgoCount < 1)
         MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
 
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+    {
+        FindConvFwdAlgorithm(handle,
+                             split.GetInChunk(),
+                             x,
+                             wDesc,
+                             w,
+                             split.GetOutChunk(),
+                             y,
+                             requestAlgoCount,
+                             returnedAlgoCount,
+                             perfResults,
+                             workSpace,
+                             workSpaceSize,
+                             exhaustiveSearch);
+        ScaleTimes(perfResults, *returnedAlgoCount, split.GetChunks());
+        return;
+    }
+
     *returnedAlgoCount = 0;
+    // Solutions which need more workspace than the limit are not evaluated.
+    workSpaceSize = std::min(workSpaceSize, workspace_limit);
 
     const ProblemDescription problem(xDesc, wDesc, yDesc, *this, conv::Direction::Forward);
     auto ctx = ConvolutionContext{problem};
@@ -494,7 +847,16 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
         ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
             findMode.IsFastHybrid(ctx);
         ctx.use_dynamic_solutions_only = findMode.IsDynamicHybrid(ctx);
-        perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
+        const auto budgeted = findMode.IsBudgeted(ctx);
+        const auto regenerate = [&](DbRecord& record) {
+            if(budgeted)
+            {
+                const auto invoke_ctx = conv::DataInvokeParams{
+                    InvokeType::Evaluate, {xDesc, x, wDesc, w, yDesc, y}, workSpace, workSpaceSize};
+                if(BudgetedFindCore(
+                       handle, *this, ctx, conv::Direction::Forward, invoke_ctx, record))
+                    return;
+            }
             DirConvFindCore(handle,
                             xDesc,
                             x,
@@ -509,7 +871,8 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                             record,
                             ctx,
                             IsWinograd3x3SupportedAndFast(ctx));
-        });
+        };
+        perf_db = UserFindDbRecord::TryLoad(handle, problem, regenerate, budgeted);
     }
 
     if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
@@ -520,7 +883,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
     if(perf_db.empty())
         MIOPEN_THROW("Forward Convolution cannot be executed due to incorrect params");
 
-    std::sort(begin(perf_db), end(perf_db));
+    SelectWithinWorkspaceLimit(perf_db, workspace_limit);
 
     for(const auto& entry : perf_db)
         MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace);
@@ -534,43 +897,127 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
         perfResults[i].memory   = perf_db[i].workspace;
     }
 
+    handle.GetMemoryUsage().AddSelectedWorkspace(perf_db[0].workspace);
     MIOPEN_LOG_I("FW Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                          << ", " << perf_db[0].time);
 }
 
-void ValidateConvTensors(const ConvTensors& tensors)
+static void ValidateConvDescriptors(const TensorDescriptor& xDesc,
+                                    const TensorDescriptor& wDesc,
+                                    const TensorDescriptor& yDesc)
 {
-    const auto invalid_buffers =
-        tensors.x == nullptr || tensors.w == nullptr || tensors.y == nullptr;
-
-    const auto tensor_sizes_not_matched = tensors.xDesc.GetSize() != tensors.yDesc.GetSize() ||
-                                          tensors.xDesc.GetSize() != tensors.wDesc.GetSize();
+    const auto tensor_sizes_not_matched =
+        xDesc.GetSize() != yDesc.GetSize() || xDesc.GetSize() != wDesc.GetSize();
 
     const auto tensor_types_not_matched =
-        (tensors.xDesc.GetType() != tensors.yDesc.GetType() &&
-         tensors.xDesc.GetType() != miopenInt8 && tensors.xDesc.GetType() != miopenInt8x4) ||
-        tensors.xDesc.GetType() != tensors.wDesc.GetType();
+        (xDesc.GetType() != yDesc.GetType() && xDesc.GetType() != miopenInt8 &&
+         xDesc.GetType() != miopenInt8x4) ||
+        xDesc.GetType() != wDesc.GetType();
 
     // if(xDesc.GetLengths()[1] != wDesc.GetLengths()[1]) {
     //    MIOPEN_THROW(miopenStatusBadParm);
     //}
 
-    const auto x_tensor_invalid = tensors.xDesc.GetSize() < 3;
+    const auto x_tensor_invalid = xDesc.GetSize() < 3;
 
     const auto bad_parameters =
-        invalid_buffers || tensor_sizes_not_matched || tensor_types_not_matched || x_tensor_invalid;
+        tensor_sizes_not_matched || tensor_types_not_matched || x_tensor_invalid;
 
     if(bad_parameters)
         MIOPEN_THROW(miopenStatusBadParm);
 }
 
-void ValidateAlphaBeta(const void* alpha, const void* beta)
+void ValidateConvTensors(const ConvTensors& tensors)
 {
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
+    const auto invalid_buffers =
+        tensors.x == nullptr || tensors.w == nullptr || tensors.y == nullptr;
+
+    if(invalid_buffers)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    ValidateConvDescriptors(tensors.xDesc, tensors.wDesc, tensors.yDesc);
+}
+
+static float GetScalingFactor(const void* factor)
+{
+    if(factor == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "alpha and beta cannot be nullptr");
+    return *static_cast<const float*>(factor);
+}
+
+static Data_t& GetOutput(conv::DataInvokeParams& params) { return params.tensors.out; }
+static Data_t& GetOutput(conv::WrWInvokeParams& params) { return params.tensors.dw; }
+static const TensorDescriptor& GetOutputDesc(const conv::DataInvokeParams& params)
+{
+    return params.tensors.outDesc;
+}
+static const TensorDescriptor& GetOutputDesc(const conv::WrWInvokeParams& params)
+{
+    return params.tensors.dwDesc;
+}
+
+/// Runs the invoker so that the output becomes alpha * conv + beta * output. The invokers of the
+/// solvers for which SupportsAlphaBeta() holds do it in their epilogue. For the rest the output
+/// is scaled in place when beta is 0, otherwise the convolution is written to a temporary buffer
+/// which is then blended into the output by a single OpTensor pass.
+template <class InvokeParams, class TContextFactory>
+static void InvokeBlended(const Handle& handle,
+                          const Invoker& invoker,
+                          InvokeParams params,
+                          const NetworkConfig& network_config,
+                          const AlgorithmName& algorithm_name,
+                          const TContextFactory& get_ctx)
+{
+    // AnyInvokeParams copies from const lvalues only. The reference also sees the changes below.
+    const auto& invoke_params = params;
+
+    if(float_equal(params.alpha, 1.0f) && float_equal(params.beta, 0.0f))
+    {
+        invoker(handle, invoke_params);
+        return;
+    }
+
+    const auto solver_id = handle.GetFoundSolverId(network_config, algorithm_name);
+    if(solver_id && solver_id->GetSolver().SupportsAlphaBeta(get_ctx()))
     {
-        MIOPEN_THROW(miopenStatusNotImplemented, "Only alpha=1 and beta=0 is supported");
+        MIOPEN_LOG_I2(solver_id->ToString() << " blends alpha = " << params.alpha
+                                            << ", beta = " << params.beta);
+        invoker(handle, invoke_params);
+        return;
+    }
+
+    const auto alpha = params.alpha;
+    const auto beta  = params.beta;
+    params.alpha     = 1.0f;
+    params.beta      = 0.0f;
+
+    auto& out           = GetOutput(params);
+    const auto& outDesc = GetOutputDesc(params);
+
+    if(float_equal(beta, 0.0f))
+    {
+        invoker(handle, invoke_params);
+        ScaleTensor(handle, outDesc, out, &alpha);
+        return;
     }
+
+    const auto result_buffer = handle.Create(outDesc.GetNumBytes());
+    const auto dst           = out;
+    out                      = result_buffer.get();
+    invoker(handle, invoke_params);
+
+    const float zero = 0.0f;
+    OpTensor(handle,
+             miopenTensorOpAdd,
+             &alpha,
+             outDesc,
+             result_buffer.get(),
+             &beta,
+             outDesc,
+             dst,
+             &zero,
+             outDesc,
+             dst);
 }
 
 static void ConvForwardCheckNumerics(const Handle& handle,
@@ -607,7 +1054,6 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
     MIOPEN_LOG_I("algo = " << algo << ", workspace = " << workSpaceSize);
     const auto tensors = ConvFwdTensors{xDesc, x, wDesc, w, yDesc, y};
     ValidateConvTensors(tensors);
-    ValidateAlphaBeta(alpha, beta);
 
     if(algo != miopenConvolutionFwdAlgoGEMM &&
        (xDesc.GetType() == miopenInt8 || xDesc.GetType() == miopenInt8x4))
@@ -615,34 +1061,101 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+    {
+        for(std::size_t i = 0; i < split.GetChunks(); ++i)
+            ConvolutionForward(handle,
+                               alpha,
+                               split.GetInChunk(),
+                               split.In(x, i),
+                               wDesc,
+                               w,
+                               algo,
+                               beta,
+                               split.GetOutChunk(),
+                               split.Out(y, i),
+                               workSpace,
+                               workSpaceSize);
+        return;
+    }
+
     ConvForwardCheckNumerics(handle, tensors, [&]() {
         ValidateGroupCount(xDesc, wDesc, *this);
 
         const auto algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
             static_cast<miopenConvAlgorithm_t>(algo), conv::Direction::Forward)};
 
-        auto ctx =
-            ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward}; // forward
-        ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto fingerprint =
+            conv::ProblemFingerprint{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+        auto keys = handle.GetProblemKeys(fingerprint);
+        if(!keys)
+        {
+            auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+            ctx.SetStream(&handle);
+            keys = GetProblemKeys(handle, fingerprint, ctx);
+        }
+        const auto& invoker = handle.GetInvoker(keys->network_config, {}, algorithm_name);
 
         if(invoker)
         {
-            const auto& invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
-            (*invoker)(handle, invoke_ctx);
+            auto invoke_ctx  = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
+            invoke_ctx.alpha = GetScalingFactor(alpha);
+            invoke_ctx.beta  = GetScalingFactor(beta);
+            const auto get_ctx = [&]() {
+                auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+                ctx.SetStream(&handle);
+                ctx.DetectRocm();
+                return ctx;
+            };
+            InvokeBlended(
+                handle, *invoker, invoke_ctx, keys->network_config, algorithm_name, get_ctx);
             return;
         }
 
         MIOPEN_THROW("No invoker was registered for convolution forward. Was find executed?");
     });
 }
+namespace {
+
+struct FindDbLookup
+{
+    std::unique_ptr<FindDbRecord> record;
+    /// Set when the record is the one of a canonical neighbor of the problem.
+    boost::optional<conv::ProblemDescription> neighbor;
+};
+
+} // namespace
+
+/// The find-db record of the problem. When there is none, the record of the most similar of its
+/// canonical neighbors which has been tuned, see conv::GetCanonicalNeighbors().
+static FindDbLookup LoadFindDbRecord(Handle& handle, const ProblemDescription& problem)
+{
+    const auto& keys = GetProblemKeys(handle, MakeFingerprint(problem), problem);
+    auto lookup      = FindDbLookup{std::make_unique<FindDbRecord>(handle, keys.db_key), {}};
+    if(!lookup.record->empty() || miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_CANONICAL_LOOKUP{}))
+        return lookup;
+
+    for(const auto& neighbor : conv::GetCanonicalNeighbors(problem.conv_problem))
+    {
+        std::ostringstream key;
+        ProblemDescription{neighbor}.Serialize(key);
+        auto record = std::make_unique<FindDbRecord>(handle, key.str());
+        if(record->empty())
+            continue;
+        MIOPEN_LOG_I("Using the find-db record of " << key.str() << " for " << keys.db_key);
+        lookup.record   = std::move(record);
+        lookup.neighbor = neighbor;
+        break;
+    }
+    return lookup;
+}
+
 static std::size_t GetSolutionCount(Handle& handle, const ProblemDescription& problem)
 {
-    const FindDbRecord fdb_record{handle, problem};
-    if(fdb_record.empty())
+    const auto lookup = LoadFindDbRecord(handle, problem);
+    if(lookup.record->empty())
         return 0;
-    return std::distance(fdb_record.begin(), fdb_record.end());
+    return std::distance(lookup.record->begin(), lookup.record->end());
 }
 
 static const char immFallbackFailed[] =
@@ -678,6 +1191,8 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionCount(Handle& handle,
                                                            const TensorDescriptor& yDesc) const
 {
     MIOPEN_LOG_I("");
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+        return GetForwardSolutionCount(handle, wDesc, split.GetInChunk(), split.GetOutChunk());
     const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
     const auto n       = GetSolutionCount(handle, problem);
     if(n > 0)
@@ -704,6 +1219,109 @@ static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
     } // clang-format on
 }
 
+/// Solvers of the registry which are enabled, not empty and applicable to the problem, in the
+/// order of the registry. They are only checked on the first query of the problem on the handle.
+/// The context shall have the default search flags, which some solvers are sensitive to.
+static const std::vector<uint64_t>&
+GetApplicableSolvers(Handle& handle,
+                     const conv::ProblemFingerprint& fingerprint,
+                     const ConvolutionContext& ctx)
+{
+    auto& cache = handle.GetApplicabilityCache();
+    if(const auto applicable = cache.FindAll(fingerprint))
+        return *applicable;
+
+    const auto solvers = solver::GetSolversByPrimitive(solver::Primitive::Convolution);
+    auto checked       = std::vector<std::pair<uint64_t, bool>>(solvers.size());
+    solver::ParForSolvers(solvers.size(), [&](auto i) {
+        const auto& s         = solvers[i].GetSolver();
+        const auto applicable =
+            !IsAlgorithmDisabled(solvers[i].GetAlgo()) && !s.IsEmpty() && s.IsApplicable(ctx);
+        checked[i] = {solvers[i].Value(), applicable};
+    });
+    return cache.RegisterAll(fingerprint, checked);
+}
+
+/// In the deterministic mode of the handle, only the solvers producing bitwise reproducible
+/// results may be selected. The applicability cache does not depend on the mode, so the solvers
+/// are checked on their way out of it.
+static bool IsAllowedByMode(const Handle& handle,
+                            const solver::Id& solver_id,
+                            const ConvolutionContext& ctx)
+{
+    return !handle.IsDeterministic() || solver_id.GetSolver().IsDeterministic(ctx);
+}
+
+/// Same as IsApplicable() of the solver, memoized on the handle. The context is only made when
+/// the solver has not been checked for the problem yet.
+template <class TContextFactory>
+static bool IsApplicableCached(Handle& handle,
+                               const conv::ProblemFingerprint& fingerprint,
+                               solver::Id solver_id,
+                               const TContextFactory& get_ctx)
+{
+    auto& cache = handle.GetApplicabilityCache();
+    if(const auto applicable = cache.Find(fingerprint, solver_id.Value()))
+        return *applicable;
+
+    const auto applicable = solver_id.GetSolver().IsApplicable(get_ctx());
+    cache.Register(fingerprint, solver_id.Value(), applicable);
+    return applicable;
+}
+
+std::vector<miopen::solver::ConvSolution>
+ConvolutionDescriptor::GetFindCandidates(Handle& handle, const ProblemDescription& problem) const
+{
+    auto ctx = ConvolutionContext{problem};
+    ctx.SetStream(&handle);
+    ctx.DetectRocm();
+    ctx.SetupFloats();
+    ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
+        findMode.IsFastHybrid(ctx);
+    ctx.use_dynamic_solutions_only = findMode.IsDynamicHybrid(ctx);
+    auto db = GetDb(ctx);
+
+    const auto solvers = solver::GetSolversByPrimitive(solver::Primitive::Convolution);
+    auto solutions     = std::vector<boost::optional<miopen::solver::ConvSolution>>(solvers.size());
+    const auto solve   = [&](std::size_t i) {
+        const auto& solver_id = solvers[i];
+        if(IsAlgorithmDisabled(solver_id.GetAlgo()))
+            return;
+        const auto& s = solver_id.GetSolver();
+        if(s.IsEmpty() || !s.IsApplicable(ctx) || !IsAllowedByMode(handle, solver_id, ctx))
+            return;
+        try
+        {
+            auto solution = s.FindSolution(ctx, db, {});
+            if(solution.Succeeded())
+                solutions[i] = std::move(solution);
+        }
+        catch(const miopen::Exception& ex)
+        {
+            MIOPEN_LOG_W(solver_id.ToString() << ": " << ex.what());
+        }
+    };
+
+    // The searches measure the kernels on the GPU, so they are run one at a time.
+    if(FindEnforce{}.IsSomethingEnforced(ctx))
+    {
+        for(auto i = std::size_t{0}; i < solvers.size(); ++i)
+            solve(i);
+    }
+    else
+    {
+        solver::ParForSolvers(solvers.size(), solve);
+    }
+
+    auto candidates = std::vector<miopen::solver::ConvSolution>{};
+    for(auto& solution : solutions)
+    {
+        if(solution)
+            candidates.push_back(std::move(*solution));
+    }
+    return candidates;
+}
+
 // Helper class used for emplace and sort.
 struct SolutionSortWrapper : miopenConvSolution_t
 {
@@ -730,6 +1348,32 @@ struct SolutionSortWrapper : miopenConvSolution_t
     }
 };
 
+/// Moves the solutions of the solvers predicted by the fallback model ahead of the others, in the
+/// predicted order. The order of the rest is kept.
+static void ApplyFallbackModel(const Handle& handle,
+                               const ProblemDescription& problem,
+                               std::vector<SolutionSortWrapper>& solutions)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMMED_FALLBACK_MODEL{}))
+        return;
+    const auto model = conv::GetFallbackModel(handle);
+    if(!model)
+        return;
+
+    const auto predicted = model->Predict(conv::GetFallbackFeatures(problem.conv_problem));
+    if(predicted.empty())
+        return;
+    MIOPEN_LOG_I2("Fallback model predicts " << predicted.front().ToString());
+
+    const auto rank = [&](const SolutionSortWrapper& solution) {
+        return std::find(predicted.begin(), predicted.end(), solver::Id{solution.solution_id}) -
+               predicted.begin();
+    };
+    std::stable_sort(solutions.begin(),
+                     solutions.end(),
+                     [&](const auto& left, const auto& right) { return rank(left) < rank(right); });
+}
+
 void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
                                                  const ProblemDescription& problem,
                                                  const size_t maxSolutionCount,
@@ -755,9 +1399,8 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
     std::vector<SolutionSortWrapper> interim;
     interim.reserve(maxSolutionCount); // For speed. In most cases we have less entries than asked.
 
-    auto ctx = ConvolutionContext{problem};
-    ctx.SetStream(&handle);
-    ctx.DetectRocm();
+    const auto shared_ctx = GetImmediateContext(handle, problem);
+    const auto& ctx       = *shared_ctx;
 
     const auto wti2time = [](const float& wti) {
         assert(wti != 0.0f);
@@ -766,27 +1409,29 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
         return 10.0f / wti; // Assume WTI == 1.0 (100%) is 10 ms.
     };
 
-    for(const auto& solver_id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+    // Disabled algos and empty solvers are filtered out there as well.
+    for(const auto id : GetApplicableSolvers(handle, MakeFingerprint(problem), ctx))
     {
         // solver_id is always valid here, because taken from registry.
         // Validity check is not required.
-        const auto algo = solver_id.GetAlgo();
-        if(IsAlgorithmDisabled(algo)) // Algos can be disabled globally.
-            continue;
-        const auto& s = solver_id.GetSolver();
-        if(s.IsEmpty())
+        const auto solver_id = solver::Id{id};
+        if(!IsAllowedByMode(handle, solver_id, ctx))
             continue;
+        const auto algo = solver_id.GetAlgo();
+        const auto& s   = solver_id.GetSolver();
         if(!s.IsDynamic()) // Let's allow non-dynamic later, if necessary.
             continue;
-        if(!s.IsApplicable(ctx))
-            continue;
 
         const auto wti = s.GetWti(ctx);
         MIOPEN_LOG_I2(solver_id.ToString() << " Estimated WTI = " << wti);
         if(wti < 0.0f) // Skip unknown WTIs.
             continue;
 
-        interim.emplace_back(wti2time(wti), s.GetWorkspaceSize(ctx), solver_id.Value(), algo);
+        const auto workspace_size = s.GetWorkspaceSize(ctx);
+        if(workspace_size > workspace_limit)
+            continue;
+
+        interim.emplace_back(wti2time(wti), workspace_size, solver_id.Value(), algo);
     }
 
     MIOPEN_LOG_I2("maxSolutionCount = " << maxSolutionCount << ", available = " << interim.size());
@@ -799,6 +1444,7 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
     // * Counts the number of entries written, yielding value for solutionsCount.
     auto i = std::size_t{0};
     std::sort(begin(interim), end(interim));
+    ApplyFallbackModel(handle, problem, interim);
     for(const auto& entry : interim)
     {
         if(i >= maxSolutionCount)
@@ -810,6 +1456,57 @@ void ConvolutionDescriptor::GetSolutionsFallback(Handle& handle,
     *solutionCount = i;
 }
 
+void ConvolutionDescriptor::GetSolutionsPredicted(Handle& handle,
+                                                  const ProblemDescription& problem,
+                                                  const size_t maxSolutionCount,
+                                                  size_t* const solutionCount,
+                                                  miopenConvSolution_t* const solutions) const
+{
+    if(solutionCount == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "solutionCount cannot be nullptr");
+    if(solutions == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
+
+    const auto& conv_problem = problem.conv_problem;
+    const auto& inDesc =
+        problem.direction.IsForward() ? conv_problem.GetIn() : conv_problem.GetOut();
+    ValidateGroupCount(inDesc, conv_problem.GetWeights(), *this);
+
+    const auto shared_ctx = GetImmediateContext(handle, problem);
+    const auto& ctx       = *shared_ctx;
+
+    const auto throughput = solver::GetDeviceThroughput(handle.GetDeviceName(),
+                                                        handle.GetMaxHardwareComputeUnits(),
+                                                        conv_problem.GetInDataType());
+
+    std::vector<SolutionSortWrapper> interim;
+    for(const auto id : GetApplicableSolvers(handle, MakeFingerprint(problem), ctx))
+    {
+        const auto solver_id = solver::Id{id};
+        if(!IsAllowedByMode(handle, solver_id, ctx))
+            continue;
+        const auto algo = solver_id.GetAlgo();
+        const auto& s   = solver_id.GetSolver();
+
+        const auto workspace_size = s.GetWorkspaceSize(ctx);
+        if(workspace_size > workspace_limit)
+            continue;
+
+        const auto wti        = s.GetWti(ctx);
+        const auto efficiency = solver::GetDefaultEfficiency(algo) * (wti > 0.0f ? wti : 1.0f);
+        const auto time       = solver::EstimateConvTime(
+            solver::GetConvWork(conv_problem, workspace_size), throughput, efficiency);
+        MIOPEN_LOG_I2(solver_id.ToString() << " WTI = " << wti << ", predicted " << time
+                                           << " ms, ws: " << workspace_size);
+        interim.emplace_back(time, workspace_size, solver_id.Value(), algo);
+    }
+
+    std::sort(begin(interim), end(interim));
+    const auto count = std::min(maxSolutionCount, interim.size());
+    std::copy(interim.begin(), interim.begin() + count, solutions);
+    *solutionCount = count;
+}
+
 void GetSolutions(Handle& handle,
                   const ProblemDescription& problem,
                   const size_t maxSolutionCount,
@@ -817,7 +1514,8 @@ void GetSolutions(Handle& handle,
                   miopenConvSolution_t* solutions,
                   std::function<int(const std::string&)>&& algoResolver)
 {
-    const FindDbRecord fdb_record{handle, problem};
+    const auto lookup      = LoadFindDbRecord(handle, problem);
+    const auto& fdb_record = *lookup.record;
 
     if(fdb_record.empty())
     {
@@ -825,6 +1523,13 @@ void GetSolutions(Handle& handle,
         return;
     }
 
+    // The times of the neighbors are scaled by the batch size. Their workspace sizes and
+    // applicability may differ from the ones of the problem, and are taken from the solvers.
+    const auto time_scale =
+        lookup.neighbor ? static_cast<float>(problem.conv_problem.GetInBatchSize()) /
+                              static_cast<float>(lookup.neighbor->GetInBatchSize())
+                        : 1.0f;
+
     std::vector<SolutionSortWrapper> interim;
     interim.reserve(maxSolutionCount); // For speed. In most cases we have less entries than asked.
 
@@ -832,14 +1537,20 @@ void GetSolutions(Handle& handle,
     // Applicability is also affected by presence of external tools (e.g. assembler)
     // ROCm version, specific features of GPU (like xnack) etc.
     // All the above can be found by calling IsApplicable().
-    // We need fully initialized context for this, see below.
-    auto ctx = ConvolutionContext{problem};
-    ctx.SetStream(&handle);
-    ctx.DetectRocm();
+    // We need fully initialized context for this, which is only made if some of the
+    // solvers have not been checked for the problem on this handle yet.
+    const auto fingerprint = MakeFingerprint(problem);
+    std::shared_ptr<const ConvolutionContext> ctx;
+    const auto get_ctx = [&]() -> const ConvolutionContext& {
+        if(ctx == nullptr)
+            ctx = GetImmediateContext(handle, problem);
+        return *ctx;
+    };
 
     for(const auto& pair : fdb_record)
     {
-        const auto algo = static_cast<miopenConvAlgorithm_t>(algoResolver(pair.first));
+        const auto algo =
+            static_cast<miopenConvAlgorithm_t>(algoResolver(GetFindDbAlgorithm(pair.first)));
         if(IsAlgorithmDisabled(algo))
             continue;
 
@@ -852,9 +1563,26 @@ void GetSolutions(Handle& handle,
             MIOPEN_LOG_I("[Warning] incorrect solver_id: " << pair.second.solver_id);
             continue;
         }
+        // The context is only needed for the check in the deterministic mode.
+        if(handle.IsDeterministic() && !IsAllowedByMode(handle, solver_id, get_ctx()))
+            continue;
+
+        if(!lookup.neighbor)
+        {
+            if(pair.second.workspace > problem.conv_problem.GetConv().workspace_limit)
+                continue;
+            if(IsApplicableCached(handle, fingerprint, solver_id, get_ctx))
+                interim.emplace_back(
+                    pair.second.time, pair.second.workspace, solver_id.Value(), algo);
+            continue;
+        }
 
-        if(solver_id.GetSolver().IsApplicable(ctx))
-            interim.emplace_back(pair.second.time, pair.second.workspace, solver_id.Value(), algo);
+        if(!IsApplicableCached(handle, fingerprint, solver_id, get_ctx))
+            continue;
+        const auto workspace = solver_id.GetSolver().GetWorkspaceSize(get_ctx());
+        if(workspace > problem.conv_problem.GetConv().workspace_limit)
+            continue;
+        interim.emplace_back(pair.second.time * time_scale, workspace, solver_id.Value(), algo);
     }
     std::sort(begin(interim), end(interim));
 
@@ -888,6 +1616,20 @@ void ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
     if(solutions == nullptr)
         MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
 
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+    {
+        GetForwardSolutions(handle,
+                            wDesc,
+                            split.GetInChunk(),
+                            split.GetOutChunk(),
+                            maxSolutionCount,
+                            solutionCount,
+                            solutions,
+                            fallbackPathTaken);
+        ScaleTimes(solutions, *solutionCount, split.GetChunks());
+        return;
+    }
+
     auto problem = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
     problem.SetStream(&handle);
 
@@ -898,7 +1640,34 @@ void ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
         *fallbackPathTaken = (*solutionCount == 0);
     if(*solutionCount == 0)
         GetSolutionsFallback(handle, problem, maxSolutionCount, solutionCount, solutions);
+    if(*solutionCount > 0)
+        handle.GetMemoryUsage().AddSelectedWorkspace(solutions[0].workspace_size);
+}
+void ConvolutionDescriptor::GetForwardSolutionsPredicted(Handle& handle,
+                                                         const TensorDescriptor& wDesc,
+                                                         const TensorDescriptor& xDesc,
+                                                         const TensorDescriptor& yDesc,
+                                                         const size_t maxSolutionCount,
+                                                         size_t* const solutionCount,
+                                                         miopenConvSolution_t* solutions) const
+{
+    MIOPEN_LOG_I("");
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+    {
+        GetForwardSolutionsPredicted(handle,
+                                     wDesc,
+                                     split.GetInChunk(),
+                                     split.GetOutChunk(),
+                                     maxSolutionCount,
+                                     solutionCount,
+                                     solutions);
+        ScaleTimes(solutions, *solutionCount, split.GetChunks());
+        return;
+    }
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+    GetSolutionsPredicted(handle, problem, maxSolutionCount, solutionCount, solutions);
 }
+
 std::size_t ConvolutionDescriptor::GetForwardSolutionWorkspaceSize(Handle& handle,
                                                                    const TensorDescriptor& wDesc,
                                                                    const TensorDescriptor& xDesc,
@@ -908,12 +1677,14 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionWorkspaceSize(Handle& handl
     MIOPEN_LOG_I("solver_id = " << solver_id.ToString());
     if(!solver_id.IsValid())
         MIOPEN_THROW(miopenStatusBadParm, "invalid solution id = " + solver_id.ToString());
-    auto sol = solver_id.GetSolver();
-    auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
-    ctx.SetStream(&handle);
-    ctx.DetectRocm();
-    if(sol.IsApplicable(ctx))
-        return sol.GetWorkspaceSize(ctx);
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+        return GetForwardSolutionWorkspaceSize(
+            handle, wDesc, split.GetInChunk(), split.GetOutChunk(), solver_id);
+    auto sol           = solver_id.GetSolver();
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+    const auto ctx     = GetImmediateContext(handle, problem);
+    if(sol.IsApplicable(*ctx))
+        return sol.GetWorkspaceSize(*ctx);
     MIOPEN_THROW(miopenStatusBadParm,
                  "The supplied solution id: " + solver_id.ToString() +
                      " is not applicable to the current problem");
@@ -921,13 +1692,10 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionWorkspaceSize(Handle& handl
 
 // Todo: remove when all immediate mode calls will support invokers
 static std::vector<KernelInvoke> CompileSolver(const Handle& handle,
-                                               ConvolutionContext& ctx,
+                                               const ConvolutionContext& ctx,
                                                solver::Id solver_id,
                                                const FindDbKCacheKey& key)
 {
-    ctx.DetectRocm();
-    ctx.SetupFloats();
-
     const auto solver   = solver_id.GetSolver();
     auto db             = GetDb(ctx);
     const auto solution = solver.FindSolution(ctx, db, {}); // auto tune is not expected here
@@ -937,18 +1705,53 @@ static std::vector<KernelInvoke> CompileSolver(const Handle& handle,
     return kernels;
 }
 
+static solver::Id GetAsyncCompileFallback(conv::Direction dir)
+{
+    switch(dir)
+    {
+    case conv::Direction::Forward:
+        return solver::Id{solver::SolverDbId(solver::ConvDirectNaiveConvFwd{})};
+    case conv::Direction::BackwardData:
+        return solver::Id{solver::SolverDbId(solver::ConvDirectNaiveConvBwd{})};
+    case conv::Direction::BackwardWeights:
+        return solver::Id{solver::SolverDbId(solver::ConvDirectNaiveConvWrw{})};
+    }
+    MIOPEN_THROW(miopenStatusInternalError);
+}
+
+/// \p ctx is prepared by GetImmediateContext().
 static Invoker PrepareInvoker(Handle& handle,
-                              ConvolutionContext& ctx,
+                              const ConvolutionContext& ctx,
                               const NetworkConfig& config,
                               solver::Id solver_id,
                               conv::Direction dir)
 {
-    ctx.DetectRocm();
-    ctx.SetupFloats();
-
     const auto solver = solver_id.GetSolver();
     auto db           = GetDb(ctx);
     auto solution     = solver.FindSolution(ctx, db, {}); // auto tune is not expected here
+
+    if(miopen::IsEnabled(MIOPEN_IMMED_ASYNC_COMPILE{}))
+    {
+        // Kernels are built in background, the naive solver runs until they are ready.
+        const auto pending = solver::PrecompileKernelsAsync(
+            handle, solution.construction_params, solver_id.ToString());
+        if(!pending.empty())
+        {
+            const auto fallback = GetAsyncCompileFallback(dir);
+            if(fallback != solver_id && fallback.GetSolver().IsApplicable(ctx))
+            {
+                MIOPEN_LOG_I(solver_id.ToString() << " is being compiled, using "
+                                                  << fallback.ToString());
+                const auto fallback_invoker = handle.GetInvoker(config, fallback);
+                if(fallback_invoker)
+                    return *fallback_invoker;
+                return PrepareInvoker(handle, ctx, config, fallback, dir);
+            }
+            for(const auto& program : pending)
+                program.wait();
+        }
+    }
+
     const auto invoker =
         handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
 
@@ -958,37 +1761,199 @@ static Invoker PrepareInvoker(Handle& handle,
 }
 
 static Invoker LoadOrPrepareInvoker(Handle& handle,
-                                    ConvolutionContext& ctx,
+                                    const ConvolutionContext& ctx,
                                     solver::Id solver_id,
                                     conv::Direction dir)
 {
-    const auto config = ctx.BuildConfKey();
-    auto invoker      = handle.GetInvoker(config, solver_id);
+    const auto& config = GetProblemKeys(handle, MakeFingerprint(ctx), ctx).network_config;
+    auto invoker       = handle.GetInvoker(config, solver_id);
     if(invoker)
         return *invoker;
     return PrepareInvoker(handle, ctx, config, solver_id, dir);
 }
 
+/// Immediate mode fast path: the context is only constructed when the
+/// invoker for the fingerprint is not available yet.
+template <class TContextFactory>
+static Invoker LoadOrPrepareInvoker(Handle& handle,
+                                    const conv::ProblemFingerprint& fingerprint,
+                                    solver::Id solver_id,
+                                    conv::Direction dir,
+                                    const TContextFactory& make_ctx)
+{
+    if(const auto keys = handle.GetProblemKeys(fingerprint))
+    {
+        const auto invoker = handle.GetInvoker(keys->network_config, solver_id);
+        if(invoker)
+            return *invoker;
+    }
+
+    const auto ctx     = GetImmediateContext(handle, fingerprint, make_ctx);
+    const auto& config = GetProblemKeys(handle, fingerprint, *ctx).network_config;
+    return PrepareInvoker(handle, *ctx, config, solver_id, dir);
+}
+
 static bool CheckInvokerSupport(const solver::Id solver_id, conv::Direction dir)
 {
     const auto& algo = solver_id.GetAlgo(dir);
     return CheckInvokerSupport(algo);
 }
 
-static void CompileSolution(Handle& handle,
-                            const solver::Id solver_id,
-                            ConvolutionContext& ctx,
-                            conv::Direction dir)
+static OnlineTuner& GetOnlineTuner()
+{
+    static OnlineTuner tuner{GetOnlineTuningConfig()};
+    return tuner;
+}
+
+static std::vector<OnlineTuner::Candidate>
+GetOnlineTuningCandidates(Handle& handle, const ConvolutionContext& ctx, conv::Direction dir)
+{
+    auto candidates = std::vector<OnlineTuner::Candidate>{};
+    for(const auto id : GetApplicableSolvers(handle, MakeFingerprint(ctx), ctx))
+    {
+        const auto solver_id = solver::Id{id};
+        if(!CheckInvokerSupport(solver_id, dir) || !IsAllowedByMode(handle, solver_id, ctx))
+            continue;
+        candidates.push_back({solver_id.ToString(), solver_id.GetSolver().GetWorkspaceSize(ctx)});
+    }
+    return candidates;
+}
+
+/// Returns the invoker of the solution to explore, or none while its kernels are being built
+/// in background, so that the production call is not delayed by the compilation.
+static boost::optional<Invoker> GetExploredInvoker(Handle& handle,
+                                                   const ConvolutionContext& ctx,
+                                                   const NetworkConfig& config,
+                                                   solver::Id solver_id,
+                                                   conv::Direction dir)
+{
+    const auto invoker = handle.GetInvoker(config, solver_id);
+    if(invoker)
+        return *invoker;
+
+    auto db             = GetDb(ctx);
+    const auto solution = solver_id.GetSolver().FindSolution(ctx, db, {});
+    if(!solution.Succeeded() ||
+       !solver::PrecompileKernelsAsync(handle, solution.construction_params, solver_id.ToString())
+            .empty())
+        return boost::none;
+    return PrepareInvoker(handle, ctx, config, solver_id, dir);
+}
+
+/// Writes the solution which has been consistently faster in production than the one requested
+/// to the user find-db. The time of the latter is replaced by the production one too, so that the
+/// two are comparable.
+static void StoreOnlineTuningWinner(Handle& handle,
+                                    const ConvolutionContext& ctx,
+                                    conv::Direction dir,
+                                    const std::string& incumbent,
+                                    const OnlineTuner::Promotion& winner,
+                                    std::size_t workspace)
+{
+    const auto& problem = static_cast<const ProblemDescription&>(ctx);
+    UserFindDbRecord::Update(handle, problem, [&](DbRecord& record) {
+        auto updates = std::vector<std::pair<std::string, FindDbData>>{};
+        for(const auto& pair : record.As<FindDbData>())
+        {
+            if(pair.second.solver_id != incumbent)
+                continue;
+            auto data   = pair.second;
+            data.time   = winner.incumbent_time.time;
+            data.trials    = winner.incumbent_time.trials;
+            data.spread    = winner.incumbent_time.spread;
+            data.norm_time = winner.incumbent_time.norm_time;
+            updates.emplace_back(pair.first, data);
+        }
+
+        const auto algorithm = solver::Id{winner.solver}.GetAlgo(dir);
+        auto data            = FindDbData{winner.solver,
+                                             winner.time.time,
+                                             workspace,
+                                             FindDbKCacheKey::MakeUnused(algorithm)};
+        data.trials          = winner.time.trials;
+        data.spread          = winner.time.spread;
+        data.norm_time       = winner.time.norm_time;
+        updates.emplace_back(algorithm, data);
+
+        for(const auto& update : updates)
+            record.SetValues(update.first, update.second);
+    });
+}
+
+/// Runs an immediate mode call. With profiling and MIOPEN_ONLINE_TUNING enabled, the time of the
+/// call is sampled and now and then another solution is run instead, see OnlineTuner.
+template <class TContextFactory, class InvokeParams>
+static void RunImmediate(Handle& handle,
+                         const conv::ProblemFingerprint& fingerprint,
+                         solver::Id solver_id,
+                         conv::Direction dir,
+                         const TContextFactory& make_ctx,
+                         const InvokeParams& invoke_ctx)
+{
+    auto invoker = LoadOrPrepareInvoker(handle, fingerprint, solver_id, dir, make_ctx);
+    if(!handle.IsProfilingEnabled() || !IsOnlineTuningEnabled())
+    {
+        invoker(handle, invoke_ctx);
+        return;
+    }
+
+    auto& tuner          = GetOnlineTuner();
+    const auto& config   = handle.GetProblemKeys(fingerprint)->network_config;
+    const auto problem   = config.ToString();
+    const auto requested = solver_id.ToString();
+    const auto get_ctx   = [&]() { return GetImmediateContext(handle, fingerprint, make_ctx); };
+
+    if(!tuner.HasCandidates(problem))
+        tuner.SetCandidates(problem, GetOnlineTuningCandidates(handle, *get_ctx(), dir));
+
+    auto run_id = solver_id;
+    if(const auto next = tuner.Next(problem, requested, invoke_ctx.workSpaceSize))
+    {
+        const auto explored =
+            GetExploredInvoker(handle, *get_ctx(), config, solver::Id{*next}, dir);
+        if(explored)
+        {
+            invoker = *explored;
+            run_id  = solver::Id{*next};
+        }
+    }
+
+    invoker(handle, invoke_ctx);
+    tuner.Record(problem, run_id.ToString(), handle.GetKernelTime());
+
+    if(const auto winner = tuner.TakeWinner(problem, requested))
+    {
+        const auto ctx = get_ctx();
+        const auto id  = solver::Id{winner->solver};
+        StoreOnlineTuningWinner(
+            handle, *ctx, dir, requested, *winner, id.GetSolver().GetWorkspaceSize(*ctx));
+    }
+}
+
+static std::vector<std::shared_future<Program>> CompileSolution(Handle& handle,
+                                                                const solver::Id solver_id,
+                                                                const ConvolutionContext& ctx,
+                                                                conv::Direction dir,
+                                                                bool async)
 {
     if(!solver_id.IsValid())
         MIOPEN_THROW(miopenStatusBadParm, "solver_id = " + solver_id.ToString());
 
     if(CheckInvokerSupport(solver_id, dir))
     {
+        if(async || miopen::IsEnabled(MIOPEN_IMMED_ASYNC_COMPILE{}))
+        {
+            // Only schedule the build, the invoker is prepared on the first run.
+            auto db             = GetDb(ctx);
+            const auto solution = solver_id.GetSolver().FindSolution(ctx, db, {});
+            return solver::PrecompileKernelsAsync(
+                handle, solution.construction_params, solver_id.ToString());
+        }
         LoadOrPrepareInvoker(handle, ctx, solver_id, dir);
-        return;
+        return {};
     }
 
+    // The kernels of the solvers without invokers are built right away, also when async.
     const FindDbRecord fdb_record{handle, ctx};
     for(const auto& pair : fdb_record)
     {
@@ -999,29 +1964,34 @@ static void CompileSolution(Handle& handle,
                                                  pair.second.kcache_key.network_config);
 
         if(!kernels.empty())
-            return;
+            return {};
 
         CompileSolver(handle, ctx, solver_id, pair.second.kcache_key);
-        return;
+        return {};
     }
 
     // Todo: solver not found in find-db.
     MIOPEN_THROW(miopenStatusNotImplemented);
 }
 
-void ConvolutionDescriptor::CompileForwardSolution(Handle& handle,
-                                                   const TensorDescriptor& wDesc,
-                                                   const TensorDescriptor& xDesc,
-                                                   const TensorDescriptor& yDesc,
-                                                   const solver::Id solver_id) const
+std::vector<std::shared_future<Program>>
+ConvolutionDescriptor::CompileForwardSolution(Handle& handle,
+                                              const TensorDescriptor& wDesc,
+                                              const TensorDescriptor& xDesc,
+                                              const TensorDescriptor& yDesc,
+                                              const solver::Id solver_id,
+                                              bool async) const
 {
     MIOPEN_LOG_I("solver_id = " << solver_id.ToString());
 
-    auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
-    ctx.SetStream(&handle);
-    ctx.disable_search_enforce = true;
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+        return CompileForwardSolution(
+            handle, wDesc, split.GetInChunk(), split.GetOutChunk(), solver_id, async);
+
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+    const auto ctx     = GetImmediateContext(handle, problem, true);
 
-    CompileSolution(handle, solver_id, ctx, conv::Direction::Forward);
+    return CompileSolution(handle, solver_id, *ctx, conv::Direction::Forward, async);
 }
 
 void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
@@ -1042,22 +2012,160 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
     if(!solver_id.IsValid())
         MIOPEN_THROW(miopenStatusBadParm);
 
-    ConvForwardCheckNumerics(handle, tensors, [&]() {
-        auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
-        ctx.SetStream(&handle);
+    if(const auto split = conv::BatchSplit{xDesc, yDesc})
+    {
+        for(std::size_t i = 0; i < split.GetChunks(); ++i)
+            ConvolutionForwardImmediate(handle,
+                                        wDesc,
+                                        w,
+                                        split.GetInChunk(),
+                                        split.In(x, i),
+                                        split.GetOutChunk(),
+                                        split.Out(y, i),
+                                        workSpace,
+                                        workSpaceSize,
+                                        solver_id);
+        return;
+    }
 
+    ConvForwardCheckNumerics(handle, tensors, [&]() {
         if(!CheckInvokerSupport(solver_id, conv::Direction::Forward))
         {
             const auto algo_name = solver_id.GetAlgo(conv::Direction::Forward);
             MIOPEN_THROW("Conv forward algorithm " + algo_name + " must implement invokers.");
         }
 
-        const auto invoker = LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::Forward);
+        const auto fingerprint =
+            conv::ProblemFingerprint{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
         const auto invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
-        invoker(handle, invoke_ctx);
+        RunImmediate(
+            handle,
+            fingerprint,
+            solver_id,
+            conv::Direction::Forward,
+            [&]() {
+                return ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
+            },
+            invoke_ctx);
     });
 }
 
+void ConvolutionForwardImmediateBatch(Handle& handle,
+                                      const std::vector<ConvFwdImmediateCall>& calls)
+{
+    MIOPEN_LOG_I("calls = " << calls.size());
+
+    // The numerics checks and the online tuner work call by call.
+    if(miopen::CheckNumericsEnabled() || (handle.IsProfilingEnabled() && IsOnlineTuningEnabled()))
+    {
+        for(const auto& call : calls)
+        {
+            if(call.conv->mode == miopenTranspose)
+                call.conv->ConvolutionBackwardImmediate(handle,
+                                                        *call.xDesc,
+                                                        call.x,
+                                                        *call.wDesc,
+                                                        call.w,
+                                                        *call.yDesc,
+                                                        call.y,
+                                                        call.workSpace,
+                                                        call.workSpaceSize,
+                                                        call.solver_id);
+            else
+                call.conv->ConvolutionForwardImmediate(handle,
+                                                       *call.wDesc,
+                                                       call.w,
+                                                       *call.xDesc,
+                                                       call.x,
+                                                       *call.yDesc,
+                                                       call.y,
+                                                       call.workSpace,
+                                                       call.workSpaceSize,
+                                                       call.solver_id);
+        }
+        return;
+    }
+
+    using InvokerKey = std::tuple<const ConvolutionDescriptor*,
+                                  const TensorDescriptor*,
+                                  const TensorDescriptor*,
+                                  const TensorDescriptor*,
+                                  uint64_t>;
+    auto invokers = std::map<InvokerKey, Invoker>{};
+    auto launches = std::vector<std::pair<const Invoker*, conv::DataInvokeParams>>{};
+    launches.reserve(calls.size());
+
+    for(const auto& call : calls)
+    {
+        const auto& conv     = *call.conv;
+        const auto& xDesc    = *call.xDesc;
+        const auto& wDesc    = *call.wDesc;
+        const auto& yDesc    = *call.yDesc;
+        const auto transpose = conv.mode == miopenTranspose;
+        const auto dir = transpose ? conv::Direction::BackwardData : conv::Direction::Forward;
+
+        if(!call.solver_id.IsValid())
+            MIOPEN_THROW(miopenStatusBadParm);
+
+        // A transposed forward convolution is the backward data one of x to y.
+        const auto tensors = [&]() -> ConvDataTensors {
+            if(!transpose)
+            {
+                const auto fwd_tensors =
+                    ConvFwdTensors{xDesc, call.x, wDesc, call.w, yDesc, call.y};
+                ValidateConvTensors(fwd_tensors);
+                return fwd_tensors;
+            }
+            const auto bwd_tensors = ConvBwdTensors{xDesc, call.x, wDesc, call.w, yDesc, call.y};
+            ValidateConvTensors(bwd_tensors);
+            if(wDesc.GetType() == miopenInt8 || xDesc.GetLengths()[1] != wDesc.GetLengths()[0])
+                MIOPEN_THROW(miopenStatusBadParm);
+            ValidateGroupCount(yDesc, wDesc, conv);
+            return bwd_tensors;
+        }();
+
+        if(!CheckInvokerSupport(call.solver_id, dir))
+        {
+            const auto algo_name = call.solver_id.GetAlgo(dir);
+            MIOPEN_THROW("Conv algorithm " + algo_name + " must implement invokers.");
+        }
+
+        const auto key = InvokerKey{&conv, &xDesc, &wDesc, &yDesc, call.solver_id.Value()};
+        auto invoker = invokers.find(key);
+        if(invoker == invokers.end())
+        {
+            const auto fingerprint = conv::ProblemFingerprint{xDesc, wDesc, yDesc, conv, dir};
+            const auto make_ctx    = [&]() {
+                return transpose ? ConvolutionContext{yDesc, wDesc, xDesc, conv, dir}
+                                 : ConvolutionContext{xDesc, wDesc, yDesc, conv, dir};
+            };
+            invoker = invokers
+                          .emplace(key,
+                                   LoadOrPrepareInvoker(
+                                       handle, fingerprint, call.solver_id, dir, make_ctx))
+                          .first;
+        }
+
+        launches.emplace_back(
+            &invoker->second,
+            conv::DataInvokeParams{tensors, call.workSpace, call.workSpaceSize});
+    }
+
+    auto time = 0.0f;
+    for(const auto& launch : launches)
+    {
+        (*launch.first)(handle, launch.second);
+        if(handle.IsProfilingEnabled())
+            time += handle.GetKernelTime();
+    }
+
+    if(handle.IsProfilingEnabled())
+    {
+        handle.ResetKernelTime();
+        handle.AccumKernelTime(time);
+    }
+}
+
 // FindBackwardDataAlgorithm()
 //
 void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
@@ -1086,7 +2194,28 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
     if(wDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
 
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+    {
+        FindConvBwdDataAlgorithm(handle,
+                                 split.GetInChunk(),
+                                 dy,
+                                 wDesc,
+                                 w,
+                                 split.GetOutChunk(),
+                                 dx,
+                                 requestAlgoCount,
+                                 returnedAlgoCount,
+                                 perfResults,
+                                 workSpace,
+                                 workSpaceSize,
+                                 exhaustiveSearch);
+        ScaleTimes(perfResults, *returnedAlgoCount, split.GetChunks());
+        return;
+    }
+
     *returnedAlgoCount = 0;
+    // Solutions which need more workspace than the limit are not evaluated.
+    workSpaceSize = std::min(workSpaceSize, workspace_limit);
 
     AutoEnableProfiling enableProfiling{handle};
     ValidateGroupCount(dxDesc, wDesc, *this);
@@ -1122,11 +2251,17 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
             return IsWinograd3x3SupportedAndFast(ctx);
         }();
 
-        perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
+        const auto budgeted = findMode.IsBudgeted(ctx);
+        const auto regenerate = [&](DbRecord& record) {
             const auto network_config = problem.BuildConfKey();
             const auto invoke_ctx     = conv::DataInvokeParams{
                 InvokeType::Evaluate, {dyDesc, dy, wDesc, w, dxDesc, dx}, workSpace, workSpaceSize};
 
+            if(budgeted &&
+               BudgetedFindCore(
+                   handle, *this, ctx, conv::Direction::BackwardData, invoke_ctx, record))
+                return;
+
             ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
                 findMode.IsFastHybrid(ctx);
             ctx.use_dynamic_solutions_only = findMode.IsDynamicHybrid(ctx);
@@ -1198,7 +2333,8 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                              network_config,
                              invoke_ctx,
                              record);
-        });
+        };
+        perf_db = UserFindDbRecord::TryLoad(handle, problem, regenerate, budgeted);
     }
 
     if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
@@ -1210,7 +2346,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
         MIOPEN_THROW(miopenStatusUnknownError,
                      "Backward Data Convolution cannot be executed due to incorrect params");
 
-    std::sort(begin(perf_db), end(perf_db));
+    SelectWithinWorkspaceLimit(perf_db, workspace_limit);
 
     for(const auto& entry : perf_db)
         MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace);
@@ -1224,6 +2360,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
         perfResults[i].memory        = perf_db[i].workspace;
     }
 
+    handle.GetMemoryUsage().AddSelectedWorkspace(perf_db[0].workspace);
     MIOPEN_LOG_I("BWD Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                           << ", " << perf_db[0].time);
 }
@@ -1266,11 +2403,28 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
     auto tensors = ConvBwdTensors{dyDesc, dy, wDesc, w, dxDesc, dx};
 
     ValidateConvTensors(tensors);
-    ValidateAlphaBeta(alpha, beta);
 
     if(wDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
 
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+    {
+        for(std::size_t i = 0; i < split.GetChunks(); ++i)
+            ConvolutionBackwardData(handle,
+                                    alpha,
+                                    split.GetInChunk(),
+                                    split.In(dy, i),
+                                    wDesc,
+                                    w,
+                                    algo,
+                                    beta,
+                                    split.GetOutChunk(),
+                                    split.Out(dx, i),
+                                    workSpace,
+                                    workSpaceSize);
+        return;
+    }
+
     ConvBwdCheckNumerics(handle, tensors, beta, [&]() {
         if(dyDesc.GetLengths()[1] != wDesc.GetLengths()[0])
         {
@@ -1281,16 +2435,31 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
         const auto algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
             static_cast<miopenConvAlgorithm_t>(algo), conv::Direction::BackwardData)};
 
-        auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
-        ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto fingerprint =
+            conv::ProblemFingerprint{dyDesc, wDesc, dxDesc, *this, conv::Direction::BackwardData};
+        auto keys = handle.GetProblemKeys(fingerprint);
+        if(!keys)
+        {
+            auto ctx =
+                ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+            ctx.SetStream(&handle);
+            keys = GetProblemKeys(handle, fingerprint, ctx);
+        }
+        const auto& invoker = handle.GetInvoker(keys->network_config, {}, algorithm_name);
 
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution backward. Was find executed?");
 
-        const auto& invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
-        (*invoker)(handle, invoke_ctx);
+        auto invoke_ctx  = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
+        invoke_ctx.alpha = GetScalingFactor(alpha);
+        invoke_ctx.beta  = GetScalingFactor(beta);
+        InvokeBlended(handle, *invoker, invoke_ctx, keys->network_config, algorithm_name, [&]() {
+            auto ctx =
+                ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+            ctx.SetStream(&handle);
+            ctx.DetectRocm();
+            return ctx;
+        });
     });
 }
 std::size_t ConvolutionDescriptor::GetBackwardSolutionCount(Handle& handle,
@@ -1300,6 +2469,8 @@ std::size_t ConvolutionDescriptor::GetBackwardSolutionCount(Handle& handle,
 {
     MIOPEN_LOG_I("");
     ValidateGroupCount(dxDesc, wDesc, *this);
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+        return GetBackwardSolutionCount(handle, split.GetInChunk(), wDesc, split.GetOutChunk());
     const auto problem =
         ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
     const auto count = GetSolutionCount(handle, problem);
@@ -1323,6 +2494,20 @@ void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
     if(solutions == nullptr)
         MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
 
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+    {
+        GetBackwardSolutions(handle,
+                             split.GetInChunk(),
+                             wDesc,
+                             split.GetOutChunk(),
+                             maxSolutionCount,
+                             solutionCount,
+                             solutions,
+                             fallbackPathTaken);
+        ScaleTimes(solutions, *solutionCount, split.GetChunks());
+        return;
+    }
+
     const auto problem =
         ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
     GetSolutions(handle,
@@ -1336,21 +2521,55 @@ void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
         *fallbackPathTaken = (*solutionCount == 0);
     if(*solutionCount == 0)
         GetSolutionsFallback(handle, problem, maxSolutionCount, solutionCount, solutions);
+    if(*solutionCount > 0)
+        handle.GetMemoryUsage().AddSelectedWorkspace(solutions[0].workspace_size);
 }
 
-void ConvolutionDescriptor::CompileBackwardSolution(Handle& handle,
-                                                    const TensorDescriptor& dyDesc,
-                                                    const TensorDescriptor& wDesc,
-                                                    const TensorDescriptor& dxDesc,
-                                                    solver::Id solver_id) const
+std::vector<std::shared_future<Program>>
+ConvolutionDescriptor::CompileBackwardSolution(Handle& handle,
+                                               const TensorDescriptor& dyDesc,
+                                               const TensorDescriptor& wDesc,
+                                               const TensorDescriptor& dxDesc,
+                                               solver::Id solver_id,
+                                               bool async) const
 {
     MIOPEN_LOG_I("solver_id = " << solver_id.ToString());
 
-    auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
-    ctx.SetStream(&handle);
-    ctx.disable_search_enforce = true;
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+        return CompileBackwardSolution(
+            handle, split.GetInChunk(), wDesc, split.GetOutChunk(), solver_id, async);
+
+    const auto problem =
+        ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+    const auto ctx = GetImmediateContext(handle, problem, true);
 
-    CompileSolution(handle, solver_id, ctx, conv::Direction::BackwardData);
+    return CompileSolution(handle, solver_id, *ctx, conv::Direction::BackwardData, async);
+}
+
+void ConvolutionDescriptor::GetBackwardSolutionsPredicted(Handle& handle,
+                                                          const TensorDescriptor& dyDesc,
+                                                          const TensorDescriptor& wDesc,
+                                                          const TensorDescriptor& dxDesc,
+                                                          const size_t maxSolutionCount,
+                                                          size_t* const solutionCount,
+                                                          miopenConvSolution_t* solutions) const
+{
+    MIOPEN_LOG_I("");
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+    {
+        GetBackwardSolutionsPredicted(handle,
+                                      split.GetInChunk(),
+                                      wDesc,
+                                      split.GetOutChunk(),
+                                      maxSolutionCount,
+                                      solutionCount,
+                                      solutions);
+        ScaleTimes(solutions, *solutionCount, split.GetChunks());
+        return;
+    }
+    const auto problem =
+        ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+    GetSolutionsPredicted(handle, problem, maxSolutionCount, solutionCount, solutions);
 }
 
 std::size_t ConvolutionDescriptor::GetBackwardSolutionWorkspaceSize(Handle& handle,
@@ -1363,12 +2582,16 @@ std::size_t ConvolutionDescriptor::GetBackwardSolutionWorkspaceSize(Handle& hand
     if(!solver_id.IsValid())
         MIOPEN_THROW(miopenStatusBadParm, "invalid solution id = " + solver_id.ToString());
 
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+        return GetBackwardSolutionWorkspaceSize(
+            handle, split.GetInChunk(), wDesc, split.GetOutChunk(), solver_id);
+
     auto sol = solver_id.GetSolver();
-    auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
-    ctx.SetStream(&handle);
-    ctx.DetectRocm();
-    if(sol.IsApplicable(ctx))
-        return sol.GetWorkspaceSize(ctx);
+    const auto problem =
+        ProblemDescription{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+    const auto ctx = GetImmediateContext(handle, problem);
+    if(sol.IsApplicable(*ctx))
+        return sol.GetWorkspaceSize(*ctx);
     else
         MIOPEN_THROW(miopenStatusBadParm,
                      "The supplied solution id: " + solver_id.ToString() +
@@ -1394,6 +2617,22 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
     if(wDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
 
+    if(const auto split = conv::BatchSplit{dyDesc, dxDesc})
+    {
+        for(std::size_t i = 0; i < split.GetChunks(); ++i)
+            ConvolutionBackwardImmediate(handle,
+                                         split.GetInChunk(),
+                                         split.In(dy, i),
+                                         wDesc,
+                                         w,
+                                         split.GetOutChunk(),
+                                         split.Out(dx, i),
+                                         workSpace,
+                                         workSpaceSize,
+                                         solver_id);
+        return;
+    }
+
     static const float beta = 0.0f;
     ConvBwdCheckNumerics(handle, tensors, &beta, [&]() {
         if(dyDesc.GetLengths()[1] != wDesc.GetLengths()[0])
@@ -1402,19 +2641,25 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
         }
         ValidateGroupCount(dxDesc, wDesc, *this);
 
-        auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
-        ctx.SetStream(&handle);
-
         if(!CheckInvokerSupport(solver_id, conv::Direction::BackwardData))
         {
             const auto algo_name = solver_id.GetAlgo(conv::Direction::BackwardData);
             MIOPEN_THROW("Conv backward algorithm " + algo_name + " must implement invokers.");
         }
 
-        const auto invoker =
-            LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::BackwardData);
+        const auto fingerprint =
+            conv::ProblemFingerprint{dyDesc, wDesc, dxDesc, *this, conv::Direction::BackwardData};
         const auto invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
-        invoker(handle, invoke_ctx);
+        RunImmediate(
+            handle,
+            fingerprint,
+            solver_id,
+            conv::Direction::BackwardData,
+            [&]() {
+                return ConvolutionContext{
+                    dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
+            },
+            invoke_ctx);
     });
 }
 
@@ -1448,6 +2693,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
 
     *returnedAlgoCount = 0;
+    // Solutions which need more workspace than the limit are not evaluated.
+    workSpaceSize = std::min(workSpaceSize, workspace_limit);
 
     AutoEnableProfiling enableProfiling{handle};
 
@@ -1477,7 +2724,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
     }
     else
     {
-        perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
+        const auto budgeted = findMode.IsBudgeted(ctx);
+        const auto regenerate = [&](DbRecord& record) {
             ConvolutionUserBuffers bufs(workSpace, workSpaceSize);
             bufs.SetWrW(x, dw, dy);
             ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
@@ -1492,6 +2740,11 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             const auto invoke_ctx     = conv::WrWInvokeParams{
                 InvokeType::Evaluate, {dyDesc, dy, xDesc, x, dwDesc, dw}, workSpace, workSpaceSize};
 
+            if(budgeted &&
+               BudgetedFindCore(
+                   handle, *this, ctx, conv::Direction::BackwardWeights, invoke_ctx, record))
+                return;
+
             // Find solutions
             const auto gemm = !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{})
                                   ? FindAllGemmSolutions(ctx, invoke_ctx)
@@ -1542,7 +2795,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                              network_config,
                              invoke_ctx,
                              record);
-        });
+        };
+        perf_db = UserFindDbRecord::TryLoad(handle, problem, regenerate, budgeted);
     }
 
     if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
@@ -1554,7 +2808,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
     if(perf_db.empty())
         MIOPEN_THROW("Backward Weights Convolution cannot be executed due to incorrect params");
 
-    std::sort(begin(perf_db), end(perf_db));
+    SelectWithinWorkspaceLimit(perf_db, workspace_limit);
 
     for(const auto& entry : perf_db)
         MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace);
@@ -1567,6 +2821,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
         perfResults[i].time             = perf_db[i].time;
         perfResults[i].memory           = perf_db[i].workspace;
     }
+
+    handle.GetMemoryUsage().AddSelectedWorkspace(perf_db[0].workspace);
     MIOPEN_LOG_I("BWrW Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                            << ", " << perf_db[0].time);
 }
@@ -1609,7 +2865,6 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
     MIOPEN_LOG_I("algo = " << algo << ", workspace = " << workSpaceSize);
     decltype(auto) tensors = ConvWrwTensors{dyDesc, dy, xDesc, x, dwDesc, dw};
     ValidateConvTensors(tensors);
-    ValidateAlphaBeta(alpha, beta);
 
     if(xDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
@@ -1627,8 +2882,15 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution weights. Was find executed?");
 
-        const auto invoke_ctx = conv::WrWInvokeParams{tensors, workSpace, workSpaceSize};
-        (*invoker)(handle, invoke_ctx);
+        auto invoke_ctx  = conv::WrWInvokeParams{tensors, workSpace, workSpaceSize};
+        invoke_ctx.alpha = GetScalingFactor(alpha);
+        invoke_ctx.beta  = GetScalingFactor(beta);
+        InvokeBlended(handle, *invoker, invoke_ctx, network_config, algorithm_name, [&]() {
+            auto conv_ctx = ConvolutionContext{xDesc, dwDesc, dyDesc, *this, direction};
+            conv_ctx.SetStream(const_cast<Handle*>(&handle)); // NOLINT
+            conv_ctx.DetectRocm();
+            return conv_ctx;
+        });
     });
 }
 
@@ -1681,20 +2943,37 @@ void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
         *fallbackPathTaken = (*solutionCount == 0);
     if(*solutionCount == 0)
         GetSolutionsFallback(handle, problem, maxSolutionCount, solutionCount, solutions);
+    if(*solutionCount > 0)
+        handle.GetMemoryUsage().AddSelectedWorkspace(solutions[0].workspace_size);
 }
 
-void ConvolutionDescriptor::CompileWrwSolution(Handle& handle,
-                                               const TensorDescriptor& dyDesc,
-                                               const TensorDescriptor& xDesc,
-                                               const TensorDescriptor& dwDesc,
-                                               solver::Id solver_id) const
+std::vector<std::shared_future<Program>>
+ConvolutionDescriptor::CompileWrwSolution(Handle& handle,
+                                          const TensorDescriptor& dyDesc,
+                                          const TensorDescriptor& xDesc,
+                                          const TensorDescriptor& dwDesc,
+                                          solver::Id solver_id,
+                                          bool async) const
 {
     MIOPEN_LOG_I("solver_id = " << solver_id.ToString());
-    auto ctx = ConvolutionContext{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
-    ctx.SetStream(&handle);
-    ctx.disable_search_enforce = true;
+    const auto problem =
+        ProblemDescription{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
+    const auto ctx = GetImmediateContext(handle, problem, true);
+
+    return CompileSolution(handle, solver_id, *ctx, conv::Direction::BackwardWeights, async);
+}
 
-    CompileSolution(handle, solver_id, ctx, conv::Direction::BackwardWeights);
+void ConvolutionDescriptor::GetWrwSolutionsPredicted(Handle& handle,
+                                                     const TensorDescriptor& dyDesc,
+                                                     const TensorDescriptor& xDesc,
+                                                     const TensorDescriptor& dwDesc,
+                                                     const size_t maxSolutionCount,
+                                                     size_t* const solutionCount,
+                                                     miopenConvSolution_t* const solutions) const
+{
+    MIOPEN_LOG_I("");
+    const auto problem = MakeWrwProblem(dyDesc, xDesc, dwDesc);
+    GetSolutionsPredicted(handle, problem, maxSolutionCount, solutionCount, solutions);
 }
 
 std::size_t ConvolutionDescriptor::GetWrwSolutionWorkspaceSize(Handle& handle,
@@ -1708,13 +2987,11 @@ std::size_t ConvolutionDescriptor::GetWrwSolutionWorkspaceSize(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "invalid solution id = " + solver_id.ToString());
 
     auto sol = solver_id.GetSolver();
-    auto problem =
+    const auto problem =
         ProblemDescription{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
-    auto ctx = ConvolutionContext{problem};
-    ctx.SetStream(&handle);
-    ctx.DetectRocm();
-    if(sol.IsApplicable(ctx))
-        return sol.GetWorkspaceSize(ctx);
+    const auto ctx = GetImmediateContext(handle, problem);
+    if(sol.IsApplicable(*ctx))
+        return sol.GetWorkspaceSize(*ctx);
     else
         MIOPEN_THROW(miopenStatusBadParm,
                      "The supplied solution id: " + solver_id.ToString() +
@@ -1743,23 +3020,98 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
     ConvWrwCheckNumerics(handle, tensors, &beta, [&]() {
         ValidateGroupCount(xDesc, dwDesc, *this);
 
-        auto ctx =
-            ConvolutionContext{xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
-        ctx.SetStream(&handle);
-
         if(!CheckInvokerSupport(solver_id, conv::Direction::BackwardWeights))
         {
             MIOPEN_THROW("Solver " + solver_id.ToString() +
                          " requested in immediate WrW, which is not supported.");
         }
 
-        const auto invoker =
-            LoadOrPrepareInvoker(handle, ctx, solver_id, conv::Direction::BackwardWeights);
+        const auto fingerprint = conv::ProblemFingerprint{
+            dyDesc, dwDesc, xDesc, *this, conv::Direction::BackwardWeights};
         const auto invoke_ctx = conv::WrWInvokeParams{tensors, workSpace, workSpaceSize};
-        invoker(handle, invoke_ctx);
+        RunImmediate(
+            handle,
+            fingerprint,
+            solver_id,
+            conv::Direction::BackwardWeights,
+            [&]() {
+                return ConvolutionContext{
+                    xDesc, dwDesc, dyDesc, *this, conv::Direction::BackwardWeights};
+            },
+            invoke_ctx);
+    });
+}
+
+Invoker ConvolutionDescriptor::GetImmediateInvoker(Handle& handle,
+                                                   const TensorDescriptor& xDesc,
+                                                   const TensorDescriptor& wDesc,
+                                                   const TensorDescriptor& yDesc,
+                                                   const conv::Direction dir,
+                                                   const solver::Id solver_id) const
+{
+    MIOPEN_LOG_I("solver_id = " << solver_id.ToString());
+    if(!solver_id.IsValid())
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    ValidateConvDescriptors(xDesc, wDesc, yDesc);
+    if(dir != conv::Direction::Forward)
+    {
+        if(xDesc.GetType() == miopenInt8)
+            MIOPEN_THROW(miopenStatusBadParm);
+        if(dir == conv::Direction::BackwardData && yDesc.GetLengths()[1] != wDesc.GetLengths()[0])
+            MIOPEN_THROW(miopenStatusBadParm);
+        ValidateGroupCount(xDesc, wDesc, *this);
+    }
+
+    if(!CheckInvokerSupport(solver_id, dir))
+    {
+        MIOPEN_THROW("Solver " + solver_id.ToString() +
+                     " requested in immediate mode, which is not supported.");
+    }
+
+    const auto fingerprint = dir == conv::Direction::Forward
+                                 ? conv::ProblemFingerprint{xDesc, wDesc, yDesc, *this, dir}
+                                 : conv::ProblemFingerprint{yDesc, wDesc, xDesc, *this, dir};
+    return LoadOrPrepareInvoker(handle, fingerprint, solver_id, dir, [&]() {
+        return ConvolutionContext{xDesc, wDesc, yDesc, *this, dir};
     });
 }
 
+/// Sums dy over the dimensions of view_lens which are 1 in db_lens with the ReduceTensor engine.
+/// The views describe dy and db as packed tensors.
+static void ConvolutionBackwardBiasReduce(const Handle& handle,
+                                          const TensorDescriptor& dyDesc,
+                                          ConstData_t dy,
+                                          const std::vector<std::size_t>& dy_lens,
+                                          const std::vector<std::size_t>& db_lens,
+                                          Data_t db)
+{
+    const auto dy_view = TensorDescriptor{dyDesc.GetType(), dy_lens};
+    const auto db_view = TensorDescriptor{dyDesc.GetType(), db_lens};
+    const auto reduce  = ReduceTensorDescriptor{MIOPEN_REDUCE_TENSOR_ADD,
+                                               miopenFloat,
+                                               MIOPEN_NOT_PROPAGATE_NAN,
+                                               MIOPEN_REDUCE_TENSOR_NO_INDICES,
+                                               MIOPEN_32BIT_INDICES};
+
+    auto& reduce_handle = const_cast<Handle&>(handle); // NOLINT
+    const auto ws_size  = reduce.GetWorkspaceSize(handle, dy_view, db_view);
+    const auto ws       = ws_size > 0 ? handle.Create(ws_size) : nullptr;
+    const float one     = 1.0f;
+    const float zero    = 0.0f;
+    reduce.ReduceTensor(reduce_handle,
+                        nullptr,
+                        0,
+                        ws.get(),
+                        ws_size,
+                        &one,
+                        dy_view,
+                        dy,
+                        &zero,
+                        db_view,
+                        db);
+}
+
 void ConvolutionBackwardBias(const Handle& handle,
                              const void* alpha,
                              const TensorDescriptor& dyDesc,
@@ -1809,6 +3161,51 @@ void ConvolutionBackwardBias(const Handle& handle,
                                            dyDesc.GetLengths().end(),
                                            std::size_t(1),
                                            std::multiplies<std::size_t>());
+
+    // MIOpenConvBwdB reads the maps of a channel as contiguous ranges. Packed channels-last
+    // tensors, such as NHWC, are instead summed as map_size * out_n rows of out_k values.
+    // So are packed NCHW ones with few channels to spread the long per-channel sums over.
+    const auto& lens         = dyDesc.GetLengths();
+    const auto& strides      = dyDesc.GetStrides();
+    auto maps_contiguous     = true;
+    auto channels_last       = stride_k == 1 || out_k == 1;
+    std::size_t map_stride   = 1;
+    std::size_t pixel_stride = out_k;
+    for(auto i = lens.size(); i-- > 2;)
+    {
+        maps_contiguous = maps_contiguous && (lens[i] == 1 || strides[i] == map_stride);
+        channels_last   = channels_last && (lens[i] == 1 || strides[i] == pixel_stride);
+        map_stride *= lens[i];
+        pixel_stride *= lens[i];
+    }
+    channels_last = channels_last && (out_n == 1 || stride_n == out_k * map_size);
+    const auto reducible = dyDesc.GetType() == miopenFloat || dyDesc.GetType() == miopenHalf ||
+                           dyDesc.GetType() == miopenBFloat16;
+
+    if(channels_last && !maps_contiguous && reducible)
+    {
+        ConvolutionBackwardBiasReduce(
+            handle, dyDesc, dy, {out_n * map_size, out_k}, {1, out_k}, db);
+        if(miopen::CheckNumericsEnabled())
+            miopen::checkNumericsOutput(handle, dbDesc, db);
+        return;
+    }
+    if(!maps_contiguous)
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Backward bias needs either contiguous maps or a packed channels-last dy");
+
+    const auto nchw_packed = (out_k == 1 || stride_k == map_size) &&
+                             (out_n == 1 || stride_n == out_k * map_size);
+    if(nchw_packed && reducible && !miopen::IsDisabled(MIOPEN_DEBUG_CONV_BWD_BIAS_REDUCE{}) &&
+       out_k < handle.GetMaxComputeUnits() && out_n * map_size >= 64 * 1024)
+    {
+        ConvolutionBackwardBiasReduce(
+            handle, dyDesc, dy, {out_n, out_k, map_size}, {1, out_k, 1}, db);
+        if(miopen::CheckNumericsEnabled())
+            miopen::checkNumericsOutput(handle, dbDesc, db);
+        return;
+    }
+
     std::size_t read_unit        = 4;
     std::size_t map_size_aligned = (map_size + (read_unit - 1)) / read_unit;
     std::size_t off_pix          = map_size - (map_size / read_unit) * read_unit;
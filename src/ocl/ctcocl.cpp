@@ -33,157 +33,102 @@
 #include <miopen/util.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/float_equal.hpp>
+#include <miopen/kernel_build_params.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/check_numerics.hpp>
 #include <vector>
 #include <numeric>
 #include <algorithm>
-
-#define MAX_ACTIVE_THREADS (64 * 4 * 64)
-#define MAX_LOCAL_MEM 65536
+#include <sstream>
 
 namespace miopen {
 
-void CTCLossDescriptor::CTCLoss(const Handle& handle,
-                                const TensorDescriptor& probsDesc,
-                                ConstData_t probs,
-                                const int* labels,
-                                const int* labelLengths,
-                                const int* inputLengths,
-                                Data_t losses,
-                                const TensorDescriptor& gradientsDesc,
-                                Data_t gradients,
-                                miopenCTCLossAlgo_t algo,
-                                Data_t workSpace,
-                                size_t workSpaceSize) const
-{
-    (void)algo;
-    (void)workSpaceSize;
+namespace {
 
-    if(probsDesc.GetType() != miopenFloat && probsDesc.GetType() != miopenHalf)
+void CheckCTCLossTensors(const TensorDescriptor& probsDesc, const TensorDescriptor& gradientsDesc)
+{
+    if(probsDesc.GetType() != miopenFloat && probsDesc.GetType() != miopenHalf &&
+       probsDesc.GetType() != miopenBFloat16)
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
+    if(probsDesc.GetType() != gradientsDesc.GetType())
+        MIOPEN_THROW(miopenStatusBadParm, "probs and gradients must have the same data type");
+
     if(probsDesc.GetLengths()[0] != gradientsDesc.GetLengths()[0] ||
        probsDesc.GetLengths()[1] != gradientsDesc.GetLengths()[1] ||
        probsDesc.GetLengths()[2] != gradientsDesc.GetLengths()[2])
     {
         MIOPEN_THROW("probs tensor's dimension does not match gradients tensor's dimension");
     }
+}
+
+/// Builds and runs CTCLossGPU. With device_labels the labels and both length lists are read by
+/// the kernel from the given device buffers, otherwise they are expected at the start of the
+/// workspace together with the label offsets and repeats computed by the host.
+void RunCTCLossKernel(const Handle& handle,
+                      const CTCLossDescriptor& ctcLossDesc,
+                      const TensorDescriptor& probsDesc,
+                      ConstData_t probs,
+                      bool device_labels,
+                      ConstData_t labels,
+                      ConstData_t labelLengths,
+                      ConstData_t inputLengths,
+                      int max_label_len,
+                      int total_label_len,
+                      Data_t losses,
+                      const TensorDescriptor& gradientsDesc,
+                      Data_t gradients,
+                      Data_t workSpace)
+{
+    const bool apply_softmax_layer = ctcLossDesc.apply_softmax_layer;
+    const int blank_label_id       = ctcLossDesc.blank_label_id;
+
+    // The 16-bit logits are read by the loss kernel itself, which writes their log-softmax to
+    // the workspace in fp32 instead of a separate softmax of the full [T, N, V] tensor.
+    const bool fused_softmax = apply_softmax_layer && probsDesc.GetType() != miopenFloat;
 
     int class_sz      = probsDesc.GetLengths()[2];
     int batch_size    = probsDesc.GetLengths()[1];
     int max_time_step = probsDesc.GetLengths()[0];
-    std::vector<int> repeat(batch_size, 0);
-    std::vector<int> labels_offset(batch_size, 0);
-    int max_label_len   = 0;
-    int total_label_len = 0;
-
-    for(int i = 0; i < batch_size; i++)
-    {
-        if(inputLengths[i] > max_time_step)
-        {
-            MIOPEN_THROW("Wrong input time step");
-        }
-        max_label_len = std::max(max_label_len, labelLengths[i]);
-        total_label_len += labelLengths[i];
-        labels_offset[i] = i == 0 ? 0 : (labels_offset[i - 1] + labelLengths[i - 1]);
-
-        for(int j = 0; j < labelLengths[i]; j++)
-        {
-            if(labels[labels_offset[i] + j] >= class_sz)
-            {
-                MIOPEN_THROW("Wrong label id");
-            }
-            if(j > 0)
-                if(labels[labels_offset[i] + j] == labels[labels_offset[i] + j - 1])
-                    repeat[i]++;
-        }
-
-        if(labelLengths[i] + repeat[i] > inputLengths[i])
-        {
-            MIOPEN_THROW("Error: label length exceeds input time step");
-        }
-    }
 
+    // The device-resident labels leave only the labels with blanks at the start of the workspace
     int max_S_len       = 2 * max_label_len + 1;
-    int lb_prime_offset = 4 * batch_size + total_label_len;
+    int lb_prime_offset = device_labels ? 0 : 4 * batch_size + total_label_len;
     int problog_offset  = lb_prime_offset + batch_size * max_S_len;
 
-    if(probsDesc.GetType() == miopenHalf)
-        problog_offset *= 2;
-
-    int alpha_offset = problog_offset + class_sz * batch_size * max_time_step;
-    int beta_offset  = alpha_offset + max_time_step * batch_size * max_S_len;
-    int batch_bytes  = 4 * batch_size; // batch size multiples sizeof(int)
-
-#if MIOPEN_BACKEND_OPENCL
-    auto q = handle.GetStream();
-
-    cl_context ctx;
-    clGetCommandQueueInfo(q, CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, nullptr);
-
-    clEnqueueWriteBuffer(q, workSpace, CL_FALSE, 0, batch_bytes, inputLengths, 0, nullptr, nullptr);
-    clEnqueueWriteBuffer(
-        q, workSpace, CL_FALSE, batch_bytes, batch_bytes, labelLengths, 0, nullptr, nullptr);
-    clEnqueueWriteBuffer(q,
-                         workSpace,
-                         CL_FALSE,
-                         2 * batch_bytes,
-                         batch_bytes,
-                         labels_offset.data(),
-                         0,
-                         nullptr,
-                         nullptr);
-    clEnqueueWriteBuffer(
-        q, workSpace, CL_FALSE, 3 * batch_bytes, batch_bytes, repeat.data(), 0, nullptr, nullptr);
-    clEnqueueWriteBuffer(q,
-                         workSpace,
-                         CL_FALSE,
-                         4 * batch_bytes,
-                         total_label_len * sizeof(int),
-                         labels,
-                         0,
-                         nullptr,
-                         nullptr);
-
-#elif MIOPEN_BACKEND_HIP
-
-    hipMemcpy(static_cast<int*>(workSpace), inputLengths, batch_bytes, hipMemcpyHostToDevice);
-    hipMemcpy(static_cast<int*>(workSpace) + batch_size,
-              labelLengths,
-              batch_bytes,
-              hipMemcpyHostToDevice);
-    hipMemcpy(static_cast<int*>(workSpace) + 2 * batch_size,
-              labels_offset.data(),
-              batch_bytes,
-              hipMemcpyHostToDevice);
-    hipMemcpy(static_cast<int*>(workSpace) + 3 * batch_size,
-              repeat.data(),
-              batch_bytes,
-              hipMemcpyHostToDevice);
-    hipMemcpy(static_cast<int*>(workSpace) + 4 * batch_size,
-              labels,
-              total_label_len * sizeof(int),
-              hipMemcpyHostToDevice);
-#endif
+    // The workspace holds fp32 for every data type, the 16-bit types also gather the log-space
+    // gradients of a frame there when they do not fit in LDS.
+    int alpha_offset   = problog_offset + class_sz * batch_size * max_time_step;
+    int beta_offset    = alpha_offset + max_time_step * batch_size * max_S_len;
+    int gradtmp_offset = beta_offset + 2 * batch_size * max_S_len;
 
     std::string program_name = "MIOpenCTCLoss.cl";
     std::string kernel_name  = "CTCLossGPU";
 
     std::string network_config =
         "t" + std::to_string(max_time_step) + "n" + std::to_string(batch_size) + "a" +
-        std::to_string(class_sz) + "mlb" + std::to_string(max_label_len) + "tlb" +
-        std::to_string(total_label_len) + "sfm" +
+        std::to_string(class_sz) + "mlb" + std::to_string(max_label_len) +
+        (device_labels ? std::string("dev") : "tlb" + std::to_string(total_label_len)) + "sfm" +
         std::to_string(static_cast<int>(apply_softmax_layer)) + "b" +
-        std::to_string(blank_label_id); // max timestep, batch, alphabet, max label length, total
-                                        // label length, softmax layer indicator, blank ID
+        std::to_string(blank_label_id) +
+        GetDataTypeName(probsDesc.GetType()); // max timestep, batch, alphabet, max label length,
+                                              // total label length or device labels, softmax
+                                              // layer indicator, blank ID, data type
+
+    // The host mode has no separate label buffers, the kernel reads everything from dim_data.
+    if(!device_labels)
+    {
+        labels       = workSpace;
+        labelLengths = workSpace;
+        inputLengths = workSpace;
+    }
 
     auto&& kernels = handle.GetKernels(kernel_name, network_config);
 
     float time = 0.;
-    if(apply_softmax_layer)
+    if(apply_softmax_layer && !fused_softmax)
     {
         std::vector<int> sfm_size(4, 1);
         sfm_size[0]   = max_time_step * batch_size;
@@ -211,19 +156,32 @@ void CTCLossDescriptor::CTCLoss(const Handle& handle,
     {
         auto kernel = kernels.front();
 
-        kernel(probs, workSpace, workSpace, losses, gradients);
+        kernel(probs,
+               workSpace,
+               workSpace,
+               losses,
+               gradients,
+               labels,
+               labelLengths,
+               inputLengths);
     }
     else
     {
         std::string params;
 
+        // Four work-groups of 256 per compute unit stay resident, and the LDS budget of a group
+        // follows from the local memory the device reports rather than a fixed 64 KB, so longer
+        // label sequences still keep beta and the labels with blanks in LDS where it is larger.
+        const std::size_t max_active_threads = handle.GetMaxComputeUnits() * 4 * 256;
+        const std::size_t max_local_mem      = handle.GetLocalMemorySize();
+
         size_t work_per_grp = batch_size <= 64 ? 256 : batch_size <= 128 ? 128 : 64;
         assert(512 >= work_per_grp && work_per_grp > 0);
-        size_t glb_sz = batch_size < MAX_ACTIVE_THREADS / work_per_grp ? batch_size * work_per_grp
-                                                                       : MAX_ACTIVE_THREADS;
+        size_t glb_sz = batch_size < max_active_threads / work_per_grp ? batch_size * work_per_grp
+                                                                       : max_active_threads;
         size_t grp_num = glb_sz / work_per_grp;
 
-        size_t lcl_mem_per_grp = MAX_LOCAL_MEM / 2 / (512 / work_per_grp);
+        size_t lcl_mem_per_grp = max_local_mem / 2 / (512 / work_per_grp);
 
         params += " -DCLASS_SZ=" + std::to_string(class_sz) +
                   " -DBATCH_SZ=" + std::to_string(batch_size) +
@@ -235,6 +193,7 @@ void CTCLossDescriptor::CTCLoss(const Handle& handle,
                   " -DPROBLOG_OFFSET=" + std::to_string(problog_offset) +
                   " -DALPHA_OFFSET=" + std::to_string(alpha_offset) +
                   " -DBETA_OFFSET=" + std::to_string(beta_offset) +
+                  " -DGRADTMP_OFFSET=" + std::to_string(gradtmp_offset) +
                   " -DWORK_PER_GRP=" + std::to_string(work_per_grp) +
                   " -DGRP_NUM=" + std::to_string(grp_num) +
                   " -DBLANK_LB_ID=" + std::to_string(blank_label_id);
@@ -247,8 +206,12 @@ void CTCLossDescriptor::CTCLoss(const Handle& handle,
             params += " -DGRADS_STRIDE0=" + std::to_string(gradientsDesc.GetStrides()[0]) +
                       " -DGRADS_STRIDE1=" + std::to_string(gradientsDesc.GetStrides()[1]);
 
+        if(device_labels)
+            params += " -DDEVICE_LABELS=1";
+
         params += " -DSOFTMAX_APPLIED=" + std::to_string(static_cast<int>(apply_softmax_layer)) +
-                  " -DSOFTMAX_LEN=" + std::to_string(class_sz);
+                  " -DSOFTMAX_LEN=" + std::to_string(class_sz) +
+                  " -DFUSED_SOFTMAX=" + std::to_string(static_cast<int>(fused_softmax));
 
 #if MIOPEN_BACKEND_OPENCL
         if(class_sz <= lcl_mem_per_grp)
@@ -269,10 +232,15 @@ void CTCLossDescriptor::CTCLoss(const Handle& handle,
            <= lcl_mem_per_grp)
             params += " -DOPT_LCL_MEM_LB";
 
+        // The log-space gradients are accumulated in fp32 for every type, so all of them can
+        // use the atomic update.
         if(probsDesc.GetType() == miopenHalf)
             params += " -DMIOPEN_USE_FP16=1";
+        else if(probsDesc.GetType() == miopenBFloat16)
+            params += " -DMIOPEN_USE_BFP16=1";
         else
-            params += " -DMIOPEN_USE_FP32=1 -DOPT_ATOMIC_LOGADDEXP";
+            params += " -DMIOPEN_USE_FP32=1";
+        params += " -DOPT_ATOMIC_LOGADDEXP";
 
 #if MIOPEN_BACKEND_HIP
         params += " -DUSE_HIP_BACKEND=1";
@@ -284,10 +252,214 @@ void CTCLossDescriptor::CTCLoss(const Handle& handle,
         const std::vector<size_t> vgd{glb_sz, 1, 1};
 
         handle.AddKernel(kernel_name, network_config, program_name, kernel_name, vld, vgd, params)(
-            probs, workSpace, workSpace, losses, gradients);
+            probs, workSpace, workSpace, losses, gradients, labels, labelLengths, inputLengths);
     }
     if(handle.IsProfilingEnabled())
         handle.AccumKernelTime(time);
 }
 
+} // namespace
+
+void CTCLossDescriptor::CTCLoss(const Handle& handle,
+                                const TensorDescriptor& probsDesc,
+                                ConstData_t probs,
+                                const int* labels,
+                                const int* labelLengths,
+                                const int* inputLengths,
+                                Data_t losses,
+                                const TensorDescriptor& gradientsDesc,
+                                Data_t gradients,
+                                miopenCTCLossAlgo_t algo,
+                                Data_t workSpace,
+                                size_t workSpaceSize) const
+{
+    (void)algo;
+    (void)workSpaceSize;
+
+    CheckCTCLossTensors(probsDesc, gradientsDesc);
+
+    int class_sz      = probsDesc.GetLengths()[2];
+    int batch_size    = probsDesc.GetLengths()[1];
+    int max_time_step = probsDesc.GetLengths()[0];
+    std::vector<int> repeat(batch_size, 0);
+    std::vector<int> labels_offset(batch_size, 0);
+    int max_label_len   = 0;
+    int total_label_len = 0;
+
+    for(int i = 0; i < batch_size; i++)
+    {
+        if(inputLengths[i] > max_time_step)
+        {
+            MIOPEN_THROW("Wrong input time step");
+        }
+        max_label_len = std::max(max_label_len, labelLengths[i]);
+        total_label_len += labelLengths[i];
+        labels_offset[i] = i == 0 ? 0 : (labels_offset[i - 1] + labelLengths[i - 1]);
+
+        for(int j = 0; j < labelLengths[i]; j++)
+        {
+            if(labels[labels_offset[i] + j] >= class_sz)
+            {
+                MIOPEN_THROW("Wrong label id");
+            }
+            if(j > 0)
+                if(labels[labels_offset[i] + j] == labels[labels_offset[i] + j - 1])
+                    repeat[i]++;
+        }
+
+        if(labelLengths[i] + repeat[i] > inputLengths[i])
+        {
+            MIOPEN_THROW("Error: label length exceeds input time step");
+        }
+    }
+
+    int batch_bytes = 4 * batch_size; // batch size multiples sizeof(int)
+
+    // Staged, so the local vectors may go before the copies complete.
+    handle.WriteToAsync(inputLengths, workSpace, batch_bytes);
+    handle.WriteToAsync(labelLengths, workSpace, batch_bytes, batch_bytes);
+    handle.WriteToAsync(labels_offset.data(), workSpace, batch_bytes, 2 * batch_bytes);
+    handle.WriteToAsync(repeat.data(), workSpace, batch_bytes, 3 * batch_bytes);
+    handle.WriteToAsync(labels, workSpace, total_label_len * sizeof(int), 4 * batch_bytes);
+
+    RunCTCLossKernel(handle,
+                     *this,
+                     probsDesc,
+                     probs,
+                     false,
+                     nullptr,
+                     nullptr,
+                     nullptr,
+                     max_label_len,
+                     total_label_len,
+                     losses,
+                     gradientsDesc,
+                     gradients,
+                     workSpace);
+}
+
+void CTCLossDescriptor::CTCLoss(const Handle& handle,
+                                const TensorDescriptor& probsDesc,
+                                ConstData_t probs,
+                                ConstData_t labels,
+                                ConstData_t labelLengths,
+                                ConstData_t inputLengths,
+                                int maxLabelLength,
+                                Data_t losses,
+                                const TensorDescriptor& gradientsDesc,
+                                Data_t gradients,
+                                miopenCTCLossAlgo_t algo,
+                                Data_t workSpace,
+                                size_t workSpaceSize) const
+{
+    (void)algo;
+    (void)workSpaceSize;
+
+    CheckCTCLossTensors(probsDesc, gradientsDesc);
+
+    if(labels == nullptr || labelLengths == nullptr || inputLengths == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "The device-resident labels and lengths are required");
+
+    if(maxLabelLength <= 0)
+        MIOPEN_THROW(miopenStatusBadParm, "The maximum label length must be positive");
+
+    RunCTCLossKernel(handle,
+                     *this,
+                     probsDesc,
+                     probs,
+                     true,
+                     labels,
+                     labelLengths,
+                     inputLengths,
+                     maxLabelLength,
+                     0,
+                     losses,
+                     gradientsDesc,
+                     gradients,
+                     workSpace);
+}
+
+void CTCLossDescriptor::CTCDecode(const Handle& handle,
+                                  miopenCTCDecodeMode_t mode,
+                                  int beamWidth,
+                                  const TensorDescriptor& probsDesc,
+                                  ConstData_t probs,
+                                  ConstData_t inputLengths,
+                                  Data_t decoded,
+                                  Data_t decodedLengths,
+                                  Data_t scores,
+                                  Data_t workSpace,
+                                  size_t workSpaceSize) const
+{
+    if(probsDesc.GetType() != miopenFloat && probsDesc.GetType() != miopenHalf)
+        MIOPEN_THROW(miopenStatusBadParm, "CTC decoding supports fp32 and fp16 probabilities");
+
+    const auto wksp_size = GetCTCDecodeWorkspaceSize(probsDesc, mode, beamWidth);
+    if(workSpaceSize < wksp_size || (wksp_size > 0 && workSpace == nullptr))
+        MIOPEN_THROW(miopenStatusBadParm, "The workspace is too small");
+
+    if(probs == nullptr || inputLengths == nullptr || decoded == nullptr ||
+       decodedLengths == nullptr || scores == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "A null pointer was passed to CTC decoding");
+
+    const auto& lens    = probsDesc.GetLengths();
+    const auto& strides = probsDesc.GetStrides();
+    if(strides[2] != 1)
+        MIOPEN_THROW(miopenStatusBadParm, "CTC decoding requires a unit class stride");
+
+    const auto max_time_step = lens[0];
+    const auto batch_size    = lens[1];
+    const auto class_sz      = lens[2];
+    const bool greedy        = mode == MIOPEN_CTC_DECODE_GREEDY;
+    if(!greedy && class_sz < 2)
+        MIOPEN_THROW(miopenStatusBadParm, "The beam search needs a class besides the blank");
+
+    const std::string kernel_name = greedy ? "CTCGreedyDecode" : "CTCBeamSearchDecode";
+
+    std::ostringstream network_config;
+    network_config << "ctcdec" << (greedy ? "g" : "bs") << beamWidth << "t" << max_time_step
+                   << "n" << batch_size << "a" << class_sz << "s" << strides[0] << "x"
+                   << strides[1] << "sfm" << static_cast<int>(apply_softmax_layer) << "b"
+                   << blank_label_id << GetDataTypeName(probsDesc.GetType());
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config.str());
+    if(!kernels.empty())
+    {
+        kernels.front()(probs, inputLengths, decoded, decodedLengths, scores, workSpace);
+        return;
+    }
+
+    // One work-group decodes one sample at a time, as many as stay resident.
+    const std::size_t work_per_grp = 256;
+    const std::size_t grp_num = std::min<std::size_t>(batch_size, handle.GetMaxComputeUnits() * 4);
+
+    const auto build_params = KernelBuildParameters{
+        {"MIOPEN_USE_FP16", static_cast<int>(probsDesc.GetType() == miopenHalf)},
+        {"MIOPEN_USE_FP32", static_cast<int>(probsDesc.GetType() == miopenFloat)},
+        {"CLASS_SZ", class_sz},
+        {"BATCH_SZ", batch_size},
+        {"MAX_TSTEP", max_time_step},
+        {"PROBS_STRIDE0", strides[0]},
+        {"PROBS_STRIDE1", strides[1]},
+        {"BEAM_WIDTH", beamWidth},
+        {"NUM_TOP", std::min<std::size_t>(beamWidth, class_sz - 1)},
+        {"BLANK_LB_ID", blank_label_id},
+        {"SOFTMAX_APPLIED", static_cast<int>(apply_softmax_layer)},
+        {"WORK_PER_GRP", work_per_grp},
+        {"GRP_NUM", grp_num},
+    };
+
+    const std::vector<size_t> vld{work_per_grp, 1, 1};
+    const std::vector<size_t> vgd{grp_num * work_per_grp, 1, 1};
+
+    handle.AddKernel(kernel_name,
+                     network_config.str(),
+                     "MIOpenCTCDecode.cl",
+                     kernel_name,
+                     vld,
+                     vgd,
+                     build_params.GenerateFor(kbp::OpenCL{}))(
+        probs, inputLengths, decoded, decodedLengths, scores, workSpace);
+}
+
 } // namespace miopen
@@ -124,6 +124,10 @@ void DropoutDescriptor::InitPRNGState(Handle& handle,
 #if DROPOUT_DEBUG
     std::cout << "Check memory and threads info of dropout PRNG states in debug mode:" << std::endl;
 #endif
+    // Counter-based generator needs no states
+    if(rng_mode == MIOPEN_RNG_PHILOX)
+        return;
+
     std::string program_name = "MIOpenDropout.cl";
     std::string kernel_name  = "InitKernelState";
 
@@ -215,8 +219,7 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
     }
 
     bool use_rsvsp = !(reserveSpace == nullptr);
-    if(((use_rsvsp || use_mask) &&
-        reserveSpaceSizeInBytes < xDesc.GetElementSize() * sizeof(bool)) ||
+    if(((use_rsvsp || use_mask) && reserveSpaceSizeInBytes < GetReserveSpaceSize(xDesc)) ||
        (use_mask && reserveSpace == nullptr))
     {
         MIOPEN_THROW("Insufficient reservespace size");
@@ -252,17 +255,23 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
                        out_len,
                        out_str);
 
-    size_t RD_BLCK    = /* (in_len[4] % 4 == 0) ? 4 : */ (in_len[2] % 2 == 0) ? 2 : 1;
-    size_t total_work = (in_len[4] / RD_BLCK) * in_len[3] * in_len[2] * in_len[1] * in_len[0];
-
-    size_t max_wk_grp =
-        use_mask ? MAX_WORKITEM_NUM : std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth());
+    // A packed mask is processed a byte, i.e. 8 elements, per work-item
+    const size_t elem_num = in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0];
+    size_t RD_BLCK = /* (in_len[4] % 4 == 0) ? 4 : */ (in_len[2] % 2 == 0) ? 2 : 1;
+    if(mask_packed)
+        RD_BLCK = 1;
+    const size_t total_work = mask_packed ? elem_num : elem_num / RD_BLCK;
+    const int pack_mode     = mask_packed ? (in_len[4] % 8 == 0 ? 2 : 1) : 0;
+
+    const bool use_states = !use_mask && rng_mode != MIOPEN_RNG_PHILOX;
+    size_t max_wk_grp     = use_states
+                            ? std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth())
+                            : MAX_WORKITEM_NUM;
     size_t wk_grp_num =
-        std::min(max_wk_grp / 256,
-                 ((in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0] + 255) / 256));
+        std::min(max_wk_grp / 256, ((mask_packed ? (elem_num + 7) / 8 : elem_num) + 255) / 256);
 
     size_t states_num = stateSizeInBytes / sizeof(prngStates);
-    if(states_num < wk_grp_num * 256 && !use_mask)
+    if(states_num < wk_grp_num * 256 && use_states)
     {
         MIOPEN_THROW("Insufficient state size for parallel PRNG");
     }
@@ -275,7 +284,8 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
         std::to_string(seed) + "-rng" + std::to_string(rng_mode) + "-rsvsp" +
         std::to_string(static_cast<int>(use_rsvsp)) + "-mask" +
         std::to_string(static_cast<int>(use_mask)) + "-evo" +
-        std::to_string(static_cast<int>(state_evo)) + "-blk" + std::to_string(RD_BLCK) + "-wg" +
+        std::to_string(static_cast<int>(state_evo)) + "-blk" + std::to_string(RD_BLCK) + "-pack" +
+        std::to_string(pack_mode) + "-wg" +
         std::to_string(wk_grp_num) /* + "-noise" + std::to_string(noise_shape.GetLengths()[0])*/;
 
     // TODO: Add noise shape
@@ -308,7 +318,9 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
                         uint(total_work),
                         uint(in_offset),
                         uint(out_offset),
-                        uint(rsvsp_offset));
+                        uint(rsvsp_offset),
+                        seed,
+                        offset);
     }
     else
     {
@@ -322,6 +334,12 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
                   " -DREAD_BOOL_TYPE=" +
                   std::string(RD_BLCK == 4 ? "uint" : RD_BLCK == 2 ? "ushort" : "uchar");
 
+        if(mask_packed)
+        {
+            params += " -DPACK_MASK=1";
+            params += " -DMASK_VEC8=" + std::to_string(static_cast<int>(pack_mode == 2));
+        }
+
         if(xDesc.GetType() == miopenHalf)
             params += " -DMIOPEN_USE_FP16=1";
         else
@@ -332,6 +350,11 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
         params += " -DUSE_RSVSP=" + std::to_string(static_cast<size_t>(use_rsvsp));
         params += " -DUSE_MASK=" + std::to_string(static_cast<size_t>(use_mask));
 
+        if(rng_mode == MIOPEN_RNG_PHILOX)
+        {
+            params += " -DUSE_PHILOX=1";
+        }
+
         const std::vector<size_t> vld{256, 1, 1};
         const std::vector<size_t> vgd{wk_grp_num * 256, 1, 1};
 
@@ -357,7 +380,9 @@ void DropoutDescriptor::DropoutForward(const Handle& handle,
             uint(total_work),
             uint(in_offset),
             uint(out_offset),
-            uint(rsvsp_offset));
+            uint(rsvsp_offset),
+            seed,
+            offset);
     }
 
     if(miopen::CheckNumericsEnabled())
@@ -417,8 +442,7 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
     }
 
     bool use_prng = reserveSpace == nullptr;
-    if(((!use_prng || use_mask) &&
-        reserveSpaceSizeInBytes < dyDesc.GetElementSize() * sizeof(bool)) ||
+    if(((!use_prng || use_mask) && reserveSpaceSizeInBytes < GetReserveSpaceSize(dyDesc)) ||
        (use_mask && use_prng))
     {
         MIOPEN_THROW("Insufficient reservespace size");
@@ -453,16 +477,22 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
                        out_len,
                        out_str);
 
-    size_t RD_BLCK    = /* (in_len[4] % 4 == 0) ? 4 : */ (in_len[2] % 2 == 0) ? 2 : 1;
-    size_t total_work = (in_len[4] / RD_BLCK) * in_len[3] * in_len[2] * in_len[1] * in_len[0];
-
-    size_t max_wk_grp =
-        use_prng ? std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth()) : MAX_WORKITEM_NUM;
+    // A packed mask is processed a byte, i.e. 8 elements, per work-item
+    const size_t elem_num = in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0];
+    size_t RD_BLCK = /* (in_len[4] % 4 == 0) ? 4 : */ (in_len[2] % 2 == 0) ? 2 : 1;
+    if(mask_packed)
+        RD_BLCK = 1;
+    const size_t total_work = mask_packed ? elem_num : elem_num / RD_BLCK;
+    const int pack_mode     = mask_packed ? (in_len[4] % 8 == 0 ? 2 : 1) : 0;
+
+    const bool use_states = use_prng && rng_mode != MIOPEN_RNG_PHILOX;
+    size_t max_wk_grp     = use_states
+                            ? std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth())
+                            : MAX_WORKITEM_NUM;
     size_t wk_grp_num =
-        std::min(max_wk_grp / 256,
-                 ((in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0] + 255) / 256));
+        std::min(max_wk_grp / 256, ((mask_packed ? (elem_num + 7) / 8 : elem_num) + 255) / 256);
 
-    if(use_prng)
+    if(use_states)
     {
         size_t states_num = stateSizeInBytes / sizeof(prngStates);
         if(states_num < wk_grp_num * 256)
@@ -478,7 +508,8 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
         "bwd-" + std::string(dyDesc.GetType() == miopenHalf ? "fp16-" : "fp32-") + "-seed" +
         std::to_string(seed) + "-rng" + std::to_string(rng_mode) + "-prng" +
         std::to_string(static_cast<int>(use_prng)) + "-evo" +
-        std::to_string(static_cast<int>(state_evo)) + "-blk" + std::to_string(RD_BLCK) + "-wg" +
+        std::to_string(static_cast<int>(state_evo)) + "-blk" + std::to_string(RD_BLCK) + "-pack" +
+        std::to_string(pack_mode) + "-wg" +
         std::to_string(wk_grp_num) /* + "-noise" + std::to_string(noise_shape.GetLengths()[0]) */;
 
     // TODO: Add noise shape
@@ -511,7 +542,9 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
                         uint(total_work),
                         uint(in_offset),
                         uint(out_offset),
-                        uint(rsvsp_offset));
+                        uint(rsvsp_offset),
+                        seed,
+                        offset);
     }
     else
     {
@@ -530,6 +563,17 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
             params += " -DUSE_PRNG=1";
         }
 
+        if(rng_mode == MIOPEN_RNG_PHILOX)
+        {
+            params += " -DUSE_PHILOX=1";
+        }
+
+        if(mask_packed)
+        {
+            params += " -DPACK_MASK=1";
+            params += " -DMASK_VEC8=" + std::to_string(static_cast<int>(pack_mode == 2));
+        }
+
         if(dyDesc.GetType() == miopenHalf)
             params += " -DMIOPEN_USE_FP16=1";
         else
@@ -562,7 +606,9 @@ void DropoutDescriptor::DropoutBackward(const Handle& handle,
             uint(total_work),
             uint(in_offset),
             uint(out_offset),
-            uint(rsvsp_offset));
+            uint(rsvsp_offset),
+            seed,
+            offset);
     }
 
     if(miopen::CheckNumericsEnabled())
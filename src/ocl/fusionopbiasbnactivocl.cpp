@@ -202,13 +202,8 @@ miopenStatus_t BatchNormInferenceFusionOpDescriptor::GetCompileParms(
 
     // The output_desc should be fully formed by this stage.
     std::tie(n, c, h, w) = tien<4>(input_desc.GetLengths());
-    size_t read_unit     = 1;
     size_t read_len      = (mode == miopenBNSpatial) ? h * w : c * h * w;
-
-    if(mode == miopenBNSpatial && input_desc.GetType() != miopenHalf)
-    {
-        read_unit = (read_len % 4 == 0) ? 4 : (read_len % 2 == 0) ? 2 : 1;
-    }
+    size_t read_unit     = (read_len % 4 == 0) ? 4 : (read_len % 2 == 0) ? 2 : 1;
 
     if(input_desc.GetType() == miopenHalf)
     {
@@ -248,13 +243,8 @@ BatchNormInferenceFusionOpDescriptor::GetGlobalWGSz(Handle& /*handle*/,
 
     // The output_desc should be fully formed by this stage.
     std::tie(n, c, h, w) = tien<4>(input_desc.GetLengths());
-    size_t read_unit     = 1;
     size_t read_len      = (mode == miopenBNSpatial) ? h * w : c * h * w;
-
-    if(mode == miopenBNSpatial && input_desc.GetType() != miopenHalf)
-    {
-        read_unit = (read_len % 4 == 0) ? 4 : (read_len % 2 == 0) ? 2 : 1;
-    }
+    size_t read_unit     = (read_len % 4 == 0) ? 4 : (read_len % 2 == 0) ? 2 : 1;
 
     size_t xgridsize = read_len / read_unit;
     size_t ygridsize = (mode == miopenBNSpatial) ? size_t(c) : 1;
@@ -14,6 +14,7 @@ mlo_construct_direct2D_fusion ConvForwardOpDescriptor::ConstructParams(Handle& h
     mlo_construct_direct2D_fusion construct_params(
         input_desc, filter_desc, o_desc, base_desc, miopen::conv::Direction::Forward);
     construct_params.setStream(&handle);
+    construct_params.EnableAutoTune(tune);
     return construct_params;
 }
 miopenStatus_t ConvForwardOpDescriptor::GetNetworkConfig(std::string& network_config,
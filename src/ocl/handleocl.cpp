@@ -25,8 +25,10 @@
  *******************************************************************************/
 
 #include <miopen/handle.hpp>
+#include <miopen/db_write_batch.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/compile_stats.hpp>
 #include <miopen/config.h>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
@@ -35,6 +37,7 @@
 #include <miopen/kernel_cache.hpp>
 #include <miopen/load_file.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
 #include <miopen/timer.hpp>
@@ -45,7 +48,10 @@
 
 #include <boost/filesystem.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -68,6 +74,27 @@ void* default_allocator(void* context, size_t sz)
 
 void default_deallocator(void*, void* mem) { clReleaseMemObject(DataCast(mem)); }
 
+namespace {
+
+std::uint64_t NextHandleId()
+{
+    static std::atomic<std::uint64_t> next_id{1};
+    return next_id++;
+}
+
+// Stream pool index selected by the calling thread, per handle id.
+std::unordered_map<std::uint64_t, int>& ThreadStreamIndices()
+{
+    static thread_local std::unordered_map<std::uint64_t, int> indices;
+    return indices;
+}
+
+using EventPtr = miopen::manage_ptr<typename std::remove_pointer<cl_event>::type,
+                                    decltype(&clReleaseEvent),
+                                    &clReleaseEvent>;
+
+} // namespace
+
 struct HandleImpl
 {
 
@@ -86,6 +113,48 @@ struct HandleImpl
     bool enable_profiling  = false;
     float profiling_result = 0.0;
     TargetProperties target_properties;
+    const std::uint64_t id = NextHandleId();
+    // Queues 1..N of the pool, queue 0 is the one above.
+    std::vector<AqPtr> extra_queues;
+
+    cl_command_queue get_queue(int index) const
+    {
+        return index == 0 ? queue.get() : extra_queues[index - 1].get();
+    }
+
+    int get_queue_index() const
+    {
+        if(extra_queues.empty())
+            return 0;
+        const auto& indices = ThreadStreamIndices();
+        const auto it       = indices.find(id);
+        return it == indices.end() ? 0 : it->second;
+    }
+
+    /// The queues of the pool are in order, and have the properties of the main one, so that
+    /// profiling works the same on all of them.
+    AqPtr create_queue() const
+    {
+        cl_command_queue_properties properties = 0;
+        auto status                            = clGetCommandQueueInfo(
+            queue.get(), CL_QUEUE_PROPERTIES, sizeof(properties), &properties, nullptr);
+        if(status != CL_SUCCESS)
+            MIOPEN_THROW_CL_STATUS(status, "Failed to get the properties of the queue");
+        properties &= ~static_cast<cl_command_queue_properties>(
+            CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+        auto result =
+            AqPtr{clCreateCommandQueue(context.get(), device, properties, &status)};
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+        if(status != CL_SUCCESS)
+            MIOPEN_THROW_CL_STATUS(status, "Failed to allocate a queue of the pool");
+        return result;
+    }
 
     std::string get_device_name() const
     {
@@ -260,7 +329,12 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+Handle::~Handle()
+{
+    FlushDbWrites();
+    CompileStats::Get().Dump();
+    Metrics::Dump();
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -275,7 +349,56 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
     MIOPEN_LOG_NQI(*this);
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const { return impl->queue.get(); }
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    return impl->get_queue(impl->get_queue_index());
+}
+
+void Handle::ReserveExtraStreamsInPool(int count) const
+{
+    for(auto i = 0; i < count; ++i)
+        impl->extra_queues.push_back(impl->create_queue());
+    MIOPEN_LOG_I2("Streams in pool: " << GetStreamPoolSize());
+}
+
+void Handle::SetStreamFromPool(int index) const
+{
+    if(index < 0 || index >= GetStreamPoolSize())
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Stream index " + std::to_string(index) + " is out of the pool");
+    if(index == 0)
+        ThreadStreamIndices().erase(impl->id);
+    else
+        ThreadStreamIndices()[impl->id] = index;
+}
+
+int Handle::GetStreamIndexFromPool() const { return impl->get_queue_index(); }
+
+int Handle::GetStreamPoolSize() const { return 1 + static_cast<int>(impl->extra_queues.size()); }
+
+void Handle::WaitStreamInPool(int waiting, int signaling) const
+{
+    for(const auto index : {waiting, signaling})
+    {
+        if(index < 0 || index >= GetStreamPoolSize())
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Stream index " + std::to_string(index) + " is out of the pool");
+    }
+    if(waiting == signaling)
+        return;
+
+    // The barrier retains the event, so it is released right after being enqueued.
+    cl_event marker = nullptr;
+    auto status = clEnqueueMarkerWithWaitList(impl->get_queue(signaling), 0, nullptr, &marker);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "Failed to enqueue a marker on the stream pool");
+    const auto event = EventPtr{marker};
+    status = clEnqueueBarrierWithWaitList(impl->get_queue(waiting), 1, &marker, nullptr);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "Failed to wait for a marker on the stream pool");
+}
+
+std::vector<Handle*> Handle::GetPeers() const { return {}; }
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
@@ -294,6 +417,12 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
 
+void Handle::DeferKernelTimes(bool /* enable */) const {}
+
+bool Handle::IsKernelTimeDeferred() const { return false; }
+
+void Handle::FlushKernelTimes() const {}
+
 void Handle::ResetKernelTime() const { this->impl->ResetProfilingResult(); }
 void Handle::AccumKernelTime(float curr_time) const { this->impl->AccumProfilingResult(curr_time); }
 
@@ -357,8 +486,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -389,6 +518,7 @@ Program Handle::LoadProgram(const std::string& program_name,
                                     program_name,
                                     params,
                                     is_kernel_str);
+    AddMetric(*this, hsaco.empty() ? Metric::BinaryCacheMisses : Metric::BinaryCacheHits);
     if(hsaco.empty())
     {
         CompileTimer ct;
@@ -400,6 +530,8 @@ Program Handle::LoadProgram(const std::string& program_name,
                                      is_kernel_str,
                                      kernel_src);
         ct.Log("Kernel", is_kernel_str ? std::string() : program_name);
+        CompileStats::Get().AddBuild(is_kernel_str ? "tinygemm.cl" : program_name, ct.ElapsedMs());
+        AddMetricTime(*this, Metric::Compiles, Metric::CompileUs, ct.ElapsedMs());
 
 // Save to cache
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -443,6 +575,18 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
+void Handle::RemoveProgram(const std::string& program_name, const std::string& params) const
+{
+    this->impl->cache.RemoveProgram(program_name, params);
+}
+
+std::size_t Handle::GetCodeObjectsSize() const { return this->impl->cache.GetCodeObjectsSize(); }
+
+std::vector<std::pair<std::pair<std::string, std::string>, Program>> Handle::GetPrograms() const
+{
+    return this->impl->cache.GetPrograms();
+}
+
 void Handle::Finish() const { clFinish(this->GetStream()); }
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
@@ -487,6 +631,15 @@ std::size_t Handle::GetMaxComputeUnits() const
     return miopen::GetDeviceInfo<CL_DEVICE_MAX_COMPUTE_UNITS>(miopen::GetDevice(this->GetStream()));
 }
 
+std::size_t Handle::GetMaxClockFrequency() const
+{
+    return miopen::GetDeviceInfo<CL_DEVICE_MAX_CLOCK_FREQUENCY>(
+        miopen::GetDevice(this->GetStream()));
+}
+
+// Not exposed by OpenCL.
+std::size_t Handle::GetCurrentClockFrequency() const { return 0; }
+
 std::size_t Handle::GetImage3dMaxWidth() const
 {
     return miopen::GetDeviceInfo<CL_DEVICE_IMAGE3D_MAX_WIDTH>(miopen::GetDevice(this->GetStream()));
@@ -501,8 +654,10 @@ std::size_t Handle::GetWavefrontWidth() const
 Allocator::ManageDataPtr Handle::Create(std::size_t sz) const
 {
     MIOPEN_HANDLE_LOCK
+    AddMetric(*this, Metric::Allocations);
+    AddMetric(*this, Metric::AllocatedBytes, sz);
     this->Finish();
-    return this->impl->allocator(sz);
+    return Allocator::Track(this->impl->allocator(sz), sz, memory_usage);
 }
 
 Allocator::ManageDataPtr&
@@ -531,6 +686,92 @@ void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size
     }
 }
 
+// The queues are in order, so the transfers need no Finish(). The writes block, as the host data
+// may be released once they return.
+void Handle::WriteToAsync(const void* data, Data_t ddata, std::size_t sz, std::size_t offset) const
+{
+    if(sz == 0)
+        return;
+    auto status = clEnqueueWriteBuffer(
+        this->GetStream(), ddata, CL_TRUE, offset, sz, data, 0, nullptr, nullptr);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error writing to buffer: " + std::to_string(sz));
+}
+
+void Handle::ReadToOrdered(void* data, ConstData_t ddata, std::size_t sz) const
+{
+    if(sz == 0)
+        return;
+    auto status = clEnqueueReadBuffer(
+        this->GetStream(), ddata, CL_TRUE, 0, sz, data, 0, nullptr, nullptr);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error reading from buffer: " + std::to_string(sz));
+}
+
+void Handle::CopyAsync(ConstData_t src, Data_t dest, std::size_t size) const
+{
+    auto status =
+        clEnqueueCopyBuffer(this->GetStream(), src, dest, 0, 0, size, 0, nullptr, nullptr);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error copying buffer: " + std::to_string(size));
+}
+
+void Handle::ZeroAsync(Data_t ddata, std::size_t sz) const
+{
+    const auto zero = cl_uchar{0};
+    auto status     = clEnqueueFillBuffer(
+        this->GetStream(), ddata, &zero, sizeof(zero), 0, sz, 0, nullptr, nullptr);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error clearing buffer: " + std::to_string(sz));
+}
+
+void Handle::Copy2DAsync(ConstData_t src,
+                         std::size_t src_offset,
+                         std::size_t src_pitch,
+                         Data_t dest,
+                         std::size_t dest_offset,
+                         std::size_t dest_pitch,
+                         std::size_t width,
+                         std::size_t height) const
+{
+    const std::size_t src_origin[]  = {src_offset, 0, 0};
+    const std::size_t dest_origin[] = {dest_offset, 0, 0};
+    const std::size_t region[]      = {width, height, 1};
+
+    auto status = clEnqueueCopyBufferRect(this->GetStream(),
+                                          src,
+                                          dest,
+                                          src_origin,
+                                          dest_origin,
+                                          region,
+                                          src_pitch,
+                                          0,
+                                          dest_pitch,
+                                          0,
+                                          0,
+                                          nullptr,
+                                          nullptr);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status,
+                               "OpenCL error copying buffer: " + std::to_string(width) + "x" +
+                                   std::to_string(height));
+}
+
+void Handle::FillAsync(Data_t ddata,
+                       std::size_t offset,
+                       std::size_t sz,
+                       const void* pattern,
+                       std::size_t pattern_size) const
+{
+    if(pattern_size != 1 && pattern_size != 2 && pattern_size != 4)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Unsupported fill pattern size: " + std::to_string(pattern_size));
+    auto status = clEnqueueFillBuffer(
+        this->GetStream(), ddata, pattern, pattern_size, offset, sz, 0, nullptr, nullptr);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "OpenCL error filling buffer: " + std::to_string(sz));
+}
+
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size) const
 {
     MIOPEN_HANDLE_LOCK
@@ -27,9 +27,77 @@
 #include <miopen/mlo_internal.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/visit_float.hpp>
+#include <miopen/datatype.hpp>
 
 namespace miopen {
 
+// The NCHW kernels of mlo_construct_norm read channel planes; packed channel-last tensors go to
+// MIOpenLRNNHWC.cl instead.
+bool IsLRNNHWC(const TensorDescriptor& desc)
+{
+    int c, h, w;
+    std::tie(std::ignore, c, h, w) = tien<4>(desc.GetLengths());
+    const auto& str                = desc.GetStrides();
+    return c > 1 && str[1] == 1 && str[3] == c && str[2] == w * c && str[0] == h * w * c;
+}
+
+template <class... Args>
+static void RunLRNNHWC(Handle& handle,
+                       const std::string& kernel_name,
+                       const TensorDescriptor& desc,
+                       int local_area,
+                       int pre_pad,
+                       bool do_scale,
+                       Args&&... args)
+{
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(desc.GetLengths());
+
+    if(c + local_area - 1 > 2048)
+        MIOPEN_THROW(miopenStatusNotImplemented, "NHWC LRN supports up to 2048 padded channels");
+
+    const int vec           = (c % 4 == 0) ? 4 : (c % 2 == 0) ? 2 : 1;
+    const size_t cvecs      = c / vec;
+    const size_t lcl_width  = c + local_area - 1;
+    const std::size_t pixes = static_cast<std::size_t>(n) * h * w;
+
+    size_t grp0 = 1;
+    while(grp0 < cvecs && grp0 < 64)
+        grp0 *= 2;
+    size_t grp1 = 256 / grp0;
+    while(grp1 > 1 && grp1 * lcl_width > 8192)
+        grp1 /= 2;
+
+    const std::vector<size_t> vld{grp0, grp1, 1};
+    const std::vector<size_t> vgd{grp0, (pixes + grp1 - 1) / grp1 * grp1, 1};
+
+    const std::string algo_name      = "miopenLRNNHWC";
+    const std::string network_config = kernel_name + "_dt" + std::to_string(desc.GetType()) +
+                                       "_c" + std::to_string(c) + "_p" + std::to_string(pixes) +
+                                       "_n" + std::to_string(local_area) + "_pre" +
+                                       std::to_string(pre_pad) + "_s" +
+                                       std::to_string(static_cast<int>(do_scale));
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(std::forward<Args>(args)..., static_cast<unsigned>(pixes));
+        return;
+    }
+
+    const std::string parms = GetDataTypeKernelParams(desc.GetType()) +
+                              " -DMLO_LRN_C=" + std::to_string(c) +
+                              " -DMLO_LRN_KERNEL_SZ=" + std::to_string(local_area) +
+                              " -DMLO_LRN_PRE_PAD=" + std::to_string(pre_pad) +
+                              " -DMLO_LRN_VEC=" + std::to_string(vec) +
+                              " -DMLO_LRN_DO_SCALE=" + std::to_string(static_cast<int>(do_scale)) +
+                              " -DMLO_LRN_GROUP_SZ0=" + std::to_string(grp0) +
+                              " -DMLO_LRN_GROUP_SZ1=" + std::to_string(grp1);
+
+    handle.AddKernel(algo_name, network_config, "MIOpenLRNNHWC.cl", kernel_name, vld, vgd, parms)(
+        std::forward<Args>(args)..., static_cast<unsigned>(pixes));
+}
+
 miopenStatus_t LRNDescriptor::Forward(Handle& handle,
                                       const void* /*alpha*/,
                                       const TensorDescriptor& xDesc,
@@ -44,6 +112,30 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
         MIOPEN_THROW("Only support packed tensors");
 
     miopenStatus_t status = miopenStatusSuccess;
+
+    if(IsLRNNHWC(xDesc) && IsLRNNHWC(yDesc))
+    {
+        if(GetMode() != miopenLRNCrossChannel)
+            MIOPEN_THROW(miopenStatusNotImplemented, "NHWC LRN supports cross-channel mode only");
+        if(float_equal(GetK(), 0.0))
+            MIOPEN_THROW("Expect non-zero bias/K");
+
+        const int local_area = static_cast<int>(GetN());
+        RunLRNNHWC(handle,
+                   "MIOpenLRNCrossChannelNHWCFwd",
+                   xDesc,
+                   local_area,
+                   (local_area - 1) / 2,
+                   do_backward,
+                   x,
+                   y,
+                   workSpace,
+                   static_cast<float>(GetAlpha() / local_area),
+                   static_cast<float>(GetBeta()),
+                   static_cast<float>(GetK()));
+        return status;
+    }
+
     mlo_construct_norm construct_params(conv::Direction::Forward);
 
     construct_params.setStream(&handle);
@@ -117,31 +209,8 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
         std::to_string(hOut) + std::to_string(wIn) + std::to_string(wOut);
 
     auto&& kernels = handle.GetKernels(algo_name, network_config);
-    if(!kernels.empty())
-    {
-        visit_float(xDesc.GetType(), [&](auto as_float) {
-            if(do_backward)
-            {
-                kernels.front()(x,
-                                y,
-                                workSpace,
-                                as_float(f_norm_alphaoverarea),
-                                as_float(f_norm_alpha),
-                                as_float(f_norm_beta),
-                                as_float(f_norm_K));
-            }
-            else
-            {
-                kernels.front()(x,
-                                y,
-                                as_float(f_norm_alphaoverarea),
-                                as_float(f_norm_alpha),
-                                as_float(f_norm_beta),
-                                as_float(f_norm_K));
-            }
-        });
-    }
-    else
+    auto obj       = kernels.empty() ? KernelInvoke{} : kernels.front();
+    if(kernels.empty())
     {
         const std::string program_name = construct_params.getKernelFile(); // CL kernel filename
         const std::string kernel_name  = construct_params.getKernelName(); // kernel name
@@ -150,30 +219,43 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
         const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
-        KernelInvoke obj = handle.AddKernel(
+        obj = handle.AddKernel(
             algo_name, network_config, program_name, kernel_name, vld, vgd, compiler_parms);
-        visit_float(xDesc.GetType(), [&](auto as_float) {
-            if(do_backward)
+    }
+
+    visit_float(xDesc.GetType(), [&](auto as_float) {
+        const auto run = [&](auto... buffers) {
+            if(construct_params.isDynamicShape())
             {
-                obj(x,
-                    y,
-                    workSpace,
+                obj(buffers...,
                     as_float(f_norm_alphaoverarea),
                     as_float(f_norm_alpha),
                     as_float(f_norm_beta),
-                    as_float(f_norm_K));
+                    as_float(f_norm_K),
+                    nIn,
+                    nInStride,
+                    cInStride,
+                    hInStride,
+                    nOutStride,
+                    cOutStride,
+                    hOutStride,
+                    wOut,
+                    hOut);
             }
             else
             {
-                obj(x,
-                    y,
+                obj(buffers...,
                     as_float(f_norm_alphaoverarea),
                     as_float(f_norm_alpha),
                     as_float(f_norm_beta),
                     as_float(f_norm_K));
             }
-        });
-    }
+        };
+        if(do_backward)
+            run(x, y, workSpace);
+        else
+            run(x, y);
+    });
     return (status);
 }
 
@@ -191,6 +273,30 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
                                        ConstData_t workSpace) const
 {
     miopenStatus_t status = miopenStatusSuccess;
+
+    if(IsLRNNHWC(xDesc) && IsLRNNHWC(yDesc) && IsLRNNHWC(dxDesc) && IsLRNNHWC(dyDesc))
+    {
+        if(GetMode() != miopenLRNCrossChannel)
+            MIOPEN_THROW(miopenStatusNotImplemented, "NHWC LRN supports cross-channel mode only");
+
+        // The scale saved by the forward pass is reused, the window is mirrored.
+        const int local_area = static_cast<int>(GetN());
+        RunLRNNHWC(handle,
+                   "MIOpenLRNCrossChannelNHWCBwd",
+                   xDesc,
+                   local_area,
+                   local_area - (local_area - 1) / 2 - 1,
+                   false,
+                   y,
+                   x,
+                   dy,
+                   workSpace,
+                   dx,
+                   static_cast<float>(2. * GetAlpha() * GetBeta() / local_area),
+                   static_cast<float>(GetBeta()));
+        return status;
+    }
+
     mlo_construct_norm construct_params(conv::Direction::BackwardData);
 
     construct_params.setStream(&handle);
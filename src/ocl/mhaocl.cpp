@@ -0,0 +1,264 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/mha.hpp>
+
+#include <miopen/check_numerics.hpp>
+#include <miopen/dropout.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/find_solution.hpp>
+#include <miopen/float_equal.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/mha/invoke_params.hpp>
+#include <miopen/mha/problem_description.hpp>
+#include <miopen/mha/solvers.hpp>
+#include <miopen/tensor.hpp>
+
+namespace miopen {
+
+static void CheckMhaDescriptors(const TensorDescriptor& qDesc,
+                                const TensorDescriptor& kDesc,
+                                const TensorDescriptor& vDesc,
+                                const TensorDescriptor& oDesc)
+{
+    const auto& q_lens = qDesc.GetLengths();
+    const auto& k_lens = kDesc.GetLengths();
+    if(q_lens.size() != 4 || k_lens.size() != 4)
+        MIOPEN_THROW(miopenStatusBadParm, "The attention tensors have to be [B, H, S, D].");
+    if(q_lens[0] != k_lens[0] || q_lens[1] != k_lens[1] || q_lens[3] != k_lens[3])
+        MIOPEN_THROW(miopenStatusBadParm, "q and k have to match in B, H and D.");
+    if(vDesc.GetLengths() != k_lens || oDesc.GetLengths() != q_lens)
+        MIOPEN_THROW(miopenStatusBadParm, "v has to match k and the output has to match q.");
+    if(kDesc.GetType() != qDesc.GetType() || vDesc.GetType() != qDesc.GetType() ||
+       oDesc.GetType() != qDesc.GetType())
+        MIOPEN_THROW(miopenStatusBadParm, "The attention tensors have to be of one type.");
+    if(!qDesc.IsPacked() || !kDesc.IsPacked() || !vDesc.IsPacked() || !oDesc.IsPacked())
+    {
+        MIOPEN_LOG_E("Only fully packed tensors supported.");
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+}
+
+// Backward replays the mask of every probability instead of storing the Sq x Sk of them.
+static void CheckMhaDropout(const DropoutDescriptor* dropoutDesc)
+{
+    if(dropoutDesc == nullptr)
+        return;
+    if(dropoutDesc->rng_mode != MIOPEN_RNG_PHILOX || dropoutDesc->use_mask)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The fused dropout needs MIOPEN_RNG_PHILOX and no saved mask.");
+    if(dropoutDesc->dropout < 0.0 || dropoutDesc->dropout > 1.0)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid dropout rate");
+}
+
+template <class Params>
+static void SetMhaDropoutParams(Params& params, const DropoutDescriptor* dropoutDesc)
+{
+    if(dropoutDesc == nullptr)
+        return;
+    const auto rate = dropoutDesc->dropout;
+
+    params.dropout       = rate;
+    params.dropout_scale = float_equal(rate, 1.0f) ? 0.0 : 1.0 / (1.0 - rate);
+    params.seed          = dropoutDesc->seed;
+    params.offset        = dropoutDesc->offset;
+}
+
+void MhaForward(Handle& handle,
+                const TensorDescriptor& qDesc,
+                ConstData_t q,
+                const TensorDescriptor& kDesc,
+                ConstData_t k,
+                const TensorDescriptor& vDesc,
+                ConstData_t v,
+                float scale,
+                bool causal,
+                const DropoutDescriptor* dropoutDesc,
+                const TensorDescriptor& oDesc,
+                Data_t o,
+                Data_t lse)
+{
+    if(q == nullptr || k == nullptr || v == nullptr || o == nullptr || lse == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+    CheckMhaDescriptors(qDesc, kDesc, vDesc, oDesc);
+    CheckMhaDropout(dropoutDesc);
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, qDesc, q);
+        miopen::checkNumericsInput(handle, kDesc, k);
+        miopen::checkNumericsInput(handle, vDesc, v);
+    }
+
+    const auto problem = mha::ProblemDescription{
+        mha::Direction::Forward, qDesc, kDesc, causal, dropoutDesc != nullptr};
+
+    const auto invoke_params = [&]() {
+        auto tmp  = mha::InvokeParams{};
+        tmp.type  = InvokeType::Run;
+        tmp.q     = q;
+        tmp.k     = k;
+        tmp.v     = v;
+        tmp.o     = o;
+        tmp.lse   = lse;
+        tmp.scale = scale;
+        SetMhaDropoutParams(tmp, dropoutDesc);
+        return tmp;
+    }();
+
+    const auto algo           = AlgorithmName{"miopenMhaForward"};
+    const auto network_config = problem.MakeNetworkConfig();
+
+    if(const auto existingInvoker = handle.GetInvoker(network_config, boost::none, algo))
+    {
+        (*existingInvoker)(handle, invoke_params);
+    }
+    else
+    {
+        const auto ctx     = ExecutionContext{&handle};
+        const auto solvers = solver::SolverContainer<solver::mha::MhaFwd>{};
+        const auto slns    = solvers.SearchForSolutions(ctx, problem, 1);
+
+        if(slns.empty())
+            MIOPEN_THROW(miopenStatusNotImplemented, "No solver found for attention forward.");
+
+        const auto& sln = slns.front();
+        if(!sln.invoker_factory)
+            MIOPEN_THROW(miopenStatusInternalError, "Invoker missing in solver " + sln.solver_id);
+        const auto invoker = handle.PrepareInvoker(*sln.invoker_factory, sln.construction_params);
+        handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
+        invoker(handle, invoke_params);
+    }
+
+    if(miopen::CheckNumericsEnabled())
+        miopen::checkNumericsOutput(handle, oDesc, o);
+}
+
+std::size_t GetMhaBackwardWorkspaceSize(const TensorDescriptor& qDesc)
+{
+    if(qDesc.GetLengths().size() != 4)
+        MIOPEN_THROW(miopenStatusBadParm, "The attention tensors have to be [B, H, S, D].");
+    return mha::ProblemDescription{mha::Direction::Backward, qDesc, qDesc, false, false}
+        .GetBackwardWorkspaceSize();
+}
+
+void MhaBackward(Handle& handle,
+                 const TensorDescriptor& qDesc,
+                 ConstData_t q,
+                 const TensorDescriptor& kDesc,
+                 ConstData_t k,
+                 const TensorDescriptor& vDesc,
+                 ConstData_t v,
+                 const TensorDescriptor& oDesc,
+                 ConstData_t o,
+                 const TensorDescriptor& doDesc,
+                 ConstData_t dout,
+                 ConstData_t lse,
+                 float scale,
+                 bool causal,
+                 const DropoutDescriptor* dropoutDesc,
+                 const TensorDescriptor& dqDesc,
+                 Data_t dq,
+                 const TensorDescriptor& dkDesc,
+                 Data_t dk,
+                 const TensorDescriptor& dvDesc,
+                 Data_t dv,
+                 Data_t workSpace,
+                 std::size_t workSpaceSize)
+{
+    if(q == nullptr || k == nullptr || v == nullptr || o == nullptr || dout == nullptr ||
+       lse == nullptr || dq == nullptr || dk == nullptr || dv == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    CheckMhaDescriptors(qDesc, kDesc, vDesc, oDesc);
+    CheckMhaDescriptors(dqDesc, dkDesc, dvDesc, doDesc);
+    if(dqDesc.GetLengths() != qDesc.GetLengths() || dkDesc.GetLengths() != kDesc.GetLengths() ||
+       dqDesc.GetType() != qDesc.GetType())
+        MIOPEN_THROW(miopenStatusBadParm, "The gradients have to match their tensors.");
+    CheckMhaDropout(dropoutDesc);
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, qDesc, q);
+        miopen::checkNumericsInput(handle, kDesc, k);
+        miopen::checkNumericsInput(handle, vDesc, v);
+        miopen::checkNumericsInput(handle, doDesc, dout);
+    }
+
+    const auto problem = mha::ProblemDescription{
+        mha::Direction::Backward, qDesc, kDesc, causal, dropoutDesc != nullptr};
+
+    const auto invoke_params = [&]() {
+        auto tmp          = mha::BwdInvokeParams{};
+        tmp.type          = InvokeType::Run;
+        tmp.q             = q;
+        tmp.k             = k;
+        tmp.v             = v;
+        tmp.o             = o;
+        tmp.dout          = dout;
+        tmp.lse           = lse;
+        tmp.dq            = dq;
+        tmp.dk            = dk;
+        tmp.dv            = dv;
+        tmp.workSpace     = workSpace;
+        tmp.workSpaceSize = workSpaceSize;
+        tmp.scale         = scale;
+        SetMhaDropoutParams(tmp, dropoutDesc);
+        return tmp;
+    }();
+
+    const auto algo           = AlgorithmName{"miopenMhaBackward"};
+    const auto network_config = problem.MakeNetworkConfig();
+
+    if(const auto existingInvoker = handle.GetInvoker(network_config, boost::none, algo))
+    {
+        (*existingInvoker)(handle, invoke_params);
+    }
+    else
+    {
+        const auto ctx     = ExecutionContext{&handle};
+        const auto solvers = solver::SolverContainer<solver::mha::MhaBwd>{};
+        const auto slns    = solvers.SearchForSolutions(ctx, problem, 1);
+
+        if(slns.empty())
+            MIOPEN_THROW(miopenStatusNotImplemented, "No solver found for attention backward.");
+
+        const auto& sln = slns.front();
+        if(!sln.invoker_factory)
+            MIOPEN_THROW(miopenStatusInternalError, "Invoker missing in solver " + sln.solver_id);
+        const auto invoker = handle.PrepareInvoker(*sln.invoker_factory, sln.construction_params);
+        handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
+        invoker(handle, invoke_params);
+    }
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsOutput(handle, dqDesc, dq);
+        miopen::checkNumericsOutput(handle, dkDesc, dk);
+        miopen::checkNumericsOutput(handle, dvDesc, dv);
+    }
+}
+
+} // namespace miopen
@@ -51,8 +51,11 @@ POSSIBILITY OF SUCH DAMAGE.
 #define MIOPEN
 #include <miopen/mlo_internal.hpp>
 #include <miopen/mlo_utils.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_LRN_DYNAMIC_SHAPE)
+
 // KNOWN ISSUES:
 // backward propogagation has a bug in cross map normalization when numper of maps less than
 // normalization region
@@ -137,6 +140,8 @@ int mlo_construct_norm::mloConstructFwd()
     _kernel_file = "MIOpenLRNFwd.cl";
     _kernel_name = (_norm_region == MLO_LRN_ACROSS_CHANNELS) ? "MIOpenLRNAcrossChannels4"
                                                              : "MIOpenLRNWithinChannel_PS";
+    _dynamic_shape = _norm_region != MLO_LRN_ACROSS_CHANNELS &&
+                     miopen::IsEnabled(MIOPEN_DEBUG_LRN_DYNAMIC_SHAPE{});
     if(_norm_region == MLO_LRN_ACROSS_CHANNELS)
     {
         _grp_tile0  = 8 * 8;
@@ -191,6 +196,7 @@ int mlo_construct_norm::mloConstructFwd()
     std::string READ_TYPE =
         (read_unit == 1) ? "_FLOAT" : "_FLOAT" + std::to_string(static_cast<long long>(read_unit));
 
+    // The tiling of the kernel.
     _comp_options =
         std::string(" -DMLO_LRN_KERNEL_SZ=") + std::to_string(static_cast<long long>(_norm_area)) +
         std::string(" -DMLO_LRN_PAD=") + std::to_string(static_cast<long long>(pad)) +
@@ -201,10 +207,6 @@ int mlo_construct_norm::mloConstructFwd()
         std::string(" -DMLO_LRN_PRE_PAD=") + std::to_string(static_cast<long long>(pre_pad)) +
         std::string(" -DMLO_LRN_PRE_PAD1=") + std::to_string(static_cast<long long>(pre_pad)) +
         std::string(" -DMLO_LRN_PRE_PAD0=") + std::to_string(static_cast<long long>(pre_pad)) +
-        std::string(" -DMLO_LRN_N_OUTPUTS=") +
-        std::to_string(static_cast<long long>(_search_params.n_outputs)) +
-        std::string(" -DMLO_LRN_N_INPUTS=") +
-        std::to_string(static_cast<long long>(_search_params.n_inputs)) +
         std::string(" -DMLO_LRN_N_HORIZ_OUT_PIX=") +
         std::to_string(static_cast<long long>(_out_pix_tile0)) +
         std::string(" -DMLO_LRN_N_VERT_OUT_PIX=") +
@@ -215,32 +217,6 @@ int mlo_construct_norm::mloConstructFwd()
         std::to_string(static_cast<long long>(ocl_group_lg2sz0)) +
         std::string(" -DMLO_LRN_GROUP_LG2SZ1=") +
         std::to_string(static_cast<long long>(ocl_group_lg2sz1)) +
-        std::string(" -DMLO_LRN_BOT_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(_search_params.in_batch_stride)) +
-        std::string(" -DMLO_LRN_BOT_CHANNEL_STRIDE=") +
-        std::to_string(static_cast<long long>(_search_params.in_channel_stride)) +
-        std::string(" -DMLO_LRN_BOT_STRIDE=") +
-        std::to_string(static_cast<long long>(_search_params.in_stride)) +
-        std::string(" -DMLO_LRN_TOP_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(_search_params.out_batch_stride)) +
-        std::string(" -DMLO_LRN_TOP_CHANNEL_STRIDE=") +
-        std::to_string(static_cast<long long>(_search_params.out_channel_stride)) +
-        std::string(" -DMLO_LRN_TOP_STRIDE=") +
-        std::to_string(static_cast<long long>(_search_params.out_stride)) +
-        std::string(" -DMLO_LRN_BOT_WIDTH=") +
-        std::to_string(static_cast<long long>(_search_params.out_width)) +
-        std::string(" -DMLO_LRN_BOT_HEIGHT=") +
-        std::to_string(static_cast<long long>(_search_params.out_height)) +
-        std::string(" -DMLO_LRN_TOP_WIDTH=") +
-        std::to_string(static_cast<long long>(_search_params.out_width)) +
-        std::string(" -DMLO_LRN_TOP_HEIGHT=") +
-        std::to_string(static_cast<long long>(_search_params.out_height)) +
-        std::string(" -DMLO_LRN_SCALE_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(scale_batch_stride)) +
-        std::string(" -DMLO_LRN_SCALE_CHANNEL_STRIDE=") +
-        std::to_string(static_cast<long long>(scale_channel_stride)) +
-        std::string(" -DMLO_LRN_SCALE_STRIDE=") +
-        std::to_string(static_cast<long long>(scale_stride)) +
         std::string(" -DMLO_LRN_TOPDF_BATCH_STRIDE=") +
         std::to_string(static_cast<long long>(top_df_batch_stride)) +
         std::string(" -DMLO_LRN_TOPDF_CHANNEL_STRIDE=") +
@@ -253,23 +229,63 @@ int mlo_construct_norm::mloConstructFwd()
         std::to_string(static_cast<long long>(bot_df_channel_stride)) +
         std::string(" -DMLO_LRN_BOTDF_STRIDE=") +
         std::to_string(static_cast<long long>(bot_df_stride)) +
-        std::string(" -DMLO_LRN_BATCH_SZ=") +
-        std::to_string(static_cast<long long>(_search_params.batch_sz)) +
-        std::string(" -DMLO_LRN_N_INPUTS=") +
-        std::to_string(static_cast<long long>(_search_params.n_inputs)) +
-        std::string(" -DMLO_LRN_N_OUTPUTS=") +
-        std::to_string(static_cast<long long>(_search_params.n_outputs)) +
         std::string(" -DMLO_LRN_DO_SCALE=") + std::to_string(static_cast<long long>(scale)) +
-        std::string(" -DMLO_OUT_VERT_ALIGNED=") +
-        std::to_string(static_cast<long long>(OUT_VERT_ALIGNED)) +
-        std::string(" -DMLO_OUT_HORIZ_ALIGNED=") +
-        std::to_string(static_cast<long long>(OUT_HORIZ_ALIGNED)) + std::string(" -DMLO_MAP_SZ4=") +
-        std::to_string(static_cast<long long>(MAP_SZ4)) + std::string(" -DMLO_C1x1_PIXLEFT=") +
-        std::to_string(static_cast<long long>(C1x1_PIXLEFT)) + std::string(" -DMLO_DIVBY4=") +
-        std::to_string(static_cast<long long>(DIVBY4)) + std::string(" -DMLO_READ_TYPE=") +
-        READ_TYPE + std::string(" -DMLO_READ_UNIT=") +
+        std::string(" -DMLO_READ_TYPE=") + READ_TYPE + std::string(" -DMLO_READ_UNIT=") +
         std::to_string(static_cast<long long>(read_unit)) + getGeneralCompOptions();
 
+    // The shape of the tensors, unless it is passed to the kernel. Then the borders of the output
+    // are always checked.
+    if(_dynamic_shape)
+    {
+        _comp_options += std::string(" -DMLO_LRN_DYNAMIC_SHAPE=1") +
+                         std::string(" -DMLO_OUT_VERT_ALIGNED=0") +
+                         std::string(" -DMLO_OUT_HORIZ_ALIGNED=0");
+    }
+    else
+    {
+        _comp_options +=
+            std::string(" -DMLO_LRN_N_OUTPUTS=") +
+            std::to_string(static_cast<long long>(_search_params.n_outputs)) +
+            std::string(" -DMLO_LRN_N_INPUTS=") +
+            std::to_string(static_cast<long long>(_search_params.n_inputs)) +
+            std::string(" -DMLO_LRN_BOT_BATCH_STRIDE=") +
+            std::to_string(static_cast<long long>(_search_params.in_batch_stride)) +
+            std::string(" -DMLO_LRN_BOT_CHANNEL_STRIDE=") +
+            std::to_string(static_cast<long long>(_search_params.in_channel_stride)) +
+            std::string(" -DMLO_LRN_BOT_STRIDE=") +
+            std::to_string(static_cast<long long>(_search_params.in_stride)) +
+            std::string(" -DMLO_LRN_TOP_BATCH_STRIDE=") +
+            std::to_string(static_cast<long long>(_search_params.out_batch_stride)) +
+            std::string(" -DMLO_LRN_TOP_CHANNEL_STRIDE=") +
+            std::to_string(static_cast<long long>(_search_params.out_channel_stride)) +
+            std::string(" -DMLO_LRN_TOP_STRIDE=") +
+            std::to_string(static_cast<long long>(_search_params.out_stride)) +
+            std::string(" -DMLO_LRN_BOT_WIDTH=") +
+            std::to_string(static_cast<long long>(_search_params.out_width)) +
+            std::string(" -DMLO_LRN_BOT_HEIGHT=") +
+            std::to_string(static_cast<long long>(_search_params.out_height)) +
+            std::string(" -DMLO_LRN_TOP_WIDTH=") +
+            std::to_string(static_cast<long long>(_search_params.out_width)) +
+            std::string(" -DMLO_LRN_TOP_HEIGHT=") +
+            std::to_string(static_cast<long long>(_search_params.out_height)) +
+            std::string(" -DMLO_LRN_SCALE_BATCH_STRIDE=") +
+            std::to_string(static_cast<long long>(scale_batch_stride)) +
+            std::string(" -DMLO_LRN_SCALE_CHANNEL_STRIDE=") +
+            std::to_string(static_cast<long long>(scale_channel_stride)) +
+            std::string(" -DMLO_LRN_SCALE_STRIDE=") +
+            std::to_string(static_cast<long long>(scale_stride)) +
+            std::string(" -DMLO_LRN_BATCH_SZ=") +
+            std::to_string(static_cast<long long>(_search_params.batch_sz)) +
+            std::string(" -DMLO_OUT_VERT_ALIGNED=") +
+            std::to_string(static_cast<long long>(OUT_VERT_ALIGNED)) +
+            std::string(" -DMLO_OUT_HORIZ_ALIGNED=") +
+            std::to_string(static_cast<long long>(OUT_HORIZ_ALIGNED)) +
+            std::string(" -DMLO_MAP_SZ4=") + std::to_string(static_cast<long long>(MAP_SZ4)) +
+            std::string(" -DMLO_C1x1_PIXLEFT=") +
+            std::to_string(static_cast<long long>(C1x1_PIXLEFT)) + std::string(" -DMLO_DIVBY4=") +
+            std::to_string(static_cast<long long>(DIVBY4));
+    }
+
     _l_wk.clear();
     _l_wk.push_back(_grp_tile0);
     _l_wk.push_back(_grp_tile1);
@@ -0,0 +1,314 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/norm.hpp>
+
+#include <miopen/activ.hpp>
+#include <miopen/check_numerics.hpp>
+#include <miopen/dropout.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/find_solution.hpp>
+#include <miopen/float_equal.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/norm/invoke_params.hpp>
+#include <miopen/norm/problem_description.hpp>
+#include <miopen/norm/solvers.hpp>
+#include <miopen/tensor.hpp>
+
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace miopen {
+
+static void CheckNormDescriptors(norm::Mode mode,
+                                 int mode_arg,
+                                 const TensorDescriptor& xDesc,
+                                 const TensorDescriptor& outDesc,
+                                 const TensorDescriptor& weightDesc,
+                                 bool affine)
+{
+    const auto& lens = xDesc.GetLengths();
+    if(xDesc.GetType() != outDesc.GetType() || lens != outDesc.GetLengths())
+        MIOPEN_THROW(miopenStatusBadParm, "The output tensor has to match x.");
+    if(!xDesc.IsPacked() || !outDesc.IsPacked())
+    {
+        MIOPEN_LOG_E("Only fully packed tensors supported.");
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+
+    // The layer norm has a parameter per normalized element, the group norm one per channel.
+    std::size_t nparams;
+    if(mode == norm::Mode::Layer)
+    {
+        if(mode_arg < 0 || mode_arg >= static_cast<int>(lens.size()))
+            MIOPEN_THROW(miopenStatusBadParm, "The normalized dimension is out of range.");
+        nparams = std::accumulate(
+            lens.begin() + mode_arg, lens.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+    }
+    else
+    {
+        if(lens.size() < 2 || mode_arg <= 0 || lens[1] % mode_arg != 0)
+            MIOPEN_THROW(miopenStatusBadParm, "The channels have to split into the groups.");
+        nparams = lens[1];
+    }
+
+    if(affine &&
+       (weightDesc.GetType() != xDesc.GetType() || weightDesc.GetElementSize() != nparams))
+        MIOPEN_THROW(miopenStatusBadParm, "The weight tensor does not match x.");
+}
+
+// The fused dropout replays its mask wherever x is read, which only a counter-based generator
+// can do.
+static void CheckNormDropout(const DropoutDescriptor* dropoutDesc, const TensorDescriptor& xDesc)
+{
+    if(dropoutDesc == nullptr)
+        return;
+    if(dropoutDesc->rng_mode != MIOPEN_RNG_PHILOX || dropoutDesc->use_mask)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The fused dropout needs MIOPEN_RNG_PHILOX and no saved mask.");
+    if(dropoutDesc->dropout < 0.0 || dropoutDesc->dropout > 1.0)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid dropout rate");
+    if(xDesc.GetElementSize() > std::numeric_limits<uint32_t>::max())
+        MIOPEN_THROW(miopenStatusBadParm, "The fused dropout supports up to 2^32 elements.");
+}
+
+template <class Params>
+static void SetNormDropoutParams(Params& params, const DropoutDescriptor* dropoutDesc)
+{
+    if(dropoutDesc == nullptr)
+        return;
+    const auto rate = dropoutDesc->dropout;
+
+    params.dropout       = rate;
+    params.dropout_scale = float_equal(rate, 1.0f) ? 0.0 : 1.0 / (1.0 - rate);
+    params.seed          = dropoutDesc->seed;
+    params.offset        = dropoutDesc->offset;
+}
+
+void NormForward(Handle& handle,
+                 norm::Mode mode,
+                 int mode_arg,
+                 const TensorDescriptor& xDesc,
+                 ConstData_t x,
+                 ConstData_t residual,
+                 const TensorDescriptor& weightDesc,
+                 ConstData_t weight,
+                 ConstData_t bias,
+                 double epsilon,
+                 const ActivationDescriptor& activDesc,
+                 const TensorDescriptor& yDesc,
+                 Data_t y,
+                 Data_t mean,
+                 Data_t rstd,
+                 const DropoutDescriptor* dropoutDesc)
+{
+    if(x == nullptr || y == nullptr || (weight == nullptr) != (bias == nullptr) ||
+       (mean == nullptr) != (rstd == nullptr))
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    const auto affine = weight != nullptr;
+    CheckNormDescriptors(mode, mode_arg, xDesc, yDesc, weightDesc, affine);
+    CheckNormDropout(dropoutDesc, xDesc);
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        if(residual != nullptr)
+            miopen::checkNumericsInput(handle, xDesc, residual);
+        if(affine)
+        {
+            miopen::checkNumericsInput(handle, weightDesc, weight);
+            miopen::checkNumericsInput(handle, weightDesc, bias);
+        }
+    }
+
+    const auto problem = norm::ProblemDescription{mode,
+                                                  mode_arg,
+                                                  xDesc,
+                                                  yDesc,
+                                                  weightDesc,
+                                                  activDesc,
+                                                  affine,
+                                                  residual != nullptr,
+                                                  mean != nullptr,
+                                                  dropoutDesc != nullptr};
+
+    const auto invoke_params = [&]() {
+        auto tmp     = norm::InvokeParams{};
+        tmp.type     = InvokeType::Run;
+        tmp.x        = x;
+        tmp.residual = residual;
+        tmp.weight   = weight;
+        tmp.bias     = bias;
+        tmp.y        = y;
+        tmp.mean     = mean;
+        tmp.rstd     = rstd;
+        tmp.epsilon  = epsilon;
+        tmp.alpha    = activDesc.GetAlpha();
+        tmp.beta     = activDesc.GetBeta();
+        tmp.gamma    = activDesc.GetGamma();
+        SetNormDropoutParams(tmp, dropoutDesc);
+        return tmp;
+    }();
+
+    const auto algo           = AlgorithmName{"miopenNormForward"};
+    const auto network_config = problem.MakeNetworkConfig();
+
+    if(const auto existingInvoker = handle.GetInvoker(network_config, boost::none, algo))
+    {
+        (*existingInvoker)(handle, invoke_params);
+    }
+    else
+    {
+        const auto ctx     = ExecutionContext{&handle};
+        const auto solvers = solver::SolverContainer<solver::norm::NormFwd>{};
+        const auto slns    = solvers.SearchForSolutions(ctx, problem, 1);
+
+        if(slns.empty())
+            MIOPEN_THROW(miopenStatusNotImplemented, "No solver found for normalization forward.");
+
+        const auto& sln = slns.front();
+        if(!sln.invoker_factory)
+            MIOPEN_THROW(miopenStatusInternalError, "Invoker missing in solver " + sln.solver_id);
+        const auto invoker = handle.PrepareInvoker(*sln.invoker_factory, sln.construction_params);
+        handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
+        invoker(handle, invoke_params);
+    }
+
+    if(miopen::CheckNumericsEnabled())
+        miopen::checkNumericsOutput(handle, yDesc, y);
+}
+
+void NormBackward(Handle& handle,
+                  norm::Mode mode,
+                  int mode_arg,
+                  const TensorDescriptor& xDesc,
+                  ConstData_t x,
+                  ConstData_t residual,
+                  const TensorDescriptor& dyDesc,
+                  ConstData_t dy,
+                  const TensorDescriptor& weightDesc,
+                  ConstData_t weight,
+                  ConstData_t bias,
+                  const ActivationDescriptor& activDesc,
+                  ConstData_t mean,
+                  ConstData_t rstd,
+                  const TensorDescriptor& dxDesc,
+                  Data_t dx,
+                  Data_t dweight,
+                  Data_t dbias,
+                  const DropoutDescriptor* dropoutDesc,
+                  Data_t dresidual)
+{
+    if(x == nullptr || dy == nullptr || dx == nullptr || mean == nullptr || rstd == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+    const auto affine = weight != nullptr;
+    if(affine && (bias == nullptr || dweight == nullptr || dbias == nullptr))
+        MIOPEN_THROW(miopenStatusBadParm, "The affine backward needs bias, dweight and dbias.");
+    CheckNormDescriptors(mode, mode_arg, xDesc, dxDesc, weightDesc, affine);
+    CheckNormDescriptors(mode, mode_arg, xDesc, dyDesc, weightDesc, affine);
+    CheckNormDropout(dropoutDesc, xDesc);
+    if(dropoutDesc != nullptr && residual != nullptr && dresidual == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "The dropout backward needs the residual gradient.");
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        miopen::checkNumericsInput(handle, dyDesc, dy);
+        if(affine)
+            miopen::checkNumericsInput(handle, weightDesc, weight);
+    }
+
+    const auto problem = norm::ProblemDescription{mode,
+                                                  mode_arg,
+                                                  xDesc,
+                                                  dyDesc,
+                                                  dxDesc,
+                                                  weightDesc,
+                                                  activDesc,
+                                                  affine,
+                                                  residual != nullptr,
+                                                  dropoutDesc != nullptr};
+
+    const auto invoke_params = [&]() {
+        auto tmp      = norm::BwdInvokeParams{};
+        tmp.type      = InvokeType::Run;
+        tmp.x         = x;
+        tmp.residual  = residual;
+        tmp.dy        = dy;
+        tmp.weight    = weight;
+        tmp.bias      = bias;
+        tmp.mean      = mean;
+        tmp.rstd      = rstd;
+        tmp.dx        = dx;
+        tmp.dweight   = dweight;
+        tmp.dbias     = dbias;
+        tmp.dresidual = dresidual;
+        tmp.alpha     = activDesc.GetAlpha();
+        tmp.beta      = activDesc.GetBeta();
+        tmp.gamma     = activDesc.GetGamma();
+        SetNormDropoutParams(tmp, dropoutDesc);
+        return tmp;
+    }();
+
+    const auto algo           = AlgorithmName{"miopenNormBackward"};
+    const auto network_config = problem.MakeNetworkConfig();
+
+    if(const auto existingInvoker = handle.GetInvoker(network_config, boost::none, algo))
+    {
+        (*existingInvoker)(handle, invoke_params);
+    }
+    else
+    {
+        const auto ctx     = ExecutionContext{&handle};
+        const auto solvers = solver::SolverContainer<solver::norm::NormBwd>{};
+        const auto slns    = solvers.SearchForSolutions(ctx, problem, 1);
+
+        if(slns.empty())
+            MIOPEN_THROW(miopenStatusNotImplemented, "No solver found for normalization backward.");
+
+        const auto& sln = slns.front();
+        if(!sln.invoker_factory)
+            MIOPEN_THROW(miopenStatusInternalError, "Invoker missing in solver " + sln.solver_id);
+        const auto invoker = handle.PrepareInvoker(*sln.invoker_factory, sln.construction_params);
+        handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
+        invoker(handle, invoke_params);
+    }
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsOutput(handle, dxDesc, dx);
+        if(dresidual != nullptr)
+            miopen::checkNumericsOutput(handle, dxDesc, dresidual);
+        if(affine)
+        {
+            miopen::checkNumericsOutput(handle, weightDesc, dweight);
+            miopen::checkNumericsOutput(handle, weightDesc, dbias);
+        }
+    }
+}
+
+} // namespace miopen
@@ -29,6 +29,7 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/datatype.hpp>
+#include <miopen/tensor.hpp>
 
 namespace miopen {
 
@@ -96,6 +97,270 @@ std::string get_vect_config(std::vector<T> v)
     return str;
 }
 
+// The 2D kernels of mlo_construct_pooling2D expect unit W stride, channel-last tensors go to
+// MIOpenPoolingNHWC.cl instead.
+bool IsPoolingNHWC(const TensorDescriptor& desc)
+{
+    return desc.GetSize() == 4 && desc.GetStrides()[1] == 1 && desc.GetLengths()[1] > 1;
+}
+
+template <class... Args>
+static void RunPoolingNHWCKernel(Handle& handle,
+                                 const PoolingDescriptor& pool,
+                                 int pooling_method,
+                                 bool forward,
+                                 bool save_index,
+                                 const TensorDescriptor& botDesc,
+                                 const TensorDescriptor& topDesc,
+                                 Args&&... args)
+{
+    int batch, chal, bot_h, bot_w, top_h, top_w;
+    std::tie(batch, chal, bot_h, bot_w) = tien<4>(botDesc.GetLengths());
+    std::tie(std::ignore, std::ignore, top_h, top_w) = tien<4>(topDesc.GetLengths());
+
+    const auto wsidx   = pool.GetWorkspaceIndexMode();
+    const bool packed  = wsidx == miopenPoolingWorkspaceIndexMaskPacked;
+    const int vec      = (chal % 4 == 0) ? 4 : (chal % 2 == 0) ? 2 : 1;
+    const int bits     = packed ? pool.GetPackedIndexBits(chal) : 0;
+    const size_t cvec  = chal / vec;
+    const size_t pixes = forward ? top_h * top_w : bot_h * bot_w;
+
+    size_t grp0 = 1;
+    while(grp0 < cvec && grp0 < 64)
+        grp0 *= 2;
+    const size_t grp1 = 256 / grp0;
+
+    const std::vector<size_t> vld{grp0, grp1, 1};
+    const std::vector<size_t> vgd{(cvec + grp0 - 1) / grp0 * grp0,
+                                  (pixes + grp1 - 1) / grp1 * grp1,
+                                  static_cast<size_t>(batch)};
+
+    const std::string algo_name =
+        forward ? "miopenPooling2dForwardNHWC" : "miopenPooling2dBackwardNHWC";
+    const std::string network_config =
+        "m" + std::to_string(pooling_method) + "_i" + std::to_string(static_cast<int>(save_index)) +
+        "_dt" + std::to_string(botDesc.GetType()) + "_ker" + get_vect_config(pool.lens) + "_str" +
+        get_vect_config(pool.strides) + "_it" + std::to_string(pool.GetIndexType()) + "_wsidx" +
+        std::to_string(wsidx) + "_b" + std::to_string(bits) + "_c" + std::to_string(chal) +
+        "_v" + std::to_string(vec) + "_glb" + get_vect_config(vgd);
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    auto kernel    = [&]() {
+        if(!kernels.empty())
+            return kernels.front();
+
+        std::string parms =
+            std::string(" -DMLO_POOLING_OP_ID=") + std::to_string(pooling_method) +
+            std::string(" -DMLO_POOLING_KERNEL_SZ0=") + std::to_string(pool.lens[1]) +
+            std::string(" -DMLO_POOLING_KERNEL_SZ1=") + std::to_string(pool.lens[0]) +
+            std::string(" -DMLO_POOLING_STRIDE0=") + std::to_string(pool.strides[1]) +
+            std::string(" -DMLO_POOLING_STRIDE1=") + std::to_string(pool.strides[0]) +
+            std::string(" -DMLO_POOLING_GROUP_SZ0=") + std::to_string(grp0) +
+            std::string(" -DMLO_POOLING_GROUP_SZ1=") + std::to_string(grp1) +
+            std::string(" -DMLO_POOLING_VEC=") + std::to_string(vec) +
+            std::string(" -DMLO_POOLING_INDEX_MODE=") + std::to_string(wsidx) +
+            std::string(" -DMLO_POOLING_INDEX_BITS=") + std::to_string(bits == 0 ? 8 : bits) +
+            std::string(save_index ? " -DMLO_POOLING_SAVE_INDEX" : "") +
+            std::string(" -DMLO_POOLING_INDEX_TYPE=") +
+            get_pooling_index_type_name(pool.GetIndexType()) +
+            std::string(" -DMLO_POOLING_INDEX_MAX=") +
+            get_pooling_index_type_max_name(pool.GetIndexType()) +
+            GetDataTypeKernelParams(botDesc.GetType());
+
+        return handle.AddKernel(algo_name,
+                                network_config,
+                                "MIOpenPoolingNHWC.cl",
+                                forward ? "mloPoolingNHWCFwd" : "mloPoolingNHWCBwd",
+                                vld,
+                                vgd,
+                                parms);
+    }();
+
+    kernel(std::forward<Args>(args)...,
+           static_cast<int>(pool.pads[0]),
+           static_cast<int>(pool.pads[1]),
+           chal,
+           bot_h,
+           bot_w,
+           top_h,
+           top_w,
+           static_cast<int>(botDesc.GetStrides()[0]),
+           static_cast<int>(botDesc.GetStrides()[2]),
+           static_cast<int>(botDesc.GetStrides()[3]),
+           static_cast<int>(topDesc.GetStrides()[0]),
+           static_cast<int>(topDesc.GetStrides()[2]),
+           static_cast<int>(topDesc.GetStrides()[3]));
+}
+
+// Adaptive pooling, and the window pooling that covers the whole image, run the region
+// reductions of MIOpenPoolingAdaptive.cl: a window kernel would give the few outputs of a global
+// pooling few work-items each and loop over the whole image in them.
+static bool IsAdaptivePooling(const PoolingDescriptor& pool,
+                              const TensorDescriptor& botDesc,
+                              const TensorDescriptor& topDesc)
+{
+    if(pool.IsAdaptive())
+        return true;
+    if(botDesc.GetSize() != 4 || pool.GetSize() != 2 ||
+       pool.GetWorkspaceIndexMode() == miopenPoolingWorkspaceIndexMaskPacked)
+        return false;
+
+    const auto& bot_lens = botDesc.GetLengths();
+    const auto& top_lens = topDesc.GetLengths();
+    return pool.lens[0] == bot_lens[2] && pool.lens[1] == bot_lens[3] && pool.pads[0] == 0 &&
+           pool.pads[1] == 0 && top_lens[2] == 1 && top_lens[3] == 1;
+}
+
+static int GetAdaptiveRegionLength(int in_len, int out_len)
+{
+    int len = 0;
+    for(int o = 0; o < out_len; o++)
+        len = std::max(len, ((o + 1) * in_len + out_len - 1) / out_len - (o * in_len) / out_len);
+    return len;
+}
+
+static void CheckAdaptivePooling(const PoolingDescriptor& pool,
+                                 const TensorDescriptor& botDesc,
+                                 const TensorDescriptor& topDesc,
+                                 bool use_index)
+{
+    if(botDesc.GetSize() != 4 || topDesc.GetSize() != 4)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Adaptive pooling supports 2D pooling only");
+    if(!use_index)
+        return;
+
+    if(pool.GetWorkspaceIndexMode() == miopenPoolingWorkspaceIndexMaskPacked)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Adaptive pooling doesn't support packed workspace indices");
+    }
+
+    int bot_h, bot_w, top_h, top_w;
+    std::tie(std::ignore, std::ignore, bot_h, bot_w) = tien<4>(botDesc.GetLengths());
+    std::tie(std::ignore, std::ignore, top_h, top_w) = tien<4>(topDesc.GetLengths());
+    const std::size_t range = pool.GetWorkspaceIndexMode() == miopenPoolingWorkspaceIndexImage
+                                  ? bot_h * bot_w
+                                  : GetAdaptiveRegionLength(bot_h, top_h) *
+                                        GetAdaptiveRegionLength(bot_w, top_w);
+    if(!(get_index_max(pool.GetIndexType()) >= range))
+        MIOPEN_THROW("Index range not enough for max pooling bwd");
+}
+
+template <typename... Args>
+static void RunPoolingAdaptiveKernel(Handle& handle,
+                                     const PoolingDescriptor& pool,
+                                     bool forward,
+                                     bool save_index,
+                                     const TensorDescriptor& botDesc,
+                                     const TensorDescriptor& topDesc,
+                                     Args&&... args)
+{
+    int batch, chal, bot_h, bot_w, top_h, top_w;
+    std::tie(batch, chal, bot_h, bot_w) = tien<4>(botDesc.GetLengths());
+    std::tie(std::ignore, std::ignore, top_h, top_w) = tien<4>(topDesc.GetLengths());
+    const auto& bot_str = botDesc.GetStrides();
+    const auto& top_str = topDesc.GetStrides();
+
+    // The regions are never padded, so both averages are the same.
+    const int pooling_method =
+        pool.GetMode() == miopenPoolingMax ? MLO_POOLING_OP_MAX : MLO_POOLING_OP_AVE;
+    const bool nhwc   = IsPoolingNHWC(botDesc) && IsPoolingNHWC(topDesc);
+    const int plane   = bot_h * bot_w;
+    const bool flat   = !nhwc && top_h == 1 && top_w == 1 && bot_str[2] == bot_w && bot_str[3] == 1;
+    const int vec_len = nhwc ? chal : flat ? plane : 1;
+    const int vec     = (vec_len % 4 == 0) ? 4 : (vec_len % 2 == 0) ? 2 : 1;
+
+    std::vector<size_t> vld;
+    std::vector<size_t> vgd;
+    if(nhwc)
+    {
+        const size_t cvec = chal / vec;
+        size_t grp0       = 1;
+        while(grp0 < cvec && grp0 < 64)
+            grp0 *= 2;
+        const size_t grp1 = 256 / grp0;
+        const size_t rows = forward ? grp1 * top_h * top_w : (plane + grp1 - 1) / grp1 * grp1;
+
+        vld = {grp0, grp1, 1};
+        vgd = {(cvec + grp0 - 1) / grp0 * grp0, rows, static_cast<size_t>(batch)};
+    }
+    else if(forward)
+    {
+        // A row of the group reduces a region, small regions share a group between channels.
+        const int region = flat ? plane : GetAdaptiveRegionLength(bot_h, top_h) *
+                                              GetAdaptiveRegionLength(bot_w, top_w);
+        const size_t lanes = (region + vec - 1) / vec;
+        size_t grp0        = 1;
+        while(grp0 < lanes && grp0 < 256)
+            grp0 *= 2;
+        const size_t grp1 = 256 / grp0;
+
+        vld = {grp0, grp1, 1};
+        vgd = {grp0 * top_h * top_w, (chal + grp1 - 1) / grp1 * grp1, static_cast<size_t>(batch)};
+    }
+    else
+    {
+        const size_t items = static_cast<size_t>(chal) * plane / vec;
+
+        vld = {256, 1, 1};
+        vgd = {(items + 255) / 256 * 256, 1, static_cast<size_t>(batch)};
+    }
+
+    const auto wsidx = pool.GetWorkspaceIndexMode();
+    const std::string algo_name =
+        forward ? "miopenPooling2dForwardAdaptive" : "miopenPooling2dBackwardAdaptive";
+    const std::string network_config =
+        "m" + std::to_string(pooling_method) + "_i" + std::to_string(static_cast<int>(save_index)) +
+        "_dt" + std::to_string(botDesc.GetType()) + "_it" + std::to_string(pool.GetIndexType()) +
+        "_wsidx" + std::to_string(wsidx) + "_nhwc" + std::to_string(static_cast<int>(nhwc)) +
+        "_flat" + std::to_string(static_cast<int>(flat)) + "_v" + std::to_string(vec) + "_lcl" +
+        get_vect_config(vld) + "_glb" + get_vect_config(vgd);
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    auto kernel    = [&]() {
+        if(!kernels.empty())
+            return kernels.front();
+
+        std::string parms =
+            std::string(" -DMLO_POOLING_OP_ID=") + std::to_string(pooling_method) +
+            std::string(" -DMLO_POOLING_GROUP_SZ0=") + std::to_string(vld[0]) +
+            std::string(" -DMLO_POOLING_GROUP_SZ1=") + std::to_string(vld[1]) +
+            std::string(" -DMLO_POOLING_VEC=") + std::to_string(vec) +
+            std::string(" -DMLO_POOLING_NHWC=") + std::to_string(static_cast<int>(nhwc)) +
+            std::string(" -DMLO_POOLING_FLAT=") + std::to_string(static_cast<int>(flat)) +
+            std::string(" -DMLO_POOLING_INDEX_MODE=") + std::to_string(wsidx) +
+            std::string(save_index ? " -DMLO_POOLING_SAVE_INDEX" : "") +
+            std::string(" -DMLO_POOLING_INDEX_TYPE=") +
+            get_pooling_index_type_name(pool.GetIndexType()) +
+            std::string(" -DMLO_POOLING_INDEX_MAX=") +
+            get_pooling_index_type_max_name(pool.GetIndexType()) +
+            GetDataTypeKernelParams(botDesc.GetType());
+
+        return handle.AddKernel(algo_name,
+                                network_config,
+                                "MIOpenPoolingAdaptive.cl",
+                                forward ? "mloPoolingAdaptiveFwd" : "mloPoolingAdaptiveBwd",
+                                vld,
+                                vgd,
+                                parms);
+    }();
+
+    kernel(std::forward<Args>(args)...,
+           chal,
+           bot_h,
+           bot_w,
+           top_h,
+           top_w,
+           static_cast<int>(bot_str[0]),
+           static_cast<int>(bot_str[1]),
+           static_cast<int>(bot_str[2]),
+           static_cast<int>(bot_str[3]),
+           static_cast<int>(top_str[0]),
+           static_cast<int>(top_str[1]),
+           static_cast<int>(top_str[2]),
+           static_cast<int>(top_str[3]));
+}
+
 miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
                                           const void* alpha,
                                           const TensorDescriptor& xDesc,
@@ -128,6 +393,22 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
         MIOPEN_THROW("Unsupported pooling dimension");
     }
 
+    if(IsAdaptivePooling(*this, xDesc, yDesc))
+    {
+        CheckAdaptivePooling(*this, xDesc, yDesc, mode == miopenPoolingMax && save_index);
+        if(mode == miopenPoolingMax && save_index && workSpace == nullptr)
+        {
+            throw std::invalid_argument("workSpace cannot be NULL in Forward Pooling MAX mode when "
+                                        "backward pass is requested");
+        }
+        RunPoolingAdaptiveKernel(handle, *this, true, save_index, xDesc, yDesc, x, y, workSpace);
+        if(miopen::CheckNumericsEnabled())
+        {
+            miopen::checkNumericsOutput(handle, yDesc, y);
+        }
+        return miopenStatusSuccess;
+    }
+
     auto index_max = get_index_max(GetIndexType());
 
     // for kernel implementation max pooling backward pass,
@@ -150,6 +431,14 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
             MIOPEN_THROW("3D pooling doesn't support workspace index mask mode");
         }
 
+        if(workspaceIndexMode == miopenPoolingWorkspaceIndexMaskPacked &&
+           !(IsPoolingNHWC(xDesc) && IsPoolingNHWC(yDesc) && lens[0] * lens[1] <= 256))
+        {
+            MIOPEN_THROW(miopenStatusNotImplemented,
+                         "Packed workspace indices need 2D NHWC pooling with up to 256 window "
+                         "elements");
+        }
+
         if(workSpace == nullptr)
         {
             throw std::invalid_argument("workSpace cannot be NULL in Forward Pooling MAX mode when "
@@ -161,6 +450,17 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
             ? MLO_POOLING_OP_MAX
             : ((mode == miopenPoolingAverage) ? MLO_POOLING_OP_AVE : MLO_POOLING_OP_AVE_INCLUSIVE);
 
+    if(pool_dim == 4 && IsPoolingNHWC(xDesc) && IsPoolingNHWC(yDesc))
+    {
+        RunPoolingNHWCKernel(
+            handle, *this, pooling_method, true, save_index, xDesc, yDesc, x, y, workSpace);
+        if(miopen::CheckNumericsEnabled())
+        {
+            miopen::checkNumericsOutput(handle, yDesc, y);
+        }
+        return miopenStatusSuccess;
+    }
+
     int top_w_per_work = 1;
     int top_h_per_work = pool_dim == 4 ? 8 : 4;
     int top_d_per_work = pool_dim == 4 ? 1 : 2;
@@ -419,6 +719,21 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
 
     miopenStatus_t status = miopenStatusSuccess;
 
+    if(IsAdaptivePooling(*this, dxDesc, dyDesc))
+    {
+        CheckAdaptivePooling(*this, dxDesc, dyDesc, mode == miopenPoolingMax);
+        if(mode == miopenPoolingMax && workSpace == nullptr)
+        {
+            throw std::invalid_argument("workSpace cannot be NULL in Backward Pooling MAX mode");
+        }
+        RunPoolingAdaptiveKernel(handle, *this, false, false, dxDesc, dyDesc, dy, dx, workSpace);
+        if(miopen::CheckNumericsEnabled())
+        {
+            miopen::checkNumericsOutput(handle, dxDesc, dx);
+        }
+        return status;
+    }
+
     auto index_max = get_index_max(GetIndexType());
 
     // for kernel implementation max pooling backward pass,
@@ -441,6 +756,14 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
         MIOPEN_THROW("3D pooling doesn't support workspace index mask mode");
     }
 
+    if(mode == miopenPoolingMax && workspaceIndexMode == miopenPoolingWorkspaceIndexMaskPacked &&
+       !(IsPoolingNHWC(dxDesc) && IsPoolingNHWC(dyDesc) && lens[0] * lens[1] <= 256))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Packed workspace indices need 2D NHWC pooling with up to 256 window "
+                     "elements");
+    }
+
     if(mode == miopenPoolingMax && workSpace == nullptr)
     {
         throw std::invalid_argument("workSpace cannot be NULL in Backward Pooling MAX mode");
@@ -450,6 +773,17 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
             ? MLO_POOLING_OP_MAX
             : ((mode == miopenPoolingAverage) ? MLO_POOLING_OP_AVE : MLO_POOLING_OP_AVE_INCLUSIVE);
 
+    if(pool_dim == 4 && IsPoolingNHWC(dxDesc) && IsPoolingNHWC(dyDesc))
+    {
+        RunPoolingNHWCKernel(
+            handle, *this, pooling_method, false, false, dxDesc, dyDesc, dy, dx, workSpace);
+        if(miopen::CheckNumericsEnabled())
+        {
+            miopen::checkNumericsOutput(handle, dxDesc, dx);
+        }
+        return status;
+    }
+
     int batch = dyDesc.GetLengths()[0];
     int chal  = dyDesc.GetLengths()[1];
 
@@ -28,11 +28,17 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/datatype.hpp>
+#include <miopen/env.hpp>
 #include <miopen/rnn_util.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/tensor.hpp>
+#include <algorithm>
 #include <cassert>
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_RNN_DIRECTION_STREAMS)
+
 void LSTMForwardHiddenStateUpdate(const Handle& handle,
                                   miopenDataType_t rnn_data_type,
                                   bool is_inference,
@@ -75,7 +81,7 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
     glb_sz              = wg_sz * item_per_grp;
 
     std::string network_config =
-        "lstmfwdhid-" + std::string(rnn_data_type == miopenHalf ? "fp16-" : "fp32-") +
+        "lstmfwdhid-" + GetDataType(rnn_data_type) + "-" +
         std::to_string(static_cast<int>(is_inference)) + "x" + std::to_string(RD_BLCK) + "x" +
         std::to_string(item_per_grp) + "x" + std::to_string(wg_sz);
 
@@ -109,16 +115,13 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
     {
         std::string params = " -DLSTM_FWD_HID=1";
 
-        const std::string data_type = GetDataType(rnn_data_type);
+        const std::string data_type = GetDataTypeStorage(rnn_data_type);
         const std::string READ_TYPE =
             (RD_BLCK == 1) ? data_type : data_type + std::to_string(RD_BLCK);
 
         params += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
 
-        if(rnn_data_type == miopenHalf)
-            params += " -DMIOPEN_USE_FP16=1";
-        else
-            params += " -DMIOPEN_USE_FP32=1";
+        params += GetDataTypeKernelParams(rnn_data_type);
 
         if(is_inference)
             params += " -DINFERENCE_MODE=1";
@@ -151,6 +154,337 @@ void LSTMForwardHiddenStateUpdate(const Handle& handle,
     (void)wei_stride;
 }
 
+void GRUForwardHiddenStateUpdate(const Handle& handle,
+                                 miopenDataType_t rnn_data_type,
+                                 bool is_inference,
+                                 bool is_seq_begin,
+                                 int direction,
+                                 int max_batch,
+                                 int cur_batch,
+                                 int use_batch,
+                                 int hy_h,
+                                 int hy_stride,
+                                 ConstData_t hx,
+                                 std::size_t hx_offset,
+                                 Data_t reserve_space,
+                                 std::size_t z_offset,
+                                 std::size_t r_offset,
+                                 std::size_t c_offset,
+                                 std::size_t hidden_offset,
+                                 std::size_t hidden_offset_pre,
+                                 std::size_t activ_offset)
+{
+    std::string program_name = "MIOpenRNNHiddenStateUpdate.cl";
+    std::string kernel_name  = "GRUFwdHidUpdate";
+
+    size_t max_active_threads = handle.GetMaxComputeUnits() * handle.GetWavefrontWidth() * 32;
+
+    size_t total_work = max_batch * hy_h;
+
+    size_t RD_BLCK = (total_work >= 4 * max_active_threads && hy_h % 4 == 0)
+                         ? 4
+                         : ((total_work >= 2 * max_active_threads && hy_h % 2 == 0) ? 2 : 1);
+
+    size_t total_item   = std::max(total_work / RD_BLCK, size_t(1));
+    size_t item_per_grp = total_item <= 64 ? 64 : total_item <= 128 ? 128 : 256;
+    size_t glb_sz       = total_item < max_active_threads ? total_item : max_active_threads;
+    size_t wg_sz        = (glb_sz + item_per_grp - 1) / item_per_grp;
+    glb_sz              = wg_sz * item_per_grp;
+
+    std::string network_config =
+        "grufwdhid-" + GetDataType(rnn_data_type) + "-" +
+        std::to_string(static_cast<int>(is_inference)) + "x" + std::to_string(RD_BLCK) + "x" +
+        std::to_string(item_per_grp) + "x" + std::to_string(wg_sz);
+
+    bool use_hx = hx != nullptr;
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+
+    if(!kernels.empty())
+    {
+        auto kernel = kernels.front();
+        kernel(hx,
+               reserve_space,
+               hy_h,
+               hy_stride,
+               static_cast<long long>(hx_offset),
+               static_cast<long long>(z_offset),
+               static_cast<long long>(r_offset),
+               static_cast<long long>(c_offset),
+               static_cast<long long>(hidden_offset),
+               static_cast<long long>(hidden_offset_pre),
+               static_cast<long long>(activ_offset),
+               static_cast<char>(use_hx),
+               static_cast<char>(is_seq_begin),
+               direction,
+               cur_batch,
+               use_batch);
+    }
+    else
+    {
+        std::string params = " -DGRU_FWD_HID=1";
+
+        const std::string data_type = GetDataTypeStorage(rnn_data_type);
+        const std::string READ_TYPE =
+            (RD_BLCK == 1) ? data_type : data_type + std::to_string(RD_BLCK);
+
+        params += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
+
+        params += GetDataTypeKernelParams(rnn_data_type);
+
+        if(is_inference)
+            params += " -DINFERENCE_MODE=1";
+
+        const std::vector<size_t> vld{item_per_grp, 1, 1};
+        const std::vector<size_t> vgd{glb_sz, 1, 1};
+
+        handle.AddKernel(kernel_name, network_config, program_name, kernel_name, vld, vgd, params)(
+            hx,
+            reserve_space,
+            hy_h,
+            hy_stride,
+            static_cast<long long>(hx_offset),
+            static_cast<long long>(z_offset),
+            static_cast<long long>(r_offset),
+            static_cast<long long>(c_offset),
+            static_cast<long long>(hidden_offset),
+            static_cast<long long>(hidden_offset_pre),
+            static_cast<long long>(activ_offset),
+            static_cast<char>(use_hx),
+            static_cast<char>(is_seq_begin),
+            direction,
+            cur_batch,
+            use_batch);
+    }
+}
+
+int GetRNNReverseDirectionStream(const Handle& handle, bool is_bidirection)
+{
+    const auto current = handle.GetStreamIndexFromPool();
+    if(!is_bidirection || !miopen::IsEnabled(MIOPEN_RNN_DIRECTION_STREAMS{}))
+        return current;
+    // Reserving is not thread safe, so it happens once per handle
+    if(handle.GetStreamPoolSize() < 2)
+        handle.ReserveExtraStreamsInPool(1);
+    return current == 1 ? 0 : 1;
+}
+
+namespace {
+
+constexpr std::size_t rnn_persistent_local_size = 256;
+
+struct RNNPersistentConfig
+{
+    int units;
+    int groups;
+    int split;
+};
+
+// Spreads the hidden units over the compute units, one work-group each, so that every
+// work-group holds the recurrent weights of its units in LDS. No units when they do not fit.
+// Int8 weights take a byte each, plus the scale of every row.
+RNNPersistentConfig GetRNNPersistentConfig(const Handle& handle,
+                                           miopenDataType_t rnn_data_type,
+                                           miopenRNNMode_t rnn_mode,
+                                           int batch,
+                                           int hy_h,
+                                           bool int8_weights)
+{
+    const int gates  = rnn_mode == miopenLSTM ? 4 : rnn_mode == miopenGRU ? 3 : 1;
+    const int cus    = static_cast<int>(handle.GetMaxComputeUnits());
+    const int units  = (hy_h + cus - 1) / cus;
+    const int groups = (hy_h + units - 1) / units;
+    const int split  = hy_h >= 256 ? 64 : hy_h >= 64 ? 16 : 4;
+
+    const std::size_t wei_size = int8_weights ? sizeof(int8_t) : GetTypeSize(rnn_data_type);
+    const std::size_t scales   = int8_weights ? gates * units : 0;
+
+    const std::size_t lds =
+        gates * units * hy_h * wei_size +
+        (batch * gates * units + scales + rnn_persistent_local_size) * sizeof(float);
+    if(lds > handle.GetLocalMemorySize())
+        return {0, 0, split};
+    return {units, groups, split};
+}
+
+} // namespace
+
+bool IsRNNPersistentApplicable(const Handle& handle,
+                               miopenDataType_t rnn_data_type,
+                               miopenRNNMode_t rnn_mode,
+                               bool is_bidirection,
+                               const std::vector<int>& in_n,
+                               int hy_h,
+                               bool int8_weights)
+{
+    if(rnn_data_type != miopenFloat && rnn_data_type != miopenHalf &&
+       rnn_data_type != miopenBFloat16)
+        return false;
+    if(is_bidirection || in_n.empty())
+        return false;
+    if(!std::all_of(in_n.begin(), in_n.end(), [&](int n) { return n == in_n.front(); }))
+        return false;
+    const auto config =
+        GetRNNPersistentConfig(handle, rnn_data_type, rnn_mode, in_n.front(), hy_h, int8_weights);
+    return config.units > 0;
+}
+
+void RNNForwardPersistent(const Handle& handle,
+                          miopenDataType_t rnn_data_type,
+                          miopenRNNMode_t rnn_mode,
+                          int seq_len,
+                          int batch,
+                          int hy_h,
+                          int hy_stride,
+                          ConstData_t w,
+                          std::size_t w_offset,
+                          ConstData_t w_scale,
+                          std::size_t scale_offset,
+                          ConstData_t hx,
+                          std::size_t hx_offset,
+                          ConstData_t cx,
+                          std::size_t cx_offset,
+                          Data_t work_space,
+                          std::size_t gate_offset,
+                          std::size_t hidden_offset,
+                          std::size_t cell_offset,
+                          std::size_t sync_offset)
+{
+    std::string program_name = "MIOpenRNNPersistent.cl";
+    std::string kernel_name  = "RNNFwdPersistent";
+
+    // Without scales the weights are of the RNN data type, and w stands in for the scales
+    const bool int8_weights = w_scale != nullptr;
+    if(!int8_weights)
+    {
+        w_scale      = w;
+        scale_offset = 0;
+    }
+
+    const auto config =
+        GetRNNPersistentConfig(handle, rnn_data_type, rnn_mode, batch, hy_h, int8_weights);
+    if(config.units == 0)
+        MIOPEN_THROW("The recurrent weights do not fit the persistent RNN kernel");
+
+    std::string network_config =
+        "rnnfwdpersist-" + GetDataType(rnn_data_type) + "-" +
+        std::to_string(static_cast<int>(rnn_mode)) + "x" + std::to_string(batch) + "x" +
+        std::to_string(hy_h) + "x" + std::to_string(config.units) + "x" +
+        std::to_string(config.split) + (int8_weights ? "-i8" : "");
+
+    bool use_hx = hx != nullptr;
+    bool use_cx = cx != nullptr;
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+
+    if(!kernels.empty())
+    {
+        auto kernel = kernels.front();
+        kernel(w,
+               w_scale,
+               hx,
+               cx,
+               work_space,
+               work_space,
+               static_cast<long long>(w_offset),
+               static_cast<long long>(scale_offset),
+               static_cast<long long>(hx_offset),
+               static_cast<long long>(cx_offset),
+               static_cast<long long>(gate_offset),
+               static_cast<long long>(hidden_offset),
+               static_cast<long long>(cell_offset),
+               static_cast<long long>(sync_offset),
+               hy_stride,
+               seq_len,
+               static_cast<char>(use_hx),
+               static_cast<char>(use_cx));
+    }
+    else
+    {
+        std::string params = " -DRNN_MODE=" + std::to_string(static_cast<int>(rnn_mode)) +
+                             " -DHY_H=" + std::to_string(hy_h) + " -DBATCH=" +
+                             std::to_string(batch) + " -DUNITS=" + std::to_string(config.units) +
+                             " -DSPLIT=" + std::to_string(config.split) + " -DLOCAL_SIZE=" +
+                             std::to_string(rnn_persistent_local_size);
+        if(int8_weights)
+            params += " -DRNN_INT8_WEIGHTS=1";
+
+        params += GetDataTypeKernelParams(rnn_data_type);
+
+        const std::vector<size_t> vld{rnn_persistent_local_size, 1, 1};
+        const std::vector<size_t> vgd{config.groups * rnn_persistent_local_size, 1, 1};
+
+        handle.AddKernel(kernel_name, network_config, program_name, kernel_name, vld, vgd, params)(
+            w,
+            w_scale,
+            hx,
+            cx,
+            work_space,
+            work_space,
+            static_cast<long long>(w_offset),
+            static_cast<long long>(scale_offset),
+            static_cast<long long>(hx_offset),
+            static_cast<long long>(cx_offset),
+            static_cast<long long>(gate_offset),
+            static_cast<long long>(hidden_offset),
+            static_cast<long long>(cell_offset),
+            static_cast<long long>(sync_offset),
+            hy_stride,
+            seq_len,
+            static_cast<char>(use_hx),
+            static_cast<char>(use_cx));
+    }
+}
+
+void RNNQuantizeWeightsInt8(const Handle& handle,
+                            miopenDataType_t rnn_data_type,
+                            int rows,
+                            int row_len,
+                            ConstData_t w,
+                            std::size_t w_offset,
+                            Data_t wq,
+                            std::size_t wq_offset,
+                            std::size_t scale_offset)
+{
+    std::string program_name = "MIOpenRNNQuantize.cl";
+    std::string kernel_name  = "RNNQuantizeWeightsInt8";
+
+    std::string network_config =
+        "rnnquantize-" + GetDataType(rnn_data_type) + "-" + std::to_string(rows) + "x" +
+        std::to_string(row_len);
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+
+    if(!kernels.empty())
+    {
+        auto kernel = kernels.front();
+        kernel(w,
+               wq,
+               wq,
+               static_cast<long long>(w_offset),
+               static_cast<long long>(wq_offset),
+               static_cast<long long>(scale_offset));
+    }
+    else
+    {
+        std::string params = " -DROW_LEN=" + std::to_string(row_len) + " -DLOCAL_SIZE=" +
+                             std::to_string(rnn_persistent_local_size);
+
+        params += GetDataTypeKernelParams(rnn_data_type);
+
+        const std::vector<size_t> vld{rnn_persistent_local_size, 1, 1};
+        const std::vector<size_t> vgd{rows * rnn_persistent_local_size, 1, 1};
+
+        handle.AddKernel(kernel_name, network_config, program_name, kernel_name, vld, vgd, params)(
+            w,
+            wq,
+            wq,
+            static_cast<long long>(w_offset),
+            static_cast<long long>(wq_offset),
+            static_cast<long long>(scale_offset));
+    }
+}
+
 void LSTMBackwardHiddenStateUpdate(const Handle& handle,
                                    miopenDataType_t rnn_data_type,
                                    bool is_seq_begin,
@@ -203,7 +537,7 @@ void LSTMBackwardHiddenStateUpdate(const Handle& handle,
     glb_sz              = wg_sz * item_per_grp;
 
     std::string network_config =
-        "lstmbwdhid-" + std::string(rnn_data_type == miopenHalf ? "fp16-" : "fp32-") +
+        "lstmbwdhid-" + GetDataType(rnn_data_type) + "-" +
         std::to_string(RD_BLCK) + "x" + std::to_string(item_per_grp) + "x" + std::to_string(wg_sz);
 
     bool use_cx  = cx != nullptr;
@@ -249,16 +583,13 @@ void LSTMBackwardHiddenStateUpdate(const Handle& handle,
     {
         std::string params = " -DLSTM_BWD_HID=1";
 
-        const std::string data_type = GetDataType(rnn_data_type);
+        const std::string data_type = GetDataTypeStorage(rnn_data_type);
         const std::string READ_TYPE =
             (RD_BLCK == 1) ? data_type : data_type + std::to_string(RD_BLCK);
 
         params += " -DRD_BLCK=" + std::to_string(RD_BLCK) + " -DREAD_TYPE=" + READ_TYPE;
 
-        if(rnn_data_type == miopenHalf)
-            params += " -DMIOPEN_USE_FP16=1";
-        else
-            params += " -DMIOPEN_USE_FP32=1";
+        params += GetDataTypeKernelParams(rnn_data_type);
 
         const std::vector<size_t> vld{item_per_grp, 1, 1};
         const std::vector<size_t> vgd{glb_sz, 1, 1};
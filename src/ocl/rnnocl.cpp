@@ -32,6 +32,7 @@
 #include <miopen/gemm_v2.hpp>
 #include <miopen/logger.hpp>
 
+#include <cstdint>
 #include <vector>
 #include <numeric>
 #include <algorithm>
@@ -73,7 +74,6 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         MIOPEN_THROW("Workspace is required");
     }
 
-    std::string network_config;
     std::vector<int> in_n;
     int in_h  = xDesc[0].GetLengths()[1]; // input vector size
     int hy_d  = hyDesc.GetLengths()[0];   // biNumLayers
@@ -86,7 +86,8 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
-    int batch_n = 0;
+    // the steps follow each other in the packed layout
+    std::vector<int> time_rows(1, 0);
     for(int i = 0; i < seqLen; i++)
     {
         int batchval, inputvec, batchvalout, outputvec;
@@ -115,18 +116,195 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             }
         }
         in_n.push_back(batchval);
-        batch_n += batchval;
+        time_rows.push_back(time_rows.back() + batchval);
+    }
+
+    RNNForwardInferenceRows(handle,
+                            in_n,
+                            time_rows,
+                            in_h,
+                            out_h,
+                            x,
+                            hxDesc,
+                            hx,
+                            cxDesc,
+                            cx,
+                            wDesc,
+                            w,
+                            y,
+                            hyDesc,
+                            hy,
+                            cyDesc,
+                            cy,
+                            workSpace,
+                            workSpaceSize);
+}
+
+void RNNDescriptor::RNNForwardInferencePadded(Handle& handle,
+                                              const int* seqLengths,
+                                              const TensorDescriptor& xDesc,
+                                              ConstData_t x,
+                                              const TensorDescriptor& hxDesc,
+                                              ConstData_t hx,
+                                              const TensorDescriptor& cxDesc,
+                                              ConstData_t cx,
+                                              const TensorDescriptor& wDesc,
+                                              ConstData_t w,
+                                              const TensorDescriptor& yDesc,
+                                              Data_t y,
+                                              const TensorDescriptor& hyDesc,
+                                              Data_t hy,
+                                              const TensorDescriptor& cyDesc,
+                                              Data_t cy,
+                                              Data_t workSpace,
+                                              size_t workSpaceSize) const
+{
+    if(x == nullptr || w == nullptr || y == nullptr || seqLengths == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(hxDesc.GetSize() != cxDesc.GetSize() || hxDesc.GetSize() != hyDesc.GetSize() ||
+       hxDesc.GetSize() != cyDesc.GetSize())
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(xDesc.GetSize() != 3 || yDesc.GetSize() != 3 || !xDesc.IsPacked() || !yDesc.IsPacked())
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Padded input and output must be packed [sequence, batch, vector] tensors");
+    }
+    if(workSpaceSize < GetPaddedWorkspaceSize(handle, xDesc))
+    {
+        MIOPEN_THROW("Workspace is required");
+    }
+
+    int seqLen, max_batch, in_h;
+    std::tie(seqLen, max_batch, in_h) = miopen::tien<3>(xDesc.GetLengths());
+    int hy_d  = hyDesc.GetLengths()[0]; // biNumLayers
+    int hy_n  = hyDesc.GetLengths()[1]; // max batch size
+    int hy_h  = hyDesc.GetLengths()[2]; // hidden size
+    int out_h = yDesc.GetLengths()[2];  // output vector size
+
+    if(in_h <= 0 || hy_h <= 0 || hy_n < max_batch || hy_d <= 0 || out_h <= 0 || seqLen <= 0)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(yDesc.GetLengths()[0] != seqLen || yDesc.GetLengths()[1] != max_batch)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Input and output sequences do not match");
+    }
+
+    // As in the packed layout the sequences are sorted by length, so the valid vectors of a step
+    // are the first ones of its slice
+    std::vector<int> in_n(seqLen + 1, 0);
+    for(int i = 0; i < max_batch; i++)
+    {
+        if(seqLengths[i] < 0 || seqLengths[i] > seqLen ||
+           (i > 0 && seqLengths[i] > seqLengths[i - 1]))
+        {
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Incorrect length of sequence " + std::to_string(i) +
+                             "! Lengths must not ascend nor exceed the sequence length!");
+        }
+        in_n[seqLengths[i]]++;
+    }
+    for(int i = seqLen - 1; i >= 0; i--)
+    {
+        in_n[i] += in_n[i + 1];
+    }
+    in_n.pop_back();
+    if(in_n.at(0) <= 0)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Input batch is ZERO!");
+    }
+
+    std::vector<int> time_rows(seqLen + 1);
+    for(int i = 0; i <= seqLen; i++)
+    {
+        time_rows[i] = i * max_batch;
+    }
+
+    RNNForwardInferenceRows(handle,
+                            in_n,
+                            time_rows,
+                            in_h,
+                            out_h,
+                            x,
+                            hxDesc,
+                            hx,
+                            cxDesc,
+                            cx,
+                            wDesc,
+                            w,
+                            y,
+                            hyDesc,
+                            hy,
+                            cyDesc,
+                            cy,
+                            workSpace,
+                            workSpaceSize);
+
+    // Zero the padding of the output, one op for every run of steps with the same batch
+    float zero = 0;
+    for(int ti = 0; ti < seqLen;)
+    {
+        int run = 1;
+        while(ti + run < seqLen && in_n.at(ti + run) == in_n.at(ti))
+            run++;
+        if(in_n.at(ti) < max_batch)
+        {
+            const std::vector<int> pad_size{run, max_batch - in_n.at(ti), out_h};
+            const std::vector<int> pad_stride{max_batch * out_h, out_h, 1};
+            const auto pad_desc = miopen::TensorDescriptor(
+                yDesc.GetType(), pad_size.data(), pad_stride.data(), 3);
+            SetTensor(handle, pad_desc, y, &zero, (ti * max_batch + in_n.at(ti)) * out_h);
+        }
+        ti += run;
+    }
+}
+
+void RNNDescriptor::RNNForwardInferenceRows(Handle& handle,
+                                            const std::vector<int>& in_n,
+                                            const std::vector<int>& time_rows,
+                                            int in_h,
+                                            int out_h,
+                                            ConstData_t x,
+                                            const TensorDescriptor& hxDesc,
+                                            ConstData_t hx,
+                                            const TensorDescriptor& cxDesc,
+                                            ConstData_t cx,
+                                            const TensorDescriptor& wDesc,
+                                            ConstData_t w,
+                                            Data_t y,
+                                            const TensorDescriptor& hyDesc,
+                                            Data_t hy,
+                                            const TensorDescriptor& cyDesc,
+                                            Data_t cy,
+                                            Data_t workSpace,
+                                            size_t workSpaceSize) const
+{
+    const int seqLen  = static_cast<int>(in_n.size());
+    const int hy_d    = hyDesc.GetLengths()[0]; // biNumLayers
+    const int hy_n    = hyDesc.GetLengths()[1]; // max batch size
+    const int rec_h   = hyDesc.GetLengths()[2]; // fed back state size, the projection if any
+    const int hy_h    = projSize != 0 ? static_cast<int>(hsize) : rec_h; // hidden size
+    const int batch_n = time_rows.back();
+
+    if(projSize != 0 && (rec_h != projSize || cyDesc.GetLengths()[2] != hsize))
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Hidden states must have the projection size, cell states the hidden size");
     }
 
     int bi = dirMode != 0u ? 2 : 1;
-    if(out_h != (bi * hy_h))
+    if(out_h != (bi * rec_h))
     {
         MIOPEN_THROW(miopenStatusBadParm, "Output size doesn't match hidden state size!");
     }
 
     float ctime    = 0.;
     int in_stride  = in_h;
-    int hy_stride  = hy_h * bi * static_cast<int>(workspaceScale);
+    int hy_stride  = (hy_h * static_cast<int>(workspaceScale) + static_cast<int>(projSize)) * bi;
     int out_stride = out_h;
     int wei_stride = hy_h * bi * static_cast<int>(nHiddenTensorsPerLayer);
     int uni_stride = hy_h;
@@ -143,7 +321,28 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         in_h = 0;
     }
 
-    size_t wei_shift_bias = (in_h + hy_h + (bi * hy_h + hy_h) * (nLayers - 1)) * wei_stride;
+    // Recurrent weights quantized from w, for the persistent kernel
+    const auto quantized = GetQuantizedWeights(w, in_h);
+
+    // Weights prepared from w are consumed instead, with every matrix transposed and its rows
+    // aligned to the GEMM tile
+    const auto prepared       = GetPreparedWeights(w, in_h);
+    const bool packed_weights = prepared != nullptr;
+    if(packed_weights)
+    {
+        w = prepared;
+    }
+    const int mat_stride =
+        packed_weights ? static_cast<int>(GetPackedWeightsStride()) : wei_stride;
+    const int dir_stride = packed_weights ? 1 : rec_h;
+    const int in_ldb     = packed_weights ? mat_stride : in_stride;
+    const int bi_ldb     = packed_weights ? mat_stride : rec_h * bi;
+    const int uni_ldb    = packed_weights ? mat_stride : rec_h;
+
+    size_t wei_shift_bias = (in_h + rec_h + (bi * rec_h + rec_h) * (nLayers - 1)) * mat_stride;
+    // The projection of every layer and direction follows the biases
+    const size_t proj_shift =
+        wei_shift_bias + (biasMode != 0u ? nLayers * 2 * static_cast<size_t>(wei_stride) : 0);
     size_t offset;
     float alpha0, alpha1, beta_t;
     float alpha = 1, beta = 0;
@@ -176,7 +375,11 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         hx_desc = miopen::TensorDescriptor(wDesc.GetType(), hx_size.data(), hx_stride.data(), 3);
         if(hy != nullptr)
         {
-            SetTensor(handle, hx_desc, hy, &beta);
+            const std::vector<int> hy_size{1, 1, hy_d * hy_n * rec_h};
+            SetTensor(handle,
+                      miopen::TensorDescriptor(wDesc.GetType(), hy_size.data(), 3),
+                      hy,
+                      &beta);
             // Update time
             profileRNNkernels(handle, 1, ctime);
         }
@@ -215,6 +418,53 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         hid_off = bi * hy_h * 3;
         break;
     }
+    // The states fed to the next step and layer, projected past the end of the row if needed
+    const int rec_off = projSize != 0 ? hy_h * bi * static_cast<int>(workspaceScale) : hid_off;
+
+    // Projects the hidden states of the rows of one direction, from row_offset on
+    auto project_hidden = [&](int li, int ri, int rows, int row_offset) {
+        miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
+                                                          false,
+                                                          true,
+                                                          rows,
+                                                          rec_h,
+                                                          hy_h,
+                                                          hy_stride,
+                                                          hy_h,
+                                                          hy_stride,
+                                                          1, // batch count
+                                                          0, // Stride A
+                                                          0, // Stride B
+                                                          0, // Stride C
+                                                          1, // alpha
+                                                          0, // beta
+                                                          wDesc.GetType()};
+
+        miopenStatus_t gemm_status = CallGemm(handle,
+                                              gemm_desc,
+                                              workSpace,
+                                              row_offset + hid_off + ri * hy_h,
+                                              w,
+                                              proj_shift + (li * bi + ri) * rec_h * hy_h,
+                                              workSpace,
+                                              row_offset + rec_off + ri * rec_h,
+                                              nullptr,
+                                              GemmBackend_t::miopengemm);
+
+        if(gemm_status != miopenStatusSuccess)
+        {
+            if(gemm_status == miopenStatusNotImplemented)
+            {
+                MIOPEN_LOG_E("GEMM not implemented");
+            }
+            else
+            {
+                MIOPEN_LOG_E("GEMM failed");
+            }
+        }
+        // Update time
+        profileRNNkernels(handle, 1, ctime);
+    };
 
     ActivationDescriptor tanhDesc, sigDesc, activDesc;
     sigDesc  = {miopenActivationLOGISTIC, 1, 0, 1};
@@ -228,10 +478,34 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         activDesc = {miopenActivationTANH, 1, 1, 1};
     }
 
+    // The persistent kernel runs all the time steps of a layer and synchronizes the work-groups
+    // on a counter per layer, kept past the rows of the workspace zeroed above. Recurrent
+    // weights quantized from w replace the ones of w; the input GEMMs still read w.
+    const bool int8_weights =
+        quantized != nullptr &&
+        IsRNNPersistentApplicable(handle, wDesc.GetType(), rnnMode, bi == 2, in_n, hy_h, true);
+    const bool persistent =
+        algoMode == miopenRNNpersistent && projSize == 0 &&
+        (int8_weights ||
+         (!packed_weights &&
+          IsRNNPersistentApplicable(handle, wDesc.GetType(), rnnMode, bi == 2, in_n, hy_h, false)));
+    if(algoMode == miopenRNNpersistent && !persistent)
+    {
+        MIOPEN_LOG_I("The persistent RNN kernel is not applicable, use the default algorithm");
+    }
+    const std::size_t sync_offset =
+        (nLayers * batch_n * hy_stride * GetTypeSize(wDesc.GetType()) + sizeof(uint32_t) - 1) /
+        sizeof(uint32_t);
+
+    // The two directions of a layer only meet at the next layer
+    const auto forward_stream = handle.GetStreamIndexFromPool();
+    const auto reverse_stream = GetRNNReverseDirectionStream(handle, bi == 2);
+
     for(int li = 0; li < nLayers; li++)
     {
         int hid_shift           = li * batch_n * hy_stride;
         int hx_shift            = li * hy_n * bi_stride;
+        int rec_shift           = li * hy_n * bi * rec_h;
         int wei_shift_bias_temp = static_cast<int>(wei_shift_bias) + li * 2 * wei_stride;
 
         // from input
@@ -259,12 +533,12 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             {
                 miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
                                                                   false,
-                                                                  true,
+                                                                  !packed_weights,
                                                                   batch_n,
                                                                   wei_len * bi,
                                                                   in_h,
                                                                   in_stride,
-                                                                  in_stride,
+                                                                  in_ldb,
                                                                   hy_stride,
                                                                   1, // batch count
                                                                   0, // Stride A
@@ -272,7 +546,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                                   0, // Stride C
                                                                   1, // alpha
                                                                   1, // beta
-                                                                  xDesc[0].GetType()};
+                                                                  wDesc.GetType()};
 
                 miopenStatus_t gemm_status = CallGemm(handle,
                                                       gemm_desc,
@@ -302,17 +576,17 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         }
         else
         {
-            wei_shift = (in_h + hy_h) * wei_stride + (li - 1) * (bi * hy_h + hy_h) * wei_stride;
-            prelayer_shift = (li - 1) * batch_n * hy_stride + hid_off;
+            wei_shift = (in_h + rec_h) * mat_stride + (li - 1) * (bi * rec_h + rec_h) * mat_stride;
+            prelayer_shift = (li - 1) * batch_n * hy_stride + rec_off;
 
             miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
                                                               false,
-                                                              true,
+                                                              !packed_weights,
                                                               batch_n,
                                                               wei_len * bi,
-                                                              hy_h * bi,
+                                                              rec_h * bi,
                                                               hy_stride,
-                                                              bi_stride,
+                                                              bi_ldb,
                                                               hy_stride,
                                                               1, // batch count
                                                               0, // Stride A
@@ -320,7 +594,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                               0, // Stride C
                                                               1, // alpha
                                                               1, // beta
-                                                              xDesc[0].GetType()};
+                                                              wDesc.GetType()};
             miopenStatus_t gemm_status       = CallGemm(handle,
                                                   gemm_desc,
                                                   workSpace,
@@ -532,7 +806,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
                             }
-                            cur_batch += in_n.at(ti);
+                            cur_batch = time_rows.at(ti + 1);
                         }
                     }
                 }
@@ -540,25 +814,56 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         }
 
         // from hidden state
+        if(persistent)
+        {
+            RNNForwardPersistent(handle,
+                                 wDesc.GetType(),
+                                 rnnMode,
+                                 seqLen,
+                                 in_n.at(0),
+                                 hy_h,
+                                 hy_stride,
+                                 int8_weights ? quantized : w,
+                                 int8_weights ? GetQuantizedMatricesOffset() +
+                                                    static_cast<std::size_t>(li) * wei_stride * hy_h
+                                              : in_h * wei_stride +
+                                                    li * (bi * hy_h + hy_h) * wei_stride,
+                                 int8_weights ? quantized : nullptr,
+                                 static_cast<std::size_t>(li) * wei_stride,
+                                 hx,
+                                 hx_shift,
+                                 rnnMode == miopenLSTM ? cx : nullptr,
+                                 hx_shift,
+                                 workSpace,
+                                 hid_shift,
+                                 hid_off,
+                                 wei_len,
+                                 sync_offset + li);
+            // Update time
+            profileRNNkernels(handle, 1, ctime);
+        }
+        handle.WaitStreamInPool(reverse_stream, forward_stream);
         int bacc   = 0;
         int baccbi = batch_n;
-        for(int ti = 0; ti < seqLen; ti++)
+        for(int ti = 0; !persistent && ti < seqLen; ti++)
         {
-            baccbi -= in_n.at(seqLen - 1 - ti);
-            wei_shift         = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+            baccbi = time_rows.at(seqLen - 1 - ti);
+            wei_shift         = in_h * mat_stride + li * (bi * rec_h + rec_h) * mat_stride;
             int pretime_shift = 0;
             int use_time      = 0;
 
             for(int ri = 0; ri < bi; ri++)
             {
+                const RNNStreamScope stream_scope(handle,
+                                                  ri == 0 ? forward_stream : reverse_stream);
                 int cur_time  = ri == 0 ? ti : seqLen - 1 - ti;
                 int cur_batch = ri == 0 ? bacc : baccbi;
                 offset        = hid_shift + cur_batch * hy_stride;
                 if(ti > 0)
                 {
                     pretime_shift =
-                        ri == 0 ? hid_shift + (bacc - in_n.at(ti - 1)) * hy_stride
-                                : hid_shift + (baccbi + in_n.at(seqLen - 1 - ti)) * hy_stride;
+                        ri == 0 ? hid_shift + time_rows.at(ti - 1) * hy_stride
+                                : hid_shift + time_rows.at(seqLen - ti) * hy_stride;
                     use_time = ri == 0 ? ti : seqLen - ti;
                 }
 
@@ -570,12 +875,12 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         {
                             miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
                                                                               false,
-                                                                              true,
+                                                                              !packed_weights,
                                                                               in_n.at(cur_time),
                                                                               wei_len,
-                                                                              hy_h,
-                                                                              uni_stride,
-                                                                              uni_stride,
+                                                                              rec_h,
+                                                                              rec_h,
+                                                                              uni_ldb,
                                                                               hy_stride,
                                                                               1, // batch count
                                                                               0, // Stride A
@@ -583,15 +888,15 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                                               0, // Stride C
                                                                               1, // alpha
                                                                               1, // beta
-                                                                              xDesc[0].GetType()};
+                                                                              wDesc.GetType()};
 
                             miopenStatus_t gemm_status =
                                 CallGemm(handle,
                                          gemm_desc,
                                          hx,
-                                         hx_shift + ri * hy_n * hy_h,
+                                         rec_shift + ri * hy_n * rec_h,
                                          w,
-                                         wei_shift + ri * wei_len * uni_stride,
+                                         wei_shift + ri * wei_len * dir_stride,
                                          workSpace,
                                          static_cast<int>(offset) + ri * wei_len,
                                          nullptr,
@@ -619,12 +924,12 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                             miopen::GemmDescriptor gemm_desc =
                                 GemmDescriptor{false,
                                                false,
-                                               true,
+                                               !packed_weights,
                                                (in_n.at(cur_time) - in_n.at(use_time)),
                                                wei_len,
-                                               hy_h,
-                                               uni_stride,
-                                               uni_stride,
+                                               rec_h,
+                                               rec_h,
+                                               uni_ldb,
                                                hy_stride,
                                                1, // batch count
                                                0, // Stride A
@@ -632,14 +937,14 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                0, // Stride C
                                                1, // alpha
                                                1, // beta
-                                               xDesc[0].GetType()};
+                                               wDesc.GetType()};
                             miopenStatus_t gemm_status =
                                 CallGemm(handle,
                                          gemm_desc,
                                          hx,
-                                         hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
+                                         rec_shift + ri * hy_n * rec_h + in_n.at(use_time) * rec_h,
                                          w,
-                                         wei_shift + ri * wei_len * uni_stride,
+                                         wei_shift + ri * wei_len * dir_stride,
                                          workSpace,
                                          static_cast<int>(offset) + ri * wei_len +
                                              in_n.at(use_time) * hy_stride,
@@ -665,12 +970,12 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         {
                             miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
                                                                               false,
-                                                                              true,
+                                                                              !packed_weights,
                                                                               in_n.at(use_time),
                                                                               wei_len,
-                                                                              hy_h,
+                                                                              rec_h,
                                                                               hy_stride,
-                                                                              uni_stride,
+                                                                              uni_ldb,
                                                                               hy_stride,
                                                                               1, // batch count
                                                                               0, // Stride A
@@ -678,15 +983,15 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                                               0, // Stride C
                                                                               1, // alpha
                                                                               1, // beta
-                                                                              xDesc[0].GetType()};
+                                                                              wDesc.GetType()};
 
                             miopenStatus_t gemm_status =
                                 CallGemm(handle,
                                          gemm_desc,
                                          workSpace,
-                                         pretime_shift + hid_off + ri * hy_h,
+                                         pretime_shift + rec_off + ri * rec_h,
                                          w,
-                                         wei_shift + ri * wei_len * uni_stride,
+                                         wei_shift + ri * wei_len * dir_stride,
                                          workSpace,
                                          static_cast<int>(offset) + ri * wei_len,
                                          nullptr,
@@ -730,7 +1035,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                     }
                     else if(rnnMode == miopenLSTM)
                     {
-                        if(algoMode == miopenRNNdefault)
+                        if(algoMode != miopenRNNfundamental)
                         {
                             LSTMForwardHiddenStateUpdate(handle,
                                                          wDesc.GetType(),
@@ -758,6 +1063,11 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
 
                             // Update time
                             profileRNNkernels(handle, 1, ctime);
+                            if(projSize != 0)
+                            {
+                                project_hidden(
+                                    li, ri, in_n.at(cur_time), static_cast<int>(offset));
+                            }
                             continue;
                         }
 
@@ -947,9 +1257,41 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                  offset + hid_off + ri * hy_h);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
+
+                        if(projSize != 0)
+                        {
+                            project_hidden(li, ri, in_n.at(cur_time), static_cast<int>(offset));
+                        }
                     }
                     else if(rnnMode == miopenGRU)
                     {
+                        if(algoMode != miopenRNNfundamental)
+                        {
+                            GRUForwardHiddenStateUpdate(handle,
+                                                        wDesc.GetType(),
+                                                        true,
+                                                        ti == 0,
+                                                        ri,
+                                                        in_n.at(0),
+                                                        in_n.at(cur_time),
+                                                        in_n.at(use_time),
+                                                        hy_h,
+                                                        hy_stride,
+                                                        hx,
+                                                        hx_shift + ri * hy_n * hy_h,
+                                                        workSpace,
+                                                        offset + ri * wei_len,
+                                                        offset + hy_h + ri * wei_len,
+                                                        offset + 2 * hy_h + ri * wei_len,
+                                                        offset + hid_off + ri * hy_h,
+                                                        pretime_shift + hid_off + ri * hy_h,
+                                                        0);
+
+                            // Update time
+                            profileRNNkernels(handle, 1, ctime);
+                            continue;
+                        }
+
                         // active z, r gate
                         sp_size[2] = 2 * hy_h;
                         sp_desc    = miopen::TensorDescriptor(
@@ -1162,8 +1504,9 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                 }
             }
 
-            bacc += in_n.at(ti);
+            bacc = time_rows.at(ti + 1);
         }
+        handle.WaitStreamInPool(forward_stream, reverse_stream);
 
         // update hy, cy
         if(hy != nullptr || (rnnMode == miopenLSTM && cy != nullptr))
@@ -1175,7 +1518,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             baccbi = 0;
             for(int ti = seqLen - 1; ti >= 0; ti--)
             {
-                bacc -= in_n.at(ti);
+                bacc = time_rows.at(ti);
                 for(int ri = 0; ri < bi; ri++)
                 {
                     int cur_time  = ri == 0 ? ti : seqLen - 1 - ti;
@@ -1202,14 +1545,19 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
 
                         if(hy != nullptr)
                         {
+                            const std::vector<int> rec_size{1, sp_size[1], rec_h};
+                            const std::vector<int> rec_stride{hy_stride, hy_stride, 1};
+                            const std::vector<int> hy_strides{rec_h, rec_h, 1};
                             CopyTensor(handle,
-                                       sp_desc,
+                                       miopen::TensorDescriptor(
+                                           wDesc.GetType(), rec_size.data(), rec_stride.data(), 3),
                                        workSpace,
-                                       hx_desc,
+                                       miopen::TensorDescriptor(
+                                           wDesc.GetType(), rec_size.data(), hy_strides.data(), 3),
                                        hy,
-                                       static_cast<int>(offset) + hid_off + ri * hy_h +
+                                       static_cast<int>(offset) + rec_off + ri * rec_h +
                                            use_batch * hy_stride,
-                                       hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
+                                       rec_shift + ri * hy_n * rec_h + use_batch * rec_h);
                             // Update time
                             profileRNNkernels(handle, 1, ctime);
                         }
@@ -1229,16 +1577,16 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         }
                     }
                 }
-                baccbi += in_n.at(seqLen - 1 - ti);
+                baccbi = time_rows.at(seqLen - ti);
             }
         }
     }
 
     // output
-    prelayer_shift = (static_cast<int>(nLayers) - 1) * batch_n * hy_stride + hid_off;
+    prelayer_shift = (static_cast<int>(nLayers) - 1) * batch_n * hy_stride + rec_off;
 
     sp_size[1] = batch_n;
-    sp_size[2] = hy_h * bi;
+    sp_size[2] = rec_h * bi;
     y_size[1]  = batch_n;
     y_size[2]  = out_h;
     y_desc     = miopen::TensorDescriptor(wDesc.GetType(), y_size.data(), y_stride.data(), 3);
@@ -1258,6 +1606,11 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
     (void)alpha;
     (void)bi_stride;
     (void)wei_shift_bias;
+    (void)proj_shift;
+    (void)in_ldb;
+    (void)bi_ldb;
+    (void)uni_ldb;
+    (void)dir_stride;
     MIOPEN_THROW("GEMM is not supported");
 #endif
 }
@@ -1282,6 +1635,106 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                                        size_t workSpaceSize,
                                        Data_t reserveSpace,
                                        size_t reserveSpaceSize) const
+{
+    if(projSize != 0)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "The training passes do not support a recurrent projection");
+    }
+    if(algoMode != miopenRNNrecompute)
+    {
+        RNNForwardTrainingFull(handle,
+                               seqLen,
+                               xDesc,
+                               x,
+                               hxDesc,
+                               hx,
+                               cxDesc,
+                               cx,
+                               wDesc,
+                               w,
+                               yDesc,
+                               y,
+                               hyDesc,
+                               hy,
+                               cyDesc,
+                               cy,
+                               workSpace,
+                               workSpaceSize,
+                               reserveSpace,
+                               reserveSpaceSize);
+        return;
+    }
+
+    if(x == nullptr || reserveSpace == nullptr || seqLen <= 0)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(!float_equal(miopen::deref(dropoutDesc).dropout, 0))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Dropout is not supported by the recompute algorithm");
+    }
+    if(reserveSpaceSize < GetReserveSize(handle, seqLen, xDesc))
+    {
+        MIOPEN_THROW("Reservespace is required");
+    }
+
+    int batch_n = 0;
+    for(int i = 0; i < seqLen; i++)
+    {
+        batch_n += xDesc[i].GetLengths()[0];
+    }
+
+    // The full reserve space only lives through the pass, the input is kept to recompute it
+    const std::size_t full_size = GetFullReserveSizeForRows(batch_n);
+    auto full_reserve           = handle.Create(full_size);
+    RNNForwardTrainingFull(handle,
+                           seqLen,
+                           xDesc,
+                           x,
+                           hxDesc,
+                           hx,
+                           cxDesc,
+                           cx,
+                           wDesc,
+                           w,
+                           yDesc,
+                           y,
+                           hyDesc,
+                           hy,
+                           cyDesc,
+                           cy,
+                           workSpace,
+                           workSpaceSize,
+                           full_reserve.get(),
+                           full_size);
+
+    const int x_len   = batch_n * xDesc[0].GetLengths()[1];
+    const auto x_desc = miopen::TensorDescriptor(wDesc.GetType(), &x_len, 1);
+    CopyTensor(handle, x_desc, x, x_desc, reserveSpace);
+    recomputedReserve = nullptr;
+}
+
+void RNNDescriptor::RNNForwardTrainingFull(Handle& handle,
+                                           const int seqLen,
+                                           c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                           ConstData_t x,
+                                           const TensorDescriptor& hxDesc,
+                                           ConstData_t hx,
+                                           const TensorDescriptor& cxDesc,
+                                           ConstData_t cx,
+                                           const TensorDescriptor& wDesc,
+                                           ConstData_t w,
+                                           c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                           Data_t y,
+                                           const TensorDescriptor& hyDesc,
+                                           Data_t hy,
+                                           const TensorDescriptor& cyDesc,
+                                           Data_t cy,
+                                           Data_t workSpace,
+                                           size_t workSpaceSize,
+                                           Data_t reserveSpace,
+                                           size_t reserveSpaceSize) const
 {
     (void)workSpace;
 
@@ -1458,6 +1911,10 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
         activDesc = {miopenActivationTANH, 1, 1, 1};
     }
 
+    // The two directions of a layer only meet at the next layer
+    const auto forward_stream = handle.GetStreamIndexFromPool();
+    const auto reverse_stream = GetRNNReverseDirectionStream(handle, bi == 2);
+
     for(int li = 0; li < nLayers; li++)
     {
         int hid_shift           = li * batch_n * hy_stride;
@@ -1551,7 +2008,7 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
 
                 size_t drop_rsv_size = drop_out_desc.GetElementSize();
                 size_t drop_rsv_start =
-                    algoMode == miopenRNNdefault && rnnMode == miopenLSTM
+                    algoMode != miopenRNNfundamental && rnnMode == miopenLSTM
                         ? nLayers * batch_n * hy_stride + nLayers * batch_n * hy_h * bi
                         : 2 * nLayers * batch_n * hy_stride;
 
@@ -1815,6 +2272,7 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
         }
 
         // from hidden state
+        handle.WaitStreamInPool(reverse_stream, forward_stream);
         int bacc   = 0;
         int baccbi = batch_n;
         for(int ti = 0; ti < seqLen; ti++)
@@ -1826,6 +2284,8 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
 
             for(int ri = 0; ri < bi; ri++)
             {
+                const RNNStreamScope stream_scope(handle,
+                                                  ri == 0 ? forward_stream : reverse_stream);
                 int cur_time  = ri == 0 ? ti : seqLen - 1 - ti;
                 int cur_batch = ri == 0 ? bacc : baccbi;
                 offset        = hid_shift + cur_batch * hy_stride;
@@ -2006,7 +2466,7 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                     }
                     else if(rnnMode == miopenLSTM)
                     {
-                        if(algoMode == miopenRNNdefault)
+                        if(algoMode != miopenRNNfundamental)
                         {
                             LSTMForwardHiddenStateUpdate(handle,
                                                          wDesc.GetType(),
@@ -2232,6 +2692,33 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
                     }
                     else if(rnnMode == miopenGRU)
                     {
+                        if(algoMode != miopenRNNfundamental)
+                        {
+                            GRUForwardHiddenStateUpdate(handle,
+                                                        wDesc.GetType(),
+                                                        false,
+                                                        ti == 0,
+                                                        ri,
+                                                        in_n.at(0),
+                                                        in_n.at(cur_time),
+                                                        in_n.at(use_time),
+                                                        hy_h,
+                                                        hy_stride,
+                                                        hx,
+                                                        hx_shift + ri * hy_n * hy_h,
+                                                        reserveSpace,
+                                                        offset + ri * wei_len,
+                                                        offset + hy_h + ri * wei_len,
+                                                        offset + 2 * hy_h + ri * wei_len,
+                                                        offset + hid_off + ri * hy_h,
+                                                        pretime_shift + hid_off + ri * hy_h,
+                                                        nLayers * batch_n * hy_stride);
+
+                            // Update time
+                            profileRNNkernels(handle, 1, ctime);
+                            continue;
+                        }
+
                         // active z, r gate
                         sp_size[2] = 2 * hy_h;
                         sp_desc    = miopen::TensorDescriptor(
@@ -2461,6 +2948,7 @@ void RNNDescriptor::RNNForwardTraining(Handle& handle,
 
             bacc += in_n.at(ti);
         }
+        handle.WaitStreamInPool(forward_stream, reverse_stream);
 
         // update hy, cy
         if(hy != nullptr || (rnnMode == miopenLSTM && cy != nullptr))
@@ -2586,6 +3074,142 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
                                     Data_t reserveSpace,
                                     size_t reserveSpaceSize) const
 {
+    if(projSize != 0)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "The training passes do not support a recurrent projection");
+    }
+    if(algoMode != miopenRNNrecompute)
+    {
+        RNNBackwardDataFull(handle,
+                            seqLen,
+                            yDesc,
+                            y,
+                            dyDesc,
+                            dy,
+                            dhyDesc,
+                            dhy,
+                            dcyDesc,
+                            dcy,
+                            wDesc,
+                            w,
+                            hxDesc,
+                            hx,
+                            cxDesc,
+                            cx,
+                            dxDesc,
+                            dx,
+                            dhxDesc,
+                            dhx,
+                            dcxDesc,
+                            dcx,
+                            workSpace,
+                            workSpaceSize,
+                            reserveSpace,
+                            reserveSpaceSize);
+        return;
+    }
+
+    if(reserveSpace == nullptr || seqLen <= 0)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    if(reserveSpaceSize < GetReserveSize(handle, seqLen, dxDesc))
+    {
+        MIOPEN_THROW("Reservespace is required");
+    }
+
+    int batch_n = 0;
+    for(int i = 0; i < seqLen; i++)
+    {
+        batch_n += yDesc[i].GetLengths()[0];
+    }
+
+    // Run the forward pass again from the input kept in the reserve space. Its output is
+    // dropped, and the full reserve space is kept for RNNBackwardWeights.
+    const std::size_t full_size = GetFullReserveSizeForRows(batch_n);
+    auto full_reserve = std::make_shared<Allocator::ManageDataPtr>(handle.Create(full_size));
+    auto recomputed_y =
+        handle.Create(batch_n * yDesc[0].GetLengths()[1] * GetTypeSize(wDesc.GetType()));
+    RNNForwardTrainingFull(handle,
+                           seqLen,
+                           dxDesc,
+                           reserveSpace,
+                           hxDesc,
+                           hx,
+                           cxDesc,
+                           cx,
+                           wDesc,
+                           w,
+                           yDesc,
+                           recomputed_y.get(),
+                           hxDesc,
+                           nullptr,
+                           cxDesc,
+                           nullptr,
+                           workSpace,
+                           workSpaceSize,
+                           full_reserve->get(),
+                           full_size);
+
+    RNNBackwardDataFull(handle,
+                        seqLen,
+                        yDesc,
+                        y,
+                        dyDesc,
+                        dy,
+                        dhyDesc,
+                        dhy,
+                        dcyDesc,
+                        dcy,
+                        wDesc,
+                        w,
+                        hxDesc,
+                        hx,
+                        cxDesc,
+                        cx,
+                        dxDesc,
+                        dx,
+                        dhxDesc,
+                        dhx,
+                        dcxDesc,
+                        dcx,
+                        workSpace,
+                        workSpaceSize,
+                        full_reserve->get(),
+                        full_size);
+
+    recomputedReserve     = full_reserve;
+    recomputedReserveSize = full_size;
+}
+
+void RNNDescriptor::RNNBackwardDataFull(Handle& handle,
+                                        const int seqLen,
+                                        c_array_view<const miopenTensorDescriptor_t> yDesc,
+                                        ConstData_t y,
+                                        c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                                        ConstData_t dy,
+                                        const TensorDescriptor& dhyDesc,
+                                        ConstData_t dhy,
+                                        const TensorDescriptor& dcyDesc,
+                                        ConstData_t dcy,
+                                        const TensorDescriptor& wDesc,
+                                        ConstData_t w,
+                                        const TensorDescriptor& hxDesc,
+                                        ConstData_t hx,
+                                        const TensorDescriptor& cxDesc,
+                                        ConstData_t cx,
+                                        c_array_view<const miopenTensorDescriptor_t> dxDesc,
+                                        Data_t dx,
+                                        const TensorDescriptor& dhxDesc,
+                                        Data_t dhx,
+                                        const TensorDescriptor& dcxDesc,
+                                        Data_t dcx,
+                                        Data_t workSpace,
+                                        size_t workSpaceSize,
+                                        Data_t reserveSpace,
+                                        size_t reserveSpaceSize) const
+{
 
     // Suppress warning
     (void)y;
@@ -2852,7 +3476,7 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
 
                 size_t drop_rsv_size = drop_in_desc.GetElementSize();
                 size_t drop_rsv_start =
-                    algoMode == miopenRNNdefault && rnnMode == miopenLSTM
+                    algoMode != miopenRNNfundamental && rnnMode == miopenLSTM
                         ? nLayers * batch_n * hy_stride + nLayers * batch_n * hy_h * bi
                         : 2 * nLayers * batch_n * hy_stride;
 
@@ -3115,7 +3739,7 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
                     }
                     else if(rnnMode == miopenLSTM)
                     {
-                        if(algoMode == miopenRNNdefault)
+                        if(algoMode != miopenRNNfundamental)
                         {
                             LSTMBackwardHiddenStateUpdate(
                                 handle,
@@ -3929,7 +4553,7 @@ void RNNDescriptor::RNNBackwardData(Handle& handle,
                             alpha0 = 1;
                             alpha1 = 1;
                             beta_t = 1;
-                            if(algoMode == miopenRNNdefault)
+                            if(algoMode != miopenRNNfundamental)
                             {
                                 OpTensor(handle,
                                          miopenTensorOpMul,
@@ -4078,6 +4702,75 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
                                        ConstData_t reserveSpace,
                                        size_t reserveSpaceSize) const
 {
+    if(projSize != 0)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "The training passes do not support a recurrent projection");
+    }
+    if(algoMode != miopenRNNrecompute)
+    {
+        RNNBackwardWeightsFull(handle,
+                               seqLen,
+                               xDesc,
+                               x,
+                               hxDesc,
+                               hx,
+                               dyDesc,
+                               dy,
+                               dwDesc,
+                               dw,
+                               workSpace,
+                               workSpaceSize,
+                               reserveSpace,
+                               reserveSpaceSize);
+        return;
+    }
+
+    if(reserveSpaceSize < GetReserveSize(handle, seqLen, xDesc))
+    {
+        MIOPEN_THROW("Reservespace is required");
+    }
+    if(recomputedReserve == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "With the recompute algorithm RNNBackwardData must run "
+                     "before RNNBackwardWeights");
+    }
+
+    // The recomputed reserve space is released once the weights are done
+    const auto full_reserve = recomputedReserve;
+    recomputedReserve       = nullptr;
+    RNNBackwardWeightsFull(handle,
+                           seqLen,
+                           xDesc,
+                           x,
+                           hxDesc,
+                           hx,
+                           dyDesc,
+                           dy,
+                           dwDesc,
+                           dw,
+                           workSpace,
+                           workSpaceSize,
+                           full_reserve->get(),
+                           recomputedReserveSize);
+}
+
+void RNNDescriptor::RNNBackwardWeightsFull(Handle& handle,
+                                           const int seqLen,
+                                           c_array_view<const miopenTensorDescriptor_t> xDesc,
+                                           ConstData_t x,
+                                           const TensorDescriptor& hxDesc,
+                                           ConstData_t hx,
+                                           c_array_view<const miopenTensorDescriptor_t> dyDesc,
+                                           ConstData_t dy,
+                                           const TensorDescriptor& dwDesc,
+                                           Data_t dw,
+                                           Data_t workSpace,
+                                           size_t workSpaceSize,
+                                           ConstData_t reserveSpace,
+                                           size_t reserveSpaceSize) const
+{
 
     if(x == nullptr || dw == nullptr || dy == nullptr)
     {
@@ -4183,8 +4876,7 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
 
     int wei_len   = 0;
     int hid_off   = 0;
-    int use_time  = 0;
-    int pre_batch = 0;
+    int use_time = 0;
 
     switch(rnnMode)
     {
@@ -4263,7 +4955,7 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
         {
             bool use_dropout    = !float_equal(miopen::deref(dropoutDesc).dropout, 0);
             auto prelayer_shift = static_cast<int>(
-                use_dropout ? (algoMode == miopenRNNdefault && rnnMode == miopenLSTM
+                use_dropout ? (algoMode != miopenRNNfundamental && rnnMode == miopenLSTM
                                    ? nLayers * batch_n * hy_stride + nLayers * batch_n * hy_h * bi
                                    : 2 * nLayers * batch_n * hy_stride) +
                                   (li - 1) * batch_n * hy_h * bi
@@ -4419,74 +5111,63 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
             }
             else
             {
-                sp_size[1] = 1;
-                sp_size[2] = wei_len;
-                w_size[1]  = 1;
-                w_size[2]  = wei_len;
+                w_size[1] = 1;
+                w_size[2] = wei_len;
                 w_desc =
                     miopen::TensorDescriptor(dwDesc.GetType(), w_size.data(), w_stride.data(), 3);
-                sp_desc =
-                    miopen::TensorDescriptor(dwDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
 
-                for(int bs = 0; bs < batch_n; bs++)
-                {
-                    if(!(hx == nullptr && bs < in_n.at(0)))
-                    {
-                        OpTensor(handle,
-                                 miopenTensorOpAdd,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 w_desc,
-                                 dw,
-                                 &beta_t,
-                                 w_desc,
-                                 dw,
-                                 hid_shift + bs * hy_stride,
-                                 wei_shift,
-                                 wei_shift);
-
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
-                    }
-                }
+                alpha0 = 0;
+                alpha1 = 1;
+                beta_t = 1;
 
-                if(dirMode != 0u)
-                {
-                    sp_size[1] = 1;
+                // Sums the bias gradient over a range of packed rows in one squashing op
+                auto add_rows = [&](int first_row, int rows, int gate_offset) {
+                    sp_size[1] = rows;
                     sp_size[2] = wei_len;
-                    w_size[1]  = 1;
-                    w_size[2]  = wei_len;
-                    w_desc     = miopen::TensorDescriptor(
-                        dwDesc.GetType(), w_size.data(), w_stride.data(), 3);
-                    sp_desc = miopen::TensorDescriptor(
+                    sp_desc    = miopen::TensorDescriptor(
                         dwDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
 
+                    OpTensor(handle,
+                             miopenTensorOpAdd,
+                             &alpha0,
+                             w_desc,
+                             dw,
+                             &alpha1,
+                             sp_desc,
+                             workSpace,
+                             &beta_t,
+                             w_desc,
+                             dw,
+                             wei_shift + gate_offset,
+                             hid_shift + first_row * hy_stride + gate_offset,
+                             wei_shift + gate_offset);
+
+                    // Update time
+                    profileRNNkernels(handle, 1, ctime);
+                };
+
+                // without hx the first time step has no hidden part
+                if(batch_n > in_n.at(0))
+                    add_rows(in_n.at(0), batch_n - in_n.at(0), 0);
+
+                if(dirMode != 0u)
+                {
+                    // backwards in time the last valid step of every sequence has none, so the
+                    // rows are contiguous as long as the batch does not shrink
                     int cur_batch = 0;
+                    int run_begin = 0;
+                    int run_rows  = 0;
                     for(int ti = 0; ti < seqLen - 1; ti++)
                     {
-                        for(int bs = 0; bs < in_n.at(ti + 1); bs++)
+                        run_rows += in_n.at(ti + 1);
+                        cur_batch += in_n.at(ti);
+                        if(in_n.at(ti + 1) != in_n.at(ti) || ti == seqLen - 2)
                         {
-                            OpTensor(handle,
-                                     miopenTensorOpAdd,
-                                     &alpha0,
-                                     sp_desc,
-                                     workSpace,
-                                     &alpha1,
-                                     w_desc,
-                                     dw,
-                                     &beta_t,
-                                     w_desc,
-                                     dw,
-                                     hid_shift + (cur_batch + bs) * hy_stride + wei_len,
-                                     wei_shift + wei_len,
-                                     wei_shift + wei_len);
-
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
+                            if(run_rows > 0)
+                                add_rows(run_begin, run_rows, wei_len);
+                            run_begin = cur_batch;
+                            run_rows  = 0;
                         }
-                        cur_batch += in_n.at(ti);
                     }
                 }
             }
@@ -4507,6 +5188,10 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
             hx_shift  = li * hy_n * bi_stride;
             wei_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
 
+            // Each direction updates its own weights, so the GEMMs of both directions run
+            // together.
+            auto hx_gemms     = std::vector<GemmProblem>{};
+            auto hidden_gemms = std::vector<GemmProblem>{};
             for(int ri = 0; ri < bi; ri++)
             {
                 hid_shift =
@@ -4533,34 +5218,13 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
                                                                       1, // beta
                                                                       xDesc[0].GetType()};
 
-                    miopenStatus_t gemm_status = CallGemm(handle,
-                                                          gemm_desc,
-                                                          workSpace,
-                                                          hid_shift + ri * wei_len,
-                                                          hx,
-                                                          hx_shift + ri * hy_n * hy_h,
-                                                          dw,
-                                                          wei_shift + ri * wei_len * uni_stride,
-                                                          nullptr,
-                                                          GemmBackend_t::miopengemm);
-
-                    if(gemm_status != miopenStatusSuccess)
-                    {
-                        if(gemm_status == miopenStatusNotImplemented)
-                        {
-                            MIOPEN_LOG_E("GEMM not implemented");
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_E("GEMM failed");
-                        }
-                    }
-
-                    // Update time
-                    if(li == nLayers - 1 && ri == bi - 1 && seqLen == 1)
-                        profileRNNkernels(handle, 2, ctime);
-                    else
-                        profileRNNkernels(handle, 1, ctime);
+                    hx_gemms.push_back({gemm_desc,
+                                        workSpace,
+                                        hid_shift + ri * wei_len,
+                                        hx,
+                                        hx_shift + ri * hy_n * hy_h,
+                                        dw,
+                                        wei_shift + ri * wei_len * uni_stride});
                 }
 
                 if(seqLen > 1)
@@ -4637,34 +5301,41 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
                                        1, // beta
                                        xDesc[0].GetType()};
 
-                    miopenStatus_t gemm_status = CallGemm(handle,
-                                                          gemm_desc,
-                                                          workSpace,
-                                                          hid_shift + ri * wei_len,
-                                                          reserveSpace,
-                                                          pretime_shift + ri * hy_h,
-                                                          dw,
-                                                          wei_shift + ri * wei_len * uni_stride,
-                                                          nullptr,
-                                                          GemmBackend_t::miopengemm);
-
-                    if(gemm_status != miopenStatusSuccess)
+                    hidden_gemms.push_back({gemm_desc,
+                                            workSpace,
+                                            hid_shift + ri * wei_len,
+                                            reserveSpace,
+                                            pretime_shift + ri * hy_h,
+                                            dw,
+                                            wei_shift + ri * wei_len * uni_stride});
+                }
+            }
+
+            for(const auto* gemms : {&hx_gemms, &hidden_gemms})
+            {
+                if(gemms->empty())
+                    continue;
+
+                miopenStatus_t gemm_status =
+                    CallGemmGrouped(handle, *gemms, GemmBackend_t::miopengemm);
+
+                if(gemm_status != miopenStatusSuccess)
+                {
+                    if(gemm_status == miopenStatusNotImplemented)
                     {
-                        if(gemm_status == miopenStatusNotImplemented)
-                        {
-                            MIOPEN_LOG_E("GEMM not implemented");
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_E("GEMM failed");
-                        }
+                        MIOPEN_LOG_E("GEMM not implemented");
                     }
-                    // Update time
-                    if(li == nLayers - 1 && ri == bi - 1)
-                        profileRNNkernels(handle, 2, ctime);
                     else
-                        profileRNNkernels(handle, 1, ctime);
+                    {
+                        MIOPEN_LOG_E("GEMM failed");
+                    }
                 }
+                // Update time
+                const auto last = gemms == &hidden_gemms || hidden_gemms.empty();
+                if(li == nLayers - 1 && last)
+                    profileRNNkernels(handle, 2, ctime);
+                else
+                    profileRNNkernels(handle, 1, ctime);
             }
         }
         else
@@ -4685,8 +5356,6 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
                     cur_time = ri == 0 ? ti : seqLen - 1 - ti;
                     if(ti > 0)
                     {
-                        pre_batch =
-                            ri == 0 ? bacc - in_n.at(ti - 1) : baccbi + in_n.at(seqLen - 1 - ti);
                         use_time = ri == 0 ? ti : seqLen - ti;
                     }
 
@@ -4792,64 +5461,105 @@ void RNNDescriptor::RNNBackwardWeights(Handle& handle,
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
                             }
+                        }
+                    }
+                }
 
-                            pretime_shift =
-                                li * batch_n * hy_stride + pre_batch * hy_stride + hid_off;
+                bacc += in_n.at(ti);
+            }
 
-                            if(in_n.at(use_time) > 0)
-                            {
-                                miopen::GemmDescriptor gemm_desc =
-                                    GemmDescriptor{false,
-                                                   true,
-                                                   false,
-                                                   wei_len,
-                                                   hy_h,
-                                                   in_n.at(use_time),
-                                                   hy_stride,
-                                                   hy_stride,
-                                                   uni_stride,
-                                                   1, // batch count
-                                                   0, // Stride A
-                                                   0, // Stride B
-                                                   0, // Stride C
-                                                   1, // alpha
-                                                   1, // beta
-                                                   xDesc[0].GetType()};
+            // Every step pairs with the previous one in its direction. While the batch keeps its
+            // size, the rows of the pairs are at a constant distance and one GEMM sums them.
+            std::vector<int> time_rows(seqLen + 1, 0);
+            for(int ti = 0; ti < seqLen; ti++)
+            {
+                time_rows[ti + 1] = time_rows[ti] + in_n.at(ti);
+            }
 
-                                miopenStatus_t gemm_status =
-                                    CallGemm(handle,
-                                             gemm_desc,
-                                             workSpace,
-                                             hid_shift + ri * wei_len,
-                                             reserveSpace,
-                                             pretime_shift + ri * hy_h,
-                                             dw,
-                                             wei_shift + ri * wei_len * uni_stride,
-                                             nullptr,
-                                             GemmBackend_t::miopengemm);
+            auto add_recurrent = [&](int ri, int first_row, int rows, int distance, bool last) {
+                if(rows <= 0)
+                {
+                    return;
+                }
 
-                                if(gemm_status != miopenStatusSuccess)
-                                {
-                                    if(gemm_status == miopenStatusNotImplemented)
-                                    {
-                                        MIOPEN_LOG_E("GEMM not implemented");
-                                    }
-                                    else
-                                    {
-                                        MIOPEN_LOG_E("GEMM failed");
-                                    }
-                                }
-                                // Update time
-                                if(li == nLayers - 1 && ti == seqLen - 1 && ri == bi - 1)
-                                    profileRNNkernels(handle, 2, ctime);
-                                else
-                                    profileRNNkernels(handle, 1, ctime);
-                            }
-                        }
+                miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
+                                                                  true,
+                                                                  false,
+                                                                  wei_len,
+                                                                  hy_h,
+                                                                  rows,
+                                                                  hy_stride,
+                                                                  hy_stride,
+                                                                  uni_stride,
+                                                                  1, // batch count
+                                                                  0, // Stride A
+                                                                  0, // Stride B
+                                                                  0, // Stride C
+                                                                  1, // alpha
+                                                                  1, // beta
+                                                                  xDesc[0].GetType()};
+
+                miopenStatus_t gemm_status =
+                    CallGemm(handle,
+                             gemm_desc,
+                             workSpace,
+                             (li * batch_n + first_row) * hy_stride + ri * wei_len,
+                             reserveSpace,
+                             (li * batch_n + first_row + distance) * hy_stride + hid_off +
+                                 ri * hy_h,
+                             dw,
+                             wei_shift + ri * wei_len * uni_stride,
+                             nullptr,
+                             GemmBackend_t::miopengemm);
+
+                if(gemm_status != miopenStatusSuccess)
+                {
+                    if(gemm_status == miopenStatusNotImplemented)
+                    {
+                        MIOPEN_LOG_E("GEMM not implemented");
+                    }
+                    else
+                    {
+                        MIOPEN_LOG_E("GEMM failed");
                     }
                 }
+                // Update time
+                if(last)
+                    profileRNNkernels(handle, 2, ctime);
+                else
+                    profileRNNkernels(handle, 1, ctime);
+            };
 
-                bacc += in_n.at(ti);
+            const bool last_layer = li == nLayers - 1;
+
+            // forward in time, step t reads the first rows of step t - 1
+            for(int ti = 1; ti < seqLen;)
+            {
+                const int prev_batch = in_n.at(ti - 1);
+                int end             = ti + 1;
+                while(end < seqLen && in_n.at(end - 1) == prev_batch)
+                    end++;
+                add_recurrent(0,
+                              time_rows[ti],
+                              time_rows[end] - time_rows[ti],
+                              -prev_batch,
+                              last_layer && bi == 1 && end == seqLen);
+                ti = end;
+            }
+
+            // backwards in time, step t reads step t + 1 whose rows all have a step t
+            for(int ti = 0; dirMode != 0u && ti < seqLen - 1;)
+            {
+                const int cur_batch = in_n.at(ti);
+                int end            = ti + 1;
+                while(end < seqLen - 1 && in_n.at(end) == cur_batch)
+                    end++;
+                add_recurrent(1,
+                              time_rows[ti],
+                              time_rows[end + 1] - time_rows[ti + 1],
+                              cur_batch,
+                              last_layer && end == seqLen - 1);
+                ti = end;
             }
         }
     }
@@ -28,6 +28,10 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/tensor.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
 
 namespace miopen {
 
@@ -51,6 +55,153 @@ int nextPow2(int v)
     }
 }
 
+// See Kernels/MIOpenSoftmaxOnline.cl for description. The kernels need every row to be
+// contiguous; returns false when it is not, so that the caller can fall back to the accurate
+// algorithm.
+static bool SoftmaxForwardOnline(const Handle& handle,
+                                 float alpha_fp,
+                                 float beta_fp,
+                                 const TensorDescriptor& xDesc,
+                                 ConstData_t x,
+                                 const TensorDescriptor& yDesc,
+                                 Data_t y,
+                                 miopenSoftmaxMode_t mode,
+                                 int x_offset,
+                                 int y_offset)
+{
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(yDesc.GetLengths());
+
+    const bool instance  = mode == MIOPEN_SOFTMAX_MODE_INSTANCE;
+    const auto row_major = [&](const TensorDescriptor& desc) {
+        const auto& str = desc.GetStrides();
+        return instance ? (str[1] == h * w && str[2] == w && str[3] == 1) : str[1] == 1;
+    };
+    if(!row_major(xDesc) || !row_major(yDesc))
+        return false;
+
+    const size_t grp      = 256;
+    const size_t len      = instance ? static_cast<size_t>(c) * h * w : c;
+    const size_t rows     = instance ? n : static_cast<size_t>(n) * h * w;
+    const unsigned row_hw = instance ? 1 : h * w;
+    const unsigned row_w  = instance ? 1 : w;
+    const size_t vec      = (len % 4 == 0) ? 4 : (len % 2 == 0) ? 2 : 1;
+
+    // Split long rows over several work-groups when there are too few rows for the device. The
+    // share of a work-item in a chunk is kept in up to 4 register vectors.
+    const size_t max_cache = 4;
+    const size_t min_grps  = 2 * handle.GetMaxComputeUnits();
+    size_t nblk            = 1;
+    size_t chunk           = len;
+    if(rows < min_grps && len > grp * vec * max_cache)
+    {
+        nblk  = std::min<size_t>({(len + grp * vec * max_cache - 1) / (grp * vec * max_cache),
+                                  (min_grps + rows - 1) / rows,
+                                  64});
+        chunk = ((len + nblk - 1) / nblk + grp * vec - 1) / (grp * vec) * (grp * vec);
+        nblk  = (len + chunk - 1) / chunk;
+    }
+    const size_t cache_vecs = (chunk / vec + grp - 1) / grp;
+    const size_t cache      = cache_vecs <= max_cache ? cache_vecs : 0;
+
+    const auto x_str = xDesc.GetStrides();
+    const auto y_str = yDesc.GetStrides();
+
+    std::string network_config =
+        "sfmonline-dt" + std::to_string(static_cast<int>(yDesc.GetType())) + "len" +
+        std::to_string(len) + "rows" + std::to_string(rows) + "v" + std::to_string(vec) + "blk" +
+        std::to_string(nblk) + "chunk" + std::to_string(chunk) + "cache" + std::to_string(cache) +
+        "a" + std::to_string(alpha_fp) + "b" + std::to_string(beta_fp);
+
+    std::string parms = GetDataTypeKernelParams(yDesc.GetType()) +
+                        " -DMIO_SFM_GRP=" + std::to_string(grp) +
+                        " -DMIO_SFM_LEN=" + std::to_string(len) +
+                        " -DMIO_SFM_VEC=" + std::to_string(vec) +
+                        " -DMIO_SFM_NBLK=" + std::to_string(nblk) +
+                        " -DMIO_SFM_CHUNK=" + std::to_string(chunk) +
+                        " -DMIO_SFM_CACHE=" + std::to_string(cache);
+    if(!float_equal(alpha_fp, 1.0))
+        parms += " -DUSE_ALPHA=1";
+    if(!float_equal(beta_fp, 0))
+        parms += " -DUSE_BETA=1";
+
+    const std::vector<size_t> vld{grp, 1, 1};
+    const std::string program_name = "MIOpenSoftmaxOnline.cl";
+
+    if(nblk == 1)
+    {
+        const std::vector<size_t> vgd{rows * grp, 1, 1};
+        const std::string algo_name = "SoftmaxForwardOnline";
+
+        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        auto kernel    = !kernels.empty() ? kernels.front()
+                                          : handle.AddKernel(algo_name,
+                                                             network_config,
+                                                             program_name,
+                                                             "SoftmaxOnlineForward",
+                                                             vld,
+                                                             vgd,
+                                                             parms);
+        kernel(x,
+               y,
+               row_hw,
+               row_w,
+               static_cast<unsigned>(x_str[0]),
+               static_cast<unsigned>(x_str[2]),
+               static_cast<unsigned>(x_str[3]),
+               static_cast<unsigned>(y_str[0]),
+               static_cast<unsigned>(y_str[2]),
+               static_cast<unsigned>(y_str[3]),
+               x_offset,
+               y_offset,
+               alpha_fp,
+               beta_fp);
+        return true;
+    }
+
+    MIOPEN_LOG_I2("Softmax rows of " << len << " elements split in " << nblk << " chunks");
+
+    // TODO - someday avoid slow malloc/free here
+    const auto ws = handle.Create(rows * nblk * 2 * sizeof(float));
+    const std::vector<size_t> vgd{nblk * grp, rows, 1};
+    const std::string algo_name = "SoftmaxForwardOnlineMultiBlock";
+
+    auto kernels = handle.GetKernels(algo_name, network_config);
+    if(kernels.empty())
+    {
+        handle.AddKernel(
+            algo_name, network_config, program_name, "SoftmaxOnlinePartial", vld, vgd, parms);
+        handle.AddKernel(
+            algo_name, network_config, program_name, "SoftmaxOnlineNorm", vld, vgd, parms);
+        kernels = handle.GetKernels(algo_name, network_config);
+    }
+
+    kernels[0](x,
+               ws.get(),
+               row_hw,
+               row_w,
+               static_cast<unsigned>(x_str[0]),
+               static_cast<unsigned>(x_str[2]),
+               static_cast<unsigned>(x_str[3]),
+               x_offset);
+    kernels[1](x,
+               y,
+               ws.get(),
+               row_hw,
+               row_w,
+               static_cast<unsigned>(x_str[0]),
+               static_cast<unsigned>(x_str[2]),
+               static_cast<unsigned>(x_str[3]),
+               static_cast<unsigned>(y_str[0]),
+               static_cast<unsigned>(y_str[2]),
+               static_cast<unsigned>(y_str[3]),
+               x_offset,
+               y_offset,
+               alpha_fp,
+               beta_fp);
+    return true;
+}
+
 miopenStatus_t SoftmaxForward(const Handle& handle,
                               const void* alpha,
                               const void* beta,
@@ -78,6 +229,30 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension lengths do not match.");
     }
 
+    auto alpha_fp = *(static_cast<const float*>(alpha));
+    auto beta_fp  = *(static_cast<const float*>(beta));
+
+    if(algorithm == MIOPEN_SOFTMAX_ONLINE)
+    {
+        if(SoftmaxForwardOnline(
+               handle, alpha_fp, beta_fp, xDesc, x, yDesc, y, mode, x_offset, y_offset))
+        {
+            if(miopen::CheckNumericsEnabled())
+            {
+                miopen::checkNumericsOutput(handle, yDesc, y);
+            }
+            return miopenStatusSuccess;
+        }
+        MIOPEN_LOG_I2("Softmax rows are not contiguous, using the accurate algorithm");
+        algorithm = MIOPEN_SOFTMAX_ACCURATE;
+    }
+
+    if(yDesc.GetType() != miopenHalf && yDesc.GetType() != miopenFloat)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Only the online softmax of contiguous rows supports this data type.");
+    }
+
     int n, c, h, w;
     std::tie(n, c, h, w) = tien<4>(yDesc.GetLengths());
 
@@ -104,9 +279,6 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
         usefp32 = false;
     }
 
-    auto alpha_fp = *(static_cast<const float*>(alpha));
-    auto beta_fp  = *(static_cast<const float*>(beta));
-
     // See Kernels/MIOpenSoftmax.cl for description
     if(num_batch == 1)
     { // CSR-Vector like approach
@@ -313,6 +485,145 @@ miopenStatus_t SoftmaxForward(const Handle& handle,
     return miopenStatusSuccess;
 }
 
+// See Kernels/MIOpenSoftmaxCrossEntropy.cl for description. The classes are the last dimension
+// of the tensor, which needs unit stride, and the leading dimensions have to collapse into rows
+// of a single stride.
+static void GetSoftmaxRows(const TensorDescriptor& desc, size_t& rows, size_t& row_stride)
+{
+    const auto& lens    = desc.GetLengths();
+    const auto& strides = desc.GetStrides();
+    const auto nd       = lens.size();
+    if(nd < 2 || strides[nd - 1] != 1)
+        MIOPEN_THROW(miopenStatusBadParm, "The classes have to be the innermost dimension.");
+
+    rows       = 1;
+    row_stride = strides[nd - 2];
+    for(size_t i = 0; i + 1 < nd; i++)
+    {
+        if(i + 2 < nd && strides[i] != strides[i + 1] * lens[i + 1])
+            MIOPEN_THROW(miopenStatusBadParm, "The rows of the tensor are not evenly strided.");
+        rows *= lens[i];
+    }
+}
+
+template <class... Args>
+static void RunSoftmaxCrossEntropy(const Handle& handle,
+                                   const std::string& kernel_name,
+                                   const TensorDescriptor& xDesc,
+                                   const TensorDescriptor* dxDesc,
+                                   Args&&... args)
+{
+    if(dxDesc != nullptr &&
+       (dxDesc->GetLengths() != xDesc.GetLengths() || dxDesc->GetType() != xDesc.GetType()))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "The gradient has to match the logits.");
+    }
+
+    size_t rows, x_rstr, dx_rstr = 0;
+    GetSoftmaxRows(xDesc, rows, x_rstr);
+    if(dxDesc != nullptr)
+        GetSoftmaxRows(*dxDesc, rows, dx_rstr);
+
+    const size_t grp        = 256;
+    const size_t len        = xDesc.GetLengths().back();
+    const size_t vec        = (len % 4 == 0) ? 4 : (len % 2 == 0) ? 2 : 1;
+    const size_t cache_vecs = (len / vec + grp - 1) / grp;
+    const size_t cache      = cache_vecs <= 4 ? cache_vecs : 0;
+    const int grad          = dxDesc != nullptr ? 1 : 0;
+
+    const std::string algo_name = "SoftmaxCrossEntropy";
+    const std::string network_config =
+        kernel_name + "dt" + std::to_string(static_cast<int>(xDesc.GetType())) + "len" +
+        std::to_string(len) + "rows" + std::to_string(rows) + "grad" + std::to_string(grad);
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(std::forward<Args>(args)...,
+                        static_cast<unsigned>(x_rstr),
+                        static_cast<unsigned>(dx_rstr));
+        return;
+    }
+
+    const std::string parms = GetDataTypeKernelParams(xDesc.GetType()) +
+                              " -DMIO_SFM_GRP=" + std::to_string(grp) +
+                              " -DMIO_SFM_LEN=" + std::to_string(len) +
+                              " -DMIO_SFM_VEC=" + std::to_string(vec) +
+                              " -DMIO_SFM_CACHE=" + std::to_string(cache) +
+                              " -DMIO_SCE_GRAD=" + std::to_string(grad);
+
+    const std::vector<size_t> vld{grp, 1, 1};
+    const std::vector<size_t> vgd{rows * grp, 1, 1};
+
+    handle.AddKernel(algo_name,
+                     network_config,
+                     "MIOpenSoftmaxCrossEntropy.cl",
+                     kernel_name,
+                     vld,
+                     vgd,
+                     parms)(std::forward<Args>(args)...,
+                            static_cast<unsigned>(x_rstr),
+                            static_cast<unsigned>(dx_rstr));
+}
+
+miopenStatus_t SoftmaxCrossEntropyForward(const Handle& handle,
+                                          const TensorDescriptor& xDesc,
+                                          ConstData_t x,
+                                          ConstData_t labels,
+                                          Data_t losses,
+                                          const TensorDescriptor& dxDesc,
+                                          Data_t dx)
+{
+    if(x == nullptr || labels == nullptr || losses == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Null pointer for tensor.");
+    }
+
+    RunSoftmaxCrossEntropy(handle,
+                           "SoftmaxCrossEntropyForward",
+                           xDesc,
+                           dx != nullptr ? &dxDesc : nullptr,
+                           x,
+                           labels,
+                           losses,
+                           dx);
+
+    if(miopen::CheckNumericsEnabled() && dx != nullptr)
+    {
+        miopen::checkNumericsOutput(handle, dxDesc, dx);
+    }
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t SoftmaxCrossEntropyBackward(const Handle& handle,
+                                           const TensorDescriptor& xDesc,
+                                           ConstData_t x,
+                                           ConstData_t labels,
+                                           ConstData_t dlosses,
+                                           const TensorDescriptor& dxDesc,
+                                           Data_t dx)
+{
+    if(x == nullptr || labels == nullptr || dlosses == nullptr || dx == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Null pointer for tensor.");
+    }
+
+    RunSoftmaxCrossEntropy(handle,
+                           "SoftmaxCrossEntropyBackward",
+                           xDesc,
+                           &dxDesc,
+                           x,
+                           labels,
+                           dlosses,
+                           dx);
+
+    if(miopen::CheckNumericsEnabled())
+    {
+        miopen::checkNumericsOutput(handle, dxDesc, dx);
+    }
+    return miopenStatusSuccess;
+}
+
 miopenStatus_t SoftmaxBackward(const Handle& handle,
                                const void* alpha,
                                const TensorDescriptor& yDesc,
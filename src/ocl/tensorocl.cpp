@@ -31,13 +31,19 @@
 #include <miopen/datatype.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/util.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/stringutils.hpp>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <numeric>
 #include <boost/range/combine.hpp>
 
 #define MIO_TENSOROCL_DEBUG 0
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TENSOR_OP_ELEMENTWISE)
+
 namespace miopen {
 
 TensorDescriptor GetFlattenedTensorDescriptor(const TensorDescriptor& desc)
@@ -179,7 +185,7 @@ void OpTensor3d(const Handle& handle,
 
     // for naive tensor ops
     size_t RD_BLCK              = (clens[2] % 4 == 0) ? 4 : (clens[2] % 2 == 0) ? 2 : 1;
-    const std::string data_type = GetDataType(bTensorDesc.GetType());
+    const std::string data_type = GetDataTypeStorage(bTensorDesc.GetType());
     const std::string READ_TYPE = (RD_BLCK == 1) ? data_type : data_type + std::to_string(RD_BLCK);
 
     size_t total_work = std::max(clens[2] / RD_BLCK, size_t(1));
@@ -301,7 +307,7 @@ void OpTensor3d(const Handle& handle,
             }
         }
 
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType());
+        std::string parms = " -DMIOPEN_TYPE=" + GetDataTypeStorage(bTensorDesc.GetType());
 
         parms += GetDataTypeKernelParams(aTensorDesc.GetType());
 
@@ -523,7 +529,7 @@ void OpTensor4d(const Handle& handle,
 #endif
 
     // for naive tensor ops
-    const std::string data_type = GetDataType(bTensorDesc.GetType());
+    const std::string data_type = GetDataTypeStorage(bTensorDesc.GetType());
 
     size_t TENS_LEN             = cTensorDesc.GetElementSize();
     size_t RD_BLCK              = (TENS_LEN % 4 == 0) ? 4 : (TENS_LEN % 2 == 0) ? 2 : 1;
@@ -735,7 +741,7 @@ void OpTensor4d(const Handle& handle,
             }
         }
 
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
+        std::string parms = " -DMIOPEN_TYPE=" + GetDataTypeStorage(bTensorDesc.GetType()) +
                             " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
         parms += GetDataTypeKernelParams(aTensorDesc.GetType());
@@ -1108,7 +1114,7 @@ void OpTensorOther(const Handle& handle,
             }
         }
 
-        std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
+        std::string parms = " -DMIOPEN_TYPE=" + GetDataTypeStorage(bTensorDesc.GetType()) +
                             " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
         parms += GetDataTypeKernelParams(aTensorDesc.GetType());
@@ -1221,6 +1227,213 @@ void OpTensorOther(const Handle& handle,
     });
 }
 
+namespace {
+
+struct ElementwiseDim
+{
+    std::size_t len;
+    std::size_t a_stride;
+    std::size_t b_stride;
+    std::size_t c_stride;
+};
+
+bool IsElementwiseType(miopenDataType_t type)
+{
+    return type == miopenFloat || type == miopenHalf || type == miopenBFloat16;
+}
+
+// The dedicated kernels cover b tensors whose non-unit dimensions are one contiguous run of the
+// dimensions of c, like a bias; anything else broadcasts through the generic kernels.
+bool IsSingleRunBroadcast(const std::vector<std::size_t>& blens,
+                          const std::vector<std::size_t>& clens)
+{
+    const auto first = std::find_if(blens.begin(), blens.end(), [](auto l) { return l != 1; });
+    if(first == blens.end())
+        return true;
+    const auto last = std::find_if(blens.rbegin(), blens.rend(), [](auto l) { return l != 1; });
+    for(auto i = std::distance(blens.begin(), first); i < std::distance(last, blens.rend()); ++i)
+    {
+        if(blens[i] != clens[i])
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void OpTensorElementwise(const Handle& handle,
+                         miopenTensorOp_t tensorOp,
+                         const void* alpha0,
+                         const TensorDescriptor& aTensorDesc,
+                         ConstData_t ATensor,
+                         const void* alpha1,
+                         const TensorDescriptor& bTensorDesc,
+                         ConstData_t BTensor,
+                         const void* beta,
+                         const TensorDescriptor& cTensorDesc,
+                         Data_t CTensor,
+                         const size_t Aoffset,
+                         const size_t Boffset,
+                         const size_t Coffset,
+                         miopenActivationMode_t activMode,
+                         double activAlpha,
+                         double activBeta,
+                         double activGamma)
+{
+    if(ATensor == nullptr || BTensor == nullptr || CTensor == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    const auto type = cTensorDesc.GetType();
+    if(aTensorDesc.GetType() != type || bTensorDesc.GetType() != type || !IsElementwiseType(type))
+        MIOPEN_THROW(miopenStatusBadParm, "The tensors have to share a floating point type");
+
+    const auto& clens = cTensorDesc.GetLengths();
+    const auto& blens = bTensorDesc.GetLengths();
+    if(aTensorDesc.GetLengths() != clens)
+        MIOPEN_THROW(miopenStatusBadParm, "A and C Tensors do not match");
+    if(blens.size() != clens.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Number of dims in B and C Tensors do not match");
+
+    std::vector<ElementwiseDim> dims;
+    for(std::size_t i = 0; i < clens.size(); ++i)
+    {
+        if(blens[i] != 1 && blens[i] != clens[i])
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "BTensor dim != 1 && BTensor dim != CTensor dim: " + std::to_string(i));
+        const auto len = clens[i];
+        if(len == 0)
+            return;
+        if(len == 1)
+            continue;
+
+        const auto dim = ElementwiseDim{len,
+                                        aTensorDesc.GetStrides()[i],
+                                        blens[i] == 1 ? 0 : bTensorDesc.GetStrides()[i],
+                                        cTensorDesc.GetStrides()[i]};
+        // A dimension that follows the previous one in all the tensors extends it.
+        if(!dims.empty() && dims.back().a_stride == dim.a_stride * len &&
+           dims.back().b_stride == dim.b_stride * len && dims.back().c_stride == dim.c_stride * len)
+        {
+            dims.back() = ElementwiseDim{
+                dims.back().len * len, dim.a_stride, dim.b_stride, dim.c_stride};
+            continue;
+        }
+        dims.push_back(dim);
+    }
+    if(dims.empty())
+        dims.push_back({1, 1, 0, 1});
+
+    if(std::any_of(dims.begin(), dims.end(), [](const ElementwiseDim& d) {
+           return d.len > std::numeric_limits<uint32_t>::max();
+       }))
+        MIOPEN_THROW(miopenStatusBadParm, "A tensor dimension is too long for the operation");
+
+    const auto& inner = dims.back();
+    std::size_t vec   = 1;
+    if(inner.a_stride == 1 && inner.c_stride == 1 && inner.b_stride <= 1)
+    {
+        for(vec = 16 / GetTypeSize(type); vec > 1 && inner.len % vec != 0; vec /= 2)
+            ;
+        vec = std::min<std::size_t>(vec, 8);
+    }
+    const bool b_vec = inner.b_stride != 0 || vec == 1;
+
+    const auto total = std::accumulate(
+        dims.begin(), dims.end(), std::size_t{1}, [](auto a, const ElementwiseDim& d) {
+            return a * d.len;
+        }) / vec;
+
+    const std::size_t local_size = 256;
+    const std::size_t max_groups = 4096;
+    const auto groups = std::min((total + local_size - 1) / local_size, max_groups);
+
+    const std::vector<size_t> vld{local_size, 1, 1};
+    const std::vector<size_t> vgd{groups * local_size, 1, 1};
+
+    auto join = [&](auto f) {
+        std::vector<std::string> items;
+        std::transform(dims.begin(), dims.end(), std::back_inserter(items), [&](const auto& d) {
+            return std::to_string(f(d));
+        });
+        return JoinStrings(items, ",");
+    };
+    const auto lens      = join([](const ElementwiseDim& d) { return d.len; });
+    const auto a_strides = join([](const ElementwiseDim& d) { return d.a_stride; });
+    const auto b_strides = join([](const ElementwiseDim& d) { return d.b_stride; });
+    const auto c_strides = join([](const ElementwiseDim& d) { return d.c_stride; });
+
+    const bool activ = activMode != miopenActivationPASTHRU;
+
+    const std::string kernel_name    = "MIOpenTensorOpElementwise";
+    const std::string network_config = "ew-t" + std::to_string(type) + "-op" +
+                                       std::to_string(tensorOp) + "-act" +
+                                       std::to_string(activ ? activMode : 0) + "-l" + lens +
+                                       "-a" + a_strides + "-b" + b_strides + "-c" + c_strides +
+                                       "-v" + std::to_string(vec) + "-g" + std::to_string(groups);
+
+    const auto miopen_alpha0 = *(static_cast<const float*>(alpha0));
+    const auto miopen_alpha1 = *(static_cast<const float*>(alpha1));
+    const auto miopen_beta   = *(static_cast<const float*>(beta));
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(ATensor,
+                        BTensor,
+                        CTensor,
+                        miopen_alpha0,
+                        miopen_alpha1,
+                        miopen_beta,
+                        static_cast<float>(activGamma),
+                        static_cast<float>(activBeta),
+                        static_cast<float>(activAlpha),
+                        static_cast<uint64_t>(Aoffset),
+                        static_cast<uint64_t>(Boffset),
+                        static_cast<uint64_t>(Coffset),
+                        static_cast<uint64_t>(total));
+        return;
+    }
+
+    const int rne_bf16          = MIOPEN_USE_RNE_BFLOAT16;
+    const std::string type_name = (type == miopenFloat) ? "float"
+                                  : (type == miopenHalf) ? "half" : "ushort";
+
+    std::string parms =
+        " -DMIO_EW_T=" + type_name +
+        " -DMIO_EW_FP16=" + std::to_string(static_cast<int>(type == miopenHalf)) +
+        " -DMIO_EW_BF16=" + std::to_string(static_cast<int>(type == miopenBFloat16)) +
+        " -DMIOPEN_USE_RNE_BFLOAT16=" + std::to_string(rne_bf16) +
+        " -DMIO_EW_OP=" + std::to_string(static_cast<int>(tensorOp)) +
+        " -DMIO_EW_ACTIV=" + std::to_string(static_cast<int>(activ)) +
+        " -DMIOPEN_NRN_OP_ID=" + std::to_string(activ ? activMode : 0) +
+        " -DMIO_EW_RANK=" + std::to_string(dims.size()) + " -DMIO_EW_LENS=" + lens +
+        " -DMIO_EW_A_STRIDES=" + a_strides + " -DMIO_EW_B_STRIDES=" + b_strides +
+        " -DMIO_EW_C_STRIDES=" + c_strides + " -DMIO_EW_VEC=" + std::to_string(vec) +
+        " -DMIO_EW_B_VEC=" + std::to_string(static_cast<int>(b_vec));
+
+    MIOPEN_LOG_I2(kernel_name << ":: " << parms);
+
+    handle.AddKernel(kernel_name,
+                     network_config,
+                     "MIOpenTensorElementwise.cl",
+                     kernel_name,
+                     vld,
+                     vgd,
+                     parms)(ATensor,
+                            BTensor,
+                            CTensor,
+                            miopen_alpha0,
+                            miopen_alpha1,
+                            miopen_beta,
+                            static_cast<float>(activGamma),
+                            static_cast<float>(activBeta),
+                            static_cast<float>(activAlpha),
+                            static_cast<uint64_t>(Aoffset),
+                            static_cast<uint64_t>(Boffset),
+                            static_cast<uint64_t>(Coffset),
+                            static_cast<uint64_t>(total));
+}
+
 void OpTensor(const Handle& handle,
               miopenTensorOp_t tensorOp,
               const void* alpha0,
@@ -1288,6 +1501,30 @@ void OpTensor(const Handle& handle,
         }
     }
 
+    // The generic kernel takes the 5-d tensors and the broadcasts the dedicated ones handle
+    // poorly.
+    if(!is_squash && !miopen::IsDisabled(MIOPEN_DEBUG_TENSOR_OP_ELEMENTWISE{}) &&
+       IsElementwiseType(cTensorDesc.GetType()) && aTensorDesc.GetType() == cTensorDesc.GetType() &&
+       aTensorDesc.GetLengths() == clens &&
+       (clens.size() == 5 || !IsSingleRunBroadcast(blens, clens)))
+    {
+        OpTensorElementwise(handle,
+                            tensorOp,
+                            alpha0,
+                            aTensorDesc,
+                            ATensor,
+                            alpha1,
+                            bTensorDesc,
+                            BTensor,
+                            beta,
+                            cTensorDesc,
+                            CTensor,
+                            Aoffset,
+                            Boffset,
+                            Coffset);
+        return;
+    }
+
     auto bsize = blens.size();
     if(bsize == 3)
     {
@@ -1389,6 +1626,22 @@ static std::vector<std::size_t> get_worker_sizes(const std::vector<std::size_t>&
     return worker_sizes;
 }
 
+// Returns the length of the shortest pattern of 1, 2 or 4 bytes that repeats to the \p size bytes
+// at \p value, or 0 when there is none.
+static std::size_t GetFillPatternSize(const void* value, std::size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(value);
+    for(std::size_t pattern = 1; pattern <= 4 && pattern <= size; pattern *= 2)
+    {
+        bool repeats = size % pattern == 0;
+        for(std::size_t i = pattern; repeats && i < size; ++i)
+            repeats = bytes[i] == bytes[i % pattern];
+        if(repeats)
+            return pattern;
+    }
+    return 0;
+}
+
 void SetTensor(const Handle& handle,
                const TensorDescriptor& yDesc,
                Data_t y,
@@ -1415,10 +1668,26 @@ void SetTensor(const Handle& handle,
 
     assert(yDim_flat > 0 && yDim_flat <= 5);
 
-    std::string kernel_name = "SubTensorOpWithScalar" + std::to_string(yDim_flat) + "d";
-
     const miopenDataType_t dataType = yDesc_flat.GetType();
 
+    // A contiguous tensor is filled like memset does, without compiling a kernel.
+    if(yDim_flat == 1 && yDesc_flat.GetStrides()[0] == 1 && dataType != miopenInt8x4)
+    {
+        const auto type_size    = GetTypeSize(dataType);
+        const auto pattern_size = GetFillPatternSize(alpha, type_size);
+        if(pattern_size != 0)
+        {
+            handle.FillAsync(y,
+                             offset * type_size,
+                             yDesc_flat.GetLengths()[0] * type_size,
+                             alpha,
+                             pattern_size);
+            return;
+        }
+    }
+
+    std::string kernel_name = "SubTensorOpWithScalar" + std::to_string(yDim_flat) + "d";
+
     std::string network_config = "set " + std::to_string(dataType);
     for(auto& len : yDesc_flat.GetLengths())
     {
@@ -1749,6 +2018,32 @@ void CopyTensor(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension sizes unsupported.");
     }
 
+    // Tensors made of contiguous rows are copied by the copy engines without compiling a kernel.
+    // Narrow rows keep the kernel, which moves them faster.
+    const auto type_size          = GetTypeSize(srcDesc_flat.GetType());
+    const std::size_t min_row_len = 256;
+    if(srcDesc_flat.GetType() != miopenInt8x4 && srcDim_flat <= 2 &&
+       srcDesc_flat.GetStrides().back() == 1 && dstDesc_flat.GetStrides().back() == 1)
+    {
+        const auto width     = srcDesc_flat.GetLengths().back() * type_size;
+        const auto height    = srcDim_flat == 2 ? srcDesc_flat.GetLengths()[0] : 1;
+        const auto src_pitch = srcDim_flat == 2 ? srcDesc_flat.GetStrides()[0] * type_size : width;
+        const auto dst_pitch = srcDim_flat == 2 ? dstDesc_flat.GetStrides()[0] * type_size : width;
+
+        if(src_pitch >= width && dst_pitch >= width && (height == 1 || width >= min_row_len))
+        {
+            handle.Copy2DAsync(src,
+                               srcOffset * type_size,
+                               src_pitch,
+                               dst,
+                               dstOffset * type_size,
+                               dst_pitch,
+                               width,
+                               height);
+            return;
+        }
+    }
+
     if(srcOffset > 0 || dstOffset > 0 || (!(srcDesc_flat.IsPacked() && dstDesc_flat.IsPacked())))
     {
         std::string kernel_name = "SubTensorOpWithSubTensor" + std::to_string(srcDim_flat) + "d";
@@ -1891,7 +2186,7 @@ void CopyTensor(const Handle& handle,
     }
     else
     {
-        handle.Copy(src, dst, srcDesc_flat.GetElementSize() * GetTypeSize(srcDesc_flat.GetType()));
+        handle.Copy(src, dst, srcDesc_flat.GetElementSize() * type_size);
     }
 }
 
@@ -2120,6 +2415,133 @@ void CastTensor(const Handle& handle,
     }
 }
 
+// Casts, copies with arbitrary strides and scales in one pass for tensors of different types, so
+// the callers do not need a temporary tensor of either type between CastTensor and the transform.
+static void TransformCastTensor(const Handle& handle,
+                                const void* alpha,
+                                const TensorDescriptor& xDesc,
+                                ConstData_t x,
+                                const void* beta,
+                                const TensorDescriptor& yDesc,
+                                Data_t y,
+                                size_t Xoffset,
+                                size_t Yoffset)
+{
+    const auto x_type = xDesc.GetType();
+    const auto y_type = yDesc.GetType();
+    // Rejects the types the kernel has no conversion for.
+    const auto type_parms = GetCastTensorBuildOptionFromType(" -DMIOPEN_SRC_TYPE=", x_type) +
+                            GetCastTensorBuildOptionFromType(" -DMIOPEN_DST_TYPE=", y_type);
+
+    const auto& lens = yDesc.GetLengths();
+
+    std::vector<ElementwiseDim> dims;
+    for(std::size_t i = 0; i < lens.size(); ++i)
+    {
+        const auto len = lens[i];
+        if(len == 0)
+            return;
+        if(len == 1)
+            continue;
+
+        const auto dim = ElementwiseDim{len, xDesc.GetStrides()[i], 0, yDesc.GetStrides()[i]};
+        // A dimension that follows the previous one in both tensors extends it.
+        if(!dims.empty() && dims.back().a_stride == dim.a_stride * len &&
+           dims.back().c_stride == dim.c_stride * len)
+        {
+            dims.back() = ElementwiseDim{dims.back().len * len, dim.a_stride, 0, dim.c_stride};
+            continue;
+        }
+        dims.push_back(dim);
+    }
+    if(dims.empty())
+        dims.push_back({1, 1, 0, 1});
+
+    if(std::any_of(dims.begin(), dims.end(), [](const ElementwiseDim& d) {
+           return d.len > std::numeric_limits<uint32_t>::max();
+       }))
+        MIOPEN_THROW(miopenStatusBadParm, "A tensor dimension is too long for the operation");
+
+    const auto& inner = dims.back();
+    std::size_t vec   = 1;
+    if(inner.a_stride == 1 && inner.c_stride == 1)
+    {
+        const auto type_size = std::max(GetTypeSize(x_type), GetTypeSize(y_type));
+        for(vec = 16 / type_size; vec > 1 && inner.len % vec != 0; vec /= 2)
+            ;
+        vec = std::min<std::size_t>(vec, 8);
+    }
+
+    const auto total = std::accumulate(
+        dims.begin(), dims.end(), std::size_t{1}, [](auto a, const ElementwiseDim& d) {
+            return a * d.len;
+        }) / vec;
+
+    const std::size_t local_size = 256;
+    const std::size_t max_groups = 4096;
+    const auto groups = std::min((total + local_size - 1) / local_size, max_groups);
+
+    const std::vector<size_t> vld{local_size, 1, 1};
+    const std::vector<size_t> vgd{groups * local_size, 1, 1};
+
+    auto join = [&](auto f) {
+        std::vector<std::string> items;
+        std::transform(dims.begin(), dims.end(), std::back_inserter(items), [&](const auto& d) {
+            return std::to_string(f(d));
+        });
+        return JoinStrings(items, ",");
+    };
+    const auto dim_lens  = join([](const ElementwiseDim& d) { return d.len; });
+    const auto x_strides = join([](const ElementwiseDim& d) { return d.a_stride; });
+    const auto y_strides = join([](const ElementwiseDim& d) { return d.c_stride; });
+
+    const std::string kernel_name    = "MIOpenTransformCastTensor";
+    const std::string network_config = "tc-x" + std::to_string(x_type) + "-y" +
+                                       std::to_string(y_type) + "-l" + dim_lens + "-xs" +
+                                       x_strides + "-ys" + y_strides + "-v" +
+                                       std::to_string(vec) + "-g" + std::to_string(groups);
+
+    const auto miopen_alpha = *(static_cast<const float*>(alpha));
+    const auto miopen_beta  = *(static_cast<const float*>(beta));
+
+    auto&& kernels = handle.GetKernels(kernel_name, network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(x,
+                        y,
+                        miopen_alpha,
+                        miopen_beta,
+                        static_cast<uint64_t>(Xoffset),
+                        static_cast<uint64_t>(Yoffset),
+                        static_cast<uint64_t>(total));
+        return;
+    }
+
+    const int rne_bf16 = MIOPEN_USE_RNE_BFLOAT16;
+
+    std::string parms = type_parms + " -DMIOPEN_USE_RNE_BFLOAT16=" + std::to_string(rne_bf16) +
+                        " -DMIO_TC_RANK=" + std::to_string(dims.size()) +
+                        " -DMIO_TC_LENS=" + dim_lens + " -DMIO_TC_X_STRIDES=" + x_strides +
+                        " -DMIO_TC_Y_STRIDES=" + y_strides +
+                        " -DMIO_TC_VEC=" + std::to_string(vec);
+
+    MIOPEN_LOG_I2(kernel_name << ":: " << parms);
+
+    handle.AddKernel(kernel_name,
+                     network_config,
+                     "MIOpenTransformCastTensor.cl",
+                     kernel_name,
+                     vld,
+                     vgd,
+                     parms)(x,
+                            y,
+                            miopen_alpha,
+                            miopen_beta,
+                            static_cast<uint64_t>(Xoffset),
+                            static_cast<uint64_t>(Yoffset),
+                            static_cast<uint64_t>(total));
+}
+
 void TransformTensor(const Handle& handle,
                      const void* alpha,
                      const TensorDescriptor& xDesc,
@@ -2234,6 +2656,12 @@ void TransformTensor(const Handle& handle,
             MIOPEN_THROW("Tensor x and y spatial sizes do not match");
         }
 
+        if(xDesc.GetType() != yDesc.GetType())
+        {
+            TransformCastTensor(handle, alpha, xDesc, x, beta, yDesc, y, Xoffset, Yoffset);
+            return;
+        }
+
         auto flat_descriptors              = GetConsistentFlattenedTensorDescriptors(xDesc, yDesc);
         const TensorDescriptor& xDesc_flat = std::get<0>(flat_descriptors);
         const TensorDescriptor& yDesc_flat = std::get<1>(flat_descriptors);
@@ -29,13 +29,22 @@
 #include <miopen/logger.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/datatype.hpp>
+#include <miopen/env.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/tensor.hpp>
 
 #include <boost/range/adaptors.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 #define WG_SIZE 256
 #define MAX_ACTIVE_THREADS (64 * 4 * 64)
 #define MAX_LOCAL_MEM 65536
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TRANSPOSE_TILE)
+
 namespace miopen {
 
 float Im2d2ColGPU(const Handle& handle,
@@ -67,8 +76,8 @@ float Im2d2ColGPU(const Handle& handle,
         "_" + std::to_string(in_w) +
         "w" + std::to_string(wei_h) +
         "_" + std::to_string(wei_w) +
-        "p" + std::to_string(pad_h) +
-        "_" + std::to_string(pad_w) +
+        "o" + std::to_string(out_h) +
+        "_" + std::to_string(out_w) +
         "s" + std::to_string(stride_h) +
         "_" + std::to_string(stride_w) +
         "d" + std::to_string(dilation_h) +
@@ -108,8 +117,12 @@ float Im2d2ColGPU(const Handle& handle,
         const int c_pack = type == miopenInt8x4 ? c / 4 : c;
 
         std::string params;
+        // Chunked im2col converts a few output rows of a taller image, its rows are only read
+        // through the tiles.
+        const bool whole_im_in_lds = in_h <= (out_h - 1) * stride_h + (wei_h - 1) * dilation_h + 1;
         int num_ch_per_wg;
-        if((out_h <= 8 && out_w <= 8) && (stride_h == 1 && stride_w == 1) && (c_pack % 4 == 0))
+        if((out_h <= 8 && out_w <= 8) && (stride_h == 1 && stride_w == 1) && (c_pack % 4 == 0) &&
+           whole_im_in_lds)
             num_ch_per_wg = 4;
         else
             num_ch_per_wg = 1;
@@ -187,6 +200,7 @@ float Im2d2ColGPU(const Handle& handle,
         params += " -DNUM_IM_BLKS=" + std::to_string(num_blks);
         params += " -DLOCAL_MEM_SIZE=" + std::to_string(local_mem_sz);
         params += " -DSTRIDE_GT_1=" + std::to_string(static_cast<int>(stride_h * stride_w > 1));
+        params += " -DWHOLE_IM_IN_LDS=" + std::to_string(static_cast<int>(whole_im_in_lds));
         params += " -DTILE_SZ_X=" + std::to_string(tile_sz_x);
         params += " -DTILE_SZ_Y=" + std::to_string(tile_sz_y);
         params += " -DUSE_IM_OFF_GUARD=1";
@@ -197,7 +211,7 @@ float Im2d2ColGPU(const Handle& handle,
         size_t global_threads = 256 * std::max(1, (c_pack / num_ch_per_wg)) * num_blks;
         const std::vector<size_t> vgd{global_threads, 1, 1};
         handle.AddKernel(
-            "miopenIm2Col", network_config, program_name, kernel_name, vld, vgd, params)(
+            "miopenIm2d2Col", network_config, program_name, kernel_name, vld, vgd, params)(
             data_size_bound_pack,
             im,
             im_offset_pack,
@@ -256,9 +270,9 @@ float Im3d2ColGPU(const Handle& handle,
         "w" + std::to_string(wei_d) +
         "_" + std::to_string(wei_h) +
         "_" + std::to_string(wei_w) +
-        "p" + std::to_string(pad_d) +
-        "_" + std::to_string(pad_h) +
-        "_" + std::to_string(pad_w) +
+        "o" + std::to_string(out_d) +
+        "_" + std::to_string(out_h) +
+        "_" + std::to_string(out_w) +
         "s" + std::to_string(stride_d) +
         "_" + std::to_string(stride_h) +
         "_" + std::to_string(stride_w) +
@@ -1115,6 +1129,20 @@ float transpose_packed_MN2NM(const Handle& handle,
         MIOPEN_THROW("transpose_packed_MN2NM only meant for int8 variants.");
     }
 
+    if(type == miopenInt8)
+    {
+        const auto m_ = static_cast<std::size_t>(m);
+        const auto n_ = static_cast<std::size_t>(n);
+        return PermuteTensorGPU(handle,
+                                TensorDescriptor{type, {m_, n_}},
+                                in,
+                                TensorDescriptor{type, {n_, m_}},
+                                out,
+                                {1, 0},
+                                in_offset,
+                                out_offset);
+    }
+
     size_t ld0 = WG_SIZE;
     size_t gd0 = m * n;
     const std::vector<size_t> vld{ld0, 1, 1};
@@ -1136,4 +1164,193 @@ float transpose_packed_MN2NM(const Handle& handle,
 
     return handle.GetKernelTime();
 }
+namespace {
+
+struct PermuteDim
+{
+    std::size_t len;
+    std::size_t in_stride;
+    std::size_t out_stride;
+};
+
+std::string GetPermuteTypeName(miopenDataType_t type, bool convert)
+{
+    switch(type)
+    {
+    case miopenFloat: return "float";
+    case miopenHalf: return convert ? "half" : "ushort";
+    case miopenBFloat16: return "ushort";
+    case miopenInt8: return "char";
+    case miopenInt32: return "int";
+    case miopenInt8x4:
+    case miopenDouble: break;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Unsupported data type of a tensor permutation");
+}
+
+bool IsFloatingPoint(miopenDataType_t type)
+{
+    return type == miopenFloat || type == miopenHalf || type == miopenBFloat16;
+}
+
+template <class F>
+std::string JoinDims(const std::vector<PermuteDim>& dims, F f)
+{
+    std::vector<std::string> items;
+    std::transform(dims.begin(), dims.end(), std::back_inserter(items), [&](const PermuteDim& d) {
+        return std::to_string(f(d));
+    });
+    return JoinStrings(items, ",");
+}
+
+} // namespace
+
+float PermuteTensorGPU(const Handle& handle,
+                       const TensorDescriptor& xDesc,
+                       ConstData_t x,
+                       const TensorDescriptor& yDesc,
+                       Data_t y,
+                       const std::vector<int>& perm,
+                       std::size_t x_offset,
+                       std::size_t y_offset)
+{
+    const auto rank = xDesc.GetSize();
+    if(yDesc.GetSize() != rank || perm.size() != rank)
+        MIOPEN_THROW(miopenStatusBadParm, "The permutation does not match the tensor ranks");
+
+    auto seen = std::vector<bool>(rank, false);
+    for(auto p : perm)
+    {
+        if(p < 0 || p >= static_cast<int>(rank) || seen[p])
+            MIOPEN_THROW(miopenStatusBadParm, "Invalid tensor permutation");
+        seen[p] = true;
+    }
+
+    const auto in_type  = xDesc.GetType();
+    const auto out_type = yDesc.GetType();
+    const bool convert  = in_type != out_type;
+    if(convert && !(IsFloatingPoint(in_type) && IsFloatingPoint(out_type)))
+        MIOPEN_THROW(miopenStatusBadParm, "Only float, half and bfloat16 convert on permutation");
+
+    // Everything is described in the output order from here on.
+    std::vector<PermuteDim> dims;
+    for(std::size_t i = 0; i < rank; ++i)
+    {
+        const auto len = yDesc.GetLengths()[i];
+        if(len != xDesc.GetLengths()[perm[i]])
+            MIOPEN_THROW(miopenStatusBadParm, "The tensor lengths do not match the permutation");
+        if(len == 0)
+            return 0.f;
+        if(len == 1)
+            continue;
+
+        const auto dim = PermuteDim{len, xDesc.GetStrides()[perm[i]], yDesc.GetStrides()[i]};
+        // A dimension that follows the previous one in both tensors extends it.
+        if(!dims.empty() && dims.back().in_stride == dim.in_stride * dim.len &&
+           dims.back().out_stride == dim.out_stride * dim.len)
+        {
+            dims.back() = PermuteDim{dims.back().len * dim.len, dim.in_stride, dim.out_stride};
+            continue;
+        }
+        dims.push_back(dim);
+    }
+    if(dims.empty())
+        dims.push_back({1, 1, 1});
+
+    if(std::any_of(dims.begin(), dims.end(), [](const PermuteDim& d) {
+           return d.len > std::numeric_limits<uint32_t>::max();
+       }))
+        MIOPEN_THROW(miopenStatusBadParm, "A tensor dimension is too long for the permutation");
+
+    const auto last = dims.size() - 1;
+    const auto q    = std::distance(
+        dims.begin(), std::min_element(dims.begin(), dims.end(), [](const auto& a, const auto& b) {
+            return a.in_stride < b.in_stride;
+        }));
+    const bool tiled = static_cast<std::size_t>(q) != last;
+
+    std::size_t vec = 1;
+    if(!tiled && dims[last].in_stride == 1 && dims[last].out_stride == 1)
+    {
+        const auto max_vec =
+            16 / std::max(GetTypeSize(in_type), GetTypeSize(out_type)); // 128-bit accesses
+        for(vec = std::min<std::size_t>(max_vec, 4); dims[last].len % vec != 0; vec /= 2)
+            ;
+    }
+
+    // The tile size is the tuning knob of the staged variant, a work-group is always 256 wide.
+    std::size_t tile = miopen::Value(MIOPEN_DEBUG_TRANSPOSE_TILE{});
+    if(tile != 16 && tile != 32 && tile != 64)
+        tile = (dims[q].len <= 16 || dims[last].len <= 16) ? 16 : 32;
+    const auto rows = 256 / tile;
+
+    const auto rest = std::accumulate(
+        dims.begin(), dims.end(), std::size_t{1}, [](auto a, const PermuteDim& d) {
+            return a * d.len;
+        });
+
+    std::vector<size_t> vld;
+    std::vector<size_t> vgd;
+    if(tiled)
+    {
+        vld = {tile, rows, 1};
+        vgd = {(dims[q].len + tile - 1) / tile * tile,
+               (dims[last].len + tile - 1) / tile * rows,
+               rest / dims[q].len / dims[last].len};
+    }
+    else
+    {
+        const auto items = dims[last].len / vec;
+        const auto ld0   = std::min<std::size_t>(256, (items + 63) / 64 * 64);
+        vld              = {ld0, 1, 1};
+        vgd              = {(items + ld0 - 1) / ld0 * ld0, rest / dims[last].len, 1};
+    }
+
+    const auto lens        = JoinDims(dims, [](const PermuteDim& d) { return d.len; });
+    const auto in_strides  = JoinDims(dims, [](const PermuteDim& d) { return d.in_stride; });
+    const auto out_strides = JoinDims(dims, [](const PermuteDim& d) { return d.out_stride; });
+
+    const std::string algo_name   = "miopenPermuteTensor";
+    const std::string kernel_name = tiled ? "MIOpenPermuteTile" : "MIOpenPermuteCopy";
+    const std::string network_config =
+        kernel_name + "-t" + std::to_string(in_type) + "-" + std::to_string(out_type) + "-l" +
+        lens + "-i" + in_strides + "-o" + out_strides + "-v" + std::to_string(vec) + "-tl" +
+        std::to_string(tile);
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    if(!kernels.empty())
+    {
+        kernels.front()(x, y, static_cast<uint64_t>(x_offset), static_cast<uint64_t>(y_offset));
+    }
+    else
+    {
+        const int use_fp16 = convert && (in_type == miopenHalf || out_type == miopenHalf);
+        const int in_bf16  = convert && in_type == miopenBFloat16;
+        const int out_bf16 = convert && out_type == miopenBFloat16;
+        const int rne_bf16 = MIOPEN_USE_RNE_BFLOAT16;
+
+        std::string params = " -DMIO_PERM_IN_T=" + GetPermuteTypeName(in_type, convert) +
+                             " -DMIO_PERM_OUT_T=" + GetPermuteTypeName(out_type, convert) +
+                             " -DMIO_PERM_CONVERT=" + std::to_string(static_cast<int>(convert)) +
+                             " -DMIO_PERM_USE_FP16=" + std::to_string(use_fp16) +
+                             " -DMIO_PERM_IN_BF16=" + std::to_string(in_bf16) +
+                             " -DMIO_PERM_OUT_BF16=" + std::to_string(out_bf16) +
+                             " -DMIOPEN_USE_RNE_BFLOAT16=" + std::to_string(rne_bf16) +
+                             " -DMIO_PERM_RANK=" + std::to_string(dims.size()) +
+                             " -DMIO_PERM_LENS=" + lens + " -DMIO_PERM_IN_STRIDES=" + in_strides +
+                             " -DMIO_PERM_OUT_STRIDES=" + out_strides +
+                             " -DMIO_PERM_Q=" + std::to_string(q) +
+                             " -DMIO_PERM_VEC=" + std::to_string(vec) +
+                             " -DMIO_PERM_TILE=" + std::to_string(tile) +
+                             " -DMIO_PERM_ROWS=" + std::to_string(rows);
+
+        MIOPEN_LOG_I2(kernel_name << ":: " << params);
+
+        handle.AddKernel(
+            algo_name, network_config, "MIOpenPermute.cl", kernel_name, vld, vgd, params)(
+            x, y, static_cast<uint64_t>(x_offset), static_cast<uint64_t>(y_offset));
+    }
+
+    return handle.GetKernelTime();
+}
 } // namespace miopen
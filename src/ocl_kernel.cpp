@@ -90,6 +90,7 @@ void OCLKernelInvoke::run() const
     {
         clWaitForEvents(1, &ev);
         callback(ev);
+        clReleaseEvent(ev);
     }
 }
 
@@ -0,0 +1,151 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/online_tuning.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <utility>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_ONLINE_TUNING)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_ONLINE_TUNING_INTERVAL)
+
+namespace miopen {
+
+bool IsOnlineTuningEnabled() { return IsEnabled(MIOPEN_ONLINE_TUNING{}); }
+
+const OnlineTuningConfig& GetOnlineTuningConfig()
+{
+    static const auto config = [] {
+        auto ret     = OnlineTuningConfig{};
+        ret.interval = Value(MIOPEN_ONLINE_TUNING_INTERVAL{}, ret.interval);
+        ret.interval = std::max<std::size_t>(ret.interval, 1);
+        return ret;
+    }();
+    return config;
+}
+
+bool OnlineTuner::HasCandidates(const std::string& problem) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto state = states.find(problem);
+    return state != states.end() && state->second.has_candidates;
+}
+
+void OnlineTuner::SetCandidates(const std::string& problem, std::vector<Candidate> candidates)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& state          = states[problem];
+    state.candidates     = std::move(candidates);
+    state.has_candidates = true;
+}
+
+boost::optional<std::string> OnlineTuner::Next(const std::string& problem,
+                                               const std::string& requested,
+                                               std::size_t workspace_limit)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& state = states[problem];
+    if(++state.calls % config.interval != 0)
+        return boost::none;
+
+    const Candidate* next = nullptr;
+    auto fewest           = std::size_t{0};
+    for(const auto& candidate : state.candidates)
+    {
+        if(candidate.solver == requested || candidate.workspace > workspace_limit)
+            continue;
+        const auto samples = state.samples.find(candidate.solver);
+        const auto total   = samples == state.samples.end() ? 0 : samples->second.total;
+        if(next == nullptr || total < fewest)
+        {
+            next   = &candidate;
+            fewest = total;
+        }
+    }
+
+    if(next == nullptr)
+        return boost::none;
+    return next->solver;
+}
+
+void OnlineTuner::Record(const std::string& problem, const std::string& solver, float time)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& samples = states[problem].samples[solver];
+    if(samples.recent.size() < config.samples)
+        samples.recent.push_back(time);
+    else
+        samples.recent[samples.next] = time;
+    samples.next = (samples.next + 1) % config.samples;
+    ++samples.total;
+}
+
+boost::optional<OnlineTuner::Promotion> OnlineTuner::TakeWinner(const std::string& problem,
+                                                                const std::string& incumbent)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& state = states[problem];
+
+    const auto incumbent_samples = state.samples.find(incumbent);
+    if(incumbent_samples == state.samples.end() ||
+       incumbent_samples->second.recent.size() < config.min_samples)
+        return boost::none;
+
+    auto best = Promotion{};
+    best.incumbent_time = Summarize(incumbent_samples->second);
+    best.time           = best.incumbent_time;
+
+    for(const auto& samples : state.samples)
+    {
+        if(samples.first == incumbent || samples.second.recent.size() < config.min_samples)
+            continue;
+        const auto time = Summarize(samples.second);
+        if(CompareFindTiming(time, best.incumbent_time, config.margin) < 0 &&
+           time.time < best.time.time)
+        {
+            best.solver = samples.first;
+            best.time   = time;
+        }
+    }
+
+    if(best.solver.empty() || best.solver == state.promoted)
+        return boost::none;
+
+    state.promoted = best.solver;
+    MIOPEN_LOG_I("Online tuning: " << best.solver << " (" << best.time.time << " ms) beats "
+                                   << incumbent << " (" << best.incumbent_time.time << " ms)");
+    return best;
+}
+
+FindTiming OnlineTuner::Summarize(const Samples& samples) const
+{
+    return SummarizeFindTiming(samples.recent, FindTimingStat::Median);
+}
+
+} // namespace miopen
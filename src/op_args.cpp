@@ -26,17 +26,30 @@
 #include <cassert>
 #include <miopen/fusion.hpp>
 #include <miopen/logger.hpp>
+#include <atomic>
 
 namespace miopen {
 
+static std::size_t NextGeneration()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::atomic<std::size_t> generation{0};
+    return ++generation;
+}
+
 // operator args
-OperatorArgs::OperatorArgs() {}
+OperatorArgs::OperatorArgs() : generation(NextGeneration()) {}
 
 void OperatorArgs::ins_arg(std::string name, OpKernelArg v)
 {
-    args_map.emplace(std::make_pair(name, v));
-    //    args_map[name] = std::move(v);
+    // Setting the arguments of an op again replaces the previous values.
+    auto it = args_map.find(name);
+    if(it == args_map.end())
+        args_map.emplace(std::move(name), v);
+    else
+        it->second = v;
     args_vec.push_back(v);
+    generation = NextGeneration();
 }
 
 std::ostream& operator<<(std::ostream& stream, const OperatorArgs&) // x )
@@ -38,7 +38,11 @@ std::ostream& operator<<(std::ostream& stream, const FusionOpDescriptor& x)
                     miopenFusionOpBiasForward,
                     miopenFusionOpBatchNormFwdTrain,
                     miopenFusionOpBatchNormBwdTrain,
-                    miopenFusionOpActivBackward);
+                    miopenFusionOpActivBackward,
+                    miopenFusionOpTensorForward,
+                    miopenFusionOpScaleForward,
+                    miopenFusionOpPoolingForward,
+                    miopenFusionOpBiasBackward);
     return stream;
 }
 
@@ -28,10 +28,13 @@
 #include <miopen/tensor.hpp>
 #include <miopen/tensor_layout.hpp>
 #include <miopen/datatype.hpp>
+#include <miopen/errors.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
-#include <cmath>
+#include <functional>
+#include <numeric>
 
 namespace miopen {
 
@@ -94,6 +97,22 @@ miopenPoolingWorkspaceIndexMode_t PoolingDescriptor::GetWorkspaceIndexMode() con
     return workspaceIndexMode;
 }
 
+void PoolingDescriptor::SetAdaptiveOutputLengths(const std::vector<int>& out_lens)
+{
+    if(!out_lens.empty() && out_lens.size() != 2)
+        MIOPEN_THROW(miopenStatusNotImplemented, "Adaptive pooling supports 2D outputs only");
+    if(std::any_of(out_lens.begin(), out_lens.end(), [](int l) { return l <= 0; }))
+        MIOPEN_THROW(miopenStatusBadParm, "Adaptive pooling output lengths must be positive");
+    adaptive_lens = out_lens;
+}
+
+const std::vector<int>& PoolingDescriptor::GetAdaptiveOutputLengths() const
+{
+    return adaptive_lens;
+}
+
+bool PoolingDescriptor::IsAdaptive() const { return !adaptive_lens.empty(); }
+
 miopenPoolingMode_t PoolingDescriptor::GetMode() const { return mode; }
 
 miopenPaddingMode_t PoolingDescriptor::GetPaddingMode() const { return (pmode); }
@@ -123,6 +142,14 @@ PoolingDescriptor::GetForwardOutputDim(const TensorDescriptor& xDesc) const
 
     std::tie(input_n, input_c, input_h, input_w) = miopen::tien<4>(xDesc.GetLengths());
 
+    if(IsAdaptive())
+    {
+        return std::make_tuple(input_n,
+                               input_c,
+                               static_cast<std::size_t>(adaptive_lens[0]),
+                               static_cast<std::size_t>(adaptive_lens[1]));
+    }
+
     int stride_h, stride_w, pad_h, pad_w, window_h, window_w;
     std::tie(stride_h, stride_w) = miopen::tien<2>(GetStrides());
     std::tie(pad_h, pad_w)       = miopen::tien<2>(GetPads());
@@ -161,6 +188,16 @@ void PoolingDescriptor::GetForwardOutputDimNd(const TensorDescriptor& xDesc,
 {
     assert(xDesc.GetLengths().size() == dims && xDesc.GetLengths().size() <= 5 &&
            xDesc.GetLengths().size() >= 4); // currently only support 2D/3D pooling
+    if(IsAdaptive())
+    {
+        if(xDesc.GetSize() != adaptive_lens.size() + 2)
+            MIOPEN_THROW(miopenStatusBadParm, "Adaptive pooling output does not match the input");
+        tensorDimArr[0] = xDesc.GetLengths()[0];
+        tensorDimArr[1] = xDesc.GetLengths()[1];
+        std::copy(adaptive_lens.begin(), adaptive_lens.end(), tensorDimArr + 2);
+        return;
+    }
+
     std::vector<int> out_dim;
     auto input_dim             = xDesc.GetLengths();
     auto strs                  = GetStrides();
@@ -228,8 +265,17 @@ TensorDescriptor PoolingDescriptor::GetForwardOutputTensor(const TensorDescripto
 
 std::size_t PoolingDescriptor::GetWorkSpaceSize(const TensorDescriptor& yDesc) const
 {
-    return GetMode() == miopenPoolingMax ? yDesc.GetElementSize() * get_data_size(GetIndexType())
-                                         : 0;
+    if(GetMode() != miopenPoolingMax)
+        return 0;
+    if(GetWorkspaceIndexMode() == miopenPoolingWorkspaceIndexMaskPacked)
+        return (yDesc.GetElementSize() * GetPackedIndexBits(yDesc.GetLengths()[1]) + 7) / 8;
+    return yDesc.GetElementSize() * get_data_size(GetIndexType());
+}
+
+int PoolingDescriptor::GetPackedIndexBits(int channels) const
+{
+    const auto window = std::accumulate(lens.begin(), lens.end(), 1, std::multiplies<int>());
+    return (window <= 16 && channels % 2 == 0) ? 4 : 8;
 }
 
 std::ostream& operator<<(std::ostream& stream, const PoolingDescriptor& x)
@@ -238,6 +284,8 @@ std::ostream& operator<<(std::ostream& stream, const PoolingDescriptor& x)
     LogRange(stream, x.lens, ", ") << ", ";
     LogRange(stream, x.pads, ", ") << ", ";
     LogRange(stream, x.strides, ", ") << ", ";
+    if(x.IsAdaptive())
+        LogRange(stream << "adaptive ", x.adaptive_lens, ", ") << ", ";
     return stream;
 }
 
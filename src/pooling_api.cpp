@@ -135,6 +135,41 @@ miopenGetPoolingWorkSpaceIndexMode(miopenPoolingDescriptor_t poolDesc,
         [&] { *workspace_index = miopen::deref(poolDesc).GetWorkspaceIndexMode(); });
 }
 
+extern "C" miopenStatus_t miopenSetPoolingAdaptiveOutputSize(miopenPoolingDescriptor_t poolDesc,
+                                                             int nbDims,
+                                                             const int* outputLens)
+{
+    MIOPEN_LOG_FUNCTION(poolDesc, nbDims, outputLens);
+    return miopen::try_([&] {
+        if(nbDims < 0 || (nbDims > 0 && outputLens == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm);
+        miopen::deref(poolDesc).SetAdaptiveOutputLengths(
+            std::vector<int>(outputLens, outputLens + nbDims));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenGetPoolingAdaptiveOutputSize(const miopenPoolingDescriptor_t poolDesc,
+                                   int nbDimsRequested,
+                                   int* nbDims,
+                                   int* outputLens)
+{
+    MIOPEN_LOG_FUNCTION(poolDesc, nbDimsRequested, nbDims, outputLens);
+    return miopen::try_([&] {
+        const auto& out_lens = miopen::deref(poolDesc).GetAdaptiveOutputLengths();
+        if(nbDims != nullptr)
+        {
+            *nbDims = out_lens.size();
+        }
+        if(outputLens != nullptr)
+        {
+            std::copy(out_lens.begin(),
+                      out_lens.begin() + std::min<std::size_t>(nbDimsRequested, out_lens.size()),
+                      outputLens);
+        }
+    });
+}
+
 extern "C" miopenStatus_t miopenSet2dPoolingDescriptor(miopenPoolingDescriptor_t poolDesc,
                                                        miopenPoolingMode_t mode,
                                                        int windowHeight,
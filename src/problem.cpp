@@ -0,0 +1,405 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/problem.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/problem_description.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace miopen {
+
+namespace {
+
+// Enough for all the algorithms of any direction.
+constexpr int max_algorithms = 8;
+
+conv::Direction ToConvDirection(miopenProblemDirection_t direction)
+{
+    switch(direction)
+    {
+    case miopenProblemDirectionForward: return conv::Direction::Forward;
+    case miopenProblemDirectionBackward: return conv::Direction::BackwardData;
+    case miopenProblemDirectionBackwardWeights: return conv::Direction::BackwardWeights;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Invalid problem direction");
+}
+
+miopenProblemDirection_t Transpose(miopenProblemDirection_t direction)
+{
+    switch(direction)
+    {
+    case miopenProblemDirectionForward: return miopenProblemDirectionBackward;
+    case miopenProblemDirectionBackward: return miopenProblemDirectionForward;
+    case miopenProblemDirectionBackwardWeights: return miopenProblemDirectionBackwardWeights;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Invalid problem direction");
+}
+
+} // namespace
+
+Problem::Problem(const ConvolutionDescriptor& conv_,
+                 miopenProblemDirection_t direction_,
+                 const TensorDescriptor& x_,
+                 const TensorDescriptor& w_,
+                 const TensorDescriptor& y_)
+    : conv(conv_), direction(direction_), user_direction(direction_), x(x_), w(w_), y(y_)
+{
+    std::ignore = ToConvDirection(direction);
+    if(conv.mode == miopenTranspose)
+    {
+        direction = Transpose(direction);
+        std::swap(x, y);
+    }
+}
+
+std::string Problem::GetKey() const
+{
+    const auto problem = ProblemDescription{x, w, y, conv, ToConvDirection(direction)};
+    return problem.BuildConfKey().ToString();
+}
+
+std::vector<miopenConvSolution_t> Problem::GetSolutions(Handle& handle, bool& fallback) const
+{
+    auto count = std::size_t{0};
+    switch(direction)
+    {
+    case miopenProblemDirectionForward:
+        count = conv.GetForwardSolutionCount(handle, w, x, y);
+        break;
+    case miopenProblemDirectionBackward:
+        count = conv.GetBackwardSolutionCount(handle, y, w, x);
+        break;
+    case miopenProblemDirectionBackwardWeights:
+        count = conv.GetWrwSolutionCount(handle, y, x, w);
+        break;
+    }
+
+    auto solutions = std::vector<miopenConvSolution_t>(count);
+    if(count == 0)
+    {
+        fallback = true;
+        return solutions;
+    }
+
+    switch(direction)
+    {
+    case miopenProblemDirectionForward:
+        conv.GetForwardSolutions(handle, w, x, y, count, &count, solutions.data(), &fallback);
+        break;
+    case miopenProblemDirectionBackward:
+        conv.GetBackwardSolutions(handle, y, w, x, count, &count, solutions.data(), &fallback);
+        break;
+    case miopenProblemDirectionBackwardWeights:
+        conv.GetWrwSolutions(handle, y, x, w, count, &count, solutions.data(), &fallback);
+        break;
+    }
+    solutions.resize(count);
+    return solutions;
+}
+
+std::size_t Problem::GetMaxWorkspaceSize(Handle& handle) const
+{
+    switch(direction)
+    {
+    case miopenProblemDirectionForward: return conv.ForwardGetWorkSpaceSize(handle, w, x, y);
+    case miopenProblemDirectionBackward: return conv.BackwardDataGetWorkSpaceSize(handle, w, y, x);
+    case miopenProblemDirectionBackwardWeights:
+        return conv.BackwardWeightsGetWorkSpaceSize(handle, y, x, w);
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Invalid problem direction");
+}
+
+void Problem::RunFind(Handle& handle, const FindOptions& options) const
+{
+    const MemoryCategoryScope memory_scope{MemoryCategory::Search};
+    // Only the time of the kernels matters, so the buffers are left uninitialized.
+    const auto x_buffer = handle.Create(x.GetNumBytes());
+    const auto w_buffer = handle.Create(w.GetNumBytes());
+    const auto y_buffer = handle.Create(y.GetNumBytes());
+
+    const auto workspace_size = std::min(GetMaxWorkspaceSize(handle), options.workspace_limit);
+    const auto workspace =
+        workspace_size > 0 ? handle.Create(workspace_size) : Allocator::ManageDataPtr{};
+
+    const solver::SearchDeadline deadline{options.time_budget};
+    auto results  = std::vector<miopenConvAlgoPerf_t>(max_algorithms);
+    auto returned = 0;
+
+    switch(direction)
+    {
+    case miopenProblemDirectionForward:
+        conv.FindConvFwdAlgorithm(handle,
+                                  x,
+                                  x_buffer.get(),
+                                  w,
+                                  w_buffer.get(),
+                                  y,
+                                  y_buffer.get(),
+                                  max_algorithms,
+                                  &returned,
+                                  results.data(),
+                                  workspace.get(),
+                                  workspace_size,
+                                  options.tuning);
+        break;
+    case miopenProblemDirectionBackward:
+        conv.FindConvBwdDataAlgorithm(handle,
+                                      y,
+                                      y_buffer.get(),
+                                      w,
+                                      w_buffer.get(),
+                                      x,
+                                      x_buffer.get(),
+                                      max_algorithms,
+                                      &returned,
+                                      results.data(),
+                                      workspace.get(),
+                                      workspace_size,
+                                      options.tuning);
+        break;
+    case miopenProblemDirectionBackwardWeights:
+        conv.FindConvBwdWeightsAlgorithm(handle,
+                                         y,
+                                         y_buffer.get(),
+                                         x,
+                                         x_buffer.get(),
+                                         w,
+                                         w_buffer.get(),
+                                         max_algorithms,
+                                         &returned,
+                                         results.data(),
+                                         workspace.get(),
+                                         workspace_size,
+                                         options.tuning);
+        break;
+    }
+}
+
+std::vector<Solution> Problem::FindSolutions(Handle& handle,
+                                             const FindOptions& options,
+                                             std::size_t max_solutions) const
+{
+    auto fallback = false;
+    auto found    = std::vector<miopenConvSolution_t>{};
+    if(!options.tuning)
+        found = GetSolutions(handle, fallback);
+
+    if(options.tuning || fallback)
+    {
+        MIOPEN_LOG_I("Running find" << (options.tuning ? " with tuning" : ""));
+        RunFind(handle, options);
+        found = GetSolutions(handle, fallback);
+    }
+    else
+    {
+        MIOPEN_LOG_I("Solutions are taken from the find-db");
+    }
+
+    const auto key = GetKey();
+    auto solutions = std::vector<Solution>{};
+    for(const auto& item : found)
+    {
+        if(solutions.size() >= max_solutions)
+            break;
+        if(item.workspace_size > options.workspace_limit)
+            continue;
+        solutions.emplace_back(solver::Id{item.solution_id},
+                               user_direction,
+                               key,
+                               item.time,
+                               item.workspace_size);
+    }
+    return solutions;
+}
+
+bool Problem::NeedsFind(Handle& handle, const FindOptions& options) const
+{
+    if(options.tuning)
+        return true;
+    auto fallback = false;
+    std::ignore   = GetSolutions(handle, fallback);
+    return fallback;
+}
+
+std::vector<std::vector<Solution>>
+Problem::FindSolutionsBatch(Handle& handle,
+                            const std::vector<const Problem*>& problems,
+                            const FindOptions& options,
+                            std::size_t max_solutions)
+{
+    // Layers of a network often repeat, these are solved once.
+    auto distinct = std::vector<const Problem*>{};
+    auto indices  = std::vector<std::size_t>{};
+    {
+        auto seen = std::map<std::pair<int, std::string>, std::size_t>{};
+        for(const auto* problem : problems)
+        {
+            const auto key      = std::make_pair(static_cast<int>(problem->user_direction),
+                                            problem->GetKey());
+            const auto inserted = seen.emplace(key, distinct.size());
+            if(inserted.second)
+                distinct.push_back(problem);
+            indices.push_back(inserted.first->second);
+        }
+    }
+
+    auto candidates = std::vector<solver::ConvSolution>{};
+    for(const auto* problem : distinct)
+    {
+        if(!problem->NeedsFind(handle, options))
+            continue;
+        const auto description = ProblemDescription{problem->x,
+                                                    problem->w,
+                                                    problem->y,
+                                                    problem->conv,
+                                                    ToConvDirection(problem->direction)};
+        auto more = problem->conv.GetFindCandidates(handle, description);
+        std::move(more.begin(), more.end(), std::back_inserter(candidates));
+    }
+
+    if(!candidates.empty())
+    {
+        auto pointers = std::vector<const solver::ConvSolution*>{};
+        pointers.reserve(candidates.size());
+        for(const auto& candidate : candidates)
+            pointers.push_back(&candidate);
+        MIOPEN_LOG_I("Compiling " << candidates.size() << " solutions of " << distinct.size()
+                                  << " problems");
+        PrecompileSolutions(handle, pointers);
+    }
+
+    auto found = std::vector<std::vector<Solution>>{};
+    found.reserve(distinct.size());
+    for(const auto* problem : distinct)
+        found.push_back(problem->FindSolutions(handle, options, max_solutions));
+
+    auto results = std::vector<std::vector<Solution>>{};
+    results.reserve(problems.size());
+    for(const auto index : indices)
+        results.push_back(found[index]);
+    return results;
+}
+
+void Problem::Run(Handle& handle,
+                  const Solution& solution,
+                  Data_t x_data,
+                  Data_t w_data,
+                  Data_t y_data,
+                  Data_t workspace,
+                  std::size_t workspace_size) const
+{
+    if(solution.GetDirection() != user_direction || solution.GetProblemKey() != GetKey())
+        MIOPEN_THROW(miopenStatusBadParm, "The solution does not belong to the problem");
+    if(workspace_size < solution.GetWorkspaceSize())
+        MIOPEN_THROW(miopenStatusBadParm, "Workspace is too small for the solution");
+    if(conv.mode == miopenTranspose)
+        std::swap(x_data, y_data);
+
+    const auto solver = solution.GetSolver();
+    switch(direction)
+    {
+    case miopenProblemDirectionForward:
+        conv.ConvolutionForwardImmediate(
+            handle, w, w_data, x, x_data, y, y_data, workspace, workspace_size, solver);
+        break;
+    case miopenProblemDirectionBackward:
+        conv.ConvolutionBackwardImmediate(
+            handle, y, y_data, w, w_data, x, x_data, workspace, workspace_size, solver);
+        break;
+    case miopenProblemDirectionBackwardWeights:
+        conv.ConvolutionWrwImmediate(
+            handle, y, y_data, x, x_data, w, w_data, workspace, workspace_size, solver);
+        break;
+    }
+}
+
+FrozenSolution Problem::Freeze(Handle& handle, const Solution& solution) const
+{
+    if(solution.GetDirection() != user_direction || solution.GetProblemKey() != GetKey())
+        MIOPEN_THROW(miopenStatusBadParm, "The solution does not belong to the problem");
+
+    auto invoker = conv.GetImmediateInvoker(
+        handle, x, w, y, ToConvDirection(direction), solution.GetSolver());
+
+    // The buffers are set by each run.
+    auto params = [&]() -> AnyInvokeParams {
+        switch(direction)
+        {
+        case miopenProblemDirectionForward: {
+            const auto tensors     = ConvFwdTensors{x, nullptr, w, nullptr, y, nullptr};
+            const auto data_params = conv::DataInvokeParams{tensors, nullptr, 0};
+            return AnyInvokeParams{data_params};
+        }
+        case miopenProblemDirectionBackward: {
+            const auto tensors     = ConvBwdTensors{y, nullptr, w, nullptr, x, nullptr};
+            const auto data_params = conv::DataInvokeParams{tensors, nullptr, 0};
+            return AnyInvokeParams{data_params};
+        }
+        case miopenProblemDirectionBackwardWeights: {
+            const auto tensors    = ConvWrwTensors{y, nullptr, x, nullptr, w, nullptr};
+            const auto wrw_params = conv::WrWInvokeParams{tensors, nullptr, 0};
+            return AnyInvokeParams{wrw_params};
+        }
+        }
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid problem direction");
+    }();
+
+    return {std::move(invoker),
+            std::move(params),
+            direction,
+            conv.mode == miopenTranspose,
+            solution.GetWorkspaceSize(),
+            solution.GetSolver().GetSolver().PreparesWeights()};
+}
+
+std::ostream& operator<<(std::ostream& stream, const FindOptions& options)
+{
+    return stream << "tuning: " << options.tuning << ", workspace limit: "
+                  << options.workspace_limit << ", time budget: " << options.time_budget;
+}
+
+std::ostream& operator<<(std::ostream& stream, const Problem& problem)
+{
+    return stream << problem.user_direction << ", " << problem.GetKey();
+}
+
+} // namespace miopen
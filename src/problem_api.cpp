@@ -0,0 +1,287 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+
+#include <miopen/errors.hpp>
+#include <miopen/frozen_solution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solution.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+extern "C" miopenStatus_t miopenCreateConvProblem(miopenProblem_t* problem,
+                                                  const miopenConvolutionDescriptor_t convDesc,
+                                                  miopenProblemDirection_t direction,
+                                                  const miopenTensorDescriptor_t xDesc,
+                                                  const miopenTensorDescriptor_t wDesc,
+                                                  const miopenTensorDescriptor_t yDesc)
+{
+    MIOPEN_LOG_FUNCTION(problem, convDesc, direction, xDesc, wDesc, yDesc);
+    return miopen::try_([&] {
+        miopen::deref(problem) = new miopen::Problem(miopen::deref(convDesc),
+                                                     direction,
+                                                     miopen::deref(xDesc),
+                                                     miopen::deref(wDesc),
+                                                     miopen::deref(yDesc));
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroyProblem(miopenProblem_t problem)
+{
+    MIOPEN_LOG_FUNCTION(problem);
+    return miopen::try_([&] { miopen_destroy_object(problem); });
+}
+
+extern "C" miopenStatus_t miopenCreateFindOptions(miopenFindOptions_t* options)
+{
+    MIOPEN_LOG_FUNCTION(options);
+    return miopen::try_([&] { miopen::deref(options) = new miopen::FindOptions(); });
+}
+
+extern "C" miopenStatus_t miopenDestroyFindOptions(miopenFindOptions_t options)
+{
+    MIOPEN_LOG_FUNCTION(options);
+    return miopen::try_([&] { miopen_destroy_object(options); });
+}
+
+extern "C" miopenStatus_t miopenSetFindOptionTuning(miopenFindOptions_t options, int value)
+{
+    MIOPEN_LOG_FUNCTION(options, value);
+    return miopen::try_([&] { miopen::deref(options).tuning = value != 0; });
+}
+
+extern "C" miopenStatus_t miopenSetFindOptionWorkspaceLimit(miopenFindOptions_t options,
+                                                            size_t value)
+{
+    MIOPEN_LOG_FUNCTION(options, value);
+    return miopen::try_([&] { miopen::deref(options).workspace_limit = value; });
+}
+
+extern "C" miopenStatus_t miopenSetFindOptionTimeBudget(miopenFindOptions_t options, float value)
+{
+    MIOPEN_LOG_FUNCTION(options, value);
+    return miopen::try_([&] {
+        if(value < 0.0f)
+            MIOPEN_THROW(miopenStatusBadParm, "Time budget shall not be negative");
+        miopen::deref(options).time_budget = value;
+    });
+}
+
+extern "C" miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
+                                              miopenProblem_t problem,
+                                              miopenFindOptions_t options,
+                                              miopenSolution_t* solutions,
+                                              size_t* numSolutions,
+                                              size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(handle, problem, options, solutions, numSolutions, maxSolutions);
+    return miopen::try_([&] {
+        const auto defaults = miopen::FindOptions{};
+        const auto& find_options = options == nullptr ? defaults : miopen::deref(options);
+        const auto found = miopen::deref(problem).FindSolutions(
+            miopen::deref(handle), find_options, maxSolutions);
+
+        if(found.size() > 0 && solutions == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Solutions array is null");
+
+        for(std::size_t i = 0; i < found.size(); ++i)
+            solutions[i] = new miopen::Solution(found[i]);
+        miopen::deref(numSolutions) = found.size();
+    });
+}
+
+extern "C" miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                                   const miopenProblem_t* problems,
+                                                   size_t numProblems,
+                                                   miopenFindOptions_t options,
+                                                   miopenSolution_t* solutions,
+                                                   size_t* numSolutions,
+                                                   size_t maxSolutionsPerProblem)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, problems, numProblems, options, solutions, numSolutions, maxSolutionsPerProblem);
+    return miopen::try_([&] {
+        if(numProblems > 0 && (problems == nullptr || numSolutions == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "Problems or numbers of solutions array is null");
+
+        auto batch = std::vector<const miopen::Problem*>{};
+        batch.reserve(numProblems);
+        for(std::size_t i = 0; i < numProblems; ++i)
+            batch.push_back(&miopen::deref(problems[i]));
+
+        const auto defaults = miopen::FindOptions{};
+        const auto& find_options = options == nullptr ? defaults : miopen::deref(options);
+        const auto found         = miopen::Problem::FindSolutionsBatch(
+            miopen::deref(handle), batch, find_options, maxSolutionsPerProblem);
+
+        for(std::size_t i = 0; i < found.size(); ++i)
+        {
+            if(found[i].size() > 0 && solutions == nullptr)
+                MIOPEN_THROW(miopenStatusBadParm, "Solutions array is null");
+
+            for(std::size_t j = 0; j < found[i].size(); ++j)
+                solutions[i * maxSolutionsPerProblem + j] = new miopen::Solution(found[i][j]);
+            numSolutions[i] = found[i].size();
+        }
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroySolution(miopenSolution_t solution)
+{
+    MIOPEN_LOG_FUNCTION(solution);
+    return miopen::try_([&] { miopen_destroy_object(solution); });
+}
+
+extern "C" miopenStatus_t miopenGetSolutionTime(miopenSolution_t solution, float* time)
+{
+    MIOPEN_LOG_FUNCTION(solution, time);
+    return miopen::try_([&] { miopen::deref(time) = miopen::deref(solution).GetTime(); });
+}
+
+extern "C" miopenStatus_t miopenGetSolutionWorkspaceSize(miopenSolution_t solution,
+                                                         size_t* workspaceSize)
+{
+    MIOPEN_LOG_FUNCTION(solution, workspaceSize);
+    return miopen::try_([&] {
+        miopen::deref(workspaceSize) = miopen::deref(solution).GetWorkspaceSize();
+    });
+}
+
+extern "C" miopenStatus_t miopenGetSolutionSolverId(miopenSolution_t solution, uint64_t* solverId)
+{
+    MIOPEN_LOG_FUNCTION(solution, solverId);
+    return miopen::try_([&] {
+        miopen::deref(solverId) = miopen::deref(solution).GetSolver().Value();
+    });
+}
+
+extern "C" miopenStatus_t miopenGetSolutionSize(miopenSolution_t solution, size_t* size)
+{
+    MIOPEN_LOG_FUNCTION(solution, size);
+    return miopen::try_([&] { miopen::deref(size) = miopen::deref(solution).Save().size(); });
+}
+
+extern "C" miopenStatus_t miopenSaveSolution(miopenSolution_t solution, char* data)
+{
+    MIOPEN_LOG_FUNCTION(solution, data);
+    return miopen::try_([&] {
+        if(data == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Solution blob is null");
+        const auto blob = miopen::deref(solution).Save();
+        std::copy(blob.begin(), blob.end(), data);
+    });
+}
+
+extern "C" miopenStatus_t miopenLoadSolution(miopenSolution_t* solution,
+                                             const char* data,
+                                             size_t size)
+{
+    MIOPEN_LOG_FUNCTION(solution, data, size);
+    return miopen::try_([&] {
+        if(data == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Solution blob is null");
+        miopen::deref(solution) = new miopen::Solution(miopen::Solution::Load(data, size));
+    });
+}
+
+extern "C" miopenStatus_t miopenRunSolution(miopenHandle_t handle,
+                                            miopenSolution_t solution,
+                                            miopenProblem_t problem,
+                                            void* x,
+                                            void* w,
+                                            void* y,
+                                            void* workspace,
+                                            size_t workspaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, solution, problem, x, w, y, workspace, workspaceSize);
+    return miopen::try_([&] {
+        miopen::deref(problem).Run(miopen::deref(handle),
+                                   miopen::deref(solution),
+                                   DataCast(x),
+                                   DataCast(w),
+                                   DataCast(y),
+                                   DataCast(workspace),
+                                   workspaceSize);
+    });
+}
+
+extern "C" miopenStatus_t miopenFreezeSolution(miopenHandle_t handle,
+                                               miopenProblem_t problem,
+                                               miopenSolution_t solution,
+                                               miopenFrozenSolution_t* frozen)
+{
+    MIOPEN_LOG_FUNCTION(handle, problem, solution, frozen);
+    return miopen::try_([&] {
+        miopen::deref(frozen) = new miopen::FrozenSolution(
+            miopen::deref(problem).Freeze(miopen::deref(handle), miopen::deref(solution)));
+    });
+}
+
+extern "C" miopenStatus_t miopenRunFrozenSolution(miopenHandle_t handle,
+                                                  miopenFrozenSolution_t frozen,
+                                                  void* x,
+                                                  void* w,
+                                                  void* y,
+                                                  void* workspace,
+                                                  size_t workspaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, frozen, x, w, y, workspace, workspaceSize);
+    return miopen::try_([&] {
+        miopen::deref(frozen).Run(miopen::deref(handle),
+                                  DataCast(x),
+                                  DataCast(w),
+                                  DataCast(y),
+                                  DataCast(workspace),
+                                  workspaceSize);
+    });
+}
+
+extern "C" miopenStatus_t miopenPrepareFrozenSolutionWeights(miopenHandle_t handle,
+                                                             miopenFrozenSolution_t frozen,
+                                                             const void* w,
+                                                             void* workspace,
+                                                             size_t workspaceSize,
+                                                             bool* prepared)
+{
+    MIOPEN_LOG_FUNCTION(handle, frozen, w, workspace, workspaceSize, prepared);
+    return miopen::try_([&] {
+        const auto result = miopen::deref(frozen).PrepareWeights(
+            miopen::deref(handle), DataCast(w), DataCast(workspace), workspaceSize);
+        if(prepared != nullptr)
+            *prepared = result;
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroyFrozenSolution(miopenFrozenSolution_t frozen)
+{
+    MIOPEN_LOG_FUNCTION(frozen);
+    return miopen::try_([&] { miopen_destroy_object(frozen); });
+}
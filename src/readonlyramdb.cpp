@@ -25,21 +25,26 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/mapped_db.hpp>
 
-#if MIOPEN_EMBED_DB
-#include <miopen_data.hpp>
-#endif
+#include <miopen/embedded_db.hpp>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/functional/hash.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <mutex>
 #include <sstream>
 #include <map>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_MAPPED_DB)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SHARED_DB)
+
 namespace miopen {
 extern boost::optional<std::string>&
 testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
@@ -69,6 +74,66 @@ ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path, bool warn_if_un
     return *instance;
 }
 
+std::size_t ReadonlyRamDb::GetKeyHash(const char* key, std::size_t size)
+{
+    return boost::hash_range(key, key + size);
+}
+
+boost::optional<ReadonlyRamDb::CacheItem> ReadonlyRamDb::FindItem(const std::string& problem) const
+{
+    if(mapped != nullptr)
+    {
+        auto record = mapped->Find(problem);
+        if(!record)
+            return boost::none;
+        return CacheItem{record->line, std::move(record->content)};
+    }
+
+    const auto range = index.equal_range(GetKeyHash(problem.data(), problem.size()));
+    for(auto it = range.first; it != range.second; ++it)
+    {
+        const auto& item = it->second;
+        if(problem.compare(0, std::string::npos, &contents[item.offset], item.key_size) != 0)
+            continue;
+        const auto content_offset = item.offset + item.key_size + 1;
+        return CacheItem{item.line, contents.substr(content_offset, item.content_size)};
+    }
+    return boost::none;
+}
+
+boost::optional<DbRecord> ReadonlyRamDb::FindRecord(const std::string& problem) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+
+    {
+        const std::lock_guard<std::mutex> lock{parsed_mutex};
+        const auto it = parsed.find(problem);
+        if(it != parsed.end())
+            return it->second;
+    }
+
+    const auto item = FindItem(problem);
+
+    if(!item)
+        return boost::none;
+
+    auto record = boost::make_optional(DbRecord{problem});
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+    MIOPEN_LOG_I2("Contents found: " << item->content);
+
+    if(!record->ParseContents(item->content))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: "
+                     << problem << " form file " << db_path << "#" << item->line);
+        MIOPEN_LOG_E("Contents: " << item->content);
+        record = boost::none;
+    }
+
+    const std::lock_guard<std::mutex> lock{parsed_mutex};
+    return parsed.emplace(problem, std::move(record)).first->second;
+}
+
 template <class TFunc>
 static auto Measure(const std::string& funcName, TFunc&& func)
 {
@@ -81,30 +146,27 @@ static auto Measure(const std::string& funcName, TFunc&& func)
     MIOPEN_LOG_I("Db::" << funcName << " time: " << (end - start).count() * .000001f << " ms");
 }
 
-void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream,
-                                   const std::string& path,
-                                   bool warn_if_unreadable)
+void ReadonlyRamDb::IndexDb(std::string&& db_contents, const std::string& path)
 {
-    if(!input_stream)
-    {
-        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
-                                                                             : LoggingLevel::Info;
-        MIOPEN_LOG(log_level, "File is unreadable: " << path);
-        return;
-    }
+    contents = std::move(db_contents);
 
-    auto line   = std::string{};
     auto n_line = 0;
-
-    while(std::getline(input_stream, line))
+    for(std::size_t begin = 0; begin < contents.size();)
     {
         ++n_line;
 
-        if(line.empty())
+        auto end = contents.find('\n', begin);
+        if(end == std::string::npos)
+            end = contents.size();
+        const auto line_begin = begin;
+        begin                 = end + 1;
+
+        if(end == line_begin)
             continue;
 
-        const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+        const auto key_end = contents.find('=', line_begin);
+        const bool is_key =
+            (key_end != std::string::npos && key_end != line_begin && key_end < end);
 
         if(!is_key)
         {
@@ -112,11 +174,21 @@ void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream,
             continue;
         }
 
-        const auto key      = line.substr(0, key_size);
-        const auto contents = line.substr(key_size + 1);
+        const auto key_size = key_end - line_begin;
+        const auto hash     = GetKeyHash(&contents[line_begin], key_size);
+        const auto range    = index.equal_range(hash);
+
+        // The first record with the key is used like on lookup in the text file.
+        const auto duplicate = std::any_of(range.first, range.second, [&](const auto& other) {
+            const auto& item = other.second;
+            return item.key_size == key_size &&
+                   contents.compare(item.offset, key_size, contents, line_begin, key_size) == 0;
+        });
 
-        cache.emplace(key, CacheItem{n_line, contents});
+        if(!duplicate)
+            index.emplace(hash, IndexItem{line_begin, key_size, end - key_end - 1, n_line});
     }
+    MIOPEN_LOG_I2("Indexed " << index.size() << " records of " << path);
 }
 
 void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
@@ -129,23 +201,44 @@ void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
         {
 #if MIOPEN_EMBED_DB
             boost::filesystem::path filepath(path);
-            const auto& it_p = miopen_data().find(filepath.filename().string() + ".o");
-            if(it_p == miopen_data().end())
+            const auto p = embedded::GetFile(filepath.filename().string());
+            if(p.first == nullptr)
                 MIOPEN_THROW(miopenStatusInternalError,
                              "Unknown database: " + filepath.filename().string() +
                                  " in internal filesystem");
 
-            const auto& p = it_p->second;
-            ptrdiff_t sz  = p.second - p.first;
             MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
-            auto input_stream = std::stringstream(std::string(p.first, sz));
-            ParseAndLoadDb(input_stream, path, warn_if_unreadable);
+            IndexDb(std::string(p.first, p.second), path);
 #endif
         }
         else
         {
-            auto input_stream = std::ifstream{path};
-            ParseAndLoadDb(input_stream, path, warn_if_unreadable);
+            if(!IsDisabled(MIOPEN_DEBUG_MAPPED_DB{}))
+            {
+                mapped = MappedDb::Open(MappedDb::GetPath(path), path);
+                if(mapped != nullptr)
+                    return;
+            }
+            if(IsEnabled(MIOPEN_DEBUG_SHARED_DB{}))
+            {
+                mapped = MappedDb::OpenShared(path);
+                if(mapped != nullptr)
+                    return;
+            }
+            auto input_stream = std::ifstream{path, std::ios::binary};
+            if(!input_stream)
+            {
+                const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                           ? LoggingLevel::Warning
+                                           : LoggingLevel::Info;
+                MIOPEN_LOG(log_level, "File is unreadable: " << path);
+                return;
+            }
+            input_stream.seekg(0, std::ios::end);
+            auto db_contents = std::string(static_cast<std::size_t>(input_stream.tellg()), '\0');
+            input_stream.seekg(0, std::ios::beg);
+            input_stream.read(&db_contents[0], db_contents.size());
+            IndexDb(std::move(db_contents), path);
         }
     });
 }
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/reduce/problem_description.hpp>
+#include <miopen/names.hpp>
+
+#include <sstream>
+
+namespace miopen {
+
+namespace reduce {
+
+bool ProblemDescription::NeedIndices() const
+{
+    const auto op = reduce.reduceTensorOp_;
+    return reduce.reduceTensorIndices_ == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES &&
+           (op == MIOPEN_REDUCE_TENSOR_MIN || op == MIOPEN_REDUCE_TENSOR_MAX ||
+            op == MIOPEN_REDUCE_TENSOR_AMAX);
+}
+
+std::string ProblemDescription::GetLengthsName() const
+{
+    std::ostringstream ss;
+    const auto& lens = aDesc.GetLengths();
+    for(std::size_t i = 0; i < lens.size(); ++i)
+        ss << (i == 0 ? "" : "x") << lens[i];
+    return ss.str();
+}
+
+std::string ProblemDescription::GetReduceDimsName() const
+{
+    std::string name;
+    const auto& in_lens  = aDesc.GetLengths();
+    const auto& out_lens = cDesc.GetLengths();
+    for(std::size_t i = 0; i < in_lens.size(); ++i)
+        name += (out_lens[i] != in_lens[i]) ? '1' : '0';
+    return name;
+}
+
+void ProblemDescription::Serialize(std::ostream& stream) const
+{
+    const auto sep = '-';
+
+    stream << GetLengthsName() << sep << GetReduceDimsName();
+    stream << sep << ((aDesc.IsPacked() && cDesc.IsPacked()) ? "packed" : "strided");
+    stream << sep << GetDataTypeName(aDesc.GetType());
+    stream << sep << GetDataTypeName(reduce.reduceTensorCompType_);
+    stream << sep << GetDataTypeName(cDesc.GetType());
+    stream << sep << "op" << reduce.reduceTensorOp_;
+    stream << sep << 'n' << reduce.reduceTensorNanOpt_;
+    stream << sep << 'i' << static_cast<int>(NeedIndices());
+}
+
+} // namespace reduce
+
+} // namespace miopen
@@ -24,12 +24,18 @@
  *
  *******************************************************************************/
 #include <miopen/config.h>
+#include <miopen/db.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/miopen.h>
 #include <miopen/visit_float.hpp>
 #include <miopen/env.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
 #include <miopen/reduce_common.hpp>
 #include <miopen/reduce_tunables.hpp>
+#include <miopen/reduce/problem_description.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/reducetensor.hpp>
 #include <miopen/stringutils.hpp>
@@ -39,6 +45,10 @@
 #include <cstddef>
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <ostream>
 #include <iostream>
 #include <sstream>
@@ -48,6 +58,8 @@
 #include <../composable_kernel/composable_kernel/include/utility/reduction_enums.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DYNAMIC_REDUCTION);
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_REDUCE_OUTER);
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_REDUCE_OUTER_ATOMIC);
 
 #define WORKAROUND_MIOPEN_ISSUE_557 1
 
@@ -479,6 +491,474 @@ static std::string get_kernel_file_name(const bool isFirstCall,
 
 }; // end of namespace detailDynamic
 
+namespace reduce {
+
+namespace {
+
+bool IsPowerOfTwoIn(int v, int lo, int hi)
+{
+    return lo <= v && v <= hi && (v & (v - 1)) == 0;
+}
+
+} // namespace
+
+bool PerformanceConfigReduce::IsValidValue() const
+{
+    return IsPowerOfTwoIn(block_size, MinBlockSize(), 512) &&
+           IsPowerOfTwoIn(thread_buffer_length, 4, 16) &&
+           IsPowerOfTwoIn(accesses_per_thread_in_block, 1, 4) &&
+           IsPowerOfTwoIn(accesses_per_thread_in_warp, 1, 4);
+}
+
+bool PerformanceConfigReduce::SetNextValue()
+{
+    // Increment with wrap-around.
+    do
+    {
+        if((accesses_per_thread_in_warp *= 2) <= 4)
+            break;
+        accesses_per_thread_in_warp = 1;
+        if((accesses_per_thread_in_block *= 2) <= 4)
+            break;
+        accesses_per_thread_in_block = 1;
+        if((thread_buffer_length *= 2) <= 16)
+            break;
+        thread_buffer_length = 4;
+        if((block_size *= 2) <= 512)
+            break;
+        block_size = MinBlockSize();
+        return false;
+    } while(false);
+    return true;
+}
+
+bool PerformanceConfigReduce::IsValid(const ProblemDescription& problem, int warp_size) const
+{
+    if(!IsValidValue() || block_size < warp_size)
+        return false;
+
+    const auto invariantLength = problem.GetInvariantLength();
+    const auto toReduceLength  = problem.GetToReduceLength();
+    const auto configurator    = detail::ReductionKernelConfigurator{block_size, warp_size};
+
+    // The fields the reduction methods of the problem do not use keep their default values, so
+    // that the search does not time the same kernels twice.
+    auto uses_thread_buffer = false;
+    auto uses_block         = false;
+    auto uses_warp          = false;
+    const auto use          = [&](ReductionMethod_t method) {
+        uses_thread_buffer |= method == Reduce_DirectThreadWise;
+        uses_warp |= method == Reduce_DirectWarpWise;
+        uses_block |= method == Reduce_BlockWise || method == Reduce_MultiBlock;
+    };
+
+    const auto method = configurator.getReductionMethod(invariantLength, toReduceLength);
+    use(method);
+    if(method == Reduce_MultiBlock)
+    {
+        const auto blkGroupSize =
+            configurator.getGridSize(invariantLength, toReduceLength) / invariantLength;
+        use(configurator.GetReductionMethod_2(blkGroupSize));
+    }
+
+    const auto& def = default_tunable_generic_reduction;
+    return (uses_thread_buffer || thread_buffer_length == def.GredThreadBufferLength) &&
+           (uses_block || accesses_per_thread_in_block == def.GredAccessesPerThreadInBlock) &&
+           (uses_warp || accesses_per_thread_in_warp == def.GredAccessesPerThreadInWarp);
+}
+
+bool PerformanceConfigReduce::operator==(const PerformanceConfigReduce& other) const
+{
+    // clang-format off
+    return block_size == other.block_size
+        && thread_buffer_length == other.thread_buffer_length
+        && accesses_per_thread_in_block == other.accesses_per_thread_in_block
+        && accesses_per_thread_in_warp == other.accesses_per_thread_in_warp;
+    // clang-format on
+}
+
+} // namespace reduce
+
+namespace detailDynamic {
+
+static const char* const perf_db_id = "ReduceTensorGeneric";
+
+// Loads the tuned parameters of the problem from the perf-db, or searches for them when
+// MIOPEN_FIND_ENFORCE asks to. A record is only looked up once per process and device.
+static reduce::PerformanceConfigReduce
+GetPerformanceConfig(Handle& handle,
+                     const reduce::ProblemDescription& problem,
+                     const std::function<float(const tunable_generic_reduction&)>& run)
+{
+    static std::mutex mutex;
+    static std::map<std::string, reduce::PerformanceConfigReduce> loaded;
+
+    const auto ctx       = ExecutionContext{&handle};
+    const auto enforce   = FindEnforce{};
+    const auto search    = enforce.IsSearch(ctx);
+    const auto warp_size = static_cast<int>(handle.GetWavefrontWidth());
+
+    std::ostringstream key;
+    key << handle.GetDbBasename() << ':' << problem;
+
+    if(!search)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto it = loaded.find(key.str());
+        if(it != loaded.end())
+            return it->second;
+    }
+
+    auto db     = GetDb(ctx);
+    auto config = reduce::PerformanceConfigReduce{};
+
+    if(!(search && enforce.IsDbUpdate(ctx)))
+    {
+        if(db.Load(problem, perf_db_id, config) && config.IsValid(problem, warp_size))
+        {
+            MIOPEN_LOG_I2("Perf Db: record loaded: " << config);
+            const std::lock_guard<std::mutex> lock(mutex);
+            return loaded[key.str()] = config;
+        }
+        config = reduce::PerformanceConfigReduce{};
+    }
+
+    if(search)
+    {
+        const AutoEnableProfiling enable_profiling{handle};
+
+        auto candidate = reduce::PerformanceConfigReduce{};
+        auto best_time = std::numeric_limits<float>::max();
+
+        candidate.block_size                   = reduce::PerformanceConfigReduce::MinBlockSize();
+        candidate.thread_buffer_length         = 4;
+        candidate.accesses_per_thread_in_block = 1;
+        candidate.accesses_per_thread_in_warp  = 1;
+
+        do
+        {
+            if(!candidate.IsValid(problem, warp_size))
+                continue;
+            // The first run includes the build of the kernels.
+            run(candidate.GetTunable());
+            const auto time = run(candidate.GetTunable());
+            MIOPEN_LOG_I2(candidate << ": " << time << " ms");
+            if(time < best_time)
+            {
+                best_time = time;
+                config    = candidate;
+            }
+        } while(candidate.SetNextValue());
+
+        MIOPEN_LOG_I("Reduction " << problem << ": " << config << ", " << best_time << " ms");
+        db.Update(problem, perf_db_id, config);
+    }
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    return loaded[key.str()] = config;
+}
+
+}; // end of namespace detailDynamic
+
+namespace detailOuter {
+
+// The reduction of the outer dimensions of a packed tensor, folded to `rows` rows of `cols`
+// contiguous elements, see MIOpenReduceOuter.cl.
+struct Geometry
+{
+    std::size_t rows;
+    std::size_t cols;
+    std::size_t vec;
+    std::size_t grp0;
+    std::size_t grp1;
+    std::size_t cgroups;
+    std::size_t nseg;
+    std::size_t segrows;
+    int mode;
+
+    std::size_t GetWorkspaceSize() const
+    {
+        return (mode == 1 ? nseg * cols : (mode == 2 ? cols : 0)) * sizeof(float);
+    }
+};
+
+static bool IsRowMajorPacked(const TensorDescriptor& desc)
+{
+    const auto& lens    = desc.GetLengths();
+    const auto& strides = desc.GetStrides();
+
+    std::size_t stride = 1;
+    for(auto i = lens.size(); i-- > 0;)
+    {
+        if(lens[i] != 1 && strides[i] != stride)
+            return false;
+        stride *= lens[i];
+    }
+    return true;
+}
+
+static bool IsApplicable(const reduce::ProblemDescription& problem)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_REDUCE_OUTER{}))
+        return false;
+
+    const auto& aDesc = problem.GetADesc();
+    const auto& cDesc = problem.GetCDesc();
+    const auto type   = aDesc.GetType();
+    const auto comp   = problem.GetReduceDesc().reduceTensorCompType_;
+
+    if(problem.NeedIndices() || cDesc.GetType() != type ||
+       (type != miopenFloat && type != miopenHalf && type != miopenBFloat16) ||
+       (comp != miopenFloat && comp != type))
+        return false;
+
+    if(!IsRowMajorPacked(aDesc) || !IsRowMajorPacked(cDesc))
+        return false;
+
+    // All the reduced dimensions have to precede the kept ones, unit dimensions aside.
+    const auto& in_lens  = aDesc.GetLengths();
+    const auto& out_lens = cDesc.GetLengths();
+    auto kept            = false;
+    for(std::size_t i = 0; i < in_lens.size(); ++i)
+    {
+        if(in_lens[i] == 1)
+            continue;
+        if(out_lens[i] == in_lens[i])
+            kept = true;
+        else if(kept)
+            return false;
+    }
+
+    const auto cols = problem.GetInvariantLength();
+    return kept && problem.GetToReduceLength() > 1 &&
+           cols <= std::numeric_limits<uint32_t>::max();
+}
+
+static void SetColumnTiling(Geometry& geo, miopenDataType_t type)
+{
+    // 128-bit loads where the rows allow them.
+    const auto type_size = GetTypeSize(type);
+    geo.vec              = 16 / type_size;
+    while(geo.cols % geo.vec != 0)
+        geo.vec /= 2;
+
+    const auto cvec = geo.cols / geo.vec;
+    geo.grp0        = 1;
+    while(geo.grp0 < cvec && geo.grp0 < 64)
+        geo.grp0 *= 2;
+    geo.grp1    = 256 / geo.grp0;
+    geo.cgroups = (cvec + geo.grp0 - 1) / geo.grp0;
+}
+
+static Geometry GetGeometry(const Handle& handle, const reduce::ProblemDescription& problem)
+{
+    auto geo = Geometry{};
+
+    geo.rows = problem.GetToReduceLength();
+    geo.cols = problem.GetInvariantLength();
+    SetColumnTiling(geo, problem.GetADesc().GetType());
+
+    // Split the rows once one work-group per slice of the columns would leave most of the device
+    // idle, with at least 8 rows per work-item in a segment.
+    const auto min_rows = geo.grp1 * 8;
+    const auto target   = std::max<std::size_t>(1, handle.GetMaxComputeUnits() * 4 / geo.cgroups);
+    geo.nseg            = std::max<std::size_t>(1, std::min(geo.rows / min_rows, target));
+    geo.segrows         = geo.rows / geo.nseg;
+
+    if(geo.nseg == 1)
+        geo.mode = 0;
+    else
+        geo.mode = miopen::IsDisabled(MIOPEN_DEBUG_REDUCE_OUTER_ATOMIC{}) ? 1 : 2;
+
+    return geo;
+}
+
+static void Run(const Handle& handle,
+                const reduce::ProblemDescription& problem,
+                float alpha,
+                ConstData_t A,
+                float beta,
+                Data_t C,
+                Data_t workspace)
+{
+    const auto geo  = GetGeometry(handle, problem);
+    const auto type = problem.GetADesc().GetType();
+    const auto& red = problem.GetReduceDesc();
+
+    const auto elem_type = type == miopenFloat ? "float" : (type == miopenHalf ? "half" : "ushort");
+
+    std::string param;
+    param += " -DMIO_RED_T=" + std::string(elem_type);
+    param += " -DMIO_RED_FP16=" + std::to_string(static_cast<int>(type == miopenHalf));
+    param += " -DMIO_RED_BF16=" + std::to_string(static_cast<int>(type == miopenBFloat16));
+    param += " -DMIO_RED_OP=" + std::to_string(static_cast<int>(red.reduceTensorOp_));
+    param += " -DMIO_RED_NAN=" +
+             std::to_string(static_cast<int>(red.reduceTensorNanOpt_ == MIOPEN_PROPAGATE_NAN));
+    param += " -DMIO_RED_VEC=" + std::to_string(geo.vec);
+    param += " -DMIO_RED_GRP0=" + std::to_string(geo.grp0);
+    param += " -DMIO_RED_GRP1=" + std::to_string(geo.grp1);
+    param += " -DMIO_RED_MODE=" + std::to_string(geo.mode);
+
+    const std::string algo_name    = "outer_reduce_tensor";
+    const std::string program_name = "MIOpenReduceOuter.cl";
+
+    // The shape is passed at run time, so the programs only depend on the values below.
+    std::ostringstream ss;
+    ss << "reduce_outer_T" << type << "op" << red.reduceTensorOp_ << "n" << red.reduceTensorNanOpt_
+       << "v" << geo.vec << "g" << geo.grp0 << "m" << geo.mode;
+    const auto network_config = ss.str();
+
+    const auto rows    = static_cast<uint64_t>(geo.rows);
+    const auto cols    = static_cast<uint32_t>(geo.cols);
+    const auto segrows = static_cast<uint64_t>(geo.segrows);
+    const auto nseg    = static_cast<uint32_t>(geo.nseg);
+
+    const std::vector<size_t> vld = {geo.grp0, geo.grp1, 1};
+    const std::vector<size_t> vgd = {geo.cgroups * geo.grp0, geo.nseg * geo.grp1, 1};
+
+    const std::vector<size_t> vld_1d = {256, 1, 1};
+    const std::vector<size_t> vgd_1d = {(geo.cols + 255) / 256 * 256, 1, 1};
+
+    float time_reduce = 0.0f;
+
+    if(geo.mode == 2)
+    {
+        handle.AddKernel(algo_name,
+                         network_config + "_init",
+                         program_name,
+                         "MIOpenReduceOuterInit",
+                         vld_1d,
+                         vgd_1d,
+                         param)(workspace, cols);
+        if(handle.IsProfilingEnabled())
+            time_reduce += handle.GetKernelTime();
+    }
+
+    handle.AddKernel(algo_name, network_config, program_name, "MIOpenReduceOuter", vld, vgd, param)(
+        A, C, workspace, alpha, beta, rows, cols, segrows);
+    if(handle.IsProfilingEnabled())
+        time_reduce += handle.GetKernelTime();
+
+    if(geo.mode != 0)
+    {
+        handle.AddKernel(algo_name,
+                         network_config + "_final",
+                         program_name,
+                         "MIOpenReduceOuterFinal",
+                         vld_1d,
+                         vgd_1d,
+                         param)(C, workspace, alpha, beta, rows, cols, nseg);
+        if(handle.IsProfilingEnabled())
+            time_reduce += handle.GetKernelTime();
+    }
+
+    if(handle.IsProfilingEnabled())
+    {
+        handle.ResetKernelTime();
+        handle.AccumKernelTime(time_reduce);
+    }
+}
+
+// The segmented reduction of the rows of a packed tensor, the rows are split into chunks of equal
+// length whatever the lengths of the segments, see MIOpenReduceOuterSegmented.
+static Geometry GetSegmentedGeometry(const Handle& handle, const TensorDescriptor& aDesc)
+{
+    auto geo = Geometry{};
+
+    geo.rows = aDesc.GetLengths()[0];
+    geo.cols = aDesc.GetElementSize() / geo.rows;
+    SetColumnTiling(geo, aDesc.GetType());
+
+    const auto min_rows = geo.grp1 * 8;
+    const auto target   = std::max<std::size_t>(1, handle.GetMaxComputeUnits() * 4 / geo.cgroups);
+    geo.nseg            = std::max<std::size_t>(1, std::min(geo.rows / min_rows, target));
+    geo.segrows         = (geo.rows + geo.nseg - 1) / geo.nseg;
+    geo.nseg            = (geo.rows + geo.segrows - 1) / geo.segrows;
+    geo.mode            = 1;
+
+    return geo;
+}
+
+static std::size_t GetSegmentedWorkspaceSize(const Geometry& geo, bool need_indices)
+{
+    return geo.nseg * 2 * geo.cols * (sizeof(float) + (need_indices ? sizeof(int) : 0));
+}
+
+static void RunSegmented(const Handle& handle,
+                         const ReduceTensorDescriptor& red,
+                         bool need_indices,
+                         const TensorDescriptor& aDesc,
+                         ConstData_t A,
+                         ConstData_t offsets,
+                         float alpha,
+                         float beta,
+                         const TensorDescriptor& cDesc,
+                         Data_t C,
+                         Data_t indices,
+                         Data_t workspace)
+{
+    const auto geo  = GetSegmentedGeometry(handle, aDesc);
+    const auto type = aDesc.GetType();
+
+    const auto elem_type = type == miopenFloat ? "float" : (type == miopenHalf ? "half" : "ushort");
+
+    std::string param;
+    param += " -DMIO_RED_T=" + std::string(elem_type);
+    param += " -DMIO_RED_FP16=" + std::to_string(static_cast<int>(type == miopenHalf));
+    param += " -DMIO_RED_BF16=" + std::to_string(static_cast<int>(type == miopenBFloat16));
+    param += " -DMIO_RED_OP=" + std::to_string(static_cast<int>(red.reduceTensorOp_));
+    param += " -DMIO_RED_NAN=" +
+             std::to_string(static_cast<int>(red.reduceTensorNanOpt_ == MIOPEN_PROPAGATE_NAN));
+    param += " -DMIO_RED_VEC=" + std::to_string(geo.vec);
+    param += " -DMIO_RED_GRP0=" + std::to_string(geo.grp0);
+    param += " -DMIO_RED_GRP1=" + std::to_string(geo.grp1);
+    param += " -DMIO_RED_INDICES=" + std::to_string(static_cast<int>(need_indices));
+
+    const std::string algo_name    = "outer_reduce_tensor_segmented";
+    const std::string program_name = "MIOpenReduceOuter.cl";
+
+    std::ostringstream ss;
+    ss << "reduce_segmented_T" << type << "op" << red.reduceTensorOp_ << "n"
+       << red.reduceTensorNanOpt_ << "v" << geo.vec << "g" << geo.grp0 << "i" << need_indices;
+    const auto network_config = ss.str();
+
+    const auto rows      = static_cast<uint64_t>(geo.rows);
+    const auto cols      = static_cast<uint32_t>(geo.cols);
+    const auto nsegs     = static_cast<uint32_t>(cDesc.GetLengths()[0]);
+    const auto nchunks   = static_cast<uint32_t>(geo.nseg);
+    const auto chunkrows = static_cast<uint64_t>(geo.segrows);
+
+    const std::vector<size_t> vld = {geo.grp0, geo.grp1, 1};
+    const std::vector<size_t> vgd = {geo.cgroups * geo.grp0, geo.nseg * geo.grp1, 1};
+
+    const std::vector<size_t> vld_final = {256, 1, 1};
+    const std::vector<size_t> vgd_final = {(geo.cols + 255) / 256 * 256, nsegs, 1};
+
+    float time_reduce = 0.0f;
+
+    handle.AddKernel(
+        algo_name, network_config, program_name, "MIOpenReduceOuterSegmented", vld, vgd, param)(
+        A, C, indices, workspace, offsets, alpha, beta, rows, cols, nsegs, chunkrows);
+    if(handle.IsProfilingEnabled())
+        time_reduce += handle.GetKernelTime();
+
+    handle.AddKernel(algo_name,
+                     network_config + "_final",
+                     program_name,
+                     "MIOpenReduceOuterSegmentedFinal",
+                     vld_final,
+                     vgd_final,
+                     param)(C, indices, workspace, offsets, alpha, beta, cols, nchunks, chunkrows);
+    if(handle.IsProfilingEnabled())
+    {
+        time_reduce += handle.GetKernelTime();
+        handle.ResetKernelTime();
+        handle.AccumKernelTime(time_reduce);
+    }
+}
+
+}; // end of namespace detailOuter
+
 ReduceTensorDescriptor::ReduceTensorDescriptor(miopenReduceTensorOp_t reduceTensorOp,
                                                miopenDataType_t reduceTensorCompType,
                                                miopenNanPropagation_t reduceTensorNanOpt,
@@ -519,11 +999,9 @@ std::size_t ReduceTensorDescriptor::GetWorkspaceSize(const Handle& handle,
 
     int blockSize;
 
+    // the smallest block size the perf-db may hold needs the largest workspace
     if(!miopen::IsDisabled(MIOPEN_DEBUG_DYNAMIC_REDUCTION{}))
-    {
-        const tunable_generic_reduction* tunable = &default_tunable_generic_reduction;
-        blockSize                                = tunable->BlockSize;
-    }
+        blockSize = reduce::PerformanceConfigReduce::MinBlockSize();
     else
         blockSize = 256;
 
@@ -547,6 +1025,11 @@ std::size_t ReduceTensorDescriptor::GetWorkspaceSize(const Handle& handle,
     if(!miopen::IsDisabled(MIOPEN_DEBUG_DYNAMIC_REDUCTION{}))
         wsSizeInBytes += 4096;
 
+    const auto problem = reduce::ProblemDescription{*this, inDesc, outDesc};
+    if(detailOuter::IsApplicable(problem))
+        wsSizeInBytes = std::max(wsSizeInBytes,
+                                 detailOuter::GetGeometry(handle, problem).GetWorkspaceSize());
+
     return (wsSizeInBytes);
 };
 
@@ -581,7 +1064,7 @@ std::size_t ReduceTensorDescriptor::GetIndicesSize(const TensorDescriptor& inDes
     return (outDesc.GetElementSize() * sizeof(int));
 };
 
-void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
+void ReduceTensorDescriptor::ReduceTensor(Handle& handle,
                                           Data_t indices,
                                           size_t indicesSizeInBytes,
                                           Data_t workspace,
@@ -606,12 +1089,6 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
     const auto& outDescLengths = cDesc.GetLengths();
     const auto& outDescStrides = cDesc.GetStrides();
 
-    const tunable_generic_reduction* tunable = &default_tunable_generic_reduction;
-
-    const int blockSize =
-        !miopen::IsDisabled(MIOPEN_DEBUG_DYNAMIC_REDUCTION{}) ? tunable->BlockSize : 256;
-    detail::ReductionKernelConfigurator configurator(blockSize, handle.GetWavefrontWidth());
-
     const bool need_indices =
         (reduceIndicesOpt == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES) &&
         (reduceOp == MIOPEN_REDUCE_TENSOR_MIN || reduceOp == MIOPEN_REDUCE_TENSOR_MAX ||
@@ -646,23 +1123,20 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
     const auto invariantLength = cDesc.GetElementSize();
     const auto toReduceLength  = aDesc.GetElementSize() / invariantLength;
 
-    long ws_buf2_bytes_offset = 0;
+    // the indices are kept in the workspace behind the partial results of the first call
+    const auto get_ws_buf2_bytes_offset = [&](const detail::ReductionKernelConfigurator& cfg) {
+        long offset = 0;
 
-    if(need_indices && workspace != nullptr)
-    {
-        auto aTypeSize      = detail::GetDataTypeSize(aDesc.GetType());
-        auto workspace_size = configurator.getWorkspaceSize(invariantLength, toReduceLength);
-
-        ws_buf2_bytes_offset = ((workspace_size * aTypeSize + 63) / 64) * 64;
-    };
+        if(need_indices && workspace != nullptr)
+        {
+            auto aTypeSize      = detail::GetDataTypeSize(aDesc.GetType());
+            auto workspace_size = cfg.getWorkspaceSize(invariantLength, toReduceLength);
 
-    const ReductionMethod_t reduceImpl =
-        configurator.getReductionMethod(invariantLength, toReduceLength);
-    const int gridSize = configurator.getGridSize(invariantLength, toReduceLength);
-    const int blkGroupSize =
-        (reduceImpl == Reduce_MultiBlock) ? static_cast<int>(gridSize / invariantLength) : 0;
+            offset = ((workspace_size * aTypeSize + 63) / 64) * 64;
+        };
 
-    const bool useTwoCalls = (reduceImpl == Reduce_MultiBlock);
+        return offset;
+    };
 
     std::vector<int> toReduceDims;
     std::vector<int> invariantDims;
@@ -688,8 +1162,30 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
                         ? static_cast<float>(*reinterpret_cast<const double*>(beta))
                         : *reinterpret_cast<const float*>(beta);
 
+    const auto problem = reduce::ProblemDescription{*this, aDesc, cDesc};
+
+    if(detailOuter::IsApplicable(problem))
+    {
+        detailOuter::Run(handle, problem, alphaVal, A, betaVal, C, workspace);
+        return;
+    }
+
     if(miopen::IsDisabled(MIOPEN_DEBUG_DYNAMIC_REDUCTION{}))
     { // use static reduction
+        const int blockSize = 256;
+        const detail::ReductionKernelConfigurator configurator(blockSize,
+                                                               handle.GetWavefrontWidth());
+
+        const long ws_buf2_bytes_offset = get_ws_buf2_bytes_offset(configurator);
+
+        const ReductionMethod_t reduceImpl =
+            configurator.getReductionMethod(invariantLength, toReduceLength);
+        const int gridSize = configurator.getGridSize(invariantLength, toReduceLength);
+        const int blkGroupSize =
+            (reduceImpl == Reduce_MultiBlock) ? static_cast<int>(gridSize / invariantLength) : 0;
+
+        const bool useTwoCalls = (reduceImpl == Reduce_MultiBlock);
+
         std::vector<std::size_t> invariantLengths;
         std::vector<std::size_t> invariantStrides;
 
@@ -885,215 +1381,147 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
     }
     else
     { // use dynamic reduction
-        const int origReduceLen = toReduceLength;
+        // runs the reduction into `out` and returns the kernel time when profiling
+        const auto run = [&](const tunable_generic_reduction& tuned, Data_t out) {
+            const tunable_generic_reduction* tunable = &tuned;
 
-        int p_inLengths[6]  = {0};
-        int p_inStrides[6]  = {0};
-        int p_outLengths[6] = {0};
-        int p_outStrides[6] = {0};
+            const detail::ReductionKernelConfigurator configurator(tunable->BlockSize,
+                                                                   handle.GetWavefrontWidth());
 
-        int pos = 0;
-        for(int i = 0; i < outDescLengths.size(); i++)
-        {
-            // invariant dimensions
-            if(outDescLengths[i] > 1)
+            const long ws_buf2_bytes_offset = get_ws_buf2_bytes_offset(configurator);
+
+            const ReductionMethod_t reduceImpl =
+                configurator.getReductionMethod(invariantLength, toReduceLength);
+            const int gridSize = configurator.getGridSize(invariantLength, toReduceLength);
+            const int blkGroupSize =
+                (reduceImpl == Reduce_MultiBlock) ? static_cast<int>(gridSize / invariantLength)
+                                                  : 0;
+
+            const bool useTwoCalls = (reduceImpl == Reduce_MultiBlock);
+
+            const int origReduceLen = toReduceLength;
+
+            int p_inLengths[6]  = {0};
+            int p_inStrides[6]  = {0};
+            int p_outLengths[6] = {0};
+            int p_outStrides[6] = {0};
+
+            int pos = 0;
+            for(int i = 0; i < outDescLengths.size(); i++)
             {
-                p_outLengths[pos] = static_cast<int>(outDescLengths[i]);
-                p_outStrides[pos] = static_cast<int>(outDescStrides[i]);
-                p_inLengths[pos]  = static_cast<int>(inDescLengths[i]);
-                p_inStrides[pos]  = static_cast<int>(inDescStrides[i]);
-                pos++;
+                // invariant dimensions
+                if(outDescLengths[i] > 1)
+                {
+                    p_outLengths[pos] = static_cast<int>(outDescLengths[i]);
+                    p_outStrides[pos] = static_cast<int>(outDescStrides[i]);
+                    p_inLengths[pos]  = static_cast<int>(inDescLengths[i]);
+                    p_inStrides[pos]  = static_cast<int>(inDescStrides[i]);
+                    pos++;
+                };
             };
-        };
 
-        for(int i = 0; i < outDescLengths.size(); i++)
-        {
-            // toReduce dimensions
-            if(outDescLengths[i] == 1)
+            for(int i = 0; i < outDescLengths.size(); i++)
             {
-                p_inLengths[pos] = static_cast<int>(inDescLengths[i]);
-                p_inStrides[pos] = static_cast<int>(inDescStrides[i]);
-                pos++;
+                // toReduce dimensions
+                if(outDescLengths[i] == 1)
+                {
+                    p_inLengths[pos] = static_cast<int>(inDescLengths[i]);
+                    p_inStrides[pos] = static_cast<int>(inDescStrides[i]);
+                    pos++;
+                };
             };
-        };
 
-        if(reduceAllDims)
-        {
-            p_outLengths[0] = 1;
-            p_outStrides[0] = 1;
-        };
+            if(reduceAllDims)
+            {
+                p_outLengths[0] = 1;
+                p_outStrides[0] = 1;
+            };
 
-        const std::vector<size_t> vld  = {static_cast<size_t>(tunable->BlockSize), 1, 1};
-        const std::vector<size_t> vgd1 = {static_cast<size_t>(tunable->BlockSize), 1, 1};
-        const std::vector<size_t> vgd2 = {static_cast<size_t>(gridSize) * tunable->BlockSize, 1, 1};
+            const std::vector<size_t> vld  = {static_cast<size_t>(tunable->BlockSize), 1, 1};
+            const std::vector<size_t> vgd1 = {static_cast<size_t>(tunable->BlockSize), 1, 1};
+            const std::vector<size_t> vgd2 = {
+                static_cast<size_t>(gridSize) * tunable->BlockSize, 1, 1};
 
-        std::string algo_name = "dynamic_generic_reduction";
+            std::string algo_name = "dynamic_generic_reduction";
 
-        std::string param;
-        std::string network_config;
+            std::string param;
+            std::string network_config;
 
-        param = solver::ck_utility::get_ck_common_compiler_flag(handle);
+            param = solver::ck_utility::get_ck_common_compiler_flag(handle);
 
-        param += detailDynamic::get_definition_string_from_type_enums(
-                     srcDataType, compType, dstDataType) +
-                 " " + detailDynamic::get_definition_string_from_tunable(tunable);
+            param += detailDynamic::get_definition_string_from_type_enums(
+                         srcDataType, compType, dstDataType) +
+                     " " + detailDynamic::get_definition_string_from_tunable(tunable);
 
-        if(!reduceAllDims)
-            param += " -DCK_PARAM_NUM_TOREDUCE_DIMS=" + std::to_string(toReduceDims.size());
+            if(!reduceAllDims)
+                param += " -DCK_PARAM_NUM_TOREDUCE_DIMS=" + std::to_string(toReduceDims.size());
 
-        param += " -DCK_PARAM_REDUCE_OP=" +
-                 std::to_string(static_cast<int>(detailDynamic::mapReduceOpId(reduceOp)));
+            param += " -DCK_PARAM_REDUCE_OP=" +
+                     std::to_string(static_cast<int>(detailDynamic::mapReduceOpId(reduceOp)));
 
-        param += detailDynamic::get_definition_string_from_options(nanPropaOpt, reduceIndicesOpt);
+            param +=
+                detailDynamic::get_definition_string_from_options(nanPropaOpt, reduceIndicesOpt);
 
-        param += " -DCK_PARAM_IN_DIMS=" + std::to_string(inDescLengths.size());
-        param += " -DCK_PARAM_OUT_DIMS=";
-        param += reduceAllDims ? "1" : std::to_string(invariantDims.size());
+            param += " -DCK_PARAM_IN_DIMS=" + std::to_string(inDescLengths.size());
+            param += " -DCK_PARAM_OUT_DIMS=";
+            param += reduceAllDims ? "1" : std::to_string(invariantDims.size());
 
-        float time_reduce = 0.0f;
+            float time_reduce = 0.0f;
 
-        network_config = detailDynamic::get_network_config_string_from_type_enums(
-                             srcDataType, compType, dstDataType) +
-                         "_" + detailDynamic::get_network_config_string_from_tunable(tunable) + "_";
+            network_config =
+                detailDynamic::get_network_config_string_from_type_enums(
+                    srcDataType, compType, dstDataType) +
+                "_" + detailDynamic::get_network_config_string_from_tunable(tunable) + "_";
 
-        network_config +=
-            std::to_string(static_cast<int>(detailDynamic::mapReduceOpId(reduceOp))) + "_";
-        network_config +=
-            detailDynamic::get_network_config_string_from_options(nanPropaOpt, reduceIndicesOpt);
+            network_config +=
+                std::to_string(static_cast<int>(detailDynamic::mapReduceOpId(reduceOp))) + "_";
+            network_config += detailDynamic::get_network_config_string_from_options(
+                nanPropaOpt, reduceIndicesOpt);
 
-        network_config += "I" + std::to_string(inDescLengths.size()) + "_";
+            network_config += "I" + std::to_string(inDescLengths.size()) + "_";
 
-        network_config += "RED";
-        network_config += std::to_string(toReduceDims.size()) + "_";
-        network_config += "BSIZE_" + std::to_string(tunable->BlockSize);
-
-        auto use_padding = detailDynamic::get_padding_need(reduceImpl,
-                                                           invariantLength,
-                                                           toReduceLength,
-                                                           gridSize,
-                                                           tunable->BlockSize,
-                                                           handle.GetWavefrontWidth(),
-                                                           blkGroupSize,
-                                                           tunable);
-
-        std::string param1 =
-            param +
-            " -DCK_PARAM_SRC2D_PADDING=" + std::to_string(static_cast<int>(use_padding.first)) +
-            " -DCK_PARAM_DST1D_PADDING=" + std::to_string(static_cast<int>(use_padding.second));
-
-        const std::string program_name1 =
-            detailDynamic::get_kernel_file_name(true, reduceImpl, reduceAllDims);
-        std::string kernel_name1     = "gridwise_generic_reduce_1_prepare";
-        std::string network_config_1 = network_config + "_1_P" + std::to_string(reduceImpl) +
-                                       std::to_string(static_cast<int>(use_padding.first)) +
-                                       std::to_string(static_cast<int>(use_padding.second));
+            network_config += "RED";
+            network_config += std::to_string(toReduceDims.size()) + "_";
+            network_config += "BSIZE_" + std::to_string(tunable->BlockSize);
 
-        if(!reduceAllDims)
-            handle.AddKernel(
-                algo_name, network_config_1, program_name1, kernel_name1, vld, vgd1, param1)(
-                gridSize,
-                blkGroupSize,
-                p_inLengths[0],
-                p_inLengths[1],
-                p_inLengths[2],
-                p_inLengths[3],
-                p_inLengths[4],
-                p_inLengths[5],
-                p_inStrides[0],
-                p_inStrides[1],
-                p_inStrides[2],
-                p_inStrides[3],
-                p_inStrides[4],
-                p_inStrides[5],
-                p_outStrides[0],
-                p_outStrides[1],
-                p_outStrides[2],
-                p_outStrides[3],
-                p_outStrides[4],
-                p_outStrides[5],
-                workspace);
-        else
-            handle.AddKernel(
-                algo_name, network_config_1, program_name1, kernel_name1, vld, vgd1, param1)(
-                gridSize,
-                blkGroupSize,
-                p_inLengths[0],
-                p_inLengths[1],
-                p_inLengths[2],
-                p_inLengths[3],
-                p_inLengths[4],
-                p_inLengths[5],
-                p_inStrides[0],
-                p_inStrides[1],
-                p_inStrides[2],
-                p_inStrides[3],
-                p_inStrides[4],
-                p_inStrides[5],
-                workspace);
-
-        if(handle.IsProfilingEnabled())
-            time_reduce += handle.GetKernelTime();
-
-        kernel_name1     = "gridwise_generic_reduce_1";
-        network_config_1 = network_config + "_1" + std::to_string(reduceImpl) +
-                           std::to_string(static_cast<int>(use_padding.first)) +
-                           std::to_string(static_cast<int>(use_padding.second));
-
-        handle.AddKernel(
-            algo_name, network_config_1, program_name1, kernel_name1, vld, vgd2, param1)(
-            origReduceLen,
-            blkGroupSize,
-            alphaVal,
-            A,
-            betaVal,
-            C,
-            workspace,
-            ws_buf2_bytes_offset,
-            indices);
+            auto use_padding = detailDynamic::get_padding_need(reduceImpl,
+                                                               invariantLength,
+                                                               toReduceLength,
+                                                               gridSize,
+                                                               tunable->BlockSize,
+                                                               handle.GetWavefrontWidth(),
+                                                               blkGroupSize,
+                                                               tunable);
 
-        if(handle.IsProfilingEnabled())
-            time_reduce += handle.GetKernelTime();
+            std::string param1 =
+                param +
+                " -DCK_PARAM_SRC2D_PADDING=" + std::to_string(static_cast<int>(use_padding.first)) +
+                " -DCK_PARAM_DST1D_PADDING=" + std::to_string(static_cast<int>(use_padding.second));
 
-        if(useTwoCalls)
-        {
-            const auto toReduceLength_2 = blkGroupSize;
-            const int gridSize_2 =
-                static_cast<int>(configurator.getGridSize_2(invariantLength, toReduceLength_2));
-            const std::vector<size_t> vgd2_2 = {
-                static_cast<size_t>(gridSize_2) * tunable->BlockSize, size_t{1}, size_t{1}};
-            const auto reduceImpl2  = configurator.GetReductionMethod_2(toReduceLength_2);
-            const auto use_padding2 = detailDynamic::get_padding_need(reduceImpl2,
-                                                                      invariantLength,
-                                                                      toReduceLength_2,
-                                                                      gridSize_2,
-                                                                      tunable->BlockSize,
-                                                                      handle.GetWavefrontWidth(),
-                                                                      1,
-                                                                      tunable);
-
-            std::string param2 = param + " -DCK_PARAM_SRC2D_PADDING=" +
-                                 std::to_string(static_cast<int>(use_padding2.first)) +
-                                 " -DCK_PARAM_DST1D_PADDING=" +
-                                 std::to_string(static_cast<int>(use_padding2.second));
-
-            std::string program_name2 =
-                detailDynamic::get_kernel_file_name(false, reduceImpl2, reduceAllDims);
-            std::string kernel_name2     = "gridwise_generic_reduce_2_prepare";
-            std::string network_config_2 = network_config + "_2_P" + std::to_string(reduceImpl2) +
-                                           std::to_string(static_cast<int>(use_padding2.first)) +
-                                           std::to_string(static_cast<int>(use_padding2.second));
+            const std::string program_name1 =
+                detailDynamic::get_kernel_file_name(true, reduceImpl, reduceAllDims);
+            std::string kernel_name1     = "gridwise_generic_reduce_1_prepare";
+            std::string network_config_1 = network_config + "_1_P" + std::to_string(reduceImpl) +
+                                           std::to_string(static_cast<int>(use_padding.first)) +
+                                           std::to_string(static_cast<int>(use_padding.second));
 
             if(!reduceAllDims)
                 handle.AddKernel(
-                    algo_name, network_config_2, program_name2, kernel_name2, vld, vgd1, param2)(
-                    gridSize_2,
+                    algo_name, network_config_1, program_name1, kernel_name1, vld, vgd1, param1)(
+                    gridSize,
                     blkGroupSize,
-                    p_outLengths[0],
-                    p_outLengths[1],
-                    p_outLengths[2],
-                    p_outLengths[3],
-                    p_outLengths[4],
-                    p_outLengths[5],
+                    p_inLengths[0],
+                    p_inLengths[1],
+                    p_inLengths[2],
+                    p_inLengths[3],
+                    p_inLengths[4],
+                    p_inLengths[5],
+                    p_inStrides[0],
+                    p_inStrides[1],
+                    p_inStrides[2],
+                    p_inStrides[3],
+                    p_inStrides[4],
+                    p_inStrides[5],
                     p_outStrides[0],
                     p_outStrides[1],
                     p_outStrides[2],
@@ -1103,33 +1531,244 @@ void ReduceTensorDescriptor::ReduceTensor(const Handle& handle,
                     workspace);
             else
                 handle.AddKernel(
-                    algo_name, network_config_2, program_name2, kernel_name2, vld, vgd1, param2)(
-                    gridSize_2, blkGroupSize, workspace);
+                    algo_name, network_config_1, program_name1, kernel_name1, vld, vgd1, param1)(
+                    gridSize,
+                    blkGroupSize,
+                    p_inLengths[0],
+                    p_inLengths[1],
+                    p_inLengths[2],
+                    p_inLengths[3],
+                    p_inLengths[4],
+                    p_inLengths[5],
+                    p_inStrides[0],
+                    p_inStrides[1],
+                    p_inStrides[2],
+                    p_inStrides[3],
+                    p_inStrides[4],
+                    p_inStrides[5],
+                    workspace);
 
             if(handle.IsProfilingEnabled())
                 time_reduce += handle.GetKernelTime();
 
-            kernel_name2     = "gridwise_generic_reduce_2";
-            network_config_2 = network_config + "_2" + std::to_string(reduceImpl2) +
-                               std::to_string(static_cast<int>(use_padding2.first)) +
-                               std::to_string(static_cast<int>(use_padding2.second));
+            kernel_name1     = "gridwise_generic_reduce_1";
+            network_config_1 = network_config + "_1" + std::to_string(reduceImpl) +
+                               std::to_string(static_cast<int>(use_padding.first)) +
+                               std::to_string(static_cast<int>(use_padding.second));
 
             handle.AddKernel(
-                algo_name, network_config_2, program_name2, kernel_name2, vld, vgd2_2, param2)(
-                origReduceLen, alphaVal, A, betaVal, C, workspace, ws_buf2_bytes_offset, indices);
+                algo_name, network_config_1, program_name1, kernel_name1, vld, vgd2, param1)(
+                origReduceLen,
+                blkGroupSize,
+                alphaVal,
+                A,
+                betaVal,
+                out,
+                workspace,
+                ws_buf2_bytes_offset,
+                indices);
 
             if(handle.IsProfilingEnabled())
                 time_reduce += handle.GetKernelTime();
-        };
 
-        if(handle.IsProfilingEnabled())
-        {
-            handle.ResetKernelTime();
-            handle.AccumKernelTime(time_reduce);
+            if(useTwoCalls)
+            {
+                const auto toReduceLength_2 = blkGroupSize;
+                const int gridSize_2 =
+                    static_cast<int>(configurator.getGridSize_2(invariantLength, toReduceLength_2));
+                const std::vector<size_t> vgd2_2 = {
+                    static_cast<size_t>(gridSize_2) * tunable->BlockSize, size_t{1}, size_t{1}};
+                const auto reduceImpl2  = configurator.GetReductionMethod_2(toReduceLength_2);
+                const auto use_padding2 =
+                    detailDynamic::get_padding_need(reduceImpl2,
+                                                    invariantLength,
+                                                    toReduceLength_2,
+                                                    gridSize_2,
+                                                    tunable->BlockSize,
+                                                    handle.GetWavefrontWidth(),
+                                                    1,
+                                                    tunable);
+
+                std::string param2 = param + " -DCK_PARAM_SRC2D_PADDING=" +
+                                     std::to_string(static_cast<int>(use_padding2.first)) +
+                                     " -DCK_PARAM_DST1D_PADDING=" +
+                                     std::to_string(static_cast<int>(use_padding2.second));
+
+                std::string program_name2 =
+                    detailDynamic::get_kernel_file_name(false, reduceImpl2, reduceAllDims);
+                std::string kernel_name2     = "gridwise_generic_reduce_2_prepare";
+                std::string network_config_2 =
+                    network_config + "_2_P" + std::to_string(reduceImpl2) +
+                    std::to_string(static_cast<int>(use_padding2.first)) +
+                    std::to_string(static_cast<int>(use_padding2.second));
+
+                if(!reduceAllDims)
+                    handle.AddKernel(algo_name,
+                                     network_config_2,
+                                     program_name2,
+                                     kernel_name2,
+                                     vld,
+                                     vgd1,
+                                     param2)(
+                        gridSize_2,
+                        blkGroupSize,
+                        p_outLengths[0],
+                        p_outLengths[1],
+                        p_outLengths[2],
+                        p_outLengths[3],
+                        p_outLengths[4],
+                        p_outLengths[5],
+                        p_outStrides[0],
+                        p_outStrides[1],
+                        p_outStrides[2],
+                        p_outStrides[3],
+                        p_outStrides[4],
+                        p_outStrides[5],
+                        workspace);
+                else
+                    handle.AddKernel(algo_name,
+                                     network_config_2,
+                                     program_name2,
+                                     kernel_name2,
+                                     vld,
+                                     vgd1,
+                                     param2)(
+                        gridSize_2, blkGroupSize, workspace);
+
+                if(handle.IsProfilingEnabled())
+                    time_reduce += handle.GetKernelTime();
+
+                kernel_name2     = "gridwise_generic_reduce_2";
+                network_config_2 = network_config + "_2" + std::to_string(reduceImpl2) +
+                                   std::to_string(static_cast<int>(use_padding2.first)) +
+                                   std::to_string(static_cast<int>(use_padding2.second));
+
+                handle.AddKernel(
+                    algo_name, network_config_2, program_name2, kernel_name2, vld, vgd2_2, param2)(
+                    origReduceLen,
+                    alphaVal,
+                    A,
+                    betaVal,
+                    out,
+                    workspace,
+                    ws_buf2_bytes_offset,
+                    indices);
+
+                if(handle.IsProfilingEnabled())
+                    time_reduce += handle.GetKernelTime();
+            };
+
+            if(handle.IsProfilingEnabled())
+            {
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(time_reduce);
+            };
+
+
+            return time_reduce;
         };
+
+        // the search writes to a scratch output, so that beta keeps its meaning for the real call
+        Allocator::ManageDataPtr scratch;
+        const auto config = detailDynamic::GetPerformanceConfig(
+            handle, problem, [&](const tunable_generic_reduction& tuned) {
+                if(!scratch)
+                {
+                    const MemoryCategoryScope memory_scope{MemoryCategory::Search};
+                    scratch = handle.Create(cDesc.GetElementSpace() * GetTypeSize(dstDataType));
+                }
+                return run(tuned, scratch.get());
+            });
+
+        run(config.GetTunable(), C);
     };
 };
 
+// A segmented reduction keeps every dimension of A but the leading one, which holds the rows
+// grouped to the segments, so C has one row per segment.
+static void CheckSegmentedReduction(const ReduceTensorDescriptor& red,
+                                    const TensorDescriptor& aDesc,
+                                    const TensorDescriptor& cDesc)
+{
+    const auto& in_lens  = aDesc.GetLengths();
+    const auto& out_lens = cDesc.GetLengths();
+
+    if(in_lens.size() != out_lens.size())
+        MIOPEN_THROW("The number of dimensions of the input and output tensor should match.");
+    if(!std::equal(in_lens.begin() + 1, in_lens.end(), out_lens.begin() + 1))
+        MIOPEN_THROW("A segmented reduction only reduces the leading dimension of the input.");
+    if(in_lens[0] == 0 || in_lens[0] > std::numeric_limits<int32_t>::max())
+        MIOPEN_THROW("The segmented rows should be indexable with int32 offsets.");
+
+    const auto type = aDesc.GetType();
+    const auto comp = red.reduceTensorCompType_;
+    if(cDesc.GetType() != type ||
+       (type != miopenFloat && type != miopenHalf && type != miopenBFloat16) ||
+       (comp != miopenFloat && comp != type))
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "A segmented reduction needs float, half or bfloat16 tensors of one type.");
+    if(!detailOuter::IsRowMajorPacked(aDesc) || !detailOuter::IsRowMajorPacked(cDesc))
+        MIOPEN_THROW(miopenStatusNotImplemented, "A segmented reduction needs packed tensors.");
+    if(aDesc.GetElementSize() / in_lens[0] > std::numeric_limits<uint32_t>::max())
+        MIOPEN_THROW(miopenStatusNotImplemented, "The segmented rows are too long.");
+}
+
+static bool NeedSegmentedIndices(const ReduceTensorDescriptor& red)
+{
+    return red.reduceTensorIndices_ == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES &&
+           (red.reduceTensorOp_ == MIOPEN_REDUCE_TENSOR_MIN ||
+            red.reduceTensorOp_ == MIOPEN_REDUCE_TENSOR_MAX ||
+            red.reduceTensorOp_ == MIOPEN_REDUCE_TENSOR_AMAX);
+}
+
+std::size_t ReduceTensorDescriptor::GetSegmentedWorkspaceSize(const Handle& handle,
+                                                              const TensorDescriptor& inDesc,
+                                                              const TensorDescriptor& outDesc) const
+{
+    CheckSegmentedReduction(*this, inDesc, outDesc);
+    return detailOuter::GetSegmentedWorkspaceSize(
+        detailOuter::GetSegmentedGeometry(handle, inDesc), NeedSegmentedIndices(*this));
+}
+
+void ReduceTensorDescriptor::ReduceTensorSegmented(Handle& handle,
+                                                   Data_t indices,
+                                                   size_t indicesSizeInBytes,
+                                                   Data_t workspace,
+                                                   size_t workspaceSizeInBytes,
+                                                   ConstData_t offsets,
+                                                   const void* alpha,
+                                                   const TensorDescriptor& aDesc,
+                                                   ConstData_t A,
+                                                   const void* beta,
+                                                   const TensorDescriptor& cDesc,
+                                                   Data_t C) const
+{
+    CheckSegmentedReduction(*this, aDesc, cDesc);
+
+    const bool need_indices = NeedSegmentedIndices(*this);
+    if(need_indices && this->reduceTensorIndicesType_ != MIOPEN_32BIT_INDICES)
+        MIOPEN_THROW("Only int32 type can be used for ReduceTensor indices.");
+
+    if(this->GetSegmentedWorkspaceSize(handle, aDesc, cDesc) > workspaceSizeInBytes)
+        MIOPEN_THROW("The workspace size allocated is not enough!");
+
+    if(need_indices && cDesc.GetElementSize() * sizeof(int) > indicesSizeInBytes)
+        MIOPEN_THROW("The indices size allocated is not enough!");
+
+    detailOuter::RunSegmented(handle,
+                              *this,
+                              need_indices,
+                              aDesc,
+                              A,
+                              offsets,
+                              *reinterpret_cast<const float*>(alpha),
+                              *reinterpret_cast<const float*>(beta),
+                              cDesc,
+                              C,
+                              indices,
+                              workspace);
+}
+
 std::ostream& operator<<(std::ostream& stream, const ReduceTensorDescriptor& desc)
 {
     stream << "ReduceTensor Descriptor : " << std::endl;
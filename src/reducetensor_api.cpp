@@ -221,3 +221,66 @@ extern "C" miopenStatus_t miopenReduceTensor(miopenHandle_t handle,
                           DataCast(C));
     });
 };
+
+extern "C" miopenStatus_t
+miopenGetReductionSegmentedWorkspaceSize(miopenHandle_t handle,
+                                         const miopenReduceTensorDescriptor_t reduceTensorDesc,
+                                         const miopenTensorDescriptor_t aDesc,
+                                         const miopenTensorDescriptor_t cDesc,
+                                         size_t* sizeInBytes)
+{
+    MIOPEN_LOG_FUNCTION(handle, reduceTensorDesc, aDesc, cDesc, sizeInBytes);
+
+    return miopen::try_([&] {
+        miopen::deref(sizeInBytes) = miopen::deref(reduceTensorDesc)
+                                         .GetSegmentedWorkspaceSize(miopen::deref(handle),
+                                                                    miopen::deref(aDesc),
+                                                                    miopen::deref(cDesc));
+    });
+};
+
+extern "C" miopenStatus_t
+miopenReduceTensorSegmented(miopenHandle_t handle,
+                            const miopenReduceTensorDescriptor_t reduceTensorDesc,
+                            void* indices,
+                            size_t indicesSizeInBytes,
+                            void* workspace,
+                            size_t workspaceSizeInBytes,
+                            const void* segmentOffsets,
+                            const void* alpha,
+                            const miopenTensorDescriptor_t aDesc,
+                            const void* A,
+                            const void* beta,
+                            const miopenTensorDescriptor_t cDesc,
+                            void* C)
+{
+    MIOPEN_LOG_FUNCTION(handle,
+                        reduceTensorDesc,
+                        indices,
+                        indicesSizeInBytes,
+                        workspace,
+                        workspaceSizeInBytes,
+                        segmentOffsets,
+                        alpha,
+                        aDesc,
+                        A,
+                        beta,
+                        cDesc,
+                        C);
+
+    return miopen::try_([&] {
+        miopen::deref(reduceTensorDesc)
+            .ReduceTensorSegmented(miopen::deref(handle),
+                                   DataCast(indices),
+                                   indicesSizeInBytes,
+                                   DataCast(workspace),
+                                   workspaceSizeInBytes,
+                                   DataCast(segmentOffsets),
+                                   alpha,
+                                   miopen::deref(aDesc),
+                                   DataCast(A),
+                                   beta,
+                                   miopen::deref(cDesc),
+                                   DataCast(C));
+    });
+};
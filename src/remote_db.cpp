@@ -0,0 +1,213 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/remote_db.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/exec_utils.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/path.hpp>
+
+#include <algorithm>
+#include <memory>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_REMOTE_DB_COMMAND)
+
+namespace miopen {
+
+static std::string QuoteArgument(const std::string& arg)
+{
+    auto quoted = std::string{"'"};
+    for(const auto c : arg)
+    {
+        if(c == '\'')
+            quoted += "'\\''";
+        else
+            quoted += c;
+    }
+    return quoted + "'";
+}
+
+RemoteDb::RemoteDb(const std::string& command_) : command(command_) {}
+
+RemoteDb::~RemoteDb()
+{
+    {
+        std::lock_guard<std::mutex> lock{queue_mutex};
+        stopping = true;
+    }
+    queue_cv.notify_all();
+    if(publisher.joinable())
+        publisher.join();
+}
+
+RemoteDb* RemoteDb::Get()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static const auto instance = []() -> std::unique_ptr<RemoteDb> {
+        const auto command = GetStringEnv(MIOPEN_REMOTE_DB_COMMAND{});
+        if(command == nullptr || *command == '\0')
+            return nullptr;
+        MIOPEN_LOG_I("Remote tuning database: " << command);
+        return std::make_unique<RemoteDb>(command);
+    }();
+    return instance.get();
+}
+
+std::string RemoteDb::GetName(const std::string& installed_path)
+{
+    if(Get() == nullptr)
+        return {};
+    return boost::filesystem::path(installed_path).filename().string();
+}
+
+std::string
+RemoteDb::GetCommand(const char* action, const std::string& db, const std::string& key) const
+{
+    return command + " " + action + " " + QuoteArgument(db) + " " + QuoteArgument(key);
+}
+
+boost::optional<DbRecord> RemoteDb::Fetch(const std::string& db, const std::string& key)
+{
+    if(db.empty() || key.empty())
+        return boost::none;
+
+    const auto id = std::make_pair(db, key);
+    {
+        std::lock_guard<std::mutex> lock{fetched_mutex};
+        const auto it = fetched.find(id);
+        if(it != fetched.end())
+            return it->second;
+    }
+
+    auto record = boost::optional<DbRecord>{};
+    try
+    {
+        std::ostringstream out;
+        const auto status = exec::Run(GetCommand("get", db, key), nullptr, &out);
+        auto contents     = out.str();
+        contents.erase(std::find(contents.begin(), contents.end(), '\n'), contents.end());
+
+        if(status == 0 && !contents.empty())
+        {
+            record = DbRecord{key};
+            if(!record->ParseContents(contents))
+            {
+                MIOPEN_LOG_E("Error parsing remote record: " << key << "=" << contents);
+                record = boost::none;
+            }
+            else
+            {
+                MIOPEN_LOG_I2("Remote record found: " << key << "=" << contents);
+            }
+        }
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_W("Remote tuning database is unavailable: " << ex.what());
+    }
+
+    std::lock_guard<std::mutex> lock{fetched_mutex};
+    return fetched.emplace(id, std::move(record)).first->second;
+}
+
+void RemoteDb::Publish(const std::string& db, const DbRecord& record)
+{
+    Publish(db, record.GetKey(), record);
+}
+
+void RemoteDb::Publish(const std::string& db, const std::string& key, const DbRecord& record)
+{
+    if(db.empty() || key.empty() || record.GetSize() == 0)
+        return;
+
+    // Records of some databases, e.g. returned by SQLitePerfDb::Update(), have no key.
+    auto keyed_record = DbRecord{key};
+    keyed_record.map  = record.map;
+
+    std::ostringstream contents;
+    keyed_record.WriteContents(contents);
+    auto line = contents.str().substr(key.size() + 1);
+
+    {
+        std::lock_guard<std::mutex> lock{fetched_mutex};
+        auto& fetched_record = fetched[std::make_pair(db, key)];
+        if(fetched_record)
+            keyed_record.Merge(*fetched_record);
+        fetched_record = std::move(keyed_record);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{queue_mutex};
+        queue.push_back({db, key, std::move(line)});
+        if(!publisher.joinable())
+            publisher = std::thread{[this]() { PublishLoop(); }};
+    }
+    queue_cv.notify_all();
+}
+
+void RemoteDb::Flush()
+{
+    std::unique_lock<std::mutex> lock{queue_mutex};
+    queue_cv.wait(lock, [&]() { return queue.empty() && !publishing; });
+}
+
+void RemoteDb::PublishLoop()
+{
+    std::unique_lock<std::mutex> lock{queue_mutex};
+    while(true)
+    {
+        queue_cv.wait(lock, [&]() { return stopping || !queue.empty(); });
+        if(queue.empty())
+            return;
+
+        auto publication = std::move(queue.front());
+        queue.pop_front();
+        publishing = true;
+        lock.unlock();
+
+        try
+        {
+            std::istringstream in(publication.contents);
+            const auto status = exec::Run(
+                GetCommand("put", publication.db, publication.key), &in, nullptr);
+            if(status != 0)
+                MIOPEN_LOG_W("Unable to publish " << publication.key << " to the remote tuning "
+                                                  << "database, status: " << status);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W("Remote tuning database is unavailable: " << ex.what());
+        }
+
+        lock.lock();
+        publishing = false;
+        queue_cv.notify_all();
+    }
+}
+
+} // namespace miopen
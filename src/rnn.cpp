@@ -26,9 +26,11 @@
 
 #include <miopen/handle.hpp>
 #include <miopen/rnn.hpp>
+#include <miopen/rnn_util.hpp>
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <numeric>
 #include <ostream>
 
@@ -151,25 +153,39 @@ size_t RNNDescriptor::paramsOffsetCalculation(const TensorDescriptor& xDesc,
         inputVectorLen = 0;
     }
 
+    const auto rsize = recSize();
+
+    // The projection matrix of every layer and direction follows the biases
+    if(projSize != 0 && paramID == 2 * nHiddenTensorsPerLayer)
+    {
+        const int bi = dirMode != 0u ? 2 : 1;
+        size_t gates = paramsOffsetCalculation(xDesc, static_cast<int>(nLayers) * bi, 0);
+        if(biasMode == miopenRNNwithBias)
+        {
+            gates += nLayers * 2 * nHiddenTensorsPerLayer * hsize * bi;
+        }
+        return gates + layer * projSize * hsize;
+    }
+
     size_t layerJump = 0;
     if(dirMode != 0u)
     {
         if(layer > 1)
         {
-            layerJump += (inputVectorLen * hsize + hsize * hsize) * nHiddenTensorsPerLayer * 2;
+            layerJump += (inputVectorLen * hsize + hsize * rsize) * nHiddenTensorsPerLayer * 2;
             layerJump +=
-                (hsize * hsize * 2 + hsize * hsize) * nHiddenTensorsPerLayer * (layer / 2 - 1) * 2;
+                (hsize * rsize * 2 + hsize * rsize) * nHiddenTensorsPerLayer * (layer / 2 - 1) * 2;
 
             if(paramID >= nHiddenTensorsPerLayer)
             {
-                layerJump += hsize * hsize * 2 * nHiddenTensorsPerLayer * 2;
-                layerJump += (layer % 2 == 1) ? nHiddenTensorsPerLayer * (hsize * hsize) : 0;
-                layerJump += (hsize * hsize) * (paramID - nHiddenTensorsPerLayer);
+                layerJump += hsize * rsize * 2 * nHiddenTensorsPerLayer * 2;
+                layerJump += (layer % 2 == 1) ? nHiddenTensorsPerLayer * (hsize * rsize) : 0;
+                layerJump += (hsize * rsize) * (paramID - nHiddenTensorsPerLayer);
             }
             else
             {
-                layerJump += (layer % 2 == 1) ? nHiddenTensorsPerLayer * (2 * hsize * hsize) : 0;
-                layerJump += (2 * hsize * hsize) * paramID;
+                layerJump += (layer % 2 == 1) ? nHiddenTensorsPerLayer * (2 * hsize * rsize) : 0;
+                layerJump += (2 * hsize * rsize) * paramID;
             }
         }
         else
@@ -180,8 +196,8 @@ size_t RNNDescriptor::paramsOffsetCalculation(const TensorDescriptor& xDesc,
                 {
                     layerJump += (inputVectorLen * hsize) * nHiddenTensorsPerLayer * 2;
                 }
-                layerJump += (layer == 1) ? nHiddenTensorsPerLayer * (hsize * hsize) : 0;
-                layerJump += (hsize * hsize) * (paramID - nHiddenTensorsPerLayer);
+                layerJump += (layer == 1) ? nHiddenTensorsPerLayer * (hsize * rsize) : 0;
+                layerJump += (hsize * rsize) * (paramID - nHiddenTensorsPerLayer);
             }
             else
             {
@@ -195,9 +211,9 @@ size_t RNNDescriptor::paramsOffsetCalculation(const TensorDescriptor& xDesc,
 
         if(layer > 0)
         {
-            layerJump += (inputVectorLen * hsize + hsize * hsize) * nHiddenTensorsPerLayer;
-            layerJump += (hsize * hsize * 2) * nHiddenTensorsPerLayer * (layer - 1);
-            layerJump += (hsize * hsize) * paramID;
+            layerJump += (inputVectorLen * hsize + hsize * rsize) * nHiddenTensorsPerLayer;
+            layerJump += (hsize * rsize * 2) * nHiddenTensorsPerLayer * (layer - 1);
+            layerJump += (hsize * rsize) * paramID;
         }
         else
         {
@@ -207,7 +223,7 @@ size_t RNNDescriptor::paramsOffsetCalculation(const TensorDescriptor& xDesc,
                 {
                     layerJump += (inputVectorLen * hsize) * nHiddenTensorsPerLayer;
                 }
-                layerJump += (hsize * hsize) * (paramID - nHiddenTensorsPerLayer);
+                layerJump += (hsize * rsize) * (paramID - nHiddenTensorsPerLayer);
             }
             else
             {
@@ -228,27 +244,37 @@ std::vector<int> RNNDescriptor::pTensorLengthsCalculation(const TensorDescriptor
         inputVectorLen = 0;
     }
 
+    const auto rsize = recSize();
     std::vector<int> tdim(2, 0);
 
+    if(projSize != 0 && paramID == 2 * nHiddenTensorsPerLayer)
+    {
+        tdim[0] = projSize;
+        tdim[1] = hsize;
+        return tdim;
+    }
+
     if(dirMode != 0u)
     {
         if(layer > 1) // NOT the input layer
         {
             if(paramID >= nHiddenTensorsPerLayer)
             {
-                tdim[0] = tdim[1] = hsize;
+                tdim[0] = hsize;
+                tdim[1] = rsize;
             }
             else
             {
                 tdim[0] = hsize;
-                tdim[1] = hsize * 2;
+                tdim[1] = rsize * 2;
             }
         }
         else // IS the input layer
         {
             if(paramID >= nHiddenTensorsPerLayer)
             {
-                tdim[0] = tdim[1] = hsize;
+                tdim[0] = hsize;
+                tdim[1] = rsize;
             }
             else
             {
@@ -261,13 +287,15 @@ std::vector<int> RNNDescriptor::pTensorLengthsCalculation(const TensorDescriptor
     {
         if(layer > 0) // NOT the input layer
         {
-            tdim[0] = tdim[1] = hsize;
+            tdim[0] = hsize;
+            tdim[1] = rsize;
         }
         else
         {
             if(paramID >= nHiddenTensorsPerLayer)
             {
-                tdim[0] = tdim[1] = hsize;
+                tdim[0] = hsize;
+                tdim[1] = rsize;
             }
             else
             {
@@ -445,6 +473,20 @@ RNNDescriptor::RNNDescriptor(int hsz,
     }
 }
 
+void RNNDescriptor::SetProjectionSize(const int projSz)
+{
+    if(projSz < 0 || projSz >= static_cast<int>(hsize))
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The projection size must be positive and smaller than the hidden size");
+    }
+    if(projSz != 0 && rnnMode != miopenLSTM)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Only LSTM supports a recurrent projection");
+    }
+    projSize = projSz;
+}
+
 size_t RNNDescriptor::GetWorkspaceSize(Handle& /* handle */,
                                        const int seqLength,
                                        c_array_view<const miopenTensorDescriptor_t> xDesc) const
@@ -460,8 +502,34 @@ size_t RNNDescriptor::GetWorkspaceSize(Handle& /* handle */,
         xDesc.data, xDesc.data + seqLength, 0, [](size_t x, miopenTensorDescriptor_t y) {
             return x + deref(y).GetLengths()[0];
         });
-    auto x = workspaceScale * nLayers * inputBatchLenSum * hsize * typeSize;
-    return size_t(dirMode == miopenRNNbidirection ? 2 * x : x);
+    return GetWorkspaceSizeForRows(inputBatchLenSum);
+}
+
+size_t RNNDescriptor::GetPaddedWorkspaceSize(Handle& /* handle */,
+                                             const TensorDescriptor& xDesc) const
+{
+    if(xDesc.GetType() != dataType)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Data type mismatch between descriptors");
+    }
+    if(xDesc.GetSize() != 3)
+    {
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Padded input must be a [sequence, batch, vector] tensor");
+    }
+    return GetWorkspaceSizeForRows(xDesc.GetLengths()[0] * xDesc.GetLengths()[1]);
+}
+
+size_t RNNDescriptor::GetWorkspaceSizeForRows(std::size_t rows) const
+{
+    // The projected states follow the gates and states of every row
+    auto x = (workspaceScale * hsize + projSize) * nLayers * rows * typeSize;
+    if(dirMode == miopenRNNbidirection)
+        x *= 2;
+    // One grid barrier counter per layer for the persistent kernel, plus room to align them
+    if(algoMode == miopenRNNpersistent)
+        x += (nLayers + 1) * sizeof(uint32_t);
+    return size_t(x);
 }
 
 size_t RNNDescriptor::GetReserveSize(Handle& /* handle */,
@@ -478,16 +546,26 @@ size_t RNNDescriptor::GetReserveSize(Handle& /* handle */,
         xDesc.data, xDesc.data + seqLength, 0, [](size_t x, miopenTensorDescriptor_t y) {
             return x + deref(y).GetLengths()[0];
         });
-    auto x = 2 * workspaceScale * nLayers * inputBatchLenSum * hsize * typeSize;
-    if(algoMode == miopenRNNdefault && rnnMode == miopenLSTM)
+    // Only the input is kept, the backward data pass recomputes the rest
+    if(algoMode == miopenRNNrecompute)
+    {
+        return inputBatchLenSum * xDesc[0].GetLengths()[1] * typeSize;
+    }
+    return GetFullReserveSizeForRows(inputBatchLenSum);
+}
+
+size_t RNNDescriptor::GetFullReserveSizeForRows(std::size_t rows) const
+{
+    auto x = 2 * workspaceScale * nLayers * rows * hsize * typeSize;
+    if(algoMode != miopenRNNfundamental && rnnMode == miopenLSTM)
     {
         x /= 2;
-        x += nLayers * inputBatchLenSum * hsize * typeSize;
+        x += nLayers * rows * hsize * typeSize;
     }
     if(!float_equal(miopen::deref(dropoutDesc).dropout, 0))
     {
-        x += (nLayers - 1) * inputBatchLenSum * hsize * typeSize;
-        x += (nLayers - 1) * inputBatchLenSum * hsize * sizeof(bool);
+        x += (nLayers - 1) * rows * hsize * typeSize;
+        x += (nLayers - 1) * rows * hsize * sizeof(bool);
     }
     return size_t(dirMode == miopenRNNbidirection ? 2 * x : x);
 }
@@ -507,7 +585,7 @@ size_t RNNDescriptor::GetParamsSize(Handle& /* handle */,
 
     int bi  = dirMode == miopenRNNbidirection ? 2 : 1;
     auto sz = nHiddenTensorsPerLayer * hsize * bi *
-              (inputVectorLen + hsize + (nLayers - 1) * (bi + 1) * hsize);
+              (inputVectorLen + recSize() + (nLayers - 1) * (bi + 1) * recSize());
 #if(MIO_RNN_DEBUG == 1)
     fprintf(stderr, "weight size: %lu\n", sz);
 #endif
@@ -515,6 +593,7 @@ size_t RNNDescriptor::GetParamsSize(Handle& /* handle */,
     {
         sz += nLayers * 2 * nHiddenTensorsPerLayer * hsize * bi;
     }
+    sz += nLayers * bi * projSize * hsize;
     return size_t(typeSize * sz);
 }
 
@@ -547,7 +626,7 @@ RNNDescriptor::GetRNNHiddenSuperTensorSize(Handle& /* handle */,
     return size_t(dirMode == miopenRNNbidirection ? 2 * x : x);
 }
 
-void RNNDescriptor::GetParamsDescriptor(Handle& /* handle */,
+void RNNDescriptor::GetParamsDescriptor(Handle& handle,
                                         const TensorDescriptor& xDesc,
                                         TensorDescriptor& wDesc,
                                         miopenDataType_t dtype) const
@@ -565,12 +644,18 @@ void RNNDescriptor::GetParamsDescriptor(Handle& /* handle */,
     // Create weight super tensor descriptor
     int bi = (dirMode == miopenRNNbidirection) ? 2 : 1;
     std::vector<int> weight_lens(2, 0);
-    weight_lens[0] = inputVectorLen + ((nLayers - 1) * (bi + 1) + 1) * hsize;
+    weight_lens[0] = inputVectorLen + ((nLayers - 1) * (bi + 1) + 1) * recSize();
     weight_lens[1] = bi * hsize * nHiddenTensorsPerLayer;
     if(biasMode == miopenRNNwithBias)
     {
         weight_lens[0] += (nLayers * 2);
     }
+    if(projSize != 0)
+    {
+        // The projection matrices do not fill whole rows
+        weight_lens[0] = 1;
+        weight_lens[1] = GetParamsSize(handle, xDesc, dtype) / typeSize;
+    }
 
     wDesc = miopen::TensorDescriptor(dtype, weight_lens.data(), 2);
 }
@@ -587,11 +672,16 @@ std::size_t RNNDescriptor::GetLayerParamSize(Handle& /*handle*/,
     auto inputVectorLen = xDesc.GetLengths()[1]; // input vector size
     inputVectorLen      = (inputMode == miopenRNNskip) ? 0 : inputVectorLen;
 
+    if(projSize != 0 && paramID == 2 * nHiddenTensorsPerLayer)
+    {
+        return size_t(typeSize * projSize * hsize);
+    }
+
     // Assuming Djikstra counting
     if((((dirMode != 0u) && layer <= 1) || ((dirMode == 0u) && layer < 1)))
     {
         if(paramID >= nHiddenTensorsPerLayer)
-            return size_t(typeSize * hsize * hsize);
+            return size_t(typeSize * hsize * recSize());
         else if(isNotRNNskip())
             return size_t(typeSize * inputVectorLen * hsize);
         else
@@ -599,11 +689,11 @@ std::size_t RNNDescriptor::GetLayerParamSize(Handle& /*handle*/,
     }
     else if((dirMode != 0u) && paramID < nHiddenTensorsPerLayer)
     {
-        return size_t(typeSize * hsize * hsize * 2);
+        return size_t(typeSize * hsize * recSize() * 2);
     }
     else
     {
-        return size_t(typeSize * hsize * hsize);
+        return size_t(typeSize * hsize * recSize());
     }
 }
 
@@ -868,6 +958,172 @@ void RNNDescriptor::GetLayerBiasOffset(const int layer,
 #endif
 }
 
+std::size_t RNNDescriptor::GetPackedWeightsStride() const
+{
+    // Multiple of the macro tile of the GEMM kernels
+    const std::size_t tile = 64;
+    const std::size_t bi   = dirMode == miopenRNNbidirection ? 2 : 1;
+    return (nHiddenTensorsPerLayer * hsize * bi + tile - 1) / tile * tile;
+}
+
+void RNNDescriptor::PrepareWeights(Handle& handle,
+                                   const TensorDescriptor& xDesc,
+                                   const TensorDescriptor& wDesc,
+                                   ConstData_t w)
+{
+    if(w == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "weight data cannot be null");
+    }
+    if(wDesc.GetType() != dataType)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Data type mismatch between descriptors");
+    }
+    if(projSize != 0)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Prepared weights do not support projection");
+    }
+    if(wDesc.GetElementSize() * typeSize < GetParamsSize(handle, xDesc, dataType))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "The weight tensor is smaller than the parameters");
+    }
+
+    const int bi         = dirMode == miopenRNNbidirection ? 2 : 1;
+    const int in_h       = inputMode == miopenRNNskip ? 0 : xDesc.GetLengths()[1];
+    const int hy_h       = static_cast<int>(hsize);
+    const int wei_stride = hy_h * bi * static_cast<int>(nHiddenTensorsPerLayer);
+    const int mat_stride = static_cast<int>(GetPackedWeightsStride());
+
+    // The input and hidden matrices of every layer, as the number of inputs of their rows
+    std::vector<int> mat_inputs;
+    for(int li = 0; li < static_cast<int>(nLayers); li++)
+    {
+        mat_inputs.push_back(li == 0 ? in_h : bi * hy_h);
+        mat_inputs.push_back(hy_h);
+    }
+    const int mat_rows = std::accumulate(mat_inputs.begin(), mat_inputs.end(), 0);
+    const int bias_len =
+        biasMode == miopenRNNwithBias ? static_cast<int>(nLayers) * 2 * wei_stride : 0;
+
+    auto packed = std::make_shared<Allocator::ManageDataPtr>(
+        handle.Create((static_cast<std::size_t>(mat_rows) * mat_stride + bias_len) * typeSize));
+
+    // The padding of the rows is read by the GEMMs, so it is zeroed
+    const float zero = 0;
+    SetTensor(handle,
+              miopen::TensorDescriptor(dataType, {std::size_t(mat_rows), std::size_t(mat_stride)}),
+              packed->get(),
+              &zero);
+
+    int offset        = 0;
+    int packed_offset = 0;
+    for(const auto k : mat_inputs)
+    {
+        if(k == 0)
+        {
+            continue;
+        }
+        // Row r of a [wei_stride, k] matrix becomes column r of a [k, mat_stride] one
+        const std::vector<int> lens{k, wei_stride};
+        const std::vector<int> src_strides{1, k};
+        const std::vector<int> dst_strides{mat_stride, 1};
+        const auto src_desc = TensorDescriptor(dataType, lens.data(), src_strides.data(), 2);
+        const auto dst_desc = TensorDescriptor(dataType, lens.data(), dst_strides.data(), 2);
+        miopen::CopyTensor(handle, src_desc, w, dst_desc, packed->get(), offset, packed_offset);
+        offset += k * wei_stride;
+        packed_offset += k * mat_stride;
+    }
+
+    if(bias_len > 0)
+    {
+        const auto bias_desc = miopen::TensorDescriptor(dataType, &bias_len, 1);
+        miopen::CopyTensor(handle, bias_desc, w, bias_desc, packed->get(), offset, packed_offset);
+    }
+
+    preparedWeights       = packed;
+    preparedWeightsSource = w;
+    preparedInputLen      = in_h;
+}
+
+ConstData_t RNNDescriptor::GetPreparedWeights(ConstData_t w, int in_h) const
+{
+    if(preparedWeights == nullptr || projSize != 0 || w != preparedWeightsSource ||
+       in_h != preparedInputLen)
+    {
+        return nullptr;
+    }
+    return preparedWeights->get();
+}
+
+std::size_t RNNDescriptor::GetQuantizedMatricesOffset() const
+{
+    return nLayers * nHiddenTensorsPerLayer * hsize * sizeof(float);
+}
+
+void RNNDescriptor::PrepareQuantizedWeights(Handle& handle,
+                                            const TensorDescriptor& xDesc,
+                                            const TensorDescriptor& wDesc,
+                                            ConstData_t w)
+{
+    if(w == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "weight data cannot be null");
+    }
+    if(wDesc.GetType() != dataType)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Data type mismatch between descriptors");
+    }
+    // Only the persistent kernel dequantizes the weights it keeps in LDS
+    if(algoMode != miopenRNNpersistent || dirMode == miopenRNNbidirection || projSize != 0)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Quantized weights need the unidirectional persistent algorithm without "
+                     "projection");
+    }
+    if(wDesc.GetElementSize() * typeSize < GetParamsSize(handle, xDesc, dataType))
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "The weight tensor is smaller than the parameters");
+    }
+
+    const int in_h       = inputMode == miopenRNNskip ? 0 : xDesc.GetLengths()[1];
+    const int hy_h       = static_cast<int>(hsize);
+    const int wei_stride = hy_h * static_cast<int>(nHiddenTensorsPerLayer);
+    const auto layers    = static_cast<int>(nLayers);
+
+    const std::size_t mat_offset = GetQuantizedMatricesOffset();
+
+    auto quantized = std::make_shared<Allocator::ManageDataPtr>(handle.Create(
+        mat_offset + static_cast<std::size_t>(layers) * wei_stride * hy_h * sizeof(int8_t)));
+
+    for(int li = 0; li < layers; li++)
+    {
+        // The input matrix of the layer precedes its hidden matrix
+        const std::size_t w_offset = static_cast<std::size_t>(in_h + li * 2 * hy_h) * wei_stride;
+        RNNQuantizeWeightsInt8(handle,
+                               dataType,
+                               wei_stride,
+                               hy_h,
+                               w,
+                               w_offset,
+                               quantized->get(),
+                               mat_offset + static_cast<std::size_t>(li) * wei_stride * hy_h,
+                               static_cast<std::size_t>(li) * wei_stride);
+    }
+
+    quantizedWeights       = quantized;
+    quantizedWeightsSource = w;
+    quantizedInputLen      = in_h;
+}
+
+ConstData_t RNNDescriptor::GetQuantizedWeights(ConstData_t w, int in_h) const
+{
+    if(quantizedWeights == nullptr || w != quantizedWeightsSource || in_h != quantizedInputLen)
+    {
+        return nullptr;
+    }
+    return quantizedWeights->get();
+}
+
 std::ostream& operator<<(std::ostream& stream, const RNNDescriptor& r)
 {
     stream << r.hsize << ", ";
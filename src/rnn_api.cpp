@@ -192,6 +192,20 @@ extern "C" miopenStatus_t miopenSetRNNDescriptor_V2(miopenRNNDescriptor_t rnnDes
     });
 }
 
+extern "C" miopenStatus_t miopenSetRNNProjectionSize(miopenRNNDescriptor_t rnnDesc,
+                                                     const int projSize)
+{
+    MIOPEN_LOG_FUNCTION(rnnDesc, projSize);
+    return miopen::try_([&] { miopen::deref(rnnDesc).SetProjectionSize(projSize); });
+}
+
+extern "C" miopenStatus_t miopenGetRNNProjectionSize(miopenRNNDescriptor_t rnnDesc, int* projSize)
+{
+    MIOPEN_LOG_FUNCTION(rnnDesc, projSize);
+    return miopen::try_(
+        [&] { miopen::deref(projSize) = static_cast<int>(miopen::deref(rnnDesc).projSize); });
+}
+
 extern "C" miopenStatus_t miopenGetRNNWorkspaceSize(miopenHandle_t handle,
                                                     const miopenRNNDescriptor_t rnnDesc,
                                                     const int sequenceLen,
@@ -206,6 +220,18 @@ extern "C" miopenStatus_t miopenGetRNNWorkspaceSize(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t miopenGetRNNPaddedWorkspaceSize(miopenHandle_t handle,
+                                                          const miopenRNNDescriptor_t rnnDesc,
+                                                          const miopenTensorDescriptor_t xDesc,
+                                                          size_t* numBytes)
+{
+    MIOPEN_LOG_FUNCTION(handle, rnnDesc, xDesc, numBytes);
+    return miopen::try_([&] {
+        miopen::deref(numBytes) = miopen::deref(rnnDesc).GetPaddedWorkspaceSize(
+            miopen::deref(handle), miopen::deref(xDesc));
+    });
+}
+
 extern "C" miopenStatus_t miopenGetRNNTrainingReserveSize(miopenHandle_t handle,
                                                           miopenRNNDescriptor_t rnnDesc,
                                                           int sequenceLen,
@@ -531,12 +557,6 @@ extern "C" miopenStatus_t miopenRNNForwardTraining(miopenHandle_t handle,
                         reserveSpace,
                         reserveSpaceNumBytes);
 
-    // bfloat16 not supported for rnn operation
-    if(miopen::deref(wDesc).GetType() == miopenBFloat16 ||
-       miopen::deref(hyDesc).GetType() == miopenBFloat16)
-    {
-        return miopenStatusNotImplemented;
-    }
     LogCmdRNN(xDesc, rnnDesc, sequenceLen, ForwardTraining);
 
     return miopen::try_([&] {
@@ -621,7 +641,7 @@ extern "C" miopenStatus_t miopenRNNBackwardData(miopenHandle_t handle,
                         reserveSpace,
                         reserveSpaceNumBytes);
 
-    // bfloat16 not supported for rnn operation
+    // bfloat16 is supported by the forward passes only
     if(miopen::deref(wDesc).GetType() == miopenBFloat16 ||
        miopen::deref(cxDesc).GetType() == miopenBFloat16)
     {
@@ -696,7 +716,7 @@ miopenStatus_t miopenRNNBackwardWeights(miopenHandle_t handle,
                         reserveSpace,
                         reserveSpaceNumBytes);
 
-    // bfloat16 not supported for rnn operation
+    // bfloat16 is supported by the forward passes only
     if(miopen::deref(hxDesc).GetType() == miopenBFloat16 ||
        miopen::deref(dwDesc).GetType() == miopenBFloat16)
     {
@@ -788,3 +808,91 @@ extern "C" miopenStatus_t miopenRNNForwardInference(miopenHandle_t handle,
                                                    workSpaceNumBytes);
     });
 }
+
+extern "C" miopenStatus_t miopenRNNForwardInferencePadded(miopenHandle_t handle,
+                                                          miopenRNNDescriptor_t rnnDesc,
+                                                          const int* seqLengths,
+                                                          const miopenTensorDescriptor_t xDesc,
+                                                          const void* x,
+                                                          const miopenTensorDescriptor_t hxDesc,
+                                                          const void* hx,
+                                                          const miopenTensorDescriptor_t cxDesc,
+                                                          const void* cx,
+                                                          const miopenTensorDescriptor_t wDesc,
+                                                          const void* w,
+                                                          const miopenTensorDescriptor_t yDesc,
+                                                          void* y,
+                                                          const miopenTensorDescriptor_t hyDesc,
+                                                          void* hy,
+                                                          const miopenTensorDescriptor_t cyDesc,
+                                                          void* cy,
+                                                          void* workSpace,
+                                                          size_t workSpaceNumBytes)
+{
+
+    MIOPEN_LOG_FUNCTION(handle,
+                        rnnDesc,
+                        seqLengths,
+                        xDesc,
+                        x,
+                        hxDesc,
+                        hx,
+                        cxDesc,
+                        cx,
+                        wDesc,
+                        w,
+                        yDesc,
+                        y,
+                        hyDesc,
+                        hy,
+                        cyDesc,
+                        cy,
+                        workSpace,
+                        workSpaceNumBytes);
+    return miopen::try_([&] {
+        miopen::deref(rnnDesc).RNNForwardInferencePadded(miopen::deref(handle),
+                                                         seqLengths,
+                                                         miopen::deref(xDesc),
+                                                         DataCast(x),
+                                                         miopen::deref(hxDesc),
+                                                         DataCast(hx),
+                                                         miopen::deref(cxDesc),
+                                                         DataCast(cx),
+                                                         miopen::deref(wDesc),
+                                                         DataCast(w),
+                                                         miopen::deref(yDesc),
+                                                         DataCast(y),
+                                                         miopen::deref(hyDesc),
+                                                         DataCast(hy),
+                                                         miopen::deref(cyDesc),
+                                                         DataCast(cy),
+                                                         DataCast(workSpace),
+                                                         workSpaceNumBytes);
+    });
+}
+
+extern "C" miopenStatus_t miopenRNNPrepareWeights(miopenHandle_t handle,
+                                                  miopenRNNDescriptor_t rnnDesc,
+                                                  const miopenTensorDescriptor_t xDesc,
+                                                  const miopenTensorDescriptor_t wDesc,
+                                                  const void* w)
+{
+    MIOPEN_LOG_FUNCTION(handle, rnnDesc, xDesc, wDesc, w);
+    return miopen::try_([&] {
+        miopen::deref(rnnDesc).PrepareWeights(
+            miopen::deref(handle), miopen::deref(xDesc), miopen::deref(wDesc), DataCast(w));
+    });
+}
+
+extern "C" miopenStatus_t miopenRNNPrepareQuantizedWeights(miopenHandle_t handle,
+                                                           miopenRNNDescriptor_t rnnDesc,
+                                                           const miopenTensorDescriptor_t xDesc,
+                                                           const miopenTensorDescriptor_t wDesc,
+                                                           const void* w)
+{
+    MIOPEN_LOG_FUNCTION(handle, rnnDesc, xDesc, wDesc, w);
+    return miopen::try_([&] {
+        miopen::deref(rnnDesc).PrepareQuantizedWeights(
+            miopen::deref(handle), miopen::deref(xDesc), miopen::deref(wDesc), DataCast(w));
+    });
+}
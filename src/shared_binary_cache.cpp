@@ -0,0 +1,236 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/shared_binary_cache.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/expanduser.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SHARED_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SHARED_CACHE_WAIT_MS)
+
+namespace miopen {
+
+namespace {
+
+constexpr std::time_t abandoned_claim_age = 10 * 60;
+
+/// Writes the file under a temporary name in the same directory and renames it into place,
+/// which is atomic on network file systems as well.
+void Publish(const std::string& data, const boost::filesystem::path& path)
+{
+    boost::filesystem::create_directories(path.parent_path());
+    const auto tmp = path.parent_path() /
+                     boost::filesystem::unique_path(path.filename().string() + ".%%%%-%%%%.tmp");
+    {
+        std::ofstream file{tmp.string(), std::ios::binary | std::ios::trunc};
+        file.write(data.data(), data.size());
+        if(!file)
+            MIOPEN_THROW("Unable to write " + tmp.string());
+    }
+    boost::filesystem::rename(tmp, path);
+}
+
+boost::filesystem::path GetClaimPath(const boost::filesystem::path& index_path)
+{
+    return index_path.string() + ".lock";
+}
+
+} // namespace
+
+SharedBinaryCache::SharedBinaryCache(const boost::filesystem::path& root_) : root(root_) {}
+
+SharedBinaryCache::~SharedBinaryCache()
+{
+    boost::system::error_code ec;
+    for(const auto& claim : claims)
+        boost::filesystem::remove(claim, ec);
+}
+
+SharedBinaryCache* SharedBinaryCache::Get()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static const auto instance = []() -> std::unique_ptr<SharedBinaryCache> {
+        const auto dir = GetStringEnv(MIOPEN_SHARED_CACHE_DIR{});
+        if(dir == nullptr || *dir == '\0')
+            return nullptr;
+        MIOPEN_LOG_I("Shared kernel cache: " << dir);
+        return std::make_unique<SharedBinaryCache>(ExpandUser(dir));
+    }();
+    return instance.get();
+}
+
+boost::filesystem::path SharedBinaryCache::GetIndexPath(const std::string& target,
+                                                        const std::string& name,
+                                                        const std::string& args) const
+{
+    return root / "index" / target / md5(name + ":" + args);
+}
+
+boost::filesystem::path SharedBinaryCache::GetObjectPath(const std::string& hash) const
+{
+    return root / "objects" / hash.substr(0, 2) / hash;
+}
+
+std::string SharedBinaryCache::Read(const boost::filesystem::path& index_path)
+{
+    auto hash = std::string{};
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        const auto it = index.find(index_path.string());
+        if(it != index.end())
+            hash = it->second;
+    }
+
+    try
+    {
+        if(hash.empty())
+        {
+            if(!boost::filesystem::exists(index_path))
+                return {};
+            hash = LoadFile(index_path);
+            hash.erase(std::remove(hash.begin(), hash.end(), '\n'), hash.end());
+            if(hash.size() < 2)
+                return {};
+        }
+
+        const auto object_path = GetObjectPath(hash);
+        if(!boost::filesystem::exists(object_path))
+            return {};
+        auto binary = LoadFile(object_path);
+        if(md5(binary) != hash)
+        {
+            MIOPEN_LOG_W("Corrupted code object in the shared kernel cache: " << object_path);
+            return {};
+        }
+
+        std::lock_guard<std::mutex> lock{mutex};
+        index.emplace(index_path.string(), hash);
+        return binary;
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Shared kernel cache is unavailable: " << ex.what());
+        return {};
+    }
+}
+
+bool SharedBinaryCache::Claim(const boost::filesystem::path& index_path)
+{
+    const auto claim = GetClaimPath(index_path);
+    for(auto attempt = 0; attempt < 2; ++attempt)
+    {
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(claim.parent_path(), ec);
+        // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+        if(auto* const file = std::fopen(claim.string().c_str(), "wx"))
+        {
+            std::fclose(file);
+            std::lock_guard<std::mutex> lock{mutex};
+            claims.insert(claim.string());
+            return true;
+        }
+
+        const auto claimed_at = boost::filesystem::last_write_time(claim, ec);
+        if(ec)
+            continue; // Published and released meanwhile, or the directory is not writable.
+        if(std::time(nullptr) - claimed_at < abandoned_claim_age)
+            return false;
+        MIOPEN_LOG_W("Dropping an abandoned claim of the shared kernel cache: " << claim);
+        boost::filesystem::remove(claim, ec);
+    }
+    return true;
+}
+
+std::string
+SharedBinaryCache::Load(const std::string& target, const std::string& name, const std::string& args)
+{
+    const auto index_path = GetIndexPath(target, name, args);
+    auto binary           = Read(index_path);
+    if(!binary.empty() || Claim(index_path))
+        return binary;
+
+    MIOPEN_LOG_I2("Waiting for another process to build " << name << "; args: " << args);
+    const auto wait     = std::chrono::milliseconds{Value(MIOPEN_SHARED_CACHE_WAIT_MS{}, 30000)};
+    const auto deadline = std::chrono::steady_clock::now() + wait;
+    while(std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+        binary = Read(index_path);
+        if(!binary.empty())
+            return binary;
+        if(!boost::filesystem::exists(GetClaimPath(index_path)))
+            break; // The other process failed to build it.
+    }
+    return Read(index_path);
+}
+
+void SharedBinaryCache::Store(const std::string& target,
+                              const std::string& name,
+                              const std::string& args,
+                              const std::string& binary)
+{
+    const auto index_path = GetIndexPath(target, name, args);
+    const auto hash       = md5(binary);
+    try
+    {
+        const auto object_path = GetObjectPath(hash);
+        if(!boost::filesystem::exists(object_path))
+            Publish(binary, object_path);
+        Publish(hash + "\n", index_path);
+        MIOPEN_LOG_I2("Published to the shared kernel cache: " << name << "; args: " << args);
+
+        std::lock_guard<std::mutex> lock{mutex};
+        index[index_path.string()] = hash;
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to publish to the shared kernel cache: " << ex.what());
+    }
+
+    const auto claim = GetClaimPath(index_path).string();
+    std::lock_guard<std::mutex> lock{mutex};
+    if(claims.erase(claim) != 0)
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(claim, ec);
+    }
+}
+
+} // namespace miopen
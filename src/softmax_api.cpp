@@ -141,9 +141,9 @@ extern "C" miopenStatus_t miopenSoftmaxForward_V2(miopenHandle_t handle,
                                                   miopenSoftmaxMode_t mode)
 {
     MIOPEN_LOG_FUNCTION(alpha, xDesc, x, beta, yDesc, y, algorithm, mode);
-    // check for supported data types
-    if(miopen::deref(xDesc).GetType() == miopenBFloat16 ||
-       miopen::deref(yDesc).GetType() == miopenBFloat16)
+    // check for supported data types, only the online algorithm handles bfloat16
+    if(algorithm != MIOPEN_SOFTMAX_ONLINE && (miopen::deref(xDesc).GetType() == miopenBFloat16 ||
+                                              miopen::deref(yDesc).GetType() == miopenBFloat16))
     {
         return miopenStatusNotImplemented;
     }
@@ -201,3 +201,44 @@ extern "C" miopenStatus_t miopenSoftmaxBackward_V2(miopenHandle_t handle,
                                 0);
     });
 }
+
+extern "C" miopenStatus_t miopenSoftmaxCrossEntropyForward(miopenHandle_t handle,
+                                                           const miopenTensorDescriptor_t xDesc,
+                                                           const void* x,
+                                                           const void* labels,
+                                                           void* losses,
+                                                           const miopenTensorDescriptor_t dxDesc,
+                                                           void* dx)
+{
+    MIOPEN_LOG_FUNCTION(handle, xDesc, x, labels, losses, dxDesc, dx);
+    return miopen::try_([&] {
+        miopen::SoftmaxCrossEntropyForward(
+            miopen::deref(handle),
+            miopen::deref(xDesc),
+            DataCast(x),
+            DataCast(labels),
+            DataCast(losses),
+            dx != nullptr ? miopen::deref(dxDesc) : miopen::deref(xDesc),
+            DataCast(dx));
+    });
+}
+
+extern "C" miopenStatus_t miopenSoftmaxCrossEntropyBackward(miopenHandle_t handle,
+                                                            const miopenTensorDescriptor_t xDesc,
+                                                            const void* x,
+                                                            const void* labels,
+                                                            const void* dlosses,
+                                                            const miopenTensorDescriptor_t dxDesc,
+                                                            void* dx)
+{
+    MIOPEN_LOG_FUNCTION(handle, xDesc, x, labels, dlosses, dxDesc, dx);
+    return miopen::try_([&] {
+        miopen::SoftmaxCrossEntropyBackward(miopen::deref(handle),
+                                            miopen::deref(xDesc),
+                                            DataCast(x),
+                                            DataCast(labels),
+                                            DataCast(dlosses),
+                                            miopen::deref(dxDesc),
+                                            DataCast(dx));
+    });
+}
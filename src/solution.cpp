@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solution.hpp>
+#include <miopen/errors.hpp>
+
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace miopen {
+
+namespace {
+
+constexpr const char* blob_magic = "MIOpenSolution";
+constexpr int blob_version       = 1;
+
+} // namespace
+
+Solution::Solution(solver::Id solver_,
+                   miopenProblemDirection_t direction_,
+                   std::string problem_key_,
+                   float time_,
+                   std::size_t workspace_size_)
+    : solver(solver_),
+      direction(direction_),
+      problem_key(std::move(problem_key_)),
+      time(time_),
+      workspace_size(workspace_size_)
+{
+}
+
+std::string Solution::Save() const
+{
+    // The key goes last, as it is the only field which may contain anything but digits.
+    std::ostringstream ss;
+    ss.precision(9);
+    ss << blob_magic << ' ' << blob_version << ' ' << solver.ToString() << ' '
+       << static_cast<int>(direction) << ' ' << time << ' ' << workspace_size << ' '
+       << problem_key;
+    return ss.str();
+}
+
+Solution Solution::Load(const char* data, std::size_t size)
+{
+    if(data == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Solution blob cannot be nullptr");
+
+    std::istringstream ss{std::string(data, size)};
+    std::string magic;
+    int version = 0;
+    std::string solver_name;
+    int direction = 0;
+    Solution solution;
+    ss >> magic >> version >> solver_name >> direction >> solution.time >>
+        solution.workspace_size;
+    if(!ss || magic != blob_magic)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid solution blob");
+    if(version != blob_version)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Unsupported solution blob version: " + std::to_string(version));
+
+    solution.solver = solver::Id{solver_name};
+    if(!solution.solver.IsValid())
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown solver in the solution blob: " + solver_name);
+    if(direction < miopenProblemDirectionForward ||
+       direction > miopenProblemDirectionBackwardWeights)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid direction in the solution blob");
+    solution.direction = static_cast<miopenProblemDirection_t>(direction);
+
+    ss >> std::ws;
+    std::getline(ss, solution.problem_key, '\0');
+    if(solution.problem_key.empty())
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid solution blob");
+    return solution;
+}
+
+std::ostream& operator<<(std::ostream& stream, const Solution& solution)
+{
+    return stream << solution.solver.ToString() << ", " << solution.time << " ms, "
+                  << solution.workspace_size << " bytes";
+}
+
+} // namespace miopen
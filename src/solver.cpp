@@ -28,6 +28,10 @@
 
 #include <miopen/activ/solvers.hpp>
 #include <miopen/batchnorm/solvers.hpp>
+#include <miopen/norm/solvers.hpp>
+#include <miopen/mha/solvers.hpp>
+#include <miopen/compile_stats.hpp>
+#include <miopen/compile_worker_pool.hpp>
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/db.hpp>
 #include <miopen/solver_id.hpp>
@@ -37,7 +41,11 @@
 #include <miopen/timer.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
+#include <algorithm>
 #include <ostream>
+#include <set>
+#include <string>
+#include <utility>
 
 namespace miopen {
 namespace solver {
@@ -55,27 +63,58 @@ std::ostream& operator<<(std::ostream& os, const KernelInfo& k)
     return os << "} '" << k.comp_options << '\'';
 }
 
-std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels)
+std::vector<Program> PrecompileKernels(const Handle& h,
+                                       const std::vector<KernelInfo>& kernels,
+                                       const std::vector<std::string>& solvers)
 {
     CompileTimer ct;
     std::vector<Program> programs(kernels.size());
+    // Keep all the compile worker processes busy when there are more of them.
+    const auto num_threads = std::max<std::size_t>(Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20),
+                                                   CompileWorkerPool::Get().GetSize());
 
     // clang-format off
     par_for_strided(kernels.size(),
-                    max_threads{Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20)},
+                    max_threads{num_threads},
                     [&](auto i) {
                         const KernelInfo& k = kernels[i];
-                        programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
+                        const CompileStats::SolverScope scope{
+                            i < solvers.size() ? solvers[i] : std::string{}};
+                        programs[i] = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
                     });
     // clang-format on
     ct.Log("PrecompileKernels");
     return programs;
 }
 
+std::vector<std::shared_future<Program>>
+PrecompileKernelsAsync(const Handle& h,
+                       const std::vector<KernelInfo>& kernels,
+                       const std::string& solver)
+{
+    std::vector<std::shared_future<Program>> pending;
+    for(const auto& k : kernels)
+    {
+        if(h.HasProgram(k.kernel_file, k.comp_options))
+            continue;
+        auto build = [&h, k, solver]() {
+            const CompileStats::SolverScope scope{solver};
+            auto program = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
+            h.AddProgram(program, k.kernel_file, k.comp_options);
+            return program;
+        };
+        pending.push_back(h.GetAsyncCompiler().Submit({k.kernel_file, k.comp_options}, build));
+    }
+    return pending;
+}
+
 void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols)
 {
-    // Find all kernels that need to be compiled from the solutions
+    // Find all kernels that need to be compiled from the solutions. Solvers often share
+    // programs, which are built once.
     std::vector<KernelInfo> kernels;
+    std::vector<std::string> solvers;
+    std::set<std::pair<std::string, std::string>> queued;
     for(auto&& sol : sols)
     {
         if(!sol->Succeeded())
@@ -84,12 +123,15 @@ void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>
         {
             if(h.HasProgram(kernel.kernel_file, kernel.comp_options))
                 continue;
+            if(!queued.emplace(kernel.kernel_file, kernel.comp_options).second)
+                continue;
             kernels.push_back(kernel);
+            solvers.push_back(sol->solver_id);
         }
     }
 
     // Precompile the kernels in parallel, but dont add them to the cache
-    std::vector<Program> programs = PrecompileKernels(h, kernels);
+    std::vector<Program> programs = PrecompileKernels(h, kernels, solvers);
 
     // Add programs to the cache
     for(std::size_t i = 0; i < programs.size(); i++)
@@ -113,6 +155,7 @@ struct IdRegistryEntry
     Primitive primitive            = Primitive::Convolution;
     miopenConvAlgorithm_t convAlgo = miopenConvolutionAlgoDirect;
     AnySolver solver               = {};
+    int db_version                 = 1;
 };
 
 struct IdRegistryData
@@ -183,6 +226,12 @@ Primitive Id::GetPrimitive() const
     return it->second.primitive;
 }
 
+int Id::GetDbVersion() const
+{
+    const auto it = IdRegistry().value_to_entry.find(value);
+    return it != IdRegistry().value_to_entry.end() ? it->second.db_version : 1;
+}
+
 miopenConvAlgorithm_t Id::GetAlgo() const
 {
     const auto it = IdRegistry().value_to_entry.find(value);
@@ -245,7 +294,9 @@ RegisterWithSolver(IdRegistryData& registry, uint64_t value, TSolver, miopenConv
 {
     if(!Register(registry, value, SolverDbId(TSolver{}), algo))
         return;
-    registry.value_to_entry.at(value).solver = TSolver{};
+    auto& entry      = registry.value_to_entry.at(value);
+    entry.solver     = TSolver{};
+    entry.db_version = GetSolverDbVersion<TSolver>();
 }
 
 inline SolverRegistrar::SolverRegistrar(IdRegistryData& registry)
@@ -486,6 +537,42 @@ inline SolverRegistrar::SolverRegistrar(IdRegistryData& registry)
     Register(
         registry, ++id, Primitive::Batchnorm, SolverDbId(batchnorm::BnFwdTrainingPerActivation{}));
 
+    RegisterWithSolver(registry, ++id, ConvDepthwiseFwd{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(registry, ++id, ConvDepthwiseBwd{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(registry, ++id, ConvDepthwiseWrw{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(
+        registry, ++id, ConvOclImplicitGemmWrwSplitK{}, miopenConvolutionAlgoImplicitGEMM);
+    RegisterWithSolver(
+        registry, ++id, ConvHipImplicitGemmFwdXdlopsInt8Nhwc{}, miopenConvolutionAlgoImplicitGEMM);
+    RegisterWithSolver(
+        registry, ++id, ConvOclImplicitGemmNdhwcFwd{}, miopenConvolutionAlgoImplicitGEMM);
+    RegisterWithSolver(
+        registry, ++id, ConvOclImplicitGemmNdhwcBwd{}, miopenConvolutionAlgoImplicitGEMM);
+    RegisterWithSolver(
+        registry, ++id, ConvOclImplicitGemmNdhwcWrw{}, miopenConvolutionAlgoImplicitGEMM);
+    RegisterWithSolver(
+        registry, ++id, ConvOclImplicitGemmFwdStreamK{}, miopenConvolutionAlgoImplicitGEMM);
+    RegisterWithSolver(registry, ++id, ConvDirectTiledFwd{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(registry, ++id, ConvDirectTiledBwd{}, miopenConvolutionAlgoDirect);
+    RegisterWithSolver(registry, ++id, ConvDirectTiledWrw{}, miopenConvolutionAlgoDirect);
+    Register(
+        registry, ++id, Primitive::Batchnorm, SolverDbId(batchnorm::BnFwdTrainingSpatialNHWC{}));
+    Register(
+        registry, ++id, Primitive::Batchnorm, SolverDbId(batchnorm::BnBwdTrainingSpatialNHWC{}));
+    Register(registry,
+             ++id,
+             Primitive::Batchnorm,
+             SolverDbId(batchnorm::BnFwdTrainingSpatialWelford{}));
+    Register(registry, ++id, Primitive::Normalization, SolverDbId(norm::NormFwd{}));
+    Register(registry, ++id, Primitive::Normalization, SolverDbId(norm::NormBwd{}));
+    RegisterWithSolver(
+        registry, ++id, ConvCkIgemmFwdV4r4r4DlopsNhwc{}, miopenConvolutionAlgoImplicitGEMM);
+    Register(registry, ++id, Primitive::Attention, SolverDbId(mha::MhaFwd{}));
+    Register(registry, ++id, Primitive::Attention, SolverDbId(mha::MhaBwd{}));
+    RegisterWithSolver(
+        registry, ++id, ConvOclImplicitGemmSubPixelBwd{}, miopenConvolutionAlgoImplicitGEMM);
+    RegisterWithSolver(registry, ++id, ConvHipWinogradFusedXdlops{}, miopenConvolutionAlgoWinograd);
+
     // IMPORTANT: New solvers should be added to the end of the function!
 }
 
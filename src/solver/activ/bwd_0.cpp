@@ -31,7 +31,9 @@
 #include <miopen/visit_float.hpp>
 #include <miopen/kernel_build_params.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace miopen {
 
@@ -101,8 +103,80 @@ bool ActivBwdSolver0::IsApplicable(const ExecutionContext&,
     // clang-format on
 }
 
+PerformanceConfigActiv
+ActivBwdSolver0::GetPerformanceConfig(const ExecutionContext&,
+                                      const miopen::activ::ProblemDescription& problem) const
+{
+    auto config = PerformanceConfigActiv{};
+    config.HeuristicInit(problem);
+    MIOPEN_LOG_I(config);
+    return config;
+}
+
+bool ActivBwdSolver0::IsValidPerformanceConfig(const ExecutionContext&,
+                                               const miopen::activ::ProblemDescription& problem,
+                                               const PerformanceConfigActiv& config) const
+{
+    return config.IsValid(problem);
+}
+
+PerformanceConfigActiv ActivBwdSolver0::Search(const ExecutionContext& context,
+                                               const miopen::activ::ProblemDescription& problem,
+                                               const AnyInvokeParams& invoke_ctx) const
+{
+    // The candidates write to a buffer of their own, dx may alias dy.
+    auto& handle           = context.GetStream();
+    const auto& ctx_params = invoke_ctx.CastTo<miopen::activ::BwdInvokeParams>();
+    const auto& dx_desc    = ctx_params.dx_desc;
+    const auto scratch     = handle.Create((dx_desc.GetElementSpace() + ctx_params.dx_offset) *
+                                       GetTypeSize(dx_desc.GetType()));
+
+    const auto params = [&]() {
+        auto tmp = ctx_params;
+        tmp.dx   = scratch.get();
+        return tmp;
+    }();
+
+    AutoEnableProfiling enableProfiling{handle};
+
+    auto best      = GetPerformanceConfig(context, problem);
+    auto best_time = std::numeric_limits<float>::max();
+    auto config    = PerformanceConfigActiv{true};
+
+    do
+    {
+        if(!config.IsValid(problem))
+            continue;
+
+        try
+        {
+            const auto sln     = GetSolution(context, problem, config);
+            const auto invoker = handle.PrepareInvoker(*sln.invoker_factory,
+                                                       sln.construction_params);
+            invoker(handle, params); // warm-up
+            invoker(handle, params);
+            const auto elapsed = handle.GetKernelTime();
+
+            MIOPEN_LOG_I2(config << ": " << elapsed);
+            if(elapsed < best_time)
+            {
+                best      = config;
+                best_time = elapsed;
+            }
+        }
+        catch(const miopen::Exception& ex)
+        {
+            MIOPEN_LOG_W(config << ": " << ex.what());
+        }
+    } while(config.SetNextValue(problem));
+
+    MIOPEN_LOG_I("Best: " << best << ", " << best_time);
+    return best;
+}
+
 ConvSolution ActivBwdSolver0::GetSolution(const ExecutionContext&,
-                                          const miopen::activ::ProblemDescription& problem) const
+                                          const miopen::activ::ProblemDescription& problem,
+                                          const PerformanceConfigActiv& config) const
 {
     auto result = ConvSolution{miopenStatusSuccess};
 
@@ -124,7 +198,7 @@ ConvSolution ActivBwdSolver0::GetSolution(const ExecutionContext&,
 
     const auto read_len = (packed) ? x_elem_sz : dx_width2D;
 
-    const auto read_unit = (read_len % 4 == 0) ? 4 : (read_len % 2 == 0) ? 2 : 1;
+    const auto read_unit = config.read_unit;
     const auto MAP_RD    = read_len / read_unit;
     const auto READ_TYPE = (read_unit == 1) ? "_FLOAT" : "_FLOAT" + std::to_string(read_unit);
 
@@ -133,6 +207,7 @@ ConvSolution ActivBwdSolver0::GetSolution(const ExecutionContext&,
         {"MIOPEN_READ_UNIT", read_unit},
         {"MIOPEN_READ_TYPE", READ_TYPE},
         {"MIOPEN_NRN_OP_ID", problem.GetActivDesc().GetMode()},
+        {"MIOPEN_NRN_VECS", config.vecs_per_thread},
     };
 
     if(xDesc.GetType() == miopenFloat)
@@ -145,21 +220,38 @@ ConvSolution ActivBwdSolver0::GetSolution(const ExecutionContext&,
         compiler_options.Define("MIOPEN_USE_FP16", 1);
         compiler_options.Define("MIOPEN_USE_FP32", 0);
     }
+    else if(xDesc.GetType() == miopenBFloat16)
+    {
+        compiler_options.Define("MIOPEN_USE_FP16", 0);
+        compiler_options.Define("MIOPEN_USE_FP32", 0);
+        compiler_options.Define("MIOPEN_USE_BFP16", 1);
+        compiler_options.Define("MIOPEN_USE_RNE_BFLOAT16", MIOPEN_USE_RNE_BFLOAT16);
+    }
 
     {
         auto kernel = KernelInfo{};
 
         kernel.comp_options = compiler_options.GenerateFor(kbp::OpenCL{});
         kernel.kernel_file  = "MIOpenNeuron.cl";
-        kernel.kernel_name  = (packed) ? "MIOpenActiveBwdLite" : "MIOpenActiveBwd2DLite";
+        kernel.kernel_name  = (packed) ? "MIOpenActiveBwdPacked" : "MIOpenActiveBwd2DLite";
 
         kernel.l_wk.push_back(256);
         kernel.l_wk.push_back(1);
         kernel.l_wk.push_back(1);
 
-        // first dimension looks similar but for the packed it is a full image for the
-        // non-packed 2D it's width
-        kernel.g_wk.push_back(MAP_RD);
+        // the packed kernel strides over the full image in a grid of the tuned size, the
+        // non-packed 2D one maps the vectors of a row
+        if(packed)
+        {
+            const auto per_group = static_cast<std::size_t>(256) * config.vecs_per_thread;
+            const auto groups    = (config.grid_size != 0) ? config.grid_size
+                                                           : (MAP_RD + per_group - 1) / per_group;
+            kernel.g_wk.push_back(std::max<std::size_t>(groups, 1) * 256);
+        }
+        else
+        {
+            kernel.g_wk.push_back(MAP_RD);
+        }
         kernel.g_wk.push_back(packed ? 1 : height);
         kernel.g_wk.push_back(1);
 
@@ -202,7 +294,8 @@ ConvSolution ActivBwdSolver0::GetSolution(const ExecutionContext&,
                            static_cast<long long>(dxOffset),
                            static_cast<long long>(dyOffset),
                            static_cast<long long>(xOffset),
-                           static_cast<long long>(yOffset));
+                           static_cast<long long>(yOffset),
+                           static_cast<unsigned long long>(x_elem_sz));
                 }
                 else
                 {
@@ -31,6 +31,9 @@
 #include <miopen/visit_float.hpp>
 #include <miopen/kernel_build_params.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace miopen {
 
 namespace solver {
@@ -74,8 +77,81 @@ bool ActivFwdSolver0::IsApplicable(const ExecutionContext&,
     // clang-format on
 }
 
+PerformanceConfigActiv
+ActivFwdSolver0::GetPerformanceConfig(const ExecutionContext&,
+                                      const miopen::activ::ProblemDescription& problem) const
+{
+    auto config = PerformanceConfigActiv{};
+    config.HeuristicInit(problem);
+    MIOPEN_LOG_I(config);
+    return config;
+}
+
+bool ActivFwdSolver0::IsValidPerformanceConfig(const ExecutionContext&,
+                                               const miopen::activ::ProblemDescription& problem,
+                                               const PerformanceConfigActiv& config) const
+{
+    return config.IsValid(problem);
+}
+
+PerformanceConfigActiv ActivFwdSolver0::Search(const ExecutionContext& context,
+                                               const miopen::activ::ProblemDescription& problem,
+                                               const AnyInvokeParams& invoke_ctx) const
+{
+    // The candidates write to a buffer of their own, so that an in-place call does not apply
+    // the activation to its input once per candidate.
+    auto& handle           = context.GetStream();
+    const auto& ctx_params = invoke_ctx.CastTo<miopen::activ::InvokeParams>();
+    const auto& y_desc     = ctx_params.y_desc;
+    const auto scratch     = handle.Create((y_desc.GetElementSpace() + ctx_params.y_offset) *
+                                       GetTypeSize(y_desc.GetType()));
+
+    const auto params = [&]() {
+        auto tmp = ctx_params;
+        tmp.y    = scratch.get();
+        return tmp;
+    }();
+
+    AutoEnableProfiling enableProfiling{handle};
+
+    auto best      = GetPerformanceConfig(context, problem);
+    auto best_time = std::numeric_limits<float>::max();
+    auto config    = PerformanceConfigActiv{true};
+
+    do
+    {
+        if(!config.IsValid(problem))
+            continue;
+
+        try
+        {
+            const auto sln     = GetSolution(context, problem, config);
+            const auto invoker = handle.PrepareInvoker(*sln.invoker_factory,
+                                                       sln.construction_params);
+            invoker(handle, params); // warm-up
+            invoker(handle, params);
+            const auto elapsed = handle.GetKernelTime();
+
+            MIOPEN_LOG_I2(config << ": " << elapsed);
+            if(elapsed < best_time)
+            {
+                best      = config;
+                best_time = elapsed;
+            }
+        }
+        catch(const miopen::Exception& ex)
+        {
+            MIOPEN_LOG_W(config << ": " << ex.what());
+        }
+    } while(config.SetNextValue(problem));
+
+    MIOPEN_LOG_I("Best: " << best << ", " << best_time);
+    return best;
+}
+
 ConvSolution ActivFwdSolver0::GetSolution(const ExecutionContext&,
-                                          const miopen::activ::ProblemDescription& problem) const
+                                          const miopen::activ::ProblemDescription& problem,
+                                          const PerformanceConfigActiv& config) const
 {
     auto result = ConvSolution{miopenStatusSuccess};
 
@@ -92,7 +168,7 @@ ConvSolution ActivFwdSolver0::GetSolution(const ExecutionContext&,
 
     const auto packed    = problem.GetXDesc().IsPacked() && problem.GetYDesc().IsPacked();
     const auto read_len  = (packed) ? x_elem_sz : x_width2D;
-    const auto read_unit = (read_len % 4 == 0) ? 4 : (read_len % 2 == 0) ? 2 : 1;
+    const auto read_unit = config.read_unit;
 
     const auto READ_TYPE = (read_unit == 1) ? "_FLOAT" : "_FLOAT" + std::to_string(read_unit);
 
@@ -101,11 +177,17 @@ ConvSolution ActivFwdSolver0::GetSolution(const ExecutionContext&,
             ? x_lens[0]
             : (x_lens.size() == 3) ? x_lens[1] : (x_lens.size() == 4) ? x_lens[2] : x_lens[3];
 
+    // Elementwise, so NCHW_VECT_C and NHWC int8 tensors are read as they are.
+    const auto is_int8 = (problem.GetXDesc().GetType() == miopenInt8 ||
+                          problem.GetXDesc().GetType() == miopenInt8x4) &&
+                         problem.GetYDesc().GetType() == problem.GetXDesc().GetType();
+
     auto build_params = KernelBuildParameters{
         {"LITE"},
         {"MIOPEN_READ_UNIT", read_unit},
         {"MIOPEN_READ_TYPE", READ_TYPE},
         {"MIOPEN_NRN_OP_ID", problem.GetActivDesc().GetMode()},
+        {"MIOPEN_NRN_VECS", config.vecs_per_thread},
     };
 
     if(problem.GetXDesc().GetType() == miopenFloat)
@@ -118,6 +200,19 @@ ConvSolution ActivFwdSolver0::GetSolution(const ExecutionContext&,
         build_params.Define("MIOPEN_USE_FP16", 1);
         build_params.Define("MIOPEN_USE_FP32", 0);
     }
+    else if(problem.GetXDesc().GetType() == miopenBFloat16)
+    {
+        build_params.Define("MIOPEN_USE_FP16", 0);
+        build_params.Define("MIOPEN_USE_FP32", 0);
+        build_params.Define("MIOPEN_USE_BFP16", 1);
+        build_params.Define("MIOPEN_USE_RNE_BFLOAT16", MIOPEN_USE_RNE_BFLOAT16);
+    }
+    else if(is_int8)
+    {
+        build_params.Define("MIOPEN_USE_FP16", 0);
+        build_params.Define("MIOPEN_USE_FP32", 0);
+        build_params.Define("MIOPEN_USE_INT8", 1);
+    }
     else
     {
         MIOPEN_LOG_E("Unsupported data types configuration: "
@@ -136,12 +231,22 @@ ConvSolution ActivFwdSolver0::GetSolution(const ExecutionContext&,
 
         const auto MAP_RD = read_len / read_unit;
 
-        kernel_info.g_wk.push_back(MAP_RD);
+        if(packed)
+        {
+            const auto per_group = static_cast<std::size_t>(256) * config.vecs_per_thread;
+            const auto groups    = (config.grid_size != 0) ? config.grid_size
+                                                           : (MAP_RD + per_group - 1) / per_group;
+            kernel_info.g_wk.push_back(std::max<std::size_t>(groups, 1) * 256);
+        }
+        else
+        {
+            kernel_info.g_wk.push_back(MAP_RD);
+        }
         kernel_info.g_wk.push_back(packed ? 1 : height);
         kernel_info.g_wk.push_back(1);
 
         kernel_info.kernel_file = "MIOpenNeuron.cl";
-        kernel_info.kernel_name = (packed) ? "MIOpenActiveFwdLite" : "MIOpenActiveFwd2DLite";
+        kernel_info.kernel_name = (packed) ? "MIOpenActiveFwdPacked" : "MIOpenActiveFwd2DLite";
 
         result.construction_params.push_back(kernel_info);
     }
@@ -151,11 +256,7 @@ ConvSolution ActivFwdSolver0::GetSolution(const ExecutionContext&,
             decltype(auto) kernel = handle.Run(kernels.front());
             decltype(auto) params = raw_params.CastTo<miopen::activ::InvokeParams>();
 
-            visit_float(params.x_desc.GetType(), [&](auto as_float) {
-                const auto alpha = as_float(params.alpha);
-                const auto beta  = as_float(params.beta);
-                const auto gamma = as_float(params.gamma);
-
+            const auto run = [&](auto gamma, auto beta, auto alpha) {
                 if(packed)
                 {
                     kernel(params.x,
@@ -164,7 +265,8 @@ ConvSolution ActivFwdSolver0::GetSolution(const ExecutionContext&,
                            beta,
                            alpha,
                            static_cast<long long>(params.x_offset),
-                           static_cast<long long>(params.y_offset));
+                           static_cast<long long>(params.y_offset),
+                           static_cast<unsigned long long>(x_elem_sz));
                 }
                 else
                 {
@@ -197,6 +299,18 @@ ConvSolution ActivFwdSolver0::GetSolution(const ExecutionContext&,
                            x_stride2D,
                            y_stride2D);
                 }
+            };
+
+            // The int8 kernels take the parameters as float.
+            if(is_int8)
+            {
+                run(static_cast<float>(params.gamma),
+                    static_cast<float>(params.beta),
+                    static_cast<float>(params.alpha));
+                return;
+            }
+            visit_float(params.x_desc.GetType(), [&](auto as_float) {
+                run(as_float(params.gamma), as_float(params.beta), as_float(params.alpha));
             });
         };
     };
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/activ/solvers.hpp>
+
+#include <miopen/activ/problem_description.hpp>
+
+#include <algorithm>
+
+namespace miopen {
+
+namespace solver {
+
+namespace activ {
+
+namespace {
+
+bool IsPowerOfTwoIn(int v, int lo, int hi)
+{
+    return lo <= v && v <= hi && (v & (v - 1)) == 0;
+}
+
+} // namespace
+
+void PerformanceConfigActiv::HeuristicInit(const miopen::activ::ProblemDescription& problem)
+{
+    const auto& xDesc = problem.GetXDesc();
+
+    if(!problem.IsPacked())
+    {
+        const auto width = xDesc.GetLengths().back();
+        read_unit        = (width % 4 == 0) ? 4 : (width % 2 == 0) ? 2 : 1;
+        vecs_per_thread  = 1;
+        grid_size        = 0;
+        return;
+    }
+
+    // 128-bit loads (64-bit for int8, the widest vector the kernel reads), the elements past the
+    // last full vector are handled one by one.
+    read_unit = std::min(8, 16 / static_cast<int>(GetTypeSize(xDesc.GetType())));
+
+    // More vectors per work-item in flight only once there are plenty of work-groups anyway.
+    const auto vectors = xDesc.GetElementSize() / read_unit;
+    vecs_per_thread    = 1;
+    while(vecs_per_thread < 4 &&
+          vectors >= static_cast<std::size_t>(256) * vecs_per_thread * 2 * 1024)
+        vecs_per_thread *= 2;
+    grid_size = 0;
+}
+
+bool PerformanceConfigActiv::IsValidValue() const
+{
+    return IsPowerOfTwoIn(read_unit, 1, 8) && IsPowerOfTwoIn(vecs_per_thread, 1, 8) &&
+           (grid_size == 0 || IsPowerOfTwoIn(grid_size, 64, 4096));
+}
+
+bool PerformanceConfigActiv::SetNextValue(const miopen::activ::ProblemDescription&)
+{
+    // Increment with wrap-around.
+    do
+    {
+        grid_size = (grid_size == 0) ? 64 : grid_size * 2;
+        if(grid_size <= 4096)
+            break;
+        grid_size = 0;
+        if((vecs_per_thread *= 2) <= 8)
+            break;
+        vecs_per_thread = 1;
+        if((read_unit *= 2) <= 8)
+            break;
+        read_unit = 1;
+        return false;
+    } while(false);
+    return true;
+}
+
+bool PerformanceConfigActiv::IsValid(const miopen::activ::ProblemDescription& problem) const
+{
+    if(!IsValidValue())
+        return false;
+
+    const auto& xDesc = problem.GetXDesc();
+    if(read_unit * GetTypeSize(xDesc.GetType()) > 16)
+        return false;
+
+    if(problem.IsPacked())
+    {
+        // A grid larger than the tensor would only add idle work-groups.
+        const auto vectors = xDesc.GetElementSize() / read_unit;
+        return vectors >= static_cast<std::size_t>(256) * vecs_per_thread * grid_size;
+    }
+
+    // The 2D kernel maps a work-item to a vector of a row.
+    return xDesc.GetLengths().back() % read_unit == 0 && vecs_per_thread == 1 && grid_size == 0;
+}
+
+bool PerformanceConfigActiv::operator==(const PerformanceConfigActiv& other) const
+{
+    // clang-format off
+    return read_unit == other.read_unit
+        && vecs_per_thread == other.vecs_per_thread
+        && grid_size == other.grid_size;
+    // clang-format on
+}
+
+} // namespace activ
+
+} // namespace solver
+
+} // namespace miopen
@@ -42,7 +42,7 @@ bool BnBwdTrainingSpatialMultiple::IsApplicable(
     const ExecutionContext& context, const miopen::batchnorm::ProblemDescription& problem) const
 {
     if(problem.GetDirection() != miopen::batchnorm::Direction::Backward ||
-       problem.GetMode() != miopenBNSpatial)
+       problem.GetMode() != miopenBNSpatial || problem.IsLayoutNHWC())
         return false;
 
     return !BnBwdTrainingSpatialSingle{}.IsApplicable(context, problem);
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/batchnorm/solvers.hpp>
+
+#include <miopen/batchnorm/invoke_params.hpp>
+#include <miopen/batchnorm/problem_description.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/kernel_build_params.hpp>
+
+#include <limits>
+
+namespace miopen {
+
+namespace solver {
+
+namespace batchnorm {
+
+bool BnBwdTrainingSpatialNHWC::IsApplicable(
+    const ExecutionContext&, const miopen::batchnorm::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::batchnorm::Direction::Backward ||
+       problem.GetMode() != miopenBNSpatial || !problem.IsLayoutNHWC())
+        return false;
+
+    const auto& xDesc = problem.GetXDesc();
+    if(!xDesc.IsPacked() || problem.GetDYDesc().GetStrides() != xDesc.GetStrides() ||
+       problem.GetDXDesc().GetStrides() != xDesc.GetStrides())
+        return false;
+    if(xDesc.GetElementSize() > std::numeric_limits<uint32_t>::max())
+        return false;
+
+    const auto ptype = problem.GetScaleBiasDiffDesc().GetType();
+    return (xDesc.GetType() == miopenFloat && ptype == miopenFloat) ||
+           (xDesc.GetType() == miopenHalf && (ptype == miopenHalf || ptype == miopenFloat)) ||
+           (xDesc.GetType() == miopenBFloat16 && ptype == miopenFloat);
+}
+
+ConvSolution
+BnBwdTrainingSpatialNHWC::GetSolution(const ExecutionContext&,
+                                      const miopen::batchnorm::ProblemDescription& problem) const
+{
+    const bool bfp16parm   = problem.GetXDesc().GetType() == miopenHalf &&
+                             problem.GetScaleBiasDiffDesc().GetType() == miopenHalf;
+    const bool bfpmixparm  = problem.GetXDesc().GetType() == miopenHalf &&
+                             problem.GetScaleBiasDiffDesc().GetType() == miopenFloat;
+    const bool bbfpmixparm = problem.GetXDesc().GetType() == miopenBFloat16;
+    const bool bfp32parm   = !bfp16parm && !bfpmixparm && !bbfpmixparm;
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(problem.GetXDesc().GetLengths());
+
+    const std::size_t in_nhw = static_cast<std::size_t>(n) * h * w;
+    const auto geo           = BnNHWCGeometry{static_cast<std::size_t>(c), in_nhw};
+    const auto useSaved      = problem.UseSaved();
+
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    {
+        auto kernel = KernelInfo{};
+
+        kernel.kernel_name = "MIOpenBatchNormBwdSpatialNHWC";
+        kernel.kernel_file = "MIOpenBatchNormSpatialNHWC.cl";
+
+        const auto build_params = KernelBuildParameters{
+            {"MIOPEN_USE_FP16", static_cast<int>(bfp16parm)},
+            {"MIOPEN_USE_FP32", static_cast<int>(bfp32parm)},
+            {"MIOPEN_USE_FPMIX", static_cast<int>(bfpmixparm)},
+            {"MIOPEN_USE_BFPMIX", static_cast<int>(bbfpmixparm)},
+            {"MIO_BN_USESAVED", static_cast<int>(useSaved)},
+            {"MIO_BN_C", c},
+            {"MIO_BN_NHW", in_nhw},
+            {"MIO_BN_VEC", geo.vec},
+            {"MIO_BN_NSEG", geo.nseg},
+            {"MIO_BN_SEGROWS", geo.segrows},
+            {"MIO_BN_GRP0", geo.grp0},
+            {"MIO_BN_GRP1", geo.grp1},
+            {"MIO_BN_GRP2", 1},
+        };
+
+        kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{});
+
+        kernel.l_wk.push_back(geo.grp0);
+        kernel.l_wk.push_back(geo.grp1);
+        kernel.l_wk.push_back(1);
+
+        kernel.g_wk.push_back(geo.cgroups * geo.grp0);
+        kernel.g_wk.push_back(geo.nseg * geo.grp1);
+        kernel.g_wk.push_back(1);
+
+        if(geo.nseg == 1)
+        {
+            result.construction_params.push_back(kernel);
+        }
+        else
+        {
+            auto copy = kernel;
+            if(!useSaved)
+            {
+                copy.kernel_name = kernel.kernel_name + "MeanVariance";
+                result.construction_params.push_back(copy);
+
+                copy.kernel_name = kernel.kernel_name + "FinalMeanVariance";
+                result.construction_params.push_back(copy);
+            }
+
+            copy.kernel_name = kernel.kernel_name + "DScaleDBias";
+            result.construction_params.push_back(copy);
+
+            copy.kernel_name = kernel.kernel_name + "FinalDScaleDBias";
+            result.construction_params.push_back(copy);
+
+            copy.kernel_name = kernel.kernel_name + "DX";
+            result.construction_params.push_back(copy);
+        }
+    }
+
+    const auto single = (geo.nseg == 1);
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::batchnorm::BwdInvokeParams>();
+
+            if(single)
+            {
+                handle_.Run(kernels.front())(params.x,
+                                             params.dy,
+                                             params.dx,
+                                             params.bnScale,
+                                             params.resultBnScaleDiff,
+                                             params.resultBnBiasDiff,
+                                             params.epsilon,
+                                             params.savedMean,
+                                             params.savedInvVariance);
+                return;
+            }
+
+            float ctime = 0.;
+            auto next   = kernels.begin();
+            if(!useSaved)
+            {
+                handle_.Run(*next++)(params.x, params.dx);
+                profileSequence(handle_, 0, &ctime);
+
+                handle_.Run(*next++)(params.dx, params.epsilon);
+                profileSequence(handle_, 1, &ctime);
+            }
+
+            handle_.Run(*next++)(
+                params.x, params.dy, params.dx, params.savedMean, params.savedInvVariance);
+            profileSequence(handle_, useSaved ? 0 : 1, &ctime);
+
+            handle_.Run(*next++)(params.dx, params.resultBnScaleDiff, params.resultBnBiasDiff);
+            profileSequence(handle_, 1, &ctime);
+
+            handle_.Run(*next)(params.x,
+                               params.dy,
+                               params.dx,
+                               params.bnScale,
+                               params.savedMean,
+                               params.savedInvVariance);
+            profileSequence(handle_, 2, &ctime);
+        };
+    };
+
+    return result;
+}
+
+} // namespace batchnorm
+
+} // namespace solver
+
+} // namespace miopen
@@ -41,6 +41,9 @@ namespace batchnorm {
 bool BnFwdTrainingPerActivation::IsApplicable(
     const ExecutionContext&, const miopen::batchnorm::ProblemDescription& problem) const
 {
+    if(problem.IsLayoutNHWC())
+        return false;
+
     return problem.GetDirection() == miopen::batchnorm::Direction::ForwardTraining ||
            problem.GetMode() == miopenBNPerActivation;
 }
@@ -44,7 +44,7 @@ bool BnFwdTrainingSpatialMultiple::IsApplicable(
     const ExecutionContext& context, const miopen::batchnorm::ProblemDescription& problem) const
 {
     if(problem.GetDirection() != miopen::batchnorm::Direction::ForwardTraining ||
-       problem.GetMode() != miopenBNSpatial)
+       problem.GetMode() != miopenBNSpatial || problem.IsLayoutNHWC())
         return false;
 
     return !BnFwdTrainingSpatialSingle{}.IsApplicable(context, problem);
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/batchnorm/solvers.hpp>
+
+#include <miopen/batchnorm/invoke_params.hpp>
+#include <miopen/batchnorm/problem_description.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/kernel_build_params.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace miopen {
+
+namespace solver {
+
+namespace batchnorm {
+
+BnNHWCGeometry::BnNHWCGeometry(std::size_t c, std::size_t nhw)
+{
+    vec = (c % 4 == 0) ? 4 : (c % 2 == 0) ? 2 : 1;
+
+    const auto cvec = c / vec;
+    grp0            = 1;
+    while(grp0 < cvec && grp0 < 64)
+        grp0 *= 2;
+    grp1    = 256 / grp0;
+    cgroups = (cvec + grp0 - 1) / grp0;
+
+    // Split the rows once a work-group per channel slice would leave most of the device idle.
+    // A segment keeps at least 8 rows per work-item, which also leaves room for the float
+    // stash of the reduction at its start.
+    const auto min_rows = grp1 * 8;
+    const auto target   = std::max<std::size_t>(1, 256 / cgroups);
+    nseg                = std::max<std::size_t>(1, std::min(nhw / min_rows, target));
+    segrows             = (nseg == 1) ? nhw : (nhw / nseg) / 8 * 8;
+}
+
+bool BnFwdTrainingSpatialNHWC::IsApplicable(
+    const ExecutionContext&, const miopen::batchnorm::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::batchnorm::Direction::ForwardTraining ||
+       problem.GetMode() != miopenBNSpatial || !problem.IsLayoutNHWC())
+        return false;
+
+    const auto& xDesc = problem.GetXDesc();
+    if(!xDesc.IsPacked() || problem.GetYDesc().GetStrides() != xDesc.GetStrides())
+        return false;
+    if(xDesc.GetElementSize() > std::numeric_limits<uint32_t>::max())
+        return false;
+
+    const auto ptype = problem.GetBnScaleBiasMeanVarDesc().GetType();
+    return (xDesc.GetType() == miopenFloat && ptype == miopenFloat) ||
+           (xDesc.GetType() == miopenHalf && (ptype == miopenHalf || ptype == miopenFloat)) ||
+           (xDesc.GetType() == miopenBFloat16 && ptype == miopenFloat);
+}
+
+ConvSolution
+BnFwdTrainingSpatialNHWC::GetSolution(const ExecutionContext&,
+                                      const miopen::batchnorm::ProblemDescription& problem) const
+{
+    const bool bfp16parm   = problem.GetXDesc().GetType() == miopenHalf &&
+                             problem.GetBnScaleBiasMeanVarDesc().GetType() == miopenHalf;
+    const bool bfpmixparm  = problem.GetXDesc().GetType() == miopenHalf &&
+                             problem.GetBnScaleBiasMeanVarDesc().GetType() == miopenFloat;
+    const bool bbfpmixparm = problem.GetXDesc().GetType() == miopenBFloat16;
+    const bool bfp32parm   = !bfp16parm && !bfpmixparm && !bbfpmixparm;
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(problem.GetXDesc().GetLengths());
+
+    const std::size_t in_nhw = static_cast<std::size_t>(n) * h * w;
+    const auto geo           = BnNHWCGeometry{static_cast<std::size_t>(c), in_nhw};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    {
+        auto kernel = KernelInfo{};
+
+        kernel.kernel_name = "MIOpenBatchNormFwdTrainSpatialNHWC";
+        kernel.kernel_file = "MIOpenBatchNormSpatialNHWC.cl";
+
+        const auto build_params = KernelBuildParameters{
+            {"MIOPEN_USE_FP16", static_cast<int>(bfp16parm)},
+            {"MIOPEN_USE_FP32", static_cast<int>(bfp32parm)},
+            {"MIOPEN_USE_FPMIX", static_cast<int>(bfpmixparm)},
+            {"MIOPEN_USE_BFPMIX", static_cast<int>(bbfpmixparm)},
+            {"MIO_SAVE_MEAN_VARIANCE", static_cast<int>(problem.GetResultSave())},
+            {"MIO_RUNNING_RESULT", static_cast<int>(problem.GetResultRunning())},
+            {"MIO_BN_C", c},
+            {"MIO_BN_NHW", in_nhw},
+            {"MIO_BN_VEC", geo.vec},
+            {"MIO_BN_NSEG", geo.nseg},
+            {"MIO_BN_SEGROWS", geo.segrows},
+            {"MIO_BN_GRP0", geo.grp0},
+            {"MIO_BN_GRP1", geo.grp1},
+            {"MIO_BN_GRP2", 1},
+        };
+
+        kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{});
+
+        kernel.l_wk.push_back(geo.grp0);
+        kernel.l_wk.push_back(geo.grp1);
+        kernel.l_wk.push_back(1);
+
+        kernel.g_wk.push_back(geo.cgroups * geo.grp0);
+        kernel.g_wk.push_back(geo.nseg * geo.grp1);
+        kernel.g_wk.push_back(1);
+
+        if(geo.nseg == 1)
+        {
+            result.construction_params.push_back(kernel);
+        }
+        else
+        {
+            auto copy        = kernel;
+            copy.kernel_name = kernel.kernel_name + "MeanVariance";
+            result.construction_params.push_back(copy);
+
+            copy.kernel_name = kernel.kernel_name + "FinalMeanVariance";
+            result.construction_params.push_back(copy);
+
+            copy.kernel_name = kernel.kernel_name + "Norm";
+            result.construction_params.push_back(copy);
+        }
+    }
+
+    const auto single = (geo.nseg == 1);
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::batchnorm::InvokeParams>();
+
+            if(single)
+            {
+                handle_.Run(kernels.front())(params.x,
+                                             params.y,
+                                             params.bnScale,
+                                             params.bnBias,
+                                             params.expAvgFactor,
+                                             params.resultRunningMean,
+                                             params.resultRunningVariance,
+                                             params.epsilon,
+                                             params.resultSaveMean,
+                                             params.resultSaveInvVariance);
+                return;
+            }
+
+            float ctime = 0.;
+            handle_.Run(kernels[0])(params.x, params.y);
+            profileSequence(handle_, 0, &ctime);
+
+            handle_.Run(kernels[1])(params.y,
+                                    params.expAvgFactor,
+                                    params.resultRunningMean,
+                                    params.resultRunningVariance,
+                                    params.epsilon,
+                                    params.resultSaveMean,
+                                    params.resultSaveInvVariance);
+            profileSequence(handle_, 1, &ctime);
+
+            handle_.Run(kernels[2])(params.x, params.y, params.bnScale, params.bnBias);
+            profileSequence(handle_, 2, &ctime);
+        };
+    };
+
+    return result;
+}
+
+} // namespace batchnorm
+
+} // namespace solver
+
+} // namespace miopen
@@ -43,7 +43,7 @@ bool BnFwdTrainingSpatialSingle::IsApplicable(
     const ExecutionContext&, const miopen::batchnorm::ProblemDescription& problem) const
 {
     if(problem.GetDirection() != miopen::batchnorm::Direction::ForwardTraining ||
-       problem.GetMode() != miopenBNSpatial)
+       problem.GetMode() != miopenBNSpatial || problem.IsLayoutNHWC())
         return false;
 
     int n, c, h, w;
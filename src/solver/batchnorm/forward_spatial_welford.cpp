@@ -0,0 +1,355 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/batchnorm/solvers.hpp>
+
+#include <miopen/batchnorm/invoke_params.hpp>
+#include <miopen/batchnorm/problem_description.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/env.hpp>
+#include <miopen/kernel_build_params.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_BN_FWD_TRAINING_WELFORD)
+
+namespace miopen {
+
+namespace solver {
+
+namespace batchnorm {
+
+namespace {
+
+/// The counters at the end of the workspace of the multi-block variant have to start at zero.
+/// The kernel resets them after use, so the buffer stays with the invoker and is cleared once.
+struct WelfordWorkspace
+{
+    Data_t Get(const Handle& handle, std::size_t size)
+    {
+        if(!buffer)
+        {
+            const MemoryCategoryScope memory_scope{MemoryCategory::Constants};
+            buffer = handle.Create(size);
+            handle.ZeroAsync(buffer.get(), size);
+        }
+        return buffer.get();
+    }
+
+    private:
+    Allocator::ManageDataPtr buffer;
+};
+
+bool IsPowerOfTwoIn(int v, int lo, int hi)
+{
+    return lo <= v && v <= hi && (v & (v - 1)) == 0;
+}
+
+} // namespace
+
+void PerformanceConfigBnFwdTrainingWelford::HeuristicInit(
+    const miopen::batchnorm::ProblemDescription& problem)
+{
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(problem.GetXDesc().GetLengths());
+
+    const std::size_t in_cstride = static_cast<std::size_t>(h) * w;
+
+    elems_per_thread   = (in_cstride % 4 == 0) ? 4 : (in_cstride % 2 == 0) ? 2 : 1;
+    const auto vectors = n * in_cstride / elems_per_thread;
+
+    grp_size = 64;
+    while(grp_size < 256 && static_cast<std::size_t>(grp_size) < vectors)
+        grp_size *= 2;
+
+    // Add work-groups to a channel while the device has room for them and each still loads
+    // at least 8 vectors per work-item.
+    blocks_per_channel = 1;
+    while(blocks_per_channel < 64 && c * blocks_per_channel < 256 &&
+          vectors >= static_cast<std::size_t>(2 * blocks_per_channel * grp_size * 8))
+        blocks_per_channel *= 2;
+}
+
+bool PerformanceConfigBnFwdTrainingWelford::IsValidValue() const
+{
+    return IsPowerOfTwoIn(grp_size, 64, 1024) && IsPowerOfTwoIn(elems_per_thread, 1, 4) &&
+           IsPowerOfTwoIn(blocks_per_channel, 1, 64);
+}
+
+bool PerformanceConfigBnFwdTrainingWelford::SetNextValue(
+    const miopen::batchnorm::ProblemDescription&)
+{
+    // Increment with wrap-around.
+    do
+    {
+        if((blocks_per_channel *= 2) <= 64)
+            break;
+        blocks_per_channel = 1;
+        if((elems_per_thread *= 2) <= 4)
+            break;
+        elems_per_thread = 1;
+        if((grp_size *= 2) <= 1024)
+            break;
+        grp_size = 64;
+        return false;
+    } while(false);
+    return true;
+}
+
+bool PerformanceConfigBnFwdTrainingWelford::IsValid(
+    const miopen::batchnorm::ProblemDescription& problem) const
+{
+    if(!IsValidValue())
+        return false;
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(problem.GetXDesc().GetLengths());
+
+    const std::size_t in_cstride = static_cast<std::size_t>(h) * w;
+    if(in_cstride % elems_per_thread != 0)
+        return false;
+
+    // Every work-group of a channel has to get some of its vectors.
+    const auto vectors = n * in_cstride / elems_per_thread;
+    return vectors >= static_cast<std::size_t>(grp_size) * (blocks_per_channel - 1) + 1;
+}
+
+bool PerformanceConfigBnFwdTrainingWelford::operator==(
+    const PerformanceConfigBnFwdTrainingWelford& other) const
+{
+    // clang-format off
+    return grp_size == other.grp_size
+        && elems_per_thread == other.elems_per_thread
+        && blocks_per_channel == other.blocks_per_channel;
+    // clang-format on
+}
+
+bool BnFwdTrainingSpatialWelford::IsApplicable(
+    const ExecutionContext& context, const miopen::batchnorm::ProblemDescription& problem) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_BN_FWD_TRAINING_WELFORD{}))
+        return false;
+    if(problem.GetDirection() != miopen::batchnorm::Direction::ForwardTraining ||
+       problem.GetMode() != miopenBNSpatial || problem.IsLayoutNHWC())
+        return false;
+
+    // The small problems are left to the single-kernel variants, which are as fast on them.
+    if(BnFwdTrainingSpatialSingle{}.IsApplicable(context, problem))
+        return false;
+
+    const auto& xDesc = problem.GetXDesc();
+    if(!xDesc.IsPacked() || problem.GetYDesc().GetStrides() != xDesc.GetStrides())
+        return false;
+    if(xDesc.GetElementSize() > std::numeric_limits<uint32_t>::max())
+        return false;
+
+    const auto ptype = problem.GetBnScaleBiasMeanVarDesc().GetType();
+    return (xDesc.GetType() == miopenFloat && ptype == miopenFloat) ||
+           (xDesc.GetType() == miopenHalf && (ptype == miopenHalf || ptype == miopenFloat));
+}
+
+PerformanceConfigBnFwdTrainingWelford BnFwdTrainingSpatialWelford::GetPerformanceConfig(
+    const ExecutionContext&, const miopen::batchnorm::ProblemDescription& problem) const
+{
+    auto config = PerformanceConfigBnFwdTrainingWelford{};
+    config.HeuristicInit(problem);
+    MIOPEN_LOG_I(config);
+    return config;
+}
+
+bool BnFwdTrainingSpatialWelford::IsValidPerformanceConfig(
+    const ExecutionContext&,
+    const miopen::batchnorm::ProblemDescription& problem,
+    const PerformanceConfigBnFwdTrainingWelford& config) const
+{
+    return config.IsValid(problem);
+}
+
+PerformanceConfigBnFwdTrainingWelford
+BnFwdTrainingSpatialWelford::Search(const ExecutionContext& context,
+                                    const miopen::batchnorm::ProblemDescription& problem,
+                                    const AnyInvokeParams& invoke_ctx) const
+{
+    // The candidates are built without the running and saved statistics, so that timing them
+    // on the buffers of the call leaves these results to the solution finally chosen.
+    const auto tuning_problem =
+        miopen::batchnorm::ProblemDescription{miopen::batchnorm::Direction::ForwardTraining,
+                                              problem.GetMode(),
+                                              problem.GetXDesc(),
+                                              problem.GetYDesc(),
+                                              problem.GetBnScaleBiasMeanVarDesc(),
+                                              problem.GetExpAvgFactor(),
+                                              problem.GetEpsilon(),
+                                              false,
+                                              false};
+
+    auto& handle = context.GetStream();
+    AutoEnableProfiling enableProfiling{handle};
+
+    auto best      = GetPerformanceConfig(context, problem);
+    auto best_time = std::numeric_limits<float>::max();
+    auto config    = PerformanceConfigBnFwdTrainingWelford{true};
+
+    do
+    {
+        if(!config.IsValid(problem))
+            continue;
+
+        try
+        {
+            const auto sln     = GetSolution(context, tuning_problem, config);
+            const auto invoker = handle.PrepareInvoker(*sln.invoker_factory,
+                                                       sln.construction_params);
+            invoker(handle, invoke_ctx); // warm-up, also clears the workspace
+            invoker(handle, invoke_ctx);
+            const auto elapsed = handle.GetKernelTime();
+
+            MIOPEN_LOG_I2(config << ": " << elapsed);
+            if(elapsed < best_time)
+            {
+                best      = config;
+                best_time = elapsed;
+            }
+        }
+        catch(const miopen::Exception& ex)
+        {
+            MIOPEN_LOG_W(config << ": " << ex.what());
+        }
+    } while(config.SetNextValue(problem));
+
+    MIOPEN_LOG_I("Best: " << best << ", " << best_time);
+    return best;
+}
+
+ConvSolution
+BnFwdTrainingSpatialWelford::GetSolution(const ExecutionContext&,
+                                         const miopen::batchnorm::ProblemDescription& problem,
+                                         const PerformanceConfigBnFwdTrainingWelford& config) const
+{
+    const bool bfp16parm  = problem.GetXDesc().GetType() == miopenHalf &&
+                            problem.GetBnScaleBiasMeanVarDesc().GetType() == miopenHalf;
+    const bool bfpmixparm = problem.GetXDesc().GetType() == miopenHalf &&
+                            problem.GetBnScaleBiasMeanVarDesc().GetType() == miopenFloat;
+    const bool bfp32parm  = !bfp16parm && !bfpmixparm;
+
+    int n, c, h, w;
+    std::tie(n, c, h, w) = tien<4>(problem.GetXDesc().GetLengths());
+
+    const std::size_t in_cstride = static_cast<std::size_t>(h) * w;
+    const std::size_t in_nhw     = n * in_cstride;
+    const std::size_t grp_size   = config.grp_size;
+    const std::size_t blocks     = config.blocks_per_channel;
+
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    {
+        auto kernel = KernelInfo{};
+
+        kernel.kernel_name = "MIOpenBatchNormFwdTrainSpatialWelford";
+        kernel.kernel_file = "MIOpenBatchNormFwdTrainSpatialWelford.cl";
+
+        const auto build_params = KernelBuildParameters{
+            {"MIOPEN_USE_FP16", static_cast<int>(bfp16parm)},
+            {"MIOPEN_USE_FP32", static_cast<int>(bfp32parm)},
+            {"MIOPEN_USE_FPMIX", static_cast<int>(bfpmixparm)},
+            {"MIO_SAVE_MEAN_VARIANCE", static_cast<int>(problem.GetResultSave())},
+            {"MIO_RUNNING_RESULT", static_cast<int>(problem.GetResultRunning())},
+            {"MIO_BN_N", n},
+            {"MIO_BN_C", c},
+            {"MIO_BN_HW", in_cstride},
+            {"MIO_BN_NHW", in_nhw},
+            {"MIO_BN_CHW", c * in_cstride},
+            {"MIO_BN_EPT", config.elems_per_thread},
+            {"MIO_BN_NBLOCKS", blocks},
+            {"MIO_BN_GRP0", grp_size},
+            {"MIO_BN_GRP1", 1},
+            {"MIO_BN_GRP2", 1},
+        };
+
+        kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{});
+
+        kernel.l_wk.push_back(grp_size);
+        kernel.l_wk.push_back(1);
+        kernel.l_wk.push_back(1);
+
+        kernel.g_wk.push_back(grp_size * blocks);
+        kernel.g_wk.push_back(c);
+        kernel.g_wk.push_back(1);
+
+        result.construction_params.push_back(kernel);
+
+        if(blocks > 1)
+        {
+            kernel.kernel_name += "Norm";
+            result.construction_params.push_back(kernel);
+        }
+    }
+
+    // Partial states, mean and inverse variance pairs and counters of the channels.
+    const auto workspace_size = (3 * blocks + 3) * c * sizeof(float);
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        const auto workspace = std::make_shared<WelfordWorkspace>();
+
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::batchnorm::InvokeParams>();
+
+            const auto ws = kernels.size() > 1 ? workspace->Get(handle_, workspace_size) : nullptr;
+
+            handle_.Run(kernels.front())(params.x,
+                                         params.y,
+                                         params.bnScale,
+                                         params.bnBias,
+                                         params.expAvgFactor,
+                                         params.resultRunningMean,
+                                         params.resultRunningVariance,
+                                         params.epsilon,
+                                         params.resultSaveMean,
+                                         params.resultSaveInvVariance,
+                                         ws);
+
+            if(kernels.size() == 1)
+                return;
+
+            float ctime = 0.;
+            profileSequence(handle_, 0, &ctime);
+
+            handle_.Run(kernels[1])(params.x, params.y, params.bnScale, params.bnBias, ws);
+            profileSequence(handle_, 2, &ctime);
+        };
+    };
+
+    return result;
+}
+
+} // namespace batchnorm
+
+} // namespace solver
+
+} // namespace miopen
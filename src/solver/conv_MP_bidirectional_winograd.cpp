@@ -26,6 +26,9 @@
 
 #include <limits>
 #include <cassert>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <miopen/solver.hpp>
 #include <miopen/env.hpp>
 #include <miopen/gcn_asm_utils.hpp>
@@ -70,6 +73,7 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_MP_BD_XDLOPS_WINOGRAD_F5X3)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_MP_BD_XDLOPS_WINOGRAD_F6X3)
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_WORKSPACE_MAX)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_BATCH_CHUNK)
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM)
 
@@ -117,19 +121,49 @@ struct WinoOffsets
     const size_t in, out, wei;
     WinoOffsets(size_t in_size, size_t out_size) : in(0), out(in_size), wei(in_size + out_size) {}
 };
+
+// Transformed filters of the constant weights, by the address of the weights.
+struct WinoFilterCache
+{
+    std::mutex mutex;
+    std::map<ConstData_t, Allocator::ManageDataPtr> filters;
+};
 #endif
 
+// The transforms and the GEMM accumulate in fp32. Only fp16 may stay in fp16, which is
+// experimental.
+inline miopenDataType_t GetTransformDataType(const ConvolutionContext& params)
+{
+    return params.IsFp16() &&
+                   miopen::IsEnabled(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM{})
+               ? miopenHalf
+               : miopenFloat;
+}
+
+// Data type ids of the transform kernels.
+inline int GetTransformKernelType(miopenDataType_t type)
+{
+    switch(type)
+    {
+    case miopenHalf: return 2;
+    case miopenBFloat16: return 3;
+    default: return 1;
+    }
+}
+
+// The buffers of the input and of the output hold the transforms of \p batch images.
 template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
 WinogradBufferInfo<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>
 GetWinoBuffer(const ConvolutionContext& params,
               const ConvWinoBuffType buff_type,
-              const miopenDataType_t transform_data_type)
+              const miopenDataType_t transform_data_type,
+              const int batch)
 {
     DEFINE_GETXFORMHWSIZE(params)
     DEFINE_SHADER_ALIASES(params)
 
     WinogradBufferInfo<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW> Transform_info(
-        N,
+        batch,
         K,
         C,
         group_cnt,
@@ -144,38 +178,123 @@ GetWinoBuffer(const ConvolutionContext& params,
         wino_xform_h,
         wino_xform_w);
 
+    (void)N;
     (void)H;
     (void)W;
     return Transform_info;
 }
 
 template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
-inline bool IsApplicableGEMM(const ConvolutionContext& params)
+WinogradBufferInfo<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>
+GetWinoBuffer(const ConvolutionContext& params,
+              const ConvWinoBuffType buff_type,
+              const miopenDataType_t transform_data_type)
+{
+    return GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+        params, buff_type, transform_data_type, params.batch_sz);
+}
+
+// With constant weights the invoker keeps the transformed filters instead of the workspace.
+inline bool IsFilterCached(const ConvolutionContext& params)
+{
+    return params.conv_problem.GetConv().constant_weights;
+}
+
+template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
+size_t GetTransformWorkspaceSize(const ConvolutionContext& params, bool cache_filter, int batch)
+{
+    const miopenDataType_t transform_data_type = GetTransformDataType(params);
+
+    // The filter goes last, see WinoOffsets.
+    return (GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+                params, ConvWinoBuffType::Input, transform_data_type, batch))
+               .buff_info.total_byte_size +
+           (GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+                params, ConvWinoBuffType::Output, transform_data_type, batch))
+               .buff_info.total_byte_size +
+           (cache_filter ? 0
+                         : (GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+                                params, ConvWinoBuffType::Weight, transform_data_type))
+                               .buff_info.total_byte_size);
+}
+
+// See MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_WORKSPACE_MAX, 0 sets the default limit of the device.
+inline std::size_t GetTransformWorkspaceLimit(const ConvolutionContext& params)
+{
+    std::size_t limit = miopen::Value(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_WORKSPACE_MAX{});
+#if WORKAROUND_SWDEV_203031
+    if(limit == 0)
+    {
+        const std::string name = params.GetStream().GetDeviceName();
+        if(name == "gfx900" || (name == "gfx906" && params.GetStream().GetMaxComputeUnits() <= 60))
+            limit = 2000000000ULL; // ~1.862 GiB
+        else
+            limit = std::numeric_limits<std::size_t>::max();
+    }
+#else
+    (void)params;
+    if(limit == 0)
+        limit = std::numeric_limits<std::size_t>::max();
+#endif
+    return limit;
+}
+
+// The transforms and the GEMM may process the batch in chunks of images, which reuse the same
+// Winograd-domain buffers of the workspace. The chunk is set by
+// MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_BATCH_CHUNK, and is reduced to fit the workspace limit, which
+// keeps large batches applicable. Without \p tiled the whole batch is processed at once.
+// Returns 0 if the limit is too small even for a single image.
+template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
+int GetBatchChunk(const ConvolutionContext& params, bool tiled)
+{
+    const int N          = params.batch_sz;
+    const auto requested = tiled ? miopen::Value(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_BATCH_CHUNK{}) : 0;
+    auto chunk = requested > 0 ? static_cast<int>(std::min<std::size_t>(requested, N)) : N;
+
+    const auto limit = GetTransformWorkspaceLimit(params);
+    if(limit == std::numeric_limits<std::size_t>::max())
+        return chunk;
+
+    const auto cache_filter = IsFilterCached(params);
+    const auto required     = [&](int batch) {
+        return GetTransformWorkspaceSize<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+            params, cache_filter, batch);
+    };
+    MIOPEN_LOG_I2("Workspace required: " << required(chunk) << ", limit: " << limit);
+    if(required(chunk) <= limit)
+        return chunk;
+    if(!tiled || required(1) > limit)
+        return 0;
+    // The workspace grows linearly with the chunk.
+    const auto per_image = required(2) - required(1);
+    return static_cast<int>(std::min<std::size_t>(chunk, 1 + (limit - required(1)) / per_image));
+}
+
+template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
+inline bool IsApplicableGEMM(const ConvolutionContext& params, int batch)
 {
 #if(MIOPEN_BACKEND_HIP && (MIOPEN_USE_ROCBLAS || MIOPEN_USE_MIOPENTENSILE))
 
-    const miopenDataType_t transform_data_type =
-        miopen::IsEnabled(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM{})
-            ? params.in_data_type
-            : miopenFloat;
+    const miopenDataType_t transform_data_type = GetTransformDataType(params);
 
     // int offset for Workspace buffers.
     return !(((GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-                   params, ConvWinoBuffType::Input, transform_data_type))
+                   params, ConvWinoBuffType::Input, transform_data_type, batch))
                       .buff_info.total_byte_size /
                   GetTypeSize(transform_data_type) +
               (GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-                   params, ConvWinoBuffType::Output, transform_data_type))
+                   params, ConvWinoBuffType::Output, transform_data_type, batch))
                       .buff_info.total_byte_size /
                   GetTypeSize(transform_data_type)) >= (1LL << 31));
 #else
     (void)params;
+    (void)batch;
     return false;
 #endif
 }
 
 template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
-inline bool IsApplicableTransform(const ConvolutionContext& params)
+inline bool IsApplicableTransform(const ConvolutionContext& params, bool tiled)
 {
 #if MIOPEN_BACKEND_HIP
     if(!params.use_asm_kernels)
@@ -186,7 +305,7 @@ inline bool IsApplicableTransform(const ConvolutionContext& params)
         return false;
     if(!(params.direction.IsForward() || params.direction.IsBackwardData()))
         return false;
-    if(!(params.IsFp32() || params.IsFp16()))
+    if(!(params.IsFp32() || params.IsFp16() || params.IsBfp16()))
         return false;
 
     const auto target = params.GetStream().GetTargetProperties();
@@ -201,31 +320,9 @@ inline bool IsApplicableTransform(const ConvolutionContext& params)
         return false;
 #endif
 
-    {
-        std::size_t limit = miopen::Value(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_WORKSPACE_MAX{});
-#if WORKAROUND_SWDEV_203031
-        if(limit == 0)
-        {
-            if(name == "gfx900" ||
-               (name == "gfx906" && params.GetStream().GetMaxComputeUnits() <= 60))
-                limit = 2000000000ULL; // ~1.862 GiB
-            else
-                limit = std::numeric_limits<std::size_t>::max();
-        }
-#else
-        if(limit == 0)
-            limit = std::numeric_limits<std::size_t>::max();
-#endif
-        if(limit != std::numeric_limits<std::size_t>::max())
-        {
-            const auto required =
-                ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>{}
-                    .GetWorkspaceSize(params);
-            MIOPEN_LOG_I2("Workspace required: " << required << ", limit: " << limit);
-            if(required > limit)
-                return false;
-        }
-    }
+    const auto chunk = GetBatchChunk<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params, tiled);
+    if(chunk == 0)
+        return false;
 
     if(!params.IsLayoutDefault())
     {
@@ -243,10 +340,7 @@ inline bool IsApplicableTransform(const ConvolutionContext& params)
     }
     DEFINE_SHADER_ALIASES(params)
     {
-        const miopenDataType_t transform_data_type =
-            miopen::IsEnabled(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM{})
-                ? params.in_data_type
-                : miopenFloat;
+        const miopenDataType_t transform_data_type = GetTransformDataType(params);
 
         BuffInfo in_buff(GetGroupConvLayout(GetMemLayout_t(params.in_layout), true),
                          N,
@@ -276,9 +370,9 @@ inline bool IsApplicableTransform(const ConvolutionContext& params)
                      GetTypeSize(params.weights_data_type));
 
         auto wino_in = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-            params, ConvWinoBuffType::Input, transform_data_type);
+            params, ConvWinoBuffType::Input, transform_data_type, chunk);
         auto wino_out = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-            params, ConvWinoBuffType::Output, transform_data_type);
+            params, ConvWinoBuffType::Output, transform_data_type, chunk);
         auto wino_wei = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
             params, ConvWinoBuffType::Weight, transform_data_type);
 
@@ -311,6 +405,7 @@ inline bool IsApplicableTransform(const ConvolutionContext& params)
     return ok;
 #else
     (void)params;
+    (void)tiled;
     return false;
 #endif
 }
@@ -327,7 +422,10 @@ bool ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>::IsA
         return false;
     }
 
-    if(!IsApplicableGEMM<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params))
+    const auto chunk = GetBatchChunk<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params, true);
+    if(chunk == 0)
+        return false;
+    if(!IsApplicableGEMM<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params, chunk))
         return false;
 
     static const int wino_data_tile   = std::max(WinoDataH, WinoDataW);
@@ -349,33 +447,23 @@ bool ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>::IsA
         if(IS_DISABLED(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_F2X3{}))
             return false;
 
-    return IsApplicableTransform<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params);
+    return IsApplicableTransform<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params, true);
 }
 
 template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
 size_t ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>::GetWorkspaceSize(
     const ConvolutionContext& params) const
 {
-    const miopenDataType_t transform_data_type =
-        miopen::IsEnabled(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM{})
-            ? params.in_data_type
-            : miopenFloat;
-
-    return (GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-                params, ConvWinoBuffType::Input, transform_data_type))
-               .buff_info.total_byte_size +
-           (GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-                params, ConvWinoBuffType::Output, transform_data_type))
-               .buff_info.total_byte_size +
-           (GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-                params, ConvWinoBuffType::Weight, transform_data_type))
-               .buff_info.total_byte_size;
+    const auto chunk = GetBatchChunk<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params, true);
+    return GetTransformWorkspaceSize<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+        params, IsFilterCached(params), std::max(chunk, 1));
 }
 
 template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
 InvokerFactory MakeWinogradInvokerFactory(const ConvolutionContext& params,
                                           InvokerFactory xdlops_factory = InvokerFactory(),
-                                          bool isXdlops                 = false)
+                                          bool isXdlops                 = false,
+                                          bool cache_filter             = false)
 {
 #if MIOPEN_BACKEND_HIP
     const int pad_H    = params.direction.IsForward() ? params.pad_h : params.GetBackwardPadH();
@@ -410,14 +498,21 @@ InvokerFactory MakeWinogradInvokerFactory(const ConvolutionContext& params,
                      group_cnt,
                      GetTypeSize(params.weights_data_type));
 
-    const miopenDataType_t transform_data_type =
-        miopen::IsEnabled(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM{})
-            ? params.in_data_type
-            : miopenFloat;
+    // The xdlops convolution is made for the whole batch.
+    const int batch_chunk =
+        GetBatchChunk<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params, !isXdlops);
+    const int chunk       = std::max(batch_chunk, 1);
+    const int last_chunk  = N % chunk == 0 ? chunk : N % chunk;
+
+    const miopenDataType_t transform_data_type = GetTransformDataType(params);
     auto wino_in = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-        params, ConvWinoBuffType::Input, transform_data_type);
+        params, ConvWinoBuffType::Input, transform_data_type, chunk);
     auto wino_out = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
-        params, ConvWinoBuffType::Output, transform_data_type);
+        params, ConvWinoBuffType::Output, transform_data_type, chunk);
+    auto wino_in_last = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+        params, ConvWinoBuffType::Input, transform_data_type, last_chunk);
+    auto wino_out_last = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+        params, ConvWinoBuffType::Output, transform_data_type, last_chunk);
     auto wino_wei = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
         params, ConvWinoBuffType::Weight, transform_data_type);
 
@@ -427,61 +522,69 @@ InvokerFactory MakeWinogradInvokerFactory(const ConvolutionContext& params,
     const WinoOffsets transform_offset(wino_in.buff_info.total_byte_size,
                                        wino_out.buff_info.total_byte_size);
 
-    InvokerFactory gemm_conv_factory;
+    // The GEMM of the last chunk only differs by the number of images.
+    InvokerFactory gemm_conv_factory, last_gemm_conv_factory;
     std::string gemm_conv_kernel_name;
 
     auto zeroDesc = TensorDescriptor();
     if(isXdlops)
     {
-        gemm_conv_kernel_name = "XDLOPS_CONV: ";
-        gemm_conv_factory     = xdlops_factory;
+        gemm_conv_kernel_name  = "XDLOPS_CONV: ";
+        gemm_conv_factory      = xdlops_factory;
+        last_gemm_conv_factory = xdlops_factory;
     }
     else
     {
-#if MIOPEN_USE_ROCBLAS || MIOPEN_USE_MIOPENTENSILE
-        // GEMM
         gemm_conv_kernel_name = "WRW_WINO_GEMM: ";
 
-        int m = K, k = C,
-            n   = wino_in.buff_info.size.nk * wino_in.buff_info.size.w * wino_in.buff_info.size.h;
-        int lda = m, ldb = n, ldc = n;
-        int batch_count       = wino_xform_h * wino_xform_w * group_cnt;
-        long long int strideA = m * k * 1LL, strideB = k * n * 1LL, strideC = m * n * 1LL;
-        float alpha = 1., beta = 0.0;
-        const bool isColMajor = false, transA = true, transB = false;
-        // clang-format off
-        GemmDescriptor wino_gemm_desc{isColMajor,transA,transB,m,n,k,
-            lda,ldb,ldc,batch_count,strideA,strideB,
-            strideC,alpha,beta,transform_data_type};
+        const auto make_gemm_conv_factory = [&](const auto& gemm_in) -> InvokerFactory {
+#if MIOPEN_USE_ROCBLAS || MIOPEN_USE_MIOPENTENSILE
+            // GEMM
+            int m = K, k = C,
+                n = gemm_in.buff_info.size.nk * gemm_in.buff_info.size.w * gemm_in.buff_info.size.h;
+            int lda = m, ldb = n, ldc = n;
+            int batch_count       = wino_xform_h * wino_xform_w * group_cnt;
+            long long int strideA = m * k * 1LL, strideB = k * n * 1LL, strideC = m * n * 1LL;
+            float alpha = 1., beta = 0.0;
+            const bool isColMajor = false, transA = true, transB = false;
+            // clang-format off
+            GemmDescriptor wino_gemm_desc{isColMajor,transA,transB,m,n,k,
+                lda,ldb,ldc,batch_count,strideA,strideB,
+                strideC,alpha,beta,transform_data_type};
 // clang-format on
 #else
-        (void)wino_xform_w;
-        (void)wino_xform_h;
+            (void)gemm_in;
+            (void)wino_xform_w;
+            (void)wino_xform_h;
 #endif
 
-        gemm_conv_factory = [=](const std::vector<Kernel>&) {
-            return [=](const Handle& handle, const AnyInvokeParams& ctx) {
+            return [=](const std::vector<Kernel>&) {
+                return [=](const Handle& handle, const AnyInvokeParams& ctx) {
 #if MIOPEN_USE_ROCBLAS || MIOPEN_USE_MIOPENTENSILE
-                const auto& data_ctx = ctx.CastTo<conv::DataInvokeParams>();
-                Data_t workSpace     = data_ctx.workSpace;
-                CallGemmStridedBatched(
-                    handle,
-                    wino_gemm_desc,
-                    workSpace,
-                    static_cast<int>(transform_offset.wei / wino_wei.buff_info.element_size),
-                    workSpace,
-                    static_cast<int>(transform_offset.in / wino_in.buff_info.element_size),
-                    workSpace,
-                    static_cast<int>(transform_offset.out / wino_out.buff_info.element_size),
-                    nullptr,
-                    GemmBackend_t::rocblas);
+                    const auto& data_ctx = ctx.CastTo<conv::DataInvokeParams>();
+                    Data_t workSpace     = data_ctx.workSpace;
+                    // The filter is either in the workspace or in the filter cache.
+                    CallGemmStridedBatched(
+                        handle,
+                        wino_gemm_desc,
+                        data_ctx.tensors.w,
+                        0,
+                        workSpace,
+                        static_cast<int>(transform_offset.in / wino_in.buff_info.element_size),
+                        workSpace,
+                        static_cast<int>(transform_offset.out / wino_out.buff_info.element_size),
+                        nullptr,
+                        GemmBackend_t::rocblas);
 #else
-                (void)handle;
-                (void)ctx;
-                MIOPEN_THROW(miopenStatusBadParm, "ConvMPBidirectWinograd is not supported ");
+                    (void)handle;
+                    (void)ctx;
+                    MIOPEN_THROW(miopenStatusBadParm, "ConvMPBidirectWinograd is not supported ");
 #endif
+                };
             };
         };
+        gemm_conv_factory      = make_gemm_conv_factory(wino_in);
+        last_gemm_conv_factory = make_gemm_conv_factory(wino_in_last);
     }
 
     return [=](const std::vector<Kernel>& kernels) {
@@ -492,6 +595,10 @@ InvokerFactory MakeWinogradInvokerFactory(const ConvolutionContext& params,
             isXdlops ? std::vector<Kernel>{kernels[3]} : std::vector<Kernel>{};
 
         auto gemm_conv_invoker = gemm_conv_factory(conv_kernels);
+        auto last_gemm_conv_invoker =
+            last_chunk == chunk ? gemm_conv_invoker : last_gemm_conv_factory(conv_kernels);
+        const auto filter_cache =
+            cache_filter ? std::make_shared<WinoFilterCache>() : std::shared_ptr<WinoFilterCache>{};
 
         return [=](const Handle& handle, const AnyInvokeParams& ctx) {
             const auto& data_ctx = ctx.CastTo<conv::DataInvokeParams>();
@@ -506,118 +613,175 @@ InvokerFactory MakeWinogradInvokerFactory(const ConvolutionContext& params,
             auto wino_out_ptr =
                 static_cast<void*>(reinterpret_cast<char*>(workSpace) + transform_offset.out);
 
-            for(int i = 0, cur = 0; i < 4; i++)
+            auto filter_ready = false;
+            if(data_ctx.prepared_weights != nullptr)
             {
-                std::string kernel_name;
-                if(i == 2) // GEMM
+                auto& filter = data_ctx.prepared_weights->buffer;
+                filter_ready = filter != nullptr;
+                if(!filter_ready)
                 {
-                    // rocblas_gemm use workSpace pointer and constant offset
-                    // xdlops_conv use tensors.in, tensors.w, tensors.out
-                    ConvDataTensors xdlops_tensor = ConvDataTensors(ConvFwdTensors{
-                        zeroDesc, wino_in_ptr, zeroDesc, wino_w_ptr, zeroDesc, wino_out_ptr});
-                    const auto invoke_params =
-                        conv::DataInvokeParams{xdlops_tensor, workSpace, workSpaceSize};
-
-                    gemm_conv_invoker(handle, invoke_params);
-                    kernel_name = gemm_conv_kernel_name;
+                    const MemoryCategoryScope memory_scope{MemoryCategory::Constants};
+                    filter = handle.Create(wino_wei.buff_info.total_byte_size);
                 }
-                else
+                wino_w_ptr = filter.get();
+            }
+            else if(filter_cache)
+            {
+                std::lock_guard<std::mutex> lock(filter_cache->mutex);
+                auto& filter = filter_cache->filters[tensors.w];
+                filter_ready = filter != nullptr;
+                if(!filter_ready)
                 {
-                    const auto kernel     = handle.Run(transform_kernels[cur++]);
-                    const BuffInfo* d_buf = nullptr;
-                    const BuffInfo* o_buf = nullptr;
-                    void* buff_out_addr   = nullptr;
-
-                    auto const_buff_in_adr = tensors.in;
-                    auto buff_in_adr       = wino_out_ptr;
-                    bool const_input       = false;
-                    kernel_name            = kernel.GetName();
-
-                    if(i == 0) // Input
-                    {          // Transform
-                        d_buf             = &in_buff;
-                        o_buf             = &(wino_in.buff_info);
-                        const_buff_in_adr = tensors.in;
-                        buff_out_addr     = wino_in_ptr;
-                        const_input       = true;
-                    }
-                    else if(i == 1) // filter
-                    {               // Transform
-                        d_buf             = &weights_buff;
-                        o_buf             = &(wino_wei.buff_info);
-                        const_buff_in_adr = tensors.w;
-                        buff_out_addr     = wino_w_ptr;
-                        const_input       = true;
-                    }
-                    else if(i == 3)
-                    { // Output
-                        d_buf         = &(wino_out.buff_info);
-                        o_buf         = &(out_buff);
-                        buff_in_adr   = wino_out_ptr;
-                        buff_out_addr = tensors.out;
-                        const_input   = false;
-                    }
-
-                    const auto input_ptr =
-                        static_cast<const void*>(const_input ? const_buff_in_adr : buff_in_adr);
-                    const auto output_ptr = buff_out_addr;
-                    // clang-format off
-                    MIOPEN_LOG_I2(" N=" << N << " G=" << group_cnt << " C=" << C << " H=" << H << " W=" << W << " K=" << K
-                        << " n_groups=" << n_groups << " R=" << R << " S=" << S
-                        << " pad_H=" << pad_H << " pad_W=" << pad_W << " out_H=" << out_H << " out_W=" << out_W
-                        << " d_buf.byte_stride.nk=" << d_buf->byte_stride.nk << " d_buf->.byte_stride.c=" << d_buf->byte_stride.c
-                        << " d_buf->.byte_stride.h=" << d_buf->byte_stride.h << " d_buf->.byte_stride.w=" << d_buf->byte_stride.w
-                        << " o_buf->byte_stride.nk=" << o_buf->byte_stride.nk << " o_buf->byte_stride.c=" << o_buf->byte_stride.c
-                        << " o_buf.byte_stride.h="  << o_buf->byte_stride.h <<  " o_buf->byte_stride.w=" << o_buf->byte_stride.w
-                        << " d_buf->.byte_stride.g=" << d_buf->byte_stride.g  << " o_buf->byte_stride.g="  << o_buf->byte_stride.g);
-                    // clang-format on
-                    kernel(N,
-                           C,
-                           H,
-                           W,
-                           K,
-                           n_groups,
-                           unused,
-                           reserved,
-                           input_ptr,
-                           reserved_ptr,
-                           output_ptr,
-                           reserved_ptr, // Unused return_addr.
-                           R,
-                           S,
-                           pad_H, // Like Fwd wino.
-                           pad_W,
-                           out_H,
-                           out_W,
-                           reserved_ptr, // Unused bias_addr.
-                           reserved,     // Unused relu_alpha.
-                           d_buf->byte_stride.nk,
-                           d_buf->byte_stride.c,
-                           d_buf->byte_stride.h,
-                           d_buf->byte_stride.w,
-                           unused,
-                           unused,
-                           unused,
-                           unused,
-                           o_buf->byte_stride.nk,
-                           o_buf->byte_stride.c,
-                           o_buf->byte_stride.h,
-                           o_buf->byte_stride.w,
-                           group_cnt,
-                           d_buf->byte_stride.g,
-                           unused,
-                           o_buf->byte_stride.g);
+                    const MemoryCategoryScope memory_scope{MemoryCategory::Constants};
+                    filter = handle.Create(wino_wei.buff_info.total_byte_size);
                 }
-                if(handle.IsProfilingEnabled())
+                wino_w_ptr = filter.get();
+            }
+
+            if(data_ctx.prepare_weights_only && filter_ready)
+                return;
+
+            // The chunks of the batch reuse the Winograd-domain buffers of the input and of the
+            // output, the filter is only transformed once.
+            for(int first = 0; first < N; first += chunk)
+            {
+                const auto n          = std::min(chunk, N - first);
+                const auto& chunk_in  = n == chunk ? wino_in : wino_in_last;
+                const auto& chunk_out = n == chunk ? wino_out : wino_out_last;
+                const auto is_last    = first + n >= N;
+                const auto in_offset  = static_cast<std::size_t>(first) * in_buff.byte_stride.nk;
+                const auto out_offset = static_cast<std::size_t>(first) * out_buff.byte_stride.nk;
+
+                for(int i = 0, cur = 0; i < 4; i++)
                 {
-                    float cur_time = handle.GetKernelTime();
-                    MIOPEN_LOG_I2(kernel_name << ": " << cur_time);
+                    if(i == 1 && (filter_ready || first > 0))
+                    {
+                        ++cur; // The filter has been transformed by a previous call or chunk.
+                        continue;
+                    }
+                    if(data_ctx.prepare_weights_only && i != 1)
+                    {
+                        if(i != 2)
+                            ++cur;
+                        continue;
+                    }
 
-                    if(i < 3)
-                        total_time += cur_time;
+                    std::string kernel_name;
+                    if(i == 2) // GEMM
+                    {
+                        // rocblas_gemm use workSpace pointer and constant offset
+                        // xdlops_conv use tensors.in, tensors.w, tensors.out
+                        ConvDataTensors xdlops_tensor = ConvDataTensors(ConvFwdTensors{
+                            zeroDesc, wino_in_ptr, zeroDesc, wino_w_ptr, zeroDesc, wino_out_ptr});
+                        const auto invoke_params =
+                            conv::DataInvokeParams{xdlops_tensor, workSpace, workSpaceSize};
+
+                        if(n == chunk)
+                            gemm_conv_invoker(handle, invoke_params);
+                        else
+                            last_gemm_conv_invoker(handle, invoke_params);
+                        kernel_name = gemm_conv_kernel_name;
+                    }
                     else
-                        handle.AccumKernelTime(total_time);
+                    {
+                        const auto kernel     = handle.Run(transform_kernels[cur++]);
+                        const BuffInfo* d_buf = nullptr;
+                        const BuffInfo* o_buf = nullptr;
+                        void* buff_out_addr   = nullptr;
+
+                        auto const_buff_in_adr = tensors.in;
+                        auto buff_in_adr       = wino_out_ptr;
+                        bool const_input       = false;
+                        kernel_name            = kernel.GetName();
+
+                        if(i == 0) // Input
+                        {          // Transform
+                            d_buf             = &in_buff;
+                            o_buf             = &(chunk_in.buff_info);
+                            const_buff_in_adr = static_cast<const char*>(tensors.in) + in_offset;
+                            buff_out_addr     = wino_in_ptr;
+                            const_input       = true;
+                        }
+                        else if(i == 1) // filter
+                        {               // Transform
+                            d_buf             = &weights_buff;
+                            o_buf             = &(wino_wei.buff_info);
+                            const_buff_in_adr = tensors.w;
+                            buff_out_addr     = wino_w_ptr;
+                            const_input       = true;
+                        }
+                        else if(i == 3)
+                        { // Output
+                            d_buf         = &(chunk_out.buff_info);
+                            o_buf         = &(out_buff);
+                            buff_in_adr   = wino_out_ptr;
+                            buff_out_addr = static_cast<char*>(tensors.out) + out_offset;
+                            const_input   = false;
+                        }
+
+                        const auto input_ptr =
+                            static_cast<const void*>(const_input ? const_buff_in_adr : buff_in_adr);
+                        const auto output_ptr = buff_out_addr;
+                        // clang-format off
+                        MIOPEN_LOG_I2(" N=" << n << " G=" << group_cnt << " C=" << C << " H=" << H << " W=" << W << " K=" << K
+                            << " n_groups=" << n_groups << " R=" << R << " S=" << S
+                            << " pad_H=" << pad_H << " pad_W=" << pad_W << " out_H=" << out_H << " out_W=" << out_W
+                            << " d_buf.byte_stride.nk=" << d_buf->byte_stride.nk << " d_buf->.byte_stride.c=" << d_buf->byte_stride.c
+                            << " d_buf->.byte_stride.h=" << d_buf->byte_stride.h << " d_buf->.byte_stride.w=" << d_buf->byte_stride.w
+                            << " o_buf->byte_stride.nk=" << o_buf->byte_stride.nk << " o_buf->byte_stride.c=" << o_buf->byte_stride.c
+                            << " o_buf.byte_stride.h="  << o_buf->byte_stride.h <<  " o_buf->byte_stride.w=" << o_buf->byte_stride.w
+                            << " d_buf->.byte_stride.g=" << d_buf->byte_stride.g  << " o_buf->byte_stride.g="  << o_buf->byte_stride.g);
+                        // clang-format on
+                        kernel(n,
+                               C,
+                               H,
+                               W,
+                               K,
+                               n_groups,
+                               unused,
+                               reserved,
+                               input_ptr,
+                               reserved_ptr,
+                               output_ptr,
+                               reserved_ptr, // Unused return_addr.
+                               R,
+                               S,
+                               pad_H, // Like Fwd wino.
+                               pad_W,
+                               out_H,
+                               out_W,
+                               reserved_ptr, // Unused bias_addr.
+                               reserved,     // Unused relu_alpha.
+                               d_buf->byte_stride.nk,
+                               d_buf->byte_stride.c,
+                               d_buf->byte_stride.h,
+                               d_buf->byte_stride.w,
+                               unused,
+                               unused,
+                               unused,
+                               unused,
+                               o_buf->byte_stride.nk,
+                               o_buf->byte_stride.c,
+                               o_buf->byte_stride.h,
+                               o_buf->byte_stride.w,
+                               group_cnt,
+                               d_buf->byte_stride.g,
+                               unused,
+                               o_buf->byte_stride.g);
+                    }
+                    if(handle.IsProfilingEnabled())
+                    {
+                        float cur_time = handle.GetKernelTime();
+                        MIOPEN_LOG_I2(kernel_name << ": " << cur_time);
+
+                        if(i < 3 || !is_last)
+                            total_time += cur_time;
+                        else
+                            handle.AccumKernelTime(total_time);
+                    }
                 }
+                if(data_ctx.prepare_weights_only)
+                    break;
             }
         };
     };
@@ -625,6 +789,7 @@ InvokerFactory MakeWinogradInvokerFactory(const ConvolutionContext& params,
     (void)params;
     (void)xdlops_factory;
     (void)isXdlops;
+    (void)cache_filter;
     MIOPEN_THROW(miopenStatusBadParm, "ConvMPBidirectWinograd is not supported ");
     return nullptr;
 #endif
@@ -643,27 +808,24 @@ ConvSolution ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilte
     const std::vector<size_t> l_wk{512, 1, 1};
     const size_t g_wk_0 = n_groups * l_wk[0];
     const std::vector<size_t> g_wk{g_wk_0, 1, 1};
-    const miopenDataType_t transform_data_type =
-        miopen::IsEnabled(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM{})
-            ? params.in_data_type
-            : miopenFloat;
+    const miopenDataType_t transform_data_type = GetTransformDataType(params);
     std::ostringstream options_in;
     GENERATE_MAIN_OPTIONS(options_in)
     GenerateClangDefsym(options_in, "xform_mirror", 0);
-    GenerateClangDefsym(options_in, "in_type", (params.IsFp32() ? 1 : 2));
-    GenerateClangDefsym(options_in, "out_type", (transform_data_type == miopenFloat ? 1 : 2));
+    GenerateClangDefsym(options_in, "in_type", GetTransformKernelType(params.in_data_type));
+    GenerateClangDefsym(options_in, "out_type", GetTransformKernelType(transform_data_type));
 
     std::ostringstream options_filter;
     GENERATE_MAIN_OPTIONS(options_filter)
     GenerateClangDefsym(options_filter, "xform_mirror", params.direction.IsBackwardData());
-    GenerateClangDefsym(options_filter, "in_type", (params.IsFp32() ? 1 : 2));
-    GenerateClangDefsym(options_filter, "out_type", (transform_data_type == miopenFloat ? 1 : 2));
+    GenerateClangDefsym(options_filter, "in_type", GetTransformKernelType(params.in_data_type));
+    GenerateClangDefsym(options_filter, "out_type", GetTransformKernelType(transform_data_type));
 
     std::ostringstream options_out;
     GENERATE_MAIN_OPTIONS(options_out)
     GenerateClangDefsym(options_out, "xform_mirror", 0);
-    GenerateClangDefsym(options_out, "in_type", (transform_data_type == miopenFloat ? 1 : 2));
-    GenerateClangDefsym(options_out, "out_type", (params.IsFp32() ? 1 : 2));
+    GenerateClangDefsym(options_out, "in_type", GetTransformKernelType(transform_data_type));
+    GenerateClangDefsym(options_out, "out_type", GetTransformKernelType(params.in_data_type));
 
     KernelInfo InTransform{
         options_in.str(),
@@ -700,7 +862,8 @@ ConvSolution ConvMPBidirectWinograd<WinoDataH, WinoFilterH, WinoDataW, WinoFilte
     result.construction_params.push_back(OutTransform);
 
     result.invoker_factory =
-        MakeWinogradInvokerFactory<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(params);
+        MakeWinogradInvokerFactory<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+            params, InvokerFactory(), false, IsFilterCached(params));
 
     return result;
 #else
@@ -722,10 +885,7 @@ ConvolutionContext ConvMPBidirectWinograd_xdlops<WinoDataH, WinoFilterH, WinoDat
 {
     DEFINE_GETXFORMHWSIZE(ctx)
     int batch_count = wino_xform_h * wino_xform_w * ctx.group_counts;
-    const miopenDataType_t transform_data_type =
-        miopen::IsEnabled(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM{})
-            ? ctx.in_data_type
-            : miopenFloat;
+    const miopenDataType_t transform_data_type = GetTransformDataType(ctx);
 
     WinogradBufferInfo<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>
         wino_in = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
@@ -774,16 +934,23 @@ ConvolutionContext ConvMPBidirectWinograd_xdlops<WinoDataH, WinoFilterH, WinoDat
     return transformed_ctx;
 }
 
+template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
+size_t ConvMPBidirectWinograd_xdlops<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>::
+    GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    // The filters are not cached here: Search() times the convolution on the workspace.
+    return GetTransformWorkspaceSize<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
+               ctx, false, ctx.batch_sz) +
+           ConvHipImplicitGemmForwardV4R4Xdlops{}.GetWorkspaceSize(GetTransformedConvContext(ctx));
+}
+
 // must be same as invoke_params in Invoker
 template <int WinoDataH, int WinoFilterH, int WinoDataW, int WinoFilterW>
 conv::DataInvokeParams GetTransformedInvokeContext(const ConvolutionContext& ctx,
                                                    const AnyInvokeParams& invoke_ctx)
 {
 #if MIOPEN_BACKEND_HIP
-    const miopenDataType_t transform_data_type =
-        miopen::IsEnabled(MIOPEN_DEBUG_AMD_MP_BD_WINOGRAD_EXPEREMENTAL_FP16_TRANSFORM{})
-            ? ctx.in_data_type
-            : miopenFloat;
+    const miopenDataType_t transform_data_type = GetTransformDataType(ctx);
     WinogradBufferInfo<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>
         wino_in = GetWinoBuffer<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(
             ctx, ConvWinoBuffType::Input, transform_data_type),
@@ -850,7 +1017,7 @@ bool ConvMPBidirectWinograd_xdlops<WinoDataH, WinoFilterH, WinoDataW, WinoFilter
         if(IS_DISABLED(MIOPEN_DEBUG_AMD_MP_BD_XDLOPS_WINOGRAD_F2X3{}))
             return false;
 
-    return IsApplicableTransform<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(ctx) &&
+    return IsApplicableTransform<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>(ctx, false) &&
            ConvHipImplicitGemmForwardV4R4Xdlops().IsApplicable(GetTransformedConvContext(ctx));
 }
 
@@ -870,7 +1037,7 @@ ConvMPBidirectWinograd_xdlops<WinoDataH, WinoFilterH, WinoDataW, WinoFilterW>::G
         ConvHipImplicitGemmForwardV4R4Xdlops{}.GetSolution(xdlops_conv_ctx, config);
 
     ConvSolution result;
-    result.workspce_sz = wino_transform.workspce_sz + xdlops_conv.workspce_sz;
+    result.workspce_sz = GetWorkspaceSize(ctx);
 
     assert(xdlops_conv.construction_params.size() == 1);
 
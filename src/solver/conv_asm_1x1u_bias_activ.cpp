@@ -88,7 +88,8 @@ ConvBiasActivAsm1x1U::Search(const ConvolutionContext& context, const AnyInvokeP
 
     /// Workaround: Fused conv API does not pass user-allocated buffers here,
     /// but we need these buffers for search.
-    auto& handle        = cba_context.GetStream();
+    auto& handle = cba_context.GetStream();
+    const MemoryCategoryScope memory_scope{MemoryCategory::Search};
     const auto bias_buf = handle.Create(cba_context.bias_sz);
     const auto in_buf   = handle.Create(cba_context.bot_sz);
     const auto wei_buf  = handle.Create(cba_context.weights_sz);
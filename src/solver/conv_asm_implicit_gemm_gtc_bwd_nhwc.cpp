@@ -29,6 +29,7 @@
 #include <miopen/generic_search.hpp>
 #include <miopen/gcn_asm_utils.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
+#include <miopen/solver/gemm_cost_model.hpp>
 #include <miopen/conv/asm_implicit_gemm.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_ASM_BWD_GTC_XDLOPS_NHWC)
@@ -422,6 +423,38 @@ void PerformanceConfigAsmImplicitGemmGTCBwdXdlopsNHWC::HeuristicInit(const Convo
     bool not_support_vector_store = ctx.IsFp16() && ((c / group) % 2 != 0);
     int m_per_block, n_per_block, k_per_block;
 
+    if(IsNarrowGroupedGemm(group, c / group, k / group))
+    {
+        const auto y_dot          = integer_divide_ceil(y, y_tilda);
+        const auto x_dot          = integer_divide_ceil(x, x_tilda);
+        const auto& config_list   = GetBwdXdlopsNHWCConfigList();
+
+        const auto cost_of = [&](const auto& config) {
+            if(!config.IsValid(ctx))
+                return std::numeric_limits<float>::max();
+            GemmTileShape shape;
+            shape.gemm_g      = group * y_tilda * x_tilda;
+            shape.gemm_m      = gemm_m;
+            shape.gemm_n      = gemm_n;
+            shape.gemm_k      = (k / group) * y_dot * x_dot;
+            shape.m_per_block = config.gemm_m_per_block;
+            shape.n_per_block = config.gemm_n_per_block;
+            shape.k_per_block = config.gemm_k_per_block;
+            shape.block_size  = config.BlockSize();
+            shape.lds_size    = 2 * (config.gemm_m_per_block + config.gemm_n_per_block) *
+                                config.gemm_k_per_block * GetTypeSize(ctx.in_data_type);
+            shape.k_splits    = std::size_t{1} << config.gemm_k_global_split;
+            return EstimateGemmTileCost(shape, ctx.GetStream().GetMaxComputeUnits());
+        };
+
+        const auto selected_index = HeuristicSelectGroupedTile(config_list, cost_of);
+        if(selected_index < config_list.size())
+        {
+            CopyParameters(config_list[selected_index]);
+            return;
+        }
+    }
+
     std::tie(m_per_block, n_per_block, k_per_block) = HeuristicInitMacroTileNoPadGemmK(
         gemm_m, gemm_n, gemm_k_even, ctx.IsFp32() ? tile_list_fp32 : tile_list_fp16);
 
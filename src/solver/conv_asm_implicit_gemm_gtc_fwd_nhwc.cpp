@@ -29,6 +29,7 @@
 #include <miopen/generic_search.hpp>
 #include <miopen/gcn_asm_utils.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
+#include <miopen/solver/gemm_cost_model.hpp>
 #include <miopen/conv/asm_implicit_gemm.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_ASM_FWD_GTC_XDLOPS_NHWC)
@@ -333,6 +334,24 @@ void PerformanceConfigAsmImplicitGemmGTCFwdXdlopsNHWC::HeuristicInit(const Convo
     bool not_support_vector_store = ctx.IsFp16() && ((k / group) % 2 != 0);
     int m_per_block, n_per_block, k_per_block;
 
+    if(IsNarrowGroupedGemm(group, c / group, k / group))
+    {
+        const auto& config_list = GetFwdXdlopsNHWCConfigList();
+
+        const auto cost_of = [&](const auto& config) {
+            if(!config.IsValid(ctx))
+                return std::numeric_limits<float>::max();
+            return ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC{}.EstimateCost(ctx, config);
+        };
+
+        const auto selected_index = HeuristicSelectGroupedTile(config_list, cost_of);
+        if(selected_index < config_list.size())
+        {
+            CopyParameters(config_list[selected_index]);
+            return;
+        }
+    }
+
     std::tie(m_per_block, n_per_block, k_per_block) = HeuristicInitMacroTileNoPadGemmK(
         gemm_m, gemm_n, gemm_k, ctx.IsFp32() ? tile_list_fp32 : tile_list_fp16);
 
@@ -539,6 +558,8 @@ PerformanceConfigAsmImplicitGemmGTCFwdXdlopsNHWC
 ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC::GetPerformanceConfig(
     const ConvolutionContext& params) const
 {
+    if(const auto by_cost = GetCostModelConfig(*this, params))
+        return *by_cost;
     PerformanceConfigAsmImplicitGemmGTCFwdXdlopsNHWC pp;
     pp.HeuristicInit(params);
     MIOPEN_LOG_I(pp.ToString());
@@ -557,6 +578,28 @@ ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC::Search(const ConvolutionContext& ctx
     return GenericSearch(*this, ctx, invoke_ctx);
 }
 
+float ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC::EstimateCost(
+    const ConvolutionContext& ctx,
+    const PerformanceConfigAsmImplicitGemmGTCFwdXdlopsNHWC& config) const
+{
+    const auto& group = ctx.group_counts;
+
+    GemmTileShape shape;
+    shape.gemm_g      = group;
+    shape.gemm_m      = ctx.batch_sz * ctx.out_height * ctx.out_width;
+    shape.gemm_n      = ctx.n_outputs / group;
+    shape.gemm_k      = (ctx.n_inputs / group) * ctx.kernel_size_h * ctx.kernel_size_w;
+    shape.m_per_block = config.gemm_m_per_block;
+    shape.n_per_block = config.gemm_n_per_block;
+    shape.k_per_block = config.gemm_k_per_block;
+    shape.block_size  = config.BlockSize();
+    // Tiles of A and B, double buffered.
+    shape.lds_size = 2 * (config.gemm_m_per_block + config.gemm_n_per_block) *
+                     config.gemm_k_per_block * GetTypeSize(ctx.in_data_type);
+    shape.k_splits = std::size_t{1} << config.gemm_k_global_split;
+    return EstimateGemmTileCost(shape, ctx.GetStream().GetMaxComputeUnits());
+}
+
 bool ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC::IsApplicable(const ConvolutionContext& ctx) const
 {
     if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_ASM_FWD_GTC_XDLOPS_NHWC{}))
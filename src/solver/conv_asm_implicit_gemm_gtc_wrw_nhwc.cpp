@@ -32,6 +32,7 @@
 #include <miopen/solver/implicitgemm_util.hpp>
 #include <miopen/gcn_asm_utils.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/solver/gemm_cost_model.hpp>
 #include <miopen/conv/asm_implicit_gemm.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_ASM_WRW_GTC_XDLOPS_NHWC)
@@ -373,6 +374,48 @@ void PerformanceConfigAsmImplicitGemmGTCWrwXdlopsNHWC::HeuristicInit(const Convo
     bool not_support_vector_store = ctx.IsFp16() && ((c / group) % 2 != 0);
     int m_per_block, n_per_block, k_per_block;
 
+    if(IsNarrowGroupedGemm(group, c / group, k / group))
+    {
+        const auto& config_list = GetWrwXdlopsNHWCConfigList();
+
+        const auto cost_of = [&](const auto& config) {
+            if(!config.IsValid(ctx))
+                return std::numeric_limits<float>::max();
+            // c need to be carefully padded
+            const auto c_vec_min = config.tensor_b_thread_lengths[3];
+            const auto c_padded  = ((c / group) + c_vec_min - 1) / c_vec_min * c_vec_min;
+            GemmTileShape shape;
+            shape.gemm_g      = group;
+            shape.gemm_m      = gemm_m;
+            shape.gemm_n      = c_padded * y * x;
+            shape.gemm_k      = ctx.batch_sz * ctx.in_height * ctx.in_width;
+            shape.m_per_block = config.gemm_m_per_block;
+            shape.n_per_block = config.gemm_n_per_block;
+            shape.k_per_block = config.gemm_k_per_block;
+            shape.block_size  = config.BlockSize();
+            shape.lds_size    = 2 * (config.gemm_m_per_block + config.gemm_n_per_block) *
+                                config.gemm_k_per_block * GetTypeSize(ctx.in_data_type);
+            return EstimateGemmTileCost(shape, num_cu);
+        };
+
+        const auto selected_index = HeuristicSelectGroupedTile(config_list, cost_of);
+        if(selected_index < config_list.size())
+        {
+            size_t current_grid_size;
+            size_t occupancy;
+            std::tie(std::ignore, std::ignore, current_grid_size, occupancy) =
+                GetImplicitGemmGtcDynamicWrwXdlopsNHWCKernel(ctx, config_list[selected_index]);
+            bool need_k_split = current_grid_size <= non_split_gridsize;
+            size_t gks = ComputeGemmKGlobalSplitsWith2DMerge(current_grid_size, occupancy, num_cu);
+            need_k_split |= gks != 0;
+
+            CopyParameters(config_list[selected_index]);
+            if(need_k_split)
+                gemm_k_global_split = occupancy;
+            return;
+        }
+    }
+
     std::tie(m_per_block, n_per_block, k_per_block) = HeuristicInitMacroTileNoPadGemmK(
         gemm_m, gemm_n, 0, ctx.IsFp32() ? tile_list_fp32 : tile_list_fp16);
 
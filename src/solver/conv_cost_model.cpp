@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver/conv_cost_model.hpp>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+struct DeviceSpec
+{
+    const char* prefix;
+    double clock_ghz;
+    double bandwidth_gbs;
+    double fp32_flops_per_cu_clock;
+    double fp16_flops_per_cu_clock;
+};
+
+// The first matching prefix wins, the empty one matches any device.
+constexpr DeviceSpec device_specs[] = {
+    {"gfx900", 1.50, 484.0, 128.0, 256.0},
+    {"gfx906", 1.75, 1024.0, 128.0, 256.0},
+    {"gfx908", 1.50, 1228.0, 256.0, 1024.0},
+    {"gfx90a", 1.70, 1638.0, 256.0, 1024.0},
+    {"gfx94", 2.10, 5300.0, 256.0, 2048.0},
+    {"gfx103", 2.25, 512.0, 128.0, 256.0},
+    {"gfx110", 2.40, 960.0, 256.0, 512.0},
+    {"", 1.50, 1000.0, 128.0, 256.0},
+};
+
+constexpr float launch_overhead_ms = 0.005f;
+
+} // namespace
+
+ConvWork GetConvWork(const conv::ProblemDescription& problem, const std::size_t workspace)
+{
+    // The output of the forward convolution is the input of the backward ones.
+    const auto forward = problem.GetDirection() == conv::Direction::Forward;
+    const auto y_pixels =
+        forward ? problem.GetOutDepth() * problem.GetOutHeight() * problem.GetOutWidth()
+                : problem.GetInDepth() * problem.GetInHeight() * problem.GetInWidth();
+    const auto filter_pixels =
+        problem.GetWeightsDepth() * problem.GetWeightsHeight() * problem.GetWeightsWidth();
+    const auto group_count = std::max(problem.GetGroupCount(), 1);
+
+    auto work  = ConvWork{};
+    work.flops = 2.0 * problem.GetInBatchSize() * problem.GetInChannels() *
+                 problem.GetOutChannels() / group_count * y_pixels * filter_pixels;
+    work.bytes = static_cast<double>(problem.GetInSize()) + problem.GetOutSize() +
+                 problem.GetWeightsSize() / group_count + 2.0 * workspace;
+    return work;
+}
+
+DeviceThroughput GetDeviceThroughput(const std::string& device_name,
+                                     const std::size_t num_cu,
+                                     const miopenDataType_t type)
+{
+    const auto spec = *std::find_if(std::begin(device_specs),
+                                    std::end(device_specs),
+                                    [&](const DeviceSpec& s) {
+                                        return StartsWith(device_name, s.prefix);
+                                    });
+    const auto has_matrix_cores = spec.fp16_flops_per_cu_clock > 2 * spec.fp32_flops_per_cu_clock;
+
+    auto flops_per_cu_clock = spec.fp32_flops_per_cu_clock;
+    switch(type)
+    {
+    case miopenHalf: flops_per_cu_clock = spec.fp16_flops_per_cu_clock; break;
+    case miopenBFloat16:
+        if(has_matrix_cores)
+            flops_per_cu_clock = spec.fp16_flops_per_cu_clock;
+        break;
+    case miopenInt8:
+    case miopenInt8x4: flops_per_cu_clock = 2 * spec.fp16_flops_per_cu_clock; break;
+    case miopenDouble: flops_per_cu_clock = spec.fp32_flops_per_cu_clock / 2; break;
+    case miopenFloat:
+    case miopenInt32: break;
+    }
+
+    auto throughput         = DeviceThroughput{};
+    throughput.flops_per_ms = flops_per_cu_clock * num_cu * spec.clock_ghz * 1.0e6;
+    throughput.bytes_per_ms = spec.bandwidth_gbs * 1.0e6;
+    return throughput;
+}
+
+float GetDefaultEfficiency(const miopenConvAlgorithm_t algorithm)
+{
+    switch(algorithm)
+    {
+    case miopenConvolutionAlgoGEMM: return 0.5f;
+    case miopenConvolutionAlgoDirect: return 0.3f;
+    case miopenConvolutionAlgoFFT: return 0.25f;
+    // Fewer flops than the direct convolution for small filters.
+    case miopenConvolutionAlgoWinograd: return 0.8f;
+    case miopenConvolutionAlgoImplicitGEMM: return 0.6f;
+    }
+    return 0.3f;
+}
+
+float EstimateConvTime(const ConvWork& work, const DeviceThroughput& device, const float efficiency)
+{
+    const auto compute_ms = work.flops / (device.flops_per_ms * std::max(efficiency, 0.01f));
+    const auto memory_ms  = work.bytes / device.bytes_per_ms;
+    return static_cast<float>(std::max(compute_ms, memory_ms)) + launch_overhead_ms;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,291 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver/conv_depthwise.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/sequences.hpp>
+
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DEPTHWISE_PERF_VALS)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+// The filter, the accumulators of the tile and a row of the input are kept in registers.
+constexpr int max_filter_size = 81;
+constexpr int max_row_span    = 64;
+
+// clang-format off
+auto PerfFieldRules()
+{
+    return seq::MakeRuleSet(
+        std::make_tuple(seq::Sequence<int, 1, 2, 4, 8>{}, &PerformanceConfigConvDepthwise::tile),
+        std::make_tuple(seq::Sequence<int, 64, 128, 256>{}, &PerformanceConfigConvDepthwise::block)
+    );
+}
+// clang-format on
+
+/// Width tiled by the work-items: the output one except of the backward data pass, which
+/// computes the input.
+int GetTiledWidth(const ConvolutionContext& ctx, const DepthwiseConvSizes& sizes)
+{
+    return ctx.direction.IsBackwardData() ? sizes.wi : sizes.wo;
+}
+
+int GetRowSpan(const DepthwiseConvSizes& sizes, int tile)
+{
+    return (tile - 1) * sizes.sx + (sizes.fx - 1) * sizes.dx + 1;
+}
+
+int Ceil(int value, int divisor) { return (value + divisor - 1) / divisor; }
+
+} // namespace
+
+DepthwiseConvSizes GetDepthwiseConvSizes(const ConvolutionContext& ctx)
+{
+    auto sizes = DepthwiseConvSizes{};
+    sizes.n    = ctx.batch_sz;
+    if(ctx.direction.IsForward())
+    {
+        sizes.c  = ctx.n_inputs;
+        sizes.m  = ctx.n_outputs / ctx.n_inputs;
+        sizes.hi = ctx.in_height;
+        sizes.wi = ctx.in_width;
+        sizes.ho = ctx.out_height;
+        sizes.wo = ctx.out_width;
+    }
+    else
+    {
+        sizes.c  = ctx.n_outputs;
+        sizes.m  = ctx.n_inputs / ctx.n_outputs;
+        sizes.hi = ctx.out_height;
+        sizes.wi = ctx.out_width;
+        sizes.ho = ctx.in_height;
+        sizes.wo = ctx.in_width;
+    }
+    sizes.fy = ctx.kernel_size_h;
+    sizes.fx = ctx.kernel_size_w;
+    sizes.sy = ctx.kernel_stride_h;
+    sizes.sx = ctx.kernel_stride_w;
+    sizes.dy = ctx.kernel_dilation_h;
+    sizes.dx = ctx.kernel_dilation_w;
+    sizes.py = ctx.pad_h;
+    sizes.px = ctx.pad_w;
+    return sizes;
+}
+
+bool IsDepthwiseConvApplicable(const ConvolutionContext& ctx)
+{
+    if(!ctx.Is2d())
+        return false;
+    if(!ctx.IsLayoutDefault() && !ctx.IsLayoutNHWC())
+        return false;
+    if(!(ctx.IsFp32() || ctx.IsFp16() || ctx.IsBfp16()))
+        return false;
+    if(ctx.in_data_type != ctx.weights_data_type || ctx.in_data_type != ctx.out_data_type)
+        return false;
+
+    const auto channels = ctx.direction.IsForward() ? ctx.n_inputs : ctx.n_outputs;
+    const auto outputs  = ctx.direction.IsForward() ? ctx.n_outputs : ctx.n_inputs;
+    if(ctx.group_counts != channels || outputs % channels != 0)
+        return false;
+
+    const auto sizes = GetDepthwiseConvSizes(ctx);
+    if(sizes.fy * sizes.fx > max_filter_size || GetRowSpan(sizes, 1) > max_row_span)
+        return false;
+
+    // The kernels index the tensors with 32-bit integers.
+    const auto max_elements = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    const auto x_elements   = static_cast<std::size_t>(sizes.n) * sizes.c * sizes.hi * sizes.wi;
+    const auto y_elements =
+        static_cast<std::size_t>(sizes.n) * sizes.c * sizes.m * sizes.ho * sizes.wo;
+    return x_elements <= max_elements && y_elements <= max_elements;
+}
+
+void PerformanceConfigConvDepthwise::HeuristicInit(const ConvolutionContext& ctx)
+{
+    const auto sizes = GetDepthwiseConvSizes(ctx);
+    const auto width = GetTiledWidth(ctx, sizes);
+
+    tile = width >= 64 ? 4 : (width >= 16 ? 2 : 1);
+    while(tile > 1 && GetRowSpan(sizes, tile) > max_row_span)
+        tile /= 2;
+
+    if(ctx.direction.IsBackwardWrW())
+        block = sizes.n * sizes.ho * Ceil(sizes.wo, tile) >= 4 * 256 ? 256 : 64;
+    else
+        block = 256;
+}
+
+bool PerformanceConfigConvDepthwise::IsValidValue() const { return PerfFieldRules().IsIn(*this); }
+
+bool PerformanceConfigConvDepthwise::SetNextValue(const ConvolutionContext& /*ctx*/)
+{
+    return !PerfFieldRules().Next(*this);
+}
+
+bool PerformanceConfigConvDepthwise::IsValid(const ConvolutionContext& ctx) const
+{
+    if(!IsValidValue())
+        return false;
+
+    const auto sizes = GetDepthwiseConvSizes(ctx);
+    // Wider tiles than the image only waste the work-items.
+    if(tile > 1 && tile / 2 >= GetTiledWidth(ctx, sizes))
+        return false;
+    return GetRowSpan(sizes, tile) <= max_row_span;
+}
+
+bool PerformanceConfigConvDepthwise::operator==(const PerformanceConfigConvDepthwise& other) const
+{
+    return tile == other.tile && block == other.block;
+}
+
+std::string PerformanceConfigConvDepthwise::ToString() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return ss.str();
+}
+
+ConvSolution GetDepthwiseConvSolution(const ConvolutionContext& ctx,
+                                      const PerformanceConfigConvDepthwise& config,
+                                      bool disableConfigOverrideFromEnv)
+{
+    const PerformanceConfigConvDepthwise* pcfg = &config;
+    PerformanceConfigConvDepthwise fromEnv;
+    if(!disableConfigOverrideFromEnv)
+    {
+        const auto p_asciz = miopen::GetStringEnv(MIOPEN_DEBUG_CONV_DEPTHWISE_PERF_VALS{});
+        if(p_asciz != nullptr && std::string(p_asciz).size() > 0)
+        {
+            if(!fromEnv.Deserialize(p_asciz) || !fromEnv.IsValid(ctx))
+            {
+                MIOPEN_LOG_E("MIOPEN_DEBUG_CONV_DEPTHWISE_PERF_VALS: "
+                             "Bad format or invalid for the problem config: "
+                             << p_asciz);
+            }
+            else
+            {
+                MIOPEN_LOG_I("Overridden from env: " << fromEnv.ToString());
+                pcfg = &fromEnv;
+            }
+        }
+    }
+
+    const auto sizes = GetDepthwiseConvSizes(ctx);
+    const auto tile  = pcfg->tile;
+    const auto block = static_cast<std::size_t>(pcfg->block);
+
+    const auto build_params = KernelBuildParameters{
+        {"MIOPEN_DW_N", sizes.n},
+        {"MIOPEN_DW_C", sizes.c},
+        {"MIOPEN_DW_M", sizes.m},
+        {"MIOPEN_DW_IN_H", sizes.hi},
+        {"MIOPEN_DW_IN_W", sizes.wi},
+        {"MIOPEN_DW_OUT_H", sizes.ho},
+        {"MIOPEN_DW_OUT_W", sizes.wo},
+        {"MIOPEN_DW_FLT_H", sizes.fy},
+        {"MIOPEN_DW_FLT_W", sizes.fx},
+        {"MIOPEN_DW_STRIDE_H", sizes.sy},
+        {"MIOPEN_DW_STRIDE_W", sizes.sx},
+        {"MIOPEN_DW_DILATION_H", sizes.dy},
+        {"MIOPEN_DW_DILATION_W", sizes.dx},
+        {"MIOPEN_DW_PAD_H", sizes.py},
+        {"MIOPEN_DW_PAD_W", sizes.px},
+        {"MIOPEN_DW_NHWC", ctx.IsLayoutNHWC() ? 1 : 0},
+        {"MIOPEN_DW_TILE", tile},
+        {"MIOPEN_DW_BLOCK", pcfg->block},
+    };
+
+    auto kernel         = KernelInfo{};
+    kernel.kernel_file  = "MIOpenConvDepthwise.cl";
+    kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{}) + ctx.general_compile_options;
+
+    auto work_items = std::size_t{0};
+    if(ctx.direction.IsForward())
+    {
+        kernel.kernel_name = "MIOpenConvDepthwiseFwd";
+        work_items         = static_cast<std::size_t>(sizes.n) * sizes.c * sizes.m * sizes.ho *
+                     Ceil(sizes.wo, tile);
+    }
+    else if(ctx.direction.IsBackwardData())
+    {
+        kernel.kernel_name = "MIOpenConvDepthwiseBwd";
+        work_items =
+            static_cast<std::size_t>(sizes.n) * sizes.c * sizes.hi * Ceil(sizes.wi, tile);
+    }
+    else
+    {
+        // A work-group per filter.
+        kernel.kernel_name = "MIOpenConvDepthwiseWrw";
+        work_items         = static_cast<std::size_t>(sizes.c) * sizes.m * block;
+    }
+
+    kernel.l_wk = {block, 1, 1};
+    kernel.g_wk = {(work_items + block - 1) / block * block, 1, 1};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+    result.construction_params.push_back(kernel);
+    result.workspce_sz = 0;
+
+    if(ctx.direction.IsBackwardWrW())
+    {
+        result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+            const auto kern = kernels[0];
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+                decltype(auto) wrw_ctx = primitive_parameters.CastTo<conv::WrWInvokeParams>();
+                const auto& tensors    = wrw_ctx.tensors;
+                handle.Run(kern)(tensors.x, tensors.dw, tensors.dy);
+            };
+        };
+    }
+    else
+    {
+        result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+            const auto kern = kernels[0];
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+                decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
+                const auto& tensors     = data_ctx.tensors;
+                handle.Run(kern)(tensors.in, tensors.w, tensors.out);
+            };
+        };
+    }
+
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver/conv_depthwise.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/generic_search.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DEPTHWISE_BWD)
+
+namespace miopen {
+namespace solver {
+
+bool ConvDepthwiseBwd::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_DEPTHWISE_BWD{}))
+        return false;
+    if(!ctx.direction.IsBackwardData())
+        return false;
+    return IsDepthwiseConvApplicable(ctx);
+}
+
+/// The kernels are memory bound and reach a good part of the bandwidth, so that they are
+/// preferred to the generic direct and GEMM solvers, which depthwise problems fall to otherwise.
+float ConvDepthwiseBwd::GetWti(const ConvolutionContext&) const { return 0.5f; }
+
+PerformanceConfigConvDepthwise
+ConvDepthwiseBwd::GetPerformanceConfig(const ConvolutionContext& ctx) const
+{
+    PerformanceConfigConvDepthwise config;
+    config.HeuristicInit(ctx);
+    MIOPEN_LOG_I(config.ToString());
+    return config;
+}
+
+bool ConvDepthwiseBwd::IsValidPerformanceConfig(const ConvolutionContext& ctx,
+                                                const PerformanceConfigConvDepthwise& config) const
+{
+    return config.IsValidValue() && config.IsValid(ctx);
+}
+
+PerformanceConfigConvDepthwise ConvDepthwiseBwd::Search(const ConvolutionContext& ctx,
+                                                        const AnyInvokeParams& invoke_ctx) const
+{
+    return GenericSearch(*this, ctx, invoke_ctx);
+}
+
+ConvSolution ConvDepthwiseBwd::GetSolution(const ConvolutionContext& ctx,
+                                           const PerformanceConfigConvDepthwise& config,
+                                           bool disableConfigOverrideFromEnv) const
+{
+    return GetDepthwiseConvSolution(ctx, config, disableConfigOverrideFromEnv);
+}
+
+} // namespace solver
+} // namespace miopen
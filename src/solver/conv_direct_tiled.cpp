@@ -0,0 +1,345 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver/conv_direct_tiled.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/sequences.hpp>
+
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT_TILED_PERF_VALS)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+// Must match the kernel.
+constexpr int block_size = 256;
+constexpr int vector     = 4;
+
+// clang-format off
+auto PerfFieldRules()
+{
+    return seq::MakeRuleSet(
+        std::make_tuple(seq::Sequence<int, 32, 64>{}, &PerformanceConfigConvDirectTiled::tile_m),
+        std::make_tuple(seq::Sequence<int, 32, 64>{}, &PerformanceConfigConvDirectTiled::tile_n)
+    );
+}
+// clang-format on
+
+std::size_t InPixels(const DirectTiledSizes& s)
+{
+    return static_cast<std::size_t>(s.di) * s.hi * s.wi;
+}
+
+std::size_t OutPixels(const DirectTiledSizes& s)
+{
+    return static_cast<std::size_t>(s.do_) * s.ho * s.wo;
+}
+
+std::size_t FilterTaps(const DirectTiledSizes& s)
+{
+    return static_cast<std::size_t>(s.fz) * s.fy * s.fx;
+}
+
+/// M and N of the GEMM of a group, see MIOpenConvDirectTiled.cl.
+std::tuple<std::size_t, std::size_t> GetGemmSizes(const ConvolutionContext& ctx,
+                                                  const DirectTiledSizes& s)
+{
+    if(ctx.direction.IsForward())
+        return std::make_tuple(s.n * OutPixels(s), static_cast<std::size_t>(s.kg));
+    if(ctx.direction.IsBackwardData())
+        return std::make_tuple(s.n * InPixels(s), static_cast<std::size_t>(s.cg));
+    return std::make_tuple(static_cast<std::size_t>(s.kg), FilterTaps(s) * s.cg);
+}
+
+/// Vector widths of the loads of the A and B matrices. A vector must not cross a pixel, a
+/// filter tap or an image, see the contiguous dimensions in MIOpenConvDirectTiled.cl.
+std::tuple<int, int> GetVectorWidths(const ConvolutionContext& ctx, const DirectTiledSizes& s)
+{
+    const auto nhwc    = ctx.IsLayoutNHWC();
+    const auto fits    = [](std::size_t size) { return size % vector == 0 ? vector : 1; };
+    const auto nhwc_cg = nhwc ? fits(s.cg) : 1;
+    const auto nhwc_kg = nhwc ? fits(s.kg) : 1;
+    if(ctx.direction.IsForward())
+        return std::make_tuple(nhwc_cg, fits(FilterTaps(s) * s.cg));
+    if(ctx.direction.IsBackwardData())
+        return std::make_tuple(nhwc_kg, nhwc_cg);
+    return std::make_tuple(nhwc ? nhwc_kg : fits(OutPixels(s)), nhwc_cg);
+}
+
+std::size_t Ceil(std::size_t value, std::size_t divisor) { return (value + divisor - 1) / divisor; }
+
+} // namespace
+
+DirectTiledSizes GetDirectTiledSizes(const ConvolutionContext& ctx)
+{
+    auto sizes = DirectTiledSizes{};
+    sizes.n    = ctx.batch_sz;
+    sizes.g    = ctx.group_counts;
+    if(ctx.direction.IsForward())
+    {
+        sizes.cg  = ctx.n_inputs / ctx.group_counts;
+        sizes.kg  = ctx.n_outputs / ctx.group_counts;
+        sizes.di  = ctx.in_depth;
+        sizes.hi  = ctx.in_height;
+        sizes.wi  = ctx.in_width;
+        sizes.do_ = ctx.out_depth;
+        sizes.ho  = ctx.out_height;
+        sizes.wo  = ctx.out_width;
+    }
+    else
+    {
+        sizes.cg  = ctx.n_outputs / ctx.group_counts;
+        sizes.kg  = ctx.n_inputs / ctx.group_counts;
+        sizes.di  = ctx.out_depth;
+        sizes.hi  = ctx.out_height;
+        sizes.wi  = ctx.out_width;
+        sizes.do_ = ctx.in_depth;
+        sizes.ho  = ctx.in_height;
+        sizes.wo  = ctx.in_width;
+    }
+    sizes.fz = ctx.kernel_size_d;
+    sizes.fy = ctx.kernel_size_h;
+    sizes.fx = ctx.kernel_size_w;
+    sizes.sz = ctx.kernel_stride_d;
+    sizes.sy = ctx.kernel_stride_h;
+    sizes.sx = ctx.kernel_stride_w;
+    sizes.dz = ctx.kernel_dilation_d;
+    sizes.dy = ctx.kernel_dilation_h;
+    sizes.dx = ctx.kernel_dilation_w;
+    sizes.pz = ctx.pad_d;
+    sizes.py = ctx.pad_h;
+    sizes.px = ctx.pad_w;
+    if(ctx.Is2d())
+    {
+        sizes.di  = 1;
+        sizes.do_ = 1;
+        sizes.fz  = 1;
+        sizes.sz  = 1;
+        sizes.dz  = 1;
+        sizes.pz  = 0;
+    }
+    return sizes;
+}
+
+bool IsDirectTiledApplicable(const ConvolutionContext& ctx)
+{
+    if(!ctx.use_opencl_convolutions)
+        return false;
+    if(!ctx.Is2d() && !ctx.Is3d())
+        return false;
+    if(!ctx.IsLayoutDefault() && !ctx.IsLayoutNHWC())
+        return false;
+    if(!(ctx.IsFp32() || ctx.IsFp16() || ctx.IsBfp16()))
+        return false;
+    if(ctx.in_data_type != ctx.weights_data_type || ctx.in_data_type != ctx.out_data_type)
+        return false;
+    if(ctx.n_inputs % ctx.group_counts != 0 || ctx.n_outputs % ctx.group_counts != 0)
+        return false;
+
+    // The kernel indexes the tensors with 32-bit integers.
+    const auto sizes        = GetDirectTiledSizes(ctx);
+    const auto max_elements = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    const auto x_elements   = sizes.n * InPixels(sizes) * sizes.g * sizes.cg;
+    const auto y_elements   = sizes.n * OutPixels(sizes) * sizes.g * sizes.kg;
+    const auto w_elements   = FilterTaps(sizes) * sizes.g * sizes.kg * sizes.cg;
+    return x_elements <= max_elements && y_elements <= max_elements &&
+           w_elements <= max_elements;
+}
+
+void PerformanceConfigConvDirectTiled::HeuristicInit(const ConvolutionContext& ctx)
+{
+    const auto sizes = GetDirectTiledSizes(ctx);
+    std::size_t m, n;
+    std::tie(m, n) = GetGemmSizes(ctx, sizes);
+
+    tile_m = m >= 64 ? 64 : 32;
+    tile_n = n >= 64 ? 64 : 32;
+
+    // Smaller tiles while there are too few work-groups to occupy every compute unit twice.
+    const auto target = 2 * ctx.GetStream().GetMaxComputeUnits();
+    const auto tiles  = [&]() { return Ceil(m, tile_m) * Ceil(n, tile_n) * sizes.g; };
+    if(tile_n == 64 && tiles() < target)
+        tile_n = 32;
+    if(tile_m == 64 && tiles() < target)
+        tile_m = 32;
+}
+
+bool PerformanceConfigConvDirectTiled::IsValidValue() const
+{
+    return PerfFieldRules().IsIn(*this);
+}
+
+bool PerformanceConfigConvDirectTiled::SetNextValue(const ConvolutionContext& /*ctx*/)
+{
+    return !PerfFieldRules().Next(*this);
+}
+
+bool PerformanceConfigConvDirectTiled::IsValid(const ConvolutionContext& ctx) const
+{
+    if(!IsValidValue())
+        return false;
+
+    std::size_t m, n;
+    std::tie(m, n) = GetGemmSizes(ctx, GetDirectTiledSizes(ctx));
+    // Tiles larger than the GEMM only waste the work-items.
+    return !(tile_m > 32 && tile_m / 2 >= m) && !(tile_n > 32 && tile_n / 2 >= n);
+}
+
+bool PerformanceConfigConvDirectTiled::operator==(
+    const PerformanceConfigConvDirectTiled& other) const
+{
+    return tile_m == other.tile_m && tile_n == other.tile_n;
+}
+
+std::string PerformanceConfigConvDirectTiled::ToString() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return ss.str();
+}
+
+ConvSolution GetDirectTiledSolution(const ConvolutionContext& ctx,
+                                    const PerformanceConfigConvDirectTiled& config,
+                                    bool disableConfigOverrideFromEnv,
+                                    bool bn_stats,
+                                    const DirectTiledEpilogue& epilogue)
+{
+    const PerformanceConfigConvDirectTiled* pcfg = &config;
+    PerformanceConfigConvDirectTiled fromEnv;
+    if(!disableConfigOverrideFromEnv)
+    {
+        const auto p_asciz = miopen::GetStringEnv(MIOPEN_DEBUG_CONV_DIRECT_TILED_PERF_VALS{});
+        if(p_asciz != nullptr && std::string(p_asciz).size() > 0)
+        {
+            if(!fromEnv.Deserialize(p_asciz) || !fromEnv.IsValid(ctx))
+            {
+                MIOPEN_LOG_E("MIOPEN_DEBUG_CONV_DIRECT_TILED_PERF_VALS: "
+                             "Bad format or invalid for the problem config: "
+                             << p_asciz);
+            }
+            else
+            {
+                MIOPEN_LOG_I("Overridden from env: " << fromEnv.ToString());
+                pcfg = &fromEnv;
+            }
+        }
+    }
+
+    const auto sizes = GetDirectTiledSizes(ctx);
+    const auto dir   = ctx.direction.IsForward() ? 0 : (ctx.direction.IsBackwardData() ? 1 : 2);
+    int vec_a, vec_b;
+    std::tie(vec_a, vec_b) = GetVectorWidths(ctx, sizes);
+
+    auto build_params = KernelBuildParameters{
+        {"MIOPEN_DT_DIR", dir},
+        {"MIOPEN_DT_NHWC", ctx.IsLayoutNHWC() ? 1 : 0},
+        {"MIOPEN_DT_N", sizes.n},
+        {"MIOPEN_DT_G", sizes.g},
+        {"MIOPEN_DT_CG", sizes.cg},
+        {"MIOPEN_DT_KG", sizes.kg},
+        {"MIOPEN_DT_DI", sizes.di},
+        {"MIOPEN_DT_HI", sizes.hi},
+        {"MIOPEN_DT_WI", sizes.wi},
+        {"MIOPEN_DT_DO", sizes.do_},
+        {"MIOPEN_DT_HO", sizes.ho},
+        {"MIOPEN_DT_WO", sizes.wo},
+        {"MIOPEN_DT_FZ", sizes.fz},
+        {"MIOPEN_DT_FY", sizes.fy},
+        {"MIOPEN_DT_FX", sizes.fx},
+        {"MIOPEN_DT_SZ", sizes.sz},
+        {"MIOPEN_DT_SY", sizes.sy},
+        {"MIOPEN_DT_SX", sizes.sx},
+        {"MIOPEN_DT_DZ", sizes.dz},
+        {"MIOPEN_DT_DY", sizes.dy},
+        {"MIOPEN_DT_DX", sizes.dx},
+        {"MIOPEN_DT_PZ", sizes.pz},
+        {"MIOPEN_DT_PY", sizes.py},
+        {"MIOPEN_DT_PX", sizes.px},
+        {"MIOPEN_DT_TILE_M", pcfg->tile_m},
+        {"MIOPEN_DT_TILE_N", pcfg->tile_n},
+        {"MIOPEN_DT_VEC_A", vec_a},
+        {"MIOPEN_DT_VEC_B", vec_b},
+        {"MIOPEN_DT_BN_STATS", bn_stats && dir == 0 ? 1 : 0},
+        {"MIOPEN_DT_BIAS", epilogue.bias && dir == 0 ? 1 : 0},
+        {"MIOPEN_DT_RESIDUAL", epilogue.residual && dir == 0 ? 1 : 0},
+        {"MIOPEN_DT_ACTIV", epilogue.activ && dir == 0 ? 1 : 0},
+    };
+    if(epilogue.activ && dir == 0)
+        build_params.Define("MIOPEN_NRN_OP_ID", static_cast<int>(*epilogue.activ));
+
+    std::size_t m, n;
+    std::tie(m, n)   = GetGemmSizes(ctx, sizes);
+    const auto tiles = Ceil(m, pcfg->tile_m) * Ceil(n, pcfg->tile_n) * sizes.g;
+
+    auto kernel         = KernelInfo{};
+    kernel.kernel_file  = "MIOpenConvDirectTiled.cl";
+    kernel.kernel_name  = "MIOpenConvDirectTiled";
+    kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{}) + ctx.general_compile_options;
+    kernel.l_wk         = {block_size, 1, 1};
+    kernel.g_wk         = {tiles * block_size, 1, 1};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+    result.construction_params.push_back(kernel);
+    result.workspce_sz = 0;
+
+    if(ctx.direction.IsBackwardWrW())
+    {
+        result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+            const auto kern = kernels[0];
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+                decltype(auto) wrw_ctx = primitive_parameters.CastTo<conv::WrWInvokeParams>();
+                const auto& tensors    = wrw_ctx.tensors;
+                handle.Run(kern)(tensors.dy, tensors.x, tensors.dw);
+            };
+        };
+    }
+    else
+    {
+        // Backward data reads dy as in and writes dx as out.
+        result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+            const auto kern = kernels[0];
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+                decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
+                const auto& tensors     = data_ctx.tensors;
+                handle.Run(kern)(tensors.in, tensors.w, tensors.out);
+            };
+        };
+    }
+
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -30,6 +30,7 @@
 #include <miopen/generic_search.hpp>
 #include <miopen/hip_build_utils.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
+#include <miopen/solver/gemm_cost_model.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_V4R4_XDLOPS)
 
@@ -845,6 +846,8 @@ ConvHipImplicitGemmForwardV4R4Xdlops::CalculateGemmSize(const ConvolutionContext
 PerformanceImplicitGemmForwardV4R4Xdlops
 ConvHipImplicitGemmForwardV4R4Xdlops::GetPerformanceConfig(const ConvolutionContext& ctx) const
 {
+    if(const auto by_cost = GetCostModelConfig(*this, ctx))
+        return *by_cost;
     PerformanceImplicitGemmForwardV4R4Xdlops config;
     config.HeuristicInit(ctx);
     MIOPEN_LOG_I(config.ToString());
@@ -1024,5 +1027,37 @@ ConvHipImplicitGemmForwardV4R4Xdlops::Search(const ConvolutionContext& ctx,
     return GenericSearch(*this, ctx, invoke_ctx);
 }
 
+float ConvHipImplicitGemmForwardV4R4Xdlops::EstimateCost(
+    const ConvolutionContext& ctx, const PerformanceImplicitGemmForwardV4R4Xdlops& config) const
+{
+    int gemm_g = 0;
+    int gemm_m = 0;
+    int gemm_n = 0;
+    int gemm_k = 0;
+    std::tie(gemm_g, gemm_m, gemm_n, gemm_k) = CalculateGemmSize(ctx);
+
+    int block_size = 0;
+    bool valid     = false;
+    std::tie(block_size, valid) = config.CalculateBlockSize();
+    if(!valid)
+        return std::numeric_limits<float>::max();
+
+    std::size_t lds_size = 0;
+    std::tie(lds_size, std::ignore) = config.CalculateLdsNumberOfByte(ctx);
+
+    GemmTileShape shape;
+    shape.gemm_g      = gemm_g;
+    shape.gemm_m      = gemm_m;
+    shape.gemm_n      = gemm_n;
+    shape.gemm_k      = gemm_k;
+    shape.m_per_block = config.GemmMPerBlock;
+    shape.n_per_block = config.GemmNPerBlock;
+    // GemmKPerBlock counts packs of GemmKPack.
+    shape.k_per_block = config.GemmKPerBlock * config.GemmKPack;
+    shape.block_size  = block_size;
+    shape.lds_size    = lds_size;
+    return EstimateGemmTileCost(shape, ctx.GetStream().GetMaxComputeUnits());
+}
+
 } // namespace solver
 } // namespace miopen
@@ -0,0 +1,277 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/sequences.hpp>
+#include <miopen/solver/implicitgemm_util.hpp>
+
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_XDLOPS_INT8_NHWC)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_XDLOPS_INT8_NHWC_PERF_VALS)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+// Must match the kernel.
+constexpr int block_size = 256;
+
+// clang-format off
+auto PerfFieldRules()
+{
+    return seq::MakeRuleSet(
+        std::make_tuple(seq::Sequence<int, 32, 64, 128>{},
+                        &PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc::block_m),
+        std::make_tuple(seq::Sequence<int, 32, 64, 128>{},
+                        &PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc::block_n)
+    );
+}
+// clang-format on
+
+/// Sizes in the terms of the forward direction.
+struct Int8ConvSizes
+{
+    int n, g, kg, cg, hi, wi, ho, wo, fy, fx;
+
+    std::size_t Pixels() const { return static_cast<std::size_t>(n) * ho * wo; }
+};
+
+Int8ConvSizes GetSizes(const ConvolutionContext& ctx)
+{
+    auto sizes = Int8ConvSizes{};
+    sizes.n    = ctx.batch_sz;
+    sizes.g    = ctx.group_counts;
+    sizes.kg   = ctx.n_outputs / ctx.group_counts;
+    sizes.cg   = ctx.n_inputs / ctx.group_counts;
+    sizes.hi   = ctx.in_height;
+    sizes.wi   = ctx.in_width;
+    sizes.ho   = ctx.out_height;
+    sizes.wo   = ctx.out_width;
+    sizes.fy   = ctx.kernel_size_h;
+    sizes.fx   = ctx.kernel_size_w;
+    return sizes;
+}
+
+std::size_t Ceil(std::size_t value, std::size_t divisor) { return (value + divisor - 1) / divisor; }
+
+std::size_t GetGridSize(const Int8ConvSizes& sizes,
+                        const PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc& config)
+{
+    return Ceil(sizes.Pixels(), config.block_m) * Ceil(sizes.kg, config.block_n) * sizes.g;
+}
+
+} // namespace
+
+void PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc::HeuristicInit(
+    const ConvolutionContext& ctx)
+{
+    const auto sizes = GetSizes(ctx);
+
+    block_n = sizes.kg >= 128 ? 128 : (sizes.kg >= 64 ? 64 : 32);
+
+    // The biggest tiles which still occupy every compute unit twice.
+    const auto target = 2 * ctx.GetStream().GetMaxComputeUnits();
+    block_m           = 128;
+    while(block_m > 32 && GetGridSize(sizes, *this) < target)
+        block_m /= 2;
+}
+
+bool PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc::IsValidValue() const
+{
+    return PerfFieldRules().IsIn(*this);
+}
+
+bool PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc::SetNextValue(
+    const ConvolutionContext& /*ctx*/)
+{
+    return !PerfFieldRules().Next(*this);
+}
+
+bool PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc::IsValid(
+    const ConvolutionContext& ctx) const
+{
+    if(!IsValidValue())
+        return false;
+    // Tiles twice as wide as the output channels only waste the matrix cores.
+    return block_n == 32 || block_n / 2 < GetSizes(ctx).kg;
+}
+
+bool PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc::operator==(
+    const PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc& other) const
+{
+    return block_m == other.block_m && block_n == other.block_n;
+}
+
+std::string PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc::ToString() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return ss.str();
+}
+
+bool ConvHipImplicitGemmFwdXdlopsInt8Nhwc::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_XDLOPS_INT8_NHWC{}))
+        return false;
+    if(!ctx.use_hip_kernels)
+        return false;
+    if(!IsXdlopsSupport(ctx))
+        return false;
+    if(!ctx.direction.IsForward())
+        return false;
+    if(!ctx.Is2d())
+        return false;
+    if(!ctx.IsLayoutNHWC())
+        return false;
+    if(ctx.in_data_type != miopenInt8 || ctx.weights_data_type != miopenInt8)
+        return false;
+    if(ctx.out_data_type != miopenInt32 && ctx.out_data_type != miopenFloat)
+        return false;
+    if(ctx.n_inputs % ctx.group_counts != 0 || ctx.n_outputs % ctx.group_counts != 0)
+        return false;
+
+    // Four channels of a group are loaded as a dword.
+    const auto sizes = GetSizes(ctx);
+    if(sizes.cg % 4 != 0)
+        return false;
+
+    // The kernel indexes the tensors with 32-bit integers.
+    const auto max_elements = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    const auto x_elements =
+        static_cast<std::size_t>(sizes.n) * sizes.g * sizes.cg * sizes.hi * sizes.wi;
+    const auto y_elements = sizes.Pixels() * sizes.g * sizes.kg;
+    return x_elements <= max_elements && y_elements <= max_elements;
+}
+
+PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc
+ConvHipImplicitGemmFwdXdlopsInt8Nhwc::GetPerformanceConfig(const ConvolutionContext& ctx) const
+{
+    PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc config;
+    config.HeuristicInit(ctx);
+    MIOPEN_LOG_I(config.ToString());
+    return config;
+}
+
+bool ConvHipImplicitGemmFwdXdlopsInt8Nhwc::IsValidPerformanceConfig(
+    const ConvolutionContext& ctx,
+    const PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc& config) const
+{
+    return config.IsValidValue() && config.IsValid(ctx);
+}
+
+PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc
+ConvHipImplicitGemmFwdXdlopsInt8Nhwc::Search(const ConvolutionContext& ctx,
+                                             const AnyInvokeParams& invoke_ctx) const
+{
+    return GenericSearch(*this, ctx, invoke_ctx);
+}
+
+ConvSolution ConvHipImplicitGemmFwdXdlopsInt8Nhwc::GetSolution(
+    const ConvolutionContext& ctx,
+    const PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc& config,
+    bool disableConfigOverrideFromEnv) const
+{
+    const PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc* pcfg = &config;
+    PerformanceConfigHipImplicitGemmFwdXdlopsInt8Nhwc fromEnv;
+    if(!disableConfigOverrideFromEnv)
+    {
+        const auto p_asciz = miopen::GetStringEnv(
+            MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_XDLOPS_INT8_NHWC_PERF_VALS{});
+        if(p_asciz != nullptr && std::string(p_asciz).size() > 0)
+        {
+            if(!fromEnv.Deserialize(p_asciz) || !fromEnv.IsValid(ctx))
+            {
+                MIOPEN_LOG_E("MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_XDLOPS_INT8_NHWC_PERF_VALS: "
+                             "Bad format or invalid for the problem config: "
+                             << p_asciz);
+            }
+            else
+            {
+                MIOPEN_LOG_I("Overridden from env: " << fromEnv.ToString());
+                pcfg = &fromEnv;
+            }
+        }
+    }
+
+    const auto sizes = GetSizes(ctx);
+
+    const auto build_params = KernelBuildParameters{
+        {"MIOPEN_I8_N", sizes.n},
+        {"MIOPEN_I8_G", sizes.g},
+        {"MIOPEN_I8_KG", sizes.kg},
+        {"MIOPEN_I8_CG", sizes.cg},
+        {"MIOPEN_I8_HI", sizes.hi},
+        {"MIOPEN_I8_WI", sizes.wi},
+        {"MIOPEN_I8_HO", sizes.ho},
+        {"MIOPEN_I8_WO", sizes.wo},
+        {"MIOPEN_I8_FY", sizes.fy},
+        {"MIOPEN_I8_FX", sizes.fx},
+        {"MIOPEN_I8_SY", ctx.kernel_stride_h},
+        {"MIOPEN_I8_SX", ctx.kernel_stride_w},
+        {"MIOPEN_I8_DY", ctx.kernel_dilation_h},
+        {"MIOPEN_I8_DX", ctx.kernel_dilation_w},
+        {"MIOPEN_I8_PY", ctx.pad_h},
+        {"MIOPEN_I8_PX", ctx.pad_w},
+        {"MIOPEN_I8_BM", pcfg->block_m},
+        {"MIOPEN_I8_BN", pcfg->block_n},
+        {"MIOPEN_I8_OUT_FLOAT", ctx.out_data_type == miopenFloat ? 1 : 0},
+    };
+
+    auto kernel         = KernelInfo{};
+    kernel.kernel_file  = "MIOpenConvFwdXdlopsInt8Nhwc.cpp";
+    kernel.kernel_name  = "MIOpenConvFwdXdlopsInt8Nhwc";
+    kernel.comp_options = build_params.GenerateFor(kbp::HIP{}) + ctx.general_compile_options;
+    kernel.l_wk         = {block_size, 1, 1};
+    kernel.g_wk         = {GetGridSize(sizes, *pcfg) * block_size, 1, 1};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+    result.construction_params.push_back(kernel);
+    result.workspce_sz = 0;
+
+    result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+        const auto kern = kernels[0];
+        return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+            decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
+            const auto& tensors     = data_ctx.tensors;
+            handle.Run(kern)(tensors.in, tensors.w, tensors.out);
+        };
+    };
+
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,290 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/sequences.hpp>
+#include <miopen/solver/implicitgemm_util.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_WINOGRAD_HIP_FUSED_XDLOPS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_WINOGRAD_HIP_FUSED_XDLOPS_PERF_VALS)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+// Must match the kernel.
+constexpr int block_size      = 256;
+constexpr int chunk_c         = 16;
+constexpr std::size_t max_lds = 64 * 1024;
+
+// clang-format off
+auto PerfFieldRules()
+{
+    return seq::MakeRuleSet(
+        std::make_tuple(seq::Sequence<int, 4, 6>{}, &PerformanceConfigHipWinogradFusedXdlops::tile),
+        std::make_tuple(seq::Sequence<int, 16, 32>{},
+                        &PerformanceConfigHipWinogradFusedXdlops::block_t),
+        std::make_tuple(seq::Sequence<int, 16, 32>{},
+                        &PerformanceConfigHipWinogradFusedXdlops::block_k)
+    );
+}
+// clang-format on
+
+/// Sizes in the terms of the forward direction.
+struct WinogradSizes
+{
+    int n, g, kg, cg, hi, wi, ho, wo;
+
+    std::size_t Tiles(int tile) const
+    {
+        return static_cast<std::size_t>(n) * ((ho + tile - 1) / tile) * ((wo + tile - 1) / tile);
+    }
+};
+
+WinogradSizes GetSizes(const ConvolutionContext& ctx)
+{
+    auto sizes = WinogradSizes{};
+    sizes.n    = ctx.batch_sz;
+    sizes.g    = ctx.group_counts;
+    sizes.kg   = ctx.n_outputs / ctx.group_counts;
+    sizes.cg   = ctx.n_inputs / ctx.group_counts;
+    sizes.hi   = ctx.in_height;
+    sizes.wi   = ctx.in_width;
+    sizes.ho   = ctx.out_height;
+    sizes.wo   = ctx.out_width;
+    return sizes;
+}
+
+std::size_t Ceil(std::size_t value, std::size_t divisor) { return (value + divisor - 1) / divisor; }
+
+std::size_t GetGridSize(const WinogradSizes& sizes,
+                        const PerformanceConfigHipWinogradFusedXdlops& config)
+{
+    return Ceil(sizes.Tiles(config.tile), config.block_t) * Ceil(sizes.kg, config.block_k) *
+           sizes.g;
+}
+
+/// The kernel keeps either the transformed inputs and filters of a step or the products of
+/// one 16x16 block for every position of the tile in LDS.
+std::size_t GetLdsSize(const PerformanceConfigHipWinogradFusedXdlops& config)
+{
+    const auto alpha  = static_cast<std::size_t>(config.tile) + 2;
+    const auto transf = alpha * alpha * (config.block_t + config.block_k) * chunk_c * 2;
+    const auto prods  = alpha * alpha * 16 * 16 * 4;
+    return std::max(transf, prods);
+}
+
+} // namespace
+
+void PerformanceConfigHipWinogradFusedXdlops::HeuristicInit(const ConvolutionContext& ctx)
+{
+    const auto sizes = GetSizes(ctx);
+
+    // F(6x6,3x3) saves a further fifth of the multiplications, but its transforms lose about
+    // twice the precision of F(4x4,3x3) in fp16. It is left to the tuning.
+    tile    = 4;
+    block_k = sizes.kg > 16 ? 32 : 16;
+
+    // Bigger tiles only while every compute unit still gets two work-groups.
+    const auto target = 2 * ctx.GetStream().GetMaxComputeUnits();
+    block_t           = block_k == 16 ? 32 : 16;
+    if(block_t > 16 && (sizes.Tiles(tile) <= 16 || GetGridSize(sizes, *this) < target))
+        block_t = 16;
+}
+
+bool PerformanceConfigHipWinogradFusedXdlops::IsValidValue() const
+{
+    return PerfFieldRules().IsIn(*this);
+}
+
+bool PerformanceConfigHipWinogradFusedXdlops::SetNextValue(const ConvolutionContext& /*ctx*/)
+{
+    return !PerfFieldRules().Next(*this);
+}
+
+bool PerformanceConfigHipWinogradFusedXdlops::IsValid(const ConvolutionContext& ctx) const
+{
+    if(!IsValidValue())
+        return false;
+    if(GetLdsSize(*this) > max_lds)
+        return false;
+    // Blocks twice as big as the problem only waste the matrix cores.
+    const auto sizes = GetSizes(ctx);
+    return (block_k == 16 || sizes.kg > 16) && (block_t == 16 || sizes.Tiles(tile) > 16);
+}
+
+bool PerformanceConfigHipWinogradFusedXdlops::operator==(
+    const PerformanceConfigHipWinogradFusedXdlops& other) const
+{
+    return tile == other.tile && block_t == other.block_t && block_k == other.block_k;
+}
+
+std::string PerformanceConfigHipWinogradFusedXdlops::ToString() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return ss.str();
+}
+
+bool ConvHipWinogradFusedXdlops::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_WINOGRAD_HIP_FUSED_XDLOPS{}))
+        return false;
+    if(!ctx.use_hip_kernels)
+        return false;
+    if(!IsXdlopsSupport(ctx))
+        return false;
+    if(!ctx.direction.IsForward())
+        return false;
+    if(!ctx.Is2d())
+        return false;
+    if(!ctx.IsLayoutDefault())
+        return false;
+    if(!ctx.IsFp16())
+        return false;
+    if(ctx.bias != 0)
+        return false;
+    if(ctx.kernel_size_h != 3 || ctx.kernel_size_w != 3)
+        return false;
+    if(ctx.kernel_stride_h != 1 || ctx.kernel_stride_w != 1)
+        return false;
+    if(ctx.kernel_dilation_h != 1 || ctx.kernel_dilation_w != 1)
+        return false;
+    if(ctx.n_inputs % ctx.group_counts != 0 || ctx.n_outputs % ctx.group_counts != 0)
+        return false;
+
+    // The kernel indexes the images of the tensors and the tiles with 32-bit integers.
+    const auto sizes        = GetSizes(ctx);
+    const auto max_elements = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    return sizes.Tiles(4) <= max_elements &&
+           static_cast<std::size_t>(sizes.hi) * sizes.wi <= max_elements &&
+           static_cast<std::size_t>(sizes.ho) * sizes.wo <= max_elements;
+}
+
+PerformanceConfigHipWinogradFusedXdlops
+ConvHipWinogradFusedXdlops::GetPerformanceConfig(const ConvolutionContext& ctx) const
+{
+    PerformanceConfigHipWinogradFusedXdlops config;
+    config.HeuristicInit(ctx);
+    MIOPEN_LOG_I(config.ToString());
+    return config;
+}
+
+bool ConvHipWinogradFusedXdlops::IsValidPerformanceConfig(
+    const ConvolutionContext& ctx, const PerformanceConfigHipWinogradFusedXdlops& config) const
+{
+    return config.IsValidValue() && config.IsValid(ctx);
+}
+
+PerformanceConfigHipWinogradFusedXdlops
+ConvHipWinogradFusedXdlops::Search(const ConvolutionContext& ctx,
+                                   const AnyInvokeParams& invoke_ctx) const
+{
+    return GenericSearch(*this, ctx, invoke_ctx);
+}
+
+ConvSolution
+ConvHipWinogradFusedXdlops::GetSolution(const ConvolutionContext& ctx,
+                                        const PerformanceConfigHipWinogradFusedXdlops& config,
+                                        bool disableConfigOverrideFromEnv) const
+{
+    const PerformanceConfigHipWinogradFusedXdlops* pcfg = &config;
+    PerformanceConfigHipWinogradFusedXdlops fromEnv;
+    if(!disableConfigOverrideFromEnv)
+    {
+        const auto p_asciz =
+            miopen::GetStringEnv(MIOPEN_DEBUG_CONV_WINOGRAD_HIP_FUSED_XDLOPS_PERF_VALS{});
+        if(p_asciz != nullptr && std::string(p_asciz).size() > 0)
+        {
+            if(!fromEnv.Deserialize(p_asciz) || !fromEnv.IsValid(ctx))
+            {
+                MIOPEN_LOG_E("MIOPEN_DEBUG_CONV_WINOGRAD_HIP_FUSED_XDLOPS_PERF_VALS: "
+                             "Bad format or invalid for the problem config: "
+                             << p_asciz);
+            }
+            else
+            {
+                MIOPEN_LOG_I("Overridden from env: " << fromEnv.ToString());
+                pcfg = &fromEnv;
+            }
+        }
+    }
+
+    const auto sizes = GetSizes(ctx);
+
+    const auto build_params = KernelBuildParameters{
+        {"MIOPEN_WF_N", sizes.n},
+        {"MIOPEN_WF_G", sizes.g},
+        {"MIOPEN_WF_KG", sizes.kg},
+        {"MIOPEN_WF_CG", sizes.cg},
+        {"MIOPEN_WF_HI", sizes.hi},
+        {"MIOPEN_WF_WI", sizes.wi},
+        {"MIOPEN_WF_HO", sizes.ho},
+        {"MIOPEN_WF_WO", sizes.wo},
+        {"MIOPEN_WF_PY", ctx.pad_h},
+        {"MIOPEN_WF_PX", ctx.pad_w},
+        {"MIOPEN_WF_TILE", pcfg->tile},
+        {"MIOPEN_WF_BT", pcfg->block_t},
+        {"MIOPEN_WF_BK", pcfg->block_k},
+    };
+
+    auto kernel         = KernelInfo{};
+    kernel.kernel_file  = "MIOpenConvWinogradFusedXdlopsFp16.cpp";
+    kernel.kernel_name  = "MIOpenConvWinogradFusedXdlopsFp16";
+    kernel.comp_options = build_params.GenerateFor(kbp::HIP{}) + ctx.general_compile_options;
+    kernel.l_wk         = {block_size, 1, 1};
+    kernel.g_wk         = {GetGridSize(sizes, *pcfg) * block_size, 1, 1};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+    result.construction_params.push_back(kernel);
+    result.workspce_sz = 0;
+
+    result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+        const auto kern = kernels[0];
+        return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+            decltype(auto) data_ctx = primitive_parameters.CastTo<conv::DataInvokeParams>();
+            const auto& tensors     = data_ctx.tensors;
+            handle.Run(kern)(tensors.in, tensors.w, tensors.out);
+        };
+    };
+
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
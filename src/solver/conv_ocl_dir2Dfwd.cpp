@@ -472,7 +472,8 @@ inline ConvSolution BaseGetSolution(const ConvolutionContext& params,
 }
 
 ConvSolution ConvOclDirectFwd::GetSolution(const ConvolutionContext& params,
-                                           const LegacyPerformanceConfig& searched_params) const
+                                           const LegacyPerformanceConfig& searched_params,
+                                           bool) const
 {
     ConvSolution result = BaseGetSolution(params, searched_params);
 
@@ -485,9 +486,9 @@ ConvSolution ConvOclDirectFwd::GetSolution(const ConvolutionContext& params,
     return result;
 }
 
-ConvSolution
-ConvOclDirectFwdFused::GetSolution(const ConvolutionContext& params,
-                                   const LegacyPerformanceConfig& searched_params) const
+ConvSolution ConvOclDirectFwdFused::GetSolution(const ConvolutionContext& params,
+                                                const LegacyPerformanceConfig& searched_params,
+                                                bool) const
 {
     ConvSolution result = BaseGetSolution(params, searched_params);
     return result;
@@ -26,15 +26,13 @@
 
 #define MIOPEN
 
-#include <miopen/allocator.hpp>
-#include <miopen/db_path.hpp>
+#include <miopen/generic_search.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/legacy_exhaustive_search.hpp>
 #include <miopen/mlo_utils.hpp>
 #include <miopen/solver.hpp>
-#include <miopen/bfloat16.hpp>
 
-#include <half.hpp>
+#include <boost/optional.hpp>
 
 #ifdef max
 #undef max
@@ -47,6 +45,12 @@
 namespace miopen {
 namespace solver {
 
+static bool IsLegacy1x1(const ConvolutionContext& params)
+{
+    // Group conv: None 1x1 version yet, fallback to universal kernel.
+    return params.kernel_size_w == 1 && params.kernel_size_h == 1 && params.group_counts == 1;
+}
+
 /*
  * select default configuration if a known configuration has not been found.
  */
@@ -77,8 +81,7 @@ ConvOclDirectFwdLegacyExhaustiveSearch::GetPerformanceConfig(const ConvolutionCo
 
     result.n_stacks = 1; // # of diff stacks (part of batch).
 
-    if(params.kernel_size_w == 1 && params.kernel_size_h == 1 &&
-       params.group_counts == 1) // Group conv: None 1x1 version yet, fallback to universal kernel.
+    if(IsLegacy1x1(params))
     {
 
         // version
@@ -126,175 +129,12 @@ ConvOclDirectFwdLegacyExhaustiveSearch::GetPerformanceConfig(const ConvolutionCo
 }
 
 /*
- * Measure the current configuration performance.
+ * Walks the search space in the order of the legacy search, until f returns true.
  */
-template <typename Tgpu, class... Solvers>
-static int MeasurePerfConfig(const Handle& handle,
-                             ConstData_t bot_ocl_buf,
-                             Data_t top_ocl_buf,
-                             ConstData_t wei_ocl_buf,
-                             ConstData_t bias_ocl_buf,
-                             double& processing_time,
-                             const ConvolutionContext& params,
-                             const LegacyPerformanceConfig& result)
-{
-    ConvSolution kernel_search_result{miopenStatusNotInitialized};
-
-    miopen::each_args(
-        [&](auto s) {
-            if(!kernel_search_result.Succeeded()) // once
-            {
-                if(s.IsApplicable(params))
-                {
-                    if(s.IsValidPerformanceConfig(params, result))
-                    {
-                        kernel_search_result = s.GetSolution(params, result);
-                    }
-                }
-            }
-        },
-        Solvers{}...);
-
-    if(!kernel_search_result.Succeeded())
-    {
-        return 1;
-    }
-#if !MIOPEN_ALLOC_BUFFERS
-    if(params.bias && bias_ocl_buf == nullptr)
-    {
-        MIOPEN_LOG_WE("Legacy search: Bias buffer required");
-        return 2;
-    }
-#endif
-
-    MIOPEN_LOG_I2("Trying " << result);
-    const auto kernel_params     = kernel_search_result.construction_params[0];
-    std::string compiler_options = kernel_params.comp_options;
-
-    try
-    {
-        Tgpu padding_value = static_cast<Tgpu>(0);
-        processing_time    = std::numeric_limits<double>::max();
-
-        auto k = handle.AddKernel("",
-                                  "",
-                                  kernel_params.kernel_file,
-                                  kernel_params.kernel_name,
-                                  kernel_params.l_wk,
-                                  kernel_params.g_wk,
-                                  compiler_options);
-
-        if(params.bias)
-        {
-            k(bot_ocl_buf, wei_ocl_buf, bias_ocl_buf, top_ocl_buf, padding_value);
-        }
-        else
-        {
-            k(bot_ocl_buf, wei_ocl_buf, top_ocl_buf, padding_value);
-        }
-        processing_time = handle.GetKernelTime();
-    }
-    catch(miopen::Exception& ex)
-    {
-        MIOPEN_LOG_WE("Status: " << ex.status << ", Message: \"" << ex.what() << '\"');
-        return -1;
-    }
-
-    MIOPEN_LOG_I2("\t\t\t\t" << processing_time);
-    return 0;
-}
-
-LegacyPerformanceConfig
-ConvOclDirectFwdLegacyExhaustiveSearch::Search(const ConvolutionContext& params,
-                                               const AnyInvokeParams&) const
-{
-    if(params.IsFp16())
-        return SearchImpl<half_float::half>(params);
-    else if(params.IsFp32())
-        return SearchImpl<float>(params);
-    else if(params.IsBfp16())
-        return SearchImpl<bfloat16>(params);
-    else
-    {
-        MIOPEN_THROW("Unsupported float_size");
-    }
-}
-
-template <typename Tgpu>
-LegacyPerformanceConfig
-ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& params) const
+template <class F>
+static void VisitSearchSpace(const ConvolutionContext& params, F f)
 {
     LegacyPerformanceConfig result;
-    bool is_passed = false;
-
-    double processing_time = std::numeric_limits<double>::max();
-
-    LegacyPerformanceConfig candidate;
-    candidate.grp_tile0       = 16;
-    candidate.grp_tile1       = 16;
-    candidate.in_tile0        = 16;
-    candidate.in_tile1        = 16;
-    candidate.out_pix_tile0   = 1;
-    candidate.out_pix_tile1   = 1;
-    candidate.n_out_pix_tiles = 2;
-    candidate.n_in_data_tiles = 3;
-    candidate.n_stacks        = 1;
-
-#if MIOPEN_ALLOC_BUFFERS
-    miopen::Handle profile_h;
-
-    // allocate input/output buffers
-    size_t bot_sz = params.bot_sz / sizeof(Tgpu);
-    std::vector<Tgpu> bot_sys_buf(bot_sz);
-    for(size_t i = 0; i < bot_sz; i++)
-    {
-        bot_sys_buf[i] =
-            static_cast<Tgpu>(rand() * (1.0 / RAND_MAX)); // NOLINT (concurrency-mt-unsafe)
-    }
-    auto bot_ocl_buf = profile_h.Write(bot_sys_buf);
-    auto bot_ocl_ptr = bot_ocl_buf.get();
-
-    size_t top_sz = params.top_sz / sizeof(Tgpu);
-    std::vector<Tgpu> top_sys_buf(top_sz);
-    auto top_ocl_buf = profile_h.Write(top_sys_buf);
-    auto top_ocl_ptr = top_ocl_buf.get();
-
-    size_t weights_sz = params.weights_sz / sizeof(Tgpu);
-    std::vector<Tgpu> wei_sys_buf(weights_sz);
-    for(size_t i = 0; i < weights_sz; i++)
-    {
-        wei_sys_buf[i] = static_cast<Tgpu>((rand() * (1.0 / RAND_MAX) - 0.5) *
-                                           0.001); // NOLINT (concurrency-mt-unsafe)
-    }
-    auto wei_ocl_buf = profile_h.Write(wei_sys_buf);
-    auto wei_ocl_ptr = wei_ocl_buf.get();
-
-    std::vector<Tgpu> bias_sys_buf;
-    miopen::Allocator::ManageDataPtr bias_ocl_buf = nullptr;
-    if(params.bias != 0)
-    {
-        size_t bias_sz = params.bias_sz / sizeof(Tgpu);
-        bias_sys_buf   = std::vector<Tgpu>(bias_sz);
-        for(size_t i = 0; i < bias_sz; i++)
-        {
-            bias_sys_buf[i] =
-                static_cast<Tgpu>(rand() * (1.0 / RAND_MAX)); // NOLINT (concurrency-mt-unsafe)
-        }
-
-        bias_ocl_buf = profile_h.Write(bias_sys_buf);
-    }
-    auto bias_ocl_ptr = bias_ocl_buf.get();
-#else
-    auto& profile_h = params.GetStream();
-    auto bot_ocl_ptr =
-        params.direction.IsForward() ? params.GetBufs().io.fwd.x : params.GetBufs().io.bwd.dy;
-    auto top_ocl_ptr =
-        params.direction.IsForward() ? params.GetBufs().io.fwd.y : params.GetBufs().io.bwd.dx;
-    auto wei_ocl_ptr =
-        params.direction.IsForward() ? params.GetBufs().io.fwd.w : params.GetBufs().io.bwd.w;
-    auto bias_ocl_ptr = params.GetBufs().bias;
-#endif
-    AutoEnableProfiling enableProfiling{profile_h};
 
     // search loop here
     int grp_tl_ln[4]       = {8, 16, 32};
@@ -306,10 +146,6 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
     int n_in_stacks_sz[2]  = {1, 2};
     int in_tiles[4]        = {64, 128, 256, 2048};
 
-    double min_proc_time = std::numeric_limits<double>::max();
-
-    size_t run_counter = 0, failed_counter = 0;
-
     int out_pix_tl_cnt = 3; // out_pix_tile_sz[1];
     int n_out_tls      = 4;
     int n_in_tls       = 3;
@@ -331,21 +167,12 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
         n_tile1_sz  = 2;
     }
 
-    int n_tiles_cnt = n_tile0_sz * n_tile1_sz;
-
-    size_t report_inteval = 25;
-
-    long long runs_left = 0, total_runs = 0;
-
-    if(params.kernel_size_w == 1 && params.kernel_size_h == 1 &&
-       params.group_counts == 1) // Group conv: None 1x1 version yet, fallback to universal kernel.
+    if(IsLegacy1x1(params))
     {
-        MIOPEN_LOG_W("Searching the best solution in the 4 dim space. Please, be patient...");
         int n_grp_tiles0 = 3;
         result.grp_tile1 = 1;
         result.in_tile1  = 1;
         result.in_tile0  = 1;
-        report_inteval   = 5;
 
         // Add 1x1_stride : no padding support yet
         if(params.in_data_type == miopenFloat && params.direction.IsForward() &&
@@ -355,7 +182,6 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
             // uint N_LCL_IN_MAPS = result.n_in_data_tiles;
             n_in_tiles_rg[0] = 0;
             n_in_tiles_rg[1] = 3;
-            n_in_tls         = 4;
 
             //					int N_LCL_OUT_MAPS = result.n_out_pix_tiles;
             n_out_tiles_rg[0] = 4;
@@ -366,13 +192,9 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
             // result.out_pix_tile0;
             out_pix_tile_sz[0] = 0;
             out_pix_tile_sz[1] = 1;
-            n_out_tls          = (n_out_tiles_rg[1] - n_out_tiles_rg[0] + 1);
             n_grp_tiles0       = 1;
             grp_tl_ln[0]       = 64;
 
-            runs_left  = out_pix_tl_cnt * n_out_tls * n_in_tls * (n_grp_tiles0 + 1);
-            total_runs = runs_left;
-
             result.out_pix_tile1 = 1;
         }
         else
@@ -405,17 +227,10 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
             n_in_tiles_rg[0] = 2;
             n_in_tiles_rg[1] = (params.n_inputs % 8 == 0) ? 3 : 2;
 
-            grp_tl_ln[0]     = 64;
-            grp_tl_ln[1]     = 128;
-            grp_tl_ln[2]     = 256;
-            n_grp_tiles0     = 3;
-            int n_grp_tiles1 = 1;
-
-            int n_grp_tiles = n_grp_tiles1 * n_grp_tiles0;
-            n_out_tls       = (n_out_tiles_rg[1] - n_out_tiles_rg[0] + 1);
-            n_in_tls        = 2;
-            runs_left       = n_grp_tiles * out_pix_tl_cnt * n_out_tls * n_in_tls;
-            total_runs      = runs_left;
+            grp_tl_ln[0] = 64;
+            grp_tl_ln[1] = 128;
+            grp_tl_ln[2] = 256;
+            n_grp_tiles0 = 3;
 
             result.out_pix_tile1 = 0;
         }
@@ -451,44 +266,8 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
                             result.n_in_data_tiles = (1 << i_t);
                         }
 
-                        const auto ret =
-                            MeasurePerfConfig<Tgpu, ConvOclDirectFwd1x1>(profile_h,
-                                                                         bot_ocl_ptr,
-                                                                         top_ocl_ptr,
-                                                                         wei_ocl_ptr,
-                                                                         bias_ocl_ptr,
-                                                                         processing_time,
-                                                                         params,
-                                                                         result);
-                        --runs_left;
-                        if(ret != 0)
-                        {
-                            ++failed_counter;
-                            continue;
-                        }
-
-                        is_passed = true;
-                        MIOPEN_LOG_T("##(n_current, n_failed, n_runs_total): "
-                                     << run_counter << " / " << failed_counter << " / "
-                                     << total_runs << " elapsed_time: " << processing_time
-                                     << " best_time: " << processing_time << ", " << result);
-
-                        if(processing_time < min_proc_time)
-                        {
-                            MIOPEN_LOG_I('#' << run_counter << ' ' << processing_time << " < "
-                                             << min_proc_time << ' ' << result);
-                            min_proc_time = processing_time;
-                            candidate     = result;
-                        }
-
-                        if(run_counter % report_inteval == 0)
-                        {
-                            MIOPEN_LOG_W("Runs left: "
-                                         << runs_left << ", "
-                                         << "min time so far: " << min_proc_time << ", "
-                                         << "curr time: " << processing_time << ' ' << result);
-                        }
-                        run_counter++;
+                        if(f(result))
+                            return;
                     }
                 }
             }
@@ -496,145 +275,68 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
     }
     else
     {
-        MIOPEN_LOG_W("Searching the best solution in the 9 dim space. Please, be patient...");
-        runs_left = /*n_grp_tiles * */ n_tiles_cnt * out_pix_tl_cnt * out_pix_tl_cnt * n_out_tls *
-                    n_in_tls * stack_cnt;
-        total_runs = runs_left;
-
         // tile1
         for(int j = 0; j < n_tile1_sz; ++j)
         {
             int tile_sz[3]  = {8, 16, 32};
             result.in_tile1 = tile_sz1[j];
             if(params.out_height * 2 <= result.in_tile1 && result.in_tile1 > tile_sz[0])
-            {
-                --runs_left;
                 continue;
-            }
 
             // tile 0
             for(int i = 0; i < n_tile0_sz; ++i)
             {
                 result.in_tile0 = tile_sz0[i];
                 if((params.out_width * 2 <= result.in_tile0 && result.in_tile0 > tile_sz[0]))
-                {
-                    --runs_left;
                     continue;
-                }
                 if(params.out_height > 16 && params.out_width > 16 &&
                    ((result.in_tile1 == 8 && result.in_tile0 == 8) ||
                     (result.grp_tile0 == 8 && result.grp_tile1 == 8)))
-                {
-                    --runs_left;
                     continue;
-                }
                 if(params.out_width > 32 && result.in_tile1 > result.in_tile0)
-                {
-                    --runs_left;
                     continue;
-                }
-                // out pix 1
 
+                // out pix 1
                 for(int k = 0; k < out_pix_tl_cnt; ++k)
                 {
                     result.out_pix_tile1 = out_pix_tile_sz[k];
                     result.grp_tile1     = result.in_tile1 / result.out_pix_tile1;
                     if(result.out_pix_tile1 > result.in_tile1 || result.grp_tile1 < 8)
-                    {
-                        --runs_left;
                         continue;
-                    }
-                    // out pix 0
 
+                    // out pix 0
                     for(int l = 0; l < out_pix_tl_cnt; ++l)
                     {
                         result.out_pix_tile0 = out_pix_tile_sz[l];
                         result.grp_tile0     = result.in_tile0 / result.out_pix_tile0;
-
                         if(result.out_pix_tile0 > result.in_tile0 || result.grp_tile0 < 8)
-                        {
-                            --runs_left;
                             continue;
-                        }
 
                         for(int o_t = 0; o_t < n_out_tls; ++o_t)
                         {
                             result.n_out_pix_tiles = n_out_tiles_rg[o_t];
                             if(params.n_outputs < result.n_out_pix_tiles)
-                            {
-                                --runs_left;
                                 continue;
-                            }
 
                             for(int i_t = 0; i_t < n_in_tls; ++i_t)
                             {
                                 result.n_in_data_tiles = n_in_tiles_rg[i_t];
                                 if(params.n_inputs < result.n_in_data_tiles)
-                                {
-                                    --runs_left;
                                     continue;
-                                }
 
                                 for(int s = 0; s < stack_cnt; ++s)
                                 {
-
                                     result.n_stacks = n_in_stacks_sz[s];
                                     if(result.n_stacks > params.batch_sz)
-                                    {
-                                        --runs_left;
                                         continue;
-                                    }
 
                                     if(result.out_pix_tile1 * result.out_pix_tile0 *
                                            result.n_out_pix_tiles * result.n_stacks >=
                                        128)
-                                    {
-                                        --runs_left;
-                                        continue;
-                                    }
-
-                                    const auto ret =
-                                        MeasurePerfConfig<Tgpu, ConvOclDirectFwd>(profile_h,
-                                                                                  bot_ocl_ptr,
-                                                                                  top_ocl_ptr,
-                                                                                  wei_ocl_ptr,
-                                                                                  bias_ocl_ptr,
-                                                                                  processing_time,
-                                                                                  params,
-                                                                                  result);
-
-                                    --runs_left;
-                                    if(ret != 0)
-                                    {
-                                        ++failed_counter;
                                         continue;
-                                    }
-
-                                    is_passed = true;
-                                    MIOPEN_LOG_T(
-                                        "##(n_current, n_failed, n_runs_total): "
-                                        << run_counter << " / " << failed_counter << " / "
-                                        << total_runs << " elapsed_time: " << processing_time
-                                        << " best_time: " << processing_time << ", " << result);
-
-                                    if(processing_time < min_proc_time)
-                                    {
-                                        MIOPEN_LOG_I('#' << run_counter << ' ' << processing_time
-                                                         << " < " << min_proc_time << ' '
-                                                         << result);
-                                        min_proc_time = processing_time;
-                                        candidate     = result;
-                                    }
-
-                                    if(run_counter % report_inteval == 0)
-                                    {
-                                        MIOPEN_LOG_W("Runs left: "
-                                                     << runs_left << ", "
-                                                     << "min time so far: " << min_proc_time << ", "
-                                                     << "curr time: " << processing_time << ' '
-                                                     << result);
-                                    }
-                                    run_counter++;
+
+                                    if(f(result))
+                                        return;
                                 }
                             }
                         }
@@ -643,54 +345,71 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
             }
         }
     }
-    // Compare search results vs. default performance config.
-    {
-        int ret                   = -1;
-        double default_time       = std::numeric_limits<double>::max();
-        const auto default_config = GetPerformanceConfig(params);
-        if(params.kernel_size_w == 1 && params.kernel_size_h == 1 &&
-           params.group_counts ==
-               1) // Group conv: None 1x1 version yet, fallback to universal kernel.
-        {
-            ret = MeasurePerfConfig<Tgpu, ConvOclDirectFwd1x1>(profile_h,
-                                                               bot_ocl_ptr,
-                                                               top_ocl_ptr,
-                                                               wei_ocl_ptr,
-                                                               bias_ocl_ptr,
-                                                               default_time,
-                                                               params,
-                                                               default_config);
-        }
-        else
-        {
-            ret = MeasurePerfConfig<Tgpu, ConvOclDirectFwd>(profile_h,
-                                                            bot_ocl_ptr,
-                                                            top_ocl_ptr,
-                                                            wei_ocl_ptr,
-                                                            bias_ocl_ptr,
-                                                            default_time,
-                                                            params,
-                                                            default_config);
-        }
-        if(ret == 0)
+}
+
+bool LegacyPerformanceConfig::SetNextValue(const ConvolutionContext& params)
+{
+    // Each step walks the space up to the current value, which takes no time compared to the
+    // build and the run of a candidate. The values off the space are before the first one.
+    auto is_current = false;
+    auto first      = boost::optional<LegacyPerformanceConfig>{};
+    auto next       = boost::optional<LegacyPerformanceConfig>{};
+    VisitSearchSpace(params, [&](const LegacyPerformanceConfig& value) {
+        if(!first)
+            first = value;
+        if(is_current)
         {
-            is_passed = true;
-            MIOPEN_LOG_W("Default run, min time so far: " << min_proc_time << ", default time: "
-                                                          << default_time << ' ' << default_config);
-            if(min_proc_time > default_time)
-            {
-                MIOPEN_LOG_W("* * * Default time < min time, using default config * * *");
-                min_proc_time = default_time;
-                candidate     = default_config;
-            }
+            next = value;
+            return true;
         }
-        MIOPEN_LOG_W("...Score: " << (default_time / min_proc_time));
-    }
-    result = candidate;
+        is_current = (value == *this);
+        return false;
+    });
+
+    if(!is_current)
+        next = first;
+    if(!next)
+        return false;
+    *this = *next;
+    return true;
+}
 
-    if(!is_passed)
-        MIOPEN_THROW("Search failed for ConvOclDirectFwdLegacyExhaustiveSearch");
-    return result;
+bool LegacyPerformanceConfig::IsValid(const ConvolutionContext& params) const
+{
+    auto is_found = false;
+    VisitSearchSpace(params, [&](const LegacyPerformanceConfig& value) {
+        is_found = (value == *this);
+        return is_found;
+    });
+    return is_found &&
+           (IsLegacy1x1(params) || ConvOclDirectFwd{}.IsValidPerformanceConfig(params, *this));
+}
+
+bool LegacyPerformanceConfig::operator==(const LegacyPerformanceConfig& other) const
+{
+    // clang-format off
+    return grp_tile1 == other.grp_tile1
+        && grp_tile0 == other.grp_tile0
+        && in_tile1 == other.in_tile1
+        && in_tile0 == other.in_tile0
+        && out_pix_tile1 == other.out_pix_tile1
+        && out_pix_tile0 == other.out_pix_tile0
+        && n_out_pix_tiles == other.n_out_pix_tiles
+        && n_in_data_tiles == other.n_in_data_tiles
+        && n_stacks == other.n_stacks;
+    // clang-format on
+}
+
+LegacyPerformanceConfig
+ConvOclDirectFwdLegacyExhaustiveSearch::Search(const ConvolutionContext& params,
+                                               const AnyInvokeParams& invoke_ctx) const
+{
+    if(!params.IsFp16() && !params.IsFp32() && !params.IsBfp16())
+        MIOPEN_THROW("Unsupported float_size");
+
+    if(IsLegacy1x1(params))
+        return GenericSearch(ConvOclDirectFwd1x1{}, params, invoke_ctx);
+    return GenericSearch(ConvOclDirectFwd{}, params, invoke_ctx);
 }
 
 } // namespace solver
@@ -0,0 +1,326 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/sequences.hpp>
+
+#include <limits>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_FWD_STREAM_K)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_FWD_STREAM_K_PERF_VALS)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+// Must match the kernels.
+constexpr int block_size = 256;
+constexpr int block_k    = 16;
+
+constexpr int max_tile       = 64;
+constexpr int max_wgs_per_cu = 4;
+
+// clang-format off
+auto PerfFieldRules()
+{
+    return seq::MakeRuleSet(
+        std::make_tuple(seq::Sequence<int, 32, 64>{},
+                        &PerformanceConfigConvOclImplicitGemmFwdStreamK::tile),
+        std::make_tuple(seq::Sequence<int, 1, 2, 4>{},
+                        &PerformanceConfigConvOclImplicitGemmFwdStreamK::wgs_per_cu)
+    );
+}
+// clang-format on
+
+struct StreamKSizes
+{
+    int n, g, cg, kg, hi, wi, ho, wo, fy, fx;
+
+    std::size_t GemmM() const { return static_cast<std::size_t>(n) * ho * wo; }
+    std::size_t GemmN() const { return kg; }
+    std::size_t GemmK() const { return static_cast<std::size_t>(cg) * fy * fx; }
+};
+
+StreamKSizes GetSizes(const ConvolutionContext& ctx)
+{
+    auto sizes = StreamKSizes{};
+    sizes.n    = ctx.batch_sz;
+    sizes.g    = ctx.group_counts;
+    sizes.cg   = ctx.n_inputs / ctx.group_counts;
+    sizes.kg   = ctx.n_outputs / ctx.group_counts;
+    sizes.hi   = ctx.in_height;
+    sizes.wi   = ctx.in_width;
+    sizes.ho   = ctx.out_height;
+    sizes.wo   = ctx.out_width;
+    sizes.fy   = ctx.kernel_size_h;
+    sizes.fx   = ctx.kernel_size_w;
+    return sizes;
+}
+
+std::size_t Ceil(std::size_t value, std::size_t divisor) { return (value + divisor - 1) / divisor; }
+
+std::size_t GetTiles(const StreamKSizes& sizes, int tile)
+{
+    return Ceil(sizes.GemmM(), tile) * Ceil(sizes.GemmN(), tile) * sizes.g;
+}
+
+std::size_t GetItersPerTile(const StreamKSizes& sizes) { return Ceil(sizes.GemmK(), block_k); }
+
+std::size_t GetGrid(const ConvolutionContext& ctx, int wgs_per_cu)
+{
+    return ctx.GetStream().GetMaxHardwareComputeUnits() * wgs_per_cu;
+}
+
+/// Each work-group keeps the partial sums of the tile it starts in and the one it ends in.
+std::size_t GetPartialsSize(std::size_t grid, int tile)
+{
+    return grid * 2 * tile * tile * sizeof(float);
+}
+
+} // namespace
+
+void PerformanceConfigConvOclImplicitGemmFwdStreamK::HeuristicInit(const ConvolutionContext& ctx)
+{
+    const auto sizes = GetSizes(ctx);
+    tile             = sizes.GemmM() >= 64 && sizes.GemmN() >= 64 ? 64 : 32;
+
+    // More work-groups hide latencies better, but as soon as they get less than the iterations
+    // of a tile each, most tiles need a fixup.
+    const auto total_iters = GetTiles(sizes, tile) * GetItersPerTile(sizes);
+    wgs_per_cu             = max_wgs_per_cu;
+    while(wgs_per_cu > 1 && total_iters / GetGrid(ctx, wgs_per_cu) < GetItersPerTile(sizes))
+        wgs_per_cu /= 2;
+}
+
+bool PerformanceConfigConvOclImplicitGemmFwdStreamK::IsValidValue() const
+{
+    return PerfFieldRules().IsIn(*this);
+}
+
+bool PerformanceConfigConvOclImplicitGemmFwdStreamK::SetNextValue(
+    const ConvolutionContext& /*ctx*/)
+{
+    return !PerfFieldRules().Next(*this);
+}
+
+bool PerformanceConfigConvOclImplicitGemmFwdStreamK::IsValid(const ConvolutionContext& ctx) const
+{
+    if(!IsValidValue())
+        return false;
+
+    const auto sizes = GetSizes(ctx);
+    // Tiles larger than the GEMM only waste the work-items.
+    if(tile > 32 && (tile / 2 >= sizes.GemmM() || tile / 2 >= sizes.GemmN()))
+        return false;
+    // Every work-group has at least an iteration to do.
+    return GetTiles(sizes, tile) * GetItersPerTile(sizes) >= GetGrid(ctx, wgs_per_cu);
+}
+
+bool PerformanceConfigConvOclImplicitGemmFwdStreamK::operator==(
+    const PerformanceConfigConvOclImplicitGemmFwdStreamK& other) const
+{
+    return tile == other.tile && wgs_per_cu == other.wgs_per_cu;
+}
+
+std::string PerformanceConfigConvOclImplicitGemmFwdStreamK::ToString() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return ss.str();
+}
+
+bool ConvOclImplicitGemmFwdStreamK::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_FWD_STREAM_K{}))
+        return false;
+    if(!ctx.use_opencl_convolutions)
+        return false;
+    if(!ctx.direction.IsForward())
+        return false;
+    if(!ctx.Is2d())
+        return false;
+    if(!ctx.IsLayoutDefault() && !ctx.IsLayoutNHWC())
+        return false;
+    if(!(ctx.IsFp32() || ctx.IsFp16() || ctx.IsBfp16()))
+        return false;
+    if(ctx.in_data_type != ctx.weights_data_type || ctx.in_data_type != ctx.out_data_type)
+        return false;
+    if(ctx.n_inputs % ctx.group_counts != 0 || ctx.n_outputs % ctx.group_counts != 0)
+        return false;
+
+    // The kernels index the tensors and the iterations with 32-bit integers.
+    const auto sizes        = GetSizes(ctx);
+    const auto max_elements = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    const auto x_elements =
+        static_cast<std::size_t>(sizes.n) * sizes.g * sizes.cg * sizes.hi * sizes.wi;
+    const auto y_elements  = sizes.GemmM() * sizes.g * sizes.kg;
+    const auto total_iters = GetTiles(sizes, 32) * GetItersPerTile(sizes);
+    if(x_elements > max_elements || y_elements > max_elements || total_iters > max_elements)
+        return false;
+
+    // There is some config which gives every work-group an iteration.
+    return total_iters >= GetGrid(ctx, 1);
+}
+
+size_t ConvOclImplicitGemmFwdStreamK::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    return GetPartialsSize(GetGrid(ctx, max_wgs_per_cu), max_tile);
+}
+
+PerformanceConfigConvOclImplicitGemmFwdStreamK
+ConvOclImplicitGemmFwdStreamK::GetPerformanceConfig(const ConvolutionContext& ctx) const
+{
+    PerformanceConfigConvOclImplicitGemmFwdStreamK config;
+    config.HeuristicInit(ctx);
+    MIOPEN_LOG_I(config.ToString());
+    return config;
+}
+
+bool ConvOclImplicitGemmFwdStreamK::IsValidPerformanceConfig(
+    const ConvolutionContext& ctx,
+    const PerformanceConfigConvOclImplicitGemmFwdStreamK& config) const
+{
+    return config.IsValidValue() && config.IsValid(ctx);
+}
+
+PerformanceConfigConvOclImplicitGemmFwdStreamK
+ConvOclImplicitGemmFwdStreamK::Search(const ConvolutionContext& ctx,
+                                      const AnyInvokeParams& invoke_ctx) const
+{
+    return GenericSearch(*this, ctx, invoke_ctx);
+}
+
+ConvSolution ConvOclImplicitGemmFwdStreamK::GetSolution(
+    const ConvolutionContext& ctx,
+    const PerformanceConfigConvOclImplicitGemmFwdStreamK& config,
+    bool disableConfigOverrideFromEnv) const
+{
+    const PerformanceConfigConvOclImplicitGemmFwdStreamK* pcfg = &config;
+    PerformanceConfigConvOclImplicitGemmFwdStreamK fromEnv;
+    if(!disableConfigOverrideFromEnv)
+    {
+        const auto p_asciz =
+            miopen::GetStringEnv(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_FWD_STREAM_K_PERF_VALS{});
+        if(p_asciz != nullptr && std::string(p_asciz).size() > 0)
+        {
+            if(!fromEnv.Deserialize(p_asciz) || !fromEnv.IsValid(ctx))
+            {
+                MIOPEN_LOG_E("MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_FWD_STREAM_K_PERF_VALS: "
+                             "Bad format or invalid for the problem config: "
+                             << p_asciz);
+            }
+            else
+            {
+                MIOPEN_LOG_I("Overridden from env: " << fromEnv.ToString());
+                pcfg = &fromEnv;
+            }
+        }
+    }
+
+    const auto sizes     = GetSizes(ctx);
+    const auto grid      = GetGrid(ctx, pcfg->wgs_per_cu);
+    const auto tiles     = GetTiles(sizes, pcfg->tile);
+    const auto workspace = GetPartialsSize(grid, pcfg->tile);
+
+    const auto build_params = KernelBuildParameters{
+        {"MIOPEN_SKF_N", sizes.n},
+        {"MIOPEN_SKF_G", sizes.g},
+        {"MIOPEN_SKF_CG", sizes.cg},
+        {"MIOPEN_SKF_KG", sizes.kg},
+        {"MIOPEN_SKF_HI", sizes.hi},
+        {"MIOPEN_SKF_WI", sizes.wi},
+        {"MIOPEN_SKF_HO", sizes.ho},
+        {"MIOPEN_SKF_WO", sizes.wo},
+        {"MIOPEN_SKF_FY", sizes.fy},
+        {"MIOPEN_SKF_FX", sizes.fx},
+        {"MIOPEN_SKF_SY", ctx.kernel_stride_h},
+        {"MIOPEN_SKF_SX", ctx.kernel_stride_w},
+        {"MIOPEN_SKF_DY", ctx.kernel_dilation_h},
+        {"MIOPEN_SKF_DX", ctx.kernel_dilation_w},
+        {"MIOPEN_SKF_PY", ctx.pad_h},
+        {"MIOPEN_SKF_PX", ctx.pad_w},
+        {"MIOPEN_SKF_NHWC", ctx.IsLayoutNHWC() ? 1 : 0},
+        {"MIOPEN_SKF_TILE", pcfg->tile},
+        {"MIOPEN_SKF_GRID", grid},
+    };
+    const auto comp_options = build_params.GenerateFor(kbp::OpenCL{}) + ctx.general_compile_options;
+
+    auto kernel         = KernelInfo{};
+    kernel.kernel_file  = "MIOpenConvFwdStreamK.cl";
+    kernel.kernel_name  = "MIOpenConvFwdStreamK";
+    kernel.comp_options = comp_options;
+    kernel.l_wk         = {block_size, 1, 1};
+    kernel.g_wk         = {grid * block_size, 1, 1};
+
+    auto fixup         = KernelInfo{};
+    fixup.kernel_file  = kernel.kernel_file;
+    fixup.kernel_name  = "MIOpenConvFwdStreamKFixup";
+    fixup.comp_options = comp_options;
+    fixup.l_wk         = {block_size, 1, 1};
+    fixup.g_wk         = {tiles * block_size, 1, 1};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+    result.construction_params.push_back(kernel);
+    result.construction_params.push_back(fixup);
+    result.workspce_sz = workspace;
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+            decltype(auto) data_params = primitive_parameters.CastTo<conv::DataInvokeParams>();
+            const auto& tensors        = data_params.tensors;
+            float elapsed              = 0;
+
+            if(data_params.workSpace == nullptr || data_params.workSpaceSize < workspace)
+                MIOPEN_THROW("Not enough workspace has been provided for "
+                             "ConvOclImplicitGemmFwdStreamK.");
+
+            handle.Run(kernels[0])(tensors.in, tensors.w, tensors.out, data_params.workSpace);
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+
+            handle.Run(kernels[1])(data_params.workSpace, tensors.out);
+            if(handle.IsProfilingEnabled())
+            {
+                elapsed += handle.GetKernelTime();
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(elapsed);
+            }
+        };
+    };
+
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
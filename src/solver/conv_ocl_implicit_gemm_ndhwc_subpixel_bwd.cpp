@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2026 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver/conv_implicit_gemm_ndhwc.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/generic_search.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_SUBPIXEL_BWD)
+
+namespace miopen {
+namespace solver {
+
+bool ConvOclImplicitGemmSubPixelBwd::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_SUBPIXEL_BWD{}))
+        return false;
+    if(!ctx.direction.IsBackwardData())
+        return false;
+    return IsNdhwcImplicitGemmApplicable(ctx, true);
+}
+
+PerformanceConfigConvOclImplicitGemmNdhwc
+ConvOclImplicitGemmSubPixelBwd::GetPerformanceConfig(const ConvolutionContext& ctx) const
+{
+    PerformanceConfigConvOclImplicitGemmNdhwc config;
+    config.HeuristicInit(ctx);
+    MIOPEN_LOG_I(config.ToString());
+    return config;
+}
+
+bool ConvOclImplicitGemmSubPixelBwd::IsValidPerformanceConfig(
+    const ConvolutionContext& ctx, const PerformanceConfigConvOclImplicitGemmNdhwc& config) const
+{
+    return config.IsValidValue() && config.IsValid(ctx);
+}
+
+PerformanceConfigConvOclImplicitGemmNdhwc
+ConvOclImplicitGemmSubPixelBwd::Search(const ConvolutionContext& ctx,
+                                   const AnyInvokeParams& invoke_ctx) const
+{
+    return GenericSearch(*this, ctx, invoke_ctx);
+}
+
+ConvSolution
+ConvOclImplicitGemmSubPixelBwd::GetSolution(const ConvolutionContext& ctx,
+                                        const PerformanceConfigConvOclImplicitGemmNdhwc& config,
+                                        bool disableConfigOverrideFromEnv) const
+{
+    return GetNdhwcImplicitGemmSolution(ctx, config, disableConfigOverrideFromEnv, true);
+}
+
+} // namespace solver
+} // namespace miopen
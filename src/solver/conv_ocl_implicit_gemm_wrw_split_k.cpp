@@ -0,0 +1,389 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver.hpp>
+
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/env.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/sequences.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_WRW_SPLIT_K)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_WRW_SPLIT_K_DETERMINISTIC)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_WRW_SPLIT_K_PERF_VALS)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+// Must match the kernel.
+constexpr int block_size = 256;
+constexpr int block_k    = 16;
+
+// Each part reduces at least that many output pixels, otherwise the partial sums cost more
+// than they parallelize.
+constexpr int min_pixels_per_split = 16 * block_k;
+constexpr int max_splits           = 64;
+
+// clang-format off
+auto PerfFieldRules()
+{
+    return seq::MakeRuleSet(
+        std::make_tuple(seq::Sequence<int, 32, 64>{},
+                        &PerformanceConfigConvOclImplicitGemmWrwSplitK::tile),
+        std::make_tuple(seq::Sequence<int, 1, 2, 4, 8, 16, 32, 64>{},
+                        &PerformanceConfigConvOclImplicitGemmWrwSplitK::splits),
+        std::make_tuple(seq::Sequence<int, 0, 1>{},
+                        &PerformanceConfigConvOclImplicitGemmWrwSplitK::atomic)
+    );
+}
+// clang-format on
+
+struct SplitKSizes
+{
+    int n, g, kg, cg, hi, wi, ho, wo, fy, fx;
+
+    std::size_t Pixels() const { return static_cast<std::size_t>(n) * ho * wo; }
+    std::size_t FilterElements() const
+    {
+        return static_cast<std::size_t>(g) * kg * cg * fy * fx;
+    }
+};
+
+SplitKSizes GetSizes(const ConvolutionContext& ctx)
+{
+    auto sizes = SplitKSizes{};
+    sizes.n    = ctx.batch_sz;
+    sizes.g    = ctx.group_counts;
+    sizes.kg   = ctx.n_inputs / ctx.group_counts;
+    sizes.cg   = ctx.n_outputs / ctx.group_counts;
+    sizes.hi   = ctx.out_height;
+    sizes.wi   = ctx.out_width;
+    sizes.ho   = ctx.in_height;
+    sizes.wo   = ctx.in_width;
+    sizes.fy   = ctx.kernel_size_h;
+    sizes.fx   = ctx.kernel_size_w;
+    return sizes;
+}
+
+int Ceil(int value, int divisor) { return (value + divisor - 1) / divisor; }
+
+/// The most parts the reduction of the problem is split into, a power of 2.
+int GetMaxSplits(const SplitKSizes& sizes)
+{
+    auto splits = 1;
+    while(splits < max_splits && sizes.Pixels() / (2 * splits) >= min_pixels_per_split)
+        splits *= 2;
+    return splits;
+}
+
+/// The atomic reduction is not used in the deterministic mode of the handle, which keeps the
+/// solver available with the configs that reduce through the workspace.
+bool IsDeterministicOnly(const ConvolutionContext& ctx)
+{
+    return miopen::IsEnabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_WRW_SPLIT_K_DETERMINISTIC{}) ||
+           ctx.GetStream().IsDeterministic();
+}
+
+/// Only the deterministic reduction and the atomic one of the types narrower than fp32 need the
+/// workspace, since fp32 atomics go to the filters directly.
+std::size_t GetRequiredWorkspaceSize(const ConvolutionContext& ctx,
+                                     const PerformanceConfigConvOclImplicitGemmWrwSplitK& config)
+{
+    if(config.splits == 1 || (config.atomic != 0 && ctx.IsFp32()))
+        return 0;
+    const auto parts = config.atomic != 0 ? 1 : config.splits;
+    return static_cast<std::size_t>(parts) * GetSizes(ctx).FilterElements() * sizeof(float);
+}
+
+} // namespace
+
+void PerformanceConfigConvOclImplicitGemmWrwSplitK::HeuristicInit(const ConvolutionContext& ctx)
+{
+    const auto sizes = GetSizes(ctx);
+    const auto cyx   = sizes.cg * sizes.fy * sizes.fx;
+
+    tile = sizes.kg >= 64 && cyx >= 64 ? 64 : 32;
+
+    // Enough work-groups to occupy every compute unit twice.
+    const auto tiles  = Ceil(sizes.kg, tile) * Ceil(cyx, tile) * sizes.g;
+    const auto target = 2 * static_cast<int>(ctx.GetStream().GetMaxComputeUnits());
+    const auto limit  = GetMaxSplits(sizes);
+
+    splits = 1;
+    while(splits < limit && tiles * splits < target)
+        splits *= 2;
+
+    // The results are reproducible by default.
+    atomic = 0;
+}
+
+bool PerformanceConfigConvOclImplicitGemmWrwSplitK::IsValidValue() const
+{
+    return PerfFieldRules().IsIn(*this);
+}
+
+bool PerformanceConfigConvOclImplicitGemmWrwSplitK::SetNextValue(
+    const ConvolutionContext& /*ctx*/)
+{
+    return !PerfFieldRules().Next(*this);
+}
+
+bool PerformanceConfigConvOclImplicitGemmWrwSplitK::IsValid(const ConvolutionContext& ctx) const
+{
+    if(!IsValidValue())
+        return false;
+    if(splits > GetMaxSplits(GetSizes(ctx)))
+        return false;
+    // A single part needs no reduction at all.
+    if(atomic != 0 && (splits == 1 || IsDeterministicOnly(ctx)))
+        return false;
+    return true;
+}
+
+bool PerformanceConfigConvOclImplicitGemmWrwSplitK::operator==(
+    const PerformanceConfigConvOclImplicitGemmWrwSplitK& other) const
+{
+    return tile == other.tile && splits == other.splits && atomic == other.atomic;
+}
+
+std::string PerformanceConfigConvOclImplicitGemmWrwSplitK::ToString() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return ss.str();
+}
+
+bool ConvOclImplicitGemmWrwSplitK::IsApplicable(const ConvolutionContext& ctx) const
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_WRW_SPLIT_K{}))
+        return false;
+    if(!ctx.use_opencl_convolutions)
+        return false;
+    if(!ctx.direction.IsBackwardWrW())
+        return false;
+    if(!ctx.Is2d())
+        return false;
+    if(!ctx.IsLayoutDefault() && !ctx.IsLayoutNHWC())
+        return false;
+    if(!(ctx.IsFp32() || ctx.IsFp16() || ctx.IsBfp16()))
+        return false;
+    if(ctx.in_data_type != ctx.weights_data_type || ctx.in_data_type != ctx.out_data_type)
+        return false;
+    if(ctx.n_inputs % ctx.group_counts != 0 || ctx.n_outputs % ctx.group_counts != 0)
+        return false;
+
+    // The kernels index the tensors with 32-bit integers.
+    const auto sizes        = GetSizes(ctx);
+    const auto max_elements = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    const auto x_elements =
+        static_cast<std::size_t>(sizes.n) * sizes.g * sizes.cg * sizes.hi * sizes.wi;
+    const auto dy_elements = sizes.Pixels() * sizes.g * sizes.kg;
+    const auto ws_elements = static_cast<std::size_t>(max_splits) * sizes.FilterElements();
+    return x_elements <= max_elements && dy_elements <= max_elements &&
+           ws_elements <= max_elements;
+}
+
+size_t ConvOclImplicitGemmWrwSplitK::GetWorkspaceSize(const ConvolutionContext& ctx) const
+{
+    const auto splits = GetMaxSplits(GetSizes(ctx));
+    if(splits == 1)
+        return 0;
+    return static_cast<std::size_t>(splits) * GetSizes(ctx).FilterElements() * sizeof(float);
+}
+
+PerformanceConfigConvOclImplicitGemmWrwSplitK
+ConvOclImplicitGemmWrwSplitK::GetPerformanceConfig(const ConvolutionContext& ctx) const
+{
+    PerformanceConfigConvOclImplicitGemmWrwSplitK config;
+    config.HeuristicInit(ctx);
+    MIOPEN_LOG_I(config.ToString());
+    return config;
+}
+
+bool ConvOclImplicitGemmWrwSplitK::IsValidPerformanceConfig(
+    const ConvolutionContext& ctx,
+    const PerformanceConfigConvOclImplicitGemmWrwSplitK& config) const
+{
+    return config.IsValidValue() && config.IsValid(ctx);
+}
+
+PerformanceConfigConvOclImplicitGemmWrwSplitK
+ConvOclImplicitGemmWrwSplitK::Search(const ConvolutionContext& ctx,
+                                     const AnyInvokeParams& invoke_ctx) const
+{
+    return GenericSearch(*this, ctx, invoke_ctx);
+}
+
+ConvSolution ConvOclImplicitGemmWrwSplitK::GetSolution(
+    const ConvolutionContext& ctx,
+    const PerformanceConfigConvOclImplicitGemmWrwSplitK& config,
+    bool disableConfigOverrideFromEnv) const
+{
+    const PerformanceConfigConvOclImplicitGemmWrwSplitK* pcfg = &config;
+    PerformanceConfigConvOclImplicitGemmWrwSplitK fromEnv;
+    if(!disableConfigOverrideFromEnv)
+    {
+        const auto p_asciz =
+            miopen::GetStringEnv(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_WRW_SPLIT_K_PERF_VALS{});
+        if(p_asciz != nullptr && std::string(p_asciz).size() > 0)
+        {
+            if(!fromEnv.Deserialize(p_asciz) || !fromEnv.IsValid(ctx))
+            {
+                MIOPEN_LOG_E("MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_OCL_WRW_SPLIT_K_PERF_VALS: "
+                             "Bad format or invalid for the problem config: "
+                             << p_asciz);
+            }
+            else
+            {
+                MIOPEN_LOG_I("Overridden from env: " << fromEnv.ToString());
+                pcfg = &fromEnv;
+            }
+        }
+    }
+
+    const auto sizes  = GetSizes(ctx);
+    const auto splits = pcfg->splits;
+    const auto atomic = pcfg->atomic != 0;
+    const auto mode   = splits == 1 ? 0 : (atomic ? 2 : 1);
+    // The fp32 atomics accumulate in the filters, the other types in the workspace.
+    const auto to_workspace = mode == 1 || (mode == 2 && !ctx.IsFp32());
+    const auto workspace    = GetRequiredWorkspaceSize(ctx, *pcfg);
+
+    const auto build_params = KernelBuildParameters{
+        {"MIOPEN_SK_N", sizes.n},
+        {"MIOPEN_SK_G", sizes.g},
+        {"MIOPEN_SK_KG", sizes.kg},
+        {"MIOPEN_SK_CG", sizes.cg},
+        {"MIOPEN_SK_HI", sizes.hi},
+        {"MIOPEN_SK_WI", sizes.wi},
+        {"MIOPEN_SK_HO", sizes.ho},
+        {"MIOPEN_SK_WO", sizes.wo},
+        {"MIOPEN_SK_FY", sizes.fy},
+        {"MIOPEN_SK_FX", sizes.fx},
+        {"MIOPEN_SK_SY", ctx.kernel_stride_h},
+        {"MIOPEN_SK_SX", ctx.kernel_stride_w},
+        {"MIOPEN_SK_DY", ctx.kernel_dilation_h},
+        {"MIOPEN_SK_DX", ctx.kernel_dilation_w},
+        {"MIOPEN_SK_PY", ctx.pad_h},
+        {"MIOPEN_SK_PX", ctx.pad_w},
+        {"MIOPEN_SK_NHWC", ctx.IsLayoutNHWC() ? 1 : 0},
+        {"MIOPEN_SK_TILE", pcfg->tile},
+        {"MIOPEN_SK_SPLITS", splits},
+        {"MIOPEN_SK_MODE", mode},
+        {"MIOPEN_SK_REDUCED_PARTS", mode == 1 ? splits : 1},
+    };
+    const auto comp_options = build_params.GenerateFor(kbp::OpenCL{}) + ctx.general_compile_options;
+
+    const auto cyx   = sizes.cg * sizes.fy * sizes.fx;
+    const auto tiles = static_cast<std::size_t>(Ceil(sizes.kg, pcfg->tile)) *
+                       Ceil(cyx, pcfg->tile) * sizes.g * splits;
+
+    auto kernel         = KernelInfo{};
+    kernel.kernel_file  = "MIOpenConvWrwSplitK.cl";
+    kernel.kernel_name  = "MIOpenConvWrwSplitK";
+    kernel.comp_options = comp_options;
+    kernel.l_wk         = {block_size, 1, 1};
+    kernel.g_wk         = {tiles * block_size, 1, 1};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+    result.construction_params.push_back(kernel);
+    result.workspce_sz = workspace;
+
+    if(to_workspace)
+    {
+        const auto wei_elements = sizes.FilterElements();
+        auto reduce             = KernelInfo{};
+        reduce.kernel_file      = kernel.kernel_file;
+        reduce.kernel_name      = "MIOpenConvWrwSplitKReduce";
+        reduce.comp_options     = comp_options;
+        reduce.l_wk             = {block_size, 1, 1};
+        reduce.g_wk = {(wei_elements + block_size - 1) / block_size * block_size, 1, 1};
+        result.construction_params.push_back(reduce);
+    }
+
+    const auto zero_first     = mode == 2;
+    const auto workspace_desc = TensorDescriptor{miopenFloat,
+                                                 ctx.conv_problem.GetWeights().GetLengths(),
+                                                 ctx.conv_problem.GetWeights().GetStrides()};
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) {
+            decltype(auto) wrw_params = primitive_parameters.CastTo<conv::WrWInvokeParams>();
+            const auto& tensors       = wrw_params.tensors;
+            float elapsed             = 0;
+            float zero                = 0.f;
+
+            if(workspace > 0 &&
+               (wrw_params.workSpace == nullptr || wrw_params.workSpaceSize < workspace))
+                MIOPEN_THROW("Not enough workspace has been provided for "
+                             "ConvOclImplicitGemmWrwSplitK.");
+
+            const auto out = to_workspace ? wrw_params.workSpace : tensors.dw;
+
+            if(zero_first)
+            {
+                if(to_workspace)
+                    SetTensor(handle, workspace_desc, out, &zero);
+                else
+                    SetTensor(handle, tensors.dwDesc, out, &zero);
+                if(handle.IsProfilingEnabled())
+                    elapsed += handle.GetKernelTime();
+            }
+
+            handle.Run(kernels[0])(tensors.x, out, tensors.dy);
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+
+            if(to_workspace)
+            {
+                handle.Run(kernels[1])(wrw_params.workSpace, tensors.dw);
+                if(handle.IsProfilingEnabled())
+                    elapsed += handle.GetKernelTime();
+            }
+
+            if(handle.IsProfilingEnabled())
+            {
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(elapsed);
+            }
+        };
+    };
+
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
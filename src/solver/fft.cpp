@@ -35,9 +35,20 @@
 
 #include <boost/any.hpp>
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace miopen {
 namespace solver {
 
+// Transformed weights of the constant weights, by the address of the weights.
+struct FFTWeightsCache
+{
+    std::mutex mutex;
+    std::map<ConstData_t, Allocator::ManageDataPtr> weights;
+};
+
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 
 static void cgemm_grid(size_t* global_work_size,
@@ -404,9 +415,18 @@ ConvSolution fft::GetSolution(const ConvolutionContext& ctx) const
         sol.construction_params.push_back(kernel);
     }
 
+    // With constant weights the transformed weights are kept, see FFTWeightsCache.
+    // HIP only, as the weights are copied out of the workspace by offset.
+    const auto cache_weights = MIOPEN_BACKEND_HIP && ctx.conv_problem.GetConv().constant_weights;
+
     sol.invoker_factory = [=](const std::vector<Kernel>& kernels) {
         int halfw = static_cast<int>(workSpaceSize) / (2 * 2 * static_cast<int>(sizeof(float)));
         const int padding = FFTConvParams::TransposePadding;
+        // The weights operand of cgemm.
+        const auto weights_offset = halfw + N * (in_n * in_c + padding);
+        const auto weights_size   = N * (in_c * out_c + padding) * 2 * sizeof(float);
+        const auto weights_cache  = cache_weights ? std::make_shared<FFTWeightsCache>()
+                                                 : std::shared_ptr<FFTWeightsCache>{};
 
         return [=](const Handle& handle, const AnyInvokeParams& primitive_params) {
             const auto& params  = primitive_params.CastTo<conv::DataInvokeParams>();
@@ -417,6 +437,36 @@ ConvSolution fft::GetSolution(const ConvolutionContext& ctx) const
                              std::to_string(workSpaceSize) + ", got " +
                              std::to_string(params.workSpaceSize));
 
+            ConstData_t weights_buffer = params.workSpace;
+            auto weights_ready         = false;
+            auto cached_weights        = Data_t{nullptr};
+            if(params.prepared_weights != nullptr)
+            {
+                auto& prepared = params.prepared_weights->buffer;
+                weights_ready  = prepared != nullptr;
+                if(!weights_ready)
+                {
+                    const MemoryCategoryScope memory_scope{MemoryCategory::Constants};
+                    prepared = handle.Create(weights_size);
+                }
+                cached_weights = prepared.get();
+            }
+            else if(weights_cache)
+            {
+                std::lock_guard<std::mutex> lock(weights_cache->mutex);
+                auto& cached  = weights_cache->weights[tensors.w];
+                weights_ready = cached != nullptr;
+                if(!weights_ready)
+                {
+                    const MemoryCategoryScope memory_scope{MemoryCategory::Constants};
+                    cached = handle.Create(weights_size);
+                }
+                cached_weights = cached.get();
+            }
+
+            if(params.prepare_weights_only && weights_ready)
+                return;
+
             float time_fft = 0;
             int kernel_id  = 0;
             for(int ik = 0; ik < NumKernels; ik++)
@@ -424,6 +474,29 @@ ConvSolution fft::GetSolution(const ConvolutionContext& ctx) const
                 if(skip_front_transposes && ((ik == 2) || (ik == 3)))
                     continue;
 
+                if(cached_weights != nullptr && ik == 4)
+                {
+                    // The transformed weights were made by this or one of the previous calls.
+#if MIOPEN_BACKEND_HIP
+                    if(!weights_ready)
+                        handle.Copy(static_cast<const char*>(params.workSpace) +
+                                        weights_offset * 2 * sizeof(float),
+                                    cached_weights,
+                                    weights_size);
+#endif
+                    weights_buffer = cached_weights;
+                    if(params.prepare_weights_only)
+                        break;
+                }
+
+                // Only the weights are transformed (ik 1 and 3) when preparing them.
+                if((weights_ready && (ik == 1 || ik == 3)) ||
+                   (params.prepare_weights_only && (ik == 0 || ik == 2)))
+                {
+                    kernel_id++;
+                    continue;
+                }
+
                 const auto& k = handle.Run(kernels[kernel_id++]);
 
                 switch(ik)
@@ -432,8 +505,9 @@ ConvSolution fft::GetSolution(const ConvolutionContext& ctx) const
                 case 1: k(tensors.w, params.workSpace); break;
                 case 4: {
                     k(params.workSpace,
+                      weights_buffer,
                       0,
-                      halfw + N * (in_n * in_c + padding),
+                      weights_buffer == params.workSpace ? weights_offset : 0,
                       halfw + 0,
                       out_c,
                       out_n * out_c + padding,
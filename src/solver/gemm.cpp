@@ -41,6 +41,8 @@
 #include <boost/range/adaptors.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_GEMM_IM2COL_WORKSPACE_MAX)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_GEMM_1X1_FOLD_BATCH_MAX_PIXELS)
 
 /// MIOpenGEMM issues with ROCm 3.7, most likely related to the
 /// issues in the OpenCL compiler. Not reproducible in ROCm 4.0.
@@ -634,10 +636,50 @@ ConvSolution GemmFwd1x1_0_1_int8::GetSolution(const ExecutionContext& context,
 #endif
 }
 
-size_t GemmFwd1x1_0_1::GetWorkspaceSize(const ExecutionContext&,
-                                        const conv::ProblemDescription&) const
+#if MIOPEN_USE_GEMM
+// The GEMM of an image is K x HW x C. When HW is small, the strided batched GEMM over the images
+// is a batch of tiny GEMMs which do not fill the device. Instead the images are transposed to
+// CNHW and multiplied by a single K x NHW x C GEMM, up to this number of output pixels per image.
+// 0 disables it.
+static std::size_t GemmFwd1x1FoldBatchMaxPixels()
+{
+    return miopen::Value(MIOPEN_DEBUG_CONV_GEMM_1X1_FOLD_BATCH_MAX_PIXELS{}, 256);
+}
+#endif
+
+size_t GemmFwd1x1_0_1::GetWorkspaceSize(const ExecutionContext& context,
+                                        const conv::ProblemDescription& problem) const
 {
+#if MIOPEN_USE_GEMM
+    decltype(auto) handle = context.GetStream();
+    decltype(auto) conv   = problem.GetConv();
+    decltype(auto) xDesc  = problem.GetIn();
+    decltype(auto) yDesc  = problem.GetOut();
+
+    const auto type = xDesc.GetType();
+    if(conv.group_count > 1 || conv.GetSpatialDimension() != 2 || xDesc.GetLengths()[0] == 1 ||
+       (type != miopenFloat && type != miopenHalf && type != miopenBFloat16))
+        return 0;
+
+    const auto out_spatial      = boost::adaptors::slice(yDesc.GetLengths(), 2, 4);
+    const auto out_spatial_size = std::accumulate(
+        out_spatial.begin(), out_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
+    if(out_spatial_size > GemmFwd1x1FoldBatchMaxPixels())
+        return 0;
+
+    // NCHW2CNHW(x) and the CNHW output of the GEMM.
+    const auto gemm_trans = (xDesc.GetElementSize() + yDesc.GetElementSize()) * GetTypeSize(type);
+    if(gemm_trans > MAX_MEM_ALLOC_SZ)
+    {
+        MIOPEN_LOG_I2(gemm_trans << " > " << MAX_MEM_ALLOC_SZ);
+        return 0;
+    }
+    return gemm_trans;
+#else
+    std::ignore = context;
+    std::ignore = problem;
     return 0;
+#endif
 }
 
 bool GemmFwd1x1_0_1::IsApplicable(const ExecutionContext& context,
@@ -664,6 +706,15 @@ bool GemmFwd1x1_0_1::IsApplicable(const ExecutionContext& context,
 #endif
 }
 
+bool GemmFwd1x1_0_1::SupportsAlphaBeta(const ExecutionContext& context,
+                                       const conv::ProblemDescription& problem) const
+{
+    // Only the single strided batched GEMM writes the output directly, the other paths go
+    // through a transpose or a cast of the result.
+    return problem.GetConv().group_count == 1 && GetWorkspaceSize(context, problem) == 0 &&
+           problem.GetWeights().GetType() != miopenInt8x4;
+}
+
 ConvSolution GemmFwd1x1_0_1::GetSolution(const ExecutionContext& context,
                                          const conv::ProblemDescription& problem) const
 {
@@ -776,6 +827,106 @@ ConvSolution GemmFwd1x1_0_1::GetSolution(const ExecutionContext& context,
             };
         };
     }
+    else if(GetWorkspaceSize(context, problem) > 0)
+    {
+        // y = CNHW2NCHW(w * NCHW2CNHW(x))
+        const GemmDescriptor gemm_desc = CreateGemmDescriptorConvCNHWFwd(wDesc, xDesc, yDesc);
+
+        const auto workspace_req = GetWorkspaceSize(context, problem);
+        solution.workspce_sz     = workspace_req;
+
+        const auto in_spatial  = std::vector<std::size_t>(in_spatial_.begin(), in_spatial_.end());
+        const auto x_t_size    = xDesc.GetElementSize();
+
+        solution.invoker_factory = [=](const std::vector<Kernel>&) {
+            MIOPEN_LOG_FUNCTION("convolution, 1x1, batch folded");
+
+            const bool time_precision = context.GetStream().IsProfilingEnabled() &&
+                                        (!IsDisabled(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING{}));
+
+            return [=](const Handle& handle, const AnyInvokeParams& primitive_params) {
+                float time                 = 0;
+                decltype(auto) conv_params = primitive_params.CastTo<conv::DataInvokeParams>();
+                const auto& workSpace      = conv_params.workSpace;
+                const auto workSpaceSize   = conv_params.workSpaceSize;
+                const auto& x              = conv_params.tensors.in;
+                const auto& w              = conv_params.tensors.w;
+                const auto& y              = conv_params.tensors.out;
+
+                if(workSpace == nullptr || workSpaceSize < workspace_req)
+                    MIOPEN_THROW("Not enough workspace for GEMM (" +
+                                 std::to_string(workSpaceSize) + " provided, " +
+                                 std::to_string(workspace_req) + " required)");
+
+                MIOPEN_LOG_FUNCTION("convolution, 1x1, batch folded");
+
+                transpose_NCHW2CNHW(handle,
+                                    in_n,
+                                    in_c,
+                                    in_spatial[0],
+                                    in_spatial[1],
+                                    in_spatial[0],
+                                    in_spatial[1],
+                                    x,
+                                    workSpace,
+                                    0,
+                                    0,
+                                    1,
+                                    1,
+                                    xDesc.GetType());
+                if(handle.IsProfilingEnabled())
+                    time += handle.GetKernelTime();
+
+                miopenStatus_t gemm_status;
+                if(conv_params.type == InvokeType::Run)
+                {
+                    gemm_status = CallGemm(
+                        handle, gemm_desc, w, 0, workSpace, 0, workSpace, x_t_size, nullptr);
+                }
+                else
+                {
+                    gemm_status = CallGemmTimeMeasure(handle,
+                                                      gemm_desc,
+                                                      w,
+                                                      0,
+                                                      workSpace,
+                                                      0,
+                                                      workSpace,
+                                                      x_t_size,
+                                                      nullptr,
+                                                      time_precision,
+                                                      callGemm);
+                }
+
+                if(gemm_status != miopenStatusSuccess)
+                    MIOPEN_THROW("GEMM execution failure");
+
+                if(handle.IsProfilingEnabled())
+                    time += handle.GetKernelTime();
+
+                transpose_CNHW2NCHW(handle,
+                                    in_n,
+                                    wei_k,
+                                    in_spatial[0],
+                                    in_spatial[1],
+                                    in_spatial[0],
+                                    in_spatial[1],
+                                    workSpace,
+                                    y,
+                                    x_t_size,
+                                    0,
+                                    1,
+                                    1,
+                                    yDesc.GetType());
+                if(handle.IsProfilingEnabled())
+                {
+                    time += handle.GetKernelTime();
+                    handle.ResetKernelTime();
+                    handle.AccumKernelTime(time);
+                }
+            };
+        };
+    }
     else
     {
         // tensors.y = tensors.w * tensors.x
@@ -801,12 +952,15 @@ ConvSolution GemmFwd1x1_0_1::GetSolution(const ExecutionContext& context,
 
                 MIOPEN_LOG_FUNCTION("convolution, 1x1");
 
-                // tensors.y = tensors.w * tensors.x
+                // tensors.y = alpha * tensors.w * tensors.x + beta * tensors.y
                 miopenStatus_t gemm_status;
                 if(conv_params.type == InvokeType::Run)
                 {
+                    auto blended_desc  = gemm_desc;
+                    blended_desc.alpha = conv_params.alpha;
+                    blended_desc.beta  = conv_params.beta;
                     gemm_status =
-                        CallGemmStridedBatched(handle, gemm_desc, w, 0, x, 0, y, 0, nullptr);
+                        CallGemmStridedBatched(handle, blended_desc, w, 0, x, 0, y, 0, nullptr);
                 }
                 else
                 {
@@ -854,39 +1008,62 @@ ConvSolution GemmFwd1x1_0_1::GetSolution(const ExecutionContext& context,
 #endif
 }
 
+#if MIOPEN_USE_GEMM
+// Bytes of the column matrix of an image per output row along the outermost spatial dimension.
+static std::size_t GemmFwdRestIm2ColRowBytes(const conv::ProblemDescription& problem)
+{
+    decltype(auto) conv  = problem.GetConv();
+    decltype(auto) wDesc = problem.GetWeights();
+    decltype(auto) yDesc = problem.GetOut();
+
+    const auto spatial_dim = conv.GetSpatialDimension();
+    const auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
+    const auto out_spatial = boost::adaptors::slice(yDesc.GetLengths(), 3, 2 + spatial_dim);
+    const auto wei_c       = wDesc.GetLengths()[1];
+
+    return wei_c *
+           std::accumulate(wei_spatial.begin(),
+                           wei_spatial.end(),
+                           std::size_t(1),
+                           std::multiplies<std::size_t>()) *
+           std::accumulate(out_spatial.begin(),
+                           out_spatial.end(),
+                           std::size_t(1),
+                           std::multiplies<std::size_t>()) *
+           GetTypeSize(wDesc.GetType()) * conv.group_count;
+}
+#endif
+
 size_t GemmFwdRest::GetWorkspaceSize(const ExecutionContext& context,
                                      const conv::ProblemDescription& problem) const
 {
 #if MIOPEN_USE_GEMM
     decltype(auto) handle = context.GetStream();
-    decltype(auto) conv   = problem.GetConv();
     decltype(auto) wDesc  = problem.GetWeights();
-    decltype(auto) yDesc  = problem.GetOut();
-
-    const auto spatial_dim = conv.GetSpatialDimension();
-    const auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
-    const auto out_spatial = boost::adaptors::slice(yDesc.GetLengths(), 2, 2 + spatial_dim);
-    const auto wei_c       = wDesc.GetLengths()[1];
 
-    const auto workspace_size = wei_c *
-                                std::accumulate(wei_spatial.begin(),
-                                                wei_spatial.end(),
-                                                std::size_t(1),
-                                                std::multiplies<std::size_t>()) *
-                                std::accumulate(out_spatial.begin(),
-                                                out_spatial.end(),
-                                                std::size_t(1),
-                                                std::multiplies<std::size_t>()) *
-                                GetTypeSize(wDesc.GetType()) * conv.group_count;
+    const auto row_bytes      = GemmFwdRestIm2ColRowBytes(problem);
+    const auto out_rows       = problem.GetOut().GetLengths()[2];
+    const auto workspace_size = row_bytes * out_rows;
 
     const auto ws_sz = (wDesc.GetType() == miopenInt8 ? 2 * workspace_size : workspace_size);
 
-    if(ws_sz > MAX_MEM_ALLOC_SZ)
+    std::size_t limit = miopen::Value(MIOPEN_DEBUG_CONV_GEMM_IM2COL_WORKSPACE_MAX{});
+    if(limit == 0 || limit > MAX_MEM_ALLOC_SZ)
+        limit = MAX_MEM_ALLOC_SZ;
+
+    if(ws_sz <= limit)
+        return ws_sz;
+
+    // The column matrix of an image does not fit, convert and multiply a chunk of output rows
+    // along the outermost spatial dimension at a time. The int8 path transposes the whole
+    // column matrix and is not chunked.
+    const auto chunk_rows = wDesc.GetType() == miopenInt8 ? 0 : limit / row_bytes;
+    if(chunk_rows == 0)
     {
-        MIOPEN_LOG_I2(ws_sz << " > " << MAX_MEM_ALLOC_SZ);
+        MIOPEN_LOG_I2(ws_sz << " > " << limit);
         return 0;
     }
-    return ws_sz;
+    return chunk_rows * row_bytes;
 #else
     std::ignore = context;
     std::ignore = problem;
@@ -970,6 +1147,9 @@ ConvSolution GemmFwdRest::GetSolution(const ExecutionContext& context,
     const auto spatial_dim = conv.GetSpatialDimension();
 
     const auto workspace_req = GetWorkspaceSize(context, problem);
+    const auto out_rows      = yDesc.GetLengths()[2];
+    const auto chunk_rows =
+        std::min(out_rows, workspace_req / GemmFwdRestIm2ColRowBytes(problem));
 
     auto solution        = ConvSolution{miopenStatusSuccess};
     solution.workspce_sz = workspace_req;
@@ -1001,6 +1181,128 @@ ConvSolution GemmFwdRest::GetSolution(const ExecutionContext& context,
 
         const bool time_precision = (!IsDisabled(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING{}));
 
+        // y[:, rows] = w * Im2Col(x)[:, rows] for a chunk of output rows along the outermost
+        // spatial dimension. The chunk is converted as a convolution with that many output rows
+        // and the padding shifted by the rows in front of it, GEMM writes it in place into y.
+        const auto RunChunks = [=](const Handle& handle,
+                                   const conv::DataInvokeParams& conv_params,
+                                   std::size_t runs) {
+            const auto& workSpace = conv_params.workSpace;
+            const auto x          = conv_params.tensors.in;
+            const auto w          = conv_params.tensors.w;
+            const auto y          = conv_params.tensors.out;
+
+            const auto row_size = out_spatial_size / out_rows;
+            float time          = 0;
+
+            for(std::size_t i = 0; i < runs; i++)
+            {
+                float iteration_time   = 0;
+                std::size_t out_offset = i * wei_k * out_spatial_size;
+                std::size_t in_offset  = i * in_c * in_spatial_size;
+
+                for(std::size_t row = 0; row < out_rows; row += chunk_rows)
+                {
+                    const auto rows = std::min(chunk_rows, out_rows - row);
+
+                    auto chunk_spatial = out_spatial;
+                    chunk_spatial[0]   = rows;
+
+                    auto chunk_pads = conv.GetConvPads();
+                    chunk_pads[0] -= static_cast<int>(row) * conv.GetConvStrides()[0];
+
+                    iteration_time += Im2ColGPU(handle,
+                                                spatial_dim,
+                                                x,
+                                                in_offset,
+                                                in_c,
+                                                in_spatial,
+                                                wei_spatial,
+                                                chunk_spatial,
+                                                chunk_pads,
+                                                conv.GetConvStrides(),
+                                                conv.GetConvDilations(),
+                                                workSpace,
+                                                xDesc.GetType());
+
+                    auto chunk_desc = gemm_desc;
+                    chunk_desc.n    = static_cast<int>(rows * row_size);
+                    chunk_desc.ldb  = chunk_desc.n;
+                    // Groups stay strided batched, the column matrix of a group is as long as
+                    // the chunk while y keeps the strides of the whole output.
+                    if(conv.group_count > 1)
+                        chunk_desc.strideB = static_cast<long long int>(chunk_desc.k) *
+                                             chunk_desc.n;
+
+                    const auto chunk_offset = out_offset + row * row_size;
+
+                    miopenStatus_t gemm_status = miopenStatusNotInitialized;
+
+                    if(conv_params.type != InvokeType::Run)
+                    {
+                        gemm_status = CallGemmTimeMeasure(
+                            handle,
+                            chunk_desc,
+                            w,
+                            0,
+                            workSpace,
+                            0,
+                            y,
+                            chunk_offset,
+                            nullptr,
+                            time_precision,
+                            conv.group_count > 1 ? callGemmStridedBatched : callGemm,
+                            (conv.group_count > 1 || wDesc.GetType() == miopenInt8x4 ||
+                             wDesc.GetType() == miopenBFloat16)
+                                ? GemmBackend_t::miopentensile
+                                : GemmBackend_t::miopengemm);
+                    }
+                    else if(conv.group_count > 1)
+                    {
+                        gemm_status = CallGemmStridedBatched(
+                            handle, chunk_desc, w, 0, workSpace, 0, y, chunk_offset, nullptr);
+                    }
+                    else
+                    {
+                        gemm_status = CallGemm(handle,
+                                               chunk_desc,
+                                               w,
+                                               0,
+                                               workSpace,
+                                               0,
+                                               y,
+                                               chunk_offset,
+                                               nullptr,
+                                               wDesc.GetType() == miopenInt8x4
+                                                   ? GemmBackend_t::rocblas
+                                                   : GemmBackend_t::miopengemm);
+                    }
+
+                    if(gemm_status != miopenStatusSuccess)
+                        MIOPEN_THROW("GEMM execution failure");
+
+                    if(handle.IsProfilingEnabled())
+                        iteration_time += handle.GetKernelTime();
+                }
+
+                if(conv_params.type != InvokeType::Run)
+                    iteration_time *= in_n;
+                time += iteration_time;
+            }
+
+            if(wDesc.GetType() == miopenInt8x4 && yDesc.GetType() != miopenInt32)
+            {
+                TensorDescriptor ygemmDesc(miopenInt32, yDesc.GetLengths(), yDesc.GetStrides());
+
+                CastTensor(handle, &conv.lowp_quant, ygemmDesc, y, yDesc, y, 0, 0);
+
+                if(handle.IsProfilingEnabled())
+                    time += handle.GetKernelTime();
+            }
+
+            return time;
+        };
+
         return [=](const Handle& handle, const AnyInvokeParams& primitive_params) {
             float time_gemm          = 0;
             const auto& conv_params  = primitive_params.CastTo<conv::DataInvokeParams>();
@@ -1020,6 +1322,17 @@ ConvSolution GemmFwdRest::GetSolution(const ExecutionContext& context,
 
             const auto runs = conv_params.type == InvokeType::Run ? in_n : 1;
 
+            if(chunk_rows < out_rows)
+            {
+                time_gemm = RunChunks(handle, conv_params, runs);
+                if(handle.IsProfilingEnabled())
+                {
+                    handle.ResetKernelTime();
+                    handle.AccumKernelTime(time_gemm);
+                }
+                return;
+            }
+
             for(std::size_t i = 0; i < runs; i++)
             {
                 float iteration_time   = 0;
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver/gemm_cost_model.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+constexpr std::size_t CeilDiv(std::size_t a, std::size_t b) { return (a + b - 1) / b; }
+
+// Resources of a compute unit of the xdlops capable devices.
+constexpr std::size_t lds_per_cu         = 64 * 1024;
+constexpr std::size_t max_threads_per_cu = 2048;
+constexpr std::size_t wave_size          = 64;
+// Waves per CU which are enough to hide the latency of the global memory.
+constexpr std::size_t waves_to_hide_latency = 8;
+// Flops per loaded element of a tile, above which the tile is compute bound.
+constexpr float compute_bound_intensity = 32.0f;
+// Overhead of each extra slice of GEMM K, for the atomic reduction of the output.
+constexpr float k_split_overhead = 0.05f;
+
+} // namespace
+
+float EstimateGemmTileCost(const GemmTileShape& shape, const std::size_t num_cu)
+{
+    if(shape.m_per_block == 0 || shape.n_per_block == 0 || shape.k_per_block == 0 ||
+       shape.block_size == 0 || shape.k_splits == 0 || num_cu == 0 ||
+       shape.lds_size > lds_per_cu || shape.block_size > max_threads_per_cu)
+        return std::numeric_limits<float>::max();
+
+    const auto tiles = shape.gemm_g * CeilDiv(shape.gemm_m, shape.m_per_block) *
+                       CeilDiv(shape.gemm_n, shape.n_per_block) * shape.k_splits;
+    // The busiest CU defines the time, this is the wave quantization.
+    const auto tiles_per_cu = CeilDiv(tiles, num_cu);
+
+    // Padded tiles do the full amount of work.
+    const auto k_per_split = CeilDiv(shape.gemm_k, shape.k_splits);
+    const auto tile_work   = static_cast<float>(shape.m_per_block) * shape.n_per_block *
+                           CeilDiv(k_per_split, shape.k_per_block) * shape.k_per_block;
+
+    const auto blocks_per_cu =
+        std::min(shape.lds_size == 0 ? max_threads_per_cu : lds_per_cu / shape.lds_size,
+                 max_threads_per_cu / shape.block_size);
+    const auto active_waves =
+        std::min(blocks_per_cu, tiles_per_cu) * CeilDiv(shape.block_size, wave_size);
+    const auto latency_efficiency =
+        std::min(1.0f, static_cast<float>(active_waves) / waves_to_hide_latency);
+
+    const auto intensity = static_cast<float>(shape.m_per_block * shape.n_per_block) /
+                           (shape.m_per_block + shape.n_per_block);
+    const auto compute_efficiency = std::min(1.0f, intensity / compute_bound_intensity);
+
+    const auto k_split_penalty = 1.0f + k_split_overhead * (shape.k_splits - 1);
+
+    return tiles_per_cu * tile_work * k_split_penalty / (latency_efficiency * compute_efficiency);
+}
+
+} // namespace solver
+} // namespace miopen
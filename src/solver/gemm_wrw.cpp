@@ -2,6 +2,7 @@
 
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/float_equal.hpp>
 #include <miopen/gemm_v2.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/util.hpp>
@@ -153,6 +154,13 @@ bool GemmWrw1x1_stride1::IsApplicable(const ExecutionContext& context,
 #endif
 }
 
+bool GemmWrw1x1_stride1::SupportsAlphaBeta(const ExecutionContext&,
+                                           const conv::ProblemDescription&) const
+{
+    // The GEMMs accumulate into dw, which is scaled by beta beforehand instead of zeroed.
+    return true;
+}
+
 ConvSolution GemmWrw1x1_stride1::GetSolution(const ExecutionContext&,
                                              const conv::ProblemDescription& problem) const
 {
@@ -243,9 +251,19 @@ ConvSolution GemmWrw1x1_stride1::GetSolution(const ExecutionContext&,
             }
             else
             {
-                // Zeroing out the output buffer
-                float zero = 0.0f;
-                SetTensor(handle, dwDesc_, dw, &zero);
+                // dw = alpha * sum_over_batch(dy[i] * transpose(x[i])) + beta * dw
+                if(float_equal(conv_params.beta, 0.0f))
+                {
+                    float zero = 0.0f;
+                    SetTensor(handle, dwDesc_, dw, &zero);
+                }
+                else if(!float_equal(conv_params.beta, 1.0f))
+                {
+                    ScaleTensor(handle, dwDesc_, dw, &conv_params.beta);
+                }
+
+                auto blended_desc  = gemm_desc;
+                blended_desc.alpha = conv_params.alpha;
 
                 if(group_count > 1)
                 {
@@ -257,7 +275,7 @@ ConvSolution GemmWrw1x1_stride1::GetSolution(const ExecutionContext&,
                         const auto in_offset  = i * in_c * in_spatial_size;
 
                         const auto status = CallGemmStridedBatched(
-                            handle, gemm_desc, dy, out_offset, x, in_offset, dw, 0, nullptr);
+                            handle, blended_desc, dy, out_offset, x, in_offset, dw, 0, nullptr);
 
                         if(status != miopenStatusSuccess)
                             MIOPEN_THROW("GemmWrw1x1_stride1 execution failure.");
@@ -275,8 +293,16 @@ ConvSolution GemmWrw1x1_stride1::GetSolution(const ExecutionContext&,
                 else
                 {
                     // dw = sum_over_batch(dy[i] * transpose(x[i])), i is batch id
-                    const auto status = CallGemmStridedBatchedSequential(
-                        handle, gemm_desc, dy, 0, x, 0, dw, 0, nullptr, GemmBackend_t::miopengemm);
+                    const auto status = CallGemmStridedBatchedSequential(handle,
+                                                                         blended_desc,
+                                                                         dy,
+                                                                         0,
+                                                                         x,
+                                                                         0,
+                                                                         dw,
+                                                                         0,
+                                                                         nullptr,
+                                                                         GemmBackend_t::miopengemm);
 
                     if(status != miopenStatusSuccess)
                         MIOPEN_THROW("GemmWrw1x1_stride1 execution failure.");
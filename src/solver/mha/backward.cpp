@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/mha/solvers.hpp>
+
+#include <miopen/mha/invoke_params.hpp>
+#include <miopen/mha/problem_description.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/kernel_build_params.hpp>
+
+#include <string>
+
+namespace miopen {
+
+namespace solver {
+
+namespace mha {
+
+// The work-group size and the query tile of MIOpenMhaBwdDot and the tiles of the other kernels.
+constexpr std::size_t mha_grp    = 256;
+constexpr std::size_t mha_fwd_br = 32;
+constexpr std::size_t mha_bwd_b  = 16;
+
+bool MhaBwd::IsApplicable(const ExecutionContext&,
+                          const miopen::mha::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::mha::Direction::Backward)
+        return false;
+    return IsMhaApplicable(problem);
+}
+
+ConvSolution MhaBwd::GetSolution(const ExecutionContext&,
+                                 const miopen::mha::ProblemDescription& problem) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    const auto build_params = GetMhaBuildParams(problem).GenerateFor(kbp::OpenCL{});
+    const auto bh           = problem.GetBatchHeads();
+    const auto rows         = bh * problem.GetQueries();
+
+    const auto add_kernel = [&](const std::string& name, std::size_t tiles, std::size_t grp1) {
+        auto kernel         = KernelInfo{};
+        kernel.kernel_name  = name;
+        kernel.kernel_file  = "MIOpenMha.cl";
+        kernel.comp_options = build_params;
+        kernel.l_wk         = {mha_grp, 1, 1};
+        kernel.g_wk         = {tiles * mha_grp, grp1, 1};
+        result.construction_params.push_back(kernel);
+    };
+
+    add_kernel("MIOpenMhaBwdDot", (rows + mha_fwd_br - 1) / mha_fwd_br, 1);
+    add_kernel("MIOpenMhaBwdKV", (problem.GetKeys() + mha_bwd_b - 1) / mha_bwd_b, bh);
+    add_kernel("MIOpenMhaBwdQ", (problem.GetQueries() + mha_bwd_b - 1) / mha_bwd_b, bh);
+
+    const auto workspace = problem.GetBackwardWorkspaceSize();
+    result.workspce_sz   = workspace;
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::mha::BwdInvokeParams>();
+
+            if(params.workSpace == nullptr || params.workSpaceSize < workspace)
+                MIOPEN_THROW(miopenStatusBadParm,
+                             "Not enough workspace for attention backward (" +
+                                 std::to_string(params.workSpaceSize) + " provided, " +
+                                 std::to_string(workspace) + " required)");
+
+            const auto rate  = static_cast<float>(params.dropout);
+            const auto scale = static_cast<float>(params.dropout_scale);
+
+            float ctime = 0.;
+            handle_.Run(kernels[0])(
+                params.o, params.dout, params.workSpace, static_cast<uint32_t>(rows));
+            profileSequence(handle_, 0, &ctime);
+
+            handle_.Run(kernels[1])(params.q,
+                                    params.k,
+                                    params.v,
+                                    params.dout,
+                                    params.lse,
+                                    params.workSpace,
+                                    params.dk,
+                                    params.dv,
+                                    params.scale,
+                                    rate,
+                                    scale,
+                                    params.seed,
+                                    params.offset);
+            profileSequence(handle_, 1, &ctime);
+
+            handle_.Run(kernels[2])(params.q,
+                                    params.k,
+                                    params.v,
+                                    params.dout,
+                                    params.lse,
+                                    params.workSpace,
+                                    params.dq,
+                                    params.scale,
+                                    rate,
+                                    scale,
+                                    params.seed,
+                                    params.offset);
+            profileSequence(handle_, 2, &ctime);
+        };
+    };
+
+    return result;
+}
+
+} // namespace mha
+
+} // namespace solver
+
+} // namespace miopen
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/mha/solvers.hpp>
+
+#include <miopen/mha/invoke_params.hpp>
+#include <miopen/mha/problem_description.hpp>
+#include <miopen/kernel_build_params.hpp>
+
+#include <limits>
+
+namespace miopen {
+
+namespace solver {
+
+namespace mha {
+
+// The work-group size and the query tile of MIOpenMhaFwd.
+constexpr std::size_t mha_grp    = 256;
+constexpr std::size_t mha_fwd_br = 32;
+
+bool IsMhaApplicable(const miopen::mha::ProblemDescription& problem)
+{
+    const auto& qDesc = problem.GetQDesc();
+    const auto& kDesc = problem.GetKDesc();
+    if(qDesc.GetType() != miopenFloat && qDesc.GetType() != miopenHalf)
+        return false;
+    // The tiles of a head dimension of up to 128 fit into 64KB of local memory.
+    return problem.GetHeadDim() <= 128 &&
+           problem.GetBatchHeads() * problem.GetQueries() <= std::numeric_limits<uint32_t>::max() &&
+           kDesc.GetElementSize() <= std::numeric_limits<uint32_t>::max() &&
+           qDesc.GetElementSize() <= std::numeric_limits<uint32_t>::max();
+}
+
+KernelBuildParameters GetMhaBuildParams(const miopen::mha::ProblemDescription& problem)
+{
+    const auto is_fp16 = problem.GetQDesc().GetType() == miopenHalf;
+
+    return KernelBuildParameters{
+        {"MIOPEN_USE_FP16", static_cast<int>(is_fp16)},
+        {"MIOPEN_USE_FP32", static_cast<int>(!is_fp16)},
+        {"MIO_MHA_SQ", problem.GetQueries()},
+        {"MIO_MHA_SK", problem.GetKeys()},
+        {"MIO_MHA_D", problem.GetHeadDim()},
+        {"MIO_MHA_CAUSAL", static_cast<int>(problem.IsCausal())},
+        {"MIO_MHA_DROPOUT", static_cast<int>(problem.HasDropout())},
+    };
+}
+
+bool MhaFwd::IsApplicable(const ExecutionContext&,
+                          const miopen::mha::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::mha::Direction::Forward)
+        return false;
+    return IsMhaApplicable(problem);
+}
+
+ConvSolution MhaFwd::GetSolution(const ExecutionContext&,
+                                 const miopen::mha::ProblemDescription& problem) const
+{
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    {
+        auto kernel = KernelInfo{};
+
+        kernel.kernel_name  = "MIOpenMhaFwd";
+        kernel.kernel_file  = "MIOpenMha.cl";
+        kernel.comp_options = GetMhaBuildParams(problem).GenerateFor(kbp::OpenCL{});
+
+        const auto tiles = (problem.GetQueries() + mha_fwd_br - 1) / mha_fwd_br;
+        kernel.l_wk      = {mha_grp, 1, 1};
+        kernel.g_wk      = {tiles * mha_grp, problem.GetBatchHeads(), 1};
+
+        result.construction_params.push_back(kernel);
+    }
+
+    result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::mha::InvokeParams>();
+
+            handle_.Run(kernels.front())(params.q,
+                                         params.k,
+                                         params.v,
+                                         params.o,
+                                         params.lse,
+                                         params.scale,
+                                         static_cast<float>(params.dropout),
+                                         static_cast<float>(params.dropout_scale),
+                                         params.seed,
+                                         params.offset);
+        };
+    };
+
+    return result;
+}
+
+} // namespace mha
+
+} // namespace solver
+
+} // namespace miopen
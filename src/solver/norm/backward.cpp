@@ -0,0 +1,179 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/norm/solvers.hpp>
+
+#include <miopen/norm/invoke_params.hpp>
+#include <miopen/norm/problem_description.hpp>
+#include <miopen/batch_norm.hpp>
+#include <miopen/kernel_build_params.hpp>
+
+namespace miopen {
+
+namespace solver {
+
+namespace norm {
+
+bool NormBwd::IsApplicable(const ExecutionContext&,
+                           const miopen::norm::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::norm::Direction::Backward)
+        return false;
+    if(problem.GetDYDesc().GetLengths() != problem.GetXDesc().GetLengths() ||
+       problem.GetDYDesc().GetType() != problem.GetXDesc().GetType() ||
+       !problem.GetDYDesc().IsPacked())
+        return false;
+    return IsNormApplicable(problem, problem.GetDXDesc());
+}
+
+ConvSolution NormBwd::GetSolution(const ExecutionContext&,
+                                  const miopen::norm::ProblemDescription& problem) const
+{
+    const auto geo = NormRowGeometry{problem.GetRowLength()};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    {
+        auto kernel = KernelInfo{};
+
+        kernel.kernel_name = "MIOpenNormBwdData";
+        kernel.kernel_file = "MIOpenNorm.cl";
+
+        auto build_params = GetNormBuildParams(problem);
+        build_params.Define("MIO_NORM_GRP0", geo.grp0);
+        build_params.Define("MIO_NORM_CACHED", static_cast<int>(geo.cached));
+
+        kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{});
+
+        kernel.l_wk.push_back(geo.grp0);
+        kernel.l_wk.push_back(1);
+        kernel.l_wk.push_back(1);
+
+        kernel.g_wk.push_back(geo.grp0 * problem.GetRows());
+        kernel.g_wk.push_back(1);
+        kernel.g_wk.push_back(1);
+
+        result.construction_params.push_back(kernel);
+    }
+
+    if(problem.IsAffine())
+    {
+        auto kernel = KernelInfo{};
+
+        kernel.kernel_file = "MIOpenNorm.cl";
+
+        auto build_params  = GetNormBuildParams(problem);
+        const auto nparams = problem.GetParamCount();
+
+        if(problem.GetParamDiv() == 1)
+        {
+            // A parameter per column of a row: 64 of them per work-group, each summed by 4 lanes.
+            const std::size_t grp0 = 64;
+            const std::size_t grp1 = 4;
+
+            kernel.kernel_name = "MIOpenNormBwdParamsColumns";
+            build_params.Define("MIO_NORM_GRP0", grp0);
+            build_params.Define("MIO_NORM_PARAM_GRP1", grp1);
+
+            kernel.l_wk = {grp0, grp1, 1};
+            kernel.g_wk = {(nparams + grp0 - 1) / grp0 * grp0, grp1, 1};
+        }
+        else
+        {
+            const std::size_t grp0 = 256;
+
+            kernel.kernel_name = "MIOpenNormBwdParamsChannels";
+            build_params.Define("MIO_NORM_GRP0", grp0);
+
+            kernel.l_wk = {grp0, 1, 1};
+            kernel.g_wk = {grp0 * nparams, 1, 1};
+        }
+        build_params.Define("MIO_NORM_CACHED", 0);
+
+        kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{});
+
+        result.construction_params.push_back(kernel);
+    }
+
+    result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::norm::BwdInvokeParams>();
+
+            const auto alpha = static_cast<float>(params.alpha);
+            const auto beta  = static_cast<float>(params.beta);
+            const auto gamma = static_cast<float>(params.gamma);
+            const auto rate  = static_cast<float>(params.dropout);
+            const auto scale = static_cast<float>(params.dropout_scale);
+
+            float ctime = 0.;
+            handle_.Run(kernels[0])(params.x,
+                                    params.residual,
+                                    params.dy,
+                                    params.weight,
+                                    params.bias,
+                                    params.mean,
+                                    params.rstd,
+                                    params.dx,
+                                    params.dresidual,
+                                    alpha,
+                                    beta,
+                                    gamma,
+                                    rate,
+                                    scale,
+                                    params.seed,
+                                    params.offset);
+            if(kernels.size() == 1)
+                return;
+            profileSequence(handle_, 0, &ctime);
+
+            handle_.Run(kernels[1])(params.x,
+                                    params.residual,
+                                    params.dy,
+                                    params.weight,
+                                    params.bias,
+                                    params.mean,
+                                    params.rstd,
+                                    params.dweight,
+                                    params.dbias,
+                                    alpha,
+                                    beta,
+                                    gamma,
+                                    rate,
+                                    scale,
+                                    params.seed,
+                                    params.offset);
+            profileSequence(handle_, 2, &ctime);
+        };
+    };
+
+    return result;
+}
+
+} // namespace norm
+
+} // namespace solver
+
+} // namespace miopen
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/norm/solvers.hpp>
+
+#include <miopen/norm/invoke_params.hpp>
+#include <miopen/norm/problem_description.hpp>
+#include <miopen/kernel_build_params.hpp>
+
+#include <limits>
+
+namespace miopen {
+
+namespace solver {
+
+namespace norm {
+
+NormRowGeometry::NormRowGeometry(std::size_t row_length)
+{
+    grp0 = 64;
+    while(grp0 < row_length && grp0 < 256)
+        grp0 *= 2;
+    ept = (row_length + grp0 - 1) / grp0;
+    // Rows of up to 2K elements stay in registers and are read once.
+    cached = ept <= 8;
+}
+
+bool IsNormApplicable(const miopen::norm::ProblemDescription& problem,
+                      const TensorDescriptor& out)
+{
+    const auto& xDesc = problem.GetXDesc();
+    if(xDesc.GetType() != miopenFloat && xDesc.GetType() != miopenHalf)
+        return false;
+    if(!xDesc.IsPacked() || !out.IsPacked() || out.GetLengths() != xDesc.GetLengths() ||
+       out.GetType() != xDesc.GetType())
+        return false;
+    if(problem.IsAffine() && (problem.GetWeightDesc().GetType() != xDesc.GetType() ||
+                              problem.GetWeightDesc().GetElementSize() != problem.GetParamCount()))
+        return false;
+
+    const auto geo = NormRowGeometry{problem.GetRowLength()};
+    return xDesc.GetElementSize() <= std::numeric_limits<uint32_t>::max() &&
+           problem.GetRows() * geo.grp0 <= std::numeric_limits<uint32_t>::max();
+}
+
+KernelBuildParameters GetNormBuildParams(const miopen::norm::ProblemDescription& problem)
+{
+    const auto is_fp16 = problem.GetXDesc().GetType() == miopenHalf;
+
+    return KernelBuildParameters{
+        {"MIOPEN_USE_FP16", static_cast<int>(is_fp16)},
+        {"MIOPEN_USE_FP32", static_cast<int>(!is_fp16)},
+        {"MIO_NORM_K", problem.GetRowLength()},
+        {"MIO_NORM_ROWS", problem.GetRows()},
+        {"MIO_NORM_G", problem.GetParamGroups()},
+        {"MIO_NORM_D", problem.GetParamDiv()},
+        {"MIO_NORM_AFFINE", static_cast<int>(problem.IsAffine())},
+        {"MIO_NORM_RESIDUAL", static_cast<int>(problem.HasResidual())},
+        {"MIO_NORM_DROPOUT", static_cast<int>(problem.HasDropout())},
+        {"MIO_NORM_ACTIV", static_cast<int>(problem.GetActivDesc().GetMode())},
+    };
+}
+
+bool NormFwd::IsApplicable(const ExecutionContext&,
+                           const miopen::norm::ProblemDescription& problem) const
+{
+    if(problem.GetDirection() != miopen::norm::Direction::Forward)
+        return false;
+    return IsNormApplicable(problem, problem.GetYDesc());
+}
+
+ConvSolution NormFwd::GetSolution(const ExecutionContext&,
+                                  const miopen::norm::ProblemDescription& problem) const
+{
+    const auto geo = NormRowGeometry{problem.GetRowLength()};
+
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    {
+        auto kernel = KernelInfo{};
+
+        kernel.kernel_name = "MIOpenNormFwd";
+        kernel.kernel_file = "MIOpenNorm.cl";
+
+        auto build_params = GetNormBuildParams(problem);
+        build_params.Define("MIO_NORM_SAVE_STATS", static_cast<int>(problem.GetSaveStats()));
+        build_params.Define("MIO_NORM_GRP0", geo.grp0);
+        build_params.Define("MIO_NORM_CACHED", static_cast<int>(geo.cached));
+
+        kernel.comp_options = build_params.GenerateFor(kbp::OpenCL{});
+
+        kernel.l_wk.push_back(geo.grp0);
+        kernel.l_wk.push_back(1);
+        kernel.l_wk.push_back(1);
+
+        kernel.g_wk.push_back(geo.grp0 * problem.GetRows());
+        kernel.g_wk.push_back(1);
+        kernel.g_wk.push_back(1);
+
+        result.construction_params.push_back(kernel);
+    }
+
+    result.invoker_factory = [](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::norm::InvokeParams>();
+
+            handle_.Run(kernels.front())(params.x,
+                                         params.residual,
+                                         params.weight,
+                                         params.bias,
+                                         params.y,
+                                         params.mean,
+                                         params.rstd,
+                                         static_cast<float>(params.epsilon),
+                                         static_cast<float>(params.alpha),
+                                         static_cast<float>(params.beta),
+                                         static_cast<float>(params.gamma),
+                                         static_cast<float>(params.dropout),
+                                         static_cast<float>(params.dropout_scale),
+                                         params.seed,
+                                         params.offset);
+        };
+    };
+
+    return result;
+}
+
+} // namespace norm
+
+} // namespace solver
+
+} // namespace miopen
@@ -30,11 +30,13 @@
 #include <miopen/logger.hpp>
 #include <miopen/md5.hpp>
 #include <miopen/problem_description.hpp>
+#include <miopen/activ/problem_description.hpp>
+#include <miopen/batchnorm/problem_description.hpp>
+#include <miopen/reduce/problem_description.hpp>
+#include <miopen/gemm/problem_description.hpp>
 #include <miopen/exp_backoff.hpp>
 
-#if MIOPEN_EMBED_DB
-#include <miopen_data.hpp>
-#endif
+#include <miopen/embedded_db.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
@@ -90,16 +92,14 @@ class SQLite::impl
         if(is_system)
         {
 
-            const auto& it_p = miopen_data().find(filepath.filename().string() + ".o");
-            if(it_p == miopen_data().end())
+            const auto p = embedded::GetFile(filepath.filename().string());
+            if(p.first == nullptr)
             {
                 MIOPEN_LOG_I("Unknown database: " + filepath.string() + " in internal file cache");
                 return SQLITE_ERROR;
             }
-            const auto& p    = it_p->second;
-            ptrdiff_t ptr_sz = p.second - p.first;
-            char* memuri     = sqlite3_mprintf(
-                "file:ignoredFilename?ptr=0x%p&sz=%lld", p.first, static_cast<long long>(ptr_sz));
+            char* memuri = sqlite3_mprintf(
+                "file:ignoredFilename?ptr=0x%p&sz=%lld", p.first, static_cast<long long>(p.second));
             if(sqlite3_open_v2(
                    memuri, &ptr_tmp, SQLITE_OPEN_READWRITE | SQLITE_OPEN_URI, nullptr) != SQLITE_OK)
             {
@@ -359,6 +359,12 @@ int SQLite::Statement::BindInt64(int idx, const int64_t num)
     return 0;
 }
 
+void SQLite::Statement::Reset()
+{
+    sqlite3_reset(pImpl->ptrStmt.get());
+    sqlite3_clear_bindings(pImpl->ptrStmt.get());
+}
+
 SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system)
     : SQLiteBase(filename_, is_system)
 {
@@ -405,6 +411,47 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system)
                 sql.Exec(create_config_sql);
             }
         }
+        {
+            // Batch normalization problems have their own table, which the older user databases
+            // lack, hence it is created even if the config table exists.
+            const auto desc         = TensorDescriptor{miopenFloat, {1, 1, 1, 1}};
+            const auto bn_prob_desc =
+                batchnorm::ProblemDescription{batchnorm::Direction::ForwardTraining,
+                                              miopenBNSpatial,
+                                              desc,
+                                              desc,
+                                              desc,
+                                              0.,
+                                              0.,
+                                              false,
+                                              false};
+            sql.Exec(bn_prob_desc.CreateQuery());
+        }
+        {
+            // The same goes for the activation problems.
+            const auto desc = TensorDescriptor{miopenFloat, {1, 1}};
+            const auto activ_prob_desc =
+                activ::ProblemDescription{ActivationDescriptor{}, desc, desc};
+            sql.Exec(activ_prob_desc.CreateQuery());
+        }
+        {
+            // And for the reductions.
+            const auto desc   = TensorDescriptor{miopenFloat, {1, 1}};
+            const auto reduce = ReduceTensorDescriptor{MIOPEN_REDUCE_TENSOR_ADD,
+                                                       miopenFloat,
+                                                       MIOPEN_NOT_PROPAGATE_NAN,
+                                                       MIOPEN_REDUCE_TENSOR_NO_INDICES,
+                                                       MIOPEN_32BIT_INDICES};
+            const auto reduce_prob_desc = reduce::ProblemDescription{reduce, desc, desc};
+            sql.Exec(reduce_prob_desc.CreateQuery());
+        }
+        {
+            // And for the rocBLAS solutions of the GEMMs.
+            const auto gemm_desc =
+                GemmDescriptor{false, false, false, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 0, miopenFloat};
+            const auto gemm_prob_desc = gemm::ProblemDescription{gemm_desc, false};
+            sql.Exec(gemm_prob_desc.CreateQuery());
+        }
         {
             // clang-format off
             const auto check_tables =
@@ -439,4 +486,122 @@ SQLitePerfDb::SQLitePerfDb(const std::string& filename_, bool is_system)
         }
     }
 }
+
+SQLitePerfDb::~SQLitePerfDb()
+{
+    try
+    {
+        Flush();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E("Unable to write pending updates to " << filename << ": " << ex.what());
+    }
+}
+
+void SQLitePerfDb::FlushAll()
+{
+    ForEachCached([](SQLitePerfDb& db) { db.Flush(); });
+}
+
+void SQLitePerfDb::Flush()
+{
+    if(pending == nullptr || dbInvalid)
+        return;
+    std::lock_guard<std::mutex> lock{pending->mutex};
+    FlushUnsafe(*pending);
+}
+
+std::string SQLitePerfDb::GetConfigKey(const std::string& table,
+                                       const std::string& clause,
+                                       const std::vector<std::string>& values)
+{
+    auto key = table + '\n' + clause;
+    for(const auto& value : values)
+        key += '\n' + value;
+    return key;
+}
+
+bool SQLitePerfDb::Write(const PendingWrite& write)
+{
+    // UPSERT the value
+    {
+        auto stmt = SQLite::Statement{sql, write.config_query, write.config_values};
+        auto rc   = stmt.Step(sql);
+        if(rc != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "Failed to insert config: " + sql.ErrorMessage());
+        auto cnt = sql.Changes();
+        MIOPEN_LOG_I2(cnt << " rows updated");
+    }
+
+    // UPSERT perf values
+    {
+        auto stmt = SQLite::Statement{sql, write.perf_query, write.perf_values};
+        auto rc   = stmt.Step(sql);
+        if(rc != SQLITE_DONE)
+        {
+            MIOPEN_LOG_E("Failed to insert performance record in the database: " +
+                         sql.ErrorMessage());
+            return false;
+        }
+    }
+    return true;
+}
+
+void SQLitePerfDb::AddPendingWrite(PendingWrite&& write)
+{
+    const auto& limits = DbWriteBatchLimits::Get();
+    std::lock_guard<std::mutex> lock{pending->mutex};
+
+    const auto& solver = write.perf_values[write.perf_values.size() - 2];
+    const auto& params = write.perf_values.back();
+    pending->records[write.config_key].SetValues(solver, params);
+
+    if(pending->writes.empty())
+        pending->first_write = std::chrono::steady_clock::now();
+    pending->writes.push_back(std::move(write));
+
+    if(pending->writes.size() >= limits.size ||
+       std::chrono::steady_clock::now() - pending->first_write >= limits.timeout)
+        FlushUnsafe(*pending);
+}
+
+void SQLitePerfDb::FlushUnsafe(PendingWrites& pending_writes)
+{
+    if(pending_writes.writes.empty())
+        return;
+
+    MIOPEN_LOG_I2("Writing " << pending_writes.writes.size() << " updates to " << filename);
+    // The batch is written as a single transaction, so the journal guarantees that either
+    // all or none of it gets to the database.
+    sql.Exec("BEGIN IMMEDIATE TRANSACTION;");
+    try
+    {
+        for(const auto& write : pending_writes.writes)
+            Write(write);
+        sql.Exec("COMMIT;");
+    }
+    catch(...)
+    {
+        pending_writes.writes.clear();
+        pending_writes.records.clear();
+        sql.Exec("ROLLBACK;");
+        throw;
+    }
+    pending_writes.writes.clear();
+    pending_writes.records.clear();
+}
+
+void SQLitePerfDb::MergePendingWrites(const std::string& config_key, DbRecord& record)
+{
+    if(pending == nullptr)
+        return;
+    std::lock_guard<std::mutex> lock{pending->mutex};
+    const auto it = pending->records.find(config_key);
+    if(it == pending->records.end())
+        return;
+    for(const auto& value : it->second.map)
+        record.SetValues(value.first, value.second);
+}
 } // namespace miopen
@@ -34,7 +34,7 @@
 
 namespace miopen {
 
-TensorDescriptor::TensorDescriptor() : packed(true) {}
+TensorDescriptor::TensorDescriptor() : packed(true) { this->CalculateDerived(); }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t, std::initializer_list<std::size_t> plens)
     : lens(plens), packed(true), type(t)
@@ -47,7 +47,7 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    std::initializer_list<std::size_t> pstrides)
     : lens(plens), strides(pstrides), type(t)
 {
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->CalculateDerived();
 }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t, const int* plens, int size)
@@ -67,7 +67,7 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
         MIOPEN_THROW("Invalid length. Length must be greater than 0.");
     if(!std::all_of(pstrides, pstrides + size, [](int x) { return x >= 0; }))
         MIOPEN_THROW("Invalid strides. Strides must be greater than 0.");
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->CalculateDerived();
 }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t,
@@ -75,18 +75,35 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    std::vector<std::size_t> strides_in)
     : lens(std::move(lens_in)), strides(std::move(strides_in)), type(t)
 {
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->CalculateDerived();
 }
 
 void TensorDescriptor::CalculateStrides()
 {
     strides.clear();
     strides.resize(lens.size(), 0);
-    if(strides.empty())
-        return;
-    strides.back() = 1;
-    std::partial_sum(
-        lens.rbegin(), lens.rend() - 1, strides.rbegin() + 1, std::multiplies<std::size_t>());
+    if(!strides.empty())
+    {
+        strides.back() = 1;
+        std::partial_sum(
+            lens.rbegin(), lens.rend() - 1, strides.rbegin() + 1, std::multiplies<std::size_t>());
+    }
+    this->CalculateDerived();
+    // Computed strides are packed, also with zero lengths, when the element space wraps around.
+    packed = true;
+}
+
+void TensorDescriptor::CalculateDerived()
+{
+    assert(lens.size() == strides.size());
+    element_size  = 1;
+    element_space = 1;
+    for(std::size_t i = 0; i < lens.size(); ++i)
+    {
+        element_size *= lens[i];
+        element_space += (lens[i] - 1) * strides[i];
+    }
+    packed = element_size == element_space;
 }
 
 const std::vector<std::size_t>& TensorDescriptor::GetLengths() const { return lens; }
@@ -96,12 +113,7 @@ int TensorDescriptor::GetSize() const
     assert(lens.size() == strides.size());
     return lens.size();
 }
-std::size_t TensorDescriptor::GetElementSize() const
-{
-    assert(lens.size() == strides.size());
-    return std::accumulate(
-        lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
-}
+std::size_t TensorDescriptor::GetElementSize() const { return element_size; }
 miopenDataType_t TensorDescriptor::GetType() const { return this->type; }
 
 std::size_t TensorDescriptor::GetIndex(std::initializer_list<int> l) const
@@ -110,18 +122,7 @@ std::size_t TensorDescriptor::GetIndex(std::initializer_list<int> l) const
     return std::inner_product(l.begin(), l.end(), strides.begin(), std::size_t{0});
 }
 
-std::size_t TensorDescriptor::GetElementSpace() const
-{
-    std::vector<std::size_t> maxIndices(lens.size());
-    std::transform(lens.begin(),
-                   lens.end(),
-                   std::vector<std::size_t>(lens.size(), 1).begin(),
-                   maxIndices.begin(),
-                   std::minus<std::size_t>());
-    return std::inner_product(
-               maxIndices.begin(), maxIndices.end(), strides.begin(), std::size_t{0}) +
-           1;
-}
+std::size_t TensorDescriptor::GetElementSpace() const { return element_space; }
 
 bool TensorDescriptor::IsPossibleLayout(const std::string& labels, const std::string& layout) const
 {
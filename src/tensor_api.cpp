@@ -25,11 +25,14 @@
  *******************************************************************************/
 #include <array>
 #include <initializer_list>
+#include <miopen/activ.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/layout_support.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/util.hpp>
 
 extern "C" miopenStatus_t miopenCreateTensorDescriptor(miopenTensorDescriptor_t* tensorDesc)
 {
@@ -152,6 +155,17 @@ extern "C" miopenStatus_t miopenGetTensorNumBytes(miopenTensorDescriptor_t tenso
     return miopen::try_([&] { miopen::deref(numBytes) = miopen::deref(tensorDesc).GetNumBytes(); });
 }
 
+extern "C" miopenStatus_t miopenIsTensorLayoutNative(miopenPrimitive_t primitive,
+                                                     const miopenTensorDescriptor_t tensorDesc,
+                                                     bool* isNative)
+{
+    MIOPEN_LOG_FUNCTION(primitive, tensorDesc, isNative);
+    return miopen::try_([&] {
+        miopen::deref(isNative) =
+            miopen::IsTensorLayoutNative(primitive, miopen::deref(tensorDesc));
+    });
+}
+
 // Internal API
 int miopenGetTensorDescriptorElementSize(miopenTensorDescriptor_t tensorDesc)
 {
@@ -269,6 +283,46 @@ extern "C" miopenStatus_t miopenOpTensor(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t miopenOpTensorActivation(miopenHandle_t handle,
+                                                   miopenTensorOp_t tensorOp,
+                                                   const void* alpha1,
+                                                   const miopenTensorDescriptor_t aDesc,
+                                                   const void* A,
+                                                   const void* alpha2,
+                                                   const miopenTensorDescriptor_t bDesc,
+                                                   const void* B,
+                                                   const void* beta,
+                                                   const miopenTensorDescriptor_t cDesc,
+                                                   void* C,
+                                                   const miopenActivationDescriptor_t activDesc)
+{
+
+    MIOPEN_LOG_FUNCTION(tensorOp, alpha1, aDesc, A, alpha2, bDesc, B, beta, cDesc, C, activDesc);
+    return miopen::try_([&] {
+        const auto activ = (activDesc != nullptr)
+                               ? miopen::deref(activDesc)
+                               : miopen::ActivationDescriptor{miopenActivationPASTHRU, 0, 0, 0};
+        OpTensorElementwise(miopen::deref(handle),
+                            tensorOp,
+                            alpha1,
+                            miopen::deref(aDesc),
+                            DataCast(A),
+                            alpha2,
+                            miopen::deref(bDesc),
+                            DataCast(B),
+                            beta,
+                            miopen::deref(cDesc),
+                            DataCast(C),
+                            0,
+                            0,
+                            0,
+                            activ.GetMode(),
+                            activ.GetAlpha(),
+                            activ.GetBeta(),
+                            activ.GetGamma());
+    });
+}
+
 extern "C" miopenStatus_t miopenSetTensor(miopenHandle_t handle,
                                           const miopenTensorDescriptor_t yDesc,
                                           void* y,
@@ -315,3 +369,24 @@ extern "C" miopenStatus_t miopenTransformTensor(miopenHandle_t handle,
                         DataCast(y));
     });
 }
+
+extern "C" miopenStatus_t miopenTransposeTensor(miopenHandle_t handle,
+                                                const miopenTensorDescriptor_t xDesc,
+                                                const void* x,
+                                                const int* perm,
+                                                const miopenTensorDescriptor_t yDesc,
+                                                void* y)
+{
+    MIOPEN_LOG_FUNCTION(handle, xDesc, x, perm, yDesc, y);
+    return miopen::try_([&] {
+        if(perm == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "The permutation is not set");
+        const auto& desc = miopen::deref(xDesc);
+        miopen::PermuteTensorGPU(miopen::deref(handle),
+                                 desc,
+                                 DataCast(x),
+                                 miopen::deref(yDesc),
+                                 DataCast(y),
+                                 std::vector<int>(perm, perm + desc.GetSize()));
+    });
+}
@@ -0,0 +1,253 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+
+#include <miopen/env.hpp>
+
+#if MIOPEN_USE_ROCTX
+#include <roctracer/roctx.h>
+#endif
+
+#include <unistd.h>
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_FILE)
+
+namespace miopen {
+namespace trace {
+
+namespace {
+
+// Bounds the memory of long runs, about a gigabyte at most.
+constexpr std::size_t max_events = 4 * 1024 * 1024;
+// The GPU timeline, the threads of the host are numbered from 1 in the order of their events.
+constexpr int gpu_tid = 0;
+
+struct Event
+{
+    char phase;
+    const char* category;
+    std::string name;
+    std::string detail;
+    Clock::time_point begin;
+    Clock::duration duration;
+    int tid;
+};
+
+int ThreadId()
+{
+    static std::atomic<int> next{gpu_tid + 1};
+    thread_local const int id = next++;
+    return id;
+}
+
+void WriteString(std::ostream& os, const std::string& str)
+{
+    os << '"';
+    for(const auto c : str)
+    {
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+               << std::dec << std::setfill(' ');
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+void WriteMicroseconds(std::ostream& os, Clock::duration duration)
+{
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    // GPU events estimated to begin before the first event of the host.
+    if(ns < 0)
+    {
+        os << '-';
+        ns = -ns;
+    }
+    os << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+}
+
+class Recorder
+{
+    public:
+    explicit Recorder(std::string path_) : path(std::move(path_)) {}
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+    ~Recorder() { Write(); }
+
+    void Add(Event&& event)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(events.size() >= max_events)
+        {
+            dropped = true;
+            return;
+        }
+        events.push_back(std::move(event));
+    }
+
+    void Write()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ofstream file{path, std::ios::out | std::ios::trunc};
+        if(!file)
+            return;
+        const auto pid = getpid();
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+             << ",\"args\":{\"name\":\"MIOpen\"}},\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << gpu_tid
+             << ",\"args\":{\"name\":\"GPU\"}}";
+        for(const auto& event : events)
+        {
+            file << ",\n{\"name\":";
+            WriteString(file, event.name);
+            file << ",\"cat\":\"" << event.category << "\",\"ph\":\"" << event.phase
+                 << "\",\"pid\":" << pid << ",\"tid\":" << event.tid << ",\"ts\":";
+            WriteMicroseconds(file, event.begin - origin);
+            if(event.phase == 'X')
+            {
+                file << ",\"dur\":";
+                WriteMicroseconds(file, event.duration);
+            }
+            else
+            {
+                file << ",\"s\":\"t\"";
+            }
+            if(!event.detail.empty())
+            {
+                file << ",\"args\":{\"detail\":";
+                WriteString(file, event.detail);
+                file << '}';
+            }
+            file << '}';
+        }
+        file << "\n],\"otherData\":{\"dropped_events\":" << (dropped ? "true" : "false")
+             << "}}\n";
+    }
+
+    private:
+    std::string path;
+    std::mutex mutex;
+    std::vector<Event> events;
+    const Clock::time_point origin = Clock::now();
+    bool dropped                   = false;
+};
+
+Recorder* GetRecorder()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static const auto recorder = []() -> std::unique_ptr<Recorder> {
+        const auto path = GetStringEnv(MIOPEN_TRACE_FILE{});
+        if(path == nullptr || *path == '\0')
+            return nullptr;
+        return std::make_unique<Recorder>(path);
+    }();
+    return recorder.get();
+}
+
+} // namespace
+
+bool IsEnabled() { return GetRecorder() != nullptr; }
+
+void Complete(const char* category,
+              const std::string& name,
+              Clock::time_point begin,
+              Clock::time_point end,
+              const std::string& detail)
+{
+    auto* const recorder = GetRecorder();
+    if(recorder != nullptr)
+        recorder->Add({'X', category, name, detail, begin, end - begin, ThreadId()});
+}
+
+void Instant(const char* category, const std::string& name, const std::string& detail)
+{
+    auto* const recorder = GetRecorder();
+    if(recorder != nullptr)
+        recorder->Add({'i', category, name, detail, Clock::now(), {}, ThreadId()});
+}
+
+void Gpu(const std::string& name, Clock::time_point end, float elapsed_ms)
+{
+    auto* const recorder = GetRecorder();
+    if(recorder == nullptr)
+        return;
+    const auto duration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float, std::milli>{elapsed_ms});
+    recorder->Add({'X', "kernel", name, {}, end - duration, duration, gpu_tid});
+}
+
+void Flush()
+{
+    auto* const recorder = GetRecorder();
+    if(recorder != nullptr)
+        recorder->Write();
+}
+
+Scope::Scope(const char* category_, const char* name_) : category(category_) { Begin(name_); }
+
+Scope::Scope(const char* category_, const std::string& name_) : category(category_)
+{
+    Begin(name_.c_str());
+}
+
+void Scope::Begin(const char* name_)
+{
+#if MIOPEN_USE_ROCTX
+    roctxRangePushA(name_);
+    active = true;
+#endif
+    if(IsEnabled())
+    {
+        name   = name_;
+        begin  = Clock::now();
+        active = true;
+    }
+}
+
+Scope::~Scope()
+{
+    if(!active)
+        return;
+#if MIOPEN_USE_ROCTX
+    roctxRangePop();
+#endif
+    if(!name.empty())
+        Complete(category, name, begin, Clock::now());
+}
+
+} // namespace trace
+} // namespace miopen
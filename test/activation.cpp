@@ -56,6 +56,9 @@ std::string to_name(miopenActivationMode_t m)
         STRING_CASE(miopenActivationCLIPPEDRELU)
         STRING_CASE(miopenActivationLEAKYRELU)
         STRING_CASE(miopenActivationELU)
+        STRING_CASE(miopenActivationGELU)
+        STRING_CASE(miopenActivationSILU)
+        STRING_CASE(miopenActivationMISH)
     }
     return "";
 }
@@ -246,6 +249,29 @@ struct activation_driver : test_driver
             miopenActivationELU,
             [=](double x) { return (x > 0) ? x : alpha * std::expm1(x); },
             [=](double dy, double x, double y) { return dy * ((x > 0) ? 1 : y + alpha); });
+        add_mode(
+            miopenActivationGELU,
+            [=](double x) { return 0.5 * x * (1 + std::erf(x / std::sqrt(2.))); },
+            [=](double dy, double x, double) {
+                double cdf = 0.5 * (1 + std::erf(x / std::sqrt(2.)));
+                double pdf = std::exp(-0.5 * x * x) / std::sqrt(2. * 3.14159265358979323846);
+                return dy * (cdf + x * pdf);
+            });
+        add_mode(
+            miopenActivationSILU,
+            [=](double x) { return x / (1 + std::exp(-x)); },
+            [=](double dy, double x, double) {
+                double s = 1 / (1 + std::exp(-x));
+                return dy * s * (1 + x * (1 - s));
+            });
+        add_mode(
+            miopenActivationMISH,
+            [=](double x) { return x * std::tanh(std::log1p(std::exp(x))); },
+            [=](double dy, double x, double) {
+                double t = std::tanh(std::log1p(std::exp(x)));
+                double s = 1 / (1 + std::exp(-x));
+                return dy * (t + x * s * (1 - t * t));
+            });
         add(input,
             "input",
             get_input_tensor(tensor_elem_gen_integer{miopen_type<T>{} == miopenHalf ? 5 : 17}));
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/aot_package.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct AotPackageTest
+{
+    void Run() const
+    {
+        RestoresDbKeys();
+        RejectsOtherKeys();
+        CollectsDbProblems();
+    }
+
+    private:
+    static std::string RoundTrip(const std::string& key)
+    {
+        auto problem = conv::ProblemDescription{};
+        EXPECT(problem.Deserialize(key));
+        std::ostringstream ss;
+        problem.Serialize(ss);
+        return ss.str();
+    }
+
+    void RestoresDbKeys() const
+    {
+        for(const auto& key : {"576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F",
+                               "64-28-28-3x3-32-28-28-16-1x1-1x1-1x1-0-NHWC-NHWC-NHWC-FP16-B",
+                               "3-32-32-3x3-16-30-30-4-0x0-1x1-1x1-0-NCHW-INT8INT8INT32-F",
+                               "16-4-14-14-3x3x3-32-4-14-14-2-1x1x1-1x1x1-1x1x1-0-NCDHW-BF16-W_g2"})
+            EXPECT_EQUAL(RoundTrip(key), key);
+
+        auto problem = conv::ProblemDescription{};
+        EXPECT(problem.Deserialize("64-28-28-3x3-32-14-14-16-1x1-2x2-1x1-0-NCHW-FP32-B_g4"));
+        // The input of the backward directions is dy.
+        EXPECT(problem.GetWeights().GetLengths() == std::vector<std::size_t>{64, 8, 3, 3});
+        EXPECT(problem.GetIn().GetLengths() == std::vector<std::size_t>{16, 64, 28, 28});
+        EXPECT(problem.GetConv().GetConvStrides() == std::vector<int>{2, 2});
+        EXPECT_EQUAL(problem.GetGroupCount(), 4);
+    }
+
+    void RejectsOtherKeys() const
+    {
+        auto problem = conv::ProblemDescription{};
+        EXPECT(!problem.Deserialize("64x56x56x32-1110-packed-FP32-FP32-FP32-op0-n0-i0"));
+        EXPECT(!problem.Deserialize("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-X"));
+        EXPECT(!problem.Deserialize("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP24-F"));
+        EXPECT(!problem.Deserialize("576-4-4-1x1-192-4-4-8-1x1-2x2-0-NCHW-FP32-F"));
+        EXPECT(!problem.Deserialize("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHX-FP32-F"));
+        EXPECT(!problem.Deserialize("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F_g5"));
+    }
+
+    void CollectsDbProblems() const
+    {
+        const TmpDir dir{"test_aot_package"};
+        const auto path = (dir.path / "find.txt").string();
+        std::ofstream{path} << "576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F=a:S1,2,0,x,y\n"
+                            << "64x56x56x32-1110-packed-FP32-FP32-FP32-op0-n0-i0=a:S1,2,0,x,y\n"
+                            << "3-32-32-3x3-16-30-30-4-0x0-1x1-1x1-0-NCHW-FP32-F=a:S1,2,0,x,y\n"
+                            << "3-32-32-3x3-16-30-30-4-0x0-1x1-1x1-0-NCHW-FP32-F=\n";
+
+        auto packager = AotPackager{};
+        packager.AddDbs({path, path});
+        EXPECT_EQUAL(packager.GetProblemCount(), 1);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::AotPackageTest{}.Run(); }
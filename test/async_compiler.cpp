@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/async_compiler.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct AsyncCompilerTest
+{
+    void Run() const
+    {
+        RunsJobs();
+        DeduplicatesJobs();
+        PropagatesErrors();
+    }
+
+    private:
+    static void RunsJobs()
+    {
+        constexpr int jobs_count = 32;
+
+        AsyncCompiler compiler;
+        std::atomic<int> runs{0};
+        std::vector<std::shared_future<Program>> futures;
+        for(auto i = 0; i < jobs_count; ++i)
+        {
+            futures.push_back(compiler.Submit({"program_" + std::to_string(i), ""}, [&]() {
+                ++runs;
+                return Program{};
+            }));
+        }
+        compiler.Wait();
+
+        EXPECT_EQUAL(runs.load(), jobs_count);
+        for(const auto& future : futures)
+            EXPECT(future.wait_for(std::chrono::seconds{0}) == std::future_status::ready);
+    }
+
+    static void DeduplicatesJobs()
+    {
+        AsyncCompiler compiler;
+        std::promise<void> release;
+        const auto released = release.get_future().share();
+        std::atomic<int> runs{0};
+        const auto job = [&]() {
+            released.wait();
+            ++runs;
+            return Program{};
+        };
+
+        const auto first  = compiler.Submit({"program", "-O3"}, job);
+        const auto second = compiler.Submit({"program", "-O3"}, job);
+        const auto other  = compiler.Submit({"program", "-O2"}, job);
+        release.set_value();
+        compiler.Wait();
+
+        EXPECT_EQUAL(runs.load(), 2);
+        first.get();
+        second.get();
+        other.get();
+
+        // Finished jobs are forgotten, so the program may be submitted again.
+        compiler.Submit({"program", "-O3"}, job).get();
+        EXPECT_EQUAL(runs.load(), 3);
+    }
+
+    static void PropagatesErrors()
+    {
+        AsyncCompiler compiler;
+        const auto future = compiler.Submit({"broken", ""}, []() -> Program {
+            throw std::runtime_error("Build failed");
+        });
+        EXPECT(throws([&]() { future.get(); }));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::AsyncCompilerTest{}.Run(); }
@@ -84,6 +84,35 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+void check_kern_db_codecs()
+{
+    // Kernel binaries repeat a lot, while random strings give lz4 nothing to compress.
+    std::string orig_str;
+    const auto part = random_string(256);
+    for(auto i = 0; i < 32; ++i)
+        orig_str += part;
+
+    for(const auto codec : {miopen::KernDbCodec::None,
+                            miopen::KernDbCodec::Bz2,
+                            miopen::KernDbCodec::Zstd,
+                            miopen::KernDbCodec::Lz4})
+    {
+        if(!miopen::IsAvailable(codec))
+            continue;
+
+        std::string compressed_str;
+        const auto compressed = miopen::CompressBlob(codec, orig_str, compressed_str);
+        EXPECT(compressed == (codec != miopen::KernDbCodec::None));
+        if(!compressed)
+            continue;
+
+        EXPECT(compressed_str.size() < orig_str.size());
+        EXPECT(miopen::DecompressBlob(codec, compressed_str, orig_str.size()) == orig_str);
+    }
+
+    EXPECT(miopen::IsAvailable(miopen::GetKernDbCodec()));
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -108,6 +137,62 @@ void check_kern_db()
         CHECK(!clean_db.FindRecordUnsafe(cfg0));
     }
 
+    {
+        // Small blobs are stored uncompressed.
+        miopen::KernelConfig cfg1;
+        cfg1.kernel_name = "kernel2";
+        cfg1.kernel_args = random_string(512);
+        cfg1.kernel_blob = random_string(miopen::kern_db_min_compressed_size / 2);
+
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb db(std::string(temp_file), false);
+        CHECK(db.StoreRecordUnsafe(cfg0));
+        CHECK(db.StoreRecordUnsafe(cfg1));
+        CHECK(db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+        CHECK(db.FindRecordUnsafe(cfg1).get() == cfg1.kernel_blob);
+    }
+
+    {
+        // Keys differ only by the strings, which are bound to the statements as is.
+        auto cfg2        = cfg0;
+        cfg2.kernel_args = cfg0.kernel_args + " -D NAME='x'";
+        cfg2.kernel_blob = random_string(1024);
+        CHECK(cfg2.Key() != cfg0.Key());
+
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb db(std::string(temp_file), false);
+        CHECK(db.StoreRecordUnsafe(cfg0));
+        CHECK(db.StoreRecordUnsafe(cfg2));
+        for(auto i = 0; i < 3; ++i)
+        {
+            CHECK(db.FindRecordUnsafe(cfg0).get() == cfg0.kernel_blob);
+            CHECK(db.FindRecordUnsafe(cfg2).get() == cfg2.kernel_blob);
+        }
+        CHECK(db.RemoveRecordUnsafe(cfg2));
+        CHECK(!db.FindRecordUnsafe(cfg2));
+        CHECK(db.FindRecordUnsafe(cfg0));
+    }
+
+    {
+        // Identical code objects are stored once and outlive the record which stored them.
+        auto cfg3        = cfg0;
+        cfg3.kernel_args = cfg0.kernel_args + " -DUNUSED=1";
+        auto cfg4        = cfg0;
+        cfg4.kernel_args = cfg0.kernel_args + " -DUNUSED=2";
+
+        miopen::TempFile temp_file("tmp-kerndb");
+        miopen::KernDb db(std::string(temp_file), false);
+        CHECK(db.StoreRecordUnsafe(cfg0));
+        CHECK(db.StoreRecordUnsafe(cfg3));
+        CHECK(db.StoreRecordUnsafe(cfg4));
+        CHECK(db.FindRecordUnsafe(cfg3).get() == cfg0.kernel_blob);
+        CHECK(db.RemoveRecordUnsafe(cfg0));
+        CHECK(!db.FindRecordUnsafe(cfg0));
+        CHECK(db.FindRecordUnsafe(cfg3).get() == cfg0.kernel_blob);
+        CHECK(db.RemoveRecordUnsafe(cfg3));
+        CHECK(db.FindRecordUnsafe(cfg4).get() == cfg0.kernel_blob);
+    }
+
     {
         miopen::TempFile temp_file("tmp-kerndb");
         miopen::KernDb err_db(
@@ -152,6 +237,7 @@ int main()
 #if MIOPEN_ENABLE_SQLITE
     check_bz2_compress();
     check_bz2_decompress();
+    check_kern_db_codecs();
     check_kern_db();
 #endif
 }
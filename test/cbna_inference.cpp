@@ -255,7 +255,8 @@ struct cbna_fusion_driver : test_driver
     miopenActivationMode_t activ_mode = miopenActivationRELU;
     int amode                         = 3;
     bool tactiv{};
-    bool bias_mode = true;
+    bool bias_mode        = true;
+    bool constant_folding = false;
     miopenBatchNormMode_t bnmode{};
     int batchnormMode = 0;
     std::string conv_mode;
@@ -291,6 +292,7 @@ struct cbna_fusion_driver : test_driver
         add(tactiv, "test_activ", generate_data({/*false, */ true}));
         add(amode, "amode", generate_data({3}));
         add(batchnormMode, "batch-norm-mode", generate_data({/*0,*/ 1}));
+        add(constant_folding, "constant-folding", generate_data({false, true}));
     }
 
     ~cbna_fusion_driver()
@@ -440,6 +442,8 @@ struct cbna_fusion_driver : test_driver
             miopenCreateOpActivationForward(ptr_fusionplan.get(), &activOp, activ_mode);
         }
 
+        miopenFusionPlanSetConstantFolding(ptr_fusionplan.get(), constant_folding);
+
         // Compile
         ++total_cnt;
         miopenStatus_t miopenError = miopenCompileFusionPlan(&handle, ptr_fusionplan.get());
@@ -72,6 +72,10 @@ struct check_numeric_normal : check_numerics_base<T>
                                          this->desc,
                                          this->buffer.get(),
                                          false));
+
+        CHECK(!miopen::checkNumericsImpl(
+            this->h, miopen::CheckNumerics::Async, this->desc, this->buffer.get(), true));
+        CHECK(!miopen::CheckNumericsPoll(this->h));
     }
 };
 
@@ -125,6 +129,14 @@ struct check_numeric_abnormal : check_numerics_base<T>
                                       this->buffer.get(),
                                       false);
         }));
+
+        // The asynchronous checks only report through the poll, which clears the flags.
+        CHECK(!miopen::checkNumericsImpl(
+            this->h, miopen::CheckNumerics::Async, this->desc, this->buffer.get(), true));
+        CHECK(!miopen::checkNumericsImpl(
+            this->h, miopen::CheckNumerics::Async, this->desc, this->buffer.get(), false));
+        CHECK(miopen::CheckNumericsPoll(this->h));
+        CHECK(!miopen::CheckNumericsPoll(this->h));
     }
 };
 
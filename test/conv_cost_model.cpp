@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/solver/conv_cost_model.hpp>
+
+namespace miopen {
+namespace tests {
+
+struct ConvCostModelTest
+{
+    void Run() const
+    {
+        ScalesWithTheDevice();
+        IsBoundByTheSlowerResource();
+        PrefersMoreEfficientSolvers();
+    }
+
+    private:
+    static solver::ConvWork Work(double flops, double bytes)
+    {
+        auto work  = solver::ConvWork{};
+        work.flops = flops;
+        work.bytes = bytes;
+        return work;
+    }
+
+    static void ScalesWithTheDevice()
+    {
+        const auto small = solver::GetDeviceThroughput("gfx90a:sramecc+:xnack-", 52, miopenFloat);
+        const auto large = solver::GetDeviceThroughput("gfx90a:sramecc+:xnack-", 104, miopenFloat);
+        EXPECT_EQUAL(large.flops_per_ms, 2 * small.flops_per_ms);
+        EXPECT_EQUAL(large.bytes_per_ms, small.bytes_per_ms);
+
+        // Matrix cores run half precision faster.
+        const auto half = solver::GetDeviceThroughput("gfx90a:sramecc+:xnack-", 104, miopenHalf);
+        EXPECT(half.flops_per_ms > large.flops_per_ms);
+
+        // Unknown devices get the defaults.
+        const auto unknown = solver::GetDeviceThroughput("gfx9999", 64, miopenFloat);
+        EXPECT(unknown.flops_per_ms > 0.0);
+        EXPECT(unknown.bytes_per_ms > 0.0);
+    }
+
+    static void IsBoundByTheSlowerResource()
+    {
+        const auto device        = solver::GetDeviceThroughput("gfx908", 120, miopenFloat);
+        const auto compute_bound = Work(1.0e12, 1.0e6);
+        const auto memory_bound  = Work(1.0e6, 1.0e10);
+
+        EXPECT(solver::EstimateConvTime(compute_bound, device, 0.5f) >
+               solver::EstimateConvTime(compute_bound, device, 1.0f));
+        // Memory bound convolutions do not benefit from a more efficient solver.
+        EXPECT_EQUAL(solver::EstimateConvTime(memory_bound, device, 0.5f),
+                     solver::EstimateConvTime(memory_bound, device, 1.0f));
+    }
+
+    static void PrefersMoreEfficientSolvers()
+    {
+        EXPECT(solver::GetDefaultEfficiency(miopenConvolutionAlgoImplicitGEMM) >
+               solver::GetDefaultEfficiency(miopenConvolutionAlgoDirect));
+        EXPECT(solver::GetDefaultEfficiency(miopenConvolutionAlgoGEMM) >
+               solver::GetDefaultEfficiency(miopenConvolutionAlgoFFT));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ConvCostModelTest{}.Run(); }
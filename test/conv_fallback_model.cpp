@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/conv/fallback_model.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct ConvFallbackModelTest
+{
+    void Run() const
+    {
+        WalksTheTree();
+        RejectsMalformedModels();
+    }
+
+    private:
+    static std::unique_ptr<conv::DecisionTreeModel> Load(const std::string& text)
+    {
+        std::istringstream stream{text};
+        return conv::DecisionTreeModel::Load(stream);
+    }
+
+    static void WalksTheTree()
+    {
+        const auto model = Load("# Filter height decides\n"
+                                "MIOpenFallbackModel 1 23\n"
+                                "node 14 1 1 2\n"
+                                "leaf ConvAsm1x1U NoSuchSolver # unknown solvers are skipped\n"
+                                "leaf ConvAsm3x3U ConvAsm1x1U\n");
+
+        auto features        = conv::FallbackFeatures{};
+        features[14]         = 1.0f;
+        const auto pointwise = model->Predict(features);
+        EXPECT(pointwise.size() == 1);
+        EXPECT_EQUAL(pointwise.front().ToString(), "ConvAsm1x1U");
+
+        features[14]      = 3.0f;
+        const auto filter = model->Predict(features);
+        EXPECT(filter.size() == 2);
+        EXPECT_EQUAL(filter.front().ToString(), "ConvAsm3x3U");
+    }
+
+    static void RejectsMalformedModels()
+    {
+        EXPECT(throws([] { Load(""); }));
+        EXPECT(throws([] { Load("MIOpenFallbackModel 2 23\nleaf ConvAsm1x1U\n"); }));
+        EXPECT(throws([] { Load("MIOpenFallbackModel 1 22\nleaf ConvAsm1x1U\n"); }));
+        EXPECT(throws([] { Load("MIOpenFallbackModel 1 23\n"); }));
+        EXPECT(throws([] { Load("MIOpenFallbackModel 1 23\nbranch 0 1 1 2\n"); }));
+        // Out of range feature, missing and looping children.
+        EXPECT(throws([] { Load("MIOpenFallbackModel 1 23\nnode 23 1 1 1\nleaf\n"); }));
+        EXPECT(throws([] { Load("MIOpenFallbackModel 1 23\nnode 0 1 1 2\nleaf\n"); }));
+        EXPECT(throws([] { Load("MIOpenFallbackModel 1 23\nnode 0 1 0 1\nleaf\n"); }));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ConvFallbackModelTest{}.Run(); }
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/conv/problem_canonicalization.hpp>
+
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct ConvProblemCanonicalizationTest
+{
+    void Run() const
+    {
+        using Buckets = std::vector<std::size_t>;
+
+        // Powers of two are buckets already.
+        EXPECT(conv::GetBatchSizeBuckets(1).empty());
+        EXPECT(conv::GetBatchSizeBuckets(64).empty());
+
+        // The nearest bucket first, ties go to the larger one.
+        EXPECT(conv::GetBatchSizeBuckets(3) == (Buckets{4, 2}));
+        EXPECT(conv::GetBatchSizeBuckets(6) == (Buckets{8, 4}));
+        EXPECT(conv::GetBatchSizeBuckets(5) == (Buckets{4, 8}));
+        EXPECT(conv::GetBatchSizeBuckets(100) == (Buckets{128, 64}));
+        EXPECT(conv::GetBatchSizeBuckets(65) == (Buckets{64, 128}));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ConvProblemCanonicalizationTest{}.Run(); }
@@ -548,6 +548,7 @@ struct verify_ctcloss
     std::vector<int> inputLengths;
     tensor<T> losses;
     tensor<T> grads;
+    bool device_labels;
 
     miopen::CTCLossDescriptor ctcLossDesc;
 
@@ -557,15 +558,17 @@ struct verify_ctcloss
                    const std::vector<int>& pLL,
                    const std::vector<int>& pIL,
                    const tensor<T>& pLS,
-                   const tensor<T>& pGD)
+                   const tensor<T>& pGD,
+                   bool pDL)
     {
-        ctcLossDesc  = pCLD;
-        probs        = pPB;
-        labels       = pLB;
-        labelLengths = pLL;
-        inputLengths = pIL;
-        losses       = pLS;
-        grads        = pGD;
+        ctcLossDesc   = pCLD;
+        probs         = pPB;
+        labels        = pLB;
+        labelLengths  = pLL;
+        inputLengths  = pIL;
+        losses        = pLS;
+        grads         = pGD;
+        device_labels = pDL;
     }
 
     std::tuple<tensor<T>, tensor<T>> cpu() const
@@ -624,13 +627,19 @@ struct verify_ctcloss
     {
         auto&& handle = get_handle();
 
-        size_t workSpaceSize = ctcLossDesc.GetCTCLossWorkspaceSize(handle,
-                                                                   probs.desc,
-                                                                   grads.desc,
-                                                                   labels.data(),
-                                                                   labelLengths.data(),
-                                                                   inputLengths.data(),
-                                                                   miopenCTCLossAlgo_t(0));
+        const int max_label_len = *std::max_element(labelLengths.begin(), labelLengths.end());
+
+        size_t workSpaceSize =
+            device_labels
+                ? ctcLossDesc.GetCTCLossWorkspaceSize(
+                      handle, probs.desc, grads.desc, max_label_len, miopenCTCLossAlgo_t(0))
+                : ctcLossDesc.GetCTCLossWorkspaceSize(handle,
+                                                      probs.desc,
+                                                      grads.desc,
+                                                      labels.data(),
+                                                      labelLengths.data(),
+                                                      inputLengths.data(),
+                                                      miopenCTCLossAlgo_t(0));
 
         auto workSpace     = tensor<T>{workSpaceSize / sizeof(T)};
         auto workSpace_dev = handle.Write(workSpace.data);
@@ -642,18 +651,41 @@ struct verify_ctcloss
         auto grads_dev  = handle.Write(grads_gpu.data);
         auto losses_dev = handle.Write(losses_gpu.data);
 
-        ctcLossDesc.CTCLoss(handle,
-                            probs.desc,
-                            probs_dev.get(),
-                            labels.data(),
-                            labelLengths.data(),
-                            inputLengths.data(),
-                            losses_dev.get(),
-                            grads.desc,
-                            grads_dev.get(),
-                            miopenCTCLossAlgo_t(0),
-                            workSpace_dev.get(),
-                            workSpaceSize);
+        if(device_labels)
+        {
+            auto labels_dev       = handle.Write(labels);
+            auto labelLengths_dev = handle.Write(labelLengths);
+            auto inputLengths_dev = handle.Write(inputLengths);
+
+            ctcLossDesc.CTCLoss(handle,
+                                probs.desc,
+                                probs_dev.get(),
+                                labels_dev.get(),
+                                labelLengths_dev.get(),
+                                inputLengths_dev.get(),
+                                max_label_len,
+                                losses_dev.get(),
+                                grads.desc,
+                                grads_dev.get(),
+                                miopenCTCLossAlgo_t(0),
+                                workSpace_dev.get(),
+                                workSpaceSize);
+        }
+        else
+        {
+            ctcLossDesc.CTCLoss(handle,
+                                probs.desc,
+                                probs_dev.get(),
+                                labels.data(),
+                                labelLengths.data(),
+                                inputLengths.data(),
+                                losses_dev.get(),
+                                grads.desc,
+                                grads_dev.get(),
+                                miopenCTCLossAlgo_t(0),
+                                workSpace_dev.get(),
+                                workSpaceSize);
+        }
 
         losses_gpu.data = handle.Read<T>(losses_dev, losses_gpu.data.size());
         grads_gpu.data  = handle.Read<T>(grads_dev, grads_gpu.data.size());
@@ -686,6 +718,7 @@ struct ctc_driver : test_driver
     int batchSize{};
     bool is_softmax_applied{};
     int blank_id{};
+    bool device_labels{};
 
     miopen::CTCLossDescriptor ctcLossDesc;
     tensor<T> probs;
@@ -700,6 +733,7 @@ struct ctc_driver : test_driver
         add(numClass, "num-class", generate_data({28, 5000}));
         add(is_softmax_applied, "apply-softmax-layer", generate_data({true, false}));
         add(blank_id, "blank-label-id", generate_data({0, 1000}));
+        add(device_labels, "device-labels", generate_data({false, true}));
     }
 
     void run()
@@ -770,8 +804,14 @@ struct ctc_driver : test_driver
                 labels[i] = blank_lb - 1 >= 0 ? (blank_lb - 1) : blank_lb + 1;
         }
 
-        verify(verify_ctcloss<T>{
-            ctcLossDesc, probs, labels, labelLengths, inputLengths, losses, grads});
+        verify(verify_ctcloss<T>{ctcLossDesc,
+                                 probs,
+                                 labels,
+                                 labelLengths,
+                                 inputLengths,
+                                 losses,
+                                 grads,
+                                 device_labels});
     }
 };
 
@@ -0,0 +1,336 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+#include "random.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+#include <miopen/ctc.hpp>
+#include <miopen/miopen.h>
+
+#define CTC_DECODE_LOG_ZERO (-1e30f)
+
+static float ctc_logaddexp(float a, float b)
+{
+    const float m = std::max(a, b);
+    if(m <= CTC_DECODE_LOG_ZERO)
+        return CTC_DECODE_LOG_ZERO;
+    return m + std::log(std::exp(a - m) + std::exp(b - m));
+}
+
+/// The decodes are written as scores and as rows of beam_width * (1 + max time step) values,
+/// the length followed by the ids, so that both can go through verify().
+template <class T>
+struct verify_ctc_decode
+{
+    tensor<T> probs;
+    std::vector<int> inputLengths;
+    miopen::CTCLossDescriptor ctcLossDesc;
+    miopenCTCDecodeMode_t mode;
+    int beam_width;
+
+    int max_time_step() const { return probs.desc.GetLengths()[0]; }
+    int batch_size() const { return probs.desc.GetLengths()[1]; }
+    int class_sz() const { return probs.desc.GetLengths()[2]; }
+
+    /// The log-probabilities of a frame.
+    std::vector<float> Frame(int t, int n) const
+    {
+        std::vector<float> lp(class_sz());
+        for(int c = 0; c < class_sz(); c++)
+            lp[c] = static_cast<float>(probs(t, n, c));
+        if(ctcLossDesc.apply_softmax_layer)
+        {
+            const float m = *std::max_element(lp.begin(), lp.end());
+            float s       = 0;
+            for(auto v : lp)
+                s += std::exp(v - m);
+            for(auto& v : lp)
+                v -= m + std::log(s);
+        }
+        return lp;
+    }
+
+    void Greedy(int n, std::vector<std::vector<int>>& seqs, std::vector<float>& sc) const
+    {
+        int prev    = -1;
+        float score = 0;
+        for(int t = 0; t < inputLengths[n]; t++)
+        {
+            const auto lp = Frame(t, n);
+            const int c   = static_cast<int>(std::max_element(lp.begin(), lp.end()) - lp.begin());
+            score += lp[c];
+            if(c != ctcLossDesc.blank_label_id && c != prev)
+                seqs[0].push_back(c);
+            prev = c;
+        }
+        sc[0] = score;
+    }
+
+    /// The same pruning and ordering as the kernel, with prefixes compared exactly.
+    void BeamSearch(int n, std::vector<std::vector<int>>& seqs, std::vector<float>& sc) const
+    {
+        struct Beam
+        {
+            std::vector<int> prefix;
+            float pb, pnb;
+        };
+        const int blank = ctcLossDesc.blank_label_id;
+        const int B     = beam_width;
+        const int K     = std::min(B, class_sz() - 1);
+
+        std::vector<Beam> beams = {{{}, 0.0f, CTC_DECODE_LOG_ZERO}};
+        for(int t = 0; t < inputLengths[n]; t++)
+        {
+            const auto lp = Frame(t, n);
+
+            std::vector<int> top;
+            for(int c = 0; c < class_sz(); c++)
+                if(c != blank)
+                    top.push_back(c);
+            std::stable_sort(
+                top.begin(), top.end(), [&](int a, int b) { return lp[a] > lp[b]; });
+            top.resize(K);
+
+            struct Cand
+            {
+                int index;
+                std::vector<int> prefix;
+                float pb, pnb;
+            };
+            std::vector<Cand> cands;
+            for(std::size_t j = 0; j < beams.size(); j++)
+            {
+                const auto& bm = beams[j];
+                const float pnb =
+                    bm.prefix.empty() ? CTC_DECODE_LOG_ZERO : bm.pnb + lp[bm.prefix.back()];
+                cands.push_back({static_cast<int>(j),
+                                 bm.prefix,
+                                 std::max(ctc_logaddexp(bm.pb, bm.pnb) + lp[blank],
+                                          CTC_DECODE_LOG_ZERO),
+                                 std::max(pnb, CTC_DECODE_LOG_ZERO)});
+            }
+            for(std::size_t i = 0; i < beams.size(); i++)
+            {
+                for(int k = 0; k < K; k++)
+                {
+                    const auto& bm = beams[i];
+                    const int c    = top[k];
+                    auto prefix    = bm.prefix;
+                    prefix.push_back(c);
+                    const float pa = !bm.prefix.empty() && bm.prefix.back() == c
+                                         ? bm.pb
+                                         : ctc_logaddexp(bm.pb, bm.pnb);
+                    const float pnb = std::max(pa + lp[c], CTC_DECODE_LOG_ZERO);
+
+                    auto same = std::find_if(cands.begin(),
+                                             cands.begin() + beams.size(),
+                                             [&](const Cand& cd) { return cd.prefix == prefix; });
+                    if(same != cands.begin() + beams.size())
+                        same->pnb = ctc_logaddexp(same->pnb, pnb);
+                    else
+                        cands.push_back({B + static_cast<int>(i) * K + k,
+                                         prefix,
+                                         CTC_DECODE_LOG_ZERO,
+                                         pnb});
+                }
+            }
+
+            std::stable_sort(cands.begin(), cands.end(), [](const Cand& a, const Cand& b) {
+                const float sa = ctc_logaddexp(a.pb, a.pnb);
+                const float sb = ctc_logaddexp(b.pb, b.pnb);
+                return sa > sb || (sa == sb && a.index < b.index);
+            });
+
+            beams.clear();
+            for(const auto& cd : cands)
+            {
+                if(static_cast<int>(beams.size()) == B ||
+                   ctc_logaddexp(cd.pb, cd.pnb) <= CTC_DECODE_LOG_ZERO)
+                    break;
+                beams.push_back({cd.prefix, cd.pb, cd.pnb});
+            }
+        }
+
+        for(std::size_t j = 0; j < beams.size(); j++)
+        {
+            seqs[j] = beams[j].prefix;
+            sc[j]   = ctc_logaddexp(beams[j].pb, beams[j].pnb);
+        }
+    }
+
+    std::tuple<tensor<float>, tensor<float>> cpu() const
+    {
+        const int row = 1 + max_time_step();
+        auto scores   = tensor<float>{static_cast<std::size_t>(batch_size() * beam_width)};
+        auto decoded  = tensor<float>{static_cast<std::size_t>(batch_size() * beam_width * row)};
+
+        for(int n = 0; n < batch_size(); n++)
+        {
+            std::vector<std::vector<int>> seqs(beam_width);
+            std::vector<float> sc(beam_width, CTC_DECODE_LOG_ZERO);
+            if(mode == MIOPEN_CTC_DECODE_GREEDY)
+                Greedy(n, seqs, sc);
+            else
+                BeamSearch(n, seqs, sc);
+
+            for(int b = 0; b < beam_width; b++)
+            {
+                const auto idx          = n * beam_width + b;
+                scores.data[idx]        = sc[b];
+                decoded.data[idx * row] = static_cast<float>(seqs[b].size());
+                std::copy(seqs[b].begin(), seqs[b].end(), decoded.data.begin() + idx * row + 1);
+            }
+        }
+        return std::make_tuple(scores, decoded);
+    }
+
+    std::tuple<tensor<float>, tensor<float>> gpu() const
+    {
+        auto&& handle = get_handle();
+
+        const auto nbeams = batch_size() * beam_width;
+        const auto wksp_sz =
+            ctcLossDesc.GetCTCDecodeWorkspaceSize(probs.desc, mode, beam_width);
+
+        auto probs_dev   = handle.Write(probs.data);
+        auto lengths_dev = handle.Write(inputLengths);
+        auto ids_dev     = handle.Write(std::vector<int>(nbeams * max_time_step(), 0));
+        auto lens_dev    = handle.Write(std::vector<int>(nbeams, 0));
+        auto scores_dev  = handle.Write(std::vector<float>(nbeams, 0));
+        auto wksp_dev    = handle.Write(std::vector<char>(std::max<std::size_t>(wksp_sz, 1)));
+
+        ctcLossDesc.CTCDecode(handle,
+                              mode,
+                              beam_width,
+                              probs.desc,
+                              probs_dev.get(),
+                              lengths_dev.get(),
+                              ids_dev.get(),
+                              lens_dev.get(),
+                              scores_dev.get(),
+                              wksp_dev.get(),
+                              wksp_sz);
+
+        const auto ids  = handle.Read<int>(ids_dev, nbeams * max_time_step());
+        const auto lens = handle.Read<int>(lens_dev, nbeams);
+
+        const int row = 1 + max_time_step();
+        auto scores   = tensor<float>{static_cast<std::size_t>(nbeams)};
+        auto decoded  = tensor<float>{static_cast<std::size_t>(nbeams * row)};
+        scores.data   = handle.Read<float>(scores_dev, nbeams);
+        for(int b = 0; b < nbeams; b++)
+        {
+            decoded.data[b * row] = static_cast<float>(lens[b]);
+            std::copy(ids.begin() + b * max_time_step(),
+                      ids.begin() + b * max_time_step() + lens[b],
+                      decoded.data.begin() + b * row + 1);
+        }
+        return std::make_tuple(scores, decoded);
+    }
+
+    void fail(int badtensor) const
+    {
+        std::cout << "CTC Decode: " << (mode == MIOPEN_CTC_DECODE_GREEDY ? "greedy" : "beam")
+                  << ", beam width " << beam_width << std::endl;
+        std::cout << "Max Timestep, Batch Size, Number of Class: " << probs.desc.ToString()
+                  << std::endl;
+        std::cout << (badtensor == 0 ? "Scores" : "Sequences") << std::endl;
+    }
+};
+
+template <class T>
+struct ctc_decode_driver : test_driver
+{
+    int inputLen{};
+    int batchSize{};
+    int numClass{};
+    int beamWidth{};
+    bool is_softmax_applied{};
+    int blank_id{};
+
+    ctc_decode_driver()
+    {
+        add(batchSize, "batch-size", generate_data({1, 7}));
+        add(inputLen, "input-len", generate_data({1, 30}));
+        add(numClass, "num-class", generate_data({4, 300}));
+        add(beamWidth, "beam-width", generate_data({0, 1, 8}));
+        add(is_softmax_applied, "apply-softmax-layer", generate_data({true, false}));
+        add(blank_id, "blank-label-id", generate_data({0, 2}));
+    }
+
+    void run()
+    {
+        if(type != miopenFloat)
+            return;
+
+        miopen::CTCLossDescriptor ctcLossDesc;
+        ctcLossDesc.dataType            = miopenFloat;
+        ctcLossDesc.apply_softmax_layer = is_softmax_applied;
+        ctcLossDesc.blank_label_id      = blank_id;
+
+        // Beam width 0 selects the greedy decoder
+        const auto mode = beamWidth == 0 ? MIOPEN_CTC_DECODE_GREEDY : MIOPEN_CTC_DECODE_BEAM_SEARCH;
+
+        std::vector<int> inputLengths(batchSize);
+        for(auto& l : inputLengths)
+            l = GET_RAND() % inputLen + 1;
+
+        const int max_time_step = *std::max_element(inputLengths.begin(), inputLengths.end());
+        std::vector<int> probsDims = {max_time_step, batchSize, numClass};
+
+        // Distinct activations keep the rankings of the beams clear of ties
+        auto probs = tensor<T>{probsDims}.generate(
+            [](auto...) { return T(double(GET_RAND() % 100000) / 10000.0 - 5.0); });
+
+        if(!is_softmax_applied)
+        {
+            for(int t = 0; t < max_time_step; t++)
+            {
+                for(int n = 0; n < batchSize; n++)
+                {
+                    double m = probs(t, n, 0), s = 0;
+                    for(int c = 0; c < numClass; c++)
+                        m = std::max<double>(m, probs(t, n, c));
+                    for(int c = 0; c < numClass; c++)
+                        s += std::exp(probs(t, n, c) - m);
+                    for(int c = 0; c < numClass; c++)
+                        probs(t, n, c) = T(probs(t, n, c) - m - std::log(s));
+                }
+            }
+        }
+
+        verify(verify_ctc_decode<T>{
+            probs, inputLengths, ctcLossDesc, mode, std::max(beamWidth, 1)});
+    }
+};
+
+int main(int argc, const char* argv[]) { test_drive<ctc_decode_driver>(argc, argv); }
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/db_merge.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct DbMergeTest
+{
+    void Run() const
+    {
+        const TmpDir dir{"test_db_merge"};
+
+        KeepsFastestFindDbEntries(dir.path);
+        KeepsLatestPerfDbEntries(dir.path);
+        DropsFilteredEntries(dir.path);
+    }
+
+    private:
+    static std::string Write(const boost::filesystem::path& dir,
+                             const std::string& name,
+                             const std::string& contents)
+    {
+        const auto path = (dir / name).string();
+        std::ofstream{path} << contents;
+        return path;
+    }
+
+    static std::string Read(const std::string& path)
+    {
+        std::ifstream file{path};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    static std::vector<std::string> Inputs(const boost::filesystem::path& dir)
+    {
+        // More inputs than threads, so that both the per thread and the final merges run.
+        return {
+            Write(dir, "0.txt", "k1=a:S1,2,0,x,y;b:S2,5,0,x,y\nk2=a:S1,1,0,x,y\n"),
+            Write(dir, "1.txt", "k1=a:S3,1,0,x,y;b:S4,7,0,x,y\nk3=a:S1,1,0,x,y\n"),
+            // The later line of a key replaces the earlier one, the empty one removes it.
+            Write(dir, "2.txt", "k2=a:S5,9,0,x,y\nk2=b:S6,3,0,x,y\nk3=\n"),
+        };
+    }
+
+    void KeepsFastestFindDbEntries(const boost::filesystem::path& dir) const
+    {
+        auto options    = DbMerger::Options{};
+        options.find_db = true;
+        options.jobs    = 2;
+
+        auto merger = DbMerger{options};
+        merger.AddText(Inputs(dir));
+        EXPECT_EQUAL(merger.GetCount(), 3);
+
+        const auto out = (dir / "find.txt").string();
+        merger.WriteText(out);
+        EXPECT_EQUAL(Read(out),
+                     "k1=a:S3,1,0,x,y;b:S2,5,0,x,y\n"
+                     "k2=a:S1,1,0,x,y;b:S6,3,0,x,y\n"
+                     "k3=a:S1,1,0,x,y\n");
+    }
+
+    void KeepsLatestPerfDbEntries(const boost::filesystem::path& dir) const
+    {
+        auto options = DbMerger::Options{};
+        options.jobs = 3;
+
+        auto merger = DbMerger{options};
+        merger.AddText(Inputs(dir));
+
+        const auto out = (dir / "perf.txt").string();
+        merger.WriteText(out);
+        EXPECT_EQUAL(Read(out),
+                     "k1=a:S3,1,0,x,y;b:S4,7,0,x,y\n"
+                     "k2=a:S1,1,0,x,y;b:S6,3,0,x,y\n"
+                     "k3=a:S1,1,0,x,y\n");
+    }
+
+    void DropsFilteredEntries(const boost::filesystem::path& dir) const
+    {
+        auto options   = DbMerger::Options{};
+        options.jobs   = 1;
+        options.filter = [](const std::string& id, const std::string&) { return id != "a"; };
+
+        auto merger = DbMerger{options};
+        merger.AddText(Inputs(dir));
+
+        const auto out = (dir / "filtered.txt").string();
+        merger.WriteText(out);
+        EXPECT_EQUAL(Read(out), "k1=b:S4,7,0,x,y\nk2=b:S6,3,0,x,y\n");
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::DbMergeTest{}.Run(); }
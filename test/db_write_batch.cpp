@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/db_write_batch.hpp>
+#include <miopen/env.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace miopen {
+namespace tests {
+
+struct TestText
+{
+    std::string text;
+
+    void Serialize(std::ostream& s) const { s << text; }
+    bool Deserialize(const std::string& s)
+    {
+        text = s;
+        return true;
+    }
+};
+
+struct DbWriteBatchTest
+{
+    void Run() const
+    {
+        const TmpDir dir{"test_db_write_batch"};
+        const auto path = (dir.path / "test.udb.txt").string();
+        std::ofstream(path) << "key_a=id0:old;id1:kept" << std::endl;
+
+        DefersWrites(path);
+        MergesUpdates(path);
+        FlushesOnLimit(path);
+    }
+
+    private:
+    static std::string ReadFile(const std::string& path)
+    {
+        std::ostringstream ss;
+        ss << std::ifstream(path).rdbuf();
+        return ss.str();
+    }
+
+    static DbRecord MakeRecord(const std::string& key, const std::string& id)
+    {
+        auto record = DbRecord{TestText{key}};
+        record.SetValues(id, TestText{"new"});
+        return record;
+    }
+
+    static void DefersWrites(const std::string& path)
+    {
+        auto db = PlainTextDb{path};
+        EXPECT(db.StoreRecord(MakeRecord("key_b", "id0")));
+        EXPECT(ReadFile(path).find("key_b") == std::string::npos);
+
+        auto value = TestText{};
+        EXPECT(db.Load(TestText{"key_b"}, "id0", value));
+        EXPECT_EQUAL(value.text, "new");
+
+        db.Flush();
+        EXPECT(ReadFile(path).find("key_b=id0:new") != std::string::npos);
+    }
+
+    static void MergesUpdates(const std::string& path)
+    {
+        auto db     = PlainTextDb{path};
+        auto record = MakeRecord("key_a", "id0");
+        EXPECT(db.UpdateRecord(record));
+        EXPECT_EQUAL(record.GetSize(), 2);
+        EXPECT(ReadFile(path).find("id0:old") != std::string::npos);
+
+        auto value = TestText{};
+        EXPECT(db.Load(TestText{"key_a"}, "id0", value));
+        EXPECT_EQUAL(value.text, "new");
+        EXPECT(db.Load(TestText{"key_a"}, "id1", value));
+        EXPECT_EQUAL(value.text, "kept");
+
+        FlushDbWrites();
+        EXPECT(ReadFile(path).find("id0:new") != std::string::npos);
+        EXPECT(PlainTextDb{path}.Load(TestText{"key_a"}, "id0", value));
+        EXPECT_EQUAL(value.text, "new");
+        EXPECT(PlainTextDb{path}.Load(TestText{"key_a"}, "id1", value));
+        EXPECT_EQUAL(value.text, "kept");
+    }
+
+    static void FlushesOnLimit(const std::string& path)
+    {
+        auto db = PlainTextDb{path};
+        EXPECT(db.StoreRecord(MakeRecord("key_c", "id0")));
+        EXPECT(db.StoreRecord(MakeRecord("key_d", "id0")));
+        EXPECT(ReadFile(path).find("key_c") == std::string::npos);
+        EXPECT(db.StoreRecord(MakeRecord("key_e", "id0")));
+
+        const auto contents = ReadFile(path);
+        EXPECT(contents.find("key_c=id0:new") != std::string::npos);
+        EXPECT(contents.find("key_e=id0:new") != std::string::npos);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main()
+{
+    // The limits are read once, so they have to be set before any database is used.
+    setenv("MIOPEN_DB_WRITE_BATCH_SIZE", "3", 1);          // NOLINT (concurrency-mt-unsafe)
+    setenv("MIOPEN_DB_WRITE_BATCH_TIMEOUT_MS", "600000", 1); // NOLINT (concurrency-mt-unsafe)
+    miopen::env::Refresh();
+    miopen::tests::DbWriteBatchTest{}.Run();
+}
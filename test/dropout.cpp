@@ -230,6 +230,7 @@ struct dropout_driver : test_driver
     bool mask{};
     std::vector<int> in_dim{};
     int rng_mode_cmd = 0;
+    bool mask_packed{};
 
     dropout_driver()
     {
@@ -244,7 +245,8 @@ struct dropout_driver : test_driver
         add(dropout_rate, "dropout", generate_data({float(0.5)}));
         add(seed, "seed", generate_data({0x0ULL}));
         add(mask, "use-mask", generate_data({false}));
-        add(rng_mode_cmd, "rng-mode", generate_data({0}));
+        add(rng_mode_cmd, "rng-mode", generate_data({0, 1}));
+        add(mask_packed, "mask-packed", generate_data({false, true}));
 #else
 #define DROPOUT_LARGE_CTEST 0
 #if DROPOUT_LARGE_CTEST
@@ -268,7 +270,8 @@ struct dropout_driver : test_driver
         add(dropout_rate, "dropout", generate_data({float(0.0), float(0.5), float(1.0)}));
         add(seed, "seed", generate_data({0x0ULL, 0xFFFFFFFFFFFFFFFFULL}));
         add(mask, "use-mask", generate_data({false, true}));
-        add(rng_mode_cmd, "rng-mode", generate_data({0}));
+        add(rng_mode_cmd, "rng-mode", generate_data({0, 1}));
+        add(mask_packed, "mask-packed", generate_data({false, true}));
 #endif
     }
 
@@ -287,7 +290,10 @@ struct dropout_driver : test_driver
         miopenRNGType_t rng_mode = miopenRNGType_t(rng_mode_cmd);
 
         size_t stateSizeInBytes =
-            std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth()) * sizeof(prngStates);
+            rng_mode == MIOPEN_RNG_PHILOX
+                ? 0
+                : std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth()) *
+                      sizeof(prngStates);
         size_t reserveSpaceSizeInBytes = in.desc.GetElementSize() * sizeof(bool);
         size_t total_mem =
             2 * (2 * in.desc.GetNumBytes() + reserveSpaceSizeInBytes) + stateSizeInBytes;
@@ -331,8 +337,12 @@ struct dropout_driver : test_driver
         DropoutDesc.seed             = seed;
         DropoutDesc.use_mask         = mask;
         DropoutDesc.rng_mode         = rng_mode;
+        DropoutDesc.offset           = rng_mode == MIOPEN_RNG_PHILOX ? 0x100000001ULL : 0;
+        DropoutDesc.mask_packed      = mask_packed;
 
-        auto state_buf      = handle.Create<unsigned char>(stateSizeInBytes);
+        auto state_buf = miopen::Allocator::ManageDataPtr{};
+        if(stateSizeInBytes != 0)
+            state_buf = handle.Create<unsigned char>(stateSizeInBytes);
         DropoutDesc.pstates = state_buf.get();
         DropoutDesc.InitPRNGState(
             handle, DropoutDesc.pstates, DropoutDesc.stateSizeInBytes, DropoutDesc.seed);
@@ -212,6 +212,39 @@ inline void xorwow_lite_init_emu(prngStates* cur_state,
     cur_state->d += static_cast<unsigned int>(offset) * 362437;
 }
 
+inline std::array<unsigned int, 4> philox4x32_10_emu(std::array<unsigned int, 4> ctr,
+                                                     std::array<unsigned int, 2> key)
+{
+    for(int r = 0; r < 10; r++)
+    {
+        if(r > 0)
+        {
+            key[0] += 0x9E3779B9U;
+            key[1] += 0xBB67AE85U;
+        }
+        const auto p0  = static_cast<unsigned long long>(0xD2511F53U) * ctr[0];
+        const auto p1  = static_cast<unsigned long long>(0xCD9E8D57U) * ctr[2];
+        const auto hi0 = static_cast<unsigned int>(p0 >> 32);
+        const auto hi1 = static_cast<unsigned int>(p1 >> 32);
+
+        ctr = {hi1 ^ ctr[1] ^ key[0], static_cast<unsigned int>(p1), hi0 ^ ctr[3] ^ key[1],
+               static_cast<unsigned int>(p0)};
+    }
+    return ctr;
+}
+
+inline unsigned int
+philox_element_emu(unsigned long long seed, unsigned long long offset, size_t elem)
+{
+    const auto res = philox4x32_10_emu({static_cast<unsigned int>(elem / 4),
+                                        0,
+                                        static_cast<unsigned int>(offset),
+                                        static_cast<unsigned int>(offset >> 32)},
+                                       {static_cast<unsigned int>(seed),
+                                        static_cast<unsigned int>(seed >> 32)});
+    return res[elem % 4];
+}
+
 inline void InitKernelStateEmulator(std::vector<prngStates>& states,
                                     const miopen::DropoutDescriptor& dropoutDesc)
 {
@@ -269,6 +302,31 @@ inline void ExpandTensorDim(std::vector<T> x_len,
         *(itr_os--) = *(itr_os + 1) * *(itr_os + 1 - out_str.begin() + out_len.begin());
 }
 
+inline bool GetDropoutMask(const miopen::DropoutDescriptor& DropoutDesc,
+                           const std::vector<unsigned char>& reservespace,
+                           size_t rsvsp_offset,
+                           size_t si)
+{
+    return DropoutDesc.mask_packed ? bool((reservespace[rsvsp_offset + si / 8] >> (si % 8)) & 1)
+                                   : bool(reservespace[rsvsp_offset + si]);
+}
+
+inline void SetDropoutMask(const miopen::DropoutDescriptor& DropoutDesc,
+                           std::vector<unsigned char>& reservespace,
+                           size_t rsvsp_offset,
+                           size_t si,
+                           bool kept)
+{
+    if(!DropoutDesc.mask_packed)
+    {
+        reservespace[rsvsp_offset + si] = static_cast<unsigned char>(kept);
+        return;
+    }
+    const auto bit = 1U << (si % 8);
+    auto& bits     = reservespace[rsvsp_offset + si / 8];
+    bits           = static_cast<unsigned char>(kept ? (bits | bit) : (bits & ~bit));
+}
+
 template <typename T>
 void DropoutForwardVerify(miopen::Handle& handle,
                           const miopen::DropoutDescriptor& DropoutDesc,
@@ -300,9 +358,12 @@ void DropoutForwardVerify(miopen::Handle& handle,
                     out_len,
                     out_str);
 
+    // A packed mask is generated a byte, i.e. 8 elements, per work-item
+    const size_t elem_num = in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0];
+    const size_t pack     = DropoutDesc.mask_packed ? 8 : 1;
     size_t glb_sz =
         std::min(size_t(std::min(size_t(MAX_PRNG_STATE), handle.GetImage3dMaxWidth()) / 256),
-                 ((in_len[4] * in_len[3] * in_len[2] * in_len[1] * in_len[0] + 255) / 256)) *
+                 (((elem_num + pack - 1) / pack) + 255) / 256) *
         256;
 
     for(size_t i0 = 0; i0 < in_len[0]; i0++)
@@ -318,17 +379,24 @@ void DropoutForwardVerify(miopen::Handle& handle,
                         size_t si = i0 * in_len[1] * in_len[2] * in_len[3] * in_len[4] +
                                     i1 * in_len[2] * in_len[3] * in_len[4] +
                                     i2 * in_len[3] * in_len[4] + i3 * in_len[4] + i4;
-                        size_t ri = rsvsp_offset + si;
 
                         if(!use_mask)
-                            reservespace[ri] =
-                                uniform_distribution_emu(xorwow_next(&states[si % glb_sz])) >
-                                dropout_rate;
-
-                        output[oi] =
-                            bool(reservespace[ri]) && !miopen::float_equal(dropout_rate, 1.0)
-                                ? static_cast<T>(input[ii] / (1 - dropout_rate))
-                                : T(0);
+                        {
+                            const auto rnd =
+                                DropoutDesc.rng_mode == MIOPEN_RNG_PHILOX
+                                    ? philox_element_emu(DropoutDesc.seed, DropoutDesc.offset, si)
+                                    : xorwow_next(&states[(si / pack) % glb_sz]);
+                            SetDropoutMask(DropoutDesc,
+                                           reservespace,
+                                           rsvsp_offset,
+                                           si,
+                                           uniform_distribution_emu(rnd) > dropout_rate);
+                        }
+
+                        output[oi] = GetDropoutMask(DropoutDesc, reservespace, rsvsp_offset, si) &&
+                                             !miopen::float_equal(dropout_rate, 1.0)
+                                         ? static_cast<T>(input[ii] / (1 - dropout_rate))
+                                         : T(0);
                     }
 }
 
@@ -366,14 +434,14 @@ void DropoutBackwardVerify(const miopen::DropoutDescriptor& DropoutDesc,
                         i3 * out_str[3] + i4;
             size_t ii =
                 in_offset + i0 * in_str[0] + i1 * in_str[1] + i2 * in_str[2] + i3 * in_str[3] + i4;
-            size_t ri = rsvsp_offset + i0 * in_len[1] * in_len[2] * in_len[3] * in_len[4] +
+            size_t si = i0 * in_len[1] * in_len[2] * in_len[3] * in_len[4] +
                         i1 * in_len[2] * in_len[3] * in_len[4] + i2 * in_len[3] * in_len[4] +
                         i3 * in_len[4] + i4;
 
-            din[ii] =
-                static_cast<T>(bool(reservespace[ri]) && !miopen::float_equal(dropout_rate, 1.0)
-                                   ? dout[oi] / (1 - dropout_rate)
-                                   : 0);
+            din[ii] = static_cast<T>(GetDropoutMask(DropoutDesc, reservespace, rsvsp_offset, si) &&
+                                             !miopen::float_equal(dropout_rate, 1.0)
+                                         ? dout[oi] / (1 - dropout_rate)
+                                         : 0);
         });
 }
 
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/env.hpp>
+
+#include <cstdlib>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TEST_ENV_SNAPSHOT_FLAG)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TEST_ENV_SNAPSHOT_VALUE)
+
+namespace miopen {
+namespace tests {
+
+struct EnvSnapshotTest
+{
+    void Run() const
+    {
+        Set("MIOPEN_TEST_ENV_SNAPSHOT_FLAG", "1");
+        Set("MIOPEN_TEST_ENV_SNAPSHOT_VALUE", "0x10");
+        env::Refresh();
+        EXPECT(IsEnabled(MIOPEN_TEST_ENV_SNAPSHOT_FLAG{}));
+        EXPECT(!IsDisabled(MIOPEN_TEST_ENV_SNAPSHOT_FLAG{}));
+        EXPECT_EQUAL(Value(MIOPEN_TEST_ENV_SNAPSHOT_VALUE{}), 16);
+
+        // Not seen until the snapshot is refreshed.
+        Set("MIOPEN_TEST_ENV_SNAPSHOT_FLAG", "disabled");
+        EXPECT(IsEnabled(MIOPEN_TEST_ENV_SNAPSHOT_FLAG{}));
+        const char* const old_value = GetStringEnv(MIOPEN_TEST_ENV_SNAPSHOT_VALUE{});
+
+        Unset("MIOPEN_TEST_ENV_SNAPSHOT_VALUE");
+        env::Refresh();
+        EXPECT(!IsEnabled(MIOPEN_TEST_ENV_SNAPSHOT_FLAG{}));
+        EXPECT(IsDisabled(MIOPEN_TEST_ENV_SNAPSHOT_FLAG{}));
+        EXPECT_EQUAL(Value(MIOPEN_TEST_ENV_SNAPSHOT_VALUE{}, 7), 7);
+        EXPECT(GetStringEnv(MIOPEN_TEST_ENV_SNAPSHOT_VALUE{}) == nullptr);
+
+        // Values handed out before a refresh stay valid.
+        EXPECT_EQUAL(std::string{old_value}, "0x10");
+    }
+
+    private:
+    static void Set(const char* name, const char* value)
+    {
+        setenv(name, value, 1); // NOLINT (concurrency-mt-unsafe)
+    }
+
+    static void Unset(const char* name)
+    {
+        unsetenv(name); // NOLINT (concurrency-mt-unsafe)
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::EnvSnapshotTest{}.Run(); }
@@ -29,6 +29,7 @@
 #include "get_handle.hpp"
 
 #include <miopen/convolution.hpp>
+#include <miopen/env.hpp>
 #include <miopen/find_db.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/temp_file.hpp>
@@ -214,5 +215,6 @@ int main(int argc, const char* argv[])
 {
     setenv("MIOPEN_LOG_LEVEL", "6", 1);              // NOLINT (concurrency-mt-unsafe)
     setenv("MIOPEN_COMPILE_PARALLEL_LEVEL", "1", 1); // NOLINT (concurrency-mt-unsafe)
+    miopen::env::Refresh();
     test_drive<miopen::FindDbTest>(argc, argv);
 }
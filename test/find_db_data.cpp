@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/find_db.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct FindDbDataTest
+{
+    void Run() const
+    {
+        ReadsLegacyEntries();
+        KeepsSolverVersion();
+        KeepsProvisionalFlag();
+        KeepsTimingStatistics();
+        MapsParetoIdsToAlgorithms();
+    }
+
+    private:
+    static constexpr const char* solver_id = "ConvAsm3x3U";
+
+    void ReadsLegacyEntries() const
+    {
+        auto data = FindDbData{};
+        EXPECT(data.Deserialize(std::string{solver_id} + ",0.5,16,algo,config"));
+        EXPECT_EQUAL(data.solver_id, solver_id);
+        EXPECT_EQUAL(data.workspace, 16);
+        EXPECT_EQUAL(data.solver_version, 1);
+        EXPECT_EQUAL(data.provisional, 0);
+        EXPECT_EQUAL(data.trials, 1);
+        EXPECT_EQUAL(data.norm_time, 0.0f);
+        EXPECT(!data.IsStale());
+
+        EXPECT(data.Deserialize(std::string{solver_id} + ",0.5,16,algo,config,2"));
+        EXPECT_EQUAL(data.solver_version, 2);
+        EXPECT_EQUAL(data.provisional, 0);
+    }
+
+    void KeepsSolverVersion() const
+    {
+        const auto current = solver::Id{solver_id}.GetDbVersion();
+        auto data          = FindDbData{solver_id, 0.5f, 16, {"algo", "config"}};
+        EXPECT_EQUAL(data.solver_version, current);
+
+        data.solver_version = current + 1;
+        std::ostringstream ss;
+        data.Serialize(ss);
+
+        auto read = FindDbData{};
+        EXPECT(read.Deserialize(ss.str()));
+        EXPECT_EQUAL(read.solver_version, current + 1);
+        EXPECT(read.IsStale());
+    }
+
+    void KeepsProvisionalFlag() const
+    {
+        const auto data = FindDbData{solver_id, 0.5f, 16, {"algo", "config"}, true};
+        EXPECT_EQUAL(data.provisional, 1);
+
+        std::ostringstream ss;
+        data.Serialize(ss);
+
+        auto read = FindDbData{};
+        EXPECT(read.Deserialize(ss.str()));
+        EXPECT_EQUAL(read.provisional, 1);
+    }
+
+    void KeepsTimingStatistics() const
+    {
+        auto data      = FindDbData{solver_id, 0.5f, 16, {"algo", "config"}};
+        data.trials    = 5;
+        data.spread    = 0.25f;
+        data.norm_time = 0.375f;
+
+        std::ostringstream ss;
+        data.Serialize(ss);
+
+        auto read = FindDbData{};
+        EXPECT(read.Deserialize(ss.str()));
+        EXPECT_EQUAL(read.trials, 5);
+        EXPECT_EQUAL(read.spread, 0.25f);
+        EXPECT_EQUAL(read.norm_time, 0.375f);
+    }
+
+    void MapsParetoIdsToAlgorithms() const
+    {
+        const auto algo = std::string{"miopenConvolutionFwdAlgoWinograd"};
+        const auto id   = MakeFindDbParetoId(algo, "ConvMPBidirectWinograd<2-3>");
+        EXPECT(id != algo);
+        EXPECT_EQUAL(GetFindDbAlgorithm(id), algo);
+        EXPECT_EQUAL(GetFindDbAlgorithm(algo), algo);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::FindDbDataTest{}.Run(); }
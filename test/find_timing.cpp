@@ -0,0 +1,123 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/find_timing.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct FindTimingTest
+{
+    void Run() const
+    {
+        SummarizesSamples();
+        IgnoresOutliers();
+        TiesWithinNoise();
+        WaitsForSettledClocks();
+        NormalizesToMaxClock();
+    }
+
+    private:
+    void SummarizesSamples() const
+    {
+        const auto empty = SummarizeFindTiming({}, FindTimingStat::Median);
+        EXPECT_EQUAL(empty.trials, 0);
+
+        const auto single = SummarizeFindTiming({2.0f}, FindTimingStat::Median);
+        EXPECT_EQUAL(single.trials, 1);
+        EXPECT_EQUAL(single.time, 2.0f);
+        EXPECT_EQUAL(single.spread, 0.0f);
+
+        const auto even = SummarizeFindTiming({4.0f, 1.0f, 3.0f, 2.0f}, FindTimingStat::Median);
+        EXPECT_EQUAL(even.time, 2.5f);
+        EXPECT_EQUAL(even.trials, 4);
+        EXPECT(even.spread > 0.0f);
+    }
+
+    void IgnoresOutliers() const
+    {
+        const auto samples = std::vector<float>{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 50.0f};
+        EXPECT_EQUAL(SummarizeFindTiming(samples, FindTimingStat::Median).time, 1.0f);
+        EXPECT_EQUAL(SummarizeFindTiming(samples, FindTimingStat::TrimmedMean).time, 1.0f);
+    }
+
+    void TiesWithinNoise() const
+    {
+        auto fast    = FindTiming{};
+        fast.time    = 1.0f;
+        auto slow    = FindTiming{};
+        slow.time    = 1.5f;
+        auto close   = FindTiming{};
+        close.time   = 1.01f;
+        auto noisy   = FindTiming{};
+        noisy.time   = 1.2f;
+        noisy.spread = 0.3f;
+
+        EXPECT_EQUAL(CompareFindTiming(fast, slow, 0.02f), -1);
+        EXPECT_EQUAL(CompareFindTiming(slow, fast, 0.02f), 1);
+        EXPECT_EQUAL(CompareFindTiming(fast, close, 0.02f), 0);
+        EXPECT_EQUAL(CompareFindTiming(fast, close, 0.0f), -1);
+        EXPECT_EQUAL(CompareFindTiming(fast, noisy, 0.02f), 0);
+    }
+
+    void WaitsForSettledClocks() const
+    {
+        auto config      = FindTimingConfig{};
+        config.settle_ms = 100;
+
+        auto runs       = 0;
+        const auto ramp = [&]() { return 1.0f + std::pow(0.9f, static_cast<float>(runs++)); };
+        EXPECT_EQUAL(WarmUpUntilSettled(ramp, config), 0);
+
+        config.stabilize = true;
+        const auto done  = WarmUpUntilSettled(ramp, config);
+        EXPECT_EQUAL(done, runs);
+        EXPECT(done > 8);
+        EXPECT(std::pow(0.9f, static_cast<float>(done)) < 0.05f);
+
+        // Never settles, stops once the runs took more than the limit: 1 + 2 + ... + 16.
+        runs            = 0;
+        const auto grow = [&]() { return static_cast<float>(++runs); };
+        EXPECT_EQUAL(WarmUpUntilSettled(grow, config), 16);
+    }
+
+    void NormalizesToMaxClock() const
+    {
+        EXPECT_EQUAL(NormalizeFindTime(2.0f, 1000, 2000), 1.0f);
+        EXPECT_EQUAL(NormalizeFindTime(2.0f, 2000, 2000), 2.0f);
+        EXPECT_EQUAL(NormalizeFindTime(2.0f, 0, 2000), 0.0f);
+        EXPECT_EQUAL(NormalizeFindTime(2.0f, 1000, 0), 0.0f);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::FindTimingTest{}.Run(); }
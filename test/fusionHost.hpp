@@ -708,6 +708,15 @@ void visitActivationHostInfer(
     case miopenActivationELU: // alpah * (exp(x)-1) | x<=0; x | x>0
         f([=](double x) { return ((x > 0.) ? x : alpha * std::expm1(x)); });
         break;
+    case miopenActivationGELU: // 0.5 * x * (1 + erf(x / sqrt(2)))
+        f([=](double x) { return 0.5 * x * (1 + std::erf(x / std::sqrt(2.))); });
+        break;
+    case miopenActivationSILU: // x / (1 + e^-x)
+        f([=](double x) { return x / (1 + std::exp(-x)); });
+        break;
+    case miopenActivationMISH: // x * tanh(log(1 + e^x))
+        f([=](double x) { return x * std::tanh(std::log1p(std::exp(x))); });
+        break;
         // default: printf("ERROR: unknown neuron type: %d\n", activMode); break;
     }
 }
@@ -770,6 +779,26 @@ void visitActivationHostBwd(
     case miopenActivationELU: // alpah * (exp(x)-1) | x<=0; x | x>0
         f([=](double dy, double x, double y) { return dy * ((x > 0) ? 1 : y + alpha); });
         break;
+    case miopenActivationGELU: // 0.5 * x * (1 + erf(x / sqrt(2)))
+        f([=](double dy, double x, double) {
+            double cdf = 0.5 * (1 + std::erf(x / std::sqrt(2.)));
+            double pdf = std::exp(-0.5 * x * x) / std::sqrt(2. * 3.14159265358979323846);
+            return dy * (cdf + x * pdf);
+        });
+        break;
+    case miopenActivationSILU: // x / (1 + e^-x)
+        f([=](double dy, double x, double) {
+            double s = 1 / (1 + std::exp(-x));
+            return dy * s * (1 + x * (1 - s));
+        });
+        break;
+    case miopenActivationMISH: // x * tanh(log(1 + e^x))
+        f([=](double dy, double x, double) {
+            double t = std::tanh(std::log1p(std::exp(x)));
+            double s = 1 / (1 + std::exp(-x));
+            return dy * (t + x * s * (1 - t * t));
+        });
+        break;
         // default: printf("ERROR: unknown neuron type: %d\n", activMode); break;
     }
 }
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/solver/gemm_cost_model.hpp>
+
+#include <limits>
+
+namespace miopen {
+namespace tests {
+
+struct GemmCostModelTest
+{
+    void Run() const
+    {
+        RejectsShapesWhichCannotRun();
+        PrefersTilesWithoutPadding();
+        PrefersTilesWhichFillTheDevice();
+        PrefersLargerTilesForLargeProblems();
+    }
+
+    private:
+    static constexpr std::size_t num_cu = 120;
+
+    static solver::GemmTileShape Shape(std::size_t m, std::size_t n, std::size_t k)
+    {
+        solver::GemmTileShape shape;
+        shape.gemm_m      = m;
+        shape.gemm_n      = n;
+        shape.gemm_k      = k;
+        shape.m_per_block = 128;
+        shape.n_per_block = 128;
+        shape.k_per_block = 16;
+        shape.block_size  = 256;
+        shape.lds_size    = 16 * 1024;
+        return shape;
+    }
+
+    static solver::GemmTileShape
+    Tile(solver::GemmTileShape shape, std::size_t m_per_block, std::size_t n_per_block)
+    {
+        shape.m_per_block = m_per_block;
+        shape.n_per_block = n_per_block;
+        return shape;
+    }
+
+    static float Cost(const solver::GemmTileShape& shape)
+    {
+        return solver::EstimateGemmTileCost(shape, num_cu);
+    }
+
+    static void RejectsShapesWhichCannotRun()
+    {
+        auto too_much_lds     = Shape(1024, 1024, 1024);
+        too_much_lds.lds_size = 128 * 1024;
+        EXPECT_EQUAL(Cost(too_much_lds), std::numeric_limits<float>::max());
+        EXPECT_EQUAL(Cost(Tile(Shape(1024, 1024, 1024), 0, 128)),
+                     std::numeric_limits<float>::max());
+        EXPECT(Cost(Shape(1024, 1024, 1024)) < std::numeric_limits<float>::max());
+    }
+
+    static void PrefersTilesWithoutPadding()
+    {
+        // 192 is covered by 64 wide tiles exactly, but 128 wide ones waste a quarter.
+        const auto shape = Shape(192 * 120, 192, 256);
+        EXPECT(Cost(Tile(shape, 64, 64)) < Cost(Tile(shape, 128, 128)));
+    }
+
+    static void PrefersTilesWhichFillTheDevice()
+    {
+        // Only 4 large tiles, so most of the compute units would idle.
+        const auto shape = Shape(256, 256, 4096);
+        EXPECT(Cost(Tile(shape, 32, 32)) < Cost(shape));
+    }
+
+    static void PrefersLargerTilesForLargeProblems()
+    {
+        const auto shape = Shape(8192, 8192, 1024);
+        EXPECT(Cost(shape) < Cost(Tile(shape, 16, 16)));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::GemmCostModelTest{}.Run(); }
@@ -31,6 +31,9 @@
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
 #include <miopen/execution_context.hpp>
+#if MIOPEN_BACKEND_HIP
+#include <miopen/hip_graph.hpp>
+#endif
 
 #if WORKAROUND_SWDEV_257056_PCH_MISSING_MACROS
 #include <miopen/hip_build_utils.hpp>
@@ -126,6 +129,163 @@ void test_multithreads(kernel_type_t kern_type, const bool with_stream = false)
     run2s(with_stream ? h2 : h1, 4, kern_type);
 }
 
+void test_async_transfers()
+{
+    auto&& h            = get_handle();
+    const std::size_t n = 64;
+    auto data_dev       = h.Create<int>(2 * n);
+    auto copy_dev       = h.Create<int>(2 * n);
+    {
+        // The staged data may go away before the copies complete.
+        const std::vector<int> ones(n, 1);
+        const std::vector<int> twos(n, 2);
+        h.WriteToAsync(ones.data(), data_dev.get(), n * sizeof(int));
+        h.WriteToAsync(twos.data(), data_dev.get(), n * sizeof(int), n * sizeof(int));
+    }
+    h.AddKernel("GEMM", "", Write2s(miopenOpenCLKernelType), "write", {n, 1, 1}, {n, 1, 1}, "")(
+        data_dev.get());
+    h.CopyAsync(data_dev.get(), copy_dev.get(), 2 * n * sizeof(int));
+    h.ZeroAsync(data_dev.get(), n * sizeof(int));
+
+    // The kernel doubles the first half.
+    auto expected = std::vector<int>(2 * n, 2);
+    auto result = std::vector<int>(2 * n);
+    h.ReadToOrdered(result.data(), copy_dev.get(), result.size() * sizeof(int));
+    CHECK(result == expected);
+
+    std::fill(expected.begin(), expected.begin() + n, 0);
+    h.ReadToOrdered(result.data(), data_dev.get(), result.size() * sizeof(int));
+    CHECK(result == expected);
+}
+
+void test_async_copy_2d_and_fill()
+{
+    auto&& h            = get_handle();
+    const std::size_t n = 64;
+    auto data_dev       = h.Create<int>(2 * n);
+    auto copy_dev       = h.Create<int>(2 * n);
+
+    const int pattern = 3;
+    h.FillAsync(data_dev.get(), 0, 2 * n * sizeof(int), &pattern, sizeof(pattern));
+    h.ZeroAsync(copy_dev.get(), 2 * n * sizeof(int));
+    // Copies the first half of every row of 8 to its second half.
+    const std::size_t row = 8 * sizeof(int);
+    h.Copy2DAsync(data_dev.get(), 0, row, copy_dev.get(), row / 2, row, row / 2, 2 * n / 8);
+
+    auto expected = std::vector<int>(2 * n, 0);
+    for(std::size_t i = 0; i < expected.size(); ++i)
+        expected[i] = (i % 8) < 4 ? 0 : pattern;
+    auto result = std::vector<int>(2 * n);
+    h.ReadToOrdered(result.data(), copy_dev.get(), result.size() * sizeof(int));
+    CHECK(result == expected);
+}
+
+#if MIOPEN_BACKEND_HIP
+void test_stream_pool(kernel_type_t kern_type)
+{
+    miopen::Handle h{};
+    const auto main_stream = h.GetStream();
+    h.ReserveExtraStreamsInPool(2);
+    EXPECT(h.GetStreamPoolSize() == 3);
+    EXPECT(h.GetStream() == main_stream);
+
+    std::vector<miopenAcceleratorQueue_t> streams(h.GetStreamPoolSize());
+    std::vector<std::thread> threads;
+    for(auto i = 0; i < h.GetStreamPoolSize(); ++i)
+    {
+        threads.emplace_back([&, i] {
+            h.SetStreamFromPool(i);
+            streams[i] = h.GetStream();
+            run2s(h, 16 * (i + 1), kern_type);
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT(streams[0] == main_stream);
+    EXPECT(streams[1] != main_stream);
+    EXPECT(streams[2] != main_stream);
+    EXPECT(streams[1] != streams[2]);
+    EXPECT(h.GetStream() == main_stream);
+}
+
+void test_graph_capture()
+{
+    // The null stream can not be captured.
+    hipStream_t stream = nullptr;
+    EXPECT(hipStreamCreate(&stream) == hipSuccess);
+    const auto stream_ptr = MIOPEN_MANAGE_PTR(hipStream_t, hipStreamDestroy){stream};
+    miopen::Handle h{stream};
+    const std::size_t n = 64;
+    std::vector<int> data_in(n, 1);
+    auto data_dev = h.Write(data_in);
+    auto kernel   = h.AddKernel(
+        "GEMM", "", Write2s(miopenOpenCLKernelType), "write", {n, 1, 1}, {n, 1, 1}, "");
+
+    miopen::HipGraph graph;
+    graph.BeginCapture(h);
+    kernel(data_dev.get());
+    graph.EndCapture(h);
+    EXPECT(graph.IsInstantiated());
+
+    graph.Launch(h);
+    graph.Launch(h);
+    std::fill(data_in.begin(), data_in.end(), 4);
+    CHECK(h.Read<int>(data_dev, n) == data_in);
+}
+
+void test_event_pool()
+{
+    miopen::Handle h{};
+    const auto& pool = h.GetEventPool();
+    h.Finish();
+    const auto idle = pool.GetIdleCount();
+    EXPECT(idle > 0);
+
+    hipEvent_t raw = nullptr;
+    {
+        const auto event = pool.Get();
+        raw              = event.get();
+        EXPECT(pool.GetIdleCount() == idle - 1);
+    }
+    EXPECT(pool.GetIdleCount() == idle);
+    EXPECT(pool.Get().get() == raw);
+
+    h.EnableProfiling();
+    h.ResetKernelTime();
+    const std::size_t n = 64;
+    auto data_dev       = h.Write(std::vector<int>(n, 1));
+    auto kernel         = h.AddKernel(
+        "GEMM", "", Write2s(miopenOpenCLKernelType), "write", {n, 1, 1}, {n, 1, 1}, "");
+    kernel(data_dev.get());
+    EXPECT(pool.GetIdleCount() >= 2);
+}
+
+void test_deferred_kernel_times()
+{
+    miopen::Handle h{};
+    h.EnableProfiling();
+    h.DeferKernelTimes();
+    h.ResetKernelTime();
+    const std::size_t n = 64;
+    auto data_dev       = h.Write(std::vector<int>(n, 1));
+    auto kernel         = h.AddKernel(
+        "GEMM", "", Write2s(miopenOpenCLKernelType), "write", {n, 1, 1}, {n, 1, 1}, "");
+    kernel(data_dev.get());
+    kernel(data_dev.get());
+    EXPECT(h.GetKernelTime() > 0.0f);
+
+    // A resolution starts a new sum.
+    kernel(data_dev.get());
+    h.FlushKernelTimes();
+    EXPECT(h.GetKernelTime() > 0.0f);
+
+    h.DeferKernelTimes(false);
+    EXPECT(!h.IsKernelTimeDeferred());
+    EXPECT(h.Read<int>(data_dev, n) == std::vector<int>(n, 8));
+}
+#endif
+
 std::string WriteError(kernel_type_t kern_type)
 {
     if(kern_type == miopenOpenCLKernelType)
@@ -260,6 +420,14 @@ int main()
     }
     test_multithreads(miopenOpenCLKernelType);
     test_multithreads(miopenOpenCLKernelType, true);
+    test_async_transfers();
+    test_async_copy_2d_and_fill();
+#if MIOPEN_BACKEND_HIP
+    test_stream_pool(miopenOpenCLKernelType);
+    test_graph_capture();
+    test_event_pool();
+    test_deferred_kernel_times();
+#endif
     test_errors(miopenOpenCLKernelType);
     test_arch_name();
 // Warnings currently dont work in opencl
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/invoke_params.hpp>
+#include <miopen/invoker_cache.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct InvokerCacheTest
+{
+    void Run() const
+    {
+        RegisterAndFind();
+        Find1_0();
+        ConcurrentLookups();
+    }
+
+    private:
+    const solver::Id solver_a{"ConvAsm3x3U"};
+    const solver::Id solver_b{"ConvAsm1x1U"};
+
+    struct TaggedInvoker
+    {
+        int tag;
+        void operator()(const Handle&, const AnyInvokeParams&) const {}
+    };
+
+    static Invoker MakeInvoker(int tag) { return TaggedInvoker{tag}; }
+
+    static int GetTag(const Invoker& invoker) { return invoker.target<TaggedInvoker>()->tag; }
+
+    void RegisterAndFind() const
+    {
+        InvokerCache cache;
+        const auto config = NetworkConfig{"1x2x3x4"};
+        const auto other  = NetworkConfig{"4x3x2x1"};
+
+        EXPECT(!cache(config, solver_a));
+
+        cache.Register(config, solver_a, MakeInvoker(1));
+        EXPECT(cache(config, solver_a));
+        EXPECT_EQUAL(GetTag(*cache(config, solver_a)), 1);
+        EXPECT(!cache(config, solver_b));
+        EXPECT(!cache(other, solver_a));
+
+        // Lookups with an equal config constructed separately must hit as well.
+        EXPECT(cache(NetworkConfig{std::string{"1x2x3x4"}}, solver_a));
+    }
+
+    void Find1_0() const
+    {
+        InvokerCache cache;
+        const auto config = NetworkConfig{"1x2x3x4"};
+        const auto algo   = AlgorithmName{"miopenConvolutionFwdAlgoDirect"};
+
+        EXPECT(!cache.GetFound1_0(config, algo));
+        EXPECT(throws([&]() { cache.SetAsFound1_0(config, algo, solver_a); }));
+
+        cache.Register(config, solver_a, MakeInvoker(1));
+        cache.Register(config, solver_b, MakeInvoker(2));
+        EXPECT(!cache.GetFound1_0(config, algo));
+
+        cache.SetAsFound1_0(config, algo, solver_b);
+        const auto found = cache.GetFound1_0(config, algo);
+        EXPECT(found);
+        EXPECT_EQUAL(GetTag(*found), 2);
+    }
+
+    void ConcurrentLookups() const
+    {
+        constexpr int configs_count = 64;
+        constexpr int threads_count = 8;
+
+        InvokerCache cache;
+        std::vector<NetworkConfig> configs;
+        for(auto i = 0; i < configs_count; ++i)
+            configs.emplace_back("config_" + std::to_string(i));
+
+        std::atomic<int> hits{0};
+        std::vector<std::thread> threads;
+        threads.emplace_back([&]() {
+            for(const auto& config : configs)
+                cache.Register(config, solver_a, MakeInvoker(0));
+        });
+        for(auto t = 0; t < threads_count; ++t)
+        {
+            threads.emplace_back([&]() {
+                for(const auto& config : configs)
+                    if(cache(config, solver_a))
+                        ++hits;
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        EXPECT(hits <= configs_count * threads_count);
+        for(const auto& config : configs)
+            EXPECT(cache(config, solver_a));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::InvokerCacheTest{}.Run(); }
@@ -51,6 +51,7 @@ struct KBPTestDriver : test_driver
             "-Wa,-defsym,DefineWithValue=0 -TrivialOption -OptionWithValue 0 -Wa,-defsym,Shifted "
             "-Wa,-defsym,DefineDefine "
             "-Wa,-defsym,DefineDefineWithValue=1");
+        EXPECT_EQUAL(kbp.GenerateFor(kbp::HIP{}), kbp.GenerateFor(kbp::OpenCL{}));
     }
 };
 } // namespace tests
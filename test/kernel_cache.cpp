@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/kernel_cache.hpp>
+
+namespace miopen {
+namespace tests {
+
+struct KernelCacheTest
+{
+    void Run() const
+    {
+        Unbounded();
+        EvictsLeastRecentlyUsedPrograms();
+        RemovesPrograms();
+    }
+
+    private:
+    static void Unbounded()
+    {
+        KernelCache cache{0, 0};
+        for(auto i = 0; i < 16; ++i)
+            cache.AddProgram(Program{}, "program_" + std::to_string(i), "");
+        EXPECT_EQUAL(cache.GetProgramsCount(), 16);
+        EXPECT_EQUAL(cache.GetKernelsCount(), 0);
+    }
+
+    static void EvictsLeastRecentlyUsedPrograms()
+    {
+        KernelCache cache{0, 2};
+        cache.AddProgram(Program{}, "a", "");
+        cache.AddProgram(Program{}, "b", "");
+        cache.AddProgram(Program{}, "a", "");
+        cache.AddProgram(Program{}, "c", "");
+
+        EXPECT_EQUAL(cache.GetProgramsCount(), 2);
+        EXPECT(cache.HasProgram("a", ""));
+        EXPECT(!cache.HasProgram("b", ""));
+        EXPECT(cache.HasProgram("c", ""));
+        EXPECT_EQUAL(cache.GetCodeObjectsSize(), 0);
+
+        const auto programs = cache.GetPrograms();
+        EXPECT_EQUAL(programs.size(), 2);
+        EXPECT_EQUAL(programs[0].first.first, "c");
+        EXPECT_EQUAL(programs[1].first.first, "a");
+    }
+
+    static void RemovesPrograms()
+    {
+        KernelCache cache{0, 0};
+        cache.AddProgram(Program{}, "a", "-DA");
+        cache.AddProgram(Program{}, "a", "-DB");
+        cache.RemoveProgram("a", "-DA");
+        cache.RemoveProgram("b", "");
+
+        EXPECT_EQUAL(cache.GetProgramsCount(), 1);
+        EXPECT(!cache.HasProgram("a", "-DA"));
+        EXPECT(cache.HasProgram("a", "-DB"));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::KernelCacheTest{}.Run(); }
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/mapped_db.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <fstream>
+
+namespace miopen {
+namespace tests {
+
+struct MappedDbTest
+{
+    void Run() const
+    {
+        const TmpDir dir{"test_mapped_db"};
+        const auto text_path = (dir.path / "test.fdb.txt").string();
+        const auto path      = MappedDb::GetPath(text_path);
+
+        std::ofstream(text_path) << "key_b=id:b" << std::endl
+                                 << std::endl
+                                 << "no_key" << std::endl
+                                 << "key_a=id:a;other:x" << std::endl
+                                 << "key_b=id:duplicate" << std::endl
+                                 << "key_c=" << std::endl;
+        MappedDb::Convert(text_path, path);
+
+        FindsRecords(path, text_path);
+        LoadsThroughRamDb(text_path);
+        SharesTextDb(text_path);
+        RejectsOutdatedFile(path, text_path);
+        LoadsTextDb((dir.path / "text.fdb.txt").string());
+    }
+
+    private:
+    static void FindsRecords(const std::string& path, const std::string& text_path)
+    {
+        const auto db = MappedDb::Open(path, text_path);
+        EXPECT(db != nullptr);
+        EXPECT_EQUAL(db->GetCount(), 3);
+
+        const auto a = db->Find("key_a");
+        EXPECT(a);
+        EXPECT_EQUAL(a->content, "id:a;other:x");
+        EXPECT_EQUAL(a->line, 4);
+
+        const auto b = db->Find("key_b");
+        EXPECT(b);
+        EXPECT_EQUAL(b->content, "id:b");
+
+        const auto c = db->Find("key_c");
+        EXPECT(c);
+        EXPECT(c->content.empty());
+
+        EXPECT(!db->Find("key"));
+        EXPECT(!db->Find("key_d"));
+        EXPECT(!db->Find(""));
+    }
+
+    static void LoadsThroughRamDb(const std::string& text_path)
+    {
+        const auto& db    = ReadonlyRamDb::GetCached(text_path, true);
+        const auto record = db.FindRecord(std::string{"key_a"});
+        EXPECT(record);
+        EXPECT_EQUAL(record->GetSize(), 2);
+        EXPECT(!db.FindRecord(std::string{"key_d"}));
+    }
+
+    static void SharesTextDb(const std::string& text_path)
+    {
+        MappedDb::RemoveShared(text_path);
+        const auto first  = MappedDb::OpenShared(text_path);
+        const auto second = MappedDb::OpenShared(text_path);
+        EXPECT(first != nullptr);
+        EXPECT(second != nullptr);
+        EXPECT_EQUAL(second->GetCount(), 3);
+
+        const auto a = second->Find("key_a");
+        EXPECT(a);
+        EXPECT_EQUAL(a->content, "id:a;other:x");
+        EXPECT(!second->Find("key_d"));
+        MappedDb::RemoveShared(text_path);
+    }
+
+    // Without the precompiled file records are indexed and parsed on the first lookup.
+    static void LoadsTextDb(const std::string& text_path)
+    {
+        std::ofstream(text_path) << "key_b=id:b" << std::endl
+                                 << "=no_key" << std::endl
+                                 << "key_a=id:a;other:x" << std::endl
+                                 << "key_b=id:duplicate;other:y" << std::endl
+                                 << "key_c=id:c";
+
+        const auto& db = ReadonlyRamDb::GetCached(text_path, true);
+        for(auto i = 0; i < 2; ++i)
+        {
+            const auto a = db.FindRecord(std::string{"key_a"});
+            EXPECT(a);
+            EXPECT_EQUAL(a->GetSize(), 2);
+        }
+
+        const auto b = db.FindRecord(std::string{"key_b"});
+        EXPECT(b);
+        EXPECT_EQUAL(b->GetSize(), 1);
+        EXPECT(db.FindRecord(std::string{"key_c"}));
+        EXPECT(!db.FindRecord(std::string{"key"}));
+        EXPECT(!db.FindRecord(std::string{""}));
+    }
+
+    static void RejectsOutdatedFile(const std::string& path, const std::string& text_path)
+    {
+        std::ofstream(text_path, std::ios::app) << "key_d=id:d" << std::endl;
+        EXPECT(MappedDb::Open(path, text_path) == nullptr);
+        EXPECT(MappedDb::Open(path + ".missing", text_path) == nullptr);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::MappedDbTest{}.Run(); }
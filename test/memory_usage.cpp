@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/handle.hpp>
+#include <miopen/memory_usage.hpp>
+
+#include <memory>
+
+namespace miopen {
+namespace tests {
+
+struct MemoryUsageTest
+{
+    void Run() const
+    {
+        Counters();
+        HandleBuffers();
+    }
+
+    private:
+    static void Counters()
+    {
+        MemoryUsage usage;
+        usage.Add(MemoryCategory::Buffers, 100);
+        usage.Add(MemoryCategory::Constants, 50);
+        usage.Remove(MemoryCategory::Buffers, 100);
+        usage.Set(MemoryCategory::Rocblas, 10);
+        EXPECT(usage.Get(MemoryCategory::Buffers) == 0);
+        EXPECT(usage.GetPeak(MemoryCategory::Buffers) == 100);
+        EXPECT(usage.GetTotal() == 60);
+        EXPECT(usage.GetTotalPeak() == 150);
+
+        usage.Set(MemoryCategory::Rocblas, 4);
+        EXPECT(usage.GetTotal() == 54);
+        EXPECT(usage.GetPeak(MemoryCategory::Rocblas) == 10);
+
+        usage.AddSelectedWorkspace(20);
+        usage.AddSelectedWorkspace(5);
+        EXPECT(usage.GetSelectedWorkspacePeak() == 20);
+
+        usage.ResetPeaks();
+        EXPECT(usage.GetPeak(MemoryCategory::Buffers) == 0);
+        EXPECT(usage.GetTotalPeak() == 54);
+        EXPECT(usage.GetSelectedWorkspacePeak() == 0);
+    }
+
+    static void HandleBuffers()
+    {
+        auto handle        = std::make_unique<Handle>();
+        const auto& usage  = handle->GetMemoryUsage();
+        const auto initial = usage.Get(MemoryCategory::Buffers);
+
+        auto scratch = handle->Create(64);
+        EXPECT(usage.Get(MemoryCategory::Buffers) == initial + 64);
+        {
+            const MemoryCategoryScope scope{MemoryCategory::Constants};
+            auto constants = handle->Create(32);
+            EXPECT(usage.Get(MemoryCategory::Constants) == 32);
+        }
+        EXPECT(usage.Get(MemoryCategory::Constants) == 0);
+        EXPECT(usage.GetPeak(MemoryCategory::Constants) == 32);
+        EXPECT(MemoryCategoryScope::Current() == MemoryCategory::Buffers);
+
+        // The buffers may outlive the handle.
+        handle.reset();
+        scratch.reset();
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main()
+{
+    miopen::tests::MemoryUsageTest{}.Run();
+    return 0;
+}
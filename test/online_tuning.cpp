@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/online_tuning.hpp>
+
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct OnlineTuningTest
+{
+    void Run() const
+    {
+        ExploresPeriodically();
+        RespectsWorkspace();
+        PromotesConsistentWinner();
+        KeepsIncumbentWithinNoise();
+    }
+
+    private:
+    static OnlineTuningConfig MakeConfig()
+    {
+        auto config        = OnlineTuningConfig{};
+        config.interval    = 4;
+        config.samples     = 8;
+        config.min_samples = 4;
+        return config;
+    }
+
+    void ExploresPeriodically() const
+    {
+        OnlineTuner tuner{MakeConfig()};
+        EXPECT(!tuner.HasCandidates("p"));
+        tuner.SetCandidates("p", {{"a", 0}, {"b", 0}, {"c", 0}});
+        EXPECT(tuner.HasCandidates("p"));
+
+        for(auto i = 0; i < 3; ++i)
+            EXPECT(!tuner.Next("p", "a", 0));
+        const auto first = tuner.Next("p", "a", 0);
+        EXPECT(first && *first == "b");
+        tuner.Record("p", "b", 1.0f);
+
+        for(auto i = 0; i < 3; ++i)
+            EXPECT(!tuner.Next("p", "a", 0));
+        const auto second = tuner.Next("p", "a", 0);
+        EXPECT(second && *second == "c");
+    }
+
+    void RespectsWorkspace() const
+    {
+        OnlineTuner tuner{MakeConfig()};
+        tuner.SetCandidates("p", {{"a", 0}, {"big", 100}});
+        for(auto i = 0; i < 8; ++i)
+            EXPECT(!tuner.Next("p", "a", 10));
+    }
+
+    void PromotesConsistentWinner() const
+    {
+        OnlineTuner tuner{MakeConfig()};
+        for(auto i = 0; i < 4; ++i)
+        {
+            tuner.Record("p", "a", 2.0f);
+            EXPECT(!tuner.TakeWinner("p", "a"));
+        }
+        for(auto i = 0; i < 4; ++i)
+            tuner.Record("p", "b", 1.0f);
+
+        const auto winner = tuner.TakeWinner("p", "a");
+        EXPECT(winner);
+        EXPECT_EQUAL(winner->solver, std::string{"b"});
+        EXPECT_EQUAL(winner->time.time, 1.0f);
+        EXPECT_EQUAL(winner->incumbent_time.time, 2.0f);
+        // Reported once.
+        EXPECT(!tuner.TakeWinner("p", "a"));
+    }
+
+    void KeepsIncumbentWithinNoise() const
+    {
+        OnlineTuner tuner{MakeConfig()};
+        for(auto i = 0; i < 4; ++i)
+        {
+            tuner.Record("p", "a", 1.0f);
+            tuner.Record("p", "b", 0.99f);
+        }
+        EXPECT(!tuner.TakeWinner("p", "a"));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::OnlineTuningTest{}.Run(); }
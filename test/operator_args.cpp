@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/fusion.hpp>
+
+#include <cstring>
+
+namespace miopen {
+namespace tests {
+
+struct OperatorArgsTest
+{
+    void Run() const
+    {
+        ReplacesArguments();
+        RenewsGeneration();
+    }
+
+    private:
+    static int Read(const OperatorArgs& args, const std::string& key)
+    {
+        int value;
+        std::memcpy(&value, args.args_map.at(key).buffer.data(), sizeof(value));
+        return value;
+    }
+
+    static void ReplacesArguments()
+    {
+        auto args = OperatorArgs{};
+        args.ins_arg("alpha0", OpKernelArg(1));
+        args.ins_arg("beta0", OpKernelArg(2));
+        args.ins_arg("alpha0", OpKernelArg(3));
+
+        EXPECT_EQUAL(args.args_map.size(), 2);
+        EXPECT_EQUAL(Read(args, "alpha0"), 3);
+        EXPECT_EQUAL(Read(args, "beta0"), 2);
+    }
+
+    static void RenewsGeneration()
+    {
+        auto first  = OperatorArgs{};
+        auto second = OperatorArgs{};
+        EXPECT(first.generation != second.generation);
+
+        const auto initial = first.generation;
+        first.ins_arg("alpha0", OpKernelArg(1));
+        EXPECT(first.generation != initial);
+        EXPECT(first.generation != second.generation);
+
+        const auto set = first.generation;
+        first.ins_arg("alpha0", OpKernelArg(1));
+        EXPECT(first.generation != set);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::OperatorArgsTest{}.Run(); }
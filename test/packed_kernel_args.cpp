@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/op_kernel_args.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct PackedKernelArgsTest
+{
+    void Run() const
+    {
+        AlignsArguments();
+        UpdatesArguments();
+        RejectsMismatchedArguments();
+    }
+
+    private:
+    template <class T>
+    static T Read(const PackedKernelArgs& args, std::size_t index)
+    {
+        T value;
+        std::memcpy(&value, args.data() + args.GetOffset(index), sizeof(T));
+        return value;
+    }
+
+    static void AlignsArguments()
+    {
+        int dummy = 0;
+        const auto args = PackedKernelArgs{{OpKernelArg(static_cast<int8_t>(1)),
+                                            OpKernelArg(&dummy),
+                                            OpKernelArg(static_cast<int16_t>(2)),
+                                            OpKernelArg(3.0f)}};
+
+        EXPECT_EQUAL(args.GetCount(), 4);
+        EXPECT_EQUAL(args.GetOffset(0), 0);
+        EXPECT_EQUAL(args.GetOffset(1), sizeof(int*));
+        EXPECT_EQUAL(args.GetOffset(2), 2 * sizeof(int*));
+        EXPECT_EQUAL(args.GetOffset(3), 2 * sizeof(int*) + 4);
+        EXPECT_EQUAL(args.size(), 2 * sizeof(int*) + 8);
+
+        EXPECT_EQUAL(Read<int8_t>(args, 0), 1);
+        EXPECT(Read<int*>(args, 1) == &dummy);
+        EXPECT_EQUAL(Read<int16_t>(args, 2), 2);
+        EXPECT_EQUAL(Read<float>(args, 3), 3.0f);
+    }
+
+    static void UpdatesArguments()
+    {
+        int first  = 0;
+        int second = 0;
+        auto args  = PackedKernelArgs{{OpKernelArg(&first), OpKernelArg(7)}};
+
+        args.Set(0, &second);
+        EXPECT(Read<int*>(args, 0) == &second);
+        EXPECT_EQUAL(Read<int>(args, 1), 7);
+
+        args.Set(1, OpKernelArg(8));
+        EXPECT_EQUAL(Read<int>(args, 1), 8);
+    }
+
+    static void RejectsMismatchedArguments()
+    {
+        auto args = PackedKernelArgs{{OpKernelArg(7)}};
+        EXPECT(throws([&]() { args.Set(0, 1.0); }));
+        EXPECT(throws([&]() { args.Set(1, 7); }));
+        EXPECT(throws([&]() { args.Set(0, OpKernelArg(static_cast<int16_t>(7))); }));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::PackedKernelArgsTest{}.Run(); }
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/par_for.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+struct ParForTest
+{
+    void Run() const
+    {
+        EachIndexOnce();
+        Strided();
+        Nested();
+        Concurrent();
+        Exception();
+    }
+
+    private:
+    void EachIndexOnce() const
+    {
+        constexpr std::size_t n = 10000;
+        std::vector<std::atomic<int>> counts(n);
+        par_for(n, min_grain{1}, [&](std::size_t i) { ++counts[i]; });
+        for(const auto& count : counts)
+            EXPECT_EQUAL(count.load(), 1);
+    }
+
+    void Strided() const
+    {
+        constexpr std::size_t n = 37;
+        std::vector<std::atomic<int>> counts(n);
+        par_for_strided(n, max_threads{5}, [&](std::size_t i) { ++counts[i]; });
+        for(const auto& count : counts)
+            EXPECT_EQUAL(count.load(), 1);
+    }
+
+    // The inner loops run while the workers of the pool are busy with the outer one.
+    void Nested() const
+    {
+        std::atomic<std::size_t> sum{0};
+        par_for(64, min_grain{1}, [&](std::size_t) {
+            par_for(100, min_grain{1}, [&](std::size_t i) { sum += i; });
+        });
+        EXPECT_EQUAL(sum.load(), 64 * 4950);
+    }
+
+    void Concurrent() const
+    {
+        constexpr int threads_count = 4;
+        std::atomic<std::size_t> sum{0};
+        std::vector<std::thread> threads;
+        for(auto t = 0; t < threads_count; ++t)
+        {
+            threads.emplace_back(
+                [&]() { par_for(1000, min_grain{1}, [&](std::size_t i) { sum += i; }); });
+        }
+        for(auto& thread : threads)
+            thread.join();
+        EXPECT_EQUAL(sum.load(), threads_count * 499500);
+    }
+
+    void Exception() const
+    {
+        EXPECT(throws([&]() {
+            par_for(100, min_grain{1}, [&](std::size_t i) {
+                if(i == 50)
+                    throw std::runtime_error("par_for test");
+            });
+        }));
+        // The pool keeps working after a failed loop.
+        EachIndexOnce();
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ParForTest{}.Run(); }
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct TestText
+{
+    std::string text;
+
+    void Serialize(std::ostream& s) const { s << text; }
+    bool Deserialize(const std::string& s)
+    {
+        text = s;
+        return true;
+    }
+};
+
+struct PlainTextDbIndexTest
+{
+    void Run() const
+    {
+        const TmpDir dir{"test_plain_text_db_index"};
+
+        AppendsRecords((dir.path / "append.udb.txt").string());
+        SeesExternalAppends((dir.path / "external.udb.txt").string());
+        SeesReplacedFile((dir.path / "replaced.udb.txt").string());
+        CompactsFile((dir.path / "compact.udb.txt").string());
+    }
+
+    private:
+    static boost::optional<std::string>
+    Load(const std::string& path, const std::string& key, const std::string& id)
+    {
+        auto value = TestText{};
+        if(!PlainTextDb{path}.Load(TestText{key}, id, value))
+            return boost::none;
+        return value.text;
+    }
+
+    static void AppendsRecords(const std::string& path)
+    {
+        auto db = PlainTextDb{path};
+        EXPECT(db.Update(TestText{"key"}, "id0", TestText{"a"}));
+        EXPECT(db.Update(TestText{"key"}, "id1", TestText{"b"}));
+        EXPECT(db.Update(TestText{"key"}, "id0", TestText{"c"}));
+        EXPECT(Load(path, "key", "id0") == std::string{"c"});
+        EXPECT(Load(path, "key", "id1") == std::string{"b"});
+
+        EXPECT(db.Remove(TestText{"key"}, "id0"));
+        EXPECT(!Load(path, "key", "id0"));
+        EXPECT(Load(path, "key", "id1") == std::string{"b"});
+
+        EXPECT(db.RemoveRecord(TestText{"key"}));
+        EXPECT(!db.FindRecord(TestText{"key"}));
+    }
+
+    static void SeesExternalAppends(const std::string& path)
+    {
+        std::ofstream(path) << "key=id0:a" << std::endl;
+        EXPECT(Load(path, "key", "id0") == std::string{"a"});
+
+        // An incomplete line is not a record yet.
+        std::ofstream(path, std::ios::app) << "key=id0:b";
+        EXPECT(Load(path, "key", "id0") == std::string{"a"});
+        std::ofstream(path, std::ios::app) << std::endl << "other=id0:c" << std::endl;
+        EXPECT(Load(path, "key", "id0") == std::string{"b"});
+        EXPECT(Load(path, "other", "id0") == std::string{"c"});
+
+        std::ofstream(path, std::ios::app) << "key=" << std::endl;
+        EXPECT(!PlainTextDb{path}.FindRecord(TestText{"key"}));
+    }
+
+    static void SeesReplacedFile(const std::string& path)
+    {
+        std::ofstream(path) << "key=id0:a" << std::endl << "other=id0:b" << std::endl;
+        EXPECT(Load(path, "other", "id0") == std::string{"b"});
+
+        const auto temp_path = path + ".new";
+        std::ofstream(temp_path) << "other=id0:replaced" << std::endl;
+        boost::filesystem::rename(temp_path, path);
+        EXPECT(Load(path, "other", "id0") == std::string{"replaced"});
+        EXPECT(!Load(path, "key", "id0"));
+    }
+
+    static void CompactsFile(const std::string& path)
+    {
+        auto db = PlainTextDb{path};
+        const auto value = std::string(100, 'x');
+
+        for(auto i = 0; i < 2000; ++i)
+            EXPECT(db.Update(TestText{"key"}, "id0", TestText{value + std::to_string(i)}));
+        EXPECT(db.Update(TestText{"other"}, "id0", TestText{"kept"}));
+
+        EXPECT(boost::filesystem::file_size(path) < 64 * 1024);
+        EXPECT(Load(path, "key", "id0") == value + "1999");
+        EXPECT(Load(path, "other", "id0") == std::string{"kept"});
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::PlainTextDbIndexTest{}.Run(); }
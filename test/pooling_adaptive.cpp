@@ -0,0 +1,256 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "verify.hpp"
+
+#include <miopen/pooling.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <limits>
+
+static int region_begin(int o, int in_len, int out_len) { return (o * in_len) / out_len; }
+
+static int region_end(int o, int in_len, int out_len)
+{
+    return ((o + 1) * in_len + out_len - 1) / out_len;
+}
+
+struct verify_forward_adaptive_pooling
+{
+    template <class T>
+    tensor<T> cpu(const tensor<T>& input,
+                  const miopen::PoolingDescriptor& filter,
+                  std::vector<uint32_t>&) const
+    {
+        auto out = tensor<T>{filter.GetForwardOutputTensor(input.desc)};
+        int in_h, in_w;
+        std::tie(std::ignore, std::ignore, in_h, in_w) = miopen::tien<4>(input.desc.GetLengths());
+        int out_h, out_w;
+        std::tie(std::ignore, std::ignore, out_h, out_w) = miopen::tien<4>(out.desc.GetLengths());
+
+        out.par_for_each([&](int n, int c, int oh, int ow) {
+            const int hs = region_begin(oh, in_h, out_h);
+            const int he = region_end(oh, in_h, out_h);
+            const int ws = region_begin(ow, in_w, out_w);
+            const int we = region_end(ow, in_w, out_w);
+
+            const bool is_max = filter.GetMode() == miopenPoolingMax;
+
+            double acc = is_max ? std::numeric_limits<double>::lowest() : 0.0;
+            for(int h = hs; h < he; h++)
+            {
+                for(int w = ws; w < we; w++)
+                {
+                    const double v = input(n, c, h, w);
+                    acc            = is_max ? std::max(acc, v) : acc + v;
+                }
+            }
+            if(!is_max)
+                acc /= (he - hs) * (we - ws);
+            out(n, c, oh, ow) = T(acc);
+        });
+        return out;
+    }
+
+    template <class T>
+    tensor<T> gpu(const tensor<T>& input,
+                  const miopen::PoolingDescriptor& filter,
+                  std::vector<uint32_t>& indices) const
+    {
+        auto&& handle = get_handle();
+        auto out      = tensor<T>{filter.GetForwardOutputTensor(input.desc)};
+        indices.resize(out.data.size(), 0);
+
+        auto in_dev        = handle.Write(input.data);
+        auto out_dev       = handle.Create<T>(out.data.size());
+        auto workspace_dev = handle.Write(indices);
+
+        float alpha = 1, beta = 0;
+        filter.Forward(handle,
+                       &alpha,
+                       input.desc,
+                       in_dev.get(),
+                       &beta,
+                       out.desc,
+                       out_dev.get(),
+                       true,
+                       workspace_dev.get(),
+                       indices.size() * sizeof(uint32_t));
+
+        indices  = handle.Read<uint32_t>(workspace_dev, indices.size());
+        out.data = handle.Read<T>(out_dev, out.data.size());
+        return out;
+    }
+
+    template <class T>
+    void fail(float,
+              const tensor<T>& input,
+              const miopen::PoolingDescriptor& filter,
+              const std::vector<uint32_t>&) const
+    {
+        std::cout << "Forward adaptive pooling: " << filter << std::endl;
+        std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
+    }
+};
+
+struct verify_backward_adaptive_pooling
+{
+    template <class T>
+    tensor<T> cpu(const tensor<T>& input,
+                  const tensor<T>& dout,
+                  const miopen::PoolingDescriptor& filter,
+                  const std::vector<uint32_t>& indices) const
+    {
+        auto dinput = input;
+        std::fill(dinput.begin(), dinput.end(), T(0));
+        int in_h, in_w;
+        std::tie(std::ignore, std::ignore, in_h, in_w) = miopen::tien<4>(input.desc.GetLengths());
+        int out_h, out_w;
+        std::tie(std::ignore, std::ignore, out_h, out_w) = miopen::tien<4>(dout.desc.GetLengths());
+        const bool image_index =
+            filter.GetWorkspaceIndexMode() == miopenPoolingWorkspaceIndexImage;
+
+        dout.for_each([&](int n, int c, int oh, int ow) {
+            const int hs = region_begin(oh, in_h, out_h);
+            const int he = region_end(oh, in_h, out_h);
+            const int ws = region_begin(ow, in_w, out_w);
+            const int we = region_end(ow, in_w, out_w);
+
+            const double g = dout(n, c, oh, ow);
+
+            if(filter.GetMode() == miopenPoolingMax)
+            {
+                const int idx = indices.at(dout.desc.GetIndex(n, c, oh, ow));
+                const int h   = image_index ? idx / in_w : hs + idx / (we - ws);
+                const int w   = image_index ? idx % in_w : ws + idx % (we - ws);
+
+                dinput(n, c, h, w) += g;
+                return;
+            }
+
+            for(int h = hs; h < he; h++)
+                for(int w = ws; w < we; w++)
+                    dinput(n, c, h, w) += g / ((he - hs) * (we - ws));
+        });
+        return dinput;
+    }
+
+    template <class T>
+    tensor<T> gpu(const tensor<T>& input,
+                  const tensor<T>& dout,
+                  const miopen::PoolingDescriptor& filter,
+                  const std::vector<uint32_t>& indices) const
+    {
+        auto&& handle = get_handle();
+        auto dinput   = input;
+
+        auto in_dev        = handle.Write(input.data);
+        auto dout_dev      = handle.Write(dout.data);
+        auto din_dev       = handle.Create<T>(dinput.data.size());
+        auto workspace_dev = handle.Write(indices);
+
+        float alpha = 1, beta = 0;
+        filter.Backward(handle,
+                        &alpha,
+                        dout.desc,
+                        nullptr,
+                        dout.desc,
+                        dout_dev.get(),
+                        input.desc,
+                        in_dev.get(),
+                        &beta,
+                        dinput.desc,
+                        din_dev.get(),
+                        workspace_dev.get());
+
+        dinput.data = handle.Read<T>(din_dev, dinput.data.size());
+        return dinput;
+    }
+
+    template <class T>
+    void fail(float,
+              const tensor<T>& input,
+              const tensor<T>&,
+              const miopen::PoolingDescriptor& filter,
+              const std::vector<uint32_t>&) const
+    {
+        std::cout << "Backward adaptive pooling: " << filter << std::endl;
+        std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
+    }
+};
+
+template <class T>
+struct pooling_adaptive_driver : test_driver
+{
+    std::vector<int> in_shape;
+    std::vector<int> out_lens;
+    std::string mode;
+    int wsidx{};
+    bool nhwc = false;
+
+    pooling_adaptive_driver()
+    {
+        add(in_shape,
+            "input",
+            generate_data({{2, 64, 7, 7}, {1, 16, 14, 14}, {2, 3, 13, 17}, {1, 8, 32, 32}}));
+        add(out_lens, "out-lens", generate_data({{1, 1}, {7, 7}, {4, 5}}));
+        add(mode, "mode", generate_data({"max", "average"}));
+        add(wsidx, "wsidx", generate_data({0, 1}));
+        add(nhwc, "nhwc", flag());
+    }
+
+    void run()
+    {
+        miopen::PoolingDescriptor filter{
+            miopen::ToUpper(mode) == "MAX" ? miopenPoolingMax : miopenPoolingAverage,
+            miopenPaddingDefault,
+            {1, 1},
+            {1, 1},
+            {0, 0}};
+        filter.SetIndexType(miopenIndexUint32);
+        filter.SetWorkspaceIndexMode(miopenPoolingWorkspaceIndexMode_t(wsidx));
+        filter.SetAdaptiveOutputLengths(out_lens);
+
+        const int c = in_shape[1], h = in_shape[2], w = in_shape[3];
+        auto input  = nhwc ? tensor<T>{in_shape, std::vector<int>{h * w * c, 1, w * c, c}}
+                           : tensor<T>{in_shape};
+        input.generate(tensor_elem_gen_integer{17});
+
+        std::vector<uint32_t> indices;
+        auto out  = verify(verify_forward_adaptive_pooling{}, input, filter, indices);
+        auto dout = out.first;
+        dout.generate(tensor_elem_gen_integer{2503});
+        verify(verify_backward_adaptive_pooling{}, input, dout, filter, indices);
+    }
+};
+
+int main(int argc, const char* argv[]) { test_drive<pooling_adaptive_driver>(argc, argv); }
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <miopen/conv/context.hpp>
+#include <miopen/conv/problem_fingerprint.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/tensor.hpp>
+
+namespace miopen {
+namespace tests {
+
+struct ProblemFingerprintTest
+{
+    void Run() const
+    {
+        const auto x    = TensorDescriptor{miopenFloat, {16, 32, 28, 28}};
+        const auto w    = TensorDescriptor{miopenFloat, {64, 32, 3, 3}};
+        const auto y    = TensorDescriptor{miopenFloat, {16, 64, 28, 28}};
+        const auto conv = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+
+        const auto fp = conv::ProblemFingerprint{x, w, y, conv, conv::Direction::Forward};
+
+        // Equal problems built from separate descriptors are equal.
+        const auto x_copy = TensorDescriptor{miopenFloat, {16, 32, 28, 28}};
+        const auto same   = conv::ProblemFingerprint{x_copy, w, y, conv, conv::Direction::Forward};
+        EXPECT(fp == same);
+        EXPECT_EQUAL(fp.GetHash(), same.GetHash());
+
+        EXPECT(fp != conv::ProblemFingerprint{x, w, y, conv, conv::Direction::BackwardData});
+        EXPECT(fp != conv::ProblemFingerprint{x, w, y, conv, conv::Direction::Forward, 1});
+
+        const auto x_half = TensorDescriptor{miopenHalf, {16, 32, 28, 28}};
+        EXPECT(fp != conv::ProblemFingerprint{x_half, w, y, conv, conv::Direction::Forward});
+
+        // Same lengths, NHWC strides.
+        const auto x_nhwc = TensorDescriptor{
+            miopenFloat, {16, 32, 28, 28}, {28 * 28 * 32, 1, 28 * 32, 32}};
+        EXPECT(fp != conv::ProblemFingerprint{x_nhwc, w, y, conv, conv::Direction::Forward});
+
+        const auto strided = ConvolutionDescriptor{{1, 1}, {2, 2}, {1, 1}};
+        EXPECT(fp != conv::ProblemFingerprint{x, w, y, strided, conv::Direction::Forward});
+
+        CheckKeysCache(fp, same);
+        CheckApplicabilityCache(fp, same);
+        CheckContextCache(fp, same);
+    }
+
+    private:
+    static void CheckKeysCache(const conv::ProblemFingerprint& fp,
+                               const conv::ProblemFingerprint& same)
+    {
+        conv::ProblemKeysCache cache;
+        EXPECT(!cache.Find(fp));
+
+        const auto& registered = cache.Register(fp, {NetworkConfig{"config"}, "db_key"});
+        EXPECT_EQUAL(registered.db_key, "db_key");
+
+        const auto found = cache.Find(same);
+        EXPECT(found);
+        EXPECT_EQUAL(found->network_config.ToString(), "config");
+        EXPECT(&*found == &registered);
+    }
+
+    static void CheckApplicabilityCache(const conv::ProblemFingerprint& fp,
+                                        const conv::ProblemFingerprint& same)
+    {
+        conv::ApplicabilityCache cache;
+        EXPECT(!cache.Find(fp, 1));
+        EXPECT(!cache.FindAll(fp));
+
+        cache.Register(fp, 1, true);
+        EXPECT(cache.Find(same, 1));
+        EXPECT(*cache.Find(same, 1));
+        EXPECT(!cache.Find(same, 2));
+        // Checking some of the solvers does not make the list.
+        EXPECT(!cache.FindAll(same));
+
+        const auto& applicable = cache.RegisterAll(fp, {{1, true}, {3, false}, {2, true}});
+        EXPECT(applicable == std::vector<uint64_t>{1, 2});
+        EXPECT(cache.Find(same, 3));
+        EXPECT(!*cache.Find(same, 3));
+
+        const auto all = cache.FindAll(same);
+        EXPECT(all);
+        EXPECT(&*all == &applicable);
+
+        // Registered lists are not replaced, the first one may still be in use.
+        EXPECT(&cache.RegisterAll(fp, {{1, false}}) == &applicable);
+        EXPECT(applicable.size() == 2);
+    }
+
+    static void CheckContextCache(const conv::ProblemFingerprint& fp,
+                                  const conv::ProblemFingerprint& same)
+    {
+        conv::ContextCache cache;
+        EXPECT(cache.Find(fp, false) == nullptr);
+
+        const auto run        = std::make_shared<ConvolutionContext>(conv::Direction::Forward);
+        const auto registered = cache.Register(fp, run);
+        EXPECT(registered == run);
+        EXPECT(cache.Find(same, false) == run);
+        // The contexts of the compilation are apart.
+        EXPECT(cache.Find(same, true) == nullptr);
+
+        const auto compile              = std::make_shared<ConvolutionContext>(*run);
+        compile->disable_search_enforce = true;
+        EXPECT(cache.Register(same, compile) == compile);
+        EXPECT(cache.Find(fp, true) == compile);
+
+        // The first context wins the race, the others are dropped.
+        EXPECT(cache.Register(fp, std::make_shared<ConvolutionContext>(*run)) == run);
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::ProblemFingerprintTest{}.Run(); }
@@ -362,7 +362,7 @@ struct verify_reduce_with_indices
         {
             auto workspace_dev = handle.Write(workspace.data);
 
-            reduce.ReduceTensor(get_handle(),
+            reduce.ReduceTensor(handle,
                                 indices_dev.get(),
                                 indices_sizeInBytes,
                                 workspace_dev.get(),
@@ -376,7 +376,7 @@ struct verify_reduce_with_indices
         }
         else
         {
-            reduce.ReduceTensor(get_handle(),
+            reduce.ReduceTensor(handle,
                                 indices_dev.get(),
                                 indices_sizeInBytes,
                                 nullptr,
@@ -659,7 +659,7 @@ struct verify_reduce_no_indices
         {
             auto workspace_dev = handle.Write(workspace.data);
 
-            reduce.ReduceTensor(get_handle(),
+            reduce.ReduceTensor(handle,
                                 nullptr,
                                 0,
                                 workspace_dev.get(),
@@ -673,7 +673,7 @@ struct verify_reduce_no_indices
         }
         else
         {
-            reduce.ReduceTensor(get_handle(),
+            reduce.ReduceTensor(handle,
                                 nullptr,
                                 0,
                                 nullptr,
@@ -731,7 +731,8 @@ struct reduce_driver : test_driver
     std::vector<std::vector<int>> get_toreduce_dims()
     {
         std::vector<std::vector<int>> tensor_dims = {
-            {0}, {1}, {2}, {3}, {0, 1}, {0, 3}, {0, 2}, {2, 3}, {0, 1, 3}, {1, 2, 3}, {0, 1, 2, 3}};
+            {0}, {1}, {2}, {3}, {0, 1}, {0, 3}, {0, 2}, {2, 3}, {0, 1, 2}, {0, 1, 3}, {1, 2, 3},
+            {0, 1, 2, 3}};
 
         return tensor_dims;
     }
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
+#include <miopen/remote_db.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cstdlib>
+#include <fstream>
+
+namespace miopen {
+namespace tests {
+
+struct TestText
+{
+    std::string text;
+
+    void Serialize(std::ostream& s) const { s << text; }
+    bool Deserialize(const std::string& s)
+    {
+        text = s;
+        return true;
+    }
+};
+
+// Serves the records from a text file, put appends to it and the last line wins.
+static void WriteServer(const std::string& path, const std::string& store)
+{
+    std::ofstream(path) << "#!/bin/sh" << std::endl
+                        << "store='" << store << "'.\"$2\"" << std::endl
+                        << "if [ \"$1\" = get ]; then" << std::endl
+                        << "  line=$(grep \"^$3=\" \"$store\" 2>/dev/null | tail -n 1)" << std::endl
+                        << "  [ -n \"$line\" ] || exit 1" << std::endl
+                        << "  echo \"${line#*=}\"" << std::endl
+                        << "else" << std::endl
+                        << "  echo \"$3=$(cat)\" >> \"$store\"" << std::endl
+                        << "fi" << std::endl;
+    boost::filesystem::permissions(path, boost::filesystem::owner_all);
+}
+
+struct RemoteDbTest
+{
+    const TmpDir& dir;
+
+    void Run() const
+    {
+        const auto installed = (dir.path / "installed.fdb.txt").string();
+        const auto user      = (dir.path / "user.ufdb.txt").string();
+        std::ofstream{installed} << "local=id:installed" << std::endl;
+
+        EXPECT(RemoteDb::Get() != nullptr);
+        EXPECT_EQUAL(RemoteDb::GetName(installed), "installed.fdb.txt");
+
+        PublishesUpdates(installed, user);
+        FetchesMisses(installed, user);
+    }
+
+    private:
+    static void PublishesUpdates(const std::string& installed, const std::string& user)
+    {
+        auto db = MultiFileDb<PlainTextDb, PlainTextDb, false>{installed, user};
+        EXPECT(db.Update(TestText{"tuned"}, "id", TestText{"value"}));
+        RemoteDb::Get()->Flush();
+
+        RemoteDb remote{std::getenv("MIOPEN_REMOTE_DB_COMMAND")};
+        const auto record = remote.Fetch("installed.fdb.txt", "tuned");
+        EXPECT(record);
+        EXPECT_EQUAL(record->GetSize(), 1);
+        EXPECT(!remote.Fetch("installed.fdb.txt", "missing"));
+        EXPECT(!remote.Fetch("other.fdb.txt", "tuned"));
+    }
+
+    static void FetchesMisses(const std::string& installed, const std::string& user)
+    {
+        // Records are fetched and cached by the user db of another machine.
+        boost::filesystem::remove(user);
+
+        auto db       = MultiFileDb<PlainTextDb, PlainTextDb, false>{installed, user};
+        const auto id = std::string{"id"};
+        auto value    = TestText{};
+        auto local    = TestText{"local"};
+        auto tuned    = TestText{"tuned"};
+        auto missing  = TestText{"missing"};
+        EXPECT(db.Load(local, id, value));
+        EXPECT_EQUAL(value.text, "installed");
+        EXPECT(db.Load(tuned, id, value));
+        EXPECT_EQUAL(value.text, "value");
+        EXPECT(!db.Load(missing, id, value));
+
+        EXPECT(PlainTextDb{user}.Load(TestText{"tuned"}, "id", value));
+        EXPECT(!PlainTextDb{user}.FindRecord(TestText{"local"}));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main()
+{
+    const miopen::TmpDir dir{"test_remote_db"};
+    const auto server = (dir.path / "server.sh").string();
+    miopen::tests::WriteServer(server, (dir.path / "remote").string());
+    setenv("MIOPEN_REMOTE_DB_COMMAND", server.c_str(), 1); // NOLINT (concurrency-mt-unsafe)
+    miopen::env::Refresh();
+    miopen::tests::RemoteDbTest{dir}.Run();
+}
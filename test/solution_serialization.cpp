@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <miopen/solution.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <string>
+
+namespace miopen {
+namespace tests {
+
+struct SolutionSerializationTest
+{
+    void Run() const
+    {
+        RoundTrips();
+        RejectsInvalidBlobs();
+    }
+
+    private:
+    static Solution Sample()
+    {
+        return {solver::Id{"ConvDirectNaiveConvFwd"},
+                miopenProblemDirectionBackwardWeights,
+                "3-32-32-3x3x64-32-32-16-1x1-1x1-1x1-0-NCHW-FP32-W",
+                0.25f,
+                4096};
+    }
+
+    void RoundTrips() const
+    {
+        const auto saved  = Sample();
+        const auto blob   = saved.Save();
+        const auto loaded = Solution::Load(blob.data(), blob.size());
+
+        EXPECT_EQUAL(loaded.GetSolver().Value(), saved.GetSolver().Value());
+        EXPECT_EQUAL(loaded.GetDirection(), saved.GetDirection());
+        EXPECT_EQUAL(loaded.GetProblemKey(), saved.GetProblemKey());
+        EXPECT_EQUAL(loaded.GetTime(), saved.GetTime());
+        EXPECT_EQUAL(loaded.GetWorkspaceSize(), saved.GetWorkspaceSize());
+    }
+
+    void RejectsInvalidBlobs() const
+    {
+        const auto load = [](const std::string& blob) {
+            return throws([&]() { Solution::Load(blob.data(), blob.size()); });
+        };
+
+        auto blob = Sample().Save();
+        EXPECT(load(""));
+        EXPECT(load(blob.substr(0, blob.find(' ', 16))));
+        EXPECT(load("Garbage" + blob));
+        EXPECT(load("MIOpenSolution 2" + blob.substr(blob.find(' ', 15))));
+        EXPECT(load("MIOpenSolution 1 NoSuchSolver 0 1 0 key"));
+        EXPECT(load("MIOpenSolution 1 ConvDirectNaiveConvFwd 7 1 0 key"));
+    }
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main() { miopen::tests::SolutionSerializationTest{}.Run(); }
@@ -260,7 +260,9 @@ struct tensor_ops_driver : test_driver
                 {32, 16, 1, 1, 1},
                 {1, 16, 8, 1, 1},
                 {1, 1, 8, 4, 1},
+                {1, 16, 1, 4, 1},
                 {16, 20, 16, 8},
+                {16, 1, 16, 1},
                 {16, 20, 16, 1},
                 {16, 20, 1, 1},
                 {16, 1, 1, 1},
@@ -271,6 +273,7 @@ struct tensor_ops_driver : test_driver
                 {1, 1, 1, 8},
                 {20, 16, 8},
                 {20, 16, 1},
+                {20, 1, 8},
                 {1, 16, 8},
                 {1, 16, 1},
                 {20, 1, 1},
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "verify.hpp"
+
+template <class T>
+struct verify_tensor_permute
+{
+    tensor<T> src;
+    tensor<T> dst;
+    std::vector<int> perm;
+
+    tensor<T> cpu() const
+    {
+        auto r           = dst;
+        const auto& lens    = dst.desc.GetLengths();
+        const auto& strides = src.desc.GetStrides();
+        std::vector<std::size_t> out_idx(lens.size());
+
+        for(std::size_t i = 0; i < r.data.size(); ++i)
+        {
+            auto rest = i;
+            for(int d = static_cast<int>(lens.size()) - 1; d >= 0; --d)
+            {
+                out_idx[d] = rest % lens[d];
+                rest /= lens[d];
+            }
+            std::size_t in_offset = 0;
+            for(std::size_t d = 0; d < lens.size(); ++d)
+                in_offset += out_idx[d] * strides[perm[d]];
+
+            r.data[i] = src.data[in_offset];
+        }
+        return r;
+    }
+
+    tensor<T> gpu() const
+    {
+        auto r        = dst;
+        auto&& handle = get_handle();
+        auto src_dev  = handle.Write(src.data);
+        auto dst_dev  = handle.Write(r.data);
+        auto src_desc = src.desc;
+
+        EXPECT(miopenTransposeTensor(&handle,
+                                     &src_desc,
+                                     src_dev.get(),
+                                     perm.data(),
+                                     &r.desc,
+                                     dst_dev.get()) == miopenStatusSuccess);
+
+        r.data = handle.Read<T>(dst_dev, dst.data.size());
+        return r;
+    }
+
+    void fail(float = 0)
+    {
+        std::cout << "Tensor Permute: " << std::endl;
+        std::cout << "src tensor: " << src.desc.ToString() << std::endl;
+        std::cout << "perm: ";
+        for(auto p : perm)
+            std::cout << p << " ";
+        std::cout << std::endl;
+    }
+};
+
+template <class T>
+struct tensor_permute_driver : test_driver
+{
+    std::vector<int> src_lens;
+    int perm_id = 0;
+
+    std::vector<std::vector<int>> get_tensor_src()
+    {
+        return {{2, 3, 4, 5}, {8, 64, 7, 7}, {4, 33, 17, 9}, {1, 256, 1, 96}, {16, 3, 64, 64}};
+    }
+
+    tensor_permute_driver()
+    {
+        disabled_cache = true;
+        add(src_lens, "srcLens", generate_data(get_tensor_src()));
+        // The index of the permutation in the lexicographic order of all of them.
+        add(perm_id, "perm", generate_data({0, 1, 5, 7, 9, 14, 18, 23}));
+    }
+
+    void run()
+    {
+        std::vector<int> perm(src_lens.size());
+        std::iota(perm.begin(), perm.end(), 0);
+        for(int i = 0; i < perm_id; ++i)
+            std::next_permutation(perm.begin(), perm.end());
+
+        auto dst_lens = src_lens;
+        for(std::size_t d = 0; d < perm.size(); ++d)
+            dst_lens[d] = src_lens[perm[d]];
+
+        const unsigned long max_value = miopen_type<T>{} == miopenHalf ? 5 : 17;
+        auto src = tensor<T>{src_lens}.generate(tensor_elem_gen_integer{max_value});
+        auto dst = tensor<T>{dst_lens};
+
+        verify_equals(verify_tensor_permute<T>{src, dst, perm});
+    }
+};
+
+int main(int argc, const char* argv[]) { test_drive<tensor_permute_driver>(argc, argv); }
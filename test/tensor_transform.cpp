@@ -35,6 +35,7 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <type_traits>
 #include <utility>
 #include <cstdlib>
 #include "driver.hpp"
@@ -327,6 +328,45 @@ struct verify_tensor_transform_scale
     }
 };
 
+template <class T, class U>
+struct verify_tensor_transform_cast
+{
+    tensor<T> src;
+    tensor<U> dst;
+    float alpha;
+    float beta;
+
+    tensor<U> cpu() const
+    {
+        auto r = dst;
+        r.par_for_each([&](auto n, auto c, auto h, auto w) {
+            r(n, c, h, w) = U(alpha * float(src(n, c, h, w)) + beta * float(dst(n, c, h, w)));
+        });
+        return r;
+    }
+
+    tensor<U> gpu() const
+    {
+        auto r        = dst;
+        auto&& handle = get_handle();
+        auto src_dev  = handle.Write(src.data);
+        auto dst_dev  = handle.Write(r.data);
+
+        miopen::TransformTensor(
+            handle, &alpha, src.desc, src_dev.get(), &beta, r.desc, dst_dev.get());
+
+        r.data = handle.Read<U>(dst_dev, r.data.size());
+        return r;
+    }
+
+    void fail(float = 0)
+    {
+        std::cout << "Tensor Transform Cast: " << std::endl;
+        std::cout << "src tensor: " << src.desc.ToString() << std::endl;
+        std::cout << "dst tensor: " << dst.desc.ToString() << std::endl;
+    }
+};
+
 template <class T>
 struct tensor_transform_driver : test_driver
 {
@@ -419,6 +459,28 @@ struct tensor_transform_driver : test_driver
             }
         }
 
+        // Test the cast to another type, in the same layout and to NHWC
+        if(miopen_type<T>{} != miopenInt8x4 && srcLens.size() == 4)
+        {
+            using U = std::conditional_t<std::is_same<T, float>{}, half_float::half, float>;
+
+            const std::vector<int> lens = srcLens;
+            const std::vector<int> nhwc_strides{
+                lens[1] * lens[2] * lens[3], 1, lens[1] * lens[3], lens[1]};
+
+            const auto cast_src = tensor<T>{lens}.generate(tensor_elem_gen_integer{max_value});
+            verify_equals(verify_tensor_transform_cast<T, U>{
+                cast_src,
+                tensor<U>{lens}.generate(tensor_elem_gen_integer{max_value}),
+                alpha,
+                beta});
+            verify_equals(verify_tensor_transform_cast<T, U>{
+                cast_src,
+                tensor<U>{lens, nhwc_strides}.generate(tensor_elem_gen_integer{max_value}),
+                alpha,
+                beta});
+        }
+
         // Test tensor scale addition
         if(miopen_type<T>{} == miopenInt8 || miopen_type<T>{} == miopenInt8x4)
             return;
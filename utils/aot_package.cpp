@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/aot_package.hpp>
+#include <miopen/handle.hpp>
+
+#if MIOPEN_MODE_NOGPU
+#include <miopen/nogpu/handle_impl.hpp>
+#endif
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int Usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options] -o <output dir> <db>...\n"
+              << "Compiles the kernels of all the convolution solvers applicable to the problems\n"
+              << "of text find-db and perf-db files into <output dir>/<version>/<arch>.kdb.\n"
+#if MIOPEN_MODE_NOGPU
+              << "  --arch <name>   target, e.g. gfx906 or gfx90a:xnack-\n"
+              << "  --num-cu <n>    number of the compute units of the target\n"
+#else
+              << "Kernels are built for the current device.\n"
+#endif
+              << "MIOPEN_COMPILE_PARALLEL_LEVEL limits the number of the compiler threads."
+              << std::endl;
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto arch   = std::string{};
+    auto num_cu = std::size_t{0};
+    auto output = std::string{};
+    auto inputs = std::vector<std::string>{};
+
+    for(auto i = 1; i < argc; ++i)
+    {
+        const auto arg = std::string{argv[i]};
+        if(arg == "--arch" && i + 1 < argc)
+            arch = argv[++i];
+        else if(arg == "--num-cu" && i + 1 < argc)
+            num_cu = std::stoul(argv[++i]);
+        else if(arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if(!arg.empty() && arg[0] == '-')
+            return Usage(argv[0]);
+        else
+            inputs.push_back(arg);
+    }
+
+    if(output.empty() || inputs.empty())
+        return Usage(argv[0]);
+#if MIOPEN_MODE_NOGPU
+    if(arch.empty() || num_cu == 0)
+        return Usage(argv[0]);
+#else
+    if(!arch.empty() || num_cu != 0)
+        return Usage(argv[0]);
+#endif
+
+    try
+    {
+        auto handle = miopen::Handle{};
+#if MIOPEN_MODE_NOGPU
+        handle.impl->device_name        = arch;
+        handle.impl->num_cu             = num_cu;
+        handle.impl->max_mem_alloc_size = 32UL * 1024 * 1024 * 1024;
+        handle.impl->global_mem_size    = 32UL * 1024 * 1024 * 1024;
+        handle.impl->target_properties.Init(&handle);
+#endif
+
+        auto packager = miopen::AotPackager{};
+        packager.AddDbs(inputs);
+        if(packager.GetProblemCount() == 0)
+        {
+            std::cerr << "No convolution problems in the inputs" << std::endl;
+            return 1;
+        }
+
+        const auto summary = packager.Build(handle, output);
+        std::cout << summary.path << ": " << summary.kernels << " kernels for "
+                  << packager.GetProblemCount() << " problems" << std::endl;
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compile_worker_pool.hpp>
+#include <miopen/hipoc_program.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/target_properties.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+
+/// The helper process of miopen::CompileWorkerPool. Reads jobs of a program name and build
+/// parameters from the standard input and answers each with a status message, empty on
+/// success, and the code object. Exits on end of input.
+int main(int argc, char** argv)
+{
+    if(argc != 3 || std::strcmp(argv[1], "--arch") != 0)
+    {
+        std::cerr << "Usage: " << argv[0] << " --arch <name>\n"
+                  << "Started by MIOpen when MIOPEN_COMPILE_WORKERS is set." << std::endl;
+        return 1;
+    }
+
+    // Builds the code objects only, without loading them onto a device.
+    setenv("MIOPEN_DEVICE_ARCH", argv[2], 1); // NOLINT (concurrency-mt-unsafe)
+    miopen::TargetProperties target;
+    target.Init(nullptr);
+
+    std::string program_name;
+    std::string params;
+    while(miopen::compile_worker::ReadMessage(0, program_name) &&
+          miopen::compile_worker::ReadMessage(0, params))
+    {
+        std::string status;
+        std::string binary;
+        try
+        {
+            auto program = miopen::HIPOCProgram{program_name, params, false, target, ""};
+            binary       = program.IsCodeObjectInMemory()
+                               ? program.GetCodeObjectBlob()
+                               : miopen::LoadFile(program.GetCodeObjectPathname().string());
+            if(binary.empty())
+                status = "empty code object";
+        }
+        catch(const std::exception& ex)
+        {
+            status = ex.what();
+            binary.clear();
+        }
+
+        if(!miopen::compile_worker::WriteMessage(1, status) ||
+           !miopen::compile_worker::WriteMessage(1, binary))
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_merge.hpp>
+#include <miopen/mapped_db.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool EndsWith(const std::string& str, const std::string& suffix)
+{
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool IsKnownFindDbEntry(const std::string&, const std::string& values)
+{
+    auto data = miopen::FindDbData{};
+    return data.Deserialize(values) && miopen::solver::Id{data.solver_id}.IsValid() &&
+           !data.IsStale();
+}
+
+/// Perf-db ids are solver ids with an optional "_v<db version>" suffix.
+bool IsKnownPerfDbEntry(const std::string& id, const std::string&)
+{
+    const auto plain = miopen::solver::Id{id};
+    if(plain.IsValid())
+        return plain.GetDbVersion() == 1;
+
+    const auto suffix = id.rfind("_v");
+    if(suffix == std::string::npos || suffix + 2 == id.size() ||
+       !std::all_of(id.begin() + suffix + 2, id.end(), [](char c) { return std::isdigit(c); }))
+        return false;
+
+    const auto solver = miopen::solver::Id{id.substr(0, suffix)};
+    return solver.IsValid() && solver.GetDbVersion() == std::stoi(id.substr(suffix + 2));
+}
+
+int Usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options] -o <output db> <input db>...\n"
+              << "Merges find-db or perf-db files collected from many machines.\n"
+              << "  --find          inputs are find-db, the fastest entry is kept per solver\n"
+              << "                  (default for *.fdb.txt and *.ufdb.txt outputs)\n"
+              << "  --perf          inputs are perf-db, the latest input wins per solver\n"
+              << "  --jobs <n>      number of the parsing threads, all hardware ones by default\n"
+              << "  --keep-removed  keep the entries of unknown or changed solvers\n"
+              << "  --mapped        also write the memory-mapped format, as <output db>.bin\n"
+              << "SQLite perf databases (*.db, *.udb) are merged when the output is one."
+              << std::endl;
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto options      = miopen::DbMerger::Options{};
+    auto find_db      = false;
+    auto perf_db      = false;
+    auto keep_removed = false;
+    auto mapped       = false;
+    auto output       = std::string{};
+    auto inputs       = std::vector<std::string>{};
+
+    for(auto i = 1; i < argc; ++i)
+    {
+        const auto arg = std::string{argv[i]};
+        if(arg == "--find")
+            find_db = true;
+        else if(arg == "--perf")
+            perf_db = true;
+        else if(arg == "--keep-removed")
+            keep_removed = true;
+        else if(arg == "--mapped")
+            mapped = true;
+        else if(arg == "--jobs" && i + 1 < argc)
+            options.jobs = std::stoul(argv[++i]);
+        else if(arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if(!arg.empty() && arg[0] == '-')
+            return Usage(argv[0]);
+        else
+            inputs.push_back(arg);
+    }
+
+    if(output.empty() || inputs.empty() || (find_db && perf_db))
+        return Usage(argv[0]);
+
+    const auto sqlite = EndsWith(output, ".db") || EndsWith(output, ".udb");
+    if(!find_db && !perf_db)
+        find_db = EndsWith(output, ".fdb.txt") || EndsWith(output, ".ufdb.txt");
+    if(sqlite && find_db)
+    {
+        std::cerr << "Find-db is a text database: " << output << std::endl;
+        return 1;
+    }
+
+    options.find_db = find_db;
+    if(!keep_removed)
+        options.filter = find_db ? IsKnownFindDbEntry : IsKnownPerfDbEntry;
+
+    try
+    {
+        if(sqlite)
+        {
+#if MIOPEN_ENABLE_SQLITE
+            miopen::DbMerger::MergeSQLite(inputs, output, options.filter);
+#else
+            std::cerr << "MIOpen is built without SQLite support" << std::endl;
+            return 1;
+#endif
+        }
+        else
+        {
+            auto merger = miopen::DbMerger{options};
+            merger.AddText(inputs);
+            merger.WriteText(output);
+            std::cout << output << ": " << merger.GetCount() << " records" << std::endl;
+        }
+
+        if(mapped && !sqlite)
+            miopen::MappedDb::Convert(output, miopen::MappedDb::GetPath(output));
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}